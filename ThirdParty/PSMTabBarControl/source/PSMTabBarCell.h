@@ -19,7 +19,9 @@
 - (void)closeTabClick:(id)sender button:(int)button;
 - (id<PSMTabStyle>)style;
 - (void)update:(BOOL)animate;
+- (void)setNeedsUpdate:(BOOL)needsUpdate animate:(BOOL)animate;
 - (BOOL)automaticallyAnimates;
+- (BOOL)coalescesCellUpdates;
 - (PSMTabBarOrientation)orientation;
 - (id<PSMTabBarControlDelegate>)delegate;
 - (NSTabView *)tabView;
@@ -356,7 +356,7 @@ static NSRect PSMConvertAccessibilityFrameToScreen(NSView *view, NSRect frame) {
     _delayedStringValueTimer = nil;
     _stringSize = [[self cachedTitle] size];
     // need to redisplay now - binding observation was too quick.
-    [[self psmTabControlView] update:[[self psmTabControlView] automaticallyAnimates]];
+    [self updateControlView];
 }
 
 - (NSSize)stringSize {
@@ -381,7 +381,7 @@ static NSRect PSMConvertAccessibilityFrameToScreen(NSView *view, NSRect frame) {
 
 - (void)setHasIcon:(BOOL)value {
     _hasIcon = value;
-    [[self psmTabControlView] update:[[self psmTabControlView] automaticallyAnimates]]; // binding notice is too fast
+    [self updateControlView]; // binding notice is too fast
 }
 
 - (BOOL)hasIcon {
@@ -391,7 +391,7 @@ static NSRect PSMConvertAccessibilityFrameToScreen(NSView *view, NSRect frame) {
 
 - (void)setCount:(int)value {
     _count = value;
-    [[self psmTabControlView] update:[[self psmTabControlView] automaticallyAnimates]]; // binding notice is too fast
+    [self updateControlView]; // binding notice is too fast
 }
 
 - (void)setCurrentStep:(int)value {
@@ -432,7 +432,16 @@ static NSRect PSMConvertAccessibilityFrameToScreen(NSView *view, NSRect frame) {
                         change:(NSDictionary *)change
                        context:(void *)context {
     // the progress indicator, label, icon, or count has changed - redraw the control view
-    [[self psmTabControlView] update:[[self psmTabControlView] automaticallyAnimates]];
+    [self updateControlView];
+}
+
+- (void)updateControlView {
+    NSView<PSMTabBarControlProtocol> *control = [self psmTabControlView];
+    if ([control coalescesCellUpdates]) {
+        [control setNeedsUpdate:YES animate:[control automaticallyAnimates]];
+    } else {
+        [control update:[control automaticallyAnimates]];
+    }
 }
 
 #pragma mark - Component Attributes
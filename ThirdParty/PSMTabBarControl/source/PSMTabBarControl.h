@@ -194,6 +194,10 @@ typedef enum {
 // Of on, ellipsize the start if more tabs share a prefix than a suffix.
 @property(nonatomic, assign) BOOL smartTruncation;
 
+// If on, a change to a cell's title, icon, count, or indicator schedules a layout for later in the
+// run loop instead of laying out every cell immediately, so a burst of changes costs one layout.
+@property(nonatomic, assign) BOOL coalescesCellUpdates;
+
 @property(nonatomic, retain) IBOutlet NSTabView *tabView;
 @property(nonatomic, assign) id<PSMTabBarControlDelegate> delegate;
 @property(nonatomic, retain) id partnerView;
@@ -897,6 +897,8 @@ PSMTabBarControlOptionKey PSMTabBarControlOptionHTMLTabTitles = @"PSMTabBarContr
     if ([_tabView numberOfTabViewItems] != [_cells count]) {
         return;
     }
+    // This update covers any that was scheduled.
+    _needsUpdate = NO;
 
     // Hide or show? These do nothing if already in the desired state.
     if ((_hideForSingleTab) && ([_cells count] <= 1)) {
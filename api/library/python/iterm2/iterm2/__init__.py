@@ -9,6 +9,8 @@ from iterm2.app import (
 
 from iterm2.arrangement import SavedArrangementException, Arrangement
 
+from iterm2.batch import async_gather_batched
+
 from iterm2.binding import PasteConfiguration, MoveSelectionUnit, SnippetIdentifier, BindingAction, KeyBinding, async_get_global_key_bindings, async_set_global_key_bindings
 
 from iterm2.broadcast import BroadcastDomain, async_set_broadcast_domains
@@ -37,6 +39,9 @@ from iterm2.keyboard import (
     Modifier, Keycode, Keystroke, KeystrokePattern, KeystrokeMonitor,
     KeystrokeFilter)
 
+from iterm2.performancecounters import (
+    PerformanceCounter, async_get_performance_counters)
+
 from iterm2.preferences import PreferenceKey, async_get_preference
 
 from iterm2.profile import (
@@ -51,7 +56,9 @@ from iterm2.prompt import (
 
 from iterm2.registration import RPC, ContextMenuProviderRPC, TitleProviderRPC, StatusBarRPC, Reference
 
-from iterm2.screen import ScreenStreamer, LineContents, ScreenContents
+from iterm2.screen import (
+    ScreenStreamer, LineContents, ScreenContents, ScreenDeltaStreamer,
+    ScreenUpdate)
 
 from iterm2.selection import SelectionMode, SubSelection, Selection
 
@@ -62,6 +69,9 @@ from iterm2.statusbar import (
     StatusBarComponent, CheckboxKnob, StringKnob, PositiveFloatingPointKnob,
     ColorKnob)
 
+from iterm2.systemmetrics import (
+    NetworkThroughput, SystemMetrics, async_get_system_metrics)
+
 from iterm2.transaction import Transaction
 
 from iterm2.tab import Tab, NavigationDirection
@@ -145,6 +145,9 @@ class ClientOriginatedMessage(google.protobuf.message.Message):
     CLOSE_REQUEST_FIELD_NUMBER: builtins.int
     INVOKE_FUNCTION_REQUEST_FIELD_NUMBER: builtins.int
     LIST_PROMPTS_REQUEST_FIELD_NUMBER: builtins.int
+    BATCH_REQUEST_FIELD_NUMBER: builtins.int
+    GET_SYSTEM_METRICS_REQUEST_FIELD_NUMBER: builtins.int
+    GET_PERFORMANCE_COUNTERS_REQUEST_FIELD_NUMBER: builtins.int
     id: builtins.int = ...
 
     @property
@@ -249,6 +252,15 @@ class ClientOriginatedMessage(google.protobuf.message.Message):
     @property
     def list_prompts_request(self) -> global___ListPromptsRequest: ...
 
+    @property
+    def batch_request(self) -> global___BatchRequest: ...
+
+    @property
+    def get_system_metrics_request(self) -> global___GetSystemMetricsRequest: ...
+
+    @property
+    def get_performance_counters_request(self) -> global___GetPerformanceCountersRequest: ...
+
     def __init__(self,
         *,
         id : typing.Optional[builtins.int] = ...,
@@ -286,10 +298,13 @@ class ClientOriginatedMessage(google.protobuf.message.Message):
         close_request : typing.Optional[global___CloseRequest] = ...,
         invoke_function_request : typing.Optional[global___InvokeFunctionRequest] = ...,
         list_prompts_request : typing.Optional[global___ListPromptsRequest] = ...,
+        batch_request : typing.Optional[global___BatchRequest] = ...,
+        get_system_metrics_request : typing.Optional[global___GetSystemMetricsRequest] = ...,
+        get_performance_counters_request : typing.Optional[global___GetPerformanceCountersRequest] = ...,
         ) -> None: ...
-    def HasField(self, field_name: typing_extensions.Literal[u"activate_request",b"activate_request",u"close_request",b"close_request",u"color_preset_request",b"color_preset_request",u"create_tab_request",b"create_tab_request",u"focus_request",b"focus_request",u"get_broadcast_domains_request",b"get_broadcast_domains_request",u"get_buffer_request",b"get_buffer_request",u"get_profile_property_request",b"get_profile_property_request",u"get_prompt_request",b"get_prompt_request",u"get_property_request",b"get_property_request",u"id",b"id",u"inject_request",b"inject_request",u"invoke_function_request",b"invoke_function_request",u"list_profiles_request",b"list_profiles_request",u"list_prompts_request",b"list_prompts_request",u"list_sessions_request",b"list_sessions_request",u"menu_item_request",b"menu_item_request",u"notification_request",b"notification_request",u"preferences_request",b"preferences_request",u"register_tool_request",b"register_tool_request",u"reorder_tabs_request",b"reorder_tabs_request",u"restart_session_request",b"restart_session_request",u"saved_arrangement_request",b"saved_arrangement_request",u"selection_request",b"selection_request",u"send_text_request",b"send_text_request",u"server_originated_rpc_result_request",b"server_originated_rpc_result_request",u"set_broadcast_domains_request",b"set_broadcast_domains_request",u"set_profile_property_request",b"set_profile_property_request",u"set_property_request",b"set_property_request",u"set_tab_layout_request",b"set_tab_layout_request",u"split_pane_request",b"split_pane_request",u"status_bar_component_request",b"status_bar_component_request",u"submessage",b"submessage",u"tmux_request",b"tmux_request",u"transaction_request",b"transaction_request",u"variable_request",b"variable_request"]) -> builtins.bool: ...
-    def ClearField(self, field_name: typing_extensions.Literal[u"activate_request",b"activate_request",u"close_request",b"close_request",u"color_preset_request",b"color_preset_request",u"create_tab_request",b"create_tab_request",u"focus_request",b"focus_request",u"get_broadcast_domains_request",b"get_broadcast_domains_request",u"get_buffer_request",b"get_buffer_request",u"get_profile_property_request",b"get_profile_property_request",u"get_prompt_request",b"get_prompt_request",u"get_property_request",b"get_property_request",u"id",b"id",u"inject_request",b"inject_request",u"invoke_function_request",b"invoke_function_request",u"list_profiles_request",b"list_profiles_request",u"list_prompts_request",b"list_prompts_request",u"list_sessions_request",b"list_sessions_request",u"menu_item_request",b"menu_item_request",u"notification_request",b"notification_request",u"preferences_request",b"preferences_request",u"register_tool_request",b"register_tool_request",u"reorder_tabs_request",b"reorder_tabs_request",u"restart_session_request",b"restart_session_request",u"saved_arrangement_request",b"saved_arrangement_request",u"selection_request",b"selection_request",u"send_text_request",b"send_text_request",u"server_originated_rpc_result_request",b"server_originated_rpc_result_request",u"set_broadcast_domains_request",b"set_broadcast_domains_request",u"set_profile_property_request",b"set_profile_property_request",u"set_property_request",b"set_property_request",u"set_tab_layout_request",b"set_tab_layout_request",u"split_pane_request",b"split_pane_request",u"status_bar_component_request",b"status_bar_component_request",u"submessage",b"submessage",u"tmux_request",b"tmux_request",u"transaction_request",b"transaction_request",u"variable_request",b"variable_request"]) -> None: ...
-    def WhichOneof(self, oneof_group: typing_extensions.Literal[u"submessage",b"submessage"]) -> typing_extensions.Literal["get_buffer_request","get_prompt_request","transaction_request","notification_request","register_tool_request","set_profile_property_request","list_sessions_request","send_text_request","create_tab_request","split_pane_request","get_profile_property_request","set_property_request","get_property_request","inject_request","activate_request","variable_request","saved_arrangement_request","focus_request","list_profiles_request","server_originated_rpc_result_request","restart_session_request","menu_item_request","set_tab_layout_request","get_broadcast_domains_request","tmux_request","reorder_tabs_request","preferences_request","color_preset_request","selection_request","status_bar_component_request","set_broadcast_domains_request","close_request","invoke_function_request","list_prompts_request"]: ...
+    def HasField(self, field_name: typing_extensions.Literal[u"activate_request",b"activate_request",u"batch_request",b"batch_request",u"close_request",b"close_request",u"color_preset_request",b"color_preset_request",u"create_tab_request",b"create_tab_request",u"focus_request",b"focus_request",u"get_broadcast_domains_request",b"get_broadcast_domains_request",u"get_buffer_request",b"get_buffer_request",u"get_performance_counters_request",b"get_performance_counters_request",u"get_profile_property_request",b"get_profile_property_request",u"get_prompt_request",b"get_prompt_request",u"get_property_request",b"get_property_request",u"get_system_metrics_request",b"get_system_metrics_request",u"id",b"id",u"inject_request",b"inject_request",u"invoke_function_request",b"invoke_function_request",u"list_profiles_request",b"list_profiles_request",u"list_prompts_request",b"list_prompts_request",u"list_sessions_request",b"list_sessions_request",u"menu_item_request",b"menu_item_request",u"notification_request",b"notification_request",u"preferences_request",b"preferences_request",u"register_tool_request",b"register_tool_request",u"reorder_tabs_request",b"reorder_tabs_request",u"restart_session_request",b"restart_session_request",u"saved_arrangement_request",b"saved_arrangement_request",u"selection_request",b"selection_request",u"send_text_request",b"send_text_request",u"server_originated_rpc_result_request",b"server_originated_rpc_result_request",u"set_broadcast_domains_request",b"set_broadcast_domains_request",u"set_profile_property_request",b"set_profile_property_request",u"set_property_request",b"set_property_request",u"set_tab_layout_request",b"set_tab_layout_request",u"split_pane_request",b"split_pane_request",u"status_bar_component_request",b"status_bar_component_request",u"submessage",b"submessage",u"tmux_request",b"tmux_request",u"transaction_request",b"transaction_request",u"variable_request",b"variable_request"]) -> builtins.bool: ...
+    def ClearField(self, field_name: typing_extensions.Literal[u"activate_request",b"activate_request",u"batch_request",b"batch_request",u"close_request",b"close_request",u"color_preset_request",b"color_preset_request",u"create_tab_request",b"create_tab_request",u"focus_request",b"focus_request",u"get_broadcast_domains_request",b"get_broadcast_domains_request",u"get_buffer_request",b"get_buffer_request",u"get_performance_counters_request",b"get_performance_counters_request",u"get_profile_property_request",b"get_profile_property_request",u"get_prompt_request",b"get_prompt_request",u"get_property_request",b"get_property_request",u"get_system_metrics_request",b"get_system_metrics_request",u"id",b"id",u"inject_request",b"inject_request",u"invoke_function_request",b"invoke_function_request",u"list_profiles_request",b"list_profiles_request",u"list_prompts_request",b"list_prompts_request",u"list_sessions_request",b"list_sessions_request",u"menu_item_request",b"menu_item_request",u"notification_request",b"notification_request",u"preferences_request",b"preferences_request",u"register_tool_request",b"register_tool_request",u"reorder_tabs_request",b"reorder_tabs_request",u"restart_session_request",b"restart_session_request",u"saved_arrangement_request",b"saved_arrangement_request",u"selection_request",b"selection_request",u"send_text_request",b"send_text_request",u"server_originated_rpc_result_request",b"server_originated_rpc_result_request",u"set_broadcast_domains_request",b"set_broadcast_domains_request",u"set_profile_property_request",b"set_profile_property_request",u"set_property_request",b"set_property_request",u"set_tab_layout_request",b"set_tab_layout_request",u"split_pane_request",b"split_pane_request",u"status_bar_component_request",b"status_bar_component_request",u"submessage",b"submessage",u"tmux_request",b"tmux_request",u"transaction_request",b"transaction_request",u"variable_request",b"variable_request"]) -> None: ...
+    def WhichOneof(self, oneof_group: typing_extensions.Literal[u"submessage",b"submessage"]) -> typing_extensions.Literal["get_buffer_request","get_prompt_request","transaction_request","notification_request","register_tool_request","set_profile_property_request","list_sessions_request","send_text_request","create_tab_request","split_pane_request","get_profile_property_request","set_property_request","get_property_request","inject_request","activate_request","variable_request","saved_arrangement_request","focus_request","list_profiles_request","server_originated_rpc_result_request","restart_session_request","menu_item_request","set_tab_layout_request","get_broadcast_domains_request","tmux_request","reorder_tabs_request","preferences_request","color_preset_request","selection_request","status_bar_component_request","set_broadcast_domains_request","close_request","invoke_function_request","list_prompts_request","batch_request","get_system_metrics_request","get_performance_counters_request"]: ...
 global___ClientOriginatedMessage = ClientOriginatedMessage
 
 class ServerOriginatedMessage(google.protobuf.message.Message):
@@ -330,6 +345,9 @@ class ServerOriginatedMessage(google.protobuf.message.Message):
     CLOSE_RESPONSE_FIELD_NUMBER: builtins.int
     INVOKE_FUNCTION_RESPONSE_FIELD_NUMBER: builtins.int
     LIST_PROMPTS_RESPONSE_FIELD_NUMBER: builtins.int
+    BATCH_RESPONSE_FIELD_NUMBER: builtins.int
+    GET_SYSTEM_METRICS_RESPONSE_FIELD_NUMBER: builtins.int
+    GET_PERFORMANCE_COUNTERS_RESPONSE_FIELD_NUMBER: builtins.int
     NOTIFICATION_FIELD_NUMBER: builtins.int
     id: builtins.int = ...
     error: typing.Text = ...
@@ -436,6 +454,15 @@ class ServerOriginatedMessage(google.protobuf.message.Message):
     @property
     def list_prompts_response(self) -> global___ListPromptsResponse: ...
 
+    @property
+    def batch_response(self) -> global___BatchResponse: ...
+
+    @property
+    def get_system_metrics_response(self) -> global___GetSystemMetricsResponse: ...
+
+    @property
+    def get_performance_counters_response(self) -> global___GetPerformanceCountersResponse: ...
+
     @property
     def notification(self) -> global___Notification: ...
 
@@ -477,11 +504,14 @@ class ServerOriginatedMessage(google.protobuf.message.Message):
         close_response : typing.Optional[global___CloseResponse] = ...,
         invoke_function_response : typing.Optional[global___InvokeFunctionResponse] = ...,
         list_prompts_response : typing.Optional[global___ListPromptsResponse] = ...,
+        batch_response : typing.Optional[global___BatchResponse] = ...,
+        get_system_metrics_response : typing.Optional[global___GetSystemMetricsResponse] = ...,
+        get_performance_counters_response : typing.Optional[global___GetPerformanceCountersResponse] = ...,
         notification : typing.Optional[global___Notification] = ...,
         ) -> None: ...
-    def HasField(self, field_name: typing_extensions.Literal[u"activate_response",b"activate_response",u"close_response",b"close_response",u"color_preset_response",b"color_preset_response",u"create_tab_response",b"create_tab_response",u"error",b"error",u"focus_response",b"focus_response",u"get_broadcast_domains_response",b"get_broadcast_domains_response",u"get_buffer_response",b"get_buffer_response",u"get_profile_property_response",b"get_profile_property_response",u"get_prompt_response",b"get_prompt_response",u"get_property_response",b"get_property_response",u"id",b"id",u"inject_response",b"inject_response",u"invoke_function_response",b"invoke_function_response",u"list_profiles_response",b"list_profiles_response",u"list_prompts_response",b"list_prompts_response",u"list_sessions_response",b"list_sessions_response",u"menu_item_response",b"menu_item_response",u"notification",b"notification",u"notification_response",b"notification_response",u"preferences_response",b"preferences_response",u"register_tool_response",b"register_tool_response",u"reorder_tabs_response",b"reorder_tabs_response",u"restart_session_response",b"restart_session_response",u"saved_arrangement_response",b"saved_arrangement_response",u"selection_response",b"selection_response",u"send_text_response",b"send_text_response",u"server_originated_rpc_result_response",b"server_originated_rpc_result_response",u"set_broadcast_domains_response",b"set_broadcast_domains_response",u"set_profile_property_response",b"set_profile_property_response",u"set_property_response",b"set_property_response",u"set_tab_layout_response",b"set_tab_layout_response",u"split_pane_response",b"split_pane_response",u"status_bar_component_response",b"status_bar_component_response",u"submessage",b"submessage",u"tmux_response",b"tmux_response",u"transaction_response",b"transaction_response",u"variable_response",b"variable_response"]) -> builtins.bool: ...
-    def ClearField(self, field_name: typing_extensions.Literal[u"activate_response",b"activate_response",u"close_response",b"close_response",u"color_preset_response",b"color_preset_response",u"create_tab_response",b"create_tab_response",u"error",b"error",u"focus_response",b"focus_response",u"get_broadcast_domains_response",b"get_broadcast_domains_response",u"get_buffer_response",b"get_buffer_response",u"get_profile_property_response",b"get_profile_property_response",u"get_prompt_response",b"get_prompt_response",u"get_property_response",b"get_property_response",u"id",b"id",u"inject_response",b"inject_response",u"invoke_function_response",b"invoke_function_response",u"list_profiles_response",b"list_profiles_response",u"list_prompts_response",b"list_prompts_response",u"list_sessions_response",b"list_sessions_response",u"menu_item_response",b"menu_item_response",u"notification",b"notification",u"notification_response",b"notification_response",u"preferences_response",b"preferences_response",u"register_tool_response",b"register_tool_response",u"reorder_tabs_response",b"reorder_tabs_response",u"restart_session_response",b"restart_session_response",u"saved_arrangement_response",b"saved_arrangement_response",u"selection_response",b"selection_response",u"send_text_response",b"send_text_response",u"server_originated_rpc_result_response",b"server_originated_rpc_result_response",u"set_broadcast_domains_response",b"set_broadcast_domains_response",u"set_profile_property_response",b"set_profile_property_response",u"set_property_response",b"set_property_response",u"set_tab_layout_response",b"set_tab_layout_response",u"split_pane_response",b"split_pane_response",u"status_bar_component_response",b"status_bar_component_response",u"submessage",b"submessage",u"tmux_response",b"tmux_response",u"transaction_response",b"transaction_response",u"variable_response",b"variable_response"]) -> None: ...
-    def WhichOneof(self, oneof_group: typing_extensions.Literal[u"submessage",b"submessage"]) -> typing_extensions.Literal["error","get_buffer_response","get_prompt_response","transaction_response","notification_response","register_tool_response","set_profile_property_response","list_sessions_response","send_text_response","create_tab_response","split_pane_response","get_profile_property_response","set_property_response","get_property_response","inject_response","activate_response","variable_response","saved_arrangement_response","focus_response","list_profiles_response","server_originated_rpc_result_response","restart_session_response","menu_item_response","set_tab_layout_response","get_broadcast_domains_response","tmux_response","reorder_tabs_response","preferences_response","color_preset_response","selection_response","status_bar_component_response","set_broadcast_domains_response","close_response","invoke_function_response","list_prompts_response","notification"]: ...
+    def HasField(self, field_name: typing_extensions.Literal[u"activate_response",b"activate_response",u"batch_response",b"batch_response",u"close_response",b"close_response",u"color_preset_response",b"color_preset_response",u"create_tab_response",b"create_tab_response",u"error",b"error",u"focus_response",b"focus_response",u"get_broadcast_domains_response",b"get_broadcast_domains_response",u"get_buffer_response",b"get_buffer_response",u"get_performance_counters_response",b"get_performance_counters_response",u"get_profile_property_response",b"get_profile_property_response",u"get_prompt_response",b"get_prompt_response",u"get_property_response",b"get_property_response",u"get_system_metrics_response",b"get_system_metrics_response",u"id",b"id",u"inject_response",b"inject_response",u"invoke_function_response",b"invoke_function_response",u"list_profiles_response",b"list_profiles_response",u"list_prompts_response",b"list_prompts_response",u"list_sessions_response",b"list_sessions_response",u"menu_item_response",b"menu_item_response",u"notification",b"notification",u"notification_response",b"notification_response",u"preferences_response",b"preferences_response",u"register_tool_response",b"register_tool_response",u"reorder_tabs_response",b"reorder_tabs_response",u"restart_session_response",b"restart_session_response",u"saved_arrangement_response",b"saved_arrangement_response",u"selection_response",b"selection_response",u"send_text_response",b"send_text_response",u"server_originated_rpc_result_response",b"server_originated_rpc_result_response",u"set_broadcast_domains_response",b"set_broadcast_domains_response",u"set_profile_property_response",b"set_profile_property_response",u"set_property_response",b"set_property_response",u"set_tab_layout_response",b"set_tab_layout_response",u"split_pane_response",b"split_pane_response",u"status_bar_component_response",b"status_bar_component_response",u"submessage",b"submessage",u"tmux_response",b"tmux_response",u"transaction_response",b"transaction_response",u"variable_response",b"variable_response"]) -> builtins.bool: ...
+    def ClearField(self, field_name: typing_extensions.Literal[u"activate_response",b"activate_response",u"batch_response",b"batch_response",u"close_response",b"close_response",u"color_preset_response",b"color_preset_response",u"create_tab_response",b"create_tab_response",u"error",b"error",u"focus_response",b"focus_response",u"get_broadcast_domains_response",b"get_broadcast_domains_response",u"get_buffer_response",b"get_buffer_response",u"get_performance_counters_response",b"get_performance_counters_response",u"get_profile_property_response",b"get_profile_property_response",u"get_prompt_response",b"get_prompt_response",u"get_property_response",b"get_property_response",u"get_system_metrics_response",b"get_system_metrics_response",u"id",b"id",u"inject_response",b"inject_response",u"invoke_function_response",b"invoke_function_response",u"list_profiles_response",b"list_profiles_response",u"list_prompts_response",b"list_prompts_response",u"list_sessions_response",b"list_sessions_response",u"menu_item_response",b"menu_item_response",u"notification",b"notification",u"notification_response",b"notification_response",u"preferences_response",b"preferences_response",u"register_tool_response",b"register_tool_response",u"reorder_tabs_response",b"reorder_tabs_response",u"restart_session_response",b"restart_session_response",u"saved_arrangement_response",b"saved_arrangement_response",u"selection_response",b"selection_response",u"send_text_response",b"send_text_response",u"server_originated_rpc_result_response",b"server_originated_rpc_result_response",u"set_broadcast_domains_response",b"set_broadcast_domains_response",u"set_profile_property_response",b"set_profile_property_response",u"set_property_response",b"set_property_response",u"set_tab_layout_response",b"set_tab_layout_response",u"split_pane_response",b"split_pane_response",u"status_bar_component_response",b"status_bar_component_response",u"submessage",b"submessage",u"tmux_response",b"tmux_response",u"transaction_response",b"transaction_response",u"variable_response",b"variable_response"]) -> None: ...
+    def WhichOneof(self, oneof_group: typing_extensions.Literal[u"submessage",b"submessage"]) -> typing_extensions.Literal["error","get_buffer_response","get_prompt_response","transaction_response","notification_response","register_tool_response","set_profile_property_response","list_sessions_response","send_text_response","create_tab_response","split_pane_response","get_profile_property_response","set_property_response","get_property_response","inject_response","activate_response","variable_response","saved_arrangement_response","focus_response","list_profiles_response","server_originated_rpc_result_response","restart_session_response","menu_item_response","set_tab_layout_response","get_broadcast_domains_response","tmux_response","reorder_tabs_response","preferences_response","color_preset_response","selection_response","status_bar_component_response","set_broadcast_domains_response","close_response","invoke_function_response","list_prompts_response","batch_response","get_system_metrics_response","get_performance_counters_response","notification"]: ...
 global___ServerOriginatedMessage = ServerOriginatedMessage
 
 class InvokeFunctionRequest(google.protobuf.message.Message):
@@ -2501,20 +2531,44 @@ class VariableMonitorRequest(google.protobuf.message.Message):
     NAME_FIELD_NUMBER: builtins.int
     SCOPE_FIELD_NUMBER: builtins.int
     IDENTIFIER_FIELD_NUMBER: builtins.int
+    COALESCING_INTERVAL_FIELD_NUMBER: builtins.int
+    PREDICATE_FIELD_NUMBER: builtins.int
     name: typing.Text = ...
     scope: global___VariableScope.V = ...
     identifier: typing.Text = ...
+    coalescing_interval: builtins.float = ...
+
+    @property
+    def predicate(self) -> global___VariableValuePredicate: ...
 
     def __init__(self,
         *,
         name : typing.Optional[typing.Text] = ...,
         scope : typing.Optional[global___VariableScope.V] = ...,
         identifier : typing.Optional[typing.Text] = ...,
+        coalescing_interval : typing.Optional[builtins.float] = ...,
+        predicate : typing.Optional[global___VariableValuePredicate] = ...,
         ) -> None: ...
-    def HasField(self, field_name: typing_extensions.Literal[u"identifier",b"identifier",u"name",b"name",u"scope",b"scope"]) -> builtins.bool: ...
-    def ClearField(self, field_name: typing_extensions.Literal[u"identifier",b"identifier",u"name",b"name",u"scope",b"scope"]) -> None: ...
+    def HasField(self, field_name: typing_extensions.Literal[u"coalescing_interval",b"coalescing_interval",u"identifier",b"identifier",u"name",b"name",u"predicate",b"predicate",u"scope",b"scope"]) -> builtins.bool: ...
+    def ClearField(self, field_name: typing_extensions.Literal[u"coalescing_interval",b"coalescing_interval",u"identifier",b"identifier",u"name",b"name",u"predicate",b"predicate",u"scope",b"scope"]) -> None: ...
 global___VariableMonitorRequest = VariableMonitorRequest
 
+class VariableValuePredicate(google.protobuf.message.Message):
+    DESCRIPTOR: google.protobuf.descriptor.Descriptor = ...
+    REGEX_FIELD_NUMBER: builtins.int
+    MINIMUM_CHANGE_FIELD_NUMBER: builtins.int
+    regex: typing.Text = ...
+    minimum_change: builtins.float = ...
+
+    def __init__(self,
+        *,
+        regex : typing.Optional[typing.Text] = ...,
+        minimum_change : typing.Optional[builtins.float] = ...,
+        ) -> None: ...
+    def HasField(self, field_name: typing_extensions.Literal[u"minimum_change",b"minimum_change",u"regex",b"regex"]) -> builtins.bool: ...
+    def ClearField(self, field_name: typing_extensions.Literal[u"minimum_change",b"minimum_change",u"regex",b"regex"]) -> None: ...
+global___VariableValuePredicate = VariableValuePredicate
+
 class ProfileChangeRequest(google.protobuf.message.Message):
     DESCRIPTOR: google.protobuf.descriptor.Descriptor = ...
     GUID_FIELD_NUMBER: builtins.int
@@ -2540,6 +2594,22 @@ class PromptMonitorRequest(google.protobuf.message.Message):
     def ClearField(self, field_name: typing_extensions.Literal[u"modes",b"modes"]) -> None: ...
 global___PromptMonitorRequest = PromptMonitorRequest
 
+class ScreenUpdateMonitorRequest(google.protobuf.message.Message):
+    DESCRIPTOR: google.protobuf.descriptor.Descriptor = ...
+    INCLUDE_CHANGED_LINES_FIELD_NUMBER: builtins.int
+    MAX_UPDATES_PER_SECOND_FIELD_NUMBER: builtins.int
+    include_changed_lines: builtins.bool = ...
+    max_updates_per_second: builtins.float = ...
+
+    def __init__(self,
+        *,
+        include_changed_lines : typing.Optional[builtins.bool] = ...,
+        max_updates_per_second : typing.Optional[builtins.float] = ...,
+        ) -> None: ...
+    def HasField(self, field_name: typing_extensions.Literal[u"include_changed_lines",b"include_changed_lines",u"max_updates_per_second",b"max_updates_per_second"]) -> builtins.bool: ...
+    def ClearField(self, field_name: typing_extensions.Literal[u"include_changed_lines",b"include_changed_lines",u"max_updates_per_second",b"max_updates_per_second"]) -> None: ...
+global___ScreenUpdateMonitorRequest = ScreenUpdateMonitorRequest
+
 class NotificationRequest(google.protobuf.message.Message):
     DESCRIPTOR: google.protobuf.descriptor.Descriptor = ...
     SESSION_FIELD_NUMBER: builtins.int
@@ -2551,6 +2621,7 @@ class NotificationRequest(google.protobuf.message.Message):
     PROFILE_CHANGE_REQUEST_FIELD_NUMBER: builtins.int
     KEYSTROKE_FILTER_REQUEST_FIELD_NUMBER: builtins.int
     PROMPT_MONITOR_REQUEST_FIELD_NUMBER: builtins.int
+    SCREEN_UPDATE_MONITOR_REQUEST_FIELD_NUMBER: builtins.int
     session: typing.Text = ...
     subscribe: builtins.bool = ...
     notification_type: global___NotificationType.V = ...
@@ -2573,6 +2644,9 @@ class NotificationRequest(google.protobuf.message.Message):
     @property
     def prompt_monitor_request(self) -> global___PromptMonitorRequest: ...
 
+    @property
+    def screen_update_monitor_request(self) -> global___ScreenUpdateMonitorRequest: ...
+
     def __init__(self,
         *,
         session : typing.Optional[typing.Text] = ...,
@@ -2584,10 +2658,11 @@ class NotificationRequest(google.protobuf.message.Message):
         profile_change_request : typing.Optional[global___ProfileChangeRequest] = ...,
         keystroke_filter_request : typing.Optional[global___KeystrokeFilterRequest] = ...,
         prompt_monitor_request : typing.Optional[global___PromptMonitorRequest] = ...,
+        screen_update_monitor_request : typing.Optional[global___ScreenUpdateMonitorRequest] = ...,
         ) -> None: ...
-    def HasField(self, field_name: typing_extensions.Literal[u"arguments",b"arguments",u"keystroke_filter_request",b"keystroke_filter_request",u"keystroke_monitor_request",b"keystroke_monitor_request",u"notification_type",b"notification_type",u"profile_change_request",b"profile_change_request",u"prompt_monitor_request",b"prompt_monitor_request",u"rpc_registration_request",b"rpc_registration_request",u"session",b"session",u"subscribe",b"subscribe",u"variable_monitor_request",b"variable_monitor_request"]) -> builtins.bool: ...
-    def ClearField(self, field_name: typing_extensions.Literal[u"arguments",b"arguments",u"keystroke_filter_request",b"keystroke_filter_request",u"keystroke_monitor_request",b"keystroke_monitor_request",u"notification_type",b"notification_type",u"profile_change_request",b"profile_change_request",u"prompt_monitor_request",b"prompt_monitor_request",u"rpc_registration_request",b"rpc_registration_request",u"session",b"session",u"subscribe",b"subscribe",u"variable_monitor_request",b"variable_monitor_request"]) -> None: ...
-    def WhichOneof(self, oneof_group: typing_extensions.Literal[u"arguments",b"arguments"]) -> typing_extensions.Literal["rpc_registration_request","keystroke_monitor_request","variable_monitor_request","profile_change_request","keystroke_filter_request","prompt_monitor_request"]: ...
+    def HasField(self, field_name: typing_extensions.Literal[u"arguments",b"arguments",u"keystroke_filter_request",b"keystroke_filter_request",u"keystroke_monitor_request",b"keystroke_monitor_request",u"notification_type",b"notification_type",u"profile_change_request",b"profile_change_request",u"prompt_monitor_request",b"prompt_monitor_request",u"rpc_registration_request",b"rpc_registration_request",u"screen_update_monitor_request",b"screen_update_monitor_request",u"session",b"session",u"subscribe",b"subscribe",u"variable_monitor_request",b"variable_monitor_request"]) -> builtins.bool: ...
+    def ClearField(self, field_name: typing_extensions.Literal[u"arguments",b"arguments",u"keystroke_filter_request",b"keystroke_filter_request",u"keystroke_monitor_request",b"keystroke_monitor_request",u"notification_type",b"notification_type",u"profile_change_request",b"profile_change_request",u"prompt_monitor_request",b"prompt_monitor_request",u"rpc_registration_request",b"rpc_registration_request",u"screen_update_monitor_request",b"screen_update_monitor_request",u"session",b"session",u"subscribe",b"subscribe",u"variable_monitor_request",b"variable_monitor_request"]) -> None: ...
+    def WhichOneof(self, oneof_group: typing_extensions.Literal[u"arguments",b"arguments"]) -> typing_extensions.Literal["rpc_registration_request","keystroke_monitor_request","variable_monitor_request","profile_change_request","keystroke_filter_request","prompt_monitor_request","screen_update_monitor_request"]: ...
 global___NotificationRequest = NotificationRequest
 
 class NotificationResponse(google.protobuf.message.Message):
@@ -2839,16 +2914,47 @@ global___KeystrokeNotification = KeystrokeNotification
 class ScreenUpdateNotification(google.protobuf.message.Message):
     DESCRIPTOR: google.protobuf.descriptor.Descriptor = ...
     SESSION_FIELD_NUMBER: builtins.int
+    CHANGED_LINES_FIELD_NUMBER: builtins.int
+    CURSOR_FIELD_NUMBER: builtins.int
+    OVERFLOW_FIELD_NUMBER: builtins.int
     session: typing.Text = ...
+    overflow: builtins.int = ...
+
+    @property
+    def changed_lines(self) -> google.protobuf.internal.containers.RepeatedCompositeFieldContainer[global___ScreenUpdateLine]: ...
+
+    @property
+    def cursor(self) -> global___Coord: ...
 
     def __init__(self,
         *,
         session : typing.Optional[typing.Text] = ...,
+        changed_lines : typing.Optional[typing.Iterable[global___ScreenUpdateLine]] = ...,
+        cursor : typing.Optional[global___Coord] = ...,
+        overflow : typing.Optional[builtins.int] = ...,
         ) -> None: ...
-    def HasField(self, field_name: typing_extensions.Literal[u"session",b"session"]) -> builtins.bool: ...
-    def ClearField(self, field_name: typing_extensions.Literal[u"session",b"session"]) -> None: ...
+    def HasField(self, field_name: typing_extensions.Literal[u"cursor",b"cursor",u"overflow",b"overflow",u"session",b"session"]) -> builtins.bool: ...
+    def ClearField(self, field_name: typing_extensions.Literal[u"changed_lines",b"changed_lines",u"cursor",b"cursor",u"overflow",b"overflow",u"session",b"session"]) -> None: ...
 global___ScreenUpdateNotification = ScreenUpdateNotification
 
+class ScreenUpdateLine(google.protobuf.message.Message):
+    DESCRIPTOR: google.protobuf.descriptor.Descriptor = ...
+    LINE_FIELD_NUMBER: builtins.int
+    CONTENTS_FIELD_NUMBER: builtins.int
+    line: builtins.int = ...
+
+    @property
+    def contents(self) -> global___LineContents: ...
+
+    def __init__(self,
+        *,
+        line : typing.Optional[builtins.int] = ...,
+        contents : typing.Optional[global___LineContents] = ...,
+        ) -> None: ...
+    def HasField(self, field_name: typing_extensions.Literal[u"contents",b"contents",u"line",b"line"]) -> builtins.bool: ...
+    def ClearField(self, field_name: typing_extensions.Literal[u"contents",b"contents",u"line",b"line"]) -> None: ...
+global___ScreenUpdateLine = ScreenUpdateLine
+
 class PromptNotificationPrompt(google.protobuf.message.Message):
     DESCRIPTOR: google.protobuf.descriptor.Descriptor = ...
     PLACEHOLDER_FIELD_NUMBER: builtins.int
@@ -3062,7 +3168,11 @@ class GetBufferRequest(google.protobuf.message.Message):
     DESCRIPTOR: google.protobuf.descriptor.Descriptor = ...
     SESSION_FIELD_NUMBER: builtins.int
     LINE_RANGE_FIELD_NUMBER: builtins.int
+    MAX_LINES_FIELD_NUMBER: builtins.int
+    CONTINUATION_TOKEN_FIELD_NUMBER: builtins.int
     session: typing.Text = ...
+    max_lines: builtins.int = ...
+    continuation_token: typing.Text = ...
 
     @property
     def line_range(self) -> global___LineRange: ...
@@ -3071,9 +3181,11 @@ class GetBufferRequest(google.protobuf.message.Message):
         *,
         session : typing.Optional[typing.Text] = ...,
         line_range : typing.Optional[global___LineRange] = ...,
+        max_lines : typing.Optional[builtins.int] = ...,
+        continuation_token : typing.Optional[typing.Text] = ...,
         ) -> None: ...
-    def HasField(self, field_name: typing_extensions.Literal[u"line_range",b"line_range",u"session",b"session"]) -> builtins.bool: ...
-    def ClearField(self, field_name: typing_extensions.Literal[u"line_range",b"line_range",u"session",b"session"]) -> None: ...
+    def HasField(self, field_name: typing_extensions.Literal[u"continuation_token",b"continuation_token",u"line_range",b"line_range",u"max_lines",b"max_lines",u"session",b"session"]) -> builtins.bool: ...
+    def ClearField(self, field_name: typing_extensions.Literal[u"continuation_token",b"continuation_token",u"line_range",b"line_range",u"max_lines",b"max_lines",u"session",b"session"]) -> None: ...
 global___GetBufferRequest = GetBufferRequest
 
 class GetBufferResponse(google.protobuf.message.Message):
@@ -3097,8 +3209,10 @@ class GetBufferResponse(google.protobuf.message.Message):
     CURSOR_FIELD_NUMBER: builtins.int
     NUM_LINES_ABOVE_SCREEN_FIELD_NUMBER: builtins.int
     WINDOWED_COORD_RANGE_FIELD_NUMBER: builtins.int
+    CONTINUATION_TOKEN_FIELD_NUMBER: builtins.int
     status: global___GetBufferResponse.Status.V = ...
     num_lines_above_screen: builtins.int = ...
+    continuation_token: typing.Text = ...
 
     @property
     def range(self) -> global___Range: ...
@@ -3120,9 +3234,10 @@ class GetBufferResponse(google.protobuf.message.Message):
         cursor : typing.Optional[global___Coord] = ...,
         num_lines_above_screen : typing.Optional[builtins.int] = ...,
         windowed_coord_range : typing.Optional[global___WindowedCoordRange] = ...,
+        continuation_token : typing.Optional[typing.Text] = ...,
         ) -> None: ...
-    def HasField(self, field_name: typing_extensions.Literal[u"cursor",b"cursor",u"num_lines_above_screen",b"num_lines_above_screen",u"range",b"range",u"status",b"status",u"windowed_coord_range",b"windowed_coord_range"]) -> builtins.bool: ...
-    def ClearField(self, field_name: typing_extensions.Literal[u"contents",b"contents",u"cursor",b"cursor",u"num_lines_above_screen",b"num_lines_above_screen",u"range",b"range",u"status",b"status",u"windowed_coord_range",b"windowed_coord_range"]) -> None: ...
+    def HasField(self, field_name: typing_extensions.Literal[u"continuation_token",b"continuation_token",u"cursor",b"cursor",u"num_lines_above_screen",b"num_lines_above_screen",u"range",b"range",u"status",b"status",u"windowed_coord_range",b"windowed_coord_range"]) -> builtins.bool: ...
+    def ClearField(self, field_name: typing_extensions.Literal[u"contents",b"contents",u"continuation_token",b"continuation_token",u"cursor",b"cursor",u"num_lines_above_screen",b"num_lines_above_screen",u"range",b"range",u"status",b"status",u"windowed_coord_range",b"windowed_coord_range"]) -> None: ...
 global___GetBufferResponse = GetBufferResponse
 
 class GetPromptRequest(google.protobuf.message.Message):
@@ -3434,6 +3549,138 @@ class TransactionResponse(google.protobuf.message.Message):
     def ClearField(self, field_name: typing_extensions.Literal[u"status",b"status"]) -> None: ...
 global___TransactionResponse = TransactionResponse
 
+class BatchRequest(google.protobuf.message.Message):
+    DESCRIPTOR: google.protobuf.descriptor.Descriptor = ...
+    REQUESTS_FIELD_NUMBER: builtins.int
+    ATOMIC_FIELD_NUMBER: builtins.int
+    atomic: builtins.bool = ...
+
+    @property
+    def requests(self) -> google.protobuf.internal.containers.RepeatedCompositeFieldContainer[global___ClientOriginatedMessage]: ...
+
+    def __init__(self,
+        *,
+        requests : typing.Optional[typing.Iterable[global___ClientOriginatedMessage]] = ...,
+        atomic : typing.Optional[builtins.bool] = ...,
+        ) -> None: ...
+    def HasField(self, field_name: typing_extensions.Literal[u"atomic",b"atomic"]) -> builtins.bool: ...
+    def ClearField(self, field_name: typing_extensions.Literal[u"atomic",b"atomic",u"requests",b"requests"]) -> None: ...
+global___BatchRequest = BatchRequest
+
+class BatchResponse(google.protobuf.message.Message):
+    DESCRIPTOR: google.protobuf.descriptor.Descriptor = ...
+    RESPONSES_FIELD_NUMBER: builtins.int
+
+    @property
+    def responses(self) -> google.protobuf.internal.containers.RepeatedCompositeFieldContainer[global___ServerOriginatedMessage]: ...
+
+    def __init__(self,
+        *,
+        responses : typing.Optional[typing.Iterable[global___ServerOriginatedMessage]] = ...,
+        ) -> None: ...
+    def ClearField(self, field_name: typing_extensions.Literal[u"responses",b"responses"]) -> None: ...
+global___BatchResponse = BatchResponse
+
+class GetSystemMetricsRequest(google.protobuf.message.Message):
+    DESCRIPTOR: google.protobuf.descriptor.Descriptor = ...
+
+    def __init__(self,
+        ) -> None: ...
+global___GetSystemMetricsRequest = GetSystemMetricsRequest
+
+class GetSystemMetricsResponse(google.protobuf.message.Message):
+    DESCRIPTOR: google.protobuf.descriptor.Descriptor = ...
+    class NetworkThroughput(google.protobuf.message.Message):
+        DESCRIPTOR: google.protobuf.descriptor.Descriptor = ...
+        BYTES_PER_SECOND_READ_FIELD_NUMBER: builtins.int
+        BYTES_PER_SECOND_WRITE_FIELD_NUMBER: builtins.int
+        bytes_per_second_read: builtins.float = ...
+        bytes_per_second_write: builtins.float = ...
+
+        def __init__(self,
+            *,
+            bytes_per_second_read : typing.Optional[builtins.float] = ...,
+            bytes_per_second_write : typing.Optional[builtins.float] = ...,
+            ) -> None: ...
+        def HasField(self, field_name: typing_extensions.Literal[u"bytes_per_second_read",b"bytes_per_second_read",u"bytes_per_second_write",b"bytes_per_second_write"]) -> builtins.bool: ...
+        def ClearField(self, field_name: typing_extensions.Literal[u"bytes_per_second_read",b"bytes_per_second_read",u"bytes_per_second_write",b"bytes_per_second_write"]) -> None: ...
+
+    SAMPLING_INTERVAL_FIELD_NUMBER: builtins.int
+    CPU_UTILIZATION_FIELD_NUMBER: builtins.int
+    MEMORY_UTILIZATION_FIELD_NUMBER: builtins.int
+    PHYSICAL_MEMORY_FIELD_NUMBER: builtins.int
+    NETWORK_THROUGHPUT_FIELD_NUMBER: builtins.int
+    sampling_interval: builtins.float = ...
+    cpu_utilization: google.protobuf.internal.containers.RepeatedScalarFieldContainer[builtins.float] = ...
+    memory_utilization: google.protobuf.internal.containers.RepeatedScalarFieldContainer[builtins.float] = ...
+    physical_memory: builtins.int = ...
+
+    @property
+    def network_throughput(self) -> google.protobuf.internal.containers.RepeatedCompositeFieldContainer[global___GetSystemMetricsResponse.NetworkThroughput]: ...
+
+    def __init__(self,
+        *,
+        sampling_interval : typing.Optional[builtins.float] = ...,
+        cpu_utilization : typing.Optional[typing.Iterable[builtins.float]] = ...,
+        memory_utilization : typing.Optional[typing.Iterable[builtins.float]] = ...,
+        physical_memory : typing.Optional[builtins.int] = ...,
+        network_throughput : typing.Optional[typing.Iterable[global___GetSystemMetricsResponse.NetworkThroughput]] = ...,
+        ) -> None: ...
+    def HasField(self, field_name: typing_extensions.Literal[u"physical_memory",b"physical_memory",u"sampling_interval",b"sampling_interval"]) -> builtins.bool: ...
+    def ClearField(self, field_name: typing_extensions.Literal[u"cpu_utilization",b"cpu_utilization",u"memory_utilization",b"memory_utilization",u"network_throughput",b"network_throughput",u"physical_memory",b"physical_memory",u"sampling_interval",b"sampling_interval"]) -> None: ...
+global___GetSystemMetricsResponse = GetSystemMetricsResponse
+
+class GetPerformanceCountersRequest(google.protobuf.message.Message):
+    DESCRIPTOR: google.protobuf.descriptor.Descriptor = ...
+
+    def __init__(self,
+        ) -> None: ...
+global___GetPerformanceCountersRequest = GetPerformanceCountersRequest
+
+class GetPerformanceCountersResponse(google.protobuf.message.Message):
+    DESCRIPTOR: google.protobuf.descriptor.Descriptor = ...
+    class Counter(google.protobuf.message.Message):
+        DESCRIPTOR: google.protobuf.descriptor.Descriptor = ...
+        NAME_FIELD_NUMBER: builtins.int
+        COUNT_FIELD_NUMBER: builtins.int
+        TOTAL_TIME_FIELD_NUMBER: builtins.int
+        P50_FIELD_NUMBER: builtins.int
+        P90_FIELD_NUMBER: builtins.int
+        P99_FIELD_NUMBER: builtins.int
+        MAX_FIELD_NUMBER: builtins.int
+        name: typing.Text = ...
+        count: builtins.int = ...
+        total_time: builtins.float = ...
+        p50: builtins.float = ...
+        p90: builtins.float = ...
+        p99: builtins.float = ...
+        max: builtins.float = ...
+
+        def __init__(self,
+            *,
+            name : typing.Optional[typing.Text] = ...,
+            count : typing.Optional[builtins.int] = ...,
+            total_time : typing.Optional[builtins.float] = ...,
+            p50 : typing.Optional[builtins.float] = ...,
+            p90 : typing.Optional[builtins.float] = ...,
+            p99 : typing.Optional[builtins.float] = ...,
+            max : typing.Optional[builtins.float] = ...,
+            ) -> None: ...
+        def HasField(self, field_name: typing_extensions.Literal[u"count",b"count",u"max",b"max",u"name",b"name",u"p50",b"p50",u"p90",b"p90",u"p99",b"p99",u"total_time",b"total_time"]) -> builtins.bool: ...
+        def ClearField(self, field_name: typing_extensions.Literal[u"count",b"count",u"max",b"max",u"name",b"name",u"p50",b"p50",u"p90",b"p90",u"p99",b"p99",u"total_time",b"total_time"]) -> None: ...
+
+    COUNTERS_FIELD_NUMBER: builtins.int
+
+    @property
+    def counters(self) -> google.protobuf.internal.containers.RepeatedCompositeFieldContainer[global___GetPerformanceCountersResponse.Counter]: ...
+
+    def __init__(self,
+        *,
+        counters : typing.Optional[typing.Iterable[global___GetPerformanceCountersResponse.Counter]] = ...,
+        ) -> None: ...
+    def ClearField(self, field_name: typing_extensions.Literal[u"counters",b"counters"]) -> None: ...
+global___GetPerformanceCountersResponse = GetPerformanceCountersResponse
+
 class LineRange(google.protobuf.message.Message):
     DESCRIPTOR: google.protobuf.descriptor.Descriptor = ...
     SCREEN_CONTENTS_ONLY_FIELD_NUMBER: builtins.int
@@ -0,0 +1,121 @@
+"""Provides a way to send many API calls to iTerm2 in a single message."""
+import asyncio
+import contextvars
+import typing
+
+import iterm2.api_pb2
+import iterm2.connection
+import iterm2.rpc
+
+_CURRENT_BATCH: contextvars.ContextVar = contextvars.ContextVar(
+    "iterm2.batch", default=None)
+
+
+class _Batch:
+    """Collects the first request made by each of a set of tasks."""
+    # pylint: disable=too-few-public-methods
+    def __init__(self, connection):
+        self.connection = connection
+        self.tasks: typing.List[asyncio.Task] = []
+        self.registered: typing.Set[asyncio.Task] = set()
+        self.requests: typing.List[iterm2.api_pb2.ClientOriginatedMessage] = []
+        self.futures: typing.List[asyncio.Future] = []
+        self.closed = False
+        self.changed = asyncio.Event()
+
+    def accepts(self, connection) -> bool:
+        """Can the current task add a request to this batch?"""
+        task = asyncio.current_task()
+        return (not self.closed and
+                connection is self.connection and
+                task in self.tasks and
+                task not in self.registered)
+
+    async def async_call(self, request):
+        """Adds a request and waits for its response."""
+        future = asyncio.get_event_loop().create_future()
+        self.registered.add(asyncio.current_task())
+        self.requests.append(request)
+        self.futures.append(future)
+        self.changed.set()
+        return await future
+
+    async def async_wait_for_tasks(self):
+        """Waits until every task has either made a request or finished."""
+        while True:
+            waiting = [task for task in self.tasks
+                       if not task.done() and task not in self.registered]
+            if not waiting:
+                break
+            self.changed.clear()
+            changed = asyncio.ensure_future(self.changed.wait())
+            await asyncio.wait(
+                waiting + [changed], return_when=asyncio.FIRST_COMPLETED)
+            changed.cancel()
+        self.closed = True
+
+    async def async_send(self, atomic: bool):
+        """Sends the collected requests and delivers their responses."""
+        if not self.requests:
+            return
+        # pylint: disable=no-member
+        try:
+            responses = await iterm2.rpc.async_batch(
+                self.connection, self.requests, atomic)
+        except Exception as exception:  # pylint: disable=broad-except
+            for future in self.futures:
+                future.set_exception(exception)
+            return
+        for future, response in zip(self.futures, responses):
+            future.set_result(response)
+
+
+def current_batch(
+        connection: iterm2.connection.Connection) -> typing.Optional[_Batch]:
+    """Returns the batch the current task's next request belongs to, if
+    any."""
+    batch = _CURRENT_BATCH.get()
+    if batch is not None and batch.accepts(connection):
+        return batch
+    return None
+
+
+async def async_gather_batched(
+        connection: iterm2.connection.Connection,
+        *coros: typing.Awaitable,
+        atomic: bool = False) -> typing.List[typing.Any]:
+    """
+    Runs coroutines concurrently, like `asyncio.gather`, but sends the first
+    request each one makes to iTerm2 together in one message.
+
+    This is much faster than awaiting the calls one at a time when there are
+    many of them because they're all handled in one pass of iTerm2's main
+    loop. Any requests a coroutine makes after its first one are sent
+    normally.
+
+    :param connection: The connection to iTerm2.
+    :param coros: Coroutines that make API calls, such as
+        `session.async_get_variable("name")`.
+    :param atomic: If `True`, nothing else happens in between the batched
+        requests, including requests from other scripts, as in a
+        :class:`~iterm2.Transaction`.
+
+    :returns: The coroutines' results in the same order.
+
+    .. code-block:: python
+
+        names = await iterm2.async_gather_batched(
+            connection,
+            *[session.async_get_variable("name")
+              for session in app.current_window.current_tab.sessions])
+    """
+    batch = _Batch(connection)
+    token = _CURRENT_BATCH.set(batch)
+    try:
+        # Tasks copy the current context, so each one sees the batch.
+        batch.tasks = [asyncio.ensure_future(coro) for coro in coros]
+    finally:
+        _CURRENT_BATCH.reset(token)
+    await batch.async_wait_for_tasks()
+    await batch.async_send(atomic)
+    return await asyncio.gather(*batch.tasks)
@@ -149,7 +149,8 @@ async def async_filter_keystrokes(
 
 
 async def async_subscribe_to_screen_update_notification(
-        connection, callback, session=None):
+        connection, callback, session=None, include_changed_lines=False,
+        max_updates_per_second=None):
     """
     Registers a callback to be run when the screen contents change.
 
@@ -157,15 +158,27 @@ async def async_subscribe_to_screen_update_notification(
     :param callback: A coroutine taking two arguments: an :class:`Connection`
         and iterm2.api_pb2.ScreenUpdateNotification..
     :param session: The session to monitor, or None.
+    :param include_changed_lines: If True, notifications include the lines
+        that changed since the previous notification, the cursor position, and
+        how many lines scrolled off the top of the screen.
+    :param max_updates_per_second: If set, notifications are coalesced so no
+        more than this many are posted per second.
 
     :returns: A token that can be passed to unsubscribe.
     """
+    monitor_request = None
+    if include_changed_lines or max_updates_per_second:
+        monitor_request = iterm2.api_pb2.ScreenUpdateMonitorRequest()
+        monitor_request.include_changed_lines = include_changed_lines
+        if max_updates_per_second:
+            monitor_request.max_updates_per_second = max_updates_per_second
     return await _async_subscribe(
         connection,
         True,
         iterm2.api_pb2.NOTIFY_ON_SCREEN_UPDATE,
         callback,
-        session=session)
+        session=session,
+        screen_update_monitor_request=monitor_request)
 
 
 async def async_subscribe_to_prompt_notification(
@@ -384,7 +397,8 @@ async def async_subscribe_to_server_originated_rpc_notification(
 
 
 async def async_subscribe_to_variable_change_notification(
-        connection, callback, scope, name, identifier):
+        connection, callback, scope, name, identifier,
+        coalescing_interval=None, regex=None, minimum_change=None):
     """
     Registers a callback to be invoked when a variable changes.
 
@@ -396,6 +410,13 @@ async def async_subscribe_to_variable_change_notification(
     :param identifier: The identifier of the object (window, tab, or session)
         being monitored, or None for app. Sometimes this will be "all" or
         "active".
+    :param coalescing_interval: If set, changes are coalesced so at most one
+        notification is posted per this many seconds. It has the latest value
+        and is skipped if that equals the last value reported.
+    :param regex: If set, only values matching this regular expression are
+        reported. Strings are matched as-is and other values as JSON.
+    :param minimum_change: If set, a numeric value is only reported when it
+        differs from the last one reported by at least this much.
     """
     # pylint: disable=no-member
     request = iterm2.api_pb2.VariableMonitorRequest()
@@ -405,6 +426,12 @@ async def async_subscribe_to_variable_change_notification(
         request.identifier = identifier
     else:
         request.identifier = ""
+    if coalescing_interval:
+        request.coalescing_interval = coalescing_interval
+    if regex is not None:
+        request.predicate.regex = regex
+    if minimum_change:
+        request.predicate.minimum_change = minimum_change
     key = (request.scope,
            request.identifier,
            request.name,
@@ -466,7 +493,8 @@ async def _async_subscribe(
         key=None,
         profile_change_request=None,
         prompt_monitor_modes=None,
-        keystroke_filter_request=None):
+        keystroke_filter_request=None,
+        screen_update_monitor_request=None):
     """Note: session argument is ignored for variable-change notifications."""
     _register_helper_if_needed()
     transformed_session = session if session is not None else "all"
@@ -494,7 +522,8 @@ async def _async_subscribe(
         variable_monitor_request,
         profile_change_request,
         prompt_monitor_modes,
-        keystroke_filter_request)
+        keystroke_filter_request,
+        screen_update_monitor_request)
     status = response.notification_response.status
     # pylint: disable=no-member
     status_ok = (
@@ -0,0 +1,71 @@
+"""Provides iTerm2's own counters for its hot paths."""
+import typing
+
+import iterm2.connection
+import iterm2.rpc
+
+
+class PerformanceCounter:
+    """
+    How often iTerm2 did one kind of work and how long it took.
+
+    Times are totals since iTerm2 launched. Frequent events are counted every
+    time but only timed now and then, so `total_time` is an estimate and the
+    percentiles are accurate to within a factor of two.
+    """
+    def __init__(self, proto):
+        self.__proto = proto
+
+    @property
+    def name(self) -> str:
+        """What was measured, such as `read`, `parse`, or `frame_prep`."""
+        return self.__proto.name
+
+    @property
+    def count(self) -> int:
+        """Number of times it happened."""
+        return self.__proto.count
+
+    @property
+    def total_time(self) -> float:
+        """Estimated total time spent, in seconds."""
+        return self.__proto.total_time
+
+    @property
+    def p50(self) -> float:
+        """Median duration in milliseconds."""
+        return self.__proto.p50
+
+    @property
+    def p90(self) -> float:
+        """90th percentile duration in milliseconds."""
+        return self.__proto.p90
+
+    @property
+    def p99(self) -> float:
+        """99th percentile duration in milliseconds."""
+        return self.__proto.p99
+
+    @property
+    def max(self) -> float:
+        """Longest duration in milliseconds."""
+        return self.__proto.max
+
+
+async def async_get_performance_counters(
+        connection: iterm2.connection.Connection) -> typing.List[
+            PerformanceCounter]:
+    """
+    Fetches iTerm2's counters for reading from ptys, parsing, executing
+    tokens, running triggers, preparing and drawing frames, saving state, and
+    rebuilding the process cache.
+
+    These are always being collected, so fetching them costs nothing extra.
+    To measure a workload, fetch them before and after and compare.
+
+    :param connection: The connection to iTerm2.
+    :returns: One counter per kind of work.
+    """
+    response = await iterm2.rpc.async_get_performance_counters(connection)
+    return [PerformanceCounter(p)
+            for p in response.get_performance_counters_response.counters]
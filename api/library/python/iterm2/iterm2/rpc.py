@@ -2,6 +2,7 @@
 import json
 
 import iterm2.api_pb2
+import iterm2.batch
 import iterm2.connection
 
 ACTIVATE_RAISE_ALL_WINDOWS = 1
@@ -43,7 +44,8 @@ async def async_notification_request(
         variable_monitor_request=None,
         profile_change_request=None,
         prompt_monitor_modes=None,
-        keystroke_filter_request=None):
+        keystroke_filter_request=None,
+        screen_update_monitor_request=None):
     """
     Requests a change to a notification subscription.
 
@@ -61,6 +63,8 @@ async def async_notification_request(
         profile change monitor) or None.
     prompt_monitor_modes: The prompt monitor modes (only for registering a
         prompt monitor) or None.
+    screen_update_monitor_request: The screen update monitor request (only
+        for registering a screen update handler) or None.
 
     Returns: iterm2.api_pb2.ServerOriginatedMessage
     """
@@ -88,6 +92,9 @@ async def async_notification_request(
         for mode in prompt_monitor_modes:
             request.notification_request.prompt_monitor_request.modes.append(
                 mode)
+    if screen_update_monitor_request:
+        request.notification_request.screen_update_monitor_request.CopyFrom(
+            screen_update_monitor_request)
     request.notification_request.subscribe = subscribe
     request.notification_request.notification_type = notification_type
     return await _async_call(connection, request)
@@ -205,20 +212,30 @@ async def async_create_tab(
 async def async_get_screen_contents(
         connection,
         session,
-        windowed_coord_range=None):
+        windowed_coord_range=None,
+        max_lines=None,
+        continuation_token=None):
     """
     Gets screen contents, including both the mutable area and history.
 
     connection: A connected iterm2.Connection.
     session: Session ID
     windowed_coord_range: The range of characters to fetch.
+    max_lines: If given, the maximum number of lines to return. The
+      response's continuation_token is set if more remain.
+    continuation_token: From a previous response. Fetches the next lines of
+      that range; windowed_coord_range is ignored.
 
     Returns: iterm2.api_pb2.ServerOriginatedMessage
     """
     request = _alloc_request()
     if session is not None:
         request.get_buffer_request.session = session
-    if windowed_coord_range:
+    if max_lines:
+        request.get_buffer_request.max_lines = max_lines
+    if continuation_token:
+        request.get_buffer_request.continuation_token = continuation_token
+    elif windowed_coord_range:
         request.get_buffer_request.line_range.windowed_coord_range.CopyFrom(
             windowed_coord_range.proto)
     else:
@@ -282,6 +299,27 @@ async def async_start_transaction(connection):
     return await _async_call(connection, request)
 
 
+async def async_batch(connection, requests, atomic):
+    """
+    Sends several requests in one message.
+
+    connection: A connected iterm2.Connection
+    requests: A list of iterm2.api_pb2.ClientOriginatedMessage.
+    atomic: If True, other connections' requests are not handled until all of
+        these have been answered.
+
+    Returns: A list of iterm2.api_pb2.ServerOriginatedMessage with one response
+        per request, in order.
+    """
+    request = _alloc_request()
+    request.batch_request.SetInParent()
+    for subrequest in requests:
+        request.batch_request.requests.add().CopyFrom(subrequest)
+    request.batch_request.atomic = atomic
+    response = await _async_call(connection, request)
+    return list(response.batch_response.responses)
+
+
 async def async_end_transaction(connection):
     """
     Ends a transaction begun with start_transaction()
@@ -863,6 +901,20 @@ async def async_invoke_method(connection, receiver, invocation, timeout):
             response.invoke_function_response.error.error_reason))
     return json.loads(response.invoke_function_response.success.json_result)
 
+
+async def async_get_system_metrics(connection):
+    """Fetches recent CPU, memory, and network utilization."""
+    request = _alloc_request()
+    request.get_system_metrics_request.SetInParent()
+    return await _async_call(connection, request)
+
+
+async def async_get_performance_counters(connection):
+    """Fetches iTerm2's counters for its hot paths."""
+    request = _alloc_request()
+    request.get_performance_counters_request.SetInParent()
+    return await _async_call(connection, request)
+
 # Private --------------------------------------------------------------------
 
 
@@ -881,8 +933,12 @@ def _alloc_request():
 
 
 async def _async_call(connection, request):
-    await connection.async_send_message(request)
-    response = await connection.async_dispatch_until_id(request.id)
+    batch = iterm2.batch.current_batch(connection)
+    if batch:
+        response = await batch.async_call(request)
+    else:
+        await connection.async_send_message(request)
+        response = await connection.async_dispatch_until_id(request.id)
     if response.HasField("error"):
         raise RPCException(response.error)
     return response
@@ -177,3 +177,88 @@ class ScreenStreamer:
         raise iterm2.rpc.RPCException(
             iterm2.api_pb2.GetBufferResponse.Status.Name(
                 result.get_buffer_response.status))
+
+
+class ScreenUpdate:
+    """Describes how the screen changed since the previous update.
+
+    To keep a copy of the screen up to date, first move every line up by
+    `overflow` lines and then replace the lines in `changed_lines`. The first
+    update includes every line of the screen."""
+    def __init__(self, proto):
+        self.__proto = proto
+
+    @property
+    def changed_lines(self) -> typing.Dict[int, LineContents]:
+        """
+        :returns: A dict mapping a line number (0 is the top of the screen) to
+            its new contents.
+        """
+        return dict(
+            (changed.line, LineContents(changed.contents))
+            for changed in self.__proto.changed_lines)
+
+    @property
+    def cursor_coord(self) -> iterm2.util.Point:
+        """
+        :returns: The cursor's position. Unlike elsewhere, y is relative to
+            the top of the screen.
+        """
+        return iterm2.util.Point(
+            self.__proto.cursor.x, self.__proto.cursor.y)
+
+    @property
+    def overflow(self) -> int:
+        """
+        :returns: The number of lines that scrolled off the top of the screen
+            since the previous update.
+        """
+        return self.__proto.overflow
+
+
+class ScreenDeltaStreamer:
+    """An asyncio context manager for receiving changes to the screen.
+
+    Unlike :class:`ScreenStreamer`, each update carries only the lines that
+    changed, so there's no need to fetch the whole screen after every change.
+    No updates are dropped if you're slow to call async_get().
+
+    Don't create this yourself. Use Session.get_screen_delta_streamer()
+    instead. See its docstring for more info."""
+    def __init__(self, connection, session_id, max_updates_per_second=None):
+        assert session_id != "all"
+        self.connection = connection
+        self.session_id = session_id
+        self.max_updates_per_second = max_updates_per_second
+        self.queue: asyncio.Queue = asyncio.Queue()
+        self.token = None
+
+    async def __aenter__(self):
+        async def async_on_update(_connection, message):
+            """Called on screen update. Enqueues the update message."""
+            await self.queue.put(message)
+
+        self.token = (
+            await iterm2.notifications.
+            async_subscribe_to_screen_update_notification(
+                self.connection,
+                async_on_update,
+                self.session_id,
+                include_changed_lines=True,
+                max_updates_per_second=self.max_updates_per_second))
+        return self
+
+    async def __aexit__(self, exc_type, exc, _tb):
+        try:
+            await iterm2.notifications.async_unsubscribe(
+                self.connection, self.token)
+        except iterm2.notifications.SubscriptionException:
+            pass
+
+    async def async_get(self) -> ScreenUpdate:
+        """
+        Blocks until the screen changes.
+
+        :returns: A :class:`ScreenUpdate` describing the change.
+        """
+        return ScreenUpdate(await self.queue.get())
@@ -402,6 +402,65 @@ class Session:
             iterm2.api_pb2.GetBufferResponse.Status.Name(
                 response.get_buffer_response.status))
 
+    async def async_get_contents_in_pages(
+            self,
+            first_line: int,
+            number_of_lines: int,
+            page_size: int = 1000
+            ) -> typing.AsyncIterator[
+                typing.List['iterm2.screen.LineContents']]:
+        """
+        Like :meth:`async_get_contents` but fetches the lines a page at a
+        time, so a large range doesn't have to arrive in one huge message.
+
+        Pages don't need to be fetched in a transaction. Lines that are lost
+        from the start of history before their page is fetched are skipped.
+
+        :param first_line: The first line number to fetch.
+        :param number_of_lines: The number of lines to fetch.
+        :param page_size: The most lines to fetch at once.
+        :returns: An async iterator of lists of
+            :class:`iterm2.screen.LineContents`.
+
+        :throws: :class:`~iterm2.rpc.RPCException` if something goes wrong.
+
+        .. code-block:: python
+          :caption: Example that prints the whole history of `session`.
+
+          li = await session.async_get_line_info()
+          total = li.scrollback_buffer_height + li.mutable_area_height
+          async for lines in session.async_get_contents_in_pages(
+                  li.overflow, total):
+              for line in lines:
+                  print(line.string)
+
+        """
+        coord_range = iterm2.util.WindowedCoordRange(
+            iterm2.util.CoordRange(
+                iterm2.util.Point(0, first_line),
+                iterm2.util.Point(0, first_line + number_of_lines)))
+        token = None
+        while True:
+            response = await iterm2.rpc.async_get_screen_contents(
+                self.connection,
+                self.session_id,
+                coord_range,
+                max_lines=page_size,
+                continuation_token=token)
+            # pylint: disable=no-member
+            if (response.get_buffer_response.status !=
+                    iterm2.api_pb2.GetBufferResponse.Status.Value("OK")):
+                raise iterm2.rpc.RPCException(
+                    iterm2.api_pb2.GetBufferResponse.Status.Name(
+                        response.get_buffer_response.status))
+            contents = iterm2.screen.ScreenContents(
+                response.get_buffer_response)
+            yield [contents.line(i) for i in range(contents.number_of_lines)]
+            if not response.get_buffer_response.HasField(
+                    "continuation_token"):
+                return
+            token = response.get_buffer_response.continuation_token
+
     def get_screen_streamer(
             self, want_contents: bool = True) -> iterm2.screen.ScreenStreamer:
         """
@@ -431,6 +490,39 @@ class Session:
             self.__session_id,
             want_contents=want_contents)
 
+    def get_screen_delta_streamer(
+            self,
+            max_updates_per_second: typing.Optional[float] = None
+            ) -> iterm2.screen.ScreenDeltaStreamer:
+        """
+        Provides an interface for receiving only the parts of the screen that
+        change.
+
+        This is cheaper than :meth:`get_screen_streamer` when you need to
+        track the screen's contents because each update carries just the
+        changed lines rather than requiring the whole screen to be fetched.
+
+        :param max_updates_per_second: If set, changes are coalesced so no more
+            than this many updates arrive each second.
+
+        :returns: A new screen delta streamer for this session.
+
+        .. code-block:: python
+          :caption: Example that keeps a copy of the screen up to date.
+
+          async with session.get_screen_delta_streamer() as streamer:
+            lines = {}
+            while condition():
+              update = await streamer.async_get()
+              lines = {y - update.overflow: line for y, line in lines.items()
+                       if y >= update.overflow}
+              lines.update(update.changed_lines)
+        """
+        return iterm2.screen.ScreenDeltaStreamer(
+            self.connection,
+            self.__session_id,
+            max_updates_per_second=max_updates_per_second)
+
     async def async_send_text(
             self, text: str, suppress_broadcast: bool = False) -> None:
         """
@@ -963,6 +1055,27 @@ class Session:
             await iterm2.rpc.async_invoke_method(
                 self.connection, self.session_id, invocation, -1))
 
+    async def async_get_memory_usage(self) -> typing.Dict[str, int]:
+        """
+        Returns the approximate number of bytes used by this session.
+
+        The keys are `scrollback`, `grid`, `dvr` (instant replay), `marks`,
+        `images`, `captured_output`, and `total`. When the session uses the
+        GPU renderer, `glyph_textures` gives the size of its glyph textures.
+        Those may be shared with other sessions so they are not part of
+        `total`.
+
+        The total is also kept in the `session.memoryUsage` variable, which
+        is updated periodically.
+
+        :returns: A dictionary mapping category to bytes.
+        """
+        invocation = iterm2.util.invocation_string(
+            "iterm2.get_memory_usage",
+            {})
+        return await iterm2.rpc.async_invoke_method(
+            self.connection, self.session_id, invocation, -1)
+
     async def async_add_annotation(self, range: iterm2.util.CoordRange, text: str):
         """
         Adds an annotation.
@@ -0,0 +1,77 @@
+"""Provides the system-wide measurements that iTerm2's status bar shows."""
+import typing
+
+import iterm2.connection
+import iterm2.rpc
+
+
+class NetworkThroughput:
+    """Bytes per second received and sent over all network interfaces."""
+    # pylint: disable=too-few-public-methods
+    def __init__(self, proto):
+        self.__proto = proto
+
+    @property
+    def bytes_per_second_read(self) -> float:
+        """Bytes per second received."""
+        return self.__proto.bytes_per_second_read
+
+    @property
+    def bytes_per_second_write(self) -> float:
+        """Bytes per second sent."""
+        return self.__proto.bytes_per_second_write
+
+
+class SystemMetrics:
+    """
+    Recent history of CPU, memory, and network utilization.
+
+    Each history is a list that is oldest first with one sample per
+    `sampling_interval` seconds. Use :func:`async_get_system_metrics` to get
+    one of these.
+    """
+    def __init__(self, proto):
+        self.__proto = proto
+
+    @property
+    def sampling_interval(self) -> float:
+        """Seconds between samples."""
+        return self.__proto.sampling_interval
+
+    @property
+    def cpu_utilization(self) -> typing.List[float]:
+        """Fraction of time the CPUs were busy, from 0 to 1."""
+        return list(self.__proto.cpu_utilization)
+
+    @property
+    def memory_utilization(self) -> typing.List[float]:
+        """Fraction of physical memory in use, from 0 to 1."""
+        return list(self.__proto.memory_utilization)
+
+    @property
+    def physical_memory(self) -> int:
+        """Bytes of physical memory."""
+        return self.__proto.physical_memory
+
+    @property
+    def network_throughput(self) -> typing.List[NetworkThroughput]:
+        """Network throughput samples."""
+        return [NetworkThroughput(p) for p in self.__proto.network_throughput]
+
+
+async def async_get_system_metrics(
+        connection: iterm2.connection.Connection) -> SystemMetrics:
+    """
+    Fetches the recent history of system-wide measurements.
+
+    iTerm2 samples these once for everyone who is interested (such as status
+    bar components), so polling this is cheaper than measuring them yourself.
+    After a request, sampling continues for a minute even if nothing else
+    needs it, so a script that polls more often than that gets a continuous
+    history. The history may be short or empty on the first request.
+
+    :param connection: The connection to iTerm2.
+    :returns: The recent measurements.
+    """
+    response = await iterm2.rpc.async_get_system_metrics(connection)
+    return SystemMetrics(response.get_system_metrics_response)
@@ -33,6 +33,16 @@ class VariableMonitor:
    :param identifier: A tab, window, or session identifier. Must correspond to
        the passed-in scope. If the scope is `APP` this should be None. If the
        scope is `SESSION` or `WINDOW` the identifier may be "all" or "active".
+   :param coalescing_interval: If set, changes are coalesced so at most one is
+       reported per this many seconds, and a value equal to the last one
+       reported is skipped.
+   :param regex: If set, only values matching this regular expression are
+       reported. Strings are matched as-is and other values as JSON.
+   :param minimum_change: If set, a numeric value is only reported when it
+       differs from the last one reported by at least this much.
+
+   Coalescing and filtering happen in iTerm2, so values that wouldn't be
+   reported are never sent to the script.
 
     .. seealso::
         * Example ":ref:`colorhost_example`"
@@ -56,11 +66,17 @@ class VariableMonitor:
             connection: iterm2.connection.Connection,
             scope: VariableScopes,
             name: str,
-            identifier: typing.Optional[str]):
+            identifier: typing.Optional[str],
+            coalescing_interval: typing.Optional[float] = None,
+            regex: typing.Optional[str] = None,
+            minimum_change: typing.Optional[float] = None):
         self.__connection = connection
         self.__scope = scope
         self.__name = name
         self.__identifier = identifier
+        self.__coalescing_interval = coalescing_interval
+        self.__regex = regex
+        self.__minimum_change = minimum_change
         self.__token = None
         self.__queue: asyncio.Queue = asyncio.Queue(
             loop=asyncio.get_event_loop())
@@ -77,7 +93,10 @@ class VariableMonitor:
                 callback,
                 self.__scope.value,
                 self.__name,
-                self.__identifier))
+                self.__identifier,
+                coalescing_interval=self.__coalescing_interval,
+                regex=self.__regex,
+                minimum_change=self.__minimum_change))
         return self
 
     async def async_get(self) -> typing.Any:
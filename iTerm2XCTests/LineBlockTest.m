@@ -0,0 +1,718 @@
+//
+//  LineBlockTest.m
+//  iTerm2XCTests
+//
+//  Created by agent on 10/14/26.
+//
+
+#import <XCTest/XCTest.h>
+
+#import "FindContext.h"
+#import "LineBlock.h"
+#import "LineBufferHelpers.h"
+#import "ScreenChar.h"
+#import "iTermCompactLineStorage.h"
+#import "iTermRegexLiteral.h"
+#import "iTermScrollbackSpillFile.h"
+
+static const NSInteger kUnicodeVersion = 9;
+static const int kLineBlockTestWidth = 80;
+
+@interface LineBlockTest : XCTestCase<iTermLineBlockObserver>
+@end
+
+@implementation LineBlockTest {
+    int _numberOfInflations;
+}
+
+#pragma mark - iTermLineBlockObserver
+
+- (void)lineBlockDidChange:(LineBlock *)lineBlock {
+}
+
+- (void)lineBlockDidInflate:(LineBlock *)lineBlock {
+    _numberOfInflations++;
+}
+
+#pragma mark - Helpers
+
+- (screen_char_t)defaultChar {
+    screen_char_t c;
+    memset(&c, 0, sizeof(c));
+    c.foregroundColor = ALTSEM_DEFAULT;
+    c.foregroundColorMode = ColorModeAlternate;
+    c.backgroundColor = ALTSEM_DEFAULT;
+    c.backgroundColorMode = ColorModeAlternate;
+    return c;
+}
+
+- (screen_char_t)continuation {
+    screen_char_t c = [self defaultChar];
+    c.code = EOL_HARD;
+    return c;
+}
+
+// Returns an array of screen_char_t for |s|. Wide characters take two cells.
+- (NSMutableData *)lineForString:(NSString *)s {
+    NSMutableData *data = [NSMutableData dataWithLength:(s.length * 2 + 1) * sizeof(screen_char_t)];
+    int len = 0;
+    BOOL foundDwc = NO;
+    StringToScreenChars(s,
+                        (screen_char_t *)data.mutableBytes,
+                        [self defaultChar],
+                        [self defaultChar],
+                        &len,
+                        NO,
+                        NULL,
+                        &foundDwc,
+                        iTermUnicodeNormalizationNone,
+                        kUnicodeVersion);
+    data.length = len * sizeof(screen_char_t);
+    return data;
+}
+
+// Returns a line whose attributes change from cell to cell, including 24-bit colors and URL codes.
+- (NSMutableData *)styledLineOfLength:(int)length seed:(int)seed {
+    NSMutableData *data = [NSMutableData dataWithLength:length * sizeof(screen_char_t)];
+    screen_char_t *line = (screen_char_t *)data.mutableBytes;
+    for (int i = 0; i < length; i++) {
+        const int n = i + seed;
+        line[i] = [self defaultChar];
+        line[i].code = 'a' + n % 26;
+        line[i].bold = n % 2;
+        line[i].italic = (n / 2) % 2;
+        line[i].underline = (n % 5) == 0;
+        if (n % 3 == 0) {
+            line[i].foregroundColorMode = ColorMode24bit;
+            line[i].foregroundColor = n % 256;
+            line[i].fgGreen = (n * 7) % 256;
+            line[i].fgBlue = (n * 13) % 256;
+        } else {
+            line[i].foregroundColorMode = ColorModeNormal;
+            line[i].foregroundColor = n % 16;
+        }
+        if (n % 7 == 0) {
+            line[i].urlCode = 1 + n % 5;
+        }
+    }
+    return data;
+}
+
+- (BOOL)appendLine:(NSData *)line toBlock:(LineBlock *)block partial:(BOOL)partial {
+    return [block appendLine:(screen_char_t *)line.bytes
+                      length:(int)(line.length / sizeof(screen_char_t))
+                     partial:partial
+                       width:kLineBlockTestWidth
+                   timestamp:0
+                continuation:[self continuation]];
+}
+
+- (void)assertCells:(const screen_char_t *)actual
+             length:(int)actualLength
+        equalToLine:(NSData *)expected
+            message:(NSString *)message {
+    const int expectedLength = (int)(expected.length / sizeof(screen_char_t));
+    XCTAssertEqual(actualLength, expectedLength, @"%@", message);
+    const screen_char_t *cells = (const screen_char_t *)expected.bytes;
+    for (int i = 0; i < MIN(actualLength, expectedLength); i++) {
+        screen_char_t a = actual[i];
+        screen_char_t e = cells[i];
+        XCTAssertEqual(a.code, e.code, @"%@ at %d", message, i);
+        XCTAssertEqual(a.complexChar, e.complexChar, @"%@ at %d", message, i);
+        XCTAssertEqual(a.urlCode, e.urlCode, @"%@ at %d", message, i);
+        XCTAssertTrue(ScreenCharacterAttributesEqual(&a, &e), @"%@ at %d", message, i);
+    }
+}
+
+- (void)assertBlock:(LineBlock *)block containsLines:(NSArray<NSData *> *)lines {
+    XCTAssertEqual([block numRawLines], (int)lines.count);
+    for (int i = 0; i < MIN([block numRawLines], (int)lines.count); i++) {
+        [self assertCells:[block rawLine:i]
+                   length:[block getRawLineLength:i]
+              equalToLine:lines[i]
+                  message:[NSString stringWithFormat:@"line %d", i]];
+    }
+}
+
+- (NSArray<NSData *> *)mixedLines {
+    NSMutableArray<NSData *> *lines = [NSMutableArray array];
+    for (int i = 0; i < 20; i++) {
+        if (i % 2) {
+            [lines addObject:[self styledLineOfLength:10 + i * 7 seed:i]];
+        } else {
+            [lines addObject:[self lineForString:[NSString stringWithFormat:@"Line %d: the quick brown fox", i]]];
+        }
+    }
+    [lines addObject:[self lineForString:@""]];
+    return lines;
+}
+
+- (void)spinUntil:(BOOL (^)(void))block {
+    NSDate *timeout = [NSDate dateWithTimeIntervalSinceNow:5];
+    while (!block() && [timeout timeIntervalSinceNow] > 0) {
+        [[NSRunLoop currentRunLoop] runMode:NSDefaultRunLoopMode
+                                 beforeDate:[NSDate dateWithTimeIntervalSinceNow:0.001]];
+    }
+}
+
+- (LineBlock *)blockWithLines:(NSArray<NSData *> *)lines {
+    LineBlock *block = [[[LineBlock alloc] initWithRawBufferSize:16384] autorelease];
+    for (NSData *line in lines) {
+        XCTAssertTrue([self appendLine:line toBlock:block partial:NO]);
+    }
+    return block;
+}
+
+// Counts wrapped lines one raw line at a time, which is right when there are no double-width
+// characters.
+- (int)naiveNumberOfWrappedLinesForLengths:(NSArray<NSNumber *> *)lengths width:(int)width {
+    int count = 0;
+    for (NSNumber *length in lengths) {
+        count += 1 + MAX(0, length.intValue - 1) / width;
+    }
+    return count;
+}
+
+- (NSData *)lineOfLength:(int)length {
+    NSMutableData *data = [NSMutableData dataWithLength:length * sizeof(screen_char_t)];
+    screen_char_t *line = (screen_char_t *)data.mutableBytes;
+    for (int i = 0; i < length; i++) {
+        line[i] = [self defaultChar];
+        line[i].code = 'a' + i % 26;
+    }
+    return data;
+}
+
+#pragma mark - Wrapped Line Counts
+
+- (void)testNumberOfWrappedLinesMatchesNaiveCount {
+    // Includes empty lines and lines right around multiples of common widths.
+    NSMutableArray<NSNumber *> *lengths = [NSMutableArray array];
+    for (int i = 0; i < 300; i++) {
+        const int length = (i * 37) % 250;
+        [lengths addObject:@(length)];
+    }
+    [lengths addObjectsFromArray:@[ @0, @1, @79, @80, @81, @160, @161, @240 ]];
+    LineBlock *block = [[[LineBlock alloc] initWithRawBufferSize:200000] autorelease];
+    for (NSNumber *length in lengths) {
+        XCTAssertTrue([self appendLine:[self lineOfLength:length.intValue] toBlock:block partial:NO]);
+    }
+    for (int width = 1; width <= 260; width++) {
+        XCTAssertEqual([block getNumLinesWithWrapWidth:width],
+                       [self naiveNumberOfWrappedLinesForLengths:lengths width:width],
+                       @"width %d", width);
+    }
+
+    // Appending changes the generation, so the index must be rebuilt. Width 80 is still cached
+    // from the loop above.
+    [lengths addObject:@500];
+    XCTAssertTrue([self appendLine:[self lineOfLength:500] toBlock:block partial:NO]);
+    XCTAssertEqual([block getNumLinesWithWrapWidth:80],
+                   [self naiveNumberOfWrappedLinesForLengths:lengths width:80]);
+    XCTAssertEqual([block getNumLinesWithWrapWidth:7],
+                   [self naiveNumberOfWrappedLinesForLengths:lengths width:7]);
+}
+
+- (void)testNumberOfWrappedLinesAfterPartialAppend {
+    LineBlock *block = [[[LineBlock alloc] initWithRawBufferSize:10000] autorelease];
+    XCTAssertTrue([self appendLine:[self lineOfLength:100] toBlock:block partial:NO]);
+    XCTAssertTrue([self appendLine:[self lineOfLength:70] toBlock:block partial:YES]);
+    XCTAssertEqual([block getNumLinesWithWrapWidth:80], 3);
+    XCTAssertEqual([block getNumLinesWithWrapWidth:50], 4);
+
+    // Continuing the partial line grows the last raw line to 160 cells.
+    XCTAssertTrue([self appendLine:[self lineOfLength:90] toBlock:block partial:NO]);
+    XCTAssertEqual([block numRawLines], 2);
+    XCTAssertEqual([block getNumLinesWithWrapWidth:80],
+                   [self naiveNumberOfWrappedLinesForLengths:@[ @100, @160 ] width:80]);
+    XCTAssertEqual([block getNumLinesWithWrapWidth:50],
+                   [self naiveNumberOfWrappedLinesForLengths:@[ @100, @160 ] width:50]);
+}
+
+- (void)testNumberOfWrappedLinesAfterDroppingLines {
+    NSMutableArray<NSNumber *> *lengths = [NSMutableArray arrayWithArray:@[ @10, @200, @0, @81, @45, @300 ]];
+    LineBlock *block = [[[LineBlock alloc] initWithRawBufferSize:10000] autorelease];
+    for (NSNumber *length in lengths) {
+        XCTAssertTrue([self appendLine:[self lineOfLength:length.intValue] toBlock:block partial:NO]);
+    }
+    const int width = 40;
+    XCTAssertEqual([block getNumLinesWithWrapWidth:width],
+                   [self naiveNumberOfWrappedLinesForLengths:lengths width:width]);
+
+    // Drop the first raw line and two of the five wrapped lines of the second.
+    int charsDropped = 0;
+    XCTAssertEqual([block dropLines:3 withWidth:width chars:&charsDropped], 3);
+    XCTAssertEqual(charsDropped, 10 + 2 * width);
+    [lengths removeObjectAtIndex:0];
+    lengths[0] = @(200 - 2 * width);
+    for (int w = 1; w <= 100; w++) {
+        XCTAssertEqual([block getNumLinesWithWrapWidth:w],
+                       [self naiveNumberOfWrappedLinesForLengths:lengths width:w],
+                       @"width %d", w);
+    }
+}
+
+// Blocks that may have double-width characters can't use the length index, because a
+// double-width character never straddles a line break.
+- (void)testNumberOfWrappedLinesWithDoubleWidthCharacters {
+    LineBlock *block = [[[LineBlock alloc] initWithRawBufferSize:10000] autorelease];
+    block.mayHaveDoubleWidthCharacter = YES;
+    // Four cells: a, the DWC and its right half, and b.
+    NSData *line = [self lineForString:@"a\u5168b"];
+    XCTAssertEqual(line.length, 4 * sizeof(screen_char_t));
+    XCTAssertTrue([self appendLine:line toBlock:block partial:NO]);
+
+    // At width 2 the DWC can't start in the second column, so it takes three lines: "a", the
+    // DWC, and "b". The naive count would be two.
+    XCTAssertEqual([block getNumLinesWithWrapWidth:2], 3);
+    XCTAssertEqual([block getNumLinesWithWrapWidth:3], 2);
+    XCTAssertEqual([block getNumLinesWithWrapWidth:4], 1);
+    // Width 1 can't show a DWC at all, so every cell is its own line.
+    XCTAssertEqual([block getNumLinesWithWrapWidth:1], 4);
+}
+
+#pragma mark - Compact Storage
+
+- (void)testCompactThenReadBack {
+    NSArray<NSData *> *lines = [self mixedLines];
+    LineBlock *block = [self blockWithLines:lines];
+    const int wrappedLines = [block getNumLinesWithWrapWidth:kLineBlockTestWidth];
+
+    [block compact];
+    XCTAssertTrue([block isCompact]);
+    XCTAssertEqual([block numRawLines], (int)lines.count);
+    XCTAssertEqual([block getNumLinesWithWrapWidth:kLineBlockTestWidth], wrappedLines);
+
+    [self assertBlock:block containsLines:lines];
+    XCTAssertFalse([block isCompact]);
+}
+
+- (void)testCompactPlainTextSavesMemory {
+    NSMutableArray<NSData *> *lines = [NSMutableArray array];
+    for (int i = 0; i < 100; i++) {
+        [lines addObject:[self lineForString:[NSString stringWithFormat:@"%d: The quick brown fox jumps over the lazy dog", i]]];
+    }
+    LineBlock *block = [self blockWithLines:lines];
+    [block shrinkToFit];
+    const NSInteger before = [block memoryUsage];
+    [block compact];
+    XCTAssertLessThan([block memoryUsage], before);
+    [self assertBlock:block containsLines:lines];
+}
+
+- (void)testAppendAfterCompaction {
+    NSMutableArray<NSData *> *lines = [[[self mixedLines] mutableCopy] autorelease];
+    LineBlock *block = [self blockWithLines:lines];
+    [block compact];
+
+    NSData *extra = [self lineForString:@"appended after compacting"];
+    XCTAssertTrue([self appendLine:extra toBlock:block partial:NO]);
+    [lines addObject:extra];
+    [self assertBlock:block containsLines:lines];
+
+    // Compacting again must encode the new line too.
+    [block compact];
+    XCTAssertTrue([block isCompact]);
+    [self assertBlock:block containsLines:lines];
+}
+
+- (void)testCompressedStorageRoundTrip {
+    NSMutableData *cells = [NSMutableData data];
+    for (NSData *line in [self mixedLines]) {
+        [cells appendData:line];
+    }
+    const int length = (int)(cells.length / sizeof(screen_char_t));
+    NSData *encoded = iTermCompactLineStorageEncode((const screen_char_t *)cells.bytes, length);
+    NSData *compressed = iTermCompactLineStorageCompress(encoded);
+    XCTAssertFalse(iTermCompactLineStorageIsCompressed(encoded));
+    XCTAssertTrue(iTermCompactLineStorageIsCompressed(compressed));
+    XCTAssertEqual(iTermCompactLineStorageLength(compressed), length);
+
+    NSMutableData *decoded = [NSMutableData dataWithLength:cells.length];
+    XCTAssertTrue(iTermCompactLineStorageDecode(compressed, (screen_char_t *)decoded.mutableBytes, length));
+    [self assertCells:(const screen_char_t *)decoded.bytes length:length equalToLine:cells message:@"decoded"];
+    XCTAssertFalse(iTermCompactLineStorageDecode(compressed, (screen_char_t *)decoded.mutableBytes, length - 1));
+}
+
+- (void)testCompressThenInflate {
+    NSMutableArray<NSData *> *lines = [NSMutableArray array];
+    for (int i = 0; i < 200; i++) {
+        [lines addObject:[self lineForString:[NSString stringWithFormat:@"%d: The quick brown fox jumps over the lazy dog", i % 10]]];
+    }
+    LineBlock *block = [self blockWithLines:lines];
+    [block addObserver:self];
+
+    // The contents can be read before the background compression finishes.
+    [block compress];
+    const NSInteger compactUsage = [block memoryUsage];
+    XCTAssertTrue([block isCompact]);
+    [self assertBlock:block containsLines:lines];
+    XCTAssertEqual(_numberOfInflations, 1);
+
+    // Once compressed the block uses less memory than the uncompressed compact form.
+    [block compress];
+    [self spinUntil:^BOOL{
+        return [block memoryUsage] < compactUsage;
+    }];
+    XCTAssertLessThan([block memoryUsage], compactUsage);
+    XCTAssertTrue([block isCompact]);
+    [self assertBlock:block containsLines:lines];
+    XCTAssertEqual(_numberOfInflations, 2);
+    XCTAssertFalse([block isCompact]);
+
+    [block removeObserver:self];
+}
+
+#pragma mark - Packed Cells
+
+// Returns cells that differ in every attribute the packed format stores, with a 24-bit background
+// and a URL code on every cell so the extras table sees many distinct entries.
+- (NSMutableData *)packedLineOfLength:(int)length seed:(int)seed {
+    NSMutableData *data = [self styledLineOfLength:length seed:seed];
+    screen_char_t *line = (screen_char_t *)data.mutableBytes;
+    for (int i = 0; i < length; i++) {
+        const int n = i + seed;
+        line[i].faint = (n / 3) % 2;
+        line[i].blink = (n % 11) == 0;
+        line[i].strikethrough = (n % 13) == 0;
+        line[i].underlineStyle = (n / 5) % 2 ? VT100UnderlineStyleCurly : VT100UnderlineStyleSingle;
+        line[i].backgroundColorMode = ColorMode24bit;
+        line[i].backgroundColor = (n * 3) % 256;
+        line[i].bgGreen = (n * 5) % 256;
+        line[i].bgBlue = (n * 11) % 256;
+        line[i].urlCode = n % 1000;
+    }
+    return data;
+}
+
+- (void)testPackedCellsRoundTrip {
+    NSData *cells = [self packedLineOfLength:5000 seed:0];
+    const int length = (int)(cells.length / sizeof(screen_char_t));
+    NSData *encoded = iTermCompactLineStorageEncode((const screen_char_t *)cells.bytes, length);
+
+    // Every cell differs from the last, so each gets packed into 8 bytes.
+    uint32_t magic = 0;
+    memcpy(&magic, encoded.bytes, sizeof(magic));
+    XCTAssertEqual(magic, (uint32_t)'iCP1');
+    XCTAssertLessThan(encoded.length, cells.length);
+    XCTAssertEqual(iTermCompactLineStorageLength(encoded), length);
+
+    NSMutableData *decoded = [NSMutableData dataWithLength:cells.length];
+    XCTAssertTrue(iTermCompactLineStorageDecode(encoded, (screen_char_t *)decoded.mutableBytes, length));
+    [self assertCells:(const screen_char_t *)decoded.bytes length:length equalToLine:cells message:@"packed"];
+
+    NSData *compressed = iTermCompactLineStorageCompress(encoded);
+    memset(decoded.mutableBytes, 0, decoded.length);
+    XCTAssertTrue(iTermCompactLineStorageDecode(compressed, (screen_char_t *)decoded.mutableBytes, length));
+    [self assertCells:(const screen_char_t *)decoded.bytes length:length equalToLine:cells message:@"compressed"];
+}
+
+// Too many distinct extras to index with 16 bits falls back to runs.
+- (void)testPackedCellsWithTooManyExtras {
+    const int length = 70000;
+    NSMutableData *cells = [self packedLineOfLength:length seed:0];
+    screen_char_t *line = (screen_char_t *)cells.mutableBytes;
+    for (int i = 0; i < length; i++) {
+        line[i].urlCode = i % 65536;
+        line[i].fgGreen = i / 65536;
+    }
+    NSData *encoded = iTermCompactLineStorageEncode(line, length);
+    uint32_t magic = 0;
+    memcpy(&magic, encoded.bytes, sizeof(magic));
+    XCTAssertNotEqual(magic, (uint32_t)'iCP1');
+
+    NSMutableData *decoded = [NSMutableData dataWithLength:cells.length];
+    XCTAssertTrue(iTermCompactLineStorageDecode(encoded, (screen_char_t *)decoded.mutableBytes, length));
+    [self assertCells:(const screen_char_t *)decoded.bytes length:length equalToLine:cells message:@"runs"];
+}
+
+- (void)testCompactPackedBlockThenReadBack {
+    NSMutableArray<NSData *> *lines = [NSMutableArray array];
+    for (int i = 0; i < 50; i++) {
+        [lines addObject:[self packedLineOfLength:1 + i * 5 seed:i]];
+    }
+    LineBlock *block = [self blockWithLines:lines];
+    [block shrinkToFit];
+    const NSInteger before = [block memoryUsage];
+
+    [block compact];
+    XCTAssertTrue([block isCompact]);
+    XCTAssertLessThan([block memoryUsage], before);
+    [self assertBlock:block containsLines:lines];
+}
+
+#pragma mark - Spilling
+
+- (void)testSpillThenReload {
+    iTermScrollbackSpillFile *file = [[[iTermScrollbackSpillFile alloc] init] autorelease];
+    XCTAssertNotNil(file);
+    NSArray<NSData *> *lines = [self mixedLines];
+    LineBlock *block = [self blockWithLines:lines];
+    const NSInteger before = [block memoryUsage];
+
+    [block spillToFile:file];
+    XCTAssertTrue([block isCompact]);
+    // The contents live in the file, not the heap.
+    const NSInteger spilledUsage = [block memoryUsage];
+    XCTAssertLessThan(spilledUsage, before);
+    [self assertBlock:block containsLines:lines];
+
+    // Unchanged since it was spilled, so compacting goes straight back to the mapping.
+    [block compact];
+    XCTAssertEqual([block memoryUsage], spilledUsage);
+    [self assertBlock:block containsLines:lines];
+}
+
+// A block modified after spilling must not go back to the stale mapping.
+- (void)testModifiedBlockDoesNotReuseStaleSpill {
+    iTermScrollbackSpillFile *file = [[[iTermScrollbackSpillFile alloc] init] autorelease];
+    XCTAssertNotNil(file);
+    NSMutableArray<NSData *> *lines = [[[self mixedLines] mutableCopy] autorelease];
+    LineBlock *block = [self blockWithLines:lines];
+    [block spillToFile:file];
+    const NSInteger spilledUsage = [block memoryUsage];
+    const NSInteger generation = block.generation;
+
+    NSData *extra = [self lineForString:@"appended after spilling"];
+    XCTAssertTrue([self appendLine:extra toBlock:block partial:NO]);
+    [lines addObject:extra];
+    XCTAssertNotEqual(block.generation, generation);
+
+    [block compact];
+    XCTAssertTrue([block isCompact]);
+    // Encoded again into the heap.
+    XCTAssertGreaterThan([block memoryUsage], spilledUsage);
+    [self assertBlock:block containsLines:lines];
+
+    // Spilling again writes the new contents.
+    [block spillToFile:file];
+    [self assertBlock:block containsLines:lines];
+}
+
+#pragma mark - Search Prefilters
+
+- (NSData *)lineWithCodes:(const unichar *)codes count:(int)count {
+    NSMutableData *data = [NSMutableData dataWithLength:count * sizeof(screen_char_t)];
+    screen_char_t *line = (screen_char_t *)data.mutableBytes;
+    for (int i = 0; i < count; i++) {
+        line[i] = [self defaultChar];
+        line[i].code = codes[i];
+    }
+    return data;
+}
+
+- (NSArray<NSString *> *)resultsOfFinding:(NSString *)needle
+                                     mode:(iTermFindMode)mode
+                                  options:(int)options
+                                  inBlock:(LineBlock *)block {
+    NSMutableArray *results = [NSMutableArray array];
+    [block findSubstring:needle
+                 options:options
+                    mode:mode
+                atOffset:(options & FindOptBackwards) ? -1 : 0
+                 results:results
+         multipleResults:YES];
+    NSMutableArray<NSString *> *ranges = [NSMutableArray array];
+    for (ResultRange *range in results) {
+        [ranges addObject:[NSString stringWithFormat:@"%d+%d", range->position, range->length]];
+    }
+    return ranges;
+}
+
+// Builds the same block with and without a trigram index and checks that every search finds the
+// same results in both. Returns the indexed block.
+- (LineBlock *)assertTrigramIndexPreservesResultsForNeedles:(NSArray<NSString *> *)needles
+                                                      build:(void (^)(LineBlock *block))build {
+    LineBlockSetIndexesTrigrams(YES);
+    LineBlock *indexed = [[[LineBlock alloc] initWithRawBufferSize:16384] autorelease];
+    LineBlockSetIndexesTrigrams(NO);
+    LineBlock *unindexed = [[[LineBlock alloc] initWithRawBufferSize:16384] autorelease];
+    build(indexed);
+    build(unindexed);
+    // The index is counted in the memory usage, which shows it exists.
+    XCTAssertGreaterThan([indexed memoryUsage], [unindexed memoryUsage]);
+
+    const iTermFindMode modes[] = {
+        iTermFindModeSmartCaseSensitivity,
+        iTermFindModeCaseSensitiveSubstring,
+        iTermFindModeCaseInsensitiveSubstring
+    };
+    const int options[] = { FindMultipleResults, FindMultipleResults | FindOptBackwards };
+    for (NSString *needle in needles) {
+        for (size_t m = 0; m < sizeof(modes) / sizeof(*modes); m++) {
+            for (size_t o = 0; o < sizeof(options) / sizeof(*options); o++) {
+                XCTAssertEqualObjects([self resultsOfFinding:needle mode:modes[m] options:options[o] inBlock:indexed],
+                                      [self resultsOfFinding:needle mode:modes[m] options:options[o] inBlock:unindexed],
+                                      @"needle %@ mode %d options %d", needle, (int)modes[m], options[o]);
+            }
+        }
+    }
+    return indexed;
+}
+
+- (void)assertBlock:(LineBlock *)block findsNeedle:(NSString *)needle mode:(iTermFindMode)mode {
+    XCTAssertGreaterThan([self resultsOfFinding:needle mode:mode options:FindMultipleResults inBlock:block].count, 0U,
+                         @"needle %@", needle);
+}
+
+- (void)testTrigramIndexWithCaseInsensitiveSearch {
+    NSArray<NSString *> *needles = @[ @"cafe", @"CAFÉ", @"café", @"CAFE\u0301", @"caf\u00e9", @"au lait", @"AU LAIT", @"quick brown",
+                                      @"QUICK", @"Quick", @"strasse", @"STRAßE", @"kelvin", @"\u212Aelvin",
+                                      @"missing" ];
+    LineBlock *block = [self assertTrigramIndexPreservesResultsForNeedles:needles build:^(LineBlock *block) {
+        for (NSString *string in @[ @"CAFÉ au lait", @"The Quick BROWN fox", @"STRASSE und straße", @"\u212Aelvin scale" ]) {
+            [self appendLine:[self lineForString:string] toBlock:block partial:NO];
+        }
+    }];
+    [self assertBlock:block findsNeedle:@"au lait" mode:iTermFindModeCaseInsensitiveSubstring];
+    [self assertBlock:block findsNeedle:@"quick brown" mode:iTermFindModeSmartCaseSensitivity];
+    // Decomposed, as pasted from a Finder filename. It matches the precomposed É even when
+    // case-sensitive.
+    [self assertBlock:block findsNeedle:@"CAFE\u0301" mode:iTermFindModeCaseSensitiveSubstring];
+
+    // Only ASCII, so case-insensitive searches use the index too.
+    needles = @[ @"straße", @"STRAßE", @"quick", @"QUICK", @"brown FOX", @"the", @"missing" ];
+    block = [self assertTrigramIndexPreservesResultsForNeedles:needles build:^(LineBlock *block) {
+        for (NSString *string in @[ @"The Quick BROWN fox", @"STRASSE" ]) {
+            [self appendLine:[self lineForString:string] toBlock:block partial:NO];
+        }
+    }];
+    [self assertBlock:block findsNeedle:@"brown FOX" mode:iTermFindModeCaseInsensitiveSubstring];
+    XCTAssertEqual([self resultsOfFinding:@"missing"
+                                     mode:iTermFindModeCaseInsensitiveSubstring
+                                  options:FindMultipleResults
+                                  inBlock:block].count, 0U);
+}
+
+- (void)testTrigramIndexWithDoubleWidthCharacters {
+    NSArray<NSString *> *needles = @[ @"ab\u5168cd", @"b\u5168c", @"abc", @"\u89d2abc\u6587", @"abcd", @"cd" ];
+    LineBlock *block = [self assertTrigramIndexPreservesResultsForNeedles:needles build:^(LineBlock *block) {
+        block.mayHaveDoubleWidthCharacter = YES;
+        for (NSString *string in @[ @"ab\u5168cd", @"\u5168\u89d2abc\u6587\u5b57" ]) {
+            [self appendLine:[self lineForString:string] toBlock:block partial:NO];
+        }
+    }];
+    [self assertBlock:block findsNeedle:@"b\u5168c" mode:iTermFindModeCaseSensitiveSubstring];
+    [self assertBlock:block findsNeedle:@"\u89d2abc\u6587" mode:iTermFindModeCaseSensitiveSubstring];
+}
+
+- (void)testTrigramIndexWithComplexCharacters {
+    NSArray<NSString *> *needles = @[ @"cafe\u0301", @"caf\u00e9", @"cafe", @"fe\u0301 n", @"noir",
+                                      @"e\u0301e\u0301", @"\U0001F642yz", @"xyz", @"yz 1" ];
+    LineBlock *block = [self assertTrigramIndexPreservesResultsForNeedles:needles build:^(LineBlock *block) {
+        for (NSString *string in @[ @"cafe\u0301 noir", @"e\u0301e\u0301e\u0301", @"x\U0001F642yz 123" ]) {
+            [self appendLine:[self lineForString:string] toBlock:block partial:NO];
+        }
+    }];
+    [self assertBlock:block findsNeedle:@"noir" mode:iTermFindModeCaseSensitiveSubstring];
+    [self assertBlock:block findsNeedle:@"yz 1" mode:iTermFindModeCaseSensitiveSubstring];
+}
+
+// Tab fillers and the right halves of double-width characters are dropped when a line is
+// converted to a string, so the characters on either side are adjacent.
+- (void)testTrigramIndexWithPrivateUseCells {
+    NSArray<NSString *> *needles = @[ @"abcd", @"bcd", @"abc", @"xyz", @"wxyz", @"ab" ];
+    LineBlock *block = [self assertTrigramIndexPreservesResultsForNeedles:needles build:^(LineBlock *block) {
+        const unichar tabs[] = { 'a', 'b', TAB_FILLER, TAB_FILLER, 'c', 'd' };
+        [self appendLine:[self lineWithCodes:tabs count:sizeof(tabs) / sizeof(*tabs)] toBlock:block partial:NO];
+        const unichar skip[] = { 'w', 'x', DWC_SKIP, 'y', 'z' };
+        [self appendLine:[self lineWithCodes:skip count:sizeof(skip) / sizeof(*skip)] toBlock:block partial:NO];
+    }];
+    [self assertBlock:block findsNeedle:@"abcd" mode:iTermFindModeCaseSensitiveSubstring];
+    [self assertBlock:block findsNeedle:@"wxyz" mode:iTermFindModeCaseSensitiveSubstring];
+}
+
+// A raw line appended in pieces must index the trigrams that span the pieces.
+- (void)testTrigramIndexWithWrappedLines {
+    NSArray<NSString *> *needles = @[ @"hello world", @"o wor", @"lo w", @"world and more end", @"e end",
+                                      @"abcd", @"bcd", @"missing" ];
+    LineBlock *block = [self assertTrigramIndexPreservesResultsForNeedles:needles build:^(LineBlock *block) {
+        [self appendLine:[self lineForString:@"hello wo"] toBlock:block partial:YES];
+        [self appendLine:[self lineForString:@"rld and more"] toBlock:block partial:YES];
+        [self appendLine:[self lineForString:@" end"] toBlock:block partial:NO];
+
+        const unichar first[] = { 'a', 'b', TAB_FILLER };
+        [self appendLine:[self lineWithCodes:first count:sizeof(first) / sizeof(*first)] toBlock:block partial:YES];
+        const unichar second[] = { TAB_FILLER, 'c', 'd' };
+        [self appendLine:[self lineWithCodes:second count:sizeof(second) / sizeof(*second)] toBlock:block partial:NO];
+    }];
+    XCTAssertEqual([block numRawLines], 2);
+    [self assertBlock:block findsNeedle:@"o wor" mode:iTermFindModeCaseSensitiveSubstring];
+    [self assertBlock:block findsNeedle:@"world and more end" mode:iTermFindModeCaseSensitiveSubstring];
+    [self assertBlock:block findsNeedle:@"abcd" mode:iTermFindModeCaseSensitiveSubstring];
+}
+
+// Searches with each regex and with an equivalent one whose alternation keeps it from having a
+// required literal, so the second search reads every line. Both must find the same results.
+- (void)assertRegexPrefilterPreservesResultsForPatterns:(NSArray<NSString *> *)patterns
+                                                inBlock:(LineBlock *)block {
+    const iTermFindMode modes[] = { iTermFindModeCaseSensitiveRegex, iTermFindModeCaseInsensitiveRegex };
+    const int options[] = { FindMultipleResults, FindMultipleResults | FindOptBackwards };
+    for (NSString *pattern in patterns) {
+        NSString *unfiltered = [NSString stringWithFormat:@"(?:%@)|[^\\s\\S]", pattern];
+        for (size_t m = 0; m < sizeof(modes) / sizeof(*modes); m++) {
+            const BOOL caseInsensitive = (modes[m] == iTermFindModeCaseInsensitiveRegex);
+            XCTAssertNil(iTermRegexRequiredLiteral(unfiltered, caseInsensitive));
+            for (size_t o = 0; o < sizeof(options) / sizeof(*options); o++) {
+                XCTAssertEqualObjects([self resultsOfFinding:pattern mode:modes[m] options:options[o] inBlock:block],
+                                      [self resultsOfFinding:unfiltered mode:modes[m] options:options[o] inBlock:block],
+                                      @"pattern %@ mode %d options %d", pattern, (int)modes[m], options[o]);
+            }
+        }
+    }
+}
+
+- (void)testRegexPrefilterPreservesResults {
+    LineBlock *block = [[[LineBlock alloc] initWithRawBufferSize:16384] autorelease];
+    block.mayHaveDoubleWidthCharacter = YES;
+    for (NSString *string in @[ @"CAFÉ au lait",
+                                @"The Quick BROWN fox",
+                                @"STRASSE und straße",
+                                @"\u212Aelvin scale",
+                                @"ab\u5168cd",
+                                @"\u5168\u89d2abc\u6587\u5b57",
+                                @"cafe\u0301 noir",
+                                @"x\U0001F642yz 123",
+                                @"xyz and xa, no emoji" ]) {
+        XCTAssertTrue([self appendLine:[self lineForString:string] toBlock:block partial:NO]);
+    }
+    NSArray<NSString *> *patterns = @[ @"quick", @"QUICK brown", @"qu.ck", @"caf", @"CAFÉ", @"au lait$",
+                                       @"^The", @"strasse", @"STRA", @"elvin", @"ab\u5168cd", @"b\u5168c",
+                                       @"abc", @"noir", @"fe\u0301 no", @"yz 1", @"x\U0001F642yz",
+                                       @"\\d{3}", @"z \\d", @"missing", @"mis+ing",
+                                       // The quantifier applies to the whole surrogate pair.
+                                       @"x\U0001F642?yz", @"x\U0001F642*yz", @"x\U0001F642{0,2}yz",
+                                       @"xa\U0001F600?", @"xa\U0001F600+" ];
+    for (NSString *pattern in @[ @"quick", @"caf", @"noir" ]) {
+        XCTAssertNotNil(iTermRegexRequiredLiteral(pattern, NO));
+        XCTAssertNotNil(iTermRegexRequiredLiteral(pattern, YES));
+    }
+    [self assertRegexPrefilterPreservesResultsForPatterns:patterns inBlock:block];
+    [self assertBlock:block findsNeedle:@"QUICK brown" mode:iTermFindModeCaseInsensitiveRegex];
+    [self assertBlock:block findsNeedle:@"fe\u0301 no" mode:iTermFindModeCaseSensitiveRegex];
+    [self assertBlock:block findsNeedle:@"yz 1" mode:iTermFindModeCaseSensitiveRegex];
+    [self assertBlock:block findsNeedle:@"x\U0001F642?yz and" mode:iTermFindModeCaseSensitiveRegex];
+    [self assertBlock:block findsNeedle:@"xa\U0001F600?, no" mode:iTermFindModeCaseSensitiveRegex];
+}
+
+- (void)testRegexPrefilterWithPrivateUseCellsAndWrappedLines {
+    LineBlock *block = [[[LineBlock alloc] initWithRawBufferSize:16384] autorelease];
+    const unichar tabs[] = { 'a', 'b', TAB_FILLER, TAB_FILLER, 'c', 'd' };
+    [self appendLine:[self lineWithCodes:tabs count:sizeof(tabs) / sizeof(*tabs)] toBlock:block partial:NO];
+    const unichar skip[] = { 'w', 'x', DWC_SKIP, 'y', 'z' };
+    [self appendLine:[self lineWithCodes:skip count:sizeof(skip) / sizeof(*skip)] toBlock:block partial:NO];
+    [self appendLine:[self lineForString:@"hello wo"] toBlock:block partial:YES];
+    [self appendLine:[self lineForString:@"rld and more"] toBlock:block partial:YES];
+    [self appendLine:[self lineForString:@" end"] toBlock:block partial:NO];
+    XCTAssertEqual([block numRawLines], 3);
+
+    NSArray<NSString *> *patterns = @[ @"abcd", @"bcd", @"ABCD", @"wxyz", @"x.z", @"hello world", @"o wor",
+                                       @"world and more end", @"e end$", @"lo w", @"missing" ];
+    [self assertRegexPrefilterPreservesResultsForPatterns:patterns inBlock:block];
+    [self assertBlock:block findsNeedle:@"abcd" mode:iTermFindModeCaseSensitiveRegex];
+    [self assertBlock:block findsNeedle:@"ABCD" mode:iTermFindModeCaseInsensitiveRegex];
+    [self assertBlock:block findsNeedle:@"wxyz" mode:iTermFindModeCaseSensitiveRegex];
+    [self assertBlock:block findsNeedle:@"world and more end" mode:iTermFindModeCaseSensitiveRegex];
+}
+
+@end
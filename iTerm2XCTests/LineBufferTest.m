@@ -0,0 +1,110 @@
+//
+//  LineBufferTest.m
+//  iTerm2XCTests
+//
+//  Created by agent on 10/14/26.
+//
+
+#import <XCTest/XCTest.h>
+
+#import "LineBuffer.h"
+#import "ScreenChar.h"
+
+static const int kLineBufferTestWidth = 80;
+
+@interface LineBufferTest : XCTestCase
+@end
+
+@implementation LineBufferTest
+
+- (screen_char_t)defaultChar {
+    screen_char_t c;
+    memset(&c, 0, sizeof(c));
+    c.foregroundColor = ALTSEM_DEFAULT;
+    c.foregroundColorMode = ColorModeAlternate;
+    c.backgroundColor = ALTSEM_DEFAULT;
+    c.backgroundColorMode = ColorModeAlternate;
+    return c;
+}
+
+- (NSData *)lineWithNumber:(int)i {
+    NSString *string = [NSString stringWithFormat:@"%05d: The quick brown fox jumps over the lazy dog", i];
+    NSMutableData *data = [NSMutableData dataWithLength:string.length * sizeof(screen_char_t)];
+    screen_char_t *cells = (screen_char_t *)data.mutableBytes;
+    for (NSUInteger j = 0; j < string.length; j++) {
+        cells[j] = [self defaultChar];
+        cells[j].code = [string characterAtIndex:j];
+        cells[j].bold = (i % 3 == 0);
+    }
+    return data;
+}
+
+// Appends lines that are each shorter than the width.
+- (void)appendLines:(NSArray<NSData *> *)lines toLineBuffer:(LineBuffer *)lineBuffer {
+    screen_char_t continuation = [self defaultChar];
+    continuation.code = EOL_HARD;
+    for (NSData *line in lines) {
+        [lineBuffer appendLine:(screen_char_t *)line.bytes
+                        length:(int)(line.length / sizeof(screen_char_t))
+                       partial:NO
+                         width:kLineBufferTestWidth
+                     timestamp:0
+                  continuation:continuation];
+    }
+}
+
+- (void)assertLineBuffer:(LineBuffer *)lineBuffer containsLines:(NSArray<NSData *> *)lines {
+    XCTAssertEqual([lineBuffer numLinesWithWidth:kLineBufferTestWidth], (int)lines.count);
+    for (int i = 0; i < (int)lines.count; i++) {
+        ScreenCharArray *actual = [lineBuffer wrappedLineAtIndex:i width:kLineBufferTestWidth continuation:NULL];
+        NSData *expected = lines[i];
+        const int length = (int)(expected.length / sizeof(screen_char_t));
+        XCTAssertEqual(actual.length, length, @"line %d", i);
+        const screen_char_t *cells = (const screen_char_t *)expected.bytes;
+        for (int j = 0; j < MIN(actual.length, length); j++) {
+            XCTAssertEqual(actual.line[j].code, cells[j].code, @"line %d cell %d", i, j);
+            XCTAssertEqual(actual.line[j].bold, cells[j].bold, @"line %d cell %d", i, j);
+        }
+    }
+}
+
+- (void)spinUntil:(BOOL (^)(void))block {
+    NSDate *timeout = [NSDate dateWithTimeIntervalSinceNow:5];
+    while (!block() && [timeout timeIntervalSinceNow] > 0) {
+        [[NSRunLoop currentRunLoop] runMode:NSDefaultRunLoopMode
+                                 beforeDate:[NSDate dateWithTimeIntervalSinceNow:0.001]];
+    }
+}
+
+- (void)testCompressOldBlocksThenReadBack {
+    NSMutableArray<NSData *> *lines = [NSMutableArray array];
+    for (int i = 0; i < 300; i++) {
+        [lines addObject:[self lineWithNumber:i]];
+    }
+    // Small blocks so there are many of them.
+    LineBuffer *lineBuffer = [[[LineBuffer alloc] initWithBlockSize:1000] autorelease];
+    [self appendLines:lines toLineBuffer:lineBuffer];
+    const NSInteger before = [lineBuffer memoryUsage];
+
+    // Blocks are compacted right away and compressed in the background.
+    XCTAssertGreaterThan([lineBuffer compressBlocksExceptNewest:1], 0);
+    const NSInteger compacted = [lineBuffer memoryUsage];
+    XCTAssertLessThan(compacted, before);
+    [self spinUntil:^BOOL{
+        return [lineBuffer memoryUsage] < compacted;
+    }];
+    XCTAssertLessThan([lineBuffer memoryUsage], compacted);
+    [self assertLineBuffer:lineBuffer containsLines:lines];
+
+    // Reading inflated the blocks. They can be compressed again and appending still works.
+    XCTAssertGreaterThan([lineBuffer compressBlocksExceptNewest:1], 0);
+    NSMutableArray<NSData *> *more = [NSMutableArray array];
+    for (int i = 300; i < 350; i++) {
+        [more addObject:[self lineWithNumber:i]];
+    }
+    [self appendLines:more toLineBuffer:lineBuffer];
+    [lines addObjectsFromArray:more];
+    [self assertLineBuffer:lineBuffer containsLines:lines];
+}
+
+@end
@@ -211,6 +211,10 @@ static NSString *const kDiffScriptPath = @"/tmp/diffs";
     return nil;
 }
 
+- (NSInteger)generationForLine:(int)y {
+    return 0;
+}
+
 - (PTYTextViewSynchronousUpdateState *)setUseSavedGridIfAvailable:(BOOL)use {
     return nil;
 }
@@ -2198,12 +2202,12 @@ static NSString *const kDiffScriptPath = @"/tmp/diffs";
                               NSTimeInterval now = 449711536;
                               const NSTimeInterval day = 86400;
                               int line = 0;
-                              [[screen.currentGrid lineInfoAtLineNumber:line++] setTimestamp:now - 1];  // HH:MM:SS
-                              [[screen.currentGrid lineInfoAtLineNumber:line++] setTimestamp:now - day - 1];  // DOW HH:MM:SS
-                              [[screen.currentGrid lineInfoAtLineNumber:line++] setTimestamp:now - 6 * day];  // DOW HH:MM:SS
-                              [[screen.currentGrid lineInfoAtLineNumber:line++] setTimestamp:now - 6 * day - 1];  // MM/DD HH:MM:SS
-                              [[screen.currentGrid lineInfoAtLineNumber:line++] setTimestamp:now - 180 * day];  // MM/DD HH:MM:SS
-                              [[screen.currentGrid lineInfoAtLineNumber:line++] setTimestamp:now - 180 * day - 1];  // MM/DD/YYYY HH:MM:SS
+                              [screen.currentGrid lineInfoAtLineNumber:line++]->timestamp = now - 1;  // HH:MM:SS
+                              [screen.currentGrid lineInfoAtLineNumber:line++]->timestamp = now - day - 1;  // DOW HH:MM:SS
+                              [screen.currentGrid lineInfoAtLineNumber:line++]->timestamp = now - 6 * day;  // DOW HH:MM:SS
+                              [screen.currentGrid lineInfoAtLineNumber:line++]->timestamp = now - 6 * day - 1;  // MM/DD HH:MM:SS
+                              [screen.currentGrid lineInfoAtLineNumber:line++]->timestamp = now - 180 * day;  // MM/DD HH:MM:SS
+                              [screen.currentGrid lineInfoAtLineNumber:line++]->timestamp = now - 180 * day - 1;  // MM/DD/YYYY HH:MM:SS
                               textView.drawingHook = ^(iTermTextDrawingHelper *helper) {
                                   helper.shouldShowTimestamps = YES;
                                   helper.now = now;
@@ -2688,7 +2692,7 @@ static NSString *const kDiffScriptPath = @"/tmp/diffs";
     [self registerCall:_cmd];
 }
 
-- (void)textViewDidFindDirtyRects {
+- (void)textViewDidFindDirtyRectsOnLines:(NSIndexSet *)dirtyLines {
 }
 
 - (iTermBackgroundImageMode)backgroundImageMode {
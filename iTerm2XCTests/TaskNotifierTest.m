@@ -0,0 +1,155 @@
+//
+//  TaskNotifierTest.m
+//  iTerm2XCTests
+//
+//  Created by agent on 10/14/26.
+//
+
+#import <XCTest/XCTest.h>
+
+#import "TaskNotifier+Private.h"
+
+#include <unistd.h>
+
+@interface TaskNotifierTest : XCTestCase
+@end
+
+@implementation TaskNotifierTest {
+    // A pipe whose write end is always writable. Declaring it before each wait means -wait never
+    // blocks, so a poller that misses an event fails the test instead of hanging it.
+    int _sentinel[2];
+    NSObject *_sentinelOwner;
+}
+
+- (void)setUp {
+    [super setUp];
+    XCTAssertEqual(pipe(_sentinel), 0);
+    _sentinelOwner = [[NSObject alloc] init];
+}
+
+- (void)tearDown {
+    close(_sentinel[0]);
+    close(_sentinel[1]);
+    [_sentinelOwner release];
+    [super tearDown];
+}
+
+- (void)addSentinelToPoller:(id<iTermTaskNotifierPoller>)poller {
+    [poller addFileDescriptor:_sentinel[1] owner:_sentinelOwner read:NO write:YES error:NO];
+}
+
+- (void)exercisePoller:(id<iTermTaskNotifierPoller>)poller reportsHangupAsError:(BOOL)reportsHangupAsError {
+    XCTAssertNotNil(poller);
+    NSObject *first = [[[NSObject alloc] init] autorelease];
+    NSObject *second = [[[NSObject alloc] init] autorelease];
+    int a[2];
+    int b[2];
+    XCTAssertEqual(pipe(a), 0);
+    XCTAssertEqual(pipe(b), 0);
+    char buffer[4];
+
+    // Only the pipe with data is readable.
+    XCTAssertEqual(write(a[1], "x", 1), 1);
+    [poller addFileDescriptor:a[0] owner:first read:YES write:NO error:YES];
+    [poller addFileDescriptor:b[0] owner:second read:YES write:NO error:YES];
+    [self addSentinelToPoller:poller];
+    XCTAssertTrue([poller wait]);
+    XCTAssertTrue([poller fileDescriptorIsReadable:a[0]]);
+    XCTAssertFalse([poller fileDescriptorHasError:a[0]]);
+    XCTAssertFalse([poller fileDescriptorIsReadable:b[0]]);
+    XCTAssertTrue([poller fileDescriptorIsWritable:_sentinel[1]]);
+    XCTAssertEqual(read(a[0], buffer, sizeof(buffer)), 1);
+
+    // Once drained it's no longer readable.
+    [poller addFileDescriptor:a[0] owner:first read:YES write:NO error:YES];
+    [self addSentinelToPoller:poller];
+    XCTAssertTrue([poller wait]);
+    XCTAssertFalse([poller fileDescriptorIsReadable:a[0]]);
+
+    // A partial read leaves it readable for the next wait.
+    XCTAssertEqual(write(b[1], "yz", 2), 2);
+    for (int i = 0; i < 2; i++) {
+        [poller addFileDescriptor:b[0] owner:second read:YES write:NO error:YES];
+        [self addSentinelToPoller:poller];
+        XCTAssertTrue([poller wait]);
+        XCTAssertTrue([poller fileDescriptorIsReadable:b[0]], @"read %d", i);
+        XCTAssertEqual(read(b[0], buffer, 1), 1);
+    }
+
+    // After the write end closes the read end is readable and read() returns 0.
+    close(a[1]);
+    [poller addFileDescriptor:a[0] owner:first read:YES write:NO error:YES];
+    [self addSentinelToPoller:poller];
+    XCTAssertTrue([poller wait]);
+    XCTAssertTrue([poller fileDescriptorIsReadable:a[0]]);
+    if (reportsHangupAsError) {
+        XCTAssertTrue([poller fileDescriptorHasError:a[0]]);
+    }
+    XCTAssertEqual(read(a[0], buffer, sizeof(buffer)), 0);
+
+    // Closing an fd and reusing its number for a new owner must still report events.
+    const int closed = a[0];
+    close(a[0]);
+    int c[2];
+    XCTAssertEqual(pipe(c), 0);
+    NSObject *third = [[[NSObject alloc] init] autorelease];
+    XCTAssertEqual(write(c[1], "w", 1), 1);
+    [poller addFileDescriptor:c[0] owner:third read:YES write:NO error:YES];
+    [self addSentinelToPoller:poller];
+    XCTAssertTrue([poller wait]);
+    XCTAssertTrue([poller fileDescriptorIsReadable:c[0]], @"closed fd %d, new fd %d", closed, c[0]);
+    XCTAssertFalse([poller fileDescriptorIsReadable:b[0]]);
+
+    // Same again, but the old owner is freed first, so the new one may get both its address and
+    // its fd number.
+    for (int i = 0; i < 4; i++) {
+        NSObject *oldOwner = [[NSObject alloc] init];
+        int d[2];
+        XCTAssertEqual(pipe(d), 0);
+        [poller addFileDescriptor:d[0] owner:oldOwner read:YES write:NO error:YES];
+        [self addSentinelToPoller:poller];
+        XCTAssertTrue([poller wait]);
+        XCTAssertFalse([poller fileDescriptorIsReadable:d[0]]);
+        close(d[0]);
+        close(d[1]);
+        const void *oldAddress = oldOwner;
+        [oldOwner release];
+
+        NSObject *newOwner = [[NSObject alloc] init];
+        int e[2];
+        XCTAssertEqual(pipe(e), 0);
+        XCTAssertEqual(write(e[1], "v", 1), 1);
+        [poller addFileDescriptor:e[0] owner:newOwner read:YES write:NO error:YES];
+        [self addSentinelToPoller:poller];
+        XCTAssertTrue([poller wait]);
+        XCTAssertTrue([poller fileDescriptorIsReadable:e[0]],
+                      @"same address %d, same fd %d", oldAddress == newOwner, d[0] == e[0]);
+        close(e[0]);
+        close(e[1]);
+        [newOwner release];
+    }
+
+    // An fd that stops being declared stops being reported.
+    XCTAssertEqual(write(b[1], "u", 1), 1);
+    [self addSentinelToPoller:poller];
+    XCTAssertTrue([poller wait]);
+    XCTAssertFalse([poller fileDescriptorIsReadable:b[0]]);
+    XCTAssertTrue([poller fileDescriptorIsWritable:_sentinel[1]]);
+
+    close(b[0]);
+    close(b[1]);
+    close(c[0]);
+    close(c[1]);
+}
+
+- (void)testSelectPoller {
+    [self exercisePoller:[[[iTermSelectTaskNotifierPoller alloc] init] autorelease]
+    reportsHangupAsError:NO];
+}
+
+- (void)testKqueuePoller {
+    [self exercisePoller:[[[iTermKqueueTaskNotifierPoller alloc] init] autorelease]
+    reportsHangupAsError:YES];
+}
+
+@end
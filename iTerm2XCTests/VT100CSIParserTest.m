@@ -73,6 +73,26 @@
     XCTAssert(token.csi->p[0] == 1);  // Default
 }
 
+- (void)testTruecolorSGR {
+    VT100Token *token = [self tokenForDataWithFormat:@"%c[38;2;10;200;3mx", VT100CC_ESC];
+    XCTAssert(token->type == VT100CSI_SGR);
+    XCTAssert(token.csi->count == 5);
+    XCTAssert(token.csi->p[0] == 38);
+    XCTAssert(token.csi->p[1] == 2);
+    XCTAssert(token.csi->p[2] == 10);
+    XCTAssert(token.csi->p[3] == 200);
+    XCTAssert(token.csi->p[4] == 3);
+    XCTAssert(iTermParserPeek(&_context) == 'x');
+}
+
+- (void)testCUPWithBlankParameters {
+    VT100Token *token = [self tokenForDataWithFormat:@"%c[;5H", VT100CC_ESC];
+    XCTAssert(token->type == VT100CSI_CUP);
+    XCTAssert(token.csi->count == 2);
+    XCTAssert(token.csi->p[0] == 1);  // Default
+    XCTAssert(token.csi->p[1] == 5);
+}
+
 - (void)testSimpleCSIWithParameter {
     VT100Token *token = [self tokenForDataWithFormat:@"%c[2D", VT100CC_ESC];
     XCTAssert(token->type == VT100CSI_CUB);
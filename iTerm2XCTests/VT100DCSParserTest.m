@@ -210,6 +210,20 @@
     XCTAssertEqualObjects(_parser.data, expected);
 }
 
+- (void)testDCSLongPassthrough {
+    NSString *payload = [@"0123456789abcdef~ " stringRepeatedTimes:10000];
+    VT100Token *token = [self tokenForDataWithFormat:@"%cPtmux;%@%c\\", VT100CC_ESC, payload, VT100CC_ESC];
+    XCTAssert(token->type == DCS_TMUX_CODE_WRAP);
+    XCTAssertEqualObjects(token.string, payload);
+}
+
+- (void)testDCSPassthroughStopsAtLengthLimit {
+    NSString *payload = [@"x" stringRepeatedTimes:1024 * 1024 + 100];
+    VT100Token *token = [self tokenForDataWithFormat:@"%cPA%@", VT100CC_ESC, payload];
+    XCTAssert(token->type == VT100_BINARY_GARBAGE);
+    XCTAssertEqual(_parser.data.length, 1024 * 1024 + 1);
+}
+
 - (void)testDCSPassthroughEsc {
     VT100Token *token = [self tokenForDataWithFormat:@"%cPAbcd%c", VT100CC_ESC, VT100CC_ESC];
     XCTAssert(token->type == VT100_WAIT);
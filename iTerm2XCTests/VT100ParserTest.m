@@ -0,0 +1,140 @@
+//
+//  VT100ParserTest.m
+//  iTerm2XCTests
+//
+//  Created by agent on 10/14/26.
+//
+
+#import <XCTest/XCTest.h>
+
+#import "CVector.h"
+#import "VT100Parser.h"
+#import "VT100Token.h"
+
+@interface VT100ParserTest : XCTestCase
+@end
+
+@implementation VT100ParserTest
+
+// Returns a token with every field set, so a token that isn't reset fully is easy to spot.
+- (VT100Token *)newDirtyToken {
+    VT100Token *token = [VT100Token newToken];
+    token->type = VT100_STRING;
+    token->code = 'x';
+    token->savingData = YES;
+    token.string = @"string";
+    token.kvpKey = @"key";
+    token.kvpValue = @"value";
+    token.savedData = [NSData dataWithBytes:"data" length:4];
+    token.csi->p[0] = 5;
+    token.csi->p[1] = 6;
+    token.csi->count = 2;
+    token.csi->cmd = 'm';
+    token.csi->num_subparameters = 1;
+    token.csi->subparameters[0].value = 7;
+    // Longer than the static buffers, so both the bytes and the screen chars are malloced.
+    char bytes[300];
+    memset(bytes, 'a', sizeof(bytes));
+    [token setAsciiBytes:bytes length:sizeof(bytes)];
+    return token;
+}
+
+- (void)assertTokenIsReset:(VT100Token *)token {
+    XCTAssertEqual(token->type, 0);
+    XCTAssertEqual(token->code, 0);
+    XCTAssertFalse(token->savingData);
+    XCTAssertNil(token.string);
+    XCTAssertNil(token.kvpKey);
+    XCTAssertNil(token.kvpValue);
+    XCTAssertNil(token.savedData);
+    XCTAssertFalse(token.isAscii);
+    XCTAssertTrue(token.asciiData->buffer == NULL);
+    XCTAssertEqual(token.asciiData->length, 0);
+    XCTAssertTrue(token.asciiData->screenChars == NULL);
+
+    CSIParam empty;
+    memset(&empty, 0, sizeof(empty));
+    XCTAssertEqual(memcmp(token.csi, &empty, sizeof(empty)), 0);
+}
+
+- (void)testRecycledTokensAreReset {
+    const int count = 10;
+    VT100Token *tokens[count];
+    for (int i = 0; i < count; i++) {
+        tokens[i] = [self newDirtyToken];
+    }
+    for (int i = 0; i < count; i++) {
+        [tokens[i] recycle];
+    }
+
+    // The pool is a stack, so these are the tokens just recycled.
+    for (int i = 0; i < count; i++) {
+        VT100Token *token = [VT100Token newToken];
+        [self assertTokenIsReset:token];
+
+        // It can hold new ASCII data.
+        [token setAsciiBytes:"hello" length:5];
+        token->type = VT100_ASCIISTRING;
+        XCTAssertEqualObjects([token stringForAsciiData], @"hello");
+        XCTAssertEqual(token.asciiData->screenChars->length, 5);
+        XCTAssertEqual(token.asciiData->screenChars->buffer[4].code, 'o');
+        [token recycle];
+    }
+}
+
+// A token still referenced elsewhere is released rather than reset.
+- (void)testRecyclingSharedTokenLeavesItIntact {
+    VT100Token *token = [self newDirtyToken];
+    [token retain];
+    [token recycle];
+    XCTAssertEqualObjects(token.string, @"string");
+    XCTAssertEqual(token.csi->p[0], 5);
+    XCTAssertEqual(token.asciiData->length, 300);
+    [token recycle];
+}
+
+// Tokens recycled after one batch are reused by the next without leaking parameters into it.
+- (void)testParserReusesRecycledTokens {
+    VT100Parser *parser = [[[VT100Parser alloc] init] autorelease];
+    parser.encoding = NSUTF8StringEncoding;
+    CVector vector;
+
+    for (int i = 0; i < 3; i++) {
+        const char *first = "\e[1;2;3;4:5;6mabcdefghijklmnopqrstuvwxyz0123456789\e]0;title\a";
+        [parser putStreamData:first length:strlen(first)];
+        CVectorCreate(&vector, 10);
+        [parser addParsedTokensToVector:&vector];
+        XCTAssertGreaterThan(CVectorCount(&vector), 0);
+        for (int j = 0; j < CVectorCount(&vector); j++) {
+            [(VT100Token *)CVectorGetObject(&vector, j) recycle];
+        }
+        CVectorDestroy(&vector);
+
+        const char *second = "\e[5;6Hxy";
+        [parser putStreamData:second length:strlen(second)];
+        CVectorCreate(&vector, 10);
+        [parser addParsedTokensToVector:&vector];
+        XCTAssertEqual(CVectorCount(&vector), 2);
+
+        VT100Token *token = CVectorGetObject(&vector, 0);
+        XCTAssertEqual(token->type, VT100CSI_CUP);
+        XCTAssertEqual(token.csi->count, 2);
+        XCTAssertEqual(token.csi->p[0], 5);
+        XCTAssertEqual(token.csi->p[1], 6);
+        XCTAssertEqual(token.csi->num_subparameters, 0);
+        XCTAssertNil(token.string);
+
+        token = CVectorGetObject(&vector, 1);
+        XCTAssertEqual(token->type, VT100_ASCIISTRING);
+        XCTAssertEqualObjects([token stringForAsciiData], @"xy");
+        XCTAssertNil(token.string);
+        XCTAssertEqual(token.csi->count, 0);
+
+        for (int j = 0; j < CVectorCount(&vector); j++) {
+            [(VT100Token *)CVectorGetObject(&vector, j) recycle];
+        }
+        CVectorDestroy(&vector);
+    }
+}
+
+@end
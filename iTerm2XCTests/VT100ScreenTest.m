@@ -4450,6 +4450,48 @@ NSLog(@"Known bug: %s should be true, but %s is.", #expressionThatShouldBeTrue,
     }
 }
 
+- (VT100Screen *)screenForScrollingOutput:(NSString *)output inBulk:(BOOL)inBulk {
+    VT100Terminal *terminal = [[[VT100Terminal alloc] init] autorelease];
+    VT100Screen *screen = [[[VT100Screen alloc] initWithTerminal:terminal] autorelease];
+    terminal.delegate = screen;
+    [screen destructivelySetScreenWidth:5 height:4];
+    screen.maxScrollbackLines = 6;
+
+    NSData *data = [output dataUsingEncoding:NSUTF8StringEncoding];
+    [terminal.parser putStreamData:data.bytes length:data.length];
+    CVector vector;
+    CVectorCreate(&vector, 1);
+    [terminal.parser addParsedTokensToVector:&vector];
+    int retryIndex = 0;
+    for (int i = 0; i < CVectorCount(&vector); i++) {
+        if (inBulk && i >= retryIndex) {
+            const int executed = [screen executeScrollingOutputTokens:&vector start:i retryIndex:&retryIndex];
+            if (executed > 0) {
+                i += executed - 1;
+                continue;
+            }
+        }
+        [terminal executeToken:CVectorGetObject(&vector, i)];
+    }
+    CVectorDestroy(&vector);
+    return screen;
+}
+
+- (void)testScrollingOutputInBulkMatchesExecutingEachToken {
+    NSArray<NSString *> *outputs = @[ @"a\r\nbc\r\n\r\ndefgh\r\nijklmnopqrs\r\nt\r\nu\r\nvw",
+                                      @"x\r\n\e[31my\r\nz\r\n1234567890\r\n\r\n\r\n\r\n\r\n",
+                                      @"abcde\r\nfghij\r\nklmno\r\npqrst\r\nuvwxy\r\nz\n123\r\n" ];
+    for (NSString *output in outputs) {
+        VT100Screen *expected = [self screenForScrollingOutput:output inBulk:NO];
+        VT100Screen *actual = [self screenForScrollingOutput:output inBulk:YES];
+        XCTAssertEqualObjects([actual compactLineDumpWithHistoryAndContinuationMarks],
+                              [expected compactLineDumpWithHistoryAndContinuationMarks]);
+        XCTAssertEqual(actual.cursorX, expected.cursorX);
+        XCTAssertEqual(actual.cursorY, expected.cursorY);
+        XCTAssertEqual(actual.totalScrollbackOverflow, expected.totalScrollbackOverflow);
+    }
+}
+
 #pragma mark - CSI Tests
 
 - (void)testCSI_CUD {
@@ -9,6 +9,8 @@
 #import <XCTest/XCTest.h>
 #import "ITAddressBookMgr.h"
 #import "iTermAutomaticProfileSwitcher.h"
+#import "iTermRule.h"
+#import "iTermRuleIndex.h"
 #import "NSDictionary+Profile.h"
 
 @interface iTermAutomaticProfileSwitcherTest : XCTestCase<iTermAutomaticProfileSwitcherDelegate>
@@ -362,6 +364,62 @@
     [_aps setHostname:@"hostname.com" username:@"user@example.com" path:@"/" job:@"whatever"];
     XCTAssert([_profile isEqualToProfile:profile]);
 }
+#pragma mark Rule index
+
+// The index only skips rules that can't match, so it must find the same best score as scoring
+// every rule.
+- (void)testRuleIndexAgreesWithScoringEveryRule {
+    NSArray<Profile *> *profiles = @[ self.profileHostA, self.profileHostB, self.profilePathDir1,
+                                      self.profilePathDir1AndSubs, self.profilePathDir2,
+                                      self.profileUserX, self.profileUserY,
+                                      self.profileUserGeorgeHostItermPathHome,
+                                      self.profileUserGeorgePathHome, self.profileUserGeorgeHostIterm,
+                                      self.profileHostItermPathHome, self.profileHostIterm,
+                                      self.profileUserGeorge, self.profilePathHome,
+                                      self.profileHostAllDotCom, self.profileAllPaths,
+                                      self.profileJobX, self.profileJobY, self.profileHostAll,
+                                      self.profileWithoutBoundHosts ];
+    iTermRuleIndex *index = [[[iTermRuleIndex alloc] initWithProfiles:profiles] autorelease];
+    double (^bestScore)(Profile *, NSString *, NSString *, NSString *, NSString *) =
+    ^double(Profile *profile, NSString *hostname, NSString *username, NSString *path, NSString *job) {
+        double best = 0;
+        for (NSString *ruleString in profile[KEY_BOUND_HOSTS]) {
+            iTermRule *rule = [iTermRule ruleWithString:ruleString];
+            best = MAX(best, [rule scoreForHostname:hostname username:username path:path job:job]);
+        }
+        return best;
+    };
+    id null = [NSNull null];
+    for (id hostname in @[ null, @"a", @"b", @"iterm2.com", @"ITERM2.COM", @"example.com" ]) {
+        for (id username in @[ null, @"george", @"x", @"y" ]) {
+            for (id path in @[ null, @"/home", @"/dir1", @"/dir1/sub", @"/dir2" ]) {
+                for (id job in @[ null, @"x", @"y", @"vim" ]) {
+                    NSString *h = hostname == null ? nil : hostname;
+                    NSString *u = username == null ? nil : username;
+                    NSString *p = path == null ? nil : path;
+                    NSString *j = job == null ? nil : job;
+                    double expected = 0;
+                    for (Profile *profile in profiles) {
+                        expected = MAX(expected, bestScore(profile, h, u, p, j));
+                    }
+                    double score = -1;
+                    Profile *profile = [index highestScoringProfileForHostname:h
+                                                                      username:u
+                                                                          path:p
+                                                                           job:j
+                                                                        sticky:NULL
+                                                                         score:&score];
+                    XCTAssertEqual(score, expected);
+                    if (expected > 0) {
+                        XCTAssertEqual(bestScore(profile, h, u, p, j), expected);
+                    } else {
+                        XCTAssertNil(profile);
+                    }
+                }
+            }
+        }
+    }
+}
 
 #pragma mark - iTermAutomaticProfileSwitcherDelegate
 
@@ -71,4 +71,47 @@
     XCTAssertEqualObjects(@2, cache[@"two"]);
 }
 
+- (void)testEvictionByCost {
+    iTermCache<NSString *, NSNumber *> *cache = [[iTermCache alloc] initWithName:@"test_cost"
+                                                                     maximumCost:10
+                                                                          shards:1
+                                                                      timeToLive:0];
+    [cache setObject:@1 forKey:@"one" cost:4];
+    [cache setObject:@2 forKey:@"two" cost:4];
+    [cache setObject:@3 forKey:@"three" cost:4];
+
+    XCTAssertNil(cache[@"one"]);
+    XCTAssertEqualObjects(@2, cache[@"two"]);
+    XCTAssertEqualObjects(@3, cache[@"three"]);
+}
+
+- (void)testSettingNilRemoves {
+    iTermCache<NSString *, NSNumber *> *cache = [[iTermCache alloc] initWithCapacity:3];
+    cache[@"one"] = @1;
+    cache[@"one"] = nil;
+    XCTAssertNil(cache[@"one"]);
+}
+
+- (void)testStatistics {
+    iTermCache<NSString *, NSNumber *> *cache = [[iTermCache alloc] initWithName:@"test_statistics"
+                                                                     maximumCost:1
+                                                                          shards:1
+                                                                      timeToLive:0];
+    cache[@"one"] = @1;
+    XCTAssertEqualObjects(@1, cache[@"one"]);
+    cache[@"two"] = @2;
+    XCTAssertNil(cache[@"one"]);
+
+    iTermCacheStatisticsSummary *summary = nil;
+    for (iTermCacheStatisticsSummary *candidate in iTermCacheStatisticsSummarize()) {
+        if ([candidate.name isEqualToString:@"test_statistics"]) {
+            summary = candidate;
+        }
+    }
+    XCTAssertEqual(summary.hits, 1ULL);
+    XCTAssertEqual(summary.misses, 1ULL);
+    XCTAssertEqual(summary.evictions, 1ULL);
+    XCTAssertEqual(summary.count, 1LL);
+}
+
 @end
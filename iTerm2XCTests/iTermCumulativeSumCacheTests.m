@@ -0,0 +1,59 @@
+//
+//  iTermCumulativeSumCacheTests.m
+//  iTerm2XCTests
+//
+//  Created by agent on 10/14/26.
+//
+
+#import <XCTest/XCTest.h>
+#import "iTermCumulativeSumCache.h"
+
+@interface iTermCumulativeSumCacheTests : XCTestCase
+@end
+
+@implementation iTermCumulativeSumCacheTests
+
+// Simulates a scrolling session: the last value grows, new values are appended, and the first
+// value shrinks and is dropped. Lookups must stay right without rebuilding. setLastValue: needs at
+// least two values.
+- (void)testLookupsAfterTailUpdatesAndHeadDrops {
+    iTermCumulativeSumCache *cache = [[[iTermCumulativeSumCache alloc] init] autorelease];
+    NSMutableArray<NSNumber *> *values = [NSMutableArray array];
+    for (int i = 0; i < 200; i++) {
+        if (values.count < 2 || i % 3 == 0) {
+            [cache appendValue:1];
+            [values addObject:@1];
+        } else {
+            const NSInteger last = values.lastObject.integerValue + 2;
+            [cache setLastValue:last];
+            values[values.count - 1] = @(last);
+        }
+        if (i % 7 == 6 && values.count > 2) {
+            const NSInteger first = values.firstObject.integerValue;
+            if (first > 1) {
+                [cache setFirstValue:first - 1];
+                values[0] = @(first - 1);
+            } else {
+                [cache removeFirstValue];
+                [values removeObjectAtIndex:0];
+            }
+        }
+        [self assertCache:cache matchesValues:values];
+    }
+}
+
+- (void)assertCache:(iTermCumulativeSumCache *)cache matchesValues:(NSArray<NSNumber *> *)values {
+    XCTAssertEqual(cache.count, (NSInteger)values.count);
+    NSInteger sum = 0;
+    for (NSInteger i = 0; i < values.count; i++) {
+        const NSInteger value = values[i].integerValue;
+        for (NSInteger j = 0; j < value; j++) {
+            XCTAssertEqual([cache indexContainingValue:sum + j], i);
+        }
+        sum += value;
+    }
+    XCTAssertEqual(cache.sumOfAllValues, sum);
+    XCTAssertEqual([cache indexContainingValue:sum], NSNotFound);
+}
+
+@end
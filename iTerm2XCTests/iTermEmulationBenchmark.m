@@ -0,0 +1,265 @@
+//
+//  iTermEmulationBenchmark.m
+//  iTerm2XCTests
+//
+//  Created by agent on 10/14/26.
+//
+
+// Measures how fast bytes go through the parser, terminal, and screen with no view attached.
+//
+// This is skipped unless ITERM_RUN_BENCHMARKS is set in the environment, so it doesn't slow down
+// the regular tests. Run it with `make benchmark`. Each stream is reported on one line with MB/s,
+// tokens/s, and allocations per MB so results can be compared across releases.
+//
+// In addition to the built-in synthetic streams, every file in the directory named by
+// ITERM_BENCHMARK_CORPUS (default: tests/benchmark-corpus) is replayed as a recorded stream. Record
+// one with `script -r`, by teeing a program's output to a file, or with the session method
+// iterm2.start_pty_capture(), in which case only its output is replayed.
+
+#import <XCTest/XCTest.h>
+
+#import "CVector.h"
+#import "VT100Parser.h"
+#import "VT100Screen.h"
+#import "VT100Terminal.h"
+#import "VT100Token.h"
+#import "iTermPtyCapture.h"
+
+#import <mach/mach.h>
+#import <malloc/malloc.h>
+#import <stdatomic.h>
+
+#define STRINGIFY(s) #s
+#define STRINGIFY_MACRO(m) STRINGIFY(m)
+
+// About what PTYTask hands to the parser per read.
+static const NSUInteger iTermEmulationBenchmarkReadSize = 4096;
+static const NSUInteger iTermEmulationBenchmarkSyntheticStreamSize = 8 * 1024 * 1024;
+
+static _Atomic uint64_t gAllocationCount;
+static void *(*gOriginalMalloc)(malloc_zone_t *zone, size_t size);
+static void *(*gOriginalCalloc)(malloc_zone_t *zone, size_t count, size_t size);
+static void *(*gOriginalRealloc)(malloc_zone_t *zone, void *ptr, size_t size);
+
+static void *iTermEmulationBenchmarkMalloc(malloc_zone_t *zone, size_t size) {
+    atomic_fetch_add_explicit(&gAllocationCount, 1, memory_order_relaxed);
+    return gOriginalMalloc(zone, size);
+}
+
+static void *iTermEmulationBenchmarkCalloc(malloc_zone_t *zone, size_t count, size_t size) {
+    atomic_fetch_add_explicit(&gAllocationCount, 1, memory_order_relaxed);
+    return gOriginalCalloc(zone, count, size);
+}
+
+static void *iTermEmulationBenchmarkRealloc(malloc_zone_t *zone, void *ptr, size_t size) {
+    atomic_fetch_add_explicit(&gAllocationCount, 1, memory_order_relaxed);
+    return gOriginalRealloc(zone, ptr, size);
+}
+
+// Counts allocations in the default zone, which is where Objective-C objects and plain malloc
+// come from. Other threads are counted too, so expect a little noise.
+static void iTermEmulationBenchmarkSetCountsAllocations(BOOL enabled) {
+    malloc_zone_t *zone = malloc_default_zone();
+    vm_protect(mach_task_self(), (vm_address_t)zone, sizeof(*zone), 0, VM_PROT_READ | VM_PROT_WRITE);
+    if (enabled) {
+        gOriginalMalloc = zone->malloc;
+        gOriginalCalloc = zone->calloc;
+        gOriginalRealloc = zone->realloc;
+        zone->malloc = iTermEmulationBenchmarkMalloc;
+        zone->calloc = iTermEmulationBenchmarkCalloc;
+        zone->realloc = iTermEmulationBenchmarkRealloc;
+    } else {
+        zone->malloc = gOriginalMalloc;
+        zone->calloc = gOriginalCalloc;
+        zone->realloc = gOriginalRealloc;
+    }
+    vm_protect(mach_task_self(), (vm_address_t)zone, sizeof(*zone), 0, VM_PROT_READ);
+}
+
+@interface iTermEmulationBenchmark : XCTestCase
+@end
+
+@implementation iTermEmulationBenchmark
+
+- (void)testThroughput {
+    if (!getenv("ITERM_RUN_BENCHMARKS")) {
+        return;
+    }
+    NSMutableArray<NSString *> *names = [NSMutableArray array];
+    NSMutableArray<NSData *> *streams = [NSMutableArray array];
+
+    [names addObject:@"plain log"];
+    [streams addObject:[self plainLogStream]];
+    [names addObject:@"full-screen redraw (htop)"];
+    [streams addObject:[self fullScreenRedrawStream]];
+    [names addObject:@"editor scrolling (vim)"];
+    [streams addObject:[self editorStream]];
+    [names addObject:@"combining marks and wide characters"];
+    [streams addObject:[self combiningMarksStream]];
+    [names addObject:@"sixel"];
+    [streams addObject:[self sixelStream]];
+    [names addObject:@"tmux control mode"];
+    [streams addObject:[self tmuxControlModeStream]];
+
+    NSString *corpus = [self corpusDirectory];
+    for (NSString *file in [[[NSFileManager defaultManager] contentsOfDirectoryAtPath:corpus error:nil] sortedArrayUsingSelector:@selector(compare:)]) {
+        NSData *data = [NSData dataWithContentsOfFile:[corpus stringByAppendingPathComponent:file]];
+        if ([iTermPtyCaptureReader dataIsCapture:data]) {
+            data = [[[[iTermPtyCaptureReader alloc] initWithData:data] autorelease] output];
+        }
+        if (data.length) {
+            [names addObject:file];
+            [streams addObject:data];
+        }
+    }
+
+    for (NSUInteger i = 0; i < streams.count; i++) {
+        [self runStream:streams[i] name:names[i]];
+    }
+}
+
+#pragma mark - Running
+
+- (NSString *)corpusDirectory {
+    const char *env = getenv("ITERM_BENCHMARK_CORPUS");
+    if (env) {
+        return [NSString stringWithUTF8String:env];
+    }
+    NSString *projectDir = [NSString stringWithUTF8String:STRINGIFY_MACRO(PROJECT_DIR)];
+    return [projectDir stringByAppendingPathComponent:@"tests/benchmark-corpus"];
+}
+
+- (void)runStream:(NSData *)stream name:(NSString *)name {
+    @autoreleasepool {
+        VT100Terminal *terminal = [[[VT100Terminal alloc] init] autorelease];
+        VT100Screen *screen = [[[VT100Screen alloc] initWithTerminal:terminal] autorelease];
+        terminal.delegate = screen;
+        [screen destructivelySetScreenWidth:80 height:25];
+        screen.maxScrollbackLines = 10000;
+
+        NSUInteger tokens = 0;
+        const char *bytes = stream.bytes;
+        atomic_store(&gAllocationCount, 0);
+        iTermEmulationBenchmarkSetCountsAllocations(YES);
+        const NSTimeInterval start = [NSDate timeIntervalSinceReferenceDate];
+        for (NSUInteger offset = 0; offset < stream.length; offset += iTermEmulationBenchmarkReadSize) {
+            @autoreleasepool {
+                const int length = (int)MIN(iTermEmulationBenchmarkReadSize, stream.length - offset);
+                [terminal.parser putStreamData:bytes + offset length:length];
+                CVector vector;
+                CVectorCreate(&vector, 100);
+                [terminal.parser addParsedTokensToVector:&vector];
+                const int n = CVectorCount(&vector);
+                for (int i = 0; i < n; i++) {
+                    VT100Token *token = CVectorGetObject(&vector, i);
+                    [terminal executeToken:token];
+                    [token recycle];
+                }
+                tokens += n;
+                CVectorDestroy(&vector);
+            }
+        }
+        const NSTimeInterval elapsed = [NSDate timeIntervalSinceReferenceDate] - start;
+        iTermEmulationBenchmarkSetCountsAllocations(NO);
+        const uint64_t allocations = atomic_load(&gAllocationCount);
+
+        const double megabytes = (double)stream.length / (1024 * 1024);
+        NSLog(@"BENCHMARK %@: %.1f MB/s, %.0f tokens/s, %.0f allocations/MB (%.1f MB in %.3fs)",
+              name,
+              megabytes / elapsed,
+              tokens / elapsed,
+              allocations / megabytes,
+              megabytes,
+              elapsed);
+    }
+}
+
+#pragma mark - Synthetic Streams
+
+- (NSData *)streamByRepeating:(NSString *(^)(NSUInteger i))block {
+    NSMutableData *data = [NSMutableData data];
+    for (NSUInteger i = 0; data.length < iTermEmulationBenchmarkSyntheticStreamSize; i++) {
+        [data appendData:[block(i) dataUsingEncoding:NSUTF8StringEncoding]];
+    }
+    return data;
+}
+
+- (NSData *)plainLogStream {
+    return [self streamByRepeating:^NSString *(NSUInteger i) {
+        return [NSString stringWithFormat:@"2026-10-14 12:%02d:%02d.%03d INFO [worker-%d] processed request id=%08lx in %dms\r\n",
+                (int)(i / 60) % 60, (int)i % 60, (int)(i * 7) % 1000, (int)i % 8, (unsigned long)(i * 2654435761u), (int)(i % 97)];
+    }];
+}
+
+// Repaints a 25-row screen with colors and absolute cursor positioning.
+- (NSData *)fullScreenRedrawStream {
+    return [self streamByRepeating:^NSString *(NSUInteger i) {
+        NSMutableString *frame = [NSMutableString stringWithString:@"\e[H"];
+        for (int row = 1; row <= 25; row++) {
+            [frame appendFormat:@"\e[%d;1H\e[38;5;%dm%5d \e[48;5;%dmroot\e[0m  20   0  %6d  %5d S  %4.1f  0.%d  0:%02d.%02d \e[1mprocess-%d\e[0m\e[K",
+             row, (int)(row + i) % 256, (int)(row * 100 + i) % 99999, (int)(row * 3 + i) % 256,
+             (int)(i * row) % 999999, (int)(row * 17) % 99999, (double)((i + row) % 1000) / 10.0, row % 10,
+             (int)i % 60, row, row];
+        }
+        return frame;
+    }];
+}
+
+// Scrolls within a region and inserts and deletes lines, like an editor does.
+- (NSData *)editorStream {
+    return [self streamByRepeating:^NSString *(NSUInteger i) {
+        if (i == 0) {
+            return @"\e[?1049h\e[1;24r";
+        }
+        switch (i % 4) {
+            case 0:
+                return [NSString stringWithFormat:@"\e[24;1H\n\e[24;1H\e[34m%4d \e[0mstatic int function_%d(int x) { return x * %d; }\e[K", (int)i, (int)i, (int)i % 13];
+            case 1:
+                return [NSString stringWithFormat:@"\e[%d;1H\e[L\e[33m~\e[0m", (int)(i % 23) + 1];
+            case 2:
+                return [NSString stringWithFormat:@"\e[%d;1H\e[M", (int)(i % 23) + 1];
+            default:
+                return [NSString stringWithFormat:@"\e[25;1H\e[7m-- INSERT --\e[0m\e[K\e[25;60H%d,%d\e[%d;%dH", (int)i, (int)i % 80, (int)(i % 24) + 1, (int)(i % 80) + 1];
+        }
+    }];
+}
+
+- (NSData *)combiningMarksStream {
+    NSArray<NSString *> *samples = @[ @"é", @"ạ̈", @"क्ष", @"中文", @"\U0001F600", @"\U0001F468‍\U0001F469‍\U0001F467", @"தமிழ்", @"ñ" ];
+    return [self streamByRepeating:^NSString *(NSUInteger i) {
+        NSMutableString *line = [NSMutableString string];
+        for (int j = 0; j < 16; j++) {
+            [line appendString:samples[(i + j) % samples.count]];
+            [line appendString:@" "];
+        }
+        [line appendString:@"\r\n"];
+        return line;
+    }];
+}
+
+- (NSData *)sixelStream {
+    return [self streamByRepeating:^NSString *(NSUInteger i) {
+        NSMutableString *image = [NSMutableString stringWithString:@"\eP0;0;0q\"1;1;64;24#0;2;0;0;0#1;2;100;50;0"];
+        for (int band = 0; band < 4; band++) {
+            [image appendFormat:@"#%d", band % 2];
+            for (int x = 0; x < 64; x++) {
+                [image appendFormat:@"%c", (char)('?' + (x + band + i) % 63)];
+            }
+            [image appendString:@"-"];
+        }
+        [image appendString:@"\e\\\r\n"];
+        return image;
+    }];
+}
+
+// Enters tmux integration mode and then sends %output notifications.
+- (NSData *)tmuxControlModeStream {
+    return [self streamByRepeating:^NSString *(NSUInteger i) {
+        if (i == 0) {
+            return @"\eP1000p%begin 0 0 0\n%end 0 0 0\n";
+        }
+        return [NSString stringWithFormat:@"%%output %%%d line %d of output\\015\\012\n", (int)i % 4, (int)i];
+    }];
+}
+
+@end
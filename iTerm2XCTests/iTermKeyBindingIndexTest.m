@@ -0,0 +1,59 @@
+//
+//  iTermKeyBindingIndexTest.m
+//  iTerm2XCTests
+//
+//  Created by agent on 10/14/26.
+//
+
+#import <XCTest/XCTest.h>
+
+#import "iTermKeyBindingAction.h"
+#import "iTermKeyBindingIndex.h"
+#import "iTermKeystroke.h"
+
+@interface iTermKeyBindingIndexTest : XCTestCase
+@end
+
+@implementation iTermKeyBindingIndexTest
+
+- (NSDictionary *)actionWithText:(NSString *)text {
+    return @{ @"Action": @(KEY_ACTION_SEND_C_H_BACKSPACE), @"Text": text };
+}
+
+// The index must agree with -valueInBindingDictionary:, which tries the modern serialized form,
+// then the legacy form, then any modern key with the same character and modifiers.
+- (void)testIndexMatchesDictionaryLookup {
+    NSDictionary *keyMappings = @{ @"0x61-0x100000-0x0": [self actionWithText:@"modern a"],
+                                   @"0x61-0x100000": [self actionWithText:@"legacy a"],
+                                   @"0x62-0x40000-0xb": [self actionWithText:@"b with key code"],
+                                   @"0xf700-0x280000-0x7e": [self actionWithText:@"up"],
+                                   @"0x63-0x80000": [self actionWithText:@"legacy c"] };
+    iTermKeyBindingIndex *index = [iTermKeyBindingIndex indexForKeyMappings:keyMappings];
+    XCTAssertNotNil(index);
+    XCTAssertEqual(index, [iTermKeyBindingIndex indexForKeyMappings:keyMappings]);
+
+    NSArray<iTermKeystroke *> *keystrokes = @[
+        [[[iTermKeystroke alloc] initWithVirtualKeyCode:0 modifierFlags:NSEventModifierFlagCommand character:'a'] autorelease],
+        [[[iTermKeystroke alloc] initWithVirtualKeyCode:12 modifierFlags:NSEventModifierFlagCommand character:'a'] autorelease],
+        [[[iTermKeystroke alloc] initWithVirtualKeyCode:0 modifierFlags:NSEventModifierFlagControl character:'b'] autorelease],
+        [[[iTermKeystroke alloc] initWithVirtualKeyCode:11 modifierFlags:NSEventModifierFlagControl character:'b'] autorelease],
+        [[[iTermKeystroke alloc] initWithVirtualKeyCode:45 modifierFlags:NSEventModifierFlagControl character:'b'] autorelease],
+        [[[iTermKeystroke alloc] initWithVirtualKeyCode:126 modifierFlags:NSEventModifierFlagOption character:NSUpArrowFunctionKey] autorelease],
+        [[[iTermKeystroke alloc] initWithVirtualKeyCode:8 modifierFlags:NSEventModifierFlagOption character:'c'] autorelease],
+        [[[iTermKeystroke alloc] initWithVirtualKeyCode:8 modifierFlags:0 character:'c'] autorelease],
+        [[[iTermKeystroke alloc] initWithVirtualKeyCode:0 modifierFlags:0 character:'z'] autorelease],
+    ];
+    for (iTermKeystroke *keystroke in keystrokes) {
+        NSDictionary *expected = [keystroke valueInBindingDictionary:keyMappings];
+        XCTAssertEqual([index hasMappingForKeystroke:keystroke], expected != nil, @"%@", keystroke);
+        XCTAssertEqualObjects([index actionForKeystroke:keystroke].parameter, expected[@"Text"], @"%@", keystroke);
+    }
+}
+
+- (void)testMutableDictionaryIsNotIndexed {
+    NSMutableDictionary *keyMappings = [NSMutableDictionary dictionaryWithObject:[self actionWithText:@"a"]
+                                                                          forKey:@"0x61-0x100000-0x0"];
+    XCTAssertNil([iTermKeyBindingIndex indexForKeyMappings:keyMappings]);
+}
+
+@end
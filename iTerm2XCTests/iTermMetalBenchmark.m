@@ -0,0 +1,263 @@
+//
+//  iTermMetalBenchmark.m
+//  iTerm2XCTests
+//
+//  Created by agent on 10/14/26.
+//
+
+// Measures Metal frame cost for canned screens without a window.
+//
+// Like iTermEmulationBenchmark, this is skipped unless ITERM_RUN_BENCHMARKS is set. Each scenario
+// gets a fresh session set up the same way as in PTYTextViewTest, with the Metal renderer drawing
+// into its offscreen MTKView. Frames are drawn one at a time, first with every line dirty and then
+// with nothing changed. The report has the main-thread time to start a frame, the driver's
+// per-stage encode times, and GPU time, all as p50/p90 in milliseconds.
+
+#import <MetalKit/MetalKit.h>
+#import <XCTest/XCTest.h>
+
+#import "ProfileModel.h"
+#import "PTYSession.h"
+#import "PTYTextView.h"
+#import "SessionView.h"
+#import "VT100Grid.h"
+#import "VT100Screen.h"
+#import "iTermAdvancedSettingsModel.h"
+#import "iTermColorPresets.h"
+#import "iTermHistogram.h"
+#import "iTermMetalDriver.h"
+#import "iTermPreferences.h"
+
+static const int iTermMetalBenchmarkWarmupFrames = 5;
+static const int iTermMetalBenchmarkFrames = 120;
+
+@interface iTermMetalBenchmark : XCTestCase
+@end
+
+@implementation iTermMetalBenchmark
+
+- (void)testFrameTimes {
+    if (!getenv("ITERM_RUN_BENCHMARKS")) {
+        return;
+    }
+    if (!MTLCreateSystemDefaultDevice()) {
+        NSLog(@"BENCHMARK metal: no Metal device");
+        return;
+    }
+    const BOOL savedMeasureMetalLatency = [iTermAdvancedSettingsModel measureMetalLatency];
+    // Needed for GPU times.
+    [iTermAdvancedSettingsModel setMeasureMetalLatency:YES];
+
+    NSDictionary<NSString *, NSString *> *scenarios = @{ @"ascii": [self asciiInput],
+                                                         @"cjk": [self cjkInput],
+                                                         @"emoji": [self emojiInput],
+                                                         @"truecolor": [self truecolorInput],
+                                                         @"images": [self imagesInput] };
+    for (NSString *name in [scenarios.allKeys sortedArrayUsingSelector:@selector(compare:)]) {
+        @autoreleasepool {
+            [self runScenario:name input:scenarios[name]];
+        }
+    }
+
+    [iTermAdvancedSettingsModel setMeasureMetalLatency:savedMeasureMetalLatency];
+}
+
+#pragma mark - Running
+
+- (PTYSession *)sessionWithSize:(VT100GridSize)size {
+    NSString *plistFile = [[NSBundle bundleForClass:[self class]] pathForResource:@"DefaultBookmark"
+                                                                           ofType:@"plist"];
+    NSMutableDictionary *profile = [NSMutableDictionary dictionaryWithContentsOfFile:plistFile];
+    iTermColorPreset *darkBackground = [iTermColorPresets presetWithName:@"Dark Background"];
+    for (NSString *colorName in [ProfileModel colorKeysWithModes:NO]) {
+        if (darkBackground[colorName]) {
+            profile[colorName] = darkBackground[colorName];
+        }
+    }
+    profile[KEY_USE_SEPARATE_COLORS_FOR_LIGHT_AND_DARK_MODE] = @NO;
+    profile[KEY_GUID] = [ProfileModel freshGuid];
+
+    PTYSession *session = [[[PTYSession alloc] initSynthetic:NO] autorelease];
+    [session setProfile:profile];
+    [session setScreenSize:NSMakeRect(0, 0, 200, 200) parent:nil];
+    [session setPreferencesFromAddressBookEntry:profile];
+    [session setSize:size];
+    session.view.frame = NSMakeRect(0,
+                                    0,
+                                    size.width * session.textview.charWidth + [iTermPreferences intForKey:kPreferenceKeySideMargins] * 2,
+                                    size.height * session.textview.lineHeight + [iTermPreferences intForKey:kPreferenceKeyTopBottomMargins] * 2);
+    [session loadInitialColorTableAndResetCursorGuide];
+    return session;
+}
+
+- (void)runScenario:(NSString *)name input:(NSString *)input {
+    PTYSession *session = [self sessionWithSize:VT100GridSizeMake(160, 50)];
+    [session synchronousReadTask:input];
+    session.useMetal = YES;
+    iTermMetalDriver *driver = session.view.driver;
+    MTKView *view = session.view.metalView;
+    if (!driver || !view) {
+        NSLog(@"BENCHMARK metal %@: Metal is unavailable", name);
+        return;
+    }
+    for (int i = 0; i < iTermMetalBenchmarkWarmupFrames; i++) {
+        [self drawFrameWithDriver:driver view:view];
+    }
+
+    iTermHistogram *full = [[[iTermHistogram alloc] init] autorelease];
+    iTermHistogram *idle = [[[iTermHistogram alloc] init] autorelease];
+    int aborted = 0;
+    for (int i = 0; i < iTermMetalBenchmarkFrames; i++) {
+        [session.screen.currentGrid markAllCharsDirty:YES];
+        if (![self drawFrameWithDriver:driver view:view cpuTime:full]) {
+            aborted++;
+        }
+    }
+    for (int i = 0; i < iTermMetalBenchmarkFrames; i++) {
+        if (![self drawFrameWithDriver:driver view:view cpuTime:idle]) {
+            aborted++;
+        }
+    }
+
+    __block NSDictionary *stats = nil;
+    [driver getLatencyStatsWithCompletion:^(NSDictionary<NSString *, id> *result) {
+        stats = [result retain];
+    }];
+    [self spinUntil:^BOOL{ return stats != nil; }];
+    [stats autorelease];
+
+    NSMutableString *encode = [NSMutableString string];
+    NSDictionary<NSString *, NSDictionary *> *encodeStats = stats[@"encode"];
+    for (NSString *stage in [encodeStats.allKeys sortedArrayUsingSelector:@selector(compare:)]) {
+        [encode appendFormat:@"\n    %@: %@", stage, [self descriptionOfSummary:encodeStats[stage]]];
+    }
+    NSLog(@"BENCHMARK metal %@: main thread (all dirty) %.3f/%.3f, main thread (idle) %.3f/%.3f, gpu %@, aborted %d%@",
+          name,
+          [full valueAtNTile:0.5], [full valueAtNTile:0.9],
+          [idle valueAtNTile:0.5], [idle valueAtNTile:0.9],
+          [self descriptionOfSummary:stats[@"gpu"]],
+          aborted,
+          encode);
+    session.useMetal = NO;
+}
+
+- (NSString *)descriptionOfSummary:(NSDictionary *)summary {
+    if ([summary[@"count"] intValue] == 0) {
+        return @"n/a";
+    }
+    return [NSString stringWithFormat:@"%.3f/%.3f", [summary[@"p50"] doubleValue], [summary[@"p90"] doubleValue]];
+}
+
+- (BOOL)drawFrameWithDriver:(iTermMetalDriver *)driver view:(MTKView *)view {
+    return [self drawFrameWithDriver:driver view:view cpuTime:nil];
+}
+
+// Waits for the GPU so frames don't overlap and each one is measured on its own.
+- (BOOL)drawFrameWithDriver:(iTermMetalDriver *)driver view:(MTKView *)view cpuTime:(iTermHistogram *)histogram {
+    __block BOOL done = NO;
+    __block BOOL ok = NO;
+    const NSTimeInterval start = [NSDate timeIntervalSinceReferenceDate];
+    [driver drawAsynchronouslyInView:view completion:^(BOOL success) {
+        ok = success;
+        done = YES;
+    }];
+    [histogram addValue:([NSDate timeIntervalSinceReferenceDate] - start) * 1000];
+    [self spinUntil:^BOOL{ return done; }];
+    return ok;
+}
+
+- (void)spinUntil:(BOOL (^)(void))block {
+    NSDate *timeout = [NSDate dateWithTimeIntervalSinceNow:5];
+    while (!block() && [timeout timeIntervalSinceNow] > 0) {
+        [[NSRunLoop currentRunLoop] runMode:NSDefaultRunLoopMode
+                                 beforeDate:[NSDate dateWithTimeIntervalSinceNow:0.001]];
+    }
+}
+
+#pragma mark - Scenarios
+
+- (NSString *)fillScreenWithLine:(NSString *(^)(int row))block {
+    NSMutableString *input = [NSMutableString string];
+    for (int row = 0; row < 50; row++) {
+        [input appendString:block(row)];
+        if (row < 49) {
+            [input appendString:@"\r\n"];
+        }
+    }
+    return input;
+}
+
+- (NSString *)asciiInput {
+    return [self fillScreenWithLine:^NSString *(int row) {
+        NSMutableString *line = [NSMutableString string];
+        while (line.length < 160) {
+            [line appendFormat:@"%c", (char)('!' + (line.length + row) % 94)];
+        }
+        return line;
+    }];
+}
+
+- (NSString *)cjkInput {
+    return [self fillScreenWithLine:^NSString *(int row) {
+        NSMutableString *line = [NSMutableString string];
+        for (int i = 0; i < 80; i++) {
+            [line appendFormat:@"%C", (unichar)(0x4E00 + (row * 80 + i) % 0x5000)];
+        }
+        return line;
+    }];
+}
+
+- (NSString *)emojiInput {
+    NSArray<NSString *> *emoji = @[ @"\U0001F600", @"\U0001F680", @"\U0001F9D1‍\U0001F4BB", @"\U0001F44D\U0001F3FD", @"❤️" ];
+    return [self fillScreenWithLine:^NSString *(int row) {
+        NSMutableString *line = [NSMutableString string];
+        for (int i = 0; i < 80; i++) {
+            [line appendString:emoji[(row + i) % emoji.count]];
+        }
+        return line;
+    }];
+}
+
+- (NSString *)truecolorInput {
+    return [self fillScreenWithLine:^NSString *(int row) {
+        NSMutableString *line = [NSMutableString string];
+        for (int i = 0; i < 160; i++) {
+            [line appendFormat:@"\e[38;2;%d;%d;%dm\e[48;2;%d;%d;%dm%c",
+             (i * 3) % 256, (row * 5) % 256, (i + row) % 256,
+             255 - (i * 3) % 256, (row * 7) % 256, (i * row) % 256,
+             (char)('a' + i % 26)];
+        }
+        [line appendString:@"\e[0m"];
+        return line;
+    }];
+}
+
+- (NSString *)imagesInput {
+    NSBitmapImageRep *rep = [[[NSBitmapImageRep alloc] initWithBitmapDataPlanes:NULL
+                                                                     pixelsWide:64
+                                                                     pixelsHigh:64
+                                                                  bitsPerSample:8
+                                                                samplesPerPixel:4
+                                                                       hasAlpha:YES
+                                                                       isPlanar:NO
+                                                                 colorSpaceName:NSDeviceRGBColorSpace
+                                                                    bytesPerRow:0
+                                                                   bitsPerPixel:0] autorelease];
+    for (int y = 0; y < 64; y++) {
+        for (int x = 0; x < 64; x++) {
+            [rep setColor:[NSColor colorWithDeviceRed:x / 63.0 green:y / 63.0 blue:0.5 alpha:1] atX:x y:y];
+        }
+    }
+    NSString *base64 = [[rep representationUsingType:NSBitmapImageFileTypePNG properties:@{}] base64EncodedStringWithOptions:0];
+    NSString *image = [NSString stringWithFormat:@"\e]1337;File=inline=1;width=20;height=10;preserveAspectRatio=0:%@\a", base64];
+    NSMutableString *input = [NSMutableString string];
+    for (int i = 0; i < 4; i++) {
+        for (int j = 0; j < 7; j++) {
+            [input appendString:image];
+        }
+        [input appendString:@"\r\n"];
+    }
+    return input;
+}
+
+@end
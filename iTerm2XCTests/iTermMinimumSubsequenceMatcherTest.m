@@ -0,0 +1,75 @@
+//
+//  iTermMinimumSubsequenceMatcherTest.m
+//  iTerm2XCTests
+//
+//  Created by agent on 10/14/26.
+//
+
+#import <XCTest/XCTest.h>
+
+#import "iTermMinimumSubsequenceMatcher.h"
+
+@interface iTermMinimumSubsequenceMatcherTest : XCTestCase
+@end
+
+@implementation iTermMinimumSubsequenceMatcherTest
+
+- (void)assertMatchForQuery:(NSString *)query
+                   document:(NSString *)document
+                      first:(NSUInteger)first
+                       last:(NSUInteger)last
+                       gaps:(NSUInteger)gaps {
+    iTermMinimumSubsequenceMatcher *matcher = [[[iTermMinimumSubsequenceMatcher alloc] initWithQuery:query] autorelease];
+    iTermSubsequenceMatch match;
+    XCTAssertTrue([matcher getMatch:&match forDocument:document]);
+    XCTAssertEqual(match.first, first);
+    XCTAssertEqual(match.last, last);
+    XCTAssertEqual(match.gaps, gaps);
+}
+
+- (void)testShortestWindowWins {
+    [self assertMatchForQuery:@"abc" document:@"a.b.c abc" first:6 last:8 gaps:0];
+    [self assertMatchForQuery:@"abc" document:@"abc" first:0 last:2 gaps:0];
+    [self assertMatchForQuery:@"aa" document:@"a...aa" first:4 last:5 gaps:0];
+    [self assertMatchForQuery:@"ac" document:@"xabc" first:1 last:3 gaps:1];
+}
+
+- (void)testNoMatch {
+    iTermMinimumSubsequenceMatcher *matcher = [[[iTermMinimumSubsequenceMatcher alloc] initWithQuery:@"abc"] autorelease];
+    iTermSubsequenceMatch match;
+    XCTAssertFalse([matcher getMatch:&match forDocument:@"cba"]);
+    XCTAssertFalse([matcher getMatch:&match forDocument:@""]);
+}
+
+// The bitset search must pick the same window as the posting list search, including for documents
+// that span several words of the bitset and those that are too long for it.
+- (void)testAgreesWithIndexSet {
+    srandom(1);
+    NSArray<NSString *> *queries = @[ @"a", @"ab", @"aba", @"cab", @"abcabc", @"dd" ];
+    for (NSString *query in queries) {
+        iTermMinimumSubsequenceMatcher *matcher = [[[iTermMinimumSubsequenceMatcher alloc] initWithQuery:query] autorelease];
+        for (int trial = 0; trial < 200; trial++) {
+            const NSUInteger length = random() % (trial < 150 ? 200 : 2000);
+            NSMutableString *document = [NSMutableString string];
+            for (NSUInteger i = 0; i < length; i++) {
+                [document appendFormat:@"%c", (char)('a' + random() % 5)];
+            }
+            NSIndexSet *indexSet = [matcher indexSetForDocument:document];
+            iTermSubsequenceMatch match;
+            const BOOL found = [matcher getMatch:&match forDocument:document];
+            XCTAssertEqual(found, indexSet.count > 0);
+            if (!found) {
+                continue;
+            }
+            __block NSUInteger ranges = 0;
+            [indexSet enumerateRangesUsingBlock:^(NSRange range, BOOL *stop) {
+                ranges++;
+            }];
+            XCTAssertEqual(match.first, indexSet.firstIndex);
+            XCTAssertEqual(match.last, indexSet.lastIndex);
+            XCTAssertEqual(match.gaps, ranges - 1);
+        }
+    }
+}
+
+@end
@@ -0,0 +1,344 @@
+//
+//  iTermPerformanceSuite.m
+//  iTerm2XCTests
+//
+//  Created by agent on 10/14/26.
+//
+
+// A fixed set of measurements that are compared against a stored baseline so a release that is
+// slower than the last one is caught before it ships.
+//
+// Like the other benchmarks, this is skipped unless ITERM_RUN_BENCHMARKS is set. Run it with
+// `make performance`. Results are written as JSON to ITERM_PERFORMANCE_RESULTS (default:
+// build/performance-results.json). If the baseline at ITERM_PERFORMANCE_BASELINE (default:
+// tests/performance-baseline.json) exists, any metric that is worse than the baseline by more than
+// ITERM_PERFORMANCE_TOLERANCE (a fraction, default 0.1) fails the test. Record a new baseline on
+// the reference machine with `make performance-baseline`.
+//
+// The emulation metrics use the same approach as iTermEmulationBenchmark and the Metal metrics the
+// same as iTermMetalBenchmark. They're skipped when there is no Metal device.
+
+#import <MetalKit/MetalKit.h>
+#import <XCTest/XCTest.h>
+
+#import "CVector.h"
+#import "FindContext.h"
+#import "iTermAdvancedSettingsModel.h"
+#import "iTermColorPresets.h"
+#import "iTermEncoderAdapter.h"
+#import "iTermHistogram.h"
+#import "iTermMetalDriver.h"
+#import "iTermPreferences.h"
+#import "ProfileModel.h"
+#import "PTYSession.h"
+#import "PTYTextView.h"
+#import "SessionView.h"
+#import "VT100Grid.h"
+#import "VT100Parser.h"
+#import "VT100Screen.h"
+#import "VT100Terminal.h"
+#import "VT100Token.h"
+
+#define STRINGIFY(s) #s
+#define STRINGIFY_MACRO(m) STRINGIFY(m)
+
+static const int iTermPerformanceSuiteScrollbackLines = 100000;
+static const NSUInteger iTermPerformanceSuiteReadSize = 4096;
+static const int iTermPerformanceSuiteWarmupFrames = 5;
+static const int iTermPerformanceSuiteFrames = 60;
+
+@interface iTermPerformanceSuite : XCTestCase
+@end
+
+@implementation iTermPerformanceSuite {
+    // Metric name -> { value, unit, better }
+    NSMutableDictionary<NSString *, NSDictionary *> *_metrics;
+}
+
+- (void)testPerformance {
+    if (!getenv("ITERM_RUN_BENCHMARKS")) {
+        return;
+    }
+    _metrics = [NSMutableDictionary dictionary];
+    NSData *stream = [self plainLogStreamWithLines:iTermPerformanceSuiteScrollbackLines];
+    @autoreleasepool {
+        [self measureParser:stream];
+    }
+    @autoreleasepool {
+        [self measureScreen:stream];
+    }
+    @autoreleasepool {
+        [self measureMetal];
+    }
+
+    NSDictionary *results = @{ @"version": @1,
+                               @"date": [[[[NSISO8601DateFormatter alloc] init] autorelease] stringFromDate:[NSDate date]],
+                               @"metrics": _metrics };
+    NSData *json = [NSJSONSerialization dataWithJSONObject:results
+                                                   options:NSJSONWritingPrettyPrinted | NSJSONWritingSortedKeys
+                                                     error:nil];
+    NSString *resultsPath = [self pathFromEnvironment:"ITERM_PERFORMANCE_RESULTS"
+                                              default:@"build/performance-results.json"];
+    [[NSFileManager defaultManager] createDirectoryAtPath:[resultsPath stringByDeletingLastPathComponent]
+                              withIntermediateDirectories:YES
+                                               attributes:nil
+                                                    error:nil];
+    XCTAssertTrue([json writeToFile:resultsPath atomically:YES]);
+    NSLog(@"BENCHMARK performance suite: wrote %@\n%@", resultsPath, [[[NSString alloc] initWithData:json encoding:NSUTF8StringEncoding] autorelease]);
+
+    [self compareWithBaseline];
+}
+
+#pragma mark - Results
+
+- (NSString *)pathFromEnvironment:(const char *)name default:(NSString *)relativePath {
+    const char *env = getenv(name);
+    if (env) {
+        return [NSString stringWithUTF8String:env];
+    }
+    NSString *projectDir = [NSString stringWithUTF8String:STRINGIFY_MACRO(PROJECT_DIR)];
+    return [projectDir stringByAppendingPathComponent:relativePath];
+}
+
+- (void)recordMetric:(NSString *)name value:(double)value unit:(NSString *)unit higherIsBetter:(BOOL)higherIsBetter {
+    _metrics[name] = @{ @"value": @(value),
+                        @"unit": unit,
+                        @"better": higherIsBetter ? @"higher" : @"lower" };
+}
+
+- (void)compareWithBaseline {
+    NSString *baselinePath = [self pathFromEnvironment:"ITERM_PERFORMANCE_BASELINE"
+                                               default:@"tests/performance-baseline.json"];
+    NSData *data = [NSData dataWithContentsOfFile:baselinePath];
+    if (!data) {
+        NSLog(@"BENCHMARK performance suite: no baseline at %@", baselinePath);
+        return;
+    }
+    NSDictionary *baseline = [NSJSONSerialization JSONObjectWithData:data options:0 error:nil][@"metrics"];
+    const char *toleranceEnv = getenv("ITERM_PERFORMANCE_TOLERANCE");
+    const double tolerance = toleranceEnv ? atof(toleranceEnv) : 0.1;
+    NSMutableArray<NSString *> *regressions = [NSMutableArray array];
+    for (NSString *name in [_metrics.allKeys sortedArrayUsingSelector:@selector(compare:)]) {
+        NSDictionary *expected = baseline[name];
+        if (!expected) {
+            continue;
+        }
+        const double value = [_metrics[name][@"value"] doubleValue];
+        const double reference = [expected[@"value"] doubleValue];
+        const BOOL higherIsBetter = [_metrics[name][@"better"] isEqualToString:@"higher"];
+        const BOOL regressed = higherIsBetter ? (value < reference * (1 - tolerance)) : (value > reference * (1 + tolerance));
+        if (regressed) {
+            [regressions addObject:[NSString stringWithFormat:@"%@: %.3f %@ vs baseline %.3f",
+                                    name, value, _metrics[name][@"unit"], reference]];
+        }
+    }
+    XCTAssertEqual(regressions.count, 0, @"Slower than %@ by more than %.0f%%:\n%@",
+                   baselinePath, tolerance * 100, [regressions componentsJoinedByString:@"\n"]);
+}
+
+#pragma mark - Emulation
+
+- (NSData *)plainLogStreamWithLines:(int)count {
+    NSMutableData *data = [NSMutableData data];
+    for (int i = 0; i < count; i++) {
+        NSString *line = [NSString stringWithFormat:@"2026-10-14 12:%02d:%02d.%03d INFO [worker-%d] processed request id=%08lx in %dms\r\n",
+                          (i / 60) % 60, i % 60, (i * 7) % 1000, i % 8, (unsigned long)(i * 2654435761u), i % 97];
+        [data appendData:[line dataUsingEncoding:NSUTF8StringEncoding]];
+    }
+    return data;
+}
+
+// Feeds |stream| to |terminal| in PTYTask-sized reads. Tokens are executed only if |execute| is set.
+- (void)feedStream:(NSData *)stream toTerminal:(VT100Terminal *)terminal execute:(BOOL)execute {
+    const char *bytes = stream.bytes;
+    for (NSUInteger offset = 0; offset < stream.length; offset += iTermPerformanceSuiteReadSize) {
+        @autoreleasepool {
+            const int length = (int)MIN(iTermPerformanceSuiteReadSize, stream.length - offset);
+            [terminal.parser putStreamData:bytes + offset length:length];
+            CVector vector;
+            CVectorCreate(&vector, 100);
+            [terminal.parser addParsedTokensToVector:&vector];
+            const int n = CVectorCount(&vector);
+            for (int i = 0; i < n; i++) {
+                VT100Token *token = CVectorGetObject(&vector, i);
+                if (execute) {
+                    [terminal executeToken:token];
+                }
+                [token recycle];
+            }
+            CVectorDestroy(&vector);
+        }
+    }
+}
+
+- (VT100Screen *)screenWithTerminal:(VT100Terminal *)terminal {
+    VT100Screen *screen = [[[VT100Screen alloc] initWithTerminal:terminal] autorelease];
+    terminal.delegate = screen;
+    [screen destructivelySetScreenWidth:80 height:25];
+    screen.maxScrollbackLines = iTermPerformanceSuiteScrollbackLines;
+    return screen;
+}
+
+- (void)measureParser:(NSData *)stream {
+    VT100Terminal *terminal = [[[VT100Terminal alloc] init] autorelease];
+    [self screenWithTerminal:terminal];
+    const NSTimeInterval start = [NSDate timeIntervalSinceReferenceDate];
+    [self feedStream:stream toTerminal:terminal execute:NO];
+    const NSTimeInterval elapsed = [NSDate timeIntervalSinceReferenceDate] - start;
+    [self recordMetric:@"parser_throughput"
+                 value:stream.length / (1024.0 * 1024.0) / elapsed
+                  unit:@"MB/s"
+        higherIsBetter:YES];
+}
+
+// Fills 100k lines of scrollback, then measures memory, find, and saving state over it.
+- (void)measureScreen:(NSData *)stream {
+    VT100Terminal *terminal = [[[VT100Terminal alloc] init] autorelease];
+    VT100Screen *screen = [self screenWithTerminal:terminal];
+    NSTimeInterval start = [NSDate timeIntervalSinceReferenceDate];
+    [self feedStream:stream toTerminal:terminal execute:YES];
+    NSTimeInterval elapsed = [NSDate timeIntervalSinceReferenceDate] - start;
+    [self recordMetric:@"screen_execution_throughput"
+                 value:stream.length / (1024.0 * 1024.0) / elapsed
+                  unit:@"MB/s"
+        higherIsBetter:YES];
+
+    const double lines = [screen numberOfLines];
+    [self recordMetric:@"memory_per_100k_lines"
+                 value:[[screen memoryUsage][@"scrollback"] doubleValue] * 100000 / lines / (1024 * 1024)
+                  unit:@"MB"
+        higherIsBetter:NO];
+
+    // The needle never matches, so every line is searched.
+    FindContext *context = [[[FindContext alloc] init] autorelease];
+    context.maxTime = 0;
+    start = [NSDate timeIntervalSinceReferenceDate];
+    [screen setFindString:@"no such needle"
+         forwardDirection:YES
+                     mode:iTermFindModeCaseInsensitiveSubstring
+              startingAtX:0
+              startingAtY:0
+               withOffset:0
+                inContext:context
+          multipleResults:YES];
+    NSMutableArray *results = [NSMutableArray array];
+    while ([screen continueFindAllResults:results inContext:context]) {
+    }
+    elapsed = [NSDate timeIntervalSinceReferenceDate] - start;
+    XCTAssertEqual(results.count, 0);
+    [self recordMetric:@"find_throughput"
+                 value:lines / elapsed / 1000
+                  unit:@"klines/s"
+        higherIsBetter:YES];
+
+    start = [NSDate timeIntervalSinceReferenceDate];
+    iTermMutableDictionaryEncoderAdapter *encoder = [iTermMutableDictionaryEncoderAdapter encoder];
+    int linesDropped = 0;
+    [screen encodeContents:encoder linesDropped:&linesDropped];
+    elapsed = [NSDate timeIntervalSinceReferenceDate] - start;
+    [self recordMetric:@"state_save_time"
+                 value:elapsed * 1000
+                  unit:@"ms"
+        higherIsBetter:NO];
+}
+
+#pragma mark - Metal
+
+- (PTYSession *)sessionWithSize:(VT100GridSize)size {
+    NSString *plistFile = [[NSBundle bundleForClass:[self class]] pathForResource:@"DefaultBookmark"
+                                                                           ofType:@"plist"];
+    NSMutableDictionary *profile = [NSMutableDictionary dictionaryWithContentsOfFile:plistFile];
+    iTermColorPreset *darkBackground = [iTermColorPresets presetWithName:@"Dark Background"];
+    for (NSString *colorName in [ProfileModel colorKeysWithModes:NO]) {
+        if (darkBackground[colorName]) {
+            profile[colorName] = darkBackground[colorName];
+        }
+    }
+    profile[KEY_USE_SEPARATE_COLORS_FOR_LIGHT_AND_DARK_MODE] = @NO;
+    profile[KEY_GUID] = [ProfileModel freshGuid];
+
+    PTYSession *session = [[[PTYSession alloc] initSynthetic:NO] autorelease];
+    [session setProfile:profile];
+    [session setScreenSize:NSMakeRect(0, 0, 200, 200) parent:nil];
+    [session setPreferencesFromAddressBookEntry:profile];
+    [session setSize:size];
+    session.view.frame = NSMakeRect(0,
+                                    0,
+                                    size.width * session.textview.charWidth + [iTermPreferences intForKey:kPreferenceKeySideMargins] * 2,
+                                    size.height * session.textview.lineHeight + [iTermPreferences intForKey:kPreferenceKeyTopBottomMargins] * 2);
+    [session loadInitialColorTableAndResetCursorGuide];
+    return session;
+}
+
+// Startup is measured from creating a session to its first finished Metal frame, since app launch
+// can't be timed from inside the test bundle.
+- (void)measureMetal {
+    if (!MTLCreateSystemDefaultDevice()) {
+        NSLog(@"BENCHMARK performance suite: no Metal device, skipping frame metrics");
+        return;
+    }
+    NSMutableString *input = [NSMutableString string];
+    for (int row = 0; row < 50; row++) {
+        for (int i = 0; i < 160; i++) {
+            [input appendFormat:@"%c", (char)('!' + (i + row) % 94)];
+        }
+        if (row < 49) {
+            [input appendString:@"\r\n"];
+        }
+    }
+
+    const NSTimeInterval start = [NSDate timeIntervalSinceReferenceDate];
+    PTYSession *session = [self sessionWithSize:VT100GridSizeMake(160, 50)];
+    [session synchronousReadTask:input];
+    session.useMetal = YES;
+    iTermMetalDriver *driver = session.view.driver;
+    MTKView *view = session.view.metalView;
+    if (!driver || !view) {
+        NSLog(@"BENCHMARK performance suite: Metal is unavailable, skipping frame metrics");
+        return;
+    }
+    BOOL drewFrame = NO;
+    for (int i = 0; i < 100 && !drewFrame; i++) {
+        drewFrame = [self drawFrameWithDriver:driver view:view cpuTime:nil];
+    }
+    const NSTimeInterval startup = [NSDate timeIntervalSinceReferenceDate] - start;
+    XCTAssertTrue(drewFrame);
+    [self recordMetric:@"session_start_to_first_frame"
+                 value:startup * 1000
+                  unit:@"ms"
+        higherIsBetter:NO];
+
+    for (int i = 0; i < iTermPerformanceSuiteWarmupFrames; i++) {
+        [self drawFrameWithDriver:driver view:view cpuTime:nil];
+    }
+    iTermHistogram *histogram = [[[iTermHistogram alloc] init] autorelease];
+    for (int i = 0; i < iTermPerformanceSuiteFrames; i++) {
+        [session.screen.currentGrid markAllCharsDirty:YES];
+        [self drawFrameWithDriver:driver view:view cpuTime:histogram];
+    }
+    [self recordMetric:@"frame_prep_time_p50"
+                 value:[histogram valueAtNTile:0.5]
+                  unit:@"ms"
+        higherIsBetter:NO];
+    session.useMetal = NO;
+}
+
+// Waits for the GPU so frames don't overlap and each one is measured on its own.
+- (BOOL)drawFrameWithDriver:(iTermMetalDriver *)driver view:(MTKView *)view cpuTime:(iTermHistogram *)histogram {
+    __block BOOL done = NO;
+    __block BOOL ok = NO;
+    const NSTimeInterval start = [NSDate timeIntervalSinceReferenceDate];
+    [driver drawAsynchronouslyInView:view completion:^(BOOL success) {
+        ok = success;
+        done = YES;
+    }];
+    [histogram addValue:([NSDate timeIntervalSinceReferenceDate] - start) * 1000];
+    NSDate *timeout = [NSDate dateWithTimeIntervalSinceNow:5];
+    while (!done && [timeout timeIntervalSinceNow] > 0) {
+        [[NSRunLoop currentRunLoop] runMode:NSDefaultRunLoopMode
+                                 beforeDate:[NSDate dateWithTimeIntervalSinceNow:0.001]];
+    }
+    return ok;
+}
+
+@end
@@ -0,0 +1,93 @@
+//
+//  iTermRegexLiteralTest.m
+//  iTerm2XCTests
+//
+//  Created by agent on 10/14/26.
+//
+
+#import <XCTest/XCTest.h>
+
+#import "iTermRegexLiteral.h"
+
+@interface iTermRegexLiteralTest : XCTestCase
+@end
+
+@implementation iTermRegexLiteralTest
+
+- (void)testPlainLiterals {
+    XCTAssertEqualObjects(iTermRegexRequiredLiteral(@"hello world", NO), @"hello world");
+    XCTAssertEqualObjects(iTermRegexRequiredLiteral(@"error: (.*) failed", NO), @"error: ");
+    XCTAssertEqualObjects(iTermRegexRequiredLiteral(@"(\\w+)@example\\.com", NO), @"@example.com");
+    XCTAssertEqualObjects(iTermRegexRequiredLiteral(@"Hello World", YES), @"hello world");
+    XCTAssertNil(iTermRegexRequiredLiteral(@"foo|bar", NO));
+    XCTAssertNil(iTermRegexRequiredLiteral(@"(?i)hello", NO));
+}
+
+// The characters of an interval are not literals, and the atom before it may not be present.
+- (void)testIntervals {
+    XCTAssertNil(iTermRegexRequiredLiteral(@"[0-9]{10,20}", NO));
+    XCTAssertNil(iTermRegexRequiredLiteral(@"\\d{3}-\\d{4}", NO));
+    XCTAssertEqualObjects(iTermRegexRequiredLiteral(@"a{0,3}bc", NO), @"bc");
+    XCTAssertEqualObjects(iTermRegexRequiredLiteral(@"abc{2}de", NO), @"ab");
+    XCTAssertEqualObjects(iTermRegexRequiredLiteral(@"(ab){2,}cd", NO), @"cd");
+    XCTAssertNil(iTermRegexRequiredLiteral(@"abc{", NO));
+}
+
+// Arguments of escapes must not become literals.
+- (void)testEscapesWithArguments {
+    XCTAssertEqualObjects(iTermRegexRequiredLiteral(@"\\x1b\\[31m", NO), @"[31m");
+    XCTAssertEqualObjects(iTermRegexRequiredLiteral(@"\\x1b\\]1337", NO), @"]1337");
+    XCTAssertEqualObjects(iTermRegexRequiredLiteral(@"\\x{263a}abc", NO), @"abc");
+    XCTAssertEqualObjects(iTermRegexRequiredLiteral(@"\\p{Lu}xyz", NO), @"xyz");
+    XCTAssertEqualObjects(iTermRegexRequiredLiteral(@"\\PLxyz", NO), @"xyz");
+    XCTAssertEqualObjects(iTermRegexRequiredLiteral(@"\\0101bc", NO), @"bc");
+    XCTAssertEqualObjects(iTermRegexRequiredLiteral(@"\\cXyz", NO), @"yz");
+    XCTAssertEqualObjects(iTermRegexRequiredLiteral(@"\\u00e9ab", NO), @"ab");
+    XCTAssertEqualObjects(iTermRegexRequiredLiteral(@"\\N{LATIN SMALL LETTER A}bc", NO), @"bc");
+    XCTAssertEqualObjects(iTermRegexRequiredLiteral(@"(a)\\12xy", NO), @"xy");
+    XCTAssertNil(iTermRegexRequiredLiteral(@"\\Qabc\\E", NO));
+    XCTAssertNil(iTermRegexRequiredLiteral(@"\\x{263aabc", NO));
+}
+
+// A quantifier after a character outside the BMP applies to both halves of its surrogate pair.
+- (void)testSurrogatePairs {
+    XCTAssertEqualObjects(iTermRegexRequiredLiteral(@"error\U0001F600?", NO), @"error");
+    XCTAssertEqualObjects(iTermRegexRequiredLiteral(@"xa\U0001F600*", NO), @"xa");
+    XCTAssertEqualObjects(iTermRegexRequiredLiteral(@"xa\U0001F600{0,2}", NO), @"xa");
+    XCTAssertEqualObjects(iTermRegexRequiredLiteral(@"xa\U0001F600+yz", NO), @"xa\U0001F600");
+    XCTAssertEqualObjects(iTermRegexRequiredLiteral(@"x\U0001F642yz", NO), @"x\U0001F642yz");
+    XCTAssertEqualObjects(iTermRegexRequiredLiteral(@"x\U0001F642?yz", YES), @"yz");
+}
+
+- (void)testNestedSets {
+    XCTAssertEqualObjects(iTermRegexRequiredLiteral(@"[[a-z]&&[^aeiou]]xy", NO), @"xy");
+    XCTAssertEqualObjects(iTermRegexRequiredLiteral(@"[]ab]cd", NO), @"cd");
+    XCTAssertNil(iTermRegexRequiredLiteral(@"[abc", NO));
+}
+
+// Every literal found must be in every line the regex matches.
+- (void)testLiteralIsInEveryMatch {
+    NSArray<NSArray<NSString *> *> *cases = @[
+        @[ @"[0-9]{10,20}", @"1234567890" ],
+        @[ @"a{0,3}bc", @"bc" ],
+        @[ @"\\x1b\\[31m", @"\x1b[31m" ],
+        @[ @"\\x{263a}abc", @"☺abc" ],
+        @[ @"\\p{Lu}xyz", @"Qxyz" ],
+        @[ @"\\0101bc", @"Abc" ],
+        @[ @"\\u00e9ab", @"éab" ],
+        @[ @"\\d{3}-\\d{4}", @"555-1234" ],
+        @[ @"error\U0001F600?", @"error" ],
+        @[ @"xa\U0001F600{0,2}", @"xa" ],
+    ];
+    for (NSArray<NSString *> *testCase in cases) {
+        NSRegularExpression *regex = [NSRegularExpression regularExpressionWithPattern:testCase[0] options:0 error:nil];
+        XCTAssertNotNil(regex, @"%@", testCase[0]);
+        XCTAssertEqual([regex numberOfMatchesInString:testCase[1] options:0 range:NSMakeRange(0, testCase[1].length)], 1, @"%@", testCase[0]);
+        NSString *literal = iTermRegexRequiredLiteral(testCase[0], NO);
+        if (literal) {
+            XCTAssertTrue([testCase[1] containsString:literal], @"%@ gave %@", testCase[0], literal);
+        }
+    }
+}
+
+@end
@@ -0,0 +1,100 @@
+//
+//  iTermTokenExecutionSchedulerTest.m
+//  iTerm2XCTests
+//
+//  Created by agent on 10/14/26.
+//
+
+#import <XCTest/XCTest.h>
+
+#import "iTermTokenExecutionScheduler.h"
+
+#include <unistd.h>
+
+// A client with a fixed number of turns' worth of work. Each turn takes |turnDuration| seconds,
+// whatever the budget, like a session whose tokens are slow to execute.
+@interface iTermFakeTokenExecutionClient : NSObject<iTermTokenExecutionSchedulerClient>
+@property (nonatomic) int weight;
+@property (nonatomic) int turnsNeeded;
+@property (nonatomic) NSTimeInterval turnDuration;
+@property (nonatomic, readonly) int turnsTaken;
+@property (nonatomic, readonly) int lastTokenBudget;
+@property (nonatomic, readonly) int lastByteBudget;
+@end
+
+@implementation iTermFakeTokenExecutionClient
+
+- (BOOL)tokenExecutionSchedulerExecuteWithTokenBudget:(int)tokenBudget byteBudget:(int)byteBudget {
+    _lastTokenBudget = tokenBudget;
+    _lastByteBudget = byteBudget;
+    if (_turnDuration > 0) {
+        usleep((useconds_t)(_turnDuration * 1000000));
+    }
+    _turnsTaken++;
+    return _turnsTaken < _turnsNeeded;
+}
+
+- (int)tokenExecutionSchedulerWeight {
+    return _weight;
+}
+
+@end
+
+@interface iTermTokenExecutionSchedulerTest : XCTestCase
+@end
+
+@implementation iTermTokenExecutionSchedulerTest
+
+- (void)runUntil:(BOOL (^)(void))condition {
+    NSDate *timeout = [NSDate dateWithTimeIntervalSinceNow:5];
+    while (!condition() && [timeout timeIntervalSinceNow] > 0) {
+        [[NSRunLoop mainRunLoop] runMode:NSDefaultRunLoopMode
+                              beforeDate:[NSDate dateWithTimeIntervalSinceNow:0.01]];
+    }
+}
+
+- (iTermFakeTokenExecutionClient *)clientWithWeight:(int)weight turns:(int)turns duration:(NSTimeInterval)duration {
+    iTermFakeTokenExecutionClient *client = [[[iTermFakeTokenExecutionClient alloc] init] autorelease];
+    client.weight = weight;
+    client.turnsNeeded = turns;
+    client.turnDuration = duration;
+    return client;
+}
+
+- (void)testBudgetsScaleWithWeight {
+    iTermTokenExecutionScheduler *scheduler = [[[iTermTokenExecutionScheduler alloc] init] autorelease];
+    iTermFakeTokenExecutionClient *light = [self clientWithWeight:1 turns:1 duration:0];
+    iTermFakeTokenExecutionClient *heavy = [self clientWithWeight:4 turns:1 duration:0];
+    [scheduler scheduleClient:light];
+    [scheduler scheduleClient:heavy];
+    [self runUntil:^BOOL{
+        return light.turnsTaken == 1 && heavy.turnsTaken == 1;
+    }];
+    XCTAssertEqual(light.turnsTaken, 1);
+    XCTAssertEqual(heavy.turnsTaken, 1);
+    XCTAssertEqual(heavy.lastTokenBudget, light.lastTokenBudget * 4);
+    XCTAssertEqual(heavy.lastByteBudget, light.lastByteBudget * 4);
+    XCTAssertGreaterThan(light.lastByteBudget, 0);
+}
+
+// A heavy client whose every turn overruns the time slice must not keep a light one waiting
+// until it's done.
+- (void)testLightClientIsNotStarvedByOverrunningHeavyClient {
+    iTermTokenExecutionScheduler *scheduler = [[[iTermTokenExecutionScheduler alloc] init] autorelease];
+    iTermFakeTokenExecutionClient *heavy = [self clientWithWeight:4 turns:20 duration:0.02];
+    iTermFakeTokenExecutionClient *light = [self clientWithWeight:1 turns:3 duration:0];
+    [scheduler scheduleClient:heavy];
+    [scheduler scheduleClient:light];
+    [self runUntil:^BOOL{
+        return light.turnsTaken == light.turnsNeeded;
+    }];
+    XCTAssertEqual(light.turnsTaken, 3);
+    XCTAssertLessThan(heavy.turnsTaken, heavy.turnsNeeded);
+
+    [self runUntil:^BOOL{
+        return heavy.turnsTaken == heavy.turnsNeeded;
+    }];
+    XCTAssertEqual(heavy.turnsTaken, 20);
+}
+
+@end
@@ -0,0 +1,128 @@
+//
+//  iTermTriggerMatcherTest.m
+//  iTerm2XCTests
+//
+//  Created by agent on 10/14/26.
+//
+
+#import <XCTest/XCTest.h>
+
+#import "iTermTriggerMatcher.h"
+
+@interface iTermTriggerMatcherTest : XCTestCase
+@end
+
+@implementation iTermTriggerMatcherTest
+
+- (NSArray<NSString *> *)regexes {
+    return @[ @"\\x1b\\]1337",
+              @"\\d{3}-\\d{4}",
+              @"[0-9]{10,20}",
+              @"a{0,3}bc",
+              @"error: (.*) failed",
+              @"\\p{Lu}xyz",
+              @"\\u00e9t\\u00e9",
+              @"(\\w+)@example\\.com",
+              @"^\\$ $",
+              @"warning" ];
+}
+
+// Without the prefilter every regex would be tried. Every regex that matches must still be a
+// candidate.
+- (void)assertCandidatesIncludeMatchesInString:(NSString *)string
+                                       regexes:(NSArray<NSString *> *)regexes
+                                       matcher:(iTermTriggerMatcher *)matcher {
+    NSIndexSet *candidates = [matcher indexesOfRegexesThatMayMatchString:string];
+    [regexes enumerateObjectsUsingBlock:^(NSString *pattern, NSUInteger idx, BOOL *stop) {
+        NSRegularExpression *regex = [NSRegularExpression regularExpressionWithPattern:pattern options:0 error:nil];
+        XCTAssertNotNil(regex, @"%@", pattern);
+        const BOOL matches = [regex numberOfMatchesInString:string options:0 range:NSMakeRange(0, string.length)] > 0;
+        if (matches) {
+            XCTAssertTrue([candidates containsIndex:idx], @"%@ matches %@ but is not a candidate", pattern, string);
+        }
+    }];
+}
+
+- (void)testMatchingRegexesAreCandidates {
+    iTermTriggerMatcher *matcher = [[[iTermTriggerMatcher alloc] initWithRegexes:[self regexes]] autorelease];
+    NSArray<NSString *> *strings = @[ @"\x1b]1337;SetMark\x07",
+                                      @"call 555-1234 now",
+                                      @"id 123456789012",
+                                      @"bc",
+                                      @"aaabc",
+                                      @"error: disk failed",
+                                      @"Qxyz",
+                                      @"été",
+                                      @"mail george@example.com",
+                                      @"$ ",
+                                      @"warning: unused variable",
+                                      @"nothing to see here" ];
+    for (NSString *string in strings) {
+        [self assertCandidatesIncludeMatchesInString:string regexes:[self regexes] matcher:matcher];
+    }
+}
+
+- (void)testMatchingRegexesAreCandidatesInNonASCIIStrings {
+    NSArray<NSString *> *regexes = @[ @"(?i)warning",
+                                      @"caf\u00e9 au lait",
+                                      @"cafe\u0301",
+                                      @"\U0001F642 ok",
+                                      @"\u5168\u89d2 mode",
+                                      @"ok done" ];
+    iTermTriggerMatcher *matcher = [[[iTermTriggerMatcher alloc] initWithRegexes:regexes] autorelease];
+    NSArray<NSString *> *strings = @[ @"WARNING: low disk",
+                                      @"Warning",
+                                      @"un caf\u00e9 au lait",
+                                      @"un cafe\u0301 au lait",
+                                      @"\U0001F642 ok done",
+                                      @"\U0001F642\U0001F642 ok",
+                                      @"\u5168\u89d2 mode on",
+                                      @"x\u5168\u89d2 mode",
+                                      @"\u00e9ok done" ];
+    for (NSString *string in strings) {
+        [self assertCandidatesIncludeMatchesInString:string regexes:regexes matcher:matcher];
+    }
+    // Inline flags mean there is no literal, so it's a candidate even without a match.
+    XCTAssertTrue([[matcher indexesOfRegexesThatMayMatchString:@"nothing"] containsIndex:0]);
+}
+
+// The quantifier applies to the whole surrogate pair, so the lines without the emoji still match.
+- (void)testQuantifiedCharactersOutsideBMP {
+    NSArray<NSString *> *regexes = @[ @"xa\U0001F600?", @"xa\U0001F600*", @"xa\U0001F600{0,2}", @"error\U0001F600?" ];
+    iTermTriggerMatcher *matcher = [[[iTermTriggerMatcher alloc] initWithRegexes:regexes] autorelease];
+    NSArray<NSString *> *strings = @[ @"xa",
+                                      @"xa\U0001F600",
+                                      @"xa\U0001F600\U0001F600",
+                                      @"an error",
+                                      @"error\U0001F600" ];
+    for (NSString *string in strings) {
+        [self assertCandidatesIncludeMatchesInString:string regexes:regexes matcher:matcher];
+    }
+    NSIndexSet *candidates = [matcher indexesOfRegexesThatMayMatchString:@"only xa here"];
+    XCTAssertTrue([candidates containsIndex:0]);
+    XCTAssertTrue([candidates containsIndex:1]);
+    XCTAssertTrue([candidates containsIndex:2]);
+}
+
+- (void)testRegexesWithoutLiteralsAreAlwaysCandidates {
+    iTermTriggerMatcher *matcher = [[[iTermTriggerMatcher alloc] initWithRegexes:[self regexes]] autorelease];
+    NSIndexSet *candidates = [matcher indexesOfRegexesThatMayMatchString:@"nothing to see here"];
+    // \d{3}-\d{4} and [0-9]{10,20} have no literal of two or more characters.
+    XCTAssertTrue([candidates containsIndex:1]);
+    XCTAssertTrue([candidates containsIndex:2]);
+    // "warning" does, and it isn't present.
+    XCTAssertFalse([candidates containsIndex:9]);
+}
+
+// Scanning from maximumLiteralLength-1 characters before the old end finds literals that span
+// the boundary.
+- (void)testIncrementalScanFindsLiteralsSpanningOldEnd {
+    iTermTriggerMatcher *matcher = [[[iTermTriggerMatcher alloc] initWithRegexes:@[ @"warning" ]] autorelease];
+    NSString *old = @"xx warn";
+    NSString *string = @"xx warning";
+    const NSUInteger location = old.length - (matcher.maximumLiteralLength - 1);
+    XCTAssertTrue([[matcher indexesOfRegexesThatMayMatchString:string fromIndex:location] containsIndex:0]);
+    XCTAssertFalse([[matcher indexesOfRegexesThatMayMatchString:old] containsIndex:0]);
+}
+
+@end
@@ -144,40 +144,6 @@ typedef void (^DeferralBlock)(void);
     return [NSDate dateWithTimeIntervalSince1970:t];
 }
 
-// Walks from newest (fromCommit) to oldest (toCommit). block is called for `fromCommit` but not
-// for `toCommit`.
-- (void)enumerateCommitsFrom:(const git_oid *)fromCommit
-                          to:(const git_oid *)toCommit
-                       block:(void (^)(const git_oid *oid))block {
-    git_revwalk *walker = NULL;
-    const int error = git_revwalk_new(&walker, _repo);
-    if (error) {
-        git_revwalk_free(walker);
-        return;
-    }
-
-    git_revwalk_sorting(walker, GIT_SORT_TOPOLOGICAL);
-    git_revwalk_push(walker, fromCommit);
-    git_oid oid;
-    while (git_revwalk_next(&oid, walker) == 0) {
-        if (0 == git_oid_cmp(&oid, toCommit)) {
-            break;
-        }
-        block(&oid);
-    }
-    git_revwalk_free(walker);
-    walker = NULL;
-}
-
-- (NSInteger)numberOfCommitsFrom:(const git_oid *)fromCommit
-                              to:(const git_oid *)toCommit {
-    __block NSInteger count = 0;
-    [self enumerateCommitsFrom:fromCommit to:toCommit block:^(const git_oid *oid) {
-        count += 1;
-    }];
-    return count;
-}
-
 // git rev-list --left-right --count HEAD...@'{u}'
 // see https://github.com/JuliaLang/julia/blob/345ce78da9aba498e4d7c2dee5f11e6fbf4ddc7c/stdlib/LibGit2/src/LibGit2.jl#L650
 - (BOOL)getCountsFromRef:(git_reference *)ref
@@ -196,16 +162,28 @@ typedef void (^DeferralBlock)(void);
 
     const git_oid *remote_oid = git_reference_target(upstream_ref);
     if (local_head_oid == NULL || remote_oid == NULL) {
+        git_reference_free(upstream_ref);
         return NO;
     }
+    // Unrelated histories have no merge base and would otherwise be walked in full.
     git_oid merge_base = {0};
     error = git_merge_base(&merge_base, _repo, local_head_oid, remote_oid);
+    if (error) {
+        git_reference_free(upstream_ref);
+        return NO;
+    }
+    // This stops at the merge bases rather than sorting the whole history topologically, which
+    // is what made this slow in repos with a long history.
+    size_t ahead = 0;
+    size_t behind = 0;
+    error = git_graph_ahead_behind(&ahead, &behind, _repo, local_head_oid, remote_oid);
+    git_reference_free(upstream_ref);
     if (error) {
         return NO;
     }
 
-    *pullCount = [self numberOfCommitsFrom:local_head_oid to:&merge_base];
-    *pushCount = [self numberOfCommitsFrom:remote_oid to:&merge_base];
+    *pullCount = ahead;
+    *pushCount = behind;
 
     return YES;
 }
@@ -228,12 +206,66 @@ typedef void (^DeferralBlock)(void);
 }
 
 // git ls-files --others --exclude-standard | wc -l
+// Looking for untracked files means walking the whole working tree, which takes longer than the
+// timeout in huge repos. Leaving them out still gives a useful answer.
+- (BOOL)isHuge {
+    static const size_t maxEntries = 100000;
+    git_index *index = NULL;
+    if (git_repository_index(&index, _repo)) {
+        return NO;
+    }
+    const size_t count = git_index_entrycount(index);
+    git_index_free(index);
+    return count > maxEntries;
+}
+
 - (BOOL)getDeletions:(NSInteger *)deletionsPtr untracked:(NSInteger *)untrackedPtr {
     git_status_list *status_list = NULL;
     git_status_options status_options = GIT_STATUS_OPTIONS_INIT;
     status_options.show = GIT_STATUS_SHOW_INDEX_AND_WORKDIR;
-    status_options.flags = (GIT_STATUS_OPT_INCLUDE_UNTRACKED |
+    status_options.flags = GIT_STATUS_OPT_RENAMES_HEAD_TO_INDEX;
+    if (![self isHuge]) {
+        status_options.flags |= GIT_STATUS_OPT_INCLUDE_UNTRACKED;
+    }
+    const int error = git_status_list_new(&status_list, _repo, &status_options);
+    if (error) {
+        return NO;
+    }
+
+    NSInteger deletions = 0;
+    NSInteger untracked = 0;
+
+    const size_t count = git_status_list_entrycount(status_list);
+    for (size_t i = 0; i < count; i++) {
+        const git_status_entry *status_entry = git_status_byindex(status_list, i);
+        if (status_entry->status & GIT_STATUS_WT_DELETED) {
+            deletions += 1;
+        }
+        if (status_entry->status & GIT_STATUS_WT_NEW) {
+            untracked += 1;
+        }
+    }
+    git_status_list_free(status_list);
+
+    *deletionsPtr = deletions;
+    *untrackedPtr = untracked;
+
+    return YES;
+}
+
+// Like repoIsDirty and getDeletions:untracked: but with one scan of the working tree instead of
+// two.
+- (BOOL)getDirty:(BOOL *)dirtyPtr
+       deletions:(NSInteger *)deletionsPtr
+       untracked:(NSInteger *)untrackedPtr {
+    git_status_list *status_list = NULL;
+    git_status_options status_options = GIT_STATUS_OPTIONS_INIT;
+    status_options.show = GIT_STATUS_SHOW_INDEX_AND_WORKDIR;
+    status_options.flags = (GIT_STATUS_OPT_EXCLUDE_SUBMODULES |
                             GIT_STATUS_OPT_RENAMES_HEAD_TO_INDEX);
+    if (![self isHuge]) {
+        status_options.flags |= GIT_STATUS_OPT_INCLUDE_UNTRACKED;
+    }
     const int error = git_status_list_new(&status_list, _repo, &status_options);
     if (error) {
         return NO;
@@ -254,6 +286,7 @@ typedef void (^DeferralBlock)(void);
     }
     git_status_list_free(status_list);
 
+    *dirtyPtr = count > 0;
     *deletionsPtr = deletions;
     *untrackedPtr = untracked;
 
@@ -312,13 +345,12 @@ static int GitForEachCallback(git_reference *ref, void *data) {
         state.pullArrow = @"";
     }
 
-    // Get dirty
-    state.dirty = [client repoIsDirty];
-
-    // Untracked files & deleted but tracked files
+    // Get dirty, untracked files & deleted but tracked files
+    BOOL dirty = NO;
     NSInteger deletions = 0;
     NSInteger untracked = 0;
-    if ([client getDeletions:&deletions untracked:&untracked]) {
+    if ([client getDirty:&dirty deletions:&deletions untracked:&untracked]) {
+        state.dirty = dirty;
         state.adds = untracked;
         state.deletes = deletions;
     }
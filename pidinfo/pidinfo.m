@@ -193,6 +193,65 @@ static int MakeNonBlocking(int fd) {
     }];
 }
 
+static NSData *PIDInfoCopy(pid_t pid, int flavor, int size) {
+    if (size <= 0 || size > 1024 * 1024) {
+        return nil;
+    }
+    NSMutableData *data = [NSMutableData dataWithLength:size];
+    const int rc = proc_pidinfo(pid, flavor, 0, data.mutableBytes, size);
+    if (rc <= 0) {
+        return nil;
+    }
+    data.length = MIN(rc, size);
+    return data;
+}
+
+// Asking with no buffer gives the size needed for a list.
+static NSData *PIDInfoCopyList(pid_t pid, int flavor) {
+    return PIDInfoCopy(pid, flavor, proc_pidinfo(pid, flavor, 0, NULL, 0));
+}
+
+static NSDictionary<NSNumber *, NSData *> *PIDInfoFields(pid_t pid, iTermPidInfoFields fields) {
+    NSMutableDictionary<NSNumber *, NSData *> *result = [NSMutableDictionary dictionary];
+    if (fields & iTermPidInfoFieldTaskAllInfo) {
+        result[@(iTermPidInfoFieldTaskAllInfo)] = PIDInfoCopy(pid, PROC_PIDTASKALLINFO, sizeof(struct proc_taskallinfo));
+    }
+    if (fields & iTermPidInfoFieldFileDescriptors) {
+        result[@(iTermPidInfoFieldFileDescriptors)] = PIDInfoCopyList(pid, PROC_PIDLISTFDS);
+    }
+    if (fields & iTermPidInfoFieldFilePorts) {
+        result[@(iTermPidInfoFieldFilePorts)] = PIDInfoCopyList(pid, PROC_PIDLISTFILEPORTS);
+    }
+    if (fields & iTermPidInfoFieldVnodePathInfo) {
+        result[@(iTermPidInfoFieldVnodePathInfo)] = PIDInfoCopy(pid, PROC_PIDVNODEPATHINFO, sizeof(struct proc_vnodepathinfo));
+    }
+    return result;
+}
+
+- (void)getProcessInfoForProcessIDs:(NSArray<NSNumber *> *)pids
+                             fields:(NSNumber *)fields
+                              reqid:(int)reqid
+                          withReply:(void (^)(NSArray<NSDictionary<NSNumber *, NSData *> *> * _Nullable))reply {
+    [self performRiskyBlock:^(BOOL shouldPerform, BOOL (^completion)(void)) {
+        if (!shouldPerform) {
+            reply(nil);
+            syslog(LOG_WARNING,
+                   "pidinfo %d detected wedged proc_pidinfo for %d processes, fields %lu. Count is %d.",
+                   reqid, (int)pids.count, (unsigned long)fields.unsignedIntegerValue, self->_numWedged);
+            return;
+        }
+        NSMutableArray<NSDictionary<NSNumber *, NSData *> *> *infos = [NSMutableArray arrayWithCapacity:pids.count];
+        for (NSNumber *pid in pids) {
+            [infos addObject:PIDInfoFields(pid.intValue, fields.unsignedIntegerValue)];
+        }
+        if (!completion()) {
+            syslog(LOG_INFO, "pidinfo reqid %d finished after timing out", reqid);
+            return;
+        }
+        reply(infos);
+    }];
+}
+
 - (void)checkIfDirectoryExists:(NSString *)directory withReply:(void (^)(NSNumber * _Nullable))reply {
     [self performRiskyBlock:^(BOOL shouldPerform, BOOL (^ _Nullable completion)(void)) {
         if (!shouldPerform) {
@@ -11,6 +11,14 @@
 
 NS_ASSUME_NONNULL_BEGIN
 
+// What -getProcessInfoForProcessIDs:fields:reqid:withReply: should fetch.
+typedef NS_OPTIONS(NSUInteger, iTermPidInfoFields) {
+    iTermPidInfoFieldTaskAllInfo = 1 << 0,  // struct proc_taskallinfo
+    iTermPidInfoFieldFileDescriptors = 1 << 1,  // Array of struct proc_fdinfo
+    iTermPidInfoFieldFilePorts = 1 << 2,  // Array of struct proc_fileportinfo
+    iTermPidInfoFieldVnodePathInfo = 1 << 3,  // struct proc_vnodepathinfo
+};
+
 // The protocol that this service will vend as its API. This header file will also need to be visible to the process hosting the service.
 @protocol pidinfoProtocol
 
@@ -21,6 +29,16 @@ NS_ASSUME_NONNULL_BEGIN
                              reqid:(int)reqid
                          withReply:(void (^ _Nonnull)(NSNumber *rc, NSData *buffer))reply;
 
+// Fetches several fields for several processes in one round trip. Lists are sized by the service,
+// so there's no need to ask for their length first. The reply has one dictionary per pid, in the
+// same order, that maps each field (as an NSNumber) to the bytes proc_pidinfo returned. Fields
+// that couldn't be read are absent. Large replies are moved out of line by XPC rather than copied
+// through the message.
+- (void)getProcessInfoForProcessIDs:(NSArray<NSNumber *> *)pids
+                             fields:(NSNumber *)fields
+                              reqid:(int)reqid
+                          withReply:(void (^)(NSArray<NSDictionary<NSNumber *, NSData *> *> * _Nullable infos))reply;
+
 - (void)handshakeWithReply:(void (^)(void))reply;
 
 - (void)checkIfDirectoryExists:(NSString *)directory
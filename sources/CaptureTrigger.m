@@ -58,6 +58,11 @@ static NSString *const kSuppressCaptureOutputToolNotVisibleWarning =
     }
 }
 
+// The mark is placed at the cursor.
+- (BOOL)needsSynchronousEvaluation {
+    return YES;
+}
+
 - (BOOL)performActionWithCapturedStrings:(NSString *const *)capturedStrings
                           capturedRanges:(const NSRange *)capturedRanges
                             captureCount:(NSInteger)captureCount
@@ -10,6 +10,7 @@
 
 @class CaptureTrigger;
 @class iTermCapturedOutputMark;
+@class iTermCapturedOutputStore;
 
 @interface CapturedOutput : NSObject
 @property(nonatomic, copy) NSString *line;
@@ -28,4 +29,8 @@
 - (BOOL)canMergeFrom:(CapturedOutput *)other;
 - (void)mergeFrom:(CapturedOutput *)other;
 
+// Moves |line| and |values| into |store|. They are read back from it each time they're accessed
+// until one of them is set.
+- (void)moveStringsToStore:(iTermCapturedOutputStore *)store;
+
 @end
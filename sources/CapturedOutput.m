@@ -9,6 +9,7 @@
 #import "CapturedOutput.h"
 #import "CaptureTrigger.h"
 #import "iTermCapturedOutputMark.h"
+#import "iTermCapturedOutputStore.h"
 #import "NSDictionary+iTerm.h"
 #import "NSObject+iTerm.h"
 #import "VT100ScreenMark.h"
@@ -23,7 +24,15 @@ NSString *const kCapturedOutputMarkGuidKey = @"Mark Guid";
 @property(nonatomic, retain) NSData *triggerDigest;
 @end
 
-@implementation CapturedOutput
+@implementation CapturedOutput {
+    // When set, line and values are in the store at _storeLocation rather than in _line and _values.
+    iTermCapturedOutputStore *_store;
+    iTermCapturedOutputStoreLocation _storeLocation;
+}
+
+// The accessors are custom, so ask for the ivars explicitly.
+@synthesize line = _line;
+@synthesize values = _values;
 
 + (instancetype)capturedOutputWithDictionary:(NSDictionary *)dict {
     CapturedOutput *capturedOutput = [[[CapturedOutput alloc] init] autorelease];
@@ -44,10 +53,72 @@ NSString *const kCapturedOutputMarkGuidKey = @"Mark Guid";
     [_markGuid release];
     [_line release];
     [_triggerDigest release];
+    [_store release];
 
     [super dealloc];
 }
 
+- (NSString *)line {
+    if (_store) {
+        return [_store stringsAtLocation:_storeLocation].firstObject;
+    }
+    return _line;
+}
+
+- (void)setLine:(NSString *)line {
+    [self moveStringsOutOfStore];
+    [_line autorelease];
+    _line = [line copy];
+}
+
+- (NSArray *)values {
+    if (_store) {
+        NSArray<NSString *> *strings = [_store stringsAtLocation:_storeLocation];
+        if (strings.count == 0) {
+            return @[];
+        }
+        return [strings subarrayWithRange:NSMakeRange(1, strings.count - 1)];
+    }
+    return _values;
+}
+
+- (void)setValues:(NSArray *)values {
+    [self moveStringsOutOfStore];
+    [_values autorelease];
+    _values = [values copy];
+}
+
+- (void)moveStringsToStore:(iTermCapturedOutputStore *)store {
+    if (_store || !_line) {
+        return;
+    }
+    // Captured values are normally strings. Anything else (e.g., NSNull) would not survive.
+    for (id value in _values) {
+        if (![value isKindOfClass:[NSString class]]) {
+            return;
+        }
+    }
+    _storeLocation = [store appendStrings:[@[ _line ] arrayByAddingObjectsFromArray:_values ?: @[]]];
+    _store = [store retain];
+    [_line release];
+    _line = nil;
+    [_values release];
+    _values = nil;
+}
+
+- (void)moveStringsOutOfStore {
+    if (!_store) {
+        return;
+    }
+    NSArray<NSString *> *strings = [_store stringsAtLocation:_storeLocation];
+    [_store release];
+    _store = nil;
+    if (strings.count > 0) {
+        _line = [strings[0] copy];
+        _values = [[strings subarrayWithRange:NSMakeRange(1, strings.count - 1)] copy];
+    }
+}
+
 - (void)setKnownTriggers:(NSArray *)knownTriggers {
     if (!_trigger && _triggerDigest) {
         for (CaptureTrigger *trigger in knownTriggers) {
@@ -63,8 +134,8 @@ NSString *const kCapturedOutputMarkGuidKey = @"Mark Guid";
 
 - (NSDictionary *)dictionaryValue {
     NSDictionary *dict =
-        @{ kCapturedOutputLineKey: _line ?: [NSNull null],
-         kCapturedOutputValuesKey: _values ?: @[],
+        @{ kCapturedOutputLineKey: self.line ?: [NSNull null],
+         kCapturedOutputValuesKey: self.values ?: @[],
     kCapturedOutputTriggerHashKey: _trigger.digest ?: [NSData data],
           kCapturedOutputStateKey: @(_state),
        kCapturedOutputMarkGuidKey: _mark.guid ?: @"Mark Missing" };
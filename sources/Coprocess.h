@@ -20,7 +20,6 @@
 @property(nonatomic, assign) pid_t pid;  // -1 after termination
 @property(nonatomic, assign) int outputFd;  // for writing
 @property(nonatomic, assign) int inputFd;  // for reading
-@property(nonatomic, readonly) NSMutableData *outputBuffer;
 @property(nonatomic, readonly) NSMutableData *inputBuffer;
 @property(nonatomic, assign) BOOL eof;
 @property(nonatomic, assign) BOOL mute;
@@ -35,7 +34,10 @@
 + (void)setSilentlyIgnoreErrors:(BOOL)shouldIgnore fromCommand:(NSString *)command;
 + (BOOL)shouldIgnoreErrorsFromCommand:(NSString *)command;
 
-// Write from outputBuffer
+// Queues bytes to be written to the coprocess by -write.
+- (void)appendOutputBytes:(const char *)bytes length:(int)length;
+
+// Write queued output
 - (int)write;
 
 // Read to end of inputBuffer
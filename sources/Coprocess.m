@@ -12,6 +12,9 @@
 
 const int kMaxInputBufferSize = 1024;
 const int kMaxOutputBufferSize = 1024;
+// Written bytes are dropped from the front of the output buffer only once there are this many, so
+// a coprocess that reads slowly doesn't cause the whole buffer to be moved after every write.
+static const NSUInteger kOutputBufferCompactionThreshold = 64 * 1024;
 
 static NSString *kCoprocessMruKey = @"Coprocess MRU";
 static NSString *const iTermCoprocessCommandsToIgnoreErrorOutputPrefsKey = @"NoSyncCoprocessCommandsToIgnoreErrorOutput";
@@ -27,13 +30,15 @@ static NSString *const iTermCoprocessCommandsToIgnoreErrorOutputPrefsKey = @"NoS
     BOOL writePipeClosed_;
 
     NSMutableString *_errors;
+    NSMutableData *outputBuffer_;
+    // Number of bytes at the start of outputBuffer_ that have already been written.
+    NSUInteger _outputOffset;
 }
 
 @synthesize pid = pid_;
 @synthesize outputFd = outputFd_;
 @synthesize inputFd = inputFd_;
 @synthesize inputBuffer = inputBuffer_;
-@synthesize outputBuffer = outputBuffer_;
 @synthesize eof = eof_;
 @synthesize mute = mute_;
 
@@ -213,22 +218,35 @@ static NSString *const iTermCoprocessCommandsToIgnoreErrorOutputPrefsKey = @"NoS
     });
 }
 
+- (void)appendOutputBytes:(const char *)bytes length:(int)length {
+    [outputBuffer_ appendBytes:bytes length:length];
+}
+
 - (int)write
 {
     if (self.pid < 0 || writePipeClosed_) {
         return -1;
     }
     int fd = [self writeFileDescriptor];
-    int n = write(fd, [outputBuffer_ bytes], [outputBuffer_ length]);
+    int n = write(fd,
+                  (const char *)[outputBuffer_ bytes] + _outputOffset,
+                  [outputBuffer_ length] - _outputOffset);
 
     if (n < 0 && (!(errno == EAGAIN || errno == EINTR))) {
         writePipeClosed_ = YES;
     } else if (n == 0) {
         writePipeClosed_ = YES;
     } else if (n > 0) {
-        [outputBuffer_ replaceBytesInRange:NSMakeRange(0, n)
-                                 withBytes:""
-                                    length:0];
+        _outputOffset += n;
+        if (_outputOffset == outputBuffer_.length) {
+            outputBuffer_.length = 0;
+            _outputOffset = 0;
+        } else if (_outputOffset >= kOutputBufferCompactionThreshold) {
+            [outputBuffer_ replaceBytesInRange:NSMakeRange(0, _outputOffset)
+                                     withBytes:""
+                                        length:0];
+            _outputOffset = 0;
+        }
     }
     return n;
 }
@@ -241,8 +259,12 @@ static NSString *const iTermCoprocessCommandsToIgnoreErrorOutputPrefsKey = @"NoS
     int rc = 0;
     int fd = [self readFileDescriptor];
     while (inputBuffer_.length < kMaxInputBufferSize) {
-        char buffer[1024];
-        int n = read(fd, buffer, sizeof(buffer));
+        // Read straight into the buffer rather than copying from the stack.
+        const NSUInteger offset = inputBuffer_.length;
+        const int size = 1024;
+        inputBuffer_.length = offset + size;
+        int n = read(fd, (char *)inputBuffer_.mutableBytes + offset, size);
+        inputBuffer_.length = offset + MAX(n, 0);
         if (n == 0) {
             rc = 0;
             eof_ = YES;
@@ -255,9 +277,8 @@ static NSString *const iTermCoprocessCommandsToIgnoreErrorOutputPrefsKey = @"NoS
             }
         } else {
             rc += n;
-            [inputBuffer_ appendBytes:buffer length:n];
         }
-        if (n < sizeof(buffer)) {
+        if (n < size) {
             break;
         }
     }
@@ -271,7 +292,7 @@ static NSString *const iTermCoprocessCommandsToIgnoreErrorOutputPrefsKey = @"NoS
 
 - (BOOL)wantToWrite
 {
-    return self.pid >= 0 && !eof_ && !writePipeClosed_ && (outputBuffer_.length > 0);
+    return self.pid >= 0 && !eof_ && !writePipeClosed_ && (outputBuffer_.length > _outputOffset);
 }
 
 - (void)mainProcessDidTerminate
@@ -66,4 +66,11 @@
 - (NSDictionary *)dictionaryValueFrom:(long long)from to:(long long)to;
 - (long long)firstTimestampAfter:(long long)timestamp;
 
+// Bytes allocated for the circular buffer, which is reserved up front.
+- (long long)memoryUsage;
+
+// Drops all recorded frames to free memory. Does nothing while a decoder exists (i.e., during
+// instant replay). Returns the number of bytes the frames used.
+- (long long)discardHistory;
+
 @end
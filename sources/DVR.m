@@ -29,6 +29,7 @@
 
 #import "DVR.h"
 #import "DVRIndexEntry.h"
+#import "iTermAdvancedSettingsModel.h"
 #import "NSData+iTerm.h"
 #import "ScreenChar.h"
 #include <sys/time.h>
@@ -38,11 +39,30 @@
     int capacity_;
     NSMutableArray* decoders_;
     DVREncoder* encoder_;
+
+    // Loaded from a dictionary whose frames may use compact encodings.
+    BOOL loadedCompactFrames_;
+
+    // If set, frames are encoded on this queue and the buffer, encoder, and decoders_ are only
+    // accessed on it.
+    dispatch_queue_t queue_;
+
+    // Frames handed to queue_ but not yet encoded. Only accessed on the main thread.
+    int pendingFrames_;
+
+    // Set when a frame was dropped because the queue fell behind. The next frame can't be
+    // described relative to one the encoder never saw.
+    BOOL droppedFrame_;
 }
 
 @synthesize readOnly = readOnly_;
 
 - (instancetype)initWithBufferCapacity:(int)bytes {
+    return [self initWithBufferCapacity:bytes
+                             background:[iTermAdvancedSettingsModel recordInstantReplayInBackground]];
+}
+
+- (instancetype)initWithBufferCapacity:(int)bytes background:(BOOL)background {
     self = [super init];
     if (self) {
         buffer_ = [DVRBuffer alloc];
@@ -51,12 +71,19 @@
         decoders_ = [[NSMutableArray alloc] init];
         encoder_ = [DVREncoder alloc];
         [encoder_ initWithBuffer:buffer_];
+        if (background) {
+            queue_ = dispatch_queue_create("com.iterm2.dvr", DISPATCH_QUEUE_SERIAL);
+        }
     }
     return self;
 }
 
 - (void)dealloc
 {
+    // Queued frames retain self, so none can be pending here.
+    if (queue_) {
+        dispatch_release(queue_);
+    }
     [decoders_ release];
     [encoder_ release];
     [buffer_ release];
@@ -76,6 +103,40 @@
         return;
     }
     _empty = NO;
+    if (!queue_) {
+        [self reallyAppendFrame:frameLines length:length cleanLines:cleanLines info:info];
+        return;
+    }
+    // Don't let a busy session queue up an unbounded amount of memory.
+    const int maxPendingFrames = 4;
+    if (pendingFrames_ >= maxPendingFrames) {
+        droppedFrame_ = YES;
+        return;
+    }
+    pendingFrames_++;
+    // The grid's lines are mutable and keep changing, so encode a copy of them.
+    NSMutableArray<NSData *> *snapshot = [NSMutableArray arrayWithCapacity:frameLines.count];
+    for (NSData *line in frameLines) {
+        [snapshot addObject:[[line copy] autorelease]];
+    }
+    NSIndexSet *clean = droppedFrame_ ? nil : [[cleanLines copy] autorelease];
+    droppedFrame_ = NO;
+    DVRFrameInfo infoCopy = *info;
+    [self retain];
+    dispatch_async(queue_, ^{
+        [self reallyAppendFrame:snapshot length:length cleanLines:clean info:&infoCopy];
+        dispatch_async(dispatch_get_main_queue(), ^{
+            pendingFrames_--;
+            [self release];
+        });
+    });
+}
+
+// Runs on queue_ if there is one.
+- (void)reallyAppendFrame:(NSArray<NSData *> *)frameLines
+                   length:(int)length
+               cleanLines:(NSIndexSet *)cleanLines
+                     info:(DVRFrameInfo *)info {
     int prevFirst = [buffer_ firstKey];
     if ([encoder_ reserve:length]) {
         // Leading frames were freed. Invalidate them in all decoders.
@@ -92,43 +153,91 @@
                      info:info];
 }
 
+// Runs block where frames aren't being encoded.
+- (void)synchronized:(void (^ NS_NOESCAPE)(void))block {
+    if (!queue_) {
+        block();
+        return;
+    }
+    dispatch_sync(queue_, block);
+}
+
 - (DVRDecoder*)getDecoder
 {
-    DVRDecoder* decoder = [[DVRDecoder alloc] initWithBuffer:buffer_];
-    [decoders_ addObject:decoder];
+    DVRDecoder* decoder = [[DVRDecoder alloc] initWithBuffer:buffer_ queue:queue_];
+    [self synchronized:^{
+        [decoders_ addObject:decoder];
+    }];
     [decoder release];
     return decoder;
 }
 
 - (void)releaseDecoder:(DVRDecoder*)decoder
 {
-    [decoders_ removeObject:decoder];
+    [self synchronized:^{
+        [decoders_ removeObject:decoder];
+    }];
 }
 
 - (long long)lastTimeStamp
 {
-    DVRIndexEntry* entry = [buffer_ entryForKey:[buffer_ lastKey]];
-    if (!entry) {
-        return 0;
-    }
-    return entry->info.timestamp;
+    __block long long result = 0;
+    [self synchronized:^{
+        DVRIndexEntry* entry = [buffer_ entryForKey:[buffer_ lastKey]];
+        if (entry) {
+            result = entry->info.timestamp;
+        }
+    }];
+    return result;
 }
 
 - (long long)firstTimeStamp
 {
-    DVRIndexEntry* entry = [buffer_ entryForKey:[buffer_ firstKey]];
-    if (!entry) {
+    __block long long result = 0;
+    [self synchronized:^{
+        DVRIndexEntry* entry = [buffer_ entryForKey:[buffer_ firstKey]];
+        if (entry) {
+            result = entry->info.timestamp;
+        }
+    }];
+    return result;
+}
+
+- (long long)memoryUsage {
+    __block long long result = 0;
+    [self synchronized:^{
+        result = [buffer_ capacity];
+    }];
+    return result;
+}
+
+- (long long)discardHistory {
+    if (readOnly_) {
         return 0;
     }
-    return entry->info.timestamp;
+    __block long long result = 0;
+    [self synchronized:^{
+        if (decoders_.count > 0) {
+            return;
+        }
+        result = [buffer_ deallocateAllBlocks];
+        [encoder_ reset];
+    }];
+    if (result > 0) {
+        _empty = YES;
+    }
+    return result;
 }
 
 - (long long)firstTimestampAfter:(long long)timestamp {
-    DVRIndexEntry *entry = [buffer_ firstEntryWithTimestampAfter:timestamp];
-    if (!entry) {
-        return 0;
-    }
-    return entry->info.timestamp;
+    __block long long result = 0;
+    [self synchronized:^{
+        DVRIndexEntry *entry = [buffer_ firstEntryWithTimestampAfter:timestamp];
+        if (entry) {
+            result = entry->info.timestamp;
+        }
+    }];
+    return result;
 }
 
 - (NSDictionary *)dictionaryValue {
@@ -142,16 +251,23 @@
     } else {
         dvr = [[self copyWithFramesFrom:from to:to] autorelease];
     }
-    return @{ @"version": @1,
-              @"capacity": @(dvr->capacity_),
-              @"buffer": dvr->buffer_.dictionaryValue };
+    __block NSDictionary *result = nil;
+    [dvr synchronized:^{
+        // Older versions can't decode compact frames, so they must not mistake them for version 1.
+        const BOOL compact = dvr->loadedCompactFrames_ || dvr->encoder_.hasCompactFrames;
+        result = [@{ @"version": compact ? @2 : @1,
+                     @"capacity": @(dvr->capacity_),
+                     @"buffer": dvr->buffer_.dictionaryValue } retain];
+    }];
+    return [result autorelease];
 }
 
 - (BOOL)loadDictionary:(NSDictionary *)dict {
     if (!dict) {
         return NO;
     }
-    if ([dict[@"version"] integerValue] != 1) {
+    const NSInteger version = [dict[@"version"] integerValue];
+    if (version != 1 && version != 2) {
         return NO;
     }
     int capacity = [dict[@"capacity"] intValue];
@@ -163,6 +279,8 @@
         return NO;
     }
 
+    // Let frames that were already queued finish with the buffer that's about to be replaced.
+    [self synchronized:^{}];
     [buffer_ release];
     buffer_ = [DVRBuffer alloc];
     [buffer_ initWithBufferCapacity:capacity];
@@ -178,12 +296,14 @@
     if (![buffer_ loadFromDictionary:bufferDict]) {
         return NO;
     }
+    loadedCompactFrames_ = (version == 2);
     readOnly_ = YES;
     return YES;
 }
 
 - (instancetype)copyWithFramesFrom:(long long)from to:(long long)to {
-    DVR *theCopy = [[DVR alloc] initWithBufferCapacity:capacity_];
+    // Encode synchronously since frames are appended faster than a queue would keep up with.
+    DVR *theCopy = [[DVR alloc] initWithBufferCapacity:capacity_ background:NO];
     DVRDecoder *decoder = [self getDecoder];
     if ([decoder seek:from]) {
         while (decoder.timestamp <= to || to == -1) {
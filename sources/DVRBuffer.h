@@ -34,16 +34,32 @@
 // that follows. The values come from this enum:
 enum {
     kSameSequence,
-    kDiffSequence
+    kDiffSequence,
+
+    // Only the changed columns of a line: the line's length, the byte offset of the first changed
+    // column, and the number of bytes that follow.
+    kColumnDiffSequence,
+
+    // Like kColumnDiffSequence but the changed columns are run-length encoded. The line's length
+    // and the index of the first changed cell are followed by the number of runs and then each run
+    // as a 16-bit count and the screen_char_t it repeats.
+    kRunLengthDiffSequence
 };
 
 // Types of frames that DVREncoder and DVRDecoder use.
 struct timeval;
 typedef enum {
     DVRFrameTypeKeyFrame,
-    DVRFrameTypeDiffFrame
+    DVRFrameTypeDiffFrame,
+
+    // A key frame compressed with deflate and prefixed by its uncompressed length.
+    DVRFrameTypeCompressedKeyFrame
 } DVRFrameType;
 
+NS_INLINE BOOL DVRFrameTypeIsKeyFrame(int frameType) {
+    return frameType == DVRFrameTypeKeyFrame || frameType == DVRFrameTypeCompressedKeyFrame;
+}
+
 @interface DVRBuffer : NSObject
 
 // Returns first/last used keys.
@@ -73,6 +89,10 @@ typedef enum {
 // Free the first block.
 - (void)deallocateBlock;
 
+// Free all blocks and tell the kernel it can reclaim the pages of the store. Returns the number of
+// bytes the blocks used.
+- (long long)deallocateAllBlocks;
+
 // Return a pointer to the memory for some key or null if it doesn't exist.
 - (void*)blockForKey:(long long)key;
 
@@ -84,5 +104,9 @@ typedef enum {
 - (BOOL)loadFromDictionary:(NSDictionary *)dict;
 - (DVRIndexEntry *)firstEntryWithTimestampAfter:(long long)timestamp;
 
+// Binary searches for the first frame whose timestamp is at least `timestamp`. Returns -1 if there
+// is none.
+- (long long)firstKeyWithTimestampAtLeast:(long long)timestamp;
+
 @end
 
@@ -28,10 +28,14 @@
 
 #import "DVRBuffer.h"
 
+#import "iTermAdvancedSettingsModel.h"
 #import "iTermMalloc.h"
 #import "NSArray+iTerm.h"
 #import "NSDictionary+iTerm.h"
 
+#include <sys/mman.h>
+#include <unistd.h>
+
 @implementation DVRBuffer {
     // Points to start of large circular buffer.
     char* store_;
@@ -183,6 +187,24 @@
     [index_ removeObjectForKey:[NSNumber numberWithLongLong:key]];
 }
 
+- (long long)deallocateAllBlocks {
+    long long bytes = 0;
+    while (firstKey_ < nextKey_) {
+        bytes += [self entryForKey:firstKey_]->frameLength;
+        [self deallocateBlock];
+    }
+    begin_ = 0;
+    end_ = 0;
+    // The store is too big to come from a malloc zone that isn't page-aligned, but be safe.
+    const uintptr_t pageSize = getpagesize();
+    const uintptr_t start = ((uintptr_t)store_ + pageSize - 1) & ~(pageSize - 1);
+    const uintptr_t end = ((uintptr_t)store_ + capacity_) & ~(pageSize - 1);
+    if (end > start) {
+        madvise((void *)start, end - start, MADV_FREE);
+    }
+    return bytes;
+}
+
 - (void*)blockForKey:(long long)key
 {
     DVRIndexEntry* entry = [self entryForKey:key];
@@ -227,7 +249,30 @@
     return [index_ objectForKey:[NSNumber numberWithLongLong:key]];
 }
 
+- (long long)firstKeyWithTimestampAtLeast:(long long)timestamp {
+    // Keys are consecutive and appended in time order.
+    long long low = firstKey_;
+    long long high = nextKey_;
+    while (low < high) {
+        const long long mid = low + (high - low) / 2;
+        DVRIndexEntry *entry = [self entryForKey:mid];
+        if (!entry) {
+            return -1;
+        }
+        if (entry->info.timestamp < timestamp) {
+            low = mid + 1;
+        } else {
+            high = mid;
+        }
+    }
+    return low < nextKey_ ? low : -1;
+}
+
 - (DVRIndexEntry *)firstEntryWithTimestampAfter:(long long)timestamp {
+    if ([iTermAdvancedSettingsModel fastInstantReplaySeeking]) {
+        const long long key = [self firstKeyWithTimestampAtLeast:timestamp + 1];
+        return key < 0 ? nil : [self entryForKey:key];
+    }
     NSArray<NSNumber *> *frameNumbers = [[index_ allKeys] sortedArrayUsingSelector:@selector(compare:)];
     NSArray<NSNumber *> *timestamps = [frameNumbers mapWithBlock:^NSNumber *(NSNumber *frameNumber) {
         DVRIndexEntry *entry = index_[frameNumber];
@@ -36,6 +36,10 @@
 
 - (instancetype)initWithBuffer:(DVRBuffer*)buffer;
 
+// If queue is not NULL, the buffer is only read on it. DVR uses this when it encodes in the
+// background.
+- (instancetype)initWithBuffer:(DVRBuffer*)buffer queue:(dispatch_queue_t)queue;
+
 // Jump to a given timestamp, or the next available frame. Returns true on success.
 // Returns false if timestamp is later than the last timestamp or there are no frames.
 - (BOOL)seek:(long long)timestamp;
@@ -51,7 +55,7 @@
 // Advance to previous frame.
 - (BOOL)prev;
 
-// Called when frame index key i is freed.
+// Called when frame index key i is freed. Must be called on the buffer's queue, if it has one.
 - (void)invalidateIndex:(long long)i;
 
 @end
@@ -30,9 +30,12 @@
 
 #import "DebugLogging.h"
 #import "DVRIndexEntry.h"
+#import "iTermAdvancedSettingsModel.h"
 #import "iTermMalloc.h"
 #import "LineBuffer.h"
 
+#include <zlib.h>
+
 //#if DEBUG
 //#define DVRDEBUG 1
 //#endif
@@ -52,15 +55,26 @@
 
     // Most recent frame's key (not timestamp).
     long long key_;
+
+    // Queue the buffer is modified on, or NULL if it's only used on the main thread.
+    dispatch_queue_t queue_;
 }
 
 - (instancetype)initWithBuffer:(DVRBuffer *)buffer {
+    return [self initWithBuffer:buffer queue:NULL];
+}
+
+- (instancetype)initWithBuffer:(DVRBuffer *)buffer queue:(dispatch_queue_t)queue {
     self = [super init];
     if (self) {
         buffer_ = buffer;
         frame_ = 0;
         length_ = 0;
         key_ = -1;
+        if (queue) {
+            queue_ = queue;
+            dispatch_retain(queue_);
+        }
     }
     return self;
 }
@@ -70,11 +84,52 @@
     if (frame_) {
         free(frame_);
     }
+    if (queue_) {
+        dispatch_release(queue_);
+    }
     [super dealloc];
 }
 
-- (BOOL)seek:(long long)timestamp
+// Runs block where the buffer can't change while it's being read.
+- (BOOL)synchronized:(BOOL (^ NS_NOESCAPE)(void))block {
+    if (!queue_) {
+        return block();
+    }
+    __block BOOL result = NO;
+    dispatch_sync(queue_, ^{
+        result = block();
+    });
+    return result;
+}
+
+- (BOOL)seek:(long long)timestamp {
+    return [self synchronized:^BOOL{
+        return [self _seek:timestamp];
+    }];
+}
+
+- (BOOL)next {
+    return [self synchronized:^BOOL{
+        return [self _next];
+    }];
+}
+
+- (BOOL)prev {
+    return [self synchronized:^BOOL{
+        return [self _prev];
+    }];
+}
+
+- (BOOL)_seek:(long long)timestamp
 {
+    if ([iTermAdvancedSettingsModel fastInstantReplaySeeking]) {
+        const long long key = [buffer_ firstKeyWithTimestampAtLeast:timestamp];
+        if (key < 0) {
+            return NO;
+        }
+        [self _seekToEntryWithKey:key];
+        return YES;
+    }
     // TODO(georgen): Do a binary search
     long long lastKey = [buffer_ lastKey];
     for (long long key = [buffer_ firstKey]; key <= lastKey; ++key) {
@@ -97,7 +152,7 @@
     return length_;
 }
 
-- (BOOL)next
+- (BOOL)_next
 {
     long long newKey;
     if (key_ == -1) {
@@ -114,7 +169,7 @@
     return YES;
 }
 
-- (BOOL)prev
+- (BOOL)_prev
 {
     if (key_ <= [buffer_ firstKey]) {
         return NO;
@@ -189,9 +244,12 @@
 #endif
         key = [buffer_ firstKey];
     }
+    if ([iTermAdvancedSettingsModel fastInstantReplaySeeking] && [self _advanceToKey:key]) {
+        return;
+    }
     // Find the key frame before 'key'.
     long long j = key;
-    while ([buffer_ entryForKey:j]->info.frameType != DVRFrameTypeKeyFrame) {
+    while (!DVRFrameTypeIsKeyFrame([buffer_ entryForKey:j]->info.frameType)) {
         assert(j != [buffer_ firstKey]);
         --j;
     }
@@ -206,6 +264,7 @@
     while (j != key) {
         ++j;
         if (![self _loadDiffFrameWithKey:j]) {
+            key_ = -1;
             return;
         }
 #ifdef DVRDEBUG
@@ -218,24 +277,68 @@
 #endif
 }
 
+// When scrubbing forward within the stretch of diff frames after a key frame, the frame that's
+// already decoded is a better place to start than the key frame. Returns NO if it isn't usable.
+- (BOOL)_advanceToKey:(long long)key {
+    if (key_ < 0 || key < key_ || key_ < [buffer_ firstKey] || !frame_) {
+        return NO;
+    }
+    for (long long j = key_ + 1; j <= key; j++) {
+        if (DVRFrameTypeIsKeyFrame([buffer_ entryForKey:j]->info.frameType)) {
+            // Loading the later key frame is cheaper.
+            return NO;
+        }
+    }
+    for (long long j = key_ + 1; j <= key; j++) {
+        if (![self _loadDiffFrameWithKey:j]) {
+            // The decoded frame is in an unknown state now.
+            key_ = -1;
+            return YES;
+        }
+        key_ = j;
+    }
+    return YES;
+}
+
 - (void)_loadKeyFrameWithKey:(long long)key
 {
     DVRIndexEntry* entry = [buffer_ entryForKey:key];
-    if (length_ != entry->frameLength && frame_) {
+    char* data = [buffer_ blockForKey:key];
+    const BOOL compressed = (entry->info.frameType == DVRFrameTypeCompressedKeyFrame);
+    int length = entry->frameLength;
+    if (compressed) {
+        if (entry->frameLength < (int)sizeof(length)) {
+            length = 0;
+        } else {
+            memcpy(&length, data, sizeof(length));
+        }
+    }
+    if (length_ != length && frame_) {
         free(frame_);
         frame_ = 0;
     }
-    length_ = entry->frameLength;
+    length_ = length;
 #ifdef DVRDEBUG
     NSLog(@"Frame length is %d", length_);
 #endif
     if (!frame_) {
         frame_ = iTermMalloc(length_);
     }
-    char* data = [buffer_ blockForKey:key];
     info_ = entry->info;
     DLog(@"Frame with key %lld has size %dx%d", key, info_.width, info_.height);
-    memcpy(frame_,  data, length_);
+    if (!compressed) {
+        memcpy(frame_,  data, length_);
+        return;
+    }
+    uLongf size = length_;
+    const int status = length_ > 0 ? uncompress((Bytef *)frame_,
+                                                &size,
+                                                (const Bytef *)data + sizeof(length),
+                                                entry->frameLength - sizeof(length)) : Z_DATA_ERROR;
+    if (status != Z_OK || size != (uLongf)length_) {
+        DLog(@"Failed to uncompress key frame %lld: status=%d size=%@", key, status, @(size));
+        memset(frame_, 0, length_);
+    }
 }
 
 // Add two positive ints. Returns NO if it can't be done. Returns YES and places the result in
@@ -309,6 +412,71 @@ static BOOL NS_WARN_UNUSED_RESULT SafeIncr(int summand, int addend, int *sum) {
                 }
                 break;
 
+            case kColumnDiffSequence: {
+                // Line length, then offset and length of the changed bytes within it.
+                int header[3];
+                if (i + (int)sizeof(header) > entry->frameLength) {
+                    return NO;
+                }
+                memcpy(header, diff + i, sizeof(header));
+                i += sizeof(header);
+                const int lineLength = header[0];
+                const int start = header[1];
+                const int count = header[2];
+                int end;
+                int frameEnd;
+                if (!SafeIncr(start, count, &end) || end > lineLength ||
+                    !SafeIncr(o, end, &frameEnd) || frameEnd > length_ ||
+                    i + count > entry->frameLength) {
+                    return NO;
+                }
+                memcpy(frame_ + o + start, diff + i, count);
+                if (!SafeIncr(count, i, &i) || !SafeIncr(lineLength, o, &o)) {
+                    return NO;
+                }
+                break;
+            }
+
+            case kRunLengthDiffSequence: {
+                // Line length, index of the first changed cell, and number of runs.
+                int header[3];
+                if (i + (int)sizeof(header) > entry->frameLength) {
+                    return NO;
+                }
+                memcpy(header, diff + i, sizeof(header));
+                i += sizeof(header);
+                const int lineLength = header[0];
+                const int runs = header[2];
+                if (header[1] < 0 || header[1] > lineLength / (int)sizeof(screen_char_t) ||
+                    runs < 0 || lineLength < 0 || o > length_ - lineLength) {
+                    return NO;
+                }
+                const int cells = lineLength / sizeof(screen_char_t);
+                screen_char_t *line = (screen_char_t *)(frame_ + o);
+                int x = header[1];
+                const int runSize = sizeof(uint16_t) + sizeof(screen_char_t);
+                for (int r = 0; r < runs; r++) {
+                    if (i + runSize > entry->frameLength) {
+                        return NO;
+                    }
+                    uint16_t count;
+                    screen_char_t c;
+                    memcpy(&count, diff + i, sizeof(count));
+                    memcpy(&c, diff + i + sizeof(count), sizeof(c));
+                    i += runSize;
+                    if (count > cells - x) {
+                        return NO;
+                    }
+                    for (int k = 0; k < count; k++) {
+                        memcpy(&line[x++], &c, sizeof(c));
+                    }
+                }
+                if (!SafeIncr(lineLength, o, &o)) {
+                    return NO;
+                }
+                break;
+            }
+
             default:
                 NSLog(@"Unexpected block type %d", (int)diff[i-1]);
                 assert(0);
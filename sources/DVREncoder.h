@@ -31,6 +31,9 @@
 
 @interface DVREncoder : NSObject
 
+// Whether any frame uses an encoding that versions without compactInstantReplayFrames can't read.
+@property(nonatomic, readonly) BOOL hasCompactFrames;
+
 - (instancetype)initWithBuffer:(DVRBuffer*)buffer;
 
 // Encoded a frame into the DVRBuffer. Call -[reserve:] first.
@@ -48,4 +51,7 @@
 // invalidate nonexistent leading frames in all decoders.
 - (BOOL)reserve:(int)length;
 
+// Forget the last frame so the next one is a key frame. Call after emptying the buffer.
+- (void)reset;
+
 @end
@@ -28,8 +28,10 @@
 #import "DVREncoder.h"
 #import "DebugLogging.h"
 #import "DVRIndexEntry.h"
+#import "iTermAdvancedSettingsModel.h"
 #include "LineBuffer.h"
 #include <sys/time.h>
+#include <zlib.h>
 
 //#if DEBUG
 //#define DVRDEBUG
@@ -67,6 +69,10 @@ static long long now()
 
     // Number of bytes reserved.
     int reservation_;
+
+    // Encode only changed columns, run-length encode them when that's smaller, and compress key
+    // frames. Fixed for the life of the encoder so a buffer's frames are consistent.
+    BOOL compact_;
 }
 
 - (instancetype)initWithBuffer:(DVRBuffer *)buffer {
@@ -76,6 +82,7 @@ static long long now()
         lastFrame_ = nil;
         count_ = 0;
         haveReservation_ = NO;
+        compact_ = [iTermAdvancedSettingsModel compactInstantReplayFrames];
     }
     return self;
 }
@@ -105,7 +112,9 @@ static long long now()
          cleanLines:(NSIndexSet *)cleanLines
                info:(DVRFrameInfo*)info {
     BOOL eligibleForDiff;
-    if (cleanLines.count > info->height * 0.8 &&
+    // A compact diff of a mostly-changed frame is usually still smaller than a key frame, and if
+    // it isn't, _appendDiffFrame falls back to one.
+    if ((compact_ || cleanLines.count > info->height * 0.8) &&
         lastFrame_ &&
         length == [lastFrame_ length] &&
         info->width == lastInfo_.width &&
@@ -118,6 +127,15 @@ static long long now()
 
     const int kKeyFrameFrequency = 100;
 
+    // Seeking decodes the preceding key frame and then every diff after it. Once those diffs add
+    // up to a few key frames' worth of bytes, a new key frame makes seeking cheaper.
+    const long long kMaxDiffBytesPerKeyFrame = 4LL * length;
+    if (eligibleForDiff &&
+        [iTermAdvancedSettingsModel fastInstantReplaySeeking] &&
+        bytesSinceLastKeyFrame_ >= kMaxDiffBytesPerKeyFrame) {
+        eligibleForDiff = NO;
+    }
+
     if (!eligibleForDiff || count_++ % kKeyFrameFrequency == 0) {
         [self _appendKeyFrame:frameLines length:length info:info];
     } else {
@@ -136,7 +154,7 @@ static long long now()
     while (![buffer_ isEmpty] && hadToFree) {
         DVRIndexEntry* entry = [buffer_ entryForKey:[buffer_ firstKey]];
         assert(entry);
-        if (entry->info.frameType == DVRFrameTypeKeyFrame) {
+        if (DVRFrameTypeIsKeyFrame(entry->info.frameType)) {
             break;
         } else {
             [buffer_ deallocateBlock];
@@ -145,6 +163,13 @@ static long long now()
     return hadToFree;
 }
 
+- (void)reset {
+    [lastFrame_ release];
+    lastFrame_ = nil;
+    count_ = 0;
+    bytesSinceLastKeyFrame_ = 0;
+}
+
 #pragma mark - Private
 
 - (void)debug:(NSString*)prefix buffer:(const char *)buffer length:(int)length
@@ -180,11 +205,38 @@ static long long now()
     lastFrame_ = [[self combinedFrameLines:frameLines] retain];
     assert(lastFrame_.length == length);
     char* scratch = [buffer_ scratch];
-    memcpy(scratch, [lastFrame_ mutableBytes], length);
-    [self _appendFrameImpl:scratch length:length type:DVRFrameTypeKeyFrame info:info];
+    const int compressedLength = compact_ ? [self _compressFrame:lastFrame_ dest:scratch maxSize:length] : -1;
+    if (compressedLength >= 0) {
+        [self _appendFrameImpl:scratch length:compressedLength type:DVRFrameTypeCompressedKeyFrame info:info];
+    } else {
+        memcpy(scratch, [lastFrame_ mutableBytes], length);
+        [self _appendFrameImpl:scratch length:length type:DVRFrameTypeKeyFrame info:info];
+    }
     bytesSinceLastKeyFrame_ = 0;
 }
 
+// Saves frame into scratch as its length followed by its deflated bytes. Returns the number of
+// bytes used or -1 if that would be more than maxSize.
+- (int)_compressFrame:(NSData *)frame dest:(char *)scratch maxSize:(int)maxBytes {
+    const int uncompressedLength = frame.length;
+    if (maxBytes <= (int)sizeof(uncompressedLength)) {
+        return -1;
+    }
+    uLongf compressedLength = maxBytes - sizeof(uncompressedLength);
+    const int status = compress2((Bytef *)scratch + sizeof(uncompressedLength),
+                                 &compressedLength,
+                                 frame.bytes,
+                                 frame.length,
+                                 Z_BEST_SPEED);
+    if (status != Z_OK) {
+        // Most likely it didn't fit.
+        return -1;
+    }
+    memcpy(scratch, &uncompressedLength, sizeof(uncompressedLength));
+    _hasCompactFrames = YES;
+    return sizeof(uncompressedLength) + compressedLength;
+}
+
 // Save a diff frame into DVRBuffer.
 - (void)_appendDiffFrame:(NSArray *)frameLines
                   length:(int)length
@@ -273,6 +325,18 @@ static long long now()
             memcpy(scratch + o, &numChars, sizeof(numChars));
             o += sizeof(numChars);
         } else {
+            if (compact_) {
+                o = [self _appendChangedColumnsOfLine:frameLines[y]
+                                               number:y
+                                          lineLength:numChars
+                                                dest:scratch
+                                              offset:o
+                                             maxSize:maxBytes];
+                if (o < 0) {
+                    return -1;
+                }
+                continue;
+            }
             if (o + 1 + sizeof(numChars) + numChars > maxBytes) {
                 // Diff is too big.
                 return -1;
@@ -298,4 +362,97 @@ static long long now()
     return o;
 }
 
+// Appends the columns of line y that differ from the last frame in whichever of the column and
+// run-length encodings is smaller, then updates the last frame to match. Returns the new offset
+// into scratch or -1 if the diff is too big.
+- (int)_appendChangedColumnsOfLine:(NSData *)lineData
+                            number:(int)y
+                        lineLength:(int)numChars
+                              dest:(char *)scratch
+                            offset:(int)o
+                           maxSize:(int)maxBytes {
+    if ((y + 1) * numChars > (int)lastFrame_.length || (int)lineData.length < numChars) {
+        return -1;
+    }
+    screen_char_t *previous = (screen_char_t *)((char *)lastFrame_.mutableBytes + y * numChars);
+    const screen_char_t *current = (const screen_char_t *)lineData.bytes;
+    const int cells = numChars / sizeof(screen_char_t);
+
+    int first = 0;
+    while (first < cells && !memcmp(&previous[first], &current[first], sizeof(screen_char_t))) {
+        first++;
+    }
+    if (first == cells) {
+        // Reported as dirty but nothing changed.
+        if (o + 1 + sizeof(numChars) > maxBytes) {
+            return -1;
+        }
+        scratch[o++] = kSameSequence;
+        memcpy(scratch + o, &numChars, sizeof(numChars));
+        return o + sizeof(numChars);
+    }
+    int last = cells - 1;
+    while (last > first && !memcmp(&previous[last], &current[last], sizeof(screen_char_t))) {
+        last--;
+    }
+    const int count = last - first + 1;
+
+    int runs = 0;
+    int runLength = 0;
+    for (int x = first; x <= last; x++) {
+        if (x == first ||
+            runLength == UINT16_MAX ||
+            memcmp(&current[x], &current[x - 1], sizeof(screen_char_t))) {
+            runs++;
+            runLength = 0;
+        }
+        runLength++;
+    }
+
+    const int headerSize = 1 + 3 * sizeof(int);
+    const int columnBytes = count * sizeof(screen_char_t);
+    const int runBytes = runs * (sizeof(uint16_t) + sizeof(screen_char_t));
+    const BOOL useRuns = runBytes < columnBytes;
+    if (o + headerSize + (useRuns ? runBytes : columnBytes) > maxBytes) {
+        return -1;
+    }
+    if (useRuns) {
+        scratch[o++] = kRunLengthDiffSequence;
+        memcpy(scratch + o, &numChars, sizeof(numChars));
+        o += sizeof(numChars);
+        memcpy(scratch + o, &first, sizeof(first));
+        o += sizeof(first);
+        memcpy(scratch + o, &runs, sizeof(runs));
+        o += sizeof(runs);
+        int x = first;
+        while (x <= last) {
+            uint16_t n = 1;
+            while (x + n <= last &&
+                   n < UINT16_MAX &&
+                   !memcmp(&current[x + n], &current[x], sizeof(screen_char_t))) {
+                n++;
+            }
+            memcpy(scratch + o, &n, sizeof(n));
+            o += sizeof(n);
+            memcpy(scratch + o, &current[x], sizeof(screen_char_t));
+            o += sizeof(screen_char_t);
+            x += n;
+        }
+    } else {
+        scratch[o++] = kColumnDiffSequence;
+        const int start = first * sizeof(screen_char_t);
+        memcpy(scratch + o, &numChars, sizeof(numChars));
+        o += sizeof(numChars);
+        memcpy(scratch + o, &start, sizeof(start));
+        o += sizeof(start);
+        memcpy(scratch + o, &columnBytes, sizeof(columnBytes));
+        o += sizeof(columnBytes);
+        memcpy(scratch + o, current + first, columnBytes);
+        o += columnBytes;
+    }
+    memcpy(previous + first, current + first, columnBytes);
+    _hasCompactFrames = YES;
+    return o;
+}
+
 @end
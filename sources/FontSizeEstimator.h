@@ -43,4 +43,8 @@
 
 + (instancetype)fontSizeEstimatorForFont:(NSFont *)aFont;
 
+// Same as fontSizeEstimatorForFont: but remembers the result for each font for as long as the
+// installed fonts and advanced settings don't change.
++ (NSSize)cachedSizeForFont:(NSFont *)aFont;
+
 @end
@@ -72,6 +72,41 @@
     return NO;
 }
 
++ (NSMutableDictionary<NSFont *, NSValue *> *)sizeCache {
+    static NSMutableDictionary<NSFont *, NSValue *> *cache;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        cache = [[NSMutableDictionary alloc] init];
+        // Measurements depend on which fonts are installed and on advanced settings.
+        for (NSString *name in @[ NSFontSetChangedNotification, iTermAdvancedSettingsDidChange ]) {
+            [[NSNotificationCenter defaultCenter] addObserverForName:name
+                                                              object:nil
+                                                               queue:nil
+                                                          usingBlock:^(NSNotification * _Nonnull note) {
+                @synchronized (cache) {
+                    [cache removeAllObjects];
+                }
+            }];
+        }
+    });
+    return cache;
+}
+
++ (NSSize)cachedSizeForFont:(NSFont *)aFont {
+    NSMutableDictionary<NSFont *, NSValue *> *cache = [self sizeCache];
+    @synchronized (cache) {
+        NSValue *value = cache[aFont];
+        if (value) {
+            return value.sizeValue;
+        }
+    }
+    const NSSize size = [[self fontSizeEstimatorForFont:aFont] size];
+    @synchronized (cache) {
+        cache[aFont] = [NSValue valueWithSize:size];
+    }
+    return size;
+}
+
 + (id)fontSizeEstimatorForFont:(NSFont *)aFont
 {
     assert(aFont != nil);
@@ -269,7 +269,7 @@ enum {
     };
     [iTermPreferenceDidChangeNotification subscribe:self
                                               block:^(iTermPreferenceDidChangeNotification * _Nonnull notification) {
-                                                  if ([notification.key isEqualToString:kPreferenceKeyEnableAPIServer]) {
+                                                  if ([notification didChangeKey:kPreferenceKeyEnableAPIServer]) {
                                                       __typeof(self) strongSelf = weakSelf;
                                                       if (strongSelf) {
                                                           strongSelf->_enableAPI.state = NSControlStateValueOn;
@@ -61,7 +61,17 @@
 // |object| should implement -hash.
 - (void)addObject:(id<IntervalTreeObject>)object withInterval:(Interval *)interval;
 - (void)removeObject:(id<IntervalTreeObject>)object;
+
+// Removes every object whose interval ends at or before |limit|. Only nodes that begin at or
+// before |limit| are visited and each node is updated once. |block| is called for each object just
+// before it's removed, while its entry is still valid. Don't modify the tree from the block.
+- (void)removeObjectsWithLimitAtMost:(long long)limit
+                               block:(void (^ NS_NOESCAPE)(id<IntervalTreeObject> object))block;
 - (NSArray<IntervalTreeObject> *)objectsInInterval:(Interval *)interval;
+
+// Like objectsInInterval: but doesn't build an array. Don't modify the tree from the block.
+- (void)enumerateObjectsInInterval:(Interval *)interval
+                             block:(void (^ NS_NOESCAPE)(id<IntervalTreeObject> object, BOOL *stop))block;
 - (NSArray<IntervalTreeObject> *)allObjects;
 - (BOOL)containsObject:(id<IntervalTreeObject>)object;
 
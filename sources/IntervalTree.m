@@ -1,5 +1,7 @@
 #import "IntervalTree.h"
 #import "DebugLogging.h"
+#import "iTermAdvancedSettingsModel.h"
+#import "iTermIntervalTreeIndex.h"
 
 static const long long kMinLocation = LLONG_MIN / 2;
 static const long long kMaxLimit = kMinLocation + LLONG_MAX;
@@ -311,6 +313,8 @@ static NSString *const kIntervalLengthKey = @"Length";
 @implementation IntervalTree {
     AATree *_tree;
     int _count;
+    // Answers objectsInInterval: without walking the AATree, if enabled.
+    iTermIntervalTreeIndex *_index;
 }
 
 - (instancetype)initWithDictionary:(NSDictionary *)dict {
@@ -345,6 +349,9 @@ static NSString *const kIntervalLengthKey = @"Length";
         }];
         assert(_tree);
         _tree.delegate = self;
+        if ([iTermAdvancedSettingsModel flatIntervalTreeQueries]) {
+            _index = [[iTermIntervalTreeIndex alloc] init];
+        }
     }
     return self;
 }
@@ -355,6 +362,7 @@ static NSString *const kIntervalLengthKey = @"Length";
     }
     _tree.delegate = nil;
     [_tree release];
+    [_index release];
     [super dealloc];
 }
 
@@ -374,6 +382,7 @@ static NSString *const kIntervalLengthKey = @"Length";
         [_tree notifyValueChangedForKey:@(interval.location)];
     }
     object.entry = entry;
+    [_index addObject:object location:interval.location limit:interval.limit];
     ++_count;
 }
 
@@ -394,6 +403,7 @@ static NSString *const kIntervalLengthKey = @"Length";
     if (entry) {
         assert(object.entry == entry);  // Was object added to another tree before being removed from this one?
         object.entry = nil;
+        [_index removeObject:object location:theLocation];
         [entries removeObjectAtIndex:i];
         if (entries.count == 0) {
             [_tree removeObjectForKey:@(theLocation)];
@@ -404,8 +414,55 @@ static NSString *const kIntervalLengthKey = @"Length";
     }
 }
 
+- (void)removeObjectsWithLimitAtMost:(long long)limit
+                               block:(void (^ NS_NOESCAPE)(id<IntervalTreeObject> object))block {
+    NSMutableArray<IntervalTreeValue *> *values = [NSMutableArray array];
+    [self addValuesWithLocationAtMost:limit toArray:values fromNode:_tree.root];
+    for (IntervalTreeValue *value in values) {
+        // The key may not survive removal of the last entry, so grab it first.
+        NSNumber *key = @(value.location);
+        NSMutableIndexSet *indexes = [NSMutableIndexSet indexSet];
+        [value.entries enumerateObjectsUsingBlock:^(IntervalTreeEntry *entry, NSUInteger idx, BOOL *stop) {
+            if (entry.interval.limit <= limit) {
+                [indexes addIndex:idx];
+            }
+        }];
+        if (indexes.count == 0) {
+            continue;
+        }
+        for (IntervalTreeEntry *entry in [value.entries objectsAtIndexes:indexes]) {
+            block(entry.object);
+            entry.object.entry = nil;
+        }
+        _count -= (int)indexes.count;
+        if (indexes.count == value.entries.count) {
+            [_tree removeObjectForKey:key];
+        } else {
+            [value.entries removeObjectsAtIndexes:indexes];
+            [_tree notifyValueChangedForKey:key];
+        }
+    }
+    [_index removeObjectsWithLimitAtMost:limit];
+}
+
 #pragma mark - Private
 
+// In-order, so that locations are ascending.
+- (void)addValuesWithLocationAtMost:(long long)location
+                            toArray:(NSMutableArray<IntervalTreeValue *> *)result
+                           fromNode:(AATreeNode *)node {
+    if (!node) {
+        return;
+    }
+    IntervalTreeValue *value = (IntervalTreeValue *)node.data;
+    [self addValuesWithLocationAtMost:location toArray:result fromNode:node.left];
+    if (value.location > location) {
+        return;
+    }
+    [result addObject:value];
+    [self addValuesWithLocationAtMost:location toArray:result fromNode:node.right];
+}
+
 - (void)recalculateMaxLimitInSubtreeAtNode:(AATreeNode *)node
                      removeFromToVisitList:(NSMutableSet *)toVisit {
     IntervalTreeValue *value = (IntervalTreeValue *)node.data;
@@ -489,10 +546,37 @@ static NSString *const kIntervalLengthKey = @"Length";
 
 - (NSArray *)objectsInInterval:(Interval *)interval {
     NSMutableArray *array = [NSMutableArray array];
+    if (_index) {
+        [_index enumerateObjectsIntersectingLocation:interval.location
+                                               limit:interval.limit
+                                               block:^(id object, BOOL *stop) {
+            [array addObject:object];
+        }];
+        return array;
+    }
     [self addObjectsInInterval:interval toArray:array fromNode:_tree.root];
     return array;
 }
 
+- (void)enumerateObjectsInInterval:(Interval *)interval
+                             block:(void (^ NS_NOESCAPE)(id<IntervalTreeObject> object, BOOL *stop))block {
+    if (_index) {
+        [_index enumerateObjectsIntersectingLocation:interval.location
+                                               limit:interval.limit
+                                               block:^(id object, BOOL *stop) {
+            block(object, stop);
+        }];
+        return;
+    }
+    BOOL stop = NO;
+    for (id<IntervalTreeObject> object in [self objectsInInterval:interval]) {
+        block(object, &stop);
+        if (stop) {
+            break;
+        }
+    }
+}
+
 - (NSArray *)allObjects {
     return [self objectsInInterval:[Interval maxInterval]];
 }
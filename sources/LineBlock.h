@@ -26,9 +26,14 @@ typedef struct {
 } LineBlockMetadata;
 
 @class LineBlock;
+@class iTermScrollbackSpillFile;
 
 @protocol iTermLineBlockObserver<NSObject>
 - (void)lineBlockDidChange:(LineBlock *)lineBlock;
+
+@optional
+// A block that was compressed with -compress got inflated because someone needed its contents.
+- (void)lineBlockDidInflate:(LineBlock *)lineBlock;
 @end
 
 // LineBlock represents an ordered collection of lines of text. It stores them contiguously
@@ -45,6 +50,10 @@ typedef struct {
 
 + (instancetype)blockWithDictionary:(NSDictionary *)dictionary;
 
+// If lazily is set, the contents stay in the dictionary's data until something needs them, like
+// a compact block. Metadata is decoded right away.
++ (instancetype)blockWithDictionary:(NSDictionary *)dictionary lazily:(BOOL)lazily;
+
 - (instancetype)initWithRawBufferSize:(int)size;
 
 // Try to append a line to the end of the buffer. Returns false if it does not fit. If length > buffer_size it will never succeed.
@@ -82,6 +91,13 @@ typedef struct {
 // Returns whether getNumLinesWithWrapWidth will be fast.
 - (BOOL)hasCachedNumLinesForWidth:(int)width;
 
+// Returns a block that counts this block's wrapped lines at |width| and may be run on any thread,
+// or nil if getNumLinesWithWrapWidth: is already fast. The block returns -1 on failure. Give its
+// result to -setNumberOfWrappedLines:forWidth:generation: along with the generation from when
+// this was called; it's ignored if the block changed in the meantime.
+- (int (^)(void))threadSafeWrappedLineCounterForWidth:(int)width;
+- (void)setNumberOfWrappedLines:(int)count forWidth:(int)width generation:(NSInteger)generation;
+
 // Returns true if the last line is incomplete.
 - (BOOL)hasPartial;
 
@@ -120,6 +136,31 @@ typedef struct {
 // Remove extra space from the end of the buffer. Future appends will fail.
 - (void)shrinkToFit;
 
+// Store the contents in a compact form and free the raw buffer. Any method that needs the
+// contents transparently inflates it again. Pointers previously returned by this block are
+// invalidated, so only do this to a block nobody is holding on to.
+- (void)compact;
+
+// Like -compact, but the compact form is also compressed on a background queue. Observers get
+// -lineBlockDidInflate: when a compressed block is inflated so they can compress it again once
+// it's no longer in use. Must be called on the main thread.
+- (void)compress;
+
+// Like -compact, but the compact form is moved out of the heap into |file|. The block should not
+// be modified afterwards; if it is, it stays in memory from then on. Must be called on the main
+// thread.
+- (void)spillToFile:(iTermScrollbackSpillFile *)file;
+
+// Expand a compact block so it can be read without modifying it (e.g., from several threads at
+// once). Must be called on the main thread.
+- (void)inflateIfNeeded;
+
+// Is the block currently stored compactly?
+- (BOOL)isCompact;
+
+// Approximate number of bytes of heap used by this block's buffers.
+- (NSInteger)memoryUsage;
+
 // Return a raw line
 - (screen_char_t *)rawLine:(int)linenum;
 
@@ -216,9 +257,14 @@ int OffsetOfWrappedLine(screen_char_t* p, int n, int length, int width, BOOL may
 // Call this only before a line block has been created.
 void EnableDoubleWidthCharacterLineCache(void);
 
+// For tests. Affects only blocks created afterwards.
+void LineBlockSetIndexesTrigrams(BOOL indexes);
+
 - (void)addObserver:(id<iTermLineBlockObserver>)observer;
 - (void)removeObserver:(id<iTermLineBlockObserver>)observer;
 - (BOOL)hasObserver:(id<iTermLineBlockObserver>)observer;
+// Each line block array holding a block observes it, so this tells whether another one shares it.
+- (BOOL)hasObserverOtherThan:(id<iTermLineBlockObserver>)observer;
 
 - (void)setPartial:(BOOL)partial;
 
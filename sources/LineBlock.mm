@@ -16,12 +16,22 @@ extern "C" {
 #import "NSBundle+iTerm.h"
 #import "RegexKitLite.h"
 #import "iTermAdvancedSettingsModel.h"
+#import "iTermCompactLineStorage.h"
+#import "iTermRegexLiteral.h"
+#import "iTermScrollbackSpillFile.h"
 }
+#include <algorithm>
+#include <atomic>
 #include <unordered_map>
 #include <vector>
 
 static BOOL gEnableDoubleWidthCharacterLineCache = NO;
 static BOOL gUseCachingNumberOfLines = NO;
+static BOOL gIndexTrigrams = NO;
+static BOOL gDeduplicateCompactBlocks = NO;
+
+// Number of bits in each block's trigram filter. Must be a power of two.
+static const int iTermLineBlockTrigramBits = 16384;
 
 NSString *const kLineBlockRawBufferKey = @"Raw Buffer";
 NSString *const kLineBlockBufferStartOffsetKey = @"Buffer Start Offset";
@@ -34,12 +44,36 @@ NSString *const kLineBlockMetadataKey = @"Metadata";
 NSString *const kLineBlockMayHaveDWCKey = @"May Have Double Width Character";
 NSString *const kLineBlockGuid = @"GUID";
 
-static NSInteger LineBlockNextGeneration = -1;
+// Atomic because blocks may be decoded on background queues during restoration.
+static std::atomic<NSInteger> LineBlockNextGeneration(-1);
+
+extern "C" int iTermLineBlockNumberOfFullLinesImpl(screen_char_t *buffer,
+                                                   int length,
+                                                   int width,
+                                                   BOOL mayHaveDoubleWidthCharacter);
 
 void EnableDoubleWidthCharacterLineCache() {
     gEnableDoubleWidthCharacterLineCache = YES;
 }
 
+static void LineBlockLoadSettings(void) {
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        if ([iTermAdvancedSettingsModel dwcLineCache]) {
+            gEnableDoubleWidthCharacterLineCache = YES;
+            gUseCachingNumberOfLines = YES;
+        }
+        gIndexTrigrams = [iTermAdvancedSettingsModel indexScrollbackForSearch];
+        gDeduplicateCompactBlocks = [iTermAdvancedSettingsModel deduplicateScrollback];
+    });
+}
+
+void LineBlockSetIndexesTrigrams(BOOL indexes) {
+    // Load first so the settings don't overwrite this later.
+    LineBlockLoadSettings();
+    gIndexTrigrams = indexes;
+}
+
 struct iTermNumFullLinesCacheKey {
     int offset;
     int length;
@@ -111,6 +145,44 @@ struct iTermNumFullLinesCacheKeyHasher {
 
     std::vector<void *> _observers;
     NSString *_guid;
+
+    // Width-independent index for counting wrapped lines: length-1 of each raw line (or 0 for an
+    // empty line), sorted. A line of length L takes 1 + (L-1)/W wrapped lines, so only lines
+    // at least as long as the width contribute more than one. Valid while _sortedLineLengthsValid
+    // is set and _sortedLineLengthsGeneration equals _generation. Not used when there might be
+    // double-width characters.
+    std::vector<int> _sortedLineLengths;
+    BOOL _sortedLineLengthsValid;
+    NSInteger _sortedLineLengthsGeneration;
+
+    // A Bloom filter of the case-folded trigrams of printable ASCII in this block, used to skip
+    // blocks that can't contain a substring search's needle. Bits are never cleared, so it may
+    // give false positives after lines are dropped or popped but never false negatives. Empty
+    // unless gIndexTrigrams is set.
+    std::vector<uint64_t> _trigramBits;
+    // Case-insensitive searches also ignore diacritics and width, so an ASCII needle could match
+    // non-ASCII text, and every search matches canonically equivalent text. If this is set the
+    // filter can't be used for case-insensitive searches or needles with non-ASCII characters.
+    BOOL _trigramsIncludeNonASCII;
+
+    // When the block is compact, raw_buffer and buffer_start are NULL and the
+    // contents of [0, rawSpaceUsed) live here instead. See -compact.
+    NSData *_compactBuffer;
+
+    // Set by -compress. Cold blocks tell their observers when they get inflated so they can be
+    // compressed again later.
+    BOOL _cold;
+
+    // A read-only mapping of the compact form in a spill file. It stays valid after inflating,
+    // so if nothing changed by the next -compact the block can go straight back to it.
+    NSData *_spilledBuffer;
+    NSInteger _spilledGeneration;
+
+    // Set for a block restored lazily. Holds the raw buffer exactly as it was saved, with contents
+    // starting at _restoredBufferStartOffset. Like _compactBuffer, it's replaced by raw_buffer on
+    // first use.
+    NSData *_restoredBuffer;
+    int _restoredBufferStartOffset;
 }
 
 NS_INLINE void iTermLineBlockDidChange(__unsafe_unretained LineBlock *lineBlock) {
@@ -144,13 +216,10 @@ NS_INLINE void iTermLineBlockDidChange(__unsafe_unretained LineBlock *lineBlock)
 }
 
 - (void)commonInit {
-    static dispatch_once_t onceToken;
-    dispatch_once(&onceToken, ^{
-        if ([iTermAdvancedSettingsModel dwcLineCache]) {
-            gEnableDoubleWidthCharacterLineCache = YES;
-            gUseCachingNumberOfLines = YES;
-        }
-    });
+    LineBlockLoadSettings();
+    if (gIndexTrigrams) {
+        _trigramBits.resize(iTermLineBlockTrigramBits / 64);
+    }
 
     if (!_guid) {
         _guid = [[[NSUUID UUID] UUIDString] retain];
@@ -162,10 +231,14 @@ NS_INLINE void iTermLineBlockDidChange(__unsafe_unretained LineBlock *lineBlock)
 }
 
 + (instancetype)blockWithDictionary:(NSDictionary *)dictionary {
-    return [[[self alloc] initWithDictionary:dictionary] autorelease];
+    return [[[self alloc] initWithDictionary:dictionary lazily:NO] autorelease];
+}
+
++ (instancetype)blockWithDictionary:(NSDictionary *)dictionary lazily:(BOOL)lazily {
+    return [[[self alloc] initWithDictionary:dictionary lazily:lazily] autorelease];
 }
 
-- (instancetype)initWithDictionary:(NSDictionary *)dictionary {
+- (instancetype)initWithDictionary:(NSDictionary *)dictionary lazily:(BOOL)lazily {
     self = [super init];
     if (self) {
         NSArray *requiredKeys = @[ kLineBlockRawBufferKey,
@@ -185,9 +258,15 @@ NS_INLINE void iTermLineBlockDidChange(__unsafe_unretained LineBlock *lineBlock)
         }
         NSData *data = dictionary[kLineBlockRawBufferKey];
         buffer_size = [dictionary[kLineBlockBufferSizeKey] intValue];
-        raw_buffer = (screen_char_t *)iTermMalloc(buffer_size * sizeof(screen_char_t));
-        memmove(raw_buffer, data.bytes, data.length);
-        buffer_start = raw_buffer + [dictionary[kLineBlockBufferStartOffsetKey] intValue];
+        const int bufferStartOffset = [dictionary[kLineBlockBufferStartOffsetKey] intValue];
+        if (lazily && data.length <= buffer_size * sizeof(screen_char_t)) {
+            _restoredBuffer = [data copy];
+            _restoredBufferStartOffset = bufferStartOffset;
+        } else {
+            raw_buffer = (screen_char_t *)iTermMalloc(buffer_size * sizeof(screen_char_t));
+            memmove(raw_buffer, data.bytes, data.length);
+            buffer_start = raw_buffer + bufferStartOffset;
+        }
         start_offset = [dictionary[kLineBlockStartOffsetKey] intValue];
         first_entry = [dictionary[kLineBlockFirstEntryKey] intValue];
         if (dictionary[kLineBlockGuid]) {
@@ -222,6 +301,12 @@ NS_INLINE void iTermLineBlockDidChange(__unsafe_unretained LineBlock *lineBlock)
         cll_entries = cll_capacity;
         is_partial = [dictionary[kLineBlockIsPartialKey] boolValue];
         _mayHaveDoubleWidthCharacter = [dictionary[kLineBlockMayHaveDWCKey] boolValue];
+        const screen_char_t *contents = buffer_start;
+        if (_restoredBuffer) {
+            // Reading the saved data in place doesn't inflate the block.
+            contents = (const screen_char_t *)_restoredBuffer.bytes + _restoredBufferStartOffset;
+        }
+        [self addTrigramsFromBuffer:contents length:[self rawSpaceUsed] - start_offset continuingFrom:NULL];
     }
     return self;
 }
@@ -231,6 +316,9 @@ NS_INLINE void iTermLineBlockDidChange(__unsafe_unretained LineBlock *lineBlock)
     if (raw_buffer) {
         free(raw_buffer);
     }
+    [_compactBuffer release];
+    [_spilledBuffer release];
+    [_restoredBuffer release];
     if (cumulative_line_lengths) {
         free(cumulative_line_lengths);
     }
@@ -247,6 +335,7 @@ NS_INLINE void iTermLineBlockDidChange(__unsafe_unretained LineBlock *lineBlock)
 }
 
 - (LineBlock *)copyWithZone:(NSZone *)zone {
+    [self inflateIfNeeded];
     LineBlock *theCopy = [[LineBlock alloc] init];
     theCopy->raw_buffer = (screen_char_t*)iTermMalloc(sizeof(screen_char_t) * buffer_size);
     memmove(theCopy->raw_buffer, raw_buffer, sizeof(screen_char_t) * buffer_size);
@@ -273,10 +362,137 @@ NS_INLINE void iTermLineBlockDidChange(__unsafe_unretained LineBlock *lineBlock)
     theCopy->cached_numlines = cached_numlines;
     theCopy->cached_numlines_width = cached_numlines_width;
     theCopy->_generation = _generation;
+    theCopy->_trigramBits = _trigramBits;
+    theCopy->_trigramsIncludeNonASCII = _trigramsIncludeNonASCII;
     
     return theCopy;
 }
 
+#pragma mark - Compact Storage
+
+- (BOOL)isCompact {
+    return _compactBuffer != nil || _restoredBuffer != nil;
+}
+
+- (void)compact {
+    if (_compactBuffer || !raw_buffer) {
+        return;
+    }
+    if (_spilledBuffer && _spilledGeneration == _generation) {
+        // Unchanged since it was spilled, so there's no need to encode it again.
+        _compactBuffer = [_spilledBuffer retain];
+    } else {
+        [_spilledBuffer release];
+        _spilledBuffer = nil;
+        NSData *encoded = iTermCompactLineStorageEncode(raw_buffer, [self rawSpaceUsed]);
+        if (gDeduplicateCompactBlocks) {
+            encoded = iTermCompactLineStorageDeduplicate(encoded);
+        }
+        _compactBuffer = [encoded retain];
+    }
+    free(raw_buffer);
+    raw_buffer = NULL;
+    buffer_start = NULL;
+}
+
+- (void)compress {
+    _cold = YES;
+    [self compact];
+    if (!_compactBuffer ||
+        _compactBuffer == _spilledBuffer ||
+        iTermCompactLineStorageIsCompressed(_compactBuffer)) {
+        return;
+    }
+    static dispatch_queue_t queue;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        queue = dispatch_queue_create("com.iterm2.line-block-compression", DISPATCH_QUEUE_SERIAL);
+    });
+    NSData *uncompressed = [[_compactBuffer retain] autorelease];
+    dispatch_async(queue, ^{
+        NSData *compressed = iTermCompactLineStorageCompress(uncompressed);
+        dispatch_async(dispatch_get_main_queue(), ^{
+            // If the block was inflated (and maybe compacted again) in the meantime the
+            // result is stale.
+            if (self->_compactBuffer != uncompressed) {
+                return;
+            }
+            NSData *result = compressed;
+            if (gDeduplicateCompactBlocks) {
+                // Compression is deterministic, so blocks that shared the uncompressed data can
+                // share the compressed data too.
+                result = iTermCompactLineStorageDeduplicate(compressed);
+            }
+            [self->_compactBuffer release];
+            self->_compactBuffer = [result retain];
+        });
+    });
+}
+
+- (void)spillToFile:(iTermScrollbackSpillFile *)file {
+    _cold = YES;
+    [self compact];
+    if (!_compactBuffer || _compactBuffer == _spilledBuffer) {
+        return;
+    }
+    NSData *mapped = [file mappedDataByWritingData:_compactBuffer];
+    if (!mapped) {
+        return;
+    }
+    [_compactBuffer release];
+    _compactBuffer = [mapped retain];
+    [_spilledBuffer release];
+    _spilledBuffer = [mapped retain];
+    _spilledGeneration = _generation;
+}
+
+- (void)inflateIfNeeded {
+    if (_restoredBuffer) {
+        raw_buffer = (screen_char_t *)iTermMalloc(sizeof(screen_char_t) * MAX(1, buffer_size));
+        memmove(raw_buffer, _restoredBuffer.bytes, _restoredBuffer.length);
+        buffer_start = raw_buffer + _restoredBufferStartOffset;
+        [_restoredBuffer release];
+        _restoredBuffer = nil;
+        return;
+    }
+    if (!_compactBuffer) {
+        return;
+    }
+    raw_buffer = (screen_char_t *)iTermMalloc(sizeof(screen_char_t) * MAX(1, buffer_size));
+    const BOOL ok = iTermCompactLineStorageDecode(_compactBuffer, raw_buffer, buffer_size);
+    ITAssertWithMessage(ok, @"Corrupt compact line block of size %@ for buffer of size %@",
+                        @(_compactBuffer.length), @(buffer_size));
+    buffer_start = raw_buffer + start_offset;
+    [_compactBuffer release];
+    _compactBuffer = nil;
+    if (_cold) {
+        for (auto &observer : _observers) {
+            __unsafe_unretained id<iTermLineBlockObserver> obj = static_cast<id<iTermLineBlockObserver> >(observer);
+            if ([obj respondsToSelector:@selector(lineBlockDidInflate:)]) {
+                [obj lineBlockDidInflate:self];
+            }
+        }
+    }
+}
+
+- (NSInteger)memoryUsage {
+    NSInteger result = sizeof(int) * cll_capacity + sizeof(LineBlockMetadata) * cll_capacity;
+    result += sizeof(uint64_t) * _trigramBits.size();
+    if (_restoredBuffer) {
+        result += _restoredBuffer.length;
+    } else if (_compactBuffer == _spilledBuffer) {
+        // Either not compact or backed by the spill file rather than the heap.
+        if (!_compactBuffer) {
+            result += sizeof(screen_char_t) * buffer_size;
+        }
+    } else if (_compactBuffer) {
+        result += _compactBuffer.length;
+    } else {
+        result += sizeof(screen_char_t) * buffer_size;
+    }
+    return result;
+}
+
 - (int)rawSpaceUsed {
     if (cll_entries == 0) {
         return 0;
@@ -322,6 +538,7 @@ static char* formatsct(screen_char_t* src, int len, char* dest) {
 
 - (void)appendToDebugString:(NSMutableString *)s
 {
+    [self inflateIfNeeded];
     char temp[1000];
     int i;
     int prev;
@@ -343,6 +560,7 @@ static char* formatsct(screen_char_t* src, int len, char* dest) {
 }
 
 - (void)dump:(int)rawOffset toDebugLog:(BOOL)toDebugLog {
+    [self inflateIfNeeded];
     if (toDebugLog) {
         DLog(@"numRawLines=%@", @([self numRawLines]));
     } else {
@@ -372,12 +590,18 @@ static char* formatsct(screen_char_t* src, int len, char* dest) {
 - (int)numberOfFullLinesFromOffset:(int)offset
                             length:(int)length
                              width:(int)width {
+    if (!(width > 1 && _mayHaveDoubleWidthCharacter)) {
+        // The answer doesn't depend on the contents so it's cheaper to compute it than to look
+        // it up.
+        return iTermLineBlockNumberOfFullLinesImpl(NULL, length, width, NO);
+    }
     auto key = iTermNumFullLinesCacheKey(offset, length, width);
     int result;
     auto insertResult = _numberOfFullLinesCache.insert(std::make_pair(key, -1));
     auto it = insertResult.first;
     auto wasInserted = insertResult.second;
     if (wasInserted) {
+        [self inflateIfNeeded];
         result = iTermLineBlockNumberOfFullLinesImpl(raw_buffer + offset,
                                                      length,
                                                      width,
@@ -436,6 +660,7 @@ extern "C" int iTermLineBlockNumberOfFullLinesImpl(screen_char_t *buffer,
              width:(int)width
          timestamp:(NSTimeInterval)timestamp
       continuation:(screen_char_t)continuation {
+    [self inflateIfNeeded];
     _numberOfFullLinesCache.clear();
     const int space_used = [self rawSpaceUsed];
     const int free_space = buffer_size - space_used - start_offset;
@@ -449,6 +674,15 @@ extern "C" int iTermLineBlockNumberOfFullLinesImpl(screen_char_t *buffer,
         return NO;
     }
     memcpy(raw_buffer + space_used, buffer, sizeof(screen_char_t) * length);
+    if (gIndexTrigrams) {
+        const screen_char_t *lineStart = NULL;
+        if (is_partial && cll_entries > first_entry) {
+            lineStart = (cll_entries > first_entry + 1) ? raw_buffer + cumulative_line_lengths[cll_entries - 2] : buffer_start;
+        }
+        [self addTrigramsFromBuffer:raw_buffer + space_used
+                             length:length
+                     continuingFrom:lineStart];
+    }
     // There's an edge case here. In the else clause, the line buffer looks like this originally:
     //   |xxxx| EOL_SOFT
     // Then append an empty line with EOL_HARD. The desired result is
@@ -469,10 +703,10 @@ extern "C" int iTermLineBlockNumberOfFullLinesImpl(screen_char_t *buffer,
             int prev_cll = cll_entries > first_entry + 1 ? cumulative_line_lengths[cll_entries - 2] - start_offset : 0;
             int cll = cumulative_line_lengths[cll_entries - 1] - start_offset;
             int old_length = cll - prev_cll;
-            int oldnum = [self numberOfFullLinesFromOffset:(buffer_start - raw_buffer) + prev_cll
+            int oldnum = [self numberOfFullLinesFromOffset:start_offset + prev_cll
                                                     length:old_length
                                                      width:width];
-            int newnum = [self numberOfFullLinesFromOffset:(buffer_start - raw_buffer) + prev_cll
+            int newnum = [self numberOfFullLinesFromOffset:start_offset + prev_cll
                                                     length:old_length + length
                                                      width:width];
             cached_numlines += newnum - oldnum;
@@ -656,7 +890,7 @@ int OffsetOfWrappedLine(screen_char_t* p, int n, int length, int width, BOOL may
     for (i = first_entry; i < cll_entries; ++i) {
         int cll = cumulative_line_lengths[i] - start_offset;
         length = cll - prev;
-        const int spans = [self numberOfFullLinesFromOffset:(buffer_start - raw_buffer) + prev
+        const int spans = [self numberOfFullLinesFromOffset:start_offset + prev
                                                      length:length
                                                       width:width];
         if (lineNum > spans) {
@@ -678,7 +912,7 @@ int OffsetOfWrappedLine(screen_char_t* p, int n, int length, int width, BOOL may
     for (i = first_entry; i < cll_entries; ++i) {
         int cll = cumulative_line_lengths[i] - start_offset;
         length = cll - prev;
-        const int spans = [self numberOfFullLinesFromOffset:(buffer_start - raw_buffer) + prev
+        const int spans = [self numberOfFullLinesFromOffset:start_offset + prev
                                                      length:length
                                                       width:width];
         if (lineNum > spans) {
@@ -715,6 +949,7 @@ int OffsetOfWrappedLine(screen_char_t* p, int n, int length, int width, BOOL may
                                       yOffset:(int*)yOffsetPtr
                                  continuation:(screen_char_t *)continuationPtr
                          isStartOfWrappedLine:(BOOL *)isStartOfWrappedLine {
+    [self inflateIfNeeded];
     ITBetaAssert(*lineNum >= 0, @"Negative lines to getWrappedLineWithWrapWidth");
     int prev = 0;
     int numEmptyLines = 0;
@@ -736,14 +971,14 @@ int OffsetOfWrappedLine(screen_char_t* p, int n, int length, int width, BOOL may
                 metadata->number_of_wrapped_lines > 0) {
                 spans = metadata->number_of_wrapped_lines;
             } else {
-                spans = [self numberOfFullLinesFromOffset:(buffer_start - raw_buffer) + prev
+                spans = [self numberOfFullLinesFromOffset:start_offset + prev
                                                    length:length
                                                     width:width];
                 metadata->number_of_wrapped_lines = spans;
                 metadata->width_for_number_of_wrapped_lines = width;
              }
         } else {
-            spans = [self numberOfFullLinesFromOffset:(buffer_start - raw_buffer) + prev
+            spans = [self numberOfFullLinesFromOffset:start_offset + prev
                                                length:length
                                                 width:width];
         }
@@ -819,6 +1054,13 @@ int OffsetOfWrappedLine(screen_char_t* p, int n, int length, int width, BOOL may
     }
 
     int count = 0;
+    if (!(width > 1 && _mayHaveDoubleWidthCharacter)) {
+        count = [self numberOfWrappedLinesFromIndexWithWidth:width];
+        cached_numlines_width = width;
+        cached_numlines = count;
+        return count;
+    }
+
     int prev = 0;
     int i;
     // Count the number of wrapped lines in the block by computing the sum of the number
@@ -826,7 +1068,7 @@ int OffsetOfWrappedLine(screen_char_t* p, int n, int length, int width, BOOL may
     for (i = first_entry; i < cll_entries; ++i) {
         int cll = cumulative_line_lengths[i] - start_offset;
         int length = cll - prev;
-        const int marginalLines = [self numberOfFullLinesFromOffset:(buffer_start - raw_buffer) + prev
+        const int marginalLines = [self numberOfFullLinesFromOffset:start_offset + prev
                                                              length:length
                                                               width:width] + 1;
         count += marginalLines;
@@ -841,10 +1083,92 @@ int OffsetOfWrappedLine(screen_char_t* p, int n, int length, int width, BOOL may
     return count;
 }
 
+// Only valid when there are no double-width characters. This is O(log(n) + k) where k is the
+// number of raw lines longer than the width, instead of O(n).
+- (int)numberOfWrappedLinesFromIndexWithWidth:(int)width {
+    if (!_sortedLineLengthsValid || _sortedLineLengthsGeneration != _generation) {
+        _sortedLineLengths.clear();
+        _sortedLineLengths.reserve(cll_entries - first_entry);
+        int prev = 0;
+        for (int i = first_entry; i < cll_entries; ++i) {
+            const int cll = cumulative_line_lengths[i] - start_offset;
+            _sortedLineLengths.push_back(MAX(0, cll - prev - 1));
+            prev = cll;
+        }
+        std::sort(_sortedLineLengths.begin(), _sortedLineLengths.end());
+        _sortedLineLengthsValid = YES;
+        _sortedLineLengthsGeneration = _generation;
+    }
+    int count = cll_entries - first_entry;
+    for (auto it = std::lower_bound(_sortedLineLengths.begin(), _sortedLineLengths.end(), width);
+         it != _sortedLineLengths.end();
+         ++it) {
+        count += *it / width;
+    }
+    return count;
+}
+
 - (BOOL) hasCachedNumLinesForWidth: (int) width {
     return cached_numlines_width == width;
 }
 
+- (int (^)(void))threadSafeWrappedLineCounterForWidth:(int)width {
+    if (!(width > 1 && _mayHaveDoubleWidthCharacter) ||
+        cached_numlines_width == width ||
+        cll_entries == first_entry) {
+        return nil;
+    }
+    // Capture only immutable data since this block may be modified, compacted, or inflated while
+    // the counter runs.
+    NSData *data;
+    BOOL encoded = NO;
+    if (_restoredBuffer) {
+        data = _restoredBuffer;
+    } else if (_compactBuffer) {
+        data = _compactBuffer;
+        encoded = YES;
+    } else {
+        data = [NSData dataWithBytes:raw_buffer length:sizeof(screen_char_t) * [self rawSpaceUsed]];
+    }
+    const int startOffset = start_offset;
+    const int bufferSize = buffer_size;
+    const std::vector<int> lineEnds(cumulative_line_lengths + first_entry,
+                                    cumulative_line_lengths + cll_entries);
+    return [[^int {
+        screen_char_t *decoded = NULL;
+        screen_char_t *buffer = (screen_char_t *)data.bytes;
+        if (encoded) {
+            decoded = (screen_char_t *)iTermMalloc(sizeof(screen_char_t) * MAX(1, bufferSize));
+            if (!iTermCompactLineStorageDecode(data, decoded, bufferSize)) {
+                free(decoded);
+                return -1;
+            }
+            buffer = decoded;
+        }
+        // Same as getNumLinesWithWrapWidth:.
+        int count = 0;
+        int prev = 0;
+        for (const int end : lineEnds) {
+            const int cll = end - startOffset;
+            count += iTermLineBlockNumberOfFullLinesImpl(buffer + startOffset + prev,
+                                                         cll - prev,
+                                                         width,
+                                                         YES) + 1;
+            prev = cll;
+        }
+        free(decoded);
+        return count;
+    } copy] autorelease];
+}
+
+- (void)setNumberOfWrappedLines:(int)count forWidth:(int)width generation:(NSInteger)generation {
+    if (count < 0 || generation != _generation) {
+        return;
+    }
+    cached_numlines_width = width;
+    cached_numlines = count;
+}
+
 - (void)removeLastWrappedLines:(int)numberOfLinesToRemove
                          width:(int)width {
     for (int i = 0; i < numberOfLinesToRemove; i++) {
@@ -865,6 +1189,7 @@ int OffsetOfWrappedLine(screen_char_t* p, int n, int length, int width, BOOL may
               upToWidth:(int)width
               timestamp:(NSTimeInterval *)timestampPtr
            continuation:(screen_char_t *)continuationPtr {
+    [self inflateIfNeeded];
     if (cll_entries == first_entry) {
         // There is no last line to pop.
         return NO;
@@ -890,7 +1215,7 @@ int OffsetOfWrappedLine(screen_char_t* p, int n, int length, int width, BOOL may
         // If the width is four and the last line is "0123456789" then return "89". It would
         // wrap as: 0123/4567/89. If there are double-width characters, this ensures they are
         // not split across lines when computing the wrapping.
-        const int numLines = [self numberOfFullLinesFromOffset:(buffer_start - raw_buffer) + start
+        const int numLines = [self numberOfFullLinesFromOffset:start_offset + start
                                                         length:available_len
                                                          width:width];
         int offset_from_start = OffsetOfWrappedLine(buffer_start + start,
@@ -967,6 +1292,7 @@ int OffsetOfWrappedLine(screen_char_t* p, int n, int length, int width, BOOL may
 
 - (screen_char_t*)rawLine:(int)linenum
 {
+    [self inflateIfNeeded];
     int start;
     if (linenum == 0) {
         start = 0;
@@ -977,6 +1303,7 @@ int OffsetOfWrappedLine(screen_char_t* p, int n, int length, int width, BOOL may
 }
 
 - (void)changeBufferSize:(int)capacity {
+    [self inflateIfNeeded];
     ITAssertWithMessage(capacity >= [self rawSpaceUsed], @"Truncating used space");
     capacity = MAX(1, capacity);
     raw_buffer = (screen_char_t*) iTermRealloc((void*) raw_buffer, sizeof(screen_char_t), capacity);
@@ -1009,6 +1336,7 @@ int OffsetOfWrappedLine(screen_char_t* p, int n, int length, int width, BOOL may
 }
 
 - (int)dropLines:(int)n withWidth:(int)width chars:(int *)charsDropped {
+    [self inflateIfNeeded];
     int orig_n = n;
     int prev = 0;
     int length;
@@ -1023,7 +1351,7 @@ int OffsetOfWrappedLine(screen_char_t* p, int n, int length, int width, BOOL may
         // Get the number of full-length wrapped lines in this raw line. If there
         // were only single-width characters the formula would be:
         //     (length - 1) / width;
-        int spans = [self numberOfFullLinesFromOffset:(buffer_start - raw_buffer) + prev
+        int spans = [self numberOfFullLinesFromOffset:start_offset + prev
                                                length:length
                                                 width:width];
         if (n > spans) {
@@ -1151,7 +1479,82 @@ static NSString* RewrittenRegex(NSString* originalRegex) {
     return rewritten;
 }
 
-static int CoreSearch(NSString *needle,
+// Everything about a needle that can be computed once per search rather than once per line.
+struct iTermLineBlockSearchPattern {
+    NSString *needle;
+    BOOL regex;
+    // Only set for regexes.
+    NSString *rewrittenRegex;
+    BOOL caseInsensitive;
+    // A string that every match of the regex must contain. Empty if none could be found.
+    std::vector<unichar> requiredLiteral;
+};
+
+static iTermLineBlockSearchPattern iTermLineBlockSearchPatternMake(NSString *needle, iTermFindMode mode) {
+    iTermLineBlockSearchPattern pattern;
+    pattern.needle = needle;
+    pattern.regex = (mode == iTermFindModeCaseInsensitiveRegex ||
+                     mode == iTermFindModeCaseSensitiveRegex);
+    pattern.rewrittenRegex = nil;
+    pattern.caseInsensitive = (mode == iTermFindModeCaseInsensitiveRegex);
+    if (pattern.regex) {
+        pattern.rewrittenRegex = RewrittenRegex(needle);
+        NSString *literal = iTermRegexRequiredLiteral(needle, pattern.caseInsensitive);
+        pattern.requiredLiteral.resize(literal.length);
+        [literal getCharacters:pattern.requiredLiteral.data() range:NSMakeRange(0, literal.length)];
+    }
+    return pattern;
+}
+
+// Returns NO only if the line can't possibly match |pattern| because it lacks the required
+// literal. Characters are compared the way the haystack string would present them: private-use
+// cells are skipped, and lines with complex characters (or anything non-ASCII, for caseless
+// patterns) aren't filtered at all.
+static BOOL iTermLineBlockLineMayMatch(const iTermLineBlockSearchPattern &pattern,
+                                       const screen_char_t *line,
+                                       int length) {
+    const std::vector<unichar> &literal = pattern.requiredLiteral;
+    if (literal.empty()) {
+        return YES;
+    }
+    const size_t n = literal.size();
+    const unichar first = literal[0];
+    for (int i = 0; i < length; i++) {
+        const screen_char_t &c = line[i];
+        if (ScreenCharIsPrivateUse(c.code)) {
+            continue;
+        }
+        if (c.complexChar || c.image || (pattern.caseInsensitive && c.code >= 0x80)) {
+            return YES;
+        }
+        unichar code = pattern.caseInsensitive ? tolower(c.code) : c.code;
+        if (code != first) {
+            continue;
+        }
+        // Compare the rest, skipping private-use cells like the haystack does.
+        size_t matched = 1;
+        for (int j = i + 1; j < length && matched < n; j++) {
+            const screen_char_t &d = line[j];
+            if (ScreenCharIsPrivateUse(d.code)) {
+                continue;
+            }
+            if (d.complexChar || d.image) {
+                return YES;
+            }
+            code = pattern.caseInsensitive && d.code < 0x80 ? tolower(d.code) : d.code;
+            if (code != literal[matched]) {
+                break;
+            }
+            matched++;
+        }
+        if (matched == n) {
+            return YES;
+        }
+    }
+    return NO;
+}
+
+static int CoreSearch(const iTermLineBlockSearchPattern &pattern,
                       screen_char_t *rawline,
                       int raw_line_length,
                       int start,
@@ -1163,11 +1566,10 @@ static int CoreSearch(NSString *needle,
                       unichar *charHaystack,
                       int *deltas,
                       int deltaOffset) {
+    NSString *needle = pattern.needle;
     RKLRegexOptions apiOptions = RKLNoOptions;
     NSRange range;
-    const BOOL regex = (mode == iTermFindModeCaseInsensitiveRegex ||
-                        mode == iTermFindModeCaseSensitiveRegex);
-    if (regex) {
+    if (pattern.regex) {
         BOOL backwards = NO;
         if (options & FindOptBackwards) {
             backwards = YES;
@@ -1178,7 +1580,7 @@ static int CoreSearch(NSString *needle,
 
         NSError* regexError = nil;
         NSRange temp;
-        NSString* rewrittenRegex = RewrittenRegex(needle);
+        NSString* rewrittenRegex = pattern.rewrittenRegex;
         NSString* sanitizedHaystack = [haystack stringByReplacingOccurrencesOfString:[NSString stringWithFormat:@"%c", kPrefixChar]
                                                                           withString:[NSString stringWithFormat:@"%c", 3]];
         sanitizedHaystack = [sanitizedHaystack stringByReplacingOccurrencesOfString:[NSString stringWithFormat:@"%c", kSuffixChar]
@@ -1283,7 +1685,7 @@ static int CoreSearch(NSString *needle,
     return result;
 }
 
-static int Search(NSString* needle,
+static int Search(const iTermLineBlockSearchPattern &pattern,
                   screen_char_t* rawline,
                   int raw_line_length,
                   int start,
@@ -1301,7 +1703,7 @@ static int Search(NSString* needle,
                                        &charHaystack,
                                        &deltas);
     // screen_char_t[i + deltas[i]] begins its run at charHaystack[i]
-    int result = CoreSearch(needle, rawline, raw_line_length, start, end, options, mode, resultLength,
+    int result = CoreSearch(pattern, rawline, raw_line_length, start, end, options, mode, resultLength,
                             haystack, charHaystack, deltas, deltas[0]);
 
     free(deltas);
@@ -1310,7 +1712,7 @@ static int Search(NSString* needle,
 }
 
 - (void)_findInRawLine:(int)entry
-                needle:(NSString*)needle
+               pattern:(const iTermLineBlockSearchPattern &)pattern
                options:(int)options
                   mode:(iTermFindMode)mode
                   skip:(int)skip
@@ -1324,6 +1726,9 @@ static int Search(NSString* needle,
     if (skip < 0) {
         skip = 0;
     }
+    if (!iTermLineBlockLineMayMatch(pattern, rawline, raw_line_length)) {
+        return;
+    }
     if (options & FindOptBackwards) {
         // This algorithm is wacky and slow but stay with me here:
         // When you search backward, the most common case is that you are
@@ -1388,7 +1793,7 @@ static int Search(NSString* needle,
                 // terminate.
                 break;
             }
-            tempPosition = CoreSearch(needle, rawline, raw_line_length, 0, limit, options,
+            tempPosition = CoreSearch(pattern, rawline, raw_line_length, 0, limit, options,
                                       mode, &tempResultLength, haystack, charHaystack, deltas, 0);
 
             limit = tempPosition + tempResultLength - 1;
@@ -1415,7 +1820,7 @@ static int Search(NSString* needle,
         int tempResultLength;
         int tempPosition;
         while (skip < raw_line_length) {
-            tempPosition = Search(needle, rawline, raw_line_length, skip, raw_line_length,
+            tempPosition = Search(pattern, rawline, raw_line_length, skip, raw_line_length,
                                   options, mode, &tempResultLength);
             if (tempPosition != -1) {
                 ResultRange* r = [[[ResultRange alloc] init] autorelease];
@@ -1459,12 +1864,127 @@ static int Search(NSString* needle,
     return -1;
 }
 
+#pragma mark - Trigram Filter
+
+NS_INLINE BOOL iTermLineBlockIsTrigramCharacter(unichar c) {
+    return c >= 0x20 && c < 0x7f;
+}
+
+NS_INLINE uint32_t iTermLineBlockTrigramHash(uint32_t trigram) {
+    // Knuth's multiplicative hash, keeping the top 14 bits.
+    static_assert(iTermLineBlockTrigramBits == (1 << 14), "Update the shift");
+    return (trigram * 2654435761u) >> (32 - 14);
+}
+
+NS_INLINE uint32_t iTermLineBlockTrigramShift(uint32_t trigram, unichar c) {
+    return ((trigram << 7) | tolower(c)) & 0x1fffff;
+}
+
+// Adds the trigrams in buffer[0..<length]. If the buffer continues a raw line that begins at
+// lineStart, the trigrams that span the boundary are added too.
+- (void)addTrigramsFromBuffer:(const screen_char_t *)buffer
+                       length:(int)length
+               continuingFrom:(const screen_char_t *)lineStart {
+    if (_trigramBits.empty()) {
+        return;
+    }
+    uint32_t trigram = 0;
+    int count = 0;
+    if (lineStart) {
+        // Seed with the last two characters of the line so far, the same way the search will
+        // see them once the line is converted to a string.
+        int seeded = 0;
+        for (const screen_char_t *p = buffer - 1; p >= lineStart && seeded < 2; p--) {
+            if (ScreenCharIsPrivateUse(p->code)) {
+                continue;
+            }
+            if (p->complexChar || p->image || !iTermLineBlockIsTrigramCharacter(p->code)) {
+                break;
+            }
+            trigram |= ((uint32_t)tolower(p->code)) << (7 * seeded);
+            seeded++;
+        }
+        count = seeded;
+    }
+    for (int i = 0; i < length; i++) {
+        const screen_char_t &c = buffer[i];
+        if (ScreenCharIsPrivateUse(c.code)) {
+            // Removed when the line is converted to a string, so its neighbors are adjacent.
+            continue;
+        }
+        if (c.complexChar || c.image || !iTermLineBlockIsTrigramCharacter(c.code)) {
+            if (c.code != 0 || c.complexChar || c.image) {
+                _trigramsIncludeNonASCII = YES;
+            }
+            count = 0;
+            trigram = 0;
+            continue;
+        }
+        trigram = iTermLineBlockTrigramShift(trigram, c.code);
+        if (++count >= 3) {
+            const uint32_t h = iTermLineBlockTrigramHash(trigram);
+            _trigramBits[h / 64] |= (1ULL << (h % 64));
+        }
+    }
+}
+
+- (BOOL)mayContainSubstring:(NSString *)substring mode:(iTermFindMode)mode {
+    if (_trigramBits.empty()) {
+        return YES;
+    }
+    if (mode == iTermFindModeCaseSensitiveRegex || mode == iTermFindModeCaseInsensitiveRegex) {
+        return YES;
+    }
+    BOOL caseInsensitive = (mode == iTermFindModeCaseInsensitiveSubstring);
+    if (mode == iTermFindModeSmartCaseSensitivity &&
+        [substring rangeOfCharacterFromSet:[NSCharacterSet uppercaseLetterCharacterSet]].location == NSNotFound) {
+        caseInsensitive = YES;
+    }
+    const NSUInteger length = substring.length;
+    if (_trigramsIncludeNonASCII) {
+        if (caseInsensitive) {
+            return YES;
+        }
+        // Searches don't use NSLiteralSearch, so a needle with non-ASCII characters can match
+        // canonically equivalent text whose trigrams were never indexed, like CAFE\u0301 in CAFÉ.
+        for (NSUInteger i = 0; i < length; i++) {
+            if ([substring characterAtIndex:i] >= 0x80) {
+                return YES;
+            }
+        }
+    }
+    uint32_t trigram = 0;
+    int count = 0;
+    for (NSUInteger i = 0; i < length; i++) {
+        const unichar c = [substring characterAtIndex:i];
+        if (!iTermLineBlockIsTrigramCharacter(c)) {
+            count = 0;
+            trigram = 0;
+            continue;
+        }
+        trigram = iTermLineBlockTrigramShift(trigram, c);
+        if (++count >= 3) {
+            const uint32_t h = iTermLineBlockTrigramHash(trigram);
+            if (!(_trigramBits[h / 64] & (1ULL << (h % 64)))) {
+                return NO;
+            }
+        }
+    }
+    return YES;
+}
+
+#pragma mark - Search
+
 - (void)findSubstring:(NSString*)substring
               options:(int)options
                  mode:(iTermFindMode)mode
              atOffset:(int)offset
               results:(NSMutableArray *)results
       multipleResults:(BOOL)multipleResults {
+    if (![self mayContainSubstring:substring mode:mode]) {
+        return;
+    }
+    [self inflateIfNeeded];
     if (offset == -1) {
         offset = [self rawSpaceUsed] - 1;
     }
@@ -1484,6 +2004,7 @@ static int Search(NSString* needle,
         limit = cll_entries;
         dir = 1;
     }
+    const iTermLineBlockSearchPattern pattern = iTermLineBlockSearchPatternMake(substring, mode);
     while (entry != limit) {
         int line_raw_offset = [self _lineRawOffset:entry];
         int skipped = offset - line_raw_offset;
@@ -1496,7 +2017,7 @@ static int Search(NSString* needle,
         // it'll hang for a long time.
         static const int MAX_SEARCHABLE_LINE_LENGTH = 500000;
         [self _findInRawLine:entry
-                      needle:substring
+                     pattern:pattern
                      options:options
                         mode:mode
                         skip:skipped
@@ -1520,6 +2041,7 @@ static int Search(NSString* needle,
               wrapOnEOL:(BOOL)wrapOnEOL
                     toX:(int*)x
                     toY:(int*)y {
+    [self inflateIfNeeded];
     if (width <= 0) {
         return NO;
     }
@@ -1603,10 +2125,17 @@ static int Search(NSString* needle,
 }
 
 - (NSDictionary *)dictionary {
-    NSData *rawBufferData = [NSData dataWithBytes:raw_buffer
-                                           length:[self rawSpaceUsed] * sizeof(screen_char_t)];
+    NSData *rawBufferData;
+    const NSUInteger length = [self rawSpaceUsed] * sizeof(screen_char_t);
+    if (_restoredBuffer && _restoredBuffer.length == length) {
+        // Unchanged since it was restored, so save it again without inflating.
+        rawBufferData = _restoredBuffer;
+    } else {
+        [self inflateIfNeeded];
+        rawBufferData = [NSData dataWithBytes:raw_buffer length:length];
+    }
     return @{ kLineBlockRawBufferKey: rawBufferData,
-              kLineBlockBufferStartOffsetKey: @(buffer_start - raw_buffer),
+              kLineBlockBufferStartOffsetKey: @(start_offset),
               kLineBlockStartOffsetKey: @(start_offset),
               kLineBlockFirstEntryKey: @(first_entry),
               kLineBlockBufferSizeKey: @(buffer_size),
@@ -1659,6 +2188,13 @@ static int Search(NSString* needle,
     return it != _observers.end();
 }
 
+- (BOOL)hasObserverOtherThan:(id<iTermLineBlockObserver>)observer {
+    void *voidptr = static_cast<void *>(observer);
+    return std::any_of(_observers.begin(), _observers.end(), [voidptr](void *existing) {
+        return existing != voidptr;
+    });
+}
+
 #pragma mark - iTermUniquelyIdentifiable
 
 - (NSString *)stringUniqueIdentifier {
@@ -58,12 +58,17 @@
 @property(nonatomic, readonly) int largestAbsoluteBlockNumber;
 @property(nonatomic, weak) id<iTermLineBufferDelegate> delegate;
 
+// Set this for unlimited scrollback to move old blocks into a memory-mapped temporary file (see
+// the spillScrollbackAfterBlocks advanced setting). Not copied by -copy.
+@property(nonatomic, assign) BOOL spillsToDisk;
+
 - (LineBuffer*)initWithBlockSize:(int)bs;
 - (LineBuffer *)initWithDictionary:(NSDictionary *)dictionary;
 
 // Returns a copy of this buffer that can be appended to but that you must not
 // pop lines from. Only the last block is deep-copied; references are held to
-// all earlier blocks.
+// all earlier blocks. With the copyOnWriteLineBlocks advanced setting, the last
+// block is shared too until either buffer modifies it.
 - (LineBuffer *)newAppendOnlyCopy;
 
 // Call this immediately after init. Otherwise the buffer will hold unlimited lines (until you
@@ -189,6 +194,13 @@
 
 - (int)numberOfDroppedBlocks;
 
+// Approximate bytes of heap used by the line blocks. Blocks spilled to disk count only their
+// metadata. See -[LineBlock memoryUsage].
+- (NSInteger)memoryUsage;
+
+// See -[iTermLineBlockArray compressBlocksExceptNewest:].
+- (NSInteger)compressBlocksExceptNewest:(NSUInteger)count;
+
 // Returns a dictionary with the contents of the line buffer. If it is more than 10k lines @ 80 columns
 // then it is truncated. The data is a weak reference and will be invalid if the line buffer is
 // changed.
@@ -203,6 +215,12 @@
 
 - (int)numberOfWrappedLinesWithWidth:(int)width;
 
+// Counts wrapped lines at |width| on background threads so a following resize to that width
+// doesn't have to. Returns NO without calling |completion| if there's too little history to
+// bother. Otherwise |completion| is called on the main queue once the counts are in place. Blocks
+// that change in the meantime are counted again by the resize.
+- (BOOL)prepareToWrapToWidth:(int)width completion:(void (^)(void))completion;
+
 - (void)beginResizing;
 - (void)endResizing;
 
@@ -35,6 +35,7 @@
 #import "iTermLineBlockArray.h"
 #import "iTermMalloc.h"
 #import "iTermOrderedDictionary.h"
+#import "iTermScrollbackSpillFile.h"
 #import "LineBlock.h"
 #import "NSArray+iTerm.h"
 #import "NSData+iTerm.h"
@@ -50,6 +51,10 @@ static NSString *const kLineBufferNumDroppedBlocksKey = @"Num Dropped Blocks";
 static NSString *const kLineBufferDroppedCharsKey = @"Dropped Chars";
 static NSString *const kLineBufferTruncatedKey = @"Truncated";
 static NSString *const kLineBufferMayHaveDWCKey = @"May Have Double Width Character";
+
+// Counting wrapped lines is only slow for blocks that may have double-width characters, since the
+// contents must be scanned. Below this many characters it's fast enough to do during the resize.
+static const NSInteger kLineBufferMinimumCharactersToWrapInBackground = 4 * 1024 * 1024;
 static NSString *const kLineBufferBlockWrapperKey = @"Block Wrapper";
 
 static const int kLineBufferVersion = 1;
@@ -85,6 +90,11 @@ static const NSInteger kUnicodeVersion = 9;
 
 // Append a block
 - (LineBlock*)_addBlockOfSize:(int)size {
+    if ([iTermAdvancedSettingsModel compactScrollback]) {
+        // The current last block will not be appended to again, so it can be stored
+        // compactly until someone needs to look at it.
+        [_lineBlocks.lastBlock compact];
+    }
     LineBlock* block = [[LineBlock alloc] initWithRawBufferSize: size];
     block.mayHaveDoubleWidthCharacter = self.mayHaveDoubleWidthCharacter;
     [_lineBlocks addBlock:block];
@@ -138,12 +148,19 @@ static const NSInteger kUnicodeVersion = 9;
         max_lines = [dictionary[kLineBufferMaxLinesKey] intValue];
         num_dropped_blocks = [dictionary[kLineBufferNumDroppedBlocksKey] intValue];
         droppedChars = [dictionary[kLineBufferDroppedCharsKey] longLongValue];
-        for (NSDictionary *maybeWrapper in dictionary[kLineBufferBlocksKey]) {
+        NSArray *blockDictionaries = dictionary[kLineBufferBlocksKey];
+        // Only the last block is likely to be drawn or appended to soon. The rest keep their saved
+        // contents as-is until they're scrolled to or searched.
+        const BOOL lazily = [iTermAdvancedSettingsModel lazyScrollbackRestoration];
+        const NSUInteger lastIndex = blockDictionaries.count - 1;
+        for (NSUInteger i = 0; i < blockDictionaries.count; i++) {
+            NSDictionary *maybeWrapper = blockDictionaries[i];
             NSDictionary *blockDictionary = maybeWrapper;
             if (maybeWrapper[kLineBufferBlockWrapperKey]) {
                 blockDictionary = maybeWrapper[kLineBufferBlockWrapperKey];
             }
-            LineBlock *block = [LineBlock blockWithDictionary:blockDictionary];
+            LineBlock *block = [LineBlock blockWithDictionary:blockDictionary
+                                                       lazily:lazily && i != lastIndex];
             if (!block) {
                 [self autorelease];
                 return nil;
@@ -181,6 +198,21 @@ static int RawNumLines(LineBuffer* buffer, int width) {
 }
 
 
+- (void)setSpillsToDisk:(BOOL)spillsToDisk {
+    if (spillsToDisk == _spillsToDisk) {
+        return;
+    }
+    _spillsToDisk = spillsToDisk;
+    if (spillsToDisk && [iTermAdvancedSettingsModel spillScrollbackAfterBlocks] > 0) {
+        iTermScrollbackSpillFile *spillFile = [[iTermScrollbackSpillFile alloc] init];
+        _lineBlocks.spillFile = spillFile;
+        [spillFile release];
+    } else {
+        // Blocks that were already spilled keep their mappings.
+        _lineBlocks.spillFile = nil;
+    }
+}
+
 - (void) setMaxLines: (int) maxLines
 {
     max_lines = maxLines;
@@ -188,12 +220,27 @@ static int RawNumLines(LineBuffer* buffer, int width) {
 }
 
 
+// Use this instead of _lineBlocks.lastBlock before modifying the last block.
+- (LineBlock *)lastBlockForWriting {
+    if ([iTermAdvancedSettingsModel copyOnWriteLineBlocks]) {
+        return [_lineBlocks lastBlockForWriting];
+    }
+    return _lineBlocks.lastBlock;
+}
+
+- (LineBlock *)firstBlockForWriting {
+    if ([iTermAdvancedSettingsModel copyOnWriteLineBlocks]) {
+        return [_lineBlocks firstBlockForWriting];
+    }
+    return _lineBlocks[0];
+}
+
 - (int)dropExcessLinesWithWidth: (int) width
 {
     int nl = RawNumLines(self, width);
     int totalDropped = 0;
     if (max_lines != -1 && nl > max_lines) {
-        LineBlock *block = _lineBlocks[0];
+        LineBlock *block = [self firstBlockForWriting];
         int total_lines = nl;
         while (total_lines > max_lines) {
             int extra_lines = total_lines - max_lines;
@@ -214,7 +261,7 @@ static int RawNumLines(LineBuffer* buffer, int width) {
                 [_lineBlocks removeFirstBlock];
                 ++num_dropped_blocks;
                 if (_lineBlocks.count > 0) {
-                    block = _lineBlocks[0];
+                    block = [self firstBlockForWriting];
                 }
             }
             total_lines -= dropped;
@@ -327,7 +374,7 @@ static int RawNumLines(LineBuffer* buffer, int width) {
         [self _addBlockOfSize:block_size];
     }
 
-    LineBlock* block = _lineBlocks.lastBlock;
+    LineBlock* block = [self lastBlockForWriting];
 
     int beforeLines = [block getNumLinesWithWrapWidth:width];
     if (![block appendLine:buffer
@@ -564,7 +611,7 @@ static int RawNumLines(LineBuffer* buffer, int width) {
         const int numberOfLinesInBlock = [block getNumLinesWithWrapWidth:width];
         if (numberOfLinesInBlock > linesToRemoveRemaining) {
             // Keep part of block
-            [block removeLastWrappedLines:linesToRemoveRemaining width:width];
+            [[self lastBlockForWriting] removeLastWrappedLines:linesToRemoveRemaining width:width];
             return;
         }
         // Remove the whole block and try again.
@@ -584,7 +631,7 @@ static int RawNumLines(LineBuffer* buffer, int width) {
     }
     num_wrapped_lines_width = -1;
 
-    LineBlock* block = _lineBlocks.lastBlock;
+    LineBlock* block = [self lastBlockForWriting];
 
     // If the line is partial the client will want to add a continuation marker so
     // tell him there's no EOL in that case.
@@ -772,6 +819,12 @@ NS_INLINE int TotalNumberOfRawLines(LineBuffer *self) {
 
     // NSLog(@"search block %d starting at offset %d", context.absBlockNum - num_dropped_blocks, context.offset);
 
+    if ((context.options & FindMultipleResults) &&
+        [iTermAdvancedSettingsModel parallelScrollbackSearch]) {
+        [self findSubstring:context stopAt:stopPosition inBlocksStartingAtIndex:blockIndex];
+        return;
+    }
+
     [block findSubstring:context.substring
                  options:context.options
                     mode:context.mode
@@ -808,6 +861,84 @@ NS_INLINE int TotalNumberOfRawLines(LineBuffer *self) {
     context.absBlockNum = context.absBlockNum + context.dir;
 }
 
+// Searches a batch of consecutive blocks (in the direction of the search) concurrently and then
+// processes the results in block order exactly as if the blocks had been searched one at a time.
+// This blocks the main thread until the whole batch is done, which is what makes it safe: nothing
+// can modify the blocks or the complex character table in the meantime.
+- (void)findSubstring:(FindContext *)context
+               stopAt:(LineBufferPosition *)stopPosition
+inBlocksStartingAtIndex:(NSInteger)firstIndex {
+    const NSInteger numBlocks = _lineBlocks.count;
+    const NSInteger batchSize = MAX(1, [[NSProcessInfo processInfo] activeProcessorCount] * 4);
+    const NSInteger available = context.dir > 0 ? numBlocks - firstIndex : firstIndex + 1;
+    const NSInteger count = MIN(batchSize, available);
+
+    NSMutableArray<LineBlock *> *blocks = [NSMutableArray arrayWithCapacity:count];
+    NSMutableArray<NSMutableArray<ResultRange *> *> *resultsPerBlock = [NSMutableArray arrayWithCapacity:count];
+    for (NSInteger i = 0; i < count; i++) {
+        LineBlock *block = _lineBlocks[firstIndex + i * context.dir];
+        // Inflating notifies observers so it must happen here, not on a worker thread.
+        [block inflateIfNeeded];
+        [blocks addObject:block];
+        [resultsPerBlock addObject:[NSMutableArray array]];
+    }
+
+    NSString *substring = context.substring;
+    const int options = (int)context.options;
+    const iTermFindMode mode = context.mode;
+    const int firstOffset = context.offset;
+    const int subsequentOffset = context.dir < 0 ? -1 : 0;
+    dispatch_apply(count, dispatch_get_global_queue(QOS_CLASS_USER_INITIATED, 0), ^(size_t i) {
+        [blocks[i] findSubstring:substring
+                         options:options
+                            mode:mode
+                        atOffset:i == 0 ? firstOffset : subsequentOffset
+                         results:resultsPerBlock[i]
+                 multipleResults:YES];
+    });
+
+    const int stopAt = stopPosition.absolutePosition - droppedChars;
+    NSMutableArray *filtered = [NSMutableArray array];
+    NSInteger numberSearched = 0;
+    for (NSInteger i = 0; i < count; i++) {
+        const int blockPosition = [self _blockPosition:context.absBlockNum - num_dropped_blocks + i * context.dir];
+        BOOL haveOutOfRangeResults = NO;
+        NSMutableArray *filteredInBlock = [NSMutableArray array];
+        for (ResultRange *range in resultsPerBlock[i]) {
+            range->position += blockPosition;
+            if (context.dir * (range->position - stopAt) > 0 ||
+                context.dir * (range->position + context.matchLength - stopAt) > 0) {
+                haveOutOfRangeResults = YES;
+            } else {
+                [filteredInBlock addObject:range];
+            }
+        }
+        if (filteredInBlock.count == 0 && haveOutOfRangeResults) {
+            if (filtered.count == 0) {
+                context.status = NotFound;
+                numberSearched = i + 1;
+            } else {
+                // Report what was found so far. Searching resumes at this block and then stops.
+                numberSearched = i;
+            }
+            break;
+        }
+        if (filteredInBlock.count > 0) {
+            context.status = Matched;
+            [filtered addObjectsFromArray:filteredInBlock];
+        }
+        numberSearched = i + 1;
+    }
+    [context.results addObjectsFromArray:filtered];
+
+    if (context.dir < 0) {
+        context.offset = -1;
+    } else {
+        context.offset = 0;
+    }
+    context.absBlockNum = context.absBlockNum + context.dir * (int)numberSearched;
+}
+
 // Returns an array of XRange values
 - (NSArray*)convertPositions:(NSArray *)resultRanges withWidth:(int)width {
     if (width <= 0) {
@@ -1086,7 +1217,8 @@ NS_INLINE int TotalNumberOfRawLines(LineBuffer *self) {
     [theCopy->_lineBlocks release];
     theCopy->_lineBlocks = [_lineBlocks copy];
     LineBlock *lastBlock = _lineBlocks.lastBlock;
-    if (lastBlock) {
+    if (lastBlock && ![iTermAdvancedSettingsModel copyOnWriteLineBlocks]) {
+        // Otherwise whichever buffer changes the last block first copies it.
         [theCopy->_lineBlocks replaceLastBlockWithCopy];
     }
     theCopy->block_size = block_size;
@@ -1106,6 +1238,18 @@ NS_INLINE int TotalNumberOfRawLines(LineBuffer *self) {
     return num_dropped_blocks;
 }
 
+- (NSInteger)memoryUsage {
+    NSInteger result = 0;
+    for (LineBlock *block in _lineBlocks.blocks) {
+        result += [block memoryUsage];
+    }
+    return result;
+}
+
+- (NSInteger)compressBlocksExceptNewest:(NSUInteger)count {
+    return [_lineBlocks compressBlocksExceptNewest:count];
+}
+
 - (int)largestAbsoluteBlockNumber {
     return _lineBlocks.count + num_dropped_blocks;
 }
@@ -1267,6 +1411,56 @@ NS_INLINE int TotalNumberOfRawLines(LineBuffer *self) {
     return [_lineBlocks numberOfWrappedLinesForWidth:width];
 }
 
+- (BOOL)prepareToWrapToWidth:(int)width completion:(void (^)(void))completion {
+    if (width <= 1) {
+        return NO;
+    }
+    // The last block changes with every line of output, so leave it to the resize.
+    NSArray<LineBlock *> *candidates = [_lineBlocks.blocks subarrayWithRange:NSMakeRange(0, MAX(1, _lineBlocks.count) - 1)];
+    NSInteger characters = 0;
+    for (LineBlock *block in candidates) {
+        if (block.mayHaveDoubleWidthCharacter && ![block hasCachedNumLinesForWidth:width]) {
+            characters += block.numberOfCharacters;
+        }
+    }
+    if (characters < kLineBufferMinimumCharactersToWrapInBackground) {
+        return NO;
+    }
+
+    NSMutableArray<LineBlock *> *blocks = [NSMutableArray array];
+    NSMutableArray<NSNumber *> *generations = [NSMutableArray array];
+    NSMutableArray *counters = [NSMutableArray array];
+    for (LineBlock *block in candidates) {
+        int (^counter)(void) = [block threadSafeWrappedLineCounterForWidth:width];
+        if (counter) {
+            [blocks addObject:block];
+            [generations addObject:@(block.generation)];
+            [counters addObject:counter];
+        }
+    }
+    DLog(@"Count wrapped lines at width %d for %@ blocks with %@ characters in the background",
+         width, @(blocks.count), @(characters));
+    completion = [[completion copy] autorelease];
+    const size_t n = counters.count;
+    int *counts = iTermMalloc(sizeof(int) * MAX(1, n));
+    dispatch_async(dispatch_get_global_queue(QOS_CLASS_USER_INITIATED, 0), ^{
+        dispatch_apply(n, DISPATCH_APPLY_AUTO, ^(size_t i) {
+            int (^counter)(void) = counters[i];
+            counts[i] = counter();
+        });
+        dispatch_async(dispatch_get_main_queue(), ^{
+            for (size_t i = 0; i < n; i++) {
+                [blocks[i] setNumberOfWrappedLines:counts[i]
+                                          forWidth:width
+                                        generation:generations[i].integerValue];
+            }
+            free(counts);
+            completion();
+        });
+    });
+    return YES;
+}
+
 - (void)beginResizing {
     assert(!_lineBlocks.resizing);
     _lineBlocks.resizing = YES;
@@ -1283,7 +1477,7 @@ NS_INLINE int TotalNumberOfRawLines(LineBuffer *self) {
 }
 
 - (void)setPartial:(BOOL)partial {
-    [_lineBlocks.lastBlock setPartial:partial];
+    [[self lastBlockForWriting] setPartial:partial];
 }
 
 @end
@@ -39,6 +39,11 @@ typedef enum {
     return YES;
 }
 
+// The mark is placed at the cursor line.
+- (BOOL)needsSynchronousEvaluation {
+    return YES;
+}
+
 - (NSInteger)indexForObject:(id)object {
     int i = 0;
     for (NSNumber *n in [self objectsSortedByValueInDict:[self menuItemsForPoupupButton]]) {
@@ -102,6 +102,10 @@ NS_CLASS_AVAILABLE(10_11, NA)
 @property (nonatomic, readonly) id creationIdentifier;
 @property (nonatomic, readonly) vector_float2 atlasSize;
 
+// Bytes of GPU memory used by the textures created so far. They may be shared with other groups
+// through iTermASCIITextureCache.
+@property (nonatomic, readonly) NSUInteger allocatedSize;
+
 - (instancetype)initWithDevice:(id<MTLDevice>)device
             creationIdentifier:(id)creationIdentifier
                     descriptor:(iTermCharacterSourceDescriptor *)descriptor
@@ -9,6 +9,8 @@
 #import "iTermASCIITexture.h"
 
 #import "DebugLogging.h"
+#import "iTermAdvancedSettingsModel.h"
+#import "iTermASCIITextureDiskCache.h"
 #import "iTermCache.h"
 #import "iTermCharacterSource.h"
 #import "iTermMalloc.h"
@@ -48,7 +50,7 @@ static const NSInteger iTermASCIITextureCapacity = iTermASCIITextureOffsetCount
 - (instancetype)init {
     self = [super init];
     if (self) {
-        _cache = [[iTermCache alloc] initWithCapacity:256];
+        _cache = [[iTermCache alloc] initWithName:@"ascii_texture" maximumCost:256 shards:1 timeToLive:0];
     }
     return self;
 }
@@ -110,8 +112,15 @@ static const NSInteger iTermASCIITextureCapacity = iTermASCIITextureOffsetCount
                                        (attributes & iTermASCIITextureAttributesItalic) ? @"Italic" : @"",
                                        (attributes & iTermASCIITextureAttributesThinStrokes) ? @"ThinStrokes" : @""];
 
+        const BOOL cacheOnDisk = [iTermAdvancedSettingsModel cacheGlyphsOnDisk];
+        if (cacheOnDisk && [self loadFromDiskCacheWithAttributes:attributes descriptor:descriptor]) {
+            return self;
+        }
+        NSMutableDictionary<NSNumber *, NSDictionary<NSNumber *, iTermCharacterBitmap *> *> *bitmaps =
+            cacheOnDisk ? [NSMutableDictionary dictionary] : nil;
         for (int i = iTermASCIITextureMinimumCharacter; i <= iTermASCIITextureMaximumCharacter; i++) {
             NSDictionary<NSNumber *, iTermCharacterBitmap *> *dict = creation(i, attributes);
+            bitmaps[@(i)] = dict;
             iTermCharacterBitmap *left = dict[@(iTermImagePartFromDeltas(-1, 0))];
             iTermCharacterBitmap *center = dict[@(iTermImagePartFromDeltas(0, 0))];
             iTermCharacterBitmap *right = dict[@(iTermImagePartFromDeltas(1, 0))];
@@ -132,10 +141,40 @@ static const NSInteger iTermASCIITextureCapacity = iTermASCIITextureOffsetCount
                 ELog(@"Couldn't produce image for ascii %d", i);
             }
         }
+        if (bitmaps) {
+            [[iTermASCIITextureDiskCache sharedInstance] saveBitmaps:bitmaps
+                                                      withAttributes:attributes
+                                                          descriptor:descriptor];
+        }
     }
     return self;
 }
 
+- (BOOL)loadFromDiskCacheWithAttributes:(iTermASCIITextureAttributes)attributes
+                             descriptor:(iTermCharacterSourceDescriptor *)descriptor {
+    return [[iTermASCIITextureDiskCache sharedInstance] enumerateBitmapsWithAttributes:attributes
+                                                                            descriptor:descriptor
+                                                                                 block:^(char c,
+                                                                                         const void *left,
+                                                                                         const void *center,
+                                                                                         const void *right) {
+        if (left) {
+            self->_parts[c] |= iTermASCIITexturePartsLeft;
+            [self->_textureArray setSlice:iTermASCIITextureIndexOfCode(c, iTermASCIITextureOffsetLeft)
+                                withBytes:left];
+        }
+        if (right) {
+            self->_parts[c] |= iTermASCIITexturePartsRight;
+            [self->_textureArray setSlice:iTermASCIITextureIndexOfCode(c, iTermASCIITextureOffsetRight)
+                                withBytes:right];
+        }
+        if (center) {
+            [self->_textureArray setSlice:iTermASCIITextureIndexOfCode(c, iTermASCIITextureOffsetCenter)
+                                withBytes:center];
+        }
+    }];
+}
+
 - (void)dealloc {
     free(_parts);
 }
@@ -192,6 +231,16 @@ static const NSInteger iTermASCIITextureCapacity = iTermASCIITextureOffsetCount
     return texture;
 }
 
+- (NSUInteger)allocatedSize {
+    NSUInteger result = 0;
+    if (@available(macOS 10.13, *)) {
+        for (int i = 0; i < iTermASCIITextureAttributesMax * 2; i++) {
+            result += _textures[i].textureArray.texture.allocatedSize;
+        }
+    }
+    return result;
+}
+
 - (BOOL)isEqual:(id)object {
     if (![object isKindOfClass:[iTermASCIITextureGroup class]]) {
         return NO;
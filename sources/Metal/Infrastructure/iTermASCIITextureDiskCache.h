@@ -0,0 +1,44 @@
+//
+//  iTermASCIITextureDiskCache.h
+//  iTerm2SharedARC
+//
+//  Created by agent on 10/14/26.
+//
+
+#import <Foundation/Foundation.h>
+
+#import "iTermASCIITexture.h"
+
+NS_ASSUME_NONNULL_BEGIN
+
+@class iTermCharacterBitmap;
+@class iTermCharacterSourceDescriptor;
+
+// Saves rasterized ASCII glyphs between launches so restoring many windows doesn't have to
+// rasterize the same fonts again. Entries are keyed by everything that affects rasterization:
+// font names and sizes, metrics, scale, antialiasing, attributes, and the OS and app versions.
+// Files are memory-mapped when read.
+@interface iTermASCIITextureDiskCache : NSObject
+
++ (instancetype)sharedInstance;
+
+// Returns NO if there is no usable entry, in which case |block| is not called. Otherwise calls
+// |block| for each character iTermASCIITextureMinimumCharacter...iTermASCIITextureMaximumCharacter
+// with pointers to BGRA bitmaps of the descriptor's glyph size, one per part and NULL for missing
+// parts. The pointers are only valid during the call.
+- (BOOL)enumerateBitmapsWithAttributes:(iTermASCIITextureAttributes)attributes
+                            descriptor:(iTermCharacterSourceDescriptor *)descriptor
+                                 block:(void (^NS_NOESCAPE)(char c,
+                                                            const void * _Nullable left,
+                                                            const void * _Nullable center,
+                                                            const void * _Nullable right))block;
+
+// Writes an entry in the background. |bitmaps| maps each character to its parts as returned by
+// the character source.
+- (void)saveBitmaps:(NSDictionary<NSNumber *, NSDictionary<NSNumber *, iTermCharacterBitmap *> *> *)bitmaps
+     withAttributes:(iTermASCIITextureAttributes)attributes
+         descriptor:(iTermCharacterSourceDescriptor *)descriptor;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,238 @@
+//
+//  iTermASCIITextureDiskCache.m
+//  iTerm2SharedARC
+//
+//  Created by agent on 10/14/26.
+//
+
+#import "iTermASCIITextureDiskCache.h"
+
+#import "DebugLogging.h"
+#import "FutureMethods.h"
+#import "iTermCharacterBitmap.h"
+#import "iTermCharacterParts.h"
+#import "iTermCharacterSource.h"
+#import "NSData+iTerm.h"
+#import "PTYFontInfo.h"
+
+static const uint32_t iTermASCIITextureDiskCacheMagic = 'iAT1';
+
+typedef struct {
+    uint32_t magic;
+    uint32_t width;
+    uint32_t height;
+    uint32_t numberOfCharacters;
+} iTermASCIITextureDiskCacheHeader;
+
+// Followed by the bitmaps for each part that is present, in the order left, center, right.
+typedef struct {
+    uint32_t parts;
+} iTermASCIITextureDiskCacheCharacter;
+
+static int iTermASCIITextureDiskCacheNumberOfCharacters(void) {
+    return iTermASCIITextureMaximumCharacter - iTermASCIITextureMinimumCharacter + 1;
+}
+
+@implementation iTermASCIITextureDiskCache {
+    dispatch_queue_t _queue;
+    NSString *_directory;
+}
+
++ (instancetype)sharedInstance {
+    static id instance;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        instance = [[self alloc] init];
+    });
+    return instance;
+}
+
+- (instancetype)init {
+    self = [super init];
+    if (self) {
+        _queue = dispatch_queue_create("com.iterm2.ascii-texture-disk-cache", DISPATCH_QUEUE_SERIAL);
+        NSString *caches = NSSearchPathForDirectoriesInDomains(NSCachesDirectory, NSUserDomainMask, YES).firstObject;
+        NSString *bundleIdentifier = [[NSBundle mainBundle] bundleIdentifier] ?: @"iTerm2";
+        _directory = [[caches stringByAppendingPathComponent:bundleIdentifier] stringByAppendingPathComponent:@"GlyphCache"];
+    }
+    return self;
+}
+
+#pragma mark - API
+
+- (BOOL)enumerateBitmapsWithAttributes:(iTermASCIITextureAttributes)attributes
+                            descriptor:(iTermCharacterSourceDescriptor *)descriptor
+                                 block:(void (^NS_NOESCAPE)(char, const void *, const void *, const void *))block {
+    NSString *path = [self pathForAttributes:attributes descriptor:descriptor];
+    NSData *data = [NSData dataWithContentsOfFile:path options:NSDataReadingMappedIfSafe error:nil];
+    if (!data) {
+        return NO;
+    }
+    const uint32_t width = descriptor.glyphSize.width;
+    const uint32_t height = descriptor.glyphSize.height;
+    const size_t bitmapSize = (size_t)width * height * 4;
+    if (![self dataIsValid:data width:width height:height]) {
+        DLog(@"Discarding invalid glyph cache at %@", path);
+        [[NSFileManager defaultManager] removeItemAtPath:path error:nil];
+        return NO;
+    }
+    const unsigned char *bytes = data.bytes;
+    size_t offset = sizeof(iTermASCIITextureDiskCacheHeader);
+    for (int i = 0; i < iTermASCIITextureDiskCacheNumberOfCharacters(); i++) {
+        iTermASCIITextureDiskCacheCharacter character;
+        memcpy(&character, bytes + offset, sizeof(character));
+        offset += sizeof(character);
+        const void *parts[3] = { NULL, NULL, NULL };
+        for (int j = 0; j < 3; j++) {
+            if (character.parts & (1 << j)) {
+                parts[j] = bytes + offset;
+                offset += bitmapSize;
+            }
+        }
+        block(iTermASCIITextureMinimumCharacter + i, parts[0], parts[1], parts[2]);
+    }
+    return YES;
+}
+
+- (void)saveBitmaps:(NSDictionary<NSNumber *, NSDictionary<NSNumber *, iTermCharacterBitmap *> *> *)bitmaps
+     withAttributes:(iTermASCIITextureAttributes)attributes
+         descriptor:(iTermCharacterSourceDescriptor *)descriptor {
+    NSString *path = [self pathForAttributes:attributes descriptor:descriptor];
+    const uint32_t width = descriptor.glyphSize.width;
+    const uint32_t height = descriptor.glyphSize.height;
+    NSString *directory = _directory;
+    dispatch_async(_queue, ^{
+        NSData *data = [self dataForBitmaps:bitmaps width:width height:height];
+        if (!data) {
+            return;
+        }
+        [[NSFileManager defaultManager] createDirectoryAtPath:directory
+                                  withIntermediateDirectories:YES
+                                                   attributes:nil
+                                                        error:nil];
+        NSError *error = nil;
+        if (![data writeToFile:path options:NSDataWritingAtomic error:&error]) {
+            DLog(@"Failed to write glyph cache to %@: %@", path, error);
+        }
+    });
+}
+
+#pragma mark - Private
+
+- (NSData *)dataForBitmaps:(NSDictionary<NSNumber *, NSDictionary<NSNumber *, iTermCharacterBitmap *> *> *)bitmaps
+                     width:(uint32_t)width
+                    height:(uint32_t)height {
+    const NSUInteger bitmapSize = (NSUInteger)width * height * 4;
+    NSMutableData *data = [NSMutableData data];
+    const iTermASCIITextureDiskCacheHeader header = {
+        .magic = iTermASCIITextureDiskCacheMagic,
+        .width = width,
+        .height = height,
+        .numberOfCharacters = iTermASCIITextureDiskCacheNumberOfCharacters()
+    };
+    [data appendBytes:&header length:sizeof(header)];
+    const int partNumbers[3] = {
+        iTermImagePartFromDeltas(-1, 0),
+        iTermImagePartFromDeltas(0, 0),
+        iTermImagePartFromDeltas(1, 0)
+    };
+    for (int i = 0; i < iTermASCIITextureDiskCacheNumberOfCharacters(); i++) {
+        NSDictionary<NSNumber *, iTermCharacterBitmap *> *dict = bitmaps[@(iTermASCIITextureMinimumCharacter + i)];
+        iTermASCIITextureDiskCacheCharacter character = { .parts = 0 };
+        for (int j = 0; j < 3; j++) {
+            iTermCharacterBitmap *bitmap = dict[@(partNumbers[j])];
+            if (!bitmap) {
+                continue;
+            }
+            if (bitmap.data.length != bitmapSize) {
+                // Don't save anything that couldn't be read back the same way.
+                return nil;
+            }
+            character.parts |= (1 << j);
+        }
+        [data appendBytes:&character length:sizeof(character)];
+        for (int j = 0; j < 3; j++) {
+            if (character.parts & (1 << j)) {
+                [data appendData:dict[@(partNumbers[j])].data];
+            }
+        }
+    }
+    return data;
+}
+
+- (BOOL)dataIsValid:(NSData *)data width:(uint32_t)width height:(uint32_t)height {
+    if (data.length < sizeof(iTermASCIITextureDiskCacheHeader)) {
+        return NO;
+    }
+    iTermASCIITextureDiskCacheHeader header;
+    memcpy(&header, data.bytes, sizeof(header));
+    if (header.magic != iTermASCIITextureDiskCacheMagic ||
+        header.width != width ||
+        header.height != height ||
+        header.numberOfCharacters != iTermASCIITextureDiskCacheNumberOfCharacters()) {
+        return NO;
+    }
+    const size_t bitmapSize = (size_t)width * height * 4;
+    const unsigned char *bytes = data.bytes;
+    size_t offset = sizeof(header);
+    for (int i = 0; i < iTermASCIITextureDiskCacheNumberOfCharacters(); i++) {
+        if (offset + sizeof(iTermASCIITextureDiskCacheCharacter) > data.length) {
+            return NO;
+        }
+        iTermASCIITextureDiskCacheCharacter character;
+        memcpy(&character, bytes + offset, sizeof(character));
+        offset += sizeof(character);
+        if (character.parts & ~7) {
+            return NO;
+        }
+        offset += bitmapSize * __builtin_popcount(character.parts);
+    }
+    return offset == data.length;
+}
+
+- (NSString *)pathForAttributes:(iTermASCIITextureAttributes)attributes
+                     descriptor:(iTermCharacterSourceDescriptor *)descriptor {
+    NSString *key = [self keyForAttributes:attributes descriptor:descriptor];
+    NSString *name = [[[key dataUsingEncoding:NSUTF8StringEncoding] it_sha256] it_hexEncoded];
+    return [_directory stringByAppendingPathComponent:name];
+}
+
+- (NSString *)keyForFontInfo:(nullable PTYFontInfo *)fontInfo {
+    NSMutableArray<NSString *> *parts = [NSMutableArray array];
+    for (id object in @[ fontInfo ?: [NSNull null],
+                         fontInfo.boldVersion ?: [NSNull null],
+                         fontInfo.italicVersion ?: [NSNull null],
+                         fontInfo.boldItalicVersion ?: [NSNull null] ]) {
+        if (![object isKindOfClass:[PTYFontInfo class]]) {
+            [parts addObject:@"-"];
+            continue;
+        }
+        PTYFontInfo *info = object;
+        [parts addObject:[NSString stringWithFormat:@"%@@%f", info.font.fontName, info.font.pointSize]];
+    }
+    return [parts componentsJoinedByString:@","];
+}
+
+- (NSString *)keyForAttributes:(iTermASCIITextureAttributes)attributes
+                    descriptor:(iTermCharacterSourceDescriptor *)descriptor {
+    NSString *appVersion = [[NSBundle mainBundle] objectForInfoDictionaryKey:@"CFBundleVersion"] ?: @"";
+    NSArray *values = @[ @(attributes),
+                         [self keyForFontInfo:descriptor.asciiFontInfo],
+                         [self keyForFontInfo:descriptor.nonAsciiFontInfo],
+                         NSStringFromSize(descriptor.asciiOffset),
+                         NSStringFromSize(descriptor.glyphSize),
+                         NSStringFromSize(descriptor.cellSize),
+                         NSStringFromSize(descriptor.cellSizeWithoutSpacing),
+                         @(descriptor.scale),
+                         @(descriptor.useBoldFont),
+                         @(descriptor.useItalicFont),
+                         @(descriptor.useNonAsciiFont),
+                         @(descriptor.asciiAntiAliased),
+                         @(descriptor.nonAsciiAntiAliased),
+                         @(iTermTextIsMonochrome()),
+                         [[NSProcessInfo processInfo] operatingSystemVersionString],
+                         appVersion ];
+    return [values componentsJoinedByString:@"|"];
+}
+
+@end
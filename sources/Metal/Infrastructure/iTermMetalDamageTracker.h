@@ -0,0 +1,32 @@
+//
+//  iTermMetalDamageTracker.h
+//  iTerm2SharedARC
+//
+//  Created by agent on 10/14/26.
+//
+
+#import <Foundation/Foundation.h>
+#import <Metal/Metal.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+@class iTermMetalFrameData;
+
+// Decides which rows of a frame can differ from the previous frame drawn into a retained texture.
+// Anything that isn't described row-by-row (badge, flash, indicators, IME, and so on) forces a
+// full redraw when it's present or when it changes.
+NS_CLASS_AVAILABLE(10_11, NA)
+@interface iTermMetalDamageTracker : NSObject
+
+// Call on the private queue in the order frames are committed, after the frame's rows have been
+// populated. |texture| is the retained texture the frame will be drawn into. Returns the rows to
+// redraw, which is all of them if the previous contents of |texture| can't be trusted.
+- (NSRange)damagedRowsInFrameData:(iTermMetalFrameData *)frameData
+                  retainedTexture:(id<MTLTexture>)texture;
+
+// Forget the previous frame. The next frame is drawn in full.
+- (void)invalidate;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,199 @@
+//
+//  iTermMetalDamageTracker.m
+//  iTerm2SharedARC
+//
+//  Created by agent on 10/14/26.
+//
+
+#import "iTermMetalDamageTracker.h"
+
+#import "DebugLogging.h"
+#import "iTermAdvancedSettingsModel.h"
+#import "iTermData.h"
+#import "iTermMetalDriver.h"
+#import "iTermMetalFrameData.h"
+#import "iTermMetalRowData.h"
+
+// Everything about a frame that isn't per-row and affects pixels in every row.
+typedef struct {
+    vector_uint2 viewportSize;
+    VT100GridSize gridSize;
+    CGSize cellSize;
+    CGSize cellSizeWithoutSpacing;
+    CGSize glyphSize;
+    CGSize asciiOffset;
+    CGFloat scale;
+    NSEdgeInsets extraMargins;
+    NSEdgeInsets edgeInsets;
+    vector_float4 defaultBackgroundColor;
+    vector_float4 processedDefaultBackgroundColor;
+    CGRect badgeSourceRect;
+    CGRect badgeDestinationRect;
+    CGRect relativeFrame;
+    CGRect containerRect;
+    CGFloat transparencyAlpha;
+    CGFloat blend;
+    BOOL showBroadcastStripes;
+    BOOL cursorGuideEnabled;
+    BOOL hasBackgroundImage;
+    BOOL asciiAntiAliased;
+} iTermMetalDamageFrameSignature;
+
+@implementation iTermMetalDamageTracker {
+    BOOL _valid;
+    __weak id<MTLTexture> _texture;
+    iTermMetalDamageFrameSignature _signature;
+    // Held strongly so that identity comparison is meaningful.
+    NSImage *_badgeImage;
+    NSColor *_cursorGuideColor;
+    id _asciiCreationIdentifier;
+    NSArray<NSData *> *_rows;
+    int _cursorRow;
+}
+
+- (void)invalidate {
+    _valid = NO;
+    _rows = nil;
+    _badgeImage = nil;
+    _cursorGuideColor = nil;
+    _asciiCreationIdentifier = nil;
+}
+
+- (NSRange)damagedRowsInFrameData:(iTermMetalFrameData *)frameData
+                  retainedTexture:(id<MTLTexture>)texture {
+    const NSRange everything = NSMakeRange(0, frameData.rows.count);
+    id<iTermMetalDriverDataSourcePerFrameState> state = frameData.perFrameState;
+
+    iTermMetalDamageFrameSignature signature;
+    // Zero out padding so the signatures can be compared with memcmp.
+    memset(&signature, 0, sizeof(signature));
+    signature.viewportSize = frameData.viewportSize;
+    signature.gridSize = frameData.gridSize;
+    signature.cellSize = frameData.cellSize;
+    signature.cellSizeWithoutSpacing = frameData.cellSizeWithoutSpacing;
+    signature.glyphSize = frameData.glyphSize;
+    signature.asciiOffset = frameData.asciiOffset;
+    signature.scale = frameData.scale;
+    signature.extraMargins = frameData.extraMargins;
+    signature.edgeInsets = state.edgeInsets;
+    signature.defaultBackgroundColor = state.defaultBackgroundColor;
+    signature.processedDefaultBackgroundColor = state.processedDefaultBackgroundColor;
+    signature.badgeSourceRect = state.badgeSourceRect;
+    signature.badgeDestinationRect = state.badgeDestinationRect;
+    signature.relativeFrame = state.relativeFrame;
+    signature.containerRect = state.containerRect;
+    signature.transparencyAlpha = state.transparencyAlpha;
+    signature.blend = state.blend;
+    signature.showBroadcastStripes = state.showBroadcastStripes;
+    signature.cursorGuideEnabled = state.cursorGuideEnabled;
+    signature.hasBackgroundImage = state.hasBackgroundImage;
+    signature.asciiAntiAliased = state.asciiAntiAliased;
+
+    NSArray<NSData *> *rows = [self rowSignaturesOfFrameData:frameData];
+    iTermMetalCursorInfo *cursorInfo = [state metalDriverCursorInfo];
+    const int cursorRow = cursorInfo.coord.y;
+    id asciiCreationIdentifier = [state metalASCIICreationIdentifierWithOffset:frameData.asciiOffset];
+
+    const BOOL comparable = (_valid &&
+                             _texture == texture &&
+                             memcmp(&signature, &_signature, sizeof(signature)) == 0 &&
+                             state.badgeImage == _badgeImage &&
+                             (state.cursorGuideColor == _cursorGuideColor || [state.cursorGuideColor isEqual:_cursorGuideColor]) &&
+                             [asciiCreationIdentifier isEqual:_asciiCreationIdentifier] &&
+                             rows.count == _rows.count &&
+                             ![self frameDataNeedsFullRedraw:frameData cursorInfo:cursorInfo]);
+
+    NSRange result = everything;
+    if (comparable) {
+        NSInteger first = NSNotFound;
+        NSInteger last = NSNotFound;
+        for (NSInteger i = 0; i < rows.count; i++) {
+            const BOOL dirty = (i == cursorRow ||
+                                i == _cursorRow ||
+                                frameData.rows[i].imageRuns.count > 0 ||
+                                ![rows[i] isEqualToData:_rows[i]]);
+            if (!dirty) {
+                continue;
+            }
+            if (first == NSNotFound) {
+                first = i;
+            }
+            last = i;
+        }
+        if (first != NSNotFound) {
+            result = NSMakeRange(first, last - first + 1);
+        } else {
+            // Nothing changed, but something has to be drawn. This can happen when the cursor is
+            // off screen.
+            result = NSMakeRange(0, MIN(1, rows.count));
+        }
+    }
+    DLog(@"Damaged rows for %@: %@", frameData, NSStringFromRange(result));
+
+    _valid = YES;
+    _texture = texture;
+    _signature = signature;
+    _badgeImage = state.badgeImage;
+    _cursorGuideColor = state.cursorGuideColor;
+    _asciiCreationIdentifier = asciiCreationIdentifier;
+    _rows = rows;
+    _cursorRow = cursorRow;
+    return result;
+}
+
+#pragma mark - Private
+
+// Things that are drawn over many rows or change without the row data changing.
+- (BOOL)frameDataNeedsFullRedraw:(iTermMetalFrameData *)frameData
+                      cursorInfo:(iTermMetalCursorInfo *)cursorInfo {
+    id<iTermMetalDriverDataSourcePerFrameState> state = frameData.perFrameState;
+    if (state.imeInfo != nil ||
+        state.fullScreenFlashColor.w > 0 ||
+        state.timestampsEnabled ||
+        cursorInfo.copyMode ||
+        [iTermAdvancedSettingsModel showMetalFPSmeter]) {
+        return YES;
+    }
+    __block BOOL found = NO;
+    [state metalEnumerateHighlightedRows:^(vector_float3 color, NSTimeInterval age, int row) {
+        found = YES;
+    }];
+    if (found) {
+        return YES;
+    }
+    const CGFloat scale = frameData.scale;
+    const NSRect frame = NSMakeRect(0,
+                                    0,
+                                    frameData.viewportSize.x / scale,
+                                    frameData.viewportSize.y / scale);
+    [state enumerateIndicatorsInFrame:frame block:^(iTermIndicatorDescriptor * _Nonnull indicator) {
+        found = YES;
+    }];
+    return found;
+}
+
+// Glyph keys of undrawable cells aren't fully initialized, so they're zeroed before comparing.
+- (NSArray<NSData *> *)rowSignaturesOfFrameData:(iTermMetalFrameData *)frameData {
+    NSMutableArray<NSData *> *result = [NSMutableArray arrayWithCapacity:frameData.rows.count];
+    for (iTermMetalRowData *rowData in frameData.rows) {
+        const int columns = frameData.gridSize.width;
+        NSMutableData *data = [NSMutableData dataWithLength:sizeof(iTermMetalGlyphKey) * columns];
+        iTermMetalGlyphKey *keys = (iTermMetalGlyphKey *)data.mutableBytes;
+        const iTermMetalGlyphKey *sourceKeys = (const iTermMetalGlyphKey *)rowData.keysData.bytes;
+        for (int x = 0; x < columns && x < rowData.numberOfDrawableGlyphs; x++) {
+            if (sourceKeys[x].drawable) {
+                keys[x] = sourceKeys[x];
+            }
+        }
+        [data appendBytes:rowData.attributesData.bytes
+                   length:sizeof(iTermMetalGlyphAttributes) * columns];
+        [data appendBytes:rowData.backgroundColorRLEData.bytes
+                   length:sizeof(iTermMetalBackgroundColorRLE) * rowData.numberOfBackgroundRLEs];
+        const iTermMarkStyle markStyle = rowData.markStyle;
+        [data appendBytes:&markStyle length:sizeof(markStyle)];
+        [result addObject:data];
+    }
+    return result;
+}
+
+@end
@@ -57,6 +57,7 @@ NS_CLASS_AVAILABLE(10_11, NA)
                        size:(CGSize)size
              transientState:(iTermMetalRendererTransientState *)tState;
 - (void)addMetalCapture:(NSURL *)url;
+- (void)setLatencyStats:(NSDictionary<NSString *, id> *)latencyStats;
 
 - (NSData *)newArchive;
 
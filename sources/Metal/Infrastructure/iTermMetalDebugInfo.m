@@ -83,6 +83,7 @@
     NSMutableArray<iTermMetalDebugDrawInfo *> *_draws;
     NSImage *_finalImage;
     NSURL *_metalCaptureURL;
+    NSDictionary<NSString *, id> *_latencyStats;
 }
 
 - (instancetype)init {
@@ -140,6 +141,10 @@
     _metalCaptureURL = url;
 }
 
+- (void)setLatencyStats:(NSDictionary<NSString *, id> *)latencyStats {
+    _latencyStats = [latencyStats copy];
+}
+
 - (NSUInteger)numberOfRecordedDraws {
     return _draws.count;
 }
@@ -197,6 +202,12 @@
                                                 error:&error];
         ITCriticalError(error == nil, @"Error moving gpu capture: %@", error);
     }
+    if (_latencyStats) {
+        NSData *json = [NSJSONSerialization dataWithJSONObject:_latencyStats
+                                                       options:NSJSONWritingPrettyPrinted
+                                                         error:nil];
+        [json writeToURL:[root URLByAppendingPathComponent:@"latency.json"] atomically:NO];
+    }
     NSURL *rowDataFolder = [self newFolderNamed:@"RowData" root:root];
     [_rowData enumerateObjectsUsingBlock:^(iTermMetalRowData * _Nonnull rowData, NSUInteger idx, BOOL * _Nonnull stop) {
         NSString *name = [NSString stringWithFormat:@"rowdata.%04d", (int)idx];
@@ -142,6 +142,9 @@ NS_CLASS_AVAILABLE(10_11, NA)
 - (nullable id<MTLTexture>)textureFromImage:(iTermImageWrapper *)image context:(nullable iTermMetalBufferPoolContext *)context;
 - (nullable id<MTLTexture>)textureFromImage:(iTermImageWrapper *)image context:(nullable iTermMetalBufferPoolContext *)context pool:(nullable iTermTexturePool *)pool;
 
+// Makes a 2D array texture with one slice per image. All slices have the size of the first image.
+- (nullable id<MTLTexture>)textureArrayFromImages:(NSArray<iTermImageWrapper *> *)images context:(nullable iTermMetalBufferPoolContext *)context;
+
 - (id<MTLRenderPipelineState>)newPipelineWithBlending:(nullable iTermMetalBlending *)blending
                                        vertexFunction:(id<MTLFunction>)vertexFunction
                                      fragmentFunction:(id<MTLFunction>)fragmentFunction;
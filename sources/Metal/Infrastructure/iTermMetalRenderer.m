@@ -14,6 +14,11 @@
 
 const NSInteger iTermMetalDriverMaximumNumberOfFramesInFlight = 3;
 
+@interface iTermMetalBlending()
+// Identifies the blend state, for sharing pipeline states.
+- (NSString *)pipelineStateKey;
+@end
+
 @implementation iTermMetalBlending
 
 + (instancetype)compositeSourceOver {
@@ -31,6 +36,13 @@ const NSInteger iTermMetalDriverMaximumNumberOfFramesInFlight = 3;
     return blending;
 }
 
+- (NSString *)pipelineStateKey {
+    return [NSString stringWithFormat:@"%@ %@ %@ %@ %@ %@",
+            @(_rgbBlendOperation), @(_alphaBlendOperation),
+            @(_sourceRGBBlendFactor), @(_destinationRGBBlendFactor),
+            @(_sourceAlphaBlendFactor), @(_destinationAlphaBlendFactor)];
+}
+
 #if ENABLE_TRANSPARENT_METAL_WINDOWS
 
 // See https://en.wikipedia.org/wiki/Alpha_compositing
@@ -198,22 +210,56 @@ maximumExtendedDynamicRangeColorComponentValue:(CGFloat)maximumExtendedDynamicRa
 - (id<MTLRenderPipelineState>)pipelineState {
     NSDictionary *key = [self keyForPipelineState];
     if (_pipelineStates[key] == nil) {
-        static id<MTLLibrary> defaultLibrary;
-        static dispatch_once_t onceToken;
-        dispatch_once(&onceToken, ^{
-            defaultLibrary = [self->_device newDefaultLibrary];
-        });
-        id <MTLFunction> vertexShader = [defaultLibrary newFunctionWithName:_vertexFunctionName];
-        ITDebugAssert(vertexShader);
-        id <MTLFunction> fragmentShader = [defaultLibrary newFunctionWithName:_fragmentFunctionName];
-        ITDebugAssert(fragmentShader);
-        _pipelineStates[key] = [self newPipelineWithBlending:_blending
-                                              vertexFunction:vertexShader
-                                            fragmentFunction:fragmentShader];
+        if ([iTermAdvancedSettingsModel sharePipelineStatesAcrossSessions]) {
+            _pipelineStates[key] = [self sharedPipelineStateForKey:key];
+        } else {
+            _pipelineStates[key] = [self newPipelineState];
+        }
     }
     return _pipelineStates[key];
 }
 
+- (id<MTLRenderPipelineState>)newPipelineState {
+    static id<MTLLibrary> defaultLibrary;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        defaultLibrary = [self->_device newDefaultLibrary];
+    });
+    id <MTLFunction> vertexShader = [defaultLibrary newFunctionWithName:_vertexFunctionName];
+    ITDebugAssert(vertexShader);
+    id <MTLFunction> fragmentShader = [defaultLibrary newFunctionWithName:_fragmentFunctionName];
+    ITDebugAssert(fragmentShader);
+    return [self newPipelineWithBlending:_blending
+                          vertexFunction:vertexShader
+                        fragmentFunction:fragmentShader];
+}
+
+// A pipeline state depends only on the renderer's class, shaders, blending, and pixel format, so
+// every session's renderers can use the same one. This saves compiling dozens of pipelines each
+// time a tab or split is created.
+- (id<MTLRenderPipelineState>)sharedPipelineStateForKey:(NSDictionary *)key {
+    static NSMutableDictionary<NSDictionary *, id<MTLRenderPipelineState>> *sharedPipelineStates;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        sharedPipelineStates = [NSMutableDictionary dictionary];
+    });
+    NSDictionary *sharedKey = @{ @"key": key,
+                                 @"class": NSStringFromClass([self class]),
+                                 @"device": [NSValue valueWithNonretainedObject:_device],
+                                 @"blending": [_blending pipelineStateKey] ?: @"",
+                                 @"hdr": @([iTermAdvancedSettingsModel hdrCursor]) };
+    @synchronized (sharedPipelineStates) {
+        id<MTLRenderPipelineState> pipelineState = sharedPipelineStates[sharedKey];
+        if (!pipelineState) {
+            pipelineState = [self newPipelineState];
+            if (pipelineState) {
+                sharedPipelineStates[sharedKey] = pipelineState;
+            }
+        }
+        return pipelineState;
+    }
+}
+
 #pragma mark - iTermMetalDebugInfoFormatter
 
 - (void)writeVertexBuffer:(id<MTLBuffer>)buffer index:(NSUInteger)index toFolder:(NSURL *)folder {
@@ -450,6 +496,58 @@ maximumExtendedDynamicRangeColorComponentValue:(CGFloat)maximumExtendedDynamicRa
     return texture;
 }
 
+- (nullable id<MTLTexture>)textureArrayFromImages:(NSArray<iTermImageWrapper *> *)images context:(iTermMetalBufferPoolContext *)context {
+    iTermImageWrapper *first = images.firstObject;
+    if (!first.image || images.count > 2048) {
+        return nil;
+    }
+
+    NSUInteger width, height;
+    [self convertWidth:first.scaledSize.width
+                height:first.scaledSize.height
+               toWidth:&width
+                height:&height
+          notExceeding:4096];
+    if (width == 0 || height == 0) {
+        return nil;
+    }
+
+    MTLTextureDescriptor *textureDescriptor =
+    [MTLTextureDescriptor texture2DDescriptorWithPixelFormat:MTLPixelFormatRGBA8Unorm
+                                                       width:width
+                                                      height:height
+                                                   mipmapped:NO];
+    textureDescriptor.textureType = MTLTextureType2DArray;
+    textureDescriptor.arrayLength = images.count;
+    id<MTLTexture> texture = [_device newTextureWithDescriptor:textureDescriptor];
+    if (!texture) {
+        return nil;
+    }
+
+    const MTLRegion region = MTLRegionMake2D(0, 0, width, height);
+    const NSUInteger bytesPerPixel = 4;
+    const NSUInteger bytesPerRow = bytesPerPixel * width;
+    for (NSUInteger slice = 0; slice < images.count; slice++) {
+        NSData *data = [images[slice].image rawDataForMetalOfSize:NSMakeSize(width, height)];
+        if (!data) {
+            return nil;
+        }
+        [texture replaceRegion:region
+                   mipmapLevel:0
+                         slice:slice
+                     withBytes:data.bytes
+                   bytesPerRow:bytesPerRow
+                 bytesPerImage:bytesPerRow * height];
+    }
+
+    [iTermTexture setBytesPerRow:bytesPerRow
+                     rawDataSize:height * width * 4
+                 samplesPerPixel:4
+                      forTexture:texture];
+    [context didAddTextureOfSize:texture.width * texture.height * images.count];
+    return texture;
+}
+
 - (id<MTLBuffer>)vertexBufferForViewportSize:(vector_uint2)viewportSize {
     if (!simd_equal(viewportSize, _cachedViewportSize)) {
         _cachedViewportSize = viewportSize;
@@ -12,6 +12,8 @@ extern "C" {
 }
 #import <Cocoa/Cocoa.h>
 
+#import "iTermAdvancedSettingsModel.h"
+#import "NSData+iTerm.h"
 #import "NSImage+iTerm.h"
 #include <map>
 #include <unordered_map>
@@ -21,6 +23,19 @@ extern "C" {
 static const CGSize iTermSubpixelModelSize = { 80, 80 };
 static NSString *const iTermSubpixelModelString = @"O";
 
+// Models saved between launches are stored as a header followed by records.
+static const uint32_t iTermSubpixelModelFileMagic = 'iSM1';
+
+typedef struct {
+    uint32_t magic;
+    uint32_t count;
+} iTermSubpixelModelFileHeader;
+
+typedef struct {
+    uint16_t key;
+    unsigned char table[256];
+} iTermSubpixelModelFileRecord;
+
 @interface iTermSubpixelModel()
 @property (nonatomic, readonly) NSMutableData *mutableTable;
 @end
@@ -85,6 +100,14 @@ static NSString *const iTermSubpixelModelString = @"O";
 
     // Cache of models that have already been built.
     NSMutableDictionary<NSNumber *, iTermSubpixelModel *> *_models;
+
+    // Models loaded from disk. Maps a key to the offset of its record in _persistedData, which is
+    // memory mapped.
+    std::unordered_map<uint16_t, size_t> _persistedOffsets;
+    NSData *_persistedData;
+    BOOL _loadedPersistedModels;
+    BOOL _saveScheduled;
+    dispatch_queue_t _saveQueue;
 }
 
 + (instancetype)sharedInstance {
@@ -192,6 +215,15 @@ static NSString *const iTermSubpixelModelString = @"O";
     self = [super init];
     if (self) {
         _models = [NSMutableDictionary dictionary];
+        _saveQueue = dispatch_queue_create("com.iterm2.subpixel-models", DISPATCH_QUEUE_SERIAL);
+    }
+    return self;
+}
+
+// The reference image is only needed to build models, which may all come from disk, so it's drawn
+// the first time a model has to be built.
+- (std::unordered_map<int, int> *)indexToReferenceColor {
+    if (!_indexToReferenceColor) {
         _indexToReferenceColor = new std::unordered_map<int, int>();
         NSData *referenceImageData = [iTermSubpixelModelBuilder dataForImageWithForegroundColor:vector4(0.0f, 0.0f, 0.0f, 1.0f)
                                                                                 backgroundColor:vector4(1.0f, 1.0f, 1.0f, 1.0f)];
@@ -213,7 +245,7 @@ static NSString *const iTermSubpixelModelString = @"O";
             }
         }
     }
-    return self;
+    return _indexToReferenceColor;
 }
 
 - (iTermSubpixelModel *)modelForForegroundColor:(float)foregroundComponent
@@ -225,6 +257,16 @@ static NSString *const iTermSubpixelModelString = @"O";
         if (cachedModel) {
             return cachedModel;
         }
+        const BOOL persist = [iTermAdvancedSettingsModel persistSubpixelModels];
+        if (persist) {
+            iTermSubpixelModel *persistedModel = [self persistedModelForForegroundColor:foregroundComponent
+                                                                        backgroundColor:backgroundComponent
+                                                                                    key:key];
+            if (persistedModel) {
+                _models[@(key)] = persistedModel;
+                return persistedModel;
+            }
+        }
 
         NSData *imageData = [iTermSubpixelModelBuilder dataForImageWithForegroundColor:simd_make_float4(foregroundComponent, foregroundComponent, foregroundComponent, 1)
                                                                        backgroundColor:simd_make_float4(backgroundComponent, backgroundComponent, backgroundComponent, 1)];
@@ -234,7 +276,7 @@ static NSString *const iTermSubpixelModelString = @"O";
         // on white sample.
         std::map<unsigned char, unsigned char> map;
         const unsigned char *bytes = (const unsigned char *)imageData.bytes;
-        for (auto kv : *_indexToReferenceColor) {
+        for (auto kv : *[self indexToReferenceColor]) {
             auto index = kv.first;
             auto color = kv.second;
 
@@ -252,10 +294,130 @@ static NSString *const iTermSubpixelModelString = @"O";
         }
         //NSLog(@"Generated model for %f/%f\n%@", foregroundComponent, backgroundComponent, subpixelModel.table);
         _models[@(key)] = subpixelModel;
+        if (persist) {
+            [self scheduleSave];
+        }
         return subpixelModel;
     }
 }
 
+#pragma mark - Persistence
+
+// Rendering of the reference glyph can change with the OS, so models are only reused by the same
+// OS and app versions.
+- (NSString *)pathForPersistedModels {
+    NSString *caches = NSSearchPathForDirectoriesInDomains(NSCachesDirectory, NSUserDomainMask, YES).firstObject;
+    NSString *bundleIdentifier = [[NSBundle mainBundle] bundleIdentifier] ?: @"iTerm2";
+    NSString *appVersion = [[NSBundle mainBundle] objectForInfoDictionaryKey:@"CFBundleVersion"] ?: @"";
+    NSString *fingerprint = [NSString stringWithFormat:@"%@|%@",
+                             [[NSProcessInfo processInfo] operatingSystemVersionString],
+                             appVersion];
+    NSString *name = [NSString stringWithFormat:@"SubpixelModels-%@",
+                      [[[fingerprint dataUsingEncoding:NSUTF8StringEncoding] it_sha256] it_hexEncoded]];
+    return [[caches stringByAppendingPathComponent:bundleIdentifier] stringByAppendingPathComponent:name];
+}
+
+- (void)loadPersistedModelsIfNeeded {
+    if (_loadedPersistedModels) {
+        return;
+    }
+    _loadedPersistedModels = YES;
+    NSString *path = [self pathForPersistedModels];
+    NSData *data = [NSData dataWithContentsOfFile:path options:NSDataReadingMappedIfSafe error:nil];
+    if (!data) {
+        return;
+    }
+    iTermSubpixelModelFileHeader header;
+    if (data.length < sizeof(header)) {
+        DLog(@"Discarding truncated subpixel models at %@", path);
+        return;
+    }
+    memcpy(&header, data.bytes, sizeof(header));
+    if (header.magic != iTermSubpixelModelFileMagic ||
+        data.length != sizeof(header) + (size_t)header.count * sizeof(iTermSubpixelModelFileRecord)) {
+        DLog(@"Discarding invalid subpixel models at %@", path);
+        return;
+    }
+    const unsigned char *bytes = (const unsigned char *)data.bytes;
+    for (uint32_t i = 0; i < header.count; i++) {
+        const size_t offset = sizeof(header) + i * sizeof(iTermSubpixelModelFileRecord);
+        uint16_t key;
+        memcpy(&key, bytes + offset + offsetof(iTermSubpixelModelFileRecord, key), sizeof(key));
+        _persistedOffsets[key] = offset;
+    }
+    _persistedData = data;
+    DLog(@"Loaded %@ subpixel models from %@", @(header.count), path);
+}
+
+- (iTermSubpixelModel *)persistedModelForForegroundColor:(float)foregroundComponent
+                                         backgroundColor:(float)backgroundComponent
+                                                     key:(NSUInteger)key {
+    [self loadPersistedModelsIfNeeded];
+    auto it = _persistedOffsets.find(key);
+    if (it == _persistedOffsets.end()) {
+        return nil;
+    }
+    iTermSubpixelModel *model = [[iTermSubpixelModel alloc] initWithForegroundColor:foregroundComponent
+                                                                    backgroundColor:backgroundComponent];
+    const unsigned char *bytes = (const unsigned char *)_persistedData.bytes;
+    memcpy(model.mutableTable.mutableBytes,
+           bytes + it->second + offsetof(iTermSubpixelModelFileRecord, table),
+           sizeof(iTermSubpixelModelFileRecord::table));
+    return model;
+}
+
+// Models are built in bursts (e.g., the whole grid the text renderer needs), so wait for the burst
+// to finish and write them all at once.
+- (void)scheduleSave {
+    if (_saveScheduled) {
+        return;
+    }
+    _saveScheduled = YES;
+    dispatch_after(dispatch_time(DISPATCH_TIME_NOW, (int64_t)(2 * NSEC_PER_SEC)), _saveQueue, ^{
+        [self save];
+    });
+}
+
+// Save queue
+- (void)save {
+    NSMutableData *data = [NSMutableData data];
+    NSString *path;
+    @synchronized (self) {
+        _saveScheduled = NO;
+        path = [self pathForPersistedModels];
+        iTermSubpixelModelFileHeader header = {
+            .magic = iTermSubpixelModelFileMagic,
+            .count = 0
+        };
+        [data appendBytes:&header length:sizeof(header)];
+        [_models enumerateKeysAndObjectsUsingBlock:^(NSNumber * _Nonnull key, iTermSubpixelModel * _Nonnull model, BOOL * _Nonnull stop) {
+            iTermSubpixelModelFileRecord record;
+            record.key = key.unsignedShortValue;
+            memcpy(record.table, model.table.bytes, sizeof(record.table));
+            [data appendBytes:&record length:sizeof(record)];
+        }];
+        header.count = _models.count;
+        // Keep models from the last launch that haven't been needed yet.
+        const unsigned char *bytes = (const unsigned char *)_persistedData.bytes;
+        for (const auto &kv : _persistedOffsets) {
+            if (_models[@(kv.first)]) {
+                continue;
+            }
+            [data appendBytes:bytes + kv.second length:sizeof(iTermSubpixelModelFileRecord)];
+            header.count += 1;
+        }
+        [data replaceBytesInRange:NSMakeRange(0, sizeof(header)) withBytes:&header];
+    }
+    [[NSFileManager defaultManager] createDirectoryAtPath:[path stringByDeletingLastPathComponent]
+                              withIntermediateDirectories:YES
+                                               attributes:nil
+                                                    error:nil];
+    NSError *error = nil;
+    if (![data writeToFile:path options:NSDataWritingAtomic error:&error]) {
+        DLog(@"Failed to write subpixel models to %@: %@", path, error);
+    }
+}
+
 - (void)writeDebugDataToFolder:(NSString *)folder
                foregroundColor:(float)foregroundComponent
                backgroundColor:(float)backgroundComponent {
@@ -31,6 +31,8 @@ NS_CLASS_AVAILABLE(10_11, NA)
 - (void)addSliceWithImage:(NSImage *)image;
 - (BOOL)setSlice:(NSUInteger)slice withImage:(NSImage *)nsimage;
 - (void)setSlice:(NSUInteger)slice withBitmap:(iTermCharacterBitmap *)bitmap;
+// |bytes| is a BGRA bitmap of the texture size.
+- (void)setSlice:(NSUInteger)slice withBytes:(const void *)bytes;
 
 - (void)copyTextureAtIndex:(NSInteger)index
                    toArray:(iTermTextureArray *)destination
@@ -108,6 +108,19 @@
               bytesPerImage:bitmap.size.height * bitmap.size.width * 4];
 }
 
+- (void)setSlice:(NSUInteger)slice withBytes:(const void *)bytes {
+    ITDebugAssert(slice < _arrayLength);
+    MTLOrigin origin = [self offsetForIndex:slice];
+    MTLRegion region = MTLRegionMake2D(origin.x, origin.y, _width, _height);
+
+    [_texture replaceRegion:region
+                mipmapLevel:0
+                      slice:0
+                  withBytes:bytes
+                bytesPerRow:_width * 4
+              bytesPerImage:_height * _width * 4];
+}
+
 - (BOOL)setSlice:(NSUInteger)slice withImage:(NSImage *)nsimage {
     ITDebugAssert(slice < _arrayLength);
     NSBitmapImageRep *bitmapRepresentation = [[NSBitmapImageRep alloc] initWithData:[nsimage TIFFRepresentation]];
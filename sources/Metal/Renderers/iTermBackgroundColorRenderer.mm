@@ -1,14 +1,40 @@
 #import "iTermBackgroundColorRenderer.h"
 
 #import "FutureMethods.h"
+#import "iTermAdvancedSettingsModel.h"
 #import "iTermPIUArray.h"
 #import "iTermTextRenderer.h"
 
+#include <vector>
+
+namespace iTerm2 {
+    // A PIU added for the most recent rows, which the rows below may extend downward.
+    struct BackgroundColorOpenRun {
+        size_t index;  // Index into the PIU array
+        int origin;
+    };
+}
+
 @interface iTermBackgroundColorRendererTransientState()
+// When set, a run that matches one in the same columns of the rows just above extends that PIU
+// downward instead of adding a new one.
+@property (nonatomic) BOOL mergesRows;
 @end
 
 @implementation iTermBackgroundColorRendererTransientState {
     iTerm2::PIUArray<iTermBackgroundColorPIU> _pius;
+    // Used when mergesRows is set. Runs from the most recent call to setColorRLEs:..., in order of
+    // origin, and the row just below them.
+    std::vector<iTerm2::BackgroundColorOpenRun> _openRuns;
+    int _rowBelowOpenRuns;
+}
+
+- (instancetype)initWithConfiguration:(__kindof iTermRenderConfiguration *)configuration {
+    self = [super initWithConfiguration:configuration];
+    if (self) {
+        _rowBelowOpenRuns = -1;
+    }
+    return self;
 }
 
 - (NSUInteger)sizeOfNewPIUBuffer {
@@ -21,6 +47,10 @@
        repeatingRows:(int)repeatingRows {
     vector_float2 cellSize = simd_make_float2(self.cellConfiguration.cellSize.width, self.cellConfiguration.cellSize.height);
     const int height = self.cellConfiguration.gridSize.height;
+    if (_mergesRows) {
+        [self mergeColorRLEs:rles count:count row:row repeatingRows:repeatingRows cellSize:cellSize height:height];
+        return;
+    }
     for (int i = 0; i < count; i++) {
         iTermBackgroundColorPIU &piu = *_pius.get_next();
         piu.color = rles[i].color;
@@ -31,6 +61,48 @@
     }
 }
 
+// Solid panels in TUIs are made of identical runs stacked vertically. Both lists of runs are
+// sorted by origin, so they are matched up in a single pass.
+- (void)mergeColorRLEs:(const iTermMetalBackgroundColorRLE *)rles
+                 count:(size_t)count
+                   row:(int)row
+         repeatingRows:(int)repeatingRows
+              cellSize:(vector_float2)cellSize
+                height:(int)height {
+    const BOOL adjacent = (row == _rowBelowOpenRuns);
+    std::vector<iTerm2::BackgroundColorOpenRun> runs;
+    runs.reserve(count);
+    size_t j = 0;
+    for (int i = 0; i < count; i++) {
+        const iTermMetalBackgroundColorRLE &rle = rles[i];
+        const float y = cellSize.y * (height - row - repeatingRows);
+        if (adjacent) {
+            while (j < _openRuns.size() && _openRuns[j].origin < rle.origin) {
+                j++;
+            }
+            if (j < _openRuns.size() && _openRuns[j].origin == rle.origin) {
+                iTermBackgroundColorPIU &above = _pius.get(_openRuns[j].index);
+                if (above.runLength == rle.count &&
+                    simd_equal(above.color, rle.color) &&
+                    above.numRows + repeatingRows <= USHRT_MAX) {
+                    above.numRows += repeatingRows;
+                    above.offset.y = y;
+                    runs.push_back(_openRuns[j]);
+                    continue;
+                }
+            }
+        }
+        runs.push_back({ _pius.size(), rle.origin });
+        iTermBackgroundColorPIU &piu = *_pius.get_next();
+        piu.color = rle.color;
+        piu.runLength = rle.count;
+        piu.numRows = repeatingRows;
+        piu.offset = simd_make_float2(cellSize.x * (float)rle.origin, y);
+    }
+    _openRuns.swap(runs);
+    _rowBelowOpenRuns = row + repeatingRows;
+}
+
 - (void)enumerateSegments:(void (^)(const iTermBackgroundColorPIU *, size_t))block {
     const int n = _pius.get_number_of_segments();
     for (int segment = 0; segment < n; segment++) {
@@ -126,6 +198,7 @@
 }
 
 - (void)initializeTransientState:(iTermBackgroundColorRendererTransientState *)tState {
+    tState.mergesRows = [iTermAdvancedSettingsModel mergeBackgroundColorRunsAcrossRows];
     tState.vertexBuffer = [[self rendererForConfiguration:tState.cellConfiguration] newQuadOfSize:tState.cellConfiguration.cellSize
                                                                                       poolContext:tState.poolContext];
     tState.vertexBuffer.label = @"Vertices";
@@ -7,6 +7,9 @@
 #import "iTermPreferences.h"
 #import "iTermShaderTypes.h"
 #import "iTermSharedImageStore.h"
+#import "NSObject+iTerm.h"
+
+static char iTermBackgroundImageRendererTexturesKey;
 
 NS_ASSUME_NONNULL_BEGIN
 
@@ -92,7 +95,7 @@ NS_ASSUME_NONNULL_BEGIN
            color:(vector_float4)defaultBackgroundColor
          context:(nullable iTermMetalBufferPoolContext *)context {
     if (image != _image) {
-        _texture = image ? [_metalRenderer textureFromImage:image context:context] : nil;
+        _texture = image ? [self textureForImage:image context:context] : nil;
     }
     _frame = frame;
     _color = defaultBackgroundColor;
@@ -101,6 +104,25 @@ NS_ASSUME_NONNULL_BEGIN
     _mode = mode;
 }
 
+// iTermSharedImageStore gives every session using the same file the same image, so sessions can
+// share its texture too, rather than each holding a copy of what may be a very large wallpaper. The
+// textures are never modified after they're made and they go away with the image.
+- (nullable id<MTLTexture>)textureForImage:(iTermImageWrapper *)image
+                                   context:(nullable iTermMetalBufferPoolContext *)context {
+    NSMutableDictionary<NSNumber *, id<MTLTexture>> *textures = [image it_associatedObjectForKey:&iTermBackgroundImageRendererTexturesKey];
+    if (!textures) {
+        textures = [NSMutableDictionary dictionary];
+        [image it_setAssociatedObject:textures forKey:&iTermBackgroundImageRendererTexturesKey];
+    }
+    NSNumber *deviceID = @(_metalRenderer.device.registryID);
+    id<MTLTexture> texture = textures[deviceID];
+    if (!texture) {
+        texture = [_metalRenderer textureFromImage:image context:context];
+        textures[deviceID] = texture;
+    }
+    return texture;
+}
+
 #if ENABLE_TRANSPARENT_METAL_WINDOWS
 - (id<MTLBuffer>)alphaBufferWithValue:(float)value
                           poolContext:(iTermMetalBufferPoolContext *)poolContext {
@@ -7,7 +7,10 @@
 
 #import "iTermImageRenderer.h"
 
+#import "DebugLogging.h"
+#import "iTermAdvancedSettingsModel.h"
 #import "iTermImageInfo.h"
+#import "iTermMetalBufferPool.h"
 #import "iTermSharedImageStore.h"
 #import "iTermTexture.h"
 #import "NSArray+iTerm.h"
@@ -15,6 +18,12 @@
 
 static NSString *const iTermImageRendererTextureMetadataKeyImageMissing = @"iTermImageRendererTextureMetadataKeyImageMissing";
 
+// Frame number used in the texture key of an animated image whose frames are all in one texture array.
+static const NSUInteger iTermImageRendererAllFrames = 0xffff;
+
+// Animated images with more frames than this get a texture per frame instead of a texture array.
+static const int iTermImageRendererMaximumNumberOfFramesInArray = 256;
+
 @implementation iTermMetalImageRun
 
 - (NSString *)debugDescription {
@@ -33,6 +42,8 @@ static NSString *const iTermImageRendererTextureMetadataKeyImageMissing = @"iTer
 @interface iTermImageRendererTransientState()
 @property (nonatomic) iTermMetalCellRenderer *cellRenderer;
 @property (nonatomic) NSTimeInterval timestamp;
+// Non-nil if animated images should keep all their frames in a texture array.
+@property (nonatomic, strong) id<MTLRenderPipelineState> arrayPipelineState;
 // Counts the number of times each texture key is in use. Shared by all transient states.
 @property (nonatomic, strong) NSCountedSet<NSNumber *> *counts;
 @property (nonatomic, strong) NSMutableDictionary<NSNumber *, id<MTLTexture>> *textures;
@@ -103,13 +114,29 @@ static NSString *const iTermImageRendererTextureMetadataKeyImageMissing = @"iTer
     [_counts addObject:key];
 }
 
+- (BOOL)shouldUseTextureArrayForRun:(iTermMetalImageRun *)run {
+    return (_arrayPipelineState != nil &&
+            run.imageInfo.animated &&
+            run.imageInfo.numberOfFrames <= iTermImageRendererMaximumNumberOfFramesInArray);
+}
+
 - (id)keyForRun:(iTermMetalImageRun *)run {
     NSUInteger temp = run.code;
+    if ([self shouldUseTextureArrayForRun:run]) {
+        // All frames share one texture so changing frames doesn't change the key.
+        return @(temp << 16 | iTermImageRendererAllFrames);
+    }
     int frame = ([run.imageInfo frameForTimestamp:_timestamp] & 0xffff);
     return @(temp << 16 | frame);
 }
 
 - (id<MTLTexture>)newTextureForImageRun:(iTermMetalImageRun *)run {
+    if ([self shouldUseTextureArrayForRun:run]) {
+        id<MTLTexture> texture = [self newTextureArrayForImageRun:run];
+        if (texture) {
+            return texture;
+        }
+    }
     CGSize cellSize = self.cellConfiguration.cellSize;
     const CGFloat scale = self.configuration.scale;
     cellSize.width /= scale;
@@ -139,7 +166,31 @@ static NSString *const iTermImageRendererTextureMetadataKeyImageMissing = @"iTer
     return texture;
 }
 
-- (void)enumerateDraws:(void (^)(NSNumber *, id<MTLBuffer>, id<MTLTexture>))block {
+// Renders every frame of an animated image once so playback only has to pick a slice.
+- (id<MTLTexture>)newTextureArrayForImageRun:(iTermMetalImageRun *)run {
+    CGSize cellSize = self.cellConfiguration.cellSize;
+    const CGFloat scale = self.configuration.scale;
+    cellSize.width /= scale;
+    cellSize.height /= scale;
+    const int count = run.imageInfo.numberOfFrames;
+    NSMutableArray<iTermImageWrapper *> *frames = [NSMutableArray arrayWithCapacity:count];
+    for (int i = 0; i < count; i++) {
+        NSImage *image = [run.imageInfo imageForFrame:i cellSize:cellSize scale:scale];
+        if (!image) {
+            return nil;
+        }
+        [frames addObject:[iTermImageWrapper withImage:image]];
+    }
+    id<MTLTexture> texture = [_cellRenderer textureArrayFromImages:frames
+                                                           context:self.poolContext];
+    if (texture) {
+        DLog(@"Made texture array with %@ frames for %@", @(count), run.imageInfo.uniqueIdentifier);
+        [_foundImageUniqueIdentifiers addObject:run.imageInfo.uniqueIdentifier];
+    }
+    return texture;
+}
+
+- (void)enumerateDraws:(void (^)(NSNumber *, id<MTLBuffer>, id<MTLTexture>, int))block {
     const CGSize cellSize = self.cellConfiguration.cellSize;
     const CGPoint offset = CGPointMake(self.margins.left, self.margins.bottom);
     const CGFloat height = self.configuration.viewportSize.y;
@@ -167,7 +218,7 @@ static NSString *const iTermImageRendererTextureMetadataKeyImageMissing = @"iTer
                                                               textureFrame:textureFrame
                                                                poolContext:self.poolContext];
 
-        block(key, vertexBuffer, texture);
+        block(key, vertexBuffer, texture, [run.imageInfo frameForTimestamp:self.timestamp]);
     }];
 }
 
@@ -175,6 +226,9 @@ static NSString *const iTermImageRendererTextureMetadataKeyImageMissing = @"iTer
 
 @implementation iTermImageRenderer {
     iTermMetalCellRenderer *_cellRenderer;
+    // Draws animated images from texture arrays. Nil unless enabled in advanced settings.
+    iTermMetalCellRenderer *_arrayCellRenderer;
+    iTermMetalBufferPool *_framePool;
     NSMutableDictionary<NSNumber *, id<MTLTexture>> *_textures;
     NSCountedSet<NSNumber *> *_counts;
 
@@ -197,6 +251,15 @@ static NSString *const iTermImageRendererTextureMetadataKeyImageMissing = @"iTer
                                                               blending:[iTermMetalBlending compositeSourceOver]
                                                         piuElementSize:0
                                                    transientStateClass:[iTermImageRendererTransientState class]];
+        if ([iTermAdvancedSettingsModel animatedImageTextureArrays]) {
+            _arrayCellRenderer = [[iTermMetalCellRenderer alloc] initWithDevice:device
+                                                             vertexFunctionName:@"iTermImageVertexShader"
+                                                           fragmentFunctionName:@"iTermImageArrayFragmentShader"
+                                                                       blending:[iTermMetalBlending compositeSourceOver]
+                                                                 piuElementSize:0
+                                                            transientStateClass:[iTermImageRendererTransientState class]];
+            _framePool = [[iTermMetalBufferPool alloc] initWithDevice:device bufferSize:sizeof(uint32_t)];
+        }
         _textures = [NSMutableDictionary dictionary];
         _counts = [[NSCountedSet alloc] init];
         _onNotice = [NSMutableSet set];
@@ -225,6 +288,7 @@ static NSString *const iTermImageRendererTextureMetadataKeyImageMissing = @"iTer
     tState.cellRenderer = _cellRenderer;
     tState.timestamp = [NSDate timeIntervalSinceReferenceDate];
     tState.textures = _textures;
+    tState.arrayPipelineState = [_arrayCellRenderer pipelineState];
 }
 
 - (void)drawWithFrameData:(iTermMetalFrameData *)frameData
@@ -232,15 +296,32 @@ static NSString *const iTermImageRendererTextureMetadataKeyImageMissing = @"iTer
     iTermImageRendererTransientState *tState = transientState;
 
     NSMutableSet<NSNumber *> *texturesToRemove = [_onNotice mutableCopy];
-    [tState enumerateDraws:^(id key, id<MTLBuffer> vertexBuffer, id<MTLTexture> texture) {
+    id<MTLRenderPipelineState> pipelineState = tState.pipelineState;
+    [tState enumerateDraws:^(id key, id<MTLBuffer> vertexBuffer, id<MTLTexture> texture, int frame) {
         [texturesToRemove removeObject:key];
-        [self->_cellRenderer drawWithTransientState:tState
-                                      renderEncoder:frameData.renderEncoder
-                                   numberOfVertices:6
-                                       numberOfPIUs:0
-                                      vertexBuffers:@{ @(iTermVertexInputIndexVertices): vertexBuffer }
-                                    fragmentBuffers:@{}
-                                           textures:@{ @(iTermTextureIndexPrimary): texture } ];
+        if (texture.textureType == MTLTextureType2DArray) {
+            const uint32_t slice = frame;
+            id<MTLBuffer> frameBuffer = [self->_framePool requestBufferFromContext:tState.poolContext
+                                                                         withBytes:&slice
+                                                                    checkIfChanged:YES];
+            tState.pipelineState = tState.arrayPipelineState;
+            [self->_arrayCellRenderer drawWithTransientState:tState
+                                               renderEncoder:frameData.renderEncoder
+                                            numberOfVertices:6
+                                                numberOfPIUs:0
+                                               vertexBuffers:@{ @(iTermVertexInputIndexVertices): vertexBuffer }
+                                             fragmentBuffers:@{ @(iTermFragmentBufferIndexImageFrame): frameBuffer }
+                                                    textures:@{ @(iTermTextureIndexPrimary): texture } ];
+            tState.pipelineState = pipelineState;
+        } else {
+            [self->_cellRenderer drawWithTransientState:tState
+                                          renderEncoder:frameData.renderEncoder
+                                       numberOfVertices:6
+                                           numberOfPIUs:0
+                                          vertexBuffers:@{ @(iTermVertexInputIndexVertices): vertexBuffer }
+                                        fragmentBuffers:@{}
+                                               textures:@{ @(iTermTextureIndexPrimary): texture } ];
+        }
         [self->_counts removeObject:key];
         if ([self->_counts countForObject:key] == 0) {
             [self->_onNotice addObject:key];
@@ -18,6 +18,10 @@ NS_CLASS_AVAILABLE(10_11, NA)
       creationIdentifier:(id)creationIdentifier
                 creation:(NSDictionary<NSNumber *, iTermCharacterBitmap *> *(^)(char, iTermASCIITextureAttributes))creation;
 
+// Bytes of GPU memory used by glyph textures. These may be shared with other sessions that have
+// the same font, so don't add them up across sessions.
+- (NSUInteger)glyphTextureBytes;
+
 @end
 
 NS_ASSUME_NONNULL_END
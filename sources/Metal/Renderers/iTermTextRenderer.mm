@@ -71,6 +71,9 @@ static BOOL gMonochromeText;
     iTermASCIITextureGroup *_asciiTextureGroup;
 
     iTermTexturePageCollectionSharedPointer *_texturePageCollectionSharedPointer;
+    // Identifies the fonts and metrics that glyphs are rasterized with, for sharing texture pages
+    // with other sessions.
+    id<NSCopying> _glyphIdentifier;
     NSMutableArray<iTermTextRendererCachedQuad *> *_quadCache;
     CGSize _cellSizeForQuadCache;
 
@@ -263,6 +266,10 @@ static BOOL gMonochromeText;
             _texturePageCollectionSharedPointer = nil;
         }
     }
+    if ([iTermAdvancedSettingsModel shareGlyphAtlasAcrossSessions] && _glyphIdentifier) {
+        // This also switches collections when the fonts change.
+        _texturePageCollectionSharedPointer = [self sharedTexturePageCollectionWithCellSize:currentSize];
+    }
     if (!_texturePageCollectionSharedPointer) {
         iTerm2::TexturePageCollection *collection = new iTerm2::TexturePageCollection(_cellRenderer.device,
                                                                                       simd_make_uint2(currentSize.width, currentSize.height),
@@ -276,6 +283,15 @@ static BOOL gMonochromeText;
     tState.texturePageCollectionSharedPointer = _texturePageCollectionSharedPointer;
     tState.numberOfCells = tState.cellConfiguration.gridSize.width * tState.cellConfiguration.gridSize.height;
     tState.asciiOffset = _asciiOffset;
+    tState.rasterizesAsynchronously = [iTermAdvancedSettingsModel rasterizeGlyphsAsynchronously];
+}
+
+- (iTermTexturePageCollectionSharedPointer *)sharedTexturePageCollectionWithCellSize:(CGSize)cellSize {
+    return [iTermTexturePageCollectionSharedPointer sharedPointerForDevice:_cellRenderer.device
+                                                                  cellSize:simd_make_uint2(cellSize.width, cellSize.height)
+                                                              pageCapacity:iTermTextAtlasCapacity
+                                                      maximumNumberOfPages:iTermTextRendererMaximumNumberOfTexturePages
+                                                                identifier:_glyphIdentifier];
 }
 
 - (id<MTLBuffer>)quadOfSize:(CGSize)size
@@ -538,9 +554,18 @@ static NSString *const VertexFunctionName(const BOOL &underlined,
     if (![replacement isEqual:_asciiTextureGroup]) {
         _asciiTextureGroup = replacement;
     }
+    _glyphIdentifier = @[ descriptor.dictionaryValue, creationIdentifier ];
     _asciiOffset = asciiOffset;
 }
 
+- (NSUInteger)glyphTextureBytes {
+    NSUInteger result = _asciiTextureGroup.allocatedSize;
+    if (_texturePageCollectionSharedPointer) {
+        result += _texturePageCollectionSharedPointer.object->get_allocated_size();
+    }
+    return result;
+}
+
 - (void)writeDebugInfoToFolder:(NSURL *)folder {
     if (iTermTextIsMonochrome()) {
         return;
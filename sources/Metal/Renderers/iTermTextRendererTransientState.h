@@ -23,6 +23,11 @@ NS_CLASS_AVAILABLE(10_11, NA)
 @property (nonatomic) iTermMetalUnderlineDescriptor asciiUnderlineDescriptor;
 @property (nonatomic) iTermMetalUnderlineDescriptor nonAsciiUnderlineDescriptor;
 @property (nonatomic) iTermMetalUnderlineDescriptor strikethroughUnderlineDescriptor;
+// When set, glyphs missing from the texture pages are not rasterized while the frame is being
+// prepared. They draw as empty cells and are remembered so that
+// -rasterizePendingGlyphsWithCreation: can add them once the frame is done.
+@property (nonatomic) BOOL rasterizesAsynchronously;
+@property (nonatomic, readonly) BOOL hasPendingGlyphs;
 
 - (void)setGlyphKeysData:(iTermGlyphKeyData*)glyphKeysData
                    count:(int)count
@@ -35,6 +40,17 @@ NS_CLASS_AVAILABLE(10_11, NA)
 - (void)willDraw;
 - (void)didComplete;
 
+// Adds the glyphs that were missing while the frame was prepared to the texture pages. Returns
+// whether any were added.
+- (BOOL)rasterizePendingGlyphsWithCreation:(NSDictionary<NSNumber *, iTermCharacterBitmap *> *(^)(iTermMetalGlyphKey *glyphKey, BOOL *emoji))creation;
+
+// Returns YES the first time it is called for the current texture pages, in which case the caller
+// should add the box-drawing glyphs with -addPendingGlyphKey: so they are rasterized in one batch.
+- (BOOL)beginAddingBoxDrawingGlyphs;
+
+// Queues a glyph for the next call to -rasterizePendingGlyphsWithCreation:.
+- (void)addPendingGlyphKey:(const iTermMetalGlyphKey *)glyphKey;
+
 @end
 
 NS_ASSUME_NONNULL_END
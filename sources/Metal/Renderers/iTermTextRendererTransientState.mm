@@ -15,6 +15,7 @@
 #import "NSMutableData+iTerm.h"
 
 #include <map>
+#include <unordered_map>
 
 const vector_float4 iTermIMEColor = simd_make_float4(1, 1, 0, 1);
 const vector_float4 iTermAnnotationUnderlineColor = simd_make_float4(1, 1, 0, 1);
@@ -43,9 +44,17 @@ static const size_t iTermNumberOfPIUArrays = iTermASCIITextureAttributesMax * 2;
     std::map<iTerm2::TexturePage *, iTerm2::PIUArray<iTermTextPIU> *> _pius[iTermPIUArraySize];
 
     iTermPreciseTimerStats _stats[iTermTextRendererStatCount];
+    BOOL _usingTexturePageCollection;
+
+    // Glyphs that were missing while rasterizing asynchronously.
+    std::unordered_map<iTerm2::GlyphKey, iTermMetalGlyphKey> _pendingGlyphs;
 }
 
 - (void)dealloc {
+    if (_usingTexturePageCollection) {
+        // Frame was abandoned without completing.
+        [_texturePageCollectionSharedPointer endUseAndPrune];
+    }
     for (size_t i = 0; i < iTermPIUArraySize; i++) {
         for (auto it = _pius[i].begin(); it != _pius[i].end(); it++) {
             delete it->second;
@@ -53,6 +62,15 @@ static const size_t iTermNumberOfPIUArrays = iTermASCIITextureAttributesMax * 2;
     }
 }
 
+- (void)setTexturePageCollectionSharedPointer:(iTermTexturePageCollectionSharedPointer *)texturePageCollectionSharedPointer {
+    if (_usingTexturePageCollection) {
+        [_texturePageCollectionSharedPointer endUseAndPrune];
+    }
+    _texturePageCollectionSharedPointer = texturePageCollectionSharedPointer;
+    [texturePageCollectionSharedPointer beginUse];
+    _usingTexturePageCollection = (texturePageCollectionSharedPointer != nil);
+}
+
 + (NSString *)formatTextPIU:(iTermTextPIU)a {
     return [NSString stringWithFormat:
             @"offset=(%@, %@) "
@@ -545,12 +563,17 @@ static inline BOOL GlyphKeyCanTakeASCIIFastPath(const iTermMetalGlyphKey &glyphK
         } else {
             // Non-ASCII slower path
             const iTerm2::GlyphKey glyphKey(&glyphKeys[x]);
+            [_texturePageCollectionSharedPointer lock];
             std::vector<const iTerm2::GlyphEntry *> *entries = _texturePageCollectionSharedPointer.object->find(glyphKey);
-            if (!entries) {
+            if (!entries && !_rasterizesAsynchronously) {
                 entries = _texturePageCollectionSharedPointer.object->add(x, glyphKey, context, creation);
-                if (!entries) {
-                    continue;
+            }
+            [_texturePageCollectionSharedPointer unlock];
+            if (!entries) {
+                if (_rasterizesAsynchronously) {
+                    _pendingGlyphs.emplace(glyphKey, glyphKeys[x]);
                 }
+                continue;
             } else if (entries->empty()) {
                 continue;
             }
@@ -605,10 +628,48 @@ static inline BOOL GlyphKeyCanTakeASCIIFastPath(const iTermMetalGlyphKey &glyphK
 
 - (void)didComplete {
     DLog(@"BEGIN didComplete for %@", self);
-    _texturePageCollectionSharedPointer.object->prune_if_needed();  // The static analyzer wrongly says this is a use-after-free.
+    if (_usingTexturePageCollection) {
+        _usingTexturePageCollection = NO;
+        [_texturePageCollectionSharedPointer endUseAndPrune];
+    }
     DLog(@"END didComplete");
 }
 
+- (BOOL)hasPendingGlyphs {
+    return !_pendingGlyphs.empty();
+}
+
+- (BOOL)beginAddingBoxDrawingGlyphs {
+    [_texturePageCollectionSharedPointer lock];
+    const BOOL result = !_texturePageCollectionSharedPointer.hasBoxDrawingGlyphs;
+    _texturePageCollectionSharedPointer.hasBoxDrawingGlyphs = YES;
+    [_texturePageCollectionSharedPointer unlock];
+    return result;
+}
+
+- (void)addPendingGlyphKey:(const iTermMetalGlyphKey *)glyphKey {
+    const iTerm2::GlyphKey key(glyphKey);
+    _pendingGlyphs.emplace(key, *glyphKey);
+}
+
+- (BOOL)rasterizePendingGlyphsWithCreation:(NSDictionary<NSNumber *, iTermCharacterBitmap *> *(^)(iTermMetalGlyphKey *glyphKey, BOOL *emoji))creation {
+    BOOL added = NO;
+    for (auto &pair : _pendingGlyphs) {
+        iTermMetalGlyphKey *metalGlyphKey = &pair.second;
+        [_texturePageCollectionSharedPointer lock];
+        // A later frame may have found the same glyph missing and added it already.
+        if (!_texturePageCollectionSharedPointer.object->find(pair.first)) {
+            _texturePageCollectionSharedPointer.object->add(0, pair.first, nil, ^NSDictionary<NSNumber *, iTermCharacterBitmap *> *(int x, BOOL *emoji) {
+                return creation(metalGlyphKey, emoji);
+            });
+            added = YES;
+        }
+        [_texturePageCollectionSharedPointer unlock];
+    }
+    _pendingGlyphs.clear();
+    return added;
+}
+
 - (nonnull NSMutableData *)modelData  {
     if (_modelData == nil) {
         _modelData = [[NSMutableData alloc] initWithUninitializedLength:sizeof(iTermTextPIU) * self.cellConfiguration.gridSize.width * self.cellConfiguration.gridSize.height];
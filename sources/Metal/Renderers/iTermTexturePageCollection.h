@@ -183,6 +183,17 @@ namespace iTerm2 {
             return _allPages.size() > _maximumNumberOfPages;
         }
 
+        // Bytes of GPU memory used by all pages.
+        NSUInteger get_allocated_size() const {
+            NSUInteger result = 0;
+            if (@available(macOS 10.13, *)) {
+                for (auto page : _allPages) {
+                    result += page->get_texture().allocatedSize;
+                }
+            }
+            return result;
+        }
+
     private:
         TexturePageCollection &operator=(const TexturePageCollection &);
         TexturePageCollection(const TexturePageCollection &);
@@ -199,8 +210,30 @@ namespace iTerm2 {
 
 @interface iTermTexturePageCollectionSharedPointer : NSObject
 @property (nonatomic, readonly) iTerm2::TexturePageCollection *object;
+// Set once the box-drawing glyphs have been queued for rasterization into this collection. Only
+// access while holding the lock.
+@property (nonatomic) BOOL hasBoxDrawingGlyphs;
+
+// Returns a collection shared by every caller that passes the same device, cell size, and
+// identifier for as long as any of them holds a reference to it. The identifier must capture
+// everything that affects how a glyph is rasterized, such as fonts and scale. Calls to a shared
+// collection's object may come from several Metal drivers' queues and must be made while holding
+// the lock.
++ (instancetype)sharedPointerForDevice:(id<MTLDevice>)device
+                              cellSize:(vector_uint2)cellSize
+                          pageCapacity:(int)pageCapacity
+                  maximumNumberOfPages:(int)maximumNumberOfPages
+                            identifier:(id<NSCopying>)identifier;
 
 - (instancetype)initWithObject:(iTerm2::TexturePageCollection *)object;
 - (instancetype)init NS_UNAVAILABLE;
 
+- (void)lock;
+- (void)unlock;
+
+// Brackets a frame's use of the collection's glyph entries. Pruning could free a page another
+// frame is drawing from, so for a shared collection it waits until no frame is using it.
+- (void)beginUse;
+- (void)endUseAndPrune;
+
 @end
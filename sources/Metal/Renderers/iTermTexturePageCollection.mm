@@ -7,16 +7,73 @@
 
 #import "iTermTexturePageCollection.h"
 
-@implementation iTermTexturePageCollectionSharedPointer
+#import <os/lock.h>
+
+@implementation iTermTexturePageCollectionSharedPointer {
+    os_unfair_lock _lock;
+    BOOL _shared;
+    NSInteger _numberOfUsers;
+}
+
++ (instancetype)sharedPointerForDevice:(id<MTLDevice>)device
+                              cellSize:(vector_uint2)cellSize
+                          pageCapacity:(int)pageCapacity
+                  maximumNumberOfPages:(int)maximumNumberOfPages
+                            identifier:(id<NSCopying>)identifier {
+    static NSMapTable<NSArray *, iTermTexturePageCollectionSharedPointer *> *registry;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        registry = [NSMapTable strongToWeakObjectsMapTable];
+    });
+    NSArray *key = @[ device, @(cellSize.x), @(cellSize.y), identifier ];
+    @synchronized(registry) {
+        iTermTexturePageCollectionSharedPointer *sharedPointer = [registry objectForKey:key];
+        if (sharedPointer) {
+            return sharedPointer;
+        }
+        iTerm2::TexturePageCollection *collection = new iTerm2::TexturePageCollection(device,
+                                                                                      cellSize,
+                                                                                      pageCapacity,
+                                                                                      maximumNumberOfPages);
+        sharedPointer = [[iTermTexturePageCollectionSharedPointer alloc] initWithObject:collection];
+        sharedPointer->_shared = YES;
+        [registry setObject:sharedPointer forKey:key];
+        return sharedPointer;
+    }
+}
 
 - (instancetype)initWithObject:(iTerm2::TexturePageCollection *)object {
     self = [super init];
     if (self) {
         _object = object;
+        _lock = OS_UNFAIR_LOCK_INIT;
     }
     return self;
 }
 
+- (void)lock {
+    os_unfair_lock_lock(&_lock);
+}
+
+- (void)unlock {
+    os_unfair_lock_unlock(&_lock);
+}
+
+- (void)beginUse {
+    [self lock];
+    _numberOfUsers += 1;
+    [self unlock];
+}
+
+- (void)endUseAndPrune {
+    [self lock];
+    _numberOfUsers -= 1;
+    if (!_shared || _numberOfUsers == 0) {
+        _object->prune_if_needed();
+    }
+    [self unlock];
+}
+
 - (void)dealloc {
     if (_object) {
         delete _object;
@@ -17,7 +17,9 @@
 @property (nonatomic) CGFloat width;
 @property (nonatomic) vector_float4 textColor;
 @property (nonatomic) vector_float4 backgroundColor;
-@property (nonatomic) NSTimeInterval date;
+@property (nonatomic) CGFloat scale;
+// The formatted timestamp, or nil for a repeat of the row above.
+@property (nonatomic, copy) NSString *string;
 @end
 
 @implementation iTermTimestampKey
@@ -34,7 +36,16 @@
             _backgroundColor.x == otherKey->_backgroundColor.x &&
             _backgroundColor.y == otherKey->_backgroundColor.y &&
             _backgroundColor.z == otherKey->_backgroundColor.z &&
-            _date == otherKey->_date);
+            _scale == otherKey->_scale &&
+            (_string == otherKey->_string || [_string isEqualToString:otherKey->_string]));
+}
+
+// Without this NSCache compares keys by address, so a texture was never reused.
+- (NSUInteger)hash {
+    return (_string.hash ^
+            [@(_width) hash] ^
+            ([@(_textColor.x + _textColor.y * 3 + _textColor.z * 7) hash] << 1) ^
+            ([@(_backgroundColor.x + _backgroundColor.y * 3 + _backgroundColor.z * 7) hash] << 2));
 }
 
 @end
@@ -101,7 +112,8 @@
         key.width = visibleWidth;
         key.textColor = textColor;
         key.backgroundColor = backgroundColor;
-        key.date = [self->_drawHelper rowIsRepeat:idx] ? -1 : round(date.timeIntervalSinceReferenceDate);
+        key.scale = scale;
+        key.string = [self->_drawHelper rowIsRepeat:idx] ? nil : [self->_drawHelper stringForRow:idx];
         block(idx,
               key,
               NSMakeRect(self.configuration.viewportSize.x / scale - visibleWidth,
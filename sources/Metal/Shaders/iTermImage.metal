@@ -36,3 +36,14 @@ iTermImageFragmentShader(iTermImageVertexFunctionOutput in [[stage_in]],
 
     return texture.sample(textureSampler, in.textureCoordinate);
 }
+
+// Used for animated images, which keep all their frames in one texture so playback needs no uploads.
+fragment float4
+iTermImageArrayFragmentShader(iTermImageVertexFunctionOutput in [[stage_in]],
+                              texture2d_array<float> texture [[ texture(iTermTextureIndexPrimary) ]],
+                              constant uint *frame [[ buffer(iTermFragmentBufferIndexImageFrame) ]]) {
+    constexpr sampler textureSampler (mag_filter::linear,
+                                      min_filter::linear);
+
+    return texture.sample(textureSampler, in.textureCoordinate, *frame);
+}
@@ -30,6 +30,7 @@ typedef enum {
     iTermFragmentBufferIndexFullScreenFlashColor = 4, // Points at a float4
     iTermFragmentInputIndexAlpha = 5,  // float4 pointer. Used by transparent windows on 10.14
     iTermFragmentInputIndexColor = 6,  // float4. Gives color for letterboxes/pillarboxes
+    iTermFragmentBufferIndexImageFrame = 7,  // Points at a single uint giving the slice of a texture array to sample
 } iTermFragmentBufferIndex;
 
 // AND with mask to remove strikethrough bit
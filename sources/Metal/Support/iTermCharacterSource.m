@@ -304,7 +304,8 @@ static const CGFloat iTermCharacterSourceAliasedFakeBoldShiftPoints = 1;
 
         CGContextRetain(context);
 
-        for (int i = 0; i < 4; i++) {
+        // Box-drawing characters are drawn with Bezier paths so they don't need to be typeset.
+        for (int i = 0; i < 4 && !boxDrawing; i++) {
             _attributedStrings[i] = [[NSAttributedString alloc] initWithString:string attributes:[self attributesForIteration:i]];
             DLog(@"Create lineref %@ with attributed string %@", @(i), _attributedStrings[i]);
             _lineRefs[i] = CTLineCreateWithAttributedString((CFAttributedStringRef)_attributedStrings[i]);
@@ -580,14 +581,23 @@ static const CGFloat iTermCharacterSourceAliasedFakeBoldShiftPoints = 1;
 - (void)drawWithOffset:(CGPoint)offset iteration:(NSInteger)iteration {
     CGAffineTransform textMatrix = CGContextGetTextMatrix(_context);
     CGContextSaveGState(_context);
-    CFArrayRef runs = CTLineGetGlyphRuns(_lineRefs[iteration]);
     const CGFloat skew = _fakeItalic ? iTermFakeItalicSkew : 0;
     const CGFloat ty = offset.y - _descriptor.baselineOffset * _descriptor.scale;
 
-    [self drawRuns:runs
-          atOffset:CGPointMake(offset.x, ty)
-              skew:skew
-         iteration:iteration];
+    if (_boxDrawing) {
+        [self prepareToDrawRunAtIteration:iteration
+                                   offset:CGPointMake(offset.x, ty)
+                                  runFont:(__bridge CTFontRef)_font
+                                     skew:skew
+                              initialized:NO];
+        [self drawBoxAtOffset:CGPointMake(offset.x, ty) iteration:iteration];
+    } else {
+        CFArrayRef runs = CTLineGetGlyphRuns(_lineRefs[iteration]);
+        [self drawRuns:runs
+              atOffset:CGPointMake(offset.x, ty)
+                  skew:skew
+             iteration:iteration];
+    }
     _haveDrawn = YES;
     const NSUInteger length = CGBitmapContextGetBytesPerRow(_context) * CGBitmapContextGetHeight(_context);
     NSMutableData *data = [NSMutableData dataWithBytes:CGBitmapContextGetData(_context)
@@ -74,6 +74,10 @@ NS_CLASS_AVAILABLE(10_11, NA)
 @property (nonatomic, readonly) BOOL thinStrokesForTimestamps;
 @property (nonatomic, readonly) BOOL asciiAntiAliased;
 @property (nonatomic, readonly) NSFont *timestampFont;
+// Time of the earliest keystroke or output that this frame is the first to reflect, or 0 if
+// there was none. Only recorded when latency measurement is enabled.
+@property (nonatomic, readonly) NSTimeInterval keystrokeTimestamp;
+@property (nonatomic, readonly) NSTimeInterval outputTimestamp;
 
 // Initialize sketchPtr to 0. The number of set bits estimates the unique number of color combinations.
 - (void)metalGetGlyphKeys:(iTermMetalGlyphKey *)glyphKeys
@@ -98,6 +102,11 @@ NS_CLASS_AVAILABLE(10_11, NA)
                                                                                 scale:(CGFloat)scale
                                                                                 emoji:(BOOL *)emoji;
 
+// Calls block with a glyph key for each character in the box-drawing block (U+2500-U+259F) and
+// the Powerline range that is drawn with Bezier paths, once for each thin-strokes value a cell
+// could use.
+- (void)metalEnumerateBoxDrawingGlyphKeys:(void (^ NS_NOESCAPE)(iTermMetalGlyphKey *glyphKey))block;
+
 // Returns the background image or nil. If there's a background image, fill in mode.
 - (iTermImageWrapper *)metalBackgroundImageGetMode:(nullable iTermBackgroundImageMode *)mode;
 
@@ -164,6 +173,14 @@ cellSizeWithoutSpacing:(CGSize)cellSizeWithoutSpacing
 // The arg to completion is YES on success and NO if the draw was aborted for lack of resources.
 - (void)drawAsynchronouslyInView:(MTKView *)view completion:(void (^)(BOOL))completion;
 
+// Calls |completion| on the main queue with histograms of keystroke-to-present,
+// output-to-present, GPU, and per-renderer encode times. See iTermMetalLatencyStats.
+- (void)getLatencyStatsWithCompletion:(void (^)(NSDictionary<NSString *, id> *stats))completion;
+
+// Calls |completion| on the main queue with the bytes of GPU memory used by glyph textures. See
+// -[iTermTextRenderer glyphTextureBytes].
+- (void)getGlyphTextureBytesWithCompletion:(void (^)(NSUInteger bytes))completion;
+
 @end
 
 NS_ASSUME_NONNULL_END
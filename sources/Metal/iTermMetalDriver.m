@@ -24,7 +24,11 @@
 #import "iTermMetalDebugInfo.h"
 #import "iTermMetalFrameData.h"
 #import "iTermMarkRenderer.h"
+#import "iTermMetalDamageTracker.h"
+#import "iTermMetalLatencyStats.h"
 #import "iTermMetalRowData.h"
+#import "iTermPerformanceCounters.h"
+#import "iTermSignposts.h"
 #import "iTermPreciseTimer.h"
 #import "iTermPreferences.h"
 #import "iTermTextRendererTransientState.h"
@@ -150,6 +154,12 @@ typedef struct {
     NSTimeInterval _lastFrameStartTime;
     iTermHistogram *_startToStartHistogram;
     iTermHistogram *_inFlightHistogram;
+    iTermMetalLatencyStats *_latencyStats;
+
+    // Partial redraw. The descriptor is only used on the main thread and the tracker only on the
+    // private queue.
+    MTLRenderPassDescriptor *_retainedRenderPassDescriptor;
+    iTermMetalDamageTracker *_damageTracker;
     MovingAverage *_currentDrawableTime;
     NSInteger _maxFramesInFlight;
 
@@ -171,6 +181,8 @@ typedef struct {
         _identifier = [NSString stringWithFormat:@"[driver %d]", gNextIdentifier++];
         _startToStartHistogram = [[iTermHistogram alloc] init];
         _inFlightHistogram = [[iTermHistogram alloc] init];
+        _latencyStats = [[iTermMetalLatencyStats alloc] init];
+        _damageTracker = [[iTermMetalDamageTracker alloc] init];
         _startTime = [NSDate timeIntervalSinceReferenceDate];
         _fullSizeTexturePool = [[iTermTexturePool alloc] init];
         
@@ -305,6 +317,24 @@ cellSizeWithoutSpacing:(CGSize)cellSizeWithoutSpacing
     self.mainThreadState->context = context;
 }
 
+- (void)getLatencyStatsWithCompletion:(void (^)(NSDictionary<NSString *, id> *))completion {
+    [self dispatchAsyncToPrivateQueue:^{
+        NSDictionary<NSString *, id> *stats = [self latencyStatsDictionary];
+        dispatch_async(dispatch_get_main_queue(), ^{
+            completion(stats);
+        });
+    }];
+}
+
+- (void)getGlyphTextureBytesWithCompletion:(void (^)(NSUInteger))completion {
+    [self dispatchAsyncToPrivateQueue:^{
+        const NSUInteger bytes = [self->_textRenderer glyphTextureBytes];
+        dispatch_async(dispatch_get_main_queue(), ^{
+            completion(bytes);
+        });
+    }];
+}
+
 #pragma mark - MTKViewDelegate
 
 - (void)mtkView:(nonnull MTKView *)view drawableSizeWillChange:(CGSize)size {
@@ -388,9 +418,13 @@ cellSizeWithoutSpacing:(CGSize)cellSizeWithoutSpacing
     static _Atomic int count;
     int thisCount = atomic_fetch_add_explicit(&count, 1, memory_order_relaxed);
     DLog(@"Start asynchronous draw of %@ count=%d", view, thisCount);
+    os_log_t signpostLog = iTermSignpostLog();
+    const os_signpost_id_t spid = os_signpost_id_generate(signpostLog);
+    os_signpost_interval_begin(signpostLog, spid, "SyncDraw", "keystroke=%llu", iTermSignpostCurrentKeystroke());
     iTermMetalDriverAsyncContext *context = [self newContextForDrawInView:view count:count];
     dispatch_group_notify(context.group, dispatch_get_main_queue(), ^{
         DLog(@"Asynchronous draw of %@ completed count=%d", view, thisCount);
+        os_signpost_interval_end(signpostLog, spid, "SyncDraw", "aborted=%d", (int)context.aborted);
         completion(!context.aborted);
     });
 }
@@ -500,6 +534,12 @@ cellSizeWithoutSpacing:(CGSize)cellSizeWithoutSpacing
     @synchronized(self) {
         [_currentFrames addObject:frameData];
     }
+    os_signpost_interval_begin(iTermSignpostLog(),
+                               os_signpost_id_make_with_pointer(iTermSignpostLog(), (__bridge void *)frameData),
+                               "Frame",
+                               "keystroke=%llu frame=%lld",
+                               iTermSignpostCurrentKeystroke(),
+                               (long long)frameData.frameNumber);
 
     frameData.group = _context.group;
     if (frameData.group) {
@@ -536,6 +576,7 @@ cellSizeWithoutSpacing:(CGSize)cellSizeWithoutSpacing
     iTermMetalFrameData *frameData = [[iTermMetalFrameData alloc] initWithView:view
                                                            fullSizeTexturePool:_fullSizeTexturePool];
 
+    const uint64_t token = iTermPerformanceCounterBegin(iTermPerformanceCounterFramePrep);
     [frameData measureTimeForStat:iTermMetalFrameDataStatMtExtractFromApp ofBlock:^{
         frameData.viewportSize = self.mainThreadState->viewportSize;
         frameData.asciiOffset = self.mainThreadState->asciiOffset;
@@ -565,6 +606,7 @@ cellSizeWithoutSpacing:(CGSize)cellSizeWithoutSpacing
             frameData.maximumExtendedDynamicRangeColorComponentValue = self.mainThreadState->maximumExtendedDynamicRangeColorComponentValue;
         }
     }];
+    iTermPerformanceCounterEnd(iTermPerformanceCounterFramePrep, token);
     return frameData;
 }
 
@@ -586,13 +628,25 @@ cellSizeWithoutSpacing:(CGSize)cellSizeWithoutSpacing
         [rowData.lineData checkForOverrun];
     }
 
+    NSRange damagedRows = NSMakeRange(0, frameData.rows.count);
+    if (frameData.retainedRenderPassDescriptor) {
+        damagedRows = [_damageTracker damagedRowsInFrameData:frameData
+                                             retainedTexture:frameData.retainedRenderPassDescriptor.colorAttachments[0].texture];
+    } else {
+        [_damageTracker invalidate];
+    }
+
     // If we're rendering to an intermediate texture because there's something complicated
     // behind text and we need to use the fancy subpixel antialiasing algorithm, create it now.
     // This has to be done before updates so the copyBackgroundRenderer's `enabled` flag can be
     // set properly.
     if (!iTermTextIsMonochrome()) {
         [frameData createIntermediateRenderPassDescriptor];
-        [frameData createTemporaryRenderPassDescriptor];
+        if (frameData.retainedRenderPassDescriptor) {
+            frameData.temporaryRenderPassDescriptor = frameData.retainedRenderPassDescriptor;
+        } else {
+            [frameData createTemporaryRenderPassDescriptor];
+        }
     }
 
     // Set properties of the renderers for values that tend not to change very often and which
@@ -620,6 +674,9 @@ cellSizeWithoutSpacing:(CGSize)cellSizeWithoutSpacing
     [frameData measureTimeForStat:iTermMetalFrameDataStatPqPopulateTransientStates ofBlock:^{
         [self populateTransientStatesWithFrameData:frameData range:NSMakeRange(0, frameData.rows.count)];
     }];
+    if (frameData.retainedRenderPassDescriptor) {
+        [self setDamageRectOfFrameData:frameData damagedRows:damagedRows];
+    }
 
 #if !ENABLE_PRIVATE_QUEUE
     [self acquireScarceResources:frameData view:view];
@@ -859,7 +916,68 @@ cellSizeWithoutSpacing:(CGSize)cellSizeWithoutSpacing
             DLog(@"YIKES! Failed to get an RPD. %@/%@", self, frameData);
             return;
         }
+        if (!frameData.deferCurrentDrawable && [self shouldRedrawOnlyDamagedRowsOfFrameData:frameData]) {
+            frameData.retainedRenderPassDescriptor = [self retainedRenderPassDescriptorForFrameData:frameData];
+            if (iTermTextIsMonochrome()) {
+                // Draw into the retained texture and copy it to the drawable at the end.
+                frameData.drawableRenderPassDescriptor = frameData.renderPassDescriptor;
+                frameData.renderPassDescriptor = frameData.retainedRenderPassDescriptor;
+                frameData.destinationTexture = frameData.retainedRenderPassDescriptor.colorAttachments[0].texture;
+            }
+        }
+    }
+}
+
+#pragma mark - Partial Redraw
+
+// Main thread. Drawing over the previous frame is only correct when the background is opaque
+// because renderers blend with what's already there.
+- (BOOL)shouldRedrawOnlyDamagedRowsOfFrameData:(iTermMetalFrameData *)frameData {
+    return ([iTermAdvancedSettingsModel metalPartialRedraw] &&
+            frameData.debugInfo == nil &&
+            frameData.perFrameState.transparencyAlpha >= 1);
+}
+
+// Main thread
+- (MTLRenderPassDescriptor *)retainedRenderPassDescriptorForFrameData:(iTermMetalFrameData *)frameData {
+    id<MTLTexture> texture = _retainedRenderPassDescriptor.colorAttachments[0].texture;
+    const MTLPixelFormat pixelFormat = [iTermAdvancedSettingsModel hdrCursor] ? MTLPixelFormatRGBA16Float : MTLPixelFormatBGRA8Unorm;
+    if (texture == nil ||
+        texture.width != frameData.viewportSize.x ||
+        texture.height != frameData.viewportSize.y ||
+        texture.pixelFormat != pixelFormat) {
+        _retainedRenderPassDescriptor = [frameData newRenderPassDescriptorWithLabel:@"Retained frame"
+                                                                               fast:NO];
+    }
+    return _retainedRenderPassDescriptor;
+}
+
+// Private queue. Converts rows to a full-width rect in framebuffer coordinates (origin at top
+// left). One extra row on each side is included for glyphs and cursors that extend past their
+// cells. Rows touching the top or bottom also cover the margin.
+- (void)setDamageRectOfFrameData:(iTermMetalFrameData *)frameData damagedRows:(NSRange)damagedRows {
+    const NSInteger height = frameData.gridSize.height;
+    if (damagedRows.location == 0 && damagedRows.length >= height) {
+        return;
+    }
+    iTermMetalCellRendererTransientState *tState = [frameData transientStateForRenderer:_textRenderer];
+    if (!tState) {
+        return;
     }
+    const NSInteger first = MAX(0, (NSInteger)damagedRows.location - 1);
+    const NSInteger last = MIN(height - 1, (NSInteger)NSMaxRange(damagedRows));
+    const CGFloat cellHeight = frameData.cellSize.height;
+    const CGFloat viewportHeight = frameData.viewportSize.y;
+    // Cell renderers position row y at margins.top + (height - y - 1) * cellHeight from the bottom.
+    const CGFloat top = (first == 0) ? 0 : viewportHeight - tState.margins.top - (height - first) * cellHeight;
+    const CGFloat bottom = (last == height - 1) ? viewportHeight : viewportHeight - tState.margins.top - (height - last - 1) * cellHeight;
+    const NSUInteger y0 = MAX(0, floor(top));
+    const NSUInteger y1 = MIN(viewportHeight, ceil(bottom));
+    if (y1 <= y0) {
+        return;
+    }
+    frameData.damageRect = (MTLScissorRect){ .x = 0, .y = y0, .width = frameData.viewportSize.x, .height = y1 - y0 };
+    frameData.hasDamageRect = YES;
 }
 
 - (void)enqueueDrawCallsForFrameData:(iTermMetalFrameData *)frameData
@@ -1145,6 +1263,40 @@ cellSizeWithoutSpacing:(CGSize)cellSizeWithoutSpacing
     tState.destinationRect = frameData.perFrameState.badgeDestinationRect;
 }
 
+// Builds the background color renderer's PIUs. This touches only the background color transient
+// state and reads row data, so it is safe to run concurrently with the text renderer's pass over
+// the rows.
+- (void)populateBackgroundColorRendererTransientStateWithFrameData:(iTermMetalFrameData *)frameData {
+    if (_backgroundColorRenderer.rendererDisabled) {
+        return;
+    }
+    iTermBackgroundColorRendererTransientState *backgroundState = [frameData transientStateForRenderer:_backgroundColorRenderer];
+    BOOL (^comparator)(iTermMetalRowData *obj1, iTermMetalRowData *obj2) = ^BOOL(iTermMetalRowData *obj1, iTermMetalRowData *obj2) {
+        const NSUInteger count = obj1.numberOfBackgroundRLEs;
+        if (count != obj2.numberOfBackgroundRLEs) {
+            return NO;
+        }
+        const iTermMetalBackgroundColorRLE *array1 = (const iTermMetalBackgroundColorRLE *)obj1.backgroundColorRLEData.mutableBytes;
+        const iTermMetalBackgroundColorRLE *array2 = (const iTermMetalBackgroundColorRLE *)obj2.backgroundColorRLEData.mutableBytes;
+        for (int i = 0; i < count; i++) {
+            if (array1[i].color.x != array2[i].color.x ||
+                array1[i].color.y != array2[i].color.y ||
+                array1[i].color.z != array2[i].color.z ||
+                array1[i].color.w != array2[i].color.w ||
+                array1[i].count != array2[i].count) {
+                return NO;
+            }
+        }
+        return YES;
+    };
+    [frameData.rows enumerateCoalescedObjectsWithComparator:comparator block:^(iTermMetalRowData *rowData, NSUInteger count) {
+        [backgroundState setColorRLEs:(const iTermMetalBackgroundColorRLE *)rowData.backgroundColorRLEData.mutableBytes
+                                count:rowData.numberOfBackgroundRLEs
+                                  row:rowData.y
+                        repeatingRows:count];
+    }];
+}
+
 - (void)populateTextAndBackgroundRenderersTransientStateWithFrameData:(iTermMetalFrameData *)frameData {
     if (_textRenderer.rendererDisabled && _backgroundColorRenderer.rendererDisabled) {
         return;
@@ -1174,6 +1326,16 @@ cellSizeWithoutSpacing:(CGSize)cellSizeWithoutSpacing
 
     iTermMetalIMEInfo *imeInfo = frameData.perFrameState.imeInfo;
 
+    // The background PIUs don't depend on the text PIUs, so on large grids build them on another
+    // core while this thread does the (much more expensive) glyph lookups.
+    dispatch_group_t group = nil;
+    if ([iTermAdvancedSettingsModel metalParallelPopulate] && !_backgroundColorRenderer.rendererDisabled) {
+        group = dispatch_group_create();
+        dispatch_group_async(group, dispatch_get_global_queue(QOS_CLASS_USER_INTERACTIVE, 0), ^{
+            [self populateBackgroundColorRendererTransientStateWithFrameData:frameData];
+        });
+    }
+
     [frameData.rows enumerateObjectsUsingBlock:^(iTermMetalRowData * _Nonnull rowData, NSUInteger idx, BOOL * _Nonnull stop) {
         NSRange markedRangeOnLine = NSMakeRange(NSNotFound, 0);
         if (imeInfo &&
@@ -1227,33 +1389,11 @@ cellSizeWithoutSpacing:(CGSize)cellSizeWithoutSpacing
         }
         [rowData.keysData checkForOverrun];
     }];
-    if (!_backgroundColorRenderer.rendererDisabled) {
-        BOOL (^comparator)(iTermMetalRowData *obj1, iTermMetalRowData *obj2) = ^BOOL(iTermMetalRowData *obj1, iTermMetalRowData *obj2) {
-            const NSUInteger count = obj1.numberOfBackgroundRLEs;
-            if (count != obj2.numberOfBackgroundRLEs) {
-                return NO;
-            }
-            const iTermMetalBackgroundColorRLE *array1 = (const iTermMetalBackgroundColorRLE *)obj1.backgroundColorRLEData.mutableBytes;
-            const iTermMetalBackgroundColorRLE *array2 = (const iTermMetalBackgroundColorRLE *)obj2.backgroundColorRLEData.mutableBytes;
-            for (int i = 0; i < count; i++) {
-                if (array1[i].color.x != array2[i].color.x ||
-                    array1[i].color.y != array2[i].color.y ||
-                    array1[i].color.z != array2[i].color.z ||
-                    array1[i].color.w != array2[i].color.w ||
-                    array1[i].count != array2[i].count) {
-                    return NO;
-                }
-            }
-            return YES;
-        };
-        [frameData.rows enumerateCoalescedObjectsWithComparator:comparator block:^(iTermMetalRowData *rowData, NSUInteger count) {
-            [backgroundState setColorRLEs:(const iTermMetalBackgroundColorRLE *)rowData.backgroundColorRLEData.mutableBytes
-                                    count:rowData.numberOfBackgroundRLEs
-                                      row:rowData.y
-                            repeatingRows:count];
-        }];
+    if (group) {
+        dispatch_group_wait(group, DISPATCH_TIME_FOREVER);
+    } else {
+        [self populateBackgroundColorRendererTransientStateWithFrameData:frameData];
     }
-
     // Tell the text state that it's done getting row data.
     if (!_textRenderer.rendererDisabled) {
         [textState willDraw];
@@ -1509,6 +1649,10 @@ cellSizeWithoutSpacing:(CGSize)cellSizeWithoutSpacing
                                                       stat:stats[pass]
                                                      label:label];
     frameData.destinationTexture = [descriptors[pass].colorAttachments[0] texture];
+    if (frameData.hasDamageRect && frameData.destinationTexture != frameData.destinationDrawable.texture) {
+        // Everything outside the damage rect is left as it was in the previous frame.
+        [frameData.renderEncoder setScissorRect:frameData.damageRect];
+    }
 }
 
 - (void)drawCursorBeforeTextWithFrameData:(iTermMetalFrameData *)frameData {
@@ -1739,7 +1883,18 @@ cellSizeWithoutSpacing:(CGSize)cellSizeWithoutSpacing
         DLog(@"  Copy offscreen texture to drawable %@", frameData);
         [self copyOffscreenTextureToDrawableInFrameData:frameData];
     }
+    if (frameData.drawableRenderPassDescriptor) {
+        DLog(@"  Copy retained texture to drawable %@", frameData);
+        [self copyToDrawableFromTexture:frameData.retainedRenderPassDescriptor.colorAttachments[0].texture
+               withRenderPassDescriptor:frameData.drawableRenderPassDescriptor
+                                  label:@"copy retained frame to drawable"
+                              frameData:frameData];
+    }
     [frameData measureTimeForStat:iTermMetalFrameDataStatPqEnqueueDrawPresentAndCommit ofBlock:^{
+        if ([iTermAdvancedSettingsModel measureMetalLatency]) {
+            [self measureLatencyOfFrameData:frameData commandBuffer:commandBuffer];
+        }
+        [self emitPresentSignpostForFrameData:frameData];
 #if !ENABLE_SYNCHRONOUS_PRESENTATION
         if (frameData.destinationDrawable) {
             DLog(@"  presentDrawable %@", frameData);
@@ -1768,6 +1923,9 @@ cellSizeWithoutSpacing:(CGSize)cellSizeWithoutSpacing
         } copy];
 
         [commandBuffer addCompletedHandler:^(id<MTLCommandBuffer> _Nonnull buffer) {
+            if (@available(macOS 10.15, *)) {
+                iTermPerformanceCounterRecordDuration(iTermPerformanceCounterGPU, buffer.GPUEndTime - buffer.GPUStartTime);
+            }
 #if ENABLE_PRIVATE_QUEUE
             [frameData dispatchToQueue:self->_queue forCompletion:completedBlock];
 #else
@@ -1801,6 +1959,7 @@ cellSizeWithoutSpacing:(CGSize)cellSizeWithoutSpacing
                     [frameData.debugInfo addMetalCapture:frameData.captureDescriptor.outputURL];
                 }
             }
+            [frameData.debugInfo setLatencyStats:[self latencyStatsDictionary]];
             NSData *archive = [frameData.debugInfo newArchive];
             dispatch_async(dispatch_get_main_queue(), ^{
                 [self.dataSource metalDriverDidProduceDebugInfo:archive];
@@ -1834,6 +1993,17 @@ cellSizeWithoutSpacing:(CGSize)cellSizeWithoutSpacing
         // Unlock indices and free up the stage texture.
         iTermTextRendererTransientState *textState = [frameData transientStateForRenderer:_textRenderer];
         [textState didComplete];
+        if ([iTermAdvancedSettingsModel rasterizeBoxDrawingGlyphsInBatch] &&
+            [textState beginAddingBoxDrawingGlyphs]) {
+            // TUIs draw mostly with these, so rasterize them all at once for this font and cell
+            // size instead of one at a time as they come into view.
+            [frameData.perFrameState metalEnumerateBoxDrawingGlyphKeys:^(iTermMetalGlyphKey *glyphKey) {
+                [textState addPendingGlyphKey:glyphKey];
+            }];
+        }
+        if (textState.hasPendingGlyphs) {
+            [self rasterizePendingGlyphsInTextState:textState frameData:frameData];
+        }
     }
 
     DLog(@"  Recording final stats");
@@ -1851,6 +2021,9 @@ cellSizeWithoutSpacing:(CGSize)cellSizeWithoutSpacing
         frameData.status = @"retired";
         [_currentFrames removeObject:frameData];
     }
+    os_signpost_interval_end(iTermSignpostLog(),
+                             os_signpost_id_make_with_pointer(iTermSignpostLog(), (__bridge void *)frameData),
+                             "Frame");
     [self dispatchAsyncToPrivateQueue:^{
         [self scheduleDrawIfNeededInView:frameData.view];
     }];
@@ -1861,6 +2034,82 @@ cellSizeWithoutSpacing:(CGSize)cellSizeWithoutSpacing
     }
 }
 
+#pragma mark - Latency
+
+// Must be called before the drawable is presented.
+- (void)emitPresentSignpostForFrameData:(iTermMetalFrameData *)frameData {
+    os_log_t signpostLog = iTermSignpostLog();
+    if (!os_signpost_enabled(signpostLog)) {
+        return;
+    }
+    if (@available(macOS 10.15.4, *)) {
+        const os_signpost_id_t spid = os_signpost_id_make_with_pointer(signpostLog, (__bridge void *)frameData);
+        const uint64_t keystroke = iTermSignpostCurrentKeystroke();
+        const long long frameNumber = frameData.frameNumber;
+        [frameData.destinationDrawable addPresentedHandler:^(id<MTLDrawable> _Nonnull presentedDrawable) {
+            if (presentedDrawable.presentedTime == 0) {
+                return;
+            }
+            os_signpost_event_emit(signpostLog, spid, "Present", "keystroke=%llu frame=%lld", keystroke, frameNumber);
+        }];
+    }
+}
+
+// Must be called before the drawable is presented.
+- (void)measureLatencyOfFrameData:(iTermMetalFrameData *)frameData
+                    commandBuffer:(id<MTLCommandBuffer>)commandBuffer {
+    iTermMetalLatencyStats *latencyStats = _latencyStats;
+    if (@available(macOS 10.15, *)) {
+        [commandBuffer addCompletedHandler:^(id<MTLCommandBuffer> _Nonnull buffer) {
+            [latencyStats recordGPUTime:buffer.GPUEndTime - buffer.GPUStartTime];
+        }];
+    }
+    const NSTimeInterval keystrokeTimestamp = frameData.perFrameState.keystrokeTimestamp;
+    const NSTimeInterval outputTimestamp = frameData.perFrameState.outputTimestamp;
+    if (keystrokeTimestamp == 0 && outputTimestamp == 0) {
+        return;
+    }
+    id<CAMetalDrawable> drawable = frameData.destinationDrawable;
+    if (@available(macOS 10.15.4, *)) {
+        if (drawable) {
+            [drawable addPresentedHandler:^(id<MTLDrawable> _Nonnull presentedDrawable) {
+                if (presentedDrawable.presentedTime == 0) {
+                    // Never made it to the screen.
+                    return;
+                }
+                // presentedTime uses the CACurrentMediaTime() clock.
+                const NSTimeInterval presentationTime =
+                    [NSDate timeIntervalSinceReferenceDate] - (CACurrentMediaTime() - presentedDrawable.presentedTime);
+                [latencyStats recordFramePresentedAt:presentationTime
+                                  keystrokeTimestamp:keystrokeTimestamp
+                                     outputTimestamp:outputTimestamp];
+            }];
+            return;
+        }
+    }
+    // Without presentation feedback, GPU completion is the best available approximation.
+    [commandBuffer addCompletedHandler:^(id<MTLCommandBuffer> _Nonnull buffer) {
+        [latencyStats recordFramePresentedAt:[NSDate timeIntervalSinceReferenceDate]
+                          keystrokeTimestamp:keystrokeTimestamp
+                             outputTimestamp:outputTimestamp];
+    }];
+}
+
+// Call on the private queue, where the stat histograms are updated.
+- (NSDictionary<NSString *, id> *)latencyStatsDictionary {
+    NSMutableDictionary<NSString *, iTermHistogram *> *encodeHistograms = [NSMutableDictionary dictionary];
+#if ENABLE_STATS
+    for (int i = iTermMetalFrameDataStatPqEnqueueDrawCreateFirstRenderEncoder;
+         i <= iTermMetalFrameDataStatPqEnqueueDrawPresentAndCommit;
+         i++) {
+        NSString *name = [[NSString stringWithUTF8String:_stats[i].name] stringByReplacingOccurrencesOfString:@"<"
+                                                                                                    withString:@""];
+        encodeHistograms[name] = _statHistograms[i];
+    }
+#endif
+    return [_latencyStats dictionaryValueWithEncodeHistograms:encodeHistograms];
+}
+
 #pragma mark - Miscellaneous Utility Methods
 
 - (NSArray<id<iTermMetalCellRenderer>> *)cellRenderers {
@@ -1903,6 +2152,30 @@ cellSizeWithoutSpacing:(CGSize)cellSizeWithoutSpacing
     }
 }
 
+// Glyphs that were missing from this frame were drawn as empty cells. Rasterize them on the
+// private queue, which is where rasterization normally happens, but after this frame has been
+// presented. Then draw again so they appear.
+- (void)rasterizePendingGlyphsInTextState:(iTermTextRendererTransientState *)textState
+                                frameData:(iTermMetalFrameData *)frameData {
+    const CGSize glyphSize = frameData.glyphSize;
+    const CGFloat scale = frameData.scale;
+    const CGSize asciiOffset = frameData.asciiOffset;
+    MTKView *view = frameData.view;
+    [self dispatchAsyncToPrivateQueue:^{
+        const BOOL added = [textState rasterizePendingGlyphsWithCreation:^NSDictionary<NSNumber *, iTermCharacterBitmap *> *(iTermMetalGlyphKey *glyphKey, BOOL *emoji) {
+            return [frameData.perFrameState metalImagesForGlyphKey:glyphKey
+                                                       asciiOffset:asciiOffset
+                                                              size:glyphSize
+                                                             scale:scale
+                                                             emoji:emoji];
+        }];
+        if (added) {
+            self.needsDrawAfterDuration = 0;
+            [self scheduleDrawIfNeededInView:view];
+        }
+    }];
+}
+
 - (void)scheduleDrawIfNeededInView:(MTKView *)view {
     const NSTimeInterval duration = self.needsDrawAfterDuration;
     if (duration < INFINITY) {
@@ -32,5 +32,6 @@ typedef struct iTermScreenIdentifier {
 - (iTermScreenIdentifier)it_identifier;
 - (NSString *)it_uniqueName;
 - (NSString *)it_uniqueKey;
+- (CGDirectDisplayID)it_displayID;
 
 @end
@@ -32,6 +32,7 @@
 #import "iTermPreferences.h"
 #import "iTermSwiftyStringParser.h"
 #import "iTermTuple.h"
+#import "iTermUnicodeProperties.h"
 #import "iTermVariableScope.h"
 #import "NSArray+iTerm.h"
 #import "NSAttributedString+PSM.h"
@@ -62,6 +63,11 @@
         // Quickly cover the common cases.
         return NO;
     }
+    if ([iTermAdvancedSettingsModel unicodePropertyTable]) {
+        return iTermUnicodePropertyTableIsDoubleWidth(iTermUnicodePropertyTableForVersion(version),
+                                                      unicode,
+                                                      ambiguousIsDoubleWidth);
+    }
 
     if ([[NSCharacterSet fullWidthCharacterSetForUnicodeVersion:version] longCharacterIsMember:unicode]) {
         return YES;
@@ -22,6 +22,10 @@
 
 + (PTYFontInfo *)fontInfoWithFont:(NSFont *)font;
 
+// Returns a process-wide instance for this font with its bold, italic, and bold italic versions
+// already computed. It is shared, so it must not be modified.
++ (PTYFontInfo *)sharedFontInfoWithVariantsForFont:(NSFont *)font;
+
 // renderBold and renderItalic are inout parameters. Pass in whether you want bold/italic and the
 // resulting value is whether it should be rendered as fake bold/italic.
 + (PTYFontInfo *)fontForAsciiCharacter:(BOOL)isAscii
@@ -127,6 +127,34 @@
     return fontInfo;
 }
 
++ (PTYFontInfo *)sharedFontInfoWithVariantsForFont:(NSFont *)font {
+    static NSMutableDictionary<NSFont *, PTYFontInfo *> *cache;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        cache = [[NSMutableDictionary alloc] init];
+        // Variants depend on which fonts are installed and the minimum weight difference for bold.
+        for (NSString *name in @[ NSFontSetChangedNotification, iTermAdvancedSettingsDidChange ]) {
+            [[NSNotificationCenter defaultCenter] addObserverForName:name
+                                                              object:nil
+                                                               queue:nil
+                                                          usingBlock:^(NSNotification * _Nonnull note) {
+                [cache removeAllObjects];
+            }];
+        }
+    });
+    PTYFontInfo *fontInfo = cache[font];
+    if (fontInfo) {
+        return fontInfo;
+    }
+    DLog(@"Compute shared font info for %@", font);
+    fontInfo = [PTYFontInfo fontInfoWithFont:font];
+    fontInfo.boldVersion = [fontInfo computedBoldVersion];
+    fontInfo.italicVersion = [fontInfo computedItalicVersion];
+    fontInfo.boldItalicVersion = [fontInfo computedBoldItalicVersion];
+    cache[font] = fontInfo;
+    return fontInfo;
+}
+
 - (void)dealloc {
     [font_ release];
     [boldVersion_ release];
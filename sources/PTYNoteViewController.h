@@ -46,6 +46,8 @@ extern NSString *const iTermAnnotationVisibilityDidChange;
 - (void)setString:(NSString *)string;
 - (void)setNoteHidden:(BOOL)hidden;
 - (BOOL)isNoteHidden;
+// Does the note's text view have keyboard focus?
+- (BOOL)isEditing;
 - (void)sizeToFit;
 - (void)makeFirstResponder;
 - (void)highlight;
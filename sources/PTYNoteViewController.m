@@ -27,6 +27,8 @@ static const CGFloat kBottomPadding = 3;
 
 @implementation PTYNoteViewController {
     NSTimeInterval highlightStartTime_;
+    // Text set before the view was loaded.
+    NSString *_pendingString;
 }
 
 @synthesize noteView = noteView_;
@@ -67,6 +69,7 @@ static const CGFloat kBottomPadding = 3;
     [noteView_ release];
     [textView_ release];
     [scrollView_ release];
+    [_pendingString release];
     [[NSNotificationCenter defaultCenter] removeObserver:self];
     [super dealloc];
 }
@@ -130,6 +133,15 @@ static const CGFloat kBottomPadding = 3;
     [wrapper addSubview:scrollView_];
 
     noteView_.contentView = wrapper;
+    if (_pendingString) {
+        textView_.string = _pendingString;
+        [_pendingString release];
+        _pendingString = nil;
+    }
+    if (hidden_) {
+        noteView_.hidden = YES;
+        noteView_.alphaValue = 0;
+    }
     [self sizeToFit];
 }
 
@@ -217,12 +229,24 @@ static const CGFloat kBottomPadding = 3;
     }
 }
 
+- (NSString *)string {
+    if (!self.isViewLoaded) {
+        return _pendingString;
+    }
+    return textView_.string;
+}
+
 - (BOOL)isEmpty {
-    return [[textView_.string stringByTrimmingCharactersInSet:[NSCharacterSet whitespaceAndNewlineCharacterSet]] length] == 0;
+    return [[[self string] stringByTrimmingCharactersInSet:[NSCharacterSet whitespaceAndNewlineCharacterSet]] length] == 0;
 }
 
 - (void)setString:(NSString *)string {
-    [self view];  // Ensure textView exists.
+    if (!self.isViewLoaded) {
+        // Notes far from the visible area may never need a view, so don't make one yet.
+        [_pendingString autorelease];
+        _pendingString = [string copy];
+        return;
+    }
     textView_.string = string;
 }
 
@@ -230,6 +254,10 @@ static const CGFloat kBottomPadding = 3;
     return hidden_;
 }
 
+- (BOOL)isEditing {
+    return textView_ != nil && textView_.window.firstResponder == textView_;
+}
+
 - (void)noteViewPositionNeedsUpdate {
     self.anchor = anchor_;
 }
@@ -334,7 +362,7 @@ static const CGFloat kBottomPadding = 3;
 #pragma mark - IntervalTreeObject
 
 - (NSDictionary *)dictionaryValue {
-    return @{ kNoteViewTextKey: textView_.string ?: @"" };
+    return @{ kNoteViewTextKey: [self string] ?: @"" };
 }
 
 @end
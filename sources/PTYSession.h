@@ -578,6 +578,9 @@ backgroundColor:(NSColor *)backgroundColor;
 // contents will be copied over.
 + (void)registerSessionInArrangement:(NSDictionary *)arrangement;
 
+// Begins decoding the session's saved contents in the background.
++ (void)prefetchContentsInArrangement:(NSDictionary *)arrangement;
+
 // Forget all sessions registered with registerSessionInArrangement. Normally
 // called after startup activities are done.
 + (void)removeAllRegisteredSessions;
@@ -634,6 +637,7 @@ backgroundColor:(NSColor *)backgroundColor;
 
 // Set rows, columns from arrangement.
 - (void)resizeFromArrangement:(NSDictionary *)arrangement;
+- (BOOL)sizeMatchesArrangement:(NSDictionary *)arrangement;
 
 - (void)startProgram:(NSString *)program
          environment:(NSDictionary *)prog_env
@@ -685,6 +689,11 @@ backgroundColor:(NSColor *)backgroundColor;
 
 - (void)writeLatin1EncodedData:(NSData *)data broadcastAllowed:(BOOL)broadcast;
 
+// Used when broadcast input is encoded once and written to each task by the caller. Does the
+// bookkeeping writeTaskNoBroadcast: would. Returns NO if the session must get the input through
+// writeTaskNoBroadcast:encoding:forceEncoding: instead.
+- (BOOL)prepareToWriteBroadcastData:(NSData *)data;
+
 - (void)updateViewBackgroundImage;
 - (void)invalidateBlend;
 
@@ -741,6 +750,9 @@ backgroundColor:(NSColor *)backgroundColor;
 
 // Display timer stuff
 - (void)updateDisplayBecause:(NSString *)reason;
+
+// Suspends or resumes presentation work depending on whether anyone can see this session.
+- (void)updatePresentationSuspension;
 - (void)doAntiIdle;
 - (NSString*)ansiColorsMatchingForeground:(NSDictionary*)fg andBackground:(NSDictionary*)bg inBookmark:(Profile*)aDict;
 
@@ -908,6 +920,10 @@ backgroundColor:(NSColor *)backgroundColor;
 - (BOOL)closeComposer;
 - (void)didChangeScreen:(CGFloat)scaleFactor;
 
+// Sets session.memoryUsage to the approximate bytes used by the session. Called periodically by
+// iTermSessionMemoryAccountant.
+- (void)updateMemoryUsage;
+
 #pragma mark - API
 
 - (ITMGetBufferResponse *)handleGetBufferRequest:(ITMGetBufferRequest *)request;
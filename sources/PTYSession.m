@@ -10,6 +10,7 @@
 #import "ITAddressBookMgr.h"
 #import "iTerm.h"
 #import "iTermAPIHelper.h"
+#import "iTermAPIResponseCache.h"
 #import "iTermActionsModel.h"
 #import "iTermAddTriggerViewController.h"
 #import "iTermAdvancedSettingsModel.h"
@@ -22,6 +23,7 @@
 #import "iTermBuriedSessions.h"
 #import "iTermBuiltInFunctions.h"
 #import "iTermCacheableImage.h"
+#import "iTermCapturedOutputStore.h"
 #import "iTermCarbonHotKeyController.h"
 #import "iTermCharacterSource.h"
 #import "iTermColorMap.h"
@@ -62,6 +64,7 @@
 #import "iTermRateLimitedUpdate.h"
 #import "iTermScriptConsole.h"
 #import "iTermScriptHistory.h"
+#import "iTermScreenUpdateSubscription.h"
 #import "iTermSharedImageStore.h"
 #import "iTermSlownessDetector.h"
 #import "iTermSnippetsModel.h"
@@ -76,10 +79,13 @@
 #import "iTermMouseCursor.h"
 #import "iTermNotificationCenter.h"
 #import "iTermPasteHelper.h"
+#import "iTermPerformanceCounters.h"
 #import "iTermPreferences.h"
+#import "iTermPtyCapture.h"
 #import "iTermPrintGuard.h"
 #import "iTermProcessCache.h"
 #import "iTermProfilePreferences.h"
+#import "iTermProfileSnapshot.h"
 #import "iTermPromptOnCloseReason.h"
 #import "iTermRecentDirectoryMO.h"
 #import "iTermRestorableSession.h"
@@ -89,10 +95,13 @@
 #import "iTermSecureKeyboardEntryController.h"
 #import "iTermSelection.h"
 #import "iTermSemanticHistoryController.h"
+#import "iTermSessionContentsDidChangeNotification.h"
 #import "iTermSessionFactory.h"
 #import "iTermSessionHotkeyController.h"
 #import "iTermSessionLauncher.h"
+#import "iTermSessionMemoryAccountant.h"
 #import "iTermSessionNameController.h"
+#import "iTermSignposts.h"
 #import "iTermSessionTitleBuiltInFunction.h"
 #import "iTermSetFindStringNotification.h"
 #import "iTerm2SharedARC-Swift.h"
@@ -111,6 +120,8 @@
 #import "iTermThroughputEstimator.h"
 #import "iTermTmuxStatusBarMonitor.h"
 #import "iTermTmuxOptionMonitor.h"
+#import "iTermTokenExecutionScheduler.h"
+#import "iTermTriggerMatcher.h"
 #import "iTermUpdateCadenceController.h"
 #import "iTermVariableReference.h"
 #import "iTermVariableScope.h"
@@ -185,6 +196,8 @@ static const NSInteger kMinimumUnicodeVersion = 8;
 static const NSInteger kMaximumUnicodeVersion = 9;
 
 static NSString *const PTYSessionDidRepairSavedArrangement = @"PTYSessionDidRepairSavedArrangement";
+// Posted when a session's task can accept input again after a paste found its write buffer full.
+static NSString *const PTYSessionWriteBufferDidDrainNotification = @"PTYSessionWriteBufferDidDrainNotification";
 
 NSString *const PTYSessionCreatedNotification = @"PTYSessionCreatedNotification";
 NSString *const PTYSessionTerminatedNotification = @"PTYSessionTerminatedNotification";
@@ -302,6 +315,11 @@ static NSMutableDictionary *gRegisteredSessionContents;
 // Rate limit for checking instant (partial-line) triggers, in seconds.
 static NSTimeInterval kMinimumPartialLineTriggerCheckInterval = 0.5;
 
+// With throttlePartialLineTriggers, the rate limit above is multiplied by one for each this many
+// bytes per second of throughput, up to kMaximumPartialLineTriggerBackoff.
+static const NSInteger kPartialLineTriggerBackoffBytesPerSecond = 64 * 1024;
+static const NSInteger kMaximumPartialLineTriggerBackoff = 8;
+
 // Grace period to avoid failing to write anti-idle code when timer runs just before when the code
 // should be sent.
 static const NSTimeInterval kAntiIdleGracePeriod = 0.1;
@@ -332,6 +350,7 @@ static const NSUInteger kMaxHosts = 100;
     iTermNaggingControllerDelegate,
     iTermObject,
     iTermPasteHelperDelegate,
+    iTermScreenUpdateSubscriptionDelegate,
     iTermSessionNameControllerDelegate,
     iTermSessionViewDelegate,
     iTermStandardKeyMapperDelegate,
@@ -339,6 +358,7 @@ static const NSUInteger kMaxHosts = 100;
     iTermTermkeyKeyMapperDelegate,
     iTermTriggersDataSource,
     iTermTmuxControllerSession,
+    iTermTokenExecutionSchedulerClient,
     iTermUpdateCadenceControllerDelegate,
     iTermWorkingDirectoryPollerDelegate,
     TriggerDelegate>
@@ -374,6 +394,8 @@ static const NSUInteger kMaxHosts = 100;
 @property(nonatomic, retain) VT100RemoteHost *currentHost;
 @property(nonatomic, retain) iTermExpectation *pasteBracketingOopsieExpectation;
 @property(nonatomic, copy) NSString *cookie;
+// Non-nil while capturing. Atomic because the TaskNotifier thread records output.
+@property(atomic, retain) iTermPtyCaptureWriter *ptyCapture;
 @end
 
 @implementation PTYSession {
@@ -396,9 +418,17 @@ static const NSUInteger kMaxHosts = 100;
     // needed.
     Profile *_originalProfile;
 
+    // Hot settings resolved from _profile. Remade whenever _profile is replaced.
+    iTermProfileSnapshot _profileSnapshot;
+
     // Time since reference date when last keypress was received.
     NSTimeInterval _lastInput;
 
+    // Earliest keystroke and output not yet reflected in a Metal frame, for latency measurement.
+    // The output time is guarded by @synchronized(self) since it's set on the reading thread.
+    NSTimeInterval _undrawnKeystrokeTime;
+    NSTimeInterval _undrawnOutputTime;
+
     // Time since reference date when the tab label was last updated.
     NSTimeInterval _lastUpdate;
 
@@ -433,6 +463,15 @@ static const NSUInteger kMaxHosts = 100;
     // The current triggers.
     NSMutableArray *_triggers;
 
+    // Finds which of _triggers could match a line. Nil unless prefilterTriggers or
+    // throttlePartialLineTriggers is on. Complete lines are only prefiltered with prefilterTriggers.
+    iTermTriggerMatcher *_triggerMatcher;
+
+    // Complete lines are matched against _triggers here when every trigger allows it. Matches are
+    // applied back on the main queue in the order the lines finished. Nil until first needed.
+    dispatch_queue_t _triggerQueue;
+    BOOL _triggersCanRunInBackground;
+
     // Does the terminal think this session is focused?
     BOOL _focused;
 
@@ -448,6 +487,9 @@ static const NSUInteger kMaxHosts = 100;
     BOOL _tmuxWindowClosingByClientRequest;
     // This is the write end of a pipe for tmux clients. The read end is in TaskNotifier.
     NSFileHandle *_tmuxClientWritePipe;
+    // If set, writes to _tmuxClientWritePipe go here instead of the shared tmuxQueue so that a
+    // pane whose pipe is full doesn't hold up output for its siblings.
+    dispatch_queue_t _tmuxClientWriteQueue;
     NSInteger _requestAttentionId;  // Last request-attention identifier
     iTermMark *_lastMark;
 
@@ -464,6 +506,24 @@ static const NSUInteger kMaxHosts = 100;
 
     dispatch_semaphore_t _executionSemaphore;
 
+    // When coalescing token execution, reads are parsed into _pendingTokens
+    // and the main thread executes everything pending in a single block.
+    // _pendingTokens, _pendingTokensByteCount, _pendingTokensBatchCount, and
+    // _pendingTokensDrainScheduled are only accessed on _tokenQueue.
+    BOOL _coalesceTokenExecution;
+    dispatch_queue_t _tokenQueue;
+    CVector _pendingTokens;
+    int _pendingTokensByteCount;
+    int _pendingTokensBatchCount;
+    BOOL _pendingTokensDrainScheduled;
+
+    // With fair-share execution, drains are handed out by iTermTokenExecutionScheduler, which may
+    // execute only some of the pending batches per turn. These give the token and byte count of
+    // each pending batch, oldest first. Only accessed on _tokenQueue.
+    BOOL _fairShareTokenExecution;
+    CTVector(int) _pendingBatchTokenCounts;
+    CTVector(int) _pendingBatchByteCounts;
+
     // Previous updateDisplay timer's timeout period (not the actual duration,
     // but the kXXXTimerIntervalSec value).
     NSTimeInterval _lastTimeout;
@@ -495,6 +555,12 @@ static const NSUInteger kMaxHosts = 100;
     // checking long lines over and over.
     NSTimeInterval _lastPartialLineTriggerCheck;
 
+    // With throttlePartialLineTriggers, the partial line last checked and the triggers whose
+    // required literals appeared in it. Used to check only text that arrived since.
+    NSString *_partialLineTriggerString;
+    long long _partialLineTriggerLineNumber;
+    NSIndexSet *_partialLineTriggerCandidates;
+
     // Maps announcement identifiers to view controllers.
     NSMutableDictionary *_announcements;
 
@@ -540,6 +606,8 @@ static const NSUInteger kMaxHosts = 100;
     NSMutableDictionary<id, ITMNotificationRequest *> *_keystrokeSubscriptions;
     NSMutableDictionary<id, ITMNotificationRequest *> *_keyboardFilterSubscriptions;
     NSMutableDictionary<id, ITMNotificationRequest *> *_updateSubscriptions;
+    // Subset of _updateSubscriptions that want changed lines or a max rate.
+    NSMutableDictionary<id, iTermScreenUpdateSubscription *> *_coalescedUpdateSubscriptions;
     NSMutableDictionary<id, ITMNotificationRequest *> *_promptSubscriptions;
     NSMutableDictionary<id, ITMNotificationRequest *> *_customEscapeSequenceNotifications;
 
@@ -549,6 +617,10 @@ static const NSUInteger kMaxHosts = 100;
     BOOL _useAdaptiveFrameRate;
     NSInteger _adaptiveFrameRateThroughputThreshold;
 
+    // Bytes per second at which to enter flood mode, or 0 if disabled. See -updateFloodMode.
+    NSInteger _floodModeThreshold;
+    BOOL _inFloodMode;
+
     uint32_t _autoLogId;
 
     iTermCopyModeHandler *_copyModeHandler;
@@ -583,6 +655,8 @@ static const NSUInteger kMaxHosts = 100;
     iTermGraphicSource *_graphicSource;
     iTermVariableReference *_jobPidRef;
     iTermCacheableImage *_customIcon;
+    // Holds the strings of captured output when storeCapturedOutputOutOfLine is on.
+    iTermCapturedOutputStore *_capturedOutputStore;
     CGContextRef _metalContext;
     BOOL _errorCreatingMetalContext;
 
@@ -609,6 +683,7 @@ static const NSUInteger kMaxHosts = 100;
     // May be stale, but allows us to update titles fast after an OSC 0/1/2
     iTermProcessInfo *_lastProcessInfo;
     iTermLoggingHelper *_logging;
+    BOOL _replayingPtyCapture;
     iTermNaggingController *_naggingController;
     iTermComposerManager *_composerManager;
     BOOL _tmuxTTLHasThresholds;
@@ -621,6 +696,14 @@ static const NSUInteger kMaxHosts = 100;
 
     VT100GridSize _savedGridSize;
 
+    // Set while the screen counts wrapped lines for a new width in the background. The text
+    // view keeps drawing the old layout until then, and _sizeAfterReflow is applied when it's done.
+    BOOL _waitingForReflow;
+    VT100GridSize _sizeAfterReflow;
+
+    // See -updatePresentationSuspension.
+    BOOL _presentationSuspended;
+
     iTermActivityInfo _activityInfo;
     TriggerController *_triggerWindowController;
 
@@ -666,6 +749,13 @@ static const NSUInteger kMaxHosts = 100;
     }
 }
 
++ (void)prefetchContentsInArrangement:(NSDictionary *)arrangement {
+    NSDictionary *contents = [NSDictionary castFrom:arrangement[SESSION_ARRANGEMENT_CONTENTS]];
+    if (contents) {
+        [VT100Screen prefetchContentsOfDictionary:contents];
+    }
+}
+
 + (void)removeAllRegisteredSessions {
     DLog(@"Remove all registered sessions");
     [gRegisteredSessionContents removeAllObjects];
@@ -683,6 +773,7 @@ static const NSUInteger kMaxHosts = 100;
         _autoLogId = arc4random();
         _useAdaptiveFrameRate = [iTermAdvancedSettingsModel useAdaptiveFrameRate];
         _adaptiveFrameRateThroughputThreshold = [iTermAdvancedSettingsModel adaptiveFrameRateThroughputThreshold];
+        _floodModeThreshold = (NSInteger)[iTermAdvancedSettingsModel floodModeThreshold] * 1024 * 1024;
         _idleTime = [iTermAdvancedSettingsModel idleTimeSeconds];
         _triggerLineNumber = -1;
         _fakePromptDetectedAbsLine = -1;
@@ -690,6 +781,8 @@ static const NSUInteger kMaxHosts = 100;
         // mode.
         [[MovePaneController sharedInstance] exitMovePaneMode];
         _lastInput = [NSDate timeIntervalSinceReferenceDate];
+        // Defaults until the profile is set.
+        _profileSnapshot = iTermProfileSnapshotMake(nil);
         _copyModeHandler = [[iTermCopyModeHandler alloc] init];
         _copyModeHandler.delegate = self;
 
@@ -697,6 +790,16 @@ static const NSUInteger kMaxHosts = 100;
         // TODO: How do slower machines fare?
         static const int kMaxOutstandingExecuteCalls = 4;
         _executionSemaphore = dispatch_semaphore_create(kMaxOutstandingExecuteCalls);
+        _coalesceTokenExecution = [iTermAdvancedSettingsModel coalesceTokenExecution];
+        if (_coalesceTokenExecution) {
+            _tokenQueue = dispatch_queue_create("com.iterm2.session-tokens", DISPATCH_QUEUE_SERIAL);
+            CVectorCreate(&_pendingTokens, 100);
+            _fairShareTokenExecution = [iTermAdvancedSettingsModel fairShareTokenExecution];
+            if (_fairShareTokenExecution) {
+                CTVectorCreate(&_pendingBatchTokenCounts, 4);
+                CTVectorCreate(&_pendingBatchByteCounts, 4);
+            }
+        }
 
         _lastOutputIgnoringOutputAfterResizing = _lastInput;
         _lastUpdate = _lastInput;
@@ -776,6 +879,7 @@ static const NSUInteger kMaxHosts = 100;
         _keystrokeSubscriptions = [[NSMutableDictionary alloc] init];
         _keyboardFilterSubscriptions = [[NSMutableDictionary alloc] init];
         _updateSubscriptions = [[NSMutableDictionary alloc] init];
+        _coalescedUpdateSubscriptions = [[NSMutableDictionary alloc] init];
         _promptSubscriptions = [[NSMutableDictionary alloc] init];
         _customEscapeSequenceNotifications = [[NSMutableDictionary alloc] init];
         _metalDisabledTokens = [[NSMutableSet alloc] init];
@@ -805,10 +909,9 @@ static const NSUInteger kMaxHosts = 100;
                                                  selector:@selector(coprocessChanged)
                                                      name:kCoprocessStatusChangeNotification
                                                    object:nil];
-        [[NSNotificationCenter defaultCenter] addObserver:self
-                                                 selector:@selector(sessionContentsChanged:)
-                                                     name:@"iTermTabContentsChanged"
-                                                   object:nil];
+        [iTermSessionContentsDidChangeNotification subscribe:self
+                                                     subject:self
+                                                    selector:@selector(sessionContentsChanged:)];
         [[NSNotificationCenter defaultCenter] addObserver:self
                                                  selector:@selector(synchronizeTmuxFonts:)
                                                      name:kTmuxFontChanged
@@ -829,6 +932,10 @@ static const NSUInteger kMaxHosts = 100;
                                                  selector:@selector(apiServerUnsubscribe:)
                                                      name:iTermRemoveAPIServerSubscriptionsNotification
                                                    object:nil];
+        [[NSNotificationCenter defaultCenter] addObserver:self
+                                                 selector:@selector(writeBufferDidDrain:)
+                                                     name:PTYSessionWriteBufferDidDrainNotification
+                                                   object:nil];
         // Detach before windows get closed. That's why we have to use the
         // iTermApplicationWillTerminate notification instead of
         // NSApplicationWillTerminate, since this gets run before the windows
@@ -873,6 +980,7 @@ static const NSUInteger kMaxHosts = 100;
 
         if (!synthetic) {
             [[NSNotificationCenter defaultCenter] postNotificationName:PTYSessionCreatedNotification object:self];
+            [[iTermSessionMemoryAccountant sharedInstance] addSession:self];
         }
         DLog(@"Done initializing new PTYSession %@", self);
     }
@@ -894,8 +1002,30 @@ ITERM_WEAKLY_REFERENCEABLE
     [self stopTailFind];  // This frees the substring in the tail find context, if needed.
     _shell.delegate = nil;
     dispatch_release(_executionSemaphore);
+    if (_tokenQueue) {
+        // Every enqueue schedules a drain that retains self, so nothing can be pending here.
+        assert(CVectorCount(&_pendingTokens) == 0);
+        CVectorDestroy(&_pendingTokens);
+        if (_fairShareTokenExecution) {
+            CTVectorDestroy(&_pendingBatchTokenCounts);
+            CTVectorDestroy(&_pendingBatchByteCounts);
+        }
+        dispatch_release(_tokenQueue);
+    }
+    if (_triggerQueue) {
+        // Pending evaluations retain self, so nothing can be queued here.
+        dispatch_release(_triggerQueue);
+    }
+    if (_tmuxClientWriteQueue) {
+        // Pending writes hold a weak reference to the pipe and the queue retains itself until
+        // they finish.
+        dispatch_release(_tmuxClientWriteQueue);
+    }
     [_colorMap release];
     [_triggers release];
+    [_triggerMatcher release];
+    [_partialLineTriggerString release];
+    [_partialLineTriggerCandidates release];
     [_pasteboard release];
     [_pbtext release];
     [_creationDate release];
@@ -952,6 +1082,7 @@ ITERM_WEAKLY_REFERENCEABLE
     [_keystrokeSubscriptions release];
     [_keyboardFilterSubscriptions release];
     [_updateSubscriptions release];
+    [_coalescedUpdateSubscriptions release];
     [_promptSubscriptions release];
     [_customEscapeSequenceNotifications release];
 
@@ -991,6 +1122,7 @@ ITERM_WEAKLY_REFERENCEABLE
     [_graphicSource release];
     [_jobPidRef release];
     [_customIcon release];
+    [_capturedOutputStore release];
     [_keyMapper release];
     [_badgeFontName release];
     [_variablesScope release];
@@ -1002,6 +1134,8 @@ ITERM_WEAKLY_REFERENCEABLE
     _logging.rawLogger = nil;
     _logging.plainLogger = nil;
     [_logging release];
+    [_ptyCapture close];
+    [_ptyCapture release];
     [_naggingController release];
     [_expect release];
     [_pasteBracketingOopsieExpectation release];
@@ -1155,6 +1289,11 @@ ITERM_WEAKLY_REFERENCEABLE
     [_textview setNeedsDisplay:YES];
 }
 
+// Any session's task may be a destination of our paste when broadcasting input.
+- (void)writeBufferDidDrain:(NSNotification *)notification {
+    [_pasteHelper destinationDidDrain];
+}
+
 + (void)drawArrangementPreview:(NSDictionary *)arrangement frame:(NSRect)frame dark:(BOOL)dark {
     Profile *theBookmark =
         [[ProfileModel sharedInstance] bookmarkWithGuid:arrangement[SESSION_ARRANGEMENT_BOOKMARK][KEY_GUID]];
@@ -1943,8 +2082,28 @@ ITERM_WEAKLY_REFERENCEABLE
     if (size.height <= 0) {
         size.height = 1;
     }
+    if (_waitingForReflow) {
+        DLog(@"Will set size to %@ after reflow finishes", VT100GridSizeDescription(size));
+        _sizeAfterReflow = size;
+        return;
+    }
+    if ([iTermAdvancedSettingsModel reflowScrollbackInBackground]) {
+        const BOOL started = [_screen prepareToResizeToWidth:size.width completion:^{
+            _waitingForReflow = NO;
+            if (!_exited) {
+                [self setSize:_sizeAfterReflow];
+            }
+        }];
+        if (started) {
+            DLog(@"Reflowing for %@ in the background", VT100GridSizeDescription(size));
+            _waitingForReflow = YES;
+            _sizeAfterReflow = size;
+            return;
+        }
+    }
     _savedGridSize = size;
     self.lastResize = [NSDate timeIntervalSinceReferenceDate];
+    [iTermAPIResponseCache invalidate];
     DLog(@"Set session %@ to %@", self, VT100GridSizeDescription(size));
     DLog(@"Before, range of visible lines is %@", VT100GridRangeDescription(_textview.rangeOfVisibleLines));
 
@@ -2761,10 +2920,22 @@ ITERM_WEAKLY_REFERENCEABLE
         if (newline) {
             _activityInfo.lastNewline = [NSDate it_timeSinceBoot];
         }
+        [self.ptyCapture recordInput:data];
         [_shell writeTask:data];
     }
 }
 
+- (BOOL)prepareToWriteBroadcastData:(NSData *)data {
+    if (self.tmuxMode == TMUX_CLIENT || _exited || _shell.pendingHighSurrogate) {
+        return NO;
+    }
+    [self.ptyCapture recordInput:data];
+    if (memchr(data.bytes, '\r', data.length) || memchr(data.bytes, '\n', data.length)) {
+        _activityInfo.lastNewline = [NSDate it_timeSinceBoot];
+    }
+    return YES;
+}
+
 // Convert the string to the requested encoding. If the string is a lone surrogate, deal with it by
 // saving the high surrogate and then combining it with a subsequent low surrogate.
 - (NSData *)dataForInputString:(NSString *)string usingEncoding:(NSStringEncoding)encoding {
@@ -2929,13 +3100,21 @@ ITERM_WEAKLY_REFERENCEABLE
 // This is run in PTYTask's thread. It parses the input here and then queues an async task to run
 // in the main thread to execute the parsed tokens.
 - (void)threadedReadTask:(char *)buffer length:(int)length {
+    [self.ptyCapture recordOutput:buffer length:length];
+
     // Pass the input stream to the parser.
+    os_log_t signpostLog = iTermSignpostLog();
+    const os_signpost_id_t spid = os_signpost_id_generate(signpostLog);
+    os_signpost_interval_begin(signpostLog, spid, "Parse", "keystroke=%llu bytes=%d", iTermSignpostCurrentKeystroke(), length);
+    const uint64_t token = iTermPerformanceCounterBegin(iTermPerformanceCounterParse);
     [_terminal.parser putStreamData:buffer length:length];
 
     // Parse the input stream into an array of tokens.
     CVector vector;
     CVectorCreate(&vector, 100);
     [_terminal.parser addParsedTokensToVector:&vector];
+    iTermPerformanceCounterEnd(iTermPerformanceCounterParse, token);
+    os_signpost_interval_end(signpostLog, spid, "Parse", "tokens=%d", CVectorCount(&vector));
 
     if (CVectorCount(&vector) == 0) {
         CVectorDestroy(&vector);
@@ -2944,17 +3123,26 @@ ITERM_WEAKLY_REFERENCEABLE
 
     @synchronized (self) {
         [_echoProbe updateEchoProbeStateWithTokenCVector:&vector];
+        if (_undrawnOutputTime == 0 && _useMetal && [iTermAdvancedSettingsModel measureMetalLatency]) {
+            _undrawnOutputTime = [NSDate timeIntervalSinceReferenceDate];
+        }
     }
 
     // This limits the number of outstanding execution blocks to prevent the main thread from
     // getting bogged down.
     dispatch_semaphore_wait(_executionSemaphore, DISPATCH_TIME_FOREVER);
 
+    if (_coalesceTokenExecution) {
+        [self threadedEnqueueTokens:&vector length:length];
+        return;
+    }
+
     [self retain];
     dispatch_retain(_executionSemaphore);
     dispatch_async(dispatch_get_main_queue(), ^{
-        if (_useAdaptiveFrameRate) {
+        if (_useAdaptiveFrameRate || _floodModeThreshold > 0) {
             [_throughputEstimator addByteCount:length];
+            [self updateFloodMode];
         }
         [self executeTokens:&vector bytesHandled:length];
         [_cadenceController didHandleInput];
@@ -2967,6 +3155,169 @@ ITERM_WEAKLY_REFERENCEABLE
     });
 }
 
+// Runs on the TaskNotifier thread. Appends a freshly parsed batch to the pending tokens and makes
+// sure a drain is scheduled. While the main thread is busy, later reads pile onto the same pending
+// vector, so there's a single main-queue block for all of them instead of one per read.
+- (void)threadedEnqueueTokens:(CVector *)vector length:(int)length {
+    __block BOOL needsDrain = NO;
+    dispatch_sync(_tokenQueue, ^{
+        const int n = CVectorCount(vector);
+        for (int i = 0; i < n; i++) {
+            CVectorAppend(&_pendingTokens, CVectorGet(vector, i));
+        }
+        _pendingTokensByteCount += length;
+        _pendingTokensBatchCount += 1;
+        if (_fairShareTokenExecution) {
+            CTVectorAppend(&_pendingBatchTokenCounts, n);
+            CTVectorAppend(&_pendingBatchByteCounts, length);
+        }
+        if (!_pendingTokensDrainScheduled) {
+            _pendingTokensDrainScheduled = YES;
+            needsDrain = YES;
+        }
+    });
+    CVectorDestroy(vector);
+    if (!needsDrain) {
+        return;
+    }
+    if (_fairShareTokenExecution) {
+        [[iTermTokenExecutionScheduler sharedInstance] scheduleClient:self];
+        return;
+    }
+
+    [self retain];
+    dispatch_retain(_executionSemaphore);
+    dispatch_async(dispatch_get_main_queue(), ^{
+        [self drainPendingTokens];
+        dispatch_release(_executionSemaphore);
+        [self release];
+    });
+}
+
+// Main thread. Executes every batch enqueued since the last drain.
+- (void)drainPendingTokens {
+    __block CVector vector;
+    __block int length = 0;
+    __block int batches = 0;
+    dispatch_sync(_tokenQueue, ^{
+        vector = _pendingTokens;
+        length = _pendingTokensByteCount;
+        batches = _pendingTokensBatchCount;
+        CVectorCreate(&_pendingTokens, MAX(100, CVectorCount(&vector)));
+        _pendingTokensByteCount = 0;
+        _pendingTokensBatchCount = 0;
+        _pendingTokensDrainScheduled = NO;
+    });
+
+    if (CVectorCount(&vector) > 0) {
+        if (_useAdaptiveFrameRate || _floodModeThreshold > 0) {
+            [_throughputEstimator addByteCount:length];
+            [self updateFloodMode];
+        }
+        // This takes ownership of the vector.
+        [self executeTokens:&vector bytesHandled:length];
+        [_cadenceController didHandleInput];
+    } else {
+        CVectorDestroy(&vector);
+    }
+
+    // Each batch took one unit of the semaphore. Give them all back so the reader can continue.
+    for (int i = 0; i < batches; i++) {
+        dispatch_semaphore_signal(_executionSemaphore);
+    }
+}
+
+#pragma mark - iTermTokenExecutionSchedulerClient
+
+// Main thread. Like drainPendingTokens but takes only the oldest tokens, up to the budgets. A batch
+// that doesn't fit is split, assuming its bytes are spread evenly over its tokens, and its
+// semaphore unit is given back only once all of it has been executed.
+- (BOOL)tokenExecutionSchedulerExecuteWithTokenBudget:(int)tokenBudget byteBudget:(int)byteBudget {
+    __block CVector vector;
+    __block int length = 0;
+    __block int batches = 0;
+    __block BOOL more = NO;
+    dispatch_sync(_tokenQueue, ^{
+        const int pendingBatches = CTVectorCount(&_pendingBatchTokenCounts);
+        int tokens = 0;
+        while (batches < pendingBatches && tokens < tokenBudget && length < byteBudget) {
+            const int batchTokens = CTVectorGet(&_pendingBatchTokenCounts, batches);
+            const int batchBytes = CTVectorGet(&_pendingBatchByteCounts, batches);
+            int take = MIN(batchTokens, tokenBudget - tokens);
+            if (batchBytes > byteBudget - length) {
+                take = MIN(take, (int)((long long)batchTokens * (byteBudget - length) / batchBytes));
+            }
+            if (take >= batchTokens) {
+                tokens += batchTokens;
+                length += batchBytes;
+                batches++;
+                continue;
+            }
+            // Take part of this batch. Always take at least one token so the turn makes progress.
+            take = MAX(1, take);
+            const int takeBytes = (int)((long long)batchBytes * take / batchTokens);
+            tokens += take;
+            length += takeBytes;
+            CTVectorSet(&_pendingBatchTokenCounts, batches, batchTokens - take);
+            CTVectorSet(&_pendingBatchByteCounts, batches, batchBytes - takeBytes);
+            break;
+        }
+
+        const int remainingTokens = CVectorCount(&_pendingTokens) - tokens;
+        if (remainingTokens == 0) {
+            vector = _pendingTokens;
+            CVectorCreate(&_pendingTokens, MAX(100, CVectorCount(&vector)));
+        } else {
+            CVectorCreate(&vector, MAX(100, tokens + 1));
+            memcpy(vector.elements, _pendingTokens.elements, tokens * sizeof(void *));
+            vector.count = tokens;
+            memmove(_pendingTokens.elements, _pendingTokens.elements + tokens, remainingTokens * sizeof(void *));
+            _pendingTokens.count = remainingTokens;
+        }
+
+        const int remainingBatches = pendingBatches - batches;
+        memmove(_pendingBatchTokenCounts.elements, _pendingBatchTokenCounts.elements + batches, remainingBatches * sizeof(int));
+        memmove(_pendingBatchByteCounts.elements, _pendingBatchByteCounts.elements + batches, remainingBatches * sizeof(int));
+        _pendingBatchTokenCounts.count = remainingBatches;
+        _pendingBatchByteCounts.count = remainingBatches;
+        _pendingTokensByteCount -= length;
+        _pendingTokensBatchCount -= batches;
+
+        // Clearing this in the same block that took the last batch guarantees that the next
+        // enqueue schedules this session again.
+        more = (remainingBatches > 0);
+        _pendingTokensDrainScheduled = more;
+    });
+
+    if (CVectorCount(&vector) > 0) {
+        if (_useAdaptiveFrameRate || _floodModeThreshold > 0) {
+            [_throughputEstimator addByteCount:length];
+            [self updateFloodMode];
+        }
+        // This takes ownership of the vector.
+        [self executeTokens:&vector bytesHandled:length];
+        [_cadenceController didHandleInput];
+    } else {
+        CVectorDestroy(&vector);
+    }
+
+    for (int i = 0; i < batches; i++) {
+        dispatch_semaphore_signal(_executionSemaphore);
+    }
+    return more;
+}
+
+// Echo of a recent keystroke matters most, then whatever the user is looking at.
+- (int)tokenExecutionSchedulerWeight {
+    if ([NSDate timeIntervalSinceReferenceDate] - _lastInput < 0.5) {
+        return 4;
+    }
+    if ([_delegate sessionIsActiveInTab:self] && _textview.window.isKeyWindow) {
+        return 2;
+    }
+    return 1;
+}
+
 - (void)synchronousReadTask:(NSString *)string {
     NSData *data = [string dataUsingEncoding:self.encoding];
     [_terminal.parser putStreamData:data.bytes length:data.length];
@@ -3002,6 +3353,7 @@ ITERM_WEAKLY_REFERENCEABLE
 - (void)executeTokens:(const CVector *)vector bytesHandled:(int)length {
     STOPWATCH_START(executing);
     DLog(@"Session %@ begins executing tokens", self);
+    [iTermAPIResponseCache invalidate];
     int n = CVectorCount(vector);
 
     if (_shell.paused || _copyModeHandler.enabled) {
@@ -3023,19 +3375,54 @@ ITERM_WEAKLY_REFERENCEABLE
         [self recycleQueuedTokens];
     }
 
+    os_log_t signpostLog = iTermSignpostLog();
+    const os_signpost_id_t spid = os_signpost_id_generate(signpostLog);
+    os_signpost_interval_begin(signpostLog, spid, "ExecuteTokens", "keystroke=%llu tokens=%d", iTermSignpostCurrentKeystroke(), n);
+    const uint64_t counterToken = iTermPerformanceCounterBegin(iTermPerformanceCounterExecuteTokens);
+    // Triggers read the screen after each line, so they need every line to pass through it.
+    const BOOL bulkAppendScrollingOutput = ([iTermAdvancedSettingsModel bulkAppendScrollingOutput] &&
+                                            !_triggers.count &&
+                                            !_expect.expectations.count);
+    const BOOL fuseAttributedRuns = ([iTermAdvancedSettingsModel fuseAttributedRuns] &&
+                                     !_triggers.count &&
+                                     !_expect.expectations.count);
     [_triggersSlownessDetector measureEvent:PTYSessionSlownessEventExecute block:^{
+        int retryIndex = 0;
+        int attributedRunRetryIndex = 0;
         for (int i = 0; i < n; i++) {
             if (![self shouldExecuteToken]) {
                 break;
             }
 
             VT100Token *token = CVectorGetObject(vector, i);
+            if (bulkAppendScrollingOutput && i >= retryIndex && token->type == VT100_ASCIISTRING) {
+                const int executed = [_screen executeScrollingOutputTokens:vector
+                                                                     start:i
+                                                                retryIndex:&retryIndex];
+                if (executed > 0) {
+                    i += executed - 1;
+                    continue;
+                }
+            }
+            if (fuseAttributedRuns &&
+                i >= attributedRunRetryIndex &&
+                (token->type == VT100CSI_SGR || token->type == VT100_ASCIISTRING)) {
+                const int executed = [_screen executeAttributedRunTokens:vector
+                                                                   start:i
+                                                              retryIndex:&attributedRunRetryIndex];
+                if (executed > 0) {
+                    i += executed - 1;
+                    continue;
+                }
+            }
             DLog(@"Execute token %@ cursor=(%d, %d)", token, _screen.cursorX - 1, _screen.cursorY - 1);
             [_terminal executeToken:token];
         }
     }];
+    iTermPerformanceCounterEnd(iTermPerformanceCounterExecuteTokens, counterToken);
 
     [self finishedHandlingNewOutputOfLength:length];
+    os_signpost_interval_end(signpostLog, spid, "ExecuteTokens");
 
     // When busy, we spend a lot of time performing recycleObject, so farm it
     // off to a background thread.
@@ -3043,7 +3430,7 @@ ITERM_WEAKLY_REFERENCEABLE
     dispatch_async(dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_BACKGROUND, 0), ^{
         for (int i = 0; i < n; i++) {
             VT100Token *token = CVectorGetObject(&temp, i);
-            [token release];
+            [token recycle];
         }
         CVectorDestroy(&temp);
     })
@@ -3061,6 +3448,7 @@ ITERM_WEAKLY_REFERENCEABLE
         _lastOutputIgnoringOutputAfterResizing = [NSDate timeIntervalSinceReferenceDate];
     }
     _newOutput = YES;
+    [_pasteHelper didReceiveOutputOfLength:length];
 
     // Make sure the screen gets redrawn soonish
     self.active = YES;
@@ -3082,10 +3470,60 @@ ITERM_WEAKLY_REFERENCEABLE
                           lineNumber:startAbsLineNumber];
 }
 
+// Flood mode is for when output arrives faster than anyone can read it. The screen redraws at a
+// low frame rate, and work that only matters to someone watching (partial-line triggers, instant
+// replay frames, accessibility notifications) waits until the flood subsides. Full-line triggers
+// still run, so nothing that a trigger must see is lost.
+- (void)updateFloodMode {
+    if (_floodModeThreshold <= 0) {
+        return;
+    }
+    const NSInteger throughput = _throughputEstimator.estimatedThroughput;
+    if (!_inFloodMode && throughput >= _floodModeThreshold) {
+        DLog(@"Enter flood mode at %@ bytes/sec", @(throughput));
+        _inFloodMode = YES;
+        _textview.deferNonessentialWork = YES;
+        [_cadenceController changeCadenceIfNeeded];
+        [self scheduleFloodModeCheck];
+    } else if (_inFloodMode && throughput < _floodModeThreshold / 2) {
+        DLog(@"Exit flood mode at %@ bytes/sec", @(throughput));
+        _inFloodMode = NO;
+        _textview.deferNonessentialWork = NO;
+        [_cadenceController changeCadenceIfNeeded];
+        [self checkPartialLineTriggers];
+    }
+}
+
+// Input stops arriving when the flood ends, so check periodically to notice that.
+- (void)scheduleFloodModeCheck {
+    __weak __typeof(self) weakSelf = self;
+    dispatch_after(dispatch_time(DISPATCH_TIME_NOW, (int64_t)(0.25 * NSEC_PER_SEC)), dispatch_get_main_queue(), ^{
+        [weakSelf floodModeCheckTimerDidFire];
+    });
+}
+
+- (void)floodModeCheckTimerDidFire {
+    if (!_inFloodMode) {
+        return;
+    }
+    [self updateFloodMode];
+    if (_inFloodMode) {
+        [self scheduleFloodModeCheck];
+    }
+}
+
 - (void)checkPartialLineTriggers {
     if (_triggerLineNumber == -1) {
         return;
     }
+    if (_inFloodMode) {
+        // Checked when flood mode ends.
+        return;
+    }
+    if (_triggerMatcher && [iTermAdvancedSettingsModel throttlePartialLineTriggers]) {
+        [self checkPartialLineTriggersIncrementally];
+        return;
+    }
     NSTimeInterval now = [NSDate timeIntervalSinceReferenceDate];
     if (now - _lastPartialLineTriggerCheck < kMinimumPartialLineTriggerCheckInterval) {
         return;
@@ -3099,16 +3537,82 @@ ITERM_WEAKLY_REFERENCEABLE
                           lineNumber:startAbsLineNumber];
 }
 
+// Like checkPartialLineTriggers, but backs off as throughput rises and skips triggers that can't
+// match because of what arrived since the last check. The full line is always checked when it
+// ends, so nothing is lost by checking partial lines less often.
+- (void)checkPartialLineTriggersIncrementally {
+    const NSInteger backoff = MAX(1, MIN(kMaximumPartialLineTriggerBackoff,
+                                         _throughputEstimator.estimatedThroughput / kPartialLineTriggerBackoffBytesPerSecond));
+    NSTimeInterval now = [NSDate timeIntervalSinceReferenceDate];
+    if (now - _lastPartialLineTriggerCheck < kMinimumPartialLineTriggerCheckInterval * backoff) {
+        return;
+    }
+    _lastPartialLineTriggerCheck = now;
+    long long startAbsLineNumber;
+    iTermStringLine *stringLine = [_screen stringLineAsStringAtAbsoluteLineNumber:_triggerLineNumber
+                                                                         startPtr:&startAbsLineNumber];
+    NSString *string = stringLine.stringValue;
+    const BOOL sameLine = (_partialLineTriggerString != nil &&
+                           _partialLineTriggerLineNumber == startAbsLineNumber);
+    if (sameLine && [string isEqualToString:_partialLineTriggerString]) {
+        DLog(@"Partial line unchanged since last check");
+        return;
+    }
+
+    NSIndexSet *candidates;
+    if (sameLine && [string hasPrefix:_partialLineTriggerString]) {
+        // Only literals that overlap the new text can be new. Triggers whose literal was already
+        // present stay candidates.
+        const NSUInteger oldLength = _partialLineTriggerString.length;
+        const NSUInteger overlap = MAX(1, _triggerMatcher.maximumLiteralLength) - 1;
+        const NSUInteger location = oldLength > overlap ? oldLength - overlap : 0;
+        NSMutableIndexSet *temp = [[[_triggerMatcher indexesOfRegexesThatMayMatchString:string
+                                                                              fromIndex:location] mutableCopy] autorelease];
+        [temp addIndexes:_partialLineTriggerCandidates];
+        candidates = temp;
+    } else {
+        candidates = [_triggerMatcher indexesOfRegexesThatMayMatchString:string];
+    }
+    [_partialLineTriggerString release];
+    _partialLineTriggerString = [string copy];
+    _partialLineTriggerLineNumber = startAbsLineNumber;
+    [_partialLineTriggerCandidates release];
+    _partialLineTriggerCandidates = [candidates retain];
+
+    [self checkTriggersOnPartialLine:YES
+                          stringLine:stringLine
+                          lineNumber:startAbsLineNumber
+                          candidates:candidates];
+}
+
+- (void)resetPartialLineTriggerState {
+    [_partialLineTriggerString release];
+    _partialLineTriggerString = nil;
+    [_partialLineTriggerCandidates release];
+    _partialLineTriggerCandidates = nil;
+}
+
 - (BOOL)shouldUseTriggers {
     if (![self.terminal softAlternateScreenMode]) {
         return YES;
     }
-    return [iTermProfilePreferences boolForKey:KEY_ENABLE_TRIGGERS_IN_INTERACTIVE_APPS inProfile:self.profile];
+    return _profileSnapshot.enableTriggersInInteractiveApps;
 }
 
 - (void)checkTriggersOnPartialLine:(BOOL)partial
                         stringLine:(iTermStringLine *)stringLine
                         lineNumber:(long long)startAbsLineNumber {
+    [self checkTriggersOnPartialLine:partial
+                          stringLine:stringLine
+                          lineNumber:startAbsLineNumber
+                          candidates:nil];
+}
+
+// |candidates| are the indexes of triggers that may match, if already known.
+- (void)checkTriggersOnPartialLine:(BOOL)partial
+                        stringLine:(iTermStringLine *)stringLine
+                        lineNumber:(long long)startAbsLineNumber
+                        candidates:(NSIndexSet *)candidates {
     DLog(@"partial=%@ startAbsLineNumber=%@", @(partial), @(startAbsLineNumber));
 
     if (![self shouldUseTriggers]) {
@@ -3118,10 +3622,13 @@ ITERM_WEAKLY_REFERENCEABLE
 
     // If the trigger causes the session to get released, don't crash.
     [[self retain] autorelease];
+    const uint64_t token = iTermPerformanceCounterBegin(iTermPerformanceCounterTriggers);
     [self reallyCheckTriggersOnPartialLine:partial
                                 stringLine:stringLine
                                 lineNumber:startAbsLineNumber
-                        requireIdempotency:NO];
+                        requireIdempotency:NO
+                                candidates:candidates];
+    iTermPerformanceCounterEnd(iTermPerformanceCounterTriggers, token);
 }
 
 
@@ -3129,7 +3636,23 @@ ITERM_WEAKLY_REFERENCEABLE
                               stringLine:(iTermStringLine *)stringLine
                               lineNumber:(long long)startAbsLineNumber
                       requireIdempotency:(BOOL)requireIdempotency {
-    for (iTermExpectation *expectation in [[_expect.expectations copy] autorelease]) {
+    [self reallyCheckTriggersOnPartialLine:partial
+                                stringLine:stringLine
+                                lineNumber:startAbsLineNumber
+                        requireIdempotency:requireIdempotency
+                                candidates:nil];
+}
+
+- (void)reallyCheckTriggersOnPartialLine:(BOOL)partial
+                              stringLine:(iTermStringLine *)stringLine
+                              lineNumber:(long long)startAbsLineNumber
+                      requireIdempotency:(BOOL)requireIdempotency
+                              candidates:(NSIndexSet *)knownCandidates {
+    for (iTermExpectation *expectation in [_expect expectationsThatMayMatchString:stringLine.stringValue]) {
+        if (expectation.hasCompleted) {
+            // Canceled by the completion of an earlier expectation.
+            continue;
+        }
         NSArray<NSString *> *capture = [stringLine.stringValue captureComponentsMatchedByRegex:expectation.regex];
         if (capture.count) {
             [expectation didMatchWithCaptureGroups:capture];
@@ -3139,12 +3662,29 @@ ITERM_WEAKLY_REFERENCEABLE
     // If a trigger changes the current profile then _triggers gets released and we should stop
     // processing triggers. This can happen with automatic profile switching.
     NSArray<Trigger *> *triggers = [[_triggers retain] autorelease];
+    // Throttling partial lines passes its own candidates, so the matcher is for prefiltering only.
+    iTermTriggerMatcher *matcher = nil;
+    if ([iTermAdvancedSettingsModel prefilterTriggers]) {
+        matcher = [[_triggerMatcher retain] autorelease];
+    }
+    if (!partial && !requireIdempotency && _triggersCanRunInBackground) {
+        [self checkTriggersInBackground:triggers
+                                matcher:matcher
+                             stringLine:stringLine
+                             lineNumber:startAbsLineNumber];
+        return;
+    }
 
     DLog(@"Start checking triggers");
     [_triggersSlownessDetector measureEvent:PTYSessionSlownessEventTriggers block:^{
-        for (Trigger *trigger in triggers) {
+        NSIndexSet *candidates = knownCandidates ?: [matcher indexesOfRegexesThatMayMatchString:stringLine.stringValue];
+        [triggers enumerateObjectsUsingBlock:^(Trigger *trigger, NSUInteger idx, BOOL *stopEnumerating) {
             if (requireIdempotency && !trigger.isIdempotent) {
-                continue;
+                return;
+            }
+            if (candidates && ![candidates containsIndex:idx]) {
+                [trigger didNotMatchPartialLine:partial];
+                return;
             }
             BOOL stop = [trigger tryString:stringLine
                                  inSession:self
@@ -3152,14 +3692,66 @@ ITERM_WEAKLY_REFERENCEABLE
                                 lineNumber:startAbsLineNumber
                           useInterpolation:_triggerParametersUseInterpolatedStrings];
             if (stop || _exited || (_triggers != triggers)) {
-                break;
+                *stopEnumerating = YES;
             }
-        }
+        }];
     }];
     [self maybeWarnAboutSlowTriggers];
     DLog(@"Finished checking triggers");
 }
 
+- (void)checkTriggersInBackground:(NSArray<Trigger *> *)triggers
+                          matcher:(iTermTriggerMatcher *)matcher
+                       stringLine:(iTermStringLine *)stringLine
+                       lineNumber:(long long)startAbsLineNumber {
+    const BOOL useInterpolation = _triggerParametersUseInterpolatedStrings;
+    dispatch_async(_triggerQueue, ^{
+        NSIndexSet *candidates = [matcher indexesOfRegexesThatMayMatchString:stringLine.stringValue];
+        // One array of matches per trigger, in the same order as |triggers|.
+        NSMutableArray<NSArray<iTermTriggerMatch *> *> *matches = [NSMutableArray arrayWithCapacity:triggers.count];
+        [triggers enumerateObjectsUsingBlock:^(Trigger *trigger, NSUInteger idx, BOOL *stop) {
+            if (trigger.disabled || (candidates && ![candidates containsIndex:idx])) {
+                [matches addObject:@[]];
+                return;
+            }
+            [matches addObject:[trigger matchesInStringLine:stringLine]];
+        }];
+        dispatch_async(dispatch_get_main_queue(), ^{
+            [self performTriggerMatches:matches
+                            forTriggers:triggers
+                             stringLine:stringLine
+                             lineNumber:startAbsLineNumber
+                       useInterpolation:useInterpolation];
+        });
+    });
+}
+
+- (void)performTriggerMatches:(NSArray<NSArray<iTermTriggerMatch *> *> *)matches
+                  forTriggers:(NSArray<Trigger *> *)triggers
+                   stringLine:(iTermStringLine *)stringLine
+                   lineNumber:(long long)startAbsLineNumber
+             useInterpolation:(BOOL)useInterpolation {
+    if (_exited || _triggers != triggers) {
+        DLog(@"Triggers changed since line %@ was matched. Drop its results.", @(startAbsLineNumber));
+        return;
+    }
+    [[self retain] autorelease];
+    [triggers enumerateObjectsUsingBlock:^(Trigger *trigger, NSUInteger idx, BOOL *stopEnumerating) {
+        if (matches[idx].count == 0) {
+            [trigger didNotMatchPartialLine:NO];
+            return;
+        }
+        const BOOL stop = [trigger performActionsForMatches:matches[idx]
+                                                   onString:stringLine
+                                                  inSession:self
+                                                 lineNumber:startAbsLineNumber
+                                           useInterpolation:useInterpolation];
+        if (stop || _exited || (_triggers != triggers)) {
+            *stopEnumerating = YES;
+        }
+    }];
+}
+
 - (void)maybeWarnAboutSlowTriggers {
     if (!_triggersSlownessDetector.enabled) {
         return;
@@ -3239,6 +3831,7 @@ ITERM_WEAKLY_REFERENCEABLE
         [self checkTriggers];
         _triggerLineNumber = -1;
     }
+    [self resetPartialLineTriggerState];
 }
 
 - (void)appendBrokenPipeMessage:(NSString *)unpaddedMessage {
@@ -3305,6 +3898,15 @@ ITERM_WEAKLY_REFERENCEABLE
     [self updateTTYSize];
 }
 
+- (void)taskWriteBufferDidDrain:(PTYTask *)task {
+    [[NSNotificationCenter defaultCenter] postNotificationName:PTYSessionWriteBufferDidDrainNotification
+                                                        object:self];
+}
+
+- (void)taskDidChangeSize:(PTYTask *)task width:(int)width height:(int)height {
+    [self.ptyCapture recordWidth:width height:height];
+}
+
 - (void)tmuxDidDisconnect {
     DLog(@"tmuxDidDisconnect");
     if (_exited) {
@@ -3337,6 +3939,8 @@ ITERM_WEAKLY_REFERENCEABLE
 - (void)cleanUpAfterBrokenPipe {
     _exited = YES;
     [_logging stop];
+    [self.ptyCapture close];
+    self.ptyCapture = nil;
     [[NSNotificationCenter defaultCenter] postNotificationName:PTYSessionTerminatedNotification object:self];
     [[NSNotificationCenter defaultCenter] postNotificationName:kCurrentSessionDidChange object:nil];
     [_delegate updateLabelAttributes];
@@ -4136,6 +4740,25 @@ ITERM_WEAKLY_REFERENCEABLE
             [_triggers addObject:trigger];
         }
     }
+    [_triggerMatcher release];
+    _triggerMatcher = nil;
+    [self resetPartialLineTriggerState];
+    // Partial-line throttling uses the matcher to tell what new text could change.
+    if ([iTermAdvancedSettingsModel prefilterTriggers] ||
+        [iTermAdvancedSettingsModel throttlePartialLineTriggers]) {
+        _triggerMatcher = [[iTermTriggerMatcher alloc] initWithRegexes:[_triggers mapWithBlock:^id(Trigger *trigger) {
+            return trigger.regex ?: @"";
+        }]];
+    }
+    // Partial-line triggers share per-line state with the synchronous partial-line checks, so
+    // they can't be matched out of order.
+    _triggersCanRunInBackground = ([iTermAdvancedSettingsModel runTriggersInBackground] &&
+                                   ![_triggers anyWithBlock:^BOOL(Trigger *trigger) {
+                                       return !trigger.disabled && (trigger.partialLine || trigger.needsSynchronousEvaluation);
+                                   }]);
+    if (_triggersCanRunInBackground && !_triggerQueue) {
+        _triggerQueue = dispatch_queue_create("com.iterm2.session-triggers", DISPATCH_QUEUE_SERIAL);
+    }
     _triggerParametersUseInterpolatedStrings = [iTermProfilePreferences boolForKey:KEY_TRIGGERS_USE_INTERPOLATED_STRINGS
                                                                          inProfile:aDict];
 
@@ -4271,7 +4894,7 @@ ITERM_WEAKLY_REFERENCEABLE
     if (_cursorTypeOverride) {
         return _cursorTypeOverride.integerValue;
     }
-    return [iTermProfilePreferences intForKey:KEY_CURSOR_TYPE inProfile:_profile];
+    return _profileSnapshot.cursorType;
 }
 
 - (void)invalidateStatusBar {
@@ -4927,6 +5550,7 @@ ITERM_WEAKLY_REFERENCEABLE
 
     [_profile release];
     _profile = [mutableProfile retain];
+    _profileSnapshot = iTermProfileSnapshotMake(_profile);
     [self profileNameDidChangeTo:self.profile[KEY_NAME]];
     [self invalidateBlend];
     [[_delegate realParentWindow] invalidateRestorableState];
@@ -5161,6 +5785,7 @@ ITERM_WEAKLY_REFERENCEABLE
 - (void)updateDisplayBecause:(NSString *)reason {
     DLog(@"updateDisplayBecause:%@ %@", reason, _cadenceController);
     _updateCount++;
+    [self updatePresentationSuspension];
     if (@available(macOS 10.11, *)) {
         if (_useMetal && _updateCount % 10 == 0) {
             iTermPreciseTimerSaveLog([NSString stringWithFormat:@"%@: updateDisplay interval", _view.driver.identifier],
@@ -5221,6 +5846,35 @@ ITERM_WEAKLY_REFERENCEABLE
     _timerRunning = NO;
 }
 
+// Sessions nobody can see (in a background tab, or in a minimized or fully covered window) don't
+// draw, render their badge, or let status bar components poll. Emulation, triggers, and API
+// notifications carry on, and everything is redrawn once the session can be seen again.
+- (void)updatePresentationSuspension {
+    const BOOL suspended = [self shouldSuspendPresentation];
+    if (suspended == _presentationSuspended) {
+        return;
+    }
+    DLog(@"%@ presentation for %@", suspended ? @"Suspend" : @"Resume", self);
+    _presentationSuspended = suspended;
+    _textview.presentationSuspended = suspended;
+    if (!suspended) {
+        [_cadenceController changeCadenceIfNeeded];
+    }
+}
+
+- (BOOL)shouldSuspendPresentation {
+    if (![iTermAdvancedSettingsModel suspendPresentationForHiddenSessions]) {
+        return NO;
+    }
+    if (![_delegate sessionBelongsToVisibleTab]) {
+        return YES;
+    }
+    NSWindow *window = self.view.window;
+    return (window == nil ||
+            window.isMiniaturized ||
+            !(window.occlusionState & NSWindowOcclusionStateVisible));
+}
+
 - (BOOL)shouldShowPasswordManagerAutomatically {
     return [iTermProfilePreferences boolForKey:KEY_OPEN_PASSWORD_MANAGER_AUTOMATICALLY
                                      inProfile:self.profile];
@@ -5308,6 +5962,9 @@ ITERM_WEAKLY_REFERENCEABLE
     [self.variablesScope setValue:processTitle forVariableNamed:iTermVariableKeySessionProcessTitle];
     [self.variablesScope setValue:processInfo.commandLine forVariableNamed:iTermVariableKeySessionCommandLine];
     [self.variablesScope setValue:@(processInfo.processID) forVariableNamed:iTermVariableKeySessionJobPid];
+    if (processInfo) {
+        _pwdPoller.foregroundJobProcessID = processInfo.processID;
+    }
 
     NSNumber *effectiveShellPID = _shell.tmuxClientProcessID ?: @(_shell.pid);
     if (!_exited && effectiveShellPID.intValue > 0) {
@@ -5460,6 +6117,7 @@ ITERM_WEAKLY_REFERENCEABLE
     [_keystrokeSubscriptions removeAllObjects];
     [_keyboardFilterSubscriptions removeAllObjects];
     [_updateSubscriptions removeAllObjects];
+    [_coalescedUpdateSubscriptions removeAllObjects];
     [_customEscapeSequenceNotifications removeAllObjects];
 }
 
@@ -5468,6 +6126,7 @@ ITERM_WEAKLY_REFERENCEABLE
     [_keystrokeSubscriptions removeObjectForKey:notification.object];
     [_keyboardFilterSubscriptions removeObjectForKey:notification.object];
     [_updateSubscriptions removeObjectForKey:notification.object];
+    [_coalescedUpdateSubscriptions removeObjectForKey:notification.object];
     [_customEscapeSequenceNotifications removeObjectForKey:notification.object];
 }
 
@@ -6027,6 +6686,20 @@ scrollToFirstResult:(BOOL)scrollToFirstResult {
     return _metalContext;
 }
 
+- (NSTimeInterval)metalGlueTakeKeystrokeTimestamp {
+    const NSTimeInterval result = _undrawnKeystrokeTime;
+    _undrawnKeystrokeTime = 0;
+    return result;
+}
+
+- (NSTimeInterval)metalGlueTakeOutputTimestamp {
+    @synchronized (self) {
+        const NSTimeInterval result = _undrawnOutputTime;
+        _undrawnOutputTime = 0;
+        return result;
+    }
+}
+
 + (CGColorSpaceRef)metalColorSpace {
     static dispatch_once_t onceToken;
     static CGColorSpaceRef colorSpace;
@@ -6577,6 +7250,13 @@ scrollToFirstResult:(BOOL)scrollToFirstResult {
         return;
     }
     [lastCommandMark addCapturedOutput:capturedOutput];
+    if ([iTermAdvancedSettingsModel storeCapturedOutputOutOfLine]) {
+        if (!_capturedOutputStore) {
+            _capturedOutputStore = [[iTermCapturedOutputStore alloc] init];
+        }
+        // This is either |capturedOutput| or the one it was merged into.
+        [lastCommandMark.capturedOutput.lastObject moveStringsToStore:_capturedOutputStore];
+    }
     [[NSNotificationCenter defaultCenter] postNotificationName:kPTYSessionCapturedOutputDidChange
                                                         object:nil];
 }
@@ -6773,6 +7453,11 @@ scrollToFirstResult:(BOOL)scrollToFirstResult {
     [_tmuxClientWritePipe release];
     _tmuxClientWritePipe = [[NSFileHandle alloc] initWithFileDescriptor:fds[1]
                                                          closeOnDealloc:YES];
+    if ([iTermAdvancedSettingsModel perPaneTmuxWriteQueues] && !_tmuxClientWriteQueue) {
+        // Writes for one pane stay in order since the queue is serial. TaskNotifier already
+        // parses each pane's pipe separately.
+        _tmuxClientWriteQueue = dispatch_queue_create("com.iterm2.tmuxPaneWrite", DISPATCH_QUEUE_SERIAL);
+    }
 }
 
 - (void)loadTmuxProcessID {
@@ -7059,6 +7744,11 @@ scrollToFirstResult:(BOOL)scrollToFirstResult {
                                     [[arrangement objectForKey:SESSION_ARRANGEMENT_ROWS] intValue])];
 }
 
+- (BOOL)sizeMatchesArrangement:(NSDictionary *)arrangement {
+    return ([[arrangement objectForKey:SESSION_ARRANGEMENT_COLUMNS] intValue] == _screen.width &&
+            [[arrangement objectForKey:SESSION_ARRANGEMENT_ROWS] intValue] == _screen.height);
+}
+
 - (BOOL)isCompatibleWith:(PTYSession *)otherSession
 {
     if (self.tmuxMode != TMUX_CLIENT && otherSession.tmuxMode != TMUX_CLIENT) {
@@ -7131,8 +7821,10 @@ scrollToFirstResult:(BOOL)scrollToFirstResult {
                                 _screen.height + [_screen numberOfScrollbackLines]);
     NSArray *notes = [_screen notesInRange:range];
     BOOL anyNoteIsVisible = NO;
+    const BOOL lazy = [iTermAdvancedSettingsModel attachNoteViewsLazily];
     for (PTYNoteViewController *note in notes) {
-        if (!note.view.isHidden) {
+        // Checking isNoteHidden avoids loading the views of notes that aren't on screen.
+        if (lazy ? !note.isNoteHidden : !note.view.isHidden) {
             anyNoteIsVisible = YES;
             break;
         }
@@ -7478,7 +8170,7 @@ scrollToFirstResult:(BOOL)scrollToFirstResult {
     // TaskNotifier has a chance to get its queue blocked when it reads the data. That limits the
     // rate that this can write, since it can only write after a %output is read.
     __weak NSFileHandle *handle = _tmuxClientWritePipe;
-    dispatch_async([[self class] tmuxQueue], ^{
+    dispatch_async(_tmuxClientWriteQueue ?: [[self class] tmuxQueue], ^{
         @try {
             [handle writeData:data];
         } @catch (NSException *exception) {
@@ -7501,6 +8193,11 @@ scrollToFirstResult:(BOOL)scrollToFirstResult {
         _tmuxTTLHasThresholds = NO;
         [self.tmuxController didPausePane:self.tmuxPane];
         if (allowAutomaticUnpause && [iTermPreferences boolForKey:kPreferenceKeyTmuxUnpauseAutomatically]) {
+            if ([iTermAdvancedSettingsModel prioritizeTmuxUnpausing]) {
+                [_tmuxController scheduleAutomaticUnpauseOfPane:self.tmuxPane
+                                                        visible:[self tmuxPaneIsVisible]];
+                return;
+            }
             __weak __typeof(self) weakSelf = self;
             dispatch_after(dispatch_time(DISPATCH_TIME_NOW, (int64_t)(1 * NSEC_PER_SEC)), dispatch_get_main_queue(), ^{
                 [weakSelf setTmuxPaused:NO allowAutomaticUnpause:YES];
@@ -7590,6 +8287,13 @@ scrollToFirstResult:(BOOL)scrollToFirstResult {
     [_tmuxController unpausePanes:@[ @(self.tmuxPane) ]];
 }
 
+- (BOOL)tmuxPaneIsVisible {
+    NSWindow *window = self.view.window;
+    return (window != nil &&
+            (window.occlusionState & NSWindowOcclusionStateVisible) &&
+            [_delegate sessionIsInSelectedTab:self]);
+}
+
 - (void)pauseTmux {
     [_tmuxController pausePanes:@[ @(self.tmuxPane) ]];
 }
@@ -7862,6 +8566,9 @@ scrollToFirstResult:(BOOL)scrollToFirstResult {
             }
         }
         _lastInput = [NSDate timeIntervalSinceReferenceDate];
+        if (_undrawnKeystrokeTime == 0 && _useMetal && [iTermAdvancedSettingsModel measureMetalLatency]) {
+            _undrawnKeystrokeTime = _lastInput;
+        }
         [_pwdPoller userDidPressKey];
         if ([_view.currentAnnouncement handleKeyDown:event]) {
             return NO;
@@ -8561,6 +9268,7 @@ scrollToFirstResult:(BOOL)scrollToFirstResult {
         return;
     }
     if (event.type == NSEventTypeKeyDown) {
+        iTermSignpostKeystrokeBegan();
         [self logKeystroke:event];
         [self resumeOutputIfNeeded];
 
@@ -8799,10 +9507,10 @@ scrollToFirstResult:(BOOL)scrollToFirstResult {
     if (![iTermAdvancedSettingsModel supportDecsetMetaSendsEscape]) {
         return NO;
     }
-    if ([[[self profile] objectForKey:KEY_OPTION_KEY_SENDS] intValue] == OPT_ESC) {
+    if (_profileSnapshot.leftOptionKey == OPT_ESC) {
         return NO;
     }
-    if ([[[self profile] objectForKey:KEY_RIGHT_OPTION_KEY_SENDS] intValue] == OPT_ESC) {
+    if (_profileSnapshot.rightOptionKey == OPT_ESC) {
         return NO;
     }
     return YES;
@@ -8811,23 +9519,22 @@ scrollToFirstResult:(BOOL)scrollToFirstResult {
 - (iTermOptionKeyBehavior)optionKey {
     if ([self shouldRespectTerminalMetaSendsEscape] &&
         self.terminal.metaSendsEscape &&
-        [iTermProfilePreferences boolForKey:KEY_LEFT_OPTION_KEY_CHANGEABLE inProfile:self.profile]) {
+        _profileSnapshot.leftOptionKeyChangeable) {
         return OPT_ESC;
     }
-    return [[[self profile] objectForKey:KEY_OPTION_KEY_SENDS] intValue];
+    return _profileSnapshot.leftOptionKey;
 }
 
 - (iTermOptionKeyBehavior)rightOptionKey {
     if ([self shouldRespectTerminalMetaSendsEscape] &&
         self.terminal.metaSendsEscape &&
-        [iTermProfilePreferences boolForKey:KEY_RIGHT_OPTION_KEY_CHANGEABLE inProfile:self.profile]) {
+        _profileSnapshot.rightOptionKeyChangeable) {
         return OPT_ESC;
     }
-    NSNumber *rightOptPref = [[self profile] objectForKey:KEY_RIGHT_OPTION_KEY_SENDS];
-    if (rightOptPref == nil) {
+    if (!_profileSnapshot.hasRightOptionKey) {
         return [self optionKey];
     }
-    return [rightOptPref intValue];
+    return _profileSnapshot.rightOptionKey;
 }
 
 - (BOOL)applicationKeypadAllowed
@@ -9044,9 +9751,7 @@ scrollToFirstResult:(BOOL)scrollToFirstResult {
 
 - (void)textViewPostTabContentsChangedNotification
 {
-    [[NSNotificationCenter defaultCenter] postNotificationName:@"iTermTabContentsChanged"
-                                                        object:self
-                                                      userInfo:nil];
+    [[iTermSessionContentsDidChangeNotification notificationWithSession:self] postCoalesced];
 }
 
 - (void)textViewInvalidateRestorableState {
@@ -9055,12 +9760,19 @@ scrollToFirstResult:(BOOL)scrollToFirstResult {
     }
 }
 
-- (void)textViewDidFindDirtyRects {
+- (void)textViewDidFindDirtyRectsOnLines:(NSIndexSet *)dirtyLines {
+    // Catches changes to the screen that didn't come from the terminal, like clearing the buffer.
+    [iTermAPIResponseCache invalidate];
     if (_updateSubscriptions.count) {
         ITMNotification *notification = [[[ITMNotification alloc] init] autorelease];
         notification.screenUpdateNotification = [[[ITMScreenUpdateNotification alloc] init] autorelease];
         notification.screenUpdateNotification.session = self.guid;
         [_updateSubscriptions enumerateKeysAndObjectsUsingBlock:^(id  _Nonnull key, ITMNotificationRequest * _Nonnull obj, BOOL * _Nonnull stop) {
+            iTermScreenUpdateSubscription *subscription = _coalescedUpdateSubscriptions[key];
+            if (subscription) {
+                [subscription addDirtyLines:dirtyLines];
+                return;
+            }
             [[iTermAPIHelper sharedInstance] postAPINotification:notification
                                                  toConnectionKey:key];
         }];
@@ -9600,7 +10312,7 @@ scrollToFirstResult:(BOOL)scrollToFirstResult {
 }
 
 - (BOOL)textViewShouldShowMarkIndicators {
-    return [iTermProfilePreferences boolForKey:KEY_SHOW_MARK_INDICATORS inProfile:_profile];
+    return _profileSnapshot.showMarkIndicators;
 }
 
 - (void)textViewThinksUserIsTryingToSendArrowKeysWithScrollWheel:(BOOL)isTrying {
@@ -9689,6 +10401,10 @@ scrollToFirstResult:(BOOL)scrollToFirstResult {
 }
 
 - (void)textViewNeedsDisplayInRect:(NSRect)rect {
+    if (_presentationSuspended) {
+        // The text view redraws everything when presentation resumes.
+        return;
+    }
     if (@available(macOS 10.11, *)) {
         NSRect visibleRect = NSIntersectionRect(rect, _textview.enclosingScrollView.documentVisibleRect);
         [_view setMetalViewNeedsDisplayInTextViewRect:visibleRect];
@@ -9838,11 +10554,11 @@ scrollToFirstResult:(BOOL)scrollToFirstResult {
 }
 
 - (CGFloat)textViewBadgeTopMargin {
-    return [iTermProfilePreferences floatForKey:KEY_BADGE_TOP_MARGIN inProfile:self.profile];
+    return _profileSnapshot.badgeTopMargin;
 }
 
 - (CGFloat)textViewBadgeRightMargin {
-    return [iTermProfilePreferences floatForKey:KEY_BADGE_RIGHT_MARGIN inProfile:self.profile];
+    return _profileSnapshot.badgeRightMargin;
 }
 
 - (iTermVariableScope *)textViewVariablesScope {
@@ -9940,11 +10656,11 @@ scrollToFirstResult:(BOOL)scrollToFirstResult {
 }
 
 - (BOOL)textViewTriggersAreEnabledInInteractiveApps {
-    return [iTermProfilePreferences boolForKey:KEY_ENABLE_TRIGGERS_IN_INTERACTIVE_APPS inProfile:self.profile];
+    return _profileSnapshot.enableTriggersInInteractiveApps;
 }
 
 - (iTermTimestampsMode)textviewTimestampsMode {
-    return (iTermTimestampsMode)[iTermProfilePreferences unsignedIntegerForKey:KEY_SHOW_TIMESTAMPS inProfile:self.profile];
+    return _profileSnapshot.timestampsMode;
 }
 
 - (void)textviewToggleTimestampsMode {
@@ -10175,7 +10891,12 @@ preferredEscaping:(iTermSendTextEscaping)preferredEscaping {
 
 - (void)uploadFiles:(NSArray *)localFilenames toPath:(SCPPath *)destinationPath
 {
-    SCPFile *previous = nil;
+    // Files are dealt round-robin into chains. Each chain uploads one file at a time over its own
+    // connection. The chains after the first start once the first file is uploaded.
+    const NSInteger concurrency = MAX(1, [iTermAdvancedSettingsModel scpUploadConcurrency]);
+    NSMutableArray<SCPFile *> *files = [NSMutableArray array];
+    NSMutableArray<SCPFile *> *lastFileInChain = [NSMutableArray array];
+    NSMutableArray<SCPFile *> *concurrentSuccessors = [NSMutableArray array];
     for (NSString *file in localFilenames) {
         SCPFile *scpFile = [[[SCPFile alloc] init] autorelease];
         scpFile.path = [[[SCPPath alloc] init] autorelease];
@@ -10185,10 +10906,21 @@ preferredEscaping:(iTermSendTextEscaping)preferredEscaping {
         scpFile.path.path = [destinationPath.path stringByAppendingPathComponent:filename];
         scpFile.localPath = file;
 
-        if (previous) {
-            previous.successor = scpFile;
+        const NSInteger chain = files.count % concurrency;
+        if (chain < lastFileInChain.count) {
+            lastFileInChain[chain].successor = scpFile;
+            lastFileInChain[chain] = scpFile;
+        } else {
+            if (chain > 0) {
+                scpFile.hasPredecessor = YES;
+                [concurrentSuccessors addObject:scpFile];
+            }
+            [lastFileInChain addObject:scpFile];
         }
-        previous = scpFile;
+        [files addObject:scpFile];
+    }
+    files.firstObject.concurrentSuccessors = concurrentSuccessors;
+    for (SCPFile *scpFile in files) {
         [scpFile upload];
     }
 }
@@ -10331,9 +11063,8 @@ preferredEscaping:(iTermSendTextEscaping)preferredEscaping {
     [self continueTailFind];
 }
 
-- (void)sessionContentsChanged:(NSNotification *)notification {
+- (void)sessionContentsChanged:(iTermSessionContentsDidChangeNotification *)notification {
     if (!_tailFindTimer &&
-        [notification object] == self &&
         [_delegate sessionBelongsToVisibleTab]) {
         [self beginTailFind];
     }
@@ -10459,7 +11190,7 @@ preferredEscaping:(iTermSendTextEscaping)preferredEscaping {
                                isPlainText:(BOOL)plainText {
     [self appendStringToTriggerLine:string];
     if (plainText && _logging.enabled && _logging.plainText && !self.isTmuxGateway) {
-        [_logging logData:[string dataUsingEncoding:_terminal.encoding]];
+        [_logging logString:string encoding:_terminal.encoding];
     }
 }
 
@@ -11803,13 +12534,11 @@ preferredEscaping:(iTermSendTextEscaping)preferredEscaping {
 }
 
 - (BOOL)screenShouldPlacePromptAtFirstColumn {
-    return [iTermProfilePreferences boolForKey:KEY_PLACE_PROMPT_AT_FIRST_COLUMN
-                                     inProfile:_profile];
+    return _profileSnapshot.placePromptAtFirstColumn;
 }
 
 - (BOOL)screenShouldPostTerminalGeneratedAlert {
-    return [iTermProfilePreferences boolForKey:KEY_SEND_TERMINAL_GENERATED_ALERT
-                                     inProfile:_profile];
+    return _profileSnapshot.sendTerminalGeneratedAlert;
 }
 
 - (void)resumeOutputIfNeeded {
@@ -12222,7 +12951,7 @@ preferredEscaping:(iTermSendTextEscaping)preferredEscaping {
 }
 
 - (BOOL)screenShouldReduceFlicker {
-    return [iTermProfilePreferences boolForKey:KEY_REDUCE_FLICKER inProfile:self.profile];
+    return _profileSnapshot.reduceFlicker;
 }
 
 - (NSInteger)screenUnicodeVersion {
@@ -12606,6 +13335,23 @@ preferredEscaping:(iTermSendTextEscaping)preferredEscaping {
     }
 }
 
+- (BOOL)pasteHelperDestinationsHaveRoom {
+    NSArray<PTYSession *> *destinations = @[ self ];
+    if ([[_delegate realParentWindow] broadcastInputToSession:self]) {
+        destinations = [[_delegate realParentWindow] broadcastSessions];
+    }
+    for (PTYSession *session in destinations) {
+        if (session.exited) {
+            continue;
+        }
+        if (![session.shell writeBufferHasRoomRequestingDrainNotification]) {
+            DLog(@"%@ has no room for more pasted input", session);
+            return NO;
+        }
+    }
+    return YES;
+}
+
 - (void)pasteHelperKeyDown:(NSEvent *)event {
     [_textview keyDown:event];
 }
@@ -13118,6 +13864,13 @@ preferredEscaping:(iTermSendTextEscaping)preferredEscaping {
     state.adaptiveFrameRateThroughputThreshold = _adaptiveFrameRateThroughputThreshold;
     state.slowFrameRate = self.useMetal ? [iTermAdvancedSettingsModel metalSlowFrameRate] : [iTermAdvancedSettingsModel slowFrameRate];
     state.liveResizing = _inLiveResize;
+    NSWindow *window = self.view.window;
+    state.occluded = window != nil && !(window.occlusionState & NSWindowOcclusionStateVisible);
+    state.focused = ([NSApp isActive] &&
+                     [NSApp keyWindow] == window &&
+                     [_delegate sessionIsActiveInSelectedTab:self]);
+    state.flooded = _inFloodMode;
+    state.floodFrameRate = [iTermAdvancedSettingsModel floodModeFrameRate];
     return state;
 }
 
@@ -13131,30 +13884,23 @@ preferredEscaping:(iTermSendTextEscaping)preferredEscaping {
     return self.view.window.sheets.count > 0;
 }
 
+- (NSScreen *)updateCadenceControllerScreen {
+    return self.view.window.screen;
+}
+
 #pragma mark - API
 
 - (NSString *)stringForLine:(screen_char_t *)screenChars
                      length:(int)length
                   cppsArray:(NSMutableArray<ITMCodePointsPerCell *> *)cppsArray {
     unichar *characters = iTermMalloc(sizeof(unichar) * length * kMaxParts + 1);
+    int *codeUnitsPerCell = iTermMalloc(sizeof(int) * MAX(1, length));
+    const int o = ScreenCharArrayToUnichars(screenChars, 0, length, YES, characters, NULL, codeUnitsPerCell);
     ITMCodePointsPerCell *cpps = [[[ITMCodePointsPerCell alloc] init] autorelease];
     cpps.numCodePoints = 1;
     cpps.repeats = 0;
-    int o = 0;
     for (int i = 0; i < length; ++i) {
-        int numCodePoints;
-
-        unichar c = screenChars[i].code;
-        if (!screenChars[i].complexChar && c >= ITERM2_PRIVATE_BEGIN && c <= ITERM2_PRIVATE_END) {
-            numCodePoints = 0;
-        } else if (screenChars[i].image) {
-            numCodePoints = 0;
-        } else {
-            const int len = ExpandScreenChar(&screenChars[i], characters + o);
-            o += len;
-            numCodePoints = len;
-        }
-
+        const int numCodePoints = codeUnitsPerCell[i];
         if (numCodePoints != cpps.numCodePoints && cpps.repeats > 0) {
             [cppsArray addObject:cpps];
             cpps = [[[ITMCodePointsPerCell alloc] init] autorelease];
@@ -13163,6 +13909,7 @@ preferredEscaping:(iTermSendTextEscaping)preferredEscaping {
         cpps.numCodePoints = numCodePoints;
         cpps.repeats = cpps.repeats + 1;
     }
+    free(codeUnitsPerCell);
     if (cpps.repeats > 0) {
         [cppsArray addObject:cpps];
     }
@@ -13206,16 +13953,8 @@ preferredEscaping:(iTermSendTextEscaping)preferredEscaping {
     return VT100GridAbsWindowedRangeMake(VT100GridAbsCoordRangeMake(0, range.location, 0, NSMaxRange(range)), 0, 0);
 }
 
-- (ITMGetBufferResponse *)handleGetBufferRequest:(ITMGetBufferRequest *)request {
-    ITMGetBufferResponse *response = [[[ITMGetBufferResponse alloc] init] autorelease];
-
-    const VT100GridAbsWindowedRange windowedRange = [self absoluteWindowedCoordRangeFromLineRange:request.lineRange];
-    if (windowedRange.coordRange.start.x < 0) {
-        response.status = ITMGetBufferResponse_Status_InvalidLineRange;
-        return nil;
-    }
-
-    const VT100GridWindowedRange range = VT100GridWindowedRangeFromVT100GridAbsWindowedRange(windowedRange, _screen.totalScrollbackOverflow);
+- (NSArray<ITMLineContents *> *)lineContentsInRange:(VT100GridWindowedRange)range {
+    NSMutableArray<ITMLineContents *> *result = [NSMutableArray array];
     iTermTextExtractor *extractor = [iTermTextExtractor textExtractorWithDataSource:_screen];
     __block int firstIndex = -1;
     __block int lastIndex = -1;
@@ -13235,7 +13974,7 @@ preferredEscaping:(iTermSendTextEscaping)preferredEscaping {
                 lineContents.continuation = ITMLineContents_Continuation_ContinuationSoftEol;
                 break;
         }
-        [response.contentsArray addObject:lineContents];
+        [result addObject:lineContents];
         firstIndex = lastIndex = -1;
         line = nil;
         return NO;
@@ -13256,6 +13995,72 @@ preferredEscaping:(iTermSendTextEscaping)preferredEscaping {
     if (line) {
         handleEol(EOL_SOFT, 0, 0);
     }
+    return result;
+}
+
+// Continuation tokens are opaque to clients. They hold what remains of the requested range in
+// absolute coordinates, so they stay valid as output arrives.
+- (NSString *)getBufferContinuationTokenForRange:(VT100GridAbsWindowedRange)range {
+    return [NSString stringWithFormat:@"1:%lld:%d:%lld:%d:%d",
+            range.coordRange.start.y,
+            range.coordRange.end.x,
+            range.coordRange.end.y,
+            range.columnWindow.location,
+            range.columnWindow.length];
+}
+
+- (BOOL)getWindowedRange:(VT100GridAbsWindowedRange *)rangePtr
+fromGetBufferContinuationToken:(NSString *)token {
+    NSArray<NSString *> *parts = [token componentsSeparatedByString:@":"];
+    if (parts.count != 6 || ![parts[0] isEqualToString:@"1"]) {
+        return NO;
+    }
+    const int location = parts[4].intValue;
+    const int length = parts[5].intValue;
+    // Pages always begin at the start of a line.
+    *rangePtr = VT100GridAbsWindowedRangeMake(VT100GridAbsCoordRangeMake(length > 0 ? location : 0,
+                                                                         parts[1].longLongValue,
+                                                                         parts[2].intValue,
+                                                                         parts[3].longLongValue),
+                                              location,
+                                              length);
+    return YES;
+}
+
+- (ITMGetBufferResponse *)handleGetBufferRequest:(ITMGetBufferRequest *)request {
+    ITMGetBufferResponse *response = [[[ITMGetBufferResponse alloc] init] autorelease];
+
+    VT100GridAbsWindowedRange windowedRange;
+    if (request.hasContinuationToken) {
+        if (![self getWindowedRange:&windowedRange fromGetBufferContinuationToken:request.continuationToken]) {
+            response.status = ITMGetBufferResponse_Status_RequestMalformed;
+            return response;
+        }
+        // Skip lines lost from the head of history since the previous page.
+        if (windowedRange.coordRange.start.y < _screen.totalScrollbackOverflow) {
+            windowedRange.coordRange.start.y = _screen.totalScrollbackOverflow;
+        }
+    } else {
+        windowedRange = [self absoluteWindowedCoordRangeFromLineRange:request.lineRange];
+    }
+    if (windowedRange.coordRange.start.x < 0) {
+        response.status = ITMGetBufferResponse_Status_InvalidLineRange;
+        return nil;
+    }
+
+    if (request.maxLines > 0) {
+        const long long pageEnd = windowedRange.coordRange.start.y + request.maxLines;
+        const VT100GridAbsCoord end = windowedRange.coordRange.end;
+        if (end.y > pageEnd || (end.y == pageEnd && end.x > 0)) {
+            VT100GridAbsWindowedRange remainder = windowedRange;
+            remainder.coordRange.start = VT100GridAbsCoordMake(0, pageEnd);
+            response.continuationToken = [self getBufferContinuationTokenForRange:remainder];
+            windowedRange.coordRange.end = VT100GridAbsCoordMake(0, pageEnd);
+        }
+    }
+
+    const VT100GridWindowedRange range = VT100GridWindowedRangeFromVT100GridAbsWindowedRange(windowedRange, _screen.totalScrollbackOverflow);
+    [response.contentsArray addObjectsFromArray:[self lineContentsInRange:range]];
     response.cursor = [[[ITMCoord alloc] init] autorelease];
     response.cursor.x = _screen.currentGrid.cursor.x;
     response.cursor.y = _screen.currentGrid.cursor.y + _screen.numberOfScrollbackLines + _screen.totalScrollbackOverflow;
@@ -13271,6 +14076,58 @@ preferredEscaping:(iTermSendTextEscaping)preferredEscaping {
     return response;
 }
 
+#pragma mark - iTermScreenUpdateSubscriptionDelegate
+
+- (void)screenUpdateSubscriptionShouldPost:(iTermScreenUpdateSubscription *)subscription {
+    ITMNotification *notification = [[[ITMNotification alloc] init] autorelease];
+    notification.screenUpdateNotification = [[[ITMScreenUpdateNotification alloc] init] autorelease];
+    notification.screenUpdateNotification.session = self.guid;
+    if (subscription.includeChangedLines) {
+        [self addChangedLinesForSubscription:subscription
+                              toNotification:notification.screenUpdateNotification];
+    }
+    [[iTermAPIHelper sharedInstance] postAPINotification:notification
+                                         toConnectionKey:subscription.connectionKey];
+}
+
+- (void)addChangedLinesForSubscription:(iTermScreenUpdateSubscription *)subscription
+                        toNotification:(ITMScreenUpdateNotification *)screenUpdateNotification {
+    const int height = _screen.height;
+    const long long overflow = [subscription takeOverflowWithScreenTop:_screen.numberOfScrollbackLines + _screen.totalScrollbackOverflow];
+    NSMutableIndexSet *lines = [[[subscription takeDirtyLines] mutableCopy] autorelease];
+    if (!lines) {
+        lines = [NSMutableIndexSet indexSetWithIndexesInRange:NSMakeRange(0, height)];
+    } else if (overflow > 0) {
+        // Lines that scrolled in since the last refresh haven't been reported dirty yet.
+        const int n = (int)MIN(overflow, height);
+        [lines addIndexesInRange:NSMakeRange(height - n, n)];
+    }
+    [lines removeIndexesInRange:NSMakeRange(height, NSNotFound - height)];
+
+    [lines enumerateRangesUsingBlock:^(NSRange range, BOOL * _Nonnull stop) {
+        const int firstLine = _screen.numberOfScrollbackLines + (int)range.location;
+        const VT100GridWindowedRange windowedRange =
+            VT100GridWindowedRangeMake(VT100GridCoordRangeMake(0, firstLine, 0, firstLine + (int)range.length),
+                                       0, 0);
+        NSArray<ITMLineContents *> *contents = [self lineContentsInRange:windowedRange];
+        [contents enumerateObjectsUsingBlock:^(ITMLineContents * _Nonnull lineContents, NSUInteger i, BOOL * _Nonnull stop) {
+            if (i >= range.length) {
+                *stop = YES;
+                return;
+            }
+            ITMScreenUpdateLine *line = [[[ITMScreenUpdateLine alloc] init] autorelease];
+            line.line = (int)(range.location + i);
+            line.contents = lineContents;
+            [screenUpdateNotification.changedLinesArray addObject:line];
+        }];
+    }];
+
+    screenUpdateNotification.cursor = [[[ITMCoord alloc] init] autorelease];
+    screenUpdateNotification.cursor.x = _screen.currentGrid.cursor.x;
+    screenUpdateNotification.cursor.y = _screen.currentGrid.cursor.y;
+    screenUpdateNotification.overflow = overflow;
+}
+
 - (void)handleListPromptsRequest:(ITMListPromptsRequest *)request completion:(void (^)(ITMListPromptsResponse *))completion {
     ITMListPromptsResponse *response = [[[ITMListPromptsResponse alloc] init] autorelease];
     [_screen enumeratePromptsFrom:request.hasFirstUniqueId ? request.firstUniqueId : nil
@@ -13638,6 +14495,10 @@ preferredEscaping:(iTermSendTextEscaping)preferredEscaping {
     return _activityInfo;
 }
 
+- (BOOL)statusBarPresentationIsSuspended {
+    return _presentationSuspended;
+}
+
 - (void)statusBarSetLayout:(nonnull iTermStatusBarLayout *)layout {
     ProfileModel *model;
     if (self.isDivorced && [_overriddenFields containsObject:KEY_STATUS_BAR_LAYOUT]) {
@@ -13806,6 +14667,10 @@ preferredEscaping:(iTermSendTextEscaping)preferredEscaping {
     return YES;
 }
 
+- (BOOL)workingDirectoryPollerHasPushedDirectory {
+    return _shouldExpectCurrentDirUpdates && self.lastLocalDirectoryWasPushed;
+}
+
 - (pid_t)workingDirectoryPollerProcessID {
     return _shell.pid;;
 }
@@ -14023,10 +14888,152 @@ preferredEscaping:(iTermSendTextEscaping)preferredEscaping {
                                                    target:self
                                                    action:@selector(addAnnotationWithCompletion:startX:startY:endX:endY:text:)];
         [_methods registerFunction:method namespace:@"iterm2"];
+
+        method = [[iTermBuiltInMethod alloc] initWithName:@"get_metal_stats"
+                                            defaultValues:@{}
+                                                    types:@{}
+                                        optionalArguments:[NSSet set]
+                                                  context:iTermVariablesSuggestionContextSession
+                                                   target:self
+                                                   action:@selector(getMetalStatsWithCompletion:)];
+        [_methods registerFunction:method namespace:@"iterm2"];
+
+        method = [[iTermBuiltInMethod alloc] initWithName:@"get_memory_usage"
+                                            defaultValues:@{}
+                                                    types:@{}
+                                        optionalArguments:[NSSet set]
+                                                  context:iTermVariablesSuggestionContextSession
+                                                   target:self
+                                                   action:@selector(getMemoryUsageWithCompletion:)];
+        [_methods registerFunction:method namespace:@"iterm2"];
+
+        method = [[iTermBuiltInMethod alloc] initWithName:@"start_pty_capture"
+                                            defaultValues:@{}
+                                                    types:@{ @"path": [NSString class] }
+                                        optionalArguments:[NSSet set]
+                                                  context:iTermVariablesSuggestionContextSession
+                                                   target:self
+                                                   action:@selector(startPtyCaptureWithCompletion:path:)];
+        [_methods registerFunction:method namespace:@"iterm2"];
+
+        method = [[iTermBuiltInMethod alloc] initWithName:@"stop_pty_capture"
+                                            defaultValues:@{}
+                                                    types:@{}
+                                        optionalArguments:[NSSet set]
+                                                  context:iTermVariablesSuggestionContextSession
+                                                   target:self
+                                                   action:@selector(stopPtyCaptureWithCompletion:)];
+        [_methods registerFunction:method namespace:@"iterm2"];
+
+        method = [[iTermBuiltInMethod alloc] initWithName:@"replay_pty_capture"
+                                            defaultValues:@{}
+                                                    types:@{ @"path": [NSString class],
+                                                             @"realTime": [NSNumber class] }
+                                        optionalArguments:[NSSet setWithArray:@[ @"realTime" ]]
+                                                  context:iTermVariablesSuggestionContextSession
+                                                   target:self
+                                                   action:@selector(replayPtyCaptureWithCompletion:path:realTime:)];
+        [_methods registerFunction:method namespace:@"iterm2"];
     }
     return _methods;
 }
 
+- (NSError *)ptyCaptureErrorWithDescription:(NSString *)description {
+    return [NSError errorWithDomain:@"com.iterm2.pty-capture"
+                               code:0
+                           userInfo:@{ NSLocalizedDescriptionKey: description }];
+}
+
+- (void)startPtyCaptureWithCompletion:(void (^)(id, NSError *))completion path:(NSString *)path {
+    iTermPtyCaptureWriter *capture = [[[iTermPtyCaptureWriter alloc] initWithPath:path.stringByExpandingTildeInPath] autorelease];
+    if (!capture) {
+        completion(nil, [self ptyCaptureErrorWithDescription:[NSString stringWithFormat:@"Could not create %@", path]]);
+        return;
+    }
+    [self.ptyCapture close];
+    [capture recordWidth:_screen.width height:_screen.height];
+    self.ptyCapture = capture;
+    completion(capture.path, nil);
+}
+
+- (void)stopPtyCaptureWithCompletion:(void (^)(id, NSError *))completion {
+    iTermPtyCaptureWriter *capture = [[self.ptyCapture retain] autorelease];
+    self.ptyCapture = nil;
+    [capture close];
+    completion(capture.path, nil);
+}
+
+// Feeds the output in a capture through the same path as output read from the pty. Reading from
+// the pty is paused meanwhile so the two don't interleave. Size changes resize the session, and
+// input is not replayed since it would go to whatever is running now. Completes with the number of
+// bytes replayed.
+- (void)replayPtyCaptureWithCompletion:(void (^)(id, NSError *))completion
+                                  path:(NSString *)path
+                              realTime:(NSNumber *)realTimeNumber {
+    iTermPtyCaptureReader *reader = [[[iTermPtyCaptureReader alloc] initWithPath:path.stringByExpandingTildeInPath] autorelease];
+    if (!reader) {
+        completion(nil, [self ptyCaptureErrorWithDescription:[NSString stringWithFormat:@"%@ is not a capture", path]]);
+        return;
+    }
+    if (_replayingPtyCapture || _shell.paused || _exited) {
+        completion(nil, [self ptyCaptureErrorWithDescription:@"Session can't replay a capture now"]);
+        return;
+    }
+    _replayingPtyCapture = YES;
+    _shell.paused = YES;
+    const BOOL realTime = realTimeNumber.boolValue;
+    void (^savedCompletion)(id, NSError *) = [[completion copy] autorelease];
+    [self retain];
+    [reader retain];
+    [savedCompletion retain];
+    dispatch_async(dispatch_get_global_queue(QOS_CLASS_USER_INITIATED, 0), ^{
+        __block NSUInteger bytes = 0;
+        [reader enumerateRecordsUsingBlock:^(iTermPtyCaptureRecordType type,
+                                             NSTimeInterval delay,
+                                             NSData *payload,
+                                             int width,
+                                             int height,
+                                             BOOL *stop) {
+            if (_exited) {
+                *stop = YES;
+                return;
+            }
+            if (realTime && delay > 0) {
+                // Long idle periods aren't interesting.
+                usleep(MIN(delay, 10) * 1000000);
+            }
+            switch (type) {
+                case iTermPtyCaptureRecordTypeOutput:
+                    [self threadedReadTask:(char *)payload.bytes length:(int)payload.length];
+                    bytes += payload.length;
+                    break;
+                case iTermPtyCaptureRecordTypeSize:
+                    dispatch_async(dispatch_get_main_queue(), ^{
+                        if (width > 0 && height > 0 && !self.isTmuxClient) {
+                            [[_delegate realParentWindow] sessionInitiatedResize:self
+                                                                           width:width
+                                                                          height:height];
+                        }
+                    });
+                    break;
+                case iTermPtyCaptureRecordTypeInput:
+                    break;
+            }
+        }];
+        dispatch_async(dispatch_get_main_queue(), ^{
+            _replayingPtyCapture = NO;
+            // Termination pauses the task too, and then it must stay paused.
+            if (_textview.delegate == self) {
+                _shell.paused = NO;
+            }
+            savedCompletion(@(bytes), nil);
+            [savedCompletion release];
+            [reader release];
+            [self release];
+        });
+    });
+}
+
 - (void)stopCoprocessWithCompletion:(void (^)(id, NSError *))completion {
     if (![self hasCoprocess]) {
         completion(@NO, nil);
@@ -14040,6 +15047,49 @@ preferredEscaping:(iTermSendTextEscaping)preferredEscaping {
     completion(_shell.coprocess.command, nil);
 }
 
+- (void)getMetalStatsWithCompletion:(void (^)(id, NSError *))completion {
+    iTermMetalDriver *driver = _view.driver;
+    if (!_useMetal || !driver) {
+        NSError *error = [NSError errorWithDomain:@"com.iterm2.metal-stats"
+                                             code:0
+                                         userInfo:@{ NSLocalizedDescriptionKey: @"Session is not using the Metal renderer" }];
+        completion(nil, error);
+        return;
+    }
+    [driver getLatencyStatsWithCompletion:^(NSDictionary<NSString *, id> *stats) {
+        completion(stats, nil);
+    }];
+}
+
+- (NSDictionary<NSString *, NSNumber *> *)memoryUsage {
+    NSMutableDictionary<NSString *, NSNumber *> *usage = [[[_screen memoryUsage] mutableCopy] autorelease];
+    usage[@"captured_output"] = @(_capturedOutputStore.byteCount);
+    NSInteger total = 0;
+    for (NSNumber *bytes in usage.allValues) {
+        total += bytes.integerValue;
+    }
+    usage[@"total"] = @(total);
+    return usage;
+}
+
+- (void)updateMemoryUsage {
+    self.variablesScope.memoryUsage = [self memoryUsage][@"total"];
+}
+
+- (void)getMemoryUsageWithCompletion:(void (^)(id, NSError *))completion {
+    NSMutableDictionary<NSString *, NSNumber *> *usage = [[[self memoryUsage] mutableCopy] autorelease];
+    iTermMetalDriver *driver = _view.driver;
+    if (!_useMetal || !driver) {
+        completion(usage, nil);
+        return;
+    }
+    [driver getGlyphTextureBytesWithCompletion:^(NSUInteger bytes) {
+        // Not part of the total because sessions with the same font share glyph textures.
+        usage[@"glyph_textures"] = @(bytes);
+        completion(usage, nil);
+    }];
+}
+
 - (void)runCoprocessWithCompletion:(void (^)(id, NSError *))completion
                        commandLine:(NSString *)command
                             mute:(NSNumber *)muteNumber {
@@ -14187,12 +15237,24 @@ preferredEscaping:(iTermSendTextEscaping)preferredEscaping {
             return response;
         }
         subscriptions[connectionKey] = request;
+        if (subscriptions == _updateSubscriptions && request.argumentsOneOfCase == ITMNotificationRequest_Arguments_OneOfCase_ScreenUpdateMonitorRequest) {
+            iTermScreenUpdateSubscription *subscription =
+                [[[iTermScreenUpdateSubscription alloc] initWithConnectionKey:connectionKey
+                                                                      request:request] autorelease];
+            subscription.delegate = self;
+            _coalescedUpdateSubscriptions[connectionKey] = subscription;
+            // Send the initial state of the screen.
+            [subscription invalidateAllLines];
+        }
     } else {
         if (!subscriptions[connectionKey]) {
             response.status = ITMNotificationResponse_Status_NotSubscribed;
             return response;
         }
         [subscriptions removeObjectForKey:connectionKey];
+        if (subscriptions == _updateSubscriptions) {
+            [_coalescedUpdateSubscriptions removeObjectForKey:connectionKey];
+        }
     }
 
     response.status = ITMNotificationResponse_Status_Ok;
@@ -14434,6 +15496,17 @@ preferredEscaping:(iTermSendTextEscaping)preferredEscaping {
     }
 }
 
+- (void)intervalTreeDidRemoveObjectsOnLines:(NSArray<NSIndexSet *> *)linesByType {
+    if (![iTermAdvancedSettingsModel showLocationsInScrollbar]) {
+        return;
+    }
+    if (@available(macOS 10.14, *)) {
+        [linesByType enumerateObjectsUsingBlock:^(NSIndexSet *lines, NSUInteger type, BOOL *stop) {
+            [_view.marksMinimap removeObjectsOfType:type fromLines:lines];
+        }];
+    }
+}
+
 - (void)intervalTreeVisibleRangeDidChange {
     [self updateMarksMinimapRangeOfVisibleLines];
 }
@@ -14450,6 +15523,16 @@ preferredEscaping:(iTermSendTextEscaping)preferredEscaping {
 
 #pragma mark - iTermTmuxControllerSession
 
+- (BOOL)tmuxControllerSessionWillUnpauseAutomatically {
+    if (!_tmuxPaused) {
+        return NO;
+    }
+    _tmuxPaused = NO;
+    [self dismissAnnouncementWithIdentifier:PTYSessionAnnouncementIdentifierTmuxPaused];
+    [self unzoomIfPossible];
+    return YES;
+}
+
 - (void)tmuxControllerSessionSetTTL:(NSTimeInterval)ttl redzone:(BOOL)redzone {
     if (_tmuxPaused) {
         return;
@@ -213,6 +213,11 @@ static void SetAgainstGrainDim(BOOL isVertical, NSSize *dest, CGFloat value) {
     BOOL _resizingSplit;
     iTermSwiftyString *_tabTitleOverrideSwiftyString;
 
+    // Nonzero while in -performBatchedLayout:. Sessions to fit are collected in
+    // _sessionsNeedingFit and fitted once when the outermost batch ends.
+    NSInteger _layoutBatchDepth;
+    NSMutableArray<PTYSession *> *_sessionsNeedingFit;
+
     NSInteger _numberOfSplitViewDragsInProgress;
 
     // If YES then force metal off. Does a hard reset when changing screens.
@@ -298,6 +303,20 @@ static void SetAgainstGrainDim(BOOL isVertical, NSSize *dest, CGFloat value) {
     [self _recursiveRegisterSessionsInArrangement:arrangement[TAB_ARRANGEMENT_ROOT]];
 }
 
++ (void)_recursivePrefetchContentsInArrangement:(NSDictionary *)arrangement {
+    if ([arrangement[TAB_ARRANGEMENT_VIEW_TYPE] isEqualToString:VIEW_TYPE_SPLITTER]) {
+        for (NSDictionary *subviewDict in arrangement[SUBVIEWS]) {
+            [self _recursivePrefetchContentsInArrangement:subviewDict];
+        }
+    } else {
+        [PTYSession prefetchContentsInArrangement:arrangement[TAB_ARRANGEMENT_SESSION]];
+    }
+}
+
++ (void)prefetchContentsInArrangement:(NSDictionary *)arrangement {
+    [self _recursivePrefetchContentsInArrangement:arrangement[TAB_ARRANGEMENT_ROOT]];
+}
+
 + (void)registerBuiltInFunctions {
     [iTermMoveTabToWindowBuiltInFunction registerBuiltInFunction];
 }
@@ -2240,12 +2259,41 @@ static void SetAgainstGrainDim(BOOL isVertical, NSSize *dest, CGFloat value) {
     } else {
         PtyLog(@"PTYTab setSize:%fx%f", (float)newSize.width, (float)newSize.height);
         [self dumpSubviewsOf:root_];
-        [root_ setFrameSize:newSize];
-        [self adjustSubviewsOf:root_];
-        [self _splitViewDidResizeSubviews:root_];
+        [self performBatchedLayout:^{
+            [root_ setFrameSize:newSize];
+            [self adjustSubviewsOf:root_];
+            [self _splitViewDidResizeSubviews:root_];
+        }];
     }
 }
 
+// Resizing nested split views posts a did-resize notification for each one, so without batching a
+// session can be fitted several times (and reflow its scrollback each time) for a single resize.
+// Within a batch, sessions are only collected. When it ends all their sizes are computed against
+// the final layout and then applied, once each.
+- (void)performBatchedLayout:(void (^ NS_NOESCAPE)(void))block {
+    if (![iTermAdvancedSettingsModel batchSplitPaneLayout]) {
+        block();
+        return;
+    }
+    _layoutBatchDepth++;
+    block();
+    _layoutBatchDepth--;
+    if (_layoutBatchDepth > 0 || _sessionsNeedingFit.count == 0) {
+        return;
+    }
+    NSArray<PTYSession *> *sessions = [_sessionsNeedingFit copy];
+    [_sessionsNeedingFit removeAllObjects];
+
+    NSArray<NSValue *> *sizes = [sessions mapWithBlock:^id(PTYSession *session) {
+        const NSSize size = [self sessionSizeForViewSize:session];
+        return [NSValue valueWithGridSize:VT100GridSizeMake(size.width, size.height)];
+    }];
+    [sessions enumerateObjectsUsingBlock:^(PTYSession *session, NSUInteger i, BOOL *stop) {
+        [self resizeSession:session toSize:sizes[i].gridSizeValue];
+    }];
+}
+
 - (void)_drawSession:(PTYSession *)session inImage:(NSImage *)viewImage atOrigin:(NSPoint)origin {
     NSImage *textviewImage = [session snapshot];
 
@@ -4151,11 +4199,16 @@ typedef struct {
                               forArrangement:(NSDictionary *)arrangement
 {
     assert(arrangement);
-    [view setNeedsDisplay:YES];
+    // When coalescing layout changes, views whose frame and grid size are unchanged are left
+    // alone so that resizing one pane doesn't resize and redraw all of them.
+    const BOOL onlyChanges = [iTermAdvancedSettingsModel coalesceTmuxLayoutChanges];
     if ([view isKindOfClass:[NSSplitView class]]) {
         NSDictionary *frameDict = [arrangement objectForKey:TAB_ARRANGEMENT_SPLITTER_FRAME];
         NSRect frame = [PTYTab dictToFrame:frameDict];
-        [view setFrame:frame];
+        if (!onlyChanges || !NSEqualRects(frame, view.frame)) {
+            [view setNeedsDisplay:YES];
+            [view setFrame:frame];
+        }
 
         int i = 0;
         NSArray *subarrangements = [arrangement objectForKey:SUBVIEWS];
@@ -4167,9 +4220,17 @@ typedef struct {
     } else {
         SessionView *sessionView = (SessionView *)view;
         PTYSession *theSession = [self sessionForSessionView:sessionView];
-        [theSession resizeFromArrangement:[arrangement objectForKey:TAB_ARRANGEMENT_SESSION]];
+        NSDictionary *sessionArrangement = [arrangement objectForKey:TAB_ARRANGEMENT_SESSION];
         assert([arrangement objectForKey:TAB_ARRANGEMENT_SESSIONVIEW_FRAME]);
         NSRect aFrame = [PTYTab dictToFrame:[arrangement objectForKey:TAB_ARRANGEMENT_SESSIONVIEW_FRAME]];
+        if (onlyChanges &&
+            NSEqualRects(aFrame, sessionView.frame) &&
+            [theSession sizeMatchesArrangement:sessionArrangement]) {
+            DLog(@"Layout of %@ is unchanged", theSession);
+            return;
+        }
+        [view setNeedsDisplay:YES];
+        [theSession resizeFromArrangement:sessionArrangement];
         [sessionView setFrame:aFrame];
         [[theSession view] updateTitleFrame];
     }
@@ -5852,7 +5913,16 @@ typedef struct {
                 PtyLog(@"splitViewDidResizeSubviews - view is %fx%f, ignore=%d", [subview frame].size.width, [subview frame].size.height, (int)[session ignoreResizeNotifications]);
                 if (![session ignoreResizeNotifications]) {
                     PtyLog(@"splitViewDidResizeSubviews - adjust session %p", session);
-                    [self fitSessionToCurrentViewSize:session];
+                    if (_layoutBatchDepth > 0 && ![session isTmuxClient]) {
+                        if (!_sessionsNeedingFit) {
+                            _sessionsNeedingFit = [[NSMutableArray alloc] init];
+                        }
+                        if (![_sessionsNeedingFit containsObject:session]) {
+                            [_sessionsNeedingFit addObject:session];
+                        }
+                    } else {
+                        [self fitSessionToCurrentViewSize:session];
+                    }
                 }
             }
         } else {
@@ -6185,7 +6255,7 @@ typedef struct {
         keysAffectingMetal = [[NSSet alloc] initWithArray:@[ kPreferenceKeyPerPaneBackgroundImage,
                                                              kPreferenceKeyUseMetal ]];
     });
-    if ([keysAffectingMetal containsObject:notification.key]) {
+    if ([keysAffectingMetal intersectsSet:notification.changedKeys]) {
         [self updateUseMetal];
     }
 }
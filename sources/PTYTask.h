@@ -33,6 +33,13 @@
 // Main thread
 - (void)taskDidRegister:(PTYTask *)task;
 
+// Main thread. Called after -writeBufferHasRoomRequestingDrainNotification returned NO, once the
+// write buffer has drained enough to accept more input.
+- (void)taskWriteBufferDidDrain:(PTYTask *)task;
+
+// Main thread. The pty's window size was just changed.
+- (void)taskDidChangeSize:(PTYTask *)task width:(int)width height:(int)height;
+
 @end
 
 typedef NS_ENUM(NSUInteger, iTermJobManagerForkAndExecStatus) {
@@ -157,6 +164,8 @@ typedef NS_OPTIONS(NSUInteger, iTermJobManagerAttachResults) {
 @property(atomic, readonly) BOOL wantsWrite;
 @property(atomic, retain) Coprocess *coprocess;
 @property(atomic, readonly) BOOL writeBufferHasRoom;
+// Like writeBufferHasRoom but if it returns NO the delegate gets taskWriteBufferDidDrain: later.
+@property(atomic, readonly) BOOL writeBufferHasRoomRequestingDrainNotification;
 @property(atomic, readonly) BOOL hasCoprocess;
 @property(nonatomic, readonly) BOOL passwordInput;
 @property(nonatomic) unichar pendingHighSurrogate;
@@ -1,4 +1,7 @@
 #define MAXRW 1024
+// Max bytes per write(2) when pipelineTaskWrites is on. A pty accepts much more than MAXRW at once
+// and coalescing many small writeTask: calls into one syscall is the point of pipelining.
+#define MAXRW_PIPELINED (64 * 1024)
 
 #import "Coprocess.h"
 #import "DebugLogging.h"
@@ -18,6 +21,8 @@
 #import "iTermMultiServerJobManager.h"
 #import "iTermOpenDirectory.h"
 #import "iTermOrphanServerAdopter.h"
+#import "iTermPerformanceCounters.h"
+#import "iTermSignposts.h"
 #import "iTermThreadSafety.h"
 #import "iTermTmuxJobManager.h"
 #import "NSDictionary+iTerm.h"
@@ -60,8 +65,12 @@ static void HandleSigChld(int n) {
     NSString* path;
     BOOL hasOutput;
 
-    NSLock* writeLock;  // protects writeBuffer
+    NSLock* writeLock;  // protects writeBuffer, _writeBufferOffset, and _wantsDrainNotification
     NSMutableData* writeBuffer;
+    // Bytes before this offset in writeBuffer have already been written. Only nonzero when
+    // pipelineTaskWrites is on; it saves moving the whole buffer after each write.
+    NSUInteger _writeBufferOffset;
+    BOOL _wantsDrainNotification;
 
 
     Coprocess *coprocess_;  // synchronized (self)
@@ -74,6 +83,7 @@ static void HandleSigChld(int n) {
     CGFloat _lastScaleFactor;
     PTYTaskSize _lastSize;
     NSTimeInterval _timeOfLastSizeChange;
+    NSTimeInterval _timeOfLastSizeRequest;
     BOOL _rateLimitedSetSizeToDesiredSizePending;
     BOOL _haveBumpedProcessCache;
     dispatch_queue_t _jobManagerQueue;
@@ -146,7 +156,7 @@ static void HandleSigChld(int n) {
         _paused = paused;
     }
     // Start/stop selecting on our FD
-    [[TaskNotifier sharedInstance] unblock];
+    [[TaskNotifier sharedInstance] unblockTask:self];
 }
 
 - (pid_t)pidToWaitOn {
@@ -214,13 +224,24 @@ static void HandleSigChld(int n) {
         coprocess_ = coprocess;
         self.hasMuteCoprocess = coprocess_.mute;
     }
-    [[TaskNotifier sharedInstance] unblock];
+    [[TaskNotifier sharedInstance] unblockTask:self];
 }
 
+static const NSUInteger kMaxWriteBufferSize = 1024 * 10;
+
 - (BOOL)writeBufferHasRoom {
-    const int kMaxWriteBufferSize = 1024 * 10;
     [writeLock lock];
-    BOOL hasRoom = [writeBuffer length] < kMaxWriteBufferSize;
+    BOOL hasRoom = [writeBuffer length] - _writeBufferOffset < kMaxWriteBufferSize;
+    [writeLock unlock];
+    return hasRoom;
+}
+
+- (BOOL)writeBufferHasRoomRequestingDrainNotification {
+    [writeLock lock];
+    BOOL hasRoom = [writeBuffer length] - _writeBufferOffset < kMaxWriteBufferSize;
+    if (!hasRoom) {
+        _wantsDrainNotification = YES;
+    }
     [writeLock unlock];
     return hasRoom;
 }
@@ -380,12 +401,64 @@ static void HandleSigChld(int n) {
     // Lock to protect the writeBuffer from the IO thread
     id<iTermJobManager> jobManager = self.jobManager;
     assert(!jobManager || !self.jobManager.isReadOnly);
+    if ([iTermAdvancedSettingsModel writeKeystrokesDirectly] && [self writeDirectly:data]) {
+        return;
+    }
+    if ([iTermAdvancedSettingsModel pipelineTaskWrites]) {
+        [writeLock lock];
+        const BOOL wasEmpty = [writeBuffer length] == _writeBufferOffset;
+        [writeBuffer appendData:data];
+        [writeLock unlock];
+        // If the buffer wasn't empty the notifier is already selecting on our fd for writing.
+        if (wasEmpty) {
+            [[TaskNotifier sharedInstance] unblockTask:self];
+        }
+        return;
+    }
     [writeLock lock];
     [writeBuffer appendData:data];
-    [[TaskNotifier sharedInstance] unblock];
+    [[TaskNotifier sharedInstance] unblockTask:self];
     [writeLock unlock];
 }
 
+// Writes small amounts of data on the calling thread when nothing is queued ahead of it, which
+// saves the round trip through the TaskNotifier thread for a keystroke. Returns NO without doing
+// anything when the data must be queued instead. Errors are left for processWrite to discover.
+- (BOOL)writeDirectly:(NSData *)data {
+    if (data.length > MAXRW || self.paused || !self.jobManager.ioAllowed) {
+        return NO;
+    }
+    const int fd = self.fd;
+    if (fd < 0) {
+        return NO;
+    }
+    [writeLock lock];
+    if ([writeBuffer length] > _writeBufferOffset) {
+        [writeLock unlock];
+        return NO;
+    }
+    os_log_t signpostLog = iTermSignpostLog();
+    const os_signpost_id_t spid = os_signpost_id_generate(signpostLog);
+    os_signpost_interval_begin(signpostLog, spid, "Write", "keystroke=%llu direct", iTermSignpostCurrentKeystroke());
+    const ssize_t written = write(fd, data.bytes, data.length);
+    if (written < 0) {
+        os_signpost_interval_end(signpostLog, spid, "Write");
+        [writeLock unlock];
+        return NO;
+    }
+    iTermSignpostKeystrokeWritten();
+    os_signpost_interval_end(signpostLog, spid, "Write");
+    const BOOL partial = written < data.length;
+    if (partial) {
+        [writeBuffer appendBytes:(const char *)data.bytes + written length:data.length - written];
+    }
+    [writeLock unlock];
+    if (partial) {
+        [[TaskNotifier sharedInstance] unblockTask:self];
+    }
+    return YES;
+}
+
 - (void)killWithMode:(iTermJobManagerKillingMode)mode {
     [self.jobManager killWithMode:mode];
     if (_tmuxClientProcessID) {
@@ -458,6 +531,7 @@ static void HandleSigChld(int n) {
     int bytesRead = 0;
 
     char buffer[MAXRW * iterations];
+    const uint64_t token = iTermPerformanceCounterBegin(iTermPerformanceCounterRead);
     for (int i = 0; i < iterations; ++i) {
         // Only read up to MAXRW*iterations bytes, then release control
         ssize_t n = read(self.fd, buffer + bytesRead, MAXRW);
@@ -465,6 +539,7 @@ static void HandleSigChld(int n) {
             // There was a read error.
             if (errno != EAGAIN && errno != EINTR) {
                 // It was a serious error.
+                iTermPerformanceCounterEnd(iTermPerformanceCounterRead, token);
                 [self brokenPipe];
                 return;
             } else {
@@ -482,6 +557,7 @@ static void HandleSigChld(int n) {
             break;
         }
     }
+    iTermPerformanceCounterEnd(iTermPerformanceCounterRead, token);
 
     hasOutput = YES;
 
@@ -490,6 +566,19 @@ static void HandleSigChld(int n) {
 }
 
 - (void)processWrite {
+    os_log_t signpostLog = iTermSignpostLog();
+    const os_signpost_id_t spid = os_signpost_id_generate(signpostLog);
+    os_signpost_interval_begin(signpostLog, spid, "Write", "keystroke=%llu", iTermSignpostCurrentKeystroke());
+    if ([iTermAdvancedSettingsModel pipelineTaskWrites]) {
+        [self processPipelinedWrite];
+    } else {
+        [self processUnpipelinedWrite];
+    }
+    iTermSignpostKeystrokeWritten();
+    os_signpost_interval_end(signpostLog, spid, "Write");
+}
+
+- (void)processUnpipelinedWrite {
     // Retain to prevent the object from being released during this method
     // Lock to protect the writeBuffer from the main thread
     [writeLock lock];
@@ -516,6 +605,46 @@ static void HandleSigChld(int n) {
     [writeLock unlock];
 }
 
+- (void)processPipelinedWrite {
+    [writeLock lock];
+
+    char *ptr = (char *)[writeBuffer mutableBytes] + _writeBufferOffset;
+    const NSUInteger length = MIN([writeBuffer length] - _writeBufferOffset, MAXRW_PIPELINED);
+    ssize_t written = write(self.fd, ptr, length);
+
+    BOOL notify = NO;
+    if ((written < 0) && (!(errno == EAGAIN || errno == EINTR))) {
+        [self brokenPipe];
+    } else if (written > 0) {
+        _writeBufferOffset += written;
+        const NSUInteger remaining = [writeBuffer length] - _writeBufferOffset;
+        if (remaining == 0) {
+            [writeBuffer setLength:0];
+            _writeBufferOffset = 0;
+        } else if (_writeBufferOffset >= remaining) {
+            // Compact once the consumed prefix is at least as big as what's left so the cost of
+            // moving bytes stays linear in the number of bytes written.
+            memmove([writeBuffer mutableBytes], ptr + written, remaining);
+            [writeBuffer setLength:remaining];
+            _writeBufferOffset = 0;
+        }
+        if (_wantsDrainNotification && remaining < kMaxWriteBufferSize / 2) {
+            _wantsDrainNotification = NO;
+            notify = YES;
+        }
+    }
+
+    [writeLock unlock];
+
+    if (notify) {
+        __weak __typeof(self) weakSelf = self;
+        dispatch_async(dispatch_get_main_queue(), ^{
+            PTYTask *strongSelf = weakSelf;
+            [strongSelf.delegate taskWriteBufferDidDrain:strongSelf];
+        });
+    }
+}
+
 - (void)stopCoprocess {
     pid_t thePid = 0;
     @synchronized (self) {
@@ -884,7 +1013,7 @@ static void HandleSigChld(int n) {
         return NO;
     }
     [writeLock lock];
-    const BOOL wantsWrite = [writeBuffer length] > 0;
+    const BOOL wantsWrite = [writeBuffer length] > _writeBufferOffset;
     [writeLock unlock];
     if (!wantsWrite) {
         return NO;
@@ -909,7 +1038,7 @@ static void HandleSigChld(int n) {
 
     @synchronized (self) {
         if (coprocess_) {
-            [coprocess_.outputBuffer appendData:[NSData dataWithBytes:buffer length:length]];
+            [coprocess_ appendOutputBytes:buffer length:length];
         }
     }
 }
@@ -927,6 +1056,7 @@ static void HandleSigChld(int n) {
 
 - (void)rateLimitedSetSizeToDesiredSize {
     DLog(@"%@", self.delegate);
+    _timeOfLastSizeRequest = [NSDate timeIntervalSinceReferenceDate];
     if (_rateLimitedSetSizeToDesiredSizePending) {
         DLog(@"Already have a pending size change");
         return;
@@ -938,16 +1068,29 @@ static void HandleSigChld(int n) {
         // change. For example, issue 5096 and 4494.
         _rateLimitedSetSizeToDesiredSizePending = YES;
         DLog(@" ** Rate limiting **");
-        dispatch_after(dispatch_time(DISPATCH_TIME_NOW, (int64_t)(kDelayBetweenSizeChanges * NSEC_PER_SEC)), dispatch_get_main_queue(), ^{
-            DLog(@"Have waited %@ sec", @(kDelayBetweenSizeChanges));
-            self->_rateLimitedSetSizeToDesiredSizePending = NO;
-            [self setTerminalSizeToDesiredSize];
-        });
+        [self setTerminalSizeToDesiredSizeAfterDelay:kDelayBetweenSizeChanges];
     } else {
         [self setTerminalSizeToDesiredSize];
     }
 }
 
+- (void)setTerminalSizeToDesiredSizeAfterDelay:(NSTimeInterval)delay {
+    dispatch_after(dispatch_time(DISPATCH_TIME_NOW, (int64_t)(delay * NSEC_PER_SEC)), dispatch_get_main_queue(), ^{
+        DLog(@"Have waited %@ sec", @(delay));
+        if ([iTermAdvancedSettingsModel batchSplitPaneLayout]) {
+            // Debounce: during a live resize, wait until the size stops changing so the job gets
+            // one SIGWINCH with the final size instead of one every few frames.
+            const NSTimeInterval quiet = [NSDate timeIntervalSinceReferenceDate] - self->_timeOfLastSizeRequest;
+            if (quiet < delay) {
+                [self setTerminalSizeToDesiredSizeAfterDelay:delay - quiet];
+                return;
+            }
+        }
+        self->_rateLimitedSetSizeToDesiredSizePending = NO;
+        [self setTerminalSizeToDesiredSize];
+    });
+}
+
 - (void)setTerminalSizeToDesiredSize {
     DLog(@"Set size of %@ from (%@x%@ cells, %@x%@px) to (%@x%@ cells, %@x%@ px)",
          self.delegate,
@@ -964,6 +1107,9 @@ static void HandleSigChld(int n) {
     _lastSize = _desiredSize;
 
     iTermSetTerminalSize(self.fd, _desiredSize);
+    [self.delegate taskDidChangeSize:self
+                               width:_desiredSize.cellSize.width
+                              height:_desiredSize.cellSize.height];
 }
 
 #pragma mark - iTermLoggingHelper
@@ -253,12 +253,23 @@ static const NSUInteger kRectangularSelectionModifierMask = (kRectangularSelecti
         if (changedUnderline || cursorChanged) {
             [self setNeedsDisplay:YES];
         }
+        [_urlActionHelper invalidateHoverCache];
         return;
     }
 
+    if ([iTermAdvancedSettingsModel cancelableCmdHoverURLLookup] &&
+        [self hasUnderline] &&
+        !VT100GridWindowedRangeContainsCoord(VT100GridWindowedRangeFromAbsWindowedRange(self.drawingHelper.underlinedRange,
+                                                                                        self.dataSource.totalScrollbackOverflow),
+                                             coord)) {
+        // Don't leave the old underline up while looking up the new position.
+        [self removeUnderline];
+        [self setNeedsDisplay:YES];
+    }
+
     __weak __typeof(self) weakSelf = self;
     DLog(@"updateUnderlinedURLs in screen:\n%@", [self.dataSource compactLineDumpWithContinuationMarks]);
-    [_urlActionHelper urlActionForClickAtCoord:coord completion:^(URLAction *action) {
+    [_urlActionHelper urlActionForHoverAtCoord:coord completion:^(URLAction *action) {
         [weakSelf finishUpdatingUnderlinesWithAction:action
                                                event:event];
     }];
@@ -585,6 +596,14 @@ static const NSUInteger kRectangularSelectionModifierMask = (kRectangularSelecti
     return self.dataSource.totalScrollbackOverflow;
 }
 
+- (int)urlActionHelperWidth:(iTermURLActionHelper *)helper {
+    return self.dataSource.width;
+}
+
+- (NSInteger)urlActionHelper:(iTermURLActionHelper *)helper generationForLine:(int)line {
+    return [self.dataSource generationForLine:line];
+}
+
 - (VT100RemoteHost *)urlActionHelper:(iTermURLActionHelper *)helper remoteHostOnLine:(int)y {
     return [self.dataSource remoteHostOnLine:y];
 }
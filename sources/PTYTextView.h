@@ -143,7 +143,8 @@ preferredEscaping:(iTermSendTextEscaping)preferredEscaping;
 - (void)textViewStopCoprocess;
 - (void)textViewPostTabContentsChangedNotification;
 - (void)textViewInvalidateRestorableState;
-- (void)textViewDidFindDirtyRects;
+// Lines are screen-relative.
+- (void)textViewDidFindDirtyRectsOnLines:(NSIndexSet *)dirtyLines;
 - (void)textViewBeginDrag;
 - (void)textViewMovePane;
 - (void)textViewSwapPane;
@@ -417,6 +418,15 @@ typedef void (^PTYTextViewDrawingHookBlock)(iTermTextDrawingHelper *);
 @property (nonatomic, readonly) NSArray<iTermHighlightedRow *> *highlightedRows;
 
 @property (nonatomic) BOOL suppressDrawing;
+
+// While set, refreshes don't record instant replay frames or post accessibility notifications.
+// Clearing it catches both up.
+@property (nonatomic) BOOL deferNonessentialWork;
+
+// Set while nobody can see this view. Refreshes skip blink scanning, note layout,
+// accessibility, and badge rendering but still track scrollback and report changes. Clearing it
+// redraws everything once.
+@property (nonatomic) BOOL presentationSuspended;
 @property (nonatomic, readonly) long long firstVisibleAbsoluteLineNumber;
 @property (nonatomic) BOOL useNativePowerlineGlyphs;
 
@@ -502,6 +512,7 @@ typedef void (^PTYTextViewDrawingHookBlock)(iTermTextDrawingHelper *);
 
 // Remove underline indicating clickable URL. Returns if it changed.
 - (BOOL)removeUnderline;
+- (BOOL)hasUnderline;
 
 // Update the scroll position and schedule a redraw. Returns true if anything
 // onscreen is blinking.
@@ -10,6 +10,7 @@
 #import "iTermAdvancedSettingsModel.h"
 #import "iTermApplicationDelegate.h"
 #import "iTermBadgeLabel.h"
+#import "iTermChunkedTextCopier.h"
 #import "iTermColorMap.h"
 #import "iTermController.h"
 #import "iTermCPS.h"
@@ -21,6 +22,7 @@
 #import "iTermLaunchServices.h"
 #import "iTermMetalClipView.h"
 #import "iTermMouseCursor.h"
+#import "iTermPerformanceCounters.h"
 #import "iTermPreferences.h"
 #import "iTermPrintAccessoryViewController.h"
 #import "iTermQuickLookController.h"
@@ -90,6 +92,9 @@
 
 #import <WebKit/WebKit.h>
 
+// Selections with at least this many cells are copied with iTermChunkedTextCopier, if enabled.
+static const long long kMinimumSelectionLengthForChunkedCopy = 4 * 1024 * 1024;
+
 @implementation iTermHighlightedRow
 
 - (instancetype)initWithAbsoluteLineNumber:(long long)row success:(BOOL)success {
@@ -111,6 +116,13 @@
     // -refresh does not want to be reentrant.
     BOOL _inRefresh;
 
+    // Something changed while deferNonessentialWork was set.
+    BOOL _deferredWorkPending;
+
+    // Work skipped while presentationSuspended was set.
+    BOOL _badgeLabelNeedsRecompute;
+    BOOL _findOnPageLocationsChangedWhileSuspended;
+
     // geometry
     double _lineHeight;
     double _charWidth;
@@ -148,6 +160,9 @@
     // Show a background indicator when in broadcast input mode
     BOOL _showStripesWhenBroadcastingInput;
 
+    // _primaryFont and _secondaryFont are shared with other sessions and must not be modified.
+    BOOL _usingSharedFontInfo;
+
     iTermTextViewAccessibilityHelper *_accessibilityHelper;
     iTermBadgeLabel *_badgeLabel;
 
@@ -159,6 +174,9 @@
     iTermScrollAccumulator *_scrollAccumulator;
 
     iTermRateLimitedUpdate *_shadowRateLimit;
+
+    // Extracts a huge selection for the pasteboard after -copy: returns.
+    iTermChunkedTextCopier *_chunkedTextCopier;
 }
 
 
@@ -198,8 +216,13 @@
 + (NSSize)charSizeForFont:(NSFont *)aFont
         horizontalSpacing:(CGFloat)hspace
           verticalSpacing:(CGFloat)vspace {
-    FontSizeEstimator* fse = [FontSizeEstimator fontSizeEstimatorForFont:aFont];
-    NSSize size = [fse size];
+    NSSize size;
+    if ([iTermAdvancedSettingsModel shareFontMetricsAcrossSessions]) {
+        size = [FontSizeEstimator cachedSizeForFont:aFont];
+    } else {
+        FontSizeEstimator* fse = [FontSizeEstimator fontSizeEstimatorForFont:aFont];
+        size = [fse size];
+    }
     size.width = ceil(size.width);
     size.height = ceil(size.height + [aFont leading]);
     size.width = ceil(size.width * hspace);
@@ -276,6 +299,12 @@
                                                  selector:@selector(applicationDidResignActive:)
                                                      name:NSApplicationDidResignActiveNotification
                                                    object:nil];
+        if ([iTermAdvancedSettingsModel attachNoteViewsLazily]) {
+            [[NSNotificationCenter defaultCenter] addObserver:self
+                                                     selector:@selector(clipViewBoundsDidChange:)
+                                                         name:NSViewBoundsDidChangeNotification
+                                                       object:nil];
+        }
 
         _semanticHistoryController = [[iTermSemanticHistoryController alloc] init];
         _semanticHistoryController.delegate = self;
@@ -377,10 +406,18 @@
     [_keyboardHandler release];
     _urlActionHelper.delegate = nil;
     [_urlActionHelper release];
+    [_chunkedTextCopier cancel];
+    [_chunkedTextCopier release];
 
     [super dealloc];
 }
 
+- (void)setDataSource:(id<PTYTextViewDataSource>)dataSource {
+    // A chunked copy in progress reads from the data source, so get the rest of it while we can.
+    [_chunkedTextCopier finish];
+    _dataSource = dataSource;
+}
+
 #pragma mark - NSObject
 
 - (NSString *)description {
@@ -1180,6 +1217,7 @@
         ITCriticalError(_dataSource.width < 0, @"Negative datasource width of %@", @(_dataSource.width));
         return;
     }
+    const uint64_t token = iTermPerformanceCounterBegin(iTermPerformanceCounterFramePrep);
     const NSRect rectToDraw = [self textDrawingHelperVisibleRect];
     DLog(@"drawing document visible rect %@", NSStringFromRect(rectToDraw));
 
@@ -1248,6 +1286,7 @@
             [self.delegate textViewWillNeedUpdateForBlink];
         }
     }];
+    iTermPerformanceCounterEnd(iTermPerformanceCounterFramePrep, token);
     [self maybeInvalidateWindowShadow];
 }
 
@@ -1699,15 +1738,32 @@
     self.charWidth = ceil(_charWidthWithoutSpacing * horizontalSpacing);
     self.lineHeight = ceil(_charHeightWithoutSpacing * verticalSpacing);
 
-    _primaryFont.font = aFont;
-    _primaryFont.boldVersion = [_primaryFont computedBoldVersion];
-    _primaryFont.italicVersion = [_primaryFont computedItalicVersion];
-    _primaryFont.boldItalicVersion = [_primaryFont computedBoldItalicVersion];
+    if ([iTermAdvancedSettingsModel shareFontMetricsAcrossSessions] && aFont && nonAsciiFont) {
+        // Replace rather than modify since the shared instances may be in use by other sessions.
+        [_primaryFont autorelease];
+        _primaryFont = [[PTYFontInfo sharedFontInfoWithVariantsForFont:aFont] retain];
+        [_secondaryFont autorelease];
+        _secondaryFont = [[PTYFontInfo sharedFontInfoWithVariantsForFont:nonAsciiFont] retain];
+        _usingSharedFontInfo = YES;
+    } else {
+        if (_usingSharedFontInfo) {
+            // The setting was turned off. Stop using the shared instances before modifying them.
+            _usingSharedFontInfo = NO;
+            [_primaryFont autorelease];
+            _primaryFont = [[PTYFontInfo alloc] init];
+            [_secondaryFont autorelease];
+            _secondaryFont = [[PTYFontInfo alloc] init];
+        }
+        _primaryFont.font = aFont;
+        _primaryFont.boldVersion = [_primaryFont computedBoldVersion];
+        _primaryFont.italicVersion = [_primaryFont computedItalicVersion];
+        _primaryFont.boldItalicVersion = [_primaryFont computedBoldItalicVersion];
 
-    _secondaryFont.font = nonAsciiFont;
-    _secondaryFont.boldVersion = [_secondaryFont computedBoldVersion];
-    _secondaryFont.italicVersion = [_secondaryFont computedItalicVersion];
-    _secondaryFont.boldItalicVersion = [_secondaryFont computedBoldItalicVersion];
+        _secondaryFont.font = nonAsciiFont;
+        _secondaryFont.boldVersion = [_secondaryFont computedBoldVersion];
+        _secondaryFont.italicVersion = [_secondaryFont computedItalicVersion];
+        _secondaryFont.boldItalicVersion = [_secondaryFont computedBoldItalicVersion];
+    }
 
     [self updateMarkedTextAttributes];
 
@@ -1950,8 +2006,11 @@
     int WIDTH = [_dataSource width];
 
     // Any characters that changed selection status since the last update or
-    // are blinking should be set dirty.
-    anythingIsBlinking = [self _markChangedSelectionAndBlinkDirty:redrawBlink width:WIDTH];
+    // are blinking should be set dirty. When presentation is suspended everything gets redrawn
+    // on resumption anyway.
+    if (!_presentationSuspended) {
+        anythingIsBlinking = [self _markChangedSelectionAndBlinkDirty:redrawBlink width:WIDTH];
+    }
 
     // Copy selection position to detect change in selected chars next call.
     [_oldSelection release];
@@ -1994,8 +2053,11 @@
 
     // Remove results from dirty lines and mark parts of the view as needing display.
     NSMutableIndexSet *cleanLines = [NSMutableIndexSet indexSet];
+    NSMutableIndexSet *dirtyLines = [NSMutableIndexSet indexSet];
     if (allDirty) {
         foundDirty = YES;
+        [_accessibilityHelper invalidateAllLines];
+        [dirtyLines addIndexesInRange:NSMakeRange(0, lineEnd - lineStart)];
         [_findOnPageHelper removeHighlightsInRange:NSMakeRange(lineStart + totalScrollbackOverflow,
                                                                lineEnd - lineStart)];
         [self setNeedsDisplayInRect:[self gridRect]];
@@ -2005,6 +2067,7 @@
             VT100GridRange range = [_dataSource dirtyRangeForLine:y - lineStart];
             if (range.length > 0) {
                 foundDirty = YES;
+                [dirtyLines addIndex:y - lineStart];
                 [_findOnPageHelper removeHighlightsInRange:NSMakeRange(y + totalScrollbackOverflow, 1)];
                 [_findOnPageHelper removeSearchResultsInRange:NSMakeRange(y + totalScrollbackOverflow, 1)];
                 [self setNeedsDisplayOnLine:y inRange:range];
@@ -2031,10 +2094,20 @@
     DebugLog(@"updateDirtyRects resetDirty");
     [_dataSource resetDirty];
 
+    if (foundDirty && _deferNonessentialWork) {
+        _deferredWorkPending = YES;
+    } else if (foundDirty && !allDirty) {
+        NSMutableIndexSet *absoluteDirtyLines = [[dirtyLines mutableCopy] autorelease];
+        [absoluteDirtyLines shiftIndexesStartingAtIndex:0 by:lineStart + totalScrollbackOverflow];
+        [_accessibilityHelper invalidateAbsoluteLines:absoluteDirtyLines];
+    }
+
     if (foundDirty) {
-        [_dataSource saveToDvr:cleanLines];
+        if (!_deferNonessentialWork) {
+            [_dataSource saveToDvr:cleanLines];
+        }
         [_delegate textViewInvalidateRestorableState];
-        [_delegate textViewDidFindDirtyRects];
+        [_delegate textViewDidFindDirtyRectsOnLines:dirtyLines];
     }
 
     if (foundDirty && [_dataSource shouldSendContentsChangedNotification]) {
@@ -2115,6 +2188,21 @@
     NSAccessibilityPostNotification(self, NSAccessibilityRowCountChangedNotification);
 }
 
+- (void)setDeferNonessentialWork:(BOOL)deferNonessentialWork {
+    if (deferNonessentialWork == _deferNonessentialWork) {
+        return;
+    }
+    _deferNonessentialWork = deferNonessentialWork;
+    if (deferNonessentialWork || !_deferredWorkPending) {
+        return;
+    }
+    _deferredWorkPending = NO;
+    // Frames were skipped, so the next one can't be a diff against the last one recorded.
+    [_dataSource saveToDvr:nil];
+    [_accessibilityHelper invalidateAllLines];
+    [self refreshAccessibility];
+}
+
 // Update accessibility, to be called periodically.
 - (void)refreshAccessibility {
     NSAccessibilityPostNotification(self, NSAccessibilityValueChangedNotification);
@@ -2168,7 +2256,7 @@
         }];
     }
 
-    if ([[self subviews] count]) {
+    if ([[self subviews] count] && !_presentationSuspended) {
         // TODO: Why update notes not in this textview?
         [[NSNotificationCenter defaultCenter] postNotificationName:PTYNoteViewControllerShouldUpdatePosition
                                                             object:nil];
@@ -2186,17 +2274,47 @@
     const BOOL foundBlink = [self updateDirtyRects:&foundDirty] || [self isCursorBlinking];
 
     // Update accessibility.
-    if (foundDirty) {
+    if (foundDirty && !_deferNonessentialWork && !_presentationSuspended) {
         [self refreshAccessibility];
     }
     if (scrollbackOverflow > 0 || frameDidChange) {
         // Need to redraw locations of search results.
-        [self.delegate textViewFindOnPageLocationsDidChange];
+        if (_presentationSuspended) {
+            _findOnPageLocationsChangedWhileSuspended = YES;
+        } else {
+            [self.delegate textViewFindOnPageLocationsDidChange];
+        }
     }
 
     return foundBlink;
 }
 
+- (void)setPresentationSuspended:(BOOL)presentationSuspended {
+    if (presentationSuspended == _presentationSuspended) {
+        return;
+    }
+    DLog(@"presentationSuspended=%@ for %@", @(presentationSuspended), _delegate);
+    _presentationSuspended = presentationSuspended;
+    if (presentationSuspended) {
+        return;
+    }
+    if (_badgeLabelNeedsRecompute) {
+        _badgeLabelNeedsRecompute = NO;
+        [self recomputeBadgeLabel];
+    }
+    if (_findOnPageLocationsChangedWhileSuspended) {
+        _findOnPageLocationsChangedWhileSuspended = NO;
+        [self.delegate textViewFindOnPageLocationsDidChange];
+    }
+    if ([[self subviews] count]) {
+        [[NSNotificationCenter defaultCenter] postNotificationName:PTYNoteViewControllerShouldUpdatePosition
+                                                            object:nil];
+    }
+    [_accessibilityHelper invalidateAllLines];
+    [self refreshAccessibility];
+    [self setNeedsDisplay:YES];
+}
+
 - (void)markCursorDirty {
     int currentCursorX = [_dataSource cursorX] - 1;
     int currentCursorY = [_dataSource cursorY] - 1;
@@ -2684,10 +2802,33 @@
     DLog(@"-[PTYTextView copy:] called");
     DLog(@"%@", [NSThread callStackSymbols]);
 
+    if (!_contextMenuHelper.savedSelectedText &&
+        [iTermAdvancedSettingsModel chunkedCopyOfLargeSelections] &&
+        [_selection hasSelection] &&
+        _selection.length >= kMinimumSelectionLengthForChunkedCopy) {
+        [self copySelectionInChunks];
+        return;
+    }
     NSString *copyString = [self selectedText];
     [self copyString:copyString];
 }
 
+// Like -copy: but doesn't build the whole string up front. It isn't saved to paste history since
+// that would build the string anyway.
+- (void)copySelectionInChunks {
+    DLog(@"Copy selection of length %@ in chunks", @(_selection.length));
+    [_chunkedTextCopier cancel];
+    [_chunkedTextCopier release];
+    _chunkedTextCopier =
+        [[iTermChunkedTextCopier alloc] initWithDataSource:_dataSource
+                                        includeLastNewline:[iTermPreferences boolForKey:kPreferenceKeyCopyLastNewline]
+                                    trimTrailingWhitespace:[iTermAdvancedSettingsModel trimWhitespaceOnCopy]];
+    [_selection enumerateSelectedAbsoluteRanges:^(VT100GridAbsWindowedRange absRange, BOOL *stop, BOOL eol) {
+        [_chunkedTextCopier addRange:absRange eol:eol];
+    }];
+    [_chunkedTextCopier writeToPasteboard:[NSPasteboard generalPasteboard]];
+}
+
 - (void)copyString:(NSString *)copyString {
     if ([iTermAdvancedSettingsModel disallowCopyEmptyString] && copyString.length == 0) {
         DLog(@"Disallow copying empty string");
@@ -3013,6 +3154,12 @@
 - (void)addViewForNote:(PTYNoteViewController *)note {
     // Make sure scrollback overflow is reset.
     [self refresh];
+    if ([iTermAdvancedSettingsModel attachNoteViewsLazily]) {
+        // The view gets added by -updateNoteViewFrames if the note is near the visible area.
+        [note setNoteHidden:NO];
+        [self updateNoteViewFrames];
+        return;
+    }
     [note.view removeFromSuperview];
     [self addSubview:note.view];
     [self updateNoteViewFrames];
@@ -3040,7 +3187,47 @@
 - (void)showNotes:(id)sender {
 }
 
+- (void)clipViewBoundsDidChange:(NSNotification *)notification {
+    if (notification.object != self.enclosingScrollView.contentView) {
+        return;
+    }
+    [self updateNoteViewFrames];
+}
+
+// Only notes within a screenful of the visible area have their views in the hierarchy, so
+// thousands of notes (e.g., from an annotate trigger on a noisy log) don't all have to be laid
+// out, composited, and hit tested. The note being edited keeps its view wherever it is.
+- (void)attachVisibleNoteViews {
+    const VT100GridRange visibleLines = [self rangeOfVisibleLines];
+    const int first = MAX(0, visibleLines.location - visibleLines.length);
+    const int last = MIN([_dataSource numberOfLines], VT100GridRangeMax(visibleLines) + 1 + visibleLines.length);
+    NSArray<PTYNoteViewController *> *notes = [_dataSource notesInRange:VT100GridCoordRangeMake(0, first, 0, last)];
+    NSSet<PTYNoteViewController *> *wanted = [NSSet setWithArray:notes];
+    for (NSView *view in [[self.subviews copy] autorelease]) {
+        if (![view isKindOfClass:[PTYNoteView class]]) {
+            continue;
+        }
+        PTYNoteViewController *note = (PTYNoteViewController *)((PTYNoteView *)view).delegate.noteViewController;
+        if (![wanted containsObject:note] && !note.isEditing) {
+            [view removeFromSuperview];
+        }
+    }
+    for (PTYNoteViewController *note in notes) {
+        if (note.view.superview != self) {
+            [note.view removeFromSuperview];
+            [self addSubview:note.view];
+        }
+    }
+}
+
+- (NSArray<PTYNoteViewController *> *)allNotes {
+    return [_dataSource notesInRange:VT100GridCoordRangeMake(0, 0, [_dataSource width], [_dataSource numberOfLines])];
+}
+
 - (void)updateNoteViewFrames {
+    if ([iTermAdvancedSettingsModel attachNoteViewsLazily]) {
+        [self attachVisibleNoteViews];
+    }
     for (NSView *view in [self subviews]) {
         if ([view isKindOfClass:[PTYNoteView class]]) {
             PTYNoteView *noteView = (PTYNoteView *)view;
@@ -3057,6 +3244,14 @@
 }
 
 - (BOOL)anyAnnotationsAreVisible {
+    if ([iTermAdvancedSettingsModel attachNoteViewsLazily]) {
+        for (PTYNoteViewController *note in [self allNotes]) {
+            if (!note.isNoteHidden) {
+                return YES;
+            }
+        }
+        return NO;
+    }
     for (NSView *view in [self subviews]) {
         if ([view isKindOfClass:[PTYNoteView class]]) {
             if (!view.hidden) {
@@ -3164,6 +3359,10 @@
     if (!_delegate) {
         return;
     }
+    if (_presentationSuspended) {
+        _badgeLabelNeedsRecompute = YES;
+        return;
+    }
 
     _badgeLabel.fillColor = [_delegate textViewBadgeColor];
     _badgeLabel.backgroundColor = [_colorMap colorForKey:kColorMapBackground];
@@ -4939,6 +5138,10 @@ scrollToFirstResult:(BOOL)scrollToFirstResult {
                [_dataSource numberOfLines]);
 }
 
+- (long long)accessibilityHelperAbsoluteLineNumberOfFirstLine {
+    return [self accessibilityHelperLineNumberForAccessibilityLineNumber:0] + [_dataSource totalScrollbackOverflow];
+}
+
 #pragma mark - NSPopoverDelegate
 
 - (void)popoverDidClose:(NSNotification *)notification {
@@ -5094,6 +5297,12 @@ scrollToFirstResult:(BOOL)scrollToFirstResult {
 }
 
 - (void)mouseHandlerDidSingleClick:(PTYMouseHandler *)handler {
+    if ([iTermAdvancedSettingsModel attachNoteViewsLazily]) {
+        for (PTYNoteViewController *note in [self allNotes]) {
+            [note setNoteHidden:YES];
+        }
+        return;
+    }
     for (NSView *view in [self subviews]) {
         if ([view isKindOfClass:[PTYNoteView class]]) {
             PTYNoteView *noteView = (PTYNoteView *)view;
@@ -45,6 +45,9 @@
 
 - (screen_char_t *)getLineAtScreenIndex:(int)theIndex;
 
+// Changes when the line's contents change.
+- (NSInteger)generationForLine:(int)y;
+
 // Provide a buffer as large as sizeof(screen_char_t*) * ([SCREEN width] + 1)
 - (screen_char_t *)getLineAtIndex:(int)theIndex withBuffer:(screen_char_t*)buffer;
 - (NSArray<ScreenCharArray *> *)linesInRange:(NSRange)range;
@@ -36,12 +36,23 @@
 
 #define kPasteboardHistoryDidChange @"PasteboardHistoryDidChange"
 
+extern const NSUInteger kPasteboardEntryMaximumLengthToScanForLines;
+
 @interface PasteboardEntry : PopupEntry
 
 @property(nonatomic, retain) NSDate *timestamp;
 
+// These don't require loading the value when it lives on disk.
+@property(nonatomic, readonly) NSString *preview;
+@property(nonatomic, readonly) NSUInteger valueLength;
+// Counts lines in the first kPasteboardEntryMaximumLengthToScanForLines characters only.
+@property(nonatomic, readonly) NSInteger lineCount;
+
 + (PasteboardEntry*)entryWithString:(NSString *)s score:(double)score;
 
+// Avoids loading the value from disk when the length or digest shows it can't match.
+- (BOOL)hasValue:(NSString *)value;
+
 @end
 
 @interface PasteboardHistory : NSObject
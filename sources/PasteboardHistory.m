@@ -34,14 +34,45 @@
 #import "PopupModel.h"
 #import "iTermAdvancedSettingsModel.h"
 #import "iTermController.h"
+#import "iTermPasteHistoryBlobStore.h"
 #import "iTermPreferences.h"
 #import "iTermSecureKeyboardEntryController.h"
 
 #define PBHKEY_ENTRIES @"Entries"
 #define PBHKEY_VALUE @"Value"
 #define PBHKEY_TIMESTAMP @"Timestamp"
+#define PBHKEY_DIGEST @"Digest"
+#define PBHKEY_LENGTH @"Length"
+#define PBHKEY_PREVIEW @"Preview"
+#define PBHKEY_LINES @"Lines"
+
+const NSUInteger kPasteboardEntryMaximumLengthToScanForLines = 1024 * 50;
+
+// Values at least this long are kept in the blob store rather than in memory and pbhistory.plist.
+static const NSUInteger kPasteboardHistoryMinimumLengthForBlob = 16 * 1024;
+static const NSUInteger kPasteboardEntryPreviewLength = 256;
+
+@interface PasteboardEntry ()
+@property(nonatomic, readonly) NSString *blobKey;
+
++ (PasteboardEntry *)entryWithBlobKey:(NSString *)key
+                                store:(iTermPasteHistoryBlobStore *)store
+                               length:(NSUInteger)length
+                              preview:(NSString *)preview
+                            lineCount:(NSInteger)lineCount
+                                score:(double)score;
+- (void)moveValueToBlobStore:(iTermPasteHistoryBlobStore *)store;
+- (void)moveValueToMemory;
+@end
 
-@implementation PasteboardEntry
+@implementation PasteboardEntry {
+    // When set, the value lives in _blobStore and super's mainValue is empty.
+    NSString *_blobKey;
+    iTermPasteHistoryBlobStore *_blobStore;
+    NSString *_preview;
+    NSUInteger _valueLength;
+    NSInteger _lineCount;
+}
 
 + (PasteboardEntry*)entryWithString:(NSString *)s score:(double)score
 {
@@ -52,12 +83,105 @@
     return e;
 }
 
++ (PasteboardEntry *)entryWithBlobKey:(NSString *)key
+                                store:(iTermPasteHistoryBlobStore *)store
+                               length:(NSUInteger)length
+                              preview:(NSString *)preview
+                            lineCount:(NSInteger)lineCount
+                                score:(double)score {
+    PasteboardEntry *e = [self entryWithString:@"" score:score];
+    e->_blobKey = [key copy];
+    e->_blobStore = store;
+    e->_valueLength = length;
+    e->_preview = [preview copy];
+    e->_lineCount = lineCount;
+    return e;
+}
+
+- (NSString *)mainValue {
+    if (_blobKey) {
+        // Not retained here so the store's cache bounds how many large values stay in memory.
+        return [_blobStore stringForKey:_blobKey] ?: @"";
+    }
+    return [super mainValue];
+}
+
+- (void)setMainValue:(NSString *)mainValue {
+    [super setMainValue:mainValue];
+    _blobKey = nil;
+    _blobStore = nil;
+    _preview = nil;
+    _lineCount = -1;
+}
+
+- (NSString *)blobKey {
+    return _blobKey;
+}
+
+- (NSString *)preview {
+    if (!_preview) {
+        NSString *value = self.mainValue;
+        _preview = value.length > kPasteboardEntryPreviewLength ? [value substringToIndex:kPasteboardEntryPreviewLength] : value;
+    }
+    return _preview;
+}
+
+- (NSUInteger)valueLength {
+    if (_blobKey) {
+        return _valueLength;
+    }
+    return [super mainValue].length;
+}
+
+- (NSInteger)lineCount {
+    if (_lineCount < 0) {
+        NSString *value = self.mainValue;
+        _lineCount = [[value substringToIndex:MIN(value.length, kPasteboardEntryMaximumLengthToScanForLines)] it_numberOfLines];
+    }
+    return _lineCount;
+}
+
+- (BOOL)hasValue:(NSString *)value {
+    if (!_blobKey) {
+        return [[super mainValue] isEqualToString:value];
+    }
+    if (value.length != _valueLength) {
+        return NO;
+    }
+    return [[iTermPasteHistoryBlobStore keyForString:value] isEqualToString:_blobKey];
+}
+
+- (void)moveValueToBlobStore:(iTermPasteHistoryBlobStore *)store {
+    if (_blobKey) {
+        return;
+    }
+    NSString *value = [super mainValue];
+    NSString *preview = self.preview;
+    const NSInteger lineCount = self.lineCount;
+    NSString *key = [iTermPasteHistoryBlobStore keyForString:value];
+    [store storeString:value key:key];
+    [super setMainValue:@""];
+    _blobKey = key;
+    _blobStore = store;
+    _valueLength = value.length;
+    _preview = preview;
+    _lineCount = lineCount;
+}
+
+- (void)moveValueToMemory {
+    if (!_blobKey) {
+        return;
+    }
+    self.mainValue = self.mainValue;
+}
+
 @end
 
 @implementation PasteboardHistory {
     NSMutableArray *entries_;
     int maxEntries_;
     NSString *path_;
+    iTermPasteHistoryBlobStore *_blobStore;
 }
 
 + (int)maxEntries
@@ -93,6 +217,7 @@
         NSString *appname = [[NSBundle mainBundle] objectForInfoDictionaryKey:(NSString *)kCFBundleNameKey];
         path_ = [path_ stringByAppendingPathComponent:appname];
         [[NSFileManager defaultManager] createDirectoryAtPath:path_ withIntermediateDirectories:YES attributes:nil error:NULL];
+        _blobStore = [[iTermPasteHistoryBlobStore alloc] initWithDirectory:[path_ stringByAppendingPathComponent:@"PasteHistoryBlobs"]];
         path_ = [[path_ stringByAppendingPathComponent:@"pbhistory.plist"] copy];
 
         [self _loadHistoryFromDisk];
@@ -107,19 +232,56 @@
 - (NSDictionary*)_entriesToDict {
     NSMutableArray *a = [NSMutableArray array];
 
+    const BOOL useBlobs = [iTermAdvancedSettingsModel diskBackedPasteHistory];
     for (PasteboardEntry *entry in entries_) {
+        NSNumber *timestamp = [NSNumber numberWithDouble:[entry.timestamp timeIntervalSinceReferenceDate]];
+        if (useBlobs && entry.valueLength >= kPasteboardHistoryMinimumLengthForBlob) {
+            [entry moveValueToBlobStore:_blobStore];
+            [a addObject:@{ PBHKEY_DIGEST: entry.blobKey,
+                            PBHKEY_LENGTH: @(entry.valueLength),
+                            PBHKEY_PREVIEW: entry.preview,
+                            PBHKEY_LINES: @(entry.lineCount),
+                            PBHKEY_TIMESTAMP: timestamp }];
+            continue;
+        }
         [a addObject:[NSDictionary dictionaryWithObjectsAndKeys:[entry mainValue], PBHKEY_VALUE,
-                      [NSNumber numberWithDouble:[entry.timestamp timeIntervalSinceReferenceDate]], PBHKEY_TIMESTAMP,
+                      timestamp, PBHKEY_TIMESTAMP,
                       nil]];
     }
     return [NSDictionary dictionaryWithObject:a forKey:PBHKEY_ENTRIES];
 }
 
+- (NSSet<NSString *> *)blobKeys {
+    NSMutableSet<NSString *> *keys = [NSMutableSet set];
+    for (PasteboardEntry *entry in entries_) {
+        if (entry.blobKey) {
+            [keys addObject:entry.blobKey];
+        }
+    }
+    return keys;
+}
+
 - (void)_addDictToEntries:(NSDictionary*)dict {
     NSArray *a = [dict objectForKey:PBHKEY_ENTRIES];
     for (NSDictionary *d in a) {
         double timestamp = [[d objectForKey:PBHKEY_TIMESTAMP] doubleValue];
-        PasteboardEntry *entry = [PasteboardEntry entryWithString:[d objectForKey:PBHKEY_VALUE] score:timestamp];
+        PasteboardEntry *entry;
+        NSString *digest = [d objectForKey:PBHKEY_DIGEST];
+        if (digest) {
+            // Written with diskBackedPasteHistory on. Still honored if it has since been turned off.
+            if (![_blobStore hasStringForKey:digest]) {
+                DLog(@"Dropping paste history entry with missing blob %@", digest);
+                continue;
+            }
+            entry = [PasteboardEntry entryWithBlobKey:digest
+                                                store:_blobStore
+                                               length:[[d objectForKey:PBHKEY_LENGTH] unsignedIntegerValue]
+                                              preview:[d objectForKey:PBHKEY_PREVIEW] ?: @""
+                                            lineCount:[[d objectForKey:PBHKEY_LINES] integerValue]
+                                                score:timestamp];
+        } else {
+            entry = [PasteboardEntry entryWithString:[d objectForKey:PBHKEY_VALUE] score:timestamp];
+        }
         entry.timestamp = [NSDate dateWithTimeIntervalSinceReferenceDate:timestamp];
         [entries_ addObject:entry];
     }
@@ -130,6 +292,11 @@
 }
 
 - (void)eraseHistory {
+    // In-memory history survives, so take back values that live in blobs before deleting them.
+    for (PasteboardEntry *entry in entries_) {
+        [entry moveValueToMemory];
+    }
+    [_blobStore removeAllBlobs];
     [[NSFileManager defaultManager] removeItemAtPath:path_ error:NULL];
 }
 
@@ -148,6 +315,7 @@
         [[NSFileManager defaultManager] setAttributes:@{ NSFilePosixPermissions: @0600 }
                                          ofItemAtPath:path_
                                                 error:nil];
+        [_blobStore removeBlobsExceptKeys:[self blobKeys]];
     }
 }
 
@@ -184,7 +352,7 @@
     // Remove existing duplicate value.
     for (int i = 0; i < [entries_ count]; ++i) {
         PasteboardEntry *entry = [entries_ objectAtIndex:i];
-        if ([[entry mainValue] isEqualToString:value]) {
+        if ([entry hasValue:value]) {
             [entries_ removeObjectAtIndex:i];
             break;
         }
@@ -196,7 +364,7 @@
     PasteboardEntry *lastEntry;
     if ([entries_ count] > 0) {
         lastEntry = [entries_ objectAtIndex:[entries_ count] - 1];
-        if ([value hasPrefix:[lastEntry mainValue]]) {
+        if (lastEntry.valueLength <= value.length && [value hasPrefix:[lastEntry mainValue]]) {
             [entries_ removeObjectAtIndex:[entries_ count] - 1];
         }
     }
@@ -293,14 +461,11 @@
     if ([[aTableColumn identifier] isEqualToString:@"date"]) {
         // Date
         NSString *formattedDate = [NSDateFormatter dateDifferenceStringFromDate:entry.timestamp];
-        int i = [self convertIndex:rowIndex];
-        PopupEntry* e = [[self model] objectAtIndex:i];
-        NSString *formattedLength = [NSString it_formatBytes:e.mainValue.length];
-        const NSUInteger maximumLengthToScan = 1024 * 50;
-        const NSInteger numberOfLines = [[e.mainValue substringToIndex:MIN(e.mainValue.length, maximumLengthToScan)] it_numberOfLines];
+        NSString *formattedLength = [NSString it_formatBytes:entry.valueLength];
+        const NSInteger numberOfLines = entry.lineCount;
         NSString *formattedNumberOfLines;
         NSString *plus;
-        if (e.mainValue.length > maximumLengthToScan) {
+        if (entry.valueLength > kPasteboardEntryMaximumLengthToScanForLines) {
             plus = @"+";
         } else {
             plus = @"";
@@ -615,6 +615,12 @@ andEditComponentWithIdentifier:(NSString *)identifier
     } else {
         [self.window setFrameUsingName:self.nameForFrame force:NO];
     }
+    if ([iTermAdvancedSettingsModel prebuildPreferencesSearchIndex]) {
+        // Wait for the view controllers to finish loading their documents.
+        dispatch_async(dispatch_get_main_queue(), ^{
+            [self buildSearchEngineInBackgroundIfNeeded];
+        });
+    }
 }
 
 #pragma mark - NSWindowDelegate
@@ -1000,12 +1006,22 @@ andEditComponentWithIdentifier:(NSString *)identifier
              _shortcutsViewController];
 }
 
+- (NSArray<iTermPreferencesSearchDocument *> *)searchableDocuments {
+    return [[self.searchableViewControllers mapWithBlock:^id(id<iTermSearchableViewController> viewController) {
+        return [viewController searchableViewControllerDocuments];
+    }] flattenedArray];
+}
+
 - (void)buildSearchEngineIfNeeded {
     if (gSearchEngine) {
         return;
     }
     gSearchEngine = [[iTermPreferencesSearchEngine alloc] init];
 
+    if ([iTermAdvancedSettingsModel prebuildPreferencesSearchIndex]) {
+        [gSearchEngine addDocumentsToIndex:self.searchableDocuments];
+        return;
+    }
     for (id<iTermSearchableViewController> viewController in self.searchableViewControllers) {
         for (iTermPreferencesSearchDocument *doc in [viewController searchableViewControllerDocuments]) {
             [gSearchEngine addDocumentToIndex:doc];
@@ -1013,6 +1029,27 @@ andEditComponentWithIdentifier:(NSString *)identifier
     }
 }
 
+// Builds the search engine on a background queue so the first search doesn't have to wait. A
+// search that starts first builds its own and this one gets dropped.
+- (void)buildSearchEngineInBackgroundIfNeeded {
+    static BOOL building;
+    if (gSearchEngine || building) {
+        return;
+    }
+    building = YES;
+    NSArray<iTermPreferencesSearchDocument *> *documents = self.searchableDocuments;
+    dispatch_async(dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_LOW, 0), ^{
+        iTermPreferencesSearchEngine *engine = [[iTermPreferencesSearchEngine alloc] init];
+        [engine addDocumentsToIndex:documents];
+        dispatch_async(dispatch_get_main_queue(), ^{
+            building = NO;
+            if (!gSearchEngine) {
+                gSearchEngine = engine;
+            }
+        });
+    });
+}
+
 - (NSArray<iTermPreferencesSearchDocument *> *)searchResults {
     [self buildSearchEngineIfNeeded];
     return [gSearchEngine documentsMatchingQuery:self.searchField.stringValue];
@@ -26,6 +26,7 @@
 
 #import "DebugLogging.h"
 #import "ITAddressBookMgr.h"
+#import "iTermAdvancedSettingsModel.h"
 #import "iTermProfileModelJournal.h"
 #import "iTermProfileSearchToken.h"
 #import "NSDictionary+iTerm.h"
@@ -59,6 +60,14 @@ static NSMutableArray<NSString *> *_combinedLog;
     NSMutableArray* journal_;
     NSUserDefaults* prefs_;
     BOOL postChanges_;              // should change notifications be posted?
+
+    // Words in each immutable profile's name (first element) and tags (the rest) for filtering.
+    // Entries go away with their profiles, and a changed profile is a new object.
+    NSMapTable<Profile *, NSArray<NSArray<NSString *> *> *> *_filterWords;
+    // Tokens of the last filter and the immutable profiles it rejected. A filter that narrows it
+    // rejects those profiles too, so they needn't be checked again.
+    NSArray<iTermProfileSearchToken *> *_lastFilterTokens;
+    NSHashTable<Profile *> *_lastFilterRejects;
 }
 
 + (BOOL)migrated {
@@ -155,6 +164,9 @@ static NSMutableArray<NSString *> *_combinedLog;
 //    [_debugGuids release];
 //    [_debugHistory release];
     [_menuController release];
+    [_filterWords release];
+    [_lastFilterTokens release];
+    [_lastFilterRejects release];
     NSLog(@"Deallocating bookmark model!");
     [super dealloc];
 }
@@ -242,6 +254,24 @@ static NSMutableArray<NSString *> *_combinedLog;
                nameIndexSet:(NSMutableIndexSet *)nameIndexSet
                tagIndexSets:(NSArray *)tagIndexSets {
     NSArray* nameWords = [name componentsSeparatedByCharactersInSet:[NSCharacterSet whitespaceCharacterSet]];
+    return [self doesProfileWithNameWords:nameWords
+                                  hasName:name != nil
+                                     tags:tags
+                                 tagWords:nil
+                              matchFilter:tokens
+                             nameIndexSet:nameIndexSet
+                             tagIndexSets:tagIndexSets];
+}
+
+// If |tagWords| is nil, the words of each tag are found from |tags|.
++ (BOOL)doesProfileWithNameWords:(NSArray *)nameWords
+                         hasName:(BOOL)hasName
+                            tags:(NSArray *)tags
+                        tagWords:(NSArray<NSArray<NSString *> *> *)tagWordsArray
+                     matchFilter:(NSArray *)tokens
+                    nameIndexSet:(NSMutableIndexSet *)nameIndexSet
+                    tagIndexSets:(NSArray *)tagIndexSets {
+    const NSUInteger numberOfTags = tagWordsArray ? tagWordsArray.count : tags.count;
     for (int i = 0; i < [tokens count]; ++i) {
         iTermProfileSearchToken *token = [tokens objectAtIndex:i];
         // Search each word in tag until one has this token as a prefix.
@@ -252,16 +282,16 @@ static NSMutableArray<NSString *> *_combinedLog;
             [nameIndexSet addIndexesInRange:token.range];
         }
         // If not try each tag.
-        for (int j = 0; !found && j < [tags count]; ++j) {
+        for (int j = 0; !found && j < numberOfTags; ++j) {
             // Expand the jth tag into an array of the words in the tag
-            NSArray* tagWords = [[tags objectAtIndex:j] componentsSeparatedByCharactersInSet:[NSCharacterSet whitespaceCharacterSet]];
+            NSArray* tagWords = tagWordsArray ? tagWordsArray[j] : [[tags objectAtIndex:j] componentsSeparatedByCharactersInSet:[NSCharacterSet whitespaceCharacterSet]];
             found = [token matchesAnyWordInTagWords:tagWords];
             if (found) {
                 NSMutableIndexSet *indexSet = tagIndexSets[j];
                 [indexSet addIndexesInRange:token.range];
             }
         }
-        if (!found && name != nil) {
+        if (!found && hasName) {
             // No tag had token i as a prefix. If name is nil then we don't really care about the
             // answer and we just want index sets.
             return NO;
@@ -281,6 +311,9 @@ static NSMutableArray<NSString *> *_combinedLog;
 }
 
 - (NSArray*)bookmarkIndicesMatchingFilter:(NSString*)filter orGuid:(NSString *)lockedGuid {
+    if ([iTermAdvancedSettingsModel cacheProfileFiltering]) {
+        return [self cachedBookmarkIndicesMatchingFilter:filter orGuid:lockedGuid];
+    }
     NSMutableArray* result = [NSMutableArray arrayWithCapacity:[bookmarks_ count]];
     NSArray* tokens = [self.class parseFilter:filter];
     int count = [bookmarks_ count];
@@ -297,6 +330,86 @@ static NSMutableArray<NSString *> *_combinedLog;
     return[ self bookmarkIndicesMatchingFilter:filter orGuid:nil];
 }
 
+// Gives the same result as the uncached path. Profiles rejected by the previous filter are
+// skipped when the new filter narrows it, and each profile's words are split only once.
+- (NSArray *)cachedBookmarkIndicesMatchingFilter:(NSString *)filter orGuid:(NSString *)lockedGuid {
+    NSArray<iTermProfileSearchToken *> *tokens = [self.class parseFilter:filter];
+    NSHashTable<Profile *> *previousRejects = [self filterTokens:tokens narrowFilterTokens:_lastFilterTokens] ? _lastFilterRejects : nil;
+    NSHashTable<Profile *> *rejects = [NSHashTable hashTableWithOptions:(NSPointerFunctionsWeakMemory | NSPointerFunctionsObjectPointerPersonality)];
+    if (!_filterWords) {
+        _filterWords = [[NSMapTable alloc] initWithKeyOptions:(NSPointerFunctionsWeakMemory | NSPointerFunctionsObjectPointerPersonality)
+                                                 valueOptions:NSPointerFunctionsStrongMemory
+                                                     capacity:bookmarks_.count];
+    }
+
+    NSMutableArray* result = [NSMutableArray arrayWithCapacity:[bookmarks_ count]];
+    const int count = [bookmarks_ count];
+    for (int i = 0; i < count; ++i) {
+        Profile *profile = bookmarks_[i];
+        if ([profile[KEY_GUID] isEqualToString:lockedGuid]) {
+            [result addObject:@(i)];
+            continue;
+        }
+        if ([previousRejects containsObject:profile]) {
+            [rejects addObject:profile];
+            continue;
+        }
+        // Mutable profiles could change without becoming new objects, so they aren't cached.
+        id copy = [profile copy];
+        const BOOL immutable = (copy == profile);
+        [copy release];
+        NSArray<NSArray<NSString *> *> *words = immutable ? [_filterWords objectForKey:profile] : nil;
+        if (!words) {
+            words = [self filterWordsForProfile:profile];
+            if (immutable) {
+                [_filterWords setObject:words forKey:profile];
+            }
+        }
+        const BOOL matches = [self.class doesProfileWithNameWords:words[0]
+                                                          hasName:profile[KEY_NAME] != nil
+                                                             tags:nil
+                                                         tagWords:[words subarrayWithRange:NSMakeRange(1, words.count - 1)]
+                                                      matchFilter:tokens
+                                                     nameIndexSet:nil
+                                                     tagIndexSets:nil];
+        if (matches) {
+            [result addObject:@(i)];
+        } else if (immutable) {
+            [rejects addObject:profile];
+        }
+    }
+
+    [_lastFilterTokens release];
+    _lastFilterTokens = [tokens retain];
+    [_lastFilterRejects release];
+    _lastFilterRejects = [rejects retain];
+    return result;
+}
+
+- (NSArray<NSArray<NSString *> *> *)filterWordsForProfile:(Profile *)profile {
+    NSCharacterSet *whitespace = [NSCharacterSet whitespaceCharacterSet];
+    NSMutableArray<NSArray<NSString *> *> *words = [NSMutableArray array];
+    [words addObject:[profile[KEY_NAME] componentsSeparatedByCharactersInSet:whitespace] ?: @[]];
+    for (NSString *tag in profile[KEY_TAGS]) {
+        [words addObject:[tag componentsSeparatedByCharactersInSet:whitespace]];
+    }
+    return words;
+}
+
+// Returns YES if every profile matching |tokens| also matches |previousTokens|.
+- (BOOL)filterTokens:(NSArray<iTermProfileSearchToken *> *)tokens
+  narrowFilterTokens:(NSArray<iTermProfileSearchToken *> *)previousTokens {
+    if (!previousTokens || tokens.count < previousTokens.count) {
+        return NO;
+    }
+    for (NSUInteger i = 0; i < previousTokens.count; i++) {
+        if (![previousTokens[i] isNarrowedBy:tokens[i]]) {
+            return NO;
+        }
+    }
+    return YES;
+}
+
 - (int)numberOfBookmarksWithFilter:(NSString*)filter
 {
     NSArray* tokens = [self.class parseFilter:filter];
@@ -134,6 +134,8 @@ extern NSString *const iTermDidCreateTerminalWindowNotification;
 // rescued later if the window is created from a saved arrangement. Called
 // during state restoration.
 + (void)registerSessionsInArrangement:(NSDictionary *)arrangement;
++ (void)prefetchContentsInArrangement:(NSDictionary *)arrangement;
++ (BOOL)arrangementIsKeyWindow:(NSDictionary *)arrangement;
 
 // If the key window is fullscreen (or is becoming fullscreen) then a new
 // normal window will automatically become fullscreen. This has to do with Lion
@@ -204,7 +206,7 @@ extern NSString *const iTermDidCreateTerminalWindowNotification;
 - (void)setWindowTitle:(NSString *)title;
 
 // Sessions in the broadcast group.
-- (NSArray *)broadcastSessions;
+- (NSArray<PTYSession *> *)broadcastSessions;
 
 // Enter full screen mode in the next mainloop.
 - (void)delayedEnterFullscreen;
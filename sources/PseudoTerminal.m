@@ -64,6 +64,7 @@
 #import "iTermSessionTitleBuiltInFunction.h"
 #import "iTermShellHistoryController.h"
 #import "iTermSquash.h"
+#import "iTermStreamingTextExporter.h"
 #import "iTermSwiftyString.h"
 #import "iTermSwiftyStringGraph.h"
 #import "iTermSystemVersion.h"
@@ -183,6 +184,7 @@ static NSString *const TERMINAL_ARRANGEMENT_SCROLLER_WIDTH = @"Scroller Width";
 // Only present in arrangements created by the window restoration system, not (for example) saved arrangements in the UI.
 // Boolean NSNumber.
 static NSString *const TERMINAL_ARRANGEMENT_MINIATURIZED = @"miniaturized";
+static NSString *const TERMINAL_ARRANGEMENT_IS_KEY_WINDOW = @"Is Key Window";
 
 static NSRect iTermRectCenteredHorizontallyWithinRect(NSRect frameToCenter, NSRect container) {
     CGFloat centerOfContainer = NSMidX(container);
@@ -439,6 +441,16 @@ typedef NS_ENUM(int, iTermShouldHaveTitleSeparator) {
     }
 }
 
++ (void)prefetchContentsInArrangement:(NSDictionary *)arrangement {
+    for (NSDictionary *tabArrangement in arrangement[TERMINAL_ARRANGEMENT_TABS]) {
+        [PTYTab prefetchContentsInArrangement:tabArrangement];
+    }
+}
+
++ (BOOL)arrangementIsKeyWindow:(NSDictionary *)arrangement {
+    return [arrangement[TERMINAL_ARRANGEMENT_IS_KEY_WINDOW] boolValue];
+}
+
 + (Profile *)expurgatedInitialProfile:(Profile *)profile {
     // We don't care about almost all the keys in the profile, so don't waste space and privacy storing them.
     return [profile ?: @{} dictionaryKeepingOnlyKeys:@[ KEY_CUSTOM_WINDOW_TITLE,
@@ -2405,6 +2417,10 @@ ITERM_WEAKLY_REFERENCEABLE
 - (void)sendInputToAllSessions:(NSString *)string
                       encoding:(NSStringEncoding)optionalEncoding
                  forceEncoding:(BOOL)forceEncoding {
+    if ([iTermAdvancedSettingsModel broadcastInputOnBackgroundQueue]) {
+        [self fanOutInputToAllSessions:string encoding:optionalEncoding forceEncoding:forceEncoding];
+        return;
+    }
     for (PTYSession *aSession in [self broadcastSessions]) {
         if (![aSession isTmuxGateway]) {
             [aSession writeTaskNoBroadcast:string encoding:optionalEncoding forceEncoding:forceEncoding];
@@ -2412,6 +2428,55 @@ ITERM_WEAKLY_REFERENCEABLE
     }
 }
 
+// Shared by all windows so broadcast input to a given task is written in the order it was typed.
+static dispatch_queue_t PseudoTerminalBroadcastWriteQueue(void) {
+    static dispatch_queue_t queue;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        queue = dispatch_queue_create("com.iterm2.broadcast-writes", DISPATCH_QUEUE_SERIAL);
+    });
+    return queue;
+}
+
+// Encodes the input once per distinct encoding and appends it to each task's write buffer off the
+// main thread. Sessions that need more than that (tmux, a pending surrogate) take the regular path.
+- (void)fanOutInputToAllSessions:(NSString *)string
+                        encoding:(NSStringEncoding)optionalEncoding
+                   forceEncoding:(BOOL)forceEncoding {
+    if (string.length == 0) {
+        return;
+    }
+    NSMutableDictionary<NSNumber *, id> *dataByEncoding = [NSMutableDictionary dictionary];
+    NSMutableArray<PTYTask *> *tasks = [NSMutableArray array];
+    NSMutableArray<NSData *> *datas = [NSMutableArray array];
+    for (PTYSession *aSession in [self broadcastSessions]) {
+        if ([aSession isTmuxGateway]) {
+            continue;
+        }
+        const NSStringEncoding encoding = forceEncoding ? optionalEncoding : aSession.terminal.encoding;
+        id data = dataByEncoding[@(encoding)];
+        if (!data) {
+            data = [string dataUsingEncoding:encoding allowLossyConversion:YES] ?: [NSNull null];
+            dataByEncoding[@(encoding)] = data;
+        }
+        if (data == [NSNull null] || ![aSession prepareToWriteBroadcastData:data]) {
+            [aSession writeTaskNoBroadcast:string encoding:optionalEncoding forceEncoding:forceEncoding];
+            continue;
+        }
+        [tasks addObject:aSession.shell];
+        [datas addObject:data];
+    }
+    if (!tasks.count) {
+        return;
+    }
+    DLog(@"Fan out %@ bytes to %@ tasks", @(string.length), @(tasks.count));
+    dispatch_async(PseudoTerminalBroadcastWriteQueue(), ^{
+        [tasks enumerateObjectsUsingBlock:^(PTYTask *task, NSUInteger idx, BOOL *stop) {
+            [task writeTask:datas[idx]];
+        }];
+    });
+}
+
 - (BOOL)broadcastInputToSession:(PTYSession *)session {
     return [_broadcastInputHelper shouldBroadcastToSessionWithID:session.guid];
 }
@@ -3350,6 +3415,8 @@ ITERM_WEAKLY_REFERENCEABLE
     result[TERMINAL_ARRANGEMENT_SELECTED_TAB_INDEX] = @([_contentView.tabView indexOfTabViewItem:[_contentView.tabView selectedTabViewItem]]);
     result[TERMINAL_ARRANGEMENT_HIDE_AFTER_OPENING] = @(hideAfterOpening_);
     result[TERMINAL_ARRANGEMENT_IS_HOTKEY_WINDOW] = @(self.isHotKeyWindow);
+    // currentTerminal survives the app being deactivated, unlike isKeyWindow.
+    result[TERMINAL_ARRANGEMENT_IS_KEY_WINDOW] = @([[iTermController sharedInstance] currentTerminal] == self);
     NSString *profileGuid = [[[[iTermHotKeyController sharedInstance] profileHotKeyForWindowController:self] profile] objectForKey:KEY_GUID];
     if (profileGuid) {
         result[TERMINAL_ARRANGEMENT_PROFILE_GUID] = profileGuid;
@@ -4025,6 +4092,16 @@ ITERM_WEAKLY_REFERENCEABLE
 
 - (void)windowOcclusionDidChange:(NSNotification *)notification {
     [self updateUseMetalInAllTabs];
+    for (PTYSession *session in [self allSessions]) {
+        [session updatePresentationSuspension];
+    }
+}
+
+// NSWindowDelegate
+- (void)windowDidChangeOcclusionState:(NSNotification *)notification {
+    for (PTYSession *session in [self allSessions]) {
+        [session updatePresentationSuspension];
+    }
 }
 
 - (void)applicationDidBecomeActive:(NSNotification *)notification {
@@ -9869,6 +9946,13 @@ static CGFloat iTermDimmingAmount(PSMTabBarControl *tabView) {
                                             documentAttributes:@{NSDocumentTypeDocumentAttribute: NSRTFTextDocumentType}
                                                          error:NULL];
                 [data writeToFile:url.path atomically:YES];
+            } else if ([iTermAdvancedSettingsModel streamSavedContents] && self.currentSession.screen) {
+                iTermStreamingTextExporter *exporter =
+                    [[[iTermStreamingTextExporter alloc] initWithDataSource:self.currentSession.screen
+                                                                       path:url.path] autorelease];
+                [exporter startWithCompletion:^(BOOL ok) {
+                    DLog(@"Finished saving contents to %@ ok=%@", url.path, @(ok));
+                }];
             } else {
                 [[self.currentSession.textview content] writeToFile:url.path atomically:NO encoding:NSUTF8StringEncoding error:nil];
             }
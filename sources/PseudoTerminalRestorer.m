@@ -14,6 +14,7 @@
 #import "iTermApplication.h"
 #import "iTermApplicationDelegate.h"
 #import "iTermController.h"
+#import "iTermLineBufferPrefetcher.h"
 #import "iTermOrphanServerAdopter.h"
 #import "iTermPreferences.h"
 #import "iTermRestorableStateController.h"
@@ -30,6 +31,7 @@ static BOOL gWaitingForFullScreen;
 static void (^gPostRestorationCompletionBlock)(void);
 static BOOL gRanQueuedBlocks;
 static BOOL gExternalRestorationDidComplete;
+static BOOL gRunningQueuedBlock;
 
 NSString *const iTermWindowStateKeyGUID = @"guid";
 
@@ -75,7 +77,9 @@ NSString *const iTermWindowStateKeyGUID = @"guid";
         }
         DLog(@"Running queued block...");
         VoidBlock block = [queuedBlocks firstObject];
+        gRunningQueuedBlock = YES;
         block();
+        gRunningQueuedBlock = NO;
         [queuedBlocks removeObjectAtIndex:0];
         DLog(@"Finished running queued block");
     }
@@ -83,6 +87,7 @@ NSString *const iTermWindowStateKeyGUID = @"guid";
     [queuedBlocks release];
     queuedBlocks = nil;
     gRanQueuedBlocks = YES;
+    [iTermLineBufferPrefetcher discardUnusedLineBuffers];
     [self runPostRestorationBlockIfNeeded];
 }
 
@@ -274,8 +279,21 @@ NSString *const iTermWindowStateKeyGUID = @"guid";
             }
             DLog(@"Done running block for id %@", identifier);
         };
-        DLog(@"Queueing block to run");
-        [queuedBlocks addObject:[[theBlock copy] autorelease]];
+        if ([iTermLineBufferPrefetcher enabled] && [iTermAdvancedSettingsModel restoreWindowContents]) {
+            // Decode scrollback while earlier windows are being created.
+            [PseudoTerminal prefetchContentsInArrangement:arrangement];
+        }
+        if ([iTermLineBufferPrefetcher enabled] &&
+            [PseudoTerminal arrangementIsKeyWindow:arrangement] &&
+            !gRunningQueuedBlock) {
+            // The window the user was looking at appears first. Other windows' scrollback keeps
+            // decoding in the background meanwhile.
+            DLog(@"Queueing block for key window to run first");
+            [queuedBlocks insertObject:[[theBlock copy] autorelease] atIndex:0];
+        } else {
+            DLog(@"Queueing block to run");
+            [queuedBlocks addObject:[[theBlock copy] autorelease]];
+        }
         DLog(@"Returning");
     } else {
         DLog(@"Abort because no arrangement");
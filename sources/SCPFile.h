@@ -14,4 +14,9 @@
 @property(nonatomic, retain) SCPPath *path;
 @property(atomic, copy) NSString *localPath;
 
+// Transfers to start on connections of their own once this one succeeds. By then the host is
+// known, so they can connect without asking about it again. Each should have hasPredecessor set so
+// it doesn't start by itself.
+@property(atomic, copy) NSArray<SCPFile *> *concurrentSuccessors;
+
 @end
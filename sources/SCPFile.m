@@ -328,6 +328,8 @@ static NSError *SCPFileError(NSString *description) {
     }
     _okToAdd = NO;
     int effectivePort;
+    // A successor reuses its predecessor's session, which is already connected to the agent.
+    const BOOL isNewSession = (self.session == nil);
     if (self.session) {
         self.session.delegate = self;
         effectivePort = self.session.port.intValue;
@@ -383,7 +385,7 @@ static NSError *SCPFileError(NSString *description) {
     }
 
     BOOL didConnectToAgent = NO;
-    if (agentAllowed && !self.hasPredecessor) {
+    if (agentAllowed && isNewSession) {
         DLog(@"Connect to agent");
         self.session.authSock = [[iTermAuthSock sharedInstance] authSock];
         [self.session connectToAgent];
@@ -675,6 +677,9 @@ static NSError *SCPFileError(NSString *description) {
             [[FileTransferManager sharedInstance] transferrableFile:self
                                      didFinishTransmissionWithError:error];
         });
+        if (!error) {
+            [self startConcurrentSuccessors:isDownload];
+        }
         if (!error && self.successor) {
             SCPFile *scpSuccessor = (SCPFile *)self.successor;
             scpSuccessor.session = self.session;
@@ -686,6 +691,17 @@ static NSError *SCPFileError(NSString *description) {
     }
 }
 
+- (void)startConcurrentSuccessors:(BOOL)isDownload {
+    NSArray<SCPFile *> *files = self.concurrentSuccessors;
+    self.concurrentSuccessors = nil;
+    for (SCPFile *file in files) {
+        DLog(@"Start concurrent transfer of %@", file.path.path);
+        dispatch_async(file.queue, ^() {
+            [file performTransferWrapper:isDownload];
+        });
+    }
+}
+
 - (NSString *)tempFileName {
     NSString *result = [NSString stringWithFormat:@".iTerm2.%@", [NSString uuid]];
 
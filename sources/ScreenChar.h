@@ -317,6 +317,13 @@ static inline BOOL ForegroundAttributesEqual(const screen_char_t a,
     }
 }
 
+// Cells with these codes, like DWC_RIGHT and TAB_FILLER, are dropped when a line is converted to
+// text whether or not they are complex. Code that scans cells to predict what the text will
+// contain must skip exactly these.
+static inline BOOL ScreenCharIsPrivateUse(unichar code) {
+    return code >= ITERM2_PRIVATE_BEGIN && code <= ITERM2_PRIVATE_END;
+}
+
 static inline BOOL ScreenCharHasDefaultAttributesAndColors(const screen_char_t s) {
     return (s.backgroundColor == ALTSEM_DEFAULT &&
             s.foregroundColor == ALTSEM_DEFAULT &&
@@ -399,6 +406,22 @@ NSString* ScreenCharArrayToString(screen_char_t* screenChars,
                                   unichar** backingStorePtr,
                                   int** deltasPtr);
 
+// The conversion underlying ScreenCharArrayToString, for callers that manage their own buffers.
+// Writes the UTF-16 for screenChars[start..<end] to |dest|, which needs room for
+// (end - start) * kMaxParts code units. Private-use cells such as DWC_RIGHT and TAB_FILLER produce
+// nothing, and so do images if |skipImages| is set. If |deltas| is not NULL it gets the values
+// described above and needs room for one more element than |dest|. If |codeUnitsPerCell| is not
+// NULL it gets the number of code units produced by each of the (end - start) cells. Returns the
+// number of code units written. Runs of ordinary cells are copied without examining each cell
+// separately; only complex characters and the cells above take the slow path.
+int ScreenCharArrayToUnichars(const screen_char_t *screenChars,
+                              int start,
+                              int end,
+                              BOOL skipImages,
+                              unichar *dest,
+                              int *deltas,
+                              int *codeUnitsPerCell);
+
 // Number of chars before a sequence of nuls at the end of the line.
 int EffectiveLineLength(screen_char_t* theLine, int totalLength);
 
@@ -467,6 +490,15 @@ void SetDecodedImage(unichar code, iTermImage *image, NSData *data);
 // Releases all memory associated with an image. The code comes from ImageCharForNewImage.
 void ReleaseImage(unichar code);
 
+// If decoded images use more memory than the inlineImageMemoryBudget advanced setting allows,
+// discards the decoded frames of the least recently drawn ones. They're decoded again from their
+// original data when next drawn.
+void EnforceImageMemoryBudget(void);
+
+// Discards the decoded frames of every image that hasn't been drawn in the last few seconds,
+// regardless of the budget. Returns the number of bytes freed.
+NSInteger DiscardUndrawnDecodedImages(void);
+
 // Returns image info for a code found in a screen_char_t with field image==1.
 iTermImageInfo *GetImageInfo(unichar code);
 
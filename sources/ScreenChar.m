@@ -30,11 +30,14 @@
 
 #import "ScreenChar.h"
 
+#import <QuartzCore/QuartzCore.h>
+
 #import "DebugLogging.h"
 #import "charmaps.h"
 #import "iTermAdvancedSettingsModel.h"
 #import "iTermImageInfo.h"
 #import "iTermMalloc.h"
+#import "iTermUnicodeProperties.h"
 #import "NSArray+iTerm.h"
 #import "NSCharacterSet+iTerm.h"
 
@@ -56,6 +59,14 @@ static NSMutableDictionary* inverseComplexCharMap;
 static NSMutableDictionary<NSNumber *, iTermImageInfo *> *gImages;
 static NSMutableDictionary* gEncodableImageMap;
 // Next available code.
+// Mirrors complexCharMap and spacingCombiningMarkCodeNumbers as flat tables indexed by code, so
+// lookups from drawing and search are a load rather than a hash of a boxed number. Entries are
+// written only on the main thread and each is a single pointer or byte, so other threads may read
+// without locking. See ComplexCharTableSet for how replaced strings are kept alive.
+static NSString *gComplexCharTable[0x10000];
+static uint8_t gSpacingCombiningMarkTable[0x10000];
+static NSMutableArray<NSString *> *gRetiredComplexChars;
+
 static int ccmNextKey = 1;
 // If ccmNextKey has wrapped then this is set to true and we have to delete old
 // strings before creating a new one with a recycled code.
@@ -250,16 +261,45 @@ static void CreateComplexCharMapIfNeeded() {
     }
 }
 
+static void ComplexCharTableSet(int key, NSString *str, BOOL isSpacingCombiningMark) {
+    if (key < 0 || key > 0xffff) {
+        return;
+    }
+    NSString *old = gComplexCharTable[key];
+    gComplexCharTable[key] = [str copy];
+    gSpacingCombiningMarkTable[key] = isSpacingCombiningMark;
+    if (!old) {
+        return;
+    }
+    // Another thread may have just loaded the old pointer, so keep it alive for a while. Anything
+    // that read it has finished with it by the time the retired strings are released.
+    if (!gRetiredComplexChars) {
+        gRetiredComplexChars = [[NSMutableArray alloc] init];
+        dispatch_after(dispatch_time(DISPATCH_TIME_NOW, (int64_t)(1 * NSEC_PER_SEC)), dispatch_get_main_queue(), ^{
+            [gRetiredComplexChars release];
+            gRetiredComplexChars = nil;
+        });
+    }
+    [gRetiredComplexChars addObject:old];
+    [old release];
+}
+
 NSString *ComplexCharToStr(int key) {
     if (key == UNICODE_REPLACEMENT_CHAR) {
         return ReplacementString();
     }
 
+    if ([iTermAdvancedSettingsModel flatComplexCharTable] && key >= 0 && key <= 0xffff) {
+        return gComplexCharTable[key];
+    }
     CreateComplexCharMapIfNeeded();
     return [complexCharMap objectForKey:[NSNumber numberWithInt:key]];
 }
 
 BOOL ComplexCharCodeIsSpacingCombiningMark(unichar code) {
+    if ([iTermAdvancedSettingsModel flatComplexCharTable]) {
+        return gSpacingCombiningMarkTable[code];
+    }
     return [spacingCombiningMarkCodeNumbers containsObject:@(code)];
 }
 
@@ -364,6 +404,53 @@ void SetDecodedImage(unichar code, iTermImage *image, NSData *data) {
         [NSApp invalidateRestorableState];
     }
     DLog(@"set decoded image in %@", imageInfo);
+    EnforceImageMemoryBudget();
+}
+
+// Returns the number of bytes freed.
+static NSInteger ReduceDecodedImagesToBudget(NSInteger budget) {
+    NSArray<iTermImageInfo *> *infos = gImages.allValues;
+    NSInteger total = 0;
+    for (iTermImageInfo *info in infos) {
+        total += info.decodedByteCount;
+    }
+    if (total <= budget) {
+        return 0;
+    }
+    // Anything drawn in the last few seconds is probably visible, so leave it be even if that means
+    // going over budget.
+    const CFTimeInterval cutoff = CACurrentMediaTime() - 5;
+    NSArray<iTermImageInfo *> *candidates = [infos filteredArrayUsingBlock:^BOOL(iTermImageInfo *info) {
+        return info.decodedByteCount > 0 && info.lastUseTime < cutoff;
+    }];
+    candidates = [candidates sortedArrayUsingComparator:^NSComparisonResult(iTermImageInfo *lhs, iTermImageInfo *rhs) {
+        return [@(lhs.lastUseTime) compare:@(rhs.lastUseTime)];
+    }];
+    DLog(@"Decoded images use %@ bytes, over the budget of %@", @(total), @(budget));
+    NSInteger reclaimed = 0;
+    for (iTermImageInfo *info in candidates) {
+        if (total <= budget) {
+            break;
+        }
+        const NSInteger bytes = info.decodedByteCount;
+        if ([info discardDecodedImage]) {
+            total -= bytes;
+            reclaimed += bytes;
+        }
+    }
+    return reclaimed;
+}
+
+void EnforceImageMemoryBudget(void) {
+    const NSInteger budget = (NSInteger)[iTermAdvancedSettingsModel inlineImageMemoryBudget] * 1024 * 1024;
+    if (budget <= 0) {
+        return;
+    }
+    ReduceDecodedImagesToBudget(budget);
+}
+
+NSInteger DiscardUndrawnDecodedImages(void) {
+    return ReduceDecodedImagesToBudget(0);
 }
 
 void ReleaseImage(unichar code) {
@@ -404,9 +491,11 @@ int GetOrSetComplexChar(NSString *str,
             [spacingCombiningMarkCodeNumbers removeObject:number];
         }
     }
+    BOOL scm = NO;
     switch (isSpacingCombiningMark) {
         case iTermTriStateTrue:
             [spacingCombiningMarkCodeNumbers addObject:number];
+            scm = YES;
             break;
         case iTermTriStateFalse:
             break;
@@ -414,11 +503,13 @@ int GetOrSetComplexChar(NSString *str,
             NSCharacterSet *scmSet = [NSCharacterSet spacingCombiningMarksForUnicodeVersion:12];
             if ([str rangeOfCharacterFromSet:scmSet].location != NSNotFound) {
                 [spacingCombiningMarkCodeNumbers addObject:number];
+                scm = YES;
             }
         }
     }
     complexCharMap[number] = str;
     inverseComplexCharMap[str] = number;
+    ComplexCharTableSet(newKey, str, scm);
     if ([iTermAdvancedSettingsModel restoreWindowContents]) {
         [NSApp invalidateRestorableState];
     }
@@ -447,7 +538,59 @@ int AppendToComplexChar(int key, unichar codePoint) {
     return GetOrSetComplexChar(temp, iTermTriStateOther);
 }
 
+// Returns YES if a UTF-16 code unit is a character that normalization leaves alone when everything
+// around it is stable too: it has no canonical decomposition (only checked when decomposing) and is
+// not a combining mark, and anything that could combine with it is not stable. These are a few big
+// ranges where this is known to hold, not the full NFC_QC and NFD_QC properties, so everything else
+// takes the slow path.
+NS_INLINE BOOL CodeUnitIsStableUnderNormalization(unichar c, BOOL decomposing) {
+    if (c < 0x2500) {
+        // Latin-1 letters like é have canonical decompositions but are already composed. U+0300 is
+        // where combining marks begin.
+        return c < (decomposing ? 0xc0 : 0x300);
+    }
+    if (c <= 0x28ff) {
+        // Box drawing, block elements, geometric shapes, miscellaneous symbols, dingbats, and braille.
+        return YES;
+    }
+    if (c >= 0x4e00 && c <= 0x9fff) {
+        // CJK unified ideographs.
+        return YES;
+    }
+    if (c >= 0xff00 && c <= 0xffef) {
+        // Halfwidth and fullwidth forms only have compatibility decompositions.
+        return YES;
+    }
+    if (decomposing) {
+        return NO;
+    }
+    // Kana other than the combining voiced sound marks at U+3099 and U+309A, and Hangul syllables.
+    // Both have canonical decompositions, but they're already composed.
+    return ((c >= 0x3041 && c <= 0x3096) ||
+            (c >= 0x30a0 && c <= 0x30ff) ||
+            (c >= 0xac00 && c <= 0xd7a3));
+}
+
+static BOOL StringIsStableUnderNormalization(NSString *theString, iTermUnicodeNormalization normalization) {
+    const BOOL decomposing = (normalization != iTermUnicodeNormalizationNFC);
+    const CFIndex length = CFStringGetLength((CFStringRef)theString);
+    CFStringInlineBuffer inlineBuffer;
+    CFStringInitInlineBuffer((CFStringRef)theString, &inlineBuffer, CFRangeMake(0, length));
+    for (CFIndex i = 0; i < length; i++) {
+        if (!CodeUnitIsStableUnderNormalization(CFStringGetCharacterFromInlineBuffer(&inlineBuffer, i),
+                                                decomposing)) {
+            return NO;
+        }
+    }
+    return YES;
+}
+
 NSString *StringByNormalizingString(NSString *theString, iTermUnicodeNormalization normalization) {
+    if (normalization != iTermUnicodeNormalizationNone &&
+        [iTermAdvancedSettingsModel quickCheckUnicodeNormalization] &&
+        StringIsStableUnderNormalization(theString, normalization)) {
+        return theString;
+    }
     NSString *normalizedString;
     switch (normalization) {
         case iTermUnicodeNormalizationNFC:
@@ -471,7 +614,6 @@ void SetComplexCharInScreenChar(screen_char_t *screenChar,
                                 iTermUnicodeNormalization normalization,
                                 BOOL isSpacingCombiningMark) {
     NSString *normalizedString = StringByNormalizingString(theString, normalization);
-    [theString precomposedStringWithCanonicalMapping];
     if (normalizedString.length == 1 && !isSpacingCombiningMark) {
         screenChar->code = [normalizedString characterAtIndex:0];
     } else {
@@ -539,6 +681,78 @@ BOOL IsHighSurrogate(unichar c)
     return c >= 0xd800 && c <= 0xdbff;
 }
 
+// Cells are examined this many at a time on the fast path.
+static const int kScreenCharArrayToUnicharsStride = 8;
+
+int ScreenCharArrayToUnichars(const screen_char_t *screenChars,
+                              int start,
+                              int end,
+                              BOOL skipImages,
+                              unichar *dest,
+                              int *deltas,
+                              int *codeUnitsPerCell) {
+    // See ScreenCharArrayToString for a description of deltas.
+    int delta = 0;
+    int o = 0;
+    int i = start;
+    while (i < end) {
+        if (i + kScreenCharArrayToUnicharsStride <= end) {
+            // Fast path: if none of the next few cells need special handling, each is exactly one
+            // code unit equal to its code. Neither loop branches on the contents of a cell, so the
+            // compiler can vectorize them.
+            unsigned int special = 0;
+            for (int k = 0; k < kScreenCharArrayToUnicharsStride; k++) {
+                const screen_char_t *c = &screenChars[i + k];
+                special |= c->complexChar | (skipImages & c->image) | ScreenCharIsPrivateUse(c->code);
+            }
+            if (!special) {
+                for (int k = 0; k < kScreenCharArrayToUnicharsStride; k++) {
+                    dest[o + k] = screenChars[i + k].code;
+                }
+                if (deltas) {
+                    for (int k = 0; k < kScreenCharArrayToUnicharsStride; k++) {
+                        deltas[o + k] = delta;
+                    }
+                }
+                if (codeUnitsPerCell) {
+                    for (int k = 0; k < kScreenCharArrayToUnicharsStride; k++) {
+                        codeUnitsPerCell[i - start + k] = 1;
+                    }
+                }
+                o += kScreenCharArrayToUnicharsStride;
+                i += kScreenCharArrayToUnicharsStride;
+                continue;
+            }
+        }
+        const screen_char_t *c = &screenChars[i];
+        int len = 0;
+        if (ScreenCharIsPrivateUse(c->code) || (skipImages && c->image)) {
+            // Skip private-use characters which signify things like double-width characters and
+            // tab fillers.
+            ++delta;
+        } else {
+            len = ExpandScreenChar((screen_char_t *)c, dest + o);
+            ++delta;
+            if (deltas) {
+                for (int j = o; j < o + len; ++j) {
+                    deltas[j] = --delta;
+                }
+            } else {
+                delta -= len;
+            }
+            o += len;
+        }
+        if (codeUnitsPerCell) {
+            codeUnitsPerCell[i - start] = len;
+        }
+        i++;
+    }
+    if (deltas) {
+        deltas[o] = delta;
+    }
+    return o;
+}
+
 NSString* ScreenCharArrayToString(screen_char_t* screenChars,
                                   int start,
                                   int end,
@@ -581,24 +795,7 @@ NSString* ScreenCharArrayToString(screen_char_t* screenChars,
     //
     // screen_char_t[i + deltas[i]] begins its run at charHaystack[i]
     // CharHaystackIndexToScreenCharTIndex(i) : i + deltas[i]
-    int delta = 0;
-    int o = 0;
-    for (int i = start; i < end; ++i) {
-        unichar c = screenChars[i].code;
-        if (c >= ITERM2_PRIVATE_BEGIN && c <= ITERM2_PRIVATE_END) {
-            // Skip private-use characters which signify things like double-width characters and
-            // tab fillers.
-            ++delta;
-        } else {
-            const int len = ExpandScreenChar(&screenChars[i], charHaystack + o);
-            ++delta;
-            for (int j = o; j < o + len; ++j) {
-                deltas[j] = --delta;
-            }
-            o += len;
-        }
-    }
-    deltas[o] = delta;
+    const int o = ScreenCharArrayToUnichars(screenChars, start, end, NO, charHaystack, deltas, NULL);
 
     return CharArrayToString(charHaystack, o);
 }
@@ -676,6 +873,22 @@ void StringToScreenChars(NSString *s,
     __block BOOL foundCursor = NO;
     NSCharacterSet *ignorableCharacters = [NSCharacterSet ignorableCharactersForUnicodeVersion:unicodeVersion];
     NSCharacterSet *spacingCombiningMarks = [NSCharacterSet spacingCombiningMarksForUnicodeVersion:12];
+    const iTermUnicodePropertyTable *properties =
+        [iTermAdvancedSettingsModel unicodePropertyTable] ? iTermUnicodePropertyTableForVersion(unicodeVersion) : NULL;
+    BOOL (^isIgnorable)(UTF32Char) = ^BOOL(UTF32Char c) {
+        if (properties) {
+            return (iTermUnicodePropertiesOfCodePoint(properties, c) & iTermUnicodePropertyIgnorable) != 0;
+        }
+        return [ignorableCharacters longCharacterIsMember:c];
+    };
+    BOOL (^isDoubleWidthCharacter)(UTF32Char) = ^BOOL(UTF32Char c) {
+        if (properties) {
+            return iTermUnicodePropertyTableIsDoubleWidth(properties, c, ambiguousIsDoubleWidth);
+        }
+        return [NSString isDoubleWidthCharacter:c
+                         ambiguousIsDoubleWidth:ambiguousIsDoubleWidth
+                                 unicodeVersion:unicodeVersion];
+    };
 
     [s enumerateComposedCharacters:^(NSRange range,
                                      unichar baseBmpChar,
@@ -699,9 +912,10 @@ void StringToScreenChars(NSString *s,
                 AppendToChar(&buf[j - 1], baseBmpChar);
                 return;
             }
-            if ([ignorableCharacters characterIsMember:baseBmpChar]) {
+            if (isIgnorable(baseBmpChar)) {
                 return;
-            } else if ([spacingCombiningMarks characterIsMember:baseBmpChar]) {
+            } else if (properties ? (iTermUnicodePropertiesOfCodePoint(properties, baseBmpChar) & iTermUnicodePropertySpacingCombiningMark)
+                                  : [spacingCombiningMarks characterIsMember:baseBmpChar]) {
                 composedOrNonBmpChar = [NSString stringWithLongCharacter:baseBmpChar];
                 baseBmpChar = 0;
                 spacingCombiningMark = YES;
@@ -719,9 +933,7 @@ void StringToScreenChars(NSString *s,
                 buf[j].code = baseBmpChar;
                 buf[j].complexChar = NO;
 
-                isDoubleWidth = [NSString isDoubleWidthCharacter:baseBmpChar
-                                          ambiguousIsDoubleWidth:ambiguousIsDoubleWidth
-                                                  unicodeVersion:unicodeVersion];
+                isDoubleWidth = isDoubleWidthCharacter(baseBmpChar);
             }
         }
         if (composedOrNonBmpChar) {
@@ -741,13 +953,11 @@ void StringToScreenChars(NSString *s,
             if (IsHighSurrogate(baseChar) && composedLength > 1) {
                 baseChar = DecodeSurrogatePair(baseChar, [composedOrNonBmpChar characterAtIndex:1]);
                 next += 1;
-                if (composedLength == 2 && [ignorableCharacters longCharacterIsMember:baseChar]) {
+                if (composedLength == 2 && isIgnorable(baseChar)) {
                     return;
                 }
             }
-            isDoubleWidth = [NSString isDoubleWidthCharacter:baseChar
-                                      ambiguousIsDoubleWidth:ambiguousIsDoubleWidth
-                                              unicodeVersion:unicodeVersion];
+            isDoubleWidth = isDoubleWidthCharacter(baseChar);
             if (!isDoubleWidth && composedLength > next) {
                 const unichar peek = [composedOrNonBmpChar characterAtIndex:next];
                 if (peek == 0xfe0f) {
@@ -857,6 +1067,11 @@ void ScreenCharDecodeRestorableState(NSDictionary *state) {
     for (NSNumber *number in spacingCombiningMarksArray) {
         [spacingCombiningMarkCodeNumbers addObject:number];
     }
+    for (NSNumber *key in complexCharMap) {
+        ComplexCharTableSet(key.intValue,
+                            complexCharMap[key],
+                            [spacingCombiningMarkCodeNumbers containsObject:key]);
+    }
 
     NSDictionary *stateInverseMap = state[kScreenCharInverseComplexCharMapKey];
     for (id key in stateInverseMap) {
@@ -65,7 +65,13 @@
 
 - (void)runCommand:(NSString *)command session:(PTYSession *)session {
     DLog(@"Invoking command %@", command);
-    iTermBackgroundCommandRunner *runner = [[ScriptTrigger commandRunnerPool] requestBackgroundCommandRunnerWithTerminationBlock:nil];
+    iTermCommandRunnerPriority priority = iTermCommandRunnerPriorityBackground;
+    if ([iTermAdvancedSettingsModel prioritizeVisibleTriggerCommands] &&
+        [session.delegate sessionBelongsToVisibleTab]) {
+        priority = iTermCommandRunnerPriorityForeground;
+    }
+    iTermBackgroundCommandRunner *runner = [[ScriptTrigger commandRunnerPool] requestBackgroundCommandRunnerWithPriority:priority
+                                                                                                     terminationBlock:nil];
     runner.command = command;
     runner.shell = session.userShell;
     runner.title = @"Run Command Trigger";
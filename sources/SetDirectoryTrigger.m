@@ -30,6 +30,11 @@
     return YES;
 }
 
+// The directory is recorded on the cursor line.
+- (BOOL)needsSynchronousEvaluation {
+    return YES;
+}
+
 - (BOOL)performActionWithCapturedStrings:(NSString *const *)capturedStrings
                           capturedRanges:(const NSRange *)capturedRanges
                             captureCount:(NSInteger)captureCount
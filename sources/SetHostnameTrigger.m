@@ -28,6 +28,11 @@
     return YES;
 }
 
+// The host is recorded on the cursor line.
+- (BOOL)needsSynchronousEvaluation {
+    return YES;
+}
+
 - (BOOL)performActionWithCapturedStrings:(NSString *const *)capturedStrings
                           capturedRanges:(const NSRange *)capturedRanges
                             captureCount:(NSInteger)captureCount
@@ -0,0 +1,36 @@
+//
+//  TaskNotifier+Private.h
+//  iTerm2
+//
+//  Created by agent on 10/14/26.
+//
+
+#import "TaskNotifier.h"
+
+// Exposed for testing
+
+// A poller collects the file descriptors that the run loop is interested in,
+// waits until at least one of them is ready, and then answers questions about
+// which were ready. Interest is declared anew before each call to -wait.
+@protocol iTermTaskNotifierPoller<NSObject>
+- (void)addFileDescriptor:(int)fd
+                    owner:(id)owner
+                     read:(BOOL)read
+                    write:(BOOL)write
+                    error:(BOOL)error;
+// Returns NO if the wait failed (e.g., EINTR or EBADF).
+- (BOOL)wait;
+- (BOOL)fileDescriptorIsReadable:(int)fd;
+- (BOOL)fileDescriptorIsWritable:(int)fd;
+- (BOOL)fileDescriptorHasError:(int)fd;
+@end
+
+// The legacy poller. It rebuilds three fd_sets on every iteration and can't
+// handle file descriptors at or above FD_SETSIZE.
+@interface iTermSelectTaskNotifierPoller : NSObject<iTermTaskNotifierPoller>
+@end
+
+// Keeps filters registered in the kernel across iterations. Returns nil from
+// -init if a kqueue can't be created.
+@interface iTermKqueueTaskNotifierPoller : NSObject<iTermTaskNotifierPoller>
+@end
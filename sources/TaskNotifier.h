@@ -1,4 +1,5 @@
-// This implements a select loop that runs in a special thread.
+// This implements a select loop that runs in a special thread. Optionally, tasks are
+// spread over several such threads so a busy session can't delay reads for the others.
 
 #import <Foundation/Foundation.h>
 
@@ -39,7 +40,10 @@ extern NSString *const kCoprocessStatusChangeNotification;
 - (void)registerTask:(id<iTermTask>)task;
 - (void)deregisterTask:(id<iTermTask>)task;
 
+// Wakes up every notifier thread.
 - (void)unblock;
+// Wakes up only the notifier thread that owns `task`.
+- (void)unblockTask:(id<iTermTask>)task;
 - (void)run;
 
 - (void)waitForPid:(pid_t)pid;
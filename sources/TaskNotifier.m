@@ -7,9 +7,14 @@
 //
 
 #import "TaskNotifier.h"
+#import "TaskNotifier+Private.h"
 #import "Coprocess.h"
 #import "DebugLogging.h"
+#import "iTermAdvancedSettingsModel.h"
+#import "iTermSignposts.h"
 
+#include <sys/event.h>
+#include <sys/sysctl.h>
 #include <sys/time.h>
 #include <sys/select.h>
 
@@ -17,8 +22,365 @@
 
 NSString *const kCoprocessStatusChangeNotification = @"kCoprocessStatusChangeNotification";
 
-static int unblockPipeR;
-static int unblockPipeW;
+// Write ends of every notifier thread's unblock pipe. Read from a signal
+// handler, so entries are only ever appended and never modified.
+static const int iTermTaskNotifierMaximumShards = 16;
+static int sUnblockPipeWriteFileDescriptors[iTermTaskNotifierMaximumShards];
+static volatile int sNumberOfUnblockPipes;
+
+#pragma mark - select()
+
+@implementation iTermSelectTaskNotifierPoller {
+    fd_set _rfds;
+    fd_set _wfds;
+    fd_set _efds;
+    int _highfd;
+    // The fd_sets hold the results of the last wait and must be cleared before new interest is added.
+    BOOL _needsReset;
+}
+
+- (instancetype)init {
+    self = [super init];
+    if (self) {
+        [self reset];
+    }
+    return self;
+}
+
+- (void)reset {
+    FD_ZERO(&_rfds);
+    FD_ZERO(&_wfds);
+    FD_ZERO(&_efds);
+    _highfd = -1;
+    _needsReset = NO;
+}
+
+- (void)addFileDescriptor:(int)fd
+                    owner:(id)owner
+                     read:(BOOL)read
+                    write:(BOOL)write
+                    error:(BOOL)error {
+    if (_needsReset) {
+        [self reset];
+    }
+    if (fd < 0) {
+        return;
+    }
+    if (fd > _highfd) {
+        _highfd = fd;
+    }
+    if (read) {
+        FD_SET(fd, &_rfds);
+    }
+    if (write) {
+        FD_SET(fd, &_wfds);
+    }
+    if (error) {
+        FD_SET(fd, &_efds);
+    }
+}
+
+- (BOOL)wait {
+    const BOOL ok = select(_highfd + 1, &_rfds, &_wfds, &_efds, NULL) > 0;
+    if (!ok) {
+        // Leave no stale results behind.
+        [self reset];
+    }
+    _needsReset = YES;
+    return ok;
+}
+
+- (BOOL)fileDescriptorIsReadable:(int)fd {
+    return fd >= 0 && FD_ISSET(fd, &_rfds);
+}
+
+- (BOOL)fileDescriptorIsWritable:(int)fd {
+    return fd >= 0 && FD_ISSET(fd, &_wfds);
+}
+
+- (BOOL)fileDescriptorHasError:(int)fd {
+    return fd >= 0 && FD_ISSET(fd, &_efds);
+}
+
+@end
+
+#pragma mark - kqueue
+
+typedef NS_OPTIONS(unsigned char, iTermTaskNotifierInterest) {
+    iTermTaskNotifierInterestRead = 1 << 0,
+    iTermTaskNotifierInterestWrite = 1 << 1,
+    iTermTaskNotifierInterestError = 1 << 2
+};
+
+typedef struct {
+    // Filters currently registered in the kqueue.
+    iTermTaskNotifierInterest registered;
+    // The serial number of the object that owned the fd when its filters were
+    // registered. Closing an fd removes its filters from the kqueue, so if the
+    // number gets reused by a different owner the filters must be added again.
+    // Serials aren't reused, unlike the address of a freed owner.
+    NSUInteger registeredOwnerSerial;
+
+    // Interest declared for the upcoming wait.
+    iTermTaskNotifierInterest desired;
+    NSUInteger desiredOwnerSerial;
+
+    // Results of the last wait.
+    iTermTaskNotifierInterest ready;
+
+    // Whether the fd is in _liveFileDescriptors.
+    BOOL live;
+} iTermKqueueFileDescriptorState;
+
+// Filters stay registered in the kernel across iterations. Each wait submits
+// only the changes since the previous wait and the kernel reports only the
+// fds that are actually ready. The work per wait is proportional to the
+// number of fds declared or still registered rather than to the largest fd,
+// and there's no FD_SETSIZE limit.
+//
+// kqueue has no filter for exceptional conditions. EOF and errors are
+// reported on the read or write filter instead, so error interest is only
+// honored while the fd is also registered for reading or writing.
+@implementation iTermKqueueTaskNotifierPoller {
+    int _kq;
+
+    // Indexed by file descriptor.
+    iTermKqueueFileDescriptorState *_states;
+    int _statesCapacity;
+    // One past the largest fd that has ever been added.
+    int _statesCount;
+
+    // The fds that were declared since the last wait, still have filters
+    // registered, or have results from the last wait. Only these can need
+    // changes or have state to reset, so -wait looks at nothing else.
+    int *_liveFileDescriptors;
+    int _liveFileDescriptorsCount;
+    int _liveFileDescriptorsCapacity;
+
+    // Weak owner -> NSNumber serial.
+    NSMapTable *_ownerSerials;
+    NSUInteger _lastOwnerSerial;
+
+    struct kevent *_changes;
+    struct kevent *_events;
+    int _keventCapacity;
+}
+
+- (instancetype)init {
+    self = [super init];
+    if (self) {
+        _kq = kqueue();
+        if (_kq < 0) {
+            DLog(@"kqueue() failed: %s", strerror(errno));
+            [self release];
+            return nil;
+        }
+        // Weak keys compared by address: a dead owner's entry goes away, so a
+        // new owner allocated at the same address gets a new serial.
+        NSPointerFunctionsOptions weakPointer = (NSPointerFunctionsWeakMemory | NSPointerFunctionsObjectPointerPersonality);
+        _ownerSerials = [[NSMapTable alloc] initWithKeyOptions:weakPointer
+                                                  valueOptions:NSPointerFunctionsStrongMemory
+                                                      capacity:16];
+    }
+    return self;
+}
+
+- (void)dealloc {
+    close(_kq);
+    [_ownerSerials release];
+    free(_states);
+    free(_liveFileDescriptors);
+    free(_changes);
+    free(_events);
+    [super dealloc];
+}
+
+- (void)addFileDescriptor:(int)fd
+                    owner:(id)owner
+                     read:(BOOL)read
+                    write:(BOOL)write
+                    error:(BOOL)error {
+    if (fd < 0) {
+        return;
+    }
+    if (fd >= _statesCapacity) {
+        const int newCapacity = MAX(fd + 1, MAX(64, _statesCapacity * 2));
+        _states = realloc(_states, sizeof(*_states) * newCapacity);
+        memset(_states + _statesCapacity, 0, sizeof(*_states) * (newCapacity - _statesCapacity));
+        _statesCapacity = newCapacity;
+    }
+    _statesCount = MAX(_statesCount, fd + 1);
+    iTermKqueueFileDescriptorState *state = &_states[fd];
+    [self makeFileDescriptorLive:fd state:state];
+    if (read) {
+        state->desired |= iTermTaskNotifierInterestRead;
+    }
+    if (write) {
+        state->desired |= iTermTaskNotifierInterestWrite;
+    }
+    if (error) {
+        state->desired |= iTermTaskNotifierInterestError;
+    }
+    state->desiredOwnerSerial = [self serialForOwner:owner];
+}
+
+- (NSUInteger)serialForOwner:(id)owner {
+    if (!owner) {
+        return 0;
+    }
+    NSNumber *serial = [_ownerSerials objectForKey:owner];
+    if (!serial) {
+        serial = @(++_lastOwnerSerial);
+        [_ownerSerials setObject:serial forKey:owner];
+    }
+    return serial.unsignedIntegerValue;
+}
+
+- (void)makeFileDescriptorLive:(int)fd state:(iTermKqueueFileDescriptorState *)state {
+    if (state->live) {
+        return;
+    }
+    if (_liveFileDescriptorsCount == _liveFileDescriptorsCapacity) {
+        _liveFileDescriptorsCapacity = MAX(16, _liveFileDescriptorsCapacity * 2);
+        _liveFileDescriptors = realloc(_liveFileDescriptors,
+                                       sizeof(*_liveFileDescriptors) * _liveFileDescriptorsCapacity);
+    }
+    _liveFileDescriptors[_liveFileDescriptorsCount++] = fd;
+    state->live = YES;
+}
+
+- (void)ensureKeventCapacity:(int)capacity {
+    if (capacity <= _keventCapacity) {
+        return;
+    }
+    const int newCapacity = MAX(capacity, _keventCapacity * 2);
+    _changes = realloc(_changes, sizeof(*_changes) * newCapacity);
+    _events = realloc(_events, sizeof(*_events) * newCapacity);
+    _keventCapacity = newCapacity;
+}
+
+static iTermTaskNotifierInterest iTermKqueueFilters(iTermTaskNotifierInterest interest) {
+    return interest & (iTermTaskNotifierInterestRead | iTermTaskNotifierInterestWrite);
+}
+
+// Appends changes to move `fd` from its registered filters to its desired filters.
+- (int)appendChangesForFileDescriptor:(int)fd
+                                state:(iTermKqueueFileDescriptorState *)state
+                            toChanges:(struct kevent *)changes {
+    iTermTaskNotifierInterest registered = state->registered;
+    if (registered && state->desiredOwnerSerial != 0 && state->registeredOwnerSerial != state->desiredOwnerSerial) {
+        // The fd was closed and reused. Its filters are already gone from the kqueue.
+        registered = 0;
+    }
+    const iTermTaskNotifierInterest desired = iTermKqueueFilters(state->desired);
+    int count = 0;
+    const struct {
+        iTermTaskNotifierInterest interest;
+        int16_t filter;
+    } filters[] = {
+        { iTermTaskNotifierInterestRead, EVFILT_READ },
+        { iTermTaskNotifierInterestWrite, EVFILT_WRITE }
+    };
+    for (size_t i = 0; i < sizeof(filters) / sizeof(*filters); i++) {
+        const BOOL want = !!(desired & filters[i].interest);
+        const BOOL have = !!(registered & filters[i].interest);
+        if (want && !have) {
+            EV_SET(&changes[count++], fd, filters[i].filter, EV_ADD | EV_ENABLE, 0, 0, NULL);
+        } else if (!want && have) {
+            EV_SET(&changes[count++], fd, filters[i].filter, EV_DELETE, 0, 0, NULL);
+        }
+    }
+    state->registered = desired;
+    state->registeredOwnerSerial = desired ? state->desiredOwnerSerial : 0;
+    return count;
+}
+
+- (BOOL)wait {
+    [self ensureKeventCapacity:MAX(16, _liveFileDescriptorsCount * 2)];
+    int numChanges = 0;
+    for (int i = 0; i < _liveFileDescriptorsCount; i++) {
+        const int fd = _liveFileDescriptors[i];
+        iTermKqueueFileDescriptorState *state = &_states[fd];
+        state->ready = 0;
+        numChanges += [self appendChangesForFileDescriptor:fd state:state toChanges:_changes + numChanges];
+        state->desired = 0;
+        state->desiredOwnerSerial = 0;
+    }
+
+    const int n = kevent(_kq, _changes, numChanges, _events, _keventCapacity, NULL);
+    for (int i = 0; i < n; i++) {
+        const struct kevent *event = &_events[i];
+        const int fd = (int)event->ident;
+        if (fd < 0 || fd >= _statesCount) {
+            continue;
+        }
+        iTermKqueueFileDescriptorState *state = &_states[fd];
+        if (event->flags & EV_ERROR) {
+            if (event->data == 0 || (event->flags & EV_DELETE)) {
+                // Deleting a filter on an fd that was already closed is expected.
+                continue;
+            }
+            // Couldn't add a filter, most likely because the fd is no longer valid.
+            DLog(@"kevent failed to register fd %d: %s", fd, strerror((int)event->data));
+            state->registered &= ~(event->filter == EVFILT_READ ? iTermTaskNotifierInterestRead : iTermTaskNotifierInterestWrite);
+            state->ready |= iTermTaskNotifierInterestError;
+            continue;
+        }
+        switch (event->filter) {
+            case EVFILT_READ:
+                state->ready |= iTermTaskNotifierInterestRead;
+                if ((event->flags & EV_EOF) && event->data == 0) {
+                    // The other end hung up and there's nothing left to read.
+                    state->ready |= iTermTaskNotifierInterestError;
+                }
+                break;
+            case EVFILT_WRITE:
+                state->ready |= iTermTaskNotifierInterestWrite;
+                if (event->flags & EV_EOF) {
+                    state->ready |= iTermTaskNotifierInterestError;
+                }
+                break;
+        }
+    }
+
+    // Forget fds that have nothing registered and nothing to report. An fd
+    // that failed to register keeps its error until the next wait resets it.
+    int liveCount = 0;
+    for (int i = 0; i < _liveFileDescriptorsCount; i++) {
+        const int fd = _liveFileDescriptors[i];
+        iTermKqueueFileDescriptorState *state = &_states[fd];
+        if (state->registered || state->ready) {
+            _liveFileDescriptors[liveCount++] = fd;
+        } else {
+            state->live = NO;
+        }
+    }
+    _liveFileDescriptorsCount = liveCount;
+    return n > 0;
+}
+
+- (BOOL)fileDescriptor:(int)fd isReady:(iTermTaskNotifierInterest)interest {
+    if (fd < 0 || fd >= _statesCount) {
+        return NO;
+    }
+    return !!(_states[fd].ready & interest);
+}
+
+- (BOOL)fileDescriptorIsReadable:(int)fd {
+    return [self fileDescriptor:fd isReady:iTermTaskNotifierInterestRead];
+}
+
+- (BOOL)fileDescriptorIsWritable:(int)fd {
+    return [self fileDescriptor:fd isReady:iTermTaskNotifierInterestWrite];
+}
+
+- (BOOL)fileDescriptorHasError:(int)fd {
+    return [self fileDescriptor:fd isReady:iTermTaskNotifierInterestError];
+}
+
+@end
+
+#pragma mark - TaskNotifier
 
 @implementation TaskNotifier
 {
@@ -30,6 +392,18 @@ static int unblockPipeW;
 
     // A set of NSNumber*s holding pids of tasks that need to be wait()ed on
     NSMutableSet* deadpool;
+
+    // Waits for I/O. Only used on the notifier thread.
+    id<iTermTaskNotifierPoller> _poller;
+
+    // Interrupts the wait when registrations change.
+    int _unblockPipeR;
+    int _unblockPipeW;
+
+    // When sharding is enabled the shared instance doesn't run a loop of its
+    // own. It routes each task to one of these, each of which runs on its own
+    // thread. Nil for the notifiers that do the actual work.
+    NSArray<TaskNotifier *> *_shards;
 }
 
 
@@ -37,14 +411,71 @@ static int unblockPipeW;
     static id instance;
     static dispatch_once_t once;
     dispatch_once(&once, ^{
-        instance = [[self alloc] init];
-        [NSThread detachNewThreadSelector:@selector(run)
-                                 toTarget:instance
-                               withObject:nil];
+        const int numberOfShards = [self numberOfShards];
+        if (numberOfShards > 1) {
+            NSMutableArray<TaskNotifier *> *shards = [NSMutableArray array];
+            for (int i = 0; i < numberOfShards; i++) {
+                TaskNotifier *shard = [[[self alloc] init] autorelease];
+                if (!shard) {
+                    break;
+                }
+                [shard startThreadWithName:[NSString stringWithFormat:@"com.iterm2.task-notifier-%d", i]];
+                [shards addObject:shard];
+            }
+            if (shards.count > 1) {
+                instance = [[self alloc] initWithShards:shards];
+            } else {
+                instance = [shards.firstObject retain];
+            }
+        }
+        if (!instance) {
+            instance = [[self alloc] init];
+            [instance startThreadWithName:@"com.iterm2.task-notifier"];
+        }
     });
     return instance;
 }
 
++ (int)numberOfShards {
+    int count = [iTermAdvancedSettingsModel taskNotifierThreads];
+    if (count == 0) {
+        // One per performance core. hw.perflevel0 only exists on machines with
+        // heterogeneous cores; elsewhere every core is a performance core.
+        int performanceCores = 0;
+        size_t size = sizeof(performanceCores);
+        if (sysctlbyname("hw.perflevel0.physicalcpu", &performanceCores, &size, NULL, 0) != 0 ||
+            performanceCores <= 0) {
+            performanceCores = (int)[[NSProcessInfo processInfo] activeProcessorCount];
+        }
+        count = performanceCores;
+    }
+    return MAX(1, MIN(iTermTaskNotifierMaximumShards, count));
+}
+
+- (void)startThreadWithName:(NSString *)name {
+    NSThread *thread = [[[NSThread alloc] initWithTarget:self
+                                                selector:@selector(run)
+                                                  object:nil] autorelease];
+    thread.name = name;
+    [thread start];
+}
+
+- (instancetype)initWithShards:(NSArray<TaskNotifier *> *)shards {
+    self = [super init];
+    if (self) {
+        _shards = [shards copy];
+    }
+    return self;
+}
+
+- (TaskNotifier *)shardForTask:(id<iTermTask>)task {
+    // Object addresses are aligned, so mix in the high bits before taking the modulus.
+    uintptr_t hash = (uintptr_t)task;
+    hash ^= hash >> 4;
+    hash ^= hash >> 16;
+    return _shards[hash % _shards.count];
+}
+
 - (instancetype)init {
     self = [super init];
     if (self) {
@@ -52,6 +483,12 @@ static int unblockPipeW;
         _tasks = [[NSMutableArray alloc] init];
         tasksLock = [[NSRecursiveLock alloc] init];
         tasksChanged = NO;
+        if ([iTermAdvancedSettingsModel useKqueueInTaskNotifier]) {
+            _poller = [[iTermKqueueTaskNotifierPoller alloc] init];
+        }
+        if (!_poller) {
+            _poller = [[iTermSelectTaskNotifierPoller alloc] init];
+        }
 
         int unblockPipe[2];
         if (pipe(unblockPipe) != 0) {
@@ -65,8 +502,13 @@ static int unblockPipeW;
             fcntl(unblockPipe[i], F_SETFD, flags | FD_CLOEXEC);
             fcntl(unblockPipe[i], F_SETFL, O_NONBLOCK);
         }
-        unblockPipeR = unblockPipe[0];
-        unblockPipeW = unblockPipe[1];
+        _unblockPipeR = unblockPipe[0];
+        _unblockPipeW = unblockPipe[1];
+
+        const int i = sNumberOfUnblockPipes;
+        assert(i < iTermTaskNotifierMaximumShards);
+        sUnblockPipeWriteFileDescriptors[i] = _unblockPipeW;
+        sNumberOfUnblockPipes = i + 1;
     }
     return self;
 }
@@ -75,13 +517,23 @@ static int unblockPipeW;
     [_tasks release];
     [tasksLock release];
     [deadpool release];
-    close(unblockPipeR);
-    close(unblockPipeW);
+    [_poller release];
+    if (!_shards) {
+        close(_unblockPipeR);
+        close(_unblockPipeW);
+    }
+    [_shards release];
     [super dealloc];
 }
 
 - (void)pipeDidBreakForExternalProcessID:(pid_t)pid status:(int)status {
     assert(pid >= 0);
+    if (_shards) {
+        for (TaskNotifier *shard in _shards) {
+            [shard pipeDidBreakForExternalProcessID:pid status:status];
+        }
+        return;
+    }
     [tasksLock lock];
     const NSInteger i = [_tasks indexOfObjectPassingTest:^BOOL(id<iTermTask>  _Nonnull obj, NSUInteger idx, BOOL * _Nonnull stop) {
         return obj.pid == pid;
@@ -101,6 +553,10 @@ static int unblockPipeW;
 }
 
 - (void)registerTask:(id<iTermTask>)task {
+    if (_shards) {
+        [[self shardForTask:task] registerTask:task];
+        return;
+    }
     PtyTaskDebugLog(@"registerTask: lock\n");
     [tasksLock lock];
     PtyTaskDebugLog(@"Add task at %p\n", (void*)task);
@@ -118,6 +574,10 @@ static int unblockPipeW;
 }
 
 - (void)deregisterTask:(id<iTermTask>)task {
+    if (_shards) {
+        [[self shardForTask:task] deregisterTask:task];
+        return;
+    }
     PtyTaskDebugLog(@"deregisterTask: lock\n");
     [tasksLock lock];
     PtyTaskDebugLog(@"Begin remove task %p\n", (void*)task);
@@ -141,6 +601,11 @@ static int unblockPipeW;
 
 // NB: This is currently used for coprocesses.
 - (void)waitForPid:(pid_t)pid {
+    if (_shards) {
+        // waitpid() isn't thread-specific so any shard will do.
+        [_shards.firstObject waitForPid:pid];
+        return;
+    }
     [tasksLock lock];
     [deadpool addObject:@(pid)];
     [tasksLock unlock];
@@ -148,21 +613,43 @@ static int unblockPipeW;
 }
 
 - (void)unblock {
-    UnblockTaskNotifier();
+    if (_shards) {
+        for (TaskNotifier *shard in _shards) {
+            [shard unblock];
+        }
+        return;
+    }
+    char dummy = 0;
+    write(_unblockPipeW, &dummy, 1);
+}
+
+- (void)unblockTask:(id<iTermTask>)task {
+    if (_shards) {
+        [[self shardForTask:task] unblock];
+        return;
+    }
+    [self unblock];
 }
 
 void UnblockTaskNotifier(void) {
     // This is called in a signal handler and must only call functions listed
     // as safe in sigaction(2)'s man page.
     char dummy = 0;
-    write(unblockPipeW, &dummy, 1);
+    const int count = sNumberOfUnblockPipes;
+    for (int i = 0; i < count; i++) {
+        write(sUnblockPipeWriteFileDescriptors[i], &dummy, 1);
+    }
 }
 
-- (BOOL)handleReadOnFileDescriptor:(int)fd task:(id<iTermTask>)task fdSet:(fd_set *)fdSet {
-    if (FD_ISSET(fd, fdSet)) {
+- (BOOL)handleReadOnFileDescriptor:(int)fd task:(id<iTermTask>)task {
+    if ([_poller fileDescriptorIsReadable:fd]) {
         PtyTaskDebugLog(@"run/processRead: unlock");
         [tasksLock unlock];
+        os_log_t signpostLog = iTermSignpostLog();
+        const os_signpost_id_t spid = os_signpost_id_generate(signpostLog);
+        os_signpost_interval_begin(signpostLog, spid, "Read", "keystroke=%llu fd=%d", iTermSignpostCurrentKeystroke(), fd);
         [task processRead];
+        os_signpost_interval_end(signpostLog, spid, "Read");
         PtyTaskDebugLog(@"run/processRead: lock");
         [tasksLock lock];
         if (tasksChanged) {
@@ -174,8 +661,8 @@ void UnblockTaskNotifier(void) {
     return NO;
 }
 
-- (BOOL)handleWriteOnFileDescriptor:(int)fd task:(id<iTermTask>)task fdSet:(fd_set *)fdSet {
-    if (FD_ISSET(fd, fdSet)) {
+- (BOOL)handleWriteOnFileDescriptor:(int)fd task:(id<iTermTask>)task {
+    if ([_poller fileDescriptorIsWritable:fd]) {
         PtyTaskDebugLog(@"run/processWrite: unlock");
         [tasksLock unlock];
         [task retain];
@@ -192,8 +679,8 @@ void UnblockTaskNotifier(void) {
     return NO;
 }
 
-- (BOOL)handleErrorOnFileDescriptor:(int)fd task:(id<iTermTask>)task fdSet:(fd_set *)fdSet {
-    if (FD_ISSET(fd, fdSet)) {
+- (BOOL)handleErrorOnFileDescriptor:(int)fd task:(id<iTermTask>)task {
+    if ([_poller fileDescriptorHasError:fd]) {
         PtyTaskDebugLog(@"run/brokenPipe: unlock");
         [tasksLock unlock];
         // brokenPipe will call deregisterTask and add the pid to
@@ -212,9 +699,8 @@ void UnblockTaskNotifier(void) {
 
 - (void)handleReadOnFileDescriptor:(int)fd
                               task:(id<iTermTask>)task
-                     withCoprocess:(Coprocess *)coprocess
-                             fdSet:(fd_set *)fdSet {
-    if (![coprocess eof] && FD_ISSET(fd, fdSet)) {
+                     withCoprocess:(Coprocess *)coprocess {
+    if (![coprocess eof] && [_poller fileDescriptorIsReadable:fd]) {
         PtyTaskDebugLog(@"Reading from coprocess");
         [coprocess read];
         [task writeTask:coprocess.inputBuffer];
@@ -223,18 +709,16 @@ void UnblockTaskNotifier(void) {
 }
 
 - (void)handleErrorOnFileDescriptor:(int)fd
-                      withCoprocess:(Coprocess *)coprocess
-                              fdSet:(fd_set *)fdSet {
-    if (FD_ISSET(fd, fdSet)) {
+                      withCoprocess:(Coprocess *)coprocess {
+    if ([_poller fileDescriptorHasError:fd]) {
         PtyTaskDebugLog(@"EOF on coprocess %@", coprocess);
         coprocess.eof = YES;
     }
 }
 
 - (void)handleWriteOnFileDescriptor:(int)coprocessWriteFd
-                      withCoprocess:(Coprocess *)coprocess
-                              fdSet:(fd_set *)fdSet {
-    if (FD_ISSET(coprocessWriteFd, fdSet)) {
+                      withCoprocess:(Coprocess *)coprocess {
+    if ([_poller fileDescriptorIsWritable:coprocessWriteFd]) {
         if (![coprocess eof]) {
             PtyTaskDebugLog(@"Write to coprocess %@", coprocess);
             [coprocess write];
@@ -243,23 +727,13 @@ void UnblockTaskNotifier(void) {
 }
 
 - (void)run {
-    fd_set rfds;
-    fd_set wfds;
-    fd_set efds;
-    int highfd;
     NSEnumerator *iter;
     NSAutoreleasePool *autoreleasePool = [[NSAutoreleasePool alloc] init];
 
     // FIXME: replace this with something better...
     for(;;) {
-
-        FD_ZERO(&rfds);
-        FD_ZERO(&wfds);
-        FD_ZERO(&efds);
-
-        // Unblock pipe to interrupt select() whenever a PTYTask register/unregisters
-        highfd = unblockPipeR;
-        FD_SET(unblockPipeR, &rfds);
+        // Unblock pipe to interrupt the wait whenever a PTYTask register/unregisters
+        [_poller addFileDescriptor:_unblockPipeR owner:self read:YES write:NO error:NO];
         NSMutableSet *handledFds = [[NSMutableSet alloc] initWithCapacity:256];
 
         // Add all the PTYTask pipes
@@ -303,7 +777,7 @@ void UnblockTaskNotifier(void) {
             deadpool = [newDeadpool retain];
         }
 
-        // Figure out the file descriptors to select on.
+        // Figure out the file descriptors to wait on.
         PtyTaskDebugLog(@"Begin enumeration over %lu tasks\n", (unsigned long)[_tasks count]);
         for (id<iTermTask> task in _tasks) {
             PtyTaskDebugLog(@"Got task %@\n", task);
@@ -311,42 +785,28 @@ void UnblockTaskNotifier(void) {
             if (fd < 0) {
                 PtyTaskDebugLog(@"Task has fd of %d\n", fd);
             } else {
-                // PtyTaskDebugLog(@"Select on fd %d\n", fd);
-                if (fd > highfd) {
-                    highfd = fd;
-                }
-                if ([task wantsRead]) {
-                    FD_SET(fd, &rfds);
-                }
-                if ([task wantsWrite]) {
-                    FD_SET(fd, &wfds);
-                }
-                FD_SET(fd, &efds);
+                [_poller addFileDescriptor:fd
+                                     owner:task
+                                      read:[task wantsRead]
+                                     write:[task wantsWrite]
+                                     error:YES];
             }
 
             @synchronized (task) {
                 Coprocess *coprocess = [task coprocess];
                 if (coprocess) {
-                    if ([coprocess wantToRead] && [task writeBufferHasRoom]) {
-                        int rfd = [coprocess readFileDescriptor];
-                        if (rfd > highfd) {
-                            highfd = rfd;
-                        }
-                        FD_SET(rfd, &rfds);
-                    }
+                    const int rfd = [coprocess readFileDescriptor];
+                    [_poller addFileDescriptor:rfd
+                                         owner:coprocess
+                                          read:[coprocess wantToRead] && [task writeBufferHasRoom]
+                                         write:NO
+                                         error:![coprocess eof]];
                     if ([coprocess wantToWrite]) {
-                        int wfd = [coprocess writeFileDescriptor];
-                        if (wfd > highfd) {
-                            highfd = wfd;
-                        }
-                        FD_SET(wfd, &wfds);
-                    }
-                    if (![coprocess eof]) {
-                        int rfd = [coprocess readFileDescriptor];
-                        if (rfd > highfd) {
-                            highfd = rfd;
-                        }
-                        FD_SET(rfd, &efds);
+                        [_poller addFileDescriptor:[coprocess writeFileDescriptor]
+                                             owner:coprocess
+                                              read:NO
+                                             write:YES
+                                             error:NO];
                     }
                 }
             }
@@ -358,8 +818,11 @@ void UnblockTaskNotifier(void) {
         [autoreleasePool drain];
         autoreleasePool = [[NSAutoreleasePool alloc] init];
 
+        os_log_t signpostLog = iTermSignpostLog();
+        const os_signpost_id_t batchID = os_signpost_id_generate(signpostLog);
+
         // Poll...
-        if (select(highfd+1, &rfds, &wfds, &efds, NULL) <= 0) {
+        if (![_poller wait]) {
             switch(errno) {
                 case EAGAIN:
                 case EINTR:
@@ -370,14 +833,15 @@ void UnblockTaskNotifier(void) {
         }
 
         // Interrupted?
-        if (FD_ISSET(unblockPipeR, &rfds)) {
+        if ([_poller fileDescriptorIsReadable:_unblockPipeR]) {
             char dummy[32];
             do {
-                read(unblockPipeR, dummy, sizeof(dummy));
+                read(_unblockPipeR, dummy, sizeof(dummy));
             } while (errno != EAGAIN);
         }
 
         // Check for read events on PTYTask pipes
+        os_signpost_interval_begin(signpostLog, batchID, "ReadBatch", "keystroke=%llu", iTermSignpostCurrentKeystroke());
         PtyTaskDebugLog(@"run2: lock");
         [tasksLock lock];
         PtyTaskDebugLog(@"Iterating over %lu tasks\n", (unsigned long)_tasks.count);
@@ -402,13 +866,13 @@ void UnblockTaskNotifier(void) {
                 [[task retain] autorelease];
                 [handledFds addObject:@(fd)];
 
-                if ([self handleReadOnFileDescriptor:fd task:task fdSet:&rfds]) {
+                if ([self handleReadOnFileDescriptor:fd task:task]) {
                     iter = [_tasks objectEnumerator];
                 }
-                if ([self handleWriteOnFileDescriptor:fd task:task fdSet:&wfds]) {
+                if ([self handleWriteOnFileDescriptor:fd task:task]) {
                     iter = [_tasks objectEnumerator];
                 }
-                if ([self handleErrorOnFileDescriptor:fd task:task fdSet:&efds]) {
+                if ([self handleErrorOnFileDescriptor:fd task:task]) {
                     iter = [_tasks objectEnumerator];
                 }
                 // Move input around between coprocess and main process.
@@ -423,8 +887,8 @@ void UnblockTaskNotifier(void) {
                             }
                             [handledFds addObject:@(fd)];
 
-                            [self handleReadOnFileDescriptor:fd task:task withCoprocess:coprocess fdSet:&rfds];
-                            [self handleErrorOnFileDescriptor:fd withCoprocess:coprocess fdSet:&efds];
+                            [self handleReadOnFileDescriptor:fd task:task withCoprocess:coprocess];
+                            [self handleErrorOnFileDescriptor:fd withCoprocess:coprocess];
 
                             // Handle writes
                             int coprocessWriteFd = [coprocess writeFileDescriptor];
@@ -433,7 +897,7 @@ void UnblockTaskNotifier(void) {
                                 continue;
                             }
                             [handledFds addObject:@(coprocessWriteFd)];
-                            [self handleWriteOnFileDescriptor:coprocessWriteFd withCoprocess:coprocess fdSet:&wfds];
+                            [self handleWriteOnFileDescriptor:coprocessWriteFd withCoprocess:coprocess];
 
                             if ([coprocess eof]) {
                                 [deadpool addObject:@([coprocess pid])];
@@ -449,6 +913,7 @@ void UnblockTaskNotifier(void) {
 
         PtyTaskDebugLog(@"run3: unlock");
         [tasksLock unlock];
+        os_signpost_interval_end(signpostLog, batchID, "ReadBatch");
         if (notifyOfCoprocessChange) {
             [self performSelectorOnMainThread:@selector(notifyCoprocessChange)
                                    withObject:nil
@@ -470,10 +935,22 @@ void UnblockTaskNotifier(void) {
 }
 
 - (void)lock {
+    if (_shards) {
+        for (TaskNotifier *shard in _shards) {
+            [shard lock];
+        }
+        return;
+    }
     [tasksLock lock];
 }
 
 - (void)unlock {
+    if (_shards) {
+        for (TaskNotifier *shard in [_shards reverseObjectEnumerator]) {
+            [shard unlock];
+        }
+        return;
+    }
     [tasksLock unlock];
 }
 
@@ -11,13 +11,195 @@
 #import "DebugLogging.h"
 #import "FileTransferManager.h"
 #import "FutureMethods.h"
+#import "iTermAdvancedSettingsModel.h"
 #import "NSSavePanel+iTerm.h"
 #import "RegexKitLite.h"
 
 #import <apr-1/apr_base64.h>
+#import <stdatomic.h>
 
 NSString *const kTerminalFileShouldStopNotification = @"kTerminalFileShouldStopNotification";
 
+// Decoded bytes are buffered up to this size before being written.
+static const NSUInteger iTermTerminalFileWriterBufferSize = 1024 * 1024;
+
+// Number of chunks of base64 that may be waiting to be decoded. Past this, appending blocks until the
+// writer catches up, which bounds memory use no matter how fast the data comes in.
+static const long iTermTerminalFileWriterMaxPendingChunks = 256;
+
+// Decodes base64 as it arrives and writes the result to a file on a background queue.
+@interface iTermTerminalFileWriter : NSObject
+// Returns nil if the file can't be created.
+- (instancetype)initWithPath:(NSString *)path NS_DESIGNATED_INITIALIZER;
+- (instancetype)init NS_UNAVAILABLE;
+- (void)appendBase64:(NSString *)string;
+// Calls |completion| on the main queue with nil on success or else a description of the error, in
+// which case the file has been removed.
+- (void)finishWithCompletion:(void (^)(NSString *errorDescription))completion;
+// Stops writing and removes the file.
+- (void)cancel;
+@end
+
+@implementation iTermTerminalFileWriter {
+    NSString *_path;
+    int _fd;
+    dispatch_queue_t _queue;
+    dispatch_semaphore_t _pendingChunks;
+    _Atomic BOOL _cancelled;
+
+    // Only accessed on _queue.
+    NSMutableData *_output;
+    unsigned char _quad[4];
+    int _quadLength;
+    BOOL _sawPadding;
+    NSInteger _bytesWritten;
+    NSString *_errorDescription;
+}
+
+- (instancetype)initWithPath:(NSString *)path {
+    self = [super init];
+    if (self) {
+        _fd = open(path.fileSystemRepresentation, O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+        if (_fd < 0) {
+            DLog(@"Failed to open %@: %s", path, strerror(errno));
+            return nil;
+        }
+        _path = [path copy];
+        _queue = dispatch_queue_create("com.iterm2.terminal-file-writer", DISPATCH_QUEUE_SERIAL);
+        _pendingChunks = dispatch_semaphore_create(iTermTerminalFileWriterMaxPendingChunks);
+        _output = [NSMutableData dataWithCapacity:iTermTerminalFileWriterBufferSize + 3];
+    }
+    return self;
+}
+
+- (void)appendBase64:(NSString *)string {
+    dispatch_semaphore_wait(_pendingChunks, DISPATCH_TIME_FOREVER);
+    dispatch_async(_queue, ^{
+        if (!atomic_load(&self->_cancelled) && !self->_errorDescription) {
+            [self decode:string];
+        }
+        dispatch_semaphore_signal(self->_pendingChunks);
+    });
+}
+
+- (void)finishWithCompletion:(void (^)(NSString *))completion {
+    dispatch_async(_queue, ^{
+        if (!self->_errorDescription) {
+            [self emitQuad];
+            [self flush];
+        }
+        if (!self->_errorDescription && self->_bytesWritten == 0) {
+            self->_errorDescription = @"No data received.";
+        }
+        [self closeRemovingFile:self->_errorDescription != nil];
+        NSString *errorDescription = self->_errorDescription;
+        dispatch_async(dispatch_get_main_queue(), ^{
+            completion(errorDescription);
+        });
+    });
+}
+
+- (void)cancel {
+    atomic_store(&_cancelled, YES);
+    dispatch_async(_queue, ^{
+        [self closeRemovingFile:YES];
+    });
+}
+
+#pragma mark - Private
+
+- (void)closeRemovingFile:(BOOL)remove {
+    if (_fd < 0) {
+        return;
+    }
+    close(_fd);
+    _fd = -1;
+    if (remove) {
+        unlink(_path.fileSystemRepresentation);
+    }
+}
+
+- (void)decode:(NSString *)string {
+    static unsigned char table[256];
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        memset(table, 0xff, sizeof(table));
+        const char *alphabet = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+        for (int i = 0; i < 64; i++) {
+            table[(unsigned char)alphabet[i]] = i;
+        }
+    });
+    if (_sawPadding) {
+        // Like apr_base64_decode, ignore anything after the end.
+        return;
+    }
+    NSData *data = [string dataUsingEncoding:NSASCIIStringEncoding];
+    if (!data) {
+        _errorDescription = @"File corrupted (not valid base64).";
+        return;
+    }
+    const unsigned char *bytes = data.bytes;
+    const NSUInteger length = data.length;
+    for (NSUInteger i = 0; i < length; i++) {
+        const unsigned char c = bytes[i];
+        if (c == '\r' || c == '\n') {
+            continue;
+        }
+        if (c == '=') {
+            _sawPadding = YES;
+            break;
+        }
+        const unsigned char value = table[c];
+        if (value == 0xff) {
+            _errorDescription = @"File corrupted (not valid base64).";
+            return;
+        }
+        _quad[_quadLength++] = value;
+        if (_quadLength == 4) {
+            [self emitQuad];
+        }
+    }
+    if (_output.length >= iTermTerminalFileWriterBufferSize) {
+        [self flush];
+    }
+}
+
+// Decodes however much of a group of four characters has been received.
+- (void)emitQuad {
+    if (_quadLength < 2) {
+        _quadLength = 0;
+        return;
+    }
+    const unsigned char decoded[3] = {
+        (unsigned char)((_quad[0] << 2) | (_quad[1] >> 4)),
+        (unsigned char)((_quad[1] << 4) | (_quad[2] >> 2)),
+        (unsigned char)((_quad[2] << 6) | _quad[3])
+    };
+    [_output appendBytes:decoded length:_quadLength - 1];
+    _quadLength = 0;
+}
+
+- (void)flush {
+    const unsigned char *bytes = _output.bytes;
+    NSUInteger offset = 0;
+    while (offset < _output.length) {
+        const ssize_t n = write(_fd, bytes + offset, _output.length - offset);
+        if (n < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            DLog(@"Write to %@ failed: %s", _path, strerror(errno));
+            _errorDescription = @"Failed to write file to disk.";
+            return;
+        }
+        offset += n;
+    }
+    _bytesWritten += _output.length;
+    _output.length = 0;
+}
+
+@end
+
 @interface TerminalFile ()
 @property(nonatomic, strong) NSMutableString *data;
 @property(nonatomic, copy) NSString *filename;  // No path, just a name.
@@ -36,7 +218,12 @@ NSString *const kTerminalFileShouldStopNotification = @"kTerminalFileShouldStopN
 
 @end
 
-@implementation TerminalFile
+@implementation TerminalFile {
+    // Non-nil while streaming a download to disk. Then |data| is not used.
+    iTermTerminalFileWriter *_writer;
+    // Number of base64 characters received by the writer.
+    NSInteger _base64Length;
+}
 
 - (instancetype)initWithName:(NSString *)name size:(NSInteger)size {
     self = [super init];
@@ -94,6 +281,12 @@ NSString *const kTerminalFileShouldStopNotification = @"kTerminalFileShouldStopN
         [[FileTransferManager sharedInstance] transferrableFile:self
                                  didFinishTransmissionWithError:error];
     }
+    if (self.localPath && [iTermAdvancedSettingsModel streamTerminalFileDownloads]) {
+        _writer = [[iTermTerminalFileWriter alloc] initWithPath:self.localPath];
+        if (_writer) {
+            return;
+        }
+    }
     self.data = [NSMutableString string];
 }
 
@@ -106,6 +299,8 @@ NSString *const kTerminalFileShouldStopNotification = @"kTerminalFileShouldStopN
     self.status = kTransferrableFileStatusCancelling;
     [[FileTransferManager sharedInstance] transferrableFileWillStop:self];
     self.data = nil;
+    [_writer cancel];
+    _writer = nil;
     [[NSNotificationCenter defaultCenter] postNotificationName:kTerminalFileShouldStopNotification
                                                         object:self];
     [TransferrableFile unlockFileName:_localPath];
@@ -122,6 +317,9 @@ NSString *const kTerminalFileShouldStopNotification = @"kTerminalFileShouldStopN
 #pragma mark - APIs
 
 - (BOOL)appendData:(NSString *)data {
+    if (_writer) {
+        return [self appendDataToWriter:data];
+    }
     if (!self.data) {
         return YES;
     }
@@ -131,7 +329,31 @@ NSString *const kTerminalFileShouldStopNotification = @"kTerminalFileShouldStopN
     data = [data stringByReplacingOccurrencesOfRegex:@"[\r\n]" withString:@""];
 
     [self.data appendString:data];
-    double approximateSize = self.data.length;
+    return [self didReceiveBase64OfLength:self.data.length];
+}
+
+- (BOOL)appendDataToWriter:(NSString *)data {
+    self.status = kTransferrableFileStatusTransferring;
+    [_writer appendBase64:data];
+
+    // Newlines don't count toward the size.
+    const CFIndex length = CFStringGetLength((CFStringRef)data);
+    CFStringInlineBuffer inlineBuffer;
+    CFStringInitInlineBuffer((CFStringRef)data, &inlineBuffer, CFRangeMake(0, length));
+    NSInteger count = 0;
+    for (CFIndex i = 0; i < length; i++) {
+        const UniChar c = CFStringGetCharacterFromInlineBuffer(&inlineBuffer, i);
+        if (c != '\r' && c != '\n') {
+            count++;
+        }
+    }
+    _base64Length += count;
+    return [self didReceiveBase64OfLength:_base64Length];
+}
+
+// Updates progress. Returns NO if there's more data than the declared size allows.
+- (BOOL)didReceiveBase64OfLength:(NSInteger)base64Length {
+    double approximateSize = base64Length;
     approximateSize *= 3.0 / 4.0;
     self.bytesTransferred = ceil(approximateSize);
     if (self.fileSize >= 0) {
@@ -140,13 +362,16 @@ NSString *const kTerminalFileShouldStopNotification = @"kTerminalFileShouldStopN
     [[FileTransferManager sharedInstance] transferrableFileProgressDidChange:self];
     if (approximateSize > self.fileSize + 5) {
         DLog(@"Have %@ bytes of base64 which encodes as much as %@ but the file's declared size is %@",
-             @(self.data.length), @(approximateSize + 4), @(self.fileSize));
+             @(base64Length), @(approximateSize + 4), @(self.fileSize));
         return NO;
     }
     return YES;
 }
 
 - (NSInteger)length {
+    if (_writer) {
+        return _base64Length;
+    }
     return self.data.length;
 }
 
@@ -156,6 +381,19 @@ NSString *const kTerminalFileShouldStopNotification = @"kTerminalFileShouldStopN
 }
 
 - (void)handleEndOfData {
+    if (_writer) {
+        iTermTerminalFileWriter *writer = _writer;
+        _writer = nil;
+        [writer finishWithCompletion:^(NSString *errorDescription) {
+            if (errorDescription) {
+                [[FileTransferManager sharedInstance] transferrableFile:self
+                                         didFinishTransmissionWithError:[self errorWithDescription:errorDescription]];
+                return;
+            }
+            [self didWriteFile];
+        }];
+        return;
+    }
     if (!self.data) {
         self.status = kTransferrableFileStatusCancelled;
         [[FileTransferManager sharedInstance] transferrableFileDidStopTransfer:self];
@@ -182,6 +420,10 @@ NSString *const kTerminalFileShouldStopNotification = @"kTerminalFileShouldStopN
                                  didFinishTransmissionWithError:[self errorWithDescription:@"Failed to write file to disk."]];
         return;
     }
+    [self didWriteFile];
+}
+
+- (void)didWriteFile {
     if (![self quarantine:self.localPath sourceURL:nil]) {
         [[FileTransferManager sharedInstance] transferrableFile:self
                                  didFinishTransmissionWithError:[self errorWithDescription:@"Failed to set quarantine."]];
@@ -193,7 +435,6 @@ NSString *const kTerminalFileShouldStopNotification = @"kTerminalFileShouldStopN
         return;
     }
     [[FileTransferManager sharedInstance] transferrableFile:self didFinishTransmissionWithError:nil];
-    return;
 }
 
 #pragma mark - Private
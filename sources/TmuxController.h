@@ -46,6 +46,9 @@ extern NSString *const kTmuxControllerDidChangeHiddenWindows;
 @protocol iTermTmuxControllerSession<NSObject>
 - (void)tmuxControllerSessionSetTTL:(NSTimeInterval)ttl redzone:(BOOL)redzone;
 - (void)revealIfTabSelected;
+// Marks the session unpaused before the controller asks tmux to unpause it along with others.
+// Returns NO if the session is no longer paused.
+- (BOOL)tmuxControllerSessionWillUnpauseAutomatically;
 @end
 
 @interface TmuxController : NSObject
@@ -131,6 +134,11 @@ extern NSString *const kTmuxControllerDidChangeHiddenWindows;
 - (void)pausePanes:(NSArray<NSNumber *> *)wps;
 - (void)didPausePane:(int)wp;
 
+// Unpauses a pane that tmux paused. Visible panes are unpaused after a second. Background panes
+// are unpaused together, after a delay that grows each time one is paused again soon after being
+// unpaused, so they don't compete with the pane the user is looking at.
+- (void)scheduleAutomaticUnpauseOfPane:(int)wp visible:(BOOL)visible;
+
 // Issue tmux commands to infer bounds on the version.
 - (void)guessVersion;
 - (void)loadTitleFormat;
@@ -143,6 +143,14 @@ static NSString *kListWindowsFormat = @"\"#{session_name}\t#{window_id}\t"
     // terminal guid -> [(tmux window id, tab index), ...]
     NSMutableDictionary<NSString *, NSMutableArray<iTermTuple<NSNumber *, NSNumber *> *> *> *_buriedWindows;
     NSString *_lastSaveBuriedIndexesCommand;
+
+    // For scheduleAutomaticUnpauseOfPane:visible:. Background panes waiting to be unpaused, and
+    // for each pane when it was last unpaused automatically and how many times in a row it was
+    // paused again soon after.
+    NSMutableSet<NSNumber *> *_backgroundPanesAwaitingUnpause;
+    BOOL _backgroundUnpauseScheduled;
+    NSMutableDictionary<NSNumber *, NSNumber *> *_lastAutomaticUnpauseTimes;
+    NSMutableDictionary<NSNumber *, NSNumber *> *_repeatedPauseCounts;
 }
 
 @synthesize gateway = gateway_;
@@ -190,10 +198,13 @@ static NSDictionary *iTermTmuxControllerDefaultFontOverridesFromProfile(Profile
         _listWindowsQueue = [[NSMutableArray alloc] init];
         _paneToActivateWhenCreated = -1;
         _buriedWindows = [[NSMutableDictionary alloc] init];
+        _backgroundPanesAwaitingUnpause = [[NSMutableSet alloc] init];
+        _lastAutomaticUnpauseTimes = [[NSMutableDictionary alloc] init];
+        _repeatedPauseCounts = [[NSMutableDictionary alloc] init];
         __weak __typeof(self) weakSelf = self;
         [iTermPreferenceDidChangeNotification subscribe:self
                                                   block:^(iTermPreferenceDidChangeNotification * _Nonnull notification) {
-            if ([notification.key isEqualToString:kPreferenceKeyTmuxPauseModeAgeLimit]) {
+            if ([notification didChangeKey:kPreferenceKeyTmuxPauseModeAgeLimit]) {
                 [weakSelf enablePauseModeIfPossible];
             }
         }];
@@ -233,6 +244,9 @@ static NSDictionary *iTermTmuxControllerDefaultFontOverridesFromProfile(Profile
     [_windowSizes release];
     [_buriedWindows release];
     [_lastSaveBuriedIndexesCommand release];
+    [_backgroundPanesAwaitingUnpause release];
+    [_lastAutomaticUnpauseTimes release];
+    [_repeatedPauseCounts release];
 
     [super dealloc];
 }
@@ -1043,6 +1057,61 @@ static NSDictionary *iTermTmuxControllerDefaultFontOverridesFromProfile(Profile
     [windowOpener unpauseWindowPanes:wps];
 }
 
+- (void)scheduleAutomaticUnpauseOfPane:(int)wp visible:(BOOL)visible {
+    NSNumber *key = @(wp);
+    const NSTimeInterval now = [NSDate timeIntervalSinceReferenceDate];
+    NSNumber *lastUnpause = _lastAutomaticUnpauseTimes[key];
+    NSInteger count = 0;
+    if (lastUnpause && now - lastUnpause.doubleValue < 10) {
+        count = [_repeatedPauseCounts[key] integerValue] + 1;
+    }
+    _repeatedPauseCounts[key] = @(count);
+    DLog(@"Schedule automatic unpause of %%%d visible=%@ repeats=%@", wp, @(visible), @(count));
+
+    __weak __typeof(self) weakSelf = self;
+    if (visible) {
+        dispatch_after(dispatch_time(DISPATCH_TIME_NOW, (int64_t)(1 * NSEC_PER_SEC)), dispatch_get_main_queue(), ^{
+            [weakSelf automaticallyUnpausePanes:@[ key ]];
+        });
+        return;
+    }
+    [_backgroundPanesAwaitingUnpause addObject:key];
+    if (_backgroundUnpauseScheduled) {
+        return;
+    }
+    _backgroundUnpauseScheduled = YES;
+    const NSTimeInterval delay = MIN(16, 2 << MIN(count, 3));
+    dispatch_after(dispatch_time(DISPATCH_TIME_NOW, (int64_t)(delay * NSEC_PER_SEC)), dispatch_get_main_queue(), ^{
+        [weakSelf unpauseBackgroundPanes];
+    });
+}
+
+- (void)unpauseBackgroundPanes {
+    _backgroundUnpauseScheduled = NO;
+    NSArray<NSNumber *> *wps = _backgroundPanesAwaitingUnpause.allObjects;
+    [_backgroundPanesAwaitingUnpause removeAllObjects];
+    [self automaticallyUnpausePanes:wps];
+}
+
+// Unpauses all of |wps| with one list of commands.
+- (void)automaticallyUnpausePanes:(NSArray<NSNumber *> *)wps {
+    const NSTimeInterval now = [NSDate timeIntervalSinceReferenceDate];
+    NSMutableArray<NSNumber *> *unpausing = [NSMutableArray array];
+    for (NSNumber *wp in wps) {
+        PTYSession<iTermTmuxControllerSession> *session = [self sessionForWindowPane:wp.intValue];
+        if (![session tmuxControllerSessionWillUnpauseAutomatically]) {
+            continue;
+        }
+        _lastAutomaticUnpauseTimes[wp] = @(now);
+        [unpausing addObject:wp];
+    }
+    if (unpausing.count == 0) {
+        return;
+    }
+    DLog(@"Automatically unpause %@", unpausing);
+    [self unpausePanes:unpausing];
+}
+
 - (void)panesDidUnpause:(TmuxWindowOpener *)opener {
     for (NSNumber *wp in opener.unpausingWindowPanes) {
         PTYSession<iTermTmuxControllerSession> *session = [self sessionForWindowPane:wp.intValue];
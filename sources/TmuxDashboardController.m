@@ -134,9 +134,10 @@
 }
 
 - (void)preferenceDidChange:(iTermPreferenceDidChangeNotification *)notification {
-    if ([notification.key isEqualToString:kPreferenceKeyTmuxDashboardLimit]) {
-        setting_.integerValue = [notification.value integerValue];
-        stepper_.integerValue = [notification.value integerValue];
+    if ([notification didChangeKey:kPreferenceKeyTmuxDashboardLimit]) {
+        const NSInteger limit = [[notification valueForChangedKey:kPreferenceKeyTmuxDashboardLimit] integerValue];
+        setting_.integerValue = limit;
+        stepper_.integerValue = limit;
     }
 }
 
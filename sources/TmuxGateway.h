@@ -19,7 +19,12 @@ typedef NS_OPTIONS(int, kTmuxGatewayCommandOptions) {
     kTmuxGatewayCommandWantsData = (1 << 1),
 
     // If this exact command was sent and has been pending for a while, offer to detach.
-    kTmuxGatewayCommandOfferToDetachIfLaggyDuplicate = (1 << 2)
+    kTmuxGatewayCommandOfferToDetachIfLaggyDuplicate = (1 << 2),
+
+    // The command has no side effects, so if an identical one that also has this flag is still
+    // waiting for its response, this one isn't sent and its callback gets that response instead.
+    // Only has an effect when the pipelineTmuxCommands advanced setting is on.
+    kTmuxGatewayCommandMayShareResponse = (1 << 3)
 };
 
 @class TmuxController;
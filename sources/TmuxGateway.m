@@ -36,6 +36,9 @@ static NSString *kCommandId = @"id";
 static NSString *kCommandIsInList = @"inList";
 static NSString *kCommandIsLastInList = @"lastInList";
 static NSString *kCommandTimestamp = @"timestamp";
+// Array of dictionaries with kCommandTarget, kCommandSelector, and kCommandObject for callers whose
+// identical command was folded into this one.
+static NSString *kCommandSharers = @"sharers";
 
 @interface iTermTmuxSubscriptionHandle()
 @property (nonatomic, readonly) NSString *identifier;
@@ -100,6 +103,14 @@ static NSString *kCommandTimestamp = @"timestamp";
     // set to NO.
     BOOL _initialized;
     NSMutableDictionary<NSString *, iTermTmuxSubscriptionHandle *> *_subscriptions;
+
+    // When pipelining, commands sent during one pass of the run loop are written together.
+    NSMutableString *_pendingWrite;
+
+    // Window ID -> most recent layout not yet given to the delegate. Windows are applied in the
+    // order their first queued change arrived.
+    NSMutableDictionary<NSNumber *, NSString *> *_pendingLayouts;
+    NSMutableArray<NSNumber *> *_pendingLayoutWindows;
 }
 
 @synthesize delegate = delegate_;
@@ -120,6 +131,9 @@ static NSString *kCommandTimestamp = @"timestamp";
 
 - (void)dealloc {
     [commandQueue_ release];
+    [_pendingWrite release];
+    [_pendingLayouts release];
+    [_pendingLayoutWindows release];
     [currentCommand_ release];
     [currentCommandResponse_ release];
     [currentCommandData_ release];
@@ -315,12 +329,56 @@ error:
     }
     int window = [[components objectAtIndex:1] intValue];
     NSString *layout = [components objectAtIndex:2];
+    if ([iTermAdvancedSettingsModel coalesceTmuxLayoutChanges]) {
+        [self enqueueLayout:layout forWindow:window];
+        return;
+    }
     [delegate_ tmuxUpdateLayoutForWindow:window
                                   layout:layout
                                   zoomed:nil
                                     only:YES];
 }
 
+// Dragging a divider or resizing the client produces a burst of layout changes, and only the
+// last one for each window matters.
+- (void)enqueueLayout:(NSString *)layout forWindow:(int)window {
+    if (!_pendingLayouts) {
+        _pendingLayouts = [[NSMutableDictionary alloc] init];
+        _pendingLayoutWindows = [[NSMutableArray alloc] init];
+    }
+    const BOOL needsFlush = (_pendingLayouts.count == 0);
+    if (!_pendingLayouts[@(window)]) {
+        [_pendingLayoutWindows addObject:@(window)];
+    }
+    _pendingLayouts[@(window)] = layout;
+    if (needsFlush) {
+        dispatch_async(dispatch_get_main_queue(), ^{
+            [self flushPendingLayouts];
+        });
+    }
+}
+
+// Anything else tmux sends (e.g., output redrawn at the new size) may depend on the layout
+// having been applied, so this is also called before handling any other line.
+- (void)flushPendingLayouts {
+    if (_pendingLayouts.count == 0) {
+        return;
+    }
+    NSDictionary<NSNumber *, NSString *> *layouts = [[_pendingLayouts copy] autorelease];
+    NSArray<NSNumber *> *windows = [[_pendingLayoutWindows copy] autorelease];
+    [_pendingLayouts removeAllObjects];
+    [_pendingLayoutWindows removeAllObjects];
+    if (disconnected_) {
+        return;
+    }
+    for (NSNumber *window in windows) {
+        [delegate_ tmuxUpdateLayoutForWindow:window.intValue
+                                      layout:layouts[window]
+                                      zoomed:nil
+                                        only:YES];
+    }
+}
+
 - (void)broadcastWindowChange
 {
     [delegate_ tmuxWindowsDidChange];
@@ -487,12 +545,20 @@ error:
 }
 
 - (void)invokeCurrentCallbackWithError:(BOOL)withError {
-    id target = [self currentCommandTarget];
+    [self invokeCallbackForCommand:currentCommand_ withError:withError];
+    for (NSDictionary *sharer in currentCommand_[kCommandSharers]) {
+        [self invokeCallbackForCommand:sharer withError:withError];
+    }
+}
+
+- (void)invokeCallbackForCommand:(NSDictionary *)command withError:(BOOL)withError {
+    id target = [self objectConvertingNullInDictionary:command forKey:kCommandTarget];
     if (!target) {
         return;
     }
-    SEL selector = [self currentCommandSelector];
-    id obj = [self currentCommandObject];
+    NSString *selectorName = [self objectConvertingNullInDictionary:command forKey:kCommandSelector];
+    SEL selector = selectorName ? NSSelectorFromString(selectorName) : nil;
+    id obj = [self objectConvertingNullInDictionary:command forKey:kCommandObject];
     if (withError) {
         [target performSelector:selector
                      withObject:nil
@@ -648,7 +714,32 @@ error:
     return ([self.minimumServerVersion compare:version] != NSOrderedAscending);
 }
 
+// The parser already found the pane and decoded the payload of this %output.
+- (void)executeOutputToken:(VT100Token *)token {
+    const int windowPane = token.csi->p[0];
+    NSData *decodedData = token.savedData;
+    if (_tmuxLogging) {
+        [delegate_ tmuxPrintLine:[NSString stringWithFormat:@"< %%output %%%d (%@ bytes decoded)",
+                                  windowPane, @(decodedData.length)]];
+    }
+    if (!acceptNotifications_) {
+        TmuxLog(@"  Not accepting notifications");
+        return;
+    }
+    TmuxLog(@"Run tmux command: \"%%output \"%%%d\" %.*s",
+            windowPane, (int)[decodedData length], (const char *)[decodedData bytes]);
+    [delegate_ tmuxReadTask:decodedData windowPane:windowPane latency:nil];
+}
+
 - (void)executeToken:(VT100Token *)token {
+    if (_pendingLayouts.count > 0 &&
+        (token->type == TMUX_OUTPUT || currentCommand_ || ![token.string hasPrefix:@"%layout-change "])) {
+        [self flushPendingLayouts];
+    }
+    if (token->type == TMUX_OUTPUT) {
+        [self executeOutputToken:token];
+        return;
+    }
     NSString *command = token.string;
     NSData *data = token.savedData;
     if (_tmuxLogging) {
@@ -751,6 +842,7 @@ error:
             [delegate_ tmuxPrintLine:command];
         }
         if ([self versionAtLeastDecimalNumberWithString:@"3.2"]) {
+            [self flushPendingWrite];
             [delegate_ tmuxWriteString:NEWLINE];
         }
         [self hostDisconnected];
@@ -918,6 +1010,36 @@ error:
     [commandQueue_ addObject:object];
 }
 
+// Returns YES if |dict| was folded into an identical pending command.
+- (BOOL)shareResponseOfPendingCommandWithCommandDict:(NSDictionary *)dict {
+    if (![iTermAdvancedSettingsModel pipelineTmuxCommands]) {
+        return NO;
+    }
+    const int flags = [dict[kCommandFlags] intValue];
+    if (!(flags & kTmuxGatewayCommandMayShareResponse)) {
+        return NO;
+    }
+    for (NSMutableDictionary *pending in commandQueue_) {
+        // Flags must match since they affect how the response is delivered.
+        if ([pending[kCommandFlags] intValue] != flags ||
+            [pending[kCommandIsInList] boolValue] ||
+            ![pending[kCommandString] isEqualToString:dict[kCommandString]]) {
+            continue;
+        }
+        NSMutableArray *sharers = pending[kCommandSharers];
+        if (!sharers) {
+            sharers = [NSMutableArray array];
+            pending[kCommandSharers] = sharers;
+        }
+        [sharers addObject:@{ kCommandTarget: dict[kCommandTarget],
+                              kCommandSelector: dict[kCommandSelector],
+                              kCommandObject: dict[kCommandObject] }];
+        TmuxLog(@"Share response of pending command: %@", dict[kCommandString]);
+        return YES;
+    }
+    return NO;
+}
+
 - (BOOL)isTmuxUnresponsive {
     const CFTimeInterval now = CACurrentMediaTime();
     for (NSDictionary *dict in commandQueue_) {
@@ -966,12 +1088,15 @@ error:
                                    responseSelector:selector
                                      responseObject:obj
                                               flags:flags];
+    if ([self shareResponseOfPendingCommandWithCommandDict:dict]) {
+        return;
+    }
     [self enqueueCommandDict:dict];
     if (disconnected_) {
         return;
     }
     TmuxLog(@"Send command: %@", commandWithNewline);
-    [delegate_ tmuxWriteString:commandWithNewline];
+    [self writeCommandString:commandWithNewline];
     TmuxLog(@"Send command: %@", [dict objectForKey:kCommandString]);
 }
 
@@ -1009,7 +1134,37 @@ error:
     TmuxLog(@"-- End command list --");
     [cmd appendString:NEWLINE];
     TmuxLog(@"Send command: %@", cmd);
-    [delegate_ tmuxWriteString:cmd];
+    [self writeCommandString:cmd];
+}
+
+// Commands are matched to responses in the order they were enqueued, so the only thing batching
+// changes is how many writes it takes to send them.
+- (void)writeCommandString:(NSString *)string {
+    if (![iTermAdvancedSettingsModel pipelineTmuxCommands]) {
+        [self flushPendingWrite];
+        [delegate_ tmuxWriteString:string];
+        return;
+    }
+    if (_pendingWrite) {
+        [_pendingWrite appendString:string];
+        return;
+    }
+    _pendingWrite = [string mutableCopy];
+    dispatch_async(dispatch_get_main_queue(), ^{
+        [self flushPendingWrite];
+    });
+}
+
+- (void)flushPendingWrite {
+    if (!_pendingWrite) {
+        return;
+    }
+    NSString *string = [_pendingWrite autorelease];
+    _pendingWrite = nil;
+    if (disconnected_) {
+        return;
+    }
+    [delegate_ tmuxWriteString:string];
 }
 
 - (NSWindowController<iTermWindowController> *)window {
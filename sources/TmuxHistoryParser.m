@@ -7,6 +7,7 @@
 
 #import "TmuxHistoryParser.h"
 
+#import "iTermAdvancedSettingsModel.h"
 #import "iTermMalloc.h"
 #import "ScreenChar.h"
 #import "VT100Terminal.h"
@@ -28,11 +29,23 @@
                   withTerminal:(VT100Terminal *)terminal
         ambiguousIsDoubleWidth:(BOOL)ambiguousIsDoubleWidth
                 unicodeVersion:(NSInteger)unicodeVersion {
+    NSData *histData = [hist dataUsingEncoding:NSUTF8StringEncoding];
+    return [self dataForHistoryLineBytes:histData.bytes
+                                  length:histData.length
+                            withTerminal:terminal
+                  ambiguousIsDoubleWidth:ambiguousIsDoubleWidth
+                          unicodeVersion:unicodeVersion];
+}
+
+- (NSData *)dataForHistoryLineBytes:(const char *)bytes
+                             length:(int)length
+                       withTerminal:(VT100Terminal *)terminal
+             ambiguousIsDoubleWidth:(BOOL)ambiguousIsDoubleWidth
+                     unicodeVersion:(NSInteger)unicodeVersion {
     screen_char_t *screenChars;
     NSMutableData *result = [NSMutableData data];
-    NSData *histData = [hist dataUsingEncoding:NSUTF8StringEncoding];
-    [terminal.parser putStreamData:histData.bytes
-                            length:histData.length];
+    [terminal.parser putStreamData:bytes
+                            length:length];
 
     CVector vector;
     CVectorCreate(&vector, 100);
@@ -82,6 +95,11 @@
     if (![response length]) {
         return [NSArray array];
     }
+    if ([iTermAdvancedSettingsModel streamTmuxHistoryParsing]) {
+        return [self streamingParseDumpHistoryResponse:response
+                                ambiguousIsDoubleWidth:ambiguousIsDoubleWidth
+                                        unicodeVersion:unicodeVersion];
+    }
     NSArray *lines = [response componentsSeparatedByString:@"\n"];
     NSMutableArray *screenLines = [NSMutableArray array];
     VT100Terminal *terminal = [[[VT100Terminal alloc] init] autorelease];
@@ -101,4 +119,46 @@
     return screenLines;
 }
 
+// Like parseDumpHistoryResponse:... but converts the response to UTF-8 once and walks it by
+// newline instead of making an array of every line as a string first. Anything autoreleased while
+// parsing a line is freed before the next one, so memory use is close to the size of the result
+// rather than several times it for panes with long histories.
+- (NSArray *)streamingParseDumpHistoryResponse:(NSString *)response
+                        ambiguousIsDoubleWidth:(BOOL)ambiguousIsDoubleWidth
+                                unicodeVersion:(NSInteger)unicodeVersion {
+    NSData *utf8 = [response dataUsingEncoding:NSUTF8StringEncoding];
+    const char *bytes = (const char *)utf8.bytes;
+    const NSUInteger length = utf8.length;
+    NSMutableArray *screenLines = [NSMutableArray array];
+    VT100Terminal *terminal = [[[VT100Terminal alloc] init] autorelease];
+    terminal.tmuxMode = YES;
+    [terminal setEncoding:NSUTF8StringEncoding];
+    NSUInteger start = 0;
+    while (YES) {
+        const char *newline = memchr(bytes + start, '\n', length - start);
+        const NSUInteger end = newline ? (NSUInteger)(newline - bytes) : length;
+        BOOL ok = YES;
+        @autoreleasepool {
+            NSData *data = [self dataForHistoryLineBytes:bytes + start
+                                                  length:(int)(end - start)
+                                            withTerminal:terminal
+                                  ambiguousIsDoubleWidth:ambiguousIsDoubleWidth
+                                          unicodeVersion:unicodeVersion];
+            if (data) {
+                [screenLines addObject:data];
+            } else {
+                ok = NO;
+            }
+        }
+        if (!ok) {
+            return nil;
+        }
+        if (!newline) {
+            break;
+        }
+        start = end + 1;
+    }
+    return screenLines;
+}
+
 @end
@@ -10,9 +10,11 @@
 #import "iTermAdvancedSettingsModel.h"
 #import "iTermController.h"
 #import "iTermPreferences.h"
+#import "iTermTmuxHistoryCache.h"
 #import "PseudoTerminal.h"
 #import "PTYTab.h"
 #import "ScreenChar.h"
+#import "TmuxController.h"
 #import "TmuxHistoryParser.h"
 #import "TmuxLayoutParser.h"
 #import "TmuxStateParser.h"
@@ -260,6 +262,24 @@ NSString *const kTmuxWindowOpenerWindowOptionStyleValueFullScreen = @"FullScreen
 
 - (NSDictionary *)dictForRequestHistoryForWindowPane:(NSNumber *)wp
                                                  alt:(BOOL)alternate {
+    // When the main screen's history was saved at the last attach, only fetch enough lines to
+    // line up with the end of it.
+    NSString *guid = self.controller.sessionGuid;
+    const BOOL useCache = (!alternate &&
+                           guid != nil &&
+                           [iTermAdvancedSettingsModel cacheTmuxHistory] &&
+                           [[iTermTmuxHistoryCache sharedInstance] hasHistoryForSessionGUID:guid pane:wp.intValue]);
+    const int recentLines = [[iTermTmuxHistoryCache sharedInstance] numberOfRecentLinesToFetch];
+    if (useCache && recentLines < self.maxHistory) {
+        return [self dictForRequestHistoryForWindowPane:wp alt:alternate lines:recentLines incremental:YES];
+    }
+    return [self dictForRequestHistoryForWindowPane:wp alt:alternate lines:self.maxHistory incremental:NO];
+}
+
+- (NSDictionary *)dictForRequestHistoryForWindowPane:(NSNumber *)wp
+                                                 alt:(BOOL)alternate
+                                               lines:(int)lines
+                                         incremental:(BOOL)incremental {
     ++pendingRequests_;
     DLog(@"Increment pending requests to %d", pendingRequests_);
     NSString *maybeN = @"";
@@ -268,13 +288,14 @@ NSString *const kTmuxWindowOpenerWindowOptionStyleValueFullScreen = @"FullScreen
     }
     NSString *command = [NSString stringWithFormat:@"capture-pane -peqJ%@ %@-t \"%%%d\" -S -%d",
                          maybeN,
-                         (alternate ? @"-a " : @""), [wp intValue], self.maxHistory];
+                         (alternate ? @"-a " : @""), [wp intValue], lines];
     return [gateway_ dictionaryForCommand:command
                            responseTarget:self
                          responseSelector:@selector(dumpHistoryResponse:paneAndAlternate:)
                            responseObject:[NSArray arrayWithObjects:
                                            wp,
                                            [NSNumber numberWithBool:alternate],
+                                           [NSNumber numberWithBool:incremental],
                                            nil]
                                     flags:kTmuxGatewayCommandShouldTolerateErrors];
 }
@@ -307,6 +328,18 @@ NSString *const kTmuxWindowOpenerWindowOptionStyleValueFullScreen = @"FullScreen
 
     NSNumber *wp = [info objectAtIndex:0];
     NSNumber *alt = [info objectAtIndex:1];
+    if (![alt boolValue]) {
+        response = [self historyByMergingCacheWithResponse:response info:info];
+        if (!response) {
+            // Fetch everything instead. Sending it first keeps this opener from finishing early.
+            [gateway_ sendCommandList:@[ [self dictForRequestHistoryForWindowPane:wp
+                                                                              alt:NO
+                                                                            lines:self.maxHistory
+                                                                      incremental:NO] ]];
+            [self requestDidComplete];
+            return;
+        }
+    }
     NSArray *history = [[TmuxHistoryParser sharedInstance] parseDumpHistoryResponse:response
                                                              ambiguousIsDoubleWidth:ambiguousIsDoubleWidth_
                                                                      unicodeVersion:self.unicodeVersion];
@@ -325,6 +358,42 @@ NSString *const kTmuxWindowOpenerWindowOptionStyleValueFullScreen = @"FullScreen
     [self requestDidComplete];
 }
 
+// Returns the full history for a response to a history request, saving it for next time if
+// caching is on. Returns nil if the response was to an incremental request that couldn't be merged
+// with the cache.
+- (NSString *)historyByMergingCacheWithResponse:(NSString *)response info:(NSArray *)info {
+    NSString *guid = self.controller.sessionGuid;
+    if (!guid || ![iTermAdvancedSettingsModel cacheTmuxHistory]) {
+        return response;
+    }
+    const int wp = [info[0] intValue];
+    iTermTmuxHistoryCache *cache = [iTermTmuxHistoryCache sharedInstance];
+    NSString *history = response;
+    const BOOL incremental = info.count > 2 && [info[2] boolValue];
+    if (incremental) {
+        // Even a response with fewer lines than requested can't be assumed to be complete since
+        // -J joins wrapped lines.
+        NSString *cached = [cache historyForSessionGUID:guid pane:wp];
+        const int height = [[gateway_ delegate] tmuxClientSize].height;
+        history = cached ? [iTermTmuxHistoryCache historyByMergingCachedHistory:cached
+                                                                  recentHistory:response
+                                                                   mutableLines:MAX(100, height * 2)] : nil;
+        if (!history) {
+            DLog(@"Could not merge incremental history for %%%d with the cache", wp);
+            return nil;
+        }
+        // Lines tmux has since dropped off the top of its history are still in the cache. Keep
+        // about as many as a full fetch would have.
+        NSArray<NSString *> *lines = [history componentsSeparatedByString:@"\n"];
+        const NSUInteger limit = (NSUInteger)self.maxHistory + MAX(0, height);
+        if (lines.count > limit) {
+            history = [[lines subarrayWithRange:NSMakeRange(lines.count - limit, limit)] componentsJoinedByString:@"\n"];
+        }
+    }
+    [cache saveHistory:history sessionGUID:guid pane:wp];
+    return history;
+}
+
 - (NSArray<NSData *> *)historyLinesForWindowPane:(int)wp alternateScreen:(BOOL)altScreen {
     NSDictionary *dict = altScreen ? altHistories_ : histories_;
     return dict[@(wp)];
@@ -223,7 +223,7 @@ static const CGFloat kMargin = 4;
         return [NSDateFormatter compactDateDifferenceStringFromDate:entry.timestamp];
     } else {
         // Contents
-        NSString* value = [[entry mainValue] stringByReplacingOccurrencesOfString:@"\n"
+        NSString* value = [[entry preview] stringByReplacingOccurrencesOfString:@"\n"
                                                                        withString:@" "];
         // Don't return an insanely long value to avoid performance issues.
         const NSUInteger kMaxLength = 256;
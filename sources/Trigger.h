@@ -21,6 +21,17 @@ extern NSString * const kTriggerParameterKey;
 extern NSString * const kTriggerPartialLineKey;
 extern NSString * const kTriggerDisabledKey;
 
+// One match of a trigger's regex, found by -[Trigger matchesInStringLine:]. Immutable.
+@interface iTermTriggerMatch : NSObject
+@property (nonatomic, readonly) NSArray<NSString *> *capturedStrings;
+@property (nonatomic, readonly) const NSRange *capturedRanges;
+
+- (instancetype)initWithCapturedStrings:(NSString * _Nonnull const * _Nonnull)capturedStrings
+                         capturedRanges:(const NSRange *)capturedRanges
+                           captureCount:(NSInteger)captureCount NS_DESIGNATED_INITIALIZER;
+- (instancetype)init NS_UNAVAILABLE;
+@end
+
 @interface Trigger : NSObject
 
 @property (nonatomic, copy) NSString *regex;
@@ -35,6 +46,9 @@ extern NSString * const kTriggerDisabledKey;
 @property (nullable, nonatomic, retain) NSColor *backgroundColor;
 @property (nonatomic, readonly) BOOL instantTriggerCanFireMultipleTimesPerLine;
 @property (nonatomic, readonly) BOOL isIdempotent;
+// If YES the action depends on the state of the session at the moment the line is finished (such
+// as the cursor position), so the trigger can't be matched on a background queue.
+@property (nonatomic, readonly) BOOL needsSynchronousEvaluation;
 @property (class, nonatomic, readonly) NSString *title;
 
 + (nullable NSSet<NSString *> *)synonyms;
@@ -85,6 +99,21 @@ extern NSString * const kTriggerDisabledKey;
        lineNumber:(long long)lineNumber
  useInterpolation:(BOOL)useInterpolation;
 
+// Finds every match of the regex in a complete line. Safe to call on any thread.
+- (NSArray<iTermTriggerMatch *> *)matchesInStringLine:(iTermStringLine *)stringLine;
+
+// Performs the action for matches previously found by matchesInStringLine: on a complete line.
+// Must be called on the main thread. Returns YES if no more triggers should be processed.
+- (BOOL)performActionsForMatches:(NSArray<iTermTriggerMatch *> *)matches
+                        onString:(iTermStringLine *)stringLine
+                       inSession:(PTYSession *)aSession
+                      lineNumber:(long long)lineNumber
+                useInterpolation:(BOOL)useInterpolation;
+
+// Called instead of tryString:... when the line is known not to match the regex, so state that
+// would have been updated by an unsuccessful attempt stays consistent.
+- (void)didNotMatchPartialLine:(BOOL)partialLine;
+
 // Subclasses must override this. Return YES if it can fire again on this line.
 - (BOOL)performActionWithCapturedStrings:(NSString * _Nonnull const * _Nonnull)capturedStrings
                           capturedRanges:(const NSRange *)capturedRanges
@@ -7,6 +7,7 @@
 
 #import "Trigger.h"
 #import "DebugLogging.h"
+#import "iTermMalloc.h"
 #import "iTermObject.h"
 #import "iTermSwiftyString.h"
 #import "iTermVariableScope.h"
@@ -22,6 +23,27 @@ NSString * const kTriggerParameterKey = @"parameter";
 NSString * const kTriggerPartialLineKey = @"partial";
 NSString * const kTriggerDisabledKey = @"disabled";
 
+@implementation iTermTriggerMatch {
+    NSData *_capturedRangesData;
+}
+
+- (instancetype)initWithCapturedStrings:(NSString *const *)capturedStrings
+                         capturedRanges:(const NSRange *)capturedRanges
+                           captureCount:(NSInteger)captureCount {
+    self = [super init];
+    if (self) {
+        _capturedStrings = [[NSArray alloc] initWithObjects:capturedStrings count:captureCount];
+        _capturedRangesData = [NSData dataWithBytes:capturedRanges length:sizeof(NSRange) * captureCount];
+    }
+    return self;
+}
+
+- (const NSRange *)capturedRanges {
+    return (const NSRange *)_capturedRangesData.bytes;
+}
+
+@end
+
 @interface Trigger()<iTermObject>
 @end
 
@@ -118,6 +140,10 @@ NSString * const kTriggerDisabledKey = @"disabled";
     return NO;
 }
 
+- (BOOL)needsSynchronousEvaluation {
+    return NO;
+}
+
 - (NSArray *)groupedMenuItemsForPopupButton
 {
   NSDictionary *menuItems = [self menuItemsForPoupupButton];
@@ -197,6 +223,63 @@ NSString * const kTriggerDisabledKey = @"disabled";
     return stopFutureTriggersFromRunningOnThisLine;
 }
 
+- (NSArray<iTermTriggerMatch *> *)matchesInStringLine:(iTermStringLine *)stringLine {
+    NSMutableArray<iTermTriggerMatch *> *matches = [NSMutableArray array];
+    NSString *s = stringLine.stringValue;
+    [s enumerateStringsMatchedByRegex:regex_
+                           usingBlock:^(NSInteger captureCount,
+                                        NSString *const __unsafe_unretained *capturedStrings,
+                                        const NSRange *capturedRanges,
+                                        volatile BOOL *const stopEnumerating) {
+                               [matches addObject:[[iTermTriggerMatch alloc] initWithCapturedStrings:capturedStrings
+                                                                                      capturedRanges:capturedRanges
+                                                                                        captureCount:captureCount]];
+                           }];
+    return matches;
+}
+
+- (BOOL)performActionsForMatches:(NSArray<iTermTriggerMatch *> *)matches
+                        onString:(iTermStringLine *)stringLine
+                       inSession:(PTYSession *)aSession
+                      lineNumber:(long long)lineNumber
+                useInterpolation:(BOOL)useInterpolation {
+    if (self.disabled) {
+        return NO;
+    }
+    BOOL stopFutureTriggersFromRunningOnThisLine = NO;
+    for (iTermTriggerMatch *match in matches) {
+        _lastLineNumber = lineNumber;
+        DLog(@"Trigger %@ matched string %@", self, stringLine.stringValue);
+        NSArray<NSString *> *captures = match.capturedStrings;
+        const NSInteger count = captures.count;
+        __unsafe_unretained NSString **capturedStrings = (__unsafe_unretained NSString **)iTermMalloc(sizeof(NSString *) * MAX(1, count));
+        [captures getObjects:capturedStrings range:NSMakeRange(0, count)];
+        const BOOL canFireAgain = [self performActionWithCapturedStrings:capturedStrings
+                                                          capturedRanges:match.capturedRanges
+                                                            captureCount:count
+                                                               inSession:aSession
+                                                                onString:stringLine
+                                                    atAbsoluteLineNumber:lineNumber
+                                                        useInterpolation:useInterpolation
+                                                                    stop:&stopFutureTriggersFromRunningOnThisLine];
+        free(capturedStrings);
+        if (!canFireAgain) {
+            break;
+        }
+    }
+    _lastLineNumber = -1;
+    return stopFutureTriggersFromRunningOnThisLine;
+}
+
+- (void)didNotMatchPartialLine:(BOOL)partialLine {
+    if (self.disabled) {
+        return;
+    }
+    if (!partialLine) {
+        _lastLineNumber = -1;
+    }
+}
+
 - (void)paramWithBackreferencesReplacedWithValues:(NSArray *)strings
                                             scope:(iTermVariableScope *)scope
                                  useInterpolation:(BOOL)useInterpolation
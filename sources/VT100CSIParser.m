@@ -712,11 +712,81 @@ static void SetCSITypeAndDefaultParameters(CSIParam *param, VT100Token *result)
     }
 }
 
+// The codes TUIs send most (SGR and cursor positioning, mostly) are nothing but digits and
+// semicolons followed by a final byte. When one of them is entirely in the buffer it can be
+// decoded in a single pass, without the per-byte scan for embedded control characters, prefixes,
+// sub-parameters, and intermediates. Returns NO without consuming anything if the sequence is not
+// that simple, in which case the general parser must be used.
+static BOOL ParseSimpleCSISequence(iTermParserContext *context, CSIParam *param) {
+    const unsigned char *bytes = context->datap;
+    const int length = iTermParserLength(context);
+    int i = (bytes[0] == VT100CC_ESC) ? 2 : 1;
+
+    CSIParamInitialize(param);
+    BOOL readNumericParameter = NO;
+    int digits = 0;
+    int n = 0;
+    while (i < length) {
+        const unsigned char c = bytes[i];
+        if (c >= '0' && c <= '9') {
+            if (++digits > 9) {
+                // Let the general parser deal with overflow.
+                return NO;
+            }
+            n = n * 10 + (c - '0');
+            i++;
+            continue;
+        }
+        if (digits > 0) {
+            if (param->count == VT100CSIPARAM_MAX) {
+                return NO;
+            }
+            param->p[param->count++] = n;
+            readNumericParameter = YES;
+            digits = 0;
+            n = 0;
+        }
+        if (c == ';') {
+            if (!readNumericParameter) {
+                if (param->count == VT100CSIPARAM_MAX) {
+                    return NO;
+                }
+                param->count++;
+            }
+            readNumericParameter = NO;
+            i++;
+            continue;
+        }
+        switch (c) {
+            case 'm':
+            case 'H':
+            case 'f':
+            case 'K':
+            case 'J':
+            case 'r':
+            case 'A':
+            case 'B':
+            case 'C':
+            case 'D':
+                param->cmd = SetFinalByteInPackedCommand(param->cmd, c);
+                iTermParserAdvanceMultiple(context, i + 1);
+                return YES;
+            default:
+                return NO;
+        }
+    }
+    return NO;
+}
+
 + (void)decodeFromContext:(iTermParserContext *)context
 support8BitControlCharacters:(BOOL)support8BitControlCharacters
               incidentals:(CVector *)incidentals
                     token:(VT100Token *)result {
     CSIParam *param = result.csi;
+    if (ParseSimpleCSISequence(context, param)) {
+        SetCSITypeAndDefaultParameters(param, result);
+        return;
+    }
     iTermParserContext savedContext = *context;
 
     ParseCSISequence(context, support8BitControlCharacters, param, incidentals);
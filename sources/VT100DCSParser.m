@@ -24,6 +24,12 @@
 #import "VT100StateMachine.h"
 #import "VT100TmuxParser.h"
 
+#if defined(__ARM_NEON)
+#include <arm_neon.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
 // Caps the amount of data to accumulate in _data before returning to the ground state. Prevents
 // a random ESC P from eating output forever by leaving us in the passthrough state until we get
 // an ST. Note that there's an exception for file downloads wrapped in DCS tmux; … ST
@@ -42,6 +48,47 @@ static NSRange MakeCharacterRange(unsigned char first, unsigned char lastInclusi
     return NSMakeRange(first, lastInclusive - first + 1);
 }
 
+// Returns the number of leading bytes in [p, p+len) that are between SP and ~ inclusive. In the
+// passthrough state these just get appended to _data and can't be binary garbage, so a run of them
+// can be consumed at once instead of going through the state machine byte by byte. This examines
+// 16 bytes at a time.
+static inline int iTermDCSPassthroughPrefixLength(const unsigned char *p, int len) {
+    int i = 0;
+#if defined(__ARM_NEON)
+    // As signed bytes, 0x80...0xff are negative, so SP...DEL is exactly "greater than 0x1f".
+    const int8x16_t threshold = vdupq_n_s8(0x1f);
+    const uint8x16_t del = vdupq_n_u8(VT100CC_DEL);
+    while (i + 16 <= len) {
+        const uint8x16_t bytes = vld1q_u8(p + i);
+        const uint8x16_t ok = vbicq_u8(vcgtq_s8(vreinterpretq_s8_u8(bytes), threshold),
+                                       vceqq_u8(bytes, del));
+        if (vminvq_u8(ok) != 0xff) {
+            // Narrow to four bits per byte and find the first byte that isn't passthrough.
+            const uint64_t nibbles = vget_lane_u64(vreinterpret_u64_u8(vshrn_n_u16(vreinterpretq_u16_u8(ok), 4)), 0);
+            return i + (__builtin_ctzll(~nibbles) >> 2);
+        }
+        i += 16;
+    }
+#elif defined(__SSE2__)
+    const __m128i threshold = _mm_set1_epi8(0x1f);
+    const __m128i del = _mm_set1_epi8(VT100CC_DEL);
+    while (i + 16 <= len) {
+        const __m128i bytes = _mm_loadu_si128((const __m128i *)(p + i));
+        const __m128i ok = _mm_andnot_si128(_mm_cmpeq_epi8(bytes, del),
+                                            _mm_cmpgt_epi8(bytes, threshold));
+        const int mask = _mm_movemask_epi8(ok);
+        if (mask != 0xffff) {
+            return i + __builtin_ctz(~mask);
+        }
+        i += 16;
+    }
+#endif
+    while (i < len && p[i] >= ' ' && p[i] <= '~') {
+        i++;
+    }
+    return i;
+}
+
 @implementation VT100DCSParser {
     BOOL _malformed;  // The current parse has failed but we're waiting for a terminator.
 
@@ -452,17 +499,42 @@ static NSRange MakeCharacterRange(unsigned char first, unsigned char lastInclusi
         offset = MAX(0, limit);
     }
     _checkedCount = limit;
-    NSInteger maxLength = kMaxDataLength;
-    if ([_data hasPrefix:@"tmux;\e]1337;File="]) {
-        // Allow file downloads to get really big.
-        maxLength = NSIntegerMax;
-    }
+    const NSInteger maxLength = [self maximumDataLength];
     return (_data.length > maxLength ||
             [_data rangeOfCharacterFromSet:garbageCharacterSet
                                    options:0
                                      range:NSMakeRange(offset, limit - offset)].location != NSNotFound);
 }
 
+- (NSInteger)maximumDataLength {
+    if ([_data hasPrefix:@"tmux;\e]1337;File="]) {
+        // Allow file downloads to get really big.
+        return NSIntegerMax;
+    }
+    return kMaxDataLength;
+}
+
+// Appends a run of plain passthrough characters to _data in one go. Returns the number of bytes
+// consumed, which may be 0. It stops one byte past the length limit so
+// -dataLooksLikeBinaryGarbage notices at the same point it would have byte by byte.
+- (int)consumePassthroughRunFromContext:(iTermParserContext *)context {
+    const int length = iTermParserLength(context);
+    int n = iTermDCSPassthroughPrefixLength(context->datap, length);
+    const NSInteger maxLength = [self maximumDataLength];
+    if (maxLength != NSIntegerMax) {
+        n = (int)MIN(n, MAX(0, maxLength + 1 - (NSInteger)_data.length));
+    }
+    if (n == 0) {
+        return 0;
+    }
+    NSString *run = [[NSString alloc] initWithBytes:context->datap
+                                             length:n
+                                           encoding:NSASCIIStringEncoding];
+    [_data appendString:run];
+    iTermParserAdvanceMultiple(context, n);
+    return n;
+}
+
 - (void)decodeFromContext:(iTermParserContext *)context
                     token:(VT100Token *)result
                  encoding:(NSStringEncoding)encoding
@@ -474,6 +546,7 @@ static NSRange MakeCharacterRange(unsigned char first, unsigned char lastInclusi
         iTermParserAdvanceMultiple(context, [savedState[kOffset] intValue]);
     }
     self.stateMachine.userInfo = @{ kVT100DCSUserInfoToken: result };
+    VT100State *passthroughState = [self.stateMachine stateWithIdentifier:@(kVT100DCSStatePassthrough)];
     result->type = VT100_WAIT;
     while (result->type == VT100_WAIT && iTermParserCanAdvance(context)) {
         if (_hook && !_hookFinished) {
@@ -484,9 +557,14 @@ static NSRange MakeCharacterRange(unsigned char first, unsigned char lastInclusi
             if (_hookFinished) {
                 [self unhook];
             }
+        } else if (self.stateMachine.currentState == passthroughState &&
+                   [self consumePassthroughRunFromContext:context] > 0) {
+            if ([self dataLooksLikeBinaryGarbage]) {
+                result->type = VT100_BINARY_GARBAGE;
+            }
         } else {
             [self.stateMachine handleCharacter:iTermParserConsume(context)];
-            if ([self.stateMachine.currentState.identifier isEqual:@(kVT100DCSStatePassthrough)] &&
+            if (self.stateMachine.currentState == passthroughState &&
                 [self dataLooksLikeBinaryGarbage]) {
                 result->type = VT100_BINARY_GARBAGE;
             }
@@ -10,9 +10,9 @@
 #import "DVRIndexEntry.h"
 #import "ScreenChar.h"
 #import "VT100GridTypes.h"
+#import "VT100LineInfo.h"
 
 @class LineBuffer;
-@class VT100LineInfo;
 @class VT100Terminal;
 @protocol iTermEncoderAdapter;
 
@@ -54,6 +54,9 @@
 // DEPRECATED - use encode: instead.
 @property(nonatomic, readonly) NSDictionary *dictionaryValue;
 
+// Approximate bytes used by lines and their metadata.
+@property(nonatomic, readonly) NSInteger memoryUsage;
+
 + (VT100GridSize)sizeInStateDictionary:(NSDictionary *)dict;
 
 - (instancetype)initWithSize:(VT100GridSize)size delegate:(id<VT100GridDelegate>)delegate;
@@ -213,6 +216,17 @@
                     withDefaultChar:(screen_char_t)defaultChar
                   maxLinesToRestore:(int)maxLines;
 
+// Like restoreScreenFromLineBuffer:withDefaultChar:maxLinesToRestore: but the cursor is only moved
+// if restoreCursor is set.
+- (BOOL)restoreScreenFromLineBuffer:(LineBuffer *)lineBuffer
+                    withDefaultChar:(screen_char_t)defaultChar
+                  maxLinesToRestore:(int)maxLines
+                      restoreCursor:(BOOL)restoreCursor;
+
+// Appends the lines above the cursor to the line buffer as scrolling them off the top would, but
+// leaves the screen alone and doesn't drop excess lines.
+- (void)appendLinesAboveCursorToLineBuffer:(LineBuffer *)lineBuffer;
+
 // Ensure the cursor and savedCursor positions are valid.
 - (void)clampCursorPositionToValid;
 
@@ -266,7 +280,8 @@
 // TODO: write a test for this
 - (void)insertChar:(screen_char_t)c at:(VT100GridCoord)pos times:(int)num;
 
-// Returns an array of NSData for lines in order (corresponding with lines on screen).
+// Returns an array of NSData for lines in order (corresponding with lines on screen). The data
+// point into the grid without copying, so they're only valid until it next changes.
 - (NSArray *)orderedLines;
 
 // Restore saved state excluding screen contents.
@@ -284,6 +299,7 @@
 
 #pragma mark - Testing use only
 
+// Returns NULL if lineNumber is out of range.
 - (VT100LineInfo *)lineInfoAtLineNumber:(int)lineNumber;
 
 @end
@@ -9,7 +9,9 @@
 #import "VT100Grid.h"
 
 #import "DebugLogging.h"
+#import "iTermAdvancedSettingsModel.h"
 #import "iTermEncoderAdapter.h"
+#import "iTermMalloc.h"
 #import "LineBuffer.h"
 #import "NSArray+iTerm.h"
 #import "NSDictionary+iTerm.h"
@@ -18,21 +20,27 @@
 #import "VT100LineInfo.h"
 #import "VT100Terminal.h"
 
+#import <mach/mach.h>
+
 static NSString *const kGridCursorKey = @"Cursor";
 static NSString *const kGridScrollRegionRowsKey = @"Scroll Region Rows";
 static NSString *const kGridScrollRegionColumnsKey = @"Scroll Region Columns";
 static NSString *const kGridUseScrollRegionColumnsKey = @"Use Scroll Region Columns";
 static NSString *const kGridSizeKey = @"Size";
 
-@interface VT100Grid ()
-@property(nonatomic, readonly) NSArray *lines;  // Warning: not in order found on screen!
-@end
+// Cells at least this large are allocated from the VM system so copies of them can be made with
+// vm_copy, which shares pages until one side writes to them. Smaller grids are faster to memcpy.
+static const size_t VT100GridMinimumVMCopySize = 64 * 1024;
 
 @implementation VT100Grid {
     VT100GridSize size_;
-    int screenTop_;  // Index into lines_ and dirty_ of first line visible in the grid.
-    NSMutableArray<NSMutableData *> *lines_;  // Array of NSMutableData. Each data has size_.width+1 screen_char_t's.
-    NSMutableArray<VT100LineInfo *> *lineInfos_;  // Array of VT100LineInfo.
+    int screenTop_;  // Index into _cells and _lineInfos of first line visible in the grid.
+    // size_.height lines of size_.width+1 screen_char_t's each in one allocation. The last
+    // screen_char_t of a line holds its continuation mark.
+    screen_char_t *_cells;
+    // Size of the VM allocation holding _cells, or 0 if it came from malloc.
+    vm_size_t _cellsVMSize;
+    VT100LineInfo *_lineInfos;  // One per line in _cells.
     id<VT100GridDelegate> delegate_;
     VT100GridCoord cursor_;
     VT100GridRange scrollRegionRows_;
@@ -49,7 +57,6 @@ static NSString *const kGridSizeKey = @"Size";
 @synthesize scrollRegionCols = scrollRegionCols_;
 @synthesize useScrollRegionCols = useScrollRegionCols_;
 @synthesize allDirty = allDirty_;
-@synthesize lines = lines_;
 @synthesize savedDefaultChar = savedDefaultChar_;
 @synthesize cursor = cursor_;
 @synthesize delegate = delegate_;
@@ -80,16 +87,30 @@ static NSString *const kGridSizeKey = @"Size";
         }
         [self setSize:[NSDictionary castFrom:dictionary[@"size"]].gridSize];
         assert(size_.width > 0 && size_.height > 0);
-        lines_ = [[NSArray castFrom:dictionary[@"lines"]] mutableCopy];
+        [[NSArray castFrom:dictionary[@"lines"]] enumerateObjectsUsingBlock:^(NSData *data,
+                                                                              NSUInteger idx,
+                                                                              BOOL * _Nonnull stop) {
+            if (idx >= size_.height) {
+                DLog(@"Too many lines");
+                *stop = YES;
+                return;
+            }
+            if (![data isKindOfClass:[NSData class]]) {
+                return;
+            }
+            memmove([self screenCharsAtLineNumber:idx],
+                    data.bytes,
+                    MIN(data.length, sizeof(screen_char_t) * (size_.width + 1)));
+        }];
         [[NSArray castFrom:dictionary[@"timestamps"]] enumerateObjectsUsingBlock:^(NSNumber *timestamp,
                                                                                    NSUInteger idx,
                                                                                    BOOL * _Nonnull stop) {
-            if (idx >= lineInfos_.count) {
+            if (idx >= size_.height) {
                 DLog(@"Too many lineInfos");
                 *stop = YES;
                 return;
             }
-            lineInfos_[idx].timestamp = timestamp.doubleValue;
+            _lineInfos[idx].timestamp = timestamp.doubleValue;
         }];
         cursor_ = [NSDictionary castFrom:dictionary[@"cursor"]].gridCoord;
         scrollRegionRows_ = [NSDictionary castFrom:dictionary[@"scrollRegionRows"]].gridRange;
@@ -105,31 +126,23 @@ static NSString *const kGridSizeKey = @"Size";
 }
 
 - (void)dealloc {
-    [lines_ release];
-    [lineInfos_ release];
+    [self freeCells];
+    free(_lineInfos);
     [cachedDefaultLine_ release];
     [resultLine_ release];
     [super dealloc];
 }
 
-- (NSMutableData *)lineDataAtLineNumber:(int)lineNumber {
-    if (lineNumber >= 0 && lineNumber < size_.height) {
-        return [lines_ objectAtIndex:(screenTop_ + lineNumber) % size_.height];
-    } else {
-        return nil;
-    }
-}
-
 - (screen_char_t *)screenCharsAtLineNumber:(int)lineNumber {
     assert(lineNumber >= 0);
-    return [[lines_ objectAtIndex:(screenTop_ + lineNumber) % size_.height] mutableBytes];
+    return _cells + ((screenTop_ + lineNumber) % size_.height) * (size_.width + 1);
 }
 
 - (VT100LineInfo *)lineInfoAtLineNumber:(int)lineNumber {
     if (lineNumber >= 0 && lineNumber < size_.height) {
-        return [lineInfos_ objectAtIndex:(screenTop_ + lineNumber) % size_.height];
+        return &_lineInfos[(screenTop_ + lineNumber) % size_.height];
     } else {
-        return nil;
+        return NULL;
     }
 }
 
@@ -140,9 +153,9 @@ static NSString *const kGridSizeKey = @"Size";
         allDirty_ = NO;
     }
     VT100LineInfo *lineInfo = [self lineInfoAtLineNumber:coord.y];
-    [lineInfo setDirty:dirty
-               inRange:VT100GridRangeMake(coord.x, 1)
-       updateTimestamp:updateTimestamp];
+    if (lineInfo) {
+        VT100LineInfoSetDirty(lineInfo, dirty, VT100GridRangeMake(coord.x, 1), updateTimestamp);
+    }
 }
 
 - (void)markCharsDirty:(BOOL)dirty inRectFrom:(VT100GridCoord)from to:(VT100GridCoord)to {
@@ -153,9 +166,9 @@ static NSString *const kGridSizeKey = @"Size";
     }
     for (int y = from.y; y <= to.y; y++) {
         VT100LineInfo *lineInfo = [self lineInfoAtLineNumber:y];
-        [lineInfo setDirty:dirty
-                   inRange:VT100GridRangeMake(from.x, to.x - from.x + 1)
-           updateTimestamp:YES];
+        if (lineInfo) {
+            VT100LineInfoSetDirty(lineInfo, dirty, VT100GridRangeMake(from.x, to.x - from.x + 1), YES);
+        }
     }
 }
 
@@ -185,7 +198,7 @@ static NSString *const kGridSizeKey = @"Size";
         return YES;
     }
     VT100LineInfo *lineInfo = [self lineInfoAtLineNumber:coord.y];
-    return [lineInfo isDirtyAtOffset:coord.x];
+    return lineInfo && VT100LineInfoIsDirtyAtOffset(lineInfo, MIN(size_.width - 1, MAX(0, coord.x)));
 }
 
 - (NSIndexSet *)dirtyIndexesOnLine:(int)line {
@@ -193,7 +206,10 @@ static NSString *const kGridSizeKey = @"Size";
         return [NSIndexSet indexSetWithIndexesInRange:NSMakeRange(0, self.size.width)];
     }
     VT100LineInfo *lineInfo = [self lineInfoAtLineNumber:line];
-    return [lineInfo dirtyIndexes];
+    if (!lineInfo || !VT100LineInfoAnyCharIsDirty(lineInfo)) {
+        return [NSIndexSet indexSet];
+    }
+    return [NSIndexSet indexSetWithIndexesInRange:NSMakeRange(lineInfo->start, lineInfo->bound - lineInfo->start)];
 }
 
 - (BOOL)isAnyCharDirty {
@@ -201,8 +217,7 @@ static NSString *const kGridSizeKey = @"Size";
         return YES;
     }
     for (int y = 0; y < size_.height; y++) {
-        VT100LineInfo *lineInfo = [self lineInfoAtLineNumber:y];
-        if ([lineInfo anyCharIsDirty]) {
+        if (VT100LineInfoAnyCharIsDirty(&_lineInfos[y])) {
             return YES;
         }
     }
@@ -211,7 +226,10 @@ static NSString *const kGridSizeKey = @"Size";
 
 - (VT100GridRange)dirtyRangeForLine:(int)y {
     VT100LineInfo *lineInfo = [self lineInfoAtLineNumber:y];
-    return [lineInfo dirtyRange];
+    if (!lineInfo) {
+        return VT100GridRangeMake(-1, 0);
+    }
+    return VT100LineInfoDirtyRange(lineInfo);
 }
 
 - (int)cursorX {
@@ -319,7 +337,7 @@ static NSString *const kGridSizeKey = @"Size";
                         length:currentLineLength
                        partial:isPartial
                          width:size_.width
-                     timestamp:[[self lineInfoAtLineNumber:i] timestamp]
+                     timestamp:[self timestampForLine:i]
                   continuation:line[size_.width]];
 #ifdef DEBUG_RESIZEDWIDTH
         NSLog(@"Appended a line. now have %d lines for width %d\n",
@@ -331,11 +349,13 @@ static NSString *const kGridSizeKey = @"Size";
 }
 
 - (NSTimeInterval)timestampForLine:(int)y {
-    return [[self lineInfoAtLineNumber:y] timestamp];
+    VT100LineInfo *lineInfo = [self lineInfoAtLineNumber:y];
+    return lineInfo ? lineInfo->timestamp : 0;
 }
 
 - (NSInteger)generationForLine:(int)y {
-    return [[self lineInfoAtLineNumber:y] generation];
+    VT100LineInfo *lineInfo = [self lineInfoAtLineNumber:y];
+    return lineInfo ? lineInfo->generation : 0;
 }
 
 - (int)lengthOfLineNumber:(int)lineNumber {
@@ -390,10 +410,7 @@ static NSString *const kGridSizeKey = @"Size";
     screenTop_ = (screenTop_ + 1) % size_.height;
     _haveScrolled = YES;
     // Empty contents of last line on screen.
-    NSMutableData *lastLineData = [self lineDataAtLineNumber:(size_.height - 1)];
-    if (lastLineData) {  // This if statement is just to quiet the analyzer.
-        [self clearLineData:lastLineData];
-    }
+    [self clearLine:[self screenCharsAtLineNumber:size_.height - 1] width:size_.width];
 
     if (lineBuffer) {
         // Mark new line at bottom of screen dirty.
@@ -689,12 +706,23 @@ static NSString *const kGridSizeKey = @"Size";
         return;
     }
     [self setSize:otherGrid.size];
-    for (int i = 0; i < size_.height; i++) {
-        screen_char_t *dest = [self screenCharsAtLineNumber:i];
-        screen_char_t *source = [otherGrid screenCharsAtLineNumber:i];
-        memmove(dest,
-                source,
-                sizeof(screen_char_t) * (size_.width + 1));
+    if ([self copyCellsFromGrid:otherGrid]) {
+        // Line infos stay put, so rotate them to match the other grid's first line.
+        VT100LineInfo *lineInfos = iTermMalloc(sizeof(VT100LineInfo) * size_.height);
+        for (int i = 0; i < size_.height; i++) {
+            lineInfos[(otherGrid->screenTop_ + i) % size_.height] = _lineInfos[(screenTop_ + i) % size_.height];
+        }
+        free(_lineInfos);
+        _lineInfos = lineInfos;
+        screenTop_ = otherGrid->screenTop_;
+    } else {
+        for (int i = 0; i < size_.height; i++) {
+            screen_char_t *dest = [self screenCharsAtLineNumber:i];
+            screen_char_t *source = [otherGrid screenCharsAtLineNumber:i];
+            memmove(dest,
+                    source,
+                    sizeof(screen_char_t) * (size_.width + 1));
+        }
     }
     [self markAllCharsDirty:YES];
 }
@@ -1362,6 +1390,16 @@ static NSString *const kGridSizeKey = @"Size";
 - (BOOL)restoreScreenFromLineBuffer:(LineBuffer *)lineBuffer
                     withDefaultChar:(screen_char_t)defaultChar
                   maxLinesToRestore:(int)maxLines {
+    return [self restoreScreenFromLineBuffer:lineBuffer
+                             withDefaultChar:defaultChar
+                           maxLinesToRestore:maxLines
+                               restoreCursor:YES];
+}
+
+- (BOOL)restoreScreenFromLineBuffer:(LineBuffer *)lineBuffer
+                    withDefaultChar:(screen_char_t)defaultChar
+                  maxLinesToRestore:(int)maxLines
+                      restoreCursor:(BOOL)restoreCursor {
     // Move scrollback lines into screen
     int numLinesInLineBuffer = [lineBuffer numLinesWithWidth:size_.width];
     int destLineNumber;
@@ -1381,7 +1419,7 @@ static NSString *const kGridSizeKey = @"Size";
     while (destLineNumber >= 0) {
         screen_char_t *dest = [self screenCharsAtLineNumber:destLineNumber];
         memcpy(dest, defaultLine, sizeof(screen_char_t) * size_.width);
-        if (!foundCursor) {
+        if (restoreCursor && !foundCursor) {
             int tempCursor = cursor_.x;
             foundCursor = [lineBuffer getCursorInLastLineWithWidth:size_.width atX:&tempCursor];
             if (foundCursor) {
@@ -1404,7 +1442,7 @@ static NSString *const kGridSizeKey = @"Size";
                                 includesEndOfLine:&cont
                                         timestamp:&timestamp
                                      continuation:&continuation]);
-        [[self lineInfoAtLineNumber:destLineNumber] setTimestamp:timestamp];
+        [self lineInfoAtLineNumber:destLineNumber]->timestamp = timestamp;
         if (cont && dest[size_.width - 1].code == 0 && prevLineStartsWithDoubleWidth) {
             // If you pop a soft-wrapped line that's a character short and the
             // line below it starts with a DWC, it's safe to conclude that a DWC
@@ -1538,7 +1576,7 @@ static NSString *const kGridSizeKey = @"Size";
             if (line[x].complexChar) c = 'U';
             [dump appendFormat:@"%c", c];
         }
-        NSDate* date = [NSDate dateWithTimeIntervalSinceReferenceDate:[[self lineInfoAtLineNumber:y] timestamp]];
+        NSDate* date = [NSDate dateWithTimeIntervalSinceReferenceDate:[self timestampForLine:y]];
         [dump appendFormat:@"  | %@", [fmt stringFromDate:date]];
         if (y != size_.height - 1) {
             [dump appendString:@"\n"];
@@ -1658,13 +1696,20 @@ static NSString *const kGridSizeKey = @"Size";
 }
 
 - (NSArray *)orderedLines {
-    NSMutableArray *array = [NSMutableArray array];
+    NSMutableArray *array = [NSMutableArray arrayWithCapacity:size_.height];
+    const NSUInteger length = sizeof(screen_char_t) * (size_.width + 1);
     for (int i = 0; i < size_.height; i++) {
-        [array addObject:[self lineDataAtLineNumber:i]];
+        [array addObject:[NSData dataWithBytesNoCopy:[self screenCharsAtLineNumber:i]
+                                              length:length
+                                        freeWhenDone:NO]];
     }
     return array;
 }
 
+- (NSInteger)memoryUsage {
+    return size_.height * (sizeof(screen_char_t) * (size_.width + 1) + sizeof(VT100LineInfo));
+}
+
 - (NSDictionary *)dictionaryValue {
     return @{ kGridCursorKey: [NSDictionary dictionaryWithGridCoord:cursor_],
               kGridScrollRegionRowsKey: [NSDictionary dictionaryWithGridRange:scrollRegionRows_],
@@ -1696,8 +1741,8 @@ static NSString *const kGridSizeKey = @"Size";
 }
 
 - (void)resetTimestamps {
-    for (VT100LineInfo *info in lineInfos_) {
-        info.timestamp = 0;
+    for (int i = 0; i < size_.height; i++) {
+        _lineInfos[i].timestamp = 0;
     }
 }
 
@@ -1730,11 +1775,12 @@ static NSString *const kGridSizeKey = @"Size";
 }
 
 - (void)encode:(id<iTermEncoderAdapter>)encoder {
-    NSArray<NSNumber *> *timestamps = [lineInfos_ mapWithBlock:^id(VT100LineInfo *anObject) {
-        return @(anObject.timestamp);
+    NSArray<NSNumber *> *timestamps = [[NSArray sequenceWithRange:NSMakeRange(0, size_.height)] mapWithBlock:^id(NSNumber *i) {
+        return @([self timestampForLine:i.intValue]);
     }];
     NSArray<NSData *> *lines = [[NSArray sequenceWithRange:NSMakeRange(0, size_.height)] mapWithBlock:^id(NSNumber *i) {
-        return [self lineDataAtLineNumber:i.intValue];
+        return [NSData dataWithBytes:[self screenCharsAtLineNumber:i.intValue]
+                              length:sizeof(screen_char_t) * (size_.width + 1)];
     }];
     [encoder mergeDictionary:@{
         @"size": [NSDictionary dictionaryWithGridSize:size_],
@@ -1750,20 +1796,40 @@ static NSString *const kGridSizeKey = @"Size";
 
 #pragma mark - Private
 
-- (NSMutableArray *)linesWithSize:(VT100GridSize)size {
-    NSMutableArray *lines = [[[NSMutableArray alloc] init] autorelease];
-    for (int i = 0; i < size.height; i++) {
-        [lines addObject:[[[self defaultLineOfWidth:size.width] mutableCopy] autorelease]];
+- (void)freeCells {
+    if (_cellsVMSize) {
+        vm_deallocate(mach_task_self(), (vm_address_t)_cells, _cellsVMSize);
+    } else {
+        free(_cells);
     }
-    return lines;
+    _cells = NULL;
+    _cellsVMSize = 0;
 }
 
-- (NSMutableArray *)lineInfosWithSize:(VT100GridSize)size {
-    NSMutableArray *dirty = [NSMutableArray array];
-    for (int i = 0; i < size.height; i++) {
-        [dirty addObject:[[[VT100LineInfo alloc] initWithWidth:size_.width] autorelease]];
+// Replaces the cells and line infos with empty ones for size_.
+- (void)allocateLines {
+    [self freeCells];
+    free(_lineInfos);
+    const size_t lineLength = size_.width + 1;
+    const size_t cellsSize = sizeof(screen_char_t) * lineLength * size_.height;
+    if ([iTermAdvancedSettingsModel copyOnWriteGridSnapshots] && cellsSize >= VT100GridMinimumVMCopySize) {
+        vm_address_t address = 0;
+        const vm_size_t vmSize = round_page(cellsSize);
+        if (vm_allocate(mach_task_self(), &address, vmSize, VM_FLAGS_ANYWHERE) == KERN_SUCCESS) {
+            _cells = (screen_char_t *)address;
+            _cellsVMSize = vmSize;
+        }
+    }
+    if (!_cells) {
+        _cells = iTermMalloc(cellsSize);
     }
-    return dirty;
+    _lineInfos = iTermMalloc(sizeof(VT100LineInfo) * size_.height);
+    const screen_char_t *defaultLine = [[self defaultLineOfWidth:size_.width] bytes];
+    for (int i = 0; i < size_.height; i++) {
+        memcpy(_cells + i * lineLength, defaultLine, sizeof(screen_char_t) * lineLength);
+        VT100LineInfoInitialize(&_lineInfos[i]);
+    }
+    screenTop_ = 0;
 }
 
 - (screen_char_t)defaultChar {
@@ -1811,7 +1877,7 @@ static NSString *const kGridSizeKey = @"Size";
 
     [cachedDefaultLine_ release];
     cachedDefaultLine_ = nil;
-    [self clearLineData:line];
+    [self clearLine:line.mutableBytes width:width];
 
     cachedDefaultLine_ = [line retain];
 
@@ -1844,12 +1910,9 @@ static NSString *const kGridSizeKey = @"Size";
     }
 }
 
-- (void)clearLineData:(NSMutableData *)line {
-    int length = (int)([line length] / sizeof(screen_char_t));
-    // Clear length+1 so that continuation is set properly
-    [self clearScreenChars:[line mutableBytes] inRange:VT100GridRangeMake(0, length)];
-    screen_char_t *chars = (screen_char_t *)[line mutableBytes];
-    int width = [line length] / sizeof(screen_char_t) - 1;
+- (void)clearLine:(screen_char_t *)chars width:(int)width {
+    // Clear width+1 so that continuation is set properly
+    [self clearScreenChars:chars inRange:VT100GridRangeMake(0, width + 1)];
     chars[width].code = EOL_HARD;
 }
 
@@ -1859,7 +1922,19 @@ static NSString *const kGridSizeKey = @"Size";
     if (!lineBuffer) {
         return 0;
     }
-    screen_char_t *line = [self screenCharsAtLineNumber:0];
+    [self appendLineNumber:0 toLineBuffer:lineBuffer];
+    int dropped;
+    if (!unlimitedScrollback) {
+        dropped = [lineBuffer dropExcessLinesWithWidth:size_.width];
+    } else {
+        dropped = 0;
+    }
+
+    return dropped;
+}
+
+- (void)appendLineNumber:(int)lineNumber toLineBuffer:(LineBuffer *)lineBuffer {
+    screen_char_t *line = [self screenCharsAtLineNumber:lineNumber];
     int len = [self lengthOfLine:line];
     int continuationMark = line[size_.width].code;
     if (continuationMark == EOL_DWC && len == size_.width) {
@@ -1869,16 +1944,14 @@ static NSString *const kGridSizeKey = @"Size";
                     length:len
                    partial:(continuationMark != EOL_HARD)
                      width:size_.width
-                 timestamp:[[self lineInfoAtLineNumber:0] timestamp]
+                 timestamp:[[self lineInfoAtLineNumber:lineNumber] timestamp]
               continuation:line[size_.width]];
-    int dropped;
-    if (!unlimitedScrollback) {
-        dropped = [lineBuffer dropExcessLinesWithWidth:size_.width];
-    } else {
-        dropped = 0;
-    }
+}
 
-    return dropped;
+- (void)appendLinesAboveCursorToLineBuffer:(LineBuffer *)lineBuffer {
+    for (int i = 0; i < cursor_.y; i++) {
+        [self appendLineNumber:i toLineBuffer:lineBuffer];
+    }
 }
 
 - (BOOL)haveColumnScrollRegion {
@@ -1917,10 +1990,7 @@ static NSString *const kGridSizeKey = @"Size";
     if (newSize.width != size_.width || newSize.height != size_.height) {
         DLog(@"Grid for %@ resized to %@", self.delegate, VT100GridSizeDescription(newSize));
         size_ = newSize;
-        [lines_ release];
-        [lineInfos_ release];
-        lines_ = [[self linesWithSize:newSize] retain];
-        lineInfos_ = [[self lineInfosWithSize:newSize] retain];
+        [self allocateLines];
         scrollRegionRows_.location = MIN(scrollRegionRows_.location, size_.width - 1);
         scrollRegionRows_.length = MIN(scrollRegionRows_.length,
                                        size_.width - scrollRegionRows_.location);
@@ -2136,21 +2206,27 @@ static void DumpBuf(screen_char_t* p, int n) {
     scrollRegionCols_ = VT100GridRangeMake(0, size_.width);
 }
 
+// Makes _cells a copy-on-write copy of otherGrid's cells, including the order of its lines.
+// Returns NO if either grid's cells weren't allocated for that, in which case nothing changes.
+- (BOOL)copyCellsFromGrid:(VT100Grid *)otherGrid {
+    if (!_cellsVMSize || _cellsVMSize != otherGrid->_cellsVMSize) {
+        return NO;
+    }
+    return vm_copy(mach_task_self(),
+                   (vm_address_t)otherGrid->_cells,
+                   _cellsVMSize,
+                   (vm_address_t)_cells) == KERN_SUCCESS;
+}
+
 #pragma mark - NSCopying
 
 - (id)copyWithZone:(NSZone *)zone {
     VT100Grid *theCopy = [[VT100Grid alloc] initWithSize:size_
                                                 delegate:delegate_];
-    [theCopy->lines_ release];
-    theCopy->lines_ = [[NSMutableArray alloc] init];
-    for (NSObject *line in lines_) {
-        [theCopy->lines_ addObject:[[line mutableCopy] autorelease]];
-    }
-    [theCopy->lineInfos_ release];
-    theCopy->lineInfos_ = [[NSMutableArray alloc] init];
-    for (VT100LineInfo *line in lineInfos_) {
-        [theCopy->lineInfos_ addObject:[[line copy] autorelease]];
+    if (![theCopy copyCellsFromGrid:self]) {
+        memcpy(theCopy->_cells, _cells, sizeof(screen_char_t) * (size_.width + 1) * size_.height);
     }
+    memcpy(theCopy->_lineInfos, _lineInfos, sizeof(VT100LineInfo) * size_.height);
     theCopy->screenTop_ = screenTop_;
     theCopy->cursor_ = cursor_;  // Don't use property to avoid delegate call
     theCopy.scrollRegionRows = scrollRegionRows_;
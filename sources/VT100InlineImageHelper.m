@@ -17,17 +17,27 @@
 #import "VT100Grid.h"
 
 @interface VT100DecodedImage: NSObject
-@property (nonatomic, strong, readonly) iTermImage *image;
+// Nil while a decode is pending.
+@property (nullable, nonatomic, strong, readonly) iTermImage *image;
 @property (nullable, nonatomic, copy, readonly) NSData *data;
 @property (nonatomic) BOOL isBroken;
+// Size of the image in pixels. Known before decoding finishes if the image is pending.
+@property (nonatomic, readonly) NSSize size;
 @end
 
-@implementation VT100DecodedImage
+@implementation VT100DecodedImage {
+    NSSize _pendingSize;
+    BOOL _pendingIsSixel;
+}
 
 - (instancetype)initWithBase64String:(NSString *)base64String {
+    return [self initWithCompressedData:[NSData dataWithBase64EncodedString:base64String]];
+}
+
+- (instancetype)initWithCompressedData:(NSData *)data {
     self = [super init];
     if (self) {
-        _data = [NSData dataWithBase64EncodedString:base64String];
+        _data = [data copy];
         _image = [iTermImage imageWithCompressedData:_data];
         if (!_image) {
             [self broke];
@@ -60,6 +70,56 @@
     return self;
 }
 
+// The image will be filled in later by -decodePendingImageWithCode:completion:.
+- (instancetype)initWithPendingData:(NSData *)data sixel:(BOOL)sixel size:(NSSize)size {
+    self = [super init];
+    if (self) {
+        _data = [data copy];
+        _pendingIsSixel = sixel;
+        _pendingSize = size;
+    }
+    return self;
+}
+
+- (NSSize)size {
+    return _image ? _image.size : _pendingSize;
+}
+
+// Decodes in the sandboxed worker on a background queue so a big image doesn't block the session.
+// The cells are already on screen; they draw as a missing image until iTermImageDidLoad is posted.
+- (void)decodePendingImageWithCode:(unichar)code completion:(void (^)(void))completion {
+    static dispatch_queue_t queue;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        queue = dispatch_queue_create("com.iterm2.sixel-decode", DISPATCH_QUEUE_SERIAL);
+    });
+    iTermImageInfo *imageInfo = GetImageInfo(code);
+    NSData *data = _data;
+    const BOOL sixel = _pendingIsSixel;
+    DLog(@"Begin asynchronous decode of image %@", imageInfo);
+    dispatch_async(queue, ^{
+        iTermImage *image = sixel ? [iTermImage imageWithSixelData:data] : [iTermImage imageWithCompressedData:data];
+        dispatch_async(dispatch_get_main_queue(), ^{
+            if (GetImageInfo(code) != imageInfo) {
+                DLog(@"Image %@ was released before it finished decoding", imageInfo);
+                return;
+            }
+            iTermImage *decoded = image;
+            if (!decoded) {
+                DLog(@"Asynchronous image decode failed");
+                imageInfo.broken = YES;
+                decoded = [iTermImage imageWithNativeImage:[NSImage it_imageNamed:@"broken_image"
+                                                                         forClass:[VT100DecodedImage class]]];
+            }
+            SetDecodedImage(code, decoded, data);
+            if (completion) {
+                completion();
+            }
+            [[NSNotificationCenter defaultCenter] postNotificationName:iTermImageDidLoad object:imageInfo];
+        });
+    });
+}
+
 - (void)broke {
     _isBroken = YES;
     DLog(@"Image is broken");
@@ -69,6 +129,46 @@
 
 @end
 
+// Returns the size given by the sixel's raster attributes (" Pan ; Pad ; Ph ; Pv), or NSZeroSize if
+// it doesn't begin with them. |data| is formatted as by VT100SixelParser.
+static NSSize VT100InlineImageHelperSixelRasterSize(NSData *data) {
+    const unsigned char *bytes = data.bytes;
+    const NSUInteger length = data.length;
+    NSUInteger i = 0;
+    // Skip the parameters line and the DCS introducer up to the final "q".
+    while (i < length && bytes[i] != '\n') {
+        i++;
+    }
+    while (i < length && bytes[i] != 'q') {
+        i++;
+    }
+    i++;
+    if (i >= length || bytes[i] != '"') {
+        return NSZeroSize;
+    }
+    i++;
+    long values[4] = { 0, 0, 0, 0 };
+    int n = 0;
+    while (i < length && n < 4) {
+        const unsigned char c = bytes[i];
+        if (c >= '0' && c <= '9') {
+            values[n] = values[n] * 10 + (c - '0');
+            if (values[n] > 1000000) {
+                return NSZeroSize;
+            }
+        } else if (c == ';') {
+            n++;
+        } else {
+            break;
+        }
+        i++;
+    }
+    if (n < 3) {
+        return NSZeroSize;
+    }
+    return NSMakeSize(values[2], values[3]);
+}
+
 @interface VT100InlineImageHelper()
 @property (nonatomic, copy) NSString *name;
 @property (nonatomic) int width;
@@ -84,7 +184,18 @@
 @property (nonatomic) CGFloat scaleFactor;
 @end
 
-@implementation VT100InlineImageHelper
+@implementation VT100InlineImageHelper {
+    // Scale of the display, even if retina inline images are off.
+    CGFloat _backingScaleFactor;
+
+    // When asynchronousInlineImages is on, base64 is decoded as it arrives into _decodedData rather
+    // than being accumulated in base64String, and scaled images are prepared in the background.
+    // _pendingBase64 holds the trailing partial group.
+    BOOL _asynchronous;
+    NSMutableData *_decodedData;
+    NSMutableString *_pendingBase64;
+    NSInteger _base64Length;
+}
 
 - (instancetype)initWithName:(NSString *)name
                        width:(int)width
@@ -109,7 +220,13 @@
         } else {
             _scaleFactor = 1;
         }
+        _backingScaleFactor = scaleFactor;
         _base64String = [NSMutableString string];
+        _asynchronous = [iTermAdvancedSettingsModel asynchronousInlineImages];
+        if (_asynchronous) {
+            _decodedData = [NSMutableData data];
+            _pendingBase64 = [NSMutableString string];
+        }
     }
     return self;
 }
@@ -152,6 +269,17 @@
 #pragma mark - APIs
 
 - (void)appendBase64EncodedData:(NSString *)data {
+    if (_asynchronous) {
+        const NSInteger lengthBefore = _base64Length;
+        [self decodeBase64Incrementally:data];
+        _base64Length += data.length;
+        if (!_preconfirmed) {
+            [self.delegate inlineImageConfirmBigDownloadWithBeforeSize:lengthBefore
+                                                             afterSize:_base64Length
+                                                                  name:_name ?: @"Unnamed file"];
+        }
+        return;
+    }
     const NSInteger lengthBefore = _base64String.length;
     [_base64String appendString: data];
     const NSInteger lengthAfter = _base64String.length;
@@ -184,7 +312,21 @@
                 decodedImage:decodedImage];
 
     // Add a mark after the image. When the mark gets freed, it will release the image's memory.
-    SetDecodedImage(c.code, decodedImage.image, decodedImage.data);
+    if (decodedImage.image) {
+        SetDecodedImage(c.code, decodedImage.image, decodedImage.data);
+        [self prepareImageWithCode:c.code];
+    } else {
+        const unichar code = c.code;
+        void (^completion)(void) = nil;
+        if (_asynchronous) {
+            const NSSize cellSize = [self.delegate inlineImageCellSize];
+            const CGFloat scale = _backingScaleFactor;
+            completion = ^{
+                [GetImageInfo(code) prepareImageWithCellSize:cellSize scale:scale];
+            };
+        }
+        [decodedImage decodePendingImageWithCode:code completion:completion];
+    }
     [self.delegate inlineImageSetMarkOnScreenLine:grid.cursor.y + 1
                                              code:c.code];
 }
@@ -201,16 +343,74 @@
     if (_sixelData) {
         DLog(@"Image is sixel");
         assert(_base64String.length == 0);
+        if ([iTermAdvancedSettingsModel decodeSixelAsynchronously]) {
+            const NSSize size = VT100InlineImageHelperSixelRasterSize(_sixelData);
+            if (size.width > 0 && size.height > 0) {
+                DLog(@"Sixel declares its size as %@. Decode asynchronously.", NSStringFromSize(size));
+                return [[VT100DecodedImage alloc] initWithPendingData:_sixelData sixel:YES size:size];
+            }
+        }
         return [[VT100DecodedImage alloc] initWithSixelData:_sixelData];
     }
     DLog(@"Image was base-64 encoded");
+    if (_asynchronous) {
+        assert(_base64String.length == 0);
+        [self finishIncrementalBase64Decode];
+        if (_widthUnits != kVT100TerminalUnitsAuto &&
+            _heightUnits != kVT100TerminalUnitsAuto &&
+            !_preserveAspectRatio) {
+            // The image's own size doesn't affect layout, so it can be decoded later.
+            DLog(@"Image size is fully specified. Decode asynchronously.");
+            return [[VT100DecodedImage alloc] initWithPendingData:_decodedData sixel:NO size:NSZeroSize];
+        }
+        return [[VT100DecodedImage alloc] initWithCompressedData:_decodedData];
+    }
     return [[VT100DecodedImage alloc] initWithBase64String:_base64String];
 }
 
+// Decodes all complete 4-character groups so the work (and the memory for the base64 text) is
+// spread over the transfer rather than done all at once when the image is written.
+- (void)decodeBase64Incrementally:(NSString *)chunk {
+    for (NSString *part in [chunk componentsSeparatedByCharactersInSet:[NSCharacterSet newlineCharacterSet]]) {
+        [_pendingBase64 appendString:part];
+    }
+    const NSUInteger usable = _pendingBase64.length - _pendingBase64.length % 4;
+    if (usable == 0) {
+        return;
+    }
+    NSData *decoded = [NSData dataWithBase64EncodedString:[_pendingBase64 substringToIndex:usable]];
+    if (decoded) {
+        [_decodedData appendData:decoded];
+    }
+    [_pendingBase64 deleteCharactersInRange:NSMakeRange(0, usable)];
+}
+
+- (void)finishIncrementalBase64Decode {
+    if (_pendingBase64.length == 0) {
+        return;
+    }
+    // Unpadded input can leave a partial group at the end.
+    NSData *decoded = [NSData dataWithBase64EncodedString:_pendingBase64];
+    if (decoded) {
+        [_decodedData appendData:decoded];
+    }
+    [_pendingBase64 setString:@""];
+}
+
+// Renders the image at its on-screen size in the background so the first draw (often while
+// scrolling) doesn't have to scale a full-size image on the main thread.
+- (void)prepareImageWithCode:(unichar)code {
+    if (!_asynchronous) {
+        return;
+    }
+    [GetImageInfo(code) prepareImageWithCellSize:[self.delegate inlineImageCellSize]
+                                           scale:_backingScaleFactor];
+}
+
 #pragma mark - Size Calculation
 
 - (NSSize)scaledSizeForDecodedImage:(VT100DecodedImage *)decodedImage {
-    NSSize scaledSize = decodedImage.image.size;
+    NSSize scaledSize = decodedImage.size;
     scaledSize.width /= _scaleFactor;
     scaledSize.height /= _scaleFactor;
     return scaledSize;
@@ -384,12 +584,12 @@
     if (_preserveAspectRatio) {
         // Pick an inset that preserves the exact dimensions of the original image.
         return [iTermImageInfo fractionalInsetsForPreservedAspectRatioWithDesiredSize:desiredSize
-                                                                         forImageSize:decodedImage.image.size
+                                                                         forImageSize:decodedImage.size
                                                                              cellSize:cellSize
                                                                         numberOfCells:NSMakeSize(width, height)];
     }
     return [iTermImageInfo fractionalInsetsStretchingToDesiredSize:desiredSize
-                                                         imageSize:decodedImage.image.size
+                                                         imageSize:decodedImage.size
                                                           cellSize:cellSize
                                                      numberOfCells:NSMakeSize(width, height)];
 }
@@ -9,16 +9,28 @@
 #import <Foundation/Foundation.h>
 #import "VT100GridTypes.h"
 
-@interface VT100LineInfo : NSObject <NSCopying>
+// Metadata for one line of a VT100Grid. The grid keeps these in one array parallel to its cells
+// rather than as an object per line.
+typedef struct {
+    NSTimeInterval timestamp;
+    // Changes whenever the dirty range grows.
+    NSInteger generation;
+    // The dirty columns are [start, bound). Both are -1 when nothing is dirty.
+    int start;
+    int bound;
+} VT100LineInfo;
 
-@property(nonatomic, assign) NSTimeInterval timestamp;
-@property(nonatomic, readonly) NSInteger generation;
+void VT100LineInfoInitialize(VT100LineInfo *info);
+void VT100LineInfoSetDirty(VT100LineInfo *info, BOOL dirty, VT100GridRange range, BOOL updateTimestamp);
 
-- (instancetype)initWithWidth:(int)width;
-- (void)setDirty:(BOOL)dirty inRange:(VT100GridRange)range updateTimestamp:(BOOL)updateTimestamp;
-- (BOOL)isDirtyAtOffset:(int)x;
-- (BOOL)anyCharIsDirty;
-- (VT100GridRange)dirtyRange;
-- (NSIndexSet *)dirtyIndexes;
+NS_INLINE VT100GridRange VT100LineInfoDirtyRange(const VT100LineInfo *info) {
+    return VT100GridRangeMake(info->start, info->bound - info->start);
+}
 
-@end
+NS_INLINE BOOL VT100LineInfoIsDirtyAtOffset(const VT100LineInfo *info, int x) {
+    return x >= info->start && x < info->bound;
+}
+
+NS_INLINE BOOL VT100LineInfoAnyCharIsDirty(const VT100LineInfo *info) {
+    return info->start >= 0;
+}
@@ -24,6 +24,8 @@
     NSMutableDictionary *_savedStateForPartialParse;
     VT100ControlParser *_controlParser;
     BOOL _dcsHooked;
+    // Parses the payload of DCS tmux passthrough codes. Created on first use and reused after that.
+    VT100Parser *_nestedParser;
 }
 
 - (instancetype)init {
@@ -41,6 +43,7 @@
     free(_stream);
     [_savedStateForPartialParse release];
     [_controlParser release];
+    [_nestedParser release];
     [super dealloc];
 }
 
@@ -55,8 +58,7 @@
     unsigned char *datap;
     int datalen;
 
-    VT100Token *token = [VT100Token token];
-    token.string = nil;
+    VT100Token *token = [VT100Token newToken];
     // get our current position in the stream
     datap = _stream + _streamOffset;
     datalen = _currentStreamLength - _streamOffset;
@@ -107,11 +109,11 @@
                     break;
 
                 case DCS_TMUX_CODE_WRAP: {
-                    VT100Parser *tempParser = [[[VT100Parser alloc] init] autorelease];
-                    tempParser.encoding = encoding;
-                    NSData *data = [token.string dataUsingEncoding:encoding];
-                    [tempParser putStreamData:data.bytes length:data.length];
-                    [tempParser addParsedTokensToVector:vector];
+                    if (!_nestedParser) {
+                        _nestedParser = [[VT100Parser alloc] init];
+                    }
+                    [_nestedParser prepareToParseNestedString:token.string encoding:encoding];
+                    [_nestedParser addParsedTokensToVector:vector];
                     break;
                 }
 
@@ -189,24 +191,62 @@
         // Don't append the outer wrapper to the output. Earlier, it was unwrapped and the inner
         // tokens were already added.
         if (token->type != DCS_TMUX_CODE_WRAP) {
-            [token retain];
+            // The vector takes ownership of the token.
             CVectorAppend(vector, token);
+        } else {
+            [token recycle];
         }
         return YES;
     }
 
+    [token recycle];
     return NO;
 }
 
-- (void)putStreamData:(const char *)buffer length:(int)length {
+// Makes room for |length| more bytes at the end of the stream.
+- (void)growStreamToFitAdditionalLength:(int)length {
+    if (_currentStreamLength + length > _totalStreamLength) {
+        // Grow the stream if needed.
+        int n = (length + _currentStreamLength) / kDefaultStreamSize;
+
+        _totalStreamLength += n * kDefaultStreamSize;
+        _stream = iTermRealloc(_stream, _totalStreamLength, 1);
+    }
+}
+
+// Puts the parser in the state of a new one and then encodes |string| directly into its stream.
+// Anything left over from the last nested payload, like an incomplete code, is discarded.
+- (void)prepareToParseNestedString:(NSString *)string encoding:(NSStringEncoding)encoding {
     @synchronized(self) {
-        if (_currentStreamLength + length > _totalStreamLength) {
-            // Grow the stream if needed.
-            int n = (length + _currentStreamLength) / kDefaultStreamSize;
+        [_savedStateForPartialParse removeAllObjects];
+        [self forceUnhookDCS:nil];
+        _saveData = NO;
+        _streamOffset = 0;
+        _currentStreamLength = 0;
+        self.encoding = encoding;
 
-            _totalStreamLength += n * kDefaultStreamSize;
-            _stream = iTermRealloc(_stream, _totalStreamLength, 1);
+        const NSUInteger maxLength = [string maximumLengthOfBytesUsingEncoding:encoding];
+        [self growStreamToFitAdditionalLength:(int)maxLength];
+        NSUInteger usedLength = 0;
+        NSRange remainingRange = NSMakeRange(0, 0);
+        [string getBytes:_stream
+               maxLength:maxLength
+              usedLength:&usedLength
+                encoding:encoding
+                 options:0
+                   range:NSMakeRange(0, string.length)
+          remainingRange:&remainingRange];
+        if (remainingRange.length > 0) {
+            // Not representable in this encoding. Ignore it as a failed conversion always has.
+            usedLength = 0;
         }
+        _currentStreamLength = (int)usedLength;
+    }
+}
+
+- (void)putStreamData:(const char *)buffer length:(int)length {
+    @synchronized(self) {
+        [self growStreamToFitAdditionalLength:length];
 
         memcpy(_stream + _currentStreamLength, buffer, length);
         _currentStreamLength += length;
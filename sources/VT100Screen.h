@@ -85,6 +85,11 @@ extern const NSInteger VT100ScreenBigFileDownloadThreshold;
 // Destructively sets the screen size.
 - (void)destructivelySetScreenWidth:(int)width height:(int)height;
 
+// Does the slow part of reflowing a large history to |width| on background threads. Returns NO
+// if that isn't worthwhile. Otherwise |completion| is called on the main queue when changing to
+// that width will be fast. Output may be processed in the meantime.
+- (BOOL)prepareToResizeToWidth:(int)width completion:(void (^)(void))completion;
+
 // Convert a run to one without nulls on either end.
 - (VT100GridRun)runByTrimmingNullsFromRun:(VT100GridRun)run;
 
@@ -111,6 +116,25 @@ extern const NSInteger VT100ScreenBigFileDownloadThreshold;
 - (void)appendStringAtCursor:(NSString *)string;
 - (void)appendAsciiDataAtCursor:(AsciiData *)asciiData;
 
+// Executes a run of tokens starting at |start| that only prints whole lines of ASCII text and
+// scrolls the screen, by appending the lines directly to the line buffer and building only the
+// final screen. The result is the same as executing the tokens one at a time. Returns the number
+// of tokens executed, or 0 if the run doesn't qualify. Then no run starting before *retryIndex
+// can qualify either. Screen delegate calls that depend on the grid's contents must be off.
+- (int)executeScrollingOutputTokens:(const CVector *)vector
+                              start:(int)start
+                         retryIndex:(int *)retryIndex;
+
+// Executes a run of tokens starting at |start| that alternates between SGR codes and ASCII text,
+// as syntax-highlighted output does, by coloring the text as it goes and appending all of it to
+// the screen in one call. The result is the same as executing the tokens one at a time. Returns
+// the number of tokens executed, or 0 if the run doesn't qualify, in which case no run starting
+// before *retryIndex can qualify either. Screen delegate calls that depend on the grid's contents
+// must be off.
+- (int)executeAttributedRunTokens:(const CVector *)vector
+                            start:(int)start
+                       retryIndex:(int *)retryIndex;
+
 // This is a hacky thing that moves the cursor to the next line, not respecting scroll regions.
 // It's used for the tmux status screen.
 - (void)crlf;
@@ -218,6 +242,10 @@ extern const NSInteger VT100ScreenBigFileDownloadThreshold;
      includeRestorationBanner:(BOOL)includeRestorationBanner
                 knownTriggers:(NSArray *)triggers
                    reattached:(BOOL)reattached;
+
+// Starts decoding the scrollback in a dictionary that will be given to -restoreFromDictionary:…
+// in the background.
++ (void)prefetchContentsOfDictionary:(NSDictionary *)dictionary;
 - (void)restoreInitialSize;
 
 // Zero-based (as VT100GridCoord always is), unlike -cursorX and -cursorY.
@@ -239,6 +267,14 @@ extern const NSInteger VT100ScreenBigFileDownloadThreshold;
                                     name:(NSString *)name;
 - (void)enumerateObservableMarks:(void (^ NS_NOESCAPE)(iTermIntervalTreeObjectType, NSInteger))block;
 
+// Approximate bytes used by each part of the screen, keyed by scrollback, grid, dvr, marks, and
+// images. Visits every mark, so don't call it often.
+- (NSDictionary<NSString *, NSNumber *> *)memoryUsage;
+
+// These free memory when the system is low on it. They return the number of bytes freed.
+- (NSInteger)discardInstantReplayHistory;
+- (NSInteger)compressScrollbackExceptNewestBlocks:(NSUInteger)blocks;
+
 @end
 
 @interface VT100Screen (Testing)
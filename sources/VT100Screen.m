@@ -12,6 +12,7 @@
 #import "iTermImage.h"
 #import "iTermImageInfo.h"
 #import "iTermImageMark.h"
+#import "iTermLineBufferPrefetcher.h"
 #import "iTermURLMark.h"
 #import "iTermOrderEnforcer.h"
 #import "iTermPreferences.h"
@@ -38,6 +39,7 @@
 #import "VT100Token.h"
 
 #import <apr-1/apr_base64.h>
+#import <objc/runtime.h>
 
 NSString *const kScreenStateKey = @"Screen State";
 
@@ -122,6 +124,10 @@ const NSInteger VT100ScreenBigFileDownloadThreshold = 1024 * 1024 * 1024;
     // Where we left off searching.
     long long savedFindContextAbsPos_;
 
+    // End of the line buffer (without the grid appended) when the last tail find began. Everything
+    // before it has been searched once the tail find finishes.
+    long long tailFindEndAbsPos_;
+
     // Used for recording instant replay.
     DVR* dvr_;
     BOOL saveToScrollbackInAlternateScreen_;
@@ -918,6 +924,13 @@ const NSInteger VT100ScreenBigFileDownloadThreshold = 1024 * 1024 * 1024;
     }
 }
 
+- (BOOL)prepareToResizeToWidth:(int)width completion:(void (^)(void))completion {
+    if (width == currentGrid_.size.width) {
+        return NO;
+    }
+    return [linebuffer_ prepareToWrapToWidth:width completion:completion];
+}
+
 - (void)setSize:(VT100GridSize)proposedSize {
     VT100GridSize newSize = [self safeSizeForSize:proposedSize];
     if (![self shouldSetSizeTo:newSize]) {
@@ -1181,10 +1194,12 @@ const NSInteger VT100ScreenBigFileDownloadThreshold = 1024 * 1024 * 1024;
     [linebuffer_ release];
     linebuffer_ = [[LineBuffer alloc] init];
     [linebuffer_ setMaxLines:maxScrollbackLines_];
+    linebuffer_.spillsToDisk = unlimitedScrollback_;
     [delegate_ screenClearHighlights];
     [currentGrid_ markAllCharsDirty:YES];
 
     savedFindContextAbsPos_ = 0;
+    tailFindEndAbsPos_ = 0;
 
     [self resetScrollbackOverflow];
     [delegate_ screenRemoveSelection];
@@ -1253,6 +1268,26 @@ const NSInteger VT100ScreenBigFileDownloadThreshold = 1024 * 1024 * 1024;
     }
 }
 
+// Fills |buffer| with |len| cells that have the colors and attributes of |prototype| and code points
+// taken from |bytes|. The prototype is laid down with a doubling memcpy and the codes are widened
+// from bytes to unichars in a separate pass. Both passes vectorize, which copying the color
+// bitfields cell by cell does not.
+static void VT100ScreenFillScreenCharsWithASCII(screen_char_t *buffer,
+                                                const char *bytes,
+                                                int len,
+                                                screen_char_t prototype) {
+    buffer[0] = prototype;
+    int filled = 1;
+    while (filled < len) {
+        const int n = MIN(filled, len - filled);
+        memcpy(buffer + filled, buffer, n * sizeof(*buffer));
+        filled += n;
+    }
+    for (int i = 0; i < len; i++) {
+        buffer[i].code = (unsigned char)bytes[i];
+    }
+}
+
 - (void)appendAsciiDataAtCursor:(AsciiData *)asciiData
 {
     int len = asciiData->length;
@@ -1269,18 +1304,29 @@ const NSInteger VT100ScreenBigFileDownloadThreshold = 1024 * 1024 * 1024;
          currentGrid_.cursorY,
          currentGrid_.cursorY + [linebuffer_ numLinesWithWidth:currentGrid_.size.width]);
 
-    screen_char_t *buffer;
-    buffer = asciiData->screenChars->buffer;
+    screen_char_t *buffer = [self screenCharsForAsciiData:asciiData];
+    [self appendScreenCharArrayAtCursor:buffer
+                                 length:len
+                             shouldFree:NO];
+    STOPWATCH_LAP(appendAsciiDataAtCursor);
+}
+
+// Fills in the attributes of the screen chars the parser made for asciiData.
+- (screen_char_t *)screenCharsForAsciiData:(AsciiData *)asciiData {
+    const int len = asciiData->length;
+    screen_char_t *buffer = asciiData->screenChars->buffer;
 
     screen_char_t fg = [terminal_ foregroundColorCode];
     screen_char_t bg = [terminal_ backgroundColorCode];
     screen_char_t zero = { 0 };
     if (memcmp(&fg, &zero, sizeof(fg)) || memcmp(&bg, &zero, sizeof(bg))) {
+        // The parser already zeroed the buffer and set the codes, so only the attributes differ
+        // from what's there. Build one prototype cell and stamp it across the run.
         STOPWATCH_START(setUpScreenCharArray);
-        for (int i = 0; i < len; i++) {
-            CopyForegroundColor(&buffer[i], fg);
-            CopyBackgroundColor(&buffer[i], bg);
-        }
+        screen_char_t prototype = zero;
+        CopyForegroundColor(&prototype, fg);
+        CopyBackgroundColor(&prototype, bg);
+        VT100ScreenFillScreenCharsWithASCII(buffer, asciiData->buffer, len, prototype);
         STOPWATCH_LAP(setUpScreenCharArray);
     }
 
@@ -1289,11 +1335,225 @@ const NSInteger VT100ScreenBigFileDownloadThreshold = 1024 * 1024 * 1024;
     if (charsetUsesLineDrawingMode_[[terminal_ charset]]) {
         ConvertCharsToGraphicsCharset(buffer, len);
     }
+    return buffer;
+}
+
+#pragma mark - Scrolling Output
+
+// Checks the state the fast path assumes: plain autowrapping output onto an empty last line of the
+// primary screen with nothing to intercept it.
+- (BOOL)canExecuteScrollingOutputTokens {
+    if (currentGrid_ != primaryGrid_ ||
+        !_wraparoundMode ||
+        _ansi ||
+        _insert ||
+        collectInputForPrinting_ ||
+        commandStartX_ != -1 ||
+        charsetUsesLineDrawingMode_[[terminal_ charset]] ||
+        terminal_.receivingFile ||
+        terminal_.copyingToPasteboard ||
+        [delegate_ screenIsAppendingToPasteboard] ||
+        [currentGrid_ haveScrollRegion]) {
+        return NO;
+    }
+    const int width = currentGrid_.size.width;
+    const int height = currentGrid_.size.height;
+    if (currentGrid_.cursorX != 0 || currentGrid_.cursorY != height - 1) {
+        return NO;
+    }
+    if ([currentGrid_ lengthOfLineNumber:height - 1] != 0) {
+        return NO;
+    }
+    if (height > 1 && [currentGrid_ screenCharsAtLineNumber:height - 2][width].code != EOL_HARD) {
+        // The first line would continue the one above.
+        return NO;
+    }
+    // The first line is written on the cursor's line, so it must end the way a line cleared by
+    // scrolling would.
+    screen_char_t continuation = [currentGrid_ defaultChar];
+    continuation.code = EOL_HARD;
+    const screen_char_t *cursorLine = [currentGrid_ screenCharsAtLineNumber:height - 1];
+    return !memcmp(&cursorLine[width], &continuation, sizeof(continuation));
+}
 
-    [self appendScreenCharArrayAtCursor:buffer
-                                 length:len
-                             shouldFree:NO];
-    STOPWATCH_LAP(appendAsciiDataAtCursor);
+- (int)executeScrollingOutputTokens:(const CVector *)vector
+                              start:(int)start
+                         retryIndex:(int *)retryIndex {
+    *retryIndex = start + 1;
+    if (![self canExecuteScrollingOutputTokens]) {
+        return 0;
+    }
+
+    // Find the whole lines and how many rows they take up. A line that exactly fills the width
+    // leaves the cursor in the right margin instead of wrapping, so it takes one row.
+    const int width = currentGrid_.size.width;
+    const int height = currentGrid_.size.height;
+    const int count = CVectorCount(vector);
+    int end = start;
+    int rows = 0;
+    int lineLength = 0;
+    BOOL sawCarriageReturn = NO;
+    int i;
+    for (i = start; i < count; i++) {
+        VT100Token *token = CVectorGetObject(vector, i);
+        if (token->type == VT100_ASCIISTRING) {
+            if (sawCarriageReturn && lineLength > 0) {
+                // Overwrites the start of the line.
+                break;
+            }
+            lineLength += token.asciiData->length;
+        } else if (token->type == VT100CC_CR) {
+            sawCarriageReturn = YES;
+        } else if (token->type == VT100CC_LF) {
+            if (lineLength > 0 && !sawCarriageReturn) {
+                // The next line would not start in the first column.
+                break;
+            }
+            rows += MAX(1, (lineLength + width - 1) / width);
+            lineLength = 0;
+            sawCarriageReturn = NO;
+            end = i + 1;
+        } else {
+            break;
+        }
+    }
+    if (rows < height) {
+        // Part of the output would still be on screen, so there's nothing to skip.
+        *retryIndex = i;
+        return 0;
+    }
+
+    // Everything on screen now, including the cursor's line, scrolls off. Only the last
+    // screenful of output stays, with an empty line for the cursor.
+    STOPWATCH_START(executeScrollingOutputTokens);
+    DLog(@"Append %d rows of scrolling output from %d tokens directly to the line buffer", rows, end - start);
+    [currentGrid_ appendLinesAboveCursorToLineBuffer:linebuffer_];
+
+    screen_char_t continuation = [currentGrid_ defaultChar];
+    continuation.code = EOL_HARD;
+    const NSTimeInterval now = [NSDate timeIntervalSinceReferenceDate];
+    screen_char_t *pending = NULL;
+    int pendingLength = 0;
+    for (i = start; i < end; i++) {
+        VT100Token *token = CVectorGetObject(vector, i);
+        switch (token->type) {
+            case VT100_ASCIISTRING: {
+                AsciiData *asciiData = token.asciiData;
+                if (asciiData->length > 0) {
+                    if (pending) {
+                        [linebuffer_ appendLine:pending
+                                         length:pendingLength
+                                        partial:YES
+                                          width:width
+                                      timestamp:now
+                                   continuation:continuation];
+                    }
+                    pending = [self screenCharsForAsciiData:asciiData];
+                    pendingLength = asciiData->length;
+                    _lastCharacter = pending[pendingLength - 1];
+                    _lastCharacterIsDoubleWidth = NO;
+                }
+                [delegate_ screenDidAppendAsciiDataToCurrentLine:asciiData];
+                break;
+            }
+            case VT100CC_CR:
+                [delegate_ screenTriggerableChangeDidOccur];
+                break;
+            case VT100CC_LF:
+                [linebuffer_ appendLine:pending ?: &continuation
+                                 length:pendingLength
+                                partial:NO
+                                  width:width
+                              timestamp:now
+                           continuation:continuation];
+                pending = NULL;
+                pendingLength = 0;
+                [delegate_ screenTriggerableChangeDidOccur];
+                [delegate_ screenDidReceiveLineFeed];
+                break;
+            default:
+                assert(NO);
+        }
+    }
+
+    // The cursor's line, as the last linefeed left it.
+    [linebuffer_ appendLine:&continuation
+                     length:0
+                    partial:NO
+                      width:width
+                  timestamp:now
+               continuation:continuation];
+    [currentGrid_ restoreScreenFromLineBuffer:linebuffer_
+                              withDefaultChar:[currentGrid_ defaultChar]
+                            maxLinesToRestore:height
+                                restoreCursor:NO];
+    currentGrid_.haveScrolled = YES;
+    [currentGrid_ markAllCharsDirty:YES];
+    if (!unlimitedScrollback_) {
+        [self incrementOverflowBy:[linebuffer_ dropExcessLinesWithWidth:width]];
+    }
+    STOPWATCH_LAP(executeScrollingOutputTokens);
+    return end - start;
+}
+
+#pragma mark - Attributed Runs
+
+- (int)executeAttributedRunTokens:(const CVector *)vector
+                            start:(int)start
+                       retryIndex:(int *)retryIndex {
+    *retryIndex = start + 1;
+    if (collectInputForPrinting_ ||
+        terminal_.receivingFile ||
+        terminal_.copyingToPasteboard ||
+        [delegate_ screenIsAppendingToPasteboard]) {
+        return 0;
+    }
+
+    const int count = CVectorCount(vector);
+    int end;
+    int strings = 0;
+    int length = 0;
+    for (end = start; end < count; end++) {
+        VT100Token *token = CVectorGetObject(vector, end);
+        if (token->type == VT100_ASCIISTRING) {
+            strings++;
+            length += token.asciiData->length;
+        } else if (token->type != VT100CSI_SGR) {
+            break;
+        }
+    }
+    if (strings < 2 || length == 0) {
+        // No shorter run within this one can do better.
+        *retryIndex = end;
+        return 0;
+    }
+
+    // Color each run of text with the rendition in effect for it, then append them all at once.
+    // Appending a concatenation is the same as appending the pieces one after another.
+    STOPWATCH_START(executeAttributedRunTokens);
+    screen_char_t *run = iTermMalloc(length * sizeof(screen_char_t));
+    int offset = 0;
+    for (int i = start; i < end; i++) {
+        VT100Token *token = CVectorGetObject(vector, i);
+        if (token->type == VT100CSI_SGR) {
+            [terminal_ executeToken:token];
+        } else if (token.asciiData->length > 0) {
+            AsciiData *asciiData = token.asciiData;
+            memcpy(run + offset,
+                   [self screenCharsForAsciiData:asciiData],
+                   asciiData->length * sizeof(screen_char_t));
+            offset += asciiData->length;
+        }
+    }
+    [self appendScreenCharArrayAtCursor:run length:length shouldFree:YES];
+    for (int i = start; i < end; i++) {
+        VT100Token *token = CVectorGetObject(vector, i);
+        if (token->type == VT100_ASCIISTRING) {
+            [delegate_ screenDidAppendAsciiDataToCurrentLine:token.asciiData];
+        }
+    }
+    STOPWATCH_LAP(executeAttributedRunTokens);
+    return end - start;
 }
 
 - (void)appendStringAtCursor:(NSString *)string {
@@ -1733,17 +1993,25 @@ basedAtAbsoluteLineNumber:(long long)absoluteLineNumber
     [currentGrid_ setContentsFromDVRFrame:s info:info];
     [self resetScrollbackOverflow];
     savedFindContextAbsPos_ = 0;
+    tailFindEndAbsPos_ = 0;
     [delegate_ screenRemoveSelection];
     [delegate_ screenNeedsRedraw];
     [currentGrid_ markAllCharsDirty:YES];
 }
 
 - (void)storeLastPositionInLineBufferAsFindContextSavedPosition {
+    if ([iTermAdvancedSettingsModel incrementalFindOnPage]) {
+        // Text appended while the tail find ran may lie behind where it already searched, so only
+        // advance as far as the end of the line buffer when it began.
+        savedFindContextAbsPos_ = tailFindEndAbsPos_;
+        return;
+    }
     savedFindContextAbsPos_ = [[linebuffer_ lastPosition] absolutePosition];
 }
 
 - (void)restoreSavedPositionToFindContext:(FindContext *)context
 {
+    tailFindEndAbsPos_ = [[linebuffer_ lastPosition] absolutePosition];
     int linesPushed;
     linesPushed = [currentGrid_ appendLines:[currentGrid_ numberOfLinesUsed]
                                toLineBuffer:linebuffer_];
@@ -2435,6 +2703,10 @@ basedAtAbsoluteLineNumber:(long long)absoluteLineNumber
 
 - (void)removeInaccessibleNotes {
     long long lastDeadLocation = [self totalScrollbackOverflow] * (self.width + 1);
+    if (lastDeadLocation > 0 && [iTermAdvancedSettingsModel bulkRemoveScrolledOffMarks]) {
+        [self removeObjectsFromIntervalTreeWithLimitAtMost:lastDeadLocation];
+        return;
+    }
     if (lastDeadLocation > 0) {
         Interval *deadInterval = [Interval intervalWithLocation:0 length:lastDeadLocation + 1];
         for (id<IntervalTreeObject> obj in [intervalTree_ objectsInInterval:deadInterval]) {
@@ -2445,6 +2717,37 @@ basedAtAbsoluteLineNumber:(long long)absoluteLineNumber
     }
 }
 
+// Like calling removeObjectFromIntervalTree: for each object that ends by |limit|, but with a
+// single traversal and a single notification.
+- (void)removeObjectsFromIntervalTreeWithLimitAtMost:(long long)limit {
+    const long long totalScrollbackOverflow = [self totalScrollbackOverflow];
+    const NSInteger numberOfTypes = (NSInteger)iTermIntervalTreeObjectTypeUnknown;
+    NSMutableArray<NSMutableIndexSet *> *linesByType = [NSMutableArray arrayWithCapacity:numberOfTypes];
+    for (NSInteger i = 0; i < numberOfTypes; i++) {
+        [linesByType addObject:[NSMutableIndexSet indexSet]];
+    }
+    __block BOOL removedAny = NO;
+    __block BOOL removedMark = NO;
+    [intervalTree_ removeObjectsWithLimitAtMost:limit block:^(id<IntervalTreeObject> obj) {
+        removedAny = YES;
+        VT100GridCoordRange range = [self coordRangeForInterval:obj.entry.interval];
+        if ([obj isKindOfClass:[VT100ScreenMark class]]) {
+            [markCache_ removeObjectForKey:@(totalScrollbackOverflow + range.end.y)];
+            removedMark = YES;
+        }
+        iTermIntervalTreeObjectType type = [self intervalTreeObserverTypeForObject:obj];
+        if (type != iTermIntervalTreeObjectTypeUnknown) {
+            [linesByType[type] addIndex:range.start.y + totalScrollbackOverflow];
+        }
+    }];
+    if (removedMark) {
+        self.lastCommandMark = nil;
+    }
+    if (removedAny) {
+        [_intervalTreeObserver intervalTreeDidRemoveObjectsOnLines:linesByType];
+    }
+}
+
 - (void)removeObjectFromIntervalTree:(id<IntervalTreeObject>)obj {
     long long totalScrollbackOverflow = [self totalScrollbackOverflow];
     if ([obj isKindOfClass:[VT100ScreenMark class]]) {
@@ -2514,8 +2817,7 @@ basedAtAbsoluteLineNumber:(long long)absoluteLineNumber
                                                                                  line,
                                                                                  0,
                                                                                  line + 1)];
-    NSArray *objects = [intervalTree_ objectsInInterval:interval];
-    for (id<IntervalTreeObject> note in objects) {
+    [intervalTree_ enumerateObjectsInInterval:interval block:^(id<IntervalTreeObject> note, BOOL *stop) {
         if ([note isKindOfClass:[PTYNoteViewController class]]) {
             VT100GridCoordRange range = [self coordRangeForInterval:note.entry.interval];
             VT100GridRange gridRange;
@@ -2531,19 +2833,18 @@ basedAtAbsoluteLineNumber:(long long)absoluteLineNumber
             }
             [result addObject:[NSValue valueWithGridRange:gridRange]];
         }
-    }
+    }];
     return result;
 }
 
 - (NSArray *)notesInRange:(VT100GridCoordRange)range {
     Interval *interval = [self intervalForGridCoordRange:range];
-    NSArray *objects = [intervalTree_ objectsInInterval:interval];
     NSMutableArray *notes = [NSMutableArray array];
-    for (id<IntervalTreeObject> o in objects) {
+    [intervalTree_ enumerateObjectsInInterval:interval block:^(id<IntervalTreeObject> o, BOOL *stop) {
         if ([o isKindOfClass:[PTYNoteViewController class]]) {
             [notes addObject:o];
         }
-    }
+    }];
     return notes;
 }
 
@@ -2606,6 +2907,37 @@ basedAtAbsoluteLineNumber:(long long)absoluteLineNumber
     }
 }
 
+- (NSDictionary<NSString *, NSNumber *> *)memoryUsage {
+    NSInteger marks = 0;
+    NSInteger images = 0;
+    NSMutableSet<NSNumber *> *imageCodes = [NSMutableSet set];
+    IntervalTree *trees[] = { intervalTree_, savedIntervalTree_ };
+    for (int i = 0; i < 2; i++) {
+        for (id<IntervalTreeObject> object in [trees[i] allObjects]) {
+            marks += class_getInstanceSize(object_getClass(object));
+            iTermImageMark *imageMark = [iTermImageMark castFrom:object];
+            if (imageMark.imageCode && ![imageCodes containsObject:imageMark.imageCode]) {
+                [imageCodes addObject:imageMark.imageCode];
+                iTermImageInfo *info = GetImageInfo(imageMark.imageCode.unsignedShortValue);
+                images += info.data.length + info.decodedByteCount;
+            }
+        }
+    }
+    return @{ @"scrollback": @([linebuffer_ memoryUsage]),
+              @"grid": @(primaryGrid_.memoryUsage + altGrid_.memoryUsage),
+              @"dvr": @([dvr_ memoryUsage]),
+              @"marks": @(marks),
+              @"images": @(images) };
+}
+
+- (NSInteger)discardInstantReplayHistory {
+    return [dvr_ discardHistory];
+}
+
+- (NSInteger)compressScrollbackExceptNewestBlocks:(NSUInteger)blocks {
+    return [linebuffer_ compressBlocksExceptNewest:blocks];
+}
+
 - (void)enumeratePromptsFrom:(NSString *)maybeFirst
                           to:(NSString *)maybeLast
                        block:(void (^ NS_NOESCAPE)(VT100ScreenMark *mark))block {
@@ -5446,6 +5778,11 @@ static void SwapInt(int *a, int *b) {
     [_intervalTreeObserver intervalTreeVisibleRangeDidChange];
 }
 
+- (void)setUnlimitedScrollback:(BOOL)unlimitedScrollback {
+    unlimitedScrollback_ = unlimitedScrollback;
+    linebuffer_.spillsToDisk = unlimitedScrollback;
+}
+
 // sets scrollback lines.
 - (void)setMaxScrollbackLines:(unsigned int)lines {
     maxScrollbackLines_ = lines;
@@ -5937,6 +6274,14 @@ static void SwapInt(int *a, int *b) {
     }
 }
 
++ (void)prefetchContentsOfDictionary:(NSDictionary *)dictionary {
+    // See -restoreFromDictionary:… for the two formats.
+    NSDictionary *lineBufferDictionary = dictionary[@"PrimaryGrid"] ? dictionary[@"LineBuffer"] : dictionary;
+    if ([lineBufferDictionary isKindOfClass:[NSDictionary class]]) {
+        [iTermLineBufferPrefetcher prefetchLineBufferWithDictionary:lineBufferDictionary];
+    }
+}
+
 - (void)restoreFromDictionary:(NSDictionary *)dictionary
      includeRestorationBanner:(BOOL)includeRestorationBanner
                 knownTriggers:(NSArray *)triggers
@@ -5955,13 +6300,14 @@ static void SwapInt(int *a, int *b) {
 
     const BOOL newFormat = (dictionary[@"PrimaryGrid"] != nil);
     if (!newFormat) {
-        LineBuffer *lineBuffer = [[LineBuffer alloc] initWithDictionary:dictionary];
+        LineBuffer *lineBuffer = [[iTermLineBufferPrefetcher lineBufferWithDictionary:dictionary] retain];
         [lineBuffer setMaxLines:maxScrollbackLines_ + self.height];
         if (!unlimitedScrollback_) {
             [lineBuffer dropExcessLinesWithWidth:self.width];
         }
         [linebuffer_ release];
         linebuffer_ = lineBuffer;
+        linebuffer_.spillsToDisk = unlimitedScrollback_;
         int maxLinesToRestore;
         if ([iTermAdvancedSettingsModel runJobsInServers] && reattached) {
             maxLinesToRestore = currentGrid_.size.height;
@@ -6029,13 +6375,14 @@ static void SwapInt(int *a, int *b) {
             currentGrid_ = altGrid_;
         }
 
-        LineBuffer *lineBuffer = [[LineBuffer alloc] initWithDictionary:dictionary[@"LineBuffer"]];
+        LineBuffer *lineBuffer = [[iTermLineBufferPrefetcher lineBufferWithDictionary:dictionary[@"LineBuffer"]] retain];
         [lineBuffer setMaxLines:maxScrollbackLines_ + self.height];
         if (!unlimitedScrollback_) {
             [lineBuffer dropExcessLinesWithWidth:self.width];
         }
         [linebuffer_ release];
         linebuffer_ = lineBuffer;
+        linebuffer_.spillsToDisk = unlimitedScrollback_;
     }
     BOOL addedBanner = NO;
     if (includeRestorationBanner && [iTermAdvancedSettingsModel showSessionRestoredBanner]) {
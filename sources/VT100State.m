@@ -6,7 +6,8 @@
 @end
 
 @implementation VT100State {
-    NSMutableDictionary *_transitions;
+    // Indexed by character. Retained.
+    VT100StateTransition *_transitions[256];
 }
 
 + (instancetype)stateWithName:(NSString *)name identifier:(NSObject *)identifier {
@@ -19,14 +20,15 @@
     self = [super init];
     if (self) {
         _name = [name copy];
-        _transitions = [[NSMutableDictionary alloc] init];
     }
     return self;
 }
 
 - (void)dealloc {
     [_name release];
-    [_transitions release];
+    for (int i = 0; i < 256; i++) {
+        [_transitions[i] release];
+    }
     [_identifier release];
     [_entryAction release];
     [_exitAction release];
@@ -40,7 +42,8 @@
 - (void)addStateTransitionForCharacter:(unsigned char)character
                                     to:(VT100State *)state
                             withAction:(VT100StateAction)action {
-    _transitions[@(character)] = [VT100StateTransition transitionToState:state withAction:action];
+    [_transitions[character] release];
+    _transitions[character] = [[VT100StateTransition transitionToState:state withAction:action] retain];
 }
 
 - (void)addStateTransitionForCharacterRange:(NSRange)characterRange
@@ -54,7 +57,7 @@
 }
 
 - (VT100StateTransition *)stateTransitionForCharacter:(unsigned char)character {
-    return _transitions[@(character)];
+    return _transitions[character];
 }
 
 @end
@@ -12,6 +12,46 @@
 #import "NSStringITerm.h"
 #import "ScreenChar.h"
 
+#if defined(__ARM_NEON)
+#include <arm_neon.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+// Returns the number of leading bytes in [p, p+len) that are printable ASCII (0x20 through 0x7f).
+// This examines 16 bytes at a time. Most output is long runs of printable ASCII, so it usually
+// gets through a whole read in a handful of iterations.
+static inline int iTermPrintableASCIIPrefixLength(const unsigned char *p, int len) {
+    int i = 0;
+#if defined(__ARM_NEON)
+    // As signed bytes, 0x80...0xff are negative, so printable is exactly "greater than 0x1f".
+    const int8x16_t threshold = vdupq_n_s8(0x1f);
+    while (i + 16 <= len) {
+        const uint8x16_t printable = vcgtq_s8(vreinterpretq_s8_u8(vld1q_u8(p + i)), threshold);
+        if (vminvq_u8(printable) != 0xff) {
+            // Narrow to four bits per byte and find the first byte that isn't printable.
+            const uint64_t nibbles = vget_lane_u64(vreinterpret_u64_u8(vshrn_n_u16(vreinterpretq_u16_u8(printable), 4)), 0);
+            return i + (__builtin_ctzll(~nibbles) >> 2);
+        }
+        i += 16;
+    }
+#elif defined(__SSE2__)
+    const __m128i threshold = _mm_set1_epi8(0x1f);
+    while (i + 16 <= len) {
+        const __m128i bytes = _mm_loadu_si128((const __m128i *)(p + i));
+        const int mask = _mm_movemask_epi8(_mm_cmpgt_epi8(bytes, threshold));
+        if (mask != 0xffff) {
+            return i + __builtin_ctz(~mask);
+        }
+        i += 16;
+    }
+#endif
+    while (i < len && p[i] >= 0x20 && p[i] <= 0x7f) {
+        i++;
+    }
+    return i;
+}
+
 static void DecodeUTF8Bytes(unsigned char *datap,
                             int datalen,
                             int *rmlen,
@@ -284,22 +324,13 @@ static void DecodeASCIIBytes(unsigned char *datap,
                              int datalen,
                              int *rmlen,
                              VT100Token *token) {
-    unsigned char *p = datap;
-    int len = datalen;
-
     // I tried the ideas mentioned here:
     // http://stackoverflow.com/questions/22218605/is-this-function-a-good-candidate-for-simd-on-intel
     // (using 8-bytes-at-a-time bit twiddling and SIMD)
     // and although this while loop completed faster, the overall benchmark speed on spam.cc did
-    // not improve.
-    while (len > 0) {
-        if (*p >= 0x20 && *p <= 0x7f) {
-            p++;
-            len--;
-        } else {
-            break;
-        }
-    }
+    // not improve. That was before the rest of the parser got faster; it now shows up in profiles
+    // of log-heavy sessions, so the scan is vectorized.
+    const int len = datalen - iTermPrintableASCIIPrefixLength(datap, datalen);
     if (len == datalen) {
         *rmlen = 0;
         token->type = VT100_WAIT;
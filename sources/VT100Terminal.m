@@ -1420,7 +1420,7 @@ static const int kMaxScreenRows = 4096;
     if (token->type == DCS_TMUX_HOOK) {
         [delegate_ terminalStartTmuxModeWithDCSIdentifier:token.string];
         return;
-    } else if (token->type == TMUX_EXIT || token->type == TMUX_LINE) {
+    } else if (token->type == TMUX_EXIT || token->type == TMUX_LINE || token->type == TMUX_OUTPUT) {
         [delegate_ terminalHandleTmuxInput:token];
         return;
     }
@@ -8,8 +8,75 @@
 
 #import "VT100TmuxParser.h"
 #import "DebugLogging.h"
+#import "iTermAdvancedSettingsModel.h"
 #import "NSMutableData+iTerm.h"
 
+// Returns the index of the first byte at or after |i| that is a backslash or a control character,
+// or |length| if there is none. Looks at eight bytes at a time since tmux output is mostly
+// printable text.
+static int VT100TmuxParserIndexOfSpecialByte(const unsigned char *bytes, int i, int length) {
+    const uint64_t ones = 0x0101010101010101ULL;
+    const uint64_t highs = 0x8080808080808080ULL;
+    const uint64_t backslashes = ones * '\\';
+    for (; i + 8 <= length; i += 8) {
+        uint64_t word;
+        memcpy(&word, bytes + i, sizeof(word));
+        const uint64_t x = word ^ backslashes;
+        const uint64_t hasBackslash = (x - ones) & ~x & highs;
+        const uint64_t hasControl = (word - ones * ' ') & ~word & highs;
+        if (hasBackslash | hasControl) {
+            break;
+        }
+    }
+    for (; i < length; i++) {
+        if (bytes[i] == '\\' || bytes[i] < ' ') {
+            return i;
+        }
+    }
+    return length;
+}
+
+// Decodes the payload of %output the same way as -[TmuxGateway decodeEscapedOutput:] but without
+// needing a copy of the line: runs of plain bytes are appended at once, control characters
+// (such as the \r the line driver adds) are dropped, and \ooo becomes one byte.
+static NSData *VT100TmuxParserDecodeOutput(const unsigned char *bytes, int length) {
+    NSMutableData *data = [NSMutableData dataWithCapacity:length];
+    int i = 0;
+    while (i < length) {
+        const int special = VT100TmuxParserIndexOfSpecialByte(bytes, i, length);
+        if (special > i) {
+            [data appendBytes:bytes + i length:special - i];
+        }
+        i = special;
+        if (i == length) {
+            break;
+        }
+        if (bytes[i] != '\\') {
+            i++;
+            continue;
+        }
+        i++;
+        // Read exactly three octal digits, or else produce '?'.
+        unsigned char c = 0;
+        int digits = 0;
+        while (digits < 3) {
+            if (i < length && bytes[i] == '\r') {
+                i++;
+                continue;
+            }
+            if (i == length || bytes[i] < '0' || bytes[i] > '7') {
+                c = '?';
+                break;
+            }
+            c = c * 8 + (bytes[i] - '0');
+            digits++;
+            i++;
+        }
+        [data appendBytes:&c length:1];
+    }
+    return data;
+}
+
 @interface VT100TmuxParser ()
 @property(nonatomic, retain) NSString *currentCommandId;
 @property(nonatomic, retain) NSString *currentCommandNumber;
@@ -19,6 +86,7 @@
     BOOL _inResponseBlock;
     BOOL _recoveryMode;
     NSMutableData *_line;
+    BOOL _decodesOutput;
 }
 
 - (instancetype)initInRecoveryMode {
@@ -40,6 +108,7 @@
     self = [super init];
     if (self) {
         _line = [[NSMutableData alloc] init];
+        _decodesOutput = [iTermAdvancedSettingsModel decodeTmuxOutputInParser];
     }
     return self;
 }
@@ -61,6 +130,12 @@ support8BitControlCharacters:(BOOL)support8BitControlCharacters
             excludingCharacter:'\r'];
         iTermParserAdvanceMultiple(context, length);
         result->type = VT100_WAIT;
+    } else if (_line.length == 0 &&
+               [self parseOutputLine:iTermParserPeekRawBytes(context, bytesTilNewline)
+                              length:bytesTilNewline
+                               token:result]) {
+        // The whole line was available so it was decoded where it sits.
+        iTermParserAdvanceMultiple(context, bytesTilNewline + 1);
     } else {
         // Append bytes up to the newline, stripping out linefeeds. Consume the newline.
         [_line appendBytes:iTermParserPeekRawBytes(context, bytesTilNewline)
@@ -76,8 +151,48 @@ support8BitControlCharacters:(BOOL)support8BitControlCharacters
     return NO;
 }
 
+// %output is by far the most common line and the only one whose payload can be large. Rather
+// than making a string of the line for TmuxGateway to parse, find the pane and decode the payload
+// here. Returns NO if this isn't a well-formed %output notification, in which case the line should
+// take the normal path.
+- (BOOL)parseOutputLine:(const unsigned char *)bytes length:(int)length token:(VT100Token *)result {
+    if (!_decodesOutput || _recoveryMode || _inResponseBlock) {
+        return NO;
+    }
+    static const char prefix[] = "%output %";
+    const int prefixLength = sizeof(prefix) - 1;
+    if (length <= prefixLength || memcmp(bytes, prefix, prefixLength)) {
+        return NO;
+    }
+    int i = prefixLength;
+    int pane = 0;
+    const int start = i;
+    while (i < length && bytes[i] >= '0' && bytes[i] <= '9') {
+        if (pane > (INT_MAX - 9) / 10) {
+            return NO;
+        }
+        pane = pane * 10 + (bytes[i] - '0');
+        i++;
+    }
+    if (i == start || i == length || bytes[i] != ' ') {
+        return NO;
+    }
+    i++;
+
+    result->type = TMUX_OUTPUT;
+    result.savedData = VT100TmuxParserDecodeOutput(bytes + i, length - i);
+    result.string = nil;
+    result.csi->p[0] = pane;
+    result.csi->count = 1;
+    return YES;
+}
+
 // Return YES if we should unhook.
 - (BOOL)processLineIntoToken:(VT100Token *)result {
+    if ([self parseOutputLine:_line.bytes length:_line.length token:result]) {
+        [_line setLength:0];
+        return NO;
+    }
     result.savedData = [[_line copy] autorelease];
     NSString *command =
         [[[NSString alloc] initWithData:_line encoding:NSUTF8StringEncoding] autorelease];
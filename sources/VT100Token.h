@@ -207,6 +207,7 @@ typedef enum {
 
     TMUX_LINE,  // A line of input from tmux
     TMUX_EXIT,  // Exit tmux mode
+    TMUX_OUTPUT,  // %output from tmux. The decoded payload is in savedData and the pane is csi->p[0].
 
     // Ambiguous codes - disambiguated at execution time.
     VT100CSI_DECSLRM_OR_ANSICSI_SCP,
@@ -273,6 +274,14 @@ typedef struct {
 + (instancetype)token;
 + (instancetype)newTokenForControlCharacter:(unsigned char)controlCharacter;
 
+// Returns a token with a retain count of 1. It comes from a pool of recycled tokens when one is
+// available, which avoids allocating a new object and its buffers.
++ (instancetype)newToken;
+
+// Use instead of -release to give up your reference. If it was the last reference, the token is
+// reset and returned to the pool for +newToken to reuse. Safe to call on any thread.
+- (void)recycle;
+
 - (void)setAsciiBytes:(char *)bytes length:(int)length;
 
 // Returns a string for |asciiData|, for convenience (this is slow).
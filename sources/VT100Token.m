@@ -12,8 +12,18 @@
 #import "iTermAdvancedSettingsModel.h"
 #import "iTermMalloc.h"
 
+#include <os/lock.h>
 #include <stdlib.h>
 
+// Tokens are created on the TaskNotifier thread and freed on a background queue after the main
+// thread executes them. At high throughput that was millions of object allocations per second, so
+// tokens whose last reference goes away get reset and kept in this free list instead. It's bounded
+// so a burst of output doesn't pin memory forever.
+static const int VT100TokenPoolCapacity = 2048;
+static VT100Token *sTokenPool[VT100TokenPoolCapacity];
+static int sTokenPoolCount;
+static os_unfair_lock sTokenPoolLock = OS_UNFAIR_LOCK_INIT;
+
 @interface VT100Token ()
 @property(nonatomic, readwrite) CSIParam *csi;
 @end
@@ -28,11 +38,78 @@
 }
 
 + (instancetype)newTokenForControlCharacter:(unsigned char)controlCharacter {
-    VT100Token *token = [[VT100Token alloc] init];
+    VT100Token *token = [VT100Token newToken];
     token->type = controlCharacter;
     return token;
 }
 
++ (instancetype)newToken {
+    VT100Token *token = nil;
+    os_unfair_lock_lock(&sTokenPoolLock);
+    if (sTokenPoolCount > 0) {
+        token = sTokenPool[--sTokenPoolCount];
+        sTokenPool[sTokenPoolCount] = nil;
+    }
+    os_unfair_lock_unlock(&sTokenPoolLock);
+    if (token) {
+        return token;
+    }
+    return [[VT100Token alloc] init];
+}
+
+- (void)recycle {
+    if (self.retainCount != 1) {
+        // Someone else (e.g., a queue of tokens for a paused session) still holds a reference.
+        [self release];
+        return;
+    }
+    [self prepareForReuse];
+
+    BOOL pooled = NO;
+    os_unfair_lock_lock(&sTokenPoolLock);
+    if (sTokenPoolCount < VT100TokenPoolCapacity) {
+        sTokenPool[sTokenPoolCount++] = self;
+        pooled = YES;
+    }
+    os_unfair_lock_unlock(&sTokenPoolLock);
+    if (!pooled) {
+        [self release];
+    }
+}
+
+// Returns the token to the state it had right after -init, but keeps the CSI parameter buffer.
+- (void)prepareForReuse {
+    type = 0;
+    savingData = NO;
+    code = 0;
+
+    [_string release];
+    _string = nil;
+    [_kvpKey release];
+    _kvpKey = nil;
+    [_kvpValue release];
+    _kvpValue = nil;
+    [_savedData release];
+    _savedData = nil;
+
+    if (_csi) {
+        memset(_csi, 0, sizeof(*_csi));
+    }
+
+    if (_asciiData.buffer != _asciiData.staticBuffer) {
+        free(_asciiData.buffer);
+    }
+    if (_asciiData.screenChars &&
+        _asciiData.screenChars->buffer != _asciiData.screenChars->staticBuffer) {
+        free(_asciiData.screenChars->buffer);
+    }
+    _asciiData.buffer = NULL;
+    _asciiData.length = 0;
+    _asciiData.screenChars = NULL;
+    _screenChars.buffer = NULL;
+    _screenChars.length = 0;
+}
+
 - (void)dealloc {
     if (_csi) {
         free(_csi);
@@ -201,6 +278,7 @@
                           @(DCS_TMUX_HOOK):                   @"DCS_TMUX_HOOK",
                           @(TMUX_LINE):                       @"TMUX_LINE",
                           @(TMUX_EXIT):                       @"TMUX_EXIT",
+                          @(TMUX_OUTPUT):                     @"TMUX_OUTPUT",
                           @(DCS_TMUX_CODE_WRAP):              @"DCS_TMUX_CODE_WRAP",
                           @(VT100CSI_DECSLRM_OR_ANSICSI_SCP): @"VT100CSI_DECSLRM_OR_ANSICSI_SCP",
                           @(DCS_REQUEST_TERMCAP_TERMINFO):    @"DCS_REQUEST_TERMCAP_TERMINFO",
@@ -319,6 +319,9 @@
 // Toggles broadcasting to a single session.
 - (void)toggleBroadcastingInputToSession:(PTYSession *)session;
 
+// Sessions that receive broadcast input.
+- (NSArray<PTYSession *> *)broadcastSessions;
+
 // Call writeTask: for each session's shell with the given data.
 - (void)sendInputToAllSessions:(NSString *)string
                       encoding:(NSStringEncoding)optionalEncoding
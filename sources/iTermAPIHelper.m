@@ -10,14 +10,19 @@
 #import "CVector.h"
 #import "DebugLogging.h"
 #import "iTermAdvancedSettingsModel.h"
+#import "iTermAPIVariableChangeFilter.h"
 #import "iTermBuriedSessions.h"
 #import "iTermBuiltInFunctions.h"
 #import "iTermColorPresets.h"
 #import "iTermController.h"
+#import "iTermCPUUtilization.h"
 #import "iTermDisclosableView.h"
 #import "iTermLSOF.h"
 #import "iTermMalloc.h"
+#import "iTermMemoryUtilization.h"
+#import "iTermNetworkUtilization.h"
 #import "iTermObject.h"
+#import "iTermPerformanceCounters.h"
 #import "iTermPreferences.h"
 #import "iTermProfileModelJournal.h"
 #import "iTermProfilePreferences.h"
@@ -28,6 +33,7 @@
 #import "iTermSessionLauncher.h"
 #import "iTermStatusBarComponent.h"
 #import "iTermStatusBarViewController.h"
+#import "iTermSystemMetricsSampler.h"
 #import "iTermVariableReference.h"
 #import "iTermVariableScope+Global.h"
 #import "iTermWarning.h"
@@ -339,6 +345,10 @@ static BOOL iTermAPIHelperLastApplescriptAuthRequiredSetting;
     // WARNING: These can exist after the block has been removed from
     // _serverOriginatedRPCCompletionBlocks if it times out.
     NSMutableDictionary<NSString *, NSMutableSet<NSString *> *> *_outstandingRPCs;
+
+    // Subscribes to system metrics so they keep being sampled between requests for them.
+    id _systemMetricsSubscriber;
+    NSInteger _systemMetricsRequestGeneration;
 }
 
 + (instancetype)sharedInstance {
@@ -1563,15 +1573,31 @@ static BOOL iTermAPIHelperLastApplescriptAuthRequiredSetting;
                                                                         vendor:scope];
     __weak __typeof(ref) weakRef = ref;
     __weak __typeof(self) weakSelf = self;
-    ref.onChangeBlock = ^{
-        ITMNotification *notification = [weakSelf variableChangeNotificationWithScope:request.variableMonitorRequest.scope
-                                                                           identifier:identifier
-                                                                                 name:name
-                                                                             newValue:weakRef.value];
-        if (notification) {
-            [weakSelf postAPINotification:notification toConnectionKey:connectionKey];
-        }
-    };
+    if ([iTermAPIVariableChangeFilter requestNeedsFilter:request.variableMonitorRequest]) {
+        iTermAPIVariableChangeFilter *filter =
+            [[iTermAPIVariableChangeFilter alloc] initWithRequest:request.variableMonitorRequest
+                                                            block:^(NSString *jsonNewValue) {
+                ITMNotification *notification = [weakSelf variableChangeNotificationWithScope:request.variableMonitorRequest.scope
+                                                                                   identifier:identifier
+                                                                                         name:name
+                                                                                 jsonNewValue:jsonNewValue];
+                [weakSelf postAPINotification:notification toConnectionKey:connectionKey];
+            }];
+        // The reference owns the filter through its block, so unsubscribing releases both.
+        ref.onChangeBlock = ^{
+            [filter valueDidChange:weakRef.value];
+        };
+    } else {
+        ref.onChangeBlock = ^{
+            ITMNotification *notification = [weakSelf variableChangeNotificationWithScope:request.variableMonitorRequest.scope
+                                                                               identifier:identifier
+                                                                                     name:name
+                                                                                 newValue:weakRef.value];
+            if (notification) {
+                [weakSelf postAPINotification:notification toConnectionKey:connectionKey];
+            }
+        };
+    }
     [dict it_addObject:[iTermTuple tupleWithObject:request andObject:ref] toMutableArrayForKey:connectionKey];
 }
 
@@ -1598,6 +1624,10 @@ static BOOL iTermAPIHelperLastApplescriptAuthRequiredSetting;
         response.status = ITMNotificationResponse_Status_RequestMalformed;
         return response;
     }
+    if (request.subscribe && ![iTermAPIVariableChangeFilter requestIsValid:request.variableMonitorRequest]) {
+        response.status = ITMNotificationResponse_Status_RequestMalformed;
+        return response;
+    }
 
     // Handle the special case of (un)subscribing to "all" sessions.
     NSString *identifier = request.variableMonitorRequest.identifier;
@@ -1623,7 +1653,8 @@ static BOOL iTermAPIHelperLastApplescriptAuthRequiredSetting;
     const NSInteger index = [array indexOfObjectPassingTest:^BOOL(iTermTuple<ITMNotificationRequest *, iTermVariableReference *> * _Nonnull tuple,
                                                                   NSUInteger idx,
                                                                   BOOL * _Nonnull stop) {
-        return ([NSObject object:tuple.firstObject.variableMonitorRequest isEqualToObject:request.variableMonitorRequest]);
+        return [self variableMonitorRequest:tuple.firstObject.variableMonitorRequest
+                   identifiesSameVariableAs:request.variableMonitorRequest];
     }];
     if (request.subscribe) {
         if (array != nil && index != NSNotFound) {
@@ -1653,17 +1684,38 @@ static BOOL iTermAPIHelperLastApplescriptAuthRequiredSetting;
     }
 }
 
+// Coalescing and predicates don't distinguish subscriptions, so unsubscribing needn't repeat them.
+- (BOOL)variableMonitorRequest:(ITMVariableMonitorRequest *)lhs
+      identifiesSameVariableAs:(ITMVariableMonitorRequest *)rhs {
+    if (lhs == nil || rhs == nil) {
+        return lhs == rhs;
+    }
+    return ([NSObject object:lhs.name isEqualToObject:rhs.name] &&
+            lhs.scope == rhs.scope &&
+            [NSObject object:lhs.identifier isEqualToObject:rhs.identifier]);
+}
+
 - (ITMNotification *)variableChangeNotificationWithScope:(ITMVariableScope)scope
                                               identifier:(NSString *)identifier
                                                     name:(NSString *)variableName
                                                 newValue:(id)newValue {
+    return [self variableChangeNotificationWithScope:scope
+                                          identifier:identifier
+                                                name:variableName
+                                        jsonNewValue:[NSJSONSerialization it_jsonStringForObject:newValue]];
+}
+
+- (ITMNotification *)variableChangeNotificationWithScope:(ITMVariableScope)scope
+                                              identifier:(NSString *)identifier
+                                                    name:(NSString *)variableName
+                                            jsonNewValue:(NSString *)jsonNewValue {
     ITMNotification *notification = [[ITMNotification alloc] init];
     notification.variableChangedNotification.scope = scope;
     if (identifier != nil) {
         notification.variableChangedNotification.identifier = identifier;
     }
     notification.variableChangedNotification.name = variableName;
-    notification.variableChangedNotification.jsonNewValue = [NSJSONSerialization it_jsonStringForObject:newValue];
+    notification.variableChangedNotification.jsonNewValue = jsonNewValue;
     return notification;
 }
 
@@ -1788,7 +1840,8 @@ static BOOL iTermAPIHelperLastApplescriptAuthRequiredSetting;
     NSIndexSet *indexes = [array indexesOfObjectsPassingTest:^BOOL(iTermTuple<ITMNotificationRequest *, iTermVariableReference *> * _Nonnull tuple,
                                                                    NSUInteger idx,
                                                                    BOOL * _Nonnull stop) {
-        return ([NSObject object:tuple.firstObject.variableMonitorRequest isEqualToObject:request.variableMonitorRequest]);
+        return [self variableMonitorRequest:tuple.firstObject.variableMonitorRequest
+                   identifiesSameVariableAs:request.variableMonitorRequest];
     }];
 
     [indexes enumerateIndexesUsingBlock:^(NSUInteger index, BOOL * _Nonnull stop) {
@@ -1875,6 +1928,11 @@ static BOOL iTermAPIHelperLastApplescriptAuthRequiredSetting;
         requestToRemove.subscribe = YES;
         const NSInteger countBefore = subscriptions.count;
         [subscriptions removeObjectsPassingTest:^BOOL(iTermAllObjectsSubscription *sub) {
+            if (request.notificationType == ITMNotificationType_NotifyOnVariableChange) {
+                return (sub.request.notificationType == request.notificationType &&
+                        [self variableMonitorRequest:sub.request.variableMonitorRequest
+                            identifiesSameVariableAs:request.variableMonitorRequest]);
+            }
             return [NSObject object:sub.request isEqualToObject:requestToRemove];
         }];
         const NSInteger countAfter = subscriptions.count;
@@ -3929,6 +3987,76 @@ static BOOL iTermCheckSplitTreesIsomorphic(ITMSplitTreeNode *node1, ITMSplitTree
     completion(response);
 }
 
+- (void)apiServerGetSystemMetricsRequest:(ITMGetSystemMetricsRequest *)request
+                                 handler:(void (^)(ITMGetSystemMetricsResponse *))completion {
+    [self keepSamplingSystemMetrics];
+
+    ITMGetSystemMetricsResponse *response = [[ITMGetSystemMetricsResponse alloc] init];
+    if ([iTermSystemMetricsSampler enabled]) {
+        response.samplingInterval = [[iTermSystemMetricsSampler sharedInstance] cadence];
+    } else {
+        response.samplingInterval = [[iTermCPUUtilization sharedInstance] cadence];
+    }
+    for (NSNumber *sample in [[iTermCPUUtilization sharedInstance] samples]) {
+        [response.cpuUtilizationArray addValue:sample.doubleValue];
+    }
+    for (NSNumber *sample in [[iTermMemoryUtilization sharedInstance] samples]) {
+        [response.memoryUtilizationArray addValue:sample.doubleValue];
+    }
+    response.physicalMemory = [[iTermMemoryUtilization sharedInstance] availableMemory];
+    for (iTermNetworkUtilizationSample *sample in [[iTermNetworkUtilization sharedInstance] samples]) {
+        ITMGetSystemMetricsResponse_NetworkThroughput *throughput = [[ITMGetSystemMetricsResponse_NetworkThroughput alloc] init];
+        throughput.bytesPerSecondRead = sample.bytesPerSecondRead;
+        throughput.bytesPerSecondWrite = sample.bytesPerSecondWrite;
+        [response.networkThroughputArray addObject:throughput];
+    }
+    completion(response);
+}
+
+// Scripts poll for metrics, so keep sampling for a while after each request in order for the
+// next one to find a continuous history. Publishers hold their subscribers weakly, so releasing
+// the subscriber unsubscribes it.
+- (void)keepSamplingSystemMetrics {
+    if (!_systemMetricsSubscriber) {
+        DLog(@"Begin sampling system metrics for API clients");
+        _systemMetricsSubscriber = [[NSObject alloc] init];
+        [[iTermCPUUtilization sharedInstance] addSubscriber:_systemMetricsSubscriber block:^(double value) {}];
+        [[iTermMemoryUtilization sharedInstance] addSubscriber:_systemMetricsSubscriber block:^(double value) {}];
+        [[iTermNetworkUtilization sharedInstance] addSubscriber:_systemMetricsSubscriber
+                                                          block:^(double bytesPerSecondRead, double bytesPerSecondWrite) {}];
+    }
+    const NSInteger generation = ++_systemMetricsRequestGeneration;
+    __weak __typeof(self) weakSelf = self;
+    dispatch_after(dispatch_time(DISPATCH_TIME_NOW, (int64_t)(60 * NSEC_PER_SEC)), dispatch_get_main_queue(), ^{
+        [weakSelf stopSamplingSystemMetricsIfGeneration:generation];
+    });
+}
+
+- (void)stopSamplingSystemMetricsIfGeneration:(NSInteger)generation {
+    if (generation != _systemMetricsRequestGeneration) {
+        return;
+    }
+    DLog(@"Stop sampling system metrics for API clients");
+    _systemMetricsSubscriber = nil;
+}
+
+- (void)apiServerGetPerformanceCountersRequest:(ITMGetPerformanceCountersRequest *)request
+                                       handler:(void (^)(ITMGetPerformanceCountersResponse *))completion {
+    ITMGetPerformanceCountersResponse *response = [[ITMGetPerformanceCountersResponse alloc] init];
+    for (iTermPerformanceCounterSummary *summary in iTermPerformanceCountersSummarize()) {
+        ITMGetPerformanceCountersResponse_Counter *counter = [[ITMGetPerformanceCountersResponse_Counter alloc] init];
+        counter.name = summary.name;
+        counter.count = summary.count;
+        counter.totalTime = summary.totalTime;
+        counter.p50 = summary.p50;
+        counter.p90 = summary.p90;
+        counter.p99 = summary.p99;
+        counter.max = summary.max;
+        [response.countersArray addObject:counter];
+    }
+    completion(response);
+}
+
 - (void)invokeFunction:(NSString *)invocation inAppContextWithCompletion:(void (^)(ITMInvokeFunctionResponse *))completion timeout:(NSTimeInterval)timeout {
     [iTermScriptFunctionCall callFunction:invocation
                                   timeout:timeout >= 0 ? timeout : 30
@@ -0,0 +1,41 @@
+//
+//  iTermAPIResponseCache.h
+//  iTerm2SharedARC
+//
+//  Created by agent on 10/14/26.
+//
+
+#import <Foundation/Foundation.h>
+
+@class ITMClientOriginatedMessage;
+@class ITMServerOriginatedMessage;
+
+NS_ASSUME_NONNULL_BEGIN
+
+// Remembers responses to read-only API requests so a repeat of the same request can be answered
+// off the main thread. Every entry is discarded when +invalidate is called, which happens whenever
+// state a cacheable request could observe changes (terminal output, variables, window layout, and
+// any mutating API request). All methods are thread-safe.
+@interface iTermAPIResponseCache : NSObject
+
++ (instancetype)sharedInstance;
+
+// Cheap enough to call on every batch of tokens.
++ (void)invalidate;
+
++ (BOOL)canCacheResponseToRequest:(ITMClientOriginatedMessage *)request;
+
+// Read this before computing a response and pass it to -setResponse:forRequest:generation: so a
+// response computed while the cache was invalidated isn't saved.
+@property (nonatomic, readonly) uint64_t generation;
+
+- (void)setResponse:(ITMServerOriginatedMessage *)response
+         forRequest:(ITMClientOriginatedMessage *)request
+         generation:(uint64_t)generation;
+
+// Returns a response with the id of |request|, or nil on a miss.
+- (nullable ITMServerOriginatedMessage *)responseForRequest:(ITMClientOriginatedMessage *)request;
+
+@end
+
+NS_ASSUME_NONNULL_END
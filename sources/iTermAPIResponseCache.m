@@ -0,0 +1,150 @@
+//
+//  iTermAPIResponseCache.m
+//  iTerm2SharedARC
+//
+//  Created by agent on 10/14/26.
+//
+
+#import "iTermAPIResponseCache.h"
+
+#import "Api.pbobjc.h"
+#import "DebugLogging.h"
+#import "MovePaneController.h"
+#import "PseudoTerminal.h"
+#import "PTYSession.h"
+#import "PTYTab.h"
+#import "iTermBuriedSessions.h"
+
+#import <AppKit/AppKit.h>
+#import <os/lock.h>
+#import <stdatomic.h>
+
+static _Atomic uint64_t iTermAPIResponseCacheGeneration;
+
+// A script that asks about many different things would otherwise grow the cache without bound.
+static const NSUInteger iTermAPIResponseCacheMaximumEntries = 256;
+
+@implementation iTermAPIResponseCache {
+    os_unfair_lock _lock;
+    // Keys are requests serialized without their IDs. Guarded by _lock.
+    NSMutableDictionary<NSData *, ITMServerOriginatedMessage *> *_entries;
+    // The generation that _entries belong to. Guarded by _lock.
+    uint64_t _entriesGeneration;
+}
+
++ (instancetype)sharedInstance {
+    static id instance;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        instance = [[self alloc] init];
+    });
+    return instance;
+}
+
++ (void)invalidate {
+    atomic_fetch_add_explicit(&iTermAPIResponseCacheGeneration, 1, memory_order_release);
+}
+
++ (BOOL)canCacheResponseToRequest:(ITMClientOriginatedMessage *)request {
+    switch (request.submessageOneOfCase) {
+        case ITMClientOriginatedMessage_Submessage_OneOfCase_GetBufferRequest:
+        case ITMClientOriginatedMessage_Submessage_OneOfCase_ListSessionsRequest:
+            return YES;
+
+        case ITMClientOriginatedMessage_Submessage_OneOfCase_GetPropertyRequest:
+            // The first visible line changes on scroll, which doesn't invalidate the cache.
+            return ![request.getPropertyRequest.name isEqualToString:@"number_of_lines"];
+
+        case ITMClientOriginatedMessage_Submessage_OneOfCase_VariableRequest:
+            return request.variableRequest.setArray_Count == 0;
+
+        default:
+            return NO;
+    }
+}
+
+- (instancetype)init {
+    self = [super init];
+    if (self) {
+        _lock = OS_UNFAIR_LOCK_INIT;
+        _entries = [NSMutableDictionary dictionary];
+        NSArray<NSString *> *names = @[ NSWindowDidMoveNotification,
+                                        NSWindowDidResizeNotification,
+                                        NSWindowDidEnterFullScreenNotification,
+                                        NSWindowDidExitFullScreenNotification,
+                                        PTYSessionCreatedNotification,
+                                        iTermSessionWillTerminateNotification,
+                                        iTermSessionDidChangeTabNotification,
+                                        iTermSessionBuriedStateChangeTabNotification,
+                                        iTermTabDidChangeWindowNotification,
+                                        iTermTabDidChangePositionInWindowNotification,
+                                        iTermTabDidCloseNotification,
+                                        iTermDidCreateTerminalWindowNotification,
+                                        iTermWindowDidCloseNotification ];
+        for (NSString *name in names) {
+            [[NSNotificationCenter defaultCenter] addObserver:self
+                                                     selector:@selector(stateDidChange:)
+                                                         name:name
+                                                       object:nil];
+        }
+    }
+    return self;
+}
+
+- (uint64_t)generation {
+    return atomic_load_explicit(&iTermAPIResponseCacheGeneration, memory_order_acquire);
+}
+
+- (void)setResponse:(ITMServerOriginatedMessage *)response
+         forRequest:(ITMClientOriginatedMessage *)request
+         generation:(uint64_t)generation {
+    NSData *key = [self keyForRequest:request];
+    ITMServerOriginatedMessage *entry = [response copy];
+    os_unfair_lock_lock(&_lock);
+    [self discardStaleEntries];
+    if (generation == _entriesGeneration) {
+        if (_entries.count >= iTermAPIResponseCacheMaximumEntries) {
+            [_entries removeAllObjects];
+        }
+        _entries[key] = entry;
+    }
+    os_unfair_lock_unlock(&_lock);
+}
+
+- (ITMServerOriginatedMessage *)responseForRequest:(ITMClientOriginatedMessage *)request {
+    NSData *key = [self keyForRequest:request];
+    os_unfair_lock_lock(&_lock);
+    [self discardStaleEntries];
+    ITMServerOriginatedMessage *entry = _entries[key];
+    os_unfair_lock_unlock(&_lock);
+    if (!entry) {
+        return nil;
+    }
+    ITMServerOriginatedMessage *response = [entry copy];
+    response.id_p = request.id_p;
+    return response;
+}
+
+#pragma mark - Private
+
+// Must hold _lock.
+- (void)discardStaleEntries {
+    const uint64_t generation = self.generation;
+    if (generation == _entriesGeneration) {
+        return;
+    }
+    [_entries removeAllObjects];
+    _entriesGeneration = generation;
+}
+
+- (NSData *)keyForRequest:(ITMClientOriginatedMessage *)request {
+    ITMClientOriginatedMessage *copy = [request copy];
+    copy.hasId_p = NO;
+    return copy.data;
+}
+
+- (void)stateDidChange:(NSNotification *)notification {
+    [iTermAPIResponseCache invalidate];
+}
+
+@end
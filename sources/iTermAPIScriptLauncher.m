@@ -10,6 +10,7 @@
 #import "DebugLogging.h"
 #import "iTermAPIConnectionIdentifierController.h"
 #import "iTermAPIHelper.h"
+#import "iTermAdvancedSettingsModel.h"
 #import "iTermNotificationController.h"
 #import "iTermOpenDirectory.h"
 #import "iTermOptionalComponentDownloadWindowController.h"
@@ -28,6 +29,28 @@
 
 static NSString *const iTermAPIScriptLauncherScriptDidFailUserNotificationCallbackNotification = @"iTermAPIScriptLauncherScriptDidFailUserNotificationCallbackNotification";
 
+// Number of idle warm interpreters to keep for each Python version.
+static const NSUInteger iTermAPIScriptLauncherWarmInterpreterCount = 2;
+
+// Printed by a warm interpreter once it's ready to receive a script.
+static NSString *const iTermAPIScriptLauncherWarmInterpreterReadyMarker = @"iterm2-warm-interpreter-ready";
+
+// A Python interpreter that has imported the iterm2 module and is blocked reading one line of JSON
+// from stdin naming the script to run, its arguments, and the environment variables that tie it to
+// its API connection.
+@interface iTermWarmPythonInterpreter : NSObject
+@property (nonatomic, strong) NSTask *task;
+@property (nonatomic, strong) NSPipe *inputPipe;
+@property (nonatomic, strong) NSPipe *outputPipe;
+// nil means the standard version.
+@property (nonatomic, copy) NSString *pythonVersion;
+// Set on the main queue once the interpreter has printed the ready marker.
+@property (nonatomic) BOOL ready;
+@end
+
+@implementation iTermWarmPythonInterpreter
+@end
+
 @implementation iTermAPIScriptLauncher
 
 + (void)launchScript:(NSString *)filename
@@ -342,6 +365,17 @@ static NSString *const iTermAPIScriptLauncherScriptDidFailUserNotificationCallba
                     key:(NSString *)key
          withVirtualEnv:(NSString *)virtualenv
           pythonVersion:(NSString *)pythonVersion {
+    if (virtualenv == nil && [iTermAdvancedSettingsModel warmPythonInterpreters]) {
+        const BOOL launched = [self tryLaunchScriptInWarmInterpreter:filename
+                                                           arguments:arguments
+                                                        historyEntry:entry
+                                                                 key:key
+                                                       pythonVersion:pythonVersion];
+        [self warmInterpretersForPythonVersion:pythonVersion];
+        if (launched) {
+            return;
+        }
+    }
     NSTask *task = [[NSTask alloc] init];
 
     // Run through the user's shell so their PATH is set properly.
@@ -382,6 +416,159 @@ static NSString *const iTermAPIScriptLauncherScriptDidFailUserNotificationCallba
     [self waitForTask:task readFromPipe:pipe historyEntry:entry];
 }
 
+#pragma mark - Warm Interpreters
+
++ (NSMutableArray<iTermWarmPythonInterpreter *> *)warmInterpreters {
+    static NSMutableArray<iTermWarmPythonInterpreter *> *interpreters;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        interpreters = [NSMutableArray array];
+    });
+    return interpreters;
+}
+
++ (BOOL)tryLaunchScriptInWarmInterpreter:(NSString *)filename
+                               arguments:(NSArray<NSString *> *)arguments
+                            historyEntry:(iTermScriptHistoryEntry *)entry
+                                     key:(NSString *)key
+                           pythonVersion:(NSString *)pythonVersion {
+    iTermWarmPythonInterpreter *interpreter = [self.warmInterpreters objectPassingTest:^BOOL(iTermWarmPythonInterpreter *candidate, NSUInteger index, BOOL *stop) {
+        return candidate.ready && [NSObject object:candidate.pythonVersion isEqualToObject:pythonVersion];
+    }];
+    if (!interpreter) {
+        DLog(@"No warm interpreter for python version %@", pythonVersion);
+        return NO;
+    }
+    [self.warmInterpreters removeObject:interpreter];
+    if (!interpreter.task.isRunning) {
+        return NO;
+    }
+    NSDictionary *request = @{ @"path": filename,
+                               @"arguments": arguments ?: @[],
+                               @"environment": @{ @"ITERM2_COOKIE": [[iTermWebSocketCookieJar sharedInstance] randomStringForCookie],
+                                                  @"ITERM2_KEY": key } };
+    NSMutableData *data = [[NSJSONSerialization dataWithJSONObject:request options:0 error:nil] mutableCopy];
+    [data appendData:[@"\n" dataUsingEncoding:NSUTF8StringEncoding]];
+    NSFileHandle *input = interpreter.inputPipe.fileHandleForWriting;
+    @try {
+        [input writeData:data];
+        [input closeFile];
+    } @catch (NSException *exception) {
+        DLog(@"Failed to hand off %@ to warm interpreter: %@", filename, exception);
+        [interpreter.task terminate];
+        return NO;
+    }
+    DLog(@"Handed off %@ to warm interpreter %@", filename, @(interpreter.task.processIdentifier));
+    [entry addOutput:[NSString stringWithFormat:@"Running %@ in a warm interpreter\n", filename]
+          completion:^{}];
+    entry.pids = @[ @(interpreter.task.processIdentifier) ];
+    [self waitForTask:interpreter.task readFromPipe:interpreter.outputPipe historyEntry:entry];
+    return YES;
+}
+
++ (void)warmInterpretersForPythonVersion:(NSString *)pythonVersion {
+    NSUInteger count = [[self.warmInterpreters filteredArrayUsingBlock:^BOOL(iTermWarmPythonInterpreter *interpreter) {
+        return [NSObject object:interpreter.pythonVersion isEqualToObject:pythonVersion];
+    }] count];
+    while (count < iTermAPIScriptLauncherWarmInterpreterCount) {
+        iTermWarmPythonInterpreter *interpreter = [self newWarmInterpreterForPythonVersion:pythonVersion];
+        if (!interpreter) {
+            return;
+        }
+        [self.warmInterpreters addObject:interpreter];
+        count++;
+    }
+}
+
+// The same command line a simple script gets, except that instead of a script Python runs a
+// bootstrap that imports iterm2, says it's ready, and then runs whatever script it's handed.
++ (iTermWarmPythonInterpreter *)newWarmInterpreterForPythonVersion:(NSString *)pythonVersion {
+    NSString *bootstrap = [@[ @"import json, os, runpy, sys",
+                              @"import iterm2",
+                              // Split so the shell's trace of this command line doesn't contain the marker.
+                              [NSString stringWithFormat:@"print('%@' + '%@', flush=True)",
+                               [iTermAPIScriptLauncherWarmInterpreterReadyMarker substringToIndex:6],
+                               [iTermAPIScriptLauncherWarmInterpreterReadyMarker substringFromIndex:6]],
+                              @"request = json.loads(sys.stdin.readline())",
+                              @"os.environ.update(request['environment'])",
+                              @"sys.argv = [request['path']] + request['arguments']",
+                              @"sys.path[0] = os.path.dirname(request['path'])",
+                              @"runpy.run_path(request['path'], run_name='__main__')" ] componentsJoinedByString:@"; "];
+    NSString *wrapper = [[NSBundle bundleForClass:self.class] pathForResource:@"it2_api_wrapper" ofType:@"sh"];
+    NSString *python = [[iTermPythonRuntimeDownloader sharedInstance] pathToStandardPyenvPythonWithPythonVersion:pythonVersion];
+    if (!wrapper || !python) {
+        return nil;
+    }
+    NSString *command = [NSString stringWithFormat:@"%@ %@ -c %@",
+                         [wrapper stringWithEscapedShellCharactersExceptTabAndNewline],
+                         [python stringWithEscapedShellCharactersExceptTabAndNewline],
+                         [bootstrap stringWithEscapedShellCharactersIncludingNewlines:YES]];
+
+    NSTask *task = [[NSTask alloc] init];
+    NSString *shell = [iTermOpenDirectory userShell];
+    NSArray<NSString *> *const knownShells = @[ @"bash", @"tcsh", @"zsh", @"fish" ];
+    if ([[NSFileManager defaultManager] fileExistsAtPath:shell] &&
+        [knownShells containsObject:[shell lastPathComponent]]) {
+        task.launchPath = shell;
+    } else {
+        task.launchPath = @"/bin/bash";
+    }
+    task.arguments = @[ @"-c", command ];
+    NSString *searchPath = [iTermPythonRuntimeDownloader.sharedInstance pathToStandardPyenvWithVersion:pythonVersion
+                                                                                creatingSymlinkIfNeeded:NO];
+    NSString *standardPythonVersion = [[iTermPythonRuntimeDownloader bestPythonVersionAt:[searchPath stringByAppendingPathComponent:@"versions"]] it_twoPartVersionNumber];
+    // The cookie and key are sent along with the script since they belong to its connection.
+    task.environment = [self environmentFromEnvironment:[[NSProcessInfo processInfo] environment]
+                                                  shell:[iTermOpenDirectory userShell]
+                                                 cookie:nil
+                                                    key:nil
+                                             virtualenv:python
+                                          pythonVersion:pythonVersion ?: standardPythonVersion];
+
+    iTermWarmPythonInterpreter *interpreter = [[iTermWarmPythonInterpreter alloc] init];
+    interpreter.task = task;
+    interpreter.inputPipe = [[NSPipe alloc] init];
+    interpreter.outputPipe = [[NSPipe alloc] init];
+    interpreter.pythonVersion = pythonVersion;
+    task.standardInput = interpreter.inputPipe;
+    task.standardOutput = interpreter.outputPipe;
+    task.standardError = interpreter.outputPipe;
+    @try {
+        [task launch];
+    } @catch (NSException *exception) {
+        DLog(@"Failed to launch warm interpreter: %@", exception);
+        return nil;
+    }
+    DLog(@"Launched warm interpreter %@ for python version %@", @(task.processIdentifier), pythonVersion);
+
+    // Consume everything up to the ready marker so the script's console starts with the script's
+    // own output. Nothing more is written until a script is handed off.
+    NSData *marker = [iTermAPIScriptLauncherWarmInterpreterReadyMarker dataUsingEncoding:NSUTF8StringEncoding];
+    NSFileHandle *readHandle = interpreter.outputPipe.fileHandleForReading;
+    dispatch_async(dispatch_get_global_queue(QOS_CLASS_UTILITY, 0), ^{
+        NSMutableData *output = [NSMutableData data];
+        NSData *chunk = [readHandle availableData];
+        while (chunk.length) {
+            [output appendData:chunk];
+            if ([output rangeOfData:marker options:0 range:NSMakeRange(0, output.length)].location != NSNotFound) {
+                dispatch_async(dispatch_get_main_queue(), ^{
+                    interpreter.ready = YES;
+                });
+                return;
+            }
+            chunk = [readHandle availableData];
+        }
+        NSString *log = [[NSString alloc] initWithData:output encoding:NSUTF8StringEncoding];
+        dispatch_async(dispatch_get_main_queue(), ^{
+            DLog(@"Warm interpreter %@ exited before becoming ready: %@", @(task.processIdentifier), log);
+            [self.warmInterpreters removeObject:interpreter];
+        });
+    });
+    return interpreter;
+}
+
+#pragma mark - Environment
+
 + (NSDictionary *)environmentFromEnvironment:(NSDictionary *)initialEnvironment
                                        shell:(NSString *)shell
                                       cookie:(NSString *)cookie
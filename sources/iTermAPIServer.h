@@ -89,6 +89,10 @@ extern NSString *const iTermAPIServerConnectionClosed;
                       handler:(void (^)(ITMCloseResponse *))response;
 - (void)apiServerInvokeFunctionRequest:(ITMInvokeFunctionRequest *)request
                                handler:(void (^)(ITMInvokeFunctionResponse *))response;
+- (void)apiServerGetSystemMetricsRequest:(ITMGetSystemMetricsRequest *)request
+                                 handler:(void (^)(ITMGetSystemMetricsResponse *))response;
+- (void)apiServerGetPerformanceCountersRequest:(ITMGetPerformanceCountersRequest *)request
+                                       handler:(void (^)(ITMGetPerformanceCountersResponse *))response;
 @end
 
 @interface iTermAPIServer : NSObject
@@ -11,6 +11,7 @@
 #import "Api.pbobjc.h"
 #import "DebugLogging.h"
 #import "iTermAdvancedSettingsModel.h"
+#import "iTermAPIResponseCache.h"
 #import "iTermHTTPConnection.h"
 #import "iTermLSOF.h"
 #import "iTermWebSocketConnection.h"
@@ -58,6 +59,9 @@ NSString *const iTermAPIServerConnectionClosed = @"iTermAPIServerConnectionClose
 
 @interface iTermAPITransaction : NSObject
 @property (nonatomic, weak) iTermWebSocketConnection *connection;
+// Set when the transaction was begun to hold other requests while an atomic batch runs, rather
+// than by a transaction request.
+@property (nonatomic) BOOL heldForBatch;
 
 - (void)wait;
 - (void)signal;
@@ -122,6 +126,30 @@ NSString *const iTermAPIServerConnectionClosed = @"iTermAPIServerConnectionClose
 
 @end
 
+// A batch request whose subrequests are being handled. Its response is sent once every
+// subrequest has been answered.
+@interface iTermAPIBatch : NSObject
+@property (nonatomic, strong) ITMServerOriginatedMessage *response;
+@property (nonatomic, weak) iTermWebSocketConnection *connection;
+// For atomic batches, holds requests from other connections until the batch finishes.
+@property (nonatomic, strong) iTermAPITransaction *transaction;
+@property (nonatomic) NSInteger numberOfOutstandingResponses;
+@end
+
+@implementation iTermAPIBatch
+@end
+
+@interface iTermAPIBatchSubrequest : NSObject
+@property (nonatomic, strong) iTermAPIBatch *batch;
+@property (nonatomic) NSUInteger index;
+// The ID the client gave the subrequest. It's replaced while handling so it can't collide with
+// the IDs of other requests.
+@property (nonatomic) int64_t originalID;
+@end
+
+@implementation iTermAPIBatchSubrequest
+@end
+
 @interface iTermAPIServer()
 @property (atomic) iTermAPITransaction *transaction;
 @property (nonatomic, strong) dispatch_queue_t queue;
@@ -133,6 +161,13 @@ NSString *const iTermAPIServerConnectionClosed = @"iTermAPIServerConnectionClose
     NSMutableDictionary<id, iTermWebSocketConnection *> *_connections;  // _queue
     dispatch_queue_t _executionQueue;
     NSMutableArray<iTermHTTPConnection *> *_pendingConnections;  // _queue
+    // Connection GUID -> IDs of its requests that were sent to the main thread and haven't been
+    // answered yet.
+    NSMutableDictionary<NSString *, NSCountedSet<NSNumber *> *> *_outstandingRequestIDs;  // _executionQueue
+    // Assigned ID -> subrequest of a batch that hasn't been answered yet. Assigned IDs are
+    // negative since clients count up from 0.
+    NSMutableDictionary<NSNumber *, iTermAPIBatchSubrequest *> *_batchSubrequests;  // @synchronized(_batchSubrequests)
+    int64_t _lastBatchSubrequestID;  // @synchronized(_batchSubrequests)
 }
 
 + (instancetype)sharedInstance {
@@ -165,6 +200,8 @@ NSString *const iTermAPIServerConnectionClosed = @"iTermAPIServerConnectionClose
         _pendingConnections = [NSMutableArray array];
         _queue = dispatch_queue_create("com.iterm2.apisockets", NULL);
         _executionQueue = dispatch_queue_create("com.iterm2.apiexec", DISPATCH_QUEUE_SERIAL);
+        _outstandingRequestIDs = [NSMutableDictionary dictionary];
+        _batchSubrequests = [NSMutableDictionary dictionary];
 
         if (![self listenOnUnixSocket]) {
             return nil;
@@ -453,6 +490,17 @@ NSString *const iTermAPIServerConnectionClosed = @"iTermAPIServerConnectionClose
             [weakSelf drainTransaction:transaction];
         });
     } else {
+        if (request.submessageOneOfCase == ITMClientOriginatedMessage_Submessage_OneOfCase_BatchRequest &&
+            request.batchRequest.atomic) {
+            // Hold other requests until every request in the batch has been answered.
+            iTermAPITransaction *transaction = [[iTermAPITransaction alloc] init];
+            transaction.connection = webSocketConnection;
+            transaction.heldForBatch = YES;
+            self.transaction = transaction;
+        }
+        if ([iTermAdvancedSettingsModel serveReadOnlyAPIRequestsFromSnapshots]) {
+            [self addOutstandingRequest:request connection:webSocketConnection];
+        }
         dispatch_async(dispatch_get_main_queue(), ^{
             [weakSelf dispatchRequest:request connection:webSocketConnection];
         });
@@ -488,26 +536,54 @@ NSString *const iTermAPIServerConnectionClosed = @"iTermAPIServerConnectionClose
                    connection:transactionRequest.connection];
     }
     dispatch_async(_executionQueue, ^{
-        if (self.transaction == transaction) {
-            self.transaction = nil;
-        }
-        iTermAPIRequest *apiRequest = [transaction dequeueRequestFromAnyConnection:YES];
-        while (apiRequest) {
-            if (apiRequest.connection) {
-                [self enqueueOrDispatchRequest:apiRequest.request onConnection:apiRequest.connection];
-            }
-            apiRequest = [transaction dequeueRequestFromAnyConnection:YES];
-        }
+        [self endTransaction:transaction];
     });
 }
 
+// Runs on execution queue. Dispatches the requests that were held during the transaction.
+- (void)endTransaction:(iTermAPITransaction *)transaction {
+    if (self.transaction == transaction) {
+        self.transaction = nil;
+    }
+    iTermAPIRequest *apiRequest = [transaction dequeueRequestFromAnyConnection:YES];
+    while (apiRequest) {
+        if (apiRequest.connection) {
+            [self enqueueOrDispatchRequest:apiRequest.request onConnection:apiRequest.connection];
+        }
+        apiRequest = [transaction dequeueRequestFromAnyConnection:YES];
+    }
+}
+
 #pragma mark - Handle incoming RPCs
 
 - (void)finishHandlingRequestWithResponse:(ITMServerOriginatedMessage *)response
                              onConnection:(iTermWebSocketConnection *)webSocketConnection {
+    if ([self addResponseToBatch:response]) {
+        return;
+    }
     dispatch_async(self.queue, ^{
         [self sendResponse:response onConnection:webSocketConnection];
     });
+    if ([iTermAdvancedSettingsModel serveReadOnlyAPIRequestsFromSnapshots]) {
+        dispatch_async(_executionQueue, ^{
+            [self removeOutstandingRequestWithID:response.id_p connection:webSocketConnection];
+        });
+    }
+}
+
+// Like finishHandlingRequestWithResponse:onConnection: but also remembers the response so that
+// repeats of the request can be answered without the main thread until something changes.
+- (void)finishHandlingRequest:(ITMClientOriginatedMessage *)request
+                   generation:(uint64_t)generation
+                 withResponse:(ITMServerOriginatedMessage *)response
+                 onConnection:(iTermWebSocketConnection *)webSocketConnection {
+    if ([iTermAdvancedSettingsModel serveReadOnlyAPIRequestsFromSnapshots] &&
+        [iTermAPIResponseCache canCacheResponseToRequest:request]) {
+        [[iTermAPIResponseCache sharedInstance] setResponse:response
+                                                 forRequest:request
+                                                 generation:generation];
+    }
+    [self finishHandlingRequestWithResponse:response onConnection:webSocketConnection];
 }
 
 - (ITMServerOriginatedMessage *)newResponseForRequest:(ITMClientOriginatedMessage *)request {
@@ -528,12 +604,16 @@ NSString *const iTermAPIServerConnectionClosed = @"iTermAPIServerConnectionClose
 
     __block BOOL handled = NO;
     __weak __typeof(self) weakSelf = self;
+    const uint64_t generation = [[iTermAPIResponseCache sharedInstance] generation];
     [_delegate apiServerGetBuffer:request.getBufferRequest
                           handler:^(ITMGetBufferResponse *getBufferResponse) {
                               assert(!handled);
                               handled = YES;
                               response.getBufferResponse = getBufferResponse;
-                              [weakSelf finishHandlingRequestWithResponse:response onConnection:webSocketConnection];
+                              [weakSelf finishHandlingRequest:request
+                                                   generation:generation
+                                                 withResponse:response
+                                                 onConnection:webSocketConnection];
                           }];
 }
 
@@ -625,12 +705,16 @@ NSString *const iTermAPIServerConnectionClosed = @"iTermAPIServerConnectionClose
 
     __block BOOL handled = NO;
     __weak __typeof(self) weakSelf = self;
+    const uint64_t generation = [[iTermAPIResponseCache sharedInstance] generation];
     [_delegate apiServerListSessions:request.listSessionsRequest
                              handler:^(ITMListSessionsResponse *listSessionsResponse) {
                                  assert(!handled);
                                  handled = YES;
                                  response.listSessionsResponse = listSessionsResponse;
-                                 [weakSelf finishHandlingRequestWithResponse:response onConnection:webSocketConnection];
+                                 [weakSelf finishHandlingRequest:request
+                                                      generation:generation
+                                                    withResponse:response
+                                                    onConnection:webSocketConnection];
                              }];
 }
 
@@ -691,11 +775,15 @@ NSString *const iTermAPIServerConnectionClosed = @"iTermAPIServerConnectionClose
 
     __block BOOL handled = NO;
     __weak __typeof(self) weakSelf = self;
+    const uint64_t generation = [[iTermAPIResponseCache sharedInstance] generation];
     [_delegate apiServerGetProperty:request.getPropertyRequest handler:^(ITMGetPropertyResponse *getPropertyResponse) {
         assert(!handled);
         handled = YES;
         response.getPropertyResponse = getPropertyResponse;
-        [weakSelf finishHandlingRequestWithResponse:response onConnection:webSocketConnection];
+        [weakSelf finishHandlingRequest:request
+                             generation:generation
+                           withResponse:response
+                           onConnection:webSocketConnection];
     }];
 }
 
@@ -730,11 +818,15 @@ NSString *const iTermAPIServerConnectionClosed = @"iTermAPIServerConnectionClose
 
     __block BOOL handled = NO;
     __weak __typeof(self) weakSelf = self;
+    const uint64_t generation = [[iTermAPIResponseCache sharedInstance] generation];
     [_delegate apiServerVariable:request.variableRequest handler:^(ITMVariableResponse *variableResponse) {
         assert(!handled);
         handled = YES;
         response.variableResponse = variableResponse;
-        [weakSelf finishHandlingRequestWithResponse:response onConnection:webSocketConnection];
+        [weakSelf finishHandlingRequest:request
+                             generation:generation
+                           withResponse:response
+                           onConnection:webSocketConnection];
     }];
 }
 
@@ -981,6 +1073,92 @@ NSString *const iTermAPIServerConnectionClosed = @"iTermAPIServerConnectionClose
     }];
 }
 
+- (void)handleBatchRequest:(ITMClientOriginatedMessage *)request connection:(iTermWebSocketConnection *)webSocketConnection {
+    iTermAPIBatch *batch = [[iTermAPIBatch alloc] init];
+    batch.response = [self newResponseForRequest:request];
+    batch.response.batchResponse = [[ITMBatchResponse alloc] init];
+    batch.connection = webSocketConnection;
+    iTermAPITransaction *transaction = self.transaction;
+    if (request.batchRequest.atomic && transaction.heldForBatch && transaction.connection == webSocketConnection) {
+        batch.transaction = transaction;
+    }
+
+    // Register every subrequest before dispatching any so that one answered synchronously can't
+    // finish the batch early. The extra outstanding response is removed after dispatching.
+    NSMutableArray<ITMClientOriginatedMessage *> *subrequests = [NSMutableArray array];
+    @synchronized (_batchSubrequests) {
+        batch.numberOfOutstandingResponses = 1;
+        [request.batchRequest.requestsArray enumerateObjectsUsingBlock:^(ITMClientOriginatedMessage *original, NSUInteger idx, BOOL *stop) {
+            ITMServerOriginatedMessage *placeholder = [self newResponseForRequest:original];
+            [batch.response.batchResponse.responsesArray addObject:placeholder];
+            if (original.submessageOneOfCase == ITMClientOriginatedMessage_Submessage_OneOfCase_TransactionRequest ||
+                original.submessageOneOfCase == ITMClientOriginatedMessage_Submessage_OneOfCase_BatchRequest) {
+                placeholder.error = @"Transaction and batch requests are not allowed in a batch.";
+                return;
+            }
+            iTermAPIBatchSubrequest *subrequest = [[iTermAPIBatchSubrequest alloc] init];
+            subrequest.batch = batch;
+            subrequest.index = idx;
+            subrequest.originalID = original.id_p;
+            ITMClientOriginatedMessage *copy = [original copy];
+            copy.id_p = --self->_lastBatchSubrequestID;
+            self->_batchSubrequests[@(copy.id_p)] = subrequest;
+            [subrequests addObject:copy];
+            batch.numberOfOutstandingResponses += 1;
+        }];
+    }
+    DLog(@"Dispatching %@ requests in batch %@", @(subrequests.count), @(request.id_p));
+    for (ITMClientOriginatedMessage *subrequest in subrequests) {
+        [self dispatchRequest:subrequest connection:webSocketConnection];
+    }
+    BOOL finished;
+    @synchronized (_batchSubrequests) {
+        batch.numberOfOutstandingResponses -= 1;
+        finished = (batch.numberOfOutstandingResponses == 0);
+    }
+    if (finished) {
+        [self finishBatch:batch];
+    }
+}
+
+// Returns YES if |response| answers a subrequest of a batch, in which case it'll be sent as part
+// of the batch's response.
+- (BOOL)addResponseToBatch:(ITMServerOriginatedMessage *)response {
+    iTermAPIBatch *finished = nil;
+    @synchronized (_batchSubrequests) {
+        if (_batchSubrequests.count == 0) {
+            return NO;
+        }
+        iTermAPIBatchSubrequest *subrequest = _batchSubrequests[@(response.id_p)];
+        if (!subrequest) {
+            return NO;
+        }
+        [_batchSubrequests removeObjectForKey:@(response.id_p)];
+        response.id_p = subrequest.originalID;
+        iTermAPIBatch *batch = subrequest.batch;
+        batch.response.batchResponse.responsesArray[subrequest.index] = response;
+        batch.numberOfOutstandingResponses -= 1;
+        if (batch.numberOfOutstandingResponses == 0) {
+            finished = batch;
+        }
+    }
+    if (finished) {
+        [self finishBatch:finished];
+    }
+    return YES;
+}
+
+- (void)finishBatch:(iTermAPIBatch *)batch {
+    DLog(@"Finished batch %@", @(batch.response.id_p));
+    [self finishHandlingRequestWithResponse:batch.response onConnection:batch.connection];
+    iTermAPITransaction *transaction = batch.transaction;
+    if (transaction) {
+        dispatch_async(_executionQueue, ^{
+            [self endTransaction:transaction];
+        });
+    }
+}
+
 - (void)handleInvokeFunctionRequest:(ITMClientOriginatedMessage *)request connection:(iTermWebSocketConnection *)webSocketConnection {
     ITMServerOriginatedMessage *response = [self newResponseForRequest:request];
 
@@ -994,6 +1172,32 @@ NSString *const iTermAPIServerConnectionClosed = @"iTermAPIServerConnectionClose
     }];
 }
 
+- (void)handleGetSystemMetricsRequest:(ITMClientOriginatedMessage *)request connection:(iTermWebSocketConnection *)webSocketConnection {
+    ITMServerOriginatedMessage *response = [self newResponseForRequest:request];
+
+    __block BOOL handled = NO;
+    __weak __typeof(self) weakSelf = self;
+    [_delegate apiServerGetSystemMetricsRequest:request.getSystemMetricsRequest handler:^(ITMGetSystemMetricsResponse *theResponse) {
+        assert(!handled);
+        handled = YES;
+        response.getSystemMetricsResponse = theResponse;
+        [weakSelf finishHandlingRequestWithResponse:response onConnection:webSocketConnection];
+    }];
+}
+
+- (void)handleGetPerformanceCountersRequest:(ITMClientOriginatedMessage *)request connection:(iTermWebSocketConnection *)webSocketConnection {
+    ITMServerOriginatedMessage *response = [self newResponseForRequest:request];
+
+    __block BOOL handled = NO;
+    __weak __typeof(self) weakSelf = self;
+    [_delegate apiServerGetPerformanceCountersRequest:request.getPerformanceCountersRequest handler:^(ITMGetPerformanceCountersResponse *theResponse) {
+        assert(!handled);
+        handled = YES;
+        response.getPerformanceCountersResponse = theResponse;
+        [weakSelf finishHandlingRequestWithResponse:response onConnection:webSocketConnection];
+    }];
+}
+
 
 // Runs on main queue, either in or not in a transaction.
 - (void)dispatchRequest:(ITMClientOriginatedMessage *)request connection:(iTermWebSocketConnection *)webSocketConnection {
@@ -1006,6 +1210,10 @@ NSString *const iTermAPIServerConnectionClosed = @"iTermAPIServerConnectionClose
         return;
     }
 
+    if (![iTermAPIResponseCache canCacheResponseToRequest:request]) {
+        // It might change something a cached response depends on.
+        [iTermAPIResponseCache invalidate];
+    }
     _currentKey = webSocketConnection.key;
     switch (request.submessageOneOfCase) {
         case ITMClientOriginatedMessage_Submessage_OneOfCase_TransactionRequest:
@@ -1149,6 +1357,18 @@ NSString *const iTermAPIServerConnectionClosed = @"iTermAPIServerConnectionClose
         case ITMClientOriginatedMessage_Submessage_OneOfCase_InvokeFunctionRequest:
             [self handleInvokeFunctionRequest:request connection:webSocketConnection];
             break;
+
+        case ITMClientOriginatedMessage_Submessage_OneOfCase_BatchRequest:
+            [self handleBatchRequest:request connection:webSocketConnection];
+            break;
+
+        case ITMClientOriginatedMessage_Submessage_OneOfCase_GetSystemMetricsRequest:
+            [self handleGetSystemMetricsRequest:request connection:webSocketConnection];
+            break;
+
+        case ITMClientOriginatedMessage_Submessage_OneOfCase_GetPerformanceCountersRequest:
+            [self handleGetPerformanceCountersRequest:request connection:webSocketConnection];
+            break;
     }
     _currentKey = nil;
 }
@@ -1177,9 +1397,64 @@ NSString *const iTermAPIServerConnectionClosed = @"iTermAPIServerConnectionClose
         return;
     }
 
+    if ([self tryHandleRequestFromCache:request connection:webSocketConnection]) {
+        return;
+    }
+
     [self dispatchRequestWhileNotInTransaction:request connection:webSocketConnection];
 }
 
+// Runs on execution queue. Answers a read-only request without waiting for the main thread if an
+// identical request was answered since the last change. A connection with requests still pending
+// on the main thread must wait its turn so it can't observe state from before they took effect.
+- (BOOL)tryHandleRequestFromCache:(ITMClientOriginatedMessage *)request
+                       connection:(iTermWebSocketConnection *)webSocketConnection {
+    if (![iTermAdvancedSettingsModel serveReadOnlyAPIRequestsFromSnapshots]) {
+        return NO;
+    }
+    if (![iTermAPIResponseCache canCacheResponseToRequest:request]) {
+        return NO;
+    }
+    if (_outstandingRequestIDs[webSocketConnection.guid].count > 0) {
+        return NO;
+    }
+    ITMServerOriginatedMessage *response = [[iTermAPIResponseCache sharedInstance] responseForRequest:request];
+    if (!response) {
+        return NO;
+    }
+    DLog(@"Answering %@ from cache", request);
+    dispatch_async(dispatch_get_main_queue(), ^{
+        [[NSNotificationCenter defaultCenter] postNotificationName:iTermAPIServerDidReceiveMessage
+                                                            object:webSocketConnection.key
+                                                          userInfo:@{ @"request": request }];
+    });
+    dispatch_async(self.queue, ^{
+        [self sendResponse:response onConnection:webSocketConnection];
+    });
+    return YES;
+}
+
+// Runs on execution queue.
+- (void)addOutstandingRequest:(ITMClientOriginatedMessage *)request
+                   connection:(iTermWebSocketConnection *)webSocketConnection {
+    NSCountedSet<NSNumber *> *ids = _outstandingRequestIDs[webSocketConnection.guid];
+    if (!ids) {
+        ids = [[NSCountedSet alloc] init];
+        _outstandingRequestIDs[webSocketConnection.guid] = ids;
+    }
+    [ids addObject:@(request.id_p)];
+}
+
+// Runs on execution queue.
+- (void)removeOutstandingRequestWithID:(int64_t)requestID
+                            connection:(iTermWebSocketConnection *)webSocketConnection {
+    NSCountedSet<NSNumber *> *ids = _outstandingRequestIDs[webSocketConnection.guid];
+    [ids removeObject:@(requestID)];
+    if (ids.count == 0) {
+        [_outstandingRequestIDs removeObjectForKey:webSocketConnection.guid];
+    }
+}
+
 #pragma mark - iTermWebSocketConnectionDelegate
 
 // _queue
@@ -1187,6 +1462,7 @@ NSString *const iTermAPIServerConnectionClosed = @"iTermAPIServerConnectionClose
     DLog(@"Connection terminated");
     [self->_connections removeObjectForKey:webSocketConnection.guid];
     dispatch_async(self->_executionQueue, ^{
+        [self->_outstandingRequestIDs removeObjectForKey:webSocketConnection.guid];
         if (self.transaction.connection == webSocketConnection) {
             iTermAPITransaction *transaction = self.transaction;
             self.transaction = nil;
@@ -0,0 +1,36 @@
+//
+//  iTermAPIVariableChangeFilter.h
+//  iTerm2SharedARC
+//
+//  Created by agent on 10/14/26.
+//
+
+#import <Foundation/Foundation.h>
+
+@class ITMVariableMonitorRequest;
+
+NS_ASSUME_NONNULL_BEGIN
+
+// Applies a variable-change subscription's coalescing interval and value predicate. Changes are
+// examined and encoded on a background queue so a variable that changes many times a second
+// costs the main thread little more than handing over its new value.
+@interface iTermAPIVariableChangeFilter : NSObject
+
+// Does the request ask for coalescing or filtering at all?
++ (BOOL)requestNeedsFilter:(ITMVariableMonitorRequest *)request;
+
+// Returns NO if the predicate can't be used (e.g., a malformed regex).
++ (BOOL)requestIsValid:(ITMVariableMonitorRequest *)request;
+
+// |block| is called on the main queue with the JSON encoding of each value to report.
+- (nullable instancetype)initWithRequest:(ITMVariableMonitorRequest *)request
+                                   block:(void (^)(NSString *jsonNewValue))block NS_DESIGNATED_INITIALIZER;
+- (instancetype)init NS_UNAVAILABLE;
+
+// Main thread. |value| is the variable's value at the time of the change and must not be mutated
+// afterwards.
+- (void)valueDidChange:(nullable id)value;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,156 @@
+//
+//  iTermAPIVariableChangeFilter.m
+//  iTerm2SharedARC
+//
+//  Created by agent on 10/14/26.
+//
+
+#import "iTermAPIVariableChangeFilter.h"
+
+#import "Api.pbobjc.h"
+#import "DebugLogging.h"
+#import "NSJSONSerialization+iTerm.h"
+
+@implementation iTermAPIVariableChangeFilter {
+    NSTimeInterval _interval;
+    NSRegularExpression *_regex;
+    double _minimumChange;
+    void (^_block)(NSString *);
+
+    // Everything below is accessed only on the queue.
+    id _pendingValue;
+    BOOL _havePendingValue;
+    BOOL _flushScheduled;
+    NSTimeInterval _lastReportTime;
+    id _lastReportedValue;
+    NSString *_lastReportedJSON;
+}
+
++ (dispatch_queue_t)queue {
+    static dispatch_queue_t queue;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        queue = dispatch_queue_create("com.iterm2.api-variable-filter", DISPATCH_QUEUE_SERIAL);
+    });
+    return queue;
+}
+
++ (BOOL)requestNeedsFilter:(ITMVariableMonitorRequest *)request {
+    return (request.coalescingInterval > 0 ||
+            request.predicate.hasRegex ||
+            request.predicate.minimumChange > 0);
+}
+
++ (BOOL)requestIsValid:(ITMVariableMonitorRequest *)request {
+    if (request.coalescingInterval < 0 || request.predicate.minimumChange < 0) {
+        return NO;
+    }
+    if (request.predicate.hasRegex) {
+        return [NSRegularExpression regularExpressionWithPattern:request.predicate.regex
+                                                         options:0
+                                                           error:nil] != nil;
+    }
+    return YES;
+}
+
+- (instancetype)initWithRequest:(ITMVariableMonitorRequest *)request
+                          block:(void (^)(NSString *))block {
+    self = [super init];
+    if (self) {
+        _interval = MAX(0, request.coalescingInterval);
+        _minimumChange = MAX(0, request.predicate.minimumChange);
+        if (request.predicate.hasRegex) {
+            NSError *error = nil;
+            _regex = [NSRegularExpression regularExpressionWithPattern:request.predicate.regex
+                                                               options:0
+                                                                 error:&error];
+            if (!_regex) {
+                DLog(@"Bad regex %@: %@", request.predicate.regex, error);
+                return nil;
+            }
+        }
+        _block = [block copy];
+        _lastReportTime = -INFINITY;
+    }
+    return self;
+}
+
+- (void)valueDidChange:(id)value {
+    dispatch_async([self.class queue], ^{
+        self->_pendingValue = value;
+        self->_havePendingValue = YES;
+        [self scheduleFlush];
+    });
+}
+
+#pragma mark - Private
+
+// queue
+- (void)scheduleFlush {
+    if (_flushScheduled) {
+        return;
+    }
+    const NSTimeInterval delay = _lastReportTime + _interval - [NSDate timeIntervalSinceReferenceDate];
+    if (delay <= 0) {
+        [self flush];
+        return;
+    }
+    _flushScheduled = YES;
+    __weak __typeof(self) weakSelf = self;
+    dispatch_after(dispatch_time(DISPATCH_TIME_NOW, (int64_t)(delay * NSEC_PER_SEC)),
+                   [self.class queue], ^{
+        __strong __typeof(self) strongSelf = weakSelf;
+        if (!strongSelf) {
+            return;
+        }
+        strongSelf->_flushScheduled = NO;
+        [strongSelf flush];
+    });
+}
+
+// queue
+- (void)flush {
+    if (!_havePendingValue) {
+        return;
+    }
+    id value = _pendingValue;
+    _pendingValue = nil;
+    _havePendingValue = NO;
+
+    if (![self valueSatisfiesPredicate:value]) {
+        return;
+    }
+    NSString *json = [NSJSONSerialization it_jsonStringForObject:value] ?: @"null";
+    if ([json isEqualToString:_lastReportedJSON]) {
+        return;
+    }
+    _lastReportedValue = value;
+    _lastReportedJSON = json;
+    _lastReportTime = [NSDate timeIntervalSinceReferenceDate];
+
+    void (^block)(NSString *) = _block;
+    dispatch_async(dispatch_get_main_queue(), ^{
+        block(json);
+    });
+}
+
+// queue
+- (BOOL)valueSatisfiesPredicate:(id)value {
+    if (_minimumChange > 0 &&
+        [value isKindOfClass:[NSNumber class]] &&
+        [_lastReportedValue isKindOfClass:[NSNumber class]]) {
+        const double delta = fabs([value doubleValue] - [_lastReportedValue doubleValue]);
+        if (delta < _minimumChange) {
+            return NO;
+        }
+    }
+    if (_regex) {
+        NSString *string = [value isKindOfClass:[NSString class]] ? value : ([NSJSONSerialization it_jsonStringForObject:value] ?: @"null");
+        if ([_regex firstMatchInString:string options:0 range:NSMakeRange(0, string.length)] == nil) {
+            return NO;
+        }
+    }
+    return YES;
+}
+
+@end
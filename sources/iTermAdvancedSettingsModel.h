@@ -36,6 +36,7 @@ extern NSString *const iTermAdvancedSettingsDidChange;
 + (BOOL)acceptOSC7;
 + (double)activeUpdateCadence;
 + (int)adaptiveFrameRateThroughputThreshold;
++ (BOOL)adaptivePasteThroughput;
 + (BOOL)addNewTabAtEndOfTabs;
 + (BOOL)aggressiveBaseCharacterDetection;
 + (BOOL)aggressiveFocusFollowsMouse;
@@ -46,6 +47,7 @@ extern NSString *const iTermAdvancedSettingsDidChange;
 + (BOOL)allowTabbarInTitlebarAccessoryBigSur;
 + (BOOL)alternateMouseScroll;
 + (BOOL)alwaysUseStatusBarComposer;
++ (BOOL)animatedImageTextureArrays;
 + (BOOL)animateGraphStatusBarComponents;
 + (void)setAlternateMouseScroll:(BOOL)value;
 + (NSString *)alternateMouseScrollStringForDown;
@@ -54,6 +56,8 @@ extern NSString *const iTermAdvancedSettingsDidChange;
 + (int)alwaysWarnBeforePastingOverSize;
 + (BOOL)anonymousTmuxWindowsOpenInCurrentWindow;
 + (BOOL)appendToExistingDebugLog;
++ (BOOL)asynchronousInlineImages;
++ (BOOL)attachNoteViewsLazily;
 + (BOOL)autoLockSessionNameOnEdit;
 + (int)autocompleteMaxOptions;
 + (NSString *)autoLogFormat;
@@ -64,10 +68,37 @@ extern NSString *const iTermAdvancedSettingsDidChange;
 + (double)badgeMaxWidthFraction;
 + (int)badgeRightMargin;
 + (int)badgeTopMargin;
++ (BOOL)batchInterpolatedStringEvaluation;
++ (BOOL)batchPidInfoQueries;
++ (BOOL)batchSessionLogWrites;
++ (BOOL)batchSplitPaneLayout;
 + (double)bellRateLimit;
++ (BOOL)bitParallelSubsequenceMatching;
 + (BOOL)bootstrapDaemon;
++ (BOOL)broadcastInputOnBackgroundQueue;
++ (BOOL)bulkAppendScrollingOutput;
++ (BOOL)bulkRemoveScrolledOffMarks;
++ (BOOL)cacheGlyphsOnDisk;
++ (BOOL)cacheMinimumContrastColors;
++ (BOOL)cacheParsedExpressions;
++ (BOOL)cacheProcessArguments;
++ (BOOL)cacheProfileFiltering;
++ (BOOL)cacheTmuxHistory;
++ (BOOL)cacheVariableScopeLookups;
++ (BOOL)cancelableCmdHoverURLLookup;
++ (BOOL)checkpointStateDatabaseInBackground;
++ (BOOL)chunkedCopyOfLargeSelections;
 + (BOOL)clearBellIconAggressively;
 + (BOOL)cmdClickWhenInactiveInvokesSemanticHistory;
++ (BOOL)coalescePreferenceChangeNotifications;
++ (BOOL)coalesceInternalNotifications;
++ (BOOL)coalesceTabBarUpdates;
++ (BOOL)coalesceTmuxLayoutChanges;
++ (BOOL)coalesceTokenExecution;
++ (BOOL)compactInstantReplayFrames;
++ (BOOL)compactScrollback;
++ (BOOL)compressLargeAPIMessages;
++ (int)compressScrollbackAfterBlocks;
 + (double)coloredSelectedTabOutlineStrength;
 + (double)coloredUnselectedTabTextProminence;
 + (double)compactEdgeDragSize;
@@ -77,12 +108,18 @@ extern NSString *const iTermAdvancedSettingsDidChange;
 + (BOOL)convertItalicsToReverseVideoForTmux;
 + (BOOL)convertTabDragToWindowDragForSolitaryTabInCompactOrMinimalTheme;
 + (BOOL)copyBackgroundColor;
++ (BOOL)copyOnWriteGridSnapshots;
++ (BOOL)copyOnWriteLineBlocks;
 + (BOOL)copyWithStylesByDefault;
 + (CGFloat)customTabBarFontSize;
 + (BOOL)darkThemeHasBlackTitlebar;
++ (BOOL)decodeSixelAsynchronously;
++ (BOOL)decodeTmuxOutputInParser;
++ (BOOL)deduplicateScrollback;
 + (CGFloat)defaultTabBarHeight;
 + (int)defaultTabStopWidth;
 + (NSString *)defaultURLScheme;
++ (BOOL)deferNonCriticalStartupWork;
 + (BOOL)detectPasswordInput;
 + (BOOL)disableAdaptiveFrameRateInInteractiveApps;
 + (BOOL)disableAppNap;
@@ -100,6 +137,7 @@ extern NSString *const iTermAdvancedSettingsDidChange;
 + (BOOL)disableWindowShadowWhenTransparencyPreMojave;
 + (BOOL)disableWindowSizeSnap;
 + (BOOL)disallowCopyEmptyString;
++ (BOOL)diskBackedPasteHistory;
 // Use PTYScrollView.shouldDismember, since disabling dismemberment is 10.15+
 + (BOOL)dismemberScrollView;
 + (BOOL)disregardDockSettingToOpenTabsInsteadOfWindows;
@@ -112,6 +150,7 @@ extern NSString *const iTermAdvancedSettingsDidChange;
 + (BOOL)drawOutlineAroundCursor;
 + (BOOL)dwcLineCache;
 + (NSString *)dynamicProfilesPath;
++ (BOOL)eagerlyReadMultiServerChildReports;
 + (double)echoProbeDuration;
 + (BOOL)enableSemanticHistoryOnNetworkMounts;
 + (BOOL)enableUnderlineSemanticHistoryOnCmdHover;
@@ -120,20 +159,28 @@ extern NSString *const iTermAdvancedSettingsDidChange;
 + (BOOL)experimentalKeyHandling;
 + (double)extraSpaceBeforeCompactTopTabBar;
 + (NSString *)fallbackLCCType;
++ (BOOL)fairShareTokenExecution;
 + (BOOL)fastForegroundJobUpdates;
++ (BOOL)fastInstantReplaySeeking;
 + (BOOL)fastTrackpad;
 + (double)findDelaySeconds;
 
 // Regular expression for finding URLs for Edit>Find>Find URLs
 + (NSString *)findUrlsRegex;
 + (BOOL)fixMouseWheel;
++ (BOOL)flatComplexCharTable;
++ (BOOL)flatIntervalTreeQueries;
++ (double)floodModeFrameRate;
++ (int)floodModeThreshold;
 + (NSString *)fontsForGenerousRounding;
 + (BOOL)focusNewSplitPaneWithFocusFollowsMouse;
 + (BOOL)focusReportingEnabled;
 + (BOOL)forceAntialiasingOnRetina;
 + (BOOL)fontChangeAffectsBroadcastingSessions;
 + (double)fractionOfCharacterSelectingNextNeighbor;
++ (BOOL)fuseAttributedRuns;
 + (BOOL)fullHeightCursor;
++ (BOOL)gitStateFromFileSystemEvents;
 + (NSString *)gitSearchPath;
 + (double)gitTimeout;
 + (BOOL)hdrCursor;
@@ -148,14 +195,28 @@ extern NSString *const iTermAdvancedSettingsDidChange;
 + (double)idleTimeSeconds;
 + (BOOL)ignoreHardNewlinesInURLs;
 + (BOOL)includePasteHistoryInAdvancedPaste;
++ (BOOL)incrementalDynamicProfileReload;
++ (BOOL)indexKeyMappings;
 + (BOOL)includeShortcutInWindowsMenu;
++ (BOOL)incrementalAccessibilityText;
++ (BOOL)incrementalFindOnPage;
++ (BOOL)incrementalProcessCacheUpdates;
++ (BOOL)indexAutomaticProfileSwitchingRules;
++ (BOOL)indexCommandHistoryByPrefix;
++ (BOOL)indexCopyModeMotions;
++ (BOOL)indexRecentDirectories;
++ (BOOL)indexScrollbackForSearch;
++ (BOOL)indexSubSelections;
 + (BOOL)indicateBellsInDockBadgeLabel;
 + (double)indicatorFlashInitialAlpha;
++ (int)inlineImageMemoryBudget;
 + (double)invalidateShadowTimesPerSecond;
 + (BOOL)jiggleTTYSizeOnClearBuffer;
 + (BOOL)killJobsInServersOnQuit;
 + (BOOL)killSessionsOnLogout;
++ (BOOL)launchJobsWithPosixSpawn;
 + (BOOL)laxNilPolicyInInterpolatedStrings;
++ (BOOL)lazyScrollbackRestoration;
 + (BOOL)logDrawingPerformance;
 + (BOOL)logRestorableStateSize;
 + (BOOL)logTimestampsWithPlainText;
@@ -165,6 +226,12 @@ extern NSString *const iTermAdvancedSettingsDidChange;
 + (int)maximumBytesToProvideToPythonAPI;
 + (int)maximumNumberOfTriggerCommands;
 + (int)maxSemanticHistoryPrefixOrSuffix;
++ (BOOL)measureMetalLatency;
++ (void)setMeasureMetalLatency:(BOOL)value;
++ (int)memoryPressureScrollbackFloor;
++ (BOOL)mergeBackgroundColorRunsAcrossRows;
++ (BOOL)metalParallelPopulate;
++ (BOOL)metalPartialRedraw;
 + (double)metalRedrawPeriod;
 + (double)metalSlowFrameRate;
 + (BOOL)middleClickClosesTab;
@@ -175,12 +242,14 @@ extern NSString *const iTermAdvancedSettingsDidChange;
 + (double)minimalTabStyleBackgroundColorDifference;
 + (BOOL)minimalTabStyleTreatLeftInsetAsPartOfFirstTab;
 + (double)minimalTabStyleOutlineStrength;
++ (BOOL)minimapDrawsByRow;
 + (int)minimumTabDragDistance;
 + (double)minimumTabLabelWidth;
 + (int)minimumWeightDifferenceForBoldFont;
 + (double)minRunningTime;
 + (int)minTabWidth;
 + (BOOL)multiserver;
++ (BOOL)narrowOpenQuicklyResults;
 + (BOOL)navigatePanesInReadingOrder;
 + (BOOL)neverWarnAboutMeta;
 + (BOOL)neverWarnAboutOverrides;
@@ -222,15 +291,25 @@ extern NSString *const iTermAdvancedSettingsDidChange;
 + (int)optimumTabWidth;
 + (BOOL)optionIsMetaForSpecialChars;
 + (BOOL)oscColorReport16Bits;
++ (BOOL)parallelScrollbackSearch;
++ (BOOL)parallelSessionRestoration;
 + (int)pasteHistoryMaxOptions;
 + (BOOL)pastingClearsSelection;
 + (NSString *)pathsToIgnore;
 + (NSString *)pathToFTP;
 + (NSString *)pathToTelnet;
++ (BOOL)persistSubpixelModels;
 + (BOOL)performDictionaryLookupOnQuickLook;
++ (BOOL)perPaneTmuxWriteQueues;
 + (BOOL)pinEditSession;
 + (BOOL)pinchToChangeFontSizeDisabled;
++ (BOOL)pipelineTaskWrites;
++ (BOOL)pipelineTmuxCommands;
 + (BOOL)pollForTmuxForegroundJob;
++ (BOOL)prebuildPreferencesSearchIndex;
++ (BOOL)precompiledSmartSelectionRules;
++ (BOOL)prefilterExpectations;
++ (BOOL)prefilterTriggers;
 + (BOOL)preferSpeedToFullLigatureSupport;
 + (NSString *)preferredBaseDir;
 + (const BOOL *)preventEscapeSequenceFromClearingHistory;
@@ -238,14 +317,23 @@ extern NSString *const iTermAdvancedSettingsDidChange;
 + (void)setPreventEscapeSequenceFromClearingHistory:(const BOOL *)value;
 + (const BOOL *)preventEscapeSequenceFromChangingProfile;
 + (void)setPreventEscapeSequenceFromChangingProfile:(const BOOL *)value;
++ (BOOL)prioritizeTmuxUnpausing;
++ (BOOL)prioritizeVisibleTriggerCommands;
 + (BOOL)profilesWindowJoinsActiveSpace;
++ (BOOL)progressiveArrangementRestoration;
 + (BOOL)promptForPasteWhenNotAtPrompt;
 + (NSString *)pythonRuntimeBetaDownloadURL;
 + (NSString *)pythonRuntimeDownloadURL;
 + (void)setPromptForPasteWhenNotAtPrompt:(BOOL)value;
 + (BOOL)proportionalScrollWheelReporting;
++ (BOOL)quickCheckUnicodeNormalization;
 + (int)quickPasteBytesPerCall;
 + (double)quickPasteDelayBetweenCalls;
++ (BOOL)rasterizeBoxDrawingGlyphsInBatch;
++ (BOOL)rasterizeGlyphsAsynchronously;
++ (BOOL)receiveMultiServerMessagesInPlace;
++ (BOOL)recordInstantReplayInBackground;
++ (BOOL)reflowScrollbackInBackground;
 + (BOOL)remapModifiersWithoutEventTap;
 
 // Remember window positions? If off, lets the OS pick the window position. Smart window placement takes precedence over this.
@@ -254,19 +342,32 @@ extern NSString *const iTermAdvancedSettingsDidChange;
 + (BOOL)restrictSemanticHistoryPrefixAndSuffixToLogicalWindow;
 + (BOOL)requireCmdForDraggingText;
 + (BOOL)resetSGROnPrompt;
++ (BOOL)resolveSemanticHistoryPathsAsynchronously;
 + (BOOL)restoreWindowContents;
 + (BOOL)restoreWindowsWithinScreens;
 + (BOOL)retinaInlineImages;
++ (BOOL)reuseUnchangedMetalRows;
 + (BOOL)runJobsInServers;
++ (BOOL)runTriggersInBackground;
++ (int)sandboxedImageDecoderConnections;
 + (BOOL)saveToPasteHistoryWhenSecureInputEnabled;
++ (int)scpUploadConcurrency;
++ (int)scriptConsoleMemoryLimit;
 + (double)scrollWheelAcceleration;
 + (NSString *)searchCommand;
 + (BOOL)selectsTabsOnMouseDown;
 + (BOOL)sensitiveScrollWheel;
 + (BOOL)serializeOpeningMultipleFullScreenWindows;
++ (BOOL)serveReadOnlyAPIRequestsFromSnapshots;
++ (double)sessionMemoryAccountingInterval;
 + (BOOL)setCookie;
 + (void)setSetCookie:(BOOL)value;
 + (double)shortLivedSessionDuration;
++ (BOOL)sharedStatusBarUpdateScheduler;
++ (BOOL)sharedSystemMetricsSampler;
++ (BOOL)shareFontMetricsAcrossSessions;
++ (BOOL)shareGlyphAtlasAcrossSessions;
++ (BOOL)sharePipelineStatesAcrossSessions;
 + (BOOL)shouldSetLCTerminal;
 + (BOOL)showAutomaticProfileSwitchingBanner;
 + (BOOL)showBlockBoundaries;
@@ -292,6 +393,8 @@ extern NSString *const iTermAdvancedSettingsDidChange;
 + (double)smartCursorColorFgThreshold;
 + (int)smartSelectionRadius;
 + (BOOL)solidUnderlines;
++ (BOOL)spillScriptConsoleLogs;
++ (int)spillScrollbackAfterBlocks;
 + (BOOL)squareWindowCorners;
 + (NSString *)sshSchemePath;
 + (BOOL)sshURLsSupportPath;
@@ -299,19 +402,26 @@ extern NSString *const iTermAdvancedSettingsDidChange;
 + (double)statusBarHeight;
 + (BOOL)statusBarIcon;
 + (BOOL)stealKeyFocus;
++ (BOOL)storeCapturedOutputOutOfLine;
 + (BOOL)storeStateInSqlite;
++ (BOOL)streamSavedContents;
++ (BOOL)streamTerminalFileDownloads;
++ (BOOL)streamTmuxHistoryParsing;
 + (BOOL)supportDecsetMetaSendsEscape;
 + (BOOL)supportREPCode;
 + (BOOL)suppressMultilinePasteWarningWhenNotAtShellPrompt;
 + (BOOL)suppressMultilinePasteWarningWhenPastingOneLineWithTerminalNewline;
 + (BOOL)suppressRestartAnnouncement;
++ (BOOL)suspendPresentationForHiddenSessions;
 + (BOOL)swapFindNextPrevious;
 + (BOOL)synchronizeQueryWithFindPasteboard;
 + (void)setSuppressRestartAnnouncement:(BOOL)value;
 + (double)tabAutoShowHoldTime;
 + (double)tabFlashAnimationDuration;
++ (int)taskNotifierThreads;
 + (BOOL)tabsWrapAround;
 + (BOOL)tabTitlesUseSmartTruncation;
++ (BOOL)throttlePartialLineTriggers;
 + (BOOL)throttleMetalConcurrentFrames;
 + (double)timeBetweenBlinks;
 + (double)timeBetweenTips;
@@ -326,15 +436,20 @@ extern NSString *const iTermAdvancedSettingsDidChange;
 + (BOOL)tolerateUnrecognizedTmuxCommands;
 + (double)toolbeltFontSize;
 + (BOOL)trackingRunloopForLiveResize;
++ (BOOL)trackWorkingDirectoryByForegroundJob;
 + (BOOL)traditionalVisualBell;
 + (NSString *)trailingPunctuationMarks;
 + (BOOL)translateScreenToXterm;
 + (int)triggerRadius;
++ (BOOL)trimBackgroundSessionsUnderMemoryPressure;
 + (BOOL)trimWhitespaceOnCopy;
++ (int)typesetLineCacheCapacity;
 + (BOOL)typingClearsSelection;
 + (double)underlineCursorHeight;
 + (double)underlineCursorOffset;
 + (BOOL)underlineHyperlinks;
++ (double)unfocusedSessionsFrameBudget;
++ (BOOL)unicodePropertyTable;
 + (double)updateScreenParamsDelay;
 + (BOOL)useCustomTabBarFontSize;
 + (BOOL)useRestorableStateController;
@@ -344,14 +459,18 @@ extern NSString *const iTermAdvancedSettingsDidChange;
 + (BOOL)useAdaptiveFrameRate;
 + (BOOL)useBlackFillerColorForTmuxInFullScreen;
 + (BOOL)useColorfgbgFallback;
++ (BOOL)useColorMapLookupTables;
++ (BOOL)useDisplayLinkUpdateCadence;
 + (BOOL)useDivorcedProfileToSplit;
 + (BOOL)useExperimentalFontMetrics;
 + (BOOL)useGCDUpdateTimer;
++ (BOOL)useKqueueInTaskNotifier;
 
 #if ENABLE_LOW_POWER_GPU_DETECTION
 + (BOOL)useLowPowerGPUWhenUnplugged;
 #endif
 
++ (BOOL)useMetalColorTable;
 + (BOOL)useModernScrollWheelAccumulator;
 + (BOOL)useNewContentFormat;
 + (BOOL)useOldStyleDropDownViews;
@@ -360,13 +479,16 @@ extern NSString *const iTermAdvancedSettingsDidChange;
 + (BOOL)useUnevenTabs;
 + (BOOL)openProfilesInNewWindow;
 + (BOOL)vs16Supported;
++ (BOOL)warmPythonInterpreters;
 + (BOOL)workAroundBigSurBug;
 + (BOOL)workAroundMultiDisplayOSBug;
 + (BOOL)workAroundNumericKeypadBug;
 + (int)xtermVersion;
 + (CGFloat)verticalBarCursorWidth;
 + (NSString *)viewManPageCommand;
++ (BOOL)visibilityAwareUpdateCadence;
 + (BOOL)wrapFocus;
++ (BOOL)writeKeystrokesDirectly;
 + (BOOL)zeroWidthSpaceAdvancesCursor;
 + (BOOL)zippyTextDrawing;
 
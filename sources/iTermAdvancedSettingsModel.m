@@ -90,8 +90,14 @@ static inline id iTermAdvancedSettingsModelInverseTransformString(NSString *valu
 // default: The default value, such as YES or @"foo". Nonnil.
 // transformation: Name of a function (as a token) that converts podtype to id
 // inverseTransformation: Name of a function (as a token) that converts id to podtype
+//
+// The value is kept both as the object that came from user defaults and already transformed to
+// podtype. Getters only load the latter, so reading a setting costs one message send and never
+// touches an object, which also makes it safe to read scalar settings off the main thread while
+// they're being reloaded.
 #define DEFINE_BOILERPLATE(name, podtype, type, default, description, transformation, inverseTransformation) \
 static id sAdvancedSetting_##name; \
+static podtype sAdvancedSettingValue_##name; \
 + (NSDictionary *)advancedSettingsModelDictionary_##name { \
     return @{ kAdvancedSettingIdentifier: [@#name stringByCapitalizingFirstLetter], \
               kAdvancedSettingType: @(type), \
@@ -106,10 +112,11 @@ static id sAdvancedSetting_##name; \
     NSString *key = [self name##UserDefaultsKey]; \
     id valueFromUserDefaults = [[NSUserDefaults standardUserDefaults] objectForKey:key]; \
     sAdvancedSetting_##name = valueFromUserDefaults ?: inverseTransformation(default); \
+    sAdvancedSettingValue_##name = transformation(sAdvancedSetting_##name); \
     return key; \
 } \
 + (podtype)name { \
-    return transformation(sAdvancedSetting_##name); \
+    return sAdvancedSettingValue_##name; \
 }
 
 // See DEFINE_BOILERPLATE.
@@ -118,6 +125,7 @@ static id sAdvancedSetting_##name; \
 DEFINE_BOILERPLATE(name, podtype, type, default, description, transformation, inverseTransformation) \
 + (void)set##capitalizedName :(podtype)newValue { \
     sAdvancedSetting_##name = inverseTransformation(newValue); \
+    sAdvancedSettingValue_##name = transformation(sAdvancedSetting_##name); \
     [[NSUserDefaults standardUserDefaults] setObject:sAdvancedSetting_##name forKey:@#capitalizedName]; \
 }
 
@@ -632,6 +640,127 @@ DEFINE_BOOL(useNewContentFormat, YES, SECTION_EXPERIMENTAL @"Save unlimited amou
 DEFINE_BOOL(vs16Supported, NO, SECTION_EXPERIMENTAL @"Support variation selector 16 making emoji fullwidth?");
 DEFINE_BOOL(fastTrackpad, YES, SECTION_EXPERIMENTAL @"Trackpad scrolls fast?\nSet to No for legacy scrolling speed.");
 DEFINE_BOOL(supportDecsetMetaSendsEscape, YES_IF_BETA_ELSE_NO, SECTION_EXPERIMENTAL @"Support DECSET 1036?\nThis allows apps in the terminal to control whether the option key sends esc+ or acts like a regular option key.");
+DEFINE_BOOL(useKqueueInTaskNotifier, NO, SECTION_EXPERIMENTAL @"Use kqueue instead of select() to wait for session input and output.\nThis scales better when many sessions are open. You must restart iTerm2 after changing this setting.");
+DEFINE_NONNEGATIVE_INT(taskNotifierThreads, 1, SECTION_EXPERIMENTAL @"Number of threads that read from sessions.\nSessions are spread evenly over these threads so one that produces a lot of output can’t delay the others. Set to 0 to use one thread per performance core. You must restart iTerm2 after changing this setting.");
+DEFINE_BOOL(coalesceTokenExecution, NO, SECTION_EXPERIMENTAL @"Coalesce session output before executing it on the main thread.\nWhen the main thread falls behind, output that arrives in the meantime is executed together in one pass instead of one pass per read. This leaves more time for handling keyboard and mouse events when several sessions are busy.");
+DEFINE_BOOL(compactScrollback, NO, SECTION_EXPERIMENTAL @"Store scrollback history in a compact format.\nHistory that has scrolled out of the newest block is stored as character codes plus runs of identical attributes, which usually takes a fraction of the memory. It is expanded again when it is next accessed.");
+DEFINE_NONNEGATIVE_INT(compressScrollbackAfterBlocks, 0, SECTION_EXPERIMENTAL @"Compress all but this many of the newest blocks of scrollback history.\nOlder history is compressed in the background and decompressed when it is scrolled to or searched. Set to 0 to disable.");
+DEFINE_NONNEGATIVE_INT(spillScrollbackAfterBlocks, 0, SECTION_EXPERIMENTAL @"With unlimited scrollback, move all but this many of the newest blocks of history to a temporary file.\nThe file is memory-mapped, so old history costs disk space instead of memory. Set to 0 to disable.");
+DEFINE_BOOL(parallelScrollbackSearch, NO, SECTION_EXPERIMENTAL @"Search scrollback history on several threads at once.\nWhen finding all matches, a batch of blocks of history is searched concurrently during each step of the search, so large scrollback buffers are searched in fewer steps.");
+DEFINE_BOOL(indexScrollbackForSearch, NO, SECTION_EXPERIMENTAL @"Keep an index of scrollback history to speed up Find.\nEach block of history remembers which three-letter sequences it contains, so searches for plain text skip blocks that can’t match. Uses about 2 KB per 8 KB block of history. You must restart iTerm2 after changing this setting.");
+DEFINE_BOOL(incrementalFindOnPage, NO, SECTION_EXPERIMENTAL @"Update Find results incrementally as output arrives.\nWhile the find bar is open, only text added since the last update is searched, and results that have scrolled out of history are discarded instead of accumulating.");
+DEFINE_BOOL(prefilterTriggers, NO, SECTION_EXPERIMENTAL @"Check all triggers against each line in a single pass.\nA literal that every match of a trigger’s regular expression must contain is found ahead of time, and one scan of the line finds which triggers could match. Only those triggers run their regular expressions.");
+DEFINE_BOOL(runTriggersInBackground, NO, SECTION_EXPERIMENTAL @"Match triggers against finished lines on a background queue.\nActions still run on the main thread in the order lines were finished. This is only used when no enabled trigger is a partial-line trigger or needs the cursor position at the moment the line ends, such as Capture Output, Set Mark, Prompt Detected, Report Directory, and Report Host.");
+DEFINE_BOOL(throttlePartialLineTriggers, NO, SECTION_EXPERIMENTAL @"Check partial-line triggers only when new text could change the outcome.\nA partial line that hasn’t changed isn’t checked again, and only triggers whose required text appears in it are run. Checks happen less often while output is arriving quickly. Finished lines are always checked.");
+DEFINE_BOOL(reuseUnchangedMetalRows, NO, SECTION_EXPERIMENTAL @"Reuse unchanged rows when drawing with Metal.\nA row whose text, selection, and highlights are the same as in the previous frame is copied instead of being rebuilt, so a blinking cursor or a change to a single line is cheap to draw.");
+DEFINE_BOOL(useMetalColorTable, NO, SECTION_EXPERIMENTAL @"Resolve cell colors through a per-frame table when drawing with Metal.\nEach palette color is looked up in the color map once per frame instead of once per run of cells, and 24-bit colors are computed directly.");
+DEFINE_BOOL(shareGlyphAtlasAcrossSessions, NO, SECTION_EXPERIMENTAL @"Share rendered glyphs among sessions that use the same fonts when drawing with Metal.\nNon-ASCII glyphs are drawn once per process instead of once per session, which saves GPU memory and lets new tabs draw without rendering them again.");
+DEFINE_BOOL(rasterizeGlyphsAsynchronously, NO, SECTION_EXPERIMENTAL @"Don’t wait for new glyphs to be rendered before drawing a frame with Metal.\nA non-ASCII character drawn for the first time appears as an empty cell for one frame, and the screen is redrawn once it’s ready. This keeps a screen full of new CJK or emoji from delaying a frame.");
+DEFINE_BOOL(cacheGlyphsOnDisk, NO, SECTION_EXPERIMENTAL @"Save rendered ASCII glyphs to disk for the next launch.\nWith Metal, the first window in each font has to render every ASCII character before it can draw. When this is on the results are kept in ~/Library/Caches and reused as long as the font, its size, and the macOS and iTerm2 versions haven’t changed.");
+DEFINE_SETTABLE_BOOL(measureMetalLatency, MeasureMetalLatency, NO, SECTION_EXPERIMENTAL @"Measure keystroke-to-screen and output-to-screen latency with Metal.\nHistograms, along with GPU and per-renderer encode times, are available to Python scripts through the session method iterm2.get_metal_stats() and are included in Metal frame captures.");
+DEFINE_BOOL(metalPartialRedraw, NO, SECTION_EXPERIMENTAL @"With Metal, redraw only the rows that changed.\nThe previous frame is kept in a texture and only the changed rows (plus the cursor’s old and new rows) are drawn over it, which saves GPU power for small updates like typing. Transparent windows, indicators, timestamps, and other screen-wide effects fall back to a full redraw.");
+DEFINE_BOOL(metalParallelPopulate, NO, SECTION_EXPERIMENTAL @"With Metal, build background color and text geometry concurrently.\nThe background color renderer’s per-cell data is prepared on a second core while the text renderer looks up glyphs, which shortens frame preparation for large sessions.");
+DEFINE_BOOL(visibilityAwareUpdateCadence, NO, SECTION_EXPERIMENTAL @"Throttle redraws of sessions nobody is looking at.\nSessions in windows that are completely covered or on an inactive Space update once a second. Visible sessions other than the focused one share a single frame budget, while the focused session keeps its full frame rate. Modifications to this setting will not affect existing sessions.");
+DEFINE_FLOAT(unfocusedSessionsFrameBudget, 60.0, SECTION_EXPERIMENTAL @"Total frame rate (FPS) shared by visible sessions that aren’t focused.\nOnly used when throttling redraws of sessions nobody is looking at is enabled. The focused session is not affected.");
+DEFINE_BOOL(useDisplayLinkUpdateCadence, NO, SECTION_EXPERIMENTAL @"Synchronize screen updates with the display’s refresh.\nUpdates happen right after a refresh of the display the window is on instead of on a free-running timer. While typing or with light output, sessions update on every refresh (up to 120 times a second on a ProMotion display); otherwise refreshes are skipped to match the normal frame rate. Modifications to this setting will not affect existing sessions.");
+DEFINE_INT(typesetLineCacheCapacity, 0, SECTION_EXPERIMENTAL @"Number of typeset text runs to keep when not using Metal.\nWhen positive, typeset runs are kept in a least-recently-used cache of this size rather than only until the next redraw, so small redraws like a blinking cursor and scrolling back to earlier text don’t typeset the same runs again. 0 disables the cache. Modifications to this setting will not affect existing sessions.");
+DEFINE_BOOL(decodeSixelAsynchronously, NO, SECTION_EXPERIMENTAL @"Decode sixel images in the background.\nWhen a sixel image declares its size, space for it is reserved right away and the image appears when decoding finishes, so large images don’t freeze the session.");
+DEFINE_BOOL(asynchronousInlineImages, NO, SECTION_EXPERIMENTAL @"Decode and scale inline images in the background.\nBase64 image data is decoded as it arrives, images whose size in cells is fully specified without preserving the aspect ratio are decoded in the background, and every image is scaled to its on-screen size in the background so scrolling doesn’t stall on the first draw.");
+DEFINE_INT(inlineImageMemoryBudget, 0, SECTION_EXPERIMENTAL @"Megabytes of decoded inline images to keep in memory.\nWhen decoded images need more than this, the ones that haven’t been drawn recently keep only their original compressed data and are decoded again when they scroll back into view. 0 means no limit.");
+DEFINE_BOOL(animatedImageTextureArrays, NO, SECTION_EXPERIMENTAL @"Keep all frames of an animated image in one GPU texture.\nThe Metal renderer uploads an animated GIF once and picks the frame on the GPU instead of uploading a new texture each time the frame changes.");
+DEFINE_BOOL(rasterizeBoxDrawingGlyphsInBatch, NO, SECTION_EXPERIMENTAL @"Rasterize all box-drawing and Powerline glyphs at once.\nWhen the Metal renderer starts using a new font or cell size it draws every box-drawing, block element, and Powerline glyph in one batch after the first frame, so TUI borders don’t trickle in one character at a time.");
+DEFINE_BOOL(useColorMapLookupTables, NO, SECTION_EXPERIMENTAL @"Process text colors with lookup tables when drawing with Metal.\nPalette colors adjusted for dimming and muting are kept in a table that is rebuilt only when the colors change, and other text colors are processed without creating NSColor objects.");
+DEFINE_BOOL(cacheMinimumContrastColors, NO, SECTION_EXPERIMENTAL @"Cache minimum-contrast adjustments of text colors.\nWhen minimum contrast is on, remember the adjusted color for recently seen text and background color pairs so truecolor text isn’t recomputed on every redraw.");
+DEFINE_BOOL(mergeBackgroundColorRunsAcrossRows, NO, SECTION_EXPERIMENTAL @"Merge identical background color runs in adjacent rows.\nSolid panels drawn by full-screen apps become one quad each instead of one per row.");
+DEFINE_BOOL(persistSubpixelModels, NO, SECTION_EXPERIMENTAL @"Save subpixel antialiasing models between launches.\nThe models the text renderer needs are loaded from disk instead of being drawn and measured on the first frame.");
+DEFINE_BOOL(decodeTmuxOutputInParser, NO, SECTION_EXPERIMENTAL @"Decode tmux %output notifications as they are parsed.\nThe pane and payload are read straight from the incoming bytes instead of making a string of each line and parsing it again.");
+DEFINE_BOOL(perPaneTmuxWriteQueues, NO, SECTION_EXPERIMENTAL @"Give each tmux pane its own queue for output.\nA pane that is slow to consume its output won't delay output for the other panes.");
+DEFINE_BOOL(streamTmuxHistoryParsing, NO, SECTION_EXPERIMENTAL @"Parse tmux history one line at a time.\nLowers memory use and parsing time when attaching to panes with long histories.");
+DEFINE_BOOL(pipelineTmuxCommands, NO, SECTION_EXPERIMENTAL @"Batch tmux commands and share identical polling requests.\nCommands sent together are written at once, and a status bar or option query that is already waiting for a response isn't sent again.");
+DEFINE_BOOL(prioritizeTmuxUnpausing, NO, SECTION_EXPERIMENTAL @"When unpausing tmux panes automatically, unpause visible panes first.\nPanes in the background are unpaused together, and later each time they fill up again quickly, so busy hidden panes don't slow down the one you're using.");
+DEFINE_BOOL(cacheTmuxHistory, NO, SECTION_EXPERIMENTAL @"Save tmux pane history on disk so reattaching fetches only recent lines.\nThe saved history is combined with the most recent lines if they overlap. Otherwise the full history is fetched as usual.");
+DEFINE_BOOL(coalesceTmuxLayoutChanges, NO, SECTION_EXPERIMENTAL @"Coalesce bursts of tmux layout changes and resize only the panes that changed.\nLayout changes for a window are applied once per pass of the run loop, before any other tmux notification is handled.");
+DEFINE_BOOL(eagerlyReadMultiServerChildReports, NO, SECTION_EXPERIMENTAL @"Read the session daemon's list of running jobs without waiting for a readiness event per job.\nThis makes restoring many sessions at login faster.");
+DEFINE_BOOL(receiveMultiServerMessagesInPlace, NO, SECTION_EXPERIMENTAL @"Receive messages from the session daemon directly into their final buffer.\nThis avoids allocating and copying a temporary buffer for each read.");
+DEFINE_BOOL(pipelineTaskWrites, NO, SECTION_EXPERIMENTAL @"Write pastes to the shell as fast as it accepts them.\nLarge writes are coalesced and pastes wait for the shell (or every session receiving broadcast input) to catch up instead of pausing between chunks.");
+DEFINE_BOOL(serveReadOnlyAPIRequestsFromSnapshots, NO, SECTION_EXPERIMENTAL @"Answer repeated read-only Python API requests without waiting for the main thread.\nGetBuffer, GetProperty, ListSessions, and variable lookups are answered from the previous response when nothing has changed since, so scripts that poll don't compete with drawing and keyboard input.");
+DEFINE_BOOL(compressLargeAPIMessages, NO, SECTION_EXPERIMENTAL @"Compress large Python API messages.\nWhen a script's websocket library offers permessage-deflate, messages over 4 KB, such as GetBuffer responses, are sent compressed. Takes effect for new connections.");
+DEFINE_BOOL(batchInterpolatedStringEvaluation, NO, SECTION_EXPERIMENTAL @"Batch reevaluation of interpolated strings.\nInvalidated interpolated strings, such as session titles and badges, are reevaluated together once per pass through the run loop, in dependency order, with at most one pending evaluation per string.");
+DEFINE_BOOL(cacheParsedExpressions, NO, SECTION_EXPERIMENTAL @"Cache parsed expressions in interpolated strings.\nExpressions in interpolated strings such as titles, badges, and status bar components are parsed once and reused, rather than parsed every time they are evaluated.");
+DEFINE_BOOL(cacheVariableScopeLookups, NO, SECTION_EXPERIMENTAL @"Cache variable lookups.\nRemembers which set of variables each variable name in an interpolated string resolves to, rather than searching for it on every evaluation.");
+DEFINE_BOOL(sharedStatusBarUpdateScheduler, NO, SECTION_EXPERIMENTAL @"Update status bar components on shared ticks.\nOne timer updates all status bar components, grouping those with the same update interval. Components that are not on screen are not updated until they reappear, and the status bar is laid out again only when a component’s size changes.");
+DEFINE_BOOL(sharedSystemMetricsSampler, NO, SECTION_EXPERIMENTAL @"Sample CPU, memory, and network use together.\nOne background timer takes all system measurements for status bar components and scripts instead of each having its own timer.");
+DEFINE_BOOL(incrementalProcessCacheUpdates, NO, SECTION_EXPERIMENTAL @"Update the process cache incrementally.\nInstead of examining every process on the system to find sessions’ jobs, only the process trees of sessions are examined. When low-latency foreground job updates are enabled, only trees that reported a fork, exec, signal, or exit are examined again.");
+DEFINE_BOOL(batchPidInfoQueries, NO, SECTION_EXPERIMENTAL @"Batch process info queries.\nRequests for the working directories of several processes made at about the same time are sent to the process info service as one message.");
+DEFINE_BOOL(trackWorkingDirectoryByForegroundJob, NO, SECTION_EXPERIMENTAL @"Look up the working directory only when it could have changed.\nThe working directory of a session's process is cached and shared with other sessions having the same process until a key is pressed or the foreground job changes. Keystrokes are ignored once shell integration reports the directory.");
+DEFINE_BOOL(gitStateFromFileSystemEvents, NO, SECTION_EXPERIMENTAL @"Recompute git status only when a repository changes.\nEach repository that a session is in is watched with FSEvents, and its git state is shared by all sessions in it until a file changes.");
+DEFINE_BOOL(cacheProcessArguments, NO, SECTION_EXPERIMENTAL @"Cache the command lines of jobs.\nA job's arguments are reused for a few seconds instead of being fetched every time a title or status bar component needs them, and job lookups run in parallel.");
+DEFINE_BOOL(parallelSessionRestoration, NO, SECTION_EXPERIMENTAL @"Decode restored scrollback in parallel.\nWhen windows are restored at launch, scrollback is decoded on background threads while windows are created, and the window that was key is created first.");
+DEFINE_BOOL(lazyScrollbackRestoration, NO, SECTION_EXPERIMENTAL @"Restore scrollback lazily.\nWhen a session is restored, older scrollback is kept in its saved form until it is first drawn or searched. This makes restoration faster and uses less memory when there is a lot of history.");
+DEFINE_BOOL(checkpointStateDatabaseInBackground, NO, SECTION_EXPERIMENTAL @"Checkpoint the saved state database in the background.\nSaving window state does not wait for its database to be flushed to disk, and space left by deleted state is reclaimed gradually.");
+DEFINE_BOOL(compactInstantReplayFrames, NO, SECTION_EXPERIMENTAL @"Store instant replay frames compactly.\nOnly the changed parts of each line are recorded and key frames are compressed, so the same amount of memory holds much more history. Instant replay saved this way can't be read by versions without this setting.");
+DEFINE_BOOL(recordInstantReplayInBackground, NO, SECTION_EXPERIMENTAL @"Record instant replay in the background.\nScreen updates hand a copy of the screen to a background queue for instant replay to encode instead of encoding it themselves.");
+DEFINE_BOOL(fastInstantReplaySeeking, NO, SECTION_EXPERIMENTAL @"Seek instant replay faster.\nFrames are found by binary search, scrubbing forward continues from the frame on screen, and key frames are added when replaying the changes since the last one would cost more than decoding a new one.");
+DEFINE_BOOL(flatIntervalTreeQueries, NO, SECTION_EXPERIMENTAL @"Index marks and annotations in a flat array.\nFinding the marks and annotations in a range of lines, which happens while drawing, searches a compact sorted array instead of a tree of objects.");
+DEFINE_BOOL(bulkRemoveScrolledOffMarks, NO, SECTION_EXPERIMENTAL @"Remove marks and annotations that scroll off in one pass.\nWhen lines drop out of scrollback, the marks and annotations on them are removed together and the scrollbar is updated once rather than once per mark.");
+DEFINE_BOOL(indexCommandHistoryByPrefix, NO, SECTION_EXPERIMENTAL @"Index command history by prefix.\nCommand history lookups while typing use a sorted index and narrow the previous result instead of scanning all history, and saves of command history are batched.");
+DEFINE_BOOL(indexRecentDirectories, NO, SECTION_EXPERIMENTAL @"Index recent directories.\nRecent directories are kept in score order as they are used, so the directories popup and toolbelt don't sort them all each time, and the tree used to abbreviate them is built on first use instead of at launch.");
+DEFINE_BOOL(storeCapturedOutputOutOfLine, NO, SECTION_EXPERIMENTAL @"Keep captured output in a memory-mapped file.\nText captured by Capture Output triggers is packed into a temporary file instead of being kept as objects, and is read back when the Captured Output tool shows it.");
+DEFINE_BOOL(flatComplexCharTable, NO, SECTION_EXPERIMENTAL @"Look up combining characters in a flat table.\nDrawing and search find the string for a cell with combining marks, emoji, or surrogate pairs by indexing a table rather than through a dictionary.");
+DEFINE_BOOL(chunkedCopyOfLargeSelections, NO, SECTION_EXPERIMENTAL @"Copy very large selections in chunks.\nCopying a selection of millions of cells returns right away and the text is extracted a little at a time. If you paste before it’s done, the rest is extracted then. Such copies are not added to paste history.");
+DEFINE_BOOL(indexSubSelections, NO, SECTION_EXPERIMENTAL @"Index selections made of many pieces by line.\nWhen a selection has many separate parts, such as after selecting all find matches, drawing looks up only the parts on each line rather than checking every one.");
+DEFINE_BOOL(precompiledSmartSelectionRules, NO, SECTION_EXPERIMENTAL @"Compile smart selection rules ahead of time.\nRules are compiled once when they change and tried concurrently, and the result for the last click is remembered.");
+DEFINE_BOOL(resolveSemanticHistoryPathsAsynchronously, NO, SECTION_EXPERIMENTAL @"Resolve semantic history paths off the main thread.\nWhen you cmd-hover or cmd-click a filename, cleaning up the path and checking that it exists happen in the background, and whether paths are on network mounts is remembered briefly.");
+DEFINE_BOOL(incrementalAccessibilityText, NO, SECTION_EXPERIMENTAL @"Update the text exposed to accessibility incrementally.\nWhen an accessibility client such as VoiceOver is attached, only lines that changed are converted again, and queries made between updates reuse the last result.");
+DEFINE_BOOL(diskBackedPasteHistory, NO, SECTION_EXPERIMENTAL @"Keep large paste history entries in compressed files on disk.\nLarge entries are loaded only when used, so they don't occupy memory or get rewritten every time the paste history is saved. Applies only when paste history is saved to disk.");
+DEFINE_BOOL(adaptivePasteThroughput, NO, SECTION_EXPERIMENTAL @"Adjust paste speed to how quickly the remote end keeps up.\nRegular pastes grow their chunks while input is echoed promptly and back off when the pty can't accept more. Bracketed pastes are sent as fast as the pty accepts them. Slow pastes and pastes that wait for a prompt are unaffected.");
+DEFINE_BOOL(broadcastInputOnBackgroundQueue, NO, SECTION_EXPERIMENTAL @"Write broadcast input to sessions from a background queue.\nInput is encoded once per distinct encoding instead of once per session, which keeps typing responsive when broadcasting to many sessions.");
+DEFINE_BOOL(indexCopyModeMotions, NO, SECTION_EXPERIMENTAL @"Use an index of blank lines to speed up word motions in copy mode.\nWord motions skip runs of blank lines in one step instead of reading them cell by cell.");
+DEFINE_BOOL(minimapDrawsByRow, NO, SECTION_EXPERIMENTAL @"Draw the search results minimap one row at a time.\nThe minimap next to the scroll bar asks for the first match in each row it draws instead of visiting every match, so it stays fast with tens of thousands of matches.");
+DEFINE_FLOAT(sessionMemoryAccountingInterval, 10, SECTION_EXPERIMENTAL @"Seconds between updates of each session’s memory usage.\nThe total is published in the session.memoryUsage variable and the breakdown is available from the iterm2.get_memory_usage() session method. Set to 0 to disable.");
+DEFINE_BOOL(trimBackgroundSessionsUnderMemoryPressure, NO, SECTION_EXPERIMENTAL @"Free memory in background sessions when the system is low on memory.\nSessions in tabs that aren’t visible lose their instant replay history and have their scrollback compressed, and decoded inline images that haven’t been drawn recently are discarded. You must restart iTerm2 for this change to take effect.");
+DEFINE_INT(memoryPressureScrollbackFloor, 2, SECTION_EXPERIMENTAL @"Number of newest scrollback blocks to leave uncompressed when trimming background sessions under memory pressure.\nOnly used when trimming background sessions under memory pressure is enabled.");
+DEFINE_INT(floodModeThreshold, 0, SECTION_EXPERIMENTAL @"Megabytes per second of output at which a session enters flood mode.\nIn flood mode a session redraws at the flood mode frame rate and puts off partial-line triggers, instant replay frames, and accessibility notifications until output slows to half this rate. 0 disables flood mode. Modifications to this setting will not affect existing sessions.");
+DEFINE_FLOAT(floodModeFrameRate, 4, SECTION_EXPERIMENTAL @"Frames per second to draw a session in flood mode.");
+DEFINE_BOOL(bulkAppendScrollingOutput, NO, SECTION_EXPERIMENTAL @"Append long runs of plain scrolling output directly to scrollback.\nWhen more than a screenful of plain text lines arrives at once, only the final screen is built. Not used in sessions with triggers.");
+DEFINE_BOOL(writeKeystrokesDirectly, NO, SECTION_EXPERIMENTAL @"Write keystrokes to the shell immediately.\nWhen nothing else is waiting to be sent, a keystroke is written as soon as it is mapped instead of waiting for the I/O thread to wake up.");
+DEFINE_BOOL(indexKeyMappings, NO, SECTION_EXPERIMENTAL @"Look up key bindings in a precompiled table.\nEach profile's key mappings are indexed once instead of being searched by string on every keystroke.");
+DEFINE_BOOL(incrementalDynamicProfileReload, NO, SECTION_EXPERIMENTAL @"Reload only dynamic profiles that changed.\nFiles are read in the background and only parsed when their contents change. Profiles that come out the same are not replaced, and nothing is announced if no profile changed.");
+DEFINE_BOOL(cacheProfileFiltering, NO, SECTION_EXPERIMENTAL @"Speed up searching long profile lists.\nEach profile's name and tags are split into words once, and typing more of a search only rechecks profiles that matched before.");
+DEFINE_BOOL(narrowOpenQuicklyResults, NO, SECTION_EXPERIMENTAL @"Speed up Open Quickly as you type.\nWhen the search grows by adding to the end, windows, profiles, and other items that didn't match before are not checked again.");
+DEFINE_BOOL(bitParallelSubsequenceMatching, NO, SECTION_EXPERIMENTAL @"Use a faster matcher for Open Quickly.\nMatches are found with bit masks instead of lists of positions, and highlights are computed only for the text that gets shown.");
+DEFINE_BOOL(prebuildPreferencesSearchIndex, NO, SECTION_EXPERIMENTAL @"Prepare Settings search in the background.\nThe search index is built all at once on a background queue when the Settings window opens, so the first search doesn't pause.");
+DEFINE_BOOL(indexAutomaticProfileSwitchingRules, NO, SECTION_EXPERIMENTAL @"Index automatic profile switching rules.\nRules are grouped by the hostname or username they require so that each prompt checks only the rules that could match, and results are remembered until a profile changes.");
+DEFINE_BOOL(coalescePreferenceChangeNotifications, NO, SECTION_EXPERIMENTAL @"Announce settings changes in batches.\nWhen many settings change at once, as when importing settings, windows and tabs are told about all of them together instead of once per setting.");
+DEFINE_BOOL(sharePipelineStatesAcrossSessions, NO, SECTION_EXPERIMENTAL @"Share GPU renderer setup between sessions.\nCompiled render pipelines are reused by every session, so new tabs and split panes using the GPU renderer start drawing sooner.");
+DEFINE_BOOL(progressiveArrangementRestoration, NO, SECTION_EXPERIMENTAL @"Show windows one at a time when opening a saved arrangement.\nEach window of a multi-window arrangement appears and starts its jobs while the rest are still being created, and the job server is started before the first window is built.");
+DEFINE_BOOL(deferNonCriticalStartupWork, NO, SECTION_EXPERIMENTAL @"Defer work that the first window doesn’t need at launch.\nBuilding the Scripts, Toolbelt and arrangement menus and launch-time checks wait until windows are open and the app is idle. The launch timeline is shown in Show Performance Counters either way.");
+DEFINE_BOOL(warmPythonInterpreters, NO, SECTION_EXPERIMENTAL @"Keep Python interpreters ready for simple scripts.\nAfter a simple (non-full-environment) script runs, two interpreters stay in the background with the iterm2 module already imported, so the next script started from a key binding, trigger or menu begins running almost immediately.");
+DEFINE_BOOL(prioritizeVisibleTriggerCommands, NO, SECTION_EXPERIMENTAL @"Run commands from visible tabs’ triggers first.\nWhen the maximum number of Run Command triggers are already running, commands from sessions in visible tabs start before those from hidden tabs.");
+DEFINE_BOOL(shareFontMetricsAcrossSessions, NO, SECTION_EXPERIMENTAL @"Share measured fonts between sessions.\nCell size, baseline and underline offsets, and bold and italic variants are computed once per font and size and reused, so opening a session with a font that’s already in use does no font work.");
+DEFINE_BOOL(batchSplitPaneLayout, NO, SECTION_EXPERIMENTAL @"Batch split pane resizes.\nWhen a tab with split panes is resized, each pane’s new size is computed from the final layout and applied once, and running programs are told about the new size once it stops changing instead of several times a second during a live resize.");
+DEFINE_BOOL(reflowScrollbackInBackground, NO, SECTION_EXPERIMENTAL @"Reflow long histories in the background when resizing.\nWhen a session with a lot of scrollback that may contain double-width characters changes width, its lines are rewrapped on background threads. The old layout stays on screen, and output keeps being processed, until the new one is ready.");
+DEFINE_BOOL(suspendPresentationForHiddenSessions, NO, SECTION_EXPERIMENTAL @"Suspend drawing in sessions nobody can see.\nSessions in background tabs and in minimized or fully covered windows stop drawing, rendering badges, and polling status bar components. Output, triggers, and scripts keep running, and the session is redrawn once when it becomes visible.");
+DEFINE_BOOL(fuseAttributedRuns, NO, SECTION_EXPERIMENTAL @"Append syntax-highlighted text in one pass.\nWhen output alternates between color changes and short runs of text, the text is colored as it goes and added to the screen all at once instead of one run at a time. Not used in sessions with triggers.");
+DEFINE_BOOL(unicodePropertyTable, NO, SECTION_EXPERIMENTAL @"Look up character widths in a table.\nWhether a character is double width, ignorable, a spacing combining mark, or has an emoji or text presentation is found by indexing a table instead of searching character sets. This speeds up output and drawing of non-ASCII text.");
+DEFINE_BOOL(quickCheckUnicodeNormalization, NO, SECTION_EXPERIMENTAL @"Skip Unicode normalization of text it can't change.\nWhen a profile normalizes Unicode, text made only of characters that normalization leaves alone, like ASCII, CJK ideographs, and box drawing characters, is used as-is.");
+DEFINE_BOOL(streamTerminalFileDownloads, NO, SECTION_EXPERIMENTAL @"Decode files downloaded with it2dl as they arrive.\nThe file is decoded and written to disk in the background while it's received, instead of being kept in memory and decoded when the download ends.");
+DEFINE_INT(scpUploadConcurrency, 1, SECTION_EXPERIMENTAL @"Number of files to upload over scp at once.\nWhen more than one file is dropped for upload, they are split among this many connections. The extra connections are made once the first one succeeds, so the host only needs to be trusted once, but each connection authenticates separately.");
+DEFINE_INT(sandboxedImageDecoderConnections, 1, SECTION_EXPERIMENTAL @"Number of images to decode at once.\nImages are decoded in a sandboxed helper. With more than one connection to it, a burst of images or sixels is decoded in parallel instead of one after another.");
+DEFINE_BOOL(copyOnWriteGridSnapshots, NO, SECTION_EXPERIMENTAL @"Share memory between copies of the screen until one of them changes.\nSynchronized updates and the alternate screen copy the whole screen. With this on, large screens are copied by remapping their pages, and a page is duplicated only when it is first written to.");
+DEFINE_BOOL(copyOnWriteLineBlocks, NO, SECTION_EXPERIMENTAL @"Share the newest block of scrollback between copies of it until one of them changes.\nCopies of scrollback are made for the alternate screen, search, and saving state. With this on, making one doesn't copy anything, and a block shared with a copy is duplicated before it is modified.");
+DEFINE_BOOL(coalesceTabBarUpdates, NO, SECTION_EXPERIMENTAL @"Lay out the tab bar at most once per pass through the run loop.\nNormally every change to a tab's title, icon, or activity indicator lays out all the tabs right away, which adds up in windows with many busy tabs.");
+DEFINE_INT(scriptConsoleMemoryLimit, 0, SECTION_EXPERIMENTAL @"Kilobytes each of output and of API calls the Script Console keeps in memory for each script.\nWhen nonzero, API calls are also formatted only while the console is showing them. 0 keeps the last 1000 lines of output and 100 calls regardless of their size.");
+DEFINE_BOOL(spillScriptConsoleLogs, NO, SECTION_EXPERIMENTAL @"Save Script Console output and API calls that no longer fit in memory to compressed files.\nFiles go in the ScriptLogs folder in iTerm2's Application Support directory. Has no effect unless the Script Console memory limit is set.");
+DEFINE_BOOL(coalesceInternalNotifications, NO, SECTION_EXPERIMENTAL @"Deliver internal notifications that support it, such as session contents changes, once per pass through the run loop.\nRepeated changes before then are merged into one notification.");
+DEFINE_BOOL(fairShareTokenExecution, NO, SECTION_EXPERIMENTAL @"Share main thread time fairly among sessions producing output.\nRequires coalescing session output. Sessions take turns executing a limited amount of output, with the session you just typed in going first and then the active one. Each pass is kept short so keyboard and mouse events are handled promptly even while several sessions are flooding.");
+DEFINE_BOOL(batchSessionLogWrites, NO, SECTION_EXPERIMENTAL @"Batch writes to session logs.\nOutput is collected in memory and written to the log file in large chunks at least every quarter second. Plain-text logs are converted to text by the writer. This helps when logging to a slow disk, such as a network home directory.");
+DEFINE_BOOL(prefilterExpectations, NO, SECTION_EXPERIMENTAL @"Check all pending expectations against each line in a single pass.\nExpectations are used by tmux integration, the shell integration installer, and scripts. Like prefiltering triggers, one scan of the line finds which expectations could match, and only those run their regular expressions.");
+DEFINE_BOOL(launchJobsWithPosixSpawn, NO, SECTION_EXPERIMENTAL @"Start new sessions with posix_spawn instead of fork.\nApplies when jobs run in servers. Forking a server that already runs many sessions copies its page tables, so opening many tabs at once slows down as they accumulate. Takes effect for servers started after changing this. Falls back to fork if posix_spawn fails.");
+DEFINE_BOOL(streamSavedContents, NO, SECTION_EXPERIMENTAL @"Save Contents writes plain text a chunk at a time.\nThe window stays responsive while a long history is saved and the whole text is never held in memory at once. Does not affect saving as RTF.");
+DEFINE_BOOL(cancelableCmdHoverURLLookup, NO, SECTION_EXPERIMENTAL @"Look up ⌘-hover links without holding up the mouse.\nEach move cancels the previous lookup, the lookup yields to other events between steps, and results are reused until the text under them changes.");
+DEFINE_BOOL(deduplicateScrollback, NO, SECTION_EXPERIMENTAL @"Share identical blocks of compact scrollback between sessions.\nWhen many sessions show the same output, such as a command broadcast to identical hosts, blocks with the same contents are stored once. Requires storing scrollback in a compact format. Takes effect after restarting iTerm2.");
+DEFINE_BOOL(attachNoteViewsLazily, NO, SECTION_EXPERIMENTAL @"Only create views for annotations near the visible area.\nSessions with thousands of annotations, for example from an annotate trigger on a busy log, scroll smoothly. Takes effect for new sessions.");
 
 #pragma mark - Scripting
 #define SECTION_SCRIPTING @"Scripting: "
@@ -664,6 +793,7 @@ DEFINE_SETTABLE_BOOL(setCookie, SetCookie, NO, SECTION_SCRIPTING @"Set ITERM2_CO
 + (void)updateSettingsForUnitTestsIfNeeded {
     if ([NSApp isRunningUnitTests]) {
         sAdvancedSetting_runJobsInServers = @NO;
+        sAdvancedSettingValue_runJobsInServers = NO;
     }
 }
 
@@ -16,6 +16,7 @@
 @property(nonatomic, readonly) int currentFrame;  // Use frameForTimestamp: for more predictable behavior
 @property(nonatomic, readonly) NSImage *currentImage;
 @property(nonatomic) BOOL paused;
+@property(nonatomic, readonly) int numberOfFrames;
 
 - (instancetype)initWithImage:(iTermImage *)image;
 - (NSImage *)imageForFrame:(int)frame;
@@ -61,6 +61,10 @@
     return _image.images[self.currentFrame];
 }
 
+- (int)numberOfFrames {
+    return (int)_image.images.count;
+}
+
 - (NSImage *)imageForFrame:(int)frame {
     return _image.images[frame];
 }
@@ -54,6 +54,7 @@
 #import "iTermLaunchServices.h"
 #import "iTermLoggingHelper.h"
 #import "iTermLSOF.h"
+#import "iTermMemoryPressurePolicy.h"
 #import "iTermMenuBarObserver.h"
 #import "iTermMigrationHelper.h"
 #import "iTermModifierRemapper.h"
@@ -71,6 +72,7 @@
 #import "iTermOrphanServerAdopter.h"
 #import "iTermPasswordManagerWindowController.h"
 #import "iTermPasteHelper.h"
+#import "iTermPerformanceCountersWindowController.h"
 #import "iTermPreciseTimer.h"
 #import "iTermPreferences.h"
 #import "iTermProfilesMenuController.h"
@@ -88,6 +90,7 @@
 #import "iTermRestorableSession.h"
 #import "iTermRemotePreferences.h"
 #import "iTermScriptsMenuController.h"
+#import "iTermStartupScheduler.h"
 #import "iTermSystemVersion.h"
 #import "iTermTipController.h"
 #import "iTermTipWindowController.h"
@@ -1059,6 +1062,7 @@ void TurnOnDebugLoggingAutomatically(void) {
         TurnOnDebugLoggingAutomatically();
     }
     DLog(@"applicationWillFinishLaunching:");
+    [[iTermStartupScheduler sharedInstance] mark:@"Will finish launching"];
 
     _globalScopeController = [[iTermGlobalScopeController alloc] init];
 
@@ -1067,7 +1071,12 @@ void TurnOnDebugLoggingAutomatically(void) {
     [iTermBuiltInFunctions registerStandardFunctions];
     
     [iTermMigrationHelper migrateApplicationSupportDirectoryIfNeeded];
-    [self buildScriptMenu:nil];
+    [iTermScriptConsole sharedInstance];
+    [[iTermStartupScheduler sharedInstance] deferTaskNamed:@"Build Scripts menu"
+                                                  priority:iTermStartupTaskPriorityHigh
+                                                     block:^{
+        [self.scriptsMenuController build];
+    }];
 
     // Fix up various user defaults settings.
     [iTermPreferences initializeUserDefaults];
@@ -1080,12 +1089,20 @@ void TurnOnDebugLoggingAutomatically(void) {
     // exists.
     [self updateProcessType];
 
-    [iTermToolbeltView populateMenu:toolbeltMenu];
+    [[iTermStartupScheduler sharedInstance] deferTaskNamed:@"Build Toolbelt menu"
+                                                  priority:iTermStartupTaskPriorityHigh
+                                                     block:^{
+        [iTermToolbeltView populateMenu:toolbeltMenu];
+    }];
 
     // Start tracking windows entering/exiting full screen.
     [iTermFullScreenWindowManager sharedInstance];
 
-    [self complainIfNightlyBuildIsTooOld];
+    [[iTermStartupScheduler sharedInstance] deferTaskNamed:@"Check nightly build age"
+                                                  priority:iTermStartupTaskPriorityLow
+                                                     block:^{
+        [self complainIfNightlyBuildIsTooOld];
+    }];
 
     // Set the Appcast URL and when it changes update it.
     [[iTermController sharedInstance] refreshSoftwareUpdateUserDefaults];
@@ -1115,6 +1132,7 @@ void TurnOnDebugLoggingAutomatically(void) {
 }
 
 - (void)applicationDidFinishLaunching:(NSNotification *)aNotification {
+    [[iTermStartupScheduler sharedInstance] mark:@"Did finish launching"];
     [iTermLaunchExperienceController applicationDidFinishLaunching];
     if (IsTouchBarAvailable()) {
         if (@available(macOS 10.12.2, *)) {
@@ -1158,8 +1176,12 @@ void TurnOnDebugLoggingAutomatically(void) {
             }
         });
     }
-    [self updateRestoreWindowArrangementsMenu:windowArrangements_ asTabs:NO fromDock:NO];
-    [self updateRestoreWindowArrangementsMenu:windowArrangementsAsTabs_ asTabs:YES fromDock:NO];
+    [[iTermStartupScheduler sharedInstance] deferTaskNamed:@"Build arrangement menus"
+                                                  priority:iTermStartupTaskPriorityHigh
+                                                     block:^{
+        [self updateRestoreWindowArrangementsMenu:windowArrangements_ asTabs:NO fromDock:NO];
+        [self updateRestoreWindowArrangementsMenu:windowArrangementsAsTabs_ asTabs:YES fromDock:NO];
+    }];
 
     // register for services
     [NSApp registerServicesMenuSendTypes:@[ NSPasteboardTypeString ]
@@ -1225,6 +1247,9 @@ void TurnOnDebugLoggingAutomatically(void) {
     }
     // This causes it to enable secure keyboard entry if needed.
     [iTermSecureKeyboardEntryController sharedInstance];
+    if ([iTermAdvancedSettingsModel trimBackgroundSessionsUnderMemoryPressure]) {
+        [iTermMemoryPressurePolicy sharedInstance];  // Begins listening for memory pressure.
+    }
     [iTermUserDefaults setIgnoreSystemWindowRestoration:[iTermAdvancedSettingsModel useRestorableStateController]];
 }
 
@@ -1443,6 +1468,7 @@ void TurnOnDebugLoggingAutomatically(void) {
         DLog(@"Launched in quiet mode. Return early.");
         // iTerm2 was launched with "open file" that turns off startup activities.
         [_untitledWindowStateMachine didFinishInitialization];
+        [[iTermStartupScheduler sharedInstance] didFinishCriticalStartup];
         return;
     }
     [[iTermController sharedInstance] setStartingUp:YES];
@@ -1492,6 +1518,7 @@ void TurnOnDebugLoggingAutomatically(void) {
     [PTYSession removeAllRegisteredSessions];
 
     [iTermLaunchExperienceController performStartupActivities];
+    [[iTermStartupScheduler sharedInstance] didFinishCriticalStartup];
 }
 
 - (void)createVersionFile {
@@ -1543,6 +1570,10 @@ void TurnOnDebugLoggingAutomatically(void) {
     [pboard setString:copyString forType:NSPasteboardTypeString];
 }
 
+- (IBAction)showPerformanceCounters:(id)sender {
+    [[iTermPerformanceCountersWindowController sharedInstance] showWindow:sender];
+}
+
 - (IBAction)checkForUpdatesFromMenu:(id)sender {
     [suUpdater checkForUpdates:(sender)];
 }
@@ -9,7 +9,9 @@
 #import "iTermAutomaticProfileSwitcher.h"
 #import "DebugLogging.h"
 #import "ITAddressBookMgr.h"
+#import "iTermAdvancedSettingsModel.h"
 #import "iTermRule.h"
+#import "iTermRuleIndex.h"
 #import "iTermScriptHistory.h"
 #import "iTermUserDefaults.h"
 #import "NSDictionary+iTerm.h"
@@ -260,6 +262,15 @@ static NSString *const kStackKey = @"Profile Stack";
                                                    job:(NSString *)job
                                                 sticky:(BOOL *)sticky
                                                  score:(double *)scorePtr {
+    if ([iTermAdvancedSettingsModel indexAutomaticProfileSwitchingRules]) {
+        iTermRuleIndex *index = [iTermRuleIndex indexForProfiles:[_delegate automaticProfileSwitcherAllProfiles]];
+        return [index highestScoringProfileForHostname:hostname
+                                              username:username
+                                                  path:path
+                                                   job:job
+                                                sticky:sticky
+                                                 score:scorePtr];
+    }
     // Construct a map from host binding to profile. This could be expensive with a lot of profiles
     // but it should be fairly rare for this code to run.
     NSMutableDictionary<NSString *, Profile *> *ruleToProfileMap = [NSMutableDictionary dictionary];
@@ -312,8 +323,12 @@ static NSString *const kStackKey = @"Profile Stack";
                             path:(NSString *)path
                              job:(NSString *)job {
     double highestScore = 0;
+    iTermRuleIndex *index = nil;
+    if ([iTermAdvancedSettingsModel indexAutomaticProfileSwitchingRules]) {
+        index = [iTermRuleIndex indexForProfiles:[_delegate automaticProfileSwitcherAllProfiles]];
+    }
     for (NSString *ruleString in candidate[KEY_BOUND_HOSTS]) {
-        iTermRule *rule = [iTermRule ruleWithString:ruleString];
+        iTermRule *rule = index ? [index ruleWithString:ruleString] : [iTermRule ruleWithString:ruleString];
         double score = [rule scoreForHostname:hostname username:username path:path job:job];
         highestScore = MAX(highestScore, score);
     }
@@ -78,7 +78,7 @@
 
 - (NSImage *)image {
     if (_fillColor && _stringValue && !NSEqualSizes(_viewSize, NSZeroSize) && !_image) {
-        _image = [[self freshlyComputedImage] retain];
+        _image = [[self cachedImage] retain];
     }
     return _image;
 }
@@ -92,6 +92,40 @@
     }
 }
 
+// Badges often go back to a string they had before (e.g., when the current directory changes back)
+// and sessions with the same profile tend to have identical badges, so images are shared by
+// everything that goes into drawing them. Getting the same image back also lets the Metal renderer
+// skip uploading it again.
+- (NSImage *)cachedImage {
+    if (![_stringValue length]) {
+        return nil;
+    }
+    static NSCache<NSString *, NSImage *> *cache;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        cache = [[NSCache alloc] init];
+        cache.countLimit = 32;
+    });
+    NSFont *font = [self.delegate badgeLabelFontOfSize:self.maximumPointSize];
+    NSString *key = [NSString stringWithFormat:@"%@\n%@\n%@\n%@\n%@ %@ %@\n%@",
+                     font.fontName,
+                     _fillColor,
+                     _backgroundColor,
+                     NSStringFromSize(self.maxSize),
+                     @(self.minimumPointSize),
+                     @(self.maximumPointSize),
+                     @([[NSScreen mainScreen] backingScaleFactor]),
+                     _stringValue];
+    NSImage *image = [cache objectForKey:key];
+    if (!image) {
+        image = [self freshlyComputedImage];
+        if (image) {
+            [cache setObject:image forKey:key];
+        }
+    }
+    return image;
+}
+
 // Compute the best point size and return a new image of the badge. Returns nil if the badge
 // is empty or zero pixels.r
 - (NSImage *)freshlyComputedImage {
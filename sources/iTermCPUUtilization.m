@@ -7,6 +7,7 @@
 
 #import "iTermCPUUtilization.h"
 #import "iTermPublisher.h"
+#import "iTermSystemMetricsSampler.h"
 
 #include <mach/mach.h>
 #include <mach/mach_init.h>
@@ -21,7 +22,7 @@ typedef struct {
 } iTermCPUTicks;
 
 
-@interface iTermCPUUtilization()<iTermPublisherDelegate>
+@interface iTermCPUUtilization()<iTermPublisherDelegate, iTermSystemMetric>
 @end
 
 @implementation iTermCPUUtilization {
@@ -72,7 +73,10 @@ typedef struct {
 }
 
 - (void)update {
-    iTermCPUTicks current = [self sample];
+    [self publishTicks:[self sample]];
+}
+
+- (void)publishTicks:(iTermCPUTicks)current {
     iTermCPUTicks delta = current;
     delta.idle -= _last.idle;
     delta.total -= _last.total;
@@ -111,6 +115,10 @@ typedef struct {
 #pragma mark - iTermPublisherDelegate
 
 - (void)publisherDidChangeNumberOfSubscribers:(iTermPublisher *)publisher {
+    if ([iTermSystemMetricsSampler enabled]) {
+        [[iTermSystemMetricsSampler sharedInstance] setMetric:self active:_publisher.hasAnySubscribers];
+        return;
+    }
     if (!_publisher.hasAnySubscribers) {
         [_timer invalidate];
         _timer = nil;
@@ -122,4 +130,18 @@ typedef struct {
                                                  repeats:YES];
     }
 }
+
+#pragma mark - iTermSystemMetric
+
+- (id)systemMetricTakeSample {
+    const iTermCPUTicks ticks = [self sample];
+    return [NSValue valueWithBytes:&ticks objCType:@encode(iTermCPUTicks)];
+}
+
+- (void)systemMetricDidTakeSample:(id)sample {
+    iTermCPUTicks ticks;
+    [(NSValue *)sample getValue:&ticks];
+    [self publishTicks:ticks];
+}
+
 @end
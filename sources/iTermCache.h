@@ -9,14 +9,43 @@
 
 NS_ASSUME_NONNULL_BEGIN
 
+// A thread-safe LRU cache. This wraps iTerm2::ConcurrentCache (see iTermConcurrentCache.h) for
+// Objective-C callers.
 @interface iTermCache<KeyType, ValueType>: NSObject
 
-- (instancetype)initWithCapacity:(NSInteger)capacity NS_DESIGNATED_INITIALIZER;
+// Holds up to |capacity| objects in one shard, so eviction is exactly least recently used.
+- (instancetype)initWithCapacity:(NSInteger)capacity;
+
+// |name| identifies the cache in iTermCacheStatisticsSummarize(). Caches with the same name share
+// statistics. Each object costs 1 unless given a cost. A |timeToLive| of 0 means entries don't
+// expire.
+- (instancetype)initWithName:(NSString *)name
+                 maximumCost:(NSInteger)maximumCost
+                      shards:(NSInteger)shards
+                  timeToLive:(NSTimeInterval)timeToLive NS_DESIGNATED_INITIALIZER;
 - (instancetype)init NS_UNAVAILABLE;
 
 - (nullable id)objectForKeyedSubscript:(KeyType<NSCopying>)key;
-- (void)setObject:(ValueType)obj forKeyedSubscript:(KeyType<NSCopying>)key;
+// Setting nil removes the object.
+- (void)setObject:(nullable ValueType)obj forKeyedSubscript:(KeyType<NSCopying>)key;
+- (void)setObject:(ValueType)obj forKey:(KeyType<NSCopying>)key cost:(NSInteger)cost;
+- (void)removeAllObjects;
+
+@end
 
+@interface iTermCacheStatisticsSummary : NSObject
+@property (nonatomic, readonly) NSString *name;
+@property (nonatomic, readonly) uint64_t hits;
+@property (nonatomic, readonly) uint64_t misses;
+@property (nonatomic, readonly) uint64_t evictions;
+// Totals over the entries currently in every cache with this name.
+@property (nonatomic, readonly) int64_t count;
+@property (nonatomic, readonly) int64_t cost;
+// Between 0 and 1. 0 if there have been no lookups.
+@property (nonatomic, readonly) double hitRate;
 @end
 
+// Totals since launch for each cache name. Safe to call from any thread.
+NSArray<iTermCacheStatisticsSummary *> *iTermCacheStatisticsSummarize(void);
+
 NS_ASSUME_NONNULL_END
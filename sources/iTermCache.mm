@@ -0,0 +1,127 @@
+//
+//  iTermCache.mm
+//  iTerm2SharedARC
+//
+//  Created by George Nachman on 11/5/19.
+//
+
+#import "iTermCache.h"
+
+#import "DebugLogging.h"
+#import "iTermConcurrentCache.h"
+
+#include <memory>
+
+namespace iTerm2 {
+    // Statistics are only ever prepended, so readers can walk the list without the lock.
+    static std::atomic<CacheStatistics *> gCacheStatistics;
+    static os_unfair_lock gCacheStatisticsLock = OS_UNFAIR_LOCK_INIT;
+
+    CacheStatistics *CacheStatistics::named(const char *name) {
+        os_unfair_lock_lock(&gCacheStatisticsLock);
+        CacheStatistics *statistics = gCacheStatistics.load();
+        while (statistics && strcmp(statistics->name, name)) {
+            statistics = statistics->next;
+        }
+        if (!statistics) {
+            statistics = new CacheStatistics();
+            statistics->name = strdup(name);
+            statistics->next = gCacheStatistics.load();
+            gCacheStatistics.store(statistics);
+        }
+        os_unfair_lock_unlock(&gCacheStatisticsLock);
+        return statistics;
+    }
+
+    CacheStatistics *CacheStatistics::first() {
+        return gCacheStatistics.load();
+    }
+}
+
+typedef iTerm2::ConcurrentCache<id, id, iTerm2::ObjectHash, iTerm2::ObjectEqual> iTermObjectCache;
+
+@implementation iTermCache {
+    std::unique_ptr<iTermObjectCache> _cache;
+}
+
+- (instancetype)initWithCapacity:(NSInteger)capacity {
+    return [self initWithName:@"unnamed" maximumCost:capacity shards:1 timeToLive:0];
+}
+
+- (instancetype)initWithName:(NSString *)name
+                 maximumCost:(NSInteger)maximumCost
+                      shards:(NSInteger)shards
+                  timeToLive:(NSTimeInterval)timeToLive {
+    self = [super init];
+    if (self) {
+        _cache.reset(new iTermObjectCache(name.UTF8String,
+                                          MAX(1, maximumCost),
+                                          MAX(1, shards),
+                                          timeToLive));
+    }
+    return self;
+}
+
+- (id)objectForKeyedSubscript:(id)key {
+    id result = nil;
+    if (!_cache->find(key, &result)) {
+        return nil;
+    }
+    return result;
+}
+
+- (void)setObject:(id)obj forKeyedSubscript:(id)key {
+    if (!obj) {
+        _cache->erase(key);
+        return;
+    }
+    [self setObject:obj forKey:key cost:1];
+}
+
+- (void)setObject:(id)obj forKey:(id)key cost:(NSInteger)cost {
+    DLog(@"%@ Insert object %@ with key %@", self, obj, key);
+    // Copy the key like NSDictionary does so mutating it later can't corrupt the cache.
+    _cache->insert([key copy], obj, MAX(0, cost));
+}
+
+- (void)removeAllObjects {
+    _cache->clear();
+}
+
+@end
+
+@implementation iTermCacheStatisticsSummary
+
+- (instancetype)initWithStatistics:(const iTerm2::CacheStatistics *)statistics {
+    self = [super init];
+    if (self) {
+        _name = [NSString stringWithUTF8String:statistics->name];
+        _hits = statistics->hits.load(std::memory_order_relaxed);
+        _misses = statistics->misses.load(std::memory_order_relaxed);
+        _evictions = statistics->evictions.load(std::memory_order_relaxed);
+        _count = statistics->count.load(std::memory_order_relaxed);
+        _cost = statistics->cost.load(std::memory_order_relaxed);
+        _hitRate = (_hits + _misses) ? (double)_hits / (_hits + _misses) : 0;
+    }
+    return self;
+}
+
+- (NSString *)description {
+    return [NSString stringWithFormat:@"<%@: %p %@ hits=%@ misses=%@ evictions=%@ count=%@ cost=%@>",
+            NSStringFromClass([self class]), self, _name, @(_hits), @(_misses), @(_evictions), @(_count), @(_cost)];
+}
+
+@end
+
+NSArray<iTermCacheStatisticsSummary *> *iTermCacheStatisticsSummarize(void) {
+    NSMutableArray<iTermCacheStatisticsSummary *> *result = [NSMutableArray array];
+    for (const iTerm2::CacheStatistics *statistics = iTerm2::CacheStatistics::first();
+         statistics;
+         statistics = statistics->next) {
+        [result addObject:[[iTermCacheStatisticsSummary alloc] initWithStatistics:statistics]];
+    }
+    return [result sortedArrayUsingComparator:^NSComparisonResult(iTermCacheStatisticsSummary *lhs,
+                                                                   iTermCacheStatisticsSummary *rhs) {
+        return [lhs.name compare:rhs.name];
+    }];
+}
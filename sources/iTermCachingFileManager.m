@@ -7,7 +7,9 @@
 
 #import "iTermCachingFileManager.h"
 
+#import "iTermAdvancedSettingsModel.h"
 #import "NSDate+iTerm.h"
+#import "NSFileManager+iTerm.h"
 
 @interface iTermCachingFileManagerEntry : NSObject
 @property (nonatomic) BOOL exists;
@@ -36,6 +38,8 @@
 
 @implementation iTermCachingFileManager {
     NSCache<NSString *, iTermCachingFileManagerEntry *> *_cache;
+    // Remembers whether paths are on local filesystems. statfs can block on a network mount.
+    NSCache<NSString *, iTermCachingFileManagerEntry *> *_localCache;
 }
 
 + (instancetype)cachingFileManager {
@@ -52,6 +56,8 @@
     if (self) {
         _cache = [[NSCache alloc] init];
         _cache.countLimit = 1000;
+        _localCache = [[NSCache alloc] init];
+        _localCache.countLimit = 1000;
     }
     return self;
 }
@@ -70,4 +76,20 @@
     return exists;
 }
 
+- (BOOL)fileIsLocal:(NSString *)filename
+additionalNetworkPaths:(NSArray<NSString *> *)additionalNetworkPaths {
+    if (![iTermAdvancedSettingsModel resolveSemanticHistoryPathsAsynchronously]) {
+        return [super fileIsLocal:filename additionalNetworkPaths:additionalNetworkPaths];
+    }
+    NSString *key = [[additionalNetworkPaths ?: @[] arrayByAddingObject:filename] componentsJoinedByString:@"\n"];
+    iTermCachingFileManagerEntry *entry = [_localCache objectForKey:key];
+    if (entry.isValid) {
+        return entry.exists;
+    }
+
+    const BOOL local = [super fileIsLocal:filename additionalNetworkPaths:additionalNetworkPaths];
+    [_localCache setObject:[iTermCachingFileManagerEntry entryWithExists:local] forKey:key];
+    return local;
+}
+
 @end
@@ -0,0 +1,30 @@
+//
+//  iTermCapturedOutputStore.h
+//  iTerm2
+//
+//  Created by agent on 10/14/26.
+//
+
+#import <Foundation/Foundation.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+typedef struct {
+    uint32_t segment;
+    uint32_t offset;
+} iTermCapturedOutputStoreLocation;
+
+// An append-only store for the strings of captured output. Records are packed into segments that
+// are mapped from an unlinked temporary file, so they don't add objects to the heap and the kernel
+// can page them out. If the file can't be created, segments fall back to malloc.
+@interface iTermCapturedOutputStore : NSObject
+
+// Bytes of records appended so far.
+@property (nonatomic, readonly) NSInteger byteCount;
+
+- (iTermCapturedOutputStoreLocation)appendStrings:(NSArray<NSString *> *)strings;
+- (NSArray<NSString *> *)stringsAtLocation:(iTermCapturedOutputStoreLocation)location;
+
+@end
+
+NS_ASSUME_NONNULL_END
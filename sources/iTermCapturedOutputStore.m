@@ -0,0 +1,156 @@
+//
+//  iTermCapturedOutputStore.m
+//  iTerm2
+//
+//  Created by agent on 10/14/26.
+//
+
+#import "iTermCapturedOutputStore.h"
+
+#import "DebugLogging.h"
+
+#include <sys/mman.h>
+#include <unistd.h>
+
+static const size_t iTermCapturedOutputStoreSegmentSize = 1024 * 1024;
+
+typedef struct {
+    char *bytes;
+    size_t capacity;
+    size_t used;
+    BOOL mapped;
+} iTermCapturedOutputStoreSegment;
+
+@implementation iTermCapturedOutputStore {
+    int _fd;
+    off_t _fileLength;
+    iTermCapturedOutputStoreSegment *_segments;
+    uint32_t _numberOfSegments;
+}
+
+- (instancetype)init {
+    self = [super init];
+    if (self) {
+        NSString *template = [NSTemporaryDirectory() stringByAppendingPathComponent:@"iTerm2-captured-output-XXXXXX"];
+        char *path = strdup(template.fileSystemRepresentation);
+        _fd = mkstemp(path);
+        if (_fd >= 0) {
+            // Nobody else needs to see it and this ensures it's cleaned up.
+            unlink(path);
+        } else {
+            DLog(@"mkstemp failed: %s", strerror(errno));
+        }
+        free(path);
+    }
+    return self;
+}
+
+- (void)dealloc {
+    for (uint32_t i = 0; i < _numberOfSegments; i++) {
+        if (_segments[i].mapped) {
+            munmap(_segments[i].bytes, _segments[i].capacity);
+        } else {
+            free(_segments[i].bytes);
+        }
+    }
+    free(_segments);
+    if (_fd >= 0) {
+        close(_fd);
+    }
+    [super dealloc];
+}
+
+- (iTermCapturedOutputStoreLocation)appendStrings:(NSArray<NSString *> *)strings {
+    // Each record is a count followed by length-prefixed UTF-8 strings.
+    NSMutableData *record = [NSMutableData data];
+    const uint32_t count = (uint32_t)strings.count;
+    [record appendBytes:&count length:sizeof(count)];
+    for (NSString *string in strings) {
+        NSData *data = [string dataUsingEncoding:NSUTF8StringEncoding] ?: [NSData data];
+        const uint32_t length = (uint32_t)data.length;
+        [record appendBytes:&length length:sizeof(length)];
+        [record appendData:data];
+    }
+
+    iTermCapturedOutputStoreSegment *segment = _numberOfSegments > 0 ? &_segments[_numberOfSegments - 1] : NULL;
+    if (!segment || segment->capacity - segment->used < record.length) {
+        segment = [self addSegmentWithMinimumCapacity:record.length];
+    }
+    iTermCapturedOutputStoreLocation location = {
+        .segment = _numberOfSegments - 1,
+        .offset = (uint32_t)segment->used
+    };
+    memcpy(segment->bytes + segment->used, record.bytes, record.length);
+    segment->used += record.length;
+    return location;
+}
+
+- (NSInteger)byteCount {
+    NSInteger result = 0;
+    for (uint32_t i = 0; i < _numberOfSegments; i++) {
+        result += _segments[i].used;
+    }
+    return result;
+}
+
+- (NSArray<NSString *> *)stringsAtLocation:(iTermCapturedOutputStoreLocation)location {
+    if (location.segment >= _numberOfSegments) {
+        return @[];
+    }
+    const iTermCapturedOutputStoreSegment *segment = &_segments[location.segment];
+    const char *p = segment->bytes + location.offset;
+    const char *end = segment->bytes + segment->used;
+    uint32_t count;
+    if (end - p < (ptrdiff_t)sizeof(count)) {
+        return @[];
+    }
+    memcpy(&count, p, sizeof(count));
+    p += sizeof(count);
+    NSMutableArray<NSString *> *result = [NSMutableArray arrayWithCapacity:count];
+    for (uint32_t i = 0; i < count; i++) {
+        uint32_t length;
+        if (end - p < (ptrdiff_t)sizeof(length)) {
+            break;
+        }
+        memcpy(&length, p, sizeof(length));
+        p += sizeof(length);
+        if (end - p < (ptrdiff_t)length) {
+            break;
+        }
+        NSString *string = [[[NSString alloc] initWithBytes:p
+                                                     length:length
+                                                   encoding:NSUTF8StringEncoding] autorelease];
+        [result addObject:string ?: @""];
+        p += length;
+    }
+    return result;
+}
+
+#pragma mark - Private
+
+- (iTermCapturedOutputStoreSegment *)addSegmentWithMinimumCapacity:(size_t)minimumCapacity {
+    const size_t pageSize = getpagesize();
+    size_t capacity = MAX(iTermCapturedOutputStoreSegmentSize, minimumCapacity);
+    capacity = (capacity + pageSize - 1) / pageSize * pageSize;
+
+    _segments = realloc(_segments, sizeof(*_segments) * (_numberOfSegments + 1));
+    iTermCapturedOutputStoreSegment *segment = &_segments[_numberOfSegments];
+    _numberOfSegments++;
+    memset(segment, 0, sizeof(*segment));
+    segment->capacity = capacity;
+
+    if (_fd >= 0 && ftruncate(_fd, _fileLength + capacity) == 0) {
+        void *bytes = mmap(NULL, capacity, PROT_READ | PROT_WRITE, MAP_SHARED, _fd, _fileLength);
+        if (bytes != MAP_FAILED) {
+            segment->bytes = bytes;
+            segment->mapped = YES;
+            _fileLength += capacity;
+            return segment;
+        }
+        DLog(@"mmap failed: %s", strerror(errno));
+    }
+    segment->bytes = malloc(capacity);
+    return segment;
+}
+
+@end
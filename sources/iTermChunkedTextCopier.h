@@ -0,0 +1,39 @@
+//
+//  iTermChunkedTextCopier.h
+//  iTerm2
+//
+//  Created by agent on 10/14/26.
+//
+
+#import <Cocoa/Cocoa.h>
+#import "PTYTextViewDataSource.h"
+#import "VT100GridTypes.h"
+
+// Copies a huge selection as plain text without building one giant NSString. Text is extracted a
+// few hundred lines at a time in short slices on the main thread and accumulated as UTF-8. The
+// pasteboard gets a promise, so copy returns immediately. If someone pastes before extraction is
+// done the rest is extracted synchronously.
+@interface iTermChunkedTextCopier : NSObject<NSPasteboardItemDataProvider>
+
+// Fraction of the selected lines extracted so far, from 0 to 1.
+@property(nonatomic, readonly) double fractionCompleted;
+@property(nonatomic, readonly) BOOL finished;
+
+// The data source is not retained. Call -finish or -cancel before it goes away.
+- (instancetype)initWithDataSource:(id<iTermTextDataSource>)dataSource
+                includeLastNewline:(BOOL)includeLastNewline
+            trimTrailingWhitespace:(BOOL)trimTrailingWhitespace;
+
+// Ranges are copied in the order added. If eol is set, a newline follows the range's text.
+- (void)addRange:(VT100GridAbsWindowedRange)range eol:(BOOL)eol;
+
+// Promises a string on the pasteboard and begins extracting text.
+- (void)writeToPasteboard:(NSPasteboard *)pasteboard;
+
+// Extracts whatever remains right now.
+- (void)finish;
+
+// Stops extracting. Whatever was extracted so far is what gets pasted.
+- (void)cancel;
+
+@end
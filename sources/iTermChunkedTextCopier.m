@@ -0,0 +1,224 @@
+//
+//  iTermChunkedTextCopier.m
+//  iTerm2
+//
+//  Created by agent on 10/14/26.
+//
+
+#import "iTermChunkedTextCopier.h"
+
+#import "DebugLogging.h"
+#import "iTermTextExtractor.h"
+#import "ScreenChar.h"
+
+// Lines extracted per chunk. A chunk is extended past this to end at a hard newline so that
+// trimming trailing whitespace behaves as it would for the whole range at once.
+static const int iTermChunkedTextCopierLinesPerChunk = 256;
+
+// How long each slice of work on the main thread may run.
+static const NSTimeInterval iTermChunkedTextCopierSliceDuration = 0.01;
+
+typedef struct {
+    VT100GridAbsWindowedRange range;
+    BOOL eol;
+} iTermChunkedTextCopierPiece;
+
+@implementation iTermChunkedTextCopier {
+    id<iTermTextDataSource> _dataSource;
+    BOOL _includeLastNewline;
+    BOOL _trimTrailingWhitespace;
+    NSMutableData *_pieces;
+    NSMutableData *_data;
+
+    // Index into _pieces of the range being extracted.
+    NSUInteger _pieceIndex;
+    // Absolute line number of the first line of the next chunk of the current piece.
+    long long _nextLine;
+    long long _linesDone;
+    long long _totalLines;
+    BOOL _scheduled;
+}
+
+- (instancetype)initWithDataSource:(id<iTermTextDataSource>)dataSource
+                includeLastNewline:(BOOL)includeLastNewline
+            trimTrailingWhitespace:(BOOL)trimTrailingWhitespace {
+    self = [super init];
+    if (self) {
+        _dataSource = dataSource;
+        _includeLastNewline = includeLastNewline;
+        _trimTrailingWhitespace = trimTrailingWhitespace;
+        _pieces = [[NSMutableData alloc] init];
+        _data = [[NSMutableData alloc] init];
+        _nextLine = -1;
+    }
+    return self;
+}
+
+- (void)dealloc {
+    [NSObject cancelPreviousPerformRequestsWithTarget:self];
+    [_pieces release];
+    [_data release];
+    [super dealloc];
+}
+
+- (void)addRange:(VT100GridAbsWindowedRange)range eol:(BOOL)eol {
+    iTermChunkedTextCopierPiece piece = { range, eol };
+    [_pieces appendBytes:&piece length:sizeof(piece)];
+    _totalLines += range.coordRange.end.y - range.coordRange.start.y + 1;
+}
+
+- (void)writeToPasteboard:(NSPasteboard *)pasteboard {
+    NSPasteboardItem *item = [[[NSPasteboardItem alloc] init] autorelease];
+    [item setDataProvider:self forTypes:@[ NSPasteboardTypeString ]];
+    [pasteboard clearContents];
+    [pasteboard writeObjects:@[ item ]];
+    [self schedule];
+}
+
+- (double)fractionCompleted {
+    if (_finished || _totalLines == 0) {
+        return 1;
+    }
+    return (double)_linesDone / (double)_totalLines;
+}
+
+- (void)finish {
+    while (!_finished) {
+        [self extractNextChunk];
+    }
+}
+
+- (void)cancel {
+    if (_finished) {
+        return;
+    }
+    DLog(@"Cancel chunked copy after %@ of %@ lines", @(_linesDone), @(_totalLines));
+    [self didFinish];
+}
+
+#pragma mark - Private
+
+- (NSUInteger)numberOfPieces {
+    return _pieces.length / sizeof(iTermChunkedTextCopierPiece);
+}
+
+- (void)schedule {
+    if (_scheduled || _finished) {
+        return;
+    }
+    _scheduled = YES;
+    [self performSelector:@selector(extractSlice) withObject:nil afterDelay:0];
+}
+
+- (void)extractSlice {
+    _scheduled = NO;
+    const NSTimeInterval start = [NSDate timeIntervalSinceReferenceDate];
+    while (!_finished &&
+           [NSDate timeIntervalSinceReferenceDate] - start < iTermChunkedTextCopierSliceDuration) {
+        [self extractNextChunk];
+    }
+    [self schedule];
+}
+
+- (void)didFinish {
+    _finished = YES;
+    _dataSource = nil;
+    [NSObject cancelPreviousPerformRequestsWithTarget:self];
+    _scheduled = NO;
+}
+
+- (void)extractNextChunk {
+    if (_pieceIndex >= self.numberOfPieces) {
+        DLog(@"Chunked copy finished with %@ bytes", @(_data.length));
+        [self didFinish];
+        return;
+    }
+    const iTermChunkedTextCopierPiece piece = ((const iTermChunkedTextCopierPiece *)_pieces.bytes)[_pieceIndex];
+    const long long overflow = [_dataSource totalScrollbackOverflow];
+    VT100GridAbsWindowedRange range = piece.range;
+    if (_nextLine < 0) {
+        _nextLine = range.coordRange.start.y;
+    } else {
+        // Later chunks begin at the left edge of the window.
+        range.coordRange.start.x = range.columnWindow.length ? range.columnWindow.location : 0;
+        range.coordRange.start.y = _nextLine;
+    }
+    if (range.coordRange.start.y < overflow) {
+        // Lines scrolled off while we were working. They can't be copied anymore.
+        DLog(@"Chunked copy lost %@ lines to scrollback overflow", @(overflow - range.coordRange.start.y));
+        _linesDone += MIN(overflow, range.coordRange.end.y + 1) - range.coordRange.start.y;
+        range.coordRange.start.x = range.columnWindow.length ? range.columnWindow.location : 0;
+        range.coordRange.start.y = overflow;
+    }
+    if (range.coordRange.end.y < overflow) {
+        [self finishPiece:piece];
+        return;
+    }
+
+    const int width = [_dataSource width];
+    const BOOL fullWidth = (range.columnWindow.length <= 0 ||
+                            (range.columnWindow.location == 0 && range.columnWindow.length == width));
+    long long lastLine = range.coordRange.start.y + iTermChunkedTextCopierLinesPerChunk - 1;
+    if (fullWidth) {
+        const long long limit = lastLine + iTermChunkedTextCopierLinesPerChunk * 16;
+        while (lastLine < range.coordRange.end.y &&
+               lastLine < limit &&
+               [_dataSource getLineAtIndex:(int)(lastLine - overflow)][width].code != EOL_HARD) {
+            lastLine++;
+        }
+    }
+    const BOOL isLastChunk = (lastLine >= range.coordRange.end.y);
+    if (!isLastChunk) {
+        // Ending at the window's left edge of the following line makes lastLine an interior line,
+        // so its newline is handled exactly as it would be in a single extraction.
+        range.coordRange.end.x = range.columnWindow.length ? range.columnWindow.location : 0;
+        range.coordRange.end.y = lastLine + 1;
+    }
+
+    @autoreleasepool {
+        iTermTextExtractor *extractor = [iTermTextExtractor textExtractorWithDataSource:_dataSource];
+        NSString *content = [extractor contentInRange:VT100GridWindowedRangeFromAbsWindowedRange(range, overflow)
+                                    attributeProvider:nil
+                                           nullPolicy:kiTermTextExtractorNullPolicyMidlineAsSpaceIgnoreTerminal
+                                                  pad:NO
+                                   includeLastNewline:_includeLastNewline
+                               trimTrailingWhitespace:_trimTrailingWhitespace
+                                         cappedAtSize:-1
+                                         truncateTail:YES
+                                    continuationChars:nil
+                                               coords:nil];
+        [_data appendData:[content dataUsingEncoding:NSUTF8StringEncoding]];
+    }
+
+    if (isLastChunk) {
+        _linesDone += range.coordRange.end.y - range.coordRange.start.y + 1;
+        [self finishPiece:piece];
+    } else {
+        _linesDone += lastLine - range.coordRange.start.y + 1;
+        _nextLine = lastLine + 1;
+    }
+}
+
+- (void)finishPiece:(iTermChunkedTextCopierPiece)piece {
+    if (piece.eol && (_data.length == 0 || ((const char *)_data.bytes)[_data.length - 1] != '\n')) {
+        [_data appendBytes:"\n" length:1];
+    }
+    _pieceIndex++;
+    _nextLine = -1;
+}
+
+#pragma mark - NSPasteboardItemDataProvider
+
+- (void)pasteboard:(NSPasteboard *)pasteboard item:(NSPasteboardItem *)item provideDataForType:(NSPasteboardType)type {
+    DLog(@"Pasteboard wants chunked copy data at %@", @(self.fractionCompleted));
+    [self finish];
+    [item setData:_data forType:type];
+}
+
+- (void)pasteboardFinishedWithDataProvider:(NSPasteboard *)pasteboard {
+    DLog(@"Pasteboard is done with chunked copy");
+    [self cancel];
+    [_data setLength:0];
+}
+
+@end
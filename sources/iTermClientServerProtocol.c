@@ -32,9 +32,17 @@ typedef enum iTermClientServerProtocolError {
 } iTermClientServerProtocolError;
 
 void iTermClientServerProtocolMessageInitialize(iTermClientServerProtocolMessage *message) {
+    iTermClientServerProtocolMessageInitializeWithBuffer(message,
+                                                         malloc(ITERM_MULTISERVER_BUFFER_SIZE),
+                                                         ITERM_MULTISERVER_BUFFER_SIZE);
+}
+
+void iTermClientServerProtocolMessageInitializeWithBuffer(iTermClientServerProtocolMessage *message,
+                                                          void *buffer,
+                                                          size_t length) {
     memset(message, 0, sizeof(*message));
-    message->ioVectors[0].iov_base = malloc(ITERM_MULTISERVER_BUFFER_SIZE);
-    message->ioVectors[0].iov_len = ITERM_MULTISERVER_BUFFER_SIZE;
+    message->ioVectors[0].iov_base = buffer;
+    message->ioVectors[0].iov_len = length;
 
     message->message.msg_iov = message->ioVectors;
     message->message.msg_iovlen = 1;
@@ -191,7 +199,11 @@ static void iTermClientServerProtocolEncoderEnsureSpace(iTermClientServerProtoco
     if (freeSpace >= additionalSpace) {
         return;
     }
-    iTermClientServerProtocolMessageEnsureSpace(encoder->message, additionalSpace - freeSpace);
+    // EnsureSpace sets the total size, so it must cover everything encoded so far. Grow
+    // geometrically so a big environment doesn't cause a realloc per string.
+    const size_t capacity = encoder->message->message.msg_iov[0].iov_len;
+    iTermClientServerProtocolMessageEnsureSpace(encoder->message,
+                                                MAX(capacity * 2, (size_t)(encoder->offset + additionalSpace)));
 }
 
 static void iTermClientServerProtocolEncoderCopyAndAdvance(iTermClientServerProtocolMessageEncoder *encoder,
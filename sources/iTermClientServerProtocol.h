@@ -31,6 +31,13 @@ typedef struct {
 
 void iTermClientServerProtocolMessageInitialize(iTermClientServerProtocolMessage *message);
 
+// Like iTermClientServerProtocolMessageInitialize() but the iovec points at a buffer owned by the
+// caller, which must outlive the message. Don't pass such a message to
+// iTermClientServerProtocolMessageFree() or iTermClientServerProtocolMessageEnsureSpace().
+void iTermClientServerProtocolMessageInitializeWithBuffer(iTermClientServerProtocolMessage *message,
+                                                          void *buffer,
+                                                          size_t length);
+
 void iTermClientServerProtocolMessageEnsureSpace(iTermClientServerProtocolMessage *message,
                                                  ssize_t spaceNeeded);
 
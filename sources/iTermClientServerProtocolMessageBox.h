@@ -13,7 +13,7 @@
 NS_ASSUME_NONNULL_BEGIN
 
 @interface iTermClientServerProtocolMessageBox: NSObject
-@property (nonatomic) iTermMultiServerMessage *message;
+@property (nonatomic, readonly) iTermMultiServerMessage *message;
 @property (nullable, nonatomic, readonly) iTermMultiServerServerOriginatedMessage *decoded;
 
 + (instancetype)withMessage:(iTermMultiServerMessage *)message;
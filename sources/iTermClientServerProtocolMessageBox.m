@@ -18,15 +18,16 @@
 
 + (instancetype)withMessage:(iTermMultiServerMessage *)message {
     iTermClientServerProtocolMessageBox *box = [[iTermClientServerProtocolMessageBox alloc] init];
-    iTermClientServerProtocolMessageInitialize(&box->_protocolMessage);
+    // Parse straight out of the message's data, which lives as long as the box.
+    iTermClientServerProtocolMessageInitializeWithBuffer(&box->_protocolMessage,
+                                                         (void *)message.data.bytes,
+                                                         message.data.length);
     if (message.fileDescriptor) {
         box->_protocolMessage.controlBuffer.cm.cmsg_len = CMSG_LEN(sizeof(int));
         box->_protocolMessage.controlBuffer.cm.cmsg_level = SOL_SOCKET;
         box->_protocolMessage.controlBuffer.cm.cmsg_type = SCM_RIGHTS;
         *((int *)CMSG_DATA(&box->_protocolMessage.controlBuffer.cm)) = message.fileDescriptor.intValue;
     }
-    iTermClientServerProtocolMessageEnsureSpace(&box->_protocolMessage, message.data.length);
-    memmove(box->_protocolMessage.message.msg_iov[0].iov_base, message.data.bytes, message.data.length);
     box->_message = message;
     return box;
 }
@@ -46,8 +47,4 @@
     return &_decodedMessage;
 }
 
-- (void)dealloc {
-    iTermClientServerProtocolMessageFree(&_protocolMessage);
-}
-
 @end
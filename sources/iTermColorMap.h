@@ -77,6 +77,9 @@ extern const int kColorMap24bitBase;
 @property(nonatomic, assign) double minimumContrast;
 @property(nonatomic, assign) BOOL useSeparateColorsForLightAndDarkMode;
 @property(nonatomic, assign) BOOL darkMode;
+// Changes whenever anything that affects the colors this map produces changes. Copies keep the
+// generation of the original, and no two maps that differ share a generation.
+@property(nonatomic, readonly) NSUInteger generation;
 
 + (iTermColorMapKey)keyFor8bitRed:(int)red
                             green:(int)green
@@ -95,6 +98,14 @@ extern const int kColorMap24bitBase;
 - (NSColor *)processedTextColorForTextColor:(NSColor *)textColor
                         overBackgroundColor:(NSColor*)backgroundColor
                      disableMinimumContrast:(BOOL)disableMinimumContrast;
+// Same as above without creating NSColors.
+- (vector_float4)fastProcessedTextColorForTextColor:(vector_float4)textColor
+                                overBackgroundColor:(vector_float4)backgroundColor
+                             disableMinimumContrast:(BOOL)disableMinimumContrast;
+// The processed color of opaque text with the color of |theKey| when minimum contrast doesn't
+// apply, which makes it independent of the background color. Comes from a table that is rebuilt
+// only when the generation changes.
+- (vector_float4)fastProcessedTextColorForKey:(iTermColorMapKey)theKey;
 - (NSColor *)processedBackgroundColorForBackgroundColor:(NSColor *)color;
 - (vector_float4)fastProcessedBackgroundColorForBackgroundColor:(vector_float4)backgroundColor;
 - (NSColor *)colorByMutingColor:(NSColor *)color;
@@ -8,7 +8,10 @@
 
 #import "iTermColorMap.h"
 #import "ITAddressBookMgr.h"
+#import "iTermAdvancedSettingsModel.h"
+#import "iTermMalloc.h"
 #import "NSColor+iTerm.h"
+#import <os/lock.h>
 #import <simd/simd.h>
 
 const int kColorMapForeground = 0;
@@ -36,10 +39,110 @@ const int kColorMapAnsiCyan = kColorMap8bitBase + 6;
 const int kColorMapAnsiWhite = kColorMap8bitBase + 7;
 const int kColorMapAnsiBrightModifier = 8;
 
+static NSUInteger iTermColorMapNextGeneration = 1;
+
 @interface iTermColorMap ()
 @property(nonatomic, retain) NSMutableDictionary *map;
 @end
 
+// Must be a power of 2.
+static const NSUInteger iTermColorMapContrastCacheCapacity = 1024;
+
+typedef struct {
+    vector_float4 text;
+    vector_float4 background;
+    vector_float4 result;
+    BOOL valid;
+} iTermColorMapContrastCacheEntry;
+
+// Remembers the results of minimum contrast adjustment, which costs far more than the rest of
+// color processing. Pages of syntax-highlighted text use only a few hundred distinct text and
+// background pairs. It is direct-mapped, so a colliding pair replaces the previous one. A color map
+// and its copies share one cache, and copies are used off the main thread, so it is locked.
+@interface iTermColorMapContrastCache : NSObject
+- (BOOL)getResult:(vector_float4 *)result
+          forText:(vector_float4)text
+       background:(vector_float4)background
+  minimumContrast:(double)minimumContrast;
+- (void)setResult:(vector_float4)result
+          forText:(vector_float4)text
+       background:(vector_float4)background
+  minimumContrast:(double)minimumContrast;
+@end
+
+@implementation iTermColorMapContrastCache {
+    os_unfair_lock _lock;
+    iTermColorMapContrastCacheEntry *_entries;
+    // All entries were computed with this value. Changing it empties the cache.
+    double _minimumContrast;
+}
+
+- (instancetype)init {
+    self = [super init];
+    if (self) {
+        _lock = OS_UNFAIR_LOCK_INIT;
+        _entries = iTermCalloc(iTermColorMapContrastCacheCapacity, sizeof(*_entries));
+    }
+    return self;
+}
+
+- (void)dealloc {
+    free(_entries);
+    [super dealloc];
+}
+
+static NSUInteger iTermColorMapContrastCacheIndex(vector_float4 text, vector_float4 background) {
+    // Colors come from 8-bit components, so hashing them at that precision loses nothing.
+    const vector_uint4 t = simd_uint(simd_saturate(text) * 255);
+    const vector_uint4 b = simd_uint(simd_saturate(background) * 255);
+    NSUInteger hash = (t.x << 16) ^ (t.y << 8) ^ t.z ^ (t.w << 24);
+    hash = hash * 31 + ((b.x << 16) ^ (b.y << 8) ^ b.z ^ (b.w << 24));
+    hash ^= hash >> 13;
+    hash *= 0x5bd1e995;
+    hash ^= hash >> 15;
+    return hash & (iTermColorMapContrastCacheCapacity - 1);
+}
+
+- (BOOL)getResult:(vector_float4 *)result
+          forText:(vector_float4)text
+       background:(vector_float4)background
+  minimumContrast:(double)minimumContrast {
+    const NSUInteger i = iTermColorMapContrastCacheIndex(text, background);
+    BOOL found = NO;
+    os_unfair_lock_lock(&_lock);
+    const iTermColorMapContrastCacheEntry *entry = &_entries[i];
+    if (_minimumContrast == minimumContrast &&
+        entry->valid &&
+        simd_equal(entry->text, text) &&
+        simd_equal(entry->background, background)) {
+        *result = entry->result;
+        found = YES;
+    }
+    os_unfair_lock_unlock(&_lock);
+    return found;
+}
+
+- (void)setResult:(vector_float4)result
+          forText:(vector_float4)text
+       background:(vector_float4)background
+  minimumContrast:(double)minimumContrast {
+    const NSUInteger i = iTermColorMapContrastCacheIndex(text, background);
+    os_unfair_lock_lock(&_lock);
+    if (_minimumContrast != minimumContrast) {
+        memset(_entries, 0, iTermColorMapContrastCacheCapacity * sizeof(*_entries));
+        _minimumContrast = minimumContrast;
+    }
+    _entries[i] = (iTermColorMapContrastCacheEntry){
+        .text = text,
+        .background = background,
+        .result = result,
+        .valid = YES
+    };
+    os_unfair_lock_unlock(&_lock);
+}
+
+@end
+
 @implementation iTermColorMap {
     double _backgroundBrightness;
     CGFloat _backgroundRed;
@@ -55,7 +158,16 @@ const int kColorMapAnsiBrightModifier = 8;
     CGFloat _lastBackgroundComponents[4];
     NSColor *_lastBackgroundColor;
 
-    NSMutableDictionary<NSNumber *, NSData *> *_fastMap;
+    // sRGB components of each color in _map, indexed by key. Zero for keys that have no color.
+    vector_float4 *_fastColors;
+
+    // Processed text colors for opaque text when minimum contrast doesn't apply, indexed by key.
+    // Valid when _processedTextColorsGeneration equals _generation.
+    vector_float4 *_processedTextColors;
+    NSUInteger _processedTextColorsGeneration;
+
+    // Nil unless enabled in advanced settings. Shared with copies.
+    iTermColorMapContrastCache *_contrastCache;
 }
 
 + (iTermColorMapKey)keyFor8bitRed:(int)red
@@ -68,7 +180,12 @@ const int kColorMapAnsiBrightModifier = 8;
     self = [super init];
     if (self) {
         _map = [[NSMutableDictionary alloc] init];
-        _fastMap = [[NSMutableDictionary alloc] init];
+        _fastColors = iTermCalloc(kColorMap24bitBase, sizeof(*_fastColors));
+        _processedTextColors = iTermCalloc(kColorMap24bitBase, sizeof(*_processedTextColors));
+        if ([iTermAdvancedSettingsModel cacheMinimumContrastColors]) {
+            _contrastCache = [[iTermColorMapContrastCache alloc] init];
+        }
+        [self bumpGeneration];
     }
     return self;
 }
@@ -77,27 +194,51 @@ const int kColorMapAnsiBrightModifier = 8;
     [_map release];
     [_lastTextColor release];
     [_lastBackgroundColor release];
-    [_fastMap release];
+    free(_fastColors);
+    free(_processedTextColors);
+    [_contrastCache release];
     [super dealloc];
 }
 
+- (void)bumpGeneration {
+    _generation = iTermColorMapNextGeneration++;
+}
+
+- (void)setMinimumContrast:(double)minimumContrast {
+    _minimumContrast = minimumContrast;
+    [self bumpGeneration];
+}
+
+- (void)setUseSeparateColorsForLightAndDarkMode:(BOOL)useSeparateColorsForLightAndDarkMode {
+    _useSeparateColorsForLightAndDarkMode = useSeparateColorsForLightAndDarkMode;
+    [self bumpGeneration];
+}
+
+- (void)setDarkMode:(BOOL)darkMode {
+    _darkMode = darkMode;
+    [self bumpGeneration];
+}
+
 - (void)setDimmingAmount:(double)dimmingAmount {
     _dimmingAmount = dimmingAmount;
+    [self bumpGeneration];
     [_delegate colorMap:self dimmingAmountDidChangeTo:dimmingAmount];
 }
 
 - (void)setMutingAmount:(double)mutingAmount {
     _mutingAmount = mutingAmount;
+    [self bumpGeneration];
     [_delegate colorMap:self mutingAmountDidChangeTo:mutingAmount];
 }
 
 - (void)setColor:(NSColor *)theColor forKey:(iTermColorMapKey)theKey {
-    if (theKey >= kColorMap24bitBase)
+    if (theKey >= kColorMap24bitBase || theKey < 0)
         return;
 
     if (!theColor) {
         [_map removeObjectForKey:@(theKey)];
-        [_fastMap removeObjectForKey:@(theKey)];
+        _fastColors[theKey] = simd_make_float4(0, 0, 0, 0);
+        [self bumpGeneration];
         return;
     }
 
@@ -128,7 +269,8 @@ const int kColorMapAnsiBrightModifier = 8;
         (float)components[2],
         (float)components[3]
    };
-    _fastMap[@(theKey)] = [NSData dataWithBytes:&value length:sizeof(value)];
+    _fastColors[theKey] = value;
+    [self bumpGeneration];
     [_delegate colorMap:self didChangeColorForKey:theKey];
 }
 
@@ -158,16 +300,16 @@ const int kColorMapAnsiBrightModifier = 8;
                                 green / 255.0,
                                 blue / 255.0,
                                 1);
+    } else if (theKey < 0) {
+        return simd_make_float4(0, 0, 0, 0);
     } else {
-        NSData *data = _fastMap[@(theKey)];
-        vector_float4 value;
-        memmove(&value, data.bytes, sizeof(value));
-        return value;
+        return _fastColors[theKey];
     }
 }
 
 - (void)setDimOnlyText:(BOOL)dimOnlyText {
     _dimOnlyText = dimOnlyText;
+    [self bumpGeneration];
     [_delegate colorMap:self dimmingAmountDidChangeTo:_dimmingAmount];
 }
 
@@ -211,10 +353,9 @@ const int kColorMapAnsiBrightModifier = 8;
 
     CGFloat contrastingRgb[4];
     if (backgroundColor && !disableMinimumContrast) {
-        [NSColor getComponents:contrastingRgb
-                 forComponents:textRgb
-            withContrastAgainstComponents:backgroundRgb
-                          minimumContrast:_minimumContrast];
+        [self getComponents:contrastingRgb
+              forComponents:textRgb
+    withContrastAgainstComponents:backgroundRgb];
     } else {
         memmove(contrastingRgb, textRgb, sizeof(textRgb));
     }
@@ -257,6 +398,91 @@ const int kColorMapAnsiBrightModifier = 8;
     }
 }
 
+// Like +[NSColor getComponents:forComponents:withContrastAgainstComponents:minimumContrast:] with
+// self.minimumContrast, but consults the cache first.
+- (void)getComponents:(CGFloat *)result
+        forComponents:(CGFloat *)textRgb
+withContrastAgainstComponents:(CGFloat *)backgroundRgb {
+    if (!_contrastCache) {
+        [NSColor getComponents:result
+                 forComponents:textRgb
+            withContrastAgainstComponents:backgroundRgb
+                          minimumContrast:_minimumContrast];
+        return;
+    }
+    const vector_float4 text = simd_make_float4(textRgb[0], textRgb[1], textRgb[2], textRgb[3]);
+    const vector_float4 background = simd_make_float4(backgroundRgb[0], backgroundRgb[1], backgroundRgb[2], backgroundRgb[3]);
+    vector_float4 cached;
+    if ([_contrastCache getResult:&cached forText:text background:background minimumContrast:_minimumContrast]) {
+        result[0] = cached.x;
+        result[1] = cached.y;
+        result[2] = cached.z;
+        result[3] = cached.w;
+        return;
+    }
+    [NSColor getComponents:result
+             forComponents:textRgb
+        withContrastAgainstComponents:backgroundRgb
+                      minimumContrast:_minimumContrast];
+    [_contrastCache setResult:simd_make_float4(result[0], result[1], result[2], result[3])
+                      forText:text
+                   background:background
+              minimumContrast:_minimumContrast];
+}
+
+- (vector_float4)fastProcessedTextColorForTextColor:(vector_float4)textColor
+                                overBackgroundColor:(vector_float4)backgroundColor
+                             disableMinimumContrast:(BOOL)disableMinimumContrast {
+    vector_float4 contrasting = textColor;
+    if (!disableMinimumContrast && _minimumContrast > 0.001) {
+        CGFloat textRgb[4] = { textColor.x, textColor.y, textColor.z, textColor.w };
+        CGFloat backgroundRgb[4] = { backgroundColor.x, backgroundColor.y, backgroundColor.z, backgroundColor.w };
+        CGFloat contrastingRgb[4];
+        [self getComponents:contrastingRgb
+              forComponents:textRgb
+    withContrastAgainstComponents:backgroundRgb];
+        contrasting = simd_make_float4(contrastingRgb[0], contrastingRgb[1], contrastingRgb[2], contrastingRgb[3]);
+    }
+
+    const float mutingAmount = _mutingAmount;
+    const vector_float4 muted = contrasting * (1 - mutingAmount) + _fastColors[kColorMapBackground] * mutingAmount;
+
+    const float gray = _dimOnlyText ? _backgroundBrightness : 0.5;
+    const float dimmingAmount = _dimmingAmount;
+    const vector_float4 dimmed = muted * (1 - dimmingAmount) + simd_make_float4(gray, gray, gray, 1) * dimmingAmount;
+
+    // Premultiply alpha
+    const float alpha = textColor.w;
+    vector_float4 result = dimmed * alpha + backgroundColor * (1 - alpha);
+    result.w = 1;
+    return result;
+}
+
+- (void)updateProcessedTextColorsIfNeeded {
+    if (_processedTextColorsGeneration == _generation) {
+        return;
+    }
+    const vector_float4 black = simd_make_float4(0, 0, 0, 1);
+    for (int i = 0; i < kColorMap24bitBase; i++) {
+        vector_float4 textColor = _fastColors[i];
+        textColor.w = 1;
+        _processedTextColors[i] = [self fastProcessedTextColorForTextColor:textColor
+                                                       overBackgroundColor:black
+                                                    disableMinimumContrast:YES];
+    }
+    _processedTextColorsGeneration = _generation;
+}
+
+- (vector_float4)fastProcessedTextColorForKey:(iTermColorMapKey)theKey {
+    if (theKey < 0 || theKey >= kColorMap24bitBase) {
+        return [self fastProcessedTextColorForTextColor:[self fastColorForKey:theKey]
+                                    overBackgroundColor:simd_make_float4(0, 0, 0, 1)
+                                 disableMinimumContrast:YES];
+    }
+    [self updateProcessedTextColorsIfNeeded];
+    return _processedTextColors[theKey];
+}
+
 // There is an issue where where the passed-in color can be in a different color space than the
 // default background color. It doesn't make sense to combine RGB values from different color
 // spaces. The effects are generally subtle.
@@ -531,14 +757,21 @@ const int kColorMapAnsiBrightModifier = 8;
 
     other->_delegate = _delegate;
 
+    [other->_contrastCache release];
+    other->_contrastCache = [_contrastCache retain];
+
     [other->_map release];
     other->_map = [_map mutableCopy];
 
-    [other->_fastMap release];
-    other->_fastMap = [_fastMap mutableCopy];
+    memmove(other->_fastColors, _fastColors, kColorMap24bitBase * sizeof(*_fastColors));
+    // Build the table here so per-frame copies share it instead of each rebuilding it.
+    [self updateProcessedTextColorsIfNeeded];
+    memmove(other->_processedTextColors, _processedTextColors, kColorMap24bitBase * sizeof(*_processedTextColors));
+    other->_processedTextColorsGeneration = _processedTextColorsGeneration;
     other->_useSeparateColorsForLightAndDarkMode = _useSeparateColorsForLightAndDarkMode;
     other->_darkMode = _darkMode;
-    
+    other->_generation = _generation;
+
     return other;
 }
 
@@ -0,0 +1,28 @@
+//
+//  iTermCommandHistoryPrefixIndex.h
+//  iTerm2
+//
+//  Created by agent on 10/14/26.
+//
+
+#import <Foundation/Foundation.h>
+
+@class iTermCommandHistoryEntryMO;
+
+NS_ASSUME_NONNULL_BEGIN
+
+// Keeps one host's command history entries sorted by case-folded command so that finding the
+// commands with a prefix is a binary search rather than a scan of the whole history.
+@interface iTermCommandHistoryPrefixIndex : NSObject
+
+- (instancetype)initWithEntries:(NSArray<iTermCommandHistoryEntryMO *> *)entries NS_DESIGNATED_INITIALIZER;
+- (instancetype)init NS_UNAVAILABLE;
+
+- (void)addEntry:(iTermCommandHistoryEntryMO *)entry;
+
+// Entries whose commands begin with |prefix|, ignoring case, in order of command.
+- (NSArray<iTermCommandHistoryEntryMO *> *)entriesWithPrefix:(NSString *)prefix;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,91 @@
+//
+//  iTermCommandHistoryPrefixIndex.m
+//  iTerm2
+//
+//  Created by agent on 10/14/26.
+//
+
+#import "iTermCommandHistoryPrefixIndex.h"
+
+#import "iTermCommandHistoryEntryMO.h"
+
+static NSString *iTermCommandHistoryPrefixIndexKey(NSString *command) {
+    return [command stringByFoldingWithOptions:NSCaseInsensitiveSearch locale:nil] ?: @"";
+}
+
+static BOOL iTermCommandHistoryPrefixIndexKeyHasPrefix(NSString *key, NSString *prefix) {
+    return (key.length >= prefix.length &&
+            [key compare:prefix options:NSLiteralSearch range:NSMakeRange(0, prefix.length)] == NSOrderedSame);
+}
+
+@implementation iTermCommandHistoryPrefixIndex {
+    // Folded commands in literal order. _entries[i] is the entry for _keys[i].
+    NSMutableArray<NSString *> *_keys;
+    NSMutableArray<iTermCommandHistoryEntryMO *> *_entries;
+}
+
+- (instancetype)initWithEntries:(NSArray<iTermCommandHistoryEntryMO *> *)entries {
+    self = [super init];
+    if (self) {
+        NSMutableArray<NSString *> *keys = [NSMutableArray arrayWithCapacity:entries.count];
+        for (iTermCommandHistoryEntryMO *entry in entries) {
+            [keys addObject:iTermCommandHistoryPrefixIndexKey(entry.command)];
+        }
+        NSMutableArray<NSNumber *> *order = [NSMutableArray arrayWithCapacity:entries.count];
+        for (NSUInteger i = 0; i < entries.count; i++) {
+            [order addObject:@(i)];
+        }
+        [order sortUsingComparator:^NSComparisonResult(NSNumber *lhs, NSNumber *rhs) {
+            return [keys[lhs.unsignedIntegerValue] compare:keys[rhs.unsignedIntegerValue]
+                                                   options:NSLiteralSearch];
+        }];
+        _keys = [[NSMutableArray alloc] initWithCapacity:entries.count];
+        _entries = [[NSMutableArray alloc] initWithCapacity:entries.count];
+        for (NSNumber *index in order) {
+            [_keys addObject:keys[index.unsignedIntegerValue]];
+            [_entries addObject:entries[index.unsignedIntegerValue]];
+        }
+    }
+    return self;
+}
+
+- (void)dealloc {
+    [_keys release];
+    [_entries release];
+    [super dealloc];
+}
+
+- (void)addEntry:(iTermCommandHistoryEntryMO *)entry {
+    NSString *key = iTermCommandHistoryPrefixIndexKey(entry.command);
+    const NSUInteger index = [self indexOfFirstKeyNotBefore:key];
+    [_keys insertObject:key atIndex:index];
+    [_entries insertObject:entry atIndex:index];
+}
+
+- (NSArray<iTermCommandHistoryEntryMO *> *)entriesWithPrefix:(NSString *)prefix {
+    NSString *foldedPrefix = iTermCommandHistoryPrefixIndexKey(prefix);
+    if (foldedPrefix.length == 0) {
+        return [[_entries copy] autorelease];
+    }
+    // Keys with a literal prefix are contiguous in literal order, starting at the first key that
+    // doesn't sort before the prefix.
+    const NSUInteger first = [self indexOfFirstKeyNotBefore:foldedPrefix];
+    NSUInteger end = first;
+    while (end < _keys.count && iTermCommandHistoryPrefixIndexKeyHasPrefix(_keys[end], foldedPrefix)) {
+        end++;
+    }
+    return [_entries subarrayWithRange:NSMakeRange(first, end - first)];
+}
+
+#pragma mark - Private
+
+- (NSUInteger)indexOfFirstKeyNotBefore:(NSString *)key {
+    return [_keys indexOfObject:key
+                  inSortedRange:NSMakeRange(0, _keys.count)
+                        options:NSBinarySearchingInsertionIndex | NSBinarySearchingFirstEqual
+                usingComparator:^NSComparisonResult(NSString *lhs, NSString *rhs) {
+        return [lhs compare:rhs options:NSLiteralSearch];
+    }];
+}
+
+@end
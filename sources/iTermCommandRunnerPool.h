@@ -33,6 +33,12 @@ NS_ASSUME_NONNULL_BEGIN
 
 @end
 
+typedef NS_ENUM(NSInteger, iTermCommandRunnerPriority) {
+    iTermCommandRunnerPriorityBackground,
+    // Waits in a separate queue that is served first when a runner frees up.
+    iTermCommandRunnerPriorityForeground
+};
+
 @interface iTermBackgroundCommandRunnerPool: iTermCommandRunnerPool
 
 - (instancetype)initWithCapacity:(int)capacity NS_DESIGNATED_INITIALIZER;
@@ -44,6 +50,8 @@ NS_ASSUME_NONNULL_BEGIN
 
 - (nullable iTermCommandRunner *)requestCommandRunnerWithTerminationBlock:(void (^ _Nullable)(iTermCommandRunner *, int))block NS_UNAVAILABLE;
 - (nullable iTermBackgroundCommandRunner *)requestBackgroundCommandRunnerWithTerminationBlock:(void (^ _Nullable)(iTermBackgroundCommandRunner *, int))block;
+- (nullable iTermBackgroundCommandRunner *)requestBackgroundCommandRunnerWithPriority:(iTermCommandRunnerPriority)priority
+                                                                     terminationBlock:(void (^ _Nullable)(iTermBackgroundCommandRunner *, int))block;
 @end
 
 NS_ASSUME_NONNULL_END
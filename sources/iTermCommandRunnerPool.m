@@ -131,6 +131,7 @@
 
 @implementation iTermBackgroundCommandRunnerPool {
     NSMutableArray<iTermBackgroundCommandRunnerPromise *> *_waiting;
+    NSMutableArray<iTermBackgroundCommandRunnerPromise *> *_foregroundWaiting;
 }
 
 - (instancetype)initWithCapacity:(int)capacity {
@@ -141,20 +142,34 @@
                        environment:nil];
     if (self) {
         _waiting = [NSMutableArray array];
+        _foregroundWaiting = [NSMutableArray array];
     }
     return self;
 }
 
 - (nullable iTermBackgroundCommandRunner *)requestBackgroundCommandRunnerWithTerminationBlock:(void (^ _Nullable)(iTermBackgroundCommandRunner *, int))block {
+    return [self requestBackgroundCommandRunnerWithPriority:iTermCommandRunnerPriorityBackground
+                                           terminationBlock:block];
+}
+
+- (nullable iTermBackgroundCommandRunner *)requestBackgroundCommandRunnerWithPriority:(iTermCommandRunnerPriority)priority
+                                                                     terminationBlock:(void (^ _Nullable)(iTermBackgroundCommandRunner *, int))block {
     iTermBackgroundCommandRunner *runner = (iTermBackgroundCommandRunner *)[super requestCommandRunnerWithTerminationBlock:(id)block];
     if (runner) {
         return runner;
     }
 
     iTermBackgroundCommandRunnerPromise *promise = [[iTermBackgroundCommandRunnerPromise alloc] initWithCommand:nil shell:nil title:nil];
-    DLog(@"Will return a promise %@.", promise);
+    DLog(@"Will return a promise %@ with priority %@.", promise, @(priority));
     promise.terminationBlock = block;
-    [_waiting addObject:promise];
+    switch (priority) {
+        case iTermCommandRunnerPriorityBackground:
+            [_waiting addObject:promise];
+            break;
+        case iTermCommandRunnerPriorityForeground:
+            [_foregroundWaiting addObject:promise];
+            break;
+    }
     return promise;
 }
 
@@ -168,15 +183,16 @@
 }
 
 - (void)commandRunnerDied:(id<iTermCommandRunner>)commandRunner {
-    DLog(@"waiting.count=%@", @(_waiting.count));
+    DLog(@"waiting.count=%@ foregroundWaiting.count=%@", @(_waiting.count), @(_foregroundWaiting.count));
     [super commandRunnerDied:commandRunner];
-    if (!_waiting.count) {
+    NSMutableArray<iTermBackgroundCommandRunnerPromise *> *queue = _foregroundWaiting.count ? _foregroundWaiting : _waiting;
+    if (!queue.count) {
         return;
     }
-    iTermBackgroundCommandRunnerPromise *promise = [_waiting firstObject];
+    iTermBackgroundCommandRunnerPromise *promise = [queue firstObject];
     DLog(@"Fulfill promise %@", promise);
     assert(promise);
-    [_waiting removeObjectAtIndex:0];
+    [queue removeObjectAtIndex:0];
     void (^terminationBlock)(iTermBackgroundCommandRunner *, int) = promise.terminationBlock;
     promise.terminationBlock = nil;
     [self initializeRunner:promise completion:terminationBlock];
@@ -0,0 +1,43 @@
+//
+//  iTermCompactLineStorage.h
+//  iTerm2SharedARC
+//
+//  Created by agent on 10/14/26.
+//
+
+#import <Foundation/Foundation.h>
+#import "ScreenChar.h"
+
+NS_ASSUME_NONNULL_BEGIN
+
+// A compact representation of an array of screen_char_t. Codes are stored as a
+// flat array of unichars and everything else is stored as a table of runs of
+// identical attributes. Scrollback almost always has long runs of identical
+// attributes, so this is usually 4-6x smaller than the raw array. When attributes change
+// too often for that to pay off, each cell is packed into 8 bytes instead, with the rarely-used
+// parts of 24-bit colors and URL codes kept in a side table.
+NSData *iTermCompactLineStorageEncode(const screen_char_t *buffer, int length);
+
+// Returns the number of screen_char_t's encoded in |data|, or -1 if it is malformed.
+int iTermCompactLineStorageLength(NSData *data);
+
+// Decodes |data| into |buffer|, which must have room for at least
+// iTermCompactLineStorageLength(data) elements. Returns NO if the data is
+// malformed or does not fit in |capacity|.
+BOOL iTermCompactLineStorageDecode(NSData *data, screen_char_t *buffer, int capacity);
+
+// Returns a zlib-compressed copy of the output of iTermCompactLineStorageEncode(). The
+// result can be passed to iTermCompactLineStorageLength() and
+// iTermCompactLineStorageDecode() directly. Safe to call on any thread.
+NSData *iTermCompactLineStorageCompress(NSData *data);
+
+// Is |data| the output of iTermCompactLineStorageCompress()?
+BOOL iTermCompactLineStorageIsCompressed(NSData *data);
+
+// Returns data with the same bytes as |data|, preferring a copy that an earlier caller already
+// holds. Identical blocks, such as the same output broadcast to many sessions, then share one
+// buffer. The data is never modified, so sharing is safe. Only weak references are kept, so a
+// buffer is freed when its last holder releases it. Must be called on the main thread.
+NSData *iTermCompactLineStorageDeduplicate(NSData *data);
+
+NS_ASSUME_NONNULL_END
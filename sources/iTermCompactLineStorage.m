@@ -0,0 +1,405 @@
+//
+//  iTermCompactLineStorage.m
+//  iTerm2SharedARC
+//
+//  Created by agent on 10/14/26.
+//
+
+#import "iTermCompactLineStorage.h"
+
+#import "DebugLogging.h"
+#import "zlib.h"
+
+static const uint32_t iTermCompactLineStorageMagic = 'iCL1';
+static const uint32_t iTermCompactLineStorageCompressedMagic = 'iCLz';
+static const uint32_t iTermCompactLineStoragePackedMagic = 'iCP1';
+
+typedef struct {
+    uint32_t magic;
+    int32_t length;
+    int32_t numberOfRuns;
+} iTermCompactLineStorageHeader;
+
+typedef struct {
+    int32_t count;
+    // Code is always 0 here. The codes live in a separate array.
+    screen_char_t attributes;
+} iTermCompactLineStorageRun;
+
+typedef struct {
+    uint32_t magic;
+    int32_t length;
+    uint32_t uncompressedSize;
+} iTermCompactLineStorageCompressedHeader;
+
+// The packed format is used when attributes change too often for runs to pay off, such as in
+// colorized or syntax-highlighted output. Each cell takes 8 bytes instead of 12, with the bytes
+// that are usually zero (the green and blue parts of 24-bit colors and the URL code) interned in
+// a side table.
+typedef struct {
+    uint32_t magic;
+    int32_t length;
+    int32_t numberOfExtras;
+} iTermCompactLineStoragePackedHeader;
+
+typedef struct {
+    uint8_t fgGreen;
+    uint8_t fgBlue;
+    uint8_t bgGreen;
+    uint8_t bgBlue;
+    uint16_t urlCode;
+} iTermCompactLineStorageExtras;
+
+typedef struct {
+    unichar code;
+    uint8_t foregroundColor;
+    uint8_t backgroundColor;
+    uint16_t flags;
+    // Index into the extras table. Entry 0 is all zeroes.
+    uint16_t extras;
+} iTermCompactLineStoragePackedCell;
+
+_Static_assert(sizeof(iTermCompactLineStoragePackedCell) == 8, "Packed cells should be 8 bytes");
+_Static_assert(sizeof(iTermCompactLineStorageExtras) == 6, "Extras should be 6 bytes");
+
+NS_INLINE uint16_t iTermCompactLineStoragePackFlags(const screen_char_t *c) {
+    return ((c->foregroundColorMode << 0) |
+            (c->backgroundColorMode << 2) |
+            (c->complexChar << 4) |
+            (c->bold << 5) |
+            (c->faint << 6) |
+            (c->italic << 7) |
+            (c->blink << 8) |
+            (c->underline << 9) |
+            (c->image << 10) |
+            (c->strikethrough << 11) |
+            (c->underlineStyle << 12) |
+            (c->unused << 13));
+}
+
+NS_INLINE void iTermCompactLineStorageUnpackFlags(uint16_t flags, screen_char_t *c) {
+    c->foregroundColorMode = (flags >> 0) & 3;
+    c->backgroundColorMode = (flags >> 2) & 3;
+    c->complexChar = (flags >> 4) & 1;
+    c->bold = (flags >> 5) & 1;
+    c->faint = (flags >> 6) & 1;
+    c->italic = (flags >> 7) & 1;
+    c->blink = (flags >> 8) & 1;
+    c->underline = (flags >> 9) & 1;
+    c->image = (flags >> 10) & 1;
+    c->strikethrough = (flags >> 11) & 1;
+    c->underlineStyle = (flags >> 12) & 1;
+    c->unused = (flags >> 13) & 7;
+}
+
+NS_INLINE uint64_t iTermCompactLineStorageExtrasKey(const screen_char_t *c) {
+    return (((uint64_t)c->fgGreen << 0) |
+            ((uint64_t)c->fgBlue << 8) |
+            ((uint64_t)c->bgGreen << 16) |
+            ((uint64_t)c->bgBlue << 24) |
+            ((uint64_t)c->urlCode << 32));
+}
+
+// Returns nil if there are too many distinct extras to index with 16 bits.
+static NSData *iTermCompactLineStorageEncodePacked(const screen_char_t *buffer, int length) {
+    NSMutableData *extras = [NSMutableData dataWithLength:sizeof(iTermCompactLineStorageExtras)];
+    NSMutableDictionary<NSNumber *, NSNumber *> *indexes = [NSMutableDictionary dictionary];
+    NSMutableData *cells = [NSMutableData dataWithLength:sizeof(iTermCompactLineStoragePackedCell) * length];
+    iTermCompactLineStoragePackedCell *packed = cells.mutableBytes;
+    uint64_t lastKey = 0;
+    uint16_t lastIndex = 0;
+    for (int i = 0; i < length; i++) {
+        const screen_char_t *c = &buffer[i];
+        packed[i].code = c->code;
+        packed[i].foregroundColor = c->foregroundColor;
+        packed[i].backgroundColor = c->backgroundColor;
+        packed[i].flags = iTermCompactLineStoragePackFlags(c);
+
+        const uint64_t key = iTermCompactLineStorageExtrasKey(c);
+        if (key != lastKey) {
+            NSNumber *existing = indexes[@(key)];
+            if (existing) {
+                lastIndex = existing.unsignedShortValue;
+            } else {
+                const NSUInteger count = extras.length / sizeof(iTermCompactLineStorageExtras);
+                if (count > UINT16_MAX) {
+                    return nil;
+                }
+                const iTermCompactLineStorageExtras entry = {
+                    .fgGreen = c->fgGreen,
+                    .fgBlue = c->fgBlue,
+                    .bgGreen = c->bgGreen,
+                    .bgBlue = c->bgBlue,
+                    .urlCode = c->urlCode
+                };
+                [extras appendBytes:&entry length:sizeof(entry)];
+                lastIndex = (uint16_t)count;
+                indexes[@(key)] = @(lastIndex);
+            }
+            lastKey = key;
+        }
+        packed[i].extras = key ? lastIndex : 0;
+    }
+
+    iTermCompactLineStoragePackedHeader header = {
+        .magic = iTermCompactLineStoragePackedMagic,
+        .length = length,
+        .numberOfExtras = (int32_t)(extras.length / sizeof(iTermCompactLineStorageExtras))
+    };
+    NSMutableData *data = [NSMutableData dataWithCapacity:sizeof(header) + extras.length + cells.length];
+    [data appendBytes:&header length:sizeof(header)];
+    [data appendData:extras];
+    [data appendData:cells];
+    return data;
+}
+
+static const iTermCompactLineStoragePackedHeader *iTermCompactLineStorageValidPackedHeader(NSData *data) {
+    if (data.length < sizeof(iTermCompactLineStoragePackedHeader)) {
+        return NULL;
+    }
+    const iTermCompactLineStoragePackedHeader *header = data.bytes;
+    if (header->magic != iTermCompactLineStoragePackedMagic ||
+        header->length < 0 ||
+        header->numberOfExtras < 1 ||
+        header->numberOfExtras > UINT16_MAX + 1) {
+        return NULL;
+    }
+    const size_t expected = (sizeof(iTermCompactLineStoragePackedHeader) +
+                             sizeof(iTermCompactLineStorageExtras) * (size_t)header->numberOfExtras +
+                             sizeof(iTermCompactLineStoragePackedCell) * (size_t)header->length);
+    if (data.length != expected) {
+        return NULL;
+    }
+    return header;
+}
+
+static BOOL iTermCompactLineStorageDecodePacked(const iTermCompactLineStoragePackedHeader *header,
+                                                screen_char_t *buffer) {
+    const iTermCompactLineStorageExtras *extras = (const iTermCompactLineStorageExtras *)(header + 1);
+    const iTermCompactLineStoragePackedCell *cells =
+        (const iTermCompactLineStoragePackedCell *)(extras + header->numberOfExtras);
+    for (int32_t i = 0; i < header->length; i++) {
+        const iTermCompactLineStoragePackedCell *cell = &cells[i];
+        if (cell->extras >= header->numberOfExtras) {
+            return NO;
+        }
+        const iTermCompactLineStorageExtras *extra = &extras[cell->extras];
+        screen_char_t *c = &buffer[i];
+        c->code = cell->code;
+        c->foregroundColor = cell->foregroundColor;
+        c->fgGreen = extra->fgGreen;
+        c->fgBlue = extra->fgBlue;
+        c->backgroundColor = cell->backgroundColor;
+        c->bgGreen = extra->bgGreen;
+        c->bgBlue = extra->bgBlue;
+        iTermCompactLineStorageUnpackFlags(cell->flags, c);
+        c->urlCode = extra->urlCode;
+    }
+    return YES;
+}
+
+NS_INLINE screen_char_t iTermCompactLineStorageAttributes(const screen_char_t *c) {
+    screen_char_t result = *c;
+    result.code = 0;
+    return result;
+}
+
+NSData *iTermCompactLineStorageEncode(const screen_char_t *buffer, int length) {
+    length = MAX(0, length);
+
+    // Count runs first so the output can be allocated in one shot.
+    int32_t numberOfRuns = 0;
+    screen_char_t previous = { 0 };
+    for (int i = 0; i < length; i++) {
+        const screen_char_t attributes = iTermCompactLineStorageAttributes(&buffer[i]);
+        if (i == 0 || memcmp(&attributes, &previous, sizeof(attributes))) {
+            numberOfRuns++;
+            previous = attributes;
+        }
+    }
+
+    const size_t size = (sizeof(iTermCompactLineStorageHeader) +
+                         sizeof(iTermCompactLineStorageRun) * numberOfRuns +
+                         sizeof(unichar) * length);
+    if (size > sizeof(iTermCompactLineStoragePackedCell) * (size_t)length) {
+        // Runs are too short to beat packing each cell.
+        NSData *packed = iTermCompactLineStorageEncodePacked(buffer, length);
+        if (packed && packed.length < size) {
+            return packed;
+        }
+    }
+    NSMutableData *data = [NSMutableData dataWithLength:size];
+    iTermCompactLineStorageHeader *header = data.mutableBytes;
+    header->magic = iTermCompactLineStorageMagic;
+    header->length = length;
+    header->numberOfRuns = numberOfRuns;
+
+    iTermCompactLineStorageRun *runs = (iTermCompactLineStorageRun *)(header + 1);
+    unichar *codes = (unichar *)(runs + numberOfRuns);
+    int32_t run = -1;
+    for (int i = 0; i < length; i++) {
+        codes[i] = buffer[i].code;
+        const screen_char_t attributes = iTermCompactLineStorageAttributes(&buffer[i]);
+        if (run < 0 || memcmp(&attributes, &runs[run].attributes, sizeof(attributes))) {
+            run++;
+            runs[run].count = 0;
+            runs[run].attributes = attributes;
+        }
+        runs[run].count++;
+    }
+    return data;
+}
+
+static const iTermCompactLineStorageHeader *iTermCompactLineStorageValidHeader(NSData *data) {
+    if (data.length < sizeof(iTermCompactLineStorageHeader)) {
+        return NULL;
+    }
+    const iTermCompactLineStorageHeader *header = data.bytes;
+    if (header->magic != iTermCompactLineStorageMagic ||
+        header->length < 0 ||
+        header->numberOfRuns < 0) {
+        return NULL;
+    }
+    const size_t expected = (sizeof(iTermCompactLineStorageHeader) +
+                             sizeof(iTermCompactLineStorageRun) * (size_t)header->numberOfRuns +
+                             sizeof(unichar) * (size_t)header->length);
+    if (data.length != expected) {
+        return NULL;
+    }
+    return header;
+}
+
+BOOL iTermCompactLineStorageIsCompressed(NSData *data) {
+    if (data.length < sizeof(iTermCompactLineStorageCompressedHeader)) {
+        return NO;
+    }
+    const iTermCompactLineStorageCompressedHeader *header = data.bytes;
+    return header->magic == iTermCompactLineStorageCompressedMagic;
+}
+
+NSData *iTermCompactLineStorageCompress(NSData *data) {
+    const int length = iTermCompactLineStorageLength(data);
+    if (length < 0 || iTermCompactLineStorageIsCompressed(data) || data.length > UINT32_MAX) {
+        return data;
+    }
+    uLongf compressedSize = compressBound(data.length);
+    NSMutableData *result =
+        [NSMutableData dataWithLength:sizeof(iTermCompactLineStorageCompressedHeader) + compressedSize];
+    iTermCompactLineStorageCompressedHeader *header = result.mutableBytes;
+    header->magic = iTermCompactLineStorageCompressedMagic;
+    header->length = length;
+    header->uncompressedSize = (uint32_t)data.length;
+    // Favor speed. This runs for every block that goes cold and the data is
+    // already much smaller than the raw buffer.
+    const int status = compress2((Bytef *)(header + 1),
+                                 &compressedSize,
+                                 data.bytes,
+                                 data.length,
+                                 Z_BEST_SPEED);
+    if (status != Z_OK) {
+        DLog(@"compress2 failed with %@", @(status));
+        return data;
+    }
+    result.length = sizeof(iTermCompactLineStorageCompressedHeader) + compressedSize;
+    return result;
+}
+
+static NSData *iTermCompactLineStorageDecompress(NSData *data) {
+    const iTermCompactLineStorageCompressedHeader *header = data.bytes;
+    NSMutableData *result = [NSMutableData dataWithLength:header->uncompressedSize];
+    uLongf size = header->uncompressedSize;
+    const int status = uncompress(result.mutableBytes,
+                                  &size,
+                                  (const Bytef *)(header + 1),
+                                  data.length - sizeof(*header));
+    if (status != Z_OK || size != header->uncompressedSize) {
+        DLog(@"uncompress failed with %@", @(status));
+        return nil;
+    }
+    return result;
+}
+
+int iTermCompactLineStorageLength(NSData *data) {
+    if (iTermCompactLineStorageIsCompressed(data)) {
+        const iTermCompactLineStorageCompressedHeader *header = data.bytes;
+        return header->length;
+    }
+    const iTermCompactLineStoragePackedHeader *packedHeader = iTermCompactLineStorageValidPackedHeader(data);
+    if (packedHeader) {
+        return packedHeader->length;
+    }
+    const iTermCompactLineStorageHeader *header = iTermCompactLineStorageValidHeader(data);
+    if (!header) {
+        return -1;
+    }
+    return header->length;
+}
+
+BOOL iTermCompactLineStorageDecode(NSData *data, screen_char_t *buffer, int capacity) {
+    if (iTermCompactLineStorageIsCompressed(data)) {
+        NSData *decompressed = iTermCompactLineStorageDecompress(data);
+        if (!decompressed || iTermCompactLineStorageIsCompressed(decompressed)) {
+            return NO;
+        }
+        return iTermCompactLineStorageDecode(decompressed, buffer, capacity);
+    }
+    const iTermCompactLineStoragePackedHeader *packedHeader = iTermCompactLineStorageValidPackedHeader(data);
+    if (packedHeader) {
+        if (packedHeader->length > capacity) {
+            return NO;
+        }
+        return iTermCompactLineStorageDecodePacked(packedHeader, buffer);
+    }
+    const iTermCompactLineStorageHeader *header = iTermCompactLineStorageValidHeader(data);
+    if (!header || header->length > capacity) {
+        return NO;
+    }
+    const iTermCompactLineStorageRun *runs = (const iTermCompactLineStorageRun *)(header + 1);
+    const unichar *codes = (const unichar *)(runs + header->numberOfRuns);
+    int i = 0;
+    for (int32_t run = 0; run < header->numberOfRuns; run++) {
+        const int32_t count = runs[run].count;
+        if (count < 0 || count > header->length - i) {
+            return NO;
+        }
+        for (int32_t j = 0; j < count; j++, i++) {
+            buffer[i] = runs[run].attributes;
+            buffer[i].code = codes[i];
+        }
+    }
+    return i == header->length;
+}
+
+// Not cryptographic; equal hashes are checked byte for byte.
+static uint64_t iTermCompactLineStorageHash(NSData *data) {
+    uint64_t hash = 0xcbf29ce484222325ULL ^ data.length;
+    const uint8_t *bytes = data.bytes;
+    const NSUInteger length = data.length;
+    NSUInteger i = 0;
+    for (; i + sizeof(uint64_t) <= length; i += sizeof(uint64_t)) {
+        uint64_t word;
+        memcpy(&word, bytes + i, sizeof(word));
+        hash = (hash ^ word) * 0x100000001b3ULL;
+        hash ^= hash >> 29;
+    }
+    for (; i < length; i++) {
+        hash = (hash ^ bytes[i]) * 0x100000001b3ULL;
+    }
+    return hash;
+}
+
+NSData *iTermCompactLineStorageDeduplicate(NSData *data) {
+    static NSMapTable<NSNumber *, NSData *> *table;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        table = [NSMapTable strongToWeakObjectsMapTable];
+    });
+    NSNumber *key = @(iTermCompactLineStorageHash(data));
+    NSData *existing = [table objectForKey:key];
+    if (existing && [existing isEqualToData:data]) {
+        return existing;
+    }
+    // On a hash collision the newer data wins. The older one is just not shared anymore.
+    [table setObject:data forKey:key];
+    return data;
+}
@@ -0,0 +1,200 @@
+//
+//  iTermConcurrentCache.h
+//  iTerm2SharedARC
+//
+//  Created by agent on 10/14/26.
+//
+
+#import <Foundation/Foundation.h>
+
+#include <algorithm>
+#include <atomic>
+#include <functional>
+#include <list>
+#include <mach/mach_time.h>
+#include <os/lock.h>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace iTerm2 {
+    // Counters shared by every cache with the same name. Never freed, so short-lived caches keep
+    // adding to the same totals. See iTermCacheStatisticsSummarize().
+    struct CacheStatistics {
+        const char *name;
+        std::atomic<uint64_t> hits;
+        std::atomic<uint64_t> misses;
+        std::atomic<uint64_t> evictions;
+        // Of the entries currently in all caches with this name.
+        std::atomic<int64_t> count;
+        std::atomic<int64_t> cost;
+        CacheStatistics *next;
+
+        // Returns the statistics for |name|, creating them on first use. Thread-safe.
+        static CacheStatistics *named(const char *name);
+        // The most recently created statistics. Follow |next| for the rest.
+        static CacheStatistics *first();
+    };
+
+    // A thread-safe LRU cache bounded by the total cost of its entries. Keys are spread over
+    // shards, each with its own lock and an equal share of the maximum cost, so threads looking up
+    // different keys rarely wait on each other. With one shard it is an exact LRU. When there is a
+    // time to live, older entries are treated as missing.
+    template<class Key, class Value, class Hash = std::hash<Key>, class KeyEqual = std::equal_to<Key>>
+    class ConcurrentCache {
+    public:
+        ConcurrentCache(const char *name,
+                        size_t maximum_cost,
+                        size_t number_of_shards = 8,
+                        NSTimeInterval time_to_live = 0) :
+        _statistics(CacheStatistics::named(name)),
+        _shards(std::max<size_t>(1, number_of_shards)),
+        _time_to_live(time_to_live > 0 ? mach_time_for_seconds(time_to_live) : 0) {
+            const size_t maximum_cost_per_shard = std::max<size_t>(1, maximum_cost / _shards.size());
+            for (Shard &shard : _shards) {
+                shard.maximum_cost = maximum_cost_per_shard;
+            }
+        }
+
+        ~ConcurrentCache() {
+            clear();
+        }
+
+        ConcurrentCache(const ConcurrentCache &) = delete;
+        ConcurrentCache &operator=(const ConcurrentCache &) = delete;
+
+        // Copies the value for |key| into |value| and returns true if present.
+        bool find(const Key &key, Value *value) {
+            Shard &shard = shard_for_key(key);
+            std::vector<Value> released;
+            os_unfair_lock_lock(&shard.lock);
+            auto it = shard.map.find(key);
+            bool found = false;
+            if (it != shard.map.end()) {
+                if (is_expired(*it->second)) {
+                    remove(shard, it->second, &released);
+                } else {
+                    shard.lru.splice(shard.lru.begin(), shard.lru, it->second);
+                    *value = it->second->value;
+                    found = true;
+                }
+            }
+            os_unfair_lock_unlock(&shard.lock);
+            (found ? _statistics->hits : _statistics->misses).fetch_add(1, std::memory_order_relaxed);
+            return found;
+        }
+
+        // Adds or replaces the value for |key| and evicts the least recently used entries in its
+        // shard until the shard is within its share of the maximum cost. The new entry is never
+        // evicted, even if it alone costs more.
+        void insert(const Key &key, const Value &value, size_t cost = 1) {
+            Shard &shard = shard_for_key(key);
+            std::vector<Value> released;
+            os_unfair_lock_lock(&shard.lock);
+            auto it = shard.map.find(key);
+            if (it != shard.map.end()) {
+                remove(shard, it->second, &released);
+            }
+            const uint64_t expiration = _time_to_live ? mach_absolute_time() + _time_to_live : 0;
+            shard.lru.push_front(Entry { key, value, cost, expiration });
+            shard.map[key] = shard.lru.begin();
+            shard.cost += cost;
+            _statistics->count.fetch_add(1, std::memory_order_relaxed);
+            _statistics->cost.fetch_add(cost, std::memory_order_relaxed);
+            while (shard.cost > shard.maximum_cost && shard.lru.size() > 1) {
+                remove(shard, std::prev(shard.lru.end()), &released);
+                _statistics->evictions.fetch_add(1, std::memory_order_relaxed);
+            }
+            os_unfair_lock_unlock(&shard.lock);
+        }
+
+        void erase(const Key &key) {
+            Shard &shard = shard_for_key(key);
+            std::vector<Value> released;
+            os_unfair_lock_lock(&shard.lock);
+            auto it = shard.map.find(key);
+            if (it != shard.map.end()) {
+                remove(shard, it->second, &released);
+            }
+            os_unfair_lock_unlock(&shard.lock);
+        }
+
+        void clear() {
+            for (Shard &shard : _shards) {
+                std::vector<Value> released;
+                os_unfair_lock_lock(&shard.lock);
+                while (!shard.lru.empty()) {
+                    remove(shard, shard.lru.begin(), &released);
+                }
+                os_unfair_lock_unlock(&shard.lock);
+            }
+        }
+
+    private:
+        struct Entry {
+            Key key;
+            Value value;
+            size_t cost;
+            // In mach absolute time units. 0 if it never expires.
+            uint64_t expiration;
+        };
+
+        typedef typename std::list<Entry>::iterator EntryIterator;
+
+        struct Shard {
+            os_unfair_lock lock = OS_UNFAIR_LOCK_INIT;
+            // Most recently used first.
+            std::list<Entry> lru;
+            std::unordered_map<Key, EntryIterator, Hash, KeyEqual> map;
+            size_t cost = 0;
+            size_t maximum_cost = 0;
+        };
+
+        static uint64_t mach_time_for_seconds(NSTimeInterval seconds) {
+            mach_timebase_info_data_t timebase;
+            mach_timebase_info(&timebase);
+            return (uint64_t)(seconds * NSEC_PER_SEC) * timebase.denom / timebase.numer;
+        }
+
+        Shard &shard_for_key(const Key &key) {
+            // Mix the hash since many hash functions leave the low bits nearly constant.
+            const size_t hash = _hasher(key) * 0x9E3779B97F4A7C15ULL;
+            return _shards[(hash >> 32) % _shards.size()];
+        }
+
+        bool is_expired(const Entry &entry) const {
+            return entry.expiration && mach_absolute_time() >= entry.expiration;
+        }
+
+        // Call with the shard locked. The value is moved to |released| so it is destroyed after
+        // the lock is dropped, since destroying a value may be slow.
+        void remove(Shard &shard, EntryIterator it, std::vector<Value> *released) {
+            released->push_back(std::move(it->value));
+            shard.cost -= it->cost;
+            _statistics->count.fetch_sub(1, std::memory_order_relaxed);
+            _statistics->cost.fetch_sub(it->cost, std::memory_order_relaxed);
+            shard.map.erase(it->key);
+            shard.lru.erase(it);
+        }
+
+        CacheStatistics *const _statistics;
+        std::vector<Shard> _shards;
+        const uint64_t _time_to_live;
+        Hash _hasher;
+    };
+
+#ifdef __OBJC__
+    // For caches keyed by Objective-C objects.
+    struct ObjectHash {
+        size_t operator()(id object) const {
+            return [object hash];
+        }
+    };
+
+    struct ObjectEqual {
+        bool operator()(id lhs, id rhs) const {
+            return [lhs isEqual:rhs];
+        }
+    };
+#endif
+}
@@ -35,6 +35,7 @@
 #import "iTermBuriedSessions.h"
 #import "iTermHotKeyController.h"
 #import "iTermMissionControlHacks.h"
+#import "iTermMultiServerJobManager.h"
 #import "iTermPresentationController.h"
 #import "iTermProfileModelJournal.h"
 #import "iTermRestorableStateController.h"
@@ -65,6 +66,7 @@
 #import "iTermProfilePreferences.h"
 #import "iTermRestorableSession.h"
 #import "iTermSetCurrentTerminalHelper.h"
+#import "iTermStartupScheduler.h"
 #import "iTermSystemVersion.h"
 #import "iTermUserDefaults.h"
 #import "iTermWarning.h"
@@ -485,12 +487,16 @@ replaceInitialDirectoryForSessionWithGUID:(NSString *)guid
 
 - (void)tryOpenArrangement:(NSDictionary *)terminalArrangement
                      named:(NSString *)arrangementName
-            asTabsInWindow:(PseudoTerminal *)term {
+            asTabsInWindow:(PseudoTerminal *)term
+                completion:(void (^)(PseudoTerminal *))completion {
     if (term) {
         [term restoreTabsFromArrangement:terminalArrangement
                                    named:arrangementName
                                 sessions:nil
                       partialAttachments:nil];
+        if (completion) {
+            completion(term);
+        }
         return;
     }
     BOOL shouldDelay = NO;
@@ -508,7 +514,10 @@ replaceInitialDirectoryForSessionWithGUID:(NSString *)guid
     if (shouldDelay) {
         DLog(@"Trying again in .25 sec");
         dispatch_after(dispatch_time(DISPATCH_TIME_NOW, (int64_t)(0.25 * NSEC_PER_SEC)), dispatch_get_main_queue(), ^{
-            [self tryOpenArrangement:terminalArrangement named:arrangementName asTabsInWindow:term];
+            [self tryOpenArrangement:terminalArrangement
+                               named:arrangementName
+                      asTabsInWindow:term
+                          completion:completion];
         });
     } else {
         DLog(@"Opening it.");
@@ -518,15 +527,50 @@ replaceInitialDirectoryForSessionWithGUID:(NSString *)guid
         if (term) {
           [self addTerminalWindow:term];
         }
+        if (completion) {
+            completion(term);
+        }
     }
 }
 
+// Opens one window per spin of the runloop, in order, so each window is drawn and its jobs begin
+// launching while later windows are still being built.
+- (void)openArrangementsProgressively:(NSArray<NSDictionary *> *)terminalArrangements
+                            fromIndex:(NSUInteger)index
+                                named:(NSString *)arrangementName {
+    if (index >= terminalArrangements.count) {
+        DLog(@"Finished opening arrangement %@", arrangementName);
+        return;
+    }
+    DLog(@"Open window %@ of %@ in arrangement %@", @(index + 1), @(terminalArrangements.count), arrangementName);
+    [self tryOpenArrangement:terminalArrangements[index]
+                       named:arrangementName
+              asTabsInWindow:nil
+                  completion:^(PseudoTerminal *term) {
+        [term.window displayIfNeeded];
+        dispatch_async(dispatch_get_main_queue(), ^{
+            [self openArrangementsProgressively:terminalArrangements
+                                      fromIndex:index + 1
+                                          named:arrangementName];
+        });
+    }];
+}
+
 - (BOOL)loadWindowArrangementWithName:(NSString *)theName asTabsInTerminal:(PseudoTerminal *)term {
     BOOL ok = NO;
     NSArray *terminalArrangements = [WindowArrangements arrangementWithName:theName];
+    if (!term &&
+        terminalArrangements.count > 1 &&
+        [iTermAdvancedSettingsModel progressiveArrangementRestoration]) {
+        if ([iTermAdvancedSettingsModel runJobsInServers]) {
+            [iTermMultiServerJobManager prepareToLaunchJobs];
+        }
+        [self openArrangementsProgressively:terminalArrangements fromIndex:0 named:theName];
+        return YES;
+    }
     if (terminalArrangements) {
         for (NSDictionary *terminalArrangement in terminalArrangements) {
-            [self tryOpenArrangement:terminalArrangement named:theName asTabsInWindow:term];
+            [self tryOpenArrangement:terminalArrangement named:theName asTabsInWindow:term completion:nil];
             ok = YES;
         }
     }
@@ -1358,6 +1402,9 @@ replaceInitialDirectoryForSessionWithGUID:(NSString *)guid
         return;
     }
 
+    if (_terminalWindows.count == 0) {
+        [[iTermStartupScheduler sharedInstance] mark:@"First window"];
+    }
     [_terminalWindows addObject:terminalWindow];
     [self updateWindowTitles];
     [self updateProcessType];
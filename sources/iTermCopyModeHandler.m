@@ -21,9 +21,11 @@ typedef NS_ENUM(NSUInteger, iTermCopyModeAction) {
     iTermCopyModeActionExitCopyMode,
     iTermCopyModeActionMoveBackwardWord,
     iTermCopyModeActionMoveBackwardBigWord,
+    iTermCopyModeActionMoveBackwardParagraph,
     iTermCopyModeActionMoveDown,
     iTermCopyModeActionMoveForwardWord,
     iTermCopyModeActionMoveForwardBigWord,
+    iTermCopyModeActionMoveForwardParagraph,
     iTermCopyModeActionMoveLeft,
     iTermCopyModeActionMoveRight,
     iTermCopyModeActionMoveToBottomOfVisibleArea,
@@ -192,6 +194,10 @@ static const NSEventModifierFlags sCopyModeEventModifierMask = (NSEventModifierF
             return [_state moveForwardWord];
         case iTermCopyModeActionMoveForwardBigWord:
             return [_state moveForwardBigWord];
+        case iTermCopyModeActionMoveBackwardParagraph:
+            return [_state moveBackwardParagraph];
+        case iTermCopyModeActionMoveForwardParagraph:
+            return [_state moveForwardParagraph];
         case iTermCopyModeActionMoveToStartOfIndentation:
             return [_state moveToStartOfIndentation];
         case iTermCopyModeActionMoveToStartOfNextLine:
@@ -360,6 +366,10 @@ static const NSEventModifierFlags sCopyModeEventModifierMask = (NSEventModifierF
                 return iTermCopyModeActionNextMark;
             case '^':
                 return iTermCopyModeActionMoveToStartOfIndentation;
+            case '{':
+                return iTermCopyModeActionMoveBackwardParagraph;
+            case '}':
+                return iTermCopyModeActionMoveForwardParagraph;
             case '$':
                 return iTermCopyModeActionMoveToEndOfLine;
         }
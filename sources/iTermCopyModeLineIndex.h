@@ -0,0 +1,37 @@
+//
+//  iTermCopyModeLineIndex.h
+//  iTerm2SharedARC
+//
+//  Created by agent on 10/14/26.
+//
+
+#import <Foundation/Foundation.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+@protocol PTYTextViewDataSource;
+
+// Remembers which lines are blank so copy mode motions can skip runs of blank lines (and runs of
+// nonblank lines, for paragraph motions) without reading their cells again. Lines are classified
+// lazily in blocks. Only blocks entirely in scrollback are kept, since lines on the screen can
+// still change.
+@interface iTermCopyModeLineIndex : NSObject
+
+@property (nonatomic, readonly, weak) id<PTYTextViewDataSource> dataSource;
+
+- (instancetype)initWithDataSource:(id<PTYTextViewDataSource>)dataSource NS_DESIGNATED_INITIALIZER;
+- (instancetype)init NS_UNAVAILABLE;
+
+- (BOOL)absLineIsBlank:(long long)absLine;
+
+// Returns the last column with a nonblank character or -1 if the line is blank.
+- (int)lastNonBlankColumnOnAbsLine:(long long)absLine;
+
+// Returns the first line after (or before) |absLine| whose blankness is |blank|, or -1 if there is
+// none.
+- (long long)absLineAfter:(long long)absLine blank:(BOOL)blank;
+- (long long)absLineBefore:(long long)absLine blank:(BOOL)blank;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,189 @@
+//
+//  iTermCopyModeLineIndex.m
+//  iTerm2SharedARC
+//
+//  Created by agent on 10/14/26.
+//
+
+#import "iTermCopyModeLineIndex.h"
+
+#import "PTYTextViewDataSource.h"
+#import "ScreenChar.h"
+
+static const long long iTermCopyModeLineIndexBlockSize = 256;
+
+@interface iTermCopyModeLineIndexBlock : NSObject
+// One entry per line: the last nonblank column or -1.
+@property (nonatomic, readonly) int *lastNonBlankColumns;
+@property (nonatomic) int numberOfBlankLines;
+@end
+
+@implementation iTermCopyModeLineIndexBlock {
+    NSMutableData *_data;
+}
+
+- (instancetype)init {
+    self = [super init];
+    if (self) {
+        _data = [NSMutableData dataWithLength:sizeof(int) * iTermCopyModeLineIndexBlockSize];
+    }
+    return self;
+}
+
+- (int *)lastNonBlankColumns {
+    return (int *)_data.mutableBytes;
+}
+
+@end
+
+@implementation iTermCopyModeLineIndex {
+    // Block number (absolute line / block size) -> block
+    NSMutableDictionary<NSNumber *, iTermCopyModeLineIndexBlock *> *_blocks;
+    int _width;
+    // Absolute line number of the first line on the screen when blocks were last validated.
+    long long _firstMutableLine;
+    NSMutableData *_buffer;
+}
+
+- (instancetype)initWithDataSource:(id<PTYTextViewDataSource>)dataSource {
+    self = [super init];
+    if (self) {
+        _dataSource = dataSource;
+        _blocks = [NSMutableDictionary dictionary];
+        _buffer = [NSMutableData data];
+    }
+    return self;
+}
+
+#pragma mark - API
+
+- (BOOL)absLineIsBlank:(long long)absLine {
+    return [self lastNonBlankColumnOnAbsLine:absLine] < 0;
+}
+
+- (int)lastNonBlankColumnOnAbsLine:(long long)absLine {
+    [self validate];
+    iTermCopyModeLineIndexBlock *block = [self blockContainingAbsLine:absLine];
+    if (block) {
+        return block.lastNonBlankColumns[absLine % iTermCopyModeLineIndexBlockSize];
+    }
+    return [self computeLastNonBlankColumnOnAbsLine:absLine];
+}
+
+- (long long)absLineAfter:(long long)absLine blank:(BOOL)blank {
+    [self validate];
+    const long long limit = [self absLineLimit];
+    long long line = MAX(absLine + 1, [self absLineStart]);
+    while (line < limit) {
+        iTermCopyModeLineIndexBlock *block = [self blockContainingAbsLine:line];
+        if (block && line % iTermCopyModeLineIndexBlockSize == 0 && ![self block:block canHaveLinesThatAreBlank:blank]) {
+            line += iTermCopyModeLineIndexBlockSize;
+            continue;
+        }
+        if (([self lastNonBlankColumnOnAbsLine:line] < 0) == blank) {
+            return line;
+        }
+        line++;
+    }
+    return -1;
+}
+
+- (long long)absLineBefore:(long long)absLine blank:(BOOL)blank {
+    [self validate];
+    const long long start = [self absLineStart];
+    long long line = MIN(absLine - 1, [self absLineLimit] - 1);
+    while (line >= start) {
+        iTermCopyModeLineIndexBlock *block = [self blockContainingAbsLine:line];
+        if (block && (line + 1) % iTermCopyModeLineIndexBlockSize == 0 && ![self block:block canHaveLinesThatAreBlank:blank]) {
+            line -= iTermCopyModeLineIndexBlockSize;
+            continue;
+        }
+        if (([self lastNonBlankColumnOnAbsLine:line] < 0) == blank) {
+            return line;
+        }
+        line--;
+    }
+    return -1;
+}
+
+#pragma mark - Private
+
+- (BOOL)block:(iTermCopyModeLineIndexBlock *)block canHaveLinesThatAreBlank:(BOOL)blank {
+    if (blank) {
+        return block.numberOfBlankLines > 0;
+    }
+    return block.numberOfBlankLines < iTermCopyModeLineIndexBlockSize;
+}
+
+- (long long)absLineStart {
+    return _dataSource.totalScrollbackOverflow;
+}
+
+- (long long)absLineLimit {
+    return _dataSource.totalScrollbackOverflow + _dataSource.numberOfLines;
+}
+
+// Drops blocks that may no longer describe the buffer.
+- (void)validate {
+    id<PTYTextViewDataSource> dataSource = _dataSource;
+    const long long firstMutableLine = dataSource.totalScrollbackOverflow + dataSource.numberOfScrollbackLines;
+    if (dataSource.width != _width || firstMutableLine < _firstMutableLine) {
+        // Reflowed or cleared.
+        [_blocks removeAllObjects];
+        _width = dataSource.width;
+    }
+    _firstMutableLine = firstMutableLine;
+    const long long firstBlock = dataSource.totalScrollbackOverflow / iTermCopyModeLineIndexBlockSize;
+    for (NSNumber *key in [_blocks.allKeys copy]) {
+        if (key.longLongValue < firstBlock) {
+            [_blocks removeObjectForKey:key];
+        }
+    }
+}
+
+// Returns nil if the block can't be cached.
+- (iTermCopyModeLineIndexBlock *)blockContainingAbsLine:(long long)absLine {
+    const long long blockNumber = absLine / iTermCopyModeLineIndexBlockSize;
+    const long long firstLine = blockNumber * iTermCopyModeLineIndexBlockSize;
+    if (firstLine < [self absLineStart] || firstLine + iTermCopyModeLineIndexBlockSize > _firstMutableLine) {
+        return nil;
+    }
+    iTermCopyModeLineIndexBlock *block = _blocks[@(blockNumber)];
+    if (block) {
+        return block;
+    }
+    block = [[iTermCopyModeLineIndexBlock alloc] init];
+    int blankLines = 0;
+    int *columns = block.lastNonBlankColumns;
+    for (long long i = 0; i < iTermCopyModeLineIndexBlockSize; i++) {
+        columns[i] = [self computeLastNonBlankColumnOnAbsLine:firstLine + i];
+        if (columns[i] < 0) {
+            blankLines++;
+        }
+    }
+    block.numberOfBlankLines = blankLines;
+    _blocks[@(blockNumber)] = block;
+    return block;
+}
+
+- (int)computeLastNonBlankColumnOnAbsLine:(long long)absLine {
+    id<PTYTextViewDataSource> dataSource = _dataSource;
+    const long long line = absLine - dataSource.totalScrollbackOverflow;
+    if (line < 0 || line >= dataSource.numberOfLines) {
+        return -1;
+    }
+    const int width = dataSource.width;
+    const NSUInteger length = sizeof(screen_char_t) * (width + 1);
+    if (_buffer.length < length) {
+        _buffer.length = length;
+    }
+    const screen_char_t *chars = [dataSource getLineAtIndex:(int)line withBuffer:_buffer.mutableBytes];
+    for (int x = width - 1; x >= 0; x--) {
+        if (chars[x].complexChar || chars[x].image || (chars[x].code != 0 && chars[x].code != ' ')) {
+            return x;
+        }
+    }
+    return -1;
+}
+
+@end
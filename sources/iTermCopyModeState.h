@@ -47,6 +47,9 @@
 
 - (BOOL)moveToStartOfIndentation;
 
+- (BOOL)moveForwardParagraph;
+- (BOOL)moveBackwardParagraph;
+
 - (BOOL)moveToBottomOfVisibleArea;
 - (BOOL)moveToMiddleOfVisibleArea;
 - (BOOL)moveToTopOfVisibleArea;
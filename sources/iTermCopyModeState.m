@@ -7,12 +7,16 @@
 //
 
 #import "iTermCopyModeState.h"
+#import "iTermAdvancedSettingsModel.h"
+#import "iTermCopyModeLineIndex.h"
 #import "iTermSelection.h"
 #import "iTermTextExtractor.h"
 #import "PTYTextView.h"
 #import "PTYTextViewDataSource.h"
 
-@implementation iTermCopyModeState
+@implementation iTermCopyModeState {
+    iTermCopyModeLineIndex *_lineIndex;
+}
 
 - (instancetype)init {
     self = [super init];
@@ -24,6 +28,7 @@
 
 - (void)dealloc {
     [_textView release];
+    [_lineIndex release];
     [super dealloc];
 }
 
@@ -161,6 +166,32 @@
     return [self moveInDirection:kPTYTextViewSelectionExtensionDirectionStartOfIndentation unit:kPTYTextViewSelectionExtensionUnitCharacter];
 }
 
+// Like vi's }: moves to the first blank line after the current paragraph.
+- (BOOL)moveForwardParagraph {
+    iTermCopyModeLineIndex *index = [self lineIndex];
+    const long long overflow = _textView.dataSource.totalScrollbackOverflow;
+    const long long line = _coord.y + overflow;
+    const long long nonBlank = [index absLineIsBlank:line] ? [index absLineAfter:line blank:NO] : line;
+    const long long blank = nonBlank < 0 ? -1 : [index absLineAfter:nonBlank blank:YES];
+    if (blank < 0) {
+        return [self moveToEnd];
+    }
+    return [self moveToAbsCoord:VT100GridAbsCoordMake(0, blank)];
+}
+
+// Like vi's {: moves to the last blank line before the current paragraph.
+- (BOOL)moveBackwardParagraph {
+    iTermCopyModeLineIndex *index = [self lineIndex];
+    const long long overflow = _textView.dataSource.totalScrollbackOverflow;
+    const long long line = _coord.y + overflow;
+    const long long nonBlank = [index absLineIsBlank:line] ? [index absLineBefore:line blank:NO] : line;
+    const long long blank = nonBlank < 0 ? -1 : [index absLineBefore:nonBlank blank:YES];
+    if (blank < 0) {
+        return [self moveToStart];
+    }
+    return [self moveToAbsCoord:VT100GridAbsCoordMake(0, blank)];
+}
+
 - (void)setSelecting:(BOOL)selecting {
     if (selecting == _selecting) {
         return;
@@ -211,6 +242,59 @@
     return VT100GridWindowedRangeMake(VT100GridCoordRangeMake(_coord.x, _coord.y, 0, 0), 0, 0);
 }
 
+- (iTermCopyModeLineIndex *)lineIndex {
+    if (_lineIndex.dataSource != _textView.dataSource) {
+        [_lineIndex release];
+        _lineIndex = [[iTermCopyModeLineIndex alloc] initWithDataSource:_textView.dataSource];
+    }
+    return _lineIndex;
+}
+
+- (BOOL)moveToAbsCoord:(VT100GridAbsCoord)absCoord {
+    const VT100GridCoord before = _coord;
+    const long long overflow = _textView.dataSource.totalScrollbackOverflow;
+    _coord = VT100GridCoordFromAbsCoord(absCoord, overflow, nil);
+    [self updateSelection];
+    return !VT100GridCoordEquals(before, _coord);
+}
+
+// Word motions read cells one at a time, which is slow across a long run of blank lines. This
+// moves the coord to the far end of such a run first so the word motion only has to look at the
+// line where it lands. Returns YES if it moved.
+- (BOOL)skipBlankLinesInDirection:(PTYTextViewSelectionExtensionDirection)direction {
+    iTermCopyModeLineIndex *index = [self lineIndex];
+    const long long overflow = _textView.dataSource.totalScrollbackOverflow;
+    const long long line = _coord.y + overflow;
+    switch (direction) {
+        case kPTYTextViewSelectionExtensionDirectionRight: {
+            if ([index lastNonBlankColumnOnAbsLine:line] >= _coord.x) {
+                return NO;
+            }
+            const long long next = [index absLineAfter:line blank:NO];
+            if (next < 0 || next - 1 <= line) {
+                return NO;
+            }
+            // The last cell of the last blank line, so the word motion lands on the first word.
+            _coord = VT100GridCoordMake(_textView.dataSource.width - 1, next - 1 - overflow);
+            return YES;
+        }
+        case kPTYTextViewSelectionExtensionDirectionLeft: {
+            if (![index absLineIsBlank:line]) {
+                return NO;
+            }
+            const long long previous = [index absLineBefore:line blank:NO];
+            if (previous < 0 || previous + 1 >= line) {
+                return NO;
+            }
+            // The first cell of the first blank line, so the word motion lands on the last word.
+            _coord = VT100GridCoordMake(0, previous + 1 - overflow);
+            return YES;
+        }
+        default:
+            return NO;
+    }
+}
+
 - (iTermTextExtractor *)extractor {
     return [[[iTermTextExtractor alloc] initWithDataSource:_textView.dataSource] autorelease];
 }
@@ -229,6 +313,11 @@
                    unit:(PTYTextViewSelectionExtensionUnit)unit {
     VT100GridCoord before = _coord;
 
+    if ((unit == kPTYTextViewSelectionExtensionUnitWord || unit == kPTYTextViewSelectionExtensionUnitBigWord) &&
+        [iTermAdvancedSettingsModel indexCopyModeMotions]) {
+        [self skipBlankLinesInDirection:direction];
+    }
+
     // Move coord
     iTermTextExtractor *extractor = [self extractor];
     [extractor restrictToLogicalWindowIncludingCoord:_coord];
@@ -244,16 +333,22 @@
                                                                         unit:unit];
     _coord = VT100GridCoordFromAbsCoord(range.coordRange.start, overflow, nil);
 
-    // Make a new selection
-    if (_selecting) {
-        [_textView.selection beginSelectionAtAbsCoord:VT100GridAbsCoordFromCoord(_start, overflow)
-                                                 mode:_mode
-                                               resume:NO
-                                               append:NO];
-        [_textView.selection moveSelectionEndpointTo:VT100GridAbsCoordFromCoord(_coord, overflow)];
-        [_textView.selection endLiveSelection];
-    }
+    [self updateSelection];
     return !VT100GridCoordEquals(before, _coord);
 }
 
+// Make a new selection
+- (void)updateSelection {
+    if (!_selecting) {
+        return;
+    }
+    const long long overflow = _textView.dataSource.totalScrollbackOverflow;
+    [_textView.selection beginSelectionAtAbsCoord:VT100GridAbsCoordFromCoord(_start, overflow)
+                                             mode:_mode
+                                           resume:NO
+                                           append:NO];
+    [_textView.selection moveSelectionEndpointTo:VT100GridAbsCoordFromCoord(_coord, overflow)];
+    [_textView.selection endLiveSelection];
+}
+
 @end
@@ -9,6 +9,7 @@
 
 #import "DebugLogging.h"
 #import "FMDatabase.h"
+#import "iTermAdvancedSettingsModel.h"
 
 @interface FMResultSet (iTerm)<iTermDatabaseResultSet>
 @end
@@ -231,6 +232,8 @@ typedef enum {
     }
 
     DLog(@"Opened db and passed integrity check.");
+    // The same few inserts and updates are run for every changed node, so keep them prepared.
+    _db.shouldCacheStatements = [iTermAdvancedSettingsModel checkpointStateDatabaseInBackground];
     return YES;
 }
 
@@ -60,7 +60,7 @@
         iTermDirectoryTreeNode *node = parent.children[part];
         if (!node) {
             node = [iTermDirectoryTreeNode nodeWithComponent:part];
-            parent.children[part] = node;
+            [parent setChild:node forComponent:part];
         }
         node.count = node.count + 1;
         parent = node;
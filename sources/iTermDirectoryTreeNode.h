@@ -17,6 +17,7 @@
 - (id)initWithComponent:(NSString *)component;
 + (instancetype)nodeWithComponent:(NSString *)component;
 - (int)numberOfChildrenStartingWithString:(NSString *)prefix;
+- (void)setChild:(iTermDirectoryTreeNode *)child forComponent:(NSString *)component;
 - (void)removePathWithParts:(NSArray *)parts;
 
 @end
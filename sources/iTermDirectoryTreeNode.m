@@ -8,7 +8,10 @@
 
 #import "iTermDirectoryTreeNode.h"
 
-@implementation iTermDirectoryTreeNode
+@implementation iTermDirectoryTreeNode {
+    // Counts children by their first character so abbreviation checks don't scan every child.
+    NSCountedSet<NSString *> *_firstCharacters;
+}
 
 + (instancetype)nodeWithComponent:(NSString *)component {
     return [[[self alloc] initWithComponent:component] autorelease];
@@ -19,6 +22,7 @@
     if (self) {
         _component = [component copy];
         _children = [[NSMutableDictionary alloc] init];
+        _firstCharacters = [[NSCountedSet alloc] init];
     }
     return self;
 }
@@ -29,6 +33,9 @@
 }
 
 - (int)numberOfChildrenStartingWithString:(NSString *)prefix {
+    if (prefix.length == 1) {
+        return (int)[_firstCharacters countForObject:prefix];
+    }
     int number = 0;
     for (NSString *child in _children) {
         if ([child hasPrefix:prefix]) {
@@ -41,9 +48,24 @@
 - (void)dealloc {
     [_component release];
     [_children release];
+    [_firstCharacters release];
     [super dealloc];
 }
 
+- (void)setChild:(iTermDirectoryTreeNode *)child forComponent:(NSString *)component {
+    if (!_children[component] && component.length > 0) {
+        [_firstCharacters addObject:[component substringToIndex:1]];
+    }
+    _children[component] = child;
+}
+
+- (void)removeChildForComponent:(NSString *)component {
+    if (_children[component] && component.length > 0) {
+        [_firstCharacters removeObject:[component substringToIndex:1]];
+    }
+    [_children removeObjectForKey:component];
+}
+
 - (void)removePathWithParts:(NSArray *)parts {
     --_count;
     if (parts.count > 1) {
@@ -52,7 +74,7 @@
         iTermDirectoryTreeNode *node = _children[firstPart];
         [node removePathWithParts:tailParts];
         if (!node.count) {
-            [_children removeObjectForKey:firstPart];
+            [self removeChildForComponent:firstPart];
         }
     }
 }
@@ -0,0 +1,37 @@
+//
+//  iTermDisplayLinkTimer.h
+//  iTerm2SharedARC
+//
+//  Created by agent on 10/14/26.
+//
+
+#import <Cocoa/Cocoa.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+// Like iTermGCDTimer but fires on the main thread just after a vertical blank of a screen, so
+// redraws line up with the display's refresh instead of drifting against it. All timers on the
+// same display share one CVDisplayLink, which is stopped while it has no timers. Holds a weak
+// reference to target.
+@interface iTermDisplayLinkTimer : NSObject
+
+// Minimum time between fires. It is rounded to a whole number of refreshes; 0 fires on every
+// refresh, which is the display's maximum rate (e.g., 120Hz on a ProMotion panel).
+@property (nonatomic) NSTimeInterval interval;
+
+// The screen whose refresh drives the timer. Defaults to the main screen. Setting this when the
+// window moves keeps the timer in sync with the display it's actually on.
+@property (nullable, nonatomic, strong) NSScreen *screen;
+
+// Time between refreshes of the current screen, or 0 if its display link couldn't be created.
+@property (nonatomic, readonly) NSTimeInterval refreshPeriod;
+
+- (instancetype)initWithInterval:(NSTimeInterval)interval
+                          target:(id)target // WEAK!
+                        selector:(SEL)selector NS_DESIGNATED_INITIALIZER;
+- (instancetype)init NS_UNAVAILABLE;
+- (void)invalidate;
+
+@end
+
+NS_ASSUME_NONNULL_END
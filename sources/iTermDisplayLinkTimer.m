@@ -0,0 +1,222 @@
+//
+//  iTermDisplayLinkTimer.m
+//  iTerm2SharedARC
+//
+//  Created by agent on 10/14/26.
+//
+
+#import "iTermDisplayLinkTimer.h"
+
+#import "DebugLogging.h"
+#import "NSObject+iTerm.h"
+#import "NSScreen+iTerm.h"
+
+#import <QuartzCore/QuartzCore.h>
+#import <stdatomic.h>
+
+@class iTermDisplayLinkSource;
+
+@interface iTermDisplayLinkTimer()
+- (void)displayDidRefresh;
+@end
+
+// Owns the CVDisplayLink for one display and fans its refreshes out to timers on the main thread.
+// Sources live forever since the display link's callback holds an unretained pointer to them.
+@interface iTermDisplayLinkSource : NSObject
+@property (nonatomic, readonly) NSTimeInterval refreshPeriod;
++ (instancetype)sourceForDisplayID:(CGDirectDisplayID)displayID;
+- (void)addTimer:(iTermDisplayLinkTimer *)timer;
+- (void)removeTimer:(iTermDisplayLinkTimer *)timer;
+@end
+
+static CVReturn iTermDisplayLinkSourceCallback(CVDisplayLinkRef displayLink,
+                                               const CVTimeStamp *now,
+                                               const CVTimeStamp *outputTime,
+                                               CVOptionFlags flagsIn,
+                                               CVOptionFlags *flagsOut,
+                                               void *context);
+
+@implementation iTermDisplayLinkSource {
+    CGDirectDisplayID _displayID;
+    CVDisplayLinkRef _displayLink;
+    NSHashTable<iTermDisplayLinkTimer *> *_timers;
+    // Set while a refresh is queued on the main thread so a busy main thread doesn't build up a
+    // backlog of them.
+    atomic_bool _pending;
+}
+
++ (instancetype)sourceForDisplayID:(CGDirectDisplayID)displayID {
+    static NSMutableDictionary<NSNumber *, iTermDisplayLinkSource *> *sources;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        sources = [NSMutableDictionary dictionary];
+    });
+    iTermDisplayLinkSource *source = sources[@(displayID)];
+    if (!source) {
+        source = [[self alloc] initWithDisplayID:displayID];
+        sources[@(displayID)] = source;
+    }
+    return source;
+}
+
+- (instancetype)initWithDisplayID:(CGDirectDisplayID)displayID {
+    self = [super init];
+    if (self) {
+        _displayID = displayID;
+        _timers = [NSHashTable weakObjectsHashTable];
+        atomic_init(&_pending, false);
+        if (CVDisplayLinkCreateWithCGDisplay(displayID, &_displayLink) != kCVReturnSuccess) {
+            DLog(@"Failed to create display link for display %@", @(displayID));
+            _displayLink = NULL;
+        } else {
+            CVDisplayLinkSetOutputCallback(_displayLink,
+                                           iTermDisplayLinkSourceCallback,
+                                           (__bridge void *)self);
+        }
+    }
+    return self;
+}
+
+- (NSTimeInterval)refreshPeriod {
+    if (!_displayLink) {
+        return 0;
+    }
+    const double actual = CVDisplayLinkGetActualOutputVideoRefreshPeriod(_displayLink);
+    if (actual > 0) {
+        return actual;
+    }
+    const CVTime nominal = CVDisplayLinkGetNominalOutputVideoRefreshPeriod(_displayLink);
+    if (nominal.flags & kCVTimeIsIndefinite || nominal.timeScale == 0) {
+        return 0;
+    }
+    return (double)nominal.timeValue / (double)nominal.timeScale;
+}
+
+- (void)addTimer:(iTermDisplayLinkTimer *)timer {
+    [_timers addObject:timer];
+    if (_displayLink && !CVDisplayLinkIsRunning(_displayLink)) {
+        DLog(@"Start display link for display %@", @(_displayID));
+        CVDisplayLinkStart(_displayLink);
+    }
+}
+
+- (void)removeTimer:(iTermDisplayLinkTimer *)timer {
+    [_timers removeObject:timer];
+    [self stopIfUnused];
+}
+
+- (void)stopIfUnused {
+    if (_timers.allObjects.count > 0) {
+        return;
+    }
+    if (_displayLink && CVDisplayLinkIsRunning(_displayLink)) {
+        DLog(@"Stop display link for display %@", @(_displayID));
+        CVDisplayLinkStop(_displayLink);
+    }
+}
+
+// Display link thread
+- (void)displayLinkDidFire {
+    if (atomic_exchange(&_pending, true)) {
+        return;
+    }
+    dispatch_async(dispatch_get_main_queue(), ^{
+        atomic_store(&self->_pending, false);
+        [self didRefresh];
+    });
+}
+
+// Main thread
+- (void)didRefresh {
+    NSArray<iTermDisplayLinkTimer *> *timers = _timers.allObjects;
+    if (timers.count == 0) {
+        [self stopIfUnused];
+        return;
+    }
+    for (iTermDisplayLinkTimer *timer in timers) {
+        [timer displayDidRefresh];
+    }
+}
+
+@end
+
+static CVReturn iTermDisplayLinkSourceCallback(CVDisplayLinkRef displayLink,
+                                               const CVTimeStamp *now,
+                                               const CVTimeStamp *outputTime,
+                                               CVOptionFlags flagsIn,
+                                               CVOptionFlags *flagsOut,
+                                               void *context) {
+    iTermDisplayLinkSource *source = (__bridge iTermDisplayLinkSource *)context;
+    [source displayLinkDidFire];
+    return kCVReturnSuccess;
+}
+
+@implementation iTermDisplayLinkTimer {
+    __weak id _target;
+    SEL _selector;
+    iTermDisplayLinkSource *_source;
+    CFTimeInterval _lastFireTime;
+    BOOL _valid;
+}
+
+- (instancetype)initWithInterval:(NSTimeInterval)interval target:(id)target selector:(SEL)selector {
+    self = [super init];
+    if (self) {
+        _target = target;
+        _selector = selector;
+        _interval = interval;
+        _valid = YES;
+        self.screen = [NSScreen mainScreen];
+    }
+    return self;
+}
+
+- (void)dealloc {
+    [_source removeTimer:self];
+}
+
+- (void)setScreen:(NSScreen *)screen {
+    _screen = screen;
+    if (!_valid) {
+        return;
+    }
+    iTermDisplayLinkSource *source = [iTermDisplayLinkSource sourceForDisplayID:(screen ?: [NSScreen mainScreen]).it_displayID];
+    if (source == _source) {
+        return;
+    }
+    [_source removeTimer:self];
+    _source = source;
+    [_source addTimer:self];
+}
+
+- (NSTimeInterval)refreshPeriod {
+    return _source.refreshPeriod;
+}
+
+- (void)invalidate {
+    _valid = NO;
+    [_source removeTimer:self];
+    _source = nil;
+}
+
+- (void)displayDidRefresh {
+    if (!_valid) {
+        return;
+    }
+    const CFTimeInterval now = CACurrentMediaTime();
+    // Allow half a refresh of slop so that an interval that's a multiple of the refresh period
+    // isn't pushed to the following refresh by jitter.
+    const NSTimeInterval slop = self.refreshPeriod / 2;
+    if (now - _lastFireTime + slop < _interval) {
+        return;
+    }
+    _lastFireTime = now;
+    __strong id strongTarget = _target;
+    if (!strongTarget) {
+        [self invalidate];
+        return;
+    }
+    [strongTarget it_performNonObjectReturningSelector:_selector withObject:self];
+}
+
+@end
@@ -15,6 +15,7 @@
 #import "iTermScriptHistory.h"
 #import "iTermWarning.h"
 #import "NSArray+iTerm.h"
+#import "NSData+iTerm.h"
 #import "NSDictionary+iTerm.h"
 #import "NSDictionary+Profile.h"
 #import "NSFileManager+iTerm.h"
@@ -58,12 +59,91 @@
 
 @end
 
+// The parsed root element of one dynamic profiles file. Remembering it lets a reload skip parsing
+// files whose contents haven't changed.
+@interface iTermDynamicProfileFile: NSObject
+@property (nonatomic, readonly) NSData *digest;
+// nil if the file couldn't be read or parsed, in which case |error| says why.
+@property (nonatomic, readonly) NSDictionary *root;
+@property (nonatomic, readonly) iTermDynamicProfileFileType fileType;
+@property (nonatomic, readonly) NSString *error;
+@end
+
+@implementation iTermDynamicProfileFile
+
+- (instancetype)initWithDigest:(NSData *)digest
+                          root:(NSDictionary *)root
+                      fileType:(iTermDynamicProfileFileType)fileType
+                         error:(NSString *)error {
+    self = [super init];
+    if (self) {
+        _digest = digest;
+        _root = root;
+        _fileType = fileType;
+        _error = [error copy];
+    }
+    return self;
+}
+
+// Safe to call on any thread. Returns |previous| if it was parsed from the same contents.
++ (instancetype)fileWithContentsOfPath:(NSString *)filename previous:(iTermDynamicProfileFile *)previous {
+    NSError *error = nil;
+    NSData *data = [NSData dataWithContentsOfFile:filename options:0 error:&error];
+    if (!data) {
+        return [[self alloc] initWithDigest:nil
+                                       root:nil
+                                   fileType:kDynamicProfileFileTypeJSON
+                                      error:[NSString stringWithFormat:@"Could not read Dynamic Profile from file %@: %@",
+                                             filename, error.localizedDescription]];
+    }
+    NSData *digest = [data it_sha256];
+    if (previous.root && [previous.digest isEqual:digest]) {
+        return previous;
+    }
+    // First, try xml and binary.
+    NSDictionary *dict = [NSDictionary castFrom:[NSPropertyListSerialization propertyListWithData:data
+                                                                                          options:NSPropertyListImmutable
+                                                                                           format:nil
+                                                                                            error:nil]];
+    if (dict) {
+        return [[self alloc] initWithDigest:digest root:dict fileType:kDynamicProfileFileTypePropertyList error:nil];
+    }
+    // Try JSON
+    id json = [NSJSONSerialization JSONObjectWithData:data
+                                              options:0
+                                                error:&error];
+    if (!json) {
+        return [[self alloc] initWithDigest:digest
+                                       root:nil
+                                   fileType:kDynamicProfileFileTypeJSON
+                                      error:[NSString stringWithFormat:@"Dynamic Profiles file %@ contains invalid JSON: %@", filename, error.localizedDescription]];
+    }
+    dict = [NSDictionary castFrom:json];
+    if (!dict) {
+        return [[self alloc] initWithDigest:digest
+                                       root:nil
+                                   fileType:kDynamicProfileFileTypeJSON
+                                      error:[NSString stringWithFormat:@"Dynamic Profiles file %@ does not have an Object (i.e., a dictionary) as its root element", filename]];
+    }
+    return [[self alloc] initWithDigest:digest root:dict fileType:kDynamicProfileFileTypeJSON error:nil];
+}
+
+@end
+
 @implementation iTermDynamicProfileManager {
     SCEvents *_events;
     NSMutableDictionary<NSString *, NSString *> *_guidToPathMap;
     NSInteger _pendingErrors;
     iTermFilesAndFolders *_paths;
     NSArray *_tokens;
+
+    // Files read by the last reload, by full path. Only used for incremental reloading.
+    NSDictionary<NSString *, iTermDynamicProfileFile *> *_files;
+    // Reads and parses files for incremental reloads.
+    dispatch_queue_t _queue;
+    // Incremented by each reload so that a background read finishing after a newer reload has
+    // started is discarded.
+    NSInteger _reloadGeneration;
 }
 
 + (instancetype)sharedInstance {
@@ -79,6 +159,7 @@
   self = [super init];
   if (self) {
       _guidToPathMap = [[NSMutableDictionary alloc] init];
+      _queue = dispatch_queue_create("com.iterm2.dynamic-profiles", DISPATCH_QUEUE_SERIAL);
       NSString *path = [self dynamicProfilesPath];
       if (path == nil) {
           ELog(@"Dynamic profiles path is nil");
@@ -239,7 +320,11 @@
 // Call this when a file or folder changes.
 - (void)somethingChanged {
     DLog(@"Path watcher noticed a change");
-    [self reloadDynamicProfiles];
+    if ([iTermAdvancedSettingsModel incrementalDynamicProfileReload]) {
+        [self reloadDynamicProfilesInBackground];
+    } else {
+        [self reloadDynamicProfiles];
+    }
 
     iTermFilesAndFolders *updatedPaths = self.pathsToWatch;
     if (![updatedPaths isEqual:_paths]) {
@@ -251,28 +336,55 @@
 }
 
 - (void)reloadDynamicProfiles {
+    _reloadGeneration += 1;
+    NSString *path = [self dynamicProfilesPath];
+    NSArray<NSString *> *fileNames = [iTermDynamicProfileManager fileNamesInPath:path];
+    NSDictionary *cache = [iTermAdvancedSettingsModel incrementalDynamicProfileReload] ? _files : nil;
+    [self reloadDynamicProfilesFromFiles:[iTermDynamicProfileManager filesWithNames:fileNames cache:cache]
+                               fileNames:fileNames];
+}
+
+// Reads and parses changed files on _queue and then updates the model on the main thread.
+- (void)reloadDynamicProfilesInBackground {
+    const NSInteger generation = ++_reloadGeneration;
+    NSString *path = [self dynamicProfilesPath];
+    NSDictionary<NSString *, iTermDynamicProfileFile *> *cache = _files;
+    __weak __typeof(self) weakSelf = self;
+    dispatch_async(_queue, ^{
+        NSArray<NSString *> *fileNames = [iTermDynamicProfileManager fileNamesInPath:path];
+        NSDictionary<NSString *, iTermDynamicProfileFile *> *files = [iTermDynamicProfileManager filesWithNames:fileNames
+                                                                                                          cache:cache];
+        dispatch_async(dispatch_get_main_queue(), ^{
+            __strong __typeof(self) strongSelf = weakSelf;
+            if (!strongSelf || strongSelf->_reloadGeneration != generation) {
+                DLog(@"Discard background read of dynamic profiles because a newer reload started");
+                return;
+            }
+            [strongSelf reloadDynamicProfilesFromFiles:files fileNames:fileNames];
+        });
+    });
+}
+
+- (void)reloadDynamicProfilesFromFiles:(NSDictionary<NSString *, iTermDynamicProfileFile *> *)files
+                             fileNames:(NSArray<NSString *> *)fileNames {
     [[ProfileModel sharedInstance] performBlockWithCoalescedNotifications:^{
         [ITAddressBookMgr performBlockWithCoalescedNotifications:^{
-            [self reallyReloadDynamicProfiles];
+            [self reallyReloadDynamicProfilesFromFiles:files fileNames:fileNames];
         }];
     }];
 }
 
-- (void)reallyReloadDynamicProfiles {
-    NSString *path = [self dynamicProfilesPath];
+// Returns the full paths of files in the DynamicProfiles folder, sorted. Safe on any thread.
++ (NSArray<NSString *> *)fileNamesInPath:(NSString *)path {
     DLog(@"Reloading dynamic profiles from %@", path);
     NSFileManager *fileManager = [NSFileManager defaultManager];
-
-    // Load the current dynamic profiles into |newProfiles|. The |guids| set
-    // is used to ensure that guids are unique across all files.
-    NSMutableArray *newProfiles = [NSMutableArray array];
-    NSMutableSet *guids = [NSMutableSet set];
     NSMutableArray *fileNames = [NSMutableArray array];
     for (NSString *file in [fileManager enumeratorAtPath:path]) {
         [fileNames addObject:file];
     }
     [fileNames sortUsingSelector:@selector(compare:)];
 
+    NSMutableArray<NSString *> *result = [NSMutableArray array];
     for (NSString *file in fileNames) {
         DLog(@"Examine file %@", file);
         if ([file hasPrefix:@"."]) {
@@ -282,8 +394,38 @@
             DLog(@"Skipping it because of trailing tilde (GNU-style backup file)");
             continue;
         }
-        NSString *fullName = [path stringByAppendingPathComponent:file];
-        if (![self loadDynamicProfilesFromFile:fullName intoArray:newProfiles guids:guids]) {
+        [result addObject:[path stringByAppendingPathComponent:file]];
+    }
+    return result;
+}
+
+// Reads each file, reusing the entry in |cache| when its contents are unchanged. Safe on any
+// thread.
++ (NSDictionary<NSString *, iTermDynamicProfileFile *> *)filesWithNames:(NSArray<NSString *> *)fileNames
+                                                                  cache:(NSDictionary<NSString *, iTermDynamicProfileFile *> *)cache {
+    NSMutableDictionary<NSString *, iTermDynamicProfileFile *> *files = [NSMutableDictionary dictionary];
+    for (NSString *fullName in fileNames) {
+        iTermDynamicProfileFile *file = [iTermDynamicProfileFile fileWithContentsOfPath:fullName
+                                                                               previous:cache[fullName]];
+        if (file == cache[fullName]) {
+            DLog(@"%@ is unchanged", fullName);
+        }
+        files[fullName] = file;
+    }
+    return files;
+}
+
+- (void)reallyReloadDynamicProfilesFromFiles:(NSDictionary<NSString *, iTermDynamicProfileFile *> *)files
+                                   fileNames:(NSArray<NSString *> *)fileNames {
+    const BOOL incremental = [iTermAdvancedSettingsModel incrementalDynamicProfileReload];
+    _files = incremental ? files : nil;
+
+    // Load the current dynamic profiles into |newProfiles|. The |guids| set
+    // is used to ensure that guids are unique across all files.
+    NSMutableArray *newProfiles = [NSMutableArray array];
+    NSMutableSet *guids = [NSMutableSet set];
+    for (NSString *fullName in fileNames) {
+        if (![self loadDynamicProfilesFromFile:fullName contents:files[fullName] intoArray:newProfiles guids:guids]) {
             [self reportError:[NSString stringWithFormat:@"Ignoring dynamic profiles in “%@” because of an error.", fullName]
                          file:fullName];
         }
@@ -291,15 +433,22 @@
 
     DLog(@"Begin add/update phase");
     // Update changes to existing dynamic profiles and add ones whose guids are
-    // not known.
+    // not known. When reloading incrementally, only a real change causes the reload notification.
     NSArray *oldProfiles = [self dynamicProfiles];
-    BOOL shouldReload = newProfiles.count > 0;
+    NSMutableDictionary<NSString *, Profile *> *oldProfilesByGuid = [NSMutableDictionary dictionary];
+    for (Profile *profile in oldProfiles.reverseObjectEnumerator) {
+        oldProfilesByGuid[profile[KEY_GUID]] = profile;
+    }
+    BOOL shouldReload = incremental ? NO : newProfiles.count > 0;
     for (Profile *profile in newProfiles) {
-        Profile *existingProfile = [self profileWithGuid:profile[KEY_GUID] inArray:oldProfiles];
+        Profile *existingProfile = oldProfilesByGuid[profile[KEY_GUID]];
         if (existingProfile) {
-            [self updateDynamicProfile:profile];
+            if ([self updateDynamicProfile:profile existingProfile:incremental ? existingProfile : nil]) {
+                shouldReload = YES;
+            }
         } else {
             [self addDynamicProfile:profile];
+            shouldReload = YES;
         }
     }
 
@@ -307,7 +456,7 @@
     // Remove dynamic profiles whose guids no longer exist.
     for (Profile *profile in oldProfiles) {
         DLog(@"Check profile name=%@ guid=%@", profile[KEY_NAME], profile[KEY_GUID]);
-        if (![self profileWithGuid:profile[KEY_GUID] inArray:newProfiles]) {
+        if (![guids containsObject:profile[KEY_GUID]]) {
             if ([self removeDynamicProfile:profile]) {
                 shouldReload = YES;
             }
@@ -324,40 +473,22 @@
 }
 
 - (NSArray<Profile *> *)profilesInFile:(NSString *)filename fileType:(iTermDynamicProfileFileType *)fileType {
+    return [self profilesInFile:filename
+                       contents:[iTermDynamicProfileFile fileWithContentsOfPath:filename previous:nil]
+                       fileType:fileType];
+}
+
+- (NSArray<Profile *> *)profilesInFile:(NSString *)filename
+                              contents:(iTermDynamicProfileFile *)file
+                              fileType:(iTermDynamicProfileFileType *)fileType {
     DLog(@"Loading dynamic profiles from file %@", filename);
-    // First, try xml and binary.
-    NSDictionary *dict = [NSDictionary dictionaryWithContentsOfFile:filename];
-    if (dict) {
-        if (fileType) {
-            *fileType = kDynamicProfileFileTypePropertyList;
-        }
-    } else {
-        // Try JSON
-        NSError *error = nil;
-        NSData *data = [NSData dataWithContentsOfFile:filename options:0 error:&error];
-        if (!data) {
-            [self reportError:[NSString stringWithFormat:@"Could not read Dynamic Profile from file %@: %@",
-                               filename, error.localizedDescription]
-                         file:filename];
-            return nil;
-        }
-        dict = [NSJSONSerialization JSONObjectWithData:data
-                                               options:0
-                                                 error:&error];
-        if (!dict) {
-            [self reportError:[NSString stringWithFormat:@"Dynamic Profiles file %@ contains invalid JSON: %@", filename, error.localizedDescription]
-                         file:filename];
-            return nil;
-        }
-        dict = [NSDictionary castFrom:dict];
-        if (!dict) {
-            [self reportError:[NSString stringWithFormat:@"Dynamic Profiles file %@ does not have an Object (i.e., a dictionary) as its root element", filename]
-                         file:filename];
-            return nil;
-        }
-        if (fileType) {
-            *fileType = kDynamicProfileFileTypeJSON;
-        }
+    NSDictionary *dict = file.root;
+    if (!dict) {
+        [self reportError:file.error file:filename];
+        return nil;
+    }
+    if (fileType) {
+        *fileType = file.fileType;
     }
     NSArray *entries = dict[@"Profiles"];
     if (!entries) {
@@ -398,7 +529,17 @@
 - (BOOL)loadDynamicProfilesFromFile:(NSString *)filename
                           intoArray:(NSMutableArray *)profiles
                               guids:(NSMutableSet *)guids {
-    NSArray<Profile *> *allProfiles = [self profilesInFile:filename fileType:nil];
+    return [self loadDynamicProfilesFromFile:filename
+                                    contents:[iTermDynamicProfileFile fileWithContentsOfPath:filename previous:nil]
+                                   intoArray:profiles
+                                       guids:guids];
+}
+
+- (BOOL)loadDynamicProfilesFromFile:(NSString *)filename
+                           contents:(iTermDynamicProfileFile *)file
+                          intoArray:(NSMutableArray *)profiles
+                              guids:(NSMutableSet *)guids {
+    NSArray<Profile *> *allProfiles = [self profilesInFile:filename contents:file fileType:nil];
     if (!allProfiles) {
         return NO;
     }
@@ -441,25 +582,21 @@
     return array;
 }
 
-// Returns the first profile in |profiles| whose guid is |guid|.
-- (Profile *)profileWithGuid:(NSString *)guid inArray:(NSArray *)profiles {
-    for (Profile *aProfile in profiles) {
-        if ([guid isEqualToString:aProfile[KEY_GUID]]) {
-            return aProfile;
-        }
-    }
-    return nil;
-}
-
-// Reload a dynamic profile, re-merging it with its parent.
-- (void)updateDynamicProfile:(Profile *)newProfile {
+// Reload a dynamic profile, re-merging it with its parent. If |existingProfile| is given and
+// equals the result, the model is left alone. Returns whether the model was updated.
+- (BOOL)updateDynamicProfile:(Profile *)newProfile existingProfile:(Profile *)existingProfile {
     DLog(@"Updating dynamic profile name=%@ guid=%@", newProfile[KEY_NAME], newProfile[KEY_GUID]);
     Profile *prototype = [self prototypeForDynamicProfile:newProfile];
     NSMutableDictionary *merged = [self profileByMergingProfile:newProfile
                                                     intoProfile:prototype];
     [merged profileAddDynamicTagIfNeeded];
+    if ([existingProfile isEqual:merged]) {
+        DLog(@"Dynamic profile guid=%@ is unchanged", newProfile[KEY_GUID]);
+        return NO;
+    }
     [[ProfileModel sharedInstance] setBookmark:merged
                                       withGuid:merged[KEY_GUID]];
+    return YES;
 }
 
 // Copies fields from |profile| over those in |prototype| and returns a new
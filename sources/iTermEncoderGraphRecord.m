@@ -14,7 +14,10 @@
 #import "NSDictionary+iTerm.h"
 #import "NSObject+iTerm.h"
 
-@implementation iTermEncoderGraphRecord
+@implementation iTermEncoderGraphRecord {
+    // Archiving the pod is the bulk of the cost of comparing revisions, so do it at most once.
+    NSData *_data;
+}
 
 + (instancetype)withPODs:(NSDictionary<NSString *, id> *)pod
                   graphs:(NSArray<iTermEncoderGraphRecord *> *)graphRecords
@@ -315,12 +318,19 @@
     if (self.pod.count == 0) {
         return [NSData data];
     }
-    NSError *error = nil;
-    NSData *data = [NSData it_dataWithSecurelyArchivedObject:self.pod error:&error];
-    if (error) {
-        DLog(@"Failed to serialize pod %@ in %@: %@", self.pod, self, error);
+    @synchronized (self) {
+        if (_data) {
+            return _data;
+        }
+        NSError *error = nil;
+        NSData *data = [NSData it_dataWithSecurelyArchivedObject:self.pod error:&error];
+        if (error) {
+            DLog(@"Failed to serialize pod %@ in %@: %@", self.pod, self, error);
+            return data;
+        }
+        _data = data;
+        return data;
     }
-    return data;
 }
 
 - (void)eraseRowIDs {
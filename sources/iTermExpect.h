@@ -33,6 +33,12 @@ NS_ASSUME_NONNULL_BEGIN
 - (void)cancelExpectation:(iTermExpectation *)expectation;
 - (void)setTimeout:(NSTimeInterval)timeout forExpectation:(iTermExpectation *)expectation;
 
+// The current expectations that could match |string|, in the order they were added. When
+// prefiltering is enabled, they are found with a single pass over the string by a matcher built
+// from all the expectations' regexes, which is rebuilt after expectations are added or removed.
+// Otherwise this is just a copy of |expectations|.
+- (NSArray<iTermExpectation *> *)expectationsThatMayMatchString:(NSString *)string;
+
 @end
 
 NS_ASSUME_NONNULL_END
@@ -7,6 +7,9 @@
 
 #import "iTermExpect.h"
 
+#import "iTermAdvancedSettingsModel.h"
+#import "iTermTriggerMatcher.h"
+
 @interface iTermExpectation()
 @property (nonatomic, readonly) void (^willExpect)(iTermExpectation *expectation);
 @property (nullable, nonatomic, strong, readwrite) iTermExpectation *successor;
@@ -75,12 +78,18 @@
 
 @implementation iTermExpect {
     NSMutableArray<iTermExpectation *> *_expectations;
+    BOOL _prefilter;
+    // Built lazily from _matcherExpectations, a snapshot of _expectations. Both are reset whenever
+    // _expectations changes.
+    iTermTriggerMatcher *_matcher;
+    NSArray<iTermExpectation *> *_matcherExpectations;
 }
 
 - (instancetype)init {
     self = [super init];
     if (self) {
         _expectations = [NSMutableArray array];
+        _prefilter = [iTermAdvancedSettingsModel prefilterExpectations];
     }
     return self;
 }
@@ -124,15 +133,38 @@
 
 - (void)addExpectation:(iTermExpectation *)expectation {
     [_expectations addObject:expectation];
+    [self invalidateMatcher];
 }
 
 - (void)removeExpectation:(iTermExpectation *)expectation {
     [_expectations removeObject:expectation];
+    [self invalidateMatcher];
 }
 
 - (void)cancelExpectation:(iTermExpectation *)expectation {
     [expectation cancel];
     [_expectations removeObject:expectation];
+    [self invalidateMatcher];
+}
+
+- (void)invalidateMatcher {
+    _matcher = nil;
+    _matcherExpectations = nil;
+}
+
+- (NSArray<iTermExpectation *> *)expectationsThatMayMatchString:(NSString *)string {
+    if (!_prefilter || _expectations.count == 0) {
+        return [_expectations copy];
+    }
+    if (!_matcher) {
+        _matcherExpectations = [_expectations copy];
+        NSMutableArray<NSString *> *regexes = [NSMutableArray array];
+        for (iTermExpectation *expectation in _matcherExpectations) {
+            [regexes addObject:expectation.regex];
+        }
+        _matcher = [[iTermTriggerMatcher alloc] initWithRegexes:regexes];
+    }
+    return [_matcherExpectations objectsAtIndexes:[_matcher indexesOfRegexesThatMayMatchString:string]];
 }
 
 - (void)setTimeout:(NSTimeInterval)timeout forExpectation:(iTermExpectation *)expectation {
@@ -230,6 +230,13 @@
                                          errorReason:(NSString *)errorReason
                                                 path:(NSString *)path
                                             optional:(BOOL)optional {
+    return [self.class parsedExpressionWithValue:value errorReason:errorReason path:path optional:optional];
+}
+
++ (iTermParsedExpression *)parsedExpressionWithValue:(id)value
+                                         errorReason:(NSString *)errorReason
+                                                path:(NSString *)path
+                                            optional:(BOOL)optional {
     if (errorReason) {
         return [[iTermParsedExpression alloc] initWithErrorCode:3 reason:errorReason];
     }
@@ -291,9 +298,15 @@
         }
         allLiterals = NO;
 
-        iTermExpressionParser *parser = [[iTermExpressionParser alloc] initWithStart:@"expression"];
-        iTermParsedExpression *expression = [parser parse:substring
-                                                    scope:scope];
+        iTermParsedExpression *template = nil;
+        iTermParsedExpression *expression = nil;
+        if ([iTermAdvancedSettingsModel cacheParsedExpressions] && !scope.usePlaceholders) {
+            template = [self templateForExpression:substring];
+            expression = [self expressionByResolvingTemplate:template scope:scope];
+        } else {
+            iTermExpressionParser *parser = [[iTermExpressionParser alloc] initWithStart:@"expression"];
+            expression = [parser parse:substring scope:scope];
+        }
         if (expression.expressionType == iTermParsedExpressionTypeString && escapingFunction) {
             NSString *escapedString = escapingFunction(expression.string);
             [interpolatedParts addObject:[[iTermParsedExpression alloc] initWithString:escapedString]];
@@ -305,8 +318,12 @@
             // If the expression was a variable reference, replace it with empty string. This works
             // around the annoyance of remembering to add question marks in interpolated strings,
             // where you know the result you want is always an empty string.
-            iTermParsedExpression *expressionWithPlaceholders = [parser parse:substring
-                                                                        scope:[[iTermVariablePlaceholderScope alloc] init]];
+            iTermParsedExpression *expressionWithPlaceholders = template;
+            if (!expressionWithPlaceholders) {
+                iTermExpressionParser *parser = [[iTermExpressionParser alloc] initWithStart:@"expression"];
+                expressionWithPlaceholders = [parser parse:substring
+                                                     scope:[[iTermVariablePlaceholderScope alloc] init]];
+            }
             if ([expressionWithPlaceholders.object conformsToProtocol:@protocol(iTermExpressionParserPlaceholder)]) {
                 expression = [[iTermParsedExpression alloc] initWithString:@""];
             }
@@ -331,10 +348,16 @@
 
 - (iTermTriple<id, NSString *, NSString *> *)pathOrDereferencedArrayFromPath:(NSString *)path
                                                                        index:(NSNumber *)indexNumber {
+    return [self.class pathOrDereferencedArrayFromPath:path index:indexNumber scope:_scope];
+}
+
++ (iTermTriple<id, NSString *, NSString *> *)pathOrDereferencedArrayFromPath:(NSString *)path
+                                                                       index:(NSNumber *)indexNumber
+                                                                       scope:(iTermVariableScope *)scope {
     if ([path isEqualToString:@"null"] && !indexNumber) {
         return [iTermTriple tripleWithObject:nil andObject:nil object:path];
     }
-    if (_scope.usePlaceholders) {
+    if (scope.usePlaceholders) {
         id placeholder;
         if (indexNumber) {
             placeholder = [[iTermExpressionParserArrayDereferencePlaceholder alloc] initWithPath:path index:indexNumber.integerValue];
@@ -345,7 +368,7 @@
                                    andObject:nil
                                       object:path];
     }
-    id untypedValue = [_scope valueForVariableName:path];
+    id untypedValue = [scope valueForVariableName:path];
     if (!untypedValue) {
         return [iTermTriple tripleWithObject:nil andObject:nil object:path];
     }
@@ -369,6 +392,100 @@
     return [iTermTriple tripleWithObject:array[index] andObject:nil object:path];
 }
 
+#pragma mark - Templates
+
+// A template is an expression parsed with placeholders for variables. Parsing is much more
+// expensive than evaluation, and interpolated strings like titles and badges are reevaluated with
+// the same source over and over, so templates are cached by source and their variables resolved
+// against the real scope before each evaluation.
++ (iTermParsedExpression *)templateForExpression:(NSString *)source {
+    static NSCache<NSString *, iTermParsedExpression *> *cache;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        cache = [[NSCache alloc] init];
+        cache.countLimit = 1000;
+    });
+    iTermParsedExpression *template = [cache objectForKey:source];
+    if (template) {
+        return template;
+    }
+    iTermExpressionParser *parser = [[iTermExpressionParser alloc] initWithStart:@"expression"];
+    template = [parser parse:source scope:[[iTermVariablePlaceholderScope alloc] init]];
+    [cache setObject:template forKey:source];
+    return template;
+}
+
+// Produces the same expression that parsing the template's source with |scope| would have.
++ (iTermParsedExpression *)expressionByResolvingTemplate:(iTermParsedExpression *)template
+                                                   scope:(iTermVariableScope *)scope {
+    switch (template.expressionType) {
+        case iTermParsedExpressionTypeNil:
+        case iTermParsedExpressionTypeArrayOfValues:
+        case iTermParsedExpressionTypeString:
+        case iTermParsedExpressionTypeNumber:
+        case iTermParsedExpressionTypeError:
+            return template;
+
+        case iTermParsedExpressionTypeVariableReference:
+        case iTermParsedExpressionTypeArrayLookup: {
+            id<iTermExpressionParserPlaceholder> placeholder = template.placeholder;
+            NSNumber *index = nil;
+            if (template.expressionType == iTermParsedExpressionTypeArrayLookup) {
+                index = @([(iTermExpressionParserArrayDereferencePlaceholder *)placeholder index]);
+            }
+            iTermTriple *triple = [self pathOrDereferencedArrayFromPath:placeholder.path
+                                                                  index:index
+                                                                  scope:scope];
+            return [self parsedExpressionWithValue:triple.firstObject
+                                       errorReason:triple.secondObject
+                                              path:triple.thirdObject
+                                          optional:template.optional];
+        }
+
+        case iTermParsedExpressionTypeArrayOfExpressions:
+            return [[iTermParsedExpression alloc] initWithArrayOfExpressions:[template.arrayOfExpressions mapWithBlock:^id(iTermParsedExpression *element) {
+                return [self expressionByResolvingTemplate:element scope:scope];
+            }]];
+
+        case iTermParsedExpressionTypeFunctionCall: {
+            // Function calls keep state while they're evaluated so each evaluation needs its own.
+            iTermScriptFunctionCall *templateCall = template.functionCall;
+            iTermScriptFunctionCall *call = [[iTermScriptFunctionCall alloc] init];
+            call.name = templateCall.name;
+            call.namespace = templateCall.namespace;
+            NSDictionary<NSString *, iTermParsedExpression *> *arguments = templateCall.argumentExpressions;
+            for (NSString *name in arguments) {
+                iTermParsedExpression *argument = [self expressionByResolvingTemplate:arguments[name] scope:scope];
+                if (argument.expressionType == iTermParsedExpressionTypeError) {
+                    return argument;
+                }
+                [call addParameterWithName:name parsedExpression:argument];
+            }
+            return [[iTermParsedExpression alloc] initWithFunctionCall:call];
+        }
+
+        case iTermParsedExpressionTypeInterpolatedString: {
+            // This is a nested string literal, which is never strict.
+            NSMutableArray<iTermParsedExpression *> *parts = [NSMutableArray array];
+            for (iTermParsedExpression *partTemplate in template.interpolatedStringParts) {
+                iTermParsedExpression *part = [self expressionByResolvingTemplate:partTemplate scope:scope];
+                if (part.expressionType == iTermParsedExpressionTypeError) {
+                    if ([iTermAdvancedSettingsModel laxNilPolicyInInterpolatedStrings] &&
+                        [partTemplate.object conformsToProtocol:@protocol(iTermExpressionParserPlaceholder)]) {
+                        part = [[iTermParsedExpression alloc] initWithString:@""];
+                    } else {
+                        return part;
+                    }
+                }
+                [parts addObject:part];
+            }
+            return [self parsedExpressionWithInterpolatedStringParts:parts];
+        }
+    }
+    assert(NO);
+    return template;
+}
+
 - (void)loadRulesAndTransforms {
     __weak __typeof(self) weakSelf = self;
     [_grammarProcessor addProductionRule:@"call ::= <path> <arglist>"
@@ -243,7 +243,9 @@ iTermUnixDomainSocketConnectResult iTermCreateConnectedUnixDomainSocket(NSString
 
     NSArray<NSString *> *argv = @[ executable, path ];
     char **cargv = Make2DArray(argv);
-    const char **cenv = (const char **)Make2DArray(@[]);
+    // The server starts with an empty environment, so this is the only way to pass it options.
+    NSArray<NSString *> *env = [iTermAdvancedSettingsModel launchJobsWithPosixSpawn] ? @[ @"ITERM2_SERVER_USE_POSIX_SPAWN=1" ] : @[];
+    const char **cenv = (const char **)Make2DArray(env);
     const char *argpath = executable.UTF8String;
 
     int fds[] = {
@@ -267,7 +269,7 @@ iTermUnixDomainSocketConnectResult iTermCreateConnectedUnixDomainSocket(NSString
             Free2DArray(cargv, argv.count);
             close(pipeFds[0]);
             *writeFDOut = pipeFds[1];
-            Free2DArray((char **)cenv, 0);
+            Free2DArray((char **)cenv, env.count);
             return forkState;
 
         case 0: {
@@ -293,7 +295,7 @@ iTermUnixDomainSocketConnectResult iTermCreateConnectedUnixDomainSocket(NSString
             Free2DArray(cargv, argv.count);
             close(pipeFds[0]);
             *writeFDOut = pipeFds[1];
-            Free2DArray((char **)cenv, 0);
+            Free2DArray((char **)cenv, env.count);
             return forkState;
     }
 }
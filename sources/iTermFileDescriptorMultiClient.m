@@ -9,6 +9,7 @@
 #import "iTermFileDescriptorMultiClient+MRR.h"
 
 #import "DebugLogging.h"
+#import "iTermAdvancedSettingsModel.h"
 #import "iTermClientServerProtocolMessageBox.h"
 #import "iTermFileDescriptorMultiClientState.h"
 #import "iTermFileDescriptorServer.h"
@@ -363,6 +364,10 @@ NSString *const iTermFileDescriptorMultiClientErrorDomain = @"iTermFileDescripto
 // read-dispatch loop begins so it is safe to do a bunch of async read calls.
 // It will call itself recursively until numberOfChildren is 0. Then the
 // completion block will be called.
+// The server writes all the reports right after the handshake response, so
+// they are usually already buffered. Reading eagerly avoids waiting for a
+// readability event twice per child, which adds up when restoring many
+// sessions.
 - (void)readInitialChildReports:(int)numberOfChildren
                           state:(iTermFileDescriptorMultiClientState *)state
                           block:(void (^)(iTermFileDescriptorMultiClientState *state, iTermMultiServerReportChild *))block
@@ -376,6 +381,7 @@ NSString *const iTermFileDescriptorMultiClientErrorDomain = @"iTermFileDescripto
     __weak __typeof(self) weakSelf = self;
     NSString *socketPath = _socketPath;
     [self readMessageWithState:state
+                         eager:[iTermAdvancedSettingsModel eagerlyReadMultiServerChildReports]
                       callback:[_thread newCallbackWithBlock:^(iTermFileDescriptorMultiClientState *state,
                                                                iTermResult<iTermClientServerProtocolMessageBox *> *result) {
         [result handleObject:^(iTermClientServerProtocolMessageBox * _Nonnull box) {
@@ -1031,12 +1037,21 @@ static unsigned long long MakeUniqueID(void) {
 // after than handshake is complete. Otherwise, reads could get intermingled.
 - (void)readMessageWithState:(iTermFileDescriptorMultiClientState *)state
                     callback:(iTermCallback<id, iTermResult<iTermClientServerProtocolMessageBox *> *> *)callback {
+    [self readMessageWithState:state eager:NO callback:callback];
+}
+
+// If `eager` is set, try to read before the socket is known to be readable. This is only safe
+// when nothing else could be reading, as during the handshake.
+- (void)readMessageWithState:(iTermFileDescriptorMultiClientState *)state
+                       eager:(BOOL)eager
+                    callback:(iTermCallback<id, iTermResult<iTermClientServerProtocolMessageBox *> *> *)callback {
     // First, read the length of the forthcoming message.
     __weak __typeof(self) weakSelf = self;
     NSString *socketPath = [_socketPath copy];
     DLog(@"Read length of next message from %@", socketPath);
     [self readWithState:state
                  length:sizeof(size_t)
+                  eager:eager
                callback:[_thread newCallbackWithBlock:^(iTermFileDescriptorMultiClientState *_Nonnull state,
                                                         iTermResult<iTermMultiServerMessage *> *_Nullable result) {
         [result handleObject:^(iTermMultiServerMessage * _Nonnull lengthMessage) {
@@ -1063,6 +1078,7 @@ static unsigned long long MakeUniqueID(void) {
             // Now read the payload including a possible file descriptor.
             [weakSelf readWithState:state
                              length:length
+                              eager:eager
                            callback:[strongSelf->_thread newCallbackWithBlock:^(iTermFileDescriptorMultiClientState *_Nonnull state,
                                                                                 iTermResult<iTermMultiServerMessage *> *_Nullable result) {
                 [result handleObject:^(iTermMultiServerMessage * _Nonnull payload) {
@@ -1100,8 +1116,14 @@ static unsigned long long MakeUniqueID(void) {
 // the callback with the result.
 - (void)readWithState:(iTermFileDescriptorMultiClientState *)state
                length:(NSInteger)length
+                eager:(BOOL)eager
              callback:(iTermCallback<id, iTermResult<iTermMultiServerMessage *> *> *)callback {
     iTermMultiServerMessageBuilder *builder = [[iTermMultiServerMessageBuilder alloc] init];
+    if (eager) {
+        // This waits for the socket to become readable if nothing is buffered yet.
+        [self partialReadWithState:state totalLength:length builder:builder callback:callback];
+        return;
+    }
     [state whenReadable:^(iTermFileDescriptorMultiClientState *state) {
         [self partialReadWithState:state totalLength:length builder:builder callback:callback];
     }];
@@ -1123,6 +1145,10 @@ static unsigned long long MakeUniqueID(void) {
         return;
     }
 
+    if ([iTermAdvancedSettingsModel receiveMultiServerMessagesInPlace]) {
+        [self receiveWithState:state totalLength:totalLength builder:builder callback:callback];
+        return;
+    }
     iTermClientServerProtocolMessage message;
     ssize_t bytesRead = iTermMultiServerReadMessage(state.readFD, &message, totalLength - builder.length);
     if (bytesRead < 0) {
@@ -1150,6 +1176,7 @@ static unsigned long long MakeUniqueID(void) {
 
     if (bytesRead == 0) {
         DLog(@"EOF %@", _socketPath);
+        iTermClientServerProtocolMessageFree(&message);
         [callback invokeWithObject:[iTermResult withError:self.connectionLostError]];
         [self closeWithState:state];
         return;
@@ -1160,6 +1187,54 @@ static unsigned long long MakeUniqueID(void) {
         [builder appendBytes:message.message.msg_iov[0].iov_base
                       length:bytesRead];
     }
+    iTermClientServerProtocolMessageFree(&message);
+
+    assert(builder.length <= totalLength);
+    if (builder.length == totalLength) {
+        DLog(@"Read complete from %@", _socketPath);
+        [callback invokeWithObject:[iTermResult withObject:builder.message]];
+        return;
+    }
+    __weak __typeof(self) weakSelf = self;
+    DLog(@"Have read %@/%@ from %@. Wait for socket to be readable again.", @(builder.length), @(totalLength), _socketPath);
+    [state whenReadable:^(iTermFileDescriptorMultiClientState *state) {
+        [weakSelf partialReadWithState:state
+                           totalLength:totalLength
+                               builder:builder
+                              callback:callback];
+    }];
+}
+
+// Same as partialReadWithState:totalLength:builder:callback: but receives directly into the
+// builder rather than into a temporary message that then gets copied.
+- (void)receiveWithState:(iTermFileDescriptorMultiClientState *)state
+             totalLength:(NSInteger)totalLength
+                 builder:(iTermMultiServerMessageBuilder *)builder
+                callback:(iTermCallback<id, iTermResult<iTermMultiServerMessage *> *> *)callback {
+    const ssize_t bytesRead = [builder receiveFromFileDescriptor:state.readFD
+                                                          length:totalLength - builder.length];
+    if (bytesRead < 0) {
+        if (errno == EAGAIN) {
+            DLog(@"Nothing to read %@. Will wait for the socket to become readable and try again later.", _socketPath);
+            __weak __typeof(self) weakSelf = self;
+            [state whenReadable:^(iTermFileDescriptorMultiClientState *state) {
+                [weakSelf partialReadWithState:state
+                                   totalLength:totalLength
+                                       builder:builder
+                                      callback:callback];
+            }];
+            return;
+        }
+        DLog(@"read failed with %s for %@", strerror(errno), _socketPath);
+        [callback invokeWithObject:[iTermResult withError:self.ioError]];
+        return;
+    }
+    if (bytesRead == 0) {
+        DLog(@"EOF %@", _socketPath);
+        [callback invokeWithObject:[iTermResult withError:self.connectionLostError]];
+        [self closeWithState:state];
+        return;
+    }
 
     assert(builder.length <= totalLength);
     if (builder.length == totalLength) {
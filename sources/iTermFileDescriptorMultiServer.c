@@ -26,6 +26,9 @@
 
 const char *gMultiServerSocketPath;
 
+// Launch children with posix_spawn instead of forkpty. Set by the client through the environment.
+static int gUsePosixSpawn;
+
 // On entry there should be three file descriptors:
 // 0: A socket we can accept() on. listen() was already called on it.
 // 1: A connection we can sendmsg() on. accept() was already called on it.
@@ -188,6 +191,22 @@ static int Launch(const iTermMultiServerRequestLaunch *launch,
                       launch->isUTF8);
     int fd;
     forkState->numFileDescriptorsToPreserve = 3;
+    if (gUsePosixSpawn) {
+        FDLog(LOG_DEBUG, "Spawning...");
+        forkState->pid = iTermPosixTTYReplacementSpawnPty(&fd,
+                                                          ttyStatePtr,
+                                                          launch->path,
+                                                          (const char **)launch->argv,
+                                                          launch->pwd,
+                                                          launch->envp);
+        if (forkState->pid > 0) {
+            FDLog(LOG_DEBUG, "posix_spawn succeeded. Child pid is %d", forkState->pid);
+            *errorPtr = 0;
+            return fd;
+        }
+        // Forking also takes care of showing why an executable couldn't be run.
+        FDLog(LOG_DEBUG, "posix_spawn failed: %s. Falling back to fork.", strerror(errno));
+    }
     FDLog(LOG_DEBUG, "Forking...");
     forkState->pid = forkpty(&fd, ttyStatePtr->tty, &ttyStatePtr->term, &ttyStatePtr->win);
     if (forkState->pid == (pid_t)0) {
@@ -1025,6 +1044,7 @@ static int iTermFileDescriptorMultiServerRun(char *path, int socketFd, int write
 int main(int argc, char *argv[]) {
     assert(argc == 2);
     gMultiServerSocketPath = argv[1];
+    gUsePosixSpawn = (getenv("ITERM2_SERVER_USE_POSIX_SPAWN") != NULL);
     iTermFileDescriptorMultiServerRun(argv[1],
                                       iTermMultiServerFileDescriptorAcceptSocket,
                                       iTermMultiServerFileDescriptorInitialWrite,
@@ -20,6 +20,7 @@
 #include <sys/stat.h>
 #include <sys/time.h>
 #include <sys/types.h>
+#include <sys/uio.h>
 #include <sys/un.h>
 #include <syslog.h>
 #include <unistd.h>
@@ -69,7 +70,7 @@ static ssize_t iTermFileDescriptorWriteImpl(int fd,
                                             int *errorOut) {
     const ssize_t rc = iTermFileDescriptorServerWrite(fd, buffer, bufferSize);
     if (rc == -1) {
-        if (*errorOut) {
+        if (errorOut) {
             *errorOut = errno;
         }
         FDLog(LOG_DEBUG, "iTermFileDescriptorServerWrite failed with %s", strerror(errno));
@@ -83,18 +84,55 @@ static ssize_t iTermFileDescriptorWriteImpl(int fd,
 }
 
 // Returns number of bytes sent, or -1 for error.
+// The length and payload go out in one writev when possible rather than as two writes.
 ssize_t iTermFileDescriptorServerWriteLengthAndBuffer(int fd,
                                                       void *buffer,
                                                       size_t bufferSize,
                                                       int *errorOut) {
     unsigned char temp[sizeof(bufferSize)];
     memmove(temp, &bufferSize, sizeof(bufferSize));
-    const ssize_t rc = iTermFileDescriptorWriteImpl(fd, temp, sizeof(temp), errorOut);
-    if (rc != sizeof(temp)) {
+    struct iovec vectors[2] = {
+        { .iov_base = temp, .iov_len = sizeof(temp) },
+        { .iov_base = buffer, .iov_len = bufferSize }
+    };
+    ssize_t rc;
+    do {
+        errno = 0;
+        rc = writev(fd, vectors, 2);
+    } while (rc == -1 && errno == EINTR);
+    if (rc == -1) {
+        if (errorOut) {
+            *errorOut = errno;
+        }
+        FDLog(LOG_DEBUG, "writev failed with %s", strerror(errno));
         return rc;
     }
-
-    return iTermFileDescriptorWriteImpl(fd, buffer, bufferSize, errorOut);
+    FDLog(LOG_DEBUG, "writev sent %d of %d bytes to client", (int)rc, (int)(sizeof(temp) + bufferSize));
+
+    // Finish a short write the slow way.
+    size_t offset = rc;
+    if (offset < sizeof(temp)) {
+        const ssize_t lengthRC = iTermFileDescriptorWriteImpl(fd, temp + offset, sizeof(temp) - offset, errorOut);
+        if (lengthRC != sizeof(temp) - offset) {
+            return lengthRC;
+        }
+        offset = sizeof(temp);
+    }
+    const size_t payloadOffset = offset - sizeof(temp);
+    if (payloadOffset == bufferSize) {
+        if (errorOut) {
+            *errorOut = 0;
+        }
+        return bufferSize;
+    }
+    const ssize_t payloadRC = iTermFileDescriptorWriteImpl(fd,
+                                                           buffer + payloadOffset,
+                                                           bufferSize - payloadOffset,
+                                                           errorOut);
+    if (payloadRC < 0) {
+        return payloadRC;
+    }
+    return payloadOffset + payloadRC;
 }
 
 // Returns -1 on error
@@ -9,6 +9,7 @@
 #import "iTermFindOnPageHelper.h"
 #import "DebugLogging.h"
 #import "FindContext.h"
+#import "iTermAdvancedSettingsModel.h"
 #import "iTermSelection.h"
 #import "SearchResult.h"
 
@@ -80,6 +81,10 @@ typedef struct {
     NSMutableIndexSet *_locations NS_AVAILABLE_MAC(10_14);
 
     BOOL _locationsHaveChanged NS_AVAILABLE_MAC(10_14);
+
+    // Highlights and search results on lines before this absolute line number have been discarded
+    // because they were lost to scrollback.
+    long long _firstUnprunedLine;
 }
 
 - (instancetype)init {
@@ -189,6 +194,7 @@ scrollToFirstResult:(BOOL)scrollToFirstResult {
     _numberOfProcessedSearchResults = 0;
     _haveRevealedSearchResult = NO;
     [_highlightMap removeAllObjects];
+    _firstUnprunedLine = 0;
     _searchingForNextResult = NO;
 
     [_delegate setNeedsDisplay:YES];
@@ -540,12 +546,53 @@ scrollToFirstResult:(BOOL)scrollToFirstResult {
 }
 
 - (void)overflowAdjustmentDidChange {
+    if ([iTermAdvancedSettingsModel incrementalFindOnPage]) {
+        [self removeSearchResultsBeforeLine:[self.delegate findOnPageOverflowAdjustment]];
+    }
     if (self.selectedResult == nil) {
         return;
     }
     [self updateCachedCountsIfNeeded];
 }
 
+// Discards results and highlights that ended before |absLine|. The cost is proportional to the
+// number of lines dropped since the last call, not to the number of results.
+- (void)removeSearchResultsBeforeLine:(long long)absLine {
+    if (absLine <= _firstUnprunedLine) {
+        return;
+    }
+    // Results are sorted descending so the ones lost to scrollback are at the end.
+    NSInteger count = _searchResults.count;
+    while (count > 0 && _searchResults[count - 1].absEndY < absLine) {
+        count--;
+    }
+    if (count < _searchResults.count) {
+        [_searchResults removeObjectsInRange:NSMakeRange(count, _searchResults.count - count)];
+        _cachedCounts.valid = NO;
+    }
+    _numberOfProcessedSearchResults = MIN(_numberOfProcessedSearchResults, (int)_searchResults.count);
+
+    if (absLine - _firstUnprunedLine > (long long)_highlightMap.count) {
+        NSMutableArray<NSNumber *> *keys = [NSMutableArray array];
+        for (NSNumber *key in _highlightMap) {
+            if (key.longLongValue < absLine) {
+                [keys addObject:key];
+            }
+        }
+        [_highlightMap removeObjectsForKeys:keys];
+    } else {
+        [self removeHighlightsInRange:NSMakeRange(_firstUnprunedLine, absLine - _firstUnprunedLine)];
+    }
+
+    if (@available(macOS 10.14, *)) {
+        if ([_locations countOfIndexesInRange:NSMakeRange(0, absLine)] > 0) {
+            [_locations removeIndexesInRange:NSMakeRange(0, absLine)];
+            [self locationsDidChange];
+        }
+    }
+    _firstUnprunedLine = absLine;
+}
+
 - (void)updateCachedCountsIfNeeded {
     const long long overflowAdjustment = [self.delegate findOnPageOverflowAdjustment];
     if (self.selectedResult.absEndY < overflowAdjustment) {
@@ -110,7 +110,7 @@
             [self insertSubview:_backing atIndex:0];
             __weak __typeof(self) weakSelf = self;
             [iTermPreferenceDidChangeNotification subscribe:self block:^(iTermPreferenceDidChangeNotification * _Nonnull notification) {
-                if ([notification.key isEqualToString:kPreferenceKeyTabStyle]) {
+                if ([notification didChangeKey:kPreferenceKeyTabStyle]) {
                     [weakSelf updateBackingVisible];
                 }
             }];
@@ -12,6 +12,7 @@
 #import "iTermAdvancedSettingsModel.h"
 #import "iTermCommandRunner.h"
 #import "iTermCommandRunnerPool.h"
+#import "iTermGitRepositoryMonitor.h"
 #import "iTermGitState+MainApp.h"
 #import "iTermSlowOperationGateway.h"
 #import "iTermTuple.h"
@@ -25,6 +26,8 @@ typedef void (^iTermGitPollWorkerCompletionBlock)(iTermGitState * _Nullable);
 @implementation iTermGitPollWorker {
     NSMutableDictionary<NSString *, iTermGitState *> *_cache;
     NSMutableDictionary<NSString *, NSMutableArray<iTermGitPollWorkerCompletionBlock> *> *_pending;
+    // Repository root -> waiters, when using iTermGitRepositoryMonitor.
+    NSMutableDictionary<NSString *, NSMutableArray<iTermGitPollWorkerCompletionBlock> *> *_pendingRepositories;
 }
 
 + (instancetype)sharedInstance {
@@ -41,6 +44,7 @@ typedef void (^iTermGitPollWorkerCompletionBlock)(iTermGitState * _Nullable);
     if (self) {
         _cache = [NSMutableDictionary dictionary];
         _pending = [NSMutableDictionary dictionary];
+        _pendingRepositories = [NSMutableDictionary dictionary];
     }
     return self;
 }
@@ -51,6 +55,57 @@ typedef void (^iTermGitPollWorkerCompletionBlock)(iTermGitState * _Nullable);
 
 - (void)requestPath:(NSString *)path completion:(void (^)(iTermGitState * _Nullable))completion {
     DLog(@"requestPath:%@", path);
+    if ([iTermGitRepositoryMonitor enabled]) {
+        [[iTermGitRepositoryMonitor sharedInstance] findRepositoryContainingPath:path completion:^(NSString * _Nullable root) {
+            if (!root) {
+                [self pollPath:path completion:completion];
+                return;
+            }
+            [self requestRepository:root completion:^(iTermGitState * _Nullable state) {
+                if (state) {
+                    self->_cache[path] = state;
+                }
+                completion(state);
+            }];
+        }];
+        return;
+    }
+    [self pollPath:path completion:completion];
+}
+
+// The state is reused until the monitor sees a change, and sessions anywhere in the same
+// repository share it.
+- (void)requestRepository:(NSString *)root completion:(void (^)(iTermGitState * _Nullable))completion {
+    iTermGitRepositoryMonitor *monitor = [iTermGitRepositoryMonitor sharedInstance];
+    iTermGitState *existing = [monitor stateForRepository:root];
+    if (existing) {
+        DLog(@"Use unchanged state for %@", root);
+        completion(existing);
+        return;
+    }
+    NSMutableArray<iTermGitPollWorkerCompletionBlock> *pending = _pendingRepositories[root];
+    if (pending) {
+        [pending addObject:[completion copy]];
+        return;
+    }
+    _pendingRepositories[root] = [@[ [completion copy] ] mutableCopy];
+    const NSInteger changeCount = [monitor changeCountForRepository:root];
+    DLog(@"Fetch state of repository %@", root);
+    [[iTermSlowOperationGateway sharedInstance] requestGitStateForPath:root completion:^(iTermGitState * _Nullable state) {
+        dispatch_async(dispatch_get_main_queue(), ^{
+            if (state) {
+                [monitor setState:state forRepository:root changeCount:changeCount];
+            }
+            NSArray<iTermGitPollWorkerCompletionBlock> *blocks = self->_pendingRepositories[root];
+            [self->_pendingRepositories removeObjectForKey:root];
+            for (iTermGitPollWorkerCompletionBlock block in blocks) {
+                block(state);
+            }
+        });
+    }];
+}
+
+- (void)pollPath:(NSString *)path completion:(void (^)(iTermGitState * _Nullable))completion {
     const NSTimeInterval ttl = 1;
 
     iTermGitState *existing = _cache[path];
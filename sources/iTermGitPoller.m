@@ -9,6 +9,7 @@
 
 #import "DebugLogging.h"
 #import "iTermGitPollWorker.h"
+#import "iTermGitRepositoryMonitor.h"
 #import "iTermGitState.h"
 #import "iTermRateLimitedUpdate.h"
 #import "NSTimer+iTerm.h"
@@ -30,6 +31,12 @@ NS_ASSUME_NONNULL_BEGIN
         _cadence = cadence;
         _update = [update copy];
         [self startTimer];
+        if ([iTermGitRepositoryMonitor enabled]) {
+            [[NSNotificationCenter defaultCenter] addObserver:self
+                                                     selector:@selector(repositoryDidChange:)
+                                                         name:iTermGitRepositoryMonitorDidChangeNotification
+                                                       object:nil];
+        }
     }
     return self;
 }
@@ -74,6 +81,20 @@ NS_ASSUME_NONNULL_BEGIN
     }
 }
 
+// With the monitor, timer-driven polls usually get the saved state without running git, so this is
+// what picks up changes promptly.
+- (void)repositoryDidChange:(NSNotification *)notification {
+    NSString *root = notification.object;
+    if (![_currentDirectory isEqualToString:root] &&
+        ![_currentDirectory hasPrefix:[root stringByAppendingString:@"/"]]) {
+        return;
+    }
+    DLog(@"%@: Repository %@ changed", self, root);
+    // Forget the last poll so the delegate only considers visibility, not recent activity.
+    _lastPollTime = nil;
+    [self poll];
+}
+
 - (NSTimeInterval)timeSinceLastPoll {
     return -[_lastPollTime timeIntervalSinceNow];
 }
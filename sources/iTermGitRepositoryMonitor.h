@@ -0,0 +1,44 @@
+//
+//  iTermGitRepositoryMonitor.h
+//  iTerm2SharedARC
+//
+//  Created by agent on 10/14/26.
+//
+
+#import <Foundation/Foundation.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+@class iTermGitState;
+
+// Posted on the main thread after files change in a watched repository. The object is the root.
+extern NSString *const iTermGitRepositoryMonitorDidChangeNotification;
+
+// Watches each git repository that sessions are in with one FSEvents stream, so that its state
+// is only recomputed after something changes, no matter how many sessions are in it. Main thread
+// only.
+@interface iTermGitRepositoryMonitor : NSObject
+
++ (BOOL)enabled;
++ (instancetype)sharedInstance;
+
+// Calls completion on the main queue with the root of the repository containing path, which will
+// be watched from then on. Gets nil if path isn't in a repository that can be watched (e.g., its
+// .git is a file pointing elsewhere).
+- (void)findRepositoryContainingPath:(NSString *)path
+                          completion:(void (^)(NSString * _Nullable root))completion;
+
+// Nil if the repository changed since its state was saved.
+- (nullable iTermGitState *)stateForRepository:(NSString *)root;
+
+// Counts changes seen in the repository. Save the value from before computing a state.
+- (NSInteger)changeCountForRepository:(NSString *)root;
+
+// Discarded if the repository changed after changeCount.
+- (void)setState:(iTermGitState *)state
+   forRepository:(NSString *)root
+     changeCount:(NSInteger)changeCount;
+
+@end
+
+NS_ASSUME_NONNULL_END
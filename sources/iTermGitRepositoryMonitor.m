@@ -0,0 +1,231 @@
+//
+//  iTermGitRepositoryMonitor.m
+//  iTerm2SharedARC
+//
+//  Created by agent on 10/14/26.
+//
+
+#import "iTermGitRepositoryMonitor.h"
+
+#import "DebugLogging.h"
+#import "iTermAdvancedSettingsModel.h"
+#import "iTermGitState.h"
+
+#import <CoreServices/CoreServices.h>
+
+NSString *const iTermGitRepositoryMonitorDidChangeNotification = @"iTermGitRepositoryMonitorDidChangeNotification";
+
+// FSEvents coalesces changes made within this many seconds, which debounces bursts like a build
+// or a checkout.
+static const CFTimeInterval iTermGitRepositoryMonitorLatency = 1;
+
+// Past this many repositories, new ones aren't watched and fall back to polling.
+static const NSUInteger iTermGitRepositoryMonitorMaximumWatchers = 64;
+
+@class iTermGitRepositoryWatcher;
+
+static void iTermGitRepositoryWatcherCallback(ConstFSEventStreamRef streamRef,
+                                              void *clientCallBackInfo,
+                                              size_t numEvents,
+                                              void *eventPaths,
+                                              const FSEventStreamEventFlags eventFlags[],
+                                              const FSEventStreamEventId eventIds[]);
+
+@interface iTermGitRepositoryWatcher : NSObject
+@property (nonatomic, readonly) NSString *root;
+@property (nonatomic, readonly) NSInteger changeCount;
+@property (nullable, nonatomic, strong) iTermGitState *state;
+- (instancetype)initWithRoot:(NSString *)root;
+- (void)didReceiveEventsAtPaths:(char **)paths count:(size_t)count;
+@end
+
+@implementation iTermGitRepositoryWatcher {
+    FSEventStreamRef _stream;
+    // Changes here don't affect the state and are frequent (e.g., git gc, reflog updates).
+    NSArray<NSString *> *_ignoredPrefixes;
+}
+
+- (instancetype)initWithRoot:(NSString *)root {
+    self = [super init];
+    if (self) {
+        _root = [root copy];
+        NSString *gitDir = [root stringByAppendingPathComponent:@".git"];
+        _ignoredPrefixes = @[ [gitDir stringByAppendingPathComponent:@"objects/"],
+                              [gitDir stringByAppendingPathComponent:@"logs/"] ];
+        FSEventStreamContext context = {
+            .version = 0,
+            .info = (__bridge void *)self,
+        };
+        _stream = FSEventStreamCreate(kCFAllocatorDefault,
+                                      iTermGitRepositoryWatcherCallback,
+                                      &context,
+                                      (__bridge CFArrayRef)@[ root ],
+                                      kFSEventStreamEventIdSinceNow,
+                                      iTermGitRepositoryMonitorLatency,
+                                      kFSEventStreamCreateFlagWatchRoot);
+        if (!_stream) {
+            DLog(@"Failed to create event stream for %@", root);
+            return nil;
+        }
+        FSEventStreamSetDispatchQueue(_stream, dispatch_get_main_queue());
+        if (!FSEventStreamStart(_stream)) {
+            DLog(@"Failed to start event stream for %@", root);
+            FSEventStreamInvalidate(_stream);
+            FSEventStreamRelease(_stream);
+            _stream = NULL;
+            return nil;
+        }
+    }
+    return self;
+}
+
+- (void)dealloc {
+    if (_stream) {
+        FSEventStreamStop(_stream);
+        FSEventStreamInvalidate(_stream);
+        FSEventStreamRelease(_stream);
+    }
+}
+
+- (void)didReceiveEventsAtPaths:(char **)paths count:(size_t)count {
+    for (size_t i = 0; i < count; i++) {
+        NSString *path = [NSString stringWithUTF8String:paths[i]];
+        BOOL ignored = NO;
+        for (NSString *prefix in _ignoredPrefixes) {
+            if ([path hasPrefix:prefix]) {
+                ignored = YES;
+                break;
+            }
+        }
+        if (ignored) {
+            continue;
+        }
+        DLog(@"%@ changed in %@", path, _root);
+        _changeCount += 1;
+        _state = nil;
+        [[NSNotificationCenter defaultCenter] postNotificationName:iTermGitRepositoryMonitorDidChangeNotification
+                                                            object:_root];
+        return;
+    }
+}
+
+@end
+
+static void iTermGitRepositoryWatcherCallback(ConstFSEventStreamRef streamRef,
+                                              void *clientCallBackInfo,
+                                              size_t numEvents,
+                                              void *eventPaths,
+                                              const FSEventStreamEventFlags eventFlags[],
+                                              const FSEventStreamEventId eventIds[]) {
+    iTermGitRepositoryWatcher *watcher = (__bridge iTermGitRepositoryWatcher *)clientCallBackInfo;
+    [watcher didReceiveEventsAtPaths:eventPaths count:numEvents];
+}
+
+@implementation iTermGitRepositoryMonitor {
+    NSMutableDictionary<NSString *, iTermGitRepositoryWatcher *> *_watchers;
+    // Path -> root of a watched repository. Misses aren't saved since a repository could be
+    // created later.
+    NSMutableDictionary<NSString *, NSString *> *_roots;
+    dispatch_queue_t _queue;
+}
+
++ (BOOL)enabled {
+    static BOOL enabled;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        enabled = [iTermAdvancedSettingsModel gitStateFromFileSystemEvents];
+    });
+    return enabled;
+}
+
++ (instancetype)sharedInstance {
+    static id instance;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        instance = [[self alloc] init];
+    });
+    return instance;
+}
+
+- (instancetype)init {
+    self = [super init];
+    if (self) {
+        _watchers = [NSMutableDictionary dictionary];
+        _roots = [NSMutableDictionary dictionary];
+        _queue = dispatch_queue_create("com.iterm2.git-repository-monitor", DISPATCH_QUEUE_SERIAL);
+    }
+    return self;
+}
+
+- (void)findRepositoryContainingPath:(NSString *)path
+                          completion:(void (^)(NSString * _Nullable))completion {
+    NSString *cached = _roots[path];
+    if (cached) {
+        completion(cached);
+        return;
+    }
+    // Stat off the main thread since the path could be on a slow network volume.
+    dispatch_async(_queue, ^{
+        NSString *root = [self repositoryRootContainingPath:path];
+        dispatch_async(dispatch_get_main_queue(), ^{
+            [self didFindRoot:root forPath:path];
+            completion(self->_watchers[root] ? root : nil);
+        });
+    });
+}
+
+- (iTermGitState *)stateForRepository:(NSString *)root {
+    return _watchers[root].state;
+}
+
+- (NSInteger)changeCountForRepository:(NSString *)root {
+    return _watchers[root].changeCount;
+}
+
+- (void)setState:(iTermGitState *)state
+   forRepository:(NSString *)root
+     changeCount:(NSInteger)changeCount {
+    iTermGitRepositoryWatcher *watcher = _watchers[root];
+    if (watcher.changeCount != changeCount) {
+        DLog(@"Discard state for %@ since it changed while computing it", root);
+        return;
+    }
+    watcher.state = state;
+}
+
+#pragma mark - Private
+
+// Runs on _queue.
+- (NSString *)repositoryRootContainingPath:(NSString *)path {
+    NSFileManager *fileManager = [NSFileManager defaultManager];
+    NSString *current = path.stringByStandardizingPath;
+    while (current.length > 0) {
+        BOOL isDirectory = NO;
+        if ([fileManager fileExistsAtPath:[current stringByAppendingPathComponent:@".git"]
+                              isDirectory:&isDirectory]) {
+            // A .git file (worktree or submodule) keeps the index somewhere this wouldn't watch.
+            return isDirectory ? current : nil;
+        }
+        NSString *parent = current.stringByDeletingLastPathComponent;
+        if ([parent isEqualToString:current]) {
+            break;
+        }
+        current = parent;
+    }
+    return nil;
+}
+
+- (void)didFindRoot:(NSString *)root forPath:(NSString *)path {
+    DLog(@"Repository containing %@ is %@", path, root);
+    if (root && !_watchers[root] && _watchers.count < iTermGitRepositoryMonitorMaximumWatchers) {
+        _watchers[root] = [[iTermGitRepositoryWatcher alloc] initWithRoot:root];
+    }
+    if (_roots.count > 1024) {
+        [_roots removeAllObjects];
+    }
+    if (_watchers[root]) {
+        _roots[path] = root;
+    }
+}
+
+@end
@@ -15,6 +15,13 @@
 #import "iTermGlobalSearchResult.h"
 #import "iTermTextExtractor.h"
 
+// How long a single call to search a session may take. This is much shorter than FindContext's
+// default so that keystrokes and drawing can be handled between calls.
+static const NSTimeInterval iTermGlobalSearchEngineSessionTimeSlice = 0.005;
+
+// How long each timer tick may spend searching, possibly across several sessions.
+static const NSTimeInterval iTermGlobalSearchEngineTickBudget = 0.012;
+
 @implementation iTermGlobalSearchEngine {
     NSTimer *_timer;
     NSMutableArray<iTermGlobalSearchEngineCursor *> *_cursors;
@@ -33,19 +40,11 @@
         _query = [query copy];
         _handler = [handler copy];
         _mode = mode;
+        // Each session's search is started lazily when its cursor first gets a turn, so opening
+        // global search with many sessions doesn't stall while every one of them is set up.
         _cursors = [[sessions mapWithBlock:^id(PTYSession *session) {
-            FindContext *findContext = [[FindContext alloc] init];
-            [session.screen setFindString:query
-                         forwardDirection:NO
-                                     mode:mode
-                              startingAtX:0
-                              startingAtY:session.screen.numberOfLines + 1 + session.screen.totalScrollbackOverflow
-                               withOffset:0
-                                inContext:findContext
-                          multipleResults:YES];
             iTermGlobalSearchEngineCursor *cursor = [[iTermGlobalSearchEngineCursor alloc] init];
             cursor.session = session;
-            cursor.findContext = findContext;
             _expectedLines += session.screen.numberOfLines;
             return cursor;
         }] mutableCopy];
@@ -65,20 +64,40 @@
 }
 
 - (void)searchMore:(NSTimer *)timer {
-    iTermGlobalSearchEngineCursor *cursor = _cursors.firstObject;
-    if (!cursor) {
-        [self stop];
-        return;
-    }
-    [_cursors removeObjectAtIndex:0];
-    const BOOL more = [self searchWithCursor:cursor];
-    if (more) {
-        [_cursors addObject:cursor];
+    NSDate *start = [NSDate date];
+    do {
+        iTermGlobalSearchEngineCursor *cursor = _cursors.firstObject;
+        if (!cursor) {
+            [self stop];
+            return;
+        }
+        [_cursors removeObjectAtIndex:0];
+        const BOOL more = [self searchWithCursor:cursor];
+        if (more) {
+            [_cursors addObject:cursor];
+        } else if (_cursors.count == 0) {
+            [self stop];
+            return;
+        }
+    } while (_timer && -[start timeIntervalSinceNow] < iTermGlobalSearchEngineTickBudget);
+}
+
+- (void)startCursorIfNeeded:(iTermGlobalSearchEngineCursor *)cursor {
+    if (cursor.findContext) {
         return;
     }
-    if (_cursors.count == 0) {
-        [self stop];
-    }
+    FindContext *findContext = [[FindContext alloc] init];
+    PTYSession *session = cursor.session;
+    [session.screen setFindString:_query
+                 forwardDirection:NO
+                             mode:_mode
+                      startingAtX:0
+                      startingAtY:session.screen.numberOfLines + 1 + session.screen.totalScrollbackOverflow
+                       withOffset:0
+                        inContext:findContext
+                  multipleResults:YES];
+    findContext.maxTime = iTermGlobalSearchEngineSessionTimeSlice;
+    cursor.findContext = findContext;
 }
 
 - (NSAttributedString *)snippetFromExtractor:(iTermTextExtractor *)extractor result:(SearchResult *)result {
@@ -102,6 +121,7 @@
 }
 
 - (BOOL)searchWithCursor:(iTermGlobalSearchEngineCursor *)cursor {
+    [self startCursorIfNeeded:cursor];
     NSMutableArray<SearchResult *> *results = [NSMutableArray array];
     const BOOL more = [cursor.session.screen continueFindAllResults:results inContext:cursor.findContext];
     iTermTextExtractor *extractor = [[iTermTextExtractor alloc] initWithDataSource:cursor.session.screen];
@@ -9,6 +9,7 @@
 
 #import "DebugLogging.h"
 #import "FMDatabase.h"
+#import "iTermAdvancedSettingsModel.h"
 #import "NSArray+iTerm.h"
 #import "NSObject+iTerm.h"
 #import "iTermGraphDeltaEncoder.h"
@@ -72,6 +73,8 @@
     NSInteger _recoveryCount;
     _Atomic int _updating;
     _Atomic int _invalid;
+    // Only accessed on _thread.
+    BOOL _checkpointScheduled;
 }
 
 - (instancetype)initWithDatabase:(id<iTermDatabase>)db {
@@ -228,6 +231,7 @@
         if ([self save:encoder state:state]) {
             _recoveryCount = 0;
             DLog(@"Save succeeded");
+            [self scheduleCheckpoint];
             return;
         }
 
@@ -367,8 +371,62 @@
     return ok;
 }
 
+// _thread
+- (void)scheduleCheckpoint {
+    if (![iTermAdvancedSettingsModel checkpointStateDatabaseInBackground] || _checkpointScheduled) {
+        return;
+    }
+    _checkpointScheduled = YES;
+    // Run after the pending save and its completion so that neither waits on the checkpoint. If
+    // several saves are queued, this coalesces their checkpoints into one.
+    [_thread dispatchAsync:^(iTermGraphDatabaseState *state) {
+        self->_checkpointScheduled = NO;
+        [self checkpoint:state];
+    }];
+}
+
+// _thread
+- (void)checkpoint:(iTermGraphDatabaseState *)state {
+    if (!state.db || _invalid) {
+        return;
+    }
+    DLog(@"Checkpoint");
+    [self drainQuery:@"pragma wal_checkpoint(PASSIVE)" state:state];
+
+    // Deleted nodes leave free pages behind. Give them back once there are enough to matter rather
+    // than vacuuming the whole file.
+    const long long minimumFreePages = 256;
+    id<iTermDatabaseResultSet> rs = [state.db executeQuery:@"pragma freelist_count"];
+    long long freePages = 0;
+    if ([rs next]) {
+        freePages = [rs longLongIntForColumn:@"freelist_count"];
+    }
+    [rs close];
+    if (freePages >= minimumFreePages) {
+        DLog(@"Reclaim %@ free pages", @(freePages));
+        [self drainQuery:@"pragma incremental_vacuum" state:state];
+    }
+}
+
+// _thread
+- (void)drainQuery:(NSString *)query state:(iTermGraphDatabaseState *)state {
+    id<iTermDatabaseResultSet> rs = [state.db executeQuery:query];
+    while ([rs next]) {}
+    [rs close];
+}
+
 - (BOOL)createTables:(iTermGraphDatabaseState *)state {
     [state.db executeUpdate:@"PRAGMA journal_mode=WAL"];
+    if ([iTermAdvancedSettingsModel checkpointStateDatabaseInBackground]) {
+        // In WAL mode commits are still durable across a crash without an fsync apiece. Losing the
+        // last save after a power failure is harmless since it's rewritten on the next one.
+        [state.db executeUpdate:@"PRAGMA synchronous=NORMAL"];
+        // Checkpoints run on their own after each save instead of inside whichever commit crosses
+        // the threshold, which could be a synchronous save at quit.
+        [self drainQuery:@"PRAGMA wal_autocheckpoint=0" state:state];
+        // Takes effect for an existing database at the vacuum that follows opening it.
+        [state.db executeUpdate:@"PRAGMA auto_vacuum=INCREMENTAL"];
+    }
 
     if (![state.db executeUpdate:@"create table if not exists Node (key text not null, identifier text not null, parent integer not null, data blob)"]) {
         return NO;
@@ -120,6 +120,11 @@
                                BOOL *stop) {
         iTermEncoderGraphRecord *before = beforeDict[key];
         iTermEncoderGraphRecord *after = afterDict[key];
+        if (before == after) {
+            // An unchanged generation reuses the previous revision's record, so neither it nor any
+            // of its descendants could have anything to write. Don't bother walking it.
+            return;
+        }
         @try {
             block(before, after, parent, path, stop);
         } @catch (NSException *exception) {
@@ -228,8 +228,9 @@ NSInteger iTermGenerationAlwaysEncode = NSIntegerMax;
 - (iTermEncoderGraphRecord *)record {
     switch (_state) {
         case iTermGraphEncoderStateLive:
-            _record = [iTermEncoderGraphRecord withPODs:_pod
-                                                 graphs:_children
+            // The record caches its encoded pod, so give it a copy that can't change later.
+            _record = [iTermEncoderGraphRecord withPODs:[_pod copy]
+                                                 graphs:[_children copy]
                                              generation:_generation
                                                     key:_key
                                              identifier:_identifier
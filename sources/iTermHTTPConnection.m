@@ -18,8 +18,12 @@
     NSURLRequest *_request;
     NSTimeInterval _deadline;
     NSMutableData *_buffer;
+    // Scratch space for read(). Big enough that a large API message arrives in a few syscalls.
+    char *_readBuffer;
 }
 
+static const size_t iTermHTTPConnectionReadBufferSize = 64 * 1024;
+
 - (instancetype)initWithFileDescriptor:(int)fd
                          clientAddress:(iTermSocketAddress *)address
                                   euid:(NSNumber *)euid {
@@ -35,6 +39,10 @@
     return self;
 }
 
+- (void)dealloc {
+    free(_readBuffer);
+}
+
 - (dispatch_io_t)newChannelOnQueue:(dispatch_queue_t)queue {
     @synchronized(_fdSync) {
         return dispatch_io_create(DISPATCH_IO_STREAM, _fd, queue, ^(int error) {
@@ -254,10 +262,12 @@
         return NO;
     }
 
-    char buffer[4096];
-    int rc;
+    if (!_readBuffer) {
+        _readBuffer = malloc(iTermHTTPConnectionReadBufferSize);
+    }
+    ssize_t rc;
     do {
-        rc = read(fd, buffer, sizeof(buffer));
+        rc = read(fd, _readBuffer, iTermHTTPConnectionReadBufferSize);
     } while (rc == -1 && (errno == EINTR || errno == EAGAIN));
     if (rc <= 0) {
         if (rc < 0) {
@@ -271,7 +281,7 @@
         return NO;
     }
 
-    [_buffer appendBytes:buffer length:rc];
+    [_buffer appendBytes:_readBuffer length:rc];
     return YES;
 }
 
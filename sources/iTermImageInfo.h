@@ -88,6 +88,24 @@ extern NSString *const iTermImageDidLoad;
 // A more predictable version of the above. Timestamp determines GIF frame.
 - (NSImage *)imageWithCellSize:(CGSize)cellSize timestamp:(NSTimeInterval)timestamp scale:(CGFloat)scale;
 
+// Like the above but for a specific GIF frame, which must be less than numberOfFrames.
+- (NSImage *)imageForFrame:(int)frame cellSize:(CGSize)cellSize scale:(CGFloat)scale;
+
+// Renders the image for -imageWithCellSize:scale: on a background queue so a later call on the
+// main thread finds it already scaled. Does nothing for animated images.
+- (void)prepareImageWithCellSize:(CGSize)cellSize scale:(CGFloat)scale;
+
+// Approximate bytes used by decoded frames, or 0 if none are resident.
+@property (atomic, readonly) NSInteger decodedByteCount;
+
+// Last time the image was rendered for display, from CACurrentMediaTime().
+@property (atomic, readonly) CFTimeInterval lastUseTime;
+
+// Frees the decoded frames and scaled images, keeping only the original data. They'll be decoded
+// again the next time the image is needed. Returns NO if the image can't be decoded again (e.g.,
+// it is broken or has no data).
+- (BOOL)discardDecodedImage;
+
 // Binds an image. Data is optional and only used for animated GIFs. Not to be used after
 // -initWithDictionary.
 - (void)setImageFromImage:(iTermImage *)image data:(NSData *)data;
@@ -101,4 +119,7 @@ extern NSString *const iTermImageDidLoad;
 // Always returns 0 for non-animated images.
 - (int)frameForTimestamp:(NSTimeInterval)timestamp;
 
+// Number of GIF frames. 1 for non-animated images and 0 if not ready.
+- (int)numberOfFrames;
+
 @end
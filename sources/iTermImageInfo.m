@@ -8,6 +8,8 @@
 
 #import "iTermImageInfo.h"
 
+#import <QuartzCore/QuartzCore.h>
+
 #import "DebugLogging.h"
 #import "iTermAnimatedImageInfo.h"
 #import "iTermImage.h"
@@ -16,6 +18,7 @@
 #import "NSData+iTerm.h"
 #import "NSImage+iTerm.h"
 #import "NSWorkspace+iTerm.h"
+#import "ScreenChar.h"
 
 static NSString *const kImageInfoSizeKey = @"Size";
 static NSString *const kImageInfoImageKey = @"Image";  // data
@@ -34,6 +37,13 @@ NSString *const iTermImageDidLoad = @"iTermImageDidLoad";
 @property(atomic, retain) iTermAnimatedImageInfo *animatedImage;  // If animated GIF, this is nonnil
 @end
 
+static NSInteger iTermImageInfoDecodedByteCount(iTermImage *image) {
+    if (!image) {
+        return 0;
+    }
+    return image.size.width * image.size.height * 4 * MAX(1, image.images.count);
+}
+
 @implementation iTermImageInfo {
     NSData *_data;
     NSString *_uniqueIdentifier;
@@ -42,6 +52,8 @@ NSString *const iTermImageDidLoad = @"iTermImageDidLoad";
     BOOL _paused;
     iTermImage *_image;
     iTermAnimatedImageInfo *_animatedImage;
+    CFTimeInterval _lastUseTime;
+    NSInteger _decodedByteCount;
 }
 
 - (instancetype)initWithCode:(unichar)code {
@@ -121,9 +133,12 @@ NSString *const iTermImageDidLoad = @"iTermImageDidLoad";
                 if (!_animatedImage) {
                     _image = [image retain];
                 }
+                _decodedByteCount = iTermImageInfoDecodedByteCount(image);
+                _lastUseTime = CACurrentMediaTime();
                 if (_image || _animatedImage) {
                     DLog(@"Loaded %@", self.uniqueIdentifier);
                     [[NSNotificationCenter defaultCenter] postNotificationName:iTermImageDidLoad object:self];
+                    EnforceImageMemoryBudget();
                 }
             });
         };
@@ -209,6 +224,54 @@ NSString *const iTermImageDidLoad = @"iTermImageDidLoad";
 
         [_image autorelease];
         _image = [image retain];
+
+        _decodedByteCount = iTermImageInfoDecodedByteCount(image);
+        _lastUseTime = CACurrentMediaTime();
+    }
+}
+
+- (NSInteger)decodedByteCount {
+    @synchronized(self) {
+        return _decodedByteCount;
+    }
+}
+
+- (CFTimeInterval)lastUseTime {
+    @synchronized(self) {
+        return _lastUseTime;
+    }
+}
+
+// Sixel data can't go through -[iTermImage imageWithCompressedData:] so it isn't discarded.
+static BOOL iTermImageInfoDataIsSixel(NSData *data) {
+    const unsigned char *bytes = data.bytes;
+    const NSUInteger limit = MIN(data.length, 1024);
+    for (NSUInteger i = 0; i < limit; i++) {
+        if (bytes[i] == '\n') {
+            return i + 2 < data.length && bytes[i + 1] == 27 && bytes[i + 2] == 'P';
+        }
+    }
+    return NO;
+}
+
+- (BOOL)discardDecodedImage {
+    @synchronized(self) {
+        if (_broken || _data.length == 0 || _dictionary || iTermImageInfoDataIsSixel(_data)) {
+            return NO;
+        }
+        if (!_image && !_animatedImage) {
+            return NO;
+        }
+        DLog(@"Discard decoded image %@", self.uniqueIdentifier);
+        // A nonnil dictionary makes the getters decode from _data again.
+        _dictionary = [[self dictionary] retain];
+        [_image release];
+        _image = nil;
+        [_animatedImage release];
+        _animatedImage = nil;
+        self.embeddedImages = nil;
+        _decodedByteCount = 0;
+        return YES;
     }
 }
 
@@ -291,12 +354,36 @@ NSString *const iTermImageDidLoad = @"iTermImageDidLoad";
     }
 }
 
+- (void)prepareImageWithCellSize:(CGSize)cellSize scale:(CGFloat)scale {
+    if (!self.ready || self.animatedImage) {
+        return;
+    }
+    static dispatch_queue_t queue;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        queue = dispatch_queue_create("com.iterm2.image-prepare", DISPATCH_QUEUE_SERIAL);
+    });
+    dispatch_async(queue, ^{
+        DLog(@"Prepare %@ at cell size %@ scale %@", self.uniqueIdentifier, NSStringFromSize(cellSize), @(scale));
+        [self imageWithCellSize:cellSize timestamp:0 scale:scale];
+    });
+}
+
 - (int)frameForTimestamp:(NSTimeInterval)timestamp {
     @synchronized(self) {
         return [self.animatedImage frameForTimestamp:timestamp];
     }
 }
 
+- (int)numberOfFrames {
+    @synchronized(self) {
+        if (self.animatedImage) {
+            return self.animatedImage.numberOfFrames;
+        }
+        return self.ready ? 1 : 0;
+    }
+}
+
 - (BOOL)ready {
     @synchronized(self) {
         return (self.image || self.animatedImage);
@@ -323,10 +410,23 @@ static NSSize iTermImageInfoGetSizeForRegionPreservingAspectRatio(const NSSize r
             DLog(@"%@ not ready", self.uniqueIdentifier);
             return nil;
         }
+        return [self imageForFrame:[self.animatedImage frameForTimestamp:timestamp]  // 0 if not animated
+                          cellSize:cellSize
+                             scale:scale];
+    }
+}
+
+// NOTE: This gets called off the main queue in the metal renderer.
+- (NSImage *)imageForFrame:(int)frame cellSize:(CGSize)cellSize scale:(CGFloat)scale {
+    @synchronized(self) {
+        if (!self.ready) {
+            DLog(@"%@ not ready", self.uniqueIdentifier);
+            return nil;
+        }
+        _lastUseTime = CACurrentMediaTime();
         if (!_embeddedImages) {
             _embeddedImages = [[NSMutableDictionary alloc] init];
         }
-        int frame = [self.animatedImage frameForTimestamp:timestamp];  // 0 if not animated
         iTermTuple *key = [iTermTuple tupleWithObject:@(frame) andObject:@(scale)];
         NSImage *embeddedImage = _embeddedImages[key];
 
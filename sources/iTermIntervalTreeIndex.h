@@ -0,0 +1,39 @@
+//
+//  iTermIntervalTreeIndex.h
+//  iTerm2
+//
+//  Created by agent on 10/14/26.
+//
+
+#import <Foundation/Foundation.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+// A flat index of half-open intervals for fast range queries. Entries live in one array sorted by
+// location and laid out as an implicit binary tree, so a query touches contiguous memory, visits
+// O(log n + k) entries, and allocates nothing.
+//
+// Objects are not retained. The owner must remove an object before it's freed.
+@interface iTermIntervalTreeIndex : NSObject
+
+@property (nonatomic, readonly) NSInteger count;
+
+- (void)addObject:(id)object location:(long long)location limit:(long long)limit;
+
+// location must be the one the object was added with.
+- (void)removeObject:(id)object location:(long long)location;
+
+- (void)removeAllObjects;
+
+// Removes all objects whose limit is at most |limit|.
+- (void)removeObjectsWithLimitAtMost:(long long)limit;
+
+// Enumerates objects whose intervals intersect [location, limit). Objects in the index come in
+// order of location, followed by those added since the index was last rebuilt.
+- (void)enumerateObjectsIntersectingLocation:(long long)location
+                                       limit:(long long)limit
+                                       block:(void (^ NS_NOESCAPE)(id object, BOOL *stop))block;
+
+@end
+
+NS_ASSUME_NONNULL_END
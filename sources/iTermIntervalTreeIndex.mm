@@ -0,0 +1,230 @@
+//
+//  iTermIntervalTreeIndex.mm
+//  iTerm2
+//
+//  Created by agent on 10/14/26.
+//
+
+#import "iTermIntervalTreeIndex.h"
+
+#include <algorithm>
+#include <vector>
+
+namespace {
+
+struct iTermIntervalTreeIndexEntry {
+    long long location;
+    long long limit;
+    // Largest limit in the implicit subtree rooted at this entry.
+    long long maxLimit;
+    // Unretained. NULL once removed.
+    void *object;
+};
+
+struct iTermIntervalTreeIndexFrame {
+    size_t index;
+    int level;
+    bool visitedLeft;
+};
+
+}  // namespace
+
+// Additions are kept aside and removals leave holes until there are enough to make indexing the
+// whole array again worthwhile.
+static const size_t iTermIntervalTreeIndexMaxPending = 32;
+
+NS_INLINE BOOL iTermIntervalTreeIndexIntersects(const iTermIntervalTreeIndexEntry &entry,
+                                                long long location,
+                                                long long limit) {
+    return std::max(entry.location, location) < std::min(entry.limit, limit);
+}
+
+@implementation iTermIntervalTreeIndex {
+    // Sorted by location and laid out as an implicit tree (see -buildIndex).
+    std::vector<iTermIntervalTreeIndexEntry> _entries;
+    // Added since the last rebuild, in no particular order.
+    std::vector<iTermIntervalTreeIndexEntry> _pending;
+    // Number of removed entries still in _entries.
+    size_t _holes;
+    // Level of the root of the implicit tree or -1 if _entries is empty.
+    int _maxLevel;
+}
+
+- (instancetype)init {
+    self = [super init];
+    if (self) {
+        _maxLevel = -1;
+    }
+    return self;
+}
+
+- (void)addObject:(id)object location:(long long)location limit:(long long)limit {
+    _pending.push_back({ location, limit, limit, (__bridge void *)object });
+    _count++;
+    if (_pending.size() > iTermIntervalTreeIndexMaxPending) {
+        [self rebuild];
+    }
+}
+
+- (void)removeObject:(id)object location:(long long)location {
+    void *pointer = (__bridge void *)object;
+    auto it = std::lower_bound(_entries.begin(),
+                               _entries.end(),
+                               location,
+                               [](const iTermIntervalTreeIndexEntry &entry, long long value) {
+        return entry.location < value;
+    });
+    for (; it != _entries.end() && it->location == location; ++it) {
+        if (it->object == pointer) {
+            it->object = NULL;
+            _holes++;
+            _count--;
+            if (_holes > _entries.size() / 2 + iTermIntervalTreeIndexMaxPending) {
+                [self rebuild];
+            }
+            return;
+        }
+    }
+    for (auto pit = _pending.begin(); pit != _pending.end(); ++pit) {
+        if (pit->object == pointer) {
+            _pending.erase(pit);
+            _count--;
+            return;
+        }
+    }
+}
+
+- (void)removeObjectsWithLimitAtMost:(long long)limit {
+    // Since location <= limit, everything to remove is in a prefix of the sorted entries.
+    for (auto it = _entries.begin(); it != _entries.end() && it->location <= limit; ++it) {
+        if (it->object && it->limit <= limit) {
+            it->object = NULL;
+            _holes++;
+            _count--;
+        }
+    }
+    const size_t before = _pending.size();
+    _pending.erase(std::remove_if(_pending.begin(),
+                                  _pending.end(),
+                                  [limit](const iTermIntervalTreeIndexEntry &entry) {
+        return entry.limit <= limit;
+    }),
+                   _pending.end());
+    _count -= before - _pending.size();
+    if (_holes > _entries.size() / 2 + iTermIntervalTreeIndexMaxPending) {
+        [self rebuild];
+    }
+}
+
+- (void)removeAllObjects {
+    _entries.clear();
+    _pending.clear();
+    _holes = 0;
+    _count = 0;
+    _maxLevel = -1;
+}
+
+- (void)enumerateObjectsIntersectingLocation:(long long)location
+                                       limit:(long long)limit
+                                       block:(void (^ NS_NOESCAPE)(id object, BOOL *stop))block {
+    BOOL stop = NO;
+    const size_t n = _entries.size();
+    const iTermIntervalTreeIndexEntry *entries = _entries.data();
+    if (_maxLevel >= 0) {
+        // Each level pushes at most two frames.
+        iTermIntervalTreeIndexFrame stack[128];
+        int sp = 0;
+        stack[sp++] = { (size_t(1) << _maxLevel) - 1, _maxLevel, false };
+        while (sp > 0 && !stop) {
+            const iTermIntervalTreeIndexFrame frame = stack[--sp];
+            if (frame.level <= 3) {
+                // Small subtrees are faster to scan in order than to descend.
+                const size_t first = frame.index >> frame.level << frame.level;
+                const size_t end = std::min(n, first + (size_t(1) << (frame.level + 1)) - 1);
+                for (size_t i = first; i < end && entries[i].location < limit && !stop; i++) {
+                    if (entries[i].object && iTermIntervalTreeIndexIntersects(entries[i], location, limit)) {
+                        block((__bridge id)entries[i].object, &stop);
+                    }
+                }
+            } else if (!frame.visitedLeft) {
+                const size_t left = frame.index - (size_t(1) << (frame.level - 1));
+                stack[sp++] = { frame.index, frame.level, true };
+                // A left child past the end is virtual but may have real descendants.
+                if (left >= n || entries[left].maxLimit > location) {
+                    stack[sp++] = { left, frame.level - 1, false };
+                }
+            } else if (frame.index < n && entries[frame.index].location < limit) {
+                const iTermIntervalTreeIndexEntry &entry = entries[frame.index];
+                if (entry.object && iTermIntervalTreeIndexIntersects(entry, location, limit)) {
+                    block((__bridge id)entry.object, &stop);
+                }
+                stack[sp++] = { frame.index + (size_t(1) << (frame.level - 1)), frame.level - 1, false };
+            }
+        }
+    }
+    for (size_t i = 0; i < _pending.size() && !stop; i++) {
+        if (iTermIntervalTreeIndexIntersects(_pending[i], location, limit)) {
+            block((__bridge id)_pending[i].object, &stop);
+        }
+    }
+}
+
+#pragma mark - Private
+
+- (void)rebuild {
+    std::vector<iTermIntervalTreeIndexEntry> merged;
+    merged.reserve(_entries.size() - _holes + _pending.size());
+    for (const auto &entry : _entries) {
+        if (entry.object) {
+            merged.push_back(entry);
+        }
+    }
+    merged.insert(merged.end(), _pending.begin(), _pending.end());
+    // Nearly sorted already since new objects tend to come after old ones.
+    std::stable_sort(merged.begin(),
+                     merged.end(),
+                     [](const iTermIntervalTreeIndexEntry &lhs, const iTermIntervalTreeIndexEntry &rhs) {
+        return lhs.location < rhs.location;
+    });
+    _entries.swap(merged);
+    _pending.clear();
+    _holes = 0;
+    [self buildIndex];
+}
+
+// Computes maxLimit for an implicit binary tree over the sorted array. Leaves are the even
+// indices, and the node at level k has its children 2^(k-1) to its left and right. This is the
+// layout described by Heng Li for cgranges.
+- (void)buildIndex {
+    const size_t n = _entries.size();
+    if (n == 0) {
+        _maxLevel = -1;
+        return;
+    }
+    iTermIntervalTreeIndexEntry *entries = _entries.data();
+    size_t lastIndex = 0;
+    long long lastMax = 0;
+    for (size_t i = 0; i < n; i += 2) {
+        lastIndex = i;
+        lastMax = entries[i].maxLimit = entries[i].limit;
+    }
+    int level;
+    for (level = 1; (size_t(1) << level) <= n; level++) {
+        const size_t offset = size_t(1) << (level - 1);
+        const size_t first = (offset << 1) - 1;
+        const size_t step = offset << 2;
+        for (size_t i = first; i < n; i += step) {
+            const long long leftMax = entries[i - offset].maxLimit;
+            // The right child may be past the end, in which case the last real node stands in.
+            const long long rightMax = i + offset < n ? entries[i + offset].maxLimit : lastMax;
+            entries[i].maxLimit = std::max(entries[i].limit, std::max(leftMax, rightMax));
+        }
+        lastIndex = ((lastIndex >> level) & 1) ? lastIndex - offset : lastIndex + offset;
+        if (lastIndex < n && entries[lastIndex].maxLimit > lastMax) {
+            lastMax = entries[lastIndex].maxLimit;
+        }
+    }
+    _maxLevel = level - 1;
+}
+
+@end
@@ -24,6 +24,8 @@ typedef NS_ENUM(NSUInteger, iTermIntervalTreeObjectType) {
                                 onLine:(NSInteger)line;
 - (void)intervalTreeDidRemoveObjectOfType:(iTermIntervalTreeObjectType)type
                                    onLine:(NSInteger)line;
+// linesByType is indexed by iTermIntervalTreeObjectType and excludes iTermIntervalTreeObjectTypeUnknown.
+- (void)intervalTreeDidRemoveObjectsOnLines:(NSArray<NSIndexSet *> *)linesByType;
 - (void)intervalTreeVisibleRangeDidChange;
 @end
 
@@ -0,0 +1,29 @@
+//
+//  iTermKeyBindingIndex.h
+//  iTerm2SharedARC
+//
+//  Created by agent on 10/14/26.
+//
+
+#import <Foundation/Foundation.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+@class iTermKeyBindingAction;
+@class iTermKeystroke;
+
+// A key mapping dictionary compiled into a hash table keyed by character, modifiers, and virtual
+// key code. Lookups give the same answers as -[iTermKeystroke valueInBindingDictionary:] without
+// formatting or parsing strings, and actions are built once rather than on each keystroke.
+@interface iTermKeyBindingIndex : NSObject
+
+// Returns the index for |keyMappings|, building it the first time. Indexes are cached as long as
+// the dictionary lives, so this returns nil for a mutable dictionary. Main thread only.
++ (nullable instancetype)indexForKeyMappings:(NSDictionary *)keyMappings;
+
+- (nullable iTermKeyBindingAction *)actionForKeystroke:(iTermKeystroke *)keystroke;
+- (BOOL)hasMappingForKeystroke:(iTermKeystroke *)keystroke;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,130 @@
+//
+//  iTermKeyBindingIndex.mm
+//  iTerm2SharedARC
+//
+//  Created by agent on 10/14/26.
+//
+
+#import "iTermKeyBindingIndex.h"
+
+#import "iTermKeyBindingAction.h"
+#import "iTermKeystroke.h"
+#import "NSObject+iTerm.h"
+
+#include <unordered_map>
+
+namespace {
+
+struct iTermKeyBindingIndexKey {
+    unsigned int character;
+    NSEventModifierFlags modifierFlags;
+    int virtualKeyCode;
+
+    bool operator==(const iTermKeyBindingIndexKey &other) const {
+        return (character == other.character &&
+                modifierFlags == other.modifierFlags &&
+                virtualKeyCode == other.virtualKeyCode);
+    }
+};
+
+struct iTermKeyBindingIndexKeyHash {
+    size_t operator()(const iTermKeyBindingIndexKey &key) const {
+        return (std::hash<unsigned long long>()(((unsigned long long)key.character << 32) ^ key.modifierFlags) ^
+                std::hash<int>()(key.virtualKeyCode));
+    }
+};
+
+struct iTermKeyBindingIndexValue {
+    // Null if the value is not a valid action dictionary.
+    iTermKeyBindingAction *action;
+    // Whether the dictionary key was in the form this lookup tries first. It takes priority over
+    // other keys that parse to the same keystroke.
+    bool preferred;
+};
+
+typedef std::unordered_map<iTermKeyBindingIndexKey, iTermKeyBindingIndexValue, iTermKeyBindingIndexKeyHash> iTermKeyBindingIndexMap;
+
+}  // namespace
+
+@implementation iTermKeyBindingIndex {
+    // Keyed by all three fields. Only holds keys in the modern serialized form.
+    iTermKeyBindingIndexMap _exact;
+    // Keyed by character and modifiers, with virtualKeyCode always 0.
+    iTermKeyBindingIndexMap _loose;
+}
+
++ (instancetype)indexForKeyMappings:(NSDictionary *)keyMappings {
+    if (!keyMappings) {
+        return nil;
+    }
+    static NSMapTable<NSDictionary *, iTermKeyBindingIndex *> *cache;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        cache = [NSMapTable mapTableWithKeyOptions:(NSPointerFunctionsWeakMemory | NSPointerFunctionsObjectPointerPersonality)
+                                      valueOptions:NSPointerFunctionsStrongMemory];
+    });
+    iTermKeyBindingIndex *index = [cache objectForKey:keyMappings];
+    if (index) {
+        return index;
+    }
+    // Copying an immutable dictionary returns the same object. A mutable one could change after
+    // the index is built.
+    if ([keyMappings copy] != keyMappings) {
+        return nil;
+    }
+    index = [[self alloc] initWithKeyMappings:keyMappings];
+    [cache setObject:index forKey:keyMappings];
+    return index;
+}
+
+- (instancetype)initWithKeyMappings:(NSDictionary *)keyMappings {
+    self = [super init];
+    if (self) {
+        [keyMappings enumerateKeysAndObjectsUsingBlock:^(id serialized, id obj, BOOL *stop) {
+            iTermKeystroke *keystroke = [[iTermKeystroke alloc] initWithSerialized:serialized];
+            NSDictionary *dict = [NSDictionary castFrom:obj];
+            const iTermKeyBindingIndexValue value = {
+                dict ? [iTermKeyBindingAction withDictionary:dict] : nil,
+                false
+            };
+            const iTermKeyBindingIndexKey looseKey = { keystroke.character, keystroke.modifierFlags, 0 };
+            if ([serialized isEqual:keystroke.serialized]) {
+                const iTermKeyBindingIndexKey exactKey = { keystroke.character, keystroke.modifierFlags, keystroke.virtualKeyCode };
+                self->_exact[exactKey] = value;
+            }
+            // Mirror -keyInBindingDictionary:, which prefers a key in the legacy form and
+            // otherwise takes the first modern key with the same character and modifiers.
+            if ([serialized isEqual:keystroke.legacySerialized]) {
+                self->_loose[looseKey] = { value.action, true };
+            } else {
+                self->_loose.emplace(looseKey, value);
+            }
+        }];
+    }
+    return self;
+}
+
+- (const iTermKeyBindingIndexValue *)valueForKeystroke:(iTermKeystroke *)keystroke {
+    const iTermKeyBindingIndexKey exactKey = { keystroke.character, keystroke.modifierFlags, keystroke.virtualKeyCode };
+    auto it = _exact.find(exactKey);
+    if (it != _exact.end()) {
+        return &it->second;
+    }
+    const iTermKeyBindingIndexKey looseKey = { keystroke.character, keystroke.modifierFlags, 0 };
+    it = _loose.find(looseKey);
+    if (it != _loose.end()) {
+        return &it->second;
+    }
+    return NULL;
+}
+
+- (iTermKeyBindingAction *)actionForKeystroke:(iTermKeystroke *)keystroke {
+    const iTermKeyBindingIndexValue *value = [self valueForKeystroke:keystroke];
+    return value ? value->action : nil;
+}
+
+- (BOOL)hasMappingForKeystroke:(iTermKeystroke *)keystroke {
+    return [self valueForKeystroke:keystroke] != NULL;
+}
+
+@end
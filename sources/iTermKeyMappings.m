@@ -9,7 +9,9 @@
 
 #import "DebugLogging.h"
 #import "ITAddressBookMgr.h"
+#import "iTermAdvancedSettingsModel.h"
 #import "iTermKeyBindingAction.h"
+#import "iTermKeyBindingIndex.h"
 #import "iTermKeystroke.h"
 #import "iTermPresetKeyMappings.h"
 #import "iTermUserDefaultsObserver.h"
@@ -62,6 +64,12 @@ static NSInteger iTermKeyMappingsNotificationSupressionCount = 0;
 
 + (iTermKeyBindingAction *)localActionForKeystroke:(iTermKeystroke *)keystroke
                                        keyMappings:(NSDictionary *)keyMappings {
+    if ([iTermAdvancedSettingsModel indexKeyMappings]) {
+        iTermKeyBindingIndex *index = [iTermKeyBindingIndex indexForKeyMappings:keyMappings];
+        if (index) {
+            return [index actionForKeystroke:keystroke];
+        }
+    }
     NSDictionary *theKeyMapping = [keystroke valueInBindingDictionary:keyMappings];
 
     if (theKeyMapping == nil) {
@@ -96,6 +104,12 @@ static NSInteger iTermKeyMappingsNotificationSupressionCount = 0;
 
 + (BOOL)haveKeyMappingForKeystroke:(iTermKeystroke *)keystroke inProfile:(Profile *)profile {
     NSDictionary *dict = profile[KEY_KEYBOARD_MAP];
+    if (dict && [iTermAdvancedSettingsModel indexKeyMappings]) {
+        iTermKeyBindingIndex *index = [iTermKeyBindingIndex indexForKeyMappings:dict];
+        if (index) {
+            return [index hasMappingForKeystroke:keystroke];
+        }
+    }
     return [keystroke valueInBindingDictionary:dict] != nil;
 }
 
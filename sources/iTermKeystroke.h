@@ -19,6 +19,8 @@ NS_ASSUME_NONNULL_BEGIN
 @property (nonatomic) NSEventModifierFlags modifierFlags;
 @property (nonatomic) unsigned int character;
 @property (nonatomic, readonly) NSString *serialized;
+// The older form of serialized, without the virtual key code.
+@property (nonatomic, readonly) NSString *legacySerialized;
 @property (nonatomic, readonly) BOOL touchbar;
 @property (nonatomic, readonly) BOOL isValid;
 
@@ -17,8 +17,13 @@ int iTermProcPidInfoWrapper(int pid, int flavor, uint64_t arg,  void *buffer, in
 + (NSArray<NSString *> *)commandLineArgumentsForProcess:(pid_t)pid execName:(NSString **)execName;
 + (NSString *)commandForProcess:(pid_t)pid execName:(NSString **)execName;
 + (NSArray<NSNumber *> *)allPids;
++ (NSArray<NSNumber *> *)childPidsForPid:(pid_t)parentPid;
 + (pid_t)ppidForPid:(pid_t)childPid;
 + (NSString *)nameOfProcessWithPid:(pid_t)thePid isForeground:(BOOL *)isForeground;
+// startTime is when the process was forked. It doesn't change on exec.
++ (NSString *)nameOfProcessWithPid:(pid_t)thePid
+                      isForeground:(BOOL *)isForeground
+                         startTime:(struct timeval *)startTime;
 + (NSString *)workingDirectoryOfProcess:(pid_t)pid;
 + (void)asyncWorkingDirectoryOfProcess:(pid_t)pid
                                  queue:(dispatch_queue_t)queue
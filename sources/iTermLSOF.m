@@ -143,6 +143,35 @@
     return pidsArray;
 }
 
++ (NSArray<NSNumber *> *)childPidsForPid:(pid_t)parentPid {
+    const int bufferSize = proc_listpids(PROC_PPID_ONLY, parentPid, NULL, 0);
+    if (bufferSize <= 0) {
+        return @[];
+    }
+
+    // Leave room for children forked since the size was measured.
+    const int capacity = bufferSize + 16 * sizeof(int);
+    int *pids = (int *)iTermMalloc(capacity);
+    const int bytesReturned = proc_listpids(PROC_PPID_ONLY, parentPid, pids, capacity);
+    if (bytesReturned <= 0) {
+        free(pids);
+        return @[];
+    }
+
+    const int numPids = bytesReturned / sizeof(int);
+
+    NSMutableArray<NSNumber *> *pidsArray = [NSMutableArray array];
+    for (int i = 0; i < numPids; i++) {
+        if (pids[i] > 0) {
+            [pidsArray addObject:@(pids[i])];
+        }
+    }
+
+    free(pids);
+
+    return pidsArray;
+}
+
 // Returns 0 on failure.
 + (pid_t)ppidForPid:(pid_t)childPid {
     struct proc_bsdshortinfo taskShortInfo;
@@ -168,6 +197,12 @@
 // If a + occurs in the STAT column then it is considered to be a foreground
 // job.
 + (NSString *)nameOfProcessWithPid:(pid_t)thePid isForeground:(BOOL *)isForeground {
+    return [self nameOfProcessWithPid:thePid isForeground:isForeground startTime:NULL];
+}
+
++ (NSString *)nameOfProcessWithPid:(pid_t)thePid
+                      isForeground:(BOOL *)isForeground
+                         startTime:(struct timeval *)startTime {
     int mib[4] = { CTL_KERN, KERN_PROC, KERN_PROC_PID, thePid };
     struct kinfo_proc kp;
     size_t bufSize = sizeof(kp);
@@ -183,6 +218,9 @@
         *isForeground = ((kp.kp_proc.p_flag & P_CONTROLT) &&
                          kp.kp_eproc.e_pgid == kp.kp_eproc.e_tpgid);
     }
+    if (startTime) {
+        *startTime = kp.kp_proc.p_starttime;
+    }
 
     if (kp.kp_proc.p_comm[0]) {
         return [NSString stringWithUTF8String:kp.kp_proc.p_comm];
@@ -18,6 +18,7 @@
 #import "iTermOptionalComponentDownloadWindowController.h"
 #import "iTermPreferences.h"
 #import "iTermSlowOperationGateway.h"
+#import "iTermStartupScheduler.h"
 #import "iTermTipController.h"
 #import "iTermTuple.h"
 #import "iTermUserDefaults.h"
@@ -165,7 +166,11 @@ typedef NS_ENUM(NSUInteger, iTermLaunchExperienceChoice) {
 }
 
 - (void)applicationDidFinishLaunching {
-    [self checkIfSystemPythonModuleNeedsUpgrade];
+    [[iTermStartupScheduler sharedInstance] deferTaskNamed:@"Check Python module version"
+                                                  priority:iTermStartupTaskPriorityNormal
+                                                     block:^{
+        [self checkIfSystemPythonModuleNeedsUpgrade];
+    }];
     switch (_choice) {
         case iTermLaunchExperienceChoiceDefaultPasteBehaviorChangeWarning:
             [self.class quellAnnoyancesForDays:1];
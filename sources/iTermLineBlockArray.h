@@ -11,6 +11,7 @@
 NS_ASSUME_NONNULL_BEGIN
 
 @class LineBlock;
+@class iTermScrollbackSpillFile;
 
 @interface iTermLineBlockArray : NSObject<NSCopying>
 
@@ -20,6 +21,10 @@ NS_ASSUME_NONNULL_BEGIN
 @property (nonatomic) BOOL resizing;
 @property (nonatomic, readonly) NSString *dumpForCrashlog;
 
+// If set, blocks older than the newest spillScrollbackAfterBlocks are moved into this file. Not
+// copied by -copyWithZone: so only the original array writes to it.
+@property (nullable, nonatomic, strong) iTermScrollbackSpillFile *spillFile;
+
 // NOTE: Update -copyWithZone: if you add properties.
 
 - (LineBlock *)objectAtIndexedSubscript:(NSUInteger)index;
@@ -28,6 +33,10 @@ NS_ASSUME_NONNULL_BEGIN
 - (void)removeFirstBlocks:(NSInteger)count;
 - (void)removeLastBlock;
 - (void)replaceLastBlockWithCopy;
+// Returns the first or last block after replacing it with a copy if another array shares it, so
+// it can be modified without affecting the other array.
+- (LineBlock *)firstBlockForWriting;
+- (LineBlock *)lastBlockForWriting;
 - (void)setAllBlocksMayHaveDoubleWidthCharacters;
 - (NSInteger)indexOfBlockContainingLineNumber:(int)lineNumber width:(int)width remainder:(out nonnull int *)remainderPtr;
 - (nullable LineBlock *)blockContainingLineNumber:(int)lineNumber
@@ -41,6 +50,11 @@ NS_ASSUME_NONNULL_BEGIN
 - (NSInteger)rawSpaceUsed;
 - (NSInteger)rawSpaceUsedInRangeOfBlocks:(NSRange)range;
 
+// Compresses every block except the newest |count|, or spills them if there is a spill file.
+// Returns the approximate number of bytes freed right away. Compression finishes in the background
+// and frees more. Must be called on the main thread.
+- (NSInteger)compressBlocksExceptNewest:(NSUInteger)count;
+
 // If you don't need a yoffset pass -1 for width and NULL for blockOffset to avoid building a cache.
 - (LineBlock *)blockContainingPosition:(long long)p
                                  width:(int)width
@@ -8,6 +8,7 @@
 #import "iTermLineBlockArray.h"
 
 #import "DebugLogging.h"
+#import "iTermAdvancedSettingsModel.h"
 #import "iTermCumulativeSumCache.h"
 #import "iTermTuple.h"
 #import "LineBlock.h"
@@ -137,14 +138,23 @@
     LineBlock *_tail;
     BOOL _headDirty;
     BOOL _tailDirty;
+
+    // Compressed blocks that have been inflated, least recently inflated first.
+    NSMutableArray<LineBlock *> *_inflatedColdBlocks;
+    BOOL _recompressionScheduled;
     // NOTE: Update -copyWithZone: if you add member variables.
 }
 
+// How many compressed blocks may be inflated at once before the least recently inflated one is
+// compressed again.
+static const NSUInteger iTermLineBlockArrayMaximumInflatedColdBlocks = 8;
+
 - (instancetype)init {
     self = [super init];
     if (self) {
         _blocks = [NSMutableArray array];
         _numLinesCaches = [[iTermLineBlockCacheCollection alloc] init];
+        _inflatedColdBlocks = [NSMutableArray array];
     }
     return self;
 }
@@ -492,19 +502,48 @@
 }
 
 - (void)replaceLastBlockWithCopy {
-    [self updateCacheIfNeeded];
     NSInteger index = _blocks.count;
     if (index == 0) {
+        [self updateCacheIfNeeded];
         return;
     }
-    index--;
-    [_blocks[index] removeObserver:self];
-    _blocks[index] = [_blocks[index] copy];
+    [self replaceBlockWithCopyAtIndex:index - 1];
+}
+
+- (void)replaceBlockWithCopyAtIndex:(NSUInteger)index {
+    [self updateCacheIfNeeded];
+    LineBlock *original = _blocks[index];
+    [original removeObserver:self];
+    _blocks[index] = [original copy];
     [_blocks[index] addObserver:self];
+    const NSUInteger inflatedIndex = [_inflatedColdBlocks indexOfObjectIdenticalTo:original];
+    if (inflatedIndex != NSNotFound) {
+        [_inflatedColdBlocks removeObjectAtIndex:inflatedIndex];
+    }
     _head = _blocks.firstObject;
     _tail = _blocks.lastObject;
 }
 
+- (LineBlock *)firstBlockForWriting {
+    if (_blocks.count == 0) {
+        return nil;
+    }
+    if ([_blocks[0] hasObserverOtherThan:self]) {
+        [self replaceBlockWithCopyAtIndex:0];
+    }
+    return _blocks[0];
+}
+
+- (LineBlock *)lastBlockForWriting {
+    if (_blocks.count == 0) {
+        return nil;
+    }
+    if ([_blocks.lastObject hasObserverOtherThan:self]) {
+        [self replaceBlockWithCopyAtIndex:_blocks.count - 1];
+    }
+    return _blocks.lastObject;
+}
+
 - (void)addBlock:(LineBlock *)block {
     [self updateCacheIfNeeded];
     [block addObserver:self];
@@ -520,11 +559,20 @@
         // The block might not be empty. Treat it like a bunch of lines just got appended.
         [self updateCacheForBlock:block];
     }
+    const NSUInteger numberOfUncompressedBlocks = [iTermAdvancedSettingsModel compressScrollbackAfterBlocks];
+    if (numberOfUncompressedBlocks > 0 && _blocks.count > numberOfUncompressedBlocks) {
+        [_blocks[_blocks.count - 1 - numberOfUncompressedBlocks] compress];
+    }
+    const NSUInteger numberOfUnspilledBlocks = [iTermAdvancedSettingsModel spillScrollbackAfterBlocks];
+    if (_spillFile && numberOfUnspilledBlocks > 0 && _blocks.count > numberOfUnspilledBlocks) {
+        [_blocks[_blocks.count - 1 - numberOfUnspilledBlocks] spillToFile:_spillFile];
+    }
 }
 
 - (void)removeFirstBlock {
     [self updateCacheIfNeeded];
     [_blocks.firstObject removeObserver:self];
+    [_inflatedColdBlocks removeObject:_blocks.firstObject];
     [_numLinesCaches removeFirstValue];
     [_rawSpaceCache removeFirstValue];
     [_rawLinesCache removeFirstValue];
@@ -542,6 +590,7 @@
 - (void)removeLastBlock {
     [self updateCacheIfNeeded];
     [_blocks.lastObject removeObserver:self];
+    [_inflatedColdBlocks removeObject:_blocks.lastObject];
     [_blocks removeLastObject];
     [_numLinesCaches removeLastValue];
     [_rawSpaceCache removeLastValue];
@@ -626,6 +675,7 @@
     theCopy->_tail = _tail;
     theCopy->_tailDirty = _tailDirty;
     theCopy->_resizing = _resizing;
+    theCopy->_inflatedColdBlocks = [_inflatedColdBlocks mutableCopy];
     for (LineBlock *block in _blocks) {
         [block addObserver:theCopy];
     }
@@ -633,6 +683,27 @@
     return theCopy;
 }
 
+- (NSInteger)compressBlocksExceptNewest:(NSUInteger)count {
+    if (_resizing) {
+        return 0;
+    }
+    // The last block is still being appended to.
+    const NSInteger limit = (NSInteger)_blocks.count - (NSInteger)MAX(1, count);
+    NSInteger reclaimed = 0;
+    for (NSInteger i = 0; i < limit; i++) {
+        LineBlock *block = _blocks[i];
+        const NSInteger before = [block memoryUsage];
+        if (_spillFile) {
+            [block spillToFile:_spillFile];
+        } else {
+            [block compress];
+        }
+        [_inflatedColdBlocks removeObject:block];
+        reclaimed += before - [block memoryUsage];
+    }
+    return reclaimed;
+}
+
 #pragma mark - iTermLineBlockObserver
 
 - (void)lineBlockDidChange:(LineBlock *)lineBlock {
@@ -643,4 +714,33 @@
     }
 }
 
+- (void)lineBlockDidInflate:(LineBlock *)lineBlock {
+    [_inflatedColdBlocks removeObject:lineBlock];
+    [_inflatedColdBlocks addObject:lineBlock];
+    if (_inflatedColdBlocks.count <= iTermLineBlockArrayMaximumInflatedColdBlocks ||
+        _recompressionScheduled) {
+        return;
+    }
+    // The caller may still be holding pointers into any of the inflated blocks, so wait until
+    // it's done before compressing them again.
+    _recompressionScheduled = YES;
+    __weak __typeof(self) weakSelf = self;
+    dispatch_async(dispatch_get_main_queue(), ^{
+        [weakSelf recompressColdBlocks];
+    });
+}
+
+- (void)recompressColdBlocks {
+    _recompressionScheduled = NO;
+    while (_inflatedColdBlocks.count > iTermLineBlockArrayMaximumInflatedColdBlocks) {
+        LineBlock *block = _inflatedColdBlocks.firstObject;
+        [_inflatedColdBlocks removeObjectAtIndex:0];
+        if (block == _tail || ![block hasObserver:self]) {
+            // Removed or being appended to.
+            continue;
+        }
+        [block compress];
+    }
+}
+
 @end
@@ -0,0 +1,32 @@
+//
+//  iTermLineBufferPrefetcher.h
+//  iTerm2SharedARC
+//
+//  Created by agent on 10/14/26.
+//
+
+#import <Foundation/Foundation.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+@class LineBuffer;
+
+// Decodes the scrollback of sessions that are about to be restored on background queues, in
+// parallel, so that by the time a window is created its sessions' line buffers are ready.
+@interface iTermLineBufferPrefetcher : NSObject
+
++ (BOOL)enabled;
+
+// Begins decoding. dictionary is a value that will later be passed to -lineBufferWithDictionary:.
++ (void)prefetchLineBufferWithDictionary:(NSDictionary *)dictionary;
+
+// Returns the prefetched line buffer for this exact dictionary, waiting for it if it's still
+// being decoded, or decodes it now if it wasn't prefetched.
++ (nullable LineBuffer *)lineBufferWithDictionary:(NSDictionary *)dictionary;
+
+// Frees prefetched line buffers that were never used (e.g., their session wasn't restored).
++ (void)discardUnusedLineBuffers;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,97 @@
+//
+//  iTermLineBufferPrefetcher.m
+//  iTerm2SharedARC
+//
+//  Created by agent on 10/14/26.
+//
+
+#import "iTermLineBufferPrefetcher.h"
+
+#import "DebugLogging.h"
+#import "iTermAdvancedSettingsModel.h"
+#import "LineBuffer.h"
+
+@interface iTermLineBufferPrefetch : NSObject
+// Keeps the dictionary alive so its address isn't reused by another one.
+@property (nonatomic, strong) NSDictionary *dictionary;
+@property (nonatomic, strong) dispatch_group_t group;
+// Written on the decoding queue before the group is left.
+@property (nonatomic, strong) LineBuffer *lineBuffer;
+@end
+
+@implementation iTermLineBufferPrefetch
+@end
+
+@implementation iTermLineBufferPrefetcher
+
++ (BOOL)enabled {
+    static BOOL enabled;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        enabled = [iTermAdvancedSettingsModel parallelSessionRestoration];
+    });
+    return enabled;
+}
+
+// Keyed by the dictionary's address. The same contents could appear twice, but only the instance
+// that was prefetched is wanted.
++ (NSMutableDictionary<NSValue *, iTermLineBufferPrefetch *> *)prefetches {
+    static NSMutableDictionary<NSValue *, iTermLineBufferPrefetch *> *prefetches;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        prefetches = [NSMutableDictionary dictionary];
+    });
+    return prefetches;
+}
+
++ (dispatch_queue_t)queue {
+    static dispatch_queue_t queue;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        queue = dispatch_queue_create_with_target("com.iterm2.line-buffer-prefetch",
+                                                  DISPATCH_QUEUE_CONCURRENT,
+                                                  dispatch_get_global_queue(QOS_CLASS_USER_INITIATED, 0));
+    });
+    return queue;
+}
+
++ (void)prefetchLineBufferWithDictionary:(NSDictionary *)dictionary {
+    NSValue *key = [NSValue valueWithNonretainedObject:dictionary];
+    iTermLineBufferPrefetch *prefetch = [[iTermLineBufferPrefetch alloc] init];
+    prefetch.dictionary = dictionary;
+    prefetch.group = dispatch_group_create();
+    @synchronized (self) {
+        if (self.prefetches[key]) {
+            return;
+        }
+        self.prefetches[key] = prefetch;
+    }
+    DLog(@"Prefetch line buffer %p", dictionary);
+    dispatch_group_async(prefetch.group, self.queue, ^{
+        prefetch.lineBuffer = [[LineBuffer alloc] initWithDictionary:dictionary];
+    });
+}
+
++ (LineBuffer *)lineBufferWithDictionary:(NSDictionary *)dictionary {
+    NSValue *key = [NSValue valueWithNonretainedObject:dictionary];
+    iTermLineBufferPrefetch *prefetch;
+    @synchronized (self) {
+        prefetch = self.prefetches[key];
+        [self.prefetches removeObjectForKey:key];
+    }
+    if (!prefetch) {
+        return [[LineBuffer alloc] initWithDictionary:dictionary];
+    }
+    DLog(@"Use prefetched line buffer %p", dictionary);
+    dispatch_group_wait(prefetch.group, DISPATCH_TIME_FOREVER);
+    return prefetch.lineBuffer;
+}
+
++ (void)discardUnusedLineBuffers {
+    @synchronized (self) {
+        DLog(@"Discard %@ unused line buffers", @(self.prefetches.count));
+        [self.prefetches removeAllObjects];
+    }
+}
+
+@end
@@ -43,6 +43,8 @@ extern NSString *const iTermLoggingHelperErrorNotificationGUIDKey;
 - (void)stop;
 
 - (void)logData:(NSData *)data;
+// Plain text. When batching, the conversion to |encoding| happens on the writer's queue.
+- (void)logString:(NSString *)string encoding:(NSStringEncoding)encoding;
 - (void)logNewline;
 
 @end
@@ -17,6 +17,11 @@
 NSString *const iTermLoggingHelperErrorNotificationName = @"SessionLogWriteFailed";
 NSString *const iTermLoggingHelperErrorNotificationGUIDKey = @"guid";
 
+// When batching, pending output is written once this much has accumulated or after the delay,
+// whichever comes first.
+static const NSUInteger iTermLoggingHelperFlushSize = 64 * 1024;
+static const NSTimeInterval iTermLoggingHelperFlushDelay = 0.25;
+
 @interface iTermLoggingHelper()
 @property (nullable, nonatomic, strong) NSFileHandle *fileHandle;
 @end
@@ -25,7 +30,17 @@ NSString *const iTermLoggingHelperErrorNotificationGUIDKey = @"guid";
     // File handle can only be accessed on this queue.
     dispatch_queue_t _queue;
     NSString *_profileGUID;
-    BOOL _needsTimestamp;  // Access only on _queue.
+    // Access only on _queue, or under @synchronized(_pendingItems) when batching.
+    BOOL _needsTimestamp;
+
+    // When batching, output waits here until the next flush on _queue. Items are NSData, NSString
+    // (with _pendingEncoding), or NSDate for a timestamp, so encoding and formatting are done by the
+    // writer rather than by whoever is producing output. Guarded by @synchronized(_pendingItems).
+    BOOL _batching;
+    NSMutableArray *_pendingItems;
+    NSUInteger _pendingLength;
+    NSStringEncoding _pendingEncoding;
+    BOOL _immediateFlushScheduled;
 }
 
 + (void)observeNotificationsWithHandler:(void (^)(NSString * _Nonnull))handler {
@@ -56,6 +71,9 @@ NSString *const iTermLoggingHelperErrorNotificationGUIDKey = @"guid";
         _queue = dispatch_queue_create("com.iterm2.logging", DISPATCH_QUEUE_SERIAL);
         _profileGUID = [profileGUID copy];
         _scope = scope;
+        _batching = [iTermAdvancedSettingsModel batchSessionLogWrites];
+        _pendingItems = [NSMutableArray array];
+        _pendingEncoding = NSUTF8StringEncoding;
     }
     return self;
 }
@@ -101,6 +119,7 @@ NSString *const iTermLoggingHelperErrorNotificationGUIDKey = @"guid";
 - (void)close {
     _scope.logFilename = nil;
     dispatch_async(_queue, ^{
+        [self queueFlush];
         [self.fileHandle closeFile];
         self.fileHandle = nil;
     });
@@ -109,11 +128,14 @@ NSString *const iTermLoggingHelperErrorNotificationGUIDKey = @"guid";
 - (void)start {
     _scope.logFilename = self.path;
     dispatch_async(_queue, ^{
+        [self queueFlush];
         [self.fileHandle closeFile];
         self.fileHandle = nil;
         self.fileHandle = [self newFileHandle];
         if (self.fileHandle) {
-            self->_needsTimestamp = YES;
+            @synchronized (self->_pendingItems) {
+                self->_needsTimestamp = YES;
+            }
         } else {
             self->_enabled = NO;
             dispatch_async(dispatch_get_main_queue(), ^{
@@ -151,6 +173,10 @@ NSString *const iTermLoggingHelperErrorNotificationGUIDKey = @"guid";
 }
 
 - (void)logData:(NSData *)data {
+    if (_batching) {
+        [self appendPendingItem:data length:data.length];
+        return;
+    }
     dispatch_async(_queue, ^{
         if (self.plainText && self->_needsTimestamp) {
             self->_needsTimestamp = NO;
@@ -175,7 +201,32 @@ NSString *const iTermLoggingHelperErrorNotificationGUIDKey = @"guid";
     }
 }
 
+- (void)logString:(NSString *)string encoding:(NSStringEncoding)encoding {
+    if (!_batching) {
+        [self logData:[string dataUsingEncoding:encoding]];
+        return;
+    }
+    @synchronized (_pendingItems) {
+        if (encoding != _pendingEncoding && _pendingItems.count) {
+            // Rare enough that encoding the strings already pending here is fine.
+            NSData *data = [self dataForItems:_pendingItems encoding:_pendingEncoding];
+            [_pendingItems removeAllObjects];
+            [_pendingItems addObject:data];
+            _pendingLength = data.length;
+        }
+        _pendingEncoding = encoding;
+    }
+    [self appendPendingItem:[string copy] length:string.length];
+}
+
 - (void)logNewline {
+    if (_batching) {
+        [self appendPendingItem:[NSData dataWithBytesNoCopy:"\n" length:1 freeWhenDone:NO] length:1];
+        @synchronized (_pendingItems) {
+            _needsTimestamp = YES;
+        }
+        return;
+    }
     dispatch_async(_queue, ^{
         [self queueLogData:[NSData dataWithBytesNoCopy:"\n" length:1 freeWhenDone:NO]];
         self->_needsTimestamp = YES;
@@ -187,6 +238,11 @@ NSString *const iTermLoggingHelperErrorNotificationGUIDKey = @"guid";
     if (![iTermAdvancedSettingsModel logTimestampsWithPlainText]) {
         return;
     }
+    [self queueLogData:[self timestampDataForDate:[NSDate date]]];
+    _needsTimestamp = NO;
+}
+
+- (NSData *)timestampDataForDate:(NSDate *)date {
     static NSDateFormatter *dateFormatter;
     static dispatch_once_t onceToken;
     dispatch_once(&onceToken, ^{
@@ -195,9 +251,84 @@ NSString *const iTermLoggingHelperErrorNotificationGUIDKey = @"guid";
                                                                    options:0
                                                                     locale:[NSLocale currentLocale]];
     });
-    NSString *dateString = [NSString stringWithFormat:@"[%@] ", [dateFormatter stringFromDate:[NSDate date]]];
-    [self queueLogData:[dateString dataUsingEncoding:NSUTF8StringEncoding]];
-    _needsTimestamp = NO;
+    NSString *dateString = [NSString stringWithFormat:@"[%@] ", [dateFormatter stringFromDate:date]];
+    return [dateString dataUsingEncoding:NSUTF8StringEncoding];
+}
+
+#pragma mark - Batching
+
+// Any thread.
+- (void)appendPendingItem:(id)item length:(NSUInteger)length {
+    BOOL flushNow = NO;
+    BOOL flushLater = NO;
+    @synchronized (_pendingItems) {
+        const BOOL wasEmpty = (_pendingItems.count == 0);
+        if (_plainText && _needsTimestamp) {
+            _needsTimestamp = NO;
+            if ([iTermAdvancedSettingsModel logTimestampsWithPlainText]) {
+                [_pendingItems addObject:[NSDate date]];
+            }
+        }
+        [_pendingItems addObject:item];
+        _pendingLength += length;
+        if (_pendingLength >= iTermLoggingHelperFlushSize && !_immediateFlushScheduled) {
+            _immediateFlushScheduled = YES;
+            flushNow = YES;
+        } else if (wasEmpty) {
+            flushLater = YES;
+        }
+    }
+    if (flushNow) {
+        dispatch_async(_queue, ^{
+            [self queueFlush];
+        });
+    } else if (flushLater) {
+        // Keeps the log current when output trickles in.
+        dispatch_after(dispatch_time(DISPATCH_TIME_NOW, (int64_t)(iTermLoggingHelperFlushDelay * NSEC_PER_SEC)), _queue, ^{
+            [self queueFlush];
+        });
+    }
+}
+
+// Renders pending items into one buffer.
+- (NSData *)dataForItems:(NSArray *)items encoding:(NSStringEncoding)encoding {
+    NSMutableData *data = [NSMutableData data];
+    for (id item in items) {
+        if ([item isKindOfClass:[NSData class]]) {
+            [data appendData:item];
+        } else if ([item isKindOfClass:[NSString class]]) {
+            NSData *encoded = [item dataUsingEncoding:encoding];
+            if (encoded) {
+                [data appendData:encoded];
+            }
+        } else if ([item isKindOfClass:[NSDate class]]) {
+            [data appendData:[self timestampDataForDate:item]];
+        }
+    }
+    return data;
+}
+
+// Called on _queue. Writes everything pending with a single write.
+- (void)queueFlush {
+    if (!_batching) {
+        return;
+    }
+    NSArray *items;
+    NSStringEncoding encoding;
+    @synchronized (_pendingItems) {
+        items = [_pendingItems copy];
+        encoding = _pendingEncoding;
+        [_pendingItems removeAllObjects];
+        _pendingLength = 0;
+        _immediateFlushScheduled = NO;
+    }
+    if (items.count == 0) {
+        return;
+    }
+    NSData *data = [self dataForItems:items encoding:encoding];
+    if (data.length) {
+        [self queueLogData:data];
+    }
 }
 
 @end
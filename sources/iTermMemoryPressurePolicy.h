@@ -0,0 +1,31 @@
+//
+//  iTermMemoryPressurePolicy.h
+//  iTerm2SharedARC
+//
+//  Created by agent on 10/14/26.
+//
+
+#import <Foundation/Foundation.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+// Frees memory when the system reports memory pressure. In order, it:
+// 1. Drops the instant replay history of background sessions.
+// 2. Discards decoded inline images that haven't been drawn recently.
+// 3. Compresses (or spills to disk) the scrollback of background sessions, except for the newest
+//    memoryPressureScrollbackFloor blocks.
+// A background session is one whose tab isn't visible. How much was freed is logged.
+@interface iTermMemoryPressurePolicy : NSObject
+
+// Bytes freed the last time memory pressure was handled, by category.
+@property (nonatomic, readonly, nullable) NSDictionary<NSString *, NSNumber *> *lastReclaimed;
+
+// Begins listening for memory pressure.
++ (instancetype)sharedInstance;
+
+// Runs the policy now regardless of memory pressure. Returns bytes freed by category.
+- (NSDictionary<NSString *, NSNumber *> *)trim;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,93 @@
+//
+//  iTermMemoryPressurePolicy.m
+//  iTerm2SharedARC
+//
+//  Created by agent on 10/14/26.
+//
+
+#import "iTermMemoryPressurePolicy.h"
+
+#import "DebugLogging.h"
+#import "iTermAdvancedSettingsModel.h"
+#import "iTermSessionMemoryAccountant.h"
+#import "NSArray+iTerm.h"
+#import "PTYSession.h"
+#import "ScreenChar.h"
+#import "VT100Screen.h"
+
+@implementation iTermMemoryPressurePolicy {
+    dispatch_source_t _source;
+}
+
++ (instancetype)sharedInstance {
+    static dispatch_once_t onceToken;
+    static id instance;
+    dispatch_once(&onceToken, ^{
+        instance = [[self alloc] init];
+    });
+    return instance;
+}
+
+- (instancetype)init {
+    self = [super init];
+    if (self) {
+        _source = dispatch_source_create(DISPATCH_SOURCE_TYPE_MEMORYPRESSURE,
+                                         0,
+                                         DISPATCH_MEMORYPRESSURE_WARN | DISPATCH_MEMORYPRESSURE_CRITICAL,
+                                         dispatch_get_main_queue());
+        __weak __typeof(self) weakSelf = self;
+        dispatch_source_set_event_handler(_source, ^{
+            [weakSelf memoryPressureDidChange];
+        });
+        dispatch_resume(_source);
+    }
+    return self;
+}
+
+- (NSDictionary<NSString *, NSNumber *> *)trim {
+    const NSUInteger floor = MAX(0, [iTermAdvancedSettingsModel memoryPressureScrollbackFloor]);
+    // Cheapest to lose first: instant replay history, then decoded images, which can be decoded
+    // again, then uncompressed scrollback, which costs time to inflate when it's next read.
+    NSInteger dvr = 0;
+    NSInteger scrollback = 0;
+    NSArray<PTYSession *> *sessions = [[[iTermSessionMemoryAccountant sharedInstance] sessions] filteredArrayUsingBlock:^BOOL(PTYSession *session) {
+        return [self sessionIsInBackground:session];
+    }];
+    for (PTYSession *session in sessions) {
+        dvr += [session.screen discardInstantReplayHistory];
+    }
+    const NSInteger images = DiscardUndrawnDecodedImages();
+    for (PTYSession *session in sessions) {
+        scrollback += [session.screen compressScrollbackExceptNewestBlocks:floor];
+    }
+    _lastReclaimed = @{ @"dvr": @(dvr),
+                        @"images": @(images),
+                        @"scrollback": @(scrollback) };
+    ILog(@"Trimmed %@ background sessions of %@ under memory pressure: %@",
+         @(sessions.count),
+         @([[iTermSessionMemoryAccountant sharedInstance] sessions].count),
+         _lastReclaimed);
+    return _lastReclaimed;
+}
+
+#pragma mark - Private
+
+- (void)memoryPressureDidChange {
+    const dispatch_source_memorypressure_flags_t flags = dispatch_source_get_data(_source);
+    DLog(@"Memory pressure flags=%@", @(flags));
+    if (!(flags & (DISPATCH_MEMORYPRESSURE_WARN | DISPATCH_MEMORYPRESSURE_CRITICAL))) {
+        return;
+    }
+    [self trim];
+}
+
+- (BOOL)sessionIsInBackground:(PTYSession *)session {
+    if (session.liveSession || session.dvrDecoder) {
+        // In instant replay.
+        return NO;
+    }
+    // Buried sessions have no delegate.
+    return !session.delegate || ![session.delegate sessionBelongsToVisibleTab];
+}
+
+@end
@@ -9,6 +9,7 @@
 
 #import "DebugLogging.h"
 #import "iTermPublisher.h"
+#import "iTermSystemMetricsSampler.h"
 #include <mach/mach.h>
 #include <mach/mach_init.h>
 #include <mach/mach_error.h>
@@ -16,7 +17,7 @@
 #include <mach/mach_time.h>
 #include <mach/vm_map.h>
 
-@interface iTermMemoryUtilization()<iTermPublisherDelegate>
+@interface iTermMemoryUtilization()<iTermPublisherDelegate, iTermSystemMetric>
 @end
 
 @implementation iTermMemoryUtilization {
@@ -62,7 +63,11 @@
 #pragma mark - Private
 
 - (void)update {
-    [_publisher publish:@((double)self.memoryUsage / (double)self.availableMemory)];
+    [_publisher publish:[self utilization]];
+}
+
+- (NSNumber *)utilization {
+    return @((double)self.memoryUsage / (double)self.availableMemory);
 }
 
 - (long long)pageSize {
@@ -120,6 +125,10 @@
 #pragma mark - iTermPublisherDelegate
 
 - (void)publisherDidChangeNumberOfSubscribers:(iTermPublisher *)publisher {
+    if ([iTermSystemMetricsSampler enabled]) {
+        [[iTermSystemMetricsSampler sharedInstance] setMetric:self active:_publisher.hasAnySubscribers];
+        return;
+    }
     if (!_publisher.hasAnySubscribers) {
         [_timer invalidate];
         _timer = nil;
@@ -132,5 +141,15 @@
     }
 }
 
+#pragma mark - iTermSystemMetric
+
+- (id)systemMetricTakeSample {
+    return [self utilization];
+}
+
+- (void)systemMetricDidTakeSample:(id)sample {
+    [_publisher publish:sample];
+}
+
 @end
 
@@ -162,6 +162,17 @@ NS_CLASS_AVAILABLE(10_11, NA)
 // Eventually this gets copied to the drawable.
 @property (nonatomic, strong) MTLRenderPassDescriptor *temporaryRenderPassDescriptor;
 
+// When redrawing only damaged rows, this descriptor's texture is owned by the driver and holds
+// the previous frame. It takes the place of the temporary texture when using subpixel AA, or of
+// the drawable otherwise. In the latter case drawableRenderPassDescriptor is the drawable's
+// descriptor, to which the retained texture gets copied at the end.
+@property (nonatomic, strong) MTLRenderPassDescriptor *retainedRenderPassDescriptor;
+@property (nonatomic, strong) MTLRenderPassDescriptor *drawableRenderPassDescriptor;
+
+// If set, render passes that draw into the retained texture are clipped to damageRect.
+@property (nonatomic) BOOL hasDamageRect;
+@property (nonatomic) MTLScissorRect damageRect;
+
 - (instancetype)initWithView:(MTKView *)view
          fullSizeTexturePool:(iTermTexturePool *)fullSizeTexturePool NS_DESIGNATED_INITIALIZER;
 - (instancetype)init NS_UNAVAILABLE;
@@ -366,7 +366,8 @@ static NSInteger gNextFrameDataNumber;
     if (self.intermediateRenderPassDescriptor) {
         [self.fullSizeTexturePool returnTexture:self.intermediateRenderPassDescriptor.colorAttachments[0].texture];
     }
-    if (self.temporaryRenderPassDescriptor) {
+    if (self.temporaryRenderPassDescriptor &&
+        self.temporaryRenderPassDescriptor != self.retainedRenderPassDescriptor) {
         [self.fullSizeTexturePool returnTexture:self.temporaryRenderPassDescriptor.colorAttachments[0].texture];
     }
 #if ENABLE_STATS
@@ -21,6 +21,9 @@ NS_CLASS_AVAILABLE(10_11, NA)
 - (iTermImageWrapper *)metalGlueBackgroundImage;
 - (iTermBackgroundImageMode)metalGlueBackgroundImageMode;
 - (CGFloat)metalGlueBackgroundImageBlend;
+// See -[iTermMetalPerFrameStateDelegate takeKeystrokeTimestamp].
+- (NSTimeInterval)metalGlueTakeKeystrokeTimestamp;
+- (NSTimeInterval)metalGlueTakeOutputTimestamp;
 
 @end
 
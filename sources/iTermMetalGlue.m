@@ -17,6 +17,7 @@
 #import "iTermImageInfo.h"
 #import "iTermMarkRenderer.h"
 #import "iTermMetalPerFrameState.h"
+#import "iTermMetalRowCache.h"
 #import "iTermSelection.h"
 #import "iTermSmartCursorColor.h"
 #import "iTermTextDrawingHelper.h"
@@ -43,6 +44,8 @@ NS_ASSUME_NONNULL_BEGIN
     NSMutableSet<NSString *> *_loadedImages;
 }
 
+@synthesize rowCache = _rowCache;
+
 @synthesize oldCursorScreenCoord = _oldCursorScreenCoord;
 @synthesize lastTimeCursorMoved = _lastTimeCursorMoved;
 
@@ -55,6 +58,7 @@ NS_ASSUME_NONNULL_BEGIN
                                                    object:nil];
         _missingImages = [NSMutableSet set];
         _loadedImages = [NSMutableSet set];
+        _rowCache = [[iTermMetalRowCache alloc] init];
     }
     return self;
 }
@@ -162,6 +166,14 @@ NS_ASSUME_NONNULL_BEGIN
     return [self.delegate metalGlueBackgroundImageBlend];
 }
 
+- (NSTimeInterval)takeKeystrokeTimestamp {
+    return [self.delegate metalGlueTakeKeystrokeTimestamp];
+}
+
+- (NSTimeInterval)takeOutputTimestamp {
+    return [self.delegate metalGlueTakeOutputTimestamp];
+}
+
 @end
 
 NS_ASSUME_NONNULL_END
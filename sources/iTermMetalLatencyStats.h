@@ -0,0 +1,35 @@
+//
+//  iTermMetalLatencyStats.h
+//  iTerm2SharedARC
+//
+//  Created by agent on 10/14/26.
+//
+
+#import <Foundation/Foundation.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+@class iTermHistogram;
+
+// Per-driver histograms of end-to-end latency, in milliseconds. Safe to use from any thread.
+@interface iTermMetalLatencyStats : NSObject
+
+// Records a frame that reached the screen at |presentationTime|. Either timestamp may be 0 if
+// the frame wasn't drawn in response to that kind of input. All times are seconds since the
+// reference date.
+- (void)recordFramePresentedAt:(NSTimeInterval)presentationTime
+             keystrokeTimestamp:(NSTimeInterval)keystrokeTimestamp
+                outputTimestamp:(NSTimeInterval)outputTimestamp;
+
+// Time the GPU spent executing a frame's command buffer.
+- (void)recordGPUTime:(NSTimeInterval)duration;
+
+// Returns a JSON-compatible summary. |encodeHistograms| maps renderer names to histograms of
+// encode time in milliseconds, which the driver already keeps.
+- (NSDictionary<NSString *, id> *)dictionaryValueWithEncodeHistograms:(NSDictionary<NSString *, iTermHistogram *> *)encodeHistograms;
+
+- (void)clear;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,92 @@
+//
+//  iTermMetalLatencyStats.m
+//  iTerm2SharedARC
+//
+//  Created by agent on 10/14/26.
+//
+
+#import "iTermMetalLatencyStats.h"
+
+#import "iTermHistogram.h"
+
+#import <os/lock.h>
+
+@implementation iTermMetalLatencyStats {
+    os_unfair_lock _lock;
+    iTermHistogram *_keystrokeToPresent;
+    iTermHistogram *_outputToPresent;
+    iTermHistogram *_gpu;
+}
+
+- (instancetype)init {
+    self = [super init];
+    if (self) {
+        _lock = OS_UNFAIR_LOCK_INIT;
+        _keystrokeToPresent = [[iTermHistogram alloc] init];
+        _outputToPresent = [[iTermHistogram alloc] init];
+        _gpu = [[iTermHistogram alloc] init];
+    }
+    return self;
+}
+
+- (void)recordFramePresentedAt:(NSTimeInterval)presentationTime
+             keystrokeTimestamp:(NSTimeInterval)keystrokeTimestamp
+                outputTimestamp:(NSTimeInterval)outputTimestamp {
+    os_unfair_lock_lock(&_lock);
+    if (keystrokeTimestamp > 0 && presentationTime >= keystrokeTimestamp) {
+        [_keystrokeToPresent addValue:(presentationTime - keystrokeTimestamp) * 1000];
+    }
+    if (outputTimestamp > 0 && presentationTime >= outputTimestamp) {
+        [_outputToPresent addValue:(presentationTime - outputTimestamp) * 1000];
+    }
+    os_unfair_lock_unlock(&_lock);
+}
+
+- (void)recordGPUTime:(NSTimeInterval)duration {
+    if (duration <= 0) {
+        return;
+    }
+    os_unfair_lock_lock(&_lock);
+    [_gpu addValue:duration * 1000];
+    os_unfair_lock_unlock(&_lock);
+}
+
+- (void)clear {
+    os_unfair_lock_lock(&_lock);
+    [_keystrokeToPresent clear];
+    [_outputToPresent clear];
+    [_gpu clear];
+    os_unfair_lock_unlock(&_lock);
+}
+
+- (NSDictionary<NSString *, id> *)dictionaryValueWithEncodeHistograms:(NSDictionary<NSString *, iTermHistogram *> *)encodeHistograms {
+    NSMutableDictionary<NSString *, id> *encode = [NSMutableDictionary dictionary];
+    [encodeHistograms enumerateKeysAndObjectsUsingBlock:^(NSString * _Nonnull name, iTermHistogram * _Nonnull histogram, BOOL * _Nonnull stop) {
+        if (histogram.count > 0) {
+            encode[name] = [self summaryOfHistogram:histogram];
+        }
+    }];
+    os_unfair_lock_lock(&_lock);
+    NSDictionary *result = @{ @"keystroke_to_present": [self summaryOfHistogram:_keystrokeToPresent],
+                              @"output_to_present": [self summaryOfHistogram:_outputToPresent],
+                              @"gpu": [self summaryOfHistogram:_gpu],
+                              @"encode": encode };
+    os_unfair_lock_unlock(&_lock);
+    return result;
+}
+
+#pragma mark - Private
+
+// Percentiles of an empty histogram are NaN, which JSON can't represent, so leave them out.
+- (NSDictionary<NSString *, NSNumber *> *)summaryOfHistogram:(iTermHistogram *)histogram {
+    if (histogram.count == 0) {
+        return @{ @"count": @0 };
+    }
+    return @{ @"count": @(histogram.count),
+              @"p50": @([histogram valueAtNTile:0.5]),
+              @"p90": @([histogram valueAtNTile:0.9]),
+              @"p99": @([histogram valueAtNTile:0.99]),
+              @"max": @([histogram valueAtNTile:1]) };
+}
+
+@end
@@ -14,6 +14,8 @@ NS_ASSUME_NONNULL_BEGIN
 @class VT100Screen;
 @class iTermImageWrapper;
 
+@class iTermMetalRowCache;
+
 @protocol iTermMetalPerFrameStateDelegate <NSObject>
 // Screen-relative cursor location on last frame
 @property (nonatomic) VT100GridCoord oldCursorScreenCoord;
@@ -23,6 +25,11 @@ NS_ASSUME_NONNULL_BEGIN
 @property (nonatomic, readonly) iTermImageWrapper *backgroundImage;
 @property (nonatomic, readonly) iTermBackgroundImageMode backroundImageMode;
 @property (nonatomic, readonly) CGFloat backgroundImageBlend;
+// Persists across frames so unchanged rows can be reused.
+@property (nonatomic, readonly) iTermMetalRowCache *rowCache;
+// Returns the time of the earliest keystroke (or output) since the last call, or 0 if none.
+- (NSTimeInterval)takeKeystrokeTimestamp;
+- (NSTimeInterval)takeOutputTimestamp;
 @end
 
 @interface iTermMetalPerFrameState : NSObject<
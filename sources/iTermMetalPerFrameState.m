@@ -16,9 +16,11 @@
 #import "iTermController.h"
 #import "iTermData.h"
 #import "iTermImageInfo.h"
+#import "iTermMalloc.h"
 #import "iTermMarkRenderer.h"
 #import "iTermMetalPerFrameStateConfiguration.h"
 #import "iTermMetalPerFrameStateRow.h"
+#import "iTermMetalRowCache.h"
 #import "iTermPreferences.h"
 #import "iTermSelection.h"
 #import "iTermSmartCursorColor.h"
@@ -76,10 +78,32 @@ typedef struct {
     BOOL havePreviousCharacterAttributes;
     screen_char_t previousCharacterAttributes;
     vector_float4 lastUnprocessedColor;
+    // Color map key that lastUnprocessedColor came from, or -1 if none. Only set when using the
+    // color map's lookup tables.
+    iTermColorMapKey lastUnprocessedKey;
     BOOL havePreviousForegroundColor;
     vector_float4 previousForegroundColor;
 } iTermMetalPerFrameStateCaches;
 
+// Frame-wide inputs to glyph keys, attributes, and background colors. When any of these changes,
+// no row can be reused from the previous frame. Compared bytewise, so always zero it first.
+typedef struct {
+    NSUInteger colorMapGeneration;
+    vector_float4 unfocusedSelectionColor;
+    CGFloat transparencyAlpha;
+    int width;
+    iTermThinStrokesSetting thinStrokes;
+    BOOL transparencyAffectsOnlyDefaultBackgroundColor;
+    BOOL isFrontTextView;
+    BOOL isRetina;
+    BOOL reverseVideo;
+    BOOL useCustomBoldColor;
+    BOOL brightenBold;
+    BOOL useNativePowerlineGlyphs;
+    BOOL blinkAllowed;
+    BOOL underlineHyperlinks;
+} iTermMetalRowCacheStyle;
+
 @interface iTermMetalPerFrameState() {
     iTermMetalPerFrameStateConfiguration *_configuration;
 
@@ -114,6 +138,22 @@ typedef struct {
     NSArray<iTermHighlightedRow *> *_highlightedRows;
     NSTimeInterval _startTime;
     NSEdgeInsets _extraMargins;
+
+    // Nil unless rows may be reused from earlier frames.
+    iTermMetalRowCache *_rowCache;
+    NSUInteger _rowCacheEpoch;
+    NSTimeInterval _keystrokeTimestamp;
+    NSTimeInterval _outputTimestamp;
+
+    // Nil unless colors are resolved through a table. Indexed by iTermColorMapKey for keys below
+    // kColorMap24bitBase and filled in lazily. Rows are built one at a time on a single queue, so no
+    // locking is needed.
+    vector_float4 *_colorTable;
+    BOOL *_colorTableValid;
+
+    // Resolve palette colors and process text colors with the color map's lookup tables and
+    // vector functions instead of NSColor.
+    BOOL _useColorMapLookupTables;
 }
 @end
 
@@ -143,6 +183,8 @@ typedef struct {
     if (_metalContext) {
         CGContextRelease(_metalContext);
     }
+    free(_colorTable);
+    free(_colorTableValid);
 }
 
 - (void)loadAllWithTextView:(PTYTextView *)textView
@@ -151,6 +193,11 @@ typedef struct {
     iTermTextDrawingHelper *drawingHelper = textView.drawingHelper;
 
     [_configuration loadSettingsWithDrawingHelper:drawingHelper textView:textView glue:glue];
+    if ([iTermAdvancedSettingsModel useMetalColorTable]) {
+        _colorTable = iTermCalloc(kColorMap24bitBase, sizeof(*_colorTable));
+        _colorTableValid = iTermCalloc(kColorMap24bitBase, sizeof(*_colorTableValid));
+    }
+    _useColorMapLookupTables = [iTermAdvancedSettingsModel useColorMapLookupTables];
     [self loadSettingsWithDrawingHelper:drawingHelper textView:textView];
     [self loadMetricsWithDrawingHelper:drawingHelper textView:textView screen:screen];
     [self loadLinesWithDrawingHelper:drawingHelper textView:textView screen:screen];
@@ -162,10 +209,41 @@ typedef struct {
     [self loadIndicatorsFromTextView:textView];
     [self loadHighlightedRowsFromTextView:textView];
     [self loadAnnotationRangesFromTextView:textView];
+    [self loadRowCacheWithGlue:glue];
+    if ([iTermAdvancedSettingsModel measureMetalLatency]) {
+        _keystrokeTimestamp = [glue takeKeystrokeTimestamp];
+        _outputTimestamp = [glue takeOutputTimestamp];
+    }
 
     [textView.dataSource setUseSavedGridIfAvailable:NO];
 }
 
+- (void)loadRowCacheWithGlue:(id<iTermMetalPerFrameStateDelegate>)glue {
+    if (![iTermAdvancedSettingsModel reuseUnchangedMetalRows]) {
+        return;
+    }
+    iTermMetalRowCacheStyle style;
+    memset(&style, 0, sizeof(style));
+    style.colorMapGeneration = _configuration->_colorMap.generation;
+    style.unfocusedSelectionColor = _configuration->_unfocusedSelectionColor;
+    style.transparencyAlpha = _configuration->_transparencyAlpha;
+    style.width = _configuration->_gridSize.width;
+    style.thinStrokes = _configuration->_thinStrokes;
+    style.transparencyAffectsOnlyDefaultBackgroundColor = _configuration->_transparencyAffectsOnlyDefaultBackgroundColor;
+    style.isFrontTextView = _configuration->_isFrontTextView;
+    style.isRetina = _configuration->_isRetina;
+    style.reverseVideo = _configuration->_reverseVideo;
+    style.useCustomBoldColor = _configuration->_useCustomBoldColor;
+    style.brightenBold = _configuration->_brightenBold;
+    style.useNativePowerlineGlyphs = _configuration->_useNativePowerlineGlyphs;
+    style.blinkAllowed = _configuration->_blinkAllowed;
+    style.underlineHyperlinks = [iTermAdvancedSettingsModel underlineHyperlinks];
+
+    _rowCache = glue.rowCache;
+    _rowCacheEpoch = [_rowCache beginFrameWithStyleKey:[NSData dataWithBytes:&style length:sizeof(style)]
+                                             firstLine:_firstVisibleAbsoluteLineNumber];
+}
+
 - (void)loadSettingsWithDrawingHelper:(iTermTextDrawingHelper *)drawingHelper
                              textView:(PTYTextView *)textView {
     _numberOfScrollbackLines = textView.dataSource.numberOfScrollbackLines;
@@ -623,6 +701,14 @@ ambiguousIsDoubleWidth:(BOOL)ambiguousIsDoubleWidth
     return _configuration->_gridSize;
 }
 
+- (NSTimeInterval)keystrokeTimestamp {
+    return _keystrokeTimestamp;
+}
+
+- (NSTimeInterval)outputTimestamp {
+    return _outputTimestamp;
+}
+
 - (vector_float4)defaultBackgroundColor {
     NSColor *color = [_configuration->_colorMap colorForKey:kColorMapBackground];
     return simd_make_float4((float)color.redComponent,
@@ -702,8 +788,34 @@ ambiguousIsDoubleWidth:(BOOL)ambiguousIsDoubleWidth
     memset(&caches, 0, sizeof(caches));
 
     *markStylePtr = [_rows[row]->_markStyle intValue];
+
+    iTermMetalRowCacheInputs *cacheInputs = nil;
+    if (_rowCache) {
+        cacheInputs = [[iTermMetalRowCacheInputs alloc] init];
+        cacheInputs->_line = lineData;
+        cacheInputs->_selectedIndexes = selectedIndexes;
+        cacheInputs->_findMatches = findMatches;
+        cacheInputs->_annotatedIndexes = annotatedIndexes;
+        cacheInputs->_underlinedRange = underlinedRange;
+        cacheInputs->_blinkingItemsVisible = _configuration->_blinkingItemsVisible;
+        iTermMetalRowCacheEntry *entry = [_rowCache entryForRow:row inputs:cacheInputs epoch:_rowCacheEpoch];
+        if (entry) {
+            memcpy(glyphKeys, entry->_glyphKeys.bytes, entry->_glyphKeys.length);
+            memcpy(attributes, entry->_attributes.bytes, entry->_attributes.length);
+            memcpy(backgroundRLE, entry->_backgroundRLEs.bytes, entry->_backgroundRLEs.length);
+            *rleCount = entry->_numberOfBackgroundRLEs;
+            *drawableGlyphsPtr = entry->_numberOfDrawableGlyphs;
+            [self setCursorTextColorInAttributes:attributes row:row width:width];
+            [lineData checkForOverrun];
+            return;
+        }
+    }
+
+    BOOL haveImage = NO;
+    BOOL haveBlinkingText = NO;
     int lastDrawableGlyph = -1;
     for (int x = 0; x < width; x++) {
+        haveBlinkingText = haveBlinkingText || line[x].blink;
         BOOL selected = [selectedIndexes containsIndex:x];
         BOOL findMatch = NO;
         if (findMatches && !selected) {
@@ -841,6 +953,7 @@ ambiguousIsDoubleWidth:(BOOL)ambiguousIsDoubleWidth
         previousColorKey = temp;
 
         if (line[x].image) {
+            haveImage = YES;
             if (line[x].code == previousImageCode &&
                 line[x].foregroundColor == ((previousImageCoord.x + 1) & 0xff) &&
                 line[x].backgroundColor == previousImageCoord.y) {
@@ -893,7 +1006,29 @@ ambiguousIsDoubleWidth:(BOOL)ambiguousIsDoubleWidth
     *rleCount = rles;
     *drawableGlyphsPtr = lastDrawableGlyph + 1;
 
-    // Tweak the text color for the cell that has a box cursor.
+    if (cacheInputs && !haveImage) {
+        // Image runs depend on whether the image has loaded, so rows with images are always rebuilt.
+        iTermMetalRowCacheEntry *entry = [[iTermMetalRowCacheEntry alloc] init];
+        entry->_inputs = cacheInputs;
+        entry->_glyphKeys = [NSData dataWithBytes:glyphKeys length:sizeof(*glyphKeys) * width];
+        entry->_attributes = [NSData dataWithBytes:attributes length:sizeof(*attributes) * width];
+        entry->_backgroundRLEs = [NSData dataWithBytes:backgroundRLE length:sizeof(*backgroundRLE) * rles];
+        entry->_numberOfBackgroundRLEs = rles;
+        entry->_numberOfDrawableGlyphs = lastDrawableGlyph + 1;
+        entry->_dependsOnBlinkingItemsVisible = haveBlinkingText && _configuration->_blinkAllowed;
+        entry->_epoch = _rowCacheEpoch;
+        [_rowCache setEntry:entry forRow:row];
+    }
+
+    [self setCursorTextColorInAttributes:attributes row:row width:width];
+    [lineData checkForOverrun];
+}
+
+// Tweak the text color for the cell that has a box cursor. This is not part of the cached row so
+// the cursor can move or blink without invalidating it.
+- (void)setCursorTextColorInAttributes:(iTermMetalGlyphAttributes *)attributes
+                                   row:(int)row
+                                 width:(int)width {
     if (row == _cursorInfo.coord.y &&
         _cursorInfo.type == CURSOR_BOX &&
         _cursorInfo.cursorVisible &&
@@ -917,7 +1052,6 @@ ambiguousIsDoubleWidth:(BOOL)ambiguousIsDoubleWidth
             attributes[_cursorInfo.coord.x].foregroundColor.w = 1;
         }
     }
-    [lineData checkForOverrun];
 }
 
 - (BOOL)useThinStrokesWithAttributes:(iTermMetalGlyphAttributes *)attributes {
@@ -1030,9 +1164,9 @@ ambiguousIsDoubleWidth:(BOOL)ambiguousIsDoubleWidth
                                                bold:isBold
                                        isBackground:isBackground];
     if (isBackground) {
-        return VectorForColor([_configuration->_colorMap colorForKey:key]);
+        return [self vectorForColorMapKey:key];
     } else {
-        vector_float4 color = VectorForColor([_configuration->_colorMap colorForKey:key]);
+        vector_float4 color = [self vectorForColorMapKey:key];
         if (isFaint) {
             color.w = 0.5;
         }
@@ -1040,6 +1174,31 @@ ambiguousIsDoubleWidth:(BOOL)ambiguousIsDoubleWidth
     }
 }
 
+- (vector_float4)vectorForColorMapKey:(iTermColorMapKey)key {
+    if (_useColorMapLookupTables) {
+        return [_configuration->_colorMap fastColorForKey:key];
+    }
+    if (!_colorTable) {
+        return VectorForColor([_configuration->_colorMap colorForKey:key]);
+    }
+    if (key >= kColorMap24bitBase) {
+        // Same as -[NSColor colorWith8BitRed:green:blue:] without creating the color.
+        const int n = key - kColorMap24bitBase;
+        return simd_make_float4(((n >> 16) & 0xff) / 255.0,
+                                ((n >> 8) & 0xff) / 255.0,
+                                (n & 0xff) / 255.0,
+                                1);
+    }
+    if (key < 0) {
+        return VectorForColor([_configuration->_colorMap colorForKey:key]);
+    }
+    if (!_colorTableValid[key]) {
+        _colorTable[key] = VectorForColor([_configuration->_colorMap colorForKey:key]);
+        _colorTableValid[key] = YES;
+    }
+    return _colorTable[key];
+}
+
 - (iTermColorMapKey)colorMapKeyForCode:(int)theIndex
                                  green:(int)green
                                   blue:(int)blue
@@ -1108,7 +1267,8 @@ ambiguousIsDoubleWidth:(BOOL)ambiguousIsDoubleWidth
               @"useItalic": @(_configuration->_useItalicFont),
               @"asciiAntialiased": @(_configuration->_asciiAntialias),
               @"nonasciiAntialiased": @(_configuration->_nonasciiAntialias),
-              @"asciiOffset": @(asciiOffset), };
+              @"asciiOffset": @(asciiOffset),
+              @"useNativePowerlineGlyphs": @(_configuration->_useNativePowerlineGlyphs) };
 }
 
 - (nullable NSDictionary<NSNumber *, iTermCharacterBitmap *> *)metalImagesForGlyphKey:(iTermMetalGlyphKey *)glyphKey
@@ -1176,6 +1336,52 @@ ambiguousIsDoubleWidth:(BOOL)ambiguousIsDoubleWidth
     return result;
 }
 
+- (void)metalEnumerateBoxDrawingGlyphKeys:(void (^ NS_NOESCAPE)(iTermMetalGlyphKey *glyphKey))block {
+    NSCharacterSet *boxCharacterSet = [iTermBoxDrawingBezierCurveFactory boxDrawingCharactersWithBezierPathsIncludingPowerline:_configuration->_useNativePowerlineGlyphs];
+    BOOL thinStrokesValues[2];
+    int numberOfThinStrokesValues = 0;
+    switch (_configuration->_thinStrokes) {
+        case iTermThinStrokesSettingAlways:
+            thinStrokesValues[numberOfThinStrokesValues++] = YES;
+            break;
+        case iTermThinStrokesSettingNever:
+            thinStrokesValues[numberOfThinStrokesValues++] = NO;
+            break;
+        case iTermThinStrokesSettingRetinaOnly:
+            thinStrokesValues[numberOfThinStrokesValues++] = _configuration->_isRetina;
+            break;
+        case iTermThinStrokesSettingDarkBackgroundsOnly:
+        case iTermThinStrokesSettingRetinaDarkBackgroundsOnly:
+            // Depends on the colors of each cell.
+            thinStrokesValues[numberOfThinStrokesValues++] = NO;
+            thinStrokesValues[numberOfThinStrokesValues++] = YES;
+            break;
+    }
+    const NSRange ranges[] = {
+        NSMakeRange(0x2500, 0x25a0 - 0x2500),  // Box drawing, block elements
+        NSMakeRange(0xe0a0, 0xe0d5 - 0xe0a0)   // Powerline
+    };
+    for (size_t i = 0; i < sizeof(ranges) / sizeof(*ranges); i++) {
+        for (NSUInteger code = ranges[i].location; code < NSMaxRange(ranges[i]); code++) {
+            if (![boxCharacterSet characterIsMember:code]) {
+                continue;
+            }
+            for (int j = 0; j < numberOfThinStrokesValues; j++) {
+                iTermMetalGlyphKey glyphKey = {
+                    .code = (unichar)code,
+                    .combiningSuccessor = 0,
+                    .isComplex = NO,
+                    .boxDrawing = YES,
+                    .thinStrokes = thinStrokesValues[j],
+                    .drawable = YES,
+                    .typeface = iTermMetalGlyphKeyTypefaceRegular
+                };
+                block(&glyphKey);
+            }
+        }
+    }
+}
+
 - (void)metalGetUnderlineDescriptorsForASCII:(out iTermMetalUnderlineDescriptor *)ascii
                                     nonASCII:(out iTermMetalUnderlineDescriptor *)nonAscii
                                strikethrough:(out iTermMetalUnderlineDescriptor *)strikethrough {
@@ -1275,6 +1481,7 @@ ambiguousIsDoubleWidth:(BOOL)ambiguousIsDoubleWidth
                             boxDrawing:(BOOL)isBoxDrawingCharacter
                                 caches:(iTermMetalPerFrameStateCaches *)caches {
     vector_float4 rawColor = { 0, 0, 0, 0 };
+    iTermColorMapKey rawKey = -1;
     iTermColorMap *colorMap = _configuration->_colorMap;
     const BOOL needsProcessing = (colorMap.minimumContrast > 0.001 ||
                                   colorMap.dimmingAmount > 0.001 ||
@@ -1289,10 +1496,12 @@ ambiguousIsDoubleWidth:(BOOL)ambiguousIsDoubleWidth
     } else if (inUnderlinedRange) {
         // Blue link text.
         rawColor = VectorForColor([_configuration->_colorMap colorForKey:kColorMapLink]);
+        rawKey = kColorMapLink;
         caches->havePreviousCharacterAttributes = NO;
     } else if (selected) {
         // Selected text.
         rawColor = VectorForColor([colorMap colorForKey:kColorMapSelectedText]);
+        rawKey = kColorMapSelectedText;
         caches->havePreviousCharacterAttributes = NO;
     } else if (_configuration->_reverseVideo &&
                ((c->foregroundColor == ALTSEM_DEFAULT && c->foregroundColorMode == ColorModeAlternate) ||
@@ -1300,6 +1509,7 @@ ambiguousIsDoubleWidth:(BOOL)ambiguousIsDoubleWidth
            // Reverse video is on. Either is cursor or has default foreground color. Use
            // background color.
            rawColor = VectorForColor([colorMap colorForKey:kColorMapBackground]);
+           rawKey = kColorMapBackground;
            caches->havePreviousCharacterAttributes = NO;
     } else if (!caches->havePreviousCharacterAttributes ||
                c->foregroundColor != caches->previousCharacterAttributes.foregroundColor ||
@@ -1312,19 +1522,34 @@ ambiguousIsDoubleWidth:(BOOL)ambiguousIsDoubleWidth
         // "Normal" case for uncached text color. Recompute the unprocessed color from the character.
         caches->previousCharacterAttributes = *c;
         caches->havePreviousCharacterAttributes = YES;
-        rawColor = [self colorForCode:c->foregroundColor
-                                green:c->fgGreen
-                                 blue:c->fgBlue
-                            colorMode:c->foregroundColorMode
-                                 bold:c->bold
-                                faint:c->faint
-                         isBackground:NO];
+        if (_useColorMapLookupTables) {
+            // Same as colorForCode:... but keeps the key so the processed color can come from a table.
+            rawKey = [self colorMapKeyForCode:c->foregroundColor
+                                        green:c->fgGreen
+                                         blue:c->fgBlue
+                                    colorMode:c->foregroundColorMode
+                                         bold:c->bold
+                                 isBackground:NO];
+            rawColor = [self vectorForColorMapKey:rawKey];
+            if (c->faint) {
+                rawColor.w = 0.5;
+            }
+        } else {
+            rawColor = [self colorForCode:c->foregroundColor
+                                    green:c->fgGreen
+                                     blue:c->fgBlue
+                                colorMode:c->foregroundColorMode
+                                     bold:c->bold
+                                    faint:c->faint
+                             isBackground:NO];
+        }
     } else {
         // Foreground attributes are just like the last character. There is a cached foreground color.
         if (needsProcessing) {
             // Process the text color for the current background color, which has changed since
             // the last cell.
             rawColor = caches->lastUnprocessedColor;
+            rawKey = caches->lastUnprocessedKey;
         } else {
             // Text color is unchanged. Either it's independent of the background color or the
             // background color has not changed.
@@ -1333,9 +1558,22 @@ ambiguousIsDoubleWidth:(BOOL)ambiguousIsDoubleWidth
     }
 
     caches->lastUnprocessedColor = rawColor;
+    caches->lastUnprocessedKey = rawKey;
 
     vector_float4 result;
-    if (needsProcessing) {
+    if (needsProcessing && _useColorMapLookupTables) {
+        if (rawKey >= 0 &&
+            rawKey < kColorMap24bitBase &&
+            rawColor.w >= 1 &&
+            (isBoxDrawingCharacter || colorMap.minimumContrast <= 0.001)) {
+            // Opaque text without minimum contrast doesn't depend on the background color.
+            result = [colorMap fastProcessedTextColorForKey:rawKey];
+        } else {
+            result = [colorMap fastProcessedTextColorForTextColor:rawColor
+                                              overBackgroundColor:unprocessedBackgroundColor
+                                           disableMinimumContrast:isBoxDrawingCharacter];
+        }
+    } else if (needsProcessing) {
         result = VectorForColor([_configuration->_colorMap processedTextColorForTextColor:ColorForVector(rawColor)
                                                       overBackgroundColor:ColorForVector(unprocessedBackgroundColor)
                                                    disableMinimumContrast:isBoxDrawingCharacter]);
@@ -0,0 +1,68 @@
+//
+//  iTermMetalRowCache.h
+//  iTerm2SharedARC
+//
+//  Created by agent on 10/14/26.
+//
+
+#import <Foundation/Foundation.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+@class iTermData;
+
+// Everything besides frame-wide style that goes into a row's glyph keys, attributes, and
+// background colors.
+@interface iTermMetalRowCacheInputs : NSObject {
+@public
+    iTermData *_line;
+    NSIndexSet * _Nullable _selectedIndexes;
+    NSData * _Nullable _findMatches;
+    NSIndexSet * _Nullable _annotatedIndexes;
+    NSRange _underlinedRange;
+    // Only compared for entries whose row has blinking text.
+    BOOL _blinkingItemsVisible;
+}
+@end
+
+// The output of building a row's glyph keys. Immutable once stored in the cache.
+@interface iTermMetalRowCacheEntry : NSObject {
+@public
+    iTermMetalRowCacheInputs *_inputs;
+    NSData *_glyphKeys;
+    NSData *_attributes;
+    NSData *_backgroundRLEs;
+    int _numberOfBackgroundRLEs;
+    int _numberOfDrawableGlyphs;
+    // Set when the row has text that blinks. Other rows are reused as the cursor blinks.
+    BOOL _dependsOnBlinkingItemsVisible;
+    NSUInteger _epoch;
+}
+@end
+
+// Remembers the glyph keys built for each row on screen so a row whose contents and decorations are
+// unchanged since the last frame can be copied rather than rebuilt. Frames are built on the main
+// thread and consumed on the Metal driver's queue, possibly with several in flight, so this class is
+// thread-safe. Each frame captures an epoch when it begins; entries from a frame with a different
+// style are never returned.
+//
+// Entries follow their lines when the view scrolls, so after output scrolls the screen up only the
+// new rows at the bottom need to be built.
+@interface iTermMetalRowCache : NSObject
+
+// Call on the main thread as each frame begins. Returns the epoch to pass to the other methods.
+// The epoch changes (and the cache empties) when |styleKey| differs from the previous frame's.
+// |firstLine| is the absolute line number of row 0. When it differs from the previous frame's, each
+// entry moves to the row its line is now on.
+- (NSUInteger)beginFrameWithStyleKey:(NSData *)styleKey firstLine:(long long)firstLine;
+
+- (nullable iTermMetalRowCacheEntry *)entryForRow:(int)row
+                                           inputs:(iTermMetalRowCacheInputs *)inputs
+                                            epoch:(NSUInteger)epoch;
+
+// Does nothing if |entry|'s epoch is stale.
+- (void)setEntry:(iTermMetalRowCacheEntry *)entry forRow:(int)row;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,112 @@
+//
+//  iTermMetalRowCache.m
+//  iTerm2SharedARC
+//
+//  Created by agent on 10/14/26.
+//
+
+#import "iTermMetalRowCache.h"
+
+#import "iTermData.h"
+#import "NSObject+iTerm.h"
+
+#import <os/lock.h>
+
+@implementation iTermMetalRowCacheInputs
+
+- (BOOL)isEqualToInputs:(iTermMetalRowCacheInputs *)other {
+    if (!NSEqualRanges(_underlinedRange, other->_underlinedRange)) {
+        return NO;
+    }
+    if (_line.length != other->_line.length ||
+        memcmp(_line.bytes, other->_line.bytes, _line.length)) {
+        return NO;
+    }
+    return ([NSObject object:_selectedIndexes isEqualToObject:other->_selectedIndexes] &&
+            [NSObject object:_findMatches isEqualToObject:other->_findMatches] &&
+            [NSObject object:_annotatedIndexes isEqualToObject:other->_annotatedIndexes]);
+}
+
+@end
+
+@implementation iTermMetalRowCacheEntry
+@end
+
+@implementation iTermMetalRowCache {
+    os_unfair_lock _lock;
+    NSData *_styleKey;
+    NSUInteger _epoch;
+    long long _firstLine;
+    NSMutableDictionary<NSNumber *, iTermMetalRowCacheEntry *> *_entries;
+}
+
+- (instancetype)init {
+    self = [super init];
+    if (self) {
+        _lock = OS_UNFAIR_LOCK_INIT;
+        _entries = [NSMutableDictionary dictionary];
+    }
+    return self;
+}
+
+- (NSUInteger)beginFrameWithStyleKey:(NSData *)styleKey firstLine:(long long)firstLine {
+    os_unfair_lock_lock(&_lock);
+    if (![styleKey isEqualToData:_styleKey]) {
+        _styleKey = [styleKey copy];
+        _epoch += 1;
+        [_entries removeAllObjects];
+    } else if (firstLine != _firstLine && _entries.count) {
+        [self shiftEntriesBy:_firstLine - firstLine];
+    }
+    _firstLine = firstLine;
+    const NSUInteger epoch = _epoch;
+    os_unfair_lock_unlock(&_lock);
+    return epoch;
+}
+
+- (nullable iTermMetalRowCacheEntry *)entryForRow:(int)row
+                                           inputs:(iTermMetalRowCacheInputs *)inputs
+                                            epoch:(NSUInteger)epoch {
+    os_unfair_lock_lock(&_lock);
+    iTermMetalRowCacheEntry *entry = _entries[@(row)];
+    os_unfair_lock_unlock(&_lock);
+    if (entry == nil || entry->_epoch != epoch) {
+        return nil;
+    }
+    if (entry->_dependsOnBlinkingItemsVisible &&
+        entry->_inputs->_blinkingItemsVisible != inputs->_blinkingItemsVisible) {
+        return nil;
+    }
+    if (![entry->_inputs isEqualToInputs:inputs]) {
+        return nil;
+    }
+    return entry;
+}
+
+// Moves the entry for row r to row r + delta. Entries that would land outside the rows seen so far
+// are dropped. Entries are checked against their inputs before use, so a wrong guess costs only a
+// rebuild.
+- (void)shiftEntriesBy:(long long)delta {
+    int numberOfRows = 0;
+    for (NSNumber *row in _entries) {
+        numberOfRows = MAX(numberOfRows, row.intValue + 1);
+    }
+    NSMutableDictionary<NSNumber *, iTermMetalRowCacheEntry *> *shifted = [NSMutableDictionary dictionary];
+    [_entries enumerateKeysAndObjectsUsingBlock:^(NSNumber *row, iTermMetalRowCacheEntry *entry, BOOL *stop) {
+        const long long newRow = row.intValue + delta;
+        if (newRow >= 0 && newRow < numberOfRows) {
+            shifted[@(newRow)] = entry;
+        }
+    }];
+    _entries = shifted;
+}
+
+- (void)setEntry:(iTermMetalRowCacheEntry *)entry forRow:(int)row {
+    os_unfair_lock_lock(&_lock);
+    if (entry->_epoch == _epoch) {
+        _entries[@(row)] = entry;
+    }
+    os_unfair_lock_unlock(&_lock);
+}
+
+@end
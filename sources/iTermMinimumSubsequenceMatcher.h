@@ -8,6 +8,15 @@
 
 #import <Foundation/Foundation.h>
 
+// Describes the shortest window of a document that contains the query as a subsequence.
+typedef struct {
+    // Offsets of the first and last matching characters.
+    NSUInteger first;
+    NSUInteger last;
+    // Number of runs of non-matching characters between matching ones.
+    NSUInteger gaps;
+} iTermSubsequenceMatch;
+
 @interface iTermMinimumSubsequenceMatcher : NSObject
 
 @property(nonatomic, readonly) NSString *query;
@@ -15,4 +24,9 @@
 - (instancetype)initWithQuery:(NSString *)query;
 - (NSIndexSet *)indexSetForDocument:(NSString *)document;
 
+// Finds the same match as -indexSetForDocument: without building an index set. Use this to score
+// many documents and the index set only for those that get displayed. Returns NO if there is no
+// match.
+- (BOOL)getMatch:(iTermSubsequenceMatch *)match forDocument:(NSString *)document;
+
 @end
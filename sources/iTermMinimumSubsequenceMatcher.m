@@ -8,11 +8,52 @@
 
 #import "iTermMinimumSubsequenceMatcher.h"
 
+#import "iTermAdvancedSettingsModel.h"
+
+// Longer queries and documents use posting lists instead of bitsets.
+static const NSUInteger iTermMinimumSubsequenceMatcherMaxQueryLength = 64;
+static const NSUInteger iTermMinimumSubsequenceMatcherMaxWords = 16;
+static const NSUInteger iTermMinimumSubsequenceMatcherMaxDocumentLength = 64 * iTermMinimumSubsequenceMatcherMaxWords;
+
+// Bit i is set if the document has a particular character at offset i.
+typedef struct {
+    uint64_t words[iTermMinimumSubsequenceMatcherMaxWords];
+} iTermMinimumSubsequenceMatcherBitset;
+
+// Returns the smallest offset greater than |offset| in |bitset|, or -1 if there is none.
+NS_INLINE NSInteger iTermMinimumSubsequenceMatcherNext(const iTermMinimumSubsequenceMatcherBitset *bitset,
+                                                       NSInteger offset,
+                                                       NSUInteger numberOfWords) {
+    const NSUInteger i = offset + 1;
+    NSUInteger w = i >> 6;
+    if (w >= numberOfWords) {
+        return -1;
+    }
+    uint64_t word = bitset->words[w] & (~0ULL << (i & 63));
+    while (!word) {
+        w++;
+        if (w == numberOfWords) {
+            return -1;
+        }
+        word = bitset->words[w];
+    }
+    return (w << 6) + __builtin_ctzll(word);
+}
+
 @implementation iTermMinimumSubsequenceMatcher {
     NSString *_query;  // The original query
     NSArray *_queryChars;  // NSNumbers, one for each character in the query.
     NSDictionary *_postingLists;  // Maps a character to an array of sorted document offsets.
     NSMutableArray *_indexes;  // 1:1 with _queryChars, gives indexes into matching posting list.
+
+    // Used by the bitset search, which is possible when the query is short enough.
+    BOOL _canUseBitsets;
+    NSUInteger _queryLength;
+    // Each distinct character in the query.
+    unichar _distinctChars[iTermMinimumSubsequenceMatcherMaxQueryLength];
+    NSUInteger _numberOfDistinctChars;
+    // Maps an offset in the query to an index in _distinctChars.
+    uint8_t _distinctIndexes[iTermMinimumSubsequenceMatcherMaxQueryLength];
 }
 
 - (instancetype)initWithQuery:(NSString *)query {
@@ -24,6 +65,22 @@
             [temp addObject:@([query characterAtIndex:i])];
         }
         _queryChars = [temp retain];
+
+        _queryLength = query.length;
+        _canUseBitsets = (_queryLength > 0 && _queryLength <= iTermMinimumSubsequenceMatcherMaxQueryLength);
+        if (_canUseBitsets) {
+            for (NSUInteger i = 0; i < _queryLength; i++) {
+                const unichar c = [query characterAtIndex:i];
+                NSUInteger j = 0;
+                while (j < _numberOfDistinctChars && _distinctChars[j] != c) {
+                    j++;
+                }
+                if (j == _numberOfDistinctChars) {
+                    _distinctChars[_numberOfDistinctChars++] = c;
+                }
+                _distinctIndexes[i] = j;
+            }
+        }
     }
     return self;
 }
@@ -181,6 +238,115 @@
 }
 
 - (NSIndexSet *)indexSetForDocument:(NSString *)document {
+    if ([iTermAdvancedSettingsModel bitParallelSubsequenceMatching] &&
+        _canUseBitsets &&
+        document.length <= iTermMinimumSubsequenceMatcherMaxDocumentLength) {
+        NSInteger offsets[iTermMinimumSubsequenceMatcherMaxQueryLength];
+        if (![self getOffsets:offsets forDocument:document]) {
+            return nil;
+        }
+        NSMutableIndexSet *indexSet = [NSMutableIndexSet indexSet];
+        for (NSUInteger i = 0; i < _queryLength; i++) {
+            [indexSet addIndex:offsets[i]];
+        }
+        return indexSet;
+    }
+    return [self postingListIndexSetForDocument:document];
+}
+
+- (BOOL)getMatch:(iTermSubsequenceMatch *)match forDocument:(NSString *)document {
+    if (!_canUseBitsets || document.length > iTermMinimumSubsequenceMatcherMaxDocumentLength) {
+        NSIndexSet *indexSet = [self postingListIndexSetForDocument:document];
+        if (!indexSet.count) {
+            return NO;
+        }
+        __block NSUInteger ranges = 0;
+        [indexSet enumerateRangesUsingBlock:^(NSRange range, BOOL *stop) {
+            ++ranges;
+        }];
+        match->first = indexSet.firstIndex;
+        match->last = indexSet.lastIndex;
+        match->gaps = ranges - 1;
+        return YES;
+    }
+
+    NSInteger offsets[iTermMinimumSubsequenceMatcherMaxQueryLength];
+    if (![self getOffsets:offsets forDocument:document]) {
+        return NO;
+    }
+    match->first = offsets[0];
+    match->last = offsets[_queryLength - 1];
+    match->gaps = 0;
+    for (NSUInteger i = 1; i < _queryLength; i++) {
+        if (offsets[i] != offsets[i - 1] + 1) {
+            match->gaps++;
+        }
+    }
+    return YES;
+}
+
+#pragma mark - Bitsets
+
+// Fills in |offsets| with the offset in |document| of each character of the query for the same
+// window the posting list search would choose. The query and document must be short enough.
+- (BOOL)getOffsets:(NSInteger *)offsets forDocument:(NSString *)document {
+    const NSUInteger length = document.length;
+    unichar chars[iTermMinimumSubsequenceMatcherMaxDocumentLength];
+    [document getCharacters:chars range:NSMakeRange(0, length)];
+
+    const NSUInteger numberOfWords = (length + 63) / 64;
+    iTermMinimumSubsequenceMatcherBitset bitsets[iTermMinimumSubsequenceMatcherMaxQueryLength];
+    for (NSUInteger j = 0; j < _numberOfDistinctChars; j++) {
+        memset(bitsets[j].words, 0, numberOfWords * sizeof(uint64_t));
+    }
+    for (NSUInteger i = 0; i < length; i++) {
+        const unichar c = chars[i];
+        for (NSUInteger j = 0; j < _numberOfDistinctChars; j++) {
+            if (_distinctChars[j] == c) {
+                bitsets[j].words[i >> 6] |= 1ULL << (i & 63);
+                break;
+            }
+        }
+    }
+
+    // Try each occurrence of the first character as the start of a window, matching the rest of
+    // the query as early as possible.
+    NSInteger bestStart = -1;
+    NSInteger bestLength = 0;
+    const iTermMinimumSubsequenceMatcherBitset *firstBitset = &bitsets[_distinctIndexes[0]];
+    NSInteger start = -1;
+    while ((start = iTermMinimumSubsequenceMatcherNext(firstBitset, start, numberOfWords)) >= 0) {
+        NSInteger end = start;
+        for (NSUInteger i = 1; i < _queryLength && end >= 0; i++) {
+            end = iTermMinimumSubsequenceMatcherNext(&bitsets[_distinctIndexes[i]], end, numberOfWords);
+        }
+        if (end < 0) {
+            // Later starts can't match either.
+            break;
+        }
+        if (bestStart < 0 || end - start < bestLength) {
+            bestStart = start;
+            bestLength = end - start;
+        }
+        if ((NSUInteger)(end - start) == _queryLength) {
+            // -bestIndexes stops here too.
+            break;
+        }
+    }
+    if (bestStart < 0) {
+        return NO;
+    }
+
+    offsets[0] = bestStart;
+    for (NSUInteger i = 1; i < _queryLength; i++) {
+        offsets[i] = iTermMinimumSubsequenceMatcherNext(&bitsets[_distinctIndexes[i]], offsets[i - 1], numberOfWords);
+    }
+    return YES;
+}
+
+#pragma mark - Posting Lists
+
+- (NSIndexSet *)postingListIndexSetForDocument:(NSString *)document {
     [_postingLists release];
     _postingLists = [[self postingListsForDocument:document] retain];
     if (!_postingLists.count) {
@@ -60,6 +60,10 @@ extern NSString *const iTermMultiServerRestorationKeyChildPID;
 
 + (BOOL)getGeneralConnection:(iTermGeneralServerConnection *)generalConnection
    fromRestorationIdentifier:(NSDictionary *)dict;
+
+// Connects to (or launches) the server ahead of a batch of launches so the first one doesn't wait
+// for it.
++ (void)prepareToLaunchJobs;
 @end
 
 NS_ASSUME_NONNULL_END
@@ -61,6 +61,17 @@ static const int iTermMultiServerMaximumSupportedRestorationIdentifierVersion =
     return [iTermAdvancedSettingsModel multiserver] && [iTermMultiServerConnection available];
 }
 
++ (void)prepareToLaunchJobs {
+    if (![self available]) {
+        return;
+    }
+    DLog(@"Prepare to launch jobs");
+    [iTermMultiServerConnection getOrCreatePrimaryConnectionWithCallback:
+     [[iTermThread main] newCallbackWithBlock:^(id state, iTermMultiServerConnection *conn) {
+        DLog(@"Primary connection is %@", conn);
+    }]];
+}
+
 + (BOOL)getGeneralConnection:(iTermGeneralServerConnection *)generalConnection
    fromRestorationIdentifier:(NSDictionary *)dict {
     NSString *type = dict[iTermMultiServerRestorationKeyType];
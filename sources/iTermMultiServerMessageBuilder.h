@@ -16,6 +16,10 @@ NS_ASSUME_NONNULL_BEGIN
 @property (nonatomic, readonly) NSInteger length;
 
 - (void)appendBytes:(void *)bytes length:(NSInteger)length;
+
+// Receives up to `length` bytes (and possibly a file descriptor) straight into the accumulated
+// message, avoiding an intermediate buffer. Returns the result of recvmsg.
+- (ssize_t)receiveFromFileDescriptor:(int)fd length:(NSInteger)length;
 - (void)setFileDescriptor:(int)fileDescriptor;
 @end
 
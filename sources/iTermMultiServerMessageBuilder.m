@@ -8,6 +8,7 @@
 #import "iTermMultiServerMessageBuilder.h"
 
 #import "DebugLogging.h"
+#import "iTermMultiServerProtocol.h"
 
 @implementation iTermMultiServerMessageBuilder {
     NSMutableData *_accumulator;
@@ -35,6 +36,22 @@
                        length:length];
 }
 
+- (ssize_t)receiveFromFileDescriptor:(int)fd length:(NSInteger)length {
+    const NSUInteger offset = _accumulator.length;
+    _accumulator.length = offset + length;
+    int receivedFileDescriptor = -1;
+    const ssize_t bytesRead = iTermMultiServerReceiveIntoBuffer(fd,
+                                                                _accumulator.mutableBytes + offset,
+                                                                length,
+                                                                &receivedFileDescriptor);
+    _accumulator.length = offset + MAX(0, bytesRead);
+    if (receivedFileDescriptor >= 0) {
+        DLog(@"Got a file descriptor in message");
+        [self setFileDescriptor:receivedFileDescriptor];
+    }
+    return bytesRead;
+}
+
 - (void)setFileDescriptor:(int)fileDescriptor {
     _fileDescriptor = @(fileDescriptor);
 }
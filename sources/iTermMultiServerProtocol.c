@@ -663,6 +663,22 @@ ssize_t iTermMultiServerReadMessage(int fd, iTermClientServerProtocolMessage *me
     return recvStatus;
 }
 
+ssize_t iTermMultiServerReceiveIntoBuffer(int fd, void *buffer, size_t length, int *receivedFileDescriptorPtr) {
+    assert(length > 0);
+    iTermClientServerProtocolMessage message;
+    iTermClientServerProtocolMessageInitializeWithBuffer(&message, buffer, length);
+    *receivedFileDescriptorPtr = -1;
+    const ssize_t recvStatus = RecvMsg(fd, &message);
+    if (recvStatus < 0) {
+        return recvStatus;
+    }
+    int receivedFileDescriptor;
+    if (iTermMultiServerProtocolGetFileDescriptor(&message, &receivedFileDescriptor) == 0) {
+        *receivedFileDescriptorPtr = receivedFileDescriptor;
+    }
+    return recvStatus;
+}
+
 int iTermMultiServerRead(int fd, iTermClientServerProtocolMessage *message) {
     iTermClientServerProtocolMessageInitialize(message);
 
@@ -264,6 +264,13 @@ void iTermMultiServerServerOriginatedMessageFree(iTermMultiServerServerOriginate
 ssize_t __attribute__((warn_unused_result))
 iTermMultiServerReadMessage(int fd, iTermClientServerProtocolMessage *message, ssize_t bufferSize);
 
+// Receives up to `length` bytes directly into `buffer` with a single recvmsg. Returns -1 on error
+// or the number of bytes received. If a file descriptor came with the bytes, it is stored in
+// *receivedFileDescriptorPtr, which you then own; otherwise that is set to -1.
+// NOTE: As with iTermMultiServerReadMessage, 0 is not EOF if a file descriptor was received.
+ssize_t __attribute__((warn_unused_result))
+iTermMultiServerReceiveIntoBuffer(int fd, void *buffer, size_t length, int *receivedFileDescriptorPtr);
+
 // Reads text from a file descriptor.
 int __attribute__((warn_unused_result))
 iTermMultiServerRead(int fd, iTermClientServerProtocolMessage *message);
@@ -8,6 +8,8 @@
 #import "iTermNetworkUtilization.h"
 
 #import "iTermPublisher.h"
+#import "iTermSystemMetricsSampler.h"
+#import "iTermTuple.h"
 
 #include <sys/sysctl.h>
 #include <netinet/in.h>
@@ -42,7 +44,7 @@ typedef struct {
 
 @end
 
-@interface iTermNetworkUtilization()<iTermPublisherDelegate>
+@interface iTermNetworkUtilization()<iTermPublisherDelegate, iTermSystemMetric>
 @end
 
 typedef struct {
@@ -95,8 +97,11 @@ typedef struct {
 #pragma mark - Private
 
 - (void)update {
+    [self publishStatsAndInterfaces:[self currentStatsAndInterfaces]];
+}
+
+- (void)publishStatsAndInterfaces:(iTermNetworkUtilizationStatsAndInterfaces)current {
     iTermNetworkUtilizationStatsAndInterfaces last = _last;
-    iTermNetworkUtilizationStatsAndInterfaces current = [self currentStatsAndInterfaces];
     if (!current.interfaces) {
         return;
     }
@@ -165,6 +170,10 @@ typedef struct {
 #pragma mark - iTermPublisherDelegate
 
 - (void)publisherDidChangeNumberOfSubscribers:(iTermPublisher *)publisher {
+    if ([iTermSystemMetricsSampler enabled]) {
+        [[iTermSystemMetricsSampler sharedInstance] setMetric:self active:_publisher.hasAnySubscribers];
+        return;
+    }
     if (!_publisher.hasAnySubscribers) {
         [_timer invalidate];
         _timer = nil;
@@ -177,4 +186,24 @@ typedef struct {
     }
 }
 
+#pragma mark - iTermSystemMetric
+
+- (id)systemMetricTakeSample {
+    const iTermNetworkUtilizationStatsAndInterfaces current = [self currentStatsAndInterfaces];
+    if (!current.interfaces) {
+        return nil;
+    }
+    const iTermNetworkUtilizationStats stats = current.stats;
+    return [iTermTuple tupleWithObject:[NSValue valueWithBytes:&stats objCType:@encode(iTermNetworkUtilizationStats)]
+                             andObject:current.interfaces];
+}
+
+- (void)systemMetricDidTakeSample:(id)sample {
+    iTermTuple<NSValue *, NSSet<NSData *> *> *tuple = sample;
+    iTermNetworkUtilizationStatsAndInterfaces current = { .stats = { 0, 0 }, .interfaces = nil };
+    [tuple.firstObject getValue:&current.stats];
+    current.interfaces = tuple.secondObject;
+    [self publishStatsAndInterfaces:current];
+}
+
 @end
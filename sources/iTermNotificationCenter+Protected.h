@@ -8,6 +8,12 @@
 #import "iTermNotificationCenter.h"
 
 @interface iTermBaseNotification()
-- (instancetype)initPrivate NS_DESIGNATED_INITIALIZER;
+- (instancetype)initPrivate;
+- (instancetype)initPrivateWithSubject:(id _Nullable)subject NS_DESIGNATED_INITIALIZER;
 + (void)internalSubscribe:(NSObject *)owner withBlock:(void (^)(id notification))block;
++ (void)internalSubscribe:(NSObject *)owner subject:(id)subject withBlock:(void (^)(id notification))block;
+
+// Returns a notification that stands for the receiver followed by |later|, or nil if both must be
+// delivered. The default merges only equal notifications.
+- (nullable instancetype)notificationByMergingNotification:(iTermBaseNotification *)later;
 @end
@@ -10,9 +10,22 @@
 NS_ASSUME_NONNULL_BEGIN
 
 @interface iTermBaseNotification : NSObject
+
+// The object this notification is about, if any. Subscribers scoped to it are the only scoped
+// subscribers that receive it. Unscoped subscribers receive every notification.
+@property (nonatomic, weak, readonly, nullable) id subject;
+
 + (void)subscribe:(NSObject *)owner selector:(SEL)selector;
+// Receives only notifications whose subject is |subject|. An owner may subscribe to many subjects.
++ (void)subscribe:(NSObject *)owner subject:(id)subject selector:(SEL)selector;
 - (nullable instancetype)init NS_UNAVAILABLE;
 - (void)post;
+
+// Call on the main thread. Delivers the notification at the end of the current pass through the
+// run loop. Until then, it may be merged into an earlier pending notification of the same class
+// and subject (see -notificationByMergingNotification:). Posts immediately unless the
+// coalesceInternalNotifications advanced setting is on.
+- (void)postCoalesced;
 @end
 
 NS_ASSUME_NONNULL_END
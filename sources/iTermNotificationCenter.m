@@ -9,11 +9,17 @@
 #import "iTermNotificationCenter+Protected.h"
 
 #import "DebugLogging.h"
+#import "iTermAdvancedSettingsModel.h"
 #import "NSNull+iTerm.h"
 #import "NSObject+iTerm.h"
 
 static NSString *const iTermInternalNotification = @"iTermInternalNotification";
+static NSString *const iTermInternalScopedNotification = @"iTermInternalScopedNotification";
 static const char iTermNotificationTokenAssociatedObject;
+static const char iTermNotificationScopedTokensAssociatedObject;
+
+// Notifications waiting for postCoalesced to deliver them. Main thread only.
+static NSMutableArray<iTermBaseNotification *> *gPendingNotifications;
 
 @interface iTermNotificationCenterObserverUnregisterer : NSObject
 - (instancetype)initWithToken:(id)token NS_DESIGNATED_INITIALIZER;
@@ -43,7 +49,21 @@ static const char iTermNotificationTokenAssociatedObject;
 @implementation iTermBaseNotification
 
 - (instancetype)initPrivate {
-    return [super init];
+    return [self initPrivateWithSubject:nil];
+}
+
+- (instancetype)initPrivateWithSubject:(id)subject {
+    self = [super init];
+    if (self) {
+        _subject = subject;
+    }
+    return self;
+}
+
+// Scoped notifications are posted with the subject as the NSNotification's object so that
+// NSNotificationCenter only hands them to the subject's subscribers.
++ (NSString *)scopedNotificationName {
+    return [iTermInternalScopedNotification stringByAppendingString:NSStringFromClass(self)];
 }
 
 + (void)subscribe:(NSObject *)owner selector:(SEL)selector {
@@ -53,35 +73,116 @@ static const char iTermNotificationTokenAssociatedObject;
     }];
 }
 
++ (void)subscribe:(NSObject *)owner subject:(id)subject selector:(SEL)selector {
+    __weak NSObject *weakOwner = owner;
+    [self internalSubscribe:owner subject:subject withBlock:^(id notification) {
+        [weakOwner it_performNonObjectReturningSelector:selector withObject:notification];
+    }];
+}
+
 + (void)internalSubscribe:(NSObject *)owner withBlock:(void (^)(id notification))block {
+    id token = [self addObserverWithName:iTermInternalNotification
+                                  object:[self class]
+                                   owner:owner
+                                   block:block];
+    [owner it_setAssociatedObject:[[iTermNotificationCenterObserverUnregisterer alloc] initWithToken:token]
+                           forKey:(void *)&iTermNotificationTokenAssociatedObject];
+}
+
++ (void)internalSubscribe:(NSObject *)owner subject:(id)subject withBlock:(void (^)(id notification))block {
+    id token = [self addObserverWithName:[self scopedNotificationName]
+                                  object:subject
+                                   owner:owner
+                                   block:block];
+    NSMutableArray<iTermNotificationCenterObserverUnregisterer *> *unregisterers =
+        [owner it_associatedObjectForKey:(void *)&iTermNotificationScopedTokensAssociatedObject];
+    if (!unregisterers) {
+        unregisterers = [NSMutableArray array];
+        [owner it_setAssociatedObject:unregisterers
+                               forKey:(void *)&iTermNotificationScopedTokensAssociatedObject];
+    }
+    [unregisterers addObject:[[iTermNotificationCenterObserverUnregisterer alloc] initWithToken:token]];
+}
+
++ (id)addObserverWithName:(NSString *)name
+                   object:(id)sender
+                    owner:(NSObject *)owner
+                    block:(void (^)(id notification))block {
     __weak NSObject *weakOwner = owner;
     // This prevents infinite recursion if you cause the notification to be sent while handling it.
     __block BOOL handling = NO;
-    id token = [[NSNotificationCenter defaultCenter] addObserverForName:iTermInternalNotification
-                                                                 object:[self class]
-                                                                  queue:nil
-                                                             usingBlock:^(NSNotification * _Nonnull notification) {
-                                                                 id strongOwner = weakOwner;
-                                                                 if (strongOwner) {
-                                                                     if (handling) {
-                                                                         return;
-                                                                     }
-                                                                     id object = notification.userInfo[@"object"];
-                                                                     assert(object);
-
-                                                                     handling = YES;
-                                                                     block(object);
-                                                                     handling = NO;
+    return [[NSNotificationCenter defaultCenter] addObserverForName:name
+                                                             object:sender
+                                                              queue:nil
+                                                         usingBlock:^(NSNotification * _Nonnull notification) {
+                                                             id strongOwner = weakOwner;
+                                                             if (strongOwner) {
+                                                                 if (handling) {
+                                                                     return;
                                                                  }
-                                                             }];
-    [owner it_setAssociatedObject:[[iTermNotificationCenterObserverUnregisterer alloc] initWithToken:token]
-                           forKey:(void *)&iTermNotificationTokenAssociatedObject];
+                                                                 id object = notification.userInfo[@"object"];
+                                                                 assert(object);
+
+                                                                 handling = YES;
+                                                                 block(object);
+                                                                 handling = NO;
+                                                             }
+                                                         }];
 }
 
 - (void)post {
     [[NSNotificationCenter defaultCenter] postNotificationName:iTermInternalNotification
                                                         object:[self class]
                                                       userInfo:@{ @"object": self }];
+    id subject = self.subject;
+    if (subject) {
+        [[NSNotificationCenter defaultCenter] postNotificationName:[[self class] scopedNotificationName]
+                                                            object:subject
+                                                          userInfo:@{ @"object": self }];
+    }
+}
+
+- (void)postCoalesced {
+    if (![iTermAdvancedSettingsModel coalesceInternalNotifications]) {
+        [self post];
+        return;
+    }
+    assert([NSThread isMainThread]);
+    if (!gPendingNotifications) {
+        gPendingNotifications = [NSMutableArray array];
+    }
+    if (gPendingNotifications.count == 0) {
+        dispatch_async(dispatch_get_main_queue(), ^{
+            [iTermBaseNotification postPendingNotifications];
+        });
+    }
+    // Only the newest pending notification of the same class and subject may absorb this one so
+    // that subscribers still see each kind of notification in the order it was posted.
+    for (NSInteger i = gPendingNotifications.count - 1; i >= 0; i--) {
+        iTermBaseNotification *earlier = gPendingNotifications[i];
+        if ([earlier class] != [self class] || earlier.subject != self.subject) {
+            continue;
+        }
+        iTermBaseNotification *merged = [earlier notificationByMergingNotification:self];
+        if (merged) {
+            gPendingNotifications[i] = merged;
+            return;
+        }
+        break;
+    }
+    [gPendingNotifications addObject:self];
+}
+
++ (void)postPendingNotifications {
+    NSArray<iTermBaseNotification *> *pending = [gPendingNotifications copy];
+    [gPendingNotifications removeAllObjects];
+    for (iTermBaseNotification *notification in pending) {
+        [notification post];
+    }
+}
+
+- (nullable instancetype)notificationByMergingNotification:(iTermBaseNotification *)later {
+    return [self isEqual:later] ? self : nil;
 }
 
 @end
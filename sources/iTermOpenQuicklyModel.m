@@ -1,6 +1,7 @@
 #import "iTermOpenQuicklyModel.h"
 
 #import "iTermActionsModel.h"
+#import "iTermAdvancedSettingsModel.h"
 #import "iTermApplication.h"
 #import "iTermApplicationDelegate.h"
 #import "iTermColorPresets.h"
@@ -22,6 +23,7 @@
 #import "NSStringITerm.h"
 #import "PseudoTerminal.h"
 #import "PTYSession+Scripting.h"
+#import "ProfileModel.h"
 #import "VT100RemoteHost.h"
 #import "WindowArrangements.h"
 
@@ -55,7 +57,40 @@ static const double kProfileNameMultiplierForColorPresetItem = 0.095;
 // Multipliers for script items. Ranks below profiles.
 static const double kProfileNameMultiplierForScriptItem = 0.09;
 
-@implementation iTermOpenQuicklyModel
+@implementation iTermOpenQuicklyModel {
+    // The query last passed to -updateWithQuery:. When the next one adds to the end of its text,
+    // candidates it rejected can't match and are skipped without scoring.
+    Class _lastCommandClass;
+    NSString *_lastQueryText;
+    BOOL _lastHaveCurrentWindow;
+    NSSet<NSString *> *_previousRejects;
+    // Candidates rejected by the query being evaluated. Nil when narrowing is off.
+    NSMutableSet<NSString *> *_rejects;
+    BOOL _narrowing;
+}
+
+- (instancetype)init {
+    self = [super init];
+    if (self) {
+        // Rejections are only valid while candidates' names stay the same.
+        NSNotificationCenter *center = [NSNotificationCenter defaultCenter];
+        for (NSString *name in @[ kReloadAddressBookNotification,
+                                  kRebuildColorPresetsMenuNotification,
+                                  kSavedArrangementDidChangeNotification ]) {
+            [center addObserver:self
+                       selector:@selector(candidatesDidChange:)
+                           name:name
+                         object:nil];
+        }
+        [iTermActionsDidChangeNotification subscribe:self selector:@selector(candidatesDidChange:)];
+        [iTermSnippetsDidChangeNotification subscribe:self selector:@selector(candidatesDidChange:)];
+    }
+    return self;
+}
+
+- (void)dealloc {
+    [[NSNotificationCenter defaultCenter] removeObserver:self];
+}
 
 #pragma mark - Commands
 
@@ -112,6 +147,31 @@ static const double kProfileNameMultiplierForScriptItem = 0.09;
     return sessions;
 }
 
+#pragma mark - Narrowing
+
+- (void)candidatesDidChange:(id)notification {
+    [self forgetLastQuery];
+}
+
+- (void)forgetLastQuery {
+    _lastCommandClass = nil;
+    _lastQueryText = nil;
+    _previousRejects = nil;
+}
+
+static NSString *iTermOpenQuicklyCandidateKey(Class itemClass, NSString *identifier) {
+    return [NSString stringWithFormat:@"%@/%@", NSStringFromClass(itemClass), identifier];
+}
+
+// Returns YES if the candidate can be skipped because it failed to match a prefix of the query.
+- (BOOL)shouldSkipCandidateWithKey:(NSString *)key {
+    return _narrowing && [_previousRejects containsObject:key];
+}
+
+- (void)rejectCandidateWithKey:(NSString *)key {
+    [_rejects addObject:key];
+}
+
 #pragma mark - Add Items
 
 - (void)addTipsToItems:(NSMutableArray<iTermOpenQuicklyItem *> *)items {
@@ -205,6 +265,10 @@ static const double kProfileNameMultiplierForScriptItem = 0.09;
     NSString *(^detailFunction)(PTYSession *) = [self detailFunctionForSessions:self.sessions];
 
     for (PTYSession *session in self.sessions) {
+        NSString *key = iTermOpenQuicklyCandidateKey([iTermOpenQuicklySessionItem class], session.guid);
+        if ([self shouldSkipCandidateWithKey:key]) {
+            continue;
+        }
         NSMutableArray *features = [NSMutableArray array];
         iTermOpenQuicklySessionItem *item = [[iTermOpenQuicklySessionItem alloc] init];
         item.logoGenerator.textColor = session.foregroundColor;
@@ -232,6 +296,8 @@ static const double kProfileNameMultiplierForScriptItem = 0.09;
                 item.detail = [self.delegate openQuicklyModelAttributedStringForDetail:detailFunction(session)];
             }
             [items addObject:item];
+        } else {
+            [self rejectCandidateWithKey:key];
         }
     }
 }
@@ -240,6 +306,10 @@ static const double kProfileNameMultiplierForScriptItem = 0.09;
                    withMatcher:(iTermMinimumSubsequenceMatcher *)matcher
              haveCurrentWindow:(BOOL)haveCurrentWindow {
     for (Profile *profile in [[ProfileModel sharedInstance] bookmarks]) {
+        NSString *key = iTermOpenQuicklyCandidateKey([iTermOpenQuicklyProfileItem class], profile[KEY_GUID]);
+        if ([self shouldSkipCandidateWithKey:key]) {
+            continue;
+        }
         iTermOpenQuicklyProfileItem *newSessionWithProfileItem = [[iTermOpenQuicklyProfileItem alloc] init];
         NSMutableAttributedString *attributedName = [[NSMutableAttributedString alloc] init];
         newSessionWithProfileItem.score = [self scoreForProfile:profile matcher:matcher attributedName:attributedName];
@@ -256,6 +326,8 @@ static const double kProfileNameMultiplierForScriptItem = 0.09;
             newSessionWithProfileItem.title = attributedName;
             newSessionWithProfileItem.identifier = profile[KEY_GUID];
             [items addObject:newSessionWithProfileItem];
+        } else {
+            [self rejectCandidateWithKey:key];
         }
     }
 }
@@ -266,8 +338,12 @@ static const double kProfileNameMultiplierForScriptItem = 0.09;
     NSColor *defaultColor = [NSColor colorWithRed:0.5 green:0.5 blue:0.5 alpha:1];
     const BOOL dark = [[NSApp effectiveAppearance] it_isDark];
     for (NSString *name in allPresets) {
+        NSString *key = iTermOpenQuicklyCandidateKey([iTermOpenQuicklyColorPresetItem class], name);
+        if ([self shouldSkipCandidateWithKey:key]) {
+            continue;
+        }
         iTermColorPreset *preset = allPresets[name];
-        
+
         iTermOpenQuicklyColorPresetItem *item = [[iTermOpenQuicklyColorPresetItem alloc] init];
         item.presetName = name;
         item.logoGenerator.textColor = iTermColorPresetGet(preset, KEY_FOREGROUND_COLOR, dark) ?: [NSColor colorWithRed:0.75 green:0.75 blue:0.75 alpha:1];
@@ -285,6 +361,8 @@ static const double kProfileNameMultiplierForScriptItem = 0.09;
             item.title = attributedName;
             item.identifier = name;
             [items addObject:item];
+        } else {
+            [self rejectCandidateWithKey:key];
         }
     }
 }
@@ -292,6 +370,10 @@ static const double kProfileNameMultiplierForScriptItem = 0.09;
 - (void)addChangeProfileToItems:(NSMutableArray<iTermOpenQuicklyItem *> *)items
                     withMatcher:(iTermMinimumSubsequenceMatcher *)matcher {
     for (Profile *profile in [[ProfileModel sharedInstance] bookmarks]) {
+        NSString *key = iTermOpenQuicklyCandidateKey([iTermOpenQuicklyChangeProfileItem class], profile[KEY_GUID]);
+        if ([self shouldSkipCandidateWithKey:key]) {
+            continue;
+        }
         iTermOpenQuicklyChangeProfileItem *changeProfileItem = [[iTermOpenQuicklyChangeProfileItem alloc] init];
         NSMutableAttributedString *attributedName = [[NSMutableAttributedString alloc] init];
         changeProfileItem.score = [self scoreForProfile:profile matcher:matcher attributedName:attributedName];
@@ -302,6 +384,8 @@ static const double kProfileNameMultiplierForScriptItem = 0.09;
             changeProfileItem.title = attributedName;
             changeProfileItem.identifier = profile[KEY_GUID];
             [items addObject:changeProfileItem];
+        } else {
+            [self rejectCandidateWithKey:key];
         }
     }
 }
@@ -319,11 +403,16 @@ static const double kProfileNameMultiplierForScriptItem = 0.09;
 
 - (iTermOpenQuicklyActionItem *)actionItemForAction:(iTermAction *)action
                                             matcher:(iTermMinimumSubsequenceMatcher *)matcher {
+    NSString *key = iTermOpenQuicklyCandidateKey([iTermOpenQuicklyActionItem class], [@(action.identifier) stringValue]);
+    if ([self shouldSkipCandidateWithKey:key]) {
+        return nil;
+    }
     iTermOpenQuicklyActionItem *actionItem = [[iTermOpenQuicklyActionItem alloc] init];
     actionItem.action = action;
     NSMutableAttributedString *attributedName = [[NSMutableAttributedString alloc] init];
     actionItem.score = [self scoreForAction:action matcher:matcher attributedName:attributedName];
     if (actionItem.score <= 0) {
+        [self rejectCandidateWithKey:key];
         return nil;
     }
     actionItem.detail = [_delegate openQuicklyModelDisplayStringForFeatureNamed:nil
@@ -347,11 +436,16 @@ static const double kProfileNameMultiplierForScriptItem = 0.09;
 
 - (iTermOpenQuicklySnippetItem *)snippetItemForSnippet:(iTermSnippet *)snippet
                                                matcher:(iTermMinimumSubsequenceMatcher *)matcher {
+    NSString *key = iTermOpenQuicklyCandidateKey([iTermOpenQuicklySnippetItem class], snippet.guid);
+    if ([self shouldSkipCandidateWithKey:key]) {
+        return nil;
+    }
     iTermOpenQuicklySnippetItem *snippetItem = [[iTermOpenQuicklySnippetItem alloc] init];
     snippetItem.snippet = snippet;
     NSMutableAttributedString *attributedName = [[NSMutableAttributedString alloc] init];
     snippetItem.score = [self scoreForSnippet:snippet matcher:matcher attributedName:attributedName];
     if (snippetItem.score <= 0) {
+        [self rejectCandidateWithKey:key];
         return nil;
     }
     snippetItem.detail = [_delegate openQuicklyModelDisplayStringForFeatureNamed:nil
@@ -366,6 +460,11 @@ static const double kProfileNameMultiplierForScriptItem = 0.09;
 - (iTermOpenQuicklyArrangementItem *)arrangementItemWithName:(NSString *)arrangementName
                                                      matcher:(iTermMinimumSubsequenceMatcher *)matcher
                                                       inTabs:(BOOL)inTabs {
+    NSString *key = iTermOpenQuicklyCandidateKey([iTermOpenQuicklyArrangementItem class],
+                                                 [NSString stringWithFormat:@"%@/%@", inTabs ? @"tabs" : @"windows", arrangementName]);
+    if ([self shouldSkipCandidateWithKey:key]) {
+        return nil;
+    }
     iTermOpenQuicklyArrangementItem *item = [[iTermOpenQuicklyArrangementItem alloc] init];
     NSMutableAttributedString *attributedName = [[NSMutableAttributedString alloc] init];
     item.score = [self scoreForArrangementWithName:arrangementName
@@ -380,12 +479,17 @@ static const double kProfileNameMultiplierForScriptItem = 0.09;
         item.identifier = arrangementName;
         return item;
     } else {
+        [self rejectCandidateWithKey:key];
         return nil;
     }
 }
 
 - (iTermOpenQuicklyScriptItem *)scriptItemWithName:(NSString *)scriptName
                                            matcher:(iTermMinimumSubsequenceMatcher *)matcher {
+    NSString *key = iTermOpenQuicklyCandidateKey([iTermOpenQuicklyScriptItem class], scriptName);
+    if ([self shouldSkipCandidateWithKey:key]) {
+        return nil;
+    }
     iTermOpenQuicklyScriptItem *item = [[iTermOpenQuicklyScriptItem alloc] init];
     NSMutableAttributedString *attributedName = [[NSMutableAttributedString alloc] init];
     item.score = [self scoreForScriptWithName:scriptName
@@ -399,6 +503,7 @@ static const double kProfileNameMultiplierForScriptItem = 0.09;
         item.identifier = scriptName;
         return item;
     } else {
+        [self rejectCandidateWithKey:key];
         return nil;
     }
 }
@@ -434,6 +539,7 @@ static const double kProfileNameMultiplierForScriptItem = 0.09;
 
 - (void)removeAllItems {
     [_items removeAllObjects];
+    [self forgetLastQuery];
 }
 
 - (void)updateWithQuery:(NSString *)queryString {
@@ -443,6 +549,20 @@ static const double kProfileNameMultiplierForScriptItem = 0.09;
         [[iTermMinimumSubsequenceMatcher alloc] initWithQuery:command.text];
 
     NSMutableArray *items = [NSMutableArray array];
+    BOOL haveCurrentWindow = [[iTermController sharedInstance] currentTerminal] != nil;
+
+    // Anything that failed to match a query can't match a longer one, so when the user keeps
+    // typing only the candidates that matched last time need to be scored again.
+    _narrowing = (_lastQueryText != nil &&
+                  [command class] == _lastCommandClass &&
+                  haveCurrentWindow == _lastHaveCurrentWindow &&
+                  [command.text hasPrefix:_lastQueryText]);
+    if ([iTermAdvancedSettingsModel narrowOpenQuicklyResults]) {
+        _rejects = _narrowing ? [_previousRejects mutableCopy] : [NSMutableSet set];
+    } else {
+        _narrowing = NO;
+        _rejects = nil;
+    }
 
     if ([queryString isEqualToString:@"/"]) {
         [self addTipsToItems:items];
@@ -452,7 +572,6 @@ static const double kProfileNameMultiplierForScriptItem = 0.09;
         [self addSessionLocationToItems:items withMatcher:matcher];
     }
 
-    BOOL haveCurrentWindow = [[iTermController sharedInstance] currentTerminal] != nil;
     if ([command supportsCreateNewTab]) {
         [self addCreateNewTabToItems:items withMatcher:matcher haveCurrentWindow:haveCurrentWindow];
     }
@@ -477,6 +596,15 @@ static const double kProfileNameMultiplierForScriptItem = 0.09;
         [self addSnippetsToItems:items withMatcher:matcher];
     }
 
+    if (_rejects) {
+        _lastCommandClass = [command class];
+        _lastQueryText = [command.text copy];
+        _lastHaveCurrentWindow = haveCurrentWindow;
+        _previousRejects = _rejects;
+        _rejects = nil;
+    }
+    _narrowing = NO;
+
     // Sort from highest to lowest score.
     [items sortUsingComparator:^NSComparisonResult(iTermOpenQuicklyItem *obj1,
                                                    iTermOpenQuicklyItem *obj2) {
@@ -778,11 +906,18 @@ static const double kProfileNameMultiplierForScriptItem = 0.09;
     NSIndexSet *bestIndexSet = nil;
     int n = documents.count;
     NSMutableIndexSet *indexSet = [NSMutableIndexSet indexSet];
+    // When set, the highlighted indexes are found only for the best document.
+    const BOOL deferIndexSet = [iTermAdvancedSettingsModel bitParallelSubsequenceMatching];
     for (NSString *document in documents) {
-        [indexSet removeAllIndexes];
-        double value = [self qualityOfMatchWithMatcher:matcher
-                                              document:[document lowercaseString]
-                                              indexSet:indexSet];
+        double value;
+        if (deferIndexSet) {
+            value = [self qualityOfMatchWithMatcher:matcher document:[document lowercaseString]];
+        } else {
+            [indexSet removeAllIndexes];
+            value = [self qualityOfMatchWithMatcher:matcher
+                                           document:[document lowercaseString]
+                                           indexSet:indexSet];
+        }
 
         // Discount older documents (which appear at the beginning of the list)
         value /= n;
@@ -791,7 +926,7 @@ static const double kProfileNameMultiplierForScriptItem = 0.09;
         if (value > highestValue) {
             highestValue = value;
             bestFeature = document;
-            bestIndexSet = [indexSet copy];
+            bestIndexSet = deferIndexSet ? nil : [indexSet copy];
         }
         score += value * multiplier;
         if (score > limit) {
@@ -800,6 +935,9 @@ static const double kProfileNameMultiplierForScriptItem = 0.09;
     }
 
     if (bestFeature && features) {
+        if (!bestIndexSet) {
+            bestIndexSet = [matcher indexSetForDocument:[bestFeature lowercaseString]];
+        }
         id displayString = [_delegate openQuicklyModelDisplayStringForFeatureNamed:name
                                                                              value:bestFeature
                                                                 highlightedIndexes:bestIndexSet];
@@ -824,21 +962,39 @@ static const double kProfileNameMultiplierForScriptItem = 0.09;
                            indexSet:(NSMutableIndexSet *)indexSet {
     [indexSet addIndexes:[matcher indexSetForDocument:documentString]];
 
-    double score;
     if (!indexSet.count) {
         // No match
-        score = 0;
-    } else if (indexSet.firstIndex == 0 && indexSet.lastIndex == documentString.length - 1) {
+        return 0;
+    }
+    const iTermSubsequenceMatch match = {
+        .first = indexSet.firstIndex,
+        .last = indexSet.lastIndex,
+        .gaps = [self numberOfGapsInIndexSet:indexSet]
+    };
+    return [self qualityOfMatch:match document:documentString];
+}
+
+// Like -qualityOfMatchWithMatcher:document:indexSet: but doesn't build an index set.
+- (double)qualityOfMatchWithMatcher:(iTermMinimumSubsequenceMatcher *)matcher
+                           document:(NSString *)documentString {
+    iTermSubsequenceMatch match;
+    if (![matcher getMatch:&match forDocument:documentString]) {
+        // No match
+        return 0;
+    }
+    return [self qualityOfMatch:match document:documentString];
+}
+
+- (double)qualityOfMatch:(iTermSubsequenceMatch)match document:(NSString *)documentString {
+    if (match.first == 0 && match.last == documentString.length - 1) {
         // Exact equality
-        score = 1;
-    } else if (indexSet.firstIndex == 0) {
+        return 1;
+    } else if (match.first == 0) {
         // Is a prefix
-        score = 0.9;
+        return 0.9;
     } else {
-        score = 0.5 / ([self numberOfGapsInIndexSet:indexSet] + 1);
+        return 0.5 / (match.gaps + 1);
     }
-
-    return score;
 }
 
 - (NSInteger)numberOfGapsInIndexSet:(NSIndexSet *)indexSet {
@@ -49,6 +49,11 @@ extern const NSInteger iTermQuickPasteBytesPerCallDefaultValue;
 
 - (iTermVariableScope *)pasteHelperScope;
 
+@optional
+// Returns NO if pasted input is arriving faster than some destination can accept it. In that case
+// the delegate must call -destinationDidDrain when there's room again.
+- (BOOL)pasteHelperDestinationsHaveRoom;
+
 @end
 
 @interface iTermPasteHelper : NSObject
@@ -104,6 +109,13 @@ extern const NSInteger iTermQuickPasteBytesPerCallDefaultValue;
 // allows one more line to be pasted.
 - (void)unblock;
 
+// Call this when a destination that was out of room can accept input again.
+- (void)destinationDidDrain;
+
+// Call this with the length of output read from the session. Adaptive pastes use it to measure
+// how quickly input is echoed.
+- (void)didReceiveOutputOfLength:(NSInteger)length;
+
 - (void)showAdvancedPasteWithFlags:(PTYSessionPasteFlags)flags;
 - (void)temporaryRightStatusBarComponentDidBecomeAvailable;
 
@@ -11,6 +11,7 @@
 #import "iTermApplicationDelegate.h"
 #import "iTermNumberOfSpacesAccessoryViewController.h"
 #import "iTermPasteHelper.h"
+#import "iTermPasteRateController.h"
 #import "iTermPasteSpecialViewController.h"
 #import "iTermPasteSpecialWindowController.h"
 #import "iTermPasteViewManager.h"
@@ -31,6 +32,10 @@ const int kNumberOfSpacesPerTabOpenAdvancedPaste = -3;
 // Was 1024, but this seemed to cause a lot of problems. Let's try this.
 const NSInteger iTermQuickPasteBytesPerCallDefaultValue = 768;
 
+// Bracketed pastes aren't interpreted until the closing bracket arrives, so they can go in large
+// chunks without waiting between them.
+static const NSInteger iTermBulkPasteBytesPerCall = 64 * 1024;
+
 @interface iTermPasteHelper () <iTermPasteViewManagerDelegate>
 @end
 
@@ -42,6 +47,9 @@ const NSInteger iTermQuickPasteBytesPerCallDefaultValue = 768;
     NSMutableString *_buffer;
     NSTimer *_timer;
     iTermPasteViewManager *_pasteViewManager;
+
+    // Non-nil while an adaptive paste is in progress.
+    iTermPasteRateController *_rateController;
 }
 
 + (NSMutableCharacterSet *)unsafeControlCodeSet {
@@ -111,6 +119,7 @@ const NSInteger iTermQuickPasteBytesPerCallDefaultValue = 768;
     _buffer = [[NSMutableString alloc] init];
     [self hidePasteIndicator];
     _pasteContext = nil;
+    _rateController = nil;
     if (!cancel) {
         [self dequeueEvents];
     }
@@ -440,12 +449,12 @@ const NSInteger iTermQuickPasteBytesPerCallDefaultValue = 768;
     [_pasteViewManager setRemainingLength:_buffer.length];
 }
 
-- (void)pasteNextChunkAndScheduleTimer {
-    DLog(@"pasteNextChunkAndScheduleTimer");
+// Returns YES if pasting should block until the next prompt.
+- (BOOL)pasteNextChunk {
     BOOL block = NO;
     NSRange range;
     range.location = 0;
-    range.length = MIN(_pasteContext.bytesPerCall, [_buffer length]);
+    range.length = MIN([self bytesPerCall], [_buffer length]);
     if (range.length > 0) {
         if (_pasteContext.blockAtNewline) {
             // If there is a newline in the range about to be pasted, only paste up to and including
@@ -461,16 +470,101 @@ const NSInteger iTermQuickPasteBytesPerCallDefaultValue = 768;
         }
         range = [_buffer makeRangeSafe:range];
         [_delegate pasteHelperWriteString:[_buffer substringWithRange:range]];
+        [_rateController didWriteBytes:range.length];
         _pasteContext.bytesWritten = _pasteContext.bytesWritten + range.length;
         if (_pasteContext.progress) {
             _pasteContext.progress(_pasteContext.bytesWritten);
         }
     }
     [_buffer replaceCharactersInRange:range withString:@""];
+    return block;
+}
+
+// Pipelined pastes write chunks for as long as the destinations have room instead of waiting
+// between them. Slow pastes, uploads, and pastes that wait for a prompt keep their pacing.
+- (BOOL)shouldPipelineCurrentPaste {
+    if (![iTermAdvancedSettingsModel pipelineTaskWrites]) {
+        return NO;
+    }
+    if (![_delegate respondsToSelector:@selector(pasteHelperDestinationsHaveRoom)]) {
+        return NO;
+    }
+    if (_rateController) {
+        // It does its own pacing.
+        return NO;
+    }
+    return [self currentPasteIsQuick];
+}
+
+- (BOOL)currentPasteIsQuick {
+    return (!_pasteContext.pasteEvent.slow &&
+            !_pasteContext.isUpload &&
+            !_pasteContext.blockAtNewline);
+}
+
+// Bulk pastes are bracketed and get written as fast as the destinations accept them.
+- (BOOL)isBulkPaste {
+    return ([iTermAdvancedSettingsModel adaptivePasteThroughput] &&
+            (_pasteContext.pasteEvent.flags & kPasteFlagsBracket) &&
+            [self currentPasteIsQuick]);
+}
+
+- (BOOL)shouldAdaptRateOfCurrentPaste {
+    return ([iTermAdvancedSettingsModel adaptivePasteThroughput] &&
+            [self currentPasteIsQuick] &&
+            ![self isBulkPaste]);
+}
+
+- (NSInteger)bytesPerCall {
+    if ([self isBulkPaste]) {
+        return iTermBulkPasteBytesPerCall;
+    }
+    if (_rateController) {
+        return _rateController.bytesPerCall;
+    }
+    return _pasteContext.bytesPerCall;
+}
+
+- (NSTimeInterval)delayBetweenCalls {
+    if (_rateController) {
+        return _rateController.delayBetweenCalls;
+    }
+    return _pasteContext.delayBetweenCalls;
+}
+
+- (BOOL)destinationsHaveRoom {
+    if (![_delegate respondsToSelector:@selector(pasteHelperDestinationsHaveRoom)]) {
+        return YES;
+    }
+    return [_delegate pasteHelperDestinationsHaveRoom];
+}
+
+- (void)didReceiveOutputOfLength:(NSInteger)length {
+    [_rateController didReceiveBytes:length];
+}
+
+- (void)pasteNextChunkAndScheduleTimer {
+    DLog(@"pasteNextChunkAndScheduleTimer");
+    if (_rateController) {
+        const BOOL haveRoom = [self destinationsHaveRoom];
+        [_rateController updateWithDestinationsHaveRoom:haveRoom];
+        if (!haveRoom) {
+            // Resume on a drain notification or when the timer fires, whichever is first.
+            DLog(@"Destinations full. Wait %@", @(_rateController.delayBetweenCalls));
+            [self scheduleNextPasteForCurrentPasteContext];
+            return;
+        }
+    }
+    const BOOL block = [self pasteNextChunk];
+    if (!block && ([self shouldPipelineCurrentPaste] || [self isBulkPaste])) {
+        while ([_buffer length] > 0 && [self destinationsHaveRoom]) {
+            [self pasteNextChunk];
+        }
+    }
 
     [self updatePasteIndicator];
     if ([_buffer length] > 0) {
-        DLog(@"Schedule timer after %@", @(_pasteContext.delayBetweenCalls));
+        DLog(@"Schedule timer after %@", @([self delayBetweenCalls]));
         [_pasteContext updateValues];
         if (!block) {
             [self scheduleNextPasteForCurrentPasteContext];
@@ -483,13 +577,14 @@ const NSInteger iTermQuickPasteBytesPerCallDefaultValue = 768;
         _timer = nil;
         [self hidePasteIndicator];
         _pasteContext = nil;
+        _rateController = nil;
         [self dequeueEvents];
     }
 }
 
 - (void)scheduleNextPasteForCurrentPasteContext {
     [_timer invalidate];
-    _timer = [self scheduledTimerWithTimeInterval:_pasteContext.delayBetweenCalls
+    _timer = [self scheduledTimerWithTimeInterval:[self delayBetweenCalls]
                                            target:self
                                          selector:@selector(pasteNextChunkAndScheduleTimer)
                                          userInfo:nil
@@ -507,6 +602,17 @@ const NSInteger iTermQuickPasteBytesPerCallDefaultValue = 768;
     }
 }
 
+- (void)destinationDidDrain {
+    if (!_timer || !([self shouldPipelineCurrentPaste] || [self isBulkPaste] || _rateController)) {
+        return;
+    }
+    // The timer is only a fallback in case a drain notification is missed.
+    DLog(@"Destination drained. Resume pasting.");
+    [_timer invalidate];
+    _timer = nil;
+    [self pasteNextChunkAndScheduleTimer];
+}
+
 - (void)temporaryRightStatusBarComponentDidBecomeAvailable {
     [_pasteViewManager temporaryRightStatusBarComponentDidBecomeAvailable];
 }
@@ -515,6 +621,11 @@ const NSInteger iTermQuickPasteBytesPerCallDefaultValue = 768;
     [_buffer appendString:pasteEvent.string];
 
     _pasteContext = [[PasteContext alloc] initWithPasteEvent:pasteEvent];
+    _rateController = nil;
+    if ([self shouldAdaptRateOfCurrentPaste]) {
+        _rateController = [[iTermPasteRateController alloc] initWithBytesPerCall:_pasteContext.bytesPerCall
+                                                               delayBetweenCalls:_pasteContext.delayBetweenCalls];
+    }
     const int kPasteBytesPerSecond = 10000;  // This is a wild-ass guess.
     const NSTimeInterval sumOfDelays =
         _pasteContext.delayBetweenCalls * _buffer.length / _pasteContext.bytesPerCall;
@@ -0,0 +1,37 @@
+//
+//  iTermPasteHistoryBlobStore.h
+//  iTerm2SharedARC
+//
+//  Created by agent on 10/14/26.
+//
+
+#import <Foundation/Foundation.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+// Keeps strings as compressed files in a directory, named by the hash of their contents, so
+// identical strings are stored once. Writes happen on a background queue. Recently used strings
+// are kept in memory.
+@interface iTermPasteHistoryBlobStore : NSObject
+
+- (instancetype)initWithDirectory:(NSString *)directory NS_DESIGNATED_INITIALIZER;
+- (instancetype)init NS_UNAVAILABLE;
+
++ (NSString *)keyForString:(NSString *)string;
+
+// Saves string under its key (see +keyForString:).
+- (void)storeString:(NSString *)string key:(NSString *)key;
+
+// Returns nil if there is no such blob or it's unreadable.
+- (nullable NSString *)stringForKey:(NSString *)key;
+
+- (BOOL)hasStringForKey:(NSString *)key;
+
+// Deletes blobs whose keys are not in |keys|.
+- (void)removeBlobsExceptKeys:(NSSet<NSString *> *)keys;
+
+- (void)removeAllBlobs;
+
+@end
+
+NS_ASSUME_NONNULL_END
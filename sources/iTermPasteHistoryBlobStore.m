@@ -0,0 +1,171 @@
+//
+//  iTermPasteHistoryBlobStore.m
+//  iTerm2SharedARC
+//
+//  Created by agent on 10/14/26.
+//
+
+#import "iTermPasteHistoryBlobStore.h"
+
+#import "DebugLogging.h"
+#import "NSData+iTerm.h"
+
+#import <zlib.h>
+
+static const uint32_t iTermPasteHistoryBlobMagic = 'iPB1';
+
+typedef struct {
+    uint32_t magic;
+    uint32_t uncompressedSize;
+} iTermPasteHistoryBlobHeader;
+
+@implementation iTermPasteHistoryBlobStore {
+    NSString *_directory;
+    dispatch_queue_t _queue;
+    NSCache<NSString *, NSString *> *_cache;
+}
+
+- (instancetype)initWithDirectory:(NSString *)directory {
+    self = [super init];
+    if (self) {
+        _directory = [directory copy];
+        _queue = dispatch_queue_create("com.iterm2.paste-history-blobs", DISPATCH_QUEUE_SERIAL);
+        _cache = [[NSCache alloc] init];
+        _cache.totalCostLimit = 64 * 1024 * 1024;
+    }
+    return self;
+}
+
++ (NSString *)keyForString:(NSString *)string {
+    return [[[string dataUsingEncoding:NSUTF8StringEncoding] it_sha256] it_hexEncoded];
+}
+
+- (void)storeString:(NSString *)string key:(NSString *)key {
+    [_cache setObject:string forKey:key cost:string.length * sizeof(unichar)];
+    NSString *path = [self pathForKey:key];
+    NSString *directory = _directory;
+    dispatch_async(_queue, ^{
+        if ([[NSFileManager defaultManager] fileExistsAtPath:path]) {
+            // Same content, same name.
+            return;
+        }
+        NSData *data = [self compressedData:[string dataUsingEncoding:NSUTF8StringEncoding]];
+        if (!data) {
+            return;
+        }
+        [[NSFileManager defaultManager] createDirectoryAtPath:directory
+                                  withIntermediateDirectories:YES
+                                                   attributes:@{ NSFilePosixPermissions: @0700 }
+                                                        error:nil];
+        NSError *error = nil;
+        if (![data writeToFile:path options:NSDataWritingAtomic error:&error]) {
+            DLog(@"Failed to write paste history blob to %@: %@", path, error);
+            return;
+        }
+        [[NSFileManager defaultManager] setAttributes:@{ NSFilePosixPermissions: @0600 }
+                                         ofItemAtPath:path
+                                                error:nil];
+    });
+}
+
+- (NSString *)stringForKey:(NSString *)key {
+    NSString *string = [_cache objectForKey:key];
+    if (string) {
+        return string;
+    }
+    // Let pending writes finish first.
+    dispatch_sync(_queue, ^{});
+    NSData *data = [NSData dataWithContentsOfFile:[self pathForKey:key]
+                                          options:NSDataReadingMappedIfSafe
+                                            error:nil];
+    NSData *decompressed = data ? [self decompressedData:data] : nil;
+    if (!decompressed) {
+        DLog(@"Missing or invalid paste history blob %@", key);
+        return nil;
+    }
+    string = [[NSString alloc] initWithData:decompressed encoding:NSUTF8StringEncoding];
+    if (string) {
+        [_cache setObject:string forKey:key cost:string.length * sizeof(unichar)];
+    }
+    return string;
+}
+
+- (BOOL)hasStringForKey:(NSString *)key {
+    if ([_cache objectForKey:key]) {
+        return YES;
+    }
+    dispatch_sync(_queue, ^{});
+    return [[NSFileManager defaultManager] fileExistsAtPath:[self pathForKey:key]];
+}
+
+- (void)removeBlobsExceptKeys:(NSSet<NSString *> *)keys {
+    NSString *directory = _directory;
+    dispatch_async(_queue, ^{
+        NSFileManager *fileManager = [NSFileManager defaultManager];
+        for (NSString *name in [fileManager contentsOfDirectoryAtPath:directory error:nil]) {
+            if (![keys containsObject:name]) {
+                [fileManager removeItemAtPath:[directory stringByAppendingPathComponent:name] error:nil];
+            }
+        }
+    });
+}
+
+- (void)removeAllBlobs {
+    [_cache removeAllObjects];
+    NSString *directory = _directory;
+    dispatch_async(_queue, ^{
+        [[NSFileManager defaultManager] removeItemAtPath:directory error:nil];
+    });
+}
+
+#pragma mark - Private
+
+- (NSString *)pathForKey:(NSString *)key {
+    return [_directory stringByAppendingPathComponent:key];
+}
+
+- (NSData *)compressedData:(NSData *)data {
+    if (data.length > UINT32_MAX) {
+        return nil;
+    }
+    uLongf compressedSize = compressBound(data.length);
+    NSMutableData *result = [NSMutableData dataWithLength:sizeof(iTermPasteHistoryBlobHeader) + compressedSize];
+    iTermPasteHistoryBlobHeader *header = result.mutableBytes;
+    header->magic = iTermPasteHistoryBlobMagic;
+    header->uncompressedSize = (uint32_t)data.length;
+    const int status = compress2((Bytef *)(header + 1),
+                                 &compressedSize,
+                                 data.bytes,
+                                 data.length,
+                                 Z_BEST_SPEED);
+    if (status != Z_OK) {
+        DLog(@"compress2 failed with %@", @(status));
+        return nil;
+    }
+    result.length = sizeof(iTermPasteHistoryBlobHeader) + compressedSize;
+    return result;
+}
+
+- (NSData *)decompressedData:(NSData *)data {
+    if (data.length < sizeof(iTermPasteHistoryBlobHeader)) {
+        return nil;
+    }
+    iTermPasteHistoryBlobHeader header;
+    memcpy(&header, data.bytes, sizeof(header));
+    if (header.magic != iTermPasteHistoryBlobMagic) {
+        return nil;
+    }
+    NSMutableData *result = [NSMutableData dataWithLength:header.uncompressedSize];
+    uLongf size = header.uncompressedSize;
+    const int status = uncompress(result.mutableBytes,
+                                  &size,
+                                  (const Bytef *)data.bytes + sizeof(header),
+                                  data.length - sizeof(header));
+    if (status != Z_OK || size != header.uncompressedSize) {
+        DLog(@"uncompress failed with %@", @(status));
+        return nil;
+    }
+    return result;
+}
+
+@end
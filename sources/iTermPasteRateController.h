@@ -0,0 +1,35 @@
+//
+//  iTermPasteRateController.h
+//  iTerm2SharedARC
+//
+//  Created by agent on 10/14/26.
+//
+
+#import <Foundation/Foundation.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+// Sizes paste chunks based on how quickly the remote end keeps up. Chunks grow while input is
+// echoed back promptly and shrink when echo lags. When the pty write buffer fills up the delay
+// between chunks grows too, so slow links like serial consoles aren't overrun. It never goes faster
+// than its maximum or, unless there's backpressure, slower than the configured chunk size and delay.
+@interface iTermPasteRateController : NSObject
+
+@property (nonatomic, readonly) NSInteger bytesPerCall;
+@property (nonatomic, readonly) NSTimeInterval delayBetweenCalls;
+
+- (instancetype)initWithBytesPerCall:(NSInteger)bytesPerCall
+                   delayBetweenCalls:(NSTimeInterval)delay NS_DESIGNATED_INITIALIZER;
+- (instancetype)init NS_UNAVAILABLE;
+
+- (void)didWriteBytes:(NSInteger)count;
+
+// Call with the length of output read from the session during the paste.
+- (void)didReceiveBytes:(NSInteger)count;
+
+// Call before deciding how much to write next.
+- (void)updateWithDestinationsHaveRoom:(BOOL)haveRoom;
+
+@end
+
+NS_ASSUME_NONNULL_END
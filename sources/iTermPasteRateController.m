@@ -0,0 +1,68 @@
+//
+//  iTermPasteRateController.m
+//  iTerm2SharedARC
+//
+//  Created by agent on 10/14/26.
+//
+
+#import "iTermPasteRateController.h"
+
+#import "DebugLogging.h"
+
+static const NSInteger iTermPasteRateControllerMaximumBytesPerCall = 64 * 1024;
+static const NSTimeInterval iTermPasteRateControllerMaximumDelay = 1;
+
+// Echo of at least this fraction of what was written since the last update counts as keeping up.
+// It's less than 1 because not everything echoes one byte per byte written.
+static const double iTermPasteRateControllerEchoFraction = 0.5;
+
+@implementation iTermPasteRateController {
+    NSInteger _baseBytesPerCall;
+    NSTimeInterval _baseDelay;
+    NSInteger _bytesWritten;
+    NSInteger _bytesReceived;
+}
+
+- (instancetype)initWithBytesPerCall:(NSInteger)bytesPerCall
+                   delayBetweenCalls:(NSTimeInterval)delay {
+    self = [super init];
+    if (self) {
+        _baseBytesPerCall = MAX(1, bytesPerCall);
+        _baseDelay = MAX(0, delay);
+        _bytesPerCall = _baseBytesPerCall;
+        _delayBetweenCalls = _baseDelay;
+    }
+    return self;
+}
+
+- (void)didWriteBytes:(NSInteger)count {
+    _bytesWritten += count;
+}
+
+- (void)didReceiveBytes:(NSInteger)count {
+    _bytesReceived += count;
+}
+
+- (void)updateWithDestinationsHaveRoom:(BOOL)haveRoom {
+    if (!haveRoom) {
+        // The pty isn't accepting input as fast as we write it. Back off in both dimensions.
+        _bytesPerCall = MAX(1, _bytesPerCall / 2);
+        _delayBetweenCalls = MIN(iTermPasteRateControllerMaximumDelay,
+                                 MAX(_delayBetweenCalls * 2, 0.01));
+    } else if (_bytesWritten == 0) {
+        return;
+    } else if (_bytesReceived >= _bytesWritten * iTermPasteRateControllerEchoFraction) {
+        _bytesPerCall = MIN(iTermPasteRateControllerMaximumBytesPerCall,
+                            MAX(_bytesPerCall * 2, _baseBytesPerCall));
+        _delayBetweenCalls = MAX(_baseDelay, _delayBetweenCalls / 2);
+    } else {
+        _bytesPerCall = MAX(_baseBytesPerCall, _bytesPerCall / 2);
+        _delayBetweenCalls = MAX(_baseDelay, _delayBetweenCalls / 2);
+    }
+    DLog(@"wrote=%@ received=%@ room=%@ -> bytesPerCall=%@ delay=%@",
+         @(_bytesWritten), @(_bytesReceived), @(haveRoom), @(_bytesPerCall), @(_delayBetweenCalls));
+    _bytesWritten = 0;
+    _bytesReceived = 0;
+}
+
+@end
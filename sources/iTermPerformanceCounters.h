@@ -0,0 +1,53 @@
+//
+//  iTermPerformanceCounters.h
+//  iTerm2SharedARC
+//
+//  Created by agent on 10/14/26.
+//
+
+#import <Foundation/Foundation.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+// Always-on counters for the hot paths. Unlike iTermPreciseTimer these are meant to be left on in
+// release builds: each thread records into its own slot with plain atomic stores, so recording
+// takes no locks and no thread waits on another. Frequent events are counted every time but only
+// timed once in a while.
+typedef NS_ENUM(int, iTermPerformanceCounter) {
+    iTermPerformanceCounterRead,
+    iTermPerformanceCounterParse,
+    iTermPerformanceCounterExecuteTokens,
+    iTermPerformanceCounterTriggers,
+    iTermPerformanceCounterFramePrep,
+    iTermPerformanceCounterGPU,
+    iTermPerformanceCounterStateSave,
+    iTermPerformanceCounterProcessCacheRebuild,
+
+    iTermPerformanceCounterCount
+};
+
+// Counts an event and returns a token to pass to iTermPerformanceCounterEnd. The token is 0 if
+// this event isn't being timed.
+uint64_t iTermPerformanceCounterBegin(iTermPerformanceCounter counter);
+void iTermPerformanceCounterEnd(iTermPerformanceCounter counter, uint64_t token);
+
+// Counts an event whose duration was measured some other way, such as GPU time.
+void iTermPerformanceCounterRecordDuration(iTermPerformanceCounter counter, NSTimeInterval duration);
+
+@interface iTermPerformanceCounterSummary : NSObject
+@property (nonatomic, readonly) NSString *name;
+@property (nonatomic, readonly) int64_t count;
+// Extrapolated from the events that were timed.
+@property (nonatomic, readonly) NSTimeInterval totalTime;
+// Durations of timed events in milliseconds. Percentiles are accurate to within the width of a
+// power-of-two bucket.
+@property (nonatomic, readonly) double p50;
+@property (nonatomic, readonly) double p90;
+@property (nonatomic, readonly) double p99;
+@property (nonatomic, readonly) double max;
+@end
+
+// Totals since launch, merged across threads. Safe to call from any thread.
+NSArray<iTermPerformanceCounterSummary *> *iTermPerformanceCountersSummarize(void);
+
+NS_ASSUME_NONNULL_END
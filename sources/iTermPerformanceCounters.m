@@ -0,0 +1,250 @@
+//
+//  iTermPerformanceCounters.m
+//  iTerm2SharedARC
+//
+//  Created by agent on 10/14/26.
+//
+
+#import "iTermPerformanceCounters.h"
+
+#include <mach/mach_time.h>
+#include <pthread.h>
+#include <stdatomic.h>
+
+// Bucket i holds durations in [2^i, 2^(i+1)) microseconds, except the first also holds shorter
+// ones and the last also holds longer ones.
+#define ITERM_PERFORMANCE_COUNTER_BUCKETS 32
+
+typedef struct {
+    // Each field has exactly one writer, the thread that owns the slot, so updates are a relaxed
+    // load and store instead of a read-modify-write.
+    _Atomic uint64_t count;
+    _Atomic uint64_t timed;
+    _Atomic uint64_t totalNanos;
+    _Atomic uint64_t maxNanos;
+    _Atomic uint64_t buckets[ITERM_PERFORMANCE_COUNTER_BUCKETS];
+} iTermPerformanceCounterStats;
+
+typedef struct iTermPerformanceCounterSlot {
+    iTermPerformanceCounterStats stats[iTermPerformanceCounterCount];
+    // Set while a thread owns the slot.
+    _Atomic bool inUse;
+    struct iTermPerformanceCounterSlot *next;
+} iTermPerformanceCounterSlot;
+
+// Slots are never freed because summarizing walks the list without a lock. When a thread exits
+// its slot is released, totals and all, and the next thread to need one takes it over. Dispatch
+// retires idle worker threads and creates new ones all the time, so without this the list would
+// grow for the life of the process; with it, it's as long as the most threads that have ever
+// recorded at once.
+static _Atomic(iTermPerformanceCounterSlot *) gSlots;
+static __thread iTermPerformanceCounterSlot *tSlot;
+static pthread_key_t gSlotKey;
+
+// log2 of how many events go by for each one that is timed.
+static const int iTermPerformanceCounterSampleShift[iTermPerformanceCounterCount] = {
+    [iTermPerformanceCounterRead] = 3,
+    [iTermPerformanceCounterParse] = 3,
+    [iTermPerformanceCounterExecuteTokens] = 3,
+    [iTermPerformanceCounterTriggers] = 3,
+    [iTermPerformanceCounterFramePrep] = 0,
+    [iTermPerformanceCounterGPU] = 0,
+    [iTermPerformanceCounterStateSave] = 0,
+    [iTermPerformanceCounterProcessCacheRebuild] = 0,
+};
+
+static NSString *const iTermPerformanceCounterNames[iTermPerformanceCounterCount] = {
+    [iTermPerformanceCounterRead] = @"read",
+    [iTermPerformanceCounterParse] = @"parse",
+    [iTermPerformanceCounterExecuteTokens] = @"execute_tokens",
+    [iTermPerformanceCounterTriggers] = @"triggers",
+    [iTermPerformanceCounterFramePrep] = @"frame_prep",
+    [iTermPerformanceCounterGPU] = @"gpu",
+    [iTermPerformanceCounterStateSave] = @"state_save",
+    [iTermPerformanceCounterProcessCacheRebuild] = @"process_cache_rebuild",
+};
+
+static mach_timebase_info_data_t iTermPerformanceCounterTimebase(void) {
+    static mach_timebase_info_data_t timebase;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        mach_timebase_info(&timebase);
+    });
+    return timebase;
+}
+
+// Runs on the exiting thread. The release pairs with the acquire in
+// iTermPerformanceCounterGetSlot so the next owner sees everything this thread recorded.
+static void iTermPerformanceCounterReleaseSlot(void *value) {
+    iTermPerformanceCounterSlot *slot = value;
+    if (tSlot == slot) {
+        tSlot = NULL;
+    }
+    atomic_store_explicit(&slot->inUse, false, memory_order_release);
+}
+
+static iTermPerformanceCounterSlot *iTermPerformanceCounterGetSlot(void) {
+    if (tSlot) {
+        return tSlot;
+    }
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        pthread_key_create(&gSlotKey, iTermPerformanceCounterReleaseSlot);
+    });
+    iTermPerformanceCounterSlot *slot = NULL;
+    for (iTermPerformanceCounterSlot *candidate = atomic_load(&gSlots); candidate; candidate = candidate->next) {
+        bool expected = false;
+        if (atomic_compare_exchange_strong_explicit(&candidate->inUse,
+                                                    &expected,
+                                                    true,
+                                                    memory_order_acquire,
+                                                    memory_order_relaxed)) {
+            slot = candidate;
+            break;
+        }
+    }
+    if (!slot) {
+        slot = calloc(1, sizeof(*slot));
+        atomic_init(&slot->inUse, true);
+        iTermPerformanceCounterSlot *head = atomic_load(&gSlots);
+        do {
+            slot->next = head;
+        } while (!atomic_compare_exchange_weak(&gSlots, &head, slot));
+    }
+    pthread_setspecific(gSlotKey, slot);
+    tSlot = slot;
+    return slot;
+}
+
+NS_INLINE void iTermPerformanceCounterIncrement(_Atomic uint64_t *value, uint64_t delta) {
+    atomic_store_explicit(value, atomic_load_explicit(value, memory_order_relaxed) + delta, memory_order_relaxed);
+}
+
+static void iTermPerformanceCounterRecordNanos(iTermPerformanceCounterStats *stats, uint64_t nanos) {
+    iTermPerformanceCounterIncrement(&stats->timed, 1);
+    iTermPerformanceCounterIncrement(&stats->totalNanos, nanos);
+    if (nanos > atomic_load_explicit(&stats->maxNanos, memory_order_relaxed)) {
+        atomic_store_explicit(&stats->maxNanos, nanos, memory_order_relaxed);
+    }
+    const uint64_t micros = nanos / 1000;
+    int bucket = micros ? 63 - __builtin_clzll(micros) : 0;
+    bucket = MIN(bucket, ITERM_PERFORMANCE_COUNTER_BUCKETS - 1);
+    iTermPerformanceCounterIncrement(&stats->buckets[bucket], 1);
+}
+
+uint64_t iTermPerformanceCounterBegin(iTermPerformanceCounter counter) {
+    iTermPerformanceCounterStats *stats = &iTermPerformanceCounterGetSlot()->stats[counter];
+    const uint64_t count = atomic_load_explicit(&stats->count, memory_order_relaxed);
+    atomic_store_explicit(&stats->count, count + 1, memory_order_relaxed);
+    const uint64_t mask = (1ULL << iTermPerformanceCounterSampleShift[counter]) - 1;
+    if (count & mask) {
+        return 0;
+    }
+    return mach_absolute_time();
+}
+
+void iTermPerformanceCounterEnd(iTermPerformanceCounter counter, uint64_t token) {
+    if (!token) {
+        return;
+    }
+    const mach_timebase_info_data_t timebase = iTermPerformanceCounterTimebase();
+    const uint64_t nanos = (mach_absolute_time() - token) * timebase.numer / timebase.denom;
+    iTermPerformanceCounterRecordNanos(&iTermPerformanceCounterGetSlot()->stats[counter], nanos);
+}
+
+void iTermPerformanceCounterRecordDuration(iTermPerformanceCounter counter, NSTimeInterval duration) {
+    iTermPerformanceCounterStats *stats = &iTermPerformanceCounterGetSlot()->stats[counter];
+    iTermPerformanceCounterIncrement(&stats->count, 1);
+    iTermPerformanceCounterRecordNanos(stats, (uint64_t)(MAX(0, duration) * NSEC_PER_SEC));
+}
+
+@interface iTermPerformanceCounterSummary ()
+- (instancetype)initWithName:(NSString *)name
+                       count:(int64_t)count
+                   totalTime:(NSTimeInterval)totalTime
+                         p50:(double)p50
+                         p90:(double)p90
+                         p99:(double)p99
+                         max:(double)max;
+@end
+
+@implementation iTermPerformanceCounterSummary
+
+- (instancetype)initWithName:(NSString *)name
+                       count:(int64_t)count
+                   totalTime:(NSTimeInterval)totalTime
+                         p50:(double)p50
+                         p90:(double)p90
+                         p99:(double)p99
+                         max:(double)max {
+    self = [super init];
+    if (self) {
+        _name = [name copy];
+        _count = count;
+        _totalTime = totalTime;
+        _p50 = p50;
+        _p90 = p90;
+        _p99 = p99;
+        _max = max;
+    }
+    return self;
+}
+
+- (NSString *)description {
+    return [NSString stringWithFormat:@"<%@: %p %@ count=%@ total=%.3fs p50=%.3fms p90=%.3fms p99=%.3fms max=%.3fms>",
+            NSStringFromClass([self class]), self, _name, @(_count), _totalTime, _p50, _p90, _p99, _max];
+}
+
+@end
+
+// Returns the geometric middle of the bucket containing the ntile, in milliseconds.
+static double iTermPerformanceCounterNTile(const uint64_t *buckets, uint64_t total, double ntile, double max) {
+    if (total == 0) {
+        return 0;
+    }
+    const uint64_t rank = MAX(1, (uint64_t)ceil(ntile * total));
+    uint64_t seen = 0;
+    for (int i = 0; i < ITERM_PERFORMANCE_COUNTER_BUCKETS; i++) {
+        seen += buckets[i];
+        if (seen >= rank) {
+            return MIN(max, exp2(i + 0.5) / 1000.0);
+        }
+    }
+    return max;
+}
+
+NSArray<iTermPerformanceCounterSummary *> *iTermPerformanceCountersSummarize(void) {
+    NSMutableArray<iTermPerformanceCounterSummary *> *result = [NSMutableArray array];
+    for (int counter = 0; counter < iTermPerformanceCounterCount; counter++) {
+        uint64_t count = 0;
+        uint64_t timed = 0;
+        uint64_t totalNanos = 0;
+        uint64_t maxNanos = 0;
+        uint64_t buckets[ITERM_PERFORMANCE_COUNTER_BUCKETS] = { 0 };
+        for (iTermPerformanceCounterSlot *slot = atomic_load(&gSlots); slot; slot = slot->next) {
+            iTermPerformanceCounterStats *stats = &slot->stats[counter];
+            count += atomic_load_explicit(&stats->count, memory_order_relaxed);
+            timed += atomic_load_explicit(&stats->timed, memory_order_relaxed);
+            totalNanos += atomic_load_explicit(&stats->totalNanos, memory_order_relaxed);
+            maxNanos = MAX(maxNanos, atomic_load_explicit(&stats->maxNanos, memory_order_relaxed));
+            for (int i = 0; i < ITERM_PERFORMANCE_COUNTER_BUCKETS; i++) {
+                buckets[i] += atomic_load_explicit(&stats->buckets[i], memory_order_relaxed);
+            }
+        }
+        // Buckets are read after timed, so they may be slightly ahead of it.
+        uint64_t bucketTotal = 0;
+        for (int i = 0; i < ITERM_PERFORMANCE_COUNTER_BUCKETS; i++) {
+            bucketTotal += buckets[i];
+        }
+        const double max = maxNanos / 1000000.0;
+        const NSTimeInterval totalTime = timed ? (totalNanos / 1e9) * ((double)count / timed) : 0;
+        [result addObject:[[iTermPerformanceCounterSummary alloc] initWithName:iTermPerformanceCounterNames[counter]
+                                                                         count:count
+                                                                     totalTime:totalTime
+                                                                           p50:iTermPerformanceCounterNTile(buckets, bucketTotal, 0.5, max)
+                                                                           p90:iTermPerformanceCounterNTile(buckets, bucketTotal, 0.9, max)
+                                                                           p99:iTermPerformanceCounterNTile(buckets, bucketTotal, 0.99, max)
+                                                                           max:max]];
+    }
+    return result;
+}
@@ -0,0 +1,19 @@
+//
+//  iTermPerformanceCountersWindowController.h
+//  iTerm2SharedARC
+//
+//  Created by agent on 10/14/26.
+//
+
+#import <Cocoa/Cocoa.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+// Debug panel that shows iTermPerformanceCounters and refreshes them once a second while visible.
+@interface iTermPerformanceCountersWindowController : NSWindowController
+
++ (instancetype)sharedInstance;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,107 @@
+//
+//  iTermPerformanceCountersWindowController.m
+//  iTerm2SharedARC
+//
+//  Created by agent on 10/14/26.
+//
+
+#import "iTermPerformanceCountersWindowController.h"
+
+#import "iTermCache.h"
+#import "iTermPerformanceCounters.h"
+#import "iTermStartupScheduler.h"
+
+@interface iTermPerformanceCountersWindowController()<NSWindowDelegate>
+@end
+
+@implementation iTermPerformanceCountersWindowController {
+    NSTextView *_textView;
+    NSTimer *_timer;
+}
+
++ (instancetype)sharedInstance {
+    static iTermPerformanceCountersWindowController *instance;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        instance = [[self alloc] init];
+    });
+    return instance;
+}
+
+- (instancetype)init {
+    NSPanel *panel = [[NSPanel alloc] initWithContentRect:NSMakeRect(0, 0, 640, 220)
+                                                styleMask:(NSWindowStyleMaskTitled |
+                                                           NSWindowStyleMaskClosable |
+                                                           NSWindowStyleMaskResizable |
+                                                           NSWindowStyleMaskUtilityWindow)
+                                                  backing:NSBackingStoreBuffered
+                                                    defer:YES];
+    panel.title = @"Performance Counters";
+    panel.releasedWhenClosed = NO;
+    panel.hidesOnDeactivate = NO;
+    self = [super initWithWindow:panel];
+    if (self) {
+        NSScrollView *scrollView = [[NSScrollView alloc] initWithFrame:panel.contentView.bounds];
+        scrollView.autoresizingMask = NSViewWidthSizable | NSViewHeightSizable;
+        scrollView.hasVerticalScroller = YES;
+        _textView = [[NSTextView alloc] initWithFrame:scrollView.bounds];
+        _textView.autoresizingMask = NSViewWidthSizable;
+        _textView.editable = NO;
+        _textView.font = [NSFont userFixedPitchFontOfSize:[NSFont systemFontSize]];
+        _textView.textContainerInset = NSMakeSize(4, 4);
+        scrollView.documentView = _textView;
+        panel.contentView = scrollView;
+        panel.delegate = self;
+        [panel center];
+    }
+    return self;
+}
+
+- (void)showWindow:(id)sender {
+    [super showWindow:sender];
+    [self update];
+    if (!_timer) {
+        __weak __typeof(self) weakSelf = self;
+        _timer = [NSTimer scheduledTimerWithTimeInterval:1 repeats:YES block:^(NSTimer * _Nonnull timer) {
+            [weakSelf update];
+        }];
+    }
+}
+
+- (void)update {
+    NSMutableString *text = [NSMutableString stringWithFormat:@"%-22s %12s %12s %9s %9s %9s %9s\n",
+                             "counter", "count", "total (s)", "p50 ms", "p90 ms", "p99 ms", "max ms"];
+    for (iTermPerformanceCounterSummary *summary in iTermPerformanceCountersSummarize()) {
+        [text appendFormat:@"%-22s %12lld %12.3f %9.3f %9.3f %9.3f %9.3f\n",
+         summary.name.UTF8String,
+         summary.count,
+         summary.totalTime,
+         summary.p50,
+         summary.p90,
+         summary.p99,
+         summary.max];
+    }
+    [text appendFormat:@"\n%-22s %12s %12s %9s %12s %12s\n",
+     "cache", "hits", "misses", "hit rate", "evictions", "entries"];
+    for (iTermCacheStatisticsSummary *summary in iTermCacheStatisticsSummarize()) {
+        [text appendFormat:@"%-22s %12llu %12llu %8.1f%% %12llu %12lld\n",
+         summary.name.UTF8String,
+         summary.hits,
+         summary.misses,
+         summary.hitRate * 100,
+         summary.evictions,
+         summary.count];
+    }
+    [text appendString:@"\nlaunch timeline (s since process start)\n"];
+    [text appendString:[[iTermStartupScheduler sharedInstance] timelineDescription]];
+    [_textView setString:text];
+}
+
+#pragma mark - NSWindowDelegate
+
+- (void)windowWillClose:(NSNotification *)notification {
+    [_timer invalidate];
+    _timer = nil;
+}
+
+@end
@@ -6,10 +6,21 @@
 //
 
 #import <Foundation/Foundation.h>
+#import "pidinfoProtocol.h"
 #include <libproc.h>
 
 NS_ASSUME_NONNULL_BEGIN
 
+// What a batched query learned about one process. Fields that weren't requested or couldn't be
+// read are nil.
+@interface iTermPidInfo : NSObject
+@property (nonatomic, readonly) pid_t processID;
+@property (nullable, nonatomic, readonly) NSData *taskAllInfo;  // struct proc_taskallinfo
+@property (nullable, nonatomic, readonly) NSData *fileDescriptors;  // Array of struct proc_fdinfo
+@property (nullable, nonatomic, readonly) NSData *filePorts;  // Array of struct proc_fileportinfo
+@property (nullable, nonatomic, readonly) NSString *rawWorkingDirectory;
+@end
+
 // Talks to the pidinfo xpc server. Provides high level APIs for accessing
 // information about processes.
 @interface iTermPidInfoClient : NSObject
@@ -33,6 +44,13 @@ NS_ASSUME_NONNULL_BEGIN
                                      queue:(dispatch_queue_t)queue
                                 completion:(void (^)(NSString *rawDir))completion;
 
+// Fetches all the requested fields of all the processes in one round trip. Infos has one entry
+// per pid, in order.
+- (void)getInfoForProcesses:(NSArray<NSNumber *> *)pids
+                     fields:(iTermPidInfoFields)fields
+                      queue:(dispatch_queue_t)queue
+                 completion:(void (^)(NSArray<iTermPidInfo *> *infos))completion;
+
 @end
 
 
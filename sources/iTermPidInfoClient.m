@@ -11,13 +11,48 @@
 #import "iTermAdvancedSettingsModel.h"
 #import "iTermMalloc.h"
 #import "iTermSlowOperationGateway.h"
+#import "iTermTuple.h"
+#import "NSArray+iTerm.h"
 #include <stdatomic.h>
 #import <QuartzCore/QuartzCore.h>
 
+static NSString *iTermPidInfoRawWorkingDirectory(NSData *buffer) {
+    struct proc_vnodepathinfo vpi;
+    if (buffer.length != sizeof(vpi)) {
+        // Now this is very bad...
+        DLog(@"Got a struct of the wrong size back");
+        return nil;
+    }
+    memmove(&vpi, buffer.bytes, sizeof(vpi));
+    return [NSString stringWithUTF8String:vpi.pvi_cdir.vip_path];
+}
+
+@implementation iTermPidInfo
+
+- (instancetype)initWithProcessID:(pid_t)pid fields:(NSDictionary<NSNumber *, NSData *> *)fields {
+    self = [super init];
+    if (self) {
+        _processID = pid;
+        _taskAllInfo = fields[@(iTermPidInfoFieldTaskAllInfo)];
+        _fileDescriptors = fields[@(iTermPidInfoFieldFileDescriptors)];
+        _filePorts = fields[@(iTermPidInfoFieldFilePorts)];
+        NSData *vnodePathInfo = fields[@(iTermPidInfoFieldVnodePathInfo)];
+        if (vnodePathInfo) {
+            _rawWorkingDirectory = iTermPidInfoRawWorkingDirectory(vnodePathInfo);
+        }
+    }
+    return self;
+}
+
+@end
+
 @implementation iTermPidInfoClient {
     dispatch_queue_t _localQueue;
     dispatch_semaphore_t _sema;
     NSTimeInterval _timeout;
+    // Working directory requests waiting to be sent together. Each is (pid, completion).
+    // Guarded by @synchronized(self).
+    NSMutableArray<iTermTuple<NSNumber *, void (^)(NSString *)> *> *_pendingWorkingDirectoryRequests;
 }
 
 + (instancetype)sharedInstance {
@@ -37,6 +72,7 @@
         // Don't let more than this many threads get wedged.
         _sema = dispatch_semaphore_create(32);
         _timeout = 0.5;
+        _pendingWorkingDirectoryRequests = [NSMutableArray array];
     }
     return self;
 }
@@ -225,6 +261,10 @@
 - (void)getWorkingDirectoryOfProcessWithID:(pid_t)pid
                                      queue:(dispatch_queue_t)queue
                                 completion:(void (^)(NSString *rawDir))completion {
+    if ([iTermAdvancedSettingsModel batchPidInfoQueries]) {
+        [self enqueueWorkingDirectoryRequestForProcessID:pid queue:queue completion:completion];
+        return;
+    }
     [self asyncGetInfoForProcess:pid
                           flavor:PROC_PIDVNODEPATHINFO
                              arg:0
@@ -240,8 +280,7 @@
             });
             return;
         }
-        struct proc_vnodepathinfo vpi;
-        if (ret != sizeof(vpi)) {
+        if (ret != sizeof(struct proc_vnodepathinfo)) {
             // Now this is very bad...
             DLog(@"Got a struct of the wrong size back");
             dispatch_async(queue, ^{
@@ -249,13 +288,144 @@
             });
             return;
         }
-        memmove(&vpi, buffer.bytes, MIN(sizeof(vpi), buffer.length));
         // All is good
-        NSString *rawDir = [NSString stringWithUTF8String:vpi.pvi_cdir.vip_path];
+        NSString *rawDir = iTermPidInfoRawWorkingDirectory(buffer);
         dispatch_async(queue, ^{
             completion(rawDir);
         });
     }];
 }
 
+// Requests made before the main queue gets around to flushing them go out in one batch. Sessions'
+// working directory pollers tend to fire together (e.g., when the app becomes active).
+- (void)enqueueWorkingDirectoryRequestForProcessID:(pid_t)pid
+                                             queue:(dispatch_queue_t)queue
+                                        completion:(void (^)(NSString *rawDir))completion {
+    void (^wrapper)(NSString *) = ^(NSString *rawDir) {
+        dispatch_async(queue, ^{
+            completion(rawDir);
+        });
+    };
+    BOOL needsFlush;
+    @synchronized (self) {
+        needsFlush = _pendingWorkingDirectoryRequests.count == 0;
+        [_pendingWorkingDirectoryRequests addObject:[iTermTuple tupleWithObject:@(pid) andObject:[wrapper copy]]];
+    }
+    if (!needsFlush) {
+        return;
+    }
+    dispatch_async(dispatch_get_main_queue(), ^{
+        [self flushWorkingDirectoryRequests];
+    });
+}
+
+- (void)flushWorkingDirectoryRequests {
+    NSArray<iTermTuple<NSNumber *, void (^)(NSString *)> *> *requests;
+    @synchronized (self) {
+        requests = [_pendingWorkingDirectoryRequests copy];
+        [_pendingWorkingDirectoryRequests removeAllObjects];
+    }
+    NSArray<NSNumber *> *pids = [[NSOrderedSet orderedSetWithArray:[requests mapWithBlock:^id(iTermTuple<NSNumber *, void (^)(NSString *)> *tuple) {
+        return tuple.firstObject;
+    }]] array];
+    DLog(@"Fetch working directories of %@ processes for %@ requests", @(pids.count), @(requests.count));
+    [self getInfoForProcesses:pids
+                       fields:iTermPidInfoFieldVnodePathInfo
+                        queue:dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0)
+                   completion:^(NSArray<iTermPidInfo *> *infos) {
+        NSMutableDictionary<NSNumber *, NSString *> *directories = [NSMutableDictionary dictionary];
+        for (iTermPidInfo *info in infos) {
+            directories[@(info.processID)] = info.rawWorkingDirectory;
+        }
+        for (iTermTuple<NSNumber *, void (^)(NSString *)> *tuple in requests) {
+            tuple.secondObject(directories[tuple.firstObject]);
+        }
+    }];
+}
+
+- (void)getInfoForProcesses:(NSArray<NSNumber *> *)pids
+                     fields:(iTermPidInfoFields)fields
+                      queue:(dispatch_queue_t)queue
+                 completion:(void (^)(NSArray<iTermPidInfo *> *infos))completion {
+    void (^finish)(NSArray<NSDictionary<NSNumber *, NSData *> *> *) = ^(NSArray<NSDictionary<NSNumber *, NSData *> *> *dicts) {
+        NSMutableArray<iTermPidInfo *> *infos = [NSMutableArray arrayWithCapacity:pids.count];
+        [pids enumerateObjectsUsingBlock:^(NSNumber * _Nonnull pid, NSUInteger idx, BOOL * _Nonnull stop) {
+            [infos addObject:[[iTermPidInfo alloc] initWithProcessID:pid.intValue
+                                                              fields:dicts ? dicts[idx] : @{}]];
+        }];
+        dispatch_async(queue, ^{
+            completion(infos);
+        });
+    };
+    if (!self.ready) {
+        DLog(@"Not ready");
+        [self localGetInfoForProcesses:pids fields:fields completion:finish];
+        return;
+    }
+    [[iTermSlowOperationGateway sharedInstance] asyncGetInfoForProcesses:pids
+                                                                  fields:fields
+                                                                   reqid:[self nextReqid]
+                                                              completion:finish];
+}
+
+// Used while waiting for the XPC service to start. Completion gets nil on failure.
+- (void)localGetInfoForProcesses:(NSArray<NSNumber *> *)pids
+                          fields:(iTermPidInfoFields)fields
+                      completion:(void (^)(NSArray<NSDictionary<NSNumber *, NSData *> *> *))completion {
+    __block atomic_flag finished = ATOMIC_FLAG_INIT;
+    const long waitResult = dispatch_semaphore_wait(_sema, DISPATCH_TIME_NOW);
+    if (waitResult) {
+        DLog(@"semaphore_wait failed, return error");
+        completion(nil);
+        return;
+    }
+    dispatch_async(_localQueue, ^{
+        NSArray<NSDictionary<NSNumber *, NSData *> *> *infos = [pids mapWithBlock:^id(NSNumber *pid) {
+            return [self localFields:fields forProcessID:pid.intValue];
+        }];
+        dispatch_semaphore_signal(self->_sema);
+        if (atomic_flag_test_and_set(&finished)) {
+            return;
+        }
+        DLog(@"Completed");
+        completion(infos);
+    });
+    dispatch_after(dispatch_time(DISPATCH_TIME_NOW, (int64_t)(_timeout * NSEC_PER_SEC)), dispatch_get_main_queue(), ^{
+        if (atomic_flag_test_and_set(&finished)) {
+            return;
+        }
+        DLog(@"Timed out");
+        completion(nil);
+    });
+}
+
+- (NSDictionary<NSNumber *, NSData *> *)localFields:(iTermPidInfoFields)fields forProcessID:(pid_t)pid {
+    NSData *(^get)(int, int) = ^NSData *(int flavor, int size) {
+        if (size <= 0 || size > 1024 * 1024) {
+            return nil;
+        }
+        NSMutableData *data = [NSMutableData dataWithLength:size];
+        const int rc = proc_pidinfo(pid, flavor, 0, data.mutableBytes, size);
+        if (rc <= 0) {
+            return nil;
+        }
+        data.length = MIN(rc, size);
+        return data;
+    };
+    NSMutableDictionary<NSNumber *, NSData *> *result = [NSMutableDictionary dictionary];
+    if (fields & iTermPidInfoFieldTaskAllInfo) {
+        result[@(iTermPidInfoFieldTaskAllInfo)] = get(PROC_PIDTASKALLINFO, sizeof(struct proc_taskallinfo));
+    }
+    if (fields & iTermPidInfoFieldFileDescriptors) {
+        result[@(iTermPidInfoFieldFileDescriptors)] = get(PROC_PIDLISTFDS, proc_pidinfo(pid, PROC_PIDLISTFDS, 0, NULL, 0));
+    }
+    if (fields & iTermPidInfoFieldFilePorts) {
+        result[@(iTermPidInfoFieldFilePorts)] = get(PROC_PIDLISTFILEPORTS, proc_pidinfo(pid, PROC_PIDLISTFILEPORTS, 0, NULL, 0));
+    }
+    if (fields & iTermPidInfoFieldVnodePathInfo) {
+        result[@(iTermPidInfoFieldVnodePathInfo)] = get(PROC_PIDVNODEPATHINFO, sizeof(struct proc_vnodepathinfo));
+    }
+    return result;
+}
+
 @end
@@ -11,7 +11,9 @@
 #import "legacy_server.h"
 
 #include <assert.h>
+#include <fcntl.h>
 #include <signal.h>
+#include <spawn.h>
 #include <stdio.h>
 #include <string.h>
 #include <sys/errno.h>
@@ -122,6 +124,80 @@ int iTermPosixTTYReplacementForkPty(int *amaster,
     }
 }
 
+pid_t iTermPosixTTYReplacementSpawnPty(int *amaster,
+                                        iTermTTYState *ttyState,
+                                        const char *argpath,
+                                        const char **argv,
+                                        const char *initialPwd,
+                                        const char **newEnviron) {
+#if defined(POSIX_SPAWN_SETSID) && defined(POSIX_SPAWN_CLOEXEC_DEFAULT)
+    if (__builtin_available(macOS 10.15, *)) {
+        int master;
+        int slave;
+        iTermFileDescriptorServerLog("Calling openpty");
+        if (openpty(&master, &slave, ttyState->tty, &ttyState->term, &ttyState->win) == -1) {
+            iTermFileDescriptorServerLog("openpty failed: %s", strerror(errno));
+            return -1;
+        }
+
+        // This does in the kernel what iTermExec does between fork and exec: default signal
+        // handlers, no blocked signals, and no file descriptors besides the ones set up below.
+        posix_spawnattr_t attr;
+        posix_spawnattr_init(&attr);
+        sigset_t signals;
+        sigfillset(&signals);
+        posix_spawnattr_setsigdefault(&attr, &signals);
+        sigemptyset(&signals);
+        posix_spawnattr_setsigmask(&attr, &signals);
+        posix_spawnattr_setflags(&attr, (POSIX_SPAWN_SETSID |
+                                         POSIX_SPAWN_CLOEXEC_DEFAULT |
+                                         POSIX_SPAWN_SETSIGDEF |
+                                         POSIX_SPAWN_SETSIGMASK));
+
+        // The new session is created before file actions run. Opening the slave by name (rather
+        // than inheriting the descriptor) from the session leader makes it the controlling terminal,
+        // like TIOCSCTTY does in iTermPosixTTYReplacementLoginTTY.
+        posix_spawn_file_actions_t actions;
+        posix_spawn_file_actions_init(&actions);
+        posix_spawn_file_actions_addopen(&actions, 0, ttyState->tty, O_RDWR, 0);
+        posix_spawn_file_actions_adddup2(&actions, 0, 1);
+        posix_spawn_file_actions_adddup2(&actions, 0, 2);
+        if (initialPwd) {
+            posix_spawn_file_actions_addchdir_np(&actions, initialPwd);
+        }
+
+        // posix_spawnp searches the caller's PATH, while execvp in iTermExec searched the new
+        // environment's, so swap it in for the duration of the call.
+        extern char **environ;
+        char **savedEnviron = environ;
+        environ = (char **)newEnviron;
+        pid_t pid = -1;
+        iTermFileDescriptorServerLog("Calling posix_spawnp");
+        const int rc = posix_spawnp(&pid,
+                                    argpath,
+                                    &actions,
+                                    &attr,
+                                    (char *const *)argv,
+                                    (char *const *)newEnviron);
+        environ = savedEnviron;
+
+        posix_spawn_file_actions_destroy(&actions);
+        posix_spawnattr_destroy(&attr);
+        close(slave);
+        if (rc != 0) {
+            iTermFileDescriptorServerLog("posix_spawnp failed: %s", strerror(rc));
+            close(master);
+            errno = rc;
+            return -1;
+        }
+        *amaster = master;
+        return pid;
+    }
+#endif
+    errno = ENOTSUP;
+    return -1;
+}
+
 void iTermExec(const char *argpath,
                const char **argv,
                int closeFileDescriptors,
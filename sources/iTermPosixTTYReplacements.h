@@ -27,6 +27,21 @@ int iTermPosixTTYReplacementForkPty(int *amaster,
                                     int serverSocketFd,
                                     int deadMansPipeWriteEnd);
 
+// Launches argv on a new pty without forking, so the cost doesn't grow with the caller's address
+// space. The child gets the same state iTermExec sets up: a new session whose controlling terminal
+// is the pty, which is also its stdin, stdout, and stderr; default signal handlers with none
+// blocked; no other file descriptors; initialPwd as its working directory; and newEnviron,
+// including for the PATH search. Returns the child's pid with the master in *amaster and its name
+// in ttyState->tty, or -1 with errno set if nothing was launched, including when the OS doesn't
+// support it. Unlike iTermExec, a program that can't be executed is reported here rather than by
+// the child, so callers may want to fall back to forking to show the error in the session.
+pid_t iTermPosixTTYReplacementSpawnPty(int *amaster,
+                                        iTermTTYState *ttyState,
+                                        const char *argpath,
+                                        const char **argv,
+                                        const char *initialPwd,
+                                        const char **newEnviron);
+
 // Call this in the child after fork. This never returns, even if it can't exec the target.
 void iTermExec(const char *argpath,
                const char **argv,
@@ -11,12 +11,21 @@ NS_ASSUME_NONNULL_BEGIN
 
 @interface iTermPreferenceDidChangeNotification : iTermBaseNotification
 
-@property (nonatomic, readonly) NSString *key;
+// When several preferences change at once these are nil. Use changedKeys instead.
+@property (nonatomic, readonly, nullable) NSString *key;
 @property (nonatomic, readonly, nullable) id value;
 
+@property (nonatomic, readonly) NSSet<NSString *> *changedKeys;
+
 + (instancetype)notificationWithKey:(NSString *)key
                               value:(nullable id)value;
 
+// |values| maps each changed key to its new value, or to NSNull if it was removed.
++ (instancetype)notificationWithValues:(NSDictionary<NSString *, id> *)values;
+
+- (BOOL)didChangeKey:(NSString *)key;
+- (nullable id)valueForChangedKey:(NSString *)key;
+
 + (void)subscribe:(NSObject *)owner
             block:(void (^)(iTermPreferenceDidChangeNotification * _Nonnull notification))block;
 
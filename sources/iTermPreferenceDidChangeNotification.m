@@ -12,6 +12,7 @@
 @interface iTermPreferenceDidChangeNotification()
 @property (nonatomic, strong, readwrite) NSString *key;
 @property (nonatomic, strong, readwrite) id value;
+@property (nonatomic, copy) NSDictionary<NSString *, id> *values;
 @end
 
 @implementation iTermPreferenceDidChangeNotification
@@ -20,9 +21,37 @@
     iTermPreferenceDidChangeNotification *notif = [[self alloc] initPrivate];
     notif.key = key;
     notif.value = value;
+    notif.values = @{ key: value ?: [NSNull null] };
     return notif;
 }
 
++ (instancetype)notificationWithValues:(NSDictionary<NSString *, id> *)values {
+    if (values.count == 1) {
+        NSString *key = values.allKeys.firstObject;
+        id value = values[key];
+        return [self notificationWithKey:key value:value == [NSNull null] ? nil : value];
+    }
+    iTermPreferenceDidChangeNotification *notif = [[self alloc] initPrivate];
+    notif.values = values;
+    return notif;
+}
+
+- (NSSet<NSString *> *)changedKeys {
+    return [NSSet setWithArray:_values.allKeys];
+}
+
+- (BOOL)didChangeKey:(NSString *)key {
+    return _values[key] != nil;
+}
+
+- (id)valueForChangedKey:(NSString *)key {
+    id value = _values[key];
+    if (value == [NSNull null]) {
+        return nil;
+    }
+    return value;
+}
+
 + (void)subscribe:(NSObject *)owner
             block:(void (^)(iTermPreferenceDidChangeNotification * _Nonnull))block {
     [self internalSubscribe:owner withBlock:block];
@@ -12,6 +12,7 @@
 // Optionally, it may have a function that computes its value (set in +computedObjectDictionary)
 // and the view controller may customize how its control's appearance changes dynamically.
 
+#import "iTermAdvancedSettingsModel.h"
 #import "iTermNotificationCenter.h"
 #import "iTermPreferenceDidChangeNotification.h"
 #import "iTermPreferences.h"
@@ -171,6 +172,9 @@ NSString *const kPreferenceKeyHTMLTabTitles = @"HTMLTabTitles";
 
 static NSMutableDictionary *gObservers;
 static NSString *sPreviousVersion;
+// Preferences changed since iTermPreferenceDidChangeNotification was last posted. Maps to NSNull
+// when a key was removed.
+static NSMutableDictionary<NSString *, id> *gPendingChanges;
 
 @implementation iTermPreferences
 
@@ -547,9 +551,31 @@ static NSString *sPreviousVersion;
         block(before, object);
     }
 
+    if ([iTermAdvancedSettingsModel coalescePreferenceChangeNotifications]) {
+        [self postDidChangeNotificationEventuallyForKey:key value:object];
+        return;
+    }
     [[iTermPreferenceDidChangeNotification notificationWithKey:key value:object] post];
 }
 
+// Changes made in the same pass through the runloop, such as by importing settings, are announced
+// together so subscribers refresh once.
++ (void)postDidChangeNotificationEventuallyForKey:(NSString *)key value:(id)object {
+    const BOOL scheduled = (gPendingChanges != nil);
+    if (!scheduled) {
+        gPendingChanges = [NSMutableDictionary dictionary];
+    }
+    gPendingChanges[key] = object ?: [NSNull null];
+    if (scheduled) {
+        return;
+    }
+    dispatch_async(dispatch_get_main_queue(), ^{
+        NSDictionary<NSString *, id> *changes = gPendingChanges;
+        gPendingChanges = nil;
+        [[iTermPreferenceDidChangeNotification notificationWithValues:changes] post];
+    });
+}
+
 #pragma mark - APIs
 
 + (BOOL)keyHasDefaultValue:(NSString *)key {
@@ -27,6 +27,10 @@ NS_ASSUME_NONNULL_BEGIN
 
 @interface iTermPreferencesSearchEngine : NSObject
 - (void)addDocumentToIndex:(iTermPreferencesSearchDocument *)document;
+
+// Equivalent to adding each document in order, but sorts the index once. Safe to call on a
+// background queue as long as nothing else is using this engine.
+- (void)addDocumentsToIndex:(NSArray<iTermPreferencesSearchDocument *> *)documents;
 - (NSArray<iTermPreferencesSearchDocument *> *)documentsMatchingQuery:(NSString *)query;
 - (nullable iTermPreferencesSearchDocument *)documentWithKey:(NSString *)key;
 @end
@@ -162,6 +162,8 @@
 @implementation iTermPreferencesSearchEngine {
     NSMutableArray<iTermPreferencesSearchIndexEntry *> *_index;
     NSMutableDictionary<NSNumber *, iTermPreferencesSearchDocument *> *_docs;
+    // First document added for each identifier.
+    NSMutableDictionary<NSString *, iTermPreferencesSearchDocument *> *_docsByIdentifier;
 }
 
 - (instancetype)init {
@@ -169,6 +171,7 @@
     if (self) {
         _index = [NSMutableArray array];
         _docs = [NSMutableDictionary dictionary];
+        _docsByIdentifier = [NSMutableDictionary dictionary];
     }
     return self;
 }
@@ -198,17 +201,42 @@
         }
         [_index insertObject:entry atIndex:index];
     }
+    [self addDocumentToTables:document];
+}
+
+- (void)addDocumentsToIndex:(NSArray<iTermPreferencesSearchDocument *> *)documents {
+    // Inserting into the sorted array one keyword at a time is quadratic, which is noticeable
+    // with the hundreds of documents the preference panels provide.
+    NSMutableDictionary<NSString *, iTermPreferencesSearchIndexEntry *> *entries = [NSMutableDictionary dictionary];
+    for (iTermPreferencesSearchIndexEntry *entry in _index) {
+        entries[entry.keyword] = entry;
+    }
+    for (iTermPreferencesSearchDocument *document in documents) {
+        for (NSString *keyword in document.allKeywords) {
+            iTermPreferencesSearchIndexEntry *entry = entries[keyword];
+            if (entry) {
+                [entry addDocument:document];
+            } else {
+                entries[keyword] = [[iTermPreferencesSearchIndexEntry alloc] initWithKeyword:keyword document:document];
+            }
+        }
+        [self addDocumentToTables:document];
+    }
+    _index = [[entries.allValues sortedArrayUsingSelector:@selector(compare:)] mutableCopy];
+}
+
+- (void)addDocumentToTables:(iTermPreferencesSearchDocument *)document {
     _docs[document.docid] = document;
+    if (document.identifier && !_docsByIdentifier[document.identifier]) {
+        _docsByIdentifier[document.identifier] = document;
+    }
 }
 
 - (iTermPreferencesSearchDocument *)documentWithKey:(NSString *)key {
-    for (NSNumber *docid in _docs) {
-        iTermPreferencesSearchDocument *doc = _docs[docid];
-        if ([doc.identifier isEqual:key]) {
-            return doc;
-        }
+    if (!key) {
+        return nil;
     }
-    return nil;
+    return _docsByIdentifier[key];
 }
 
 - (NSArray<iTermPreferencesSearchDocument *> *)documentsMatchingQuery:(NSString *)query {
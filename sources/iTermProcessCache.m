@@ -8,7 +8,9 @@
 #import <Cocoa/Cocoa.h>
 
 #import "DebugLogging.h"
+#import "iTermAdvancedSettingsModel.h"
 #import "iTermLSOF.h"
+#import "iTermPerformanceCounters.h"
 #import "iTermProcessCache.h"
 #import "iTermProcessMonitor.h"
 #import "iTermRateLimitedUpdate.h"
@@ -32,6 +34,24 @@
     iTermRateLimitedUpdate *_rateLimit;  // Main queue. keeps updateIfNeeded from eating all the CPU
     NSMutableIndexSet *_dirtyPIDsLQ;  // _lockQueue
     BOOL _forcingLQ;
+
+    // When updating incrementally, these replace _collectionLQ. Maps a tracked PID to a collection
+    // holding just its subtree (plus its parent). _lockQueue
+    NSMutableDictionary<NSNumber *, iTermProcessCollection *> *_subtreesLQ;
+    // Tracked PIDs whose subtrees must be rescanned at the next update. _lockQueue
+    NSMutableIndexSet *_staleRootsLQ;
+}
+
+// Rather than enumerating every process on the system, rescan only the subtrees of tracked
+// processes, and when process monitors are on only those that reported fork, exec, signal, or
+// exit.
++ (BOOL)updatesIncrementally {
+    static BOOL enabled;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        enabled = [iTermAdvancedSettingsModel incrementalProcessCacheUpdates];
+    });
+    return enabled;
 }
 
 + (instancetype)sharedInstance {
@@ -52,6 +72,8 @@
                                                   minimumInterval:0.5];
         _trackedPidsLQ = [NSMutableDictionary dictionary];
         _dirtyPIDsLQ = [NSMutableIndexSet indexSet];
+        _subtreesLQ = [NSMutableDictionary dictionary];
+        _staleRootsLQ = [NSMutableIndexSet indexSet];
         [self setNeedsUpdate:YES];
         _blocksLQ = [NSMutableArray array];
         [[NSNotificationCenter defaultCenter] addObserver:self
@@ -73,6 +95,12 @@
     DLog(@"setNeedsUpdate:%@", @(needsUpdate));
     dispatch_sync(_lockQueue, ^{
         self->_needsUpdateFlagLQ = needsUpdate;
+        if (needsUpdate &&
+            [iTermProcessCache updatesIncrementally] &&
+            ![iTermAdvancedSettingsModel fastForegroundJobUpdates]) {
+            // Without process monitors nothing says which subtrees changed.
+            [self markAllRootsStaleLQ];
+        }
     });
     if (needsUpdate) {
         [_rateLimit performRateLimitedSelector:@selector(updateIfNeeded) onTarget:self withObject:nil];
@@ -139,7 +167,11 @@
 - (iTermProcessInfo *)processInfoForPid:(pid_t)pid {
     __block iTermProcessInfo *info = nil;
     dispatch_sync(_lockQueue, ^{
-        info = [self->_collectionLQ infoForProcessID:pid];
+        if ([iTermProcessCache updatesIncrementally]) {
+            info = [self infoForProcessIDLQ:pid];
+        } else {
+            info = [self->_collectionLQ infoForProcessID:pid];
+        }
     });
     return info;
 }
@@ -162,7 +194,13 @@
                                   ^(iTermProcessMonitor * monitor, dispatch_source_proc_flags_t flags) {
             [weakSelf processMonitor:monitor didChangeFlags:flags];
         }];
-        monitor.processInfo = [self->_collectionLQ infoForProcessID:pid];
+        if ([iTermProcessCache updatesIncrementally]) {
+            // Its subtree gets scanned at the next update.
+            [self->_staleRootsLQ addIndex:pid];
+            self->_needsUpdateFlagLQ = YES;
+        } else {
+            monitor.processInfo = [self->_collectionLQ infoForProcessID:pid];
+        }
         self->_trackedPidsLQ[@(pid)] = monitor;
     });
 }
@@ -171,6 +209,9 @@
 - (void)processMonitor:(iTermProcessMonitor *)monitor didChangeFlags:(dispatch_source_proc_flags_t)flags {
     DLog(@"Flags changed for %@.", @(monitor.processInfo.processID));
     _needsUpdateFlagLQ = YES;
+    if ([iTermProcessCache updatesIncrementally]) {
+        [self markRootStaleForMonitorLQ:monitor];
+    }
     const BOOL wasForced = _forcingLQ;
     _forcingLQ = YES;
     if (!wasForced) {
@@ -200,6 +241,8 @@
 - (void)unregisterTrackedPID:(pid_t)pid {
     dispatch_async(_lockQueue, ^{
         [self->_trackedPidsLQ removeObjectForKey:@(pid)];
+        [self->_subtreesLQ removeObjectForKey:@(pid)];
+        [self->_staleRootsLQ removeIndex:pid];
     });
 }
 
@@ -260,6 +303,12 @@
 
 // _workQueue
 - (void)reallyUpdate {
+    const uint64_t token = iTermPerformanceCounterBegin(iTermPerformanceCounterProcessCacheRebuild);
+    if ([iTermProcessCache updatesIncrementally]) {
+        [self reallyUpdateIncrementally];
+        iTermPerformanceCounterEnd(iTermPerformanceCounterProcessCacheRebuild, token);
+        return;
+    }
     DLog(@"* DOING THE EXPENSIVE THING * Process cache reallyUpdate starting");
 
     // Do expensive stuff
@@ -281,6 +330,127 @@
             }
         }];
     });
+    iTermPerformanceCounterEnd(iTermPerformanceCounterProcessCacheRebuild, token);
+}
+
+#pragma mark - Incremental Updates
+
+// _workQueue
++ (iTermProcessCollection *)newProcessCollectionForRoot:(pid_t)root {
+    iTermProcessCollection *collection = [[iTermProcessCollection alloc] init];
+    const pid_t ppid = [iTermLSOF ppidForPid:root];
+    if (!ppid) {
+        DLog(@"Tracked process %@ is gone", @(root));
+        [collection commit];
+        return collection;
+    }
+    // Include the parent so the root knows what launched it (e.g., login), as it would in a
+    // collection of every process.
+    [collection addProcessWithProcessID:ppid parentProcessID:[iTermLSOF ppidForPid:ppid]];
+    [collection addProcessWithProcessID:root parentProcessID:ppid];
+
+    NSMutableIndexSet *visited = [NSMutableIndexSet indexSetWithIndex:root];
+    NSMutableArray<NSNumber *> *queue = [NSMutableArray arrayWithObject:@(root)];
+    while (queue.count > 0) {
+        const pid_t pid = queue.firstObject.intValue;
+        [queue removeObjectAtIndex:0];
+        for (NSNumber *childNumber in [iTermLSOF childPidsForPid:pid]) {
+            const pid_t child = childNumber.intValue;
+            if ([visited containsIndex:child]) {
+                continue;
+            }
+            [visited addIndex:child];
+            [collection addProcessWithProcessID:child parentProcessID:pid];
+            [queue addObject:childNumber];
+        }
+    }
+    [collection commit];
+    return collection;
+}
+
+// _workQueue
+- (void)reallyUpdateIncrementally {
+    __block NSDictionary<NSNumber *, iTermProcessCollection *> *subtrees;
+    __block NSIndexSet *staleRoots;
+    __block NSArray<NSNumber *> *roots;
+    dispatch_sync(_lockQueue, ^{
+        subtrees = [self->_subtreesLQ copy];
+        staleRoots = [self->_staleRootsLQ copy];
+        [self->_staleRootsLQ removeAllIndexes];
+        roots = self->_trackedPidsLQ.allKeys;
+    });
+    DLog(@"Process cache incremental update of %@ of %@ tracked processes", @(staleRoots.count), @(roots.count));
+
+    NSMutableDictionary<NSNumber *, iTermProcessCollection *> *updatedSubtrees = [NSMutableDictionary dictionary];
+    NSMutableDictionary<NSNumber *, iTermProcessInfo *> *cachedDeepestForegroundJob = [NSMutableDictionary dictionary];
+    for (NSNumber *root in roots) {
+        iTermProcessCollection *collection = subtrees[root];
+        if (!collection || [staleRoots containsIndex:root.intValue]) {
+            collection = [self.class newProcessCollectionForRoot:root.intValue];
+        }
+        updatedSubtrees[root] = collection;
+        iTermProcessInfo *info = [collection infoForProcessID:root.intValue].deepestForegroundJob;
+        if (info) {
+            cachedDeepestForegroundJob[root] = info;
+        }
+    }
+
+    dispatch_sync(_lockQueue, ^{
+        self->_cachedDeepestForegroundJobLQ = cachedDeepestForegroundJob;
+        [self->_subtreesLQ removeAllObjects];
+        [updatedSubtrees enumerateKeysAndObjectsUsingBlock:^(NSNumber * _Nonnull key, iTermProcessCollection * _Nonnull collection, BOOL * _Nonnull stop) {
+            iTermProcessMonitor *monitor = self->_trackedPidsLQ[key];
+            if (!monitor) {
+                // Unregistered while updating.
+                return;
+            }
+            self->_subtreesLQ[key] = collection;
+            iTermProcessInfo *info = [collection infoForProcessID:key.intValue];
+            if ([monitor setProcessInfo:info]) {
+                DLog(@"%@ changed! Set dirty", @(info.processID));
+                [self->_dirtyPIDsLQ addIndex:key.intValue];
+            }
+        }];
+        // Something may have become stale while updating.
+        self->_needsUpdateFlagLQ = self->_staleRootsLQ.count > 0;
+    });
+}
+
+// _lockQueue
+- (iTermProcessInfo *)infoForProcessIDLQ:(pid_t)pid {
+    iTermProcessInfo *info = [_subtreesLQ[@(pid)] infoForProcessID:pid];
+    if (info) {
+        return info;
+    }
+    for (iTermProcessCollection *collection in _subtreesLQ.allValues) {
+        info = [collection infoForProcessID:pid];
+        if (info) {
+            return info;
+        }
+    }
+    return nil;
+}
+
+// _lockQueue
+- (void)markAllRootsStaleLQ {
+    [_trackedPidsLQ enumerateKeysAndObjectsUsingBlock:^(NSNumber * _Nonnull key, iTermProcessMonitor * _Nonnull obj, BOOL * _Nonnull stop) {
+        [self->_staleRootsLQ addIndex:key.intValue];
+    }];
+}
+
+// _lockQueue
+- (void)markRootStaleForMonitorLQ:(iTermProcessMonitor *)monitor {
+    iTermProcessMonitor *root = monitor;
+    while (root.parent) {
+        root = root.parent;
+    }
+    [_trackedPidsLQ enumerateKeysAndObjectsUsingBlock:^(NSNumber * _Nonnull key, iTermProcessMonitor * _Nonnull obj, BOOL * _Nonnull stop) {
+        if (obj == root) {
+            DLog(@"Subtree of %@ is stale", key);
+            [self->_staleRootsLQ addIndex:key.intValue];
+            *stop = YES;
+        }
+    }];
 }
 
 #pragma mark - Notifications
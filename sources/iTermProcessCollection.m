@@ -6,17 +6,70 @@
 //
 //
 
+#import "iTermAdvancedSettingsModel.h"
 #import "iTermLSOF.h"
 #import "iTermProcessCollection.h"
 #import "NSArray+iTerm.h"
 #import "NSObject+iTerm.h"
 
+#import <QuartzCore/QuartzCore.h>
+
 @interface iTermProcessInfoLock : NSObject
 @end
 
 @implementation iTermProcessInfoLock
 @end
 
+@interface iTermProcessArgumentsCacheEntry : NSObject
+@property (nonatomic, readonly) NSArray<NSString *> *argv;
+@property (nonatomic, readonly) CFTimeInterval timestamp;
+@end
+
+@implementation iTermProcessArgumentsCacheEntry
+
+- (instancetype)initWithArgv:(NSArray<NSString *> *)argv {
+    self = [super init];
+    if (self) {
+        _argv = [argv copy];
+        _timestamp = CACurrentMediaTime();
+    }
+    return self;
+}
+
+@end
+
+// Each process cache update makes new iTermProcessInfos, so without this the arguments of every
+// foreground job would be fetched with KERN_PROCARGS2 again each time a title is computed. Keyed
+// by pid, fork time, and name so that neither pid reuse nor exec gets a stale result. Entries
+// expire because setproctitle can change argv in place.
+static NSArray<NSString *> *iTermProcessArguments(pid_t pid, struct timeval startTime, NSString *name) {
+    static BOOL enabled;
+    static NSCache<NSString *, iTermProcessArgumentsCacheEntry *> *cache;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        enabled = [iTermAdvancedSettingsModel cacheProcessArguments];
+        cache = [[NSCache alloc] init];
+        cache.countLimit = 1024;
+    });
+    if (!enabled || (startTime.tv_sec == 0 && startTime.tv_usec == 0)) {
+        return [iTermLSOF commandLineArgumentsForProcess:pid execName:NULL];
+    }
+    const CFTimeInterval ttl = 5;
+    NSString *key = [NSString stringWithFormat:@"%d.%ld.%d.%@",
+                     pid, (long)startTime.tv_sec, (int)startTime.tv_usec, name];
+    iTermProcessArgumentsCacheEntry *entry = [cache objectForKey:key];
+    if (entry && CACurrentMediaTime() - entry.timestamp < ttl) {
+        return entry.argv;
+    }
+    NSArray<NSString *> *argv = [iTermLSOF commandLineArgumentsForProcess:pid execName:NULL];
+    if (argv) {
+        [cache setObject:[[iTermProcessArgumentsCacheEntry alloc] initWithArgv:argv] forKey:key];
+    } else {
+        [cache removeObjectForKey:key];
+    }
+    return argv;
+}
+
 @interface iTermProcessInfo()
 @property(nonatomic, weak, readwrite) iTermProcessInfo *parent;
 @property(atomic, copy) NSString *nameValue;
@@ -209,10 +262,13 @@
 - (void)doSlowLookup {
     if ([self shouldInitialize]) {
         BOOL fg = NO;
-        self.nameValue = [iTermLSOF nameOfProcessWithPid:self->_processID isForeground:&fg];
+        struct timeval startTime = { 0 };
+        self.nameValue = [iTermLSOF nameOfProcessWithPid:self->_processID
+                                            isForeground:&fg
+                                               startTime:&startTime];
         if (fg || [self.parent.name isEqualToString:@"login"] || !self.parent) {
             // Full command line with hacked command name.
-            NSArray<NSString *> *argv = [iTermLSOF commandLineArgumentsForProcess:self->_processID execName:NULL];
+            NSArray<NSString *> *argv = iTermProcessArguments(self->_processID, startTime, self.nameValue);
             self.commandLineValue = [argv componentsJoinedByString:@" "];
             if (argv.firstObject.length) {
                 self.argv0Value = argv[0];
@@ -251,7 +307,9 @@
     static dispatch_queue_t queue;
     static dispatch_once_t onceToken;
     dispatch_once(&onceToken, ^{
-        queue = dispatch_queue_create("com.iterm2.pid-lookup", DISPATCH_QUEUE_SERIAL);
+        // Lookups are independent since each is guarded by -shouldInitialize.
+        queue = dispatch_queue_create("com.iterm2.pid-lookup",
+                                      [iTermAdvancedSettingsModel cacheProcessArguments] ? DISPATCH_QUEUE_CONCURRENT : DISPATCH_QUEUE_SERIAL);
     });
     dispatch_async(queue, ^{
         [self doSlowLookup];
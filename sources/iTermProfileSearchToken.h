@@ -17,4 +17,8 @@
 - (BOOL)matchesAnyWordInNameWords:(NSArray *)nameWords;
 - (BOOL)matchesAnyWordInTagWords:(NSArray *)tagWords;
 
+// Returns YES if any list of words that |other| matches is also matched by the receiver, as when
+// |other| comes from typing more characters after the receiver's phrase.
+- (BOOL)isNarrowedBy:(iTermProfileSearchToken *)other;
+
 @end
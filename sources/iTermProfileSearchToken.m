@@ -89,6 +89,22 @@ static NSString *const kTitleRestrictionOperator = @"name:";
   return [self matchesAnyWordInWords:tagWords];
 }
 
+- (BOOL)isNarrowedBy:(iTermProfileSearchToken *)other {
+  if (!(_operator == other.operator || [_operator isEqualToString:other.operator])) {
+    return NO;
+  }
+  if (_anchorStart != other.anchorStart) {
+    return NO;
+  }
+  NSString *mine = [_strings componentsJoinedByString:@" "];
+  NSString *theirs = [other.strings componentsJoinedByString:@" "];
+  if (_anchorEnd) {
+    return other.anchorEnd && [mine isEqualToString:theirs];
+  }
+  // Wherever |theirs| occurs, its prefix |mine| occurs too and spans no more words.
+  return [theirs hasPrefix:mine];
+}
+
 - (BOOL)matchesAnyWordInWords:(NSArray *)words {
   NSStringCompareOptions options = NSCaseInsensitiveSearch;
   if (_anchorStart) {
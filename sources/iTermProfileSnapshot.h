@@ -0,0 +1,36 @@
+//
+//  iTermProfileSnapshot.h
+//  iTerm2SharedARC
+//
+//  Created by agent on 10/14/26.
+//
+
+#import <Foundation/Foundation.h>
+
+#import "ITAddressBookMgr.h"
+#import "iTermCursor.h"
+
+// Resolved values of profile settings that are read while drawing, handling keys, or processing
+// output. A session makes one each time its profile is replaced and reads the fields directly
+// instead of going through iTermProfilePreferences, which looks up the key, falls back to the
+// default, and unboxes on every call.
+typedef struct {
+    ITermCursorType cursorType;
+    iTermTimestampsMode timestampsMode;
+    BOOL showMarkIndicators;
+    BOOL reduceFlicker;
+    BOOL placePromptAtFirstColumn;
+    BOOL sendTerminalGeneratedAlert;
+    BOOL enableTriggersInInteractiveApps;
+    CGFloat badgeTopMargin;
+    CGFloat badgeRightMargin;
+
+    // These hold the profile's own values, without defaults, as the option key handling expects.
+    iTermOptionKeyBehavior leftOptionKey;
+    iTermOptionKeyBehavior rightOptionKey;
+    BOOL hasRightOptionKey;
+    BOOL leftOptionKeyChangeable;
+    BOOL rightOptionKeyChangeable;
+} iTermProfileSnapshot;
+
+iTermProfileSnapshot iTermProfileSnapshotMake(Profile *profile);
@@ -0,0 +1,31 @@
+//
+//  iTermProfileSnapshot.m
+//  iTerm2SharedARC
+//
+//  Created by agent on 10/14/26.
+//
+
+#import "iTermProfileSnapshot.h"
+
+#import "iTermProfilePreferences.h"
+
+iTermProfileSnapshot iTermProfileSnapshotMake(Profile *profile) {
+    NSNumber *rightOptionKey = profile[KEY_RIGHT_OPTION_KEY_SENDS];
+    return (iTermProfileSnapshot) {
+        .cursorType = [iTermProfilePreferences intForKey:KEY_CURSOR_TYPE inProfile:profile],
+        .timestampsMode = (iTermTimestampsMode)[iTermProfilePreferences unsignedIntegerForKey:KEY_SHOW_TIMESTAMPS inProfile:profile],
+        .showMarkIndicators = [iTermProfilePreferences boolForKey:KEY_SHOW_MARK_INDICATORS inProfile:profile],
+        .reduceFlicker = [iTermProfilePreferences boolForKey:KEY_REDUCE_FLICKER inProfile:profile],
+        .placePromptAtFirstColumn = [iTermProfilePreferences boolForKey:KEY_PLACE_PROMPT_AT_FIRST_COLUMN inProfile:profile],
+        .sendTerminalGeneratedAlert = [iTermProfilePreferences boolForKey:KEY_SEND_TERMINAL_GENERATED_ALERT inProfile:profile],
+        .enableTriggersInInteractiveApps = [iTermProfilePreferences boolForKey:KEY_ENABLE_TRIGGERS_IN_INTERACTIVE_APPS inProfile:profile],
+        .badgeTopMargin = [iTermProfilePreferences floatForKey:KEY_BADGE_TOP_MARGIN inProfile:profile],
+        .badgeRightMargin = [iTermProfilePreferences floatForKey:KEY_BADGE_RIGHT_MARGIN inProfile:profile],
+
+        .leftOptionKey = [profile[KEY_OPTION_KEY_SENDS] intValue],
+        .rightOptionKey = [rightOptionKey intValue],
+        .hasRightOptionKey = rightOptionKey != nil,
+        .leftOptionKeyChangeable = [iTermProfilePreferences boolForKey:KEY_LEFT_OPTION_KEY_CHANGEABLE inProfile:profile],
+        .rightOptionKeyChangeable = [iTermProfilePreferences boolForKey:KEY_RIGHT_OPTION_KEY_CHANGEABLE inProfile:profile],
+    };
+}
@@ -0,0 +1,70 @@
+//
+//  iTermPtyCapture.h
+//  iTerm2SharedARC
+//
+//  Created by agent on 10/14/26.
+//
+
+#import <Foundation/Foundation.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+// A capture is a compact binary file of everything that went between a session and its pty, with
+// timestamps, so a performance problem can be reproduced byte for byte. It begins with a 4 byte
+// magic number. Each record that follows is a type byte, the time since the previous record in
+// microseconds as a varint, a payload length as a varint, and the payload. A size record's payload
+// is the width and height as varints.
+//
+// Captures include whatever the user typed, passwords included, so they're only readable by the
+// user who made them.
+typedef NS_ENUM(uint8_t, iTermPtyCaptureRecordType) {
+    // Bytes read from the pty.
+    iTermPtyCaptureRecordTypeOutput = 1,
+    // Bytes written to the pty.
+    iTermPtyCaptureRecordTypeInput = 2,
+    // The window size changed.
+    iTermPtyCaptureRecordTypeSize = 3
+};
+
+// All methods may be called from any thread. Records are written in the order they're made.
+@interface iTermPtyCaptureWriter : NSObject
+
+@property (nonatomic, readonly) NSString *path;
+
+// Returns nil if the file can't be created.
+- (nullable instancetype)initWithPath:(NSString *)path NS_DESIGNATED_INITIALIZER;
+- (instancetype)init NS_UNAVAILABLE;
+
+- (void)recordOutput:(const char *)bytes length:(int)length;
+- (void)recordInput:(NSData *)data;
+- (void)recordWidth:(int)width height:(int)height;
+
+// Flushes and closes the file. Later records are dropped.
+- (void)close;
+
+@end
+
+@interface iTermPtyCaptureReader : NSObject
+
+// Returns nil if the file is missing or not a capture.
+- (nullable instancetype)initWithPath:(NSString *)path;
+- (nullable instancetype)initWithData:(NSData *)data NS_DESIGNATED_INITIALIZER;
+- (instancetype)init NS_UNAVAILABLE;
+
++ (BOOL)dataIsCapture:(NSData *)data;
+
+// |delay| is the time since the previous record. For size records, |payload| is ignored and
+// |width| and |height| are set; otherwise they are 0. Stops early if the file is truncated.
+- (void)enumerateRecordsUsingBlock:(void (^ NS_NOESCAPE)(iTermPtyCaptureRecordType type,
+                                                         NSTimeInterval delay,
+                                                         NSData *payload,
+                                                         int width,
+                                                         int height,
+                                                         BOOL *stop))block;
+
+// All output records concatenated.
+- (NSData *)output;
+
+@end
+
+NS_ASSUME_NONNULL_END
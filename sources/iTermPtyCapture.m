@@ -0,0 +1,210 @@
+//
+//  iTermPtyCapture.m
+//  iTerm2SharedARC
+//
+//  Created by agent on 10/14/26.
+//
+
+#import "iTermPtyCapture.h"
+
+#import "DebugLogging.h"
+#import "NSDate+iTerm.h"
+
+#include <fcntl.h>
+#include <stdio.h>
+
+static const uint32_t iTermPtyCaptureMagic = 'iPC1';
+
+static size_t iTermPtyCaptureEncodeVarint(uint64_t value, uint8_t *buffer) {
+    size_t i = 0;
+    while (value >= 0x80) {
+        buffer[i++] = (value & 0x7f) | 0x80;
+        value >>= 7;
+    }
+    buffer[i++] = value;
+    return i;
+}
+
+// Returns NO if the varint runs past the end.
+static BOOL iTermPtyCaptureDecodeVarint(const uint8_t *bytes, size_t length, size_t *offset, uint64_t *value) {
+    uint64_t result = 0;
+    for (int shift = 0; shift < 64 && *offset < length; shift += 7) {
+        const uint8_t byte = bytes[(*offset)++];
+        result |= (uint64_t)(byte & 0x7f) << shift;
+        if (!(byte & 0x80)) {
+            *value = result;
+            return YES;
+        }
+    }
+    return NO;
+}
+
+@implementation iTermPtyCaptureWriter {
+    dispatch_queue_t _queue;
+    // Only accessed on _queue. NULL after closing.
+    FILE *_file;
+    // Time of the last record made. Guarded by @synchronized(self) so timestamps and order agree.
+    NSTimeInterval _lastTime;
+}
+
+- (nullable instancetype)initWithPath:(NSString *)path {
+    self = [super init];
+    if (self) {
+        const int fd = open(path.fileSystemRepresentation, O_WRONLY | O_CREAT | O_TRUNC, 0600);
+        if (fd < 0) {
+            DLog(@"Failed to create capture at %@: %s", path, strerror(errno));
+            return nil;
+        }
+        _file = fdopen(fd, "w");
+        if (!_file) {
+            close(fd);
+            return nil;
+        }
+        _path = [path copy];
+        _queue = dispatch_queue_create("com.iterm2.pty-capture", DISPATCH_QUEUE_SERIAL);
+        _lastTime = [NSDate it_timeSinceBoot];
+        const uint32_t magic = iTermPtyCaptureMagic;
+        fwrite(&magic, sizeof(magic), 1, _file);
+    }
+    return self;
+}
+
+- (void)dealloc {
+    if (_file) {
+        fclose(_file);
+    }
+}
+
+- (void)recordOutput:(const char *)bytes length:(int)length {
+    [self addRecordOfType:iTermPtyCaptureRecordTypeOutput payload:[NSData dataWithBytes:bytes length:length]];
+}
+
+- (void)recordInput:(NSData *)data {
+    [self addRecordOfType:iTermPtyCaptureRecordTypeInput payload:[data copy]];
+}
+
+- (void)recordWidth:(int)width height:(int)height {
+    uint8_t buffer[20];
+    size_t length = iTermPtyCaptureEncodeVarint(MAX(0, width), buffer);
+    length += iTermPtyCaptureEncodeVarint(MAX(0, height), buffer + length);
+    [self addRecordOfType:iTermPtyCaptureRecordTypeSize payload:[NSData dataWithBytes:buffer length:length]];
+}
+
+- (void)close {
+    dispatch_sync(_queue, ^{
+        if (self->_file) {
+            fclose(self->_file);
+            self->_file = NULL;
+        }
+    });
+}
+
+#pragma mark - Private
+
+- (void)addRecordOfType:(iTermPtyCaptureRecordType)type payload:(NSData *)payload {
+    @synchronized (self) {
+        const NSTimeInterval now = [NSDate it_timeSinceBoot];
+        const uint64_t delay = (uint64_t)(MAX(0, now - _lastTime) * 1000000.0);
+        _lastTime = now;
+        dispatch_async(_queue, ^{
+            [self writeRecordOfType:type delay:delay payload:payload];
+        });
+    }
+}
+
+- (void)writeRecordOfType:(iTermPtyCaptureRecordType)type delay:(uint64_t)delay payload:(NSData *)payload {
+    if (!_file) {
+        return;
+    }
+    uint8_t header[21];
+    size_t length = 0;
+    header[length++] = type;
+    length += iTermPtyCaptureEncodeVarint(delay, header + length);
+    length += iTermPtyCaptureEncodeVarint(payload.length, header + length);
+    fwrite(header, 1, length, _file);
+    fwrite(payload.bytes, 1, payload.length, _file);
+}
+
+@end
+
+@implementation iTermPtyCaptureReader {
+    NSData *_data;
+}
+
++ (BOOL)dataIsCapture:(NSData *)data {
+    uint32_t magic = 0;
+    if (data.length < sizeof(magic)) {
+        return NO;
+    }
+    memcpy(&magic, data.bytes, sizeof(magic));
+    return magic == iTermPtyCaptureMagic;
+}
+
+- (nullable instancetype)initWithPath:(NSString *)path {
+    NSData *data = [NSData dataWithContentsOfFile:path options:NSDataReadingMappedIfSafe error:nil];
+    if (!data) {
+        return nil;
+    }
+    return [self initWithData:data];
+}
+
+- (nullable instancetype)initWithData:(NSData *)data {
+    if (![iTermPtyCaptureReader dataIsCapture:data]) {
+        return nil;
+    }
+    self = [super init];
+    if (self) {
+        _data = data;
+    }
+    return self;
+}
+
+- (void)enumerateRecordsUsingBlock:(void (^ NS_NOESCAPE)(iTermPtyCaptureRecordType type,
+                                                         NSTimeInterval delay,
+                                                         NSData *payload,
+                                                         int width,
+                                                         int height,
+                                                         BOOL *stop))block {
+    const uint8_t *bytes = _data.bytes;
+    const size_t length = _data.length;
+    size_t offset = sizeof(uint32_t);
+    BOOL stop = NO;
+    while (offset < length && !stop) {
+        const iTermPtyCaptureRecordType type = bytes[offset++];
+        uint64_t delay = 0;
+        uint64_t payloadLength = 0;
+        if (!iTermPtyCaptureDecodeVarint(bytes, length, &offset, &delay) ||
+            !iTermPtyCaptureDecodeVarint(bytes, length, &offset, &payloadLength) ||
+            payloadLength > length - offset) {
+            DLog(@"Capture is truncated at offset %@", @(offset));
+            return;
+        }
+        NSData *payload = [_data subdataWithRange:NSMakeRange(offset, payloadLength)];
+        uint64_t width = 0;
+        uint64_t height = 0;
+        if (type == iTermPtyCaptureRecordTypeSize) {
+            size_t sizeOffset = 0;
+            iTermPtyCaptureDecodeVarint(payload.bytes, payload.length, &sizeOffset, &width);
+            iTermPtyCaptureDecodeVarint(payload.bytes, payload.length, &sizeOffset, &height);
+        }
+        offset += payloadLength;
+        block(type, delay / 1000000.0, payload, (int)width, (int)height, &stop);
+    }
+}
+
+- (NSData *)output {
+    NSMutableData *output = [NSMutableData data];
+    [self enumerateRecordsUsingBlock:^(iTermPtyCaptureRecordType type,
+                                       NSTimeInterval delay,
+                                       NSData *payload,
+                                       int width,
+                                       int height,
+                                       BOOL *stop) {
+        if (type == iTermPtyCaptureRecordTypeOutput) {
+            [output appendData:payload];
+        }
+    }];
+    return output;
+}
+
+@end
@@ -0,0 +1,33 @@
+//
+//  iTermRecentDirectoryIndex.h
+//  iTerm2
+//
+//  Created by agent on 10/14/26.
+//
+
+#import <Foundation/Foundation.h>
+
+@class iTermRecentDirectoryMO;
+
+NS_ASSUME_NONNULL_BEGIN
+
+// One host's recent directories, kept in score order (see -[iTermRecentDirectoryMO compare:]) and
+// by path. A directory's score depends only on its own use count, last use, and star, so a use
+// moves just that directory instead of requiring everything to be sorted again.
+@interface iTermRecentDirectoryIndex : NSObject
+
+@property (nonatomic, readonly) NSArray<iTermRecentDirectoryMO *> *sortedDirectories;
+
+- (instancetype)initWithDirectories:(NSArray<iTermRecentDirectoryMO *> *)directories NS_DESIGNATED_INITIALIZER;
+- (instancetype)init NS_UNAVAILABLE;
+
+- (nullable iTermRecentDirectoryMO *)directoryWithPath:(NSString *)path;
+
+- (void)addDirectory:(iTermRecentDirectoryMO *)directory;
+
+// Call this before changing anything that affects the directory's score and add it back after.
+- (void)removeDirectory:(iTermRecentDirectoryMO *)directory;
+
+@end
+
+NS_ASSUME_NONNULL_END
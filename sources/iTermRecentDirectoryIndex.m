@@ -0,0 +1,88 @@
+//
+//  iTermRecentDirectoryIndex.m
+//  iTerm2
+//
+//  Created by agent on 10/14/26.
+//
+
+#import "iTermRecentDirectoryIndex.h"
+
+#import "iTermRecentDirectoryMO.h"
+#import "iTermRecentDirectoryMO+Additions.h"
+
+@implementation iTermRecentDirectoryIndex {
+    NSMutableArray<iTermRecentDirectoryMO *> *_sorted;
+    NSMutableDictionary<NSString *, iTermRecentDirectoryMO *> *_byPath;
+}
+
+- (instancetype)initWithDirectories:(NSArray<iTermRecentDirectoryMO *> *)directories {
+    self = [super init];
+    if (self) {
+        _sorted = [[directories sortedArrayUsingSelector:@selector(compare:)] mutableCopy];
+        _byPath = [[NSMutableDictionary alloc] initWithCapacity:directories.count];
+        for (iTermRecentDirectoryMO *directory in directories) {
+            if (directory.path) {
+                _byPath[directory.path] = directory;
+            }
+        }
+    }
+    return self;
+}
+
+- (void)dealloc {
+    [_sorted release];
+    [_byPath release];
+    [super dealloc];
+}
+
+- (NSArray<iTermRecentDirectoryMO *> *)sortedDirectories {
+    return [[_sorted copy] autorelease];
+}
+
+- (iTermRecentDirectoryMO *)directoryWithPath:(NSString *)path {
+    return _byPath[path];
+}
+
+- (void)addDirectory:(iTermRecentDirectoryMO *)directory {
+    const NSUInteger index = [self insertionIndexForDirectory:directory];
+    [_sorted insertObject:directory atIndex:index];
+    if (directory.path) {
+        _byPath[directory.path] = directory;
+    }
+}
+
+- (void)removeDirectory:(iTermRecentDirectoryMO *)directory {
+    // Equal scores are adjacent so look for this exact object among them.
+    NSUInteger index = [self insertionIndexForDirectory:directory];
+    while (index < _sorted.count && _sorted[index] != directory) {
+        if ([_sorted[index] compare:directory] != NSOrderedSame) {
+            index = NSNotFound;
+            break;
+        }
+        index++;
+    }
+    if (index == NSNotFound || index >= _sorted.count) {
+        // Its score was changed without removing it first.
+        index = [_sorted indexOfObjectIdenticalTo:directory];
+    }
+    if (index != NSNotFound) {
+        [_sorted removeObjectAtIndex:index];
+    }
+    if (directory.path) {
+        [_byPath removeObjectForKey:directory.path];
+    }
+}
+
+#pragma mark - Private
+
+// The index of the first directory that doesn't score higher than |directory|.
+- (NSUInteger)insertionIndexForDirectory:(iTermRecentDirectoryMO *)directory {
+    return [_sorted indexOfObject:directory
+                    inSortedRange:NSMakeRange(0, _sorted.count)
+                          options:NSBinarySearchingInsertionIndex | NSBinarySearchingFirstEqual
+                  usingComparator:^NSComparisonResult(iTermRecentDirectoryMO *lhs, iTermRecentDirectoryMO *rhs) {
+        return [lhs compare:rhs];
+    }];
+}
+
+@end
@@ -14,6 +14,9 @@
 + (NSString *)entityName;
 + (instancetype)entryWithDictionary:(NSDictionary *)dictionary
                           inContext:(NSManagedObjectContext *)context;
+
+// Sorts from highest to lowest score.
+- (NSComparisonResult)compare:(iTermRecentDirectoryMO *)other;
 - (NSAttributedString *)attributedStringForTableColumn:(NSTableColumn *)aTableColumn
                             abbreviationSafeComponents:(NSIndexSet *)abbreviationSafeIndexes;
 
@@ -0,0 +1,20 @@
+//
+//  iTermRegexLiteral.h
+//  iTerm2SharedARC
+//
+//  Created by agent on 10/14/26.
+//
+
+#import <Foundation/Foundation.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+// Conservatively finds the longest literal that every match of |regex| must contain. Only
+// top-level literals are considered and anything unusual (alternation, inline flags, quoting, an
+// unfamiliar escape or a malformed interval) gives up. Escapes that take an argument, like \x1b or
+// \p{Lu}, are never literals, and an atom followed by an interval is treated as optional. A
+// surrogate pair is one atom. If |caseInsensitive| is set the literal is lowercased and only ASCII
+// characters are used. Returns nil if there is no literal of at least two characters.
+NSString * _Nullable iTermRegexRequiredLiteral(NSString *regex, BOOL caseInsensitive);
+
+NS_ASSUME_NONNULL_END
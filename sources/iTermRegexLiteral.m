@@ -0,0 +1,297 @@
+//
+//  iTermRegexLiteral.m
+//  iTerm2SharedARC
+//
+//  Created by agent on 10/14/26.
+//
+
+#import "iTermRegexLiteral.h"
+
+#import "iTermMalloc.h"
+
+static BOOL iTermRegexCharacterIsQuantifier(unichar c) {
+    return c == '?' || c == '*' || c == '+' || c == '{';
+}
+
+static BOOL iTermRegexCharacterIsDigit(unichar c, int base) {
+    if (base == 8) {
+        return c >= '0' && c <= '7';
+    }
+    if (base == 16) {
+        return c < 0x80 && isxdigit(c);
+    }
+    return c >= '0' && c <= '9';
+}
+
+// Returns the index after the characters starting at |i| that are digits in |base|, consuming at
+// most |maximum| of them.
+static NSUInteger iTermRegexSkipDigits(const unichar *chars, NSUInteger length, NSUInteger i, int base, NSUInteger maximum) {
+    const NSUInteger limit = MIN(length, i + maximum);
+    while (i < limit && iTermRegexCharacterIsDigit(chars[i], base)) {
+        i++;
+    }
+    return i;
+}
+
+// Returns the index after the |close| that ends the argument starting with |open| at |i|, or
+// NSNotFound if it is not terminated.
+static NSUInteger iTermRegexSkipDelimited(const unichar *chars, NSUInteger length, NSUInteger i, unichar close) {
+    for (NSUInteger j = i + 1; j < length; j++) {
+        if (chars[j] == close) {
+            return j + 1;
+        }
+    }
+    return NSNotFound;
+}
+
+// |i| is the index of a {. Returns the index after an interval like {3}, {3,} or {3,5}, or
+// NSNotFound if it isn't one.
+static NSUInteger iTermRegexSkipInterval(const unichar *chars, NSUInteger length, NSUInteger i) {
+    NSUInteger j = iTermRegexSkipDigits(chars, length, i + 1, 10, length);
+    if (j == i + 1) {
+        return NSNotFound;
+    }
+    if (j < length && chars[j] == ',') {
+        j = iTermRegexSkipDigits(chars, length, j + 1, 10, length);
+    }
+    if (j < length && chars[j] == '}') {
+        return j + 1;
+    }
+    return NSNotFound;
+}
+
+// |i| is the index of a [. Returns the index after the set, which may contain nested sets, or
+// NSNotFound if it is not terminated.
+static NSUInteger iTermRegexSkipSet(const unichar *chars, NSUInteger length, NSUInteger i) {
+    int depth = 0;
+    while (i < length) {
+        if (chars[i] == '[') {
+            depth++;
+            i++;
+            if (i < length && chars[i] == '^') {
+                i++;
+            }
+            if (i < length && chars[i] == ']') {
+                // A ] right after the opening bracket is a member.
+                i++;
+            }
+            continue;
+        }
+        if (chars[i] == '\\') {
+            i += 2;
+            continue;
+        }
+        if (chars[i] == ']') {
+            depth--;
+            i++;
+            if (depth == 0) {
+                return i;
+            }
+            continue;
+        }
+        i++;
+    }
+    return NSNotFound;
+}
+
+// |i| is the index of a backslash followed by an ASCII letter or digit. Returns the index after
+// the escape including its argument (as in \x{263a}, \p{Lu}, \0101, or \cX), or NSNotFound if it
+// is malformed or unfamiliar. None of these escapes is a literal character the prefilter can use.
+static NSUInteger iTermRegexSkipAlphanumericEscape(const unichar *chars, NSUInteger length, NSUInteger i) {
+    const NSUInteger argument = i + 2;
+    const unichar escaped = chars[i + 1];
+    switch (escaped) {
+        case 'x':
+            if (argument < length && chars[argument] == '{') {
+                return iTermRegexSkipDelimited(chars, length, argument, '}');
+            }
+            return iTermRegexSkipDigits(chars, length, argument, 16, 2);
+        case 'u':
+            return iTermRegexSkipDigits(chars, length, argument, 16, 4);
+        case 'U':
+            return iTermRegexSkipDigits(chars, length, argument, 16, 8);
+        case '0':
+            return iTermRegexSkipDigits(chars, length, argument, 8, 3);
+        case 'c':
+            return argument < length ? argument + 1 : NSNotFound;
+        case 'p':
+        case 'P':
+            if (argument < length && chars[argument] == '{') {
+                return iTermRegexSkipDelimited(chars, length, argument, '}');
+            }
+            return argument < length ? argument + 1 : NSNotFound;
+        case 'N':
+            if (argument < length && chars[argument] == '{') {
+                return iTermRegexSkipDelimited(chars, length, argument, '}');
+            }
+            return NSNotFound;
+        case 'k':
+            if (argument < length && chars[argument] == '<') {
+                return iTermRegexSkipDelimited(chars, length, argument, '>');
+            }
+            return NSNotFound;
+        case 'Q':
+        case 'E':
+            // Quoting is too much trouble to follow.
+            return NSNotFound;
+    }
+    if (escaped >= '1' && escaped <= '9') {
+        // A back reference.
+        return iTermRegexSkipDigits(chars, length, argument, 10, length);
+    }
+    // Classes like \d and \w, anchors like \b and \z, and control characters like \t and \e
+    // take no argument.
+    return argument;
+}
+
+NSString *iTermRegexRequiredLiteral(NSString *regex, BOOL caseInsensitive) {
+    const NSUInteger length = regex.length;
+    if (length < 2) {
+        return nil;
+    }
+    unichar *chars = iTermMalloc(sizeof(unichar) * length);
+    [regex getCharacters:chars range:NSMakeRange(0, length)];
+
+    // Neither literal can be longer than the regex itself.
+    unichar *current = iTermMalloc(sizeof(unichar) * length);
+    NSUInteger currentLength = 0;
+    unichar *best = iTermMalloc(sizeof(unichar) * length);
+    NSUInteger bestLength = 0;
+    BOOL giveUp = NO;
+
+#define END_RUN() do { \
+    if (currentLength > bestLength) { \
+        memcpy(best, current, currentLength * sizeof(unichar)); \
+        bestLength = currentLength; \
+    } \
+    currentLength = 0; \
+} while (0)
+
+    int depth = 0;
+    NSUInteger i = 0;
+    while (i < length) {
+        const unichar c = chars[i];
+        if (c == '|') {
+            giveUp = YES;
+            break;
+        }
+        if (c == '(' && i + 1 < length && chars[i + 1] == '?') {
+            // Inline flags and lookaround can change what's required.
+            giveUp = YES;
+            break;
+        }
+        if (c == '[') {
+            END_RUN();
+            i = iTermRegexSkipSet(chars, length, i);
+            if (i == NSNotFound) {
+                giveUp = YES;
+                break;
+            }
+            continue;
+        }
+        if (c == '{') {
+            // An interval after something that isn't a literal, like a set or a group.
+            END_RUN();
+            i = iTermRegexSkipInterval(chars, length, i);
+            if (i == NSNotFound) {
+                giveUp = YES;
+                break;
+            }
+            continue;
+        }
+        if (c == '(') {
+            END_RUN();
+            depth++;
+            i++;
+            continue;
+        }
+        if (c == ')') {
+            END_RUN();
+            depth = MAX(0, depth - 1);
+            i++;
+            continue;
+        }
+
+        unichar literal = 0;
+        // Set when the atom is a surrogate pair, which is one character to the regex.
+        unichar lowSurrogate = 0;
+        NSUInteger next = i + 1;
+        if (c == '\\') {
+            if (i + 1 >= length) {
+                giveUp = YES;
+                break;
+            }
+            const unichar escaped = chars[i + 1];
+            if (escaped >= 0x80) {
+                giveUp = YES;
+                break;
+            }
+            if (isalnum(escaped)) {
+                next = iTermRegexSkipAlphanumericEscape(chars, length, i);
+                if (next == NSNotFound) {
+                    giveUp = YES;
+                    break;
+                }
+            } else {
+                next = i + 2;
+                literal = escaped;
+            }
+        } else if (c == '.' || c == '^' || c == '$' || iTermRegexCharacterIsQuantifier(c) || c == '}') {
+            literal = 0;
+        } else if (CFStringIsSurrogateHighCharacter(c)) {
+            // A quantifier after the pair applies to both halves.
+            if (i + 1 < length && CFStringIsSurrogateLowCharacter(chars[i + 1])) {
+                literal = c;
+                lowSurrogate = chars[i + 1];
+                next = i + 2;
+            }
+        } else if (CFStringIsSurrogateLowCharacter(c)) {
+            // Unpaired.
+            literal = 0;
+        } else {
+            literal = c;
+        }
+        if (caseInsensitive && literal >= 0x80) {
+            // Caseless matching of non-ASCII characters is too subtle to prefilter.
+            literal = 0;
+        }
+        if (depth > 0 || literal == 0) {
+            END_RUN();
+            i = next;
+            continue;
+        }
+        const BOOL quantified = next < length && iTermRegexCharacterIsQuantifier(chars[next]);
+        if (quantified && chars[next] == '{') {
+            // Treat an interval like {0,3} as making the atom optional.
+            END_RUN();
+            next = iTermRegexSkipInterval(chars, length, next);
+            if (next == NSNotFound) {
+                giveUp = YES;
+                break;
+            }
+        } else if (quantified && chars[next] != '+') {
+            // Optional or of unknown count.
+            END_RUN();
+        } else {
+            current[currentLength++] = caseInsensitive ? tolower(literal) : literal;
+            if (lowSurrogate) {
+                current[currentLength++] = lowSurrogate;
+            }
+            if (quantified) {
+                END_RUN();
+            }
+        }
+        i = next;
+    }
+    END_RUN();
+#undef END_RUN
+
+    NSString *result = nil;
+    if (!giveUp && bestLength >= 2) {
+        result = [NSString stringWithCharacters:best length:bestLength];
+    }
+    free(chars);
+    free(current);
+    free(best);
+    return result;
+}
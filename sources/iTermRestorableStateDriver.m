@@ -8,6 +8,7 @@
 #import "iTermRestorableStateDriver.h"
 
 #import "DebugLogging.h"
+#import "iTermPerformanceCounters.h"
 #import "iTermWarning.h"
 #import "NSArray+iTerm.h"
 
@@ -38,9 +39,11 @@ static NSString *const iTermRestorableStateControllerUserDefaultsKeyCount = @"No
         return;
     }
     __weak __typeof(self) weakSelf = self;
+    const uint64_t token = iTermPerformanceCounterBegin(iTermPerformanceCounterStateSave);
     const BOOL saved = [_saver saveSynchronously:sync withCompletion:^{
         [weakSelf didSave];
     }];
+    iTermPerformanceCounterEnd(iTermPerformanceCounterStateSave, token);
     // Do this after saveSynchronously:withCompletion:. It guarantees not to run its completion block
     // synchronously. It could fail if it was already busy saving, in which case we don't want
     // to reset _needsSave. Considering it is busy, the other guy will eventually finish and cause
@@ -0,0 +1,41 @@
+//
+//  iTermRuleIndex.h
+//  iTerm2SharedARC
+//
+//  Created by agent on 10/14/26.
+//
+
+#import <Foundation/Foundation.h>
+#import "ProfileModel.h"
+
+NS_ASSUME_NONNULL_BEGIN
+
+@class iTermRule;
+
+// Finds the profile whose automatic profile switching rule best matches a hostname, username,
+// path, and job without scoring every rule. Rules naming a hostname without wildcards are keyed by
+// that hostname, those naming a username are keyed by it, and only the rest are checked every
+// time. Results are cached until the profiles change.
+@interface iTermRuleIndex : NSObject
+
+// Returns an index of the rules in |profiles|, reusing the last one when none of them has changed.
+// Main thread only.
++ (instancetype)indexForProfiles:(NSArray<Profile *> *)profiles;
+
+- (instancetype)initWithProfiles:(NSArray<Profile *> *)profiles NS_DESIGNATED_INITIALIZER;
+- (instancetype)init NS_UNAVAILABLE;
+
+// Same meaning as -[iTermAutomaticProfileSwitcher highestScoringProfileForHostname:...].
+- (nullable Profile *)highestScoringProfileForHostname:(nullable NSString *)hostname
+                                              username:(nullable NSString *)username
+                                                  path:(nullable NSString *)path
+                                                   job:(nullable NSString *)job
+                                                sticky:(nullable BOOL *)sticky
+                                                 score:(nullable double *)scorePtr;
+
+// Returns the parsed rule, avoiding reparsing rules that are in the index.
+- (iTermRule *)ruleWithString:(NSString *)string;
+
+@end
+
+NS_ASSUME_NONNULL_END
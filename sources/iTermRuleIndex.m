@@ -0,0 +1,183 @@
+//
+//  iTermRuleIndex.m
+//  iTerm2SharedARC
+//
+//  Created by agent on 10/14/26.
+//
+
+#import "iTermRuleIndex.h"
+
+#import "ITAddressBookMgr.h"
+#import "iTermRule.h"
+
+// Stop caching results for new configurations after this many.
+static const NSUInteger iTermRuleIndexMaxCachedResults = 256;
+
+@interface iTermRuleIndexEntry : NSObject
+@property (nonatomic, strong) iTermRule *rule;
+@property (nonatomic, strong) Profile *profile;
+// Position among unique rules, used to break ties the same way every time.
+@property (nonatomic) NSUInteger ordinal;
+@end
+
+@implementation iTermRuleIndexEntry
+@end
+
+@interface iTermRuleIndexResult : NSObject
+@property (nonatomic, strong) Profile *profile;
+@property (nonatomic) BOOL sticky;
+@property (nonatomic) double score;
+@end
+
+@implementation iTermRuleIndexResult
+@end
+
+@implementation iTermRuleIndex {
+    // The profiles this was built from, compared by identity to detect changes.
+    NSArray<Profile *> *_profiles;
+    NSMutableDictionary<NSString *, iTermRuleIndexEntry *> *_entriesByRuleString;
+    // Lowercase hostname -> rules whose hostname has no wildcard.
+    NSMutableDictionary<NSString *, NSMutableArray<iTermRuleIndexEntry *> *> *_byHostname;
+    // Username -> rules not in _byHostname that require this username.
+    NSMutableDictionary<NSString *, NSMutableArray<iTermRuleIndexEntry *> *> *_byUsername;
+    // Rules that could match any hostname and username.
+    NSMutableArray<iTermRuleIndexEntry *> *_residual;
+    NSMutableDictionary<NSArray *, iTermRuleIndexResult *> *_results;
+}
+
++ (instancetype)indexForProfiles:(NSArray<Profile *> *)profiles {
+    static iTermRuleIndex *last;
+    if (![last isIndexOfProfiles:profiles]) {
+        last = [[iTermRuleIndex alloc] initWithProfiles:profiles];
+    }
+    return last;
+}
+
+- (instancetype)initWithProfiles:(NSArray<Profile *> *)profiles {
+    self = [super init];
+    if (self) {
+        _profiles = [profiles copy];
+        _entriesByRuleString = [NSMutableDictionary dictionary];
+        _byHostname = [NSMutableDictionary dictionary];
+        _byUsername = [NSMutableDictionary dictionary];
+        _residual = [NSMutableArray array];
+        _results = [NSMutableDictionary dictionary];
+
+        // As with the unindexed search, a rule belongs to the last profile that has it.
+        NSMutableArray<NSString *> *ruleStrings = [NSMutableArray array];
+        for (Profile *profile in _profiles) {
+            for (NSString *ruleString in profile[KEY_BOUND_HOSTS]) {
+                iTermRuleIndexEntry *entry = _entriesByRuleString[ruleString];
+                if (!entry) {
+                    entry = [[iTermRuleIndexEntry alloc] init];
+                    entry.rule = [iTermRule ruleWithString:ruleString];
+                    entry.ordinal = ruleStrings.count;
+                    _entriesByRuleString[ruleString] = entry;
+                    [ruleStrings addObject:ruleString];
+                }
+                entry.profile = profile;
+            }
+        }
+        for (NSString *ruleString in ruleStrings) {
+            [self addEntry:_entriesByRuleString[ruleString]];
+        }
+    }
+    return self;
+}
+
+- (void)addEntry:(iTermRuleIndexEntry *)entry {
+    iTermRule *rule = entry.rule;
+    // A hostname without a wildcard only matches that hostname, ignoring case.
+    if (rule.hostname.length > 0 && [rule.hostname rangeOfString:@"*"].location == NSNotFound) {
+        [self addEntry:entry toBucket:rule.hostname.lowercaseString in:_byHostname];
+    } else if (rule.username.length > 0) {
+        [self addEntry:entry toBucket:rule.username in:_byUsername];
+    } else {
+        [_residual addObject:entry];
+    }
+}
+
+- (void)addEntry:(iTermRuleIndexEntry *)entry
+        toBucket:(NSString *)key
+              in:(NSMutableDictionary<NSString *, NSMutableArray<iTermRuleIndexEntry *> *> *)buckets {
+    NSMutableArray<iTermRuleIndexEntry *> *bucket = buckets[key];
+    if (!bucket) {
+        bucket = [NSMutableArray array];
+        buckets[key] = bucket;
+    }
+    [bucket addObject:entry];
+}
+
+- (BOOL)isIndexOfProfiles:(NSArray<Profile *> *)profiles {
+    if (profiles.count != _profiles.count) {
+        return NO;
+    }
+    // Profiles are immutable, so a changed profile is a different object.
+    for (NSUInteger i = 0; i < profiles.count; i++) {
+        if (profiles[i] != _profiles[i]) {
+            return NO;
+        }
+    }
+    return YES;
+}
+
+- (iTermRule *)ruleWithString:(NSString *)string {
+    return _entriesByRuleString[string].rule ?: [iTermRule ruleWithString:string];
+}
+
+- (nullable Profile *)highestScoringProfileForHostname:(nullable NSString *)hostname
+                                              username:(nullable NSString *)username
+                                                  path:(nullable NSString *)path
+                                                   job:(nullable NSString *)job
+                                                sticky:(nullable BOOL *)sticky
+                                                 score:(nullable double *)scorePtr {
+    NSArray *key = @[ hostname ?: [NSNull null],
+                      username ?: [NSNull null],
+                      path ?: [NSNull null],
+                      job ?: [NSNull null] ];
+    iTermRuleIndexResult *result = _results[key];
+    if (!result) {
+        result = [self resultForHostname:hostname username:username path:path job:job];
+        if (_results.count < iTermRuleIndexMaxCachedResults) {
+            _results[key] = result;
+        }
+    }
+    if (sticky && result.profile) {
+        *sticky = result.sticky;
+    }
+    if (scorePtr) {
+        *scorePtr = result.score;
+    }
+    return result.profile;
+}
+
+#pragma mark - Private
+
+- (iTermRuleIndexResult *)resultForHostname:(NSString *)hostname
+                                   username:(NSString *)username
+                                       path:(NSString *)path
+                                        job:(NSString *)job {
+    iTermRuleIndexResult *result = [[iTermRuleIndexResult alloc] init];
+    __block NSUInteger bestOrdinal = NSNotFound;
+    void (^consider)(NSArray<iTermRuleIndexEntry *> *) = ^(NSArray<iTermRuleIndexEntry *> *entries) {
+        for (iTermRuleIndexEntry *entry in entries) {
+            const double score = [entry.rule scoreForHostname:hostname username:username path:path job:job];
+            if (score > result.score || (score > 0 && score == result.score && entry.ordinal < bestOrdinal)) {
+                result.score = score;
+                result.profile = entry.profile;
+                result.sticky = entry.rule.isSticky;
+                bestOrdinal = entry.ordinal;
+            }
+        }
+    };
+    if (hostname) {
+        consider(_byHostname[hostname.lowercaseString]);
+    }
+    if (username) {
+        consider(_byUsername[username]);
+    }
+    consider(_residual);
+    return result;
+}
+
+@end
@@ -8,28 +8,73 @@
 #import "iTermSandboxedWorkerClient.h"
 #import "iTerm2SandboxedWorkerProtocol.h"
 #import "DebugLogging.h"
+#import "iTermAdvancedSettingsModel.h"
 
+// The worker handles each connection's requests one at a time on its own queue, so decoding on
+// several connections at once keeps a burst of images from waiting behind each other.
+static NSMutableArray<NSXPCConnection *> *sSandboxedWorkerConnections;
+// Number of requests waiting on each connection, 1:1 with sSandboxedWorkerConnections.
+static NSMutableArray<NSNumber *> *sSandboxedWorkerPendingCounts;
 
 @implementation iTermSandboxedWorkerClient
 
++ (NSXPCConnection *)newConnection {
+    NSXPCConnection *connection = [[NSXPCConnection alloc] initWithServiceName:@"com.iterm2.sandboxed-worker"];
+    if (!connection) {
+        return nil;
+    }
+    connection.remoteObjectInterface = [NSXPCInterface interfaceWithProtocol:@protocol(iTerm2SandboxedWorkerProtocol)];
+    __weak NSXPCConnection *weakConnection = connection;
+    connection.invalidationHandler = ^{
+        @synchronized(self) {
+            const NSUInteger index = [sSandboxedWorkerConnections indexOfObjectIdenticalTo:weakConnection];
+            if (index != NSNotFound) {
+                [sSandboxedWorkerConnections removeObjectAtIndex:index];
+                [sSandboxedWorkerPendingCounts removeObjectAtIndex:index];
+            }
+        }
+    };
+    [connection resume];
+    return connection;
+}
+
+// Returns the connection with the fewest requests waiting on it, making a new one if they're all
+// busy and there's room for another. The caller must balance this with -finishedWithConnection:.
 + (NSXPCConnection *)connection {
     @synchronized(self) {
-        static NSXPCConnection *sSandboxedWorkerConnection;
-        if (sSandboxedWorkerConnection) {
-            return sSandboxedWorkerConnection;
+        if (!sSandboxedWorkerConnections) {
+            sSandboxedWorkerConnections = [NSMutableArray array];
+            sSandboxedWorkerPendingCounts = [NSMutableArray array];
         }
-        sSandboxedWorkerConnection = [[NSXPCConnection alloc] initWithServiceName:@"com.iterm2.sandboxed-worker"];
-        if (!sSandboxedWorkerConnection) {
-            return nil;
+        NSInteger best = -1;
+        for (NSUInteger i = 0; i < sSandboxedWorkerConnections.count; i++) {
+            if (best < 0 || sSandboxedWorkerPendingCounts[i].integerValue < sSandboxedWorkerPendingCounts[best].integerValue) {
+                best = i;
+            }
         }
-        sSandboxedWorkerConnection.remoteObjectInterface = [NSXPCInterface interfaceWithProtocol:@protocol(iTerm2SandboxedWorkerProtocol)];
-        sSandboxedWorkerConnection.invalidationHandler = ^{
-            @synchronized(self) {
-                sSandboxedWorkerConnection = nil;
+        const NSUInteger maximumConnections = MAX(1, [iTermAdvancedSettingsModel sandboxedImageDecoderConnections]);
+        if (best < 0 ||
+            (sSandboxedWorkerPendingCounts[best].integerValue > 0 && sSandboxedWorkerConnections.count < maximumConnections)) {
+            NSXPCConnection *connection = [self newConnection];
+            if (connection) {
+                [sSandboxedWorkerConnections addObject:connection];
+                [sSandboxedWorkerPendingCounts addObject:@0];
+                best = sSandboxedWorkerConnections.count - 1;
+            } else if (best < 0) {
+                return nil;
             }
-        };
-        [sSandboxedWorkerConnection resume];
-        return sSandboxedWorkerConnection;
+        }
+        sSandboxedWorkerPendingCounts[best] = @(sSandboxedWorkerPendingCounts[best].integerValue + 1);
+        return sSandboxedWorkerConnections[best];
+    }
+}
+
++ (void)finishedWithConnection:(NSXPCConnection *)connection {
+    @synchronized(self) {
+        const NSUInteger index = [sSandboxedWorkerConnections indexOfObjectIdenticalTo:connection];
+        if (index != NSNotFound) {
+            sSandboxedWorkerPendingCounts[index] = @(sSandboxedWorkerPendingCounts[index].integerValue - 1);
+        }
     }
 }
 
@@ -46,6 +91,7 @@
     });
 
     dispatch_group_wait(group, DISPATCH_TIME_FOREVER);
+    [self finishedWithConnection:connectionToService];
 
     return result;
 }
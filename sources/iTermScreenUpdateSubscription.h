@@ -0,0 +1,50 @@
+//
+//  iTermScreenUpdateSubscription.h
+//  iTerm2SharedARC
+//
+//  Created by agent on 10/14/26.
+//
+
+#import <Foundation/Foundation.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+@class ITMNotificationRequest;
+@class iTermScreenUpdateSubscription;
+
+@protocol iTermScreenUpdateSubscriptionDelegate<NSObject>
+// Build and post a notification now.
+- (void)screenUpdateSubscriptionShouldPost:(iTermScreenUpdateSubscription *)subscription;
+@end
+
+// State for an API connection's screen update subscription that asked for changed lines or a max
+// rate. Dirty lines accumulate between notifications so that when they're coalesced nothing is
+// lost.
+@interface iTermScreenUpdateSubscription : NSObject
+
+@property (nonatomic, readonly) NSString *connectionKey;
+@property (nonatomic, readonly) BOOL includeChangedLines;
+@property (nonatomic, weak) id<iTermScreenUpdateSubscriptionDelegate> delegate;
+
+- (instancetype)initWithConnectionKey:(NSString *)connectionKey
+                              request:(ITMNotificationRequest *)request NS_DESIGNATED_INITIALIZER;
+- (instancetype)init NS_UNAVAILABLE;
+
+// Lines are screen-relative. Posts immediately or after enough time has passed since the
+// previous notification.
+- (void)addDirtyLines:(NSIndexSet *)lines;
+
+// Causes the next notification to include every line. Always posts asynchronously.
+- (void)invalidateAllLines;
+
+// Called while building a notification. Returns the lines to send (or nil if all of them should be
+// sent) and resets the accumulated set.
+- (nullable NSIndexSet *)takeDirtyLines;
+
+// Called while building a notification. |screenTop| is the absolute line number of the top of the
+// screen. Returns how many lines it moved down since the last call, or 0 the first time.
+- (long long)takeOverflowWithScreenTop:(long long)screenTop;
+
+@end
+
+NS_ASSUME_NONNULL_END
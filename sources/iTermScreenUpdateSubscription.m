@@ -0,0 +1,99 @@
+//
+//  iTermScreenUpdateSubscription.m
+//  iTerm2SharedARC
+//
+//  Created by agent on 10/14/26.
+//
+
+#import "iTermScreenUpdateSubscription.h"
+
+#import "Api.pbobjc.h"
+#import "DebugLogging.h"
+#import "NSDate+iTerm.h"
+
+@implementation iTermScreenUpdateSubscription {
+    NSTimeInterval _minimumInterval;
+    NSTimeInterval _lastPostTime;
+    NSMutableIndexSet *_dirtyLines;
+    BOOL _allLinesDirty;
+    BOOL _postPending;
+    BOOL _haveScreenTop;
+    long long _screenTop;
+}
+
+- (instancetype)initWithConnectionKey:(NSString *)connectionKey
+                              request:(ITMNotificationRequest *)request {
+    self = [super init];
+    if (self) {
+        _connectionKey = [connectionKey copy];
+        ITMScreenUpdateMonitorRequest *monitorRequest = request.screenUpdateMonitorRequest;
+        _includeChangedLines = monitorRequest.includeChangedLines;
+        if (monitorRequest.maxUpdatesPerSecond > 0) {
+            _minimumInterval = 1.0 / monitorRequest.maxUpdatesPerSecond;
+        }
+        _dirtyLines = [[NSMutableIndexSet alloc] init];
+        _allLinesDirty = YES;
+    }
+    return self;
+}
+
+- (void)addDirtyLines:(NSIndexSet *)lines {
+    [_dirtyLines addIndexes:lines];
+    if (_postPending) {
+        return;
+    }
+    const NSTimeInterval delay = _lastPostTime + _minimumInterval - [NSDate it_timeSinceBoot];
+    if (delay <= 0) {
+        [self post];
+        return;
+    }
+    [self postAfterDelay:delay];
+}
+
+- (void)invalidateAllLines {
+    _allLinesDirty = YES;
+    if (!_postPending) {
+        [self postAfterDelay:0];
+    }
+}
+
+- (NSIndexSet *)takeDirtyLines {
+    if (_allLinesDirty) {
+        _allLinesDirty = NO;
+        [_dirtyLines removeAllIndexes];
+        return nil;
+    }
+    NSIndexSet *result = [_dirtyLines copy];
+    [_dirtyLines removeAllIndexes];
+    return result;
+}
+
+- (long long)takeOverflowWithScreenTop:(long long)screenTop {
+    const long long overflow = _haveScreenTop ? MAX(0, screenTop - _screenTop) : 0;
+    _haveScreenTop = YES;
+    _screenTop = screenTop;
+    return overflow;
+}
+
+#pragma mark - Private
+
+- (void)postAfterDelay:(NSTimeInterval)delay {
+    _postPending = YES;
+    DLog(@"Coalesce screen updates for %@ for %@ sec", _connectionKey, @(delay));
+    __weak __typeof(self) weakSelf = self;
+    dispatch_after(dispatch_time(DISPATCH_TIME_NOW, (int64_t)(delay * NSEC_PER_SEC)), dispatch_get_main_queue(), ^{
+        __typeof(self) strongSelf = weakSelf;
+        if (!strongSelf) {
+            return;
+        }
+        strongSelf->_postPending = NO;
+        [strongSelf post];
+    });
+}
+
+- (void)post {
+    _lastPostTime = [NSDate it_timeSinceBoot];
+    [self.delegate screenUpdateSubscriptionShouldPost:self];
+}
+
+@end
@@ -7,6 +7,7 @@
 
 #import "iTermScriptConsole.h"
 
+#import "iTermAdvancedSettingsModel.h"
 #import "iTermAPIServer.h"
 #import "iTermScriptHistory.h"
 #import "iTermScriptInspector.h"
@@ -45,6 +46,7 @@ typedef NS_ENUM(NSInteger, iTermScriptFilterControlTag) {
     iTermScriptInspector *_inspector;
 
     id _token;
+    __weak iTermScriptHistoryEntry *_watchedEntry;
 }
 
 + (instancetype)sharedInstance {
@@ -146,6 +148,11 @@ typedef NS_ENUM(NSInteger, iTermScriptFilterControlTag) {
 
     [self makeTextViewHorizontallyScrollable:_logsView];
     [self makeTextViewHorizontallyScrollable:_callsView];
+
+    [[NSNotificationCenter defaultCenter] addObserver:self
+                                             selector:@selector(windowDidChangeOcclusionState:)
+                                                 name:NSWindowDidChangeOcclusionStateNotification
+                                               object:self.window];
 }
 
 - (void)dealloc {
@@ -323,6 +330,8 @@ typedef NS_ENUM(NSInteger, iTermScriptFilterControlTag) {
                                                   columnIndexes:[NSIndexSet indexSetWithIndex:0]];
             }
         }];
+        _watchedEntry = entry;
+        entry.consoleIsWatching = [self windowIsVisible];
     }
 }
 
@@ -400,6 +409,23 @@ typedef NS_ENUM(NSInteger, iTermScriptFilterControlTag) {
     _startButton.enabled = NO;
 }
 
+// With a memory limit, entries don't announce calls unless the console is watching them. Stop
+// watching while the window can't be seen and reload everything when it can.
+- (void)windowDidChangeOcclusionState:(NSNotification *)notification {
+    if ([iTermAdvancedSettingsModel scriptConsoleMemoryLimit] <= 0 || !_watchedEntry) {
+        return;
+    }
+    const BOOL visible = [self windowIsVisible];
+    if (visible == _watchedEntry.consoleIsWatching) {
+        return;
+    }
+    if (visible) {
+        [self tableViewSelectionDidChange:notification];
+    } else {
+        _watchedEntry.consoleIsWatching = NO;
+    }
+}
+
 - (void)historyEntryDidChange:(NSNotification *)notification {
     if (!notification.userInfo) {
         [_tableView reloadData];
@@ -490,6 +516,12 @@ typedef NS_ENUM(NSInteger, iTermScriptFilterControlTag) {
         [[NSNotificationCenter defaultCenter] removeObserver:_token];
         _token = nil;
     }
+    _watchedEntry.consoleIsWatching = NO;
+    _watchedEntry = nil;
+}
+
+- (BOOL)windowIsVisible {
+    return (self.window.occlusionState & NSWindowOcclusionStateVisible) != 0;
 }
 
 @end
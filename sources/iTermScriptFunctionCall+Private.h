@@ -14,6 +14,8 @@
 @property (nonatomic, copy) NSString *namespace;
 @property (nonatomic, copy) NSString *name;
 @property (nonatomic, readonly) NSString *connectionKey;
+// Maps an argument name to a parsed expression for its value.
+@property (nonatomic, readonly) NSDictionary<NSString *, iTermParsedExpression *> *argumentExpressions;
 
 - (void)performFunctionCallFromInvocation:(NSString *)invocation
                                  receiver:(NSString *)receiver
@@ -293,6 +293,10 @@ void iTermFunctionCallSplitFullyQualifiedName(NSString *fqName, NSString **names
     _argToExpression[name] = expression;
 }
 
+- (NSDictionary<NSString *, iTermParsedExpression *> *)argumentExpressions {
+    return [_argToExpression copy];
+}
+
 - (void)callWithScope:(iTermVariableScope *)scope
            invocation:(NSString *)invocation
              receiver:(NSString *)receiver
@@ -33,6 +33,9 @@ extern NSString *const iTermScriptHistoryEntryFieldRPCValue;  // RPC changed
 @property (nonatomic) BOOL terminatedByUser;
 @property (nonatomic, copy) NSString *path;
 @property (nonatomic, readonly, nullable) NSString *fullPath;  // This can be passed to launchScriptWithAbsolutePath:
+// Set by the script console while it shows this entry. With a memory limit, calls are only
+// formatted and announced while this is set.
+@property (nonatomic) BOOL consoleIsWatching;
 
 + (instancetype)globalEntry;
 + (instancetype)apsEntry;
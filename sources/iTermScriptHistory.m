@@ -8,11 +8,14 @@
 #import "iTermScriptHistory.h"
 
 #import "DebugLogging.h"
+#import "iTermAdvancedSettingsModel.h"
 #import "iTermAPIServer.h"
 #import "iTermAPIHelper.h"
 #import "iTermUserDefaults.h"
 #import "iTermWebSocketConnection.h"
 #import "NSArray+iTerm.h"
+#import "NSData+iTerm.h"
+#import "NSFileManager+iTerm.h"
 #import "NSObject+iTerm.h"
 #import "NSStringITerm.h"
 
@@ -26,9 +29,138 @@ NSString *const iTermScriptHistoryEntryFieldRPCValue = @"rpc";
 
 static NSDateFormatter *gScriptHistoryDateFormatter;
 
+static dispatch_queue_t iTermScriptHistoryQueue(void) {
+    static dispatch_queue_t queue;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        dispatch_queue_attr_t attr = dispatch_queue_attr_make_with_qos_class(DISPATCH_QUEUE_SERIAL, QOS_CLASS_UTILITY, 0);
+        queue = dispatch_queue_create("com.iterm2.script-history", attr);
+    });
+    return queue;
+}
+
+// An entry in the list of API calls. Formatting a big message is expensive and most calls are
+// never looked at, so a call made from a message formats it the first time its string is needed.
+@interface iTermScriptHistoryCall : NSObject
+// About how many characters the formatted call takes.
+@property (nonatomic, readonly) NSUInteger cost;
+@property (nonatomic, readonly) NSString *string;
+
+- (instancetype)initWithRPC:(NSString *)rpc clientOriginated:(BOOL)clientOriginated;
+- (instancetype)initWithMessage:(GPBMessage *)message clientOriginated:(BOOL)clientOriginated;
+@end
+
+@implementation iTermScriptHistoryCall {
+    NSDate *_date;
+    BOOL _clientOriginated;
+    GPBMessage *_message;
+    NSString *_string;
+}
+
+- (instancetype)initWithRPC:(NSString *)rpc clientOriginated:(BOOL)clientOriginated {
+    self = [super init];
+    if (self) {
+        _date = [NSDate date];
+        _clientOriginated = clientOriginated;
+        _string = [self formattedStringWithRPC:rpc];
+        _cost = _string.length;
+    }
+    return self;
+}
+
+- (instancetype)initWithMessage:(GPBMessage *)message clientOriginated:(BOOL)clientOriginated {
+    self = [super init];
+    if (self) {
+        _date = [NSDate date];
+        _clientOriginated = clientOriginated;
+        _message = message;
+        // The text format is typically a few times bigger than the wire format.
+        _cost = message.serializedSize * 3;
+    }
+    return self;
+}
+
+- (NSString *)string {
+    if (!_string) {
+        _string = [self formattedStringWithRPC:[_message.description stringByAppendingString:@"\n"]];
+        _message = nil;
+    }
+    return _string;
+}
+
+- (NSString *)formattedStringWithRPC:(NSString *)rpc {
+    return [NSString stringWithFormat:@"%@ %@:\n%@\n",
+            _clientOriginated ? @"Script → iTerm2" : @"Script ← iTerm2",
+            [gScriptHistoryDateFormatter stringFromDate:_date],
+            rpc];
+}
+
+@end
+
+// Appends text that no longer fits in memory to a gzip file. Text is compressed in chunks, each its
+// own gzip member; gunzip reads concatenated members as one stream. Use only on the script history
+// queue.
+@interface iTermScriptHistorySpillFile : NSObject
+- (instancetype)initWithPath:(NSString *)path NS_DESIGNATED_INITIALIZER;
+- (instancetype)init NS_UNAVAILABLE;
+- (void)appendString:(NSString *)string;
+- (void)flush;
+@end
+
+@implementation iTermScriptHistorySpillFile {
+    NSString *_path;
+    NSMutableString *_pending;
+}
+
+- (instancetype)initWithPath:(NSString *)path {
+    self = [super init];
+    if (self) {
+        _path = [path copy];
+        _pending = [NSMutableString string];
+    }
+    return self;
+}
+
+- (void)appendString:(NSString *)string {
+    [_pending appendString:string];
+    if (_pending.length >= 64 * 1024) {
+        [self flush];
+    }
+}
+
+- (void)flush {
+    if (_pending.length == 0) {
+        return;
+    }
+    NSData *compressed = [[_pending dataUsingEncoding:NSUTF8StringEncoding] it_compressedData];
+    [_pending setString:@""];
+    if (!compressed) {
+        return;
+    }
+    [[NSFileManager defaultManager] createDirectoryAtPath:[_path stringByDeletingLastPathComponent]
+                              withIntermediateDirectories:YES
+                                               attributes:nil
+                                                    error:nil];
+    FILE *file = fopen(_path.fileSystemRepresentation, "ab");
+    if (!file) {
+        DLog(@"Failed to open %@: %s", _path, strerror(errno));
+        return;
+    }
+    fwrite(compressed.bytes, 1, compressed.length, file);
+    fclose(file);
+}
+
+@end
+
 @implementation iTermScriptHistoryEntry {
     NSMutableArray<NSString *> *_logLines;
-    NSMutableArray<NSString *> *_callEntries;
+    NSMutableArray<iTermScriptHistoryCall *> *_calls;
+    // Sum of the lengths of _logLines.
+    NSUInteger _logLength;
+    // Sum of the costs of _calls.
+    NSUInteger _callsCost;
+    iTermScriptHistorySpillFile *_logSpill;
+    iTermScriptHistorySpillFile *_callSpill;
 }
 
 + (instancetype)globalEntry {
@@ -93,7 +225,7 @@ static NSDateFormatter *gScriptHistoryDateFormatter;
         _isRunning = YES;
 
         _logLines = [NSMutableArray array];
-        _callEntries = [NSMutableArray array];
+        _calls = [NSMutableArray array];
         static dispatch_once_t onceToken;
         dispatch_once(&onceToken, ^{
             gScriptHistoryDateFormatter = [[NSDateFormatter alloc] init];
@@ -124,11 +256,19 @@ static NSDateFormatter *gScriptHistoryDateFormatter;
 
 - (void)apiServerDidReceiveMessage:(NSNotification *)notification {
     ITMClientOriginatedMessage *request = notification.userInfo[@"request"];
+    if ([self memoryLimit] > 0) {
+        [self addCall:[[iTermScriptHistoryCall alloc] initWithMessage:request clientOriginated:YES]];
+        return;
+    }
     [self addClientOriginatedRPC:[request.description stringByAppendingString:@"\n"]];
 }
 
 - (void)apiServerWillSendMessage:(NSNotification *)notification {
     ITMServerOriginatedMessage *message = notification.userInfo[@"message"];
+    if ([self memoryLimit] > 0) {
+        [self addCall:[[iTermScriptHistoryCall alloc] initWithMessage:message clientOriginated:NO]];
+        return;
+    }
     [self addServerOriginatedRPC:[message.description stringByAppendingString:@"\n"]];
 }
 
@@ -137,23 +277,31 @@ static NSDateFormatter *gScriptHistoryDateFormatter;
 }
 
 - (void)addClientOriginatedRPC:(NSString *)rpc {
-    NSString *string = [NSString stringWithFormat:@"Script → iTerm2 %@:\n%@\n", [gScriptHistoryDateFormatter stringFromDate:[NSDate date]], rpc];
-    [self appendCalls:string];
-    [[NSNotificationCenter defaultCenter] postNotificationName:iTermScriptHistoryEntryDidChangeNotification
-                                                        object:self
-                                                      userInfo:@{ iTermScriptHistoryEntryDelta: string,
-                                                                  iTermScriptHistoryEntryFieldKey: iTermScriptHistoryEntryFieldRPCValue }];
+    [self addCall:[[iTermScriptHistoryCall alloc] initWithRPC:rpc clientOriginated:YES]];
 }
 
 - (void)addServerOriginatedRPC:(NSString *)rpc {
-    NSString *string = [NSString stringWithFormat:@"Script ← iTerm2 %@:\n%@\n", [gScriptHistoryDateFormatter stringFromDate:[NSDate date]], rpc];
-    [self appendCalls:string];
+    [self addCall:[[iTermScriptHistoryCall alloc] initWithRPC:rpc clientOriginated:NO]];
+}
+
+- (void)addCall:(iTermScriptHistoryCall *)call {
+    [self appendCall:call];
+    if ([self memoryLimit] > 0 && !_consoleIsWatching) {
+        // The console reloads all the calls when it starts watching.
+        return;
+    }
     [[NSNotificationCenter defaultCenter] postNotificationName:iTermScriptHistoryEntryDidChangeNotification
                                                         object:self
-                                                      userInfo:@{ iTermScriptHistoryEntryDelta: string,
+                                                      userInfo:@{ iTermScriptHistoryEntryDelta: call.string,
                                                                   iTermScriptHistoryEntryFieldKey: iTermScriptHistoryEntryFieldRPCValue }];
 }
 
+- (NSArray<NSString *> *)callEntries {
+    return [_calls mapWithBlock:^id(iTermScriptHistoryCall *call) {
+        return call.string;
+    }];
+}
+
 - (pid_t)onlyPid {
     if (self.pids.count != 1) {
         return 0;
@@ -194,6 +342,14 @@ static NSDateFormatter *gScriptHistoryDateFormatter;
 }
 - (void)stopRunning {
     _isRunning = NO;
+    iTermScriptHistorySpillFile *logSpill = _logSpill;
+    iTermScriptHistorySpillFile *callSpill = _callSpill;
+    if (logSpill || callSpill) {
+        dispatch_async(iTermScriptHistoryQueue(), ^{
+            [logSpill flush];
+            [callSpill flush];
+        });
+    }
     [[NSNotificationCenter defaultCenter] postNotificationName:iTermScriptHistoryEntryDidChangeNotification
                                                         object:self];
 }
@@ -205,15 +361,9 @@ static NSDateFormatter *gScriptHistoryDateFormatter;
     }
     NSString *timestamp = [gScriptHistoryDateFormatter stringFromDate:[NSDate date]];
 
-    static dispatch_queue_t queue;
-    static dispatch_once_t onceToken;
-    dispatch_once(&onceToken, ^{
-        dispatch_queue_attr_t attr = dispatch_queue_attr_make_with_qos_class(DISPATCH_QUEUE_SERIAL, QOS_CLASS_UTILITY, 0);
-        queue = dispatch_queue_create("com.iterm2.script-history", attr);
-    });
     const BOOL continuation = _lastLogLineContinues;
     _lastLogLineContinues = ![rawLogs hasSuffix:@"\n"];
-    dispatch_async(queue, ^{
+    dispatch_async(iTermScriptHistoryQueue(), ^{
         [self queueAppendLogs:rawLogs
                     timestamp:timestamp
                  continuation:continuation
@@ -270,21 +420,16 @@ static NSDateFormatter *gScriptHistoryDateFormatter;
                   completion:(void (^)(void))completion {
     if (continuation) {
         NSString *amended = [_logLines.lastObject stringByAppendingString:newLines.firstObject];
+        _logLength += newLines.firstObject.length;
         newLines = [newLines subarrayWithRange:NSMakeRange(1, newLines.count - 1)];
         _logLines[_logLines.count - 1] = amended;
 
     }
-    const NSInteger maxLines = 1000;
-    if (newLines.count > maxLines) {
-        [_logLines removeAllObjects];
-        [_logLines addObjectsFromArray:[newLines subarrayWithRange:NSMakeRange(newLines.count - maxLines, maxLines)]];
-    } else {
-        [_logLines addObjectsFromArray:newLines];
-
-        if (_logLines.count > maxLines) {
-            [_logLines removeObjectsInRange:NSMakeRange(0, _logLines.count - maxLines)];
-        }
+    [_logLines addObjectsFromArray:newLines];
+    for (NSString *line in newLines) {
+        _logLength += line.length;
     }
+    [self trimLogLines];
     [[NSNotificationCenter defaultCenter] postNotificationName:iTermScriptHistoryEntryDidChangeNotification
                                                         object:self
                                                       userInfo:@{ iTermScriptHistoryEntryDelta: delta,
@@ -292,11 +437,90 @@ static NSDateFormatter *gScriptHistoryDateFormatter;
     completion();
 }
 
-- (void)appendCalls:(NSString *)delta {
-    [_callEntries addObject:delta];
-    while (_callEntries.count > 100) {
-        [_callEntries removeObjectAtIndex:0];
+// Drops the oldest lines beyond 1000 or the memory limit. The newest line is always kept.
+- (void)trimLogLines {
+    const NSUInteger maxLines = 1000;
+    const NSUInteger limit = [self memoryLimit];
+    NSUInteger count = 0;
+    NSUInteger length = _logLength;
+    while (_logLines.count - count > maxLines ||
+           (limit > 0 && length > limit && _logLines.count - count > 1)) {
+        length -= _logLines[count].length;
+        count++;
+    }
+    if (count == 0) {
+        return;
+    }
+    const NSRange range = NSMakeRange(0, count);
+    if ([self shouldSpill]) {
+        if (!_logSpill) {
+            _logSpill = [[iTermScriptHistorySpillFile alloc] initWithPath:[self spillPathWithExtension:@"log.gz"]];
+        }
+        iTermScriptHistorySpillFile *spill = _logSpill;
+        NSArray<NSString *> *lines = [_logLines subarrayWithRange:range];
+        dispatch_async(iTermScriptHistoryQueue(), ^{
+            for (NSString *line in lines) {
+                [spill appendString:line];
+                [spill appendString:@"\n"];
+            }
+        });
+    }
+    [_logLines removeObjectsInRange:range];
+    _logLength = length;
+}
+
+// Adds a call, dropping the oldest beyond 100 or the memory limit. The newest call is always kept.
+- (void)appendCall:(iTermScriptHistoryCall *)call {
+    [_calls addObject:call];
+    _callsCost += call.cost;
+
+    const NSUInteger maxCalls = 100;
+    const NSUInteger limit = [self memoryLimit];
+    NSUInteger count = 0;
+    NSUInteger cost = _callsCost;
+    while (_calls.count - count > maxCalls ||
+           (limit > 0 && cost > limit && _calls.count - count > 1)) {
+        cost -= _calls[count].cost;
+        count++;
+    }
+    if (count == 0) {
+        return;
+    }
+    const NSRange range = NSMakeRange(0, count);
+    if ([self shouldSpill]) {
+        if (!_callSpill) {
+            _callSpill = [[iTermScriptHistorySpillFile alloc] initWithPath:[self spillPathWithExtension:@"calls.gz"]];
+        }
+        iTermScriptHistorySpillFile *spill = _callSpill;
+        // Evicted calls are only referenced from here on, so they can be formatted off the main thread.
+        NSArray<iTermScriptHistoryCall *> *calls = [_calls subarrayWithRange:range];
+        dispatch_async(iTermScriptHistoryQueue(), ^{
+            for (iTermScriptHistoryCall *evicted in calls) {
+                [spill appendString:evicted.string];
+                [spill appendString:@"\n"];
+            }
+        });
     }
+    [_calls removeObjectsInRange:range];
+    _callsCost = cost;
+}
+
+// In characters. 0 means no limit.
+- (NSUInteger)memoryLimit {
+    return (NSUInteger)MAX(0, [iTermAdvancedSettingsModel scriptConsoleMemoryLimit]) * 1024;
+}
+
+- (BOOL)shouldSpill {
+    return [self memoryLimit] > 0 && [iTermAdvancedSettingsModel spillScriptConsoleLogs];
+}
+
+- (NSString *)spillPathWithExtension:(NSString *)extension {
+    NSString *folder = [[[NSFileManager defaultManager] applicationSupportDirectory] stringByAppendingPathComponent:@"ScriptLogs"];
+    NSString *name = [NSString stringWithFormat:@"%@-%lld.%@",
+                      [_identifier stringByReplacingOccurrencesOfString:@"/" withString:@"_"],
+                      (long long)_startDate.timeIntervalSince1970,
+                      extension];
+    return [folder stringByAppendingPathComponent:name];
 }
 
 @end
@@ -0,0 +1,27 @@
+//
+//  iTermScrollbackSpillFile.h
+//  iTerm2SharedARC
+//
+//  Created by agent on 10/14/26.
+//
+
+#import <Foundation/Foundation.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+// An append-only, anonymous temporary file that scrollback history can be moved into. Each write
+// returns an NSData backed by a read-only mapping of the bytes just written, so the kernel can
+// drop the pages under memory pressure instead of swapping them. The file is unlinked as soon as
+// it is created, so it disappears when the last mapping goes away.
+@interface iTermScrollbackSpillFile : NSObject
+
+// Returns nil if the file could not be created.
+- (nullable instancetype)init NS_DESIGNATED_INITIALIZER;
+
+// Writes |data| to the end of the file and returns a mapping of it, or nil on failure (e.g., the
+// disk is full).
+- (nullable NSData *)mappedDataByWritingData:(NSData *)data;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,77 @@
+//
+//  iTermScrollbackSpillFile.m
+//  iTerm2SharedARC
+//
+//  Created by agent on 10/14/26.
+//
+
+#import "iTermScrollbackSpillFile.h"
+
+#import "DebugLogging.h"
+
+#include <sys/mman.h>
+#include <unistd.h>
+
+@implementation iTermScrollbackSpillFile {
+    int _fd;
+    off_t _length;
+}
+
+- (instancetype)init {
+    self = [super init];
+    if (self) {
+        NSString *pattern = [NSTemporaryDirectory() stringByAppendingPathComponent:@"iTerm2-scrollback.XXXXXX"];
+        char *path = strdup(pattern.fileSystemRepresentation);
+        _fd = mkstemp(path);
+        if (_fd < 0) {
+            DLog(@"mkstemp(%s) failed: %s", path, strerror(errno));
+            free(path);
+            return nil;
+        }
+        unlink(path);
+        free(path);
+    }
+    return self;
+}
+
+- (void)dealloc {
+    // Existing mappings remain valid after the file descriptor is closed.
+    close(_fd);
+}
+
+- (NSData *)mappedDataByWritingData:(NSData *)data {
+    if (data.length == 0) {
+        return nil;
+    }
+    // Mappings must begin on a page boundary.
+    const off_t pageSize = getpagesize();
+    const off_t offset = (_length + pageSize - 1) / pageSize * pageSize;
+
+    const char *bytes = data.bytes;
+    size_t written = 0;
+    while (written < data.length) {
+        const ssize_t n = pwrite(_fd, bytes + written, data.length - written, offset + written);
+        if (n < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            DLog(@"pwrite of %@ bytes at %@ failed: %s", @(data.length), @(offset), strerror(errno));
+            return nil;
+        }
+        written += n;
+    }
+
+    void *mapping = mmap(NULL, data.length, PROT_READ, MAP_FILE | MAP_SHARED, _fd, offset);
+    if (mapping == MAP_FAILED) {
+        DLog(@"mmap of %@ bytes at %@ failed: %s", @(data.length), @(offset), strerror(errno));
+        return nil;
+    }
+    _length = offset + data.length;
+    return [[NSData alloc] initWithBytesNoCopy:mapping
+                                        length:data.length
+                                   deallocator:^(void *bytes, NSUInteger length) {
+        munmap(bytes, length);
+    }];
+}
+
+@end
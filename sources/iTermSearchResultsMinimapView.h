@@ -39,6 +39,7 @@ NS_CLASS_AVAILABLE_MAC(10_14)
 
 - (void)addObjectOfType:(NSInteger)objectType onLine:(NSInteger)line;
 - (void)removeObjectOfType:(NSInteger)objectType fromLine:(NSInteger)line;
+- (void)removeObjectsOfType:(NSInteger)objectType fromLines:(NSIndexSet *)lines;
 - (void)setFirstVisibleLine:(NSInteger)firstVisibleLine
        numberOfVisibleLines:(NSInteger)numberOfVisibleLines;
 - (void)removeAllObjects;
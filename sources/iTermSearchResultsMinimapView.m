@@ -8,6 +8,7 @@
 #import "iTermSearchResultsMinimapView.h"
 
 #import "DebugLogging.h"
+#import "iTermAdvancedSettingsModel.h"
 #import "iTermMalloc.h"
 #import "iTermRateLimitedUpdate.h"
 
@@ -90,6 +91,41 @@ static inline void iTermSearchResultsMinimapViewDrawItem(CGFloat offset, CGFloat
     CGContextFillRect(context, fillRect);
 }
 
+// Draws the same items as enumerating every index, but asks the index set once per point of
+// height instead, so the cost doesn't grow with the number of indexes. Offset p is drawn if any
+// index rounds to it, and (as when enumerating) only if it's at least 2 points below the last item.
+static void iTermMinimapDrawIndexesByRow(NSIndexSet *indexes,
+                                         NSRange range,
+                                         CGFloat width,
+                                         CGFloat height,
+                                         CGContextRef context) {
+    if (range.length == 0 || height <= 0) {
+        return;
+    }
+    const CGFloat numberOfLines = range.length;
+    CGFloat lastPointOffset = INFINITY;
+    for (NSInteger p = round(height); p >= 0; p--) {
+        if (p + 2 > lastPointOffset) {
+            continue;
+        }
+        // Indexes whose offset rounds to p are those whose fraction of the range is in
+        // (lowerFraction, upperFraction].
+        const CGFloat lowerFraction = (height - p - 0.5) / height;
+        const CGFloat upperFraction = (height - p + 0.5) / height;
+        const NSUInteger lower = range.location + (NSUInteger)MAX(0, floor(lowerFraction * numberOfLines) + 1);
+        const NSUInteger upper = range.location + (NSUInteger)MIN(numberOfLines, MAX(0, floor(upperFraction * numberOfLines) + 1));
+        if (lower >= upper) {
+            continue;
+        }
+        const NSUInteger index = [indexes indexGreaterThanOrEqualToIndex:lower];
+        if (index == NSNotFound || index >= upper) {
+            continue;
+        }
+        iTermSearchResultsMinimapViewDrawItem(p, width, context);
+        lastPointOffset = p;
+    }
+}
+
 #pragma mark - CALayerDelegate
 
 - (void)drawLayer:(CALayer *)layer inContext:(CGContextRef)ctx {
@@ -110,6 +146,10 @@ static inline void iTermSearchResultsMinimapViewDrawItem(CGFloat offset, CGFloat
              @(rangeOfVisibleLines.length),
              @(height),
              series.fillColor);
+        if ([iTermAdvancedSettingsModel minimapDrawsByRow]) {
+            iTermMinimapDrawIndexesByRow(indexes, rangeOfVisibleLines, width, height, ctx);
+            continue;
+        }
         [indexes enumerateIndexesInRange:rangeOfVisibleLines options:0 usingBlock:^(NSUInteger idx, BOOL * _Nonnull stop) {
             const CGFloat fraction = (CGFloat)(idx - rangeOfVisibleLines.location) / numberOfLines;
             const CGFloat flippedFraction = 1.0 - fraction;
@@ -280,6 +320,14 @@ static inline void iTermSearchResultsMinimapViewDrawItem(CGFloat offset, CGFloat
     [self updateHidden];
 }
 
+- (void)removeObjectsOfType:(NSInteger)objectType fromLines:(NSIndexSet *)lines {
+    if (lines.count == 0) {
+        return;
+    }
+    [_sets[@(objectType)] removeIndexes:lines];
+    [self updateHidden];
+}
+
 - (void)setFirstVisibleLine:(NSInteger)firstVisibleLine
        numberOfVisibleLines:(NSInteger)numberOfVisibleLines {
     _visibleLines = NSMakeRange(firstVisibleLine, numberOfVisibleLines);
@@ -8,6 +8,8 @@
 
 #import "iTermSelection.h"
 #import "DebugLogging.h"
+#import "iTermAdvancedSettingsModel.h"
+#import "iTermIntervalTreeIndex.h"
 #import "NSArray+iTerm.h"
 #import "NSDictionary+iTerm.h"
 #import "NSIndexSet+iTerm.h"
@@ -148,6 +150,10 @@ static NSString *const kiTermSubSelectionMode = @"Mode";
     BOOL _live;
     BOOL _extend;
     NSMutableArray *_subSelections;  // iTermSubSelection array
+
+    // Maps the lines each sub-selection spans to it. Built on demand when there are many
+    // sub-selections and discarded when they change.
+    iTermIntervalTreeIndex *_subSelectionIndex;
 }
 
 + (NSString *)nameForMode:(iTermSelectionMode)mode {
@@ -179,6 +185,7 @@ static NSString *const kiTermSubSelectionMode = @"Mode";
 
 - (void)dealloc {
     [_subSelections release];
+    [_subSelectionIndex release];
     [super dealloc];
 }
 
@@ -216,6 +223,7 @@ static NSString *const kiTermSubSelectionMode = @"Mode";
         _absRange = sub.absRange;
         _selectionMode = sub.selectionMode;
         [_subSelections removeLastObject];
+        [self subSelectionsDidChange];
     }
     DLog(@"Begin extending selection.");
     _live = YES;
@@ -359,6 +367,7 @@ static NSString *const kiTermSubSelectionMode = @"Mode";
     if (_resumable && resume && [_subSelections count]) {
         _absRange = [self lastAbsRange];
         [_subSelections removeLastObject];
+        [self subSelectionsDidChange];
         // Preserve existing value of appending flag.
     } else {
         _appending = append;
@@ -366,6 +375,7 @@ static NSString *const kiTermSubSelectionMode = @"Mode";
 
     if (!_appending) {
         [_subSelections removeAllObjects];
+        [self subSelectionsDidChange];
     }
     DLog(@"Begin new selection. coord=%@, extend=%d", VT100GridAbsCoordDescription(absCoord), extend);
     _live = YES;
@@ -404,6 +414,7 @@ static NSString *const kiTermSubSelectionMode = @"Mode";
                                                       width:self.width];
             [_subSelections addObject:sub];
         }
+        [self subSelectionsDidChange];
         _resumable = NO;
     } else {
         if (self.liveRangeIsFlipped) {
@@ -419,6 +430,7 @@ static NSString *const kiTermSubSelectionMode = @"Mode";
             sub.absRange = _absRange;
             sub.selectionMode = _selectionMode;
             [_subSelections addObject:sub];
+            [self subSelectionsDidChange];
             _resumable = YES;
         } else {
             _resumable = NO;
@@ -481,6 +493,7 @@ static NSString *const kiTermSubSelectionMode = @"Mode";
         DLog(@"Clear selection");
         _absRange = VT100GridAbsWindowedRangeMake(VT100GridAbsCoordRangeMake(-1, -1, -1, -1), 0, 0);
         [_subSelections removeAllObjects];
+        [self subSelectionsDidChange];
         [_delegate selectionDidChange:[[self retain] autorelease]];
     }
 }
@@ -636,6 +649,8 @@ static NSString *const kiTermSubSelectionMode = @"Mode";
     for (iTermSubSelection *sub in subsToRemove) {
         [_subSelections removeObject:sub];
     }
+    // Ranges may also have been clipped above.
+    [self subSelectionsDidChange];
 
     if (notifyDelegateOfChange) {
         [_delegate selectionDidChange:self];
@@ -654,16 +669,61 @@ static NSString *const kiTermSubSelectionMode = @"Mode";
     if (![self hasSelection]) {
         return NO;
     }
-    BOOL contained = NO;
-    for (iTermSubSelection *sub in [self allSubSelections]) {
+    __block BOOL contained = NO;
+    [self enumerateSubSelectionsOnAbsoluteLine:absCoord.y block:^(iTermSubSelection *sub) {
         if ([sub containsAbsCoord:absCoord]) {
             contained = !contained;
         }
-    }
+    }];
 
     return contained;
 }
 
+// Sub-selections toggle each other, so their order doesn't matter to the callers of this.
+- (void)enumerateSubSelectionsOnAbsoluteLine:(long long)line
+                                       block:(void (^ NS_NOESCAPE)(iTermSubSelection *sub))block {
+    iTermIntervalTreeIndex *index = [self subSelectionIndex];
+    if (index) {
+        [index enumerateObjectsIntersectingLocation:line
+                                              limit:line + 1
+                                              block:^(id object, BOOL *stop) {
+            block(object);
+        }];
+    } else {
+        for (iTermSubSelection *sub in _subSelections) {
+            block(sub);
+        }
+    }
+    if ([self haveLiveSelection]) {
+        block([iTermSubSelection subSelectionWithAbsRange:[self unflippedLiveAbsRange]
+                                                     mode:_selectionMode
+                                                    width:self.width]);
+    }
+}
+
+- (iTermIntervalTreeIndex *)subSelectionIndex {
+    static const NSUInteger iTermSelectionMinimumSubSelectionsToIndex = 16;
+    if (_subSelectionIndex ||
+        _subSelections.count < iTermSelectionMinimumSubSelectionsToIndex ||
+        ![iTermAdvancedSettingsModel indexSubSelections]) {
+        return _subSelectionIndex;
+    }
+    _subSelectionIndex = [[iTermIntervalTreeIndex alloc] init];
+    for (iTermSubSelection *sub in _subSelections) {
+        const VT100GridAbsCoordRange range = sub.absRange.coordRange;
+        // Box ranges may be flipped.
+        [_subSelectionIndex addObject:sub
+                             location:MIN(range.start.y, range.end.y)
+                                limit:MAX(range.start.y, range.end.y) + 1];
+    }
+    return _subSelectionIndex;
+}
+
+- (void)subSelectionsDidChange {
+    [_subSelectionIndex release];
+    _subSelectionIndex = nil;
+}
+
 - (int)width {
     return [_delegate selectionViewportWidth];
 }
@@ -838,6 +898,7 @@ static NSString *const kiTermSubSelectionMode = @"Mode";
                                   withObject:[iTermSubSelection subSelectionWithAbsRange:firstRange
                                                                                     mode:mode
                                                                                    width:self.width]];
+        [self subSelectionsDidChange];
     }
     [_delegate selectionDidChange:[[self retain] autorelease]];
 }
@@ -852,6 +913,7 @@ static NSString *const kiTermSubSelectionMode = @"Mode";
         [_subSelections addObject:[iTermSubSelection subSelectionWithAbsRange:lastRange
                                                                          mode:mode
                                                                         width:self.width]];
+        [self subSelectionsDidChange];
     }
     [_delegate selectionDidChange:[[self retain] autorelease]];
 }
@@ -870,6 +932,7 @@ static NSString *const kiTermSubSelectionMode = @"Mode";
         }
         [_subSelections addObject:sub];
     }
+    [self subSelectionsDidChange];
     [_delegate selectionDidChange:[[self retain] autorelease]];
 }
 
@@ -892,6 +955,7 @@ static NSString *const kiTermSubSelectionMode = @"Mode";
     }
     [_subSelections autorelease];
     _subSelections = [newSubs retain];
+    [self subSelectionsDidChange];
 }
 
 static NSRange iTermMakeRange(NSInteger location, NSInteger length) {
@@ -984,7 +1048,7 @@ static NSRange iTermMakeRange(NSInteger location, NSInteger length) {
 
     // Slow path.
     NSMutableIndexSet *indexes = [NSMutableIndexSet indexSet];
-    for (iTermSubSelection *sub in [self allSubSelections]) {
+    [self enumerateSubSelectionsOnAbsoluteLine:line block:^(iTermSubSelection *sub) {
         VT100GridAbsWindowedRange range = sub.absRange;
         NSRange theRange = [self rangeOfIndexesInAbsRange:range
                                            onAbsoluteLine:line
@@ -1002,7 +1066,7 @@ static NSRange iTermMakeRange(NSInteger location, NSInteger length) {
         }];
         [indexes removeIndexes:indexesToRemove];
         [indexes addIndexes:indexesToAdd];
-    }
+    }];
 
     return indexes;
 }
@@ -56,6 +56,15 @@ extern NSString *const kSemanticHistoryColumnNumberKey;
                 extractedLineNumber:(NSString **)lineNumber
                        columnNumber:(NSString **)columnNumber;
 
+// Like cleanedUpPathFromPath:suffix:workingDirectory:extractedLineNumber:columnNumber: but does
+// its filesystem access on a background queue. The completion block is called on the main queue.
+- (void)cleanUpPathFromPath:(NSString *)path
+                     suffix:(NSString *)suffix
+           workingDirectory:(NSString *)workingDirectory
+                 completion:(void (^)(NSString *cleanedUpPath,
+                                      NSString *lineNumber,
+                                      NSString *columnNumber))completion;
+
 // Opens the file at the relative |path| (which may include :lineNumber) in |workingDirectory|.
 // The |substitutions| dictionary is used to expand \references in the command to run (gotten from
 // self.prefs[kSemanticHistoryTextKey]) as follows:
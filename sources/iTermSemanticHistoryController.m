@@ -92,6 +92,21 @@ NSString *const kSemanticHistoryColumnNumberKey = @"semanticHistory.columnNumber
     return cleaner.cleanPath;
 }
 
+- (void)cleanUpPathFromPath:(NSString *)path
+                     suffix:(NSString *)suffix
+           workingDirectory:(NSString *)workingDirectory
+                 completion:(void (^)(NSString *cleanedUpPath,
+                                      NSString *lineNumber,
+                                      NSString *columnNumber))completion {
+    iTermPathCleaner *cleaner = [[iTermPathCleaner alloc] initWithPath:path
+                                                                suffix:suffix
+                                                      workingDirectory:workingDirectory];
+    cleaner.fileManager = self.fileManager;
+    [cleaner cleanWithCompletion:^{
+        completion(cleaner.cleanPath, cleaner.lineNumber, cleaner.columnNumber);
+    }];
+}
+
 - (NSString *)preferredEditorIdentifier {
     if ([prefs_[kSemanticHistoryActionKey] isEqualToString:kSemanticHistoryBestEditorAction]) {
         return [iTermSemanticHistoryPrefsController bestEditor];
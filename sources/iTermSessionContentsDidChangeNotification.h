@@ -0,0 +1,24 @@
+//
+//  iTermSessionContentsDidChangeNotification.h
+//  iTerm2SharedARC
+//
+//  Created by agent on 10/14/26.
+//
+
+#import "iTermNotificationCenter.h"
+
+NS_ASSUME_NONNULL_BEGIN
+
+@class PTYSession;
+
+// Posted when a session's text view finds dirty lines while the session wants to hear about it.
+// The subject is the session.
+@interface iTermSessionContentsDidChangeNotification : iTermBaseNotification
+
+@property (nonatomic, weak, readonly, nullable) PTYSession *session;
+
++ (instancetype)notificationWithSession:(PTYSession *)session;
+
+@end
+
+NS_ASSUME_NONNULL_END
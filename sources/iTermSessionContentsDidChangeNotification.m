@@ -0,0 +1,26 @@
+//
+//  iTermSessionContentsDidChangeNotification.m
+//  iTerm2SharedARC
+//
+//  Created by agent on 10/14/26.
+//
+
+#import "iTermSessionContentsDidChangeNotification.h"
+#import "iTermNotificationCenter+Protected.h"
+
+@implementation iTermSessionContentsDidChangeNotification
+
++ (instancetype)notificationWithSession:(PTYSession *)session {
+    return [[self alloc] initPrivateWithSubject:session];
+}
+
+- (PTYSession *)session {
+    return self.subject;
+}
+
+// Any number of changes to the same session's contents are reported as one.
+- (nullable instancetype)notificationByMergingNotification:(iTermSessionContentsDidChangeNotification *)later {
+    return self;
+}
+
+@end
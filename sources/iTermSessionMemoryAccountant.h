@@ -0,0 +1,28 @@
+//
+//  iTermSessionMemoryAccountant.h
+//  iTerm2SharedARC
+//
+//  Created by agent on 10/14/26.
+//
+
+#import <Foundation/Foundation.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+@class PTYSession;
+
+// Periodically asks every session to update its session.memoryUsage variable. The interval comes
+// from the sessionMemoryAccountingInterval advanced setting.
+@interface iTermSessionMemoryAccountant : NSObject
+
++ (instancetype)sharedInstance;
+
+// Every session that has been added and not yet freed.
+@property (nonatomic, readonly) NSArray<PTYSession *> *sessions;
+
+// Sessions are held weakly.
+- (void)addSession:(PTYSession *)session;
+
+@end
+
+NS_ASSUME_NONNULL_END
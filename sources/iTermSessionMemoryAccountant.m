@@ -0,0 +1,68 @@
+//
+//  iTermSessionMemoryAccountant.m
+//  iTerm2SharedARC
+//
+//  Created by agent on 10/14/26.
+//
+
+#import "iTermSessionMemoryAccountant.h"
+
+#import "DebugLogging.h"
+#import "iTermAdvancedSettingsModel.h"
+#import "PTYSession.h"
+
+@implementation iTermSessionMemoryAccountant {
+    NSHashTable<PTYSession *> *_sessions;
+    NSTimer *_timer;
+}
+
++ (instancetype)sharedInstance {
+    static dispatch_once_t onceToken;
+    static id instance;
+    dispatch_once(&onceToken, ^{
+        instance = [[self alloc] init];
+    });
+    return instance;
+}
+
+- (instancetype)init {
+    self = [super init];
+    if (self) {
+        _sessions = [NSHashTable weakObjectsHashTable];
+    }
+    return self;
+}
+
+- (NSArray<PTYSession *> *)sessions {
+    return _sessions.allObjects;
+}
+
+- (void)addSession:(PTYSession *)session {
+    [_sessions addObject:session];
+    if (_timer) {
+        return;
+    }
+    const NSTimeInterval interval = [iTermAdvancedSettingsModel sessionMemoryAccountingInterval];
+    if (interval <= 0) {
+        return;
+    }
+    __weak __typeof(self) weakSelf = self;
+    _timer = [NSTimer scheduledTimerWithTimeInterval:interval
+                                             repeats:YES
+                                               block:^(NSTimer * _Nonnull timer) {
+        [weakSelf update];
+    }];
+    // Being a little late is fine, and it lets the system coalesce wakeups.
+    _timer.tolerance = interval / 10;
+}
+
+#pragma mark - Private
+
+- (void)update {
+    DLog(@"Update memory usage of %@ sessions", @(_sessions.count));
+    for (PTYSession *session in _sessions.allObjects) {
+        [session updateMemoryUsage];
+    }
+}
+
+@end
@@ -9,11 +9,14 @@
 #import "iTermShellHistoryController.h"
 
 #import "DebugLogging.h"
+#import "iTermAdvancedSettingsModel.h"
 #import "iTermCommandHistoryEntryMO+Additions.h"
+#import "iTermCommandHistoryPrefixIndex.h"
 #import "iTermDirectoryTree.h"
 #import "iTermHostRecordMO.h"
 #import "iTermHostRecordMO+Additions.h"
 #import "iTermPreferences.h"
+#import "iTermRecentDirectoryIndex.h"
 #import "iTermRecentDirectoryMO.h"
 #import "iTermRecentDirectoryMO+Additions.h"
 #import "NSArray+iTerm.h"
@@ -62,6 +65,24 @@ static const NSTimeInterval kMaxTimeToRememberDirectories = 60 * 60 * 24 * 90;
 
     // Current store is on-disk?
     BOOL _savingToDisk;
+
+    // Keys are remote host keys. Built on first lookup when indexCommandHistoryByPrefix is on.
+    NSMutableDictionary<NSString *, iTermCommandHistoryPrefixIndex *> *_prefixIndexes;
+
+    // The sorted result of the last prefix lookup. Typing extends the prefix, so the next lookup
+    // can usually filter this instead of searching and sorting again.
+    NSString *_lastLookupHostKey;
+    NSString *_lastLookupPrefix;
+    NSArray<iTermCommandHistoryEntryMO *> *_lastLookupResult;
+
+    // A save of command history is scheduled but hasn't happened yet.
+    BOOL _saveScheduled;
+
+    // Keys are remote host keys. Built on first lookup when indexRecentDirectories is on.
+    NSMutableDictionary<NSString *, iTermRecentDirectoryIndex *> *_directoryIndexes;
+
+    // When indexRecentDirectories is on, _tree is filled in on first use rather than at launch.
+    BOOL _treeNeedsLoad;
 }
 
 + (instancetype)sharedInstance {
@@ -100,19 +121,34 @@ static const NSTimeInterval kMaxTimeToRememberDirectories = 60 * 60 * 24 * 90;
     _records = [[NSMutableDictionary alloc] init];
     _expandedCache = [[NSMutableDictionary alloc] init];
     _tree = [[iTermDirectoryTree alloc] init];
+    _prefixIndexes = [[NSMutableDictionary alloc] init];
+    _directoryIndexes = [[NSMutableDictionary alloc] init];
 
     [self removeOldData];
     [self loadObjectGraph];
+    [[NSNotificationCenter defaultCenter] addObserver:self
+                                             selector:@selector(applicationWillTerminate:)
+                                                 name:NSApplicationWillTerminateNotification
+                                               object:nil];
 
     _initializing = NO;
     return YES;
 }
 
 - (void)dealloc {
+    [[NSNotificationCenter defaultCenter] removeObserver:self];
+    if (_saveScheduled) {
+        [self saveObjectGraph];
+    }
     [_records release];
     [_expandedCache release];
     [_managedObjectContext release];
     [_tree release];
+    [_prefixIndexes release];
+    [_directoryIndexes release];
+    [_lastLookupHostKey release];
+    [_lastLookupPrefix release];
+    [_lastLookupResult release];
     [super dealloc];
 }
 
@@ -312,6 +348,7 @@ static const NSTimeInterval kMaxTimeToRememberDirectories = 60 * 60 * 24 * 90;
 }
 
 - (void)saveObjectGraph {
+    _saveScheduled = NO;
     NSError *error = nil;
     @try {
         if (![_managedObjectContext save:&error]) {
@@ -351,6 +388,8 @@ static const NSTimeInterval kMaxTimeToRememberDirectories = 60 * 60 * 24 * 90;
     // Reload everything.
     [_records removeAllObjects];
     [_expandedCache removeAllObjects];
+    [self invalidatePrefixIndexes];
+    [self invalidateDirectoryIndexes];
     [_tree release];
     _tree = [[iTermDirectoryTree alloc] init];
     [self loadObjectGraph];
@@ -411,6 +450,8 @@ static const NSTimeInterval kMaxTimeToRememberDirectories = 60 * 60 * 24 * 90;
         [_managedObjectContext release];
         _managedObjectContext = nil;
         [self initializeCoreDataWithRetry:YES vacuum:NO];
+        [self invalidatePrefixIndexes];
+        [self invalidateDirectoryIndexes];
     }
 
     if (self.shouldSaveToDisk) {
@@ -444,6 +485,8 @@ static const NSTimeInterval kMaxTimeToRememberDirectories = 60 * 60 * 24 * 90;
         [self deleteObjectsWithEntityName:[iTermHostRecordMO entityName]];
     }
 
+    [self invalidatePrefixIndexes];
+    [self invalidateDirectoryIndexes];
     [self saveObjectGraph];
     [self vacuum];
 
@@ -483,7 +526,10 @@ static const NSTimeInterval kMaxTimeToRememberDirectories = 60 * 60 * 24 * 90;
         theEntry = [iTermCommandHistoryEntryMO commandHistoryEntryInContext:_managedObjectContext];
         theEntry.command = command;
         [hostRecord addEntriesObject:theEntry];
+        [_prefixIndexes[host.key ?: @""] addEntry:theEntry];
     }
+    // Scores are about to change.
+    [self forgetLastLookup];
 
     theEntry.numberOfUses = @(theEntry.numberOfUses.integerValue + 1);
     theEntry.timeOfLastUse = @([self now]);
@@ -528,6 +574,11 @@ static const NSTimeInterval kMaxTimeToRememberDirectories = 60 * 60 * 24 * 90;
     if (host == nil) {
         return [self commandHistoryEntriesWithPrefix:partialCommand onHost:[VT100RemoteHost localhost]];
     }
+    if ([iTermAdvancedSettingsModel indexCommandHistoryByPrefix]) {
+        NSArray<iTermCommandHistoryEntryMO *> *sortedEntries =
+            [self sortedCommandHistoryEntriesWithPrefix:partialCommand ?: @"" onHost:host];
+        return [sortedEntries subarrayWithRange:NSMakeRange(0, MIN(kMaxResults, sortedEntries.count))];
+    }
     BOOL emptyPartialCommand = (partialCommand.length == 0);
     NSMutableArray<iTermCommandHistoryEntryMO *> *result = [NSMutableArray array];
     iTermHostRecordMO *hostRecord = [self recordForHost:host];
@@ -609,11 +660,16 @@ static const NSTimeInterval kMaxTimeToRememberDirectories = 60 * 60 * 24 * 90;
     }
 
     // Check if we already have it;
+    iTermRecentDirectoryIndex *index = [self directoryIndexForHost:host];
     iTermRecentDirectoryMO *directory = nil;
-    for (iTermRecentDirectoryMO *existingDirectory in hostRecord.directories) {
-        if ([existingDirectory.path isEqualToString:path]) {
-            directory = existingDirectory;
-            break;
+    if (index) {
+        directory = [index directoryWithPath:path];
+    } else {
+        for (iTermRecentDirectoryMO *existingDirectory in hostRecord.directories) {
+            if ([existingDirectory.path isEqualToString:path]) {
+                directory = existingDirectory;
+                break;
+            }
         }
     }
 
@@ -622,11 +678,16 @@ static const NSTimeInterval kMaxTimeToRememberDirectories = 60 * 60 * 24 * 90;
         directory = [NSEntityDescription insertNewObjectForEntityForName:[iTermRecentDirectoryMO entityName]
                                                   inManagedObjectContext:_managedObjectContext];
         directory.path = path;
-        [_tree addPath:path];
+        if (!_treeNeedsLoad) {
+            [_tree addPath:path];
+        }
         [hostRecord addDirectoriesObject:directory];
+    } else {
+        [index removeDirectory:directory];
     }
     directory.useCount = @(directory.useCount.integerValue + 1);
     directory.lastUse = @([self now]);
+    [index addDirectory:directory];
 
     [self saveDirectories];
 
@@ -634,17 +695,25 @@ static const NSTimeInterval kMaxTimeToRememberDirectories = 60 * 60 * 24 * 90;
 }
 
 - (void)setDirectory:(iTermRecentDirectoryMO *)directory starred:(BOOL)starred {
+    iTermRecentDirectoryIndex *index = _directoryIndexes[directory.remoteHost.hostKey ?: @""];
+    [index removeDirectory:directory];
     directory.starred = @(starred);
+    [index addDirectory:directory];
     [self saveDirectories];
 }
 
 #pragma mark Lookup
 
 - (NSIndexSet *)abbreviationSafeIndexesInRecentDirectory:(iTermRecentDirectoryMO *)entry {
+    [self loadDirectoryTreeIfNeeded];
     return [_tree abbreviationSafeIndexesInPath:entry.path];
 }
 
 - (NSArray *)directoriesSortedByScoreOnHost:(VT100RemoteHost *)host {
+    iTermRecentDirectoryIndex *index = [self directoryIndexForHost:host];
+    if (index) {
+        return index.sortedDirectories;
+    }
     return [[self directoriesForHost:host] sortedArrayUsingSelector:@selector(compare:)];
 }
 
@@ -660,6 +729,8 @@ static const NSTimeInterval kMaxTimeToRememberDirectories = 60 * 60 * 24 * 90;
     if (hostRecord) {
         [hostRecord removeEntries:hostRecord.entries];
         [_expandedCache removeObjectForKey:key];
+        [_prefixIndexes removeObjectForKey:key];
+        [self forgetLastLookup];
         [self saveCommandHistory];
     }
 }
@@ -668,6 +739,7 @@ static const NSTimeInterval kMaxTimeToRememberDirectories = 60 * 60 * 24 * 90;
     iTermHostRecordMO *hostRecord = [self recordForHost:host];
     if (hostRecord) {
         [hostRecord removeDirectories:hostRecord.directories];
+        [_directoryIndexes removeObjectForKey:host.key ?: @""];
         [self saveDirectories];
     }
 }
@@ -752,6 +824,23 @@ static const NSTimeInterval kMaxTimeToRememberDirectories = 60 * 60 * 24 * 90;
 - (void)loadObjectGraph {
     [self loadObjectGraphIntoDictionary:_records];
     [_expandedCache removeAllObjects];
+    if ([iTermAdvancedSettingsModel indexRecentDirectories]) {
+        // Nothing needs the tree until a list of directories is drawn.
+        _treeNeedsLoad = YES;
+        return;
+    }
+    [self loadDirectoryTree];
+}
+
+- (void)loadDirectoryTreeIfNeeded {
+    if (!_treeNeedsLoad) {
+        return;
+    }
+    _treeNeedsLoad = NO;
+    [self loadDirectoryTree];
+}
+
+- (void)loadDirectoryTree {
     for (NSString *hostKey in _records) {
         iTermHostRecordMO *hostRecord = _records[hostKey];
         for (iTermRecentDirectoryMO *directory in hostRecord.directories) {
@@ -801,14 +890,99 @@ static const NSTimeInterval kMaxTimeToRememberDirectories = 60 * 60 * 24 * 90;
 
 }
 
+// Returns all matching entries sorted by score.
+- (NSArray<iTermCommandHistoryEntryMO *> *)sortedCommandHistoryEntriesWithPrefix:(NSString *)partialCommand
+                                                                          onHost:(VT100RemoteHost *)host {
+    NSString *key = host.key ?: @"";
+    if (_lastLookupResult &&
+        [_lastLookupHostKey isEqualToString:key] &&
+        (_lastLookupPrefix.length == 0 || [partialCommand caseInsensitiveHasPrefix:_lastLookupPrefix])) {
+        if (partialCommand.length == _lastLookupPrefix.length) {
+            return _lastLookupResult;
+        }
+        // Filtering preserves the order so there's no need to sort again.
+        NSArray<iTermCommandHistoryEntryMO *> *filtered =
+            [_lastLookupResult filteredArrayUsingBlock:^BOOL(iTermCommandHistoryEntryMO *entry) {
+                return [entry.command caseInsensitiveHasPrefix:partialCommand];
+            }];
+        [self rememberLookupOfPrefix:partialCommand hostKey:key result:filtered];
+        return filtered;
+    }
+
+    iTermCommandHistoryPrefixIndex *index = _prefixIndexes[key];
+    if (!index) {
+        NSArray<iTermCommandHistoryEntryMO *> *entries = [[self recordForHost:host].entries allObjects] ?: @[];
+        index = [[[iTermCommandHistoryPrefixIndex alloc] initWithEntries:entries] autorelease];
+        _prefixIndexes[key] = index;
+    }
+    NSArray<iTermCommandHistoryEntryMO *> *matches = [index entriesWithPrefix:partialCommand];
+    for (iTermCommandHistoryEntryMO *entry in matches) {
+        entry.matchLocation = @0;
+    }
+    NSArray<iTermCommandHistoryEntryMO *> *sorted = [matches sortedArrayUsingSelector:@selector(compare:)];
+    [self rememberLookupOfPrefix:partialCommand hostKey:key result:sorted];
+    return sorted;
+}
+
+- (void)rememberLookupOfPrefix:(NSString *)prefix
+                       hostKey:(NSString *)hostKey
+                        result:(NSArray<iTermCommandHistoryEntryMO *> *)result {
+    [_lastLookupHostKey autorelease];
+    _lastLookupHostKey = [hostKey copy];
+    [_lastLookupPrefix autorelease];
+    _lastLookupPrefix = [prefix copy];
+    [_lastLookupResult autorelease];
+    _lastLookupResult = [result retain];
+}
+
+- (void)forgetLastLookup {
+    [_lastLookupResult release];
+    _lastLookupResult = nil;
+}
+
+- (void)invalidatePrefixIndexes {
+    [_prefixIndexes removeAllObjects];
+    [self forgetLastLookup];
+}
+
 - (void)saveCommandHistory {
-    [self saveObjectGraph];
+    if ([iTermAdvancedSettingsModel indexCommandHistoryByPrefix]) {
+        // Commands often come in bursts (and each one is followed by its exit status), so save
+        // them together.
+        [self scheduleSave];
+    } else {
+        [self saveObjectGraph];
+    }
     if (!_initializing) {
         [[NSNotificationCenter defaultCenter] postNotificationName:kCommandHistoryDidChangeNotificationName
                                                             object:nil];
     }
 }
 
+- (void)scheduleSave {
+    if (_saveScheduled) {
+        return;
+    }
+    _saveScheduled = YES;
+    [self retain];
+    dispatch_after(dispatch_time(DISPATCH_TIME_NOW, (int64_t)(1 * NSEC_PER_SEC)), dispatch_get_main_queue(), ^{
+        [self saveScheduledChanges];
+        [self release];
+    });
+}
+
+- (void)saveScheduledChanges {
+    if (!_saveScheduled) {
+        return;
+    }
+    _saveScheduled = NO;
+    [self saveObjectGraph];
+}
+
+- (void)applicationWillTerminate:(NSNotification *)notification {
+    [self saveScheduledChanges];
+}
+
 #pragma mark Private Directories
 
 - (NSArray<iTermRecentDirectoryMO *> *)directoriesForHost:(VT100RemoteHost *)host {
@@ -824,6 +998,25 @@ static const NSTimeInterval kMaxTimeToRememberDirectories = 60 * 60 * 24 * 90;
     return [starred arrayByAddingObjectsFromArray:results];
 }
 
+// Returns nil if indexRecentDirectories is off.
+- (iTermRecentDirectoryIndex *)directoryIndexForHost:(VT100RemoteHost *)host {
+    if (![iTermAdvancedSettingsModel indexRecentDirectories]) {
+        return nil;
+    }
+    NSString *key = host.key ?: @"";
+    iTermRecentDirectoryIndex *index = _directoryIndexes[key];
+    if (!index) {
+        NSArray<iTermRecentDirectoryMO *> *directories = [[self recordForHost:host].directories allObjects] ?: @[];
+        index = [[[iTermRecentDirectoryIndex alloc] initWithDirectories:directories] autorelease];
+        _directoryIndexes[key] = index;
+    }
+    return index;
+}
+
+- (void)invalidateDirectoryIndexes {
+    [_directoryIndexes removeAllObjects];
+}
+
 - (void)saveDirectories {
     [self saveObjectGraph];
     if (!_initializing) {
@@ -23,6 +23,11 @@
     return YES;
 }
 
+// Prompt detection has to agree with the cursor at the time the line ends.
+- (BOOL)needsSynchronousEvaluation {
+    return YES;
+}
+
 - (BOOL)performActionWithCapturedStrings:(NSString *const *)capturedStrings
                           capturedRanges:(const NSRange *)capturedRanges
                             captureCount:(NSInteger)captureCount
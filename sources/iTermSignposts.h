@@ -0,0 +1,43 @@
+//
+//  iTermSignposts.h
+//  iTerm2SharedARC
+//
+//  Created by agent on 10/14/26.
+//
+
+#import <Foundation/Foundation.h>
+#import <os/signpost.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+// Signposts that follow input from the keyboard to the screen. To see them in Instruments, add the
+// os_signpost instrument and filter on subsystem com.googlecode.iterm2, category Latency.
+//
+// Intervals:
+//   Keystroke      From PTYSession's -keyDown: until the next write to a pty.
+//   Write          One write of queued input to a pty.
+//   ReadBatch      Handling every file descriptor that one wakeup of TaskNotifier found ready.
+//   Read           One read from a pty, including parsing what was read.
+//   Parse          Handing one read's bytes to the parser and collecting tokens.
+//   ExecuteTokens  Executing one batch of tokens on the main thread.
+//   UpdateDisplay  One tick of the update cadence controller.
+//   Frame          A Metal frame, from when it's committed to being drawn until the GPU finishes.
+//   SyncDraw       -[iTermMetalDriver drawAsynchronouslyInView:completion:], e.g., during resize.
+// Events:
+//   Present        A Metal frame reaching the screen. Shares its Frame's signpost ID.
+//
+// Each carries keystroke=N, the signpost ID of the Keystroke interval that began most recently, so
+// one trace can be narrowed to everything that followed a keystroke: write, echo read, parse,
+// execution, frame, and present.
+os_log_t iTermSignpostLog(void);
+
+// Begins a Keystroke interval. One that's still open is ended first.
+void iTermSignpostKeystrokeBegan(void);
+
+// Ends the open Keystroke interval, if there is one.
+void iTermSignpostKeystrokeWritten(void);
+
+// Signpost ID of the most recent Keystroke interval or 0 if there hasn't been one.
+uint64_t iTermSignpostCurrentKeystroke(void);
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,51 @@
+//
+//  iTermSignposts.m
+//  iTerm2SharedARC
+//
+//  Created by agent on 10/14/26.
+//
+
+#import "iTermSignposts.h"
+
+#import <stdatomic.h>
+
+static _Atomic uint64_t gCurrentKeystroke;
+// Nonzero while a Keystroke interval is open.
+static _Atomic uint64_t gOpenKeystroke;
+
+os_log_t iTermSignpostLog(void) {
+    static os_log_t log;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        log = os_log_create("com.googlecode.iterm2", "Latency");
+    });
+    return log;
+}
+
+void iTermSignpostKeystrokeBegan(void) {
+    os_log_t log = iTermSignpostLog();
+    if (!os_signpost_enabled(log)) {
+        return;
+    }
+    const os_signpost_id_t spid = os_signpost_id_generate(log);
+    atomic_store_explicit(&gCurrentKeystroke, spid, memory_order_relaxed);
+    const os_signpost_id_t previous = atomic_exchange(&gOpenKeystroke, spid);
+    if (previous) {
+        os_signpost_interval_end(log, previous, "Keystroke", "written=0");
+    }
+    os_signpost_interval_begin(log, spid, "Keystroke", "keystroke=%llu", spid);
+}
+
+void iTermSignpostKeystrokeWritten(void) {
+    if (!atomic_load_explicit(&gOpenKeystroke, memory_order_relaxed)) {
+        return;
+    }
+    const os_signpost_id_t spid = atomic_exchange(&gOpenKeystroke, 0);
+    if (spid) {
+        os_signpost_interval_end(iTermSignpostLog(), spid, "Keystroke", "written=1");
+    }
+}
+
+uint64_t iTermSignpostCurrentKeystroke(void) {
+    return atomic_load_explicit(&gCurrentKeystroke, memory_order_relaxed);
+}
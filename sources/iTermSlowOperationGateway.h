@@ -6,6 +6,7 @@
 //
 
 #import <Foundation/Foundation.h>
+#import "pidinfoProtocol.h"
 
 @class iTermGitState;
 
@@ -38,6 +39,12 @@ NS_ASSUME_NONNULL_BEGIN
                          reqid:(int)reqid
                     completion:(void (^)(int rc, NSData *buffer))completion;
 
+// Infos is nil on failure or timeout. Otherwise it has one entry per pid. See the pidinfo protocol.
+- (void)asyncGetInfoForProcesses:(NSArray<NSNumber *> *)pids
+                          fields:(iTermPidInfoFields)fields
+                           reqid:(int)reqid
+                      completion:(void (^)(NSArray<NSDictionary<NSNumber *, NSData *> *> * _Nullable infos))completion;
+
 // Get the value of an environment variable from the user's shell.
 - (void)exfiltrateEnvironmentVariableNamed:(NSString *)name
                                      shell:(NSString *)shell
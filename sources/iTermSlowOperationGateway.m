@@ -195,6 +195,36 @@ typedef void (^iTermRecentBranchFetchCallback)(NSArray<NSString *> *);
     });
 }
 
+- (void)asyncGetInfoForProcesses:(NSArray<NSNumber *> *)pids
+                          fields:(iTermPidInfoFields)fields
+                           reqid:(int)reqid
+                      completion:(void (^)(NSArray<NSDictionary<NSNumber *, NSData *> *> * _Nullable))completion {
+    __block atomic_flag finished = ATOMIC_FLAG_INIT;
+    [[_connectionToService remoteObjectProxy] getProcessInfoForProcessIDs:pids
+                                                                   fields:@(fields)
+                                                                    reqid:reqid
+                                                                withReply:^(NSArray<NSDictionary<NSNumber *, NSData *> *> * _Nullable infos) {
+        // Called on a private queue
+        if (atomic_flag_test_and_set(&finished)) {
+            DLog(@"Return early because already timed out for %@ pids", @(pids.count));
+            return;
+        }
+        DLog(@"Completed with %@ infos for %@ pids", @(infos.count), @(pids.count));
+        if (infos.count != pids.count) {
+            completion(nil);
+            return;
+        }
+        completion(infos);
+    }];
+    dispatch_after(dispatch_time(DISPATCH_TIME_NOW, (int64_t)(_timeout * NSEC_PER_SEC)), dispatch_get_main_queue(), ^{
+        if (atomic_flag_test_and_set(&finished)) {
+            return;
+        }
+        DLog(@"Timed out");
+        completion(nil);
+    });
+}
+
 - (void)runCommandInUserShell:(NSString *)command completion:(void (^)(NSString *))completion {
     [[_connectionToService remoteObjectProxy] runShellScript:command
                                                        shell:[iTermOpenDirectory userShell] ?: @"/bin/bash"
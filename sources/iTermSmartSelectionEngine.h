@@ -0,0 +1,45 @@
+//
+//  iTermSmartSelectionEngine.h
+//  iTerm2SharedARC
+//
+//  Created by agent on 10/14/26.
+//
+
+#import <Foundation/Foundation.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+// A rule's match in a text window. The range is in the text's UTF-16 offsets.
+@interface iTermSmartSelectionEngineMatch : NSObject
+@property (nonatomic, readonly) NSDictionary *rule;
+@property (nonatomic, readonly) NSRange range;
+@property (nonatomic, readonly) double score;
+// 0 is the full match, 1+ are capture groups. Groups that did not participate are empty.
+@property (nonatomic, readonly) NSArray<NSString *> *components;
+@end
+
+// Compiles a set of smart selection rules once and evaluates them against text windows. Rules
+// are evaluated concurrently and the results for the most recent text window are cached, so
+// asking about the same click again (e.g., double-click followed by cmd-click) is free.
+//
+// Not thread-safe. Use it from the main thread.
+@interface iTermSmartSelectionEngine : NSObject
+
+@property (nonatomic, readonly) NSArray<NSDictionary *> *rules;
+
+// Returns an engine for these rules, reusing the last one if the rules haven't changed.
++ (instancetype)engineForRules:(NSArray<NSDictionary *> *)rules;
+
+- (instancetype)initWithRules:(NSArray<NSDictionary *> *)rules NS_DESIGNATED_INITIALIZER;
+- (instancetype)init NS_UNAVAILABLE;
+
+// Returns matches that contain targetOffset. Each rule is tried at successive offsets up to
+// targetOffset, as -[iTermTextExtractor smartSelectionAt:...] always has. When several rules
+// match the same string only the highest-scoring match (the earliest rule, in a tie) is kept.
+- (NSArray<iTermSmartSelectionEngineMatch *> *)matchesInText:(NSString *)text
+                                                targetOffset:(int)targetOffset
+                                              actionRequired:(BOOL)actionRequired;
+
+@end
+
+NS_ASSUME_NONNULL_END
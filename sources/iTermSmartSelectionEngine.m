@@ -0,0 +1,184 @@
+//
+//  iTermSmartSelectionEngine.m
+//  iTerm2SharedARC
+//
+//  Created by agent on 10/14/26.
+//
+
+#import "iTermSmartSelectionEngine.h"
+
+#import "DebugLogging.h"
+#import "SmartSelectionController.h"
+
+@implementation iTermSmartSelectionEngineMatch
+
+- (instancetype)initWithRule:(NSDictionary *)rule
+                       range:(NSRange)range
+                       score:(double)score
+                  components:(NSArray<NSString *> *)components {
+    self = [super init];
+    if (self) {
+        _rule = rule;
+        _range = range;
+        _score = score;
+        _components = components;
+    }
+    return self;
+}
+
+@end
+
+// A rule with its regex compiled.
+@interface iTermSmartSelectionCompiledRule : NSObject
+@property (nonatomic, strong) NSDictionary *rule;
+@property (nonatomic, strong) NSRegularExpression *regex;
+@property (nonatomic) double precision;
+@property (nonatomic) BOOL hasActions;
+@end
+
+@implementation iTermSmartSelectionCompiledRule
+@end
+
+@implementation iTermSmartSelectionEngine {
+    NSArray<iTermSmartSelectionCompiledRule *> *_compiledRules;
+
+    // Cache of the last query.
+    NSString *_lastText;
+    int _lastTargetOffset;
+    BOOL _lastActionRequired;
+    NSArray<iTermSmartSelectionEngineMatch *> *_lastMatches;
+}
+
++ (instancetype)engineForRules:(NSArray<NSDictionary *> *)rules {
+    static iTermSmartSelectionEngine *lastEngine;
+    if (lastEngine.rules != rules && ![lastEngine.rules isEqualToArray:rules]) {
+        lastEngine = [[self alloc] initWithRules:rules];
+    }
+    return lastEngine;
+}
+
+- (instancetype)initWithRules:(NSArray<NSDictionary *> *)rules {
+    self = [super init];
+    if (self) {
+        _rules = [rules copy];
+        NSMutableArray<iTermSmartSelectionCompiledRule *> *compiledRules = [NSMutableArray array];
+        for (NSDictionary *rule in rules) {
+            NSString *pattern = [SmartSelectionController regexInRule:rule];
+            NSError *error = nil;
+            NSRegularExpression *regex = pattern ? [NSRegularExpression regularExpressionWithPattern:pattern
+                                                                                             options:0
+                                                                                               error:&error] : nil;
+            if (!regex) {
+                DLog(@"Ignore smart selection rule with bad regex %@: %@", pattern, error);
+                continue;
+            }
+            iTermSmartSelectionCompiledRule *compiledRule = [[iTermSmartSelectionCompiledRule alloc] init];
+            compiledRule.rule = rule;
+            compiledRule.regex = regex;
+            compiledRule.precision = [SmartSelectionController precisionInRule:rule];
+            compiledRule.hasActions = [[SmartSelectionController actionsInRule:rule] count] > 0;
+            [compiledRules addObject:compiledRule];
+        }
+        _compiledRules = compiledRules;
+    }
+    return self;
+}
+
+- (NSArray<iTermSmartSelectionEngineMatch *> *)matchesInText:(NSString *)text
+                                                targetOffset:(int)targetOffset
+                                              actionRequired:(BOOL)actionRequired {
+    if (_lastMatches &&
+        _lastTargetOffset == targetOffset &&
+        _lastActionRequired == actionRequired &&
+        [_lastText isEqualToString:text]) {
+        DLog(@"Reuse cached smart selection matches");
+        return _lastMatches;
+    }
+    NSString *immutableText = [text copy];
+    NSArray<iTermSmartSelectionCompiledRule *> *compiledRules = _compiledRules;
+    const size_t count = compiledRules.count;
+    NSMutableArray *matchesByRule = [NSMutableArray arrayWithCapacity:count];
+    for (size_t i = 0; i < count; i++) {
+        [matchesByRule addObject:[NSNull null]];
+    }
+    // NSRegularExpression is safe to use from many threads at once.
+    dispatch_apply(count, dispatch_get_global_queue(QOS_CLASS_USER_INTERACTIVE, 0), ^(size_t j) {
+        iTermSmartSelectionCompiledRule *compiledRule = compiledRules[j];
+        if (actionRequired && !compiledRule.hasActions) {
+            return;
+        }
+        NSArray *matches = [self matchesOfRule:compiledRule inText:immutableText targetOffset:targetOffset];
+        @synchronized (matchesByRule) {
+            matchesByRule[j] = matches;
+        }
+    });
+
+    // Merge in rule order so ties go to the earlier rule, as they did when rules were evaluated
+    // one after another.
+    NSMutableDictionary<NSString *, iTermSmartSelectionEngineMatch *> *best = [NSMutableDictionary dictionary];
+    NSMutableArray<iTermSmartSelectionEngineMatch *> *result = [NSMutableArray array];
+    for (id matches in matchesByRule) {
+        if (matches == [NSNull null]) {
+            continue;
+        }
+        for (iTermSmartSelectionEngineMatch *match in matches) {
+            NSString *string = match.components.firstObject;
+            iTermSmartSelectionEngineMatch *oldMatch = best[string];
+            if (oldMatch && match.score <= oldMatch.score) {
+                continue;
+            }
+            if (oldMatch) {
+                [result removeObjectIdenticalTo:oldMatch];
+            }
+            best[string] = match;
+            [result addObject:match];
+        }
+    }
+
+    _lastText = immutableText;
+    _lastTargetOffset = targetOffset;
+    _lastActionRequired = actionRequired;
+    _lastMatches = result;
+    return result;
+}
+
+#pragma mark - Private
+
+// Searching a range with the default (opaque, anchoring) bounds behaves like searching a
+// substring starting at the same place, without having to make the substring.
+- (NSArray<iTermSmartSelectionEngineMatch *> *)matchesOfRule:(iTermSmartSelectionCompiledRule *)compiledRule
+                                                      inText:(NSString *)text
+                                                targetOffset:(int)targetOffset {
+    NSMutableArray<iTermSmartSelectionEngineMatch *> *matches = [NSMutableArray array];
+    if (targetOffset < 0) {
+        return matches;
+    }
+    const NSUInteger target = targetOffset;
+    const NSUInteger length = text.length;
+    for (NSUInteger i = 0; i <= target && i <= length; i++) {
+        NSTextCheckingResult *match = [compiledRule.regex firstMatchInString:text
+                                                                     options:0
+                                                                       range:NSMakeRange(i, length - i)];
+        if (!match || match.range.location == NSNotFound) {
+            break;
+        }
+        const NSRange range = match.range;
+        if (range.location <= target && NSMaxRange(range) > target) {
+            NSMutableArray<NSString *> *components = [NSMutableArray arrayWithCapacity:match.numberOfRanges];
+            for (NSUInteger g = 0; g < match.numberOfRanges; g++) {
+                const NSRange groupRange = [match rangeAtIndex:g];
+                [components addObject:groupRange.location == NSNotFound ? @"" : [text substringWithRange:groupRange]];
+            }
+            [matches addObject:[[iTermSmartSelectionEngineMatch alloc] initWithRule:compiledRule.rule
+                                                                             range:range
+                                                                             score:compiledRule.precision * (double)range.length
+                                                                        components:components]];
+            i = NSMaxRange(range) - 1;
+        } else {
+            i = range.location;
+        }
+    }
+    return matches;
+}
+
+@end
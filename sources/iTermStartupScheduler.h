@@ -0,0 +1,44 @@
+//
+//  iTermStartupScheduler.h
+//  iTerm2SharedARC
+//
+//  Created by agent on 10/14/26.
+//
+
+#import <Foundation/Foundation.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+typedef NS_ENUM(NSInteger, iTermStartupTaskPriority) {
+    // Things the user might reach for right away, like menus.
+    iTermStartupTaskPriorityHigh,
+    iTermStartupTaskPriorityNormal,
+    // Checks that may show a dialog. They go last so they don't interrupt restoring windows.
+    iTermStartupTaskPriorityLow
+};
+
+// Runs launch work that the first window doesn't need once the app goes idle, and records a
+// timeline of launch so regressions are visible in the performance counters panel.
+@interface iTermStartupScheduler : NSObject
+
++ (instancetype)sharedInstance;
+
+// Records the first time a stage of launch is reached. Later calls with the same name are ignored.
+- (void)mark:(NSString *)name;
+
+// Runs block when the main thread is idle after the first windows are open. Higher priorities run
+// first and tasks of equal priority run in the order they were added, one per pass of the runloop.
+// Runs it right away when deferral is disabled or launch is already over.
+- (void)deferTaskNamed:(NSString *)name
+              priority:(iTermStartupTaskPriority)priority
+                 block:(void (^)(void))block;
+
+// Call when the first windows have been opened. Deferred tasks begin at the next idle time.
+- (void)didFinishCriticalStartup;
+
+// One line per mark with the number of seconds since the process started.
+- (NSString *)timelineDescription;
+
+@end
+
+NS_ASSUME_NONNULL_END
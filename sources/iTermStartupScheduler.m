@@ -0,0 +1,161 @@
+//
+//  iTermStartupScheduler.m
+//  iTerm2SharedARC
+//
+//  Created by agent on 10/14/26.
+//
+
+#import "iTermStartupScheduler.h"
+
+#import "DebugLogging.h"
+#import "iTermAdvancedSettingsModel.h"
+
+#include <sys/sysctl.h>
+
+@interface iTermStartupTask : NSObject
+@property (nonatomic, copy) NSString *name;
+@property (nonatomic) iTermStartupTaskPriority priority;
+@property (nonatomic) NSUInteger ordinal;
+@property (nonatomic, copy) void (^block)(void);
+@end
+
+@implementation iTermStartupTask
+@end
+
+@implementation iTermStartupScheduler {
+    NSTimeInterval _processStartTime;
+    NSMutableArray<NSString *> *_markNames;
+    NSMutableArray<NSNumber *> *_markTimes;
+    NSMutableArray<iTermStartupTask *> *_tasks;
+    NSUInteger _nextOrdinal;
+    CFRunLoopObserverRef _observer;
+    // Set once every deferred task has run. Tasks added after that run right away.
+    BOOL _finished;
+}
+
++ (instancetype)sharedInstance {
+    static iTermStartupScheduler *instance;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        instance = [[self alloc] init];
+    });
+    return instance;
+}
+
+// Falls back to now if the kernel won't say, which makes the timeline relative to the first mark.
+static NSTimeInterval iTermStartupSchedulerProcessStartTime(void) {
+    struct kinfo_proc info;
+    size_t size = sizeof(info);
+    int mib[4] = { CTL_KERN, KERN_PROC, KERN_PROC_PID, getpid() };
+    if (sysctl(mib, 4, &info, &size, NULL, 0) != 0 || size == 0) {
+        return [NSDate timeIntervalSinceReferenceDate];
+    }
+    const struct timeval start = info.kp_proc.p_starttime;
+    return start.tv_sec + start.tv_usec / 1000000.0 - NSTimeIntervalSince1970;
+}
+
+- (instancetype)init {
+    self = [super init];
+    if (self) {
+        _processStartTime = iTermStartupSchedulerProcessStartTime();
+        _markNames = [NSMutableArray array];
+        _markTimes = [NSMutableArray array];
+        _tasks = [NSMutableArray array];
+    }
+    return self;
+}
+
+- (void)mark:(NSString *)name {
+    if ([_markNames containsObject:name]) {
+        return;
+    }
+    const NSTimeInterval elapsed = [NSDate timeIntervalSinceReferenceDate] - _processStartTime;
+    DLog(@"Startup: %@ at %.3fs", name, elapsed);
+    [_markNames addObject:name];
+    [_markTimes addObject:@(elapsed)];
+}
+
+- (void)deferTaskNamed:(NSString *)name
+              priority:(iTermStartupTaskPriority)priority
+                 block:(void (^)(void))block {
+    if (_finished || ![iTermAdvancedSettingsModel deferNonCriticalStartupWork]) {
+        [self runTaskNamed:name block:block];
+        return;
+    }
+    DLog(@"Defer startup task %@", name);
+    iTermStartupTask *task = [[iTermStartupTask alloc] init];
+    task.name = name;
+    task.priority = priority;
+    task.ordinal = _nextOrdinal++;
+    task.block = block;
+    [_tasks addObject:task];
+}
+
+- (void)didFinishCriticalStartup {
+    [self mark:@"Critical startup finished"];
+    if (_observer || _finished) {
+        return;
+    }
+    if (_tasks.count == 0) {
+        [self finish];
+        return;
+    }
+    [_tasks sortUsingComparator:^NSComparisonResult(iTermStartupTask *lhs, iTermStartupTask *rhs) {
+        if (lhs.priority != rhs.priority) {
+            return lhs.priority < rhs.priority ? NSOrderedAscending : NSOrderedDescending;
+        }
+        return [@(lhs.ordinal) compare:@(rhs.ordinal)];
+    }];
+    // The runloop is about to wait only when it has nothing else to do, so this runs tasks in
+    // idle time. Common modes are avoided so nothing runs during menu tracking or a live resize.
+    __weak __typeof(self) weakSelf = self;
+    _observer = CFRunLoopObserverCreateWithHandler(kCFAllocatorDefault,
+                                                   kCFRunLoopBeforeWaiting,
+                                                   true,
+                                                   0,
+                                                   ^(CFRunLoopObserverRef observer, CFRunLoopActivity activity) {
+        [weakSelf runNextTask];
+    });
+    CFRunLoopAddObserver(CFRunLoopGetMain(), _observer, kCFRunLoopDefaultMode);
+}
+
+- (NSString *)timelineDescription {
+    NSMutableString *result = [NSMutableString string];
+    for (NSUInteger i = 0; i < _markNames.count; i++) {
+        [result appendFormat:@"%9.3f  %@\n", _markTimes[i].doubleValue, _markNames[i]];
+    }
+    return result;
+}
+
+#pragma mark - Private
+
+- (void)runNextTask {
+    iTermStartupTask *task = _tasks.firstObject;
+    if (!task) {
+        [self finish];
+        return;
+    }
+    [_tasks removeObjectAtIndex:0];
+    [self runTaskNamed:task.name block:task.block];
+    // Come back for the next one after input that arrived meanwhile has been handled.
+    CFRunLoopWakeUp(CFRunLoopGetMain());
+}
+
+- (void)runTaskNamed:(NSString *)name block:(void (^)(void))block {
+    const NSTimeInterval start = [NSDate timeIntervalSinceReferenceDate];
+    block();
+    const NSTimeInterval duration = [NSDate timeIntervalSinceReferenceDate] - start;
+    [self mark:[NSString stringWithFormat:@"%@ (%.0f ms)", name, duration * 1000]];
+}
+
+- (void)finish {
+    if (_observer) {
+        CFRunLoopRemoveObserver(CFRunLoopGetMain(), _observer, kCFRunLoopDefaultMode);
+        CFRelease(_observer);
+        _observer = NULL;
+    }
+    _finished = YES;
+    [self mark:@"Deferred startup work finished"];
+}
+
+@end
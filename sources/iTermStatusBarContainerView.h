@@ -48,6 +48,11 @@ const CGFloat iTermGetStatusBarHeight(void);
 - (instancetype)init NS_UNAVAILABLE;
 
 - (void)layoutSubviews;
+- (void)setNeedsUpdate;
+
+// For iTermStatusBarUpdateScheduler. A skipped update is performed once the view is on screen.
+- (void)scheduledUpdateWasSkipped;
+- (void)updateIfSkipped;
 
 @end
 
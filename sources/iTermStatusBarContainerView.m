@@ -10,6 +10,7 @@
 #import "DebugLogging.h"
 #import "iTermAdvancedSettingsModel.h"
 #import "iTermStatusBarBaseComponent.h"
+#import "iTermStatusBarUpdateScheduler.h"
 #import "iTermUnreadCountView.h"
 #import "NSDictionary+iTerm.h"
 #import "NSEvent+iTerm.h"
@@ -36,6 +37,8 @@ const CGFloat iTermGetStatusBarHeight() {
     BOOL _needsUpdate;
     NSView *_view;
     iTermUnreadCountView *_unreadCountView;
+    // Set when iTermStatusBarUpdateScheduler skipped an update because this view was off screen.
+    BOOL _skippedUpdate;
 }
 
 - (nullable instancetype)initWithComponent:(id<iTermStatusBarComponent>)component {
@@ -55,11 +58,16 @@ const CGFloat iTermGetStatusBarHeight() {
         _view = component.statusBarComponentView;
         [self addSubview:_view];
         _view.frame = NSMakeRect(self.minX, 0, self.preferredWidthForComponentView, self.frame.size.height);
-        _timer = [NSTimer scheduledWeakTimerWithTimeInterval:_component.statusBarComponentUpdateCadence
-                                                      target:self
-                                                    selector:@selector(reevaluateTimer:)
-                                                    userInfo:nil
-                                                     repeats:YES];
+        if ([iTermStatusBarUpdateScheduler enabled]) {
+            [[iTermStatusBarUpdateScheduler sharedInstance] addContainerView:self
+                                                                     cadence:_component.statusBarComponentUpdateCadence];
+        } else {
+            _timer = [NSTimer scheduledWeakTimerWithTimeInterval:_component.statusBarComponentUpdateCadence
+                                                          target:self
+                                                        selector:@selector(reevaluateTimer:)
+                                                        userInfo:nil
+                                                         repeats:YES];
+        }
         [component statusBarComponentUpdate];
 
         if ([component statusBarComponentHandlesClicks]) {
@@ -78,6 +86,9 @@ const CGFloat iTermGetStatusBarHeight() {
 
 - (void)dealloc {
     [_timer invalidate];
+    if ([iTermStatusBarUpdateScheduler enabled]) {
+        [[iTermStatusBarUpdateScheduler sharedInstance] removeContainerView:self];
+    }
 }
 
 - (void)updateIconIfNeeded {
@@ -164,8 +175,38 @@ const CGFloat iTermGetStatusBarHeight() {
         return;
     }
     _needsUpdate = NO;
+    _skippedUpdate = NO;
     [self updateIconIfNeeded];
+    if (![iTermStatusBarUpdateScheduler enabled]) {
+        [self.component statusBarComponentUpdate];
+        return;
+    }
+    const NSTimeInterval start = [NSDate timeIntervalSinceReferenceDate];
     [self.component statusBarComponentUpdate];
+    [[iTermStatusBarUpdateScheduler sharedInstance] recordUpdateOfComponentClass:[self.component class]
+                                                                        duration:[NSDate timeIntervalSinceReferenceDate] - start];
+}
+
+- (void)scheduledUpdateWasSkipped {
+    _skippedUpdate = YES;
+}
+
+- (void)updateIfSkipped {
+    if (_skippedUpdate) {
+        [self setNeedsUpdate];
+    }
+}
+
+- (void)viewDidMoveToWindow {
+    [super viewDidMoveToWindow];
+    if (self.window) {
+        [self updateIfSkipped];
+    }
+}
+
+- (void)viewDidUnhide {
+    [super viewDidUnhide];
+    [self updateIfSkipped];
 }
 
 - (void)resizeSubviewsWithOldSize:(NSSize)oldSize {
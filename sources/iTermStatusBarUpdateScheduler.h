@@ -0,0 +1,32 @@
+//
+//  iTermStatusBarUpdateScheduler.h
+//  iTerm2SharedARC
+//
+//  Created by agent on 10/14/26.
+//
+
+#import <Foundation/Foundation.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+@class iTermStatusBarContainerView;
+
+// Drives periodic updates of all status bar components from one timer instead of one timer per
+// component. Updates are aligned to multiples of each component's cadence so components with the
+// same cadence update together on a shared tick. Components that aren't on screen are skipped
+// and updated as soon as they reappear. The cost of each kind of component is kept in a pinned
+// debug log message.
+@interface iTermStatusBarUpdateScheduler : NSObject
+
++ (BOOL)enabled;
++ (instancetype)sharedInstance;
+
+- (void)addContainerView:(iTermStatusBarContainerView *)containerView cadence:(NSTimeInterval)cadence;
+- (void)removeContainerView:(iTermStatusBarContainerView *)containerView;
+
+// Adds the time taken to update a component to its totals.
+- (void)recordUpdateOfComponentClass:(Class)componentClass duration:(NSTimeInterval)duration;
+
+@end
+
+NS_ASSUME_NONNULL_END
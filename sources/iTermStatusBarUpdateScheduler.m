@@ -0,0 +1,198 @@
+//
+//  iTermStatusBarUpdateScheduler.m
+//  iTerm2SharedARC
+//
+//  Created by agent on 10/14/26.
+//
+
+#import "iTermStatusBarUpdateScheduler.h"
+
+#import "DebugLogging.h"
+#import "iTermAdvancedSettingsModel.h"
+#import "iTermStatusBarContainerView.h"
+#import "NSArray+iTerm.h"
+#import "NSTimer+iTerm.h"
+
+@interface iTermStatusBarScheduledContainer : NSObject
+@property (nonatomic, weak) iTermStatusBarContainerView *containerView;
+@property (nonatomic) NSTimeInterval cadence;
+@property (nonatomic) NSTimeInterval nextUpdate;
+@end
+
+@implementation iTermStatusBarScheduledContainer
+@end
+
+@interface iTermStatusBarComponentCost : NSObject
+@property (nonatomic) NSInteger count;
+@property (nonatomic) NSTimeInterval total;
+@end
+
+@implementation iTermStatusBarComponentCost
+@end
+
+@implementation iTermStatusBarUpdateScheduler {
+    NSMutableArray<iTermStatusBarScheduledContainer *> *_containers;
+    NSTimer *_timer;
+    NSTimeInterval _timerFireTime;
+    NSMutableDictionary<NSString *, iTermStatusBarComponentCost *> *_costs;
+}
+
++ (BOOL)enabled {
+    static BOOL enabled;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        enabled = [iTermAdvancedSettingsModel sharedStatusBarUpdateScheduler];
+    });
+    return enabled;
+}
+
++ (instancetype)sharedInstance {
+    static id instance;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        instance = [[self alloc] init];
+    });
+    return instance;
+}
+
+- (instancetype)init {
+    self = [super init];
+    if (self) {
+        _containers = [NSMutableArray array];
+        _costs = [NSMutableDictionary dictionary];
+        [[NSNotificationCenter defaultCenter] addObserver:self
+                                                 selector:@selector(windowDidChangeOcclusionState:)
+                                                     name:NSWindowDidChangeOcclusionStateNotification
+                                                   object:nil];
+    }
+    return self;
+}
+
+#pragma mark - APIs
+
+- (void)addContainerView:(iTermStatusBarContainerView *)containerView cadence:(NSTimeInterval)cadence {
+    if (!(cadence > 0) || !isfinite(cadence)) {
+        return;
+    }
+    iTermStatusBarScheduledContainer *entry = [[iTermStatusBarScheduledContainer alloc] init];
+    entry.containerView = containerView;
+    entry.cadence = cadence;
+    entry.nextUpdate = [self tickAfter:[NSDate timeIntervalSinceReferenceDate] cadence:cadence];
+    [_containers addObject:entry];
+    [self scheduleTimer];
+}
+
+- (void)removeContainerView:(iTermStatusBarContainerView *)containerView {
+    [_containers removeObjectsPassingTest:^BOOL(iTermStatusBarScheduledContainer *entry) {
+        return entry.containerView == nil || entry.containerView == containerView;
+    }];
+}
+
+- (void)recordUpdateOfComponentClass:(Class)componentClass duration:(NSTimeInterval)duration {
+    NSString *key = NSStringFromClass(componentClass);
+    iTermStatusBarComponentCost *cost = _costs[key];
+    if (!cost) {
+        cost = [[iTermStatusBarComponentCost alloc] init];
+        _costs[key] = cost;
+    }
+    cost.count += 1;
+    cost.total += duration;
+}
+
+#pragma mark - Private
+
+// Ticks are at multiples of the cadence so every component with the same cadence shares them.
+- (NSTimeInterval)tickAfter:(NSTimeInterval)time cadence:(NSTimeInterval)cadence {
+    return (floor(time / cadence) + 1) * cadence;
+}
+
+- (void)scheduleTimer {
+    NSTimeInterval earliest = INFINITY;
+    for (iTermStatusBarScheduledContainer *entry in _containers) {
+        earliest = MIN(earliest, entry.nextUpdate);
+    }
+    if (!isfinite(earliest)) {
+        [_timer invalidate];
+        _timer = nil;
+        return;
+    }
+    if (_timer && _timerFireTime <= earliest) {
+        return;
+    }
+    [_timer invalidate];
+    _timerFireTime = earliest;
+    const NSTimeInterval delay = MAX(0, earliest - [NSDate timeIntervalSinceReferenceDate]);
+    __weak __typeof(self) weakSelf = self;
+    _timer = [NSTimer it_scheduledTimerWithTimeInterval:delay repeats:NO block:^(NSTimer * _Nonnull timer) {
+        [weakSelf timerDidFire];
+    }];
+    _timer.tolerance = 0.05;
+}
+
+- (void)timerDidFire {
+    _timer = nil;
+    const NSTimeInterval now = [NSDate timeIntervalSinceReferenceDate];
+    NSInteger updated = 0;
+    NSInteger skipped = 0;
+    // Copy because updating a component can add or remove containers.
+    for (iTermStatusBarScheduledContainer *entry in [_containers copy]) {
+        iTermStatusBarContainerView *containerView = entry.containerView;
+        if (!containerView) {
+            [_containers removeObject:entry];
+            continue;
+        }
+        // A little slack lets entries that are due within the timer's tolerance share this tick.
+        if (entry.nextUpdate > now + 0.05) {
+            continue;
+        }
+        entry.nextUpdate = [self tickAfter:now cadence:entry.cadence];
+        if ([self containerViewIsOnScreen:containerView]) {
+            [containerView setNeedsUpdate];
+            updated += 1;
+        } else {
+            [containerView scheduledUpdateWasSkipped];
+            skipped += 1;
+        }
+    }
+    DLog(@"Status bar tick updated %@ and skipped %@ components", @(updated), @(skipped));
+    if (gDebugLogging) {
+        SetPinnedDebugLogMessage(@"Status bar component costs", @"%@", [self costDescription]);
+    }
+    [self scheduleTimer];
+}
+
+- (BOOL)containerViewIsOnScreen:(iTermStatusBarContainerView *)containerView {
+    NSWindow *window = containerView.window;
+    if (!window || !window.isVisible || containerView.isHiddenOrHasHiddenAncestor) {
+        return NO;
+    }
+    return (window.occlusionState & NSWindowOcclusionStateVisible) != 0;
+}
+
+- (NSString *)costDescription {
+    NSArray<NSString *> *keys = [_costs keysSortedByValueUsingComparator:^NSComparisonResult(iTermStatusBarComponentCost *lhs, iTermStatusBarComponentCost *rhs) {
+        return [@(rhs.total) compare:@(lhs.total)];
+    }];
+    return [[keys mapWithBlock:^id(NSString *key) {
+        iTermStatusBarComponentCost *cost = self->_costs[key];
+        return [NSString stringWithFormat:@"%@: %@ updates, %.1f ms total, %.3f ms each",
+                key, @(cost.count), cost.total * 1000, cost.total * 1000 / MAX(1, cost.count)];
+    }] componentsJoinedByString:@"\n"];
+}
+
+#pragma mark - Notifications
+
+- (void)windowDidChangeOcclusionState:(NSNotification *)notification {
+    NSWindow *window = notification.object;
+    if (!(window.occlusionState & NSWindowOcclusionStateVisible)) {
+        return;
+    }
+    for (iTermStatusBarScheduledContainer *entry in [_containers copy]) {
+        iTermStatusBarContainerView *containerView = entry.containerView;
+        if (containerView.window == window) {
+            [containerView updateIfSkipped];
+        }
+    }
+}
+
+@end
@@ -46,6 +46,9 @@ NS_ASSUME_NONNULL_BEGIN
 - (BOOL)statusBarRevealComposer;
 - (iTermActivityInfo)statusBarActivityInfo;
 
+// Nobody can see the status bar, even though it may be in a window.
+- (BOOL)statusBarPresentationIsSuspended;
+
 @end
 
 @protocol iTermStatusBarContainer<NSObject>
@@ -12,6 +12,7 @@
 #import "iTermStatusBarFixedSpacerComponent.h"
 #import "iTermStatusBarLayout.h"
 #import "iTermStatusBarLayoutAlgorithm.h"
+#import "iTermStatusBarUpdateScheduler.h"
 #import "iTermStatusBarPlaceholderComponent.h"
 #import "iTermStatusBarSpringComponent.h"
 #import "iTermStatusBarUnreadCountController.h"
@@ -44,6 +45,8 @@ static const CGFloat iTermStatusBarViewControllerBottomMargin = 0;
     NSInteger _updating;
     BOOL _makeSearchControllerFirstResponder;
     iTermStatusBarAutoRainbowController *_autoRainbowController;
+    // The layout algorithm's inputs at the last layout. Only used with iTermStatusBarUpdateScheduler.
+    NSArray<NSNumber *> *_measurementsAtLastLayout;
 }
 
 - (instancetype)initWithLayout:(iTermStatusBarLayout *)layout
@@ -149,6 +152,9 @@ static const CGFloat iTermStatusBarViewControllerBottomMargin = 0;
 - (void)viewWillLayout {
     NSArray<iTermStatusBarContainerView *> *previouslyVisible = _visibleContainerViews.copy;
     DLog(@"--- begin status bar layout %@ ---", self);
+    if ([iTermStatusBarUpdateScheduler enabled]) {
+        _measurementsAtLastLayout = [self measurements];
+    }
     _visibleContainerViews = [self.layoutAlgorithm visibleContainerViews];
     [self updateDesiredOrigins];
 
@@ -327,15 +333,39 @@ static const CGFloat iTermStatusBarViewControllerBottomMargin = 0;
         DLog(@"Ignoring size change because am updating");
         return;
     }
+    if ([iTermStatusBarUpdateScheduler enabled] &&
+        _measurementsAtLastLayout &&
+        [[self measurements] isEqualToArray:_measurementsAtLastLayout]) {
+        // The layout would come out the same so only the component's own view needs to be redone.
+        DLog(@"Measurements unchanged. Skip status bar layout.");
+        [[self containerViewForComponent:component] layoutSubviews];
+        return;
+    }
     [self.view setNeedsLayout:YES];
 }
 
+// Everything about the components that the layout algorithm depends on and can change.
+- (NSArray<NSNumber *> *)measurements {
+    NSMutableArray<NSNumber *> *result = [NSMutableArray array];
+    for (iTermStatusBarContainerView *view in _containerViews) {
+        id<iTermStatusBarComponent> component = view.component;
+        [result addObject:@(component.statusBarComponentPreferredWidth)];
+        [result addObject:@(component.statusBarComponentMaximumWidth)];
+        [result addObject:@(view.minimumWidthIncludingIcon)];
+        [result addObject:@(component.statusBarComponentIcon != nil)];
+        [result addObject:@(component.statusBarComponentIsEmpty)];
+    }
+    return result;
+}
+
 - (NSColor *)statusBarComponentDefaultTextColor {
     return [self.delegate statusBarDefaultTextColor];
 }
 
 - (BOOL)statusBarComponentIsVisible:(id<iTermStatusBarComponent>)component {
-    return self.view.window != nil && !self.view.isHidden;
+    return (self.view.window != nil &&
+            !self.view.isHidden &&
+            ![self.delegate statusBarPresentationIsSuspended]);
 }
 
 - (NSFont *)statusBarComponentTerminalFont:(id<iTermStatusBarComponent>)component {
@@ -0,0 +1,32 @@
+//
+//  iTermStreamingTextExporter.h
+//  iTerm2SharedARC
+//
+//  Created by agent on 10/14/26.
+//
+
+#import <Foundation/Foundation.h>
+
+@protocol iTermTextDataSource;
+
+NS_ASSUME_NONNULL_BEGIN
+
+// Writes the text of a session's scrollback and screen to a file a chunk of lines at a time, so
+// saving a huge history neither blocks the main thread for long nor holds the whole thing in
+// memory. Text is extracted on the main thread and written on a background queue. Lines added
+// after it starts are not included and lines lost from the top of history before they are reached
+// are skipped.
+@interface iTermStreamingTextExporter : NSObject
+
+- (instancetype)initWithDataSource:(id<iTermTextDataSource>)dataSource
+                              path:(NSString *)path NS_DESIGNATED_INITIALIZER;
+- (instancetype)init NS_UNAVAILABLE;
+
+// Call on the main thread. The exporter keeps itself alive until it finishes. |completion| is
+// called on the main thread with NO if the file couldn't be written, the width of the session
+// changed, or the session went away.
+- (void)startWithCompletion:(void (^)(BOOL ok))completion;
+
+@end
+
+NS_ASSUME_NONNULL_END
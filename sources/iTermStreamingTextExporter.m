@@ -0,0 +1,159 @@
+//
+//  iTermStreamingTextExporter.m
+//  iTerm2SharedARC
+//
+//  Created by agent on 10/14/26.
+//
+
+#import "iTermStreamingTextExporter.h"
+
+#import "DebugLogging.h"
+#import "PTYTextViewDataSource.h"
+#import "iTermTextExtractor.h"
+
+// Lines to extract per pass through the run loop.
+static const int iTermStreamingTextExporterLinesPerChunk = 5000;
+// Extraction pauses when this many chunks are waiting to be written.
+static const int iTermStreamingTextExporterMaximumPendingWrites = 4;
+
+@implementation iTermStreamingTextExporter {
+    __weak id<iTermTextDataSource> _dataSource;
+    NSString *_path;
+    dispatch_queue_t _queue;
+    // Only accessed on _queue.
+    NSFileHandle *_fileHandle;
+    BOOL _writeFailed;
+
+    int _width;
+    // Absolute line numbers. The next line to extract and one past the last.
+    long long _nextLine;
+    long long _endLine;
+    int _pendingWrites;
+    BOOL _passScheduled;
+    BOOL _extractionFinished;
+    void (^_completion)(BOOL);
+    // Keeps self alive until the completion block is called.
+    iTermStreamingTextExporter *_retainSelf;
+}
+
+- (instancetype)initWithDataSource:(id<iTermTextDataSource>)dataSource
+                              path:(NSString *)path {
+    self = [super init];
+    if (self) {
+        _dataSource = dataSource;
+        _path = [path copy];
+        _queue = dispatch_queue_create("com.iterm2.streaming-text-exporter", DISPATCH_QUEUE_SERIAL);
+    }
+    return self;
+}
+
+- (void)startWithCompletion:(void (^)(BOOL))completion {
+    assert([NSThread isMainThread]);
+    id<iTermTextDataSource> dataSource = _dataSource;
+    _completion = [completion copy];
+    if (!dataSource) {
+        [self finish:NO];
+        return;
+    }
+    _retainSelf = self;
+    _width = dataSource.width;
+    _nextLine = dataSource.totalScrollbackOverflow;
+    _endLine = _nextLine + dataSource.numberOfLines;
+    NSString *path = _path;
+    dispatch_async(_queue, ^{
+        [[NSFileManager defaultManager] createFileAtPath:path contents:nil attributes:nil];
+        self->_fileHandle = [NSFileHandle fileHandleForWritingAtPath:path];
+        self->_writeFailed = (self->_fileHandle == nil);
+    });
+    [self schedulePass];
+}
+
+#pragma mark - Private
+
+- (void)schedulePass {
+    if (_passScheduled) {
+        return;
+    }
+    _passScheduled = YES;
+    dispatch_async(dispatch_get_main_queue(), ^{
+        self->_passScheduled = NO;
+        [self extractChunk];
+    });
+}
+
+- (void)extractChunk {
+    if (_extractionFinished || _pendingWrites >= iTermStreamingTextExporterMaximumPendingWrites) {
+        return;
+    }
+    id<iTermTextDataSource> dataSource = _dataSource;
+    if (!dataSource || dataSource.width != _width) {
+        DLog(@"Data source went away or changed width. Abort export to %@", _path);
+        [self finishExtraction:NO];
+        return;
+    }
+    const long long overflow = dataSource.totalScrollbackOverflow;
+    const long long firstLine = MAX(_nextLine, overflow);
+    const long long lastLine = MIN(_endLine, firstLine + iTermStreamingTextExporterLinesPerChunk);
+    if (firstLine >= lastLine) {
+        [self finishExtraction:YES];
+        return;
+    }
+    const int y0 = (int)(firstLine - overflow);
+    const int y1 = (int)(lastLine - overflow);
+    iTermTextExtractor *extractor = [iTermTextExtractor textExtractorWithDataSource:dataSource];
+    VT100GridCoordRange range = VT100GridCoordRangeMake(0, y0, _width, y1 - 1);
+    NSString *content = [extractor contentInRange:VT100GridWindowedRangeMake(range, 0, 0)
+                                attributeProvider:nil
+                                       nullPolicy:kiTermTextExtractorNullPolicyTreatAsSpace
+                                              pad:NO
+                               includeLastNewline:YES
+                           trimTrailingWhitespace:NO
+                                     cappedAtSize:-1
+                                     truncateTail:YES
+                                continuationChars:nil
+                                           coords:nil];
+    _nextLine = lastLine;
+    [self writeData:[content dataUsingEncoding:NSUTF8StringEncoding]];
+    [self schedulePass];
+}
+
+- (void)writeData:(NSData *)data {
+    _pendingWrites += 1;
+    dispatch_async(_queue, ^{
+        if (!self->_writeFailed) {
+            @try {
+                [self->_fileHandle writeData:data];
+            } @catch (NSException *exception) {
+                DLog(@"Exception while saving contents: %@", exception);
+                self->_writeFailed = YES;
+            }
+        }
+        dispatch_async(dispatch_get_main_queue(), ^{
+            self->_pendingWrites -= 1;
+            [self schedulePass];
+        });
+    });
+}
+
+- (void)finishExtraction:(BOOL)ok {
+    _extractionFinished = YES;
+    dispatch_async(_queue, ^{
+        [self->_fileHandle closeFile];
+        self->_fileHandle = nil;
+        const BOOL succeeded = ok && !self->_writeFailed;
+        dispatch_async(dispatch_get_main_queue(), ^{
+            [self finish:succeeded];
+        });
+    });
+}
+
+- (void)finish:(BOOL)ok {
+    void (^completion)(BOOL) = _completion;
+    _completion = nil;
+    if (completion) {
+        completion(ok);
+    }
+    _retainSelf = nil;
+}
+
+@end
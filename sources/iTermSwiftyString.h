@@ -9,6 +9,7 @@
 
 NS_ASSUME_NONNULL_BEGIN
 
+@class iTermVariableDesignator;
 @class iTermVariableReference;
 @class iTermVariableScope;
 
@@ -47,6 +48,10 @@ NS_ASSUME_NONNULL_BEGIN
 // Variables the string depends on
 @property (nonatomic, readonly) NSSet<NSString *> *dependencies;
 
+// Used by iTermSwiftyStringScheduler to order and throttle evaluations.
+@property (nonatomic, readonly) BOOL evaluationInFlight;
+@property (nullable, nonatomic, readonly) iTermVariableDesignator *destinationDesignator;
+
 - (instancetype)initWithString:(NSString *)swiftyString
                          scope:(nullable iTermVariableScope *)scope
                       observer:(NSString *(^ _Nullable)(NSString * _Nullable newValue, NSError * _Nullable error))observer NS_DESIGNATED_INITIALIZER;
@@ -57,6 +62,7 @@ NS_ASSUME_NONNULL_BEGIN
 
 - (instancetype)init NS_UNAVAILABLE;
 - (void)invalidate;
+- (void)reevaluateIfNeeded;
 - (void)evaluateSynchronously:(BOOL)synchronously
                     withScope:(iTermVariableScope *)scope
                    completion:(void (^)(NSString *result, NSError *error, NSSet<NSString *> *missing))completion;
@@ -12,6 +12,7 @@
 #import "iTermExpressionEvaluator.h"
 #import "iTermScriptFunctionCall.h"
 #import "iTermScriptHistory.h"
+#import "iTermSwiftyStringScheduler.h"
 #import "iTermVariableReference.h"
 #import "iTermVariableScope.h"
 #import "NSArray+iTerm.h"
@@ -28,6 +29,7 @@
     iTermVariableScope *_scope;
     BOOL _observing;
     iTermVariableReference<NSString *> *_sourceRef;
+    NSInteger _asyncEvaluationsInFlight;
 }
 
 - (instancetype)initWithString:(NSString *)swiftyString
@@ -142,10 +144,16 @@
     __weak __typeof(self) weakSelf = self;
     NSInteger count = ++_count;
     DLog(@"%p: %@->%@ evaluate %@", self, _sourceRef.path, _destinationPath, _swiftyString);
+    if (!synchronously) {
+        [self asyncEvaluationDidBegin];
+    }
     [self evaluateSynchronously:synchronously completion:^(NSString *result, NSError *error) {
         DLog(@"%p: result=%@ error=%@", weakSelf, result, error);
         __strong __typeof(self) strongSelf = weakSelf;
         if (strongSelf) {
+            if (!synchronously) {
+                [strongSelf asyncEvaluationDidEnd];
+            }
             if (strongSelf.appliedCount > count) {
                 // A later async evaluation has already completed. Don't overwrite it.
                 DLog(@"obsoleted");
@@ -161,6 +169,31 @@
     }];
 }
 
+- (void)asyncEvaluationDidBegin {
+    _asyncEvaluationsInFlight += 1;
+    if ([iTermSwiftyStringScheduler enabled]) {
+        [[iTermSwiftyStringScheduler sharedInstance] swiftyStringDidBeginEvaluation:self];
+    }
+}
+
+- (void)asyncEvaluationDidEnd {
+    _asyncEvaluationsInFlight -= 1;
+    if (_asyncEvaluationsInFlight == 0 && [iTermSwiftyStringScheduler enabled]) {
+        [[iTermSwiftyStringScheduler sharedInstance] swiftyStringDidFinishEvaluation:self];
+    }
+}
+
+- (BOOL)evaluationInFlight {
+    return _asyncEvaluationsInFlight > 0;
+}
+
+- (iTermVariableDesignator *)destinationDesignator {
+    if (!_destinationPath) {
+        return nil;
+    }
+    return [_scope designatorForPath:_destinationPath];
+}
+
 - (void)evaluateSynchronously:(BOOL)synchronously
                    completion:(void (^)(NSString *, NSError *))completion {
     iTermVariableRecordingScope *scope = [self.scope recordingCopy];
@@ -215,6 +248,10 @@
 }
 - (void)setNeedsReevaluation {
     self.needsReevaluation = YES;
+    if ([iTermSwiftyStringScheduler enabled]) {
+        [[iTermSwiftyStringScheduler sharedInstance] setNeedsReevaluationOfSwiftyString:self];
+        return;
+    }
     dispatch_async(dispatch_get_main_queue(), ^{
         if (self.needsReevaluation) {
             [self reevaluateIfNeeded];
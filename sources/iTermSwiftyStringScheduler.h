@@ -0,0 +1,30 @@
+//
+//  iTermSwiftyStringScheduler.h
+//  iTerm2SharedARC
+//
+//  Created by agent on 10/14/26.
+//
+
+#import <Foundation/Foundation.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+@class iTermSwiftyString;
+
+// Reevaluates invalidated swifty strings together once per pass through the main run loop rather
+// than each on its own. Strings are ordered so that one whose destination variable is an input to
+// another goes first, and the consumer waits for the producer's evaluation to finish so it is
+// evaluated once with the new input instead of once before and once after. A string never has
+// more than one evaluation (and hence RPC) outstanding.
+@interface iTermSwiftyStringScheduler : NSObject
+
++ (BOOL)enabled;
++ (instancetype)sharedInstance;
+
+- (void)setNeedsReevaluationOfSwiftyString:(iTermSwiftyString *)swiftyString;
+- (void)swiftyStringDidBeginEvaluation:(iTermSwiftyString *)swiftyString;
+- (void)swiftyStringDidFinishEvaluation:(iTermSwiftyString *)swiftyString;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,197 @@
+//
+//  iTermSwiftyStringScheduler.m
+//  iTerm2SharedARC
+//
+//  Created by agent on 10/14/26.
+//
+
+#import "iTermSwiftyStringScheduler.h"
+
+#import "DebugLogging.h"
+#import "iTermAdvancedSettingsModel.h"
+#import "iTermSwiftyString.h"
+#import "iTermVariableReference.h"
+#import "iTermVariableScope.h"
+
+@implementation iTermSwiftyStringScheduler {
+    NSMutableOrderedSet<iTermSwiftyString *> *_pending;
+    NSHashTable<iTermSwiftyString *> *_inFlight;
+    BOOL _scheduled;
+}
+
++ (BOOL)enabled {
+    static BOOL enabled;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        enabled = [iTermAdvancedSettingsModel batchInterpolatedStringEvaluation];
+    });
+    return enabled;
+}
+
++ (instancetype)sharedInstance {
+    static id instance;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        instance = [[self alloc] init];
+    });
+    return instance;
+}
+
+- (instancetype)init {
+    self = [super init];
+    if (self) {
+        _pending = [[NSMutableOrderedSet alloc] init];
+        _inFlight = [NSHashTable weakObjectsHashTable];
+    }
+    return self;
+}
+
+- (void)setNeedsReevaluationOfSwiftyString:(iTermSwiftyString *)swiftyString {
+    [_pending addObject:swiftyString];
+    [self schedule];
+}
+
+- (void)swiftyStringDidBeginEvaluation:(iTermSwiftyString *)swiftyString {
+    [_inFlight addObject:swiftyString];
+}
+
+- (void)swiftyStringDidFinishEvaluation:(iTermSwiftyString *)swiftyString {
+    [_inFlight removeObject:swiftyString];
+    if (_pending.count) {
+        // Consumers of its destination may have been waiting on it.
+        [self schedule];
+    }
+}
+
+#pragma mark - Private
+
+- (void)schedule {
+    if (_scheduled) {
+        return;
+    }
+    _scheduled = YES;
+    dispatch_async(dispatch_get_main_queue(), ^{
+        self->_scheduled = NO;
+        [self evaluatePending];
+    });
+}
+
+- (void)evaluatePending {
+    NSArray<iTermSwiftyString *> *sorted = [self topologicallySortedPendingStrings];
+    [_pending removeAllObjects];
+    DLog(@"Evaluate %@ swifty strings", @(sorted.count));
+
+    NSMutableSet<iTermVariableDesignator *> *busyDestinations = [NSMutableSet set];
+    for (iTermSwiftyString *swiftyString in _inFlight) {
+        iTermVariableDesignator *destination = swiftyString.destinationDesignator;
+        if (destination) {
+            [busyDestinations addObject:destination];
+        }
+    }
+    for (iTermSwiftyString *swiftyString in sorted) {
+        if (swiftyString.evaluationInFlight || [self swiftyString:swiftyString readsAnyOf:busyDestinations]) {
+            // Try again when the outstanding evaluation finishes.
+            [_pending addObject:swiftyString];
+            continue;
+        }
+        [swiftyString reevaluateIfNeeded];
+        iTermVariableDesignator *destination = swiftyString.destinationDesignator;
+        if (destination && swiftyString.evaluationInFlight) {
+            [busyDestinations addObject:destination];
+        }
+    }
+}
+
+- (BOOL)swiftyString:(iTermSwiftyString *)swiftyString readsAnyOf:(NSSet<iTermVariableDesignator *> *)designators {
+    if (!designators.count) {
+        return NO;
+    }
+    for (iTermVariableDesignator *input in [self inputsOfSwiftyString:swiftyString]) {
+        if ([designators containsObject:input]) {
+            return YES;
+        }
+    }
+    return NO;
+}
+
+- (NSArray<iTermVariableDesignator *> *)inputsOfSwiftyString:(iTermSwiftyString *)swiftyString {
+    iTermVariableScope *scope = swiftyString.scope;
+    NSMutableArray<iTermVariableDesignator *> *inputs = [NSMutableArray array];
+    for (iTermVariableReference *ref in swiftyString.refs) {
+        iTermVariableDesignator *designator = [scope designatorForPath:ref.path];
+        if (designator) {
+            [inputs addObject:designator];
+        }
+    }
+    return inputs;
+}
+
+// Kahn's algorithm over edges from a string to the pending strings that read its destination.
+// Whatever remains in a cycle is appended in the order it was invalidated.
+- (NSArray<iTermSwiftyString *> *)topologicallySortedPendingStrings {
+    NSArray<iTermSwiftyString *> *pending = _pending.array;
+    if (pending.count < 2) {
+        return pending;
+    }
+    NSMutableDictionary<iTermVariableDesignator *, iTermSwiftyString *> *producers = [NSMutableDictionary dictionary];
+    for (iTermSwiftyString *swiftyString in pending) {
+        iTermVariableDesignator *destination = swiftyString.destinationDesignator;
+        if (destination) {
+            producers[destination] = swiftyString;
+        }
+    }
+    if (!producers.count) {
+        return pending;
+    }
+    NSMapTable<iTermSwiftyString *, NSMutableArray<iTermSwiftyString *> *> *consumers = [NSMapTable strongToStrongObjectsMapTable];
+    NSMapTable<iTermSwiftyString *, NSNumber *> *inDegree = [NSMapTable strongToStrongObjectsMapTable];
+    for (iTermSwiftyString *swiftyString in pending) {
+        NSInteger degree = 0;
+        for (iTermVariableDesignator *input in [self inputsOfSwiftyString:swiftyString]) {
+            iTermSwiftyString *producer = producers[input];
+            if (!producer || producer == swiftyString) {
+                continue;
+            }
+            NSMutableArray *array = [consumers objectForKey:producer];
+            if (!array) {
+                array = [NSMutableArray array];
+                [consumers setObject:array forKey:producer];
+            }
+            [array addObject:swiftyString];
+            degree += 1;
+        }
+        [inDegree setObject:@(degree) forKey:swiftyString];
+    }
+
+    NSMutableArray<iTermSwiftyString *> *sorted = [NSMutableArray array];
+    NSMutableArray<iTermSwiftyString *> *ready = [NSMutableArray array];
+    for (iTermSwiftyString *swiftyString in pending) {
+        if ([[inDegree objectForKey:swiftyString] integerValue] == 0) {
+            [ready addObject:swiftyString];
+        }
+    }
+    while (ready.count) {
+        iTermSwiftyString *swiftyString = ready.firstObject;
+        [ready removeObjectAtIndex:0];
+        [sorted addObject:swiftyString];
+        for (iTermSwiftyString *consumer in [consumers objectForKey:swiftyString]) {
+            const NSInteger degree = [[inDegree objectForKey:consumer] integerValue] - 1;
+            [inDegree setObject:@(degree) forKey:consumer];
+            if (degree == 0) {
+                [ready addObject:consumer];
+            }
+        }
+    }
+    if (sorted.count < pending.count) {
+        DLog(@"Cycle among swifty strings");
+        NSSet<iTermSwiftyString *> *done = [NSSet setWithArray:sorted];
+        for (iTermSwiftyString *swiftyString in pending) {
+            if (![done containsObject:swiftyString]) {
+                [sorted addObject:swiftyString];
+            }
+        }
+    }
+    return sorted;
+}
+
+@end
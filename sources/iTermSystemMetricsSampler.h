@@ -0,0 +1,37 @@
+//
+//  iTermSystemMetricsSampler.h
+//  iTerm2SharedARC
+//
+//  Created by agent on 10/14/26.
+//
+
+#import <Foundation/Foundation.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+// A source of system-wide measurements, like CPU utilization.
+@protocol iTermSystemMetric<NSObject>
+
+// Called on the sampler's queue, so it must not touch state shared with the main thread.
+- (id)systemMetricTakeSample;
+
+// Called on the main thread with the result of -systemMetricTakeSample.
+- (void)systemMetricDidTakeSample:(id)sample;
+
+@end
+
+// Takes samples of every active metric together on one background timer, then delivers them all
+// on the main thread. Used instead of each metric having a timer of its own.
+@interface iTermSystemMetricsSampler : NSObject
+
+@property (nonatomic, readonly) NSTimeInterval cadence;
+
++ (BOOL)enabled;
++ (instancetype)sharedInstance;
+
+// The sampler runs while any metric is active. Metrics are retained while active.
+- (void)setMetric:(id<iTermSystemMetric>)metric active:(BOOL)active;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,112 @@
+//
+//  iTermSystemMetricsSampler.m
+//  iTerm2SharedARC
+//
+//  Created by agent on 10/14/26.
+//
+
+#import "iTermSystemMetricsSampler.h"
+
+#import "DebugLogging.h"
+#import "iTermAdvancedSettingsModel.h"
+
+@interface iTermSystemMetricsSampler()
+// A copy of _metrics that the sampler's queue can read.
+@property (atomic, copy) NSArray<id<iTermSystemMetric>> *activeMetrics;
+@end
+
+@implementation iTermSystemMetricsSampler {
+    dispatch_queue_t _queue;
+    dispatch_source_t _timer;
+    // Main thread only.
+    NSMutableArray<id<iTermSystemMetric>> *_metrics;
+}
+
++ (BOOL)enabled {
+    static BOOL enabled;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        enabled = [iTermAdvancedSettingsModel sharedSystemMetricsSampler];
+    });
+    return enabled;
+}
+
++ (instancetype)sharedInstance {
+    static id instance;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        instance = [[self alloc] init];
+    });
+    return instance;
+}
+
+- (instancetype)init {
+    self = [super init];
+    if (self) {
+        _cadence = 1;
+        _queue = dispatch_queue_create("com.iterm2.system-metrics", DISPATCH_QUEUE_SERIAL);
+        _metrics = [NSMutableArray array];
+    }
+    return self;
+}
+
+- (void)setMetric:(id<iTermSystemMetric>)metric active:(BOOL)active {
+    if (active) {
+        if ([_metrics containsObject:metric]) {
+            return;
+        }
+        [_metrics addObject:metric];
+    } else {
+        [_metrics removeObject:metric];
+    }
+    self.activeMetrics = _metrics;
+    [self updateTimer];
+}
+
+#pragma mark - Private
+
+- (void)updateTimer {
+    if (_metrics.count == 0) {
+        if (_timer) {
+            DLog(@"Stop sampling system metrics");
+            dispatch_source_cancel(_timer);
+            _timer = nil;
+        }
+        return;
+    }
+    if (_timer) {
+        return;
+    }
+    DLog(@"Start sampling system metrics");
+    _timer = dispatch_source_create(DISPATCH_SOURCE_TYPE_TIMER, 0, 0, _queue);
+    const uint64_t interval = _cadence * NSEC_PER_SEC;
+    dispatch_source_set_timer(_timer,
+                              dispatch_time(DISPATCH_TIME_NOW, interval),
+                              interval,
+                              interval / 10);
+    __weak __typeof(self) weakSelf = self;
+    dispatch_source_set_event_handler(_timer, ^{
+        [weakSelf tick];
+    });
+    dispatch_resume(_timer);
+}
+
+// Runs on _queue. All metrics are sampled back to back and the samples are delivered in a single
+// trip to the main thread.
+- (void)tick {
+    NSArray<id<iTermSystemMetric>> *metrics = self.activeMetrics;
+    NSMutableArray *samples = [NSMutableArray arrayWithCapacity:metrics.count];
+    for (id<iTermSystemMetric> metric in metrics) {
+        [samples addObject:[metric systemMetricTakeSample] ?: [NSNull null]];
+    }
+    dispatch_async(dispatch_get_main_queue(), ^{
+        [metrics enumerateObjectsUsingBlock:^(id<iTermSystemMetric> metric, NSUInteger idx, BOOL * _Nonnull stop) {
+            if (![self->_metrics containsObject:metric] || samples[idx] == [NSNull null]) {
+                return;
+            }
+            [metric systemMetricDidTakeSample:samples[idx]];
+        }];
+    });
+}
+
+@end
@@ -15,6 +15,7 @@
 #import "iTermAttributedStringProxy.h"
 #import "iTermBackgroundColorRun.h"
 #import "iTermBoxDrawingBezierCurveFactory.h"
+#import "iTermCache.h"
 #import "iTermColorMap.h"
 #import "iTermController.h"
 #import "iTermFindCursorView.h"
@@ -27,6 +28,7 @@
 #import "iTermSelection.h"
 #import "iTermTextExtractor.h"
 #import "iTermTimestampDrawHelper.h"
+#import "iTermUnicodeProperties.h"
 #import "iTermVirtualOffset.h"
 #import "MovingAverage.h"
 #import "NSArray+iTerm.h"
@@ -178,6 +180,11 @@ static CGFloat iTermTextDrawingHelperAlphaValueForDefaultBackgroundColor(BOOL ha
     // The cache we'll use next time.
     NSMutableDictionary<iTermAttributedStringProxy *, id> *_replacementLineRefCache;
 
+    // If nonnil, used instead of the two caches above. Lines survive as long as they're among the
+    // most recently used, so they outlive redraws that don't include them (e.g., a cursor blink or
+    // scrolling away and back).
+    iTermCache<iTermAttributedStringProxy *, id> *_persistentLineRefCache;
+
     BOOL _preferSpeedToFullLigatureSupport;
 }
 
@@ -203,6 +210,13 @@ static CGFloat iTermTextDrawingHelperAlphaValueForDefaultBackgroundColor(BOOL ha
         _missingImages = [[NSMutableSet alloc] init];
         _lineRefCache = [[NSMutableDictionary alloc] init];
         _replacementLineRefCache = [[NSMutableDictionary alloc] init];
+        const int capacity = [iTermAdvancedSettingsModel typesetLineCacheCapacity];
+        if (capacity > 0) {
+            _persistentLineRefCache = [[iTermCache alloc] initWithName:@"typeset_line"
+                                                           maximumCost:capacity
+                                                                shards:1
+                                                            timeToLive:0];
+        }
     }
     return self;
 }
@@ -224,6 +238,7 @@ static CGFloat iTermTextDrawingHelperAlphaValueForDefaultBackgroundColor(BOOL ha
     [_backgroundStripesImage release];
     [_lineRefCache release];
     [_replacementLineRefCache release];
+    [_persistentLineRefCache release];
     [_timestampDrawHelper release];
 
     [super dealloc];
@@ -1642,13 +1657,22 @@ static CGFloat iTermTextDrawingHelperAlphaValueForDefaultBackgroundColor(BOOL ha
 
     CTLineRef lineRef;
     iTermAttributedStringProxy *proxy = [iTermAttributedStringProxy withAttributedString:attributedString];
-    lineRef = (CTLineRef)_lineRefCache[proxy];
-    if (lineRef == nil) {
-        lineRef = CTLineCreateWithAttributedString((CFAttributedStringRef)attributedString);
-        _lineRefCache[proxy] = (id)lineRef;
-        CFRelease(lineRef);
+    if (_persistentLineRefCache) {
+        lineRef = (CTLineRef)_persistentLineRefCache[proxy];
+        if (lineRef == nil) {
+            lineRef = CTLineCreateWithAttributedString((CFAttributedStringRef)attributedString);
+            _persistentLineRefCache[proxy] = (id)lineRef;
+            CFRelease(lineRef);
+        }
+    } else {
+        lineRef = (CTLineRef)_lineRefCache[proxy];
+        if (lineRef == nil) {
+            lineRef = CTLineCreateWithAttributedString((CFAttributedStringRef)attributedString);
+            _lineRefCache[proxy] = (id)lineRef;
+            CFRelease(lineRef);
+        }
+        _replacementLineRefCache[proxy] = (id)lineRef;
     }
-    _replacementLineRefCache[proxy] = (id)lineRef;
 
     CFArrayRef runs = CTLineGetGlyphRuns(lineRef);
     CGContextRef cgContext = (CGContextRef) [ctx CGContext];
@@ -2348,6 +2372,21 @@ static BOOL iTermTextDrawingHelperShouldAntiAlias(screen_char_t *c,
     BOOL lastWasNull = NO;
     NSCharacterSet *emojiWithDefaultTextPresentation = [NSCharacterSet emojiWithDefaultTextPresentation];
     NSCharacterSet *emojiWithDefaultEmojiPresentationCharacterSet = [NSCharacterSet emojiWithDefaultEmojiPresentation];
+    // Presentation doesn't depend on the Unicode version, so any table will do.
+    const iTermUnicodePropertyTable *properties =
+        [iTermAdvancedSettingsModel unicodePropertyTable] ? iTermUnicodePropertyTableForVersion(9) : NULL;
+    BOOL (^hasTextPresentation)(UTF32Char) = ^BOOL(UTF32Char c) {
+        if (properties) {
+            return (iTermUnicodePropertiesOfCodePoint(properties, c) & iTermUnicodePropertyTextPresentation) != 0;
+        }
+        return [emojiWithDefaultTextPresentation longCharacterIsMember:c];
+    };
+    BOOL (^hasEmojiPresentation)(UTF32Char) = ^BOOL(UTF32Char c) {
+        if (properties) {
+            return (iTermUnicodePropertiesOfCodePoint(properties, c) & iTermUnicodePropertyEmojiPresentation) != 0;
+        }
+        return [emojiWithDefaultEmojiPresentationCharacterSet longCharacterIsMember:c];
+    };
     for (int i = indexRange.location; i < NSMaxRange(indexRange); i++) {
         iTermPreciseTimerStatsStartTimer(&_stats[TIMER_ATTRS_FOR_CHAR]);
         screen_char_t c = line[i];
@@ -2386,22 +2425,22 @@ static BOOL iTermTextDrawingHelperShouldAntiAlias(screen_char_t *c,
                 continue;
             }
             const UTF32Char base = [charAsString firstCharacter];
-            if (lastCharacterImpartsEmojiPresentation && [emojiWithDefaultTextPresentation longCharacterIsMember:base] && ![charAsString containsString:@"\ufe0f"]) {
+            if (lastCharacterImpartsEmojiPresentation && hasTextPresentation(base) && ![charAsString containsString:@"\ufe0f"]) {
                 // Prevent previous character's emoji presentation from making this one have an emoji presentation as well.
                 // Leave lastCharacterImpartsEmojiPresentation set to YES intentionally.
                 charAsString = [charAsString stringByAppendingString:@"\ufe0e"];
             } else {
-                lastCharacterImpartsEmojiPresentation = [emojiWithDefaultEmojiPresentationCharacterSet longCharacterIsMember:base];
+                lastCharacterImpartsEmojiPresentation = hasEmojiPresentation(base);
             }
         } else {
             charAsString = nil;
-            if (lastCharacterImpartsEmojiPresentation && [emojiWithDefaultTextPresentation characterIsMember:code]) {
+            if (lastCharacterImpartsEmojiPresentation && hasTextPresentation(code)) {
                 unichar chars[2] = { code, 0xfe0e };
                 // Prevent previous character's emoji presentation from making this one have an emoji presentation as well.
                 // See issue 9185
                 charAsString = [NSString stringWithCharacters:chars length:2];
             } else if (code != DWC_RIGHT && code >= iTermMinimumDefaultEmojiPresentationCodePoint) {  // filter out small values for speed
-                lastCharacterImpartsEmojiPresentation = [emojiWithDefaultEmojiPresentationCharacterSet characterIsMember:code];
+                lastCharacterImpartsEmojiPresentation = hasEmojiPresentation(code);
             }
         }
 
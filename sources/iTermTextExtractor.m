@@ -12,6 +12,7 @@
 #import "iTermImageInfo.h"
 #import "iTermLocatedString.h"
 #import "iTermPreferences.h"
+#import "iTermSmartSelectionEngine.h"
 #import "iTermSystemVersion.h"
 #import "iTermURLStore.h"
 #import "NSStringITerm.h"
@@ -732,60 +733,86 @@ const NSInteger kLongMaximumWordLength = 100000;
     if (debug) {
         NSLog(@"Perform smart selection on text: %@", textWindow);
     }
-    for (int j = 0; j < numRules; j++) {
-        NSDictionary *rule = [rulesArray objectAtIndex:j];
-        if (actionRequired && [[SmartSelectionController actionsInRule:rule] count] == 0) {
-            DLog(@"Ignore smart selection rule because it has no action: %@", rule);
-            continue;
-        }
-        NSString *regex = [SmartSelectionController regexInRule:rule];
-        double precision = [SmartSelectionController precisionInRule:rule];
-        if (debug) {
-            NSLog(@"Try regex %@", regex);
+    if ([iTermAdvancedSettingsModel precompiledSmartSelectionRules]) {
+        iTermSmartSelectionEngine *engine = [iTermSmartSelectionEngine engineForRules:rulesArray];
+        const long long overflow = [_dataSource totalScrollbackOverflow];
+        for (iTermSmartSelectionEngineMatch *engineMatch in [engine matchesInText:textWindow
+                                                                     targetOffset:targetOffset
+                                                                   actionRequired:actionRequired]) {
+            SmartMatch *match = [[[SmartMatch alloc] init] autorelease];
+            match.score = engineMatch.score;
+            VT100GridCoord startCoord = [coords[engineMatch.range.location] gridCoordValue];
+            VT100GridCoord endCoord = [coords[MIN(numCoords - 1, NSMaxRange(engineMatch.range) - 1)] gridCoordValue];
+            endCoord = [self successorOfCoord:endCoord];
+            match.startX = startCoord.x;
+            match.absStartY = startCoord.y + overflow;
+            match.endX = endCoord.x;
+            match.absEndY = endCoord.y + overflow;
+            match.rule = engineMatch.rule;
+            match.components = engineMatch.components;
+            matches[engineMatch.components.firstObject] = match;
+            if (debug) {
+                NSLog(@"Regex %@ matched. Add result %@ at %d,%lld -> %d,%lld with score %lf",
+                      [SmartSelectionController regexInRule:match.rule], engineMatch.components.firstObject,
+                      match.startX, match.absStartY, match.endX, match.absEndY, match.score);
+            }
         }
-        for (int i = 0; i <= targetOffset; i++) {
-            NSString* substring = [textWindow substringWithRange:NSMakeRange(i, [textWindow length] - i)];
-            NSError* regexError = nil;
-            NSRange temp = [substring rangeOfRegex:regex
-                                           options:0
-                                           inRange:NSMakeRange(0, [substring length])
-                                           capture:0
-                                             error:&regexError];
-            if (temp.location != NSNotFound) {
-                if (i + temp.location <= targetOffset && i + temp.location + temp.length > targetOffset) {
-                    NSString* result = [substring substringWithRange:temp];
-                    double score = precision * (double) temp.length;
-                    SmartMatch* oldMatch = [matches objectForKey:result];
-                    if (!oldMatch || score > oldMatch.score) {
-                        SmartMatch* match = [[[SmartMatch alloc] init] autorelease];
-                        match.score = score;
-                        VT100GridCoord startCoord = [coords[i + temp.location] gridCoordValue];
-                        VT100GridCoord endCoord = [coords[MIN(numCoords - 1,
-                                                              i + temp.location + temp.length - 1)] gridCoordValue];
-                        endCoord = [self successorOfCoord:endCoord];
-                        match.startX = startCoord.x;
-                        match.absStartY = startCoord.y + [_dataSource totalScrollbackOverflow];
-                        match.endX = endCoord.x;
-                        match.absEndY = endCoord.y + [_dataSource totalScrollbackOverflow];
-                        match.rule = rule;
-                        match.components = [substring captureComponentsMatchedByRegex:regex
-                                                                              options:0
-                                                                                range:NSMakeRange(0, [substring length])
-                                                                                error:&regexError];
-                        [matches setObject:match forKey:result];
-
-                        if (debug) {
-                            NSLog(@"Regex matched. Add result %@ at %d,%lld -> %d,%lld with score %lf", result,
-                                  match.startX, match.absStartY, match.endX, match.absEndY,
-                                  match.score);
+    } else {
+        for (int j = 0; j < numRules; j++) {
+            NSDictionary *rule = [rulesArray objectAtIndex:j];
+            if (actionRequired && [[SmartSelectionController actionsInRule:rule] count] == 0) {
+                DLog(@"Ignore smart selection rule because it has no action: %@", rule);
+                continue;
+            }
+            NSString *regex = [SmartSelectionController regexInRule:rule];
+            double precision = [SmartSelectionController precisionInRule:rule];
+            if (debug) {
+                NSLog(@"Try regex %@", regex);
+            }
+            for (int i = 0; i <= targetOffset; i++) {
+                NSString* substring = [textWindow substringWithRange:NSMakeRange(i, [textWindow length] - i)];
+                NSError* regexError = nil;
+                NSRange temp = [substring rangeOfRegex:regex
+                                               options:0
+                                               inRange:NSMakeRange(0, [substring length])
+                                               capture:0
+                                                 error:&regexError];
+                if (temp.location != NSNotFound) {
+                    if (i + temp.location <= targetOffset && i + temp.location + temp.length > targetOffset) {
+                        NSString* result = [substring substringWithRange:temp];
+                        double score = precision * (double) temp.length;
+                        SmartMatch* oldMatch = [matches objectForKey:result];
+                        if (!oldMatch || score > oldMatch.score) {
+                            SmartMatch* match = [[[SmartMatch alloc] init] autorelease];
+                            match.score = score;
+                            VT100GridCoord startCoord = [coords[i + temp.location] gridCoordValue];
+                            VT100GridCoord endCoord = [coords[MIN(numCoords - 1,
+                                                                  i + temp.location + temp.length - 1)] gridCoordValue];
+                            endCoord = [self successorOfCoord:endCoord];
+                            match.startX = startCoord.x;
+                            match.absStartY = startCoord.y + [_dataSource totalScrollbackOverflow];
+                            match.endX = endCoord.x;
+                            match.absEndY = endCoord.y + [_dataSource totalScrollbackOverflow];
+                            match.rule = rule;
+                            match.components = [substring captureComponentsMatchedByRegex:regex
+                                                                                  options:0
+                                                                                    range:NSMakeRange(0, [substring length])
+                                                                                    error:&regexError];
+                            [matches setObject:match forKey:result];
+
+                            if (debug) {
+                                NSLog(@"Regex matched. Add result %@ at %d,%lld -> %d,%lld with score %lf", result,
+                                      match.startX, match.absStartY, match.endX, match.absEndY,
+                                      match.score);
+                            }
                         }
+                        i += temp.location + temp.length - 1;
+                    } else {
+                        i += temp.location;
                     }
-                    i += temp.location + temp.length - 1;
                 } else {
-                    i += temp.location;
+                    break;
                 }
-            } else {
-                break;
             }
         }
     }
@@ -24,6 +24,9 @@
 // Return the number of lines visible to accessibility.
 - (int)accessibilityHelperNumberOfLines;
 
+// Return the absolute line number of the 0th line in accessibility-space.
+- (long long)accessibilityHelperAbsoluteLineNumberOfFirstLine;
+
 // Return the coordinate for a point in screen coords.
 - (VT100GridCoord)accessibilityHelperCoordForPoint:(NSPoint)point;
 
@@ -76,5 +79,9 @@
 - (NSURL *)currentDocumentURL;
 - (void)setSelectedTextRange:(NSRange)range;
 
+// Call these when lines change so the text exposed to accessibility can be updated incrementally.
+// Lines are given as absolute line numbers.
+- (void)invalidateAbsoluteLines:(NSIndexSet *)lines;
+- (void)invalidateAllLines;
 
 @end
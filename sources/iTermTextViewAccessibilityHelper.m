@@ -8,6 +8,7 @@
 
 #import "iTermTextViewAccessibilityHelper.h"
 #import "DebugLogging.h"
+#import "iTermAdvancedSettingsModel.h"
 
 @implementation iTermTextViewAccessibilityHelper {
     // This is a giant string with the entire scrollback buffer plus screen
@@ -15,6 +16,39 @@
     NSMutableString *_allText;
     // This is the indices at which soft newlines occur in _allText.
     NSMutableArray *_lineBreakIndexOffsets;
+
+    // When building _allText incrementally, this maps an absolute line number to its text
+    // (including its newline, if it ends in a hard eol).
+    NSMutableDictionary<NSNumber *, NSString *> *_lineStrings;
+    // The geometry _allText was built for. If it changes, or some line was invalidated, _allText
+    // must be built again.
+    long long _firstAbsoluteLine;
+    int _numberOfLines;
+    int _width;
+    BOOL _allTextIsValid;
+}
+
+- (instancetype)init {
+    self = [super init];
+    if (self) {
+        _lineStrings = [[NSMutableDictionary alloc] init];
+    }
+    return self;
+}
+
+- (void)invalidateAbsoluteLines:(NSIndexSet *)lines {
+    if (!_allTextIsValid && _lineStrings.count == 0) {
+        return;
+    }
+    [lines enumerateIndexesUsingBlock:^(NSUInteger idx, BOOL * _Nonnull stop) {
+        [_lineStrings removeObjectForKey:@(idx)];
+    }];
+    _allTextIsValid = NO;
+}
+
+- (void)invalidateAllLines {
+    [_lineStrings removeAllObjects];
+    _allTextIsValid = NO;
 }
 
 #pragma mark - Parameterized attributes
@@ -36,30 +70,24 @@
     return range;
 }
 
+// Number of line break offsets that are at most |value|. Offsets are nondecreasing.
+- (NSUInteger)numberOfLineBreakOffsetsNotAfter:(NSUInteger)value {
+    return [_lineBreakIndexOffsets indexOfObject:@(value)
+                                   inSortedRange:NSMakeRange(0, _lineBreakIndexOffsets.count)
+                                         options:NSBinarySearchingInsertionIndex | NSBinarySearchingLastEqual
+                                 usingComparator:^NSComparisonResult(NSNumber *lhs, NSNumber *rhs) {
+        return [lhs compare:rhs];
+    }];
+}
+
 // Range in _allText of the given index.
 - (NSUInteger)lineNumberOfIndex:(NSUInteger)theIndex {
-    NSUInteger lineNum = 0;
-    for (NSNumber *n in _lineBreakIndexOffsets) {
-        NSUInteger offset = [n unsignedLongValue];
-        if (offset > theIndex) {
-            break;
-        }
-        lineNum++;
-    }
-    return lineNum;
+    return [self numberOfLineBreakOffsetsNotAfter:theIndex];
 }
 
 // Line number of a location (respecting compositing chars) in _allText.
 - (NSUInteger)lineNumberOfChar:(NSUInteger)location {
-    NSUInteger lineNum = 0;
-    for (NSNumber *n in _lineBreakIndexOffsets) {
-        NSUInteger offset = [n unsignedLongValue];
-        if (offset > location) {
-            break;
-        }
-        lineNum++;
-    }
-    return lineNum;
+    return [self numberOfLineBreakOffsetsNotAfter:location];
 }
 
 // Number of unichar a character uses (normally 1 in English).
@@ -237,6 +265,9 @@
 // NSAttributedString's with custom attributes, but unfortunately that would
 // have been a lot easier to do about five years ago.
 - (NSString *)allText {
+    if ([iTermAdvancedSettingsModel incrementalAccessibilityText]) {
+        return [self incrementallyUpdatedAllText];
+    }
     _allText = [[NSMutableString alloc] init];
     _lineBreakIndexOffsets = [[NSMutableArray alloc] init];
 
@@ -294,6 +325,84 @@
     return _allText;
 }
 
+// Equivalent to the result of the slow path in -allText but only converts lines whose text isn't
+// cached, and does nothing at all if no line changed since the last call.
+- (NSString *)incrementallyUpdatedAllText {
+    const int width = [_delegate accessibilityHelperWidth];
+    const int numberOfLines = [_delegate accessibilityHelperNumberOfLines];
+    const long long firstAbsoluteLine = [_delegate accessibilityHelperAbsoluteLineNumberOfFirstLine];
+    if (width != _width) {
+        [_lineStrings removeAllObjects];
+        _allTextIsValid = NO;
+    }
+    if (_allTextIsValid &&
+        firstAbsoluteLine == _firstAbsoluteLine &&
+        numberOfLines == _numberOfLines) {
+        return _allText;
+    }
+    _width = width;
+    _numberOfLines = numberOfLines;
+    _firstAbsoluteLine = firstAbsoluteLine;
+
+    _allText = [[NSMutableString alloc] init];
+    _lineBreakIndexOffsets = [[NSMutableArray alloc] initWithCapacity:numberOfLines];
+    NSMutableDictionary<NSNumber *, NSString *> *lineStrings =
+        [[NSMutableDictionary alloc] initWithCapacity:numberOfLines];
+    NSUInteger offset = 0;
+    for (int i = 0; i < numberOfLines; i++) {
+        NSNumber *key = @(firstAbsoluteLine + i);
+        NSString *string = _lineStrings[key] ?: [self stringForAccessibilityLine:i width:width];
+        lineStrings[key] = string;
+        [_allText appendString:string];
+        offset += string.length;
+        [_lineBreakIndexOffsets addObject:@(offset)];
+    }
+    // Lines that scrolled out of accessibility-space are forgotten.
+    _lineStrings = lineStrings;
+
+    NSInteger i = (NSInteger)_allText.length - 1;
+    while (i >= 0 && [_allText characterAtIndex:i] == '\n') {
+        i--;
+    }
+    [_allText deleteCharactersInRange:NSMakeRange(i + 1, _allText.length - (i + 1))];
+    _allTextIsValid = YES;
+    return _allText;
+}
+
+// The text of one line as the slow path in -allText would append it.
+- (NSString *)stringForAccessibilityLine:(int)i width:(int)width {
+    screen_char_t *line = [_delegate accessibilityHelperLineAtIndex:i];
+    int k;
+    for (k = width - 1; k >= 0; k--) {
+        if (line[k].code) {
+            break;
+        }
+    }
+    NSMutableString *string = [NSMutableString string];
+    unichar chars[width * kMaxParts];
+    int o = 0;
+    for (int j = 0; j <= k; j++) {
+        if (line[j].complexChar) {
+            NSString *cs = ComplexCharToStr(line[j].code);
+            for (int l = 0; l < [cs length]; ++l) {
+                chars[o++] = [cs characterAtIndex:l];
+            }
+        } else if (line[j].code >= 0xf000) {
+            // Don't output private range chars to accessibility.
+            chars[o++] = 0;
+        } else {
+            chars[o++] = line[j].code;
+        }
+    }
+    if (o > 0) {
+        [string appendString:[NSString stringWithCharacters:chars length:o]];
+    }
+    if (line[width].code == EOL_HARD) {
+        [string appendString:@"\n"];
+    }
+    return string;
+}
+
 - (NSAccessibilityRole)role {
     return NSAccessibilityTextAreaRole;
 }
@@ -39,4 +39,7 @@ extern const CGFloat iTermTimestampGradientWidth;
 - (void)drawRow:(int)index inContext:(NSGraphicsContext *)context frame:(NSRect)frame virtualOffset:(CGFloat)virtualOffset;
 - (BOOL)rowIsRepeat:(int)index;
 
+// The formatted timestamp for a row, as it will be drawn unless it's a repeat.
+- (NSString *)stringForRow:(int)index;
+
 @end
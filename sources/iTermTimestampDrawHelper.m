@@ -103,6 +103,10 @@ const CGFloat iTermTimestampGradientWidth = 20;
     return [_rows[index - 1].string isEqual:_rows[index].string];
 }
 
+- (NSString *)stringForRow:(int)index {
+    return _rows[index].string;
+}
+
 - (CGFloat)suggestedWidth {
     return _maximumWidth + [iTermPreferences intForKey:kPreferenceKeySideMargins] + iTermTimestampGradientWidth;
 }
@@ -157,10 +161,24 @@ const CGFloat iTermTimestampGradientWidth = 20;
 }
 
 - (NSRect)frameForString:(NSString *)s line:(int)line maxX:(CGFloat)maxX virtualOffset:(CGFloat)virtualOffset {
-    NSString *widest = [s stringByReplacingOccurrencesOfRegex:@"[\\d\\p{Alphabetic}]" withString:@"M"];
-    NSSize size = [widest sizeWithAttributes:@{ NSFontAttributeName: self.font ?: [NSFont userFixedPitchFontOfSize:[NSFont systemFontSize]] }];
+    NSFont *font = self.font ?: [NSFont userFixedPitchFontOfSize:[NSFont systemFontSize]];
+    // Every visible row is measured on every frame, so remember widths across frames.
+    static NSCache<NSString *, NSNumber *> *widthCache;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        widthCache = [[NSCache alloc] init];
+        widthCache.countLimit = 1024;
+    });
+    NSString *key = [NSString stringWithFormat:@"%@ %f %@", font.fontName, font.pointSize, s];
+    NSNumber *width = [widthCache objectForKey:key];
+    if (!width) {
+        NSString *widest = [s stringByReplacingOccurrencesOfRegex:@"[\\d\\p{Alphabetic}]" withString:@"M"];
+        NSSize size = [widest sizeWithAttributes:@{ NSFontAttributeName: font }];
+        width = @(size.width);
+        [widthCache setObject:width forKey:key];
+    }
 
-    return [self frameForStringGivenWidth:size.width line:line maxX:maxX virtualOffset:virtualOffset];
+    return [self frameForStringGivenWidth:width doubleValue line:line maxX:maxX virtualOffset:virtualOffset];
 }
 
 - (NSRect)frameForStringGivenWidth:(CGFloat)width line:(int)line maxX:(CGFloat)maxX virtualOffset:(CGFloat)virtualOffset {
@@ -175,33 +193,45 @@ const CGFloat iTermTimestampGradientWidth = 20;
 
 - (NSDateFormatter *)dateFormatterWithTimeDelta:(NSTimeInterval)timeDelta
                              useTestingTimezone:(BOOL)useTestingTimezone {
-    NSDateFormatter *fmt = [[NSDateFormatter alloc] init];
+    NSString *template;
     const NSTimeInterval day = -86400;
     if (timeDelta < day * 180) {
         // More than 180 days ago: include year
         // I tried using 365 but it was pretty confusing to see tomorrow's date.
-        [fmt setDateFormat:[NSDateFormatter dateFormatFromTemplate:@"yyyyMMMd jj:mm:ss"
-                                                           options:0
-                                                            locale:[NSLocale currentLocale]]];
+        template = @"yyyyMMMd jj:mm:ss";
     } else if (timeDelta < day * 6) {
         // 6 days to 180 days ago: include date without year
-        [fmt setDateFormat:[NSDateFormatter dateFormatFromTemplate:@"MMMd jj:mm:ss"
-                                                           options:0
-                                                            locale:[NSLocale currentLocale]]];
+        template = @"MMMd jj:mm:ss";
     } else if (timeDelta < day) {
         // 1 day to 6 days ago: include day of week
-        [fmt setDateFormat:[NSDateFormatter dateFormatFromTemplate:@"EEE jj:mm:ss"
-                                                           options:0
-                                                            locale:[NSLocale currentLocale]]];
+        template = @"EEE jj:mm:ss";
     } else {
         // In last 24 hours, just show time
-        [fmt setDateFormat:[NSDateFormatter dateFormatFromTemplate:@"jj:mm:ss"
-                                                           options:0
-                                                            locale:[NSLocale currentLocale]]];
+        template = @"jj:mm:ss";
+    }
+
+    // Making a formatter costs far more than using one and this is called for every visible row on
+    // every frame. Formatters are thread safe, so there is one per template, locale, and time zone.
+    static NSCache<NSString *, NSDateFormatter *> *formatters;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        formatters = [[NSCache alloc] init];
+    });
+    NSLocale *locale = [NSLocale currentLocale];
+    NSString *timeZoneName = useTestingTimezone ? @"GMT" : [[NSTimeZone defaultTimeZone] name];
+    NSString *key = [NSString stringWithFormat:@"%@ %@ %@", template, locale.localeIdentifier, timeZoneName];
+    NSDateFormatter *fmt = [formatters objectForKey:key];
+    if (fmt) {
+        return fmt;
     }
+    fmt = [[NSDateFormatter alloc] init];
+    [fmt setDateFormat:[NSDateFormatter dateFormatFromTemplate:template
+                                                       options:0
+                                                        locale:locale]];
     if (useTestingTimezone) {
         fmt.timeZone = [NSTimeZone timeZoneForSecondsFromGMT:0];
     }
+    [formatters setObject:fmt forKey:key];
     return fmt;
 }
 
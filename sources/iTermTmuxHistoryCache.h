@@ -0,0 +1,38 @@
+//
+//  iTermTmuxHistoryCache.h
+//  iTerm2SharedARC
+//
+//  Created by agent on 10/14/26.
+//
+
+#import <Foundation/Foundation.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+// Saves the response to capture-pane for each tmux pane so that reattaching only has to fetch
+// what was added since. Entries are compressed and keyed by the tmux session's GUID (which is
+// unique to a server's session) and the pane ID.
+@interface iTermTmuxHistoryCache : NSObject
+
+// How many lines to fetch when there is a cached history to merge with.
+@property (nonatomic, readonly) int numberOfRecentLinesToFetch;
+
++ (instancetype)sharedInstance;
+
+- (BOOL)hasHistoryForSessionGUID:(NSString *)guid pane:(int)wp;
+- (nullable NSString *)historyForSessionGUID:(NSString *)guid pane:(int)wp;
+
+// Writes in the background.
+- (void)saveHistory:(NSString *)history sessionGUID:(NSString *)guid pane:(int)wp;
+
+// Combines a cached capture-pane response with the response to fetching only the most recent
+// lines. The last |mutableLines| lines of |cached| may have been redrawn since it was saved, so
+// only lines before them are trusted. Returns nil if the two don't overlap, in which case the
+// whole history must be fetched.
++ (nullable NSString *)historyByMergingCachedHistory:(NSString *)cached
+                                       recentHistory:(NSString *)recent
+                                        mutableLines:(int)mutableLines;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,173 @@
+//
+//  iTermTmuxHistoryCache.m
+//  iTerm2SharedARC
+//
+//  Created by agent on 10/14/26.
+//
+
+#import "iTermTmuxHistoryCache.h"
+
+#import "DebugLogging.h"
+#import "NSData+iTerm.h"
+
+#import <zlib.h>
+
+static const uint32_t iTermTmuxHistoryCacheMagic = 'iTH1';
+
+// Fewer lines than this in common is too likely to be a coincidence (e.g., a run of blank lines).
+static const NSInteger iTermTmuxHistoryCacheMinimumOverlap = 16;
+
+typedef struct {
+    uint32_t magic;
+    uint32_t uncompressedSize;
+} iTermTmuxHistoryCacheHeader;
+
+@implementation iTermTmuxHistoryCache {
+    dispatch_queue_t _queue;
+    NSString *_directory;
+}
+
++ (instancetype)sharedInstance {
+    static id instance;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        instance = [[self alloc] init];
+    });
+    return instance;
+}
+
+- (instancetype)init {
+    self = [super init];
+    if (self) {
+        _queue = dispatch_queue_create("com.iterm2.tmux-history-cache", DISPATCH_QUEUE_SERIAL);
+        NSString *caches = NSSearchPathForDirectoriesInDomains(NSCachesDirectory, NSUserDomainMask, YES).firstObject;
+        NSString *bundleIdentifier = [[NSBundle mainBundle] bundleIdentifier] ?: @"iTerm2";
+        _directory = [[caches stringByAppendingPathComponent:bundleIdentifier] stringByAppendingPathComponent:@"TmuxHistory"];
+        _numberOfRecentLinesToFetch = 2000;
+    }
+    return self;
+}
+
+#pragma mark - API
+
+- (BOOL)hasHistoryForSessionGUID:(NSString *)guid pane:(int)wp {
+    return [[NSFileManager defaultManager] fileExistsAtPath:[self pathForSessionGUID:guid pane:wp]];
+}
+
+- (NSString *)historyForSessionGUID:(NSString *)guid pane:(int)wp {
+    NSString *path = [self pathForSessionGUID:guid pane:wp];
+    NSData *data = [NSData dataWithContentsOfFile:path options:NSDataReadingMappedIfSafe error:nil];
+    if (!data) {
+        return nil;
+    }
+    NSData *decompressed = [self decompressedData:data];
+    if (!decompressed) {
+        DLog(@"Discarding invalid tmux history cache at %@", path);
+        [[NSFileManager defaultManager] removeItemAtPath:path error:nil];
+        return nil;
+    }
+    return [[NSString alloc] initWithData:decompressed encoding:NSUTF8StringEncoding];
+}
+
+- (void)saveHistory:(NSString *)history sessionGUID:(NSString *)guid pane:(int)wp {
+    NSString *path = [self pathForSessionGUID:guid pane:wp];
+    NSString *directory = _directory;
+    dispatch_async(_queue, ^{
+        NSData *data = [self compressedData:[history dataUsingEncoding:NSUTF8StringEncoding]];
+        if (!data) {
+            return;
+        }
+        [[NSFileManager defaultManager] createDirectoryAtPath:directory
+                                  withIntermediateDirectories:YES
+                                                   attributes:nil
+                                                        error:nil];
+        NSError *error = nil;
+        if (![data writeToFile:path options:NSDataWritingAtomic error:&error]) {
+            DLog(@"Failed to write tmux history cache to %@: %@", path, error);
+        }
+    });
+}
+
++ (NSString *)historyByMergingCachedHistory:(NSString *)cached
+                              recentHistory:(NSString *)recent
+                               mutableLines:(int)mutableLines {
+    NSArray<NSString *> *cachedLines = [cached componentsSeparatedByString:@"\n"];
+    NSArray<NSString *> *recentLines = [recent componentsSeparatedByString:@"\n"];
+    const NSInteger immutableEnd = (NSInteger)cachedLines.count - mutableLines;
+    if (immutableEnd < iTermTmuxHistoryCacheMinimumOverlap) {
+        return nil;
+    }
+    // |recent| begins at some line of |cached|. Prefer the largest overlap since that means the
+    // fewest lines were added, and require every trusted line after that point to match.
+    const NSInteger firstCandidate = MAX(0, immutableEnd - (NSInteger)recentLines.count);
+    for (NSInteger p = firstCandidate; p <= immutableEnd - iTermTmuxHistoryCacheMinimumOverlap; p++) {
+        BOOL matches = YES;
+        for (NSInteger i = 0; p + i < immutableEnd; i++) {
+            if (![cachedLines[p + i] isEqualToString:recentLines[i]]) {
+                matches = NO;
+                break;
+            }
+        }
+        if (!matches) {
+            continue;
+        }
+        DLog(@"Merged %@ cached lines with %@ recent lines at %@", @(cachedLines.count), @(recentLines.count), @(p));
+        NSArray<NSString *> *merged = [[cachedLines subarrayWithRange:NSMakeRange(0, p)] arrayByAddingObjectsFromArray:recentLines];
+        return [merged componentsJoinedByString:@"\n"];
+    }
+    return nil;
+}
+
+#pragma mark - Private
+
+- (NSString *)pathForSessionGUID:(NSString *)guid pane:(int)wp {
+    NSString *key = [NSString stringWithFormat:@"%@|%d", guid, wp];
+    NSString *name = [[[key dataUsingEncoding:NSUTF8StringEncoding] it_sha256] it_hexEncoded];
+    return [_directory stringByAppendingPathComponent:name];
+}
+
+- (NSData *)compressedData:(NSData *)data {
+    if (data.length > UINT32_MAX) {
+        return nil;
+    }
+    uLongf compressedSize = compressBound(data.length);
+    NSMutableData *result = [NSMutableData dataWithLength:sizeof(iTermTmuxHistoryCacheHeader) + compressedSize];
+    iTermTmuxHistoryCacheHeader *header = result.mutableBytes;
+    header->magic = iTermTmuxHistoryCacheMagic;
+    header->uncompressedSize = (uint32_t)data.length;
+    const int status = compress2((Bytef *)(header + 1),
+                                 &compressedSize,
+                                 data.bytes,
+                                 data.length,
+                                 Z_BEST_SPEED);
+    if (status != Z_OK) {
+        DLog(@"compress2 failed with %@", @(status));
+        return nil;
+    }
+    result.length = sizeof(iTermTmuxHistoryCacheHeader) + compressedSize;
+    return result;
+}
+
+- (NSData *)decompressedData:(NSData *)data {
+    if (data.length < sizeof(iTermTmuxHistoryCacheHeader)) {
+        return nil;
+    }
+    iTermTmuxHistoryCacheHeader header;
+    memcpy(&header, data.bytes, sizeof(header));
+    if (header.magic != iTermTmuxHistoryCacheMagic) {
+        return nil;
+    }
+    NSMutableData *result = [NSMutableData dataWithLength:header.uncompressedSize];
+    uLongf size = header.uncompressedSize;
+    const int status = uncompress(result.mutableBytes,
+                                  &size,
+                                  (const Bytef *)data.bytes + sizeof(header),
+                                  data.length - sizeof(header));
+    if (status != Z_OK || size != header.uncompressedSize) {
+        DLog(@"uncompress failed with %@", @(status));
+        return nil;
+    }
+    return result;
+}
+
+@end
@@ -138,7 +138,7 @@
                responseTarget:self
              responseSelector:@selector(didFetch:)
                responseObject:nil
-                        flags:kTmuxGatewayCommandShouldTolerateErrors];
+                        flags:kTmuxGatewayCommandShouldTolerateErrors | kTmuxGatewayCommandMayShareResponse];
 }
 
 - (void)didFetch:(NSString *)value {
@@ -36,7 +36,9 @@
         _acceleratedInterval = 0.01;
         [_gateway sendCommand:@"display-message -p \"#{status-interval}\""
                responseTarget:self
-             responseSelector:@selector(handleStatusIntervalResponse:)];
+             responseSelector:@selector(handleStatusIntervalResponse:)
+               responseObject:nil
+                        flags:kTmuxGatewayCommandMayShareResponse];
         NSString *path = [NSString stringWithFormat:@"%@.%@",
                           iTermVariableKeySessionTab, iTermVariableKeyTabTmuxWindow];
         _paneReference = [[iTermVariableReference alloc] initWithPath:path
@@ -0,0 +1,41 @@
+//
+//  iTermTokenExecutionScheduler.h
+//  iTerm2SharedARC
+//
+//  Created by agent on 10/14/26.
+//
+
+#import <Foundation/Foundation.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+@protocol iTermTokenExecutionSchedulerClient<NSObject>
+
+// Main thread. Executes at least one pending token but no more than |tokenBudget| tokens or about
+// |byteBudget| bytes of input, splitting a batch if needed. Returns YES if tokens remain, in which
+// case the client gets another turn later.
+- (BOOL)tokenExecutionSchedulerExecuteWithTokenBudget:(int)tokenBudget byteBudget:(int)byteBudget;
+
+// Main thread. A client with weight n is served before lighter ones and gets n times the budget.
+// Must be at least 1.
+- (int)tokenExecutionSchedulerWeight;
+
+@end
+
+// Decides when each session's pending tokens get executed on the main thread. Rather than one
+// main-queue block per read, clients with pending tokens take turns in order of weight, each
+// executing up to its budget. When a pass runs out of time the rest waits for the next pass of the
+// run loop, so events that arrived in the meantime are handled first and one flooding session
+// can't hold up keystrokes or other sessions. Clients that were cut off go first in the next pass,
+// ahead of heavier ones, so a heavy client whose turns overrun the time slice can't starve them.
+@interface iTermTokenExecutionScheduler : NSObject
+
++ (instancetype)sharedInstance;
+
+// Any thread. Call after adding tokens while the client isn't already scheduled. The client is
+// retained until it reports having nothing left.
+- (void)scheduleClient:(id<iTermTokenExecutionSchedulerClient>)client;
+
+@end
+
+NS_ASSUME_NONNULL_END
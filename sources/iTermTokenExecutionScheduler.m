@@ -0,0 +1,144 @@
+//
+//  iTermTokenExecutionScheduler.m
+//  iTerm2SharedARC
+//
+//  Created by agent on 10/14/26.
+//
+
+#import "iTermTokenExecutionScheduler.h"
+
+#import "DebugLogging.h"
+
+// Tokens and bytes of input per unit of weight per turn. A few large tokens can take as long as
+// many small ones, so turns are bounded by both.
+static const int iTermTokenExecutionSchedulerBaseTokenBudget = 512;
+static const int iTermTokenExecutionSchedulerBaseByteBudget = 16384;
+
+// Time a single pass may take before yielding to the run loop. About one frame.
+static const NSTimeInterval iTermTokenExecutionSchedulerTimeSlice = 1.0 / 120.0;
+
+@implementation iTermTokenExecutionScheduler {
+    // Clients waiting for a turn, in the order they became ready. Guarded by @synchronized(self).
+    NSMutableOrderedSet<id<iTermTokenExecutionSchedulerClient>> *_readyClients;
+    // Clients that were still waiting when the time slice ran out, in the order they were to be
+    // served. They go before everyone in _readyClients whatever their weight. Guarded by
+    // @synchronized(self).
+    NSMutableOrderedSet<id<iTermTokenExecutionSchedulerClient>> *_skippedClients;
+    // Guarded by @synchronized(self).
+    BOOL _passScheduled;
+}
+
++ (instancetype)sharedInstance {
+    static iTermTokenExecutionScheduler *instance;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        instance = [[self alloc] init];
+    });
+    return instance;
+}
+
+- (instancetype)init {
+    self = [super init];
+    if (self) {
+        _readyClients = [NSMutableOrderedSet orderedSet];
+        _skippedClients = [NSMutableOrderedSet orderedSet];
+    }
+    return self;
+}
+
+- (void)scheduleClient:(id<iTermTokenExecutionSchedulerClient>)client {
+    @synchronized (self) {
+        [_readyClients addObject:client];
+    }
+    [self schedulePassIfNeeded];
+}
+
+#pragma mark - Private
+
+- (void)schedulePassIfNeeded {
+    @synchronized (self) {
+        if (_passScheduled || (_readyClients.count == 0 && _skippedClients.count == 0)) {
+            return;
+        }
+        _passScheduled = YES;
+    }
+    // Unlike the main dispatch queue, which may run blocks enqueued while it drains in the same
+    // pass, a block performed on the run loop waits for the next iteration, after pending events.
+    CFRunLoopPerformBlock(CFRunLoopGetMain(), kCFRunLoopCommonModes, ^{
+        [self runPass];
+    });
+    CFRunLoopWakeUp(CFRunLoopGetMain());
+}
+
+- (void)runPass {
+    const NSTimeInterval deadline = [NSDate timeIntervalSinceReferenceDate] + iTermTokenExecutionSchedulerTimeSlice;
+    NSInteger turns = 0;
+    while ([NSDate timeIntervalSinceReferenceDate] < deadline) {
+        NSArray<id<iTermTokenExecutionSchedulerClient>> *skipped;
+        NSMutableOrderedSet<id<iTermTokenExecutionSchedulerClient>> *ready;
+        @synchronized (self) {
+            skipped = _skippedClients.array;
+            [_skippedClients removeAllObjects];
+            ready = [_readyClients mutableCopy];
+            [_readyClients removeAllObjects];
+        }
+        [ready minusSet:[NSSet setWithArray:skipped]];
+        NSArray<id<iTermTokenExecutionSchedulerClient>> *round = [skipped arrayByAddingObjectsFromArray:ready.array];
+        if (round.count == 0) {
+            break;
+        }
+        // Weights can change between rounds (e.g., a keystroke was just sent), so compute them each
+        // time.
+        NSMutableArray<NSNumber *> *weights = [NSMutableArray arrayWithCapacity:round.count];
+        for (id<iTermTokenExecutionSchedulerClient> client in round) {
+            [weights addObject:@(MAX(1, [client tokenExecutionSchedulerWeight]))];
+        }
+        // Skipped clients keep their order at the front. The rest go heaviest first. The sort is
+        // stable so clients of equal weight keep their round-robin order.
+        NSArray<NSNumber *> *indexes = [self indexesOfArray:round];
+        NSArray<NSNumber *> *order = [indexes subarrayWithRange:NSMakeRange(0, skipped.count)];
+        NSArray<NSNumber *> *sorted = [[indexes subarrayWithRange:NSMakeRange(skipped.count, round.count - skipped.count)]
+                                       sortedArrayWithOptions:NSSortStable
+                                       usingComparator:^NSComparisonResult(NSNumber *lhs, NSNumber *rhs) {
+            return [weights[rhs.integerValue] compare:weights[lhs.integerValue]];
+        }];
+        order = [order arrayByAddingObjectsFromArray:sorted];
+
+        NSMutableArray<id<iTermTokenExecutionSchedulerClient>> *unfinished = [NSMutableArray array];
+        NSMutableArray<id<iTermTokenExecutionSchedulerClient>> *unserved = [NSMutableArray array];
+        for (NSNumber *index in order) {
+            id<iTermTokenExecutionSchedulerClient> client = round[index.integerValue];
+            if (turns > 0 && [NSDate timeIntervalSinceReferenceDate] >= deadline) {
+                [unserved addObject:client];
+                continue;
+            }
+            const int weight = weights[index.integerValue].intValue;
+            if ([client tokenExecutionSchedulerExecuteWithTokenBudget:iTermTokenExecutionSchedulerBaseTokenBudget * weight
+                                                           byteBudget:iTermTokenExecutionSchedulerBaseByteBudget * weight]) {
+                [unfinished addObject:client];
+            }
+            turns++;
+        }
+        @synchronized (self) {
+            [_skippedClients addObjectsFromArray:unserved];
+            // Clients that became ready during this round were added already. Those that were just
+            // served wait behind them.
+            [_readyClients addObjectsFromArray:unfinished];
+        }
+    }
+    DLog(@"Token execution pass ran %@ turns", @(turns));
+    @synchronized (self) {
+        _passScheduled = NO;
+    }
+    [self schedulePassIfNeeded];
+}
+
+- (NSArray<NSNumber *> *)indexesOfArray:(NSArray *)array {
+    NSMutableArray<NSNumber *> *indexes = [NSMutableArray arrayWithCapacity:array.count];
+    for (NSUInteger i = 0; i < array.count; i++) {
+        [indexes addObject:@(i)];
+    }
+    return indexes;
+}
+
+@end
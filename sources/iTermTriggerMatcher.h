@@ -0,0 +1,36 @@
+//
+//  iTermTriggerMatcher.h
+//  iTerm2SharedARC
+//
+//  Created by agent on 10/14/26.
+//
+
+#import <Foundation/Foundation.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+// Decides which of a list of regexes could possibly match a string with a single pass over it.
+// Each regex contributes the literal that all of its matches must contain (see
+// iTermRegexRequiredLiteral()) to one Aho-Corasick automaton. Regexes without such a literal are
+// always reported as candidates, so this never rules out a regex that would match.
+@interface iTermTriggerMatcher : NSObject
+
+- (instancetype)initWithRegexes:(NSArray<NSString *> *)regexes NS_DESIGNATED_INITIALIZER;
+- (instancetype)init NS_UNAVAILABLE;
+
+// Returns the indexes (into the array passed to the initializer) of regexes that may match
+// |string|.
+- (NSIndexSet *)indexesOfRegexesThatMayMatchString:(NSString *)string;
+
+// Like indexesOfRegexesThatMayMatchString: but only literals that begin at or after |location|
+// are considered. Regexes without a literal are still always included. When a string grows,
+// scanning from maximumLiteralLength-1 characters before its old end finds every literal that
+// wasn't already present.
+- (NSIndexSet *)indexesOfRegexesThatMayMatchString:(NSString *)string fromIndex:(NSUInteger)location;
+
+// Length of the longest required literal, or 0 if there are none.
+@property (nonatomic, readonly) NSUInteger maximumLiteralLength;
+
+@end
+
+NS_ASSUME_NONNULL_END
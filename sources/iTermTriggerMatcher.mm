@@ -0,0 +1,168 @@
+//
+//  iTermTriggerMatcher.mm
+//  iTerm2SharedARC
+//
+//  Created by agent on 10/14/26.
+//
+
+#import "iTermTriggerMatcher.h"
+
+extern "C" {
+#import "DebugLogging.h"
+#import "iTermRegexLiteral.h"
+}
+
+#include <deque>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace iTerm2 {
+    // A node of the Aho-Corasick automaton. ASCII transitions are a full table so the common case
+    // is a single lookup per character; everything else falls back along failure links.
+    struct TriggerMatcherNode {
+        int ascii[128];
+        std::unordered_map<unichar, int> wide;
+        std::vector<std::pair<unichar, int>> children;
+        int fail;
+        // Indexes of regexes whose literal ends here (including via failure links).
+        std::vector<NSUInteger> outputs;
+
+        TriggerMatcherNode() : fail(0) {
+            std::fill(std::begin(ascii), std::end(ascii), -1);
+        }
+    };
+
+    static inline int TriggerMatcherTransition(const std::vector<TriggerMatcherNode> &nodes,
+                                               int state,
+                                               unichar c) {
+        if (c < 128) {
+            // Filled in for every node once failure links are built.
+            return nodes[state].ascii[c];
+        }
+        while (true) {
+            auto it = nodes[state].wide.find(c);
+            if (it != nodes[state].wide.end()) {
+                return it->second;
+            }
+            if (state == 0) {
+                return 0;
+            }
+            state = nodes[state].fail;
+        }
+    }
+}
+
+@implementation iTermTriggerMatcher {
+    std::vector<iTerm2::TriggerMatcherNode> _nodes;
+    // Regexes that have no required literal and so must always be tried.
+    NSIndexSet *_unconditionalIndexes;
+    NSUInteger _numberOfRegexes;
+}
+
+- (instancetype)initWithRegexes:(NSArray<NSString *> *)regexes {
+    self = [super init];
+    if (self) {
+        _numberOfRegexes = regexes.count;
+        NSMutableIndexSet *unconditional = [NSMutableIndexSet indexSet];
+        _nodes.emplace_back();
+        [regexes enumerateObjectsUsingBlock:^(NSString * _Nonnull regex, NSUInteger idx, BOOL * _Nonnull stop) {
+            NSString *literal = iTermRegexRequiredLiteral(regex, NO);
+            if (!literal) {
+                [unconditional addIndex:idx];
+                return;
+            }
+            DLog(@"Regex %@ requires literal %@", regex, literal);
+            self->_maximumLiteralLength = MAX(self->_maximumLiteralLength, literal.length);
+            [self addLiteral:literal index:idx];
+        }];
+        _unconditionalIndexes = unconditional;
+        [self buildFailureLinks];
+    }
+    return self;
+}
+
+- (void)addLiteral:(NSString *)literal index:(NSUInteger)index {
+    int state = 0;
+    const NSUInteger length = literal.length;
+    for (NSUInteger i = 0; i < length; i++) {
+        const unichar c = [literal characterAtIndex:i];
+        int next = [self childOf:state character:c];
+        if (next < 0) {
+            next = _nodes.size();
+            _nodes.emplace_back();
+            _nodes[state].children.push_back(std::make_pair(c, next));
+            if (c < 128) {
+                _nodes[state].ascii[c] = next;
+            } else {
+                _nodes[state].wide[c] = next;
+            }
+        }
+        state = next;
+    }
+    _nodes[state].outputs.push_back(index);
+}
+
+- (int)childOf:(int)state character:(unichar)c {
+    if (c < 128) {
+        return _nodes[state].ascii[c];
+    }
+    auto it = _nodes[state].wide.find(c);
+    if (it == _nodes[state].wide.end()) {
+        return -1;
+    }
+    return it->second;
+}
+
+// Breadth-first so that a node's failure target, which is always shallower, is complete before
+// the node itself is processed.
+- (void)buildFailureLinks {
+    std::deque<int> queue;
+    queue.push_back(0);
+    while (!queue.empty()) {
+        const int u = queue.front();
+        queue.pop_front();
+        for (const auto &child : _nodes[u].children) {
+            const int v = child.second;
+            const int f = (u == 0) ? 0 : iTerm2::TriggerMatcherTransition(_nodes, _nodes[u].fail, child.first);
+            _nodes[v].fail = f;
+            _nodes[v].outputs.insert(_nodes[v].outputs.end(),
+                                     _nodes[f].outputs.begin(),
+                                     _nodes[f].outputs.end());
+            queue.push_back(v);
+        }
+        for (int c = 0; c < 128; c++) {
+            if (_nodes[u].ascii[c] < 0) {
+                _nodes[u].ascii[c] = (u == 0) ? 0 : _nodes[_nodes[u].fail].ascii[c];
+            }
+        }
+    }
+}
+
+- (NSIndexSet *)indexesOfRegexesThatMayMatchString:(NSString *)string {
+    return [self indexesOfRegexesThatMayMatchString:string fromIndex:0];
+}
+
+- (NSIndexSet *)indexesOfRegexesThatMayMatchString:(NSString *)string fromIndex:(NSUInteger)location {
+    const NSUInteger length = string.length;
+    if (_nodes.size() == 1 || location >= length) {
+        return _unconditionalIndexes;
+    }
+    NSMutableIndexSet *result = [_unconditionalIndexes mutableCopy];
+    std::vector<unichar> chars(length - location);
+    [string getCharacters:chars.data() range:NSMakeRange(location, length - location)];
+
+    int state = 0;
+    for (NSUInteger i = 0; i < chars.size(); i++) {
+        state = iTerm2::TriggerMatcherTransition(_nodes, state, chars[i]);
+        for (NSUInteger index : _nodes[state].outputs) {
+            [result addIndex:index];
+        }
+        if (result.count == _numberOfRegexes) {
+            break;
+        }
+    }
+    return result;
+}
+
+@end
@@ -18,15 +18,22 @@
 
 @interface iTermURLActionFactory : NSUserDefaults
 
-+ (void)urlActionAtCoord:(VT100GridCoord)coord
-     respectHardNewlines:(BOOL)respectHardNewlines
-        workingDirectory:(NSString *)workingDirectory
-              remoteHost:(VT100RemoteHost *)remoteHost
-               selectors:(NSDictionary<NSNumber *, NSString *> *)selectors
-                   rules:(NSArray *)rules
-               extractor:(iTermTextExtractor *)extractor
-semanticHistoryController:(iTermSemanticHistoryController *)semanticHistoryController
-             pathFactory:(SCPPath *(^)(NSString *, int))pathFactory
-              completion:(void (^)(URLAction *))completion;
+// Returns the factory, which may already be finished. It is kept alive until it finishes. If
+// |yieldsBetweenPhases| is set, it returns to the run loop between phases so events are handled
+// while it works.
++ (instancetype)urlActionAtCoord:(VT100GridCoord)coord
+             respectHardNewlines:(BOOL)respectHardNewlines
+                workingDirectory:(NSString *)workingDirectory
+                      remoteHost:(VT100RemoteHost *)remoteHost
+                       selectors:(NSDictionary<NSNumber *, NSString *> *)selectors
+                           rules:(NSArray *)rules
+                       extractor:(iTermTextExtractor *)extractor
+       semanticHistoryController:(iTermSemanticHistoryController *)semanticHistoryController
+                     pathFactory:(SCPPath *(^)(NSString *, int))pathFactory
+             yieldsBetweenPhases:(BOOL)yieldsBetweenPhases
+                      completion:(void (^)(URLAction *))completion;
+
+// Stops work in progress. The completion block will not be called.
+- (void)cancel;
 
 @end
@@ -51,6 +51,7 @@ typedef enum {
 @property (nonatomic, copy) void (^completion)(URLAction *);
 @property (nonatomic) iTermURLActionFactoryPhase phase;
 @property (nonatomic) BOOL workingDirectoryIsLocal;
+@property (nonatomic) BOOL yieldsBetweenPhases;
 
 @property (nonatomic, strong) iTermLocatedString *locatedPrefix;
 @property (nonatomic, strong) iTermLocatedString *locatedSuffix;
@@ -60,19 +61,21 @@ static NSMutableArray<iTermURLActionFactory *> *sFactories;
 
 @implementation iTermURLActionFactory {
     BOOL _finished;
+    BOOL _canceled;
     iTermPathFinder *_pathfinder;
 }
 
-+ (void)urlActionAtCoord:(VT100GridCoord)coord
-     respectHardNewlines:(BOOL)respectHardNewlines
-        workingDirectory:(NSString *)workingDirectory
-              remoteHost:(VT100RemoteHost *)remoteHost
-               selectors:(NSDictionary<NSNumber *, NSString *> *)selectors
-                   rules:(NSArray *)rules
-               extractor:(iTermTextExtractor *)extractor
-semanticHistoryController:(iTermSemanticHistoryController *)semanticHistoryController
-             pathFactory:(SCPPath *(^)(NSString *, int))pathFactory
-              completion:(void (^)(URLAction *))completion {
++ (instancetype)urlActionAtCoord:(VT100GridCoord)coord
+             respectHardNewlines:(BOOL)respectHardNewlines
+                workingDirectory:(NSString *)workingDirectory
+                      remoteHost:(VT100RemoteHost *)remoteHost
+                       selectors:(NSDictionary<NSNumber *, NSString *> *)selectors
+                           rules:(NSArray *)rules
+                       extractor:(iTermTextExtractor *)extractor
+       semanticHistoryController:(iTermSemanticHistoryController *)semanticHistoryController
+                     pathFactory:(SCPPath *(^)(NSString *, int))pathFactory
+             yieldsBetweenPhases:(BOOL)yieldsBetweenPhases
+                      completion:(void (^)(URLAction *))completion {
     iTermURLActionFactory *factory = [[iTermURLActionFactory alloc] init];
     factory.coord = coord;
     factory.respectHardNewlines = respectHardNewlines;
@@ -84,6 +87,7 @@ semanticHistoryController:(iTermSemanticHistoryController *)semanticHistoryContr
     factory.semanticHistoryController = semanticHistoryController;
     factory.pathFactory = pathFactory;
     factory.completion = completion;
+    factory.yieldsBetweenPhases = yieldsBetweenPhases;
     factory.phase = iTermURLActionFactoryPhaseHypertextLink;
     [[NSNotificationCenter defaultCenter] addObserver:factory
                                              selector:@selector(cancelPathfinders:)
@@ -97,6 +101,7 @@ semanticHistoryController:(iTermSemanticHistoryController *)semanticHistoryContr
 
     [sFactories addObject:factory];
     [factory tryCurrentPhase];
+    return factory;
 }
 
 - (iTermTextExtractor *)extractor {
@@ -114,6 +119,9 @@ semanticHistoryController:(iTermSemanticHistoryController *)semanticHistoryContr
 
 // This is always eventually callsed.
 - (void)completeWithAction:(URLAction *)action {
+    if (_canceled) {
+        return;
+    }
     DLog(@"Phase completed successfully with action %@", action);
     _finished = YES;
     self.completion(action);
@@ -123,10 +131,29 @@ semanticHistoryController:(iTermSemanticHistoryController *)semanticHistoryContr
 - (void)fail {
     DLog(@"Phase failed");
     self.phase = self.phase + 1;
+    if (self.yieldsBetweenPhases) {
+        dispatch_async(dispatch_get_main_queue(), ^{
+            [self tryCurrentPhase];
+        });
+        return;
+    }
     [self tryCurrentPhase];
 }
 
+- (void)cancel {
+    if (_finished || _canceled) {
+        return;
+    }
+    DLog(@"Cancel factory for %@", VT100GridCoordDescription(self.coord));
+    _canceled = YES;
+    [_pathfinder cancel];
+    [sFactories removeObject:self];
+}
+
 - (void)tryCurrentPhase {
+    if (_canceled) {
+        return;
+    }
     if (self.extractor.dataSource == nil) {
         [self completeWithAction:nil];
         return;
@@ -314,6 +341,17 @@ semanticHistoryController:(iTermSemanticHistoryController *)semanticHistoryContr
                                                                                       int suffixChars,
                                                                                       BOOL workingDirectoryIsLocal) {
         DLog(@"Semantic history controller returned filename %@ with %@ prefix and %@ suffix chars", filename, @(prefixChars), @(suffixChars));
+        if ([iTermAdvancedSettingsModel resolveSemanticHistoryPathsAsynchronously]) {
+            [self urlActionForFilename:filename
+                         locatedPrefix:locatedPrefix
+                         locatedSuffix:locatedSuffix
+                           prefixChars:prefixChars
+                           suffixChars:suffixChars
+                            completion:^(URLAction *action) {
+                completion(action, workingDirectoryIsLocal);
+            }];
+            return;
+        }
         URLAction *action = [self urlActionForFilename:filename
                                          locatedPrefix:locatedPrefix
                                          locatedSuffix:locatedSuffix
@@ -328,6 +366,61 @@ semanticHistoryController:(iTermSemanticHistoryController *)semanticHistoryContr
                       locatedSuffix:(iTermLocatedString *)locatedSuffix
                         prefixChars:(int)prefixChars
                         suffixChars:(int)suffixChars {
+    URLAction *action = [self urlActionWithoutPathForFilename:filename
+                                                locatedPrefix:locatedPrefix
+                                                locatedSuffix:locatedSuffix
+                                                  prefixChars:prefixChars
+                                                  suffixChars:suffixChars];
+    if (!action) {
+        return nil;
+    }
+    NSString *lineNumber = nil;
+    NSString *columnNumber = nil;
+    action.fullPath = [self.semanticHistoryController cleanedUpPathFromPath:filename
+                                                                     suffix:[locatedSuffix.string substringFromIndex:suffixChars]
+                                                           workingDirectory:self.workingDirectory
+                                                        extractedLineNumber:&lineNumber
+                                                               columnNumber:&columnNumber];
+    action.lineNumber = lineNumber;
+    action.columnNumber = columnNumber;
+    return action;
+}
+
+// Cleans up the path without blocking the main thread since it may hit a slow filesystem.
+- (void)urlActionForFilename:(NSString *)filename
+               locatedPrefix:(iTermLocatedString *)locatedPrefix
+               locatedSuffix:(iTermLocatedString *)locatedSuffix
+                 prefixChars:(int)prefixChars
+                 suffixChars:(int)suffixChars
+                  completion:(void (^)(URLAction *))completion {
+    URLAction *action = [self urlActionWithoutPathForFilename:filename
+                                                locatedPrefix:locatedPrefix
+                                                locatedSuffix:locatedSuffix
+                                                  prefixChars:prefixChars
+                                                  suffixChars:suffixChars];
+    if (!action) {
+        completion(nil);
+        return;
+    }
+    [self.semanticHistoryController cleanUpPathFromPath:filename
+                                                 suffix:[locatedSuffix.string substringFromIndex:suffixChars]
+                                       workingDirectory:self.workingDirectory
+                                             completion:^(NSString *cleanedUpPath,
+                                                          NSString *lineNumber,
+                                                          NSString *columnNumber) {
+        action.fullPath = cleanedUpPath;
+        action.lineNumber = lineNumber;
+        action.columnNumber = columnNumber;
+        completion(action);
+    }];
+}
+
+// Returns an action whose fullPath, lineNumber, and columnNumber are not yet set.
+- (URLAction *)urlActionWithoutPathForFilename:(NSString *)filename
+                                 locatedPrefix:(iTermLocatedString *)locatedPrefix
+                                 locatedSuffix:(iTermLocatedString *)locatedSuffix
+                                   prefixChars:(int)prefixChars
+                                   suffixChars:(int)suffixChars {
     if (self.extractor.dataSource == nil) {
         return nil;
     }
@@ -364,17 +457,7 @@ semanticHistoryController:(iTermSemanticHistoryController *)semanticHistoryContr
     range.coordRange.end = [self.extractor successorOfCoord:lastCoord];
     range.columnWindow = self.extractor.logicalWindow;
     action.range = range;
-
-    NSString *lineNumber = nil;
-    NSString *columnNumber = nil;
     action.rawFilename = filename;
-    action.fullPath = [self.semanticHistoryController cleanedUpPathFromPath:filename
-                                                                     suffix:[locatedSuffix.string substringFromIndex:suffixChars]
-                                                           workingDirectory:self.workingDirectory
-                                                        extractedLineNumber:&lineNumber
-                                                               columnNumber:&columnNumber];
-    action.lineNumber = lineNumber;
-    action.columnNumber = columnNumber;
     action.workingDirectory = self.workingDirectory;
     return action;
 }
@@ -42,6 +42,8 @@ NS_ASSUME_NONNULL_BEGIN
             allowRightMarginOverflow:(BOOL)allowRightMarginOverflow;
 
 - (long long)urlActionTotalScrollbackOverflow:(iTermURLActionHelper *)helper;
+- (int)urlActionHelperWidth:(iTermURLActionHelper *)helper;
+- (NSInteger)urlActionHelper:(iTermURLActionHelper *)helper generationForLine:(int)line;
 
 - (VT100RemoteHost *)urlActionHelper:(iTermURLActionHelper *)helper remoteHostOnLine:(int)line;
 
@@ -76,6 +78,14 @@ NS_ASSUME_NONNULL_BEGIN
           respectingHardNewlines:(BOOL)respectHardNewlines
                       completion:(void (^)(URLAction * _Nullable))completion;
 
+// For cmd-hover, which looks up a new coord on every mouse move. Cancels the previous hover
+// lookup, so only the completion of the most recent one is called. Results are remembered until
+// the lines they cover change or -invalidateHoverCache is called.
+- (void)urlActionForHoverAtCoord:(VT100GridCoord)coord
+                      completion:(void (^)(URLAction * _Nullable))completion;
+
+- (void)invalidateHoverCache;
+
 - (void)openTargetWithEvent:(NSEvent *)event inBackground:(BOOL)openInBackground;
 
 - (void)findUrlInString:(NSString *)aURLString andOpenInBackground:(BOOL)background;
@@ -24,8 +24,30 @@
 #import "SmartMatch.h"
 #import "URLAction.h"
 
+static const NSUInteger iTermURLActionHelperHoverCacheCapacity = 32;
+
+// A hover result that is good as long as the lines it covers have the same generations.
+@interface iTermURLActionHoverCacheEntry : NSObject
+@property (nonatomic) VT100GridAbsWindowedRange range;
+@property (nonatomic) int width;
+// One per line in |range|.
+@property (nonatomic, copy) NSArray<NSNumber *> *generations;
+// nil if there is no action at the coord.
+@property (nonatomic, strong) URLAction *action;
+@end
+
+@implementation iTermURLActionHoverCacheEntry
+@end
+
 @implementation iTermURLActionHelper {
     NSInteger _openTargetGeneration;
+    NSInteger _lastHoverGeneration;
+    // Of the hover lookup in progress, or 0 if there is none.
+    NSInteger _hoverGeneration;
+    iTermURLActionFactory *_hoverFactory;
+    VT100GridAbsCoord _hoverCoord;
+    // Most recently used first.
+    NSMutableArray<iTermURLActionHoverCacheEntry *> *_hoverCache;
 }
 
 - (instancetype)initWithSemanticHistoryController:(iTermSemanticHistoryController *)semanticHistoryController {
@@ -55,6 +77,60 @@
 - (void)urlActionForClickAtCoord:(VT100GridCoord)coord
           respectingHardNewlines:(BOOL)respectHardNewlines
                       completion:(void (^)(URLAction *))completion {
+    [self urlActionAtCoord:coord
+    respectingHardNewlines:respectHardNewlines
+                generation:-1
+                completion:completion];
+}
+
+- (void)urlActionForHoverAtCoord:(VT100GridCoord)coord
+                      completion:(void (^)(URLAction *))completion {
+    if (![iTermAdvancedSettingsModel cancelableCmdHoverURLLookup]) {
+        [self urlActionForClickAtCoord:coord completion:completion];
+        return;
+    }
+    const long long overflow = [self.delegate urlActionTotalScrollbackOverflow:self];
+    const VT100GridAbsCoord absCoord = VT100GridAbsCoordFromCoord(coord, overflow);
+    iTermURLActionHoverCacheEntry *entry = [self hoverCacheEntryForCoord:coord overflow:overflow];
+    if (entry) {
+        DLog(@"Hover cache hit at %@: %@", VT100GridAbsCoordDescription(absCoord), entry.action);
+        [self cancelHoverLookup];
+        completion(entry.action);
+        return;
+    }
+    if (_hoverGeneration > 0 && VT100GridAbsCoordEquals(absCoord, _hoverCoord)) {
+        DLog(@"Hover lookup at %@ already in progress", VT100GridAbsCoordDescription(absCoord));
+        return;
+    }
+    [self cancelHoverLookup];
+    _hoverCoord = absCoord;
+    const NSInteger generation = ++_lastHoverGeneration;
+    _hoverGeneration = generation;
+    __weak __typeof(self) weakSelf = self;
+    [self urlActionAtCoord:coord
+    respectingHardNewlines:![self ignoreHardNewlinesInURLs]
+                generation:generation
+                completion:^(URLAction *action) {
+        __strong __typeof(self) strongSelf = weakSelf;
+        if (!strongSelf || strongSelf->_hoverGeneration != generation) {
+            return;
+        }
+        strongSelf->_hoverGeneration = 0;
+        strongSelf->_hoverFactory = nil;
+        [strongSelf addHoverResult:action at:absCoord overflow:overflow];
+        completion(action);
+    }];
+}
+
+- (void)invalidateHoverCache {
+    [self cancelHoverLookup];
+    [_hoverCache removeAllObjects];
+}
+
+- (void)urlActionAtCoord:(VT100GridCoord)coord
+  respectingHardNewlines:(BOOL)respectHardNewlines
+              generation:(NSInteger)generation
+              completion:(void (^)(URLAction *))completion {
     DLog(@"urlActionForClickAt:%@ respectingHardNewlines:%@",
          VT100GridCoordDescription(coord), @(respectHardNewlines));
     if (coord.y < 0) {
@@ -76,6 +152,11 @@
     [self.delegate urlActionHelper:self
             workingDirectoryOnLine:coord.y
                         completion:^(NSString *workingDirectory) {
+        if (generation >= 0 && generation != self->_hoverGeneration) {
+            DLog(@"Hover lookup %@ was canceled while getting the working directory", @(generation));
+            return;
+        }
+        iTermURLActionFactory *factory =
         [iTermURLActionFactory urlActionAtCoord:coord
                             respectHardNewlines:respectHardNewlines
                                workingDirectory:workingDirectory ?: @""
@@ -87,10 +168,86 @@
                                     pathFactory:^SCPPath *(NSString *path, int line) {
                                         return [self.delegate urlActionHelper:self secureCopyPathForFile:path onLine:line];
                                     }
+                            yieldsBetweenPhases:generation >= 0
                                      completion:completion];
+        if (generation >= 0 && generation == self->_hoverGeneration) {
+            self->_hoverFactory = factory;
+        }
     }];
 }
 
+#pragma mark - Hover
+
+- (void)cancelHoverLookup {
+    [_hoverFactory cancel];
+    _hoverFactory = nil;
+    _hoverGeneration = 0;
+}
+
+- (NSArray<NSNumber *> *)generationsForRange:(VT100GridAbsWindowedRange)range
+                                    overflow:(long long)overflow {
+    NSMutableArray<NSNumber *> *generations = [NSMutableArray array];
+    for (long long y = range.coordRange.start.y; y <= range.coordRange.end.y; y++) {
+        if (y < overflow) {
+            // Scrolled off the top of history.
+            return nil;
+        }
+        [generations addObject:@([self.delegate urlActionHelper:self generationForLine:(int)(y - overflow)])];
+    }
+    return generations;
+}
+
+- (iTermURLActionHoverCacheEntry *)hoverCacheEntryForCoord:(VT100GridCoord)coord
+                                                  overflow:(long long)overflow {
+    const int width = [self.delegate urlActionHelperWidth:self];
+    for (NSUInteger i = 0; i < _hoverCache.count; i++) {
+        iTermURLActionHoverCacheEntry *entry = _hoverCache[i];
+        if (entry.width != width ||
+            entry.range.coordRange.start.y < overflow ||
+            !VT100GridWindowedRangeContainsCoord(VT100GridWindowedRangeFromAbsWindowedRange(entry.range, overflow), coord)) {
+            continue;
+        }
+        NSArray<NSNumber *> *generations = [self generationsForRange:entry.range overflow:overflow];
+        if (![generations isEqualToArray:entry.generations]) {
+            [_hoverCache removeObjectAtIndex:i];
+            return nil;
+        }
+        if (i > 0) {
+            [_hoverCache removeObjectAtIndex:i];
+            [_hoverCache insertObject:entry atIndex:0];
+        }
+        return entry;
+    }
+    return nil;
+}
+
+- (void)addHoverResult:(URLAction *)action
+                    at:(VT100GridAbsCoord)coord
+              overflow:(long long)overflow {
+    iTermURLActionHoverCacheEntry *entry = [[iTermURLActionHoverCacheEntry alloc] init];
+    if (action) {
+        entry.range = VT100GridAbsWindowedRangeFromRelative(action.range, overflow);
+    } else {
+        // Nothing here, but a neighbor might still have an action so remember just this cell.
+        entry.range = VT100GridAbsWindowedRangeMake(VT100GridAbsCoordRangeMake(coord.x, coord.y, coord.x + 1, coord.y),
+                                                    coord.x,
+                                                    1);
+    }
+    entry.width = [self.delegate urlActionHelperWidth:self];
+    entry.generations = [self generationsForRange:entry.range overflow:overflow];
+    entry.action = action;
+    if (!entry.generations) {
+        return;
+    }
+    if (!_hoverCache) {
+        _hoverCache = [NSMutableArray array];
+    }
+    [_hoverCache insertObject:entry atIndex:0];
+    while (_hoverCache.count > iTermURLActionHelperHoverCacheCapacity) {
+        [_hoverCache removeLastObject];
+    }
+}
+
 - (void)openTargetWithEvent:(NSEvent *)event inBackground:(BOOL)openInBackground {
     // Command click in place.
     const VT100GridCoord coord = [self.delegate urlActionHelper:self coordForEvent:event allowRightMarginOverflow:NO];
@@ -12,18 +12,60 @@
 
 #import <Cocoa/Cocoa.h>
 
-@implementation iTermURLStore {
-    // { "url": NSURL.absoluteString, "params": NSString } -> @(NSInteger)
-    NSMutableDictionary<NSDictionary *, NSNumber *> *_store;
+// Number of usable codes. Zero means "no URL".
+static const NSUInteger iTermURLStoreCapacity = USHRT_MAX;
+
+// One URL+params pair. Equality and hash consider only the URL string and params so that a set of
+// entries can find the existing entry for a pair.
+@interface iTermURLStoreEntry : NSObject
+@property (nonatomic, readonly) NSString *urlString;
+@property (nonatomic, readonly) NSString *params;
+@property (nonatomic, strong) NSURL *url;
+@property (nonatomic) unsigned short code;
+@property (nonatomic) NSUInteger referenceCount;
+@end
+
+@implementation iTermURLStoreEntry {
+    NSUInteger _hash;
+}
+
+- (instancetype)initWithURLString:(NSString *)urlString params:(NSString *)params {
+    self = [super init];
+    if (self) {
+        _urlString = [urlString copy];
+        _params = [params copy];
+        _hash = _urlString.hash * 31 + _params.hash;
+    }
+    return self;
+}
+
+- (NSUInteger)hash {
+    return _hash;
+}
+
+- (BOOL)isEqual:(id)object {
+    if (object == self) {
+        return YES;
+    }
+    if (![object isKindOfClass:[iTermURLStoreEntry class]]) {
+        return NO;
+    }
+    iTermURLStoreEntry *other = object;
+    return _hash == other->_hash && [_urlString isEqualToString:other->_urlString] && [_params isEqualToString:other->_params];
+}
 
-    // @(unsigned short) -> { "url": NSURL, "params": NSString }
-    NSMutableDictionary<NSNumber *, NSDictionary *> *_reverseStore;
+@end
+
+@implementation iTermURLStore {
+    // Each distinct URL+params has exactly one entry.
+    NSMutableSet<iTermURLStoreEntry *> *_entries;
 
-    NSCountedSet<NSNumber *> *_referenceCounts;
+    // Index is code. Slot 0 is never used.
+    NSPointerArray *_entriesByCode;
 
-    // Internally, the code is stored as a 64-bit integer so we don't have to think about overflow.
-    // The value that's exported is truncated to 16 bits and will never equal zero.
-    NSInteger _nextCode;
+    // The most recently allocated code. The search for a free code starts after it so codes that
+    // were just released aren't reused right away.
+    NSUInteger _lastCode;
 }
 
 + (instancetype)sharedInstance {
@@ -42,31 +84,39 @@
 - (instancetype)init {
     self = [super init];
     if (self) {
-        _store = [NSMutableDictionary dictionary];
-        _reverseStore = [NSMutableDictionary dictionary];
-        _referenceCounts = [NSCountedSet set];
+        _entries = [NSMutableSet set];
+        _entriesByCode = [NSPointerArray strongObjectsPointerArray];
+        _entriesByCode.count = iTermURLStoreCapacity + 1;
     }
     return self;
 }
 
+- (iTermURLStoreEntry *)entryForCode:(unsigned short)code {
+    if (code == 0) {
+        // Safety valve in case something goes awry. There should never be an entry at 0.
+        return nil;
+    }
+    return (__bridge iTermURLStoreEntry *)[_entriesByCode pointerAtIndex:code];
+}
+
 - (void)retainCode:(unsigned short)code {
     _generation++;
     [NSApp invalidateRestorableState];
-    [_referenceCounts addObject:@(code)];
+    [self entryForCode:code].referenceCount += 1;
 }
 
 - (void)releaseCode:(unsigned short)code {
     _generation++;
     [NSApp invalidateRestorableState];
-    [_referenceCounts removeObject:@(code)];
-    if (![_referenceCounts containsObject:@(code)]) {
-        NSDictionary *dict = _reverseStore[@(code)];
-        [_reverseStore removeObjectForKey:@(code)];
-        NSString *url = [dict[@"url"] absoluteString];
-        NSString *params = dict[@"params"];
-        if (url) {
-            [_store removeObjectForKey:@{ @"url": url, @"params": params }];
-        }
+    iTermURLStoreEntry *entry = [self entryForCode:code];
+    if (!entry) {
+        return;
+    }
+    if (entry.referenceCount > 0) {
+        entry.referenceCount -= 1;
+    }
+    if (entry.referenceCount == 0) {
+        [self removeEntry:entry];
     }
 }
 
@@ -75,44 +125,30 @@
         DLog(@"codeForURL:%@ withParams:%@ returning 0 because of nil value", url.absoluteString, params);
         return 0;
     }
-    NSDictionary *key = @{ @"url": url.absoluteString, @"params": params };
-    NSNumber *number = _store[key];
-    unsigned short truncatedCode;
-    if (number == nil) {
-        if (_reverseStore.count == USHRT_MAX - 1) {
-            DLog(@"Ran out of URL storage. Refusing to allocate a code.");
-            return 0;
-        }
-        while (_reverseStore[@(_nextCode)]) {
-            _nextCode++;
-        }
-        number = @(_nextCode);
-        _nextCode++;
-        _store[key] = number;
-        truncatedCode = [iTermURLStore truncatedCodeForCode:number.integerValue];
-        _reverseStore[@(truncatedCode)] = @{ @"url": url, @"params": params };
-        [NSApp invalidateRestorableState];
-        _generation++;
-        return truncatedCode;
-    } else {
-        return [iTermURLStore truncatedCodeForCode:number.integerValue];
+    iTermURLStoreEntry *probe = [[iTermURLStoreEntry alloc] initWithURLString:url.absoluteString
+                                                                        params:params];
+    iTermURLStoreEntry *existing = [_entries member:probe];
+    if (existing) {
+        return existing.code;
     }
+    const unsigned short code = [self unusedCode];
+    if (code == 0) {
+        DLog(@"Ran out of URL storage. Refusing to allocate a code.");
+        return 0;
+    }
+    probe.url = url;
+    [self addEntry:probe code:code];
+    [NSApp invalidateRestorableState];
+    _generation++;
+    return code;
 }
 
 - (NSURL *)urlForCode:(unsigned short)code {
-    if (code == 0) {
-        // Safety valve in case something goes awry. There should never be an entry at 0.
-        return nil;
-    }
-    return _reverseStore[@(code)][@"url"];
+    return [self entryForCode:code].url;
 }
 
 - (NSString *)paramsForCode:(unsigned short)code {
-    if (code == 0) {
-        // Safety valve in case something goes awry. There should never be an entry at 0.
-        return nil;
-    }
-    return _reverseStore[@(code)][@"params"];
+    return [self entryForCode:code].params;
 }
 
 - (NSString *)paramWithKey:(NSString *)key forCode:(unsigned short)code {
@@ -134,13 +170,24 @@
     return nil;
 }
 
+// The format predates the entry table: "store" maps { url, params } to a number whose truncated
+// value is the code, and "refcounts" is an archived counted set of codes.
 - (NSDictionary *)dictionaryValue {
+    NSMutableDictionary<NSDictionary *, NSNumber *> *store = [NSMutableDictionary dictionaryWithCapacity:_entries.count];
+    NSCountedSet<NSNumber *> *referenceCounts = [NSCountedSet set];
+    for (iTermURLStoreEntry *entry in _entries) {
+        store[@{ @"url": entry.urlString, @"params": entry.params }] = @(entry.code - 1);
+        for (NSUInteger i = 0; i < entry.referenceCount; i++) {
+            [referenceCounts addObject:@(entry.code)];
+        }
+    }
+
     NSKeyedArchiver *coder = [[NSKeyedArchiver alloc] initRequiringSecureCoding:YES];
     coder.outputFormat = NSPropertyListBinaryFormat_v1_0;
-    [_referenceCounts encodeWithCoder:coder];
+    [referenceCounts encodeWithCoder:coder];
     [coder finishEncoding];
 
-    return @{ @"store": _store,
+    return @{ @"store": store,
               @"refcounts": coder.encodedData };
 }
 
@@ -165,20 +212,62 @@
             XLog(@"Bogus key not a URL: %@", url);
             return;
         }
-        self->_store[key] = obj;
-
-        unsigned short truncated = [iTermURLStore truncatedCodeForCode:obj.integerValue];
-        self->_reverseStore[@(truncated)] = @{ @"url": url, @"params": key[@"params"] ?: @"" };
-        self->_nextCode = MAX(self->_nextCode, obj.integerValue + 1);
+        const unsigned short code = [iTermURLStore truncatedCodeForCode:obj.integerValue];
+        if ([self entryForCode:code]) {
+            DLog(@"Ignoring %@ because its code %@ is taken", key, @(code));
+            return;
+        }
+        iTermURLStoreEntry *entry = [[iTermURLStoreEntry alloc] initWithURLString:url.absoluteString
+                                                                           params:key[@"params"] ?: @""];
+        if ([self->_entries member:entry]) {
+            return;
+        }
+        entry.url = url;
+        [self addEntry:entry code:code];
+        self->_lastCode = MAX(self->_lastCode, code);
     }];
-    
+
     NSError *error = nil;
     NSKeyedUnarchiver *decoder = [[NSKeyedUnarchiver alloc] initForReadingFromData:refcounts error:&error];
     if (error) {
         NSLog(@"Failed to decode refcounts from data %@", refcounts);
         return;
     }
-    _referenceCounts = [[NSCountedSet alloc] initWithCoder:decoder];
+    NSCountedSet<NSNumber *> *referenceCounts = [[NSCountedSet alloc] initWithCoder:decoder];
+    for (NSNumber *code in referenceCounts) {
+        if (code.unsignedIntegerValue > iTermURLStoreCapacity) {
+            continue;
+        }
+        [self entryForCode:code.unsignedShortValue].referenceCount = [referenceCounts countForObject:code];
+    }
+}
+
+#pragma mark - Private
+
+- (void)addEntry:(iTermURLStoreEntry *)entry code:(unsigned short)code {
+    entry.code = code;
+    [_entries addObject:entry];
+    [_entriesByCode replacePointerAtIndex:code withPointer:(__bridge void *)entry];
+}
+
+- (void)removeEntry:(iTermURLStoreEntry *)entry {
+    [_entriesByCode replacePointerAtIndex:entry.code withPointer:NULL];
+    [_entries removeObject:entry];
+}
+
+// Returns 0 if every code is taken.
+- (unsigned short)unusedCode {
+    if (_entries.count >= iTermURLStoreCapacity) {
+        return 0;
+    }
+    for (NSUInteger i = 1; i <= iTermURLStoreCapacity; i++) {
+        const NSUInteger code = (_lastCode + i - 1) % iTermURLStoreCapacity + 1;
+        if (![_entriesByCode pointerAtIndex:code]) {
+            _lastCode = code;
+            return (unsigned short)code;
+        }
+    }
+    return 0;
 }
 
 @end
@@ -0,0 +1,60 @@
+//
+//  iTermUnicodeProperties.h
+//  iTerm2SharedARC
+//
+//  Created by agent on 10/14/26.
+//
+
+#import <Foundation/Foundation.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+typedef NS_OPTIONS(uint8_t, iTermUnicodeProperty) {
+    // Takes two cells. Never set for code points the width checks treat as obviously narrow.
+    iTermUnicodePropertyFullWidth = 1 << 0,
+    // Takes two cells if ambiguous-width characters are double width.
+    iTermUnicodePropertyAmbiguousWidth = 1 << 1,
+    // Default_Ignorable_Code_Point.
+    iTermUnicodePropertyIgnorable = 1 << 2,
+    iTermUnicodePropertySpacingCombiningMark = 1 << 3,
+    iTermUnicodePropertyEmojiPresentation = 1 << 4,
+    iTermUnicodePropertyTextPresentation = 1 << 5,
+};
+
+// A two-level table of the character properties that affect how text is laid out in cells. It
+// gives the same answers as the character sets in NSCharacterSet+iTerm without a message send or
+// a search through ranges. Each block of 256 code points is filled in from the character sets the
+// first time anything in it is looked up, so only the blocks a session actually uses cost anything.
+typedef struct {
+    // One entry per block. NULL until the block is first looked up.
+    const uint8_t * _Nullable blocks[0x110000 >> 8];
+    NSInteger unicodeVersion;
+} iTermUnicodePropertyTable;
+
+// Returns the long-lived table for a Unicode version setting. Safe to call from any thread.
+const iTermUnicodePropertyTable *iTermUnicodePropertyTableForVersion(NSInteger version);
+
+const uint8_t *iTermUnicodePropertyTableFillBlock(iTermUnicodePropertyTable *table, UTF32Char block);
+
+NS_INLINE iTermUnicodeProperty iTermUnicodePropertiesOfCodePoint(const iTermUnicodePropertyTable *table,
+                                                                 UTF32Char codePoint) {
+    if (codePoint > 0x10ffff) {
+        return 0;
+    }
+    const UTF32Char block = codePoint >> 8;
+    const uint8_t *properties = __atomic_load_n(&table->blocks[block], __ATOMIC_ACQUIRE);
+    if (__builtin_expect(properties == NULL, 0)) {
+        properties = iTermUnicodePropertyTableFillBlock((iTermUnicodePropertyTable *)table, block);
+    }
+    return properties[codePoint & 0xff];
+}
+
+NS_INLINE BOOL iTermUnicodePropertyTableIsDoubleWidth(const iTermUnicodePropertyTable *table,
+                                                      UTF32Char codePoint,
+                                                      BOOL ambiguousIsDoubleWidth) {
+    const iTermUnicodeProperty properties = iTermUnicodePropertiesOfCodePoint(table, codePoint);
+    return ((properties & iTermUnicodePropertyFullWidth) ||
+            (ambiguousIsDoubleWidth && (properties & iTermUnicodePropertyAmbiguousWidth)));
+}
+
+NS_ASSUME_NONNULL_END
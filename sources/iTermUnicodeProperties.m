@@ -0,0 +1,87 @@
+//
+//  iTermUnicodeProperties.m
+//  iTerm2SharedARC
+//
+//  Created by agent on 10/14/26.
+//
+
+#import "iTermUnicodeProperties.h"
+
+#import "NSCharacterSet+iTerm.h"
+
+// Shared by every block with no properties at all, which is most of them.
+static const uint8_t iTermUnicodePropertyEmptyBlock[256];
+
+const iTermUnicodePropertyTable *iTermUnicodePropertyTableForVersion(NSInteger version) {
+    // The width tables are the only ones that depend on the version, and they only distinguish
+    // versions before 9 from the rest.
+    static iTermUnicodePropertyTable *tables[2];
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        for (int i = 0; i < 2; i++) {
+            tables[i] = calloc(1, sizeof(iTermUnicodePropertyTable));
+            tables[i]->unicodeVersion = (i == 0) ? 8 : 9;
+        }
+    });
+    return tables[version >= 9 ? 1 : 0];
+}
+
+const uint8_t *iTermUnicodePropertyTableFillBlock(iTermUnicodePropertyTable *table, UTF32Char block) {
+    const NSInteger version = table->unicodeVersion;
+    NSCharacterSet *fullWidth = [NSCharacterSet fullWidthCharacterSetForUnicodeVersion:version];
+    NSCharacterSet *ambiguousWidth = [NSCharacterSet ambiguousWidthCharacterSetForUnicodeVersion:version];
+    NSCharacterSet *ignorable = [NSCharacterSet ignorableCharactersForUnicodeVersion:version];
+    NSCharacterSet *spacingCombiningMarks = [NSCharacterSet spacingCombiningMarksForUnicodeVersion:12];
+    NSCharacterSet *emojiPresentation = [NSCharacterSet emojiWithDefaultEmojiPresentation];
+    NSCharacterSet *textPresentation = [NSCharacterSet emojiWithDefaultTextPresentation];
+
+    uint8_t properties[256];
+    BOOL empty = YES;
+    for (int i = 0; i < 256; i++) {
+        const UTF32Char c = (block << 8) | i;
+        uint8_t p = 0;
+        // Matches the shortcut in +[NSString isDoubleWidthCharacter:ambiguousIsDoubleWidth:unicodeVersion:].
+        const BOOL obviouslyNarrow = (c <= 0xa0 || (c > 0x452 && c < 0x1100));
+        if (!obviouslyNarrow && [fullWidth longCharacterIsMember:c]) {
+            p |= iTermUnicodePropertyFullWidth;
+        }
+        if (!obviouslyNarrow && [ambiguousWidth longCharacterIsMember:c]) {
+            p |= iTermUnicodePropertyAmbiguousWidth;
+        }
+        if ([ignorable longCharacterIsMember:c]) {
+            p |= iTermUnicodePropertyIgnorable;
+        }
+        if ([spacingCombiningMarks longCharacterIsMember:c]) {
+            p |= iTermUnicodePropertySpacingCombiningMark;
+        }
+        if ([emojiPresentation longCharacterIsMember:c]) {
+            p |= iTermUnicodePropertyEmojiPresentation;
+        }
+        if ([textPresentation longCharacterIsMember:c]) {
+            p |= iTermUnicodePropertyTextPresentation;
+        }
+        properties[i] = p;
+        empty = empty && (p == 0);
+    }
+
+    const uint8_t *filled = iTermUnicodePropertyEmptyBlock;
+    if (!empty) {
+        uint8_t *copy = malloc(sizeof(properties));
+        memcpy(copy, properties, sizeof(properties));
+        filled = copy;
+    }
+    // Another thread may have filled the same block in the meantime. Its copy is just as good.
+    const uint8_t *expected = NULL;
+    if (!__atomic_compare_exchange_n(&table->blocks[block],
+                                     &expected,
+                                     filled,
+                                     false,
+                                     __ATOMIC_ACQ_REL,
+                                     __ATOMIC_ACQUIRE)) {
+        if (filled != iTermUnicodePropertyEmptyBlock) {
+            free((void *)filled);
+        }
+        return expected;
+    }
+    return filled;
+}
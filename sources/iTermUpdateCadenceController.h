@@ -20,6 +20,13 @@ typedef struct {
     NSInteger adaptiveFrameRateThroughputThreshold;
     double slowFrameRate;
     BOOL liveResizing;
+    // No part of the window is on screen (e.g., covered or on an inactive Space).
+    BOOL occluded;
+    // The session is the one the user is typing into.
+    BOOL focused;
+    // The session is receiving so much output that it should redraw at floodFrameRate.
+    BOOL flooded;
+    double floodFrameRate;
 } iTermUpdateCadenceState;
 
 @protocol iTermUpdateCadenceControllerDelegate<NSObject>
@@ -34,6 +41,10 @@ typedef struct {
 
 - (BOOL)updateCadenceControllerWindowHasSheet;
 
+// The screen the session is on. Used to synchronize updates with its refresh when the display
+// link update cadence is enabled.
+- (NSScreen *)updateCadenceControllerScreen;
+
 @end
 
 @interface iTermUpdateCadenceController : NSObject
@@ -11,9 +11,12 @@
 #import "DebugLogging.h"
 #import "NSTimer+iTerm.h"
 #import "iTermAdvancedSettingsModel.h"
+#import "iTermDisplayLinkTimer.h"
 #import "iTermHistogram.h"
+#import "iTermSignposts.h"
 #import "iTermThroughputEstimator.h"
 #import "iTermWarning.h"
+#import "iTermWindowOcclusionChangeMonitor.h"
 
 // Timer period between updates when adaptive frame rate is enabled and throughput is low but not 0.
 static const NSTimeInterval kFastUpdateCadence = 1.0 / 60.0;
@@ -23,6 +26,16 @@ static const NSTimeInterval kFastUpdateCadence = 1.0 / 60.0;
 // TODO(georgen): There's room for improvement here.
 static const NSTimeInterval kBackgroundUpdateCadence = 1;
 
+// Visible sessions that aren't focused share a frame budget (see
+// +unfocusedSessionsFrameBudget) so a window full of busy splits can't starve the focused one.
+static NSHashTable<iTermUpdateCadenceController *> *iTermUpdateCadenceControllerUnfocusedControllers(void) {
+    static NSHashTable *table;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        table = [NSHashTable weakObjectsHashTable];
+    });
+    return table;
+}
 
 @implementation iTermUpdateCadenceController {
     BOOL _useGCDUpdateTimer;
@@ -32,6 +45,10 @@ static const NSTimeInterval kBackgroundUpdateCadence = 1;
 
     // This is the experimental GCD version of the update timer that seems to have more regular refreshes.
     dispatch_source_t _gcdUpdateTimer;
+
+    // When set, updates are driven by the refresh of the session's screen instead of a timer.
+    BOOL _useDisplayLink;
+    iTermDisplayLinkTimer *_displayLinkTimer;
     NSTimeInterval _cadence;
 
     BOOL _deferredCadenceChange;
@@ -44,12 +61,16 @@ static const NSTimeInterval kBackgroundUpdateCadence = 1;
     NSTimeInterval _activeUpdateCadence;
 
     CFTimeInterval _lastKeystrokeTime;
+
+    // Cached value of +[iTermAdvancedSettingsModel visibilityAwareUpdateCadence].
+    BOOL _visibilityAware;
 }
 
 - (instancetype)initWithThroughputEstimator:(iTermThroughputEstimator *)throughputEstimator {
     self = [super init];
     if (self) {
         _useGCDUpdateTimer = [iTermAdvancedSettingsModel useGCDUpdateTimer];
+        _useDisplayLink = [iTermAdvancedSettingsModel useDisplayLinkUpdateCadence];
         _throughputEstimator = throughputEstimator;
         _histogram = [[iTermHistogram alloc] init];
         _activeUpdateCadence = 1.0 / MAX(1, [iTermAdvancedSettingsModel activeUpdateCadence]);
@@ -57,6 +78,19 @@ static const NSTimeInterval kBackgroundUpdateCadence = 1;
                                                  selector:@selector(applicationDidBecomeActive:)
                                                      name:NSApplicationDidBecomeActiveNotification
                                                    object:nil];
+        _visibilityAware = [iTermAdvancedSettingsModel visibilityAwareUpdateCadence];
+        if (_visibilityAware) {
+            [iTermWindowOcclusionChangeMonitor sharedInstance];
+            for (NSNotificationName name in @[ iTermWindowOcclusionDidChange,
+                                               NSWindowDidBecomeKeyNotification,
+                                               NSWindowDidResignKeyNotification,
+                                               NSApplicationDidResignActiveNotification ]) {
+                [[NSNotificationCenter defaultCenter] addObserver:self
+                                                         selector:@selector(visibilityDidChange:)
+                                                             name:name
+                                                           object:nil];
+            }
+        }
     }
     return self;
 }
@@ -67,6 +101,7 @@ static const NSTimeInterval kBackgroundUpdateCadence = 1;
         dispatch_source_cancel(_gcdUpdateTimer);
     }
     [_updateTimer invalidate];
+    [_displayLinkTimer invalidate];
 }
 
 - (NSString *)description {
@@ -97,6 +132,11 @@ static const NSTimeInterval kBackgroundUpdateCadence = 1;
 
 - (void)didHandleKeystroke {
     _lastKeystrokeTime = CACurrentMediaTime();
+    if (_displayLinkTimer) {
+        // Go to the display's maximum rate until typing stops so the echo is drawn on the next
+        // refresh. -displayLinkTimerDidFire: restores the normal rate.
+        _displayLinkTimer.interval = 0;
+    }
 }
 
 - (void)willStartLiveResize {
@@ -106,7 +146,7 @@ static const NSTimeInterval kBackgroundUpdateCadence = 1;
 }
 
 - (void)liveResizeDidEnd {
-    if (_useGCDUpdateTimer) {
+    if (_useDisplayLink || _useGCDUpdateTimer) {
         NSTimeInterval cadence = _cadence;
         _cadence = 0;
         [self setUpdateCadence:cadence liveResizing:NO force:NO];
@@ -145,6 +185,7 @@ static const NSTimeInterval kBackgroundUpdateCadence = 1;
     // idle means no input has been received on the PTY in a while (3 seconds by default).
     // assignment to self.isActive is used to update whether Metal is in use, when it's disabled while idle.
     self.isActive = (state.active || !state.idle);
+    [self updateBudgetMembershipWithState:state];
 
     if (!self.isActive) {
         // Periodic redraws not needed (i.e., nothing is blinking) and the session is idle. It doesn't matter
@@ -162,10 +203,27 @@ static const NSTimeInterval kBackgroundUpdateCadence = 1;
         return;
     }
 
+    if (_visibilityAware && state.occluded) {
+        // It's in the visible tab but nobody can see the window.
+        DLog(@"select background update cadence because the window is occluded");
+        [self setUpdateCadence:kBackgroundUpdateCadence liveResizing:state.liveResizing force:force];
+        return;
+    }
+
+    if (state.flooded) {
+        DLog(@"select flood mode frame rate");
+        [self setUpdateCadence:[self budgetedCadence:1.0 / MAX(1, state.floodFrameRate)]
+                  liveResizing:state.liveResizing
+                         force:force];
+        return;
+    }
+
     if (!state.useAdaptiveFrameRate) {
         // The session is visible and self.active is true (it needs redraws or it's not idle).
         DLog(@"select active update cadence");
-        [self setUpdateCadence:_activeUpdateCadence liveResizing:state.liveResizing force:force];
+        [self setUpdateCadence:[self budgetedCadence:_activeUpdateCadence]
+                  liveResizing:state.liveResizing
+                         force:force];
     }
 
     // Adaptive framerate path - the session is active and visible
@@ -173,15 +231,55 @@ static const NSTimeInterval kBackgroundUpdateCadence = 1;
     const NSInteger estimatedThroughput = [_throughputEstimator estimatedThroughput];
     if (estimatedThroughput < kThroughputLimit && estimatedThroughput > 0) {
         DLog(@"select fast cadence");
-        [self setUpdateCadence:kFastUpdateCadence liveResizing:state.liveResizing force:force];
+        [self setUpdateCadence:[self budgetedCadence:kFastUpdateCadence]
+                  liveResizing:state.liveResizing
+                         force:force];
     } else {
         DLog(@"select slow frame rate");
-        [self setUpdateCadence:1.0 / state.slowFrameRate liveResizing:state.liveResizing force:force];
+        [self setUpdateCadence:[self budgetedCadence:1.0 / state.slowFrameRate]
+                  liveResizing:state.liveResizing
+                         force:force];
+    }
+}
+
+- (void)updateBudgetMembershipWithState:(iTermUpdateCadenceState)state {
+    if (!_visibilityAware) {
+        return;
+    }
+    NSHashTable<iTermUpdateCadenceController *> *table = iTermUpdateCadenceControllerUnfocusedControllers();
+    const BOOL shouldBeMember = (self.isActive && state.visible && !state.occluded && !state.focused);
+    if (shouldBeMember == [table containsObject:self]) {
+        return;
+    }
+    if (shouldBeMember) {
+        [table addObject:self];
+    } else {
+        [table removeObject:self];
+    }
+    DLog(@"%@ budget membership changed to %@. Now %@ unfocused sessions share the budget.",
+         self, @(shouldBeMember), @(table.count));
+    // Everyone else's share changed.
+    for (iTermUpdateCadenceController *other in [table allObjects]) {
+        if (other != self) {
+            [other changeCadenceIfNeeded];
+        }
+    }
+}
+
+// Unfocused sessions split the budget evenly. The focused session is never throttled.
+- (NSTimeInterval)budgetedCadence:(NSTimeInterval)cadence {
+    NSHashTable<iTermUpdateCadenceController *> *table = iTermUpdateCadenceControllerUnfocusedControllers();
+    if (!_visibilityAware || ![table containsObject:self]) {
+        return cadence;
     }
+    const double budget = MAX(1, [iTermAdvancedSettingsModel unfocusedSessionsFrameBudget]);
+    return MAX(cadence, table.count / budget);
 }
 
 - (void)setUpdateCadence:(NSTimeInterval)cadence liveResizing:(BOOL)liveResizing force:(BOOL)force {
-    if (_useGCDUpdateTimer) {
+    if (_useDisplayLink) {
+        [self setDisplayLinkUpdateCadence:cadence liveResizing:liveResizing force:force];
+    } else if (_useGCDUpdateTimer) {
         [self setGCDUpdateCadence:cadence liveResizing:liveResizing force:force];
     } else {
         [self setTimerUpdateCadence:cadence liveResizing:liveResizing force:force];
@@ -258,8 +356,55 @@ static const NSTimeInterval kBackgroundUpdateCadence = 1;
     dispatch_resume(_gcdUpdateTimer);
 }
 
+- (void)setDisplayLinkUpdateCadence:(NSTimeInterval)cadence liveResizing:(BOOL)liveResizing force:(BOOL)force {
+    // Do this even if the cadence doesn't change since the window may have moved to another screen.
+    _displayLinkTimer.screen = [_delegate updateCadenceControllerScreen];
+
+    const NSTimeInterval period = liveResizing ? _activeUpdateCadence : cadence;
+    if (_displayLinkTimer && _cadence == period) {
+        DLog(@"No change to cadence: %@", self);
+        return;
+    }
+    DLog(@"Set cadence of %@ to %f", self, cadence);
+
+    if (!force && _cadence > 0 && cadence > _cadence) {
+        // See the comment in -setGCDUpdateCadence:liveResizing:force:.
+        DLog(@"Defer cadence change");
+        _deferredCadenceChange = YES;
+        return;
+    }
+
+    _cadence = period;
+    if (!_displayLinkTimer) {
+        _displayLinkTimer = [[iTermDisplayLinkTimer alloc] initWithInterval:0
+                                                                     target:self
+                                                                   selector:@selector(displayLinkTimerDidFire:)];
+        _displayLinkTimer.screen = [_delegate updateCadenceControllerScreen];
+    }
+    _displayLinkTimer.interval = [self lastKeystrokeWasRecent] ? 0 : [self displayLinkIntervalForCadence:period];
+}
+
+// The fast cadences stand in for "as fast as possible", which for a display link is every refresh.
+// On a variable refresh rate display that's up to 120Hz; slower cadences skip refreshes.
+- (NSTimeInterval)displayLinkIntervalForCadence:(NSTimeInterval)cadence {
+    if (cadence <= kFastUpdateCadence) {
+        return 0;
+    }
+    return cadence;
+}
+
+- (void)displayLinkTimerDidFire:(iTermDisplayLinkTimer *)timer {
+    if (timer.interval == 0 && ![self lastKeystrokeWasRecent]) {
+        timer.interval = [self displayLinkIntervalForCadence:_cadence];
+    }
+    DLog(@"Display link cadence timer fired for %@", self);
+    [self maybeUpdateDisplay];
+}
+
 - (BOOL)updateTimerIsValid {
-    if (_useGCDUpdateTimer) {
+    if (_useDisplayLink) {
+        return _displayLinkTimer != nil;
+    } else if (_useGCDUpdateTimer) {
         return _gcdUpdateTimer != nil;
     } else {
         return _updateTimer.isValid;
@@ -284,7 +429,15 @@ static const NSTimeInterval kBackgroundUpdateCadence = 1;
         [_histogram addValue:ms];
     }
     _lastUpdate = now;
+    os_log_t signpostLog = iTermSignpostLog();
+    const os_signpost_id_t spid = os_signpost_id_generate(signpostLog);
+    os_signpost_interval_begin(signpostLog, spid, "UpdateDisplay", "keystroke=%llu", iTermSignpostCurrentKeystroke());
     [_delegate updateCadenceControllerUpdateDisplay:self];
+    os_signpost_interval_end(signpostLog, spid, "UpdateDisplay");
+}
+
+- (void)visibilityDidChange:(NSNotification *)notification {
+    [self changeCadenceIfNeeded];
 }
 
 - (void)applicationDidBecomeActive:(NSNotification *)notification {
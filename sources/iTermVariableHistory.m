@@ -78,6 +78,7 @@
                                     iTermVariableKeySessionSelection,
                                     iTermVariableKeySessionSelectionLength,
                                     iTermVariableKeySessionBellCount,
+                                    iTermVariableKeySessionMemoryUsage,
                                     iTermVariableKeySessionLogFilename,
                                     iTermVariableKeySessionMouseInfo];
     [names enumerateObjectsUsingBlock:^(NSString * _Nonnull obj, NSUInteger idx, BOOL * _Nonnull stop) {
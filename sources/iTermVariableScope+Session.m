@@ -310,6 +310,14 @@
     [self setValue:bellCount forVariableNamed:iTermVariableKeySessionBellCount];
 }
 
+- (NSNumber *)memoryUsage {
+    return [self valueForVariableName:iTermVariableKeySessionMemoryUsage];
+}
+
+- (void)setMemoryUsage:(NSNumber *)memoryUsage {
+    [self setValue:memoryUsage forVariableNamed:iTermVariableKeySessionMemoryUsage];
+}
+
 - (NSNumber *)showingAlternateScreen {
     return [self valueForVariableName:iTermVariableKeySessionShowingAlternateScreen];
 }
@@ -8,6 +8,7 @@
 #import "iTermVariableScope.h"
 
 #import "DebugLogging.h"
+#import "iTermAdvancedSettingsModel.h"
 #import "iTermObject.h"
 #import "iTermTuple.h"
 #import "iTermVariableReference.h"
@@ -57,8 +58,46 @@ NS_ASSUME_NONNULL_BEGIN
 
 @end
 
+// The result of -ownerForKey:forWriting:NO stripped: for one key.
+@interface iTermVariableScopeLookup : NSObject {
+@public
+    iTermVariables *_owner;
+    NSString *_stripped;
+    // If set, the owner is an anonymous frame that was chosen because it had a value for this name.
+    NSString *_presentName;
+}
+@end
+
+@implementation iTermVariableScopeLookup
+@end
+
+// Lookups depend on the frames and on which names the anonymous frames have a value for. Scopes
+// with the same frames share a cache. When a scope's frames change it gets a new cache, and
+// entries are discarded whenever a name is added to or removed from any iTermVariables.
+@interface iTermVariableScopeLookupCache : NSObject {
+@public
+    NSMutableDictionary<NSString *, iTermVariableScopeLookup *> *_lookups;
+    NSUInteger _generation;
+}
+@end
+
+@implementation iTermVariableScopeLookupCache
+
+- (instancetype)init {
+    self = [super init];
+    if (self) {
+        _lookups = [NSMutableDictionary dictionary];
+        _generation = iTermVariablesNamesGeneration;
+    }
+    return self;
+}
+
+@end
+
 @implementation iTermVariableScope {
     NSMutableArray<iTermTuple<NSString *, iTermVariables *> *> *_frames;
+    // Main thread only. Nil until first used and after frames change.
+    iTermVariableScopeLookupCache *_lookupCache;
     // References to paths without an owner. This normally only happens when a session is being
     // shut down (e.g, tab.currentSession is assigned to nil)
     NSPointerArray *_danglingReferences;
@@ -79,10 +118,12 @@ NS_ASSUME_NONNULL_BEGIN
 
 - (void)addVariables:(iTermVariables *)variables toScopeNamed:(nullable NSString *)scopeName {
     [_frames insertObject:[iTermTuple tupleWithObject:scopeName andObject:variables] atIndex:0];
+    _lookupCache = nil;
     [self resolveDanglingReferences];
 }
 
 - (void)removeFrameWithName:(NSString *)name {
+    _lookupCache = nil;
     [_frames removeObjectsPassingTest:^BOOL(iTermTuple<NSString *,iTermVariables *> *obj) {
         return [obj.firstObject isEqual:name];
     }];
@@ -135,6 +176,50 @@ NS_ASSUME_NONNULL_BEGIN
 }
 
 - (nullable iTermVariables *)ownerForKey:(NSString *)key forWriting:(BOOL)forWriting stripped:(out NSString **)stripped {
+    if (forWriting || ![iTermAdvancedSettingsModel cacheVariableScopeLookups] || ![NSThread isMainThread]) {
+        return [self uncachedOwnerForKey:key forWriting:forWriting stripped:stripped];
+    }
+    iTermVariableScopeLookupCache *cache = [self lookupCache];
+    if (cache->_generation != iTermVariablesNamesGeneration) {
+        [cache->_lookups removeAllObjects];
+        cache->_generation = iTermVariablesNamesGeneration;
+    }
+    iTermVariableScopeLookup *lookup = cache->_lookups[key];
+    // A weakly held value can go away without its name being removed, so check that it's still there.
+    if (!lookup || (lookup->_presentName && ![lookup->_owner valueForVariableName:lookup->_presentName])) {
+        lookup = [[iTermVariableScopeLookup alloc] init];
+        NSString *uncachedStripped = nil;
+        lookup->_owner = [self uncachedOwnerForKey:key forWriting:NO stripped:&uncachedStripped];
+        lookup->_stripped = uncachedStripped;
+        NSString *firstName = [key componentsSeparatedByString:@"."].firstObject;
+        if (lookup->_owner &&
+            [self ownerIsAnonymousFrame:lookup->_owner] &&
+            [lookup->_owner valueForVariableName:firstName]) {
+            lookup->_presentName = firstName;
+        }
+        cache->_lookups[key] = lookup;
+    }
+    *stripped = lookup->_stripped;
+    return lookup->_owner;
+}
+
+- (iTermVariableScopeLookupCache *)lookupCache {
+    if (!_lookupCache) {
+        _lookupCache = [[iTermVariableScopeLookupCache alloc] init];
+    }
+    return _lookupCache;
+}
+
+- (BOOL)ownerIsAnonymousFrame:(iTermVariables *)owner {
+    for (iTermTuple<NSString *,iTermVariables *> *tuple in _frames) {
+        if (tuple.secondObject == owner && tuple.firstObject == nil) {
+            return YES;
+        }
+    }
+    return NO;
+}
+
+- (nullable iTermVariables *)uncachedOwnerForKey:(NSString *)key forWriting:(BOOL)forWriting stripped:(out NSString **)stripped {
     NSArray<NSString *> *parts = [key componentsSeparatedByString:@"."];
     if (parts.count == 0) {
         return nil;
@@ -310,6 +395,10 @@ NS_ASSUME_NONNULL_BEGIN
     [_frames enumerateObjectsUsingBlock:^(iTermTuple<NSString *,iTermVariables *> * _Nonnull tuple, NSUInteger idx, BOOL * _Nonnull stop) {
         [theCopy addVariables:tuple.secondObject toScopeNamed:tuple.firstObject];
     }];
+    if ([NSThread isMainThread]) {
+        // Recording copies are made for every evaluation so they'd never benefit from a cache of their own.
+        theCopy->_lookupCache = [self lookupCache];
+    }
     return theCopy;
 }
 
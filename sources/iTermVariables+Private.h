@@ -9,6 +9,9 @@
 
 @protocol iTermVariableReference;
 
+// Incremented whenever a name is added to or removed from any iTermVariables. Main thread only.
+extern NSUInteger iTermVariablesNamesGeneration;
+
 @interface iTermVariables(Private)
 
 - (NSDictionary<NSString *, NSString *> *)stringValuedDictionaryInScope:(nullable NSString *)scopeName;
@@ -69,6 +69,7 @@ extern NSString *const iTermVariableKeySessionSelection;  // NSString. Containin
 extern NSString *const iTermVariableKeySessionSelectionLength;  // NSNumber. Contains length of selected text.
 extern NSString *const iTermVariableKeySessionParent;  // Session that was active when this one was created, if any.
 extern NSString *const iTermVariableKeySessionBellCount;  // NSNumber. Number of times the bell has tried to ring.
+extern NSString *const iTermVariableKeySessionMemoryUsage;  // NSNumber. Approximate bytes used by the session.
 extern NSString *const iTermVariableKeySessionLogFilename;  // NSString. Path to log file. Unset if not logging.
 extern NSString *const iTermVariableKeySessionMouseInfo;  // [x=NSNumber, y=NSNumber, button=NSNumber, count=NSNumber, modifiers=NSNumber, sideEffects=NSNumber, state=NSNumber]. Info about last lcick.
 
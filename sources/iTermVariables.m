@@ -8,6 +8,7 @@
 #import "iTermVariables.h"
 
 #import "DebugLogging.h"
+#import "iTermAPIResponseCache.h"
 #import "iTermTuple.h"
 #import "iTermVariableReference.h"
 #import "iTermVariablesIndex.h"
@@ -22,6 +23,8 @@ NS_ASSUME_NONNULL_BEGIN
 
 typedef iTermTriple<NSNumber *, iTermVariables *, NSString *> iTermVariablesDepthOwnerNamesTriple;
 
+NSUInteger iTermVariablesNamesGeneration;
+
 NSString *const iTermVariableKeyGlobalScopeName = @"iterm2";
 
 #pragma mark - Global Context
@@ -82,6 +85,7 @@ NSString *const iTermVariableKeySessionSelection = @"selection";
 NSString *const iTermVariableKeySessionSelectionLength = @"selectionLength";
 NSString *const iTermVariableKeySessionParent = @"parentSession";
 NSString *const iTermVariableKeySessionBellCount = @"bellCount";
+NSString *const iTermVariableKeySessionMemoryUsage = @"memoryUsage";
 NSString *const iTermVariableKeySessionLogFilename = @"logFilename";
 NSString *const iTermVariableKeySessionTmuxWindowPaneIndex = @"tmuxWindowPaneIndex";
 NSString *const iTermVariableKeySessionMouseInfo = @"mouseInfo";
@@ -405,11 +409,15 @@ NSString *const iTermVariableKeyWindowNumber = @"number";
     if (!changed) {
         return self;
     }
+    [iTermAPIResponseCache invalidate];
     iTermVariables *child = [iTermVariables castFrom:value];
     if (child && !weak) {
         child->_parentName = [name copy];
         child->_parent = self;
     }
+    if (!_values[name] || !value || [NSNull castFrom:value]) {
+        iTermVariablesNamesGeneration += 1;
+    }
     if (value && ![NSNull castFrom:value]) {
         if ([value isKindOfClass:[iTermVariables class]]) {
             if (weak) {
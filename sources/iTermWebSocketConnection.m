@@ -8,6 +8,7 @@
 
 #import "iTermWebSocketConnection.h"
 #import "DebugLogging.h"
+#import "iTermAdvancedSettingsModel.h"
 #import "iTermAPIConnectionIdentifierController.h"
 #import "iTermHTTPConnection.h"
 #import "iTermWebSocketCookieJar.h"
@@ -16,9 +17,15 @@
 #import "NSData+iTerm.h"
 
 #import <CommonCrypto/CommonDigest.h>
+#import <zlib.h>
 
 static NSString *const kProtocolName = @"api.iterm2.com";
 static const NSInteger kWebSocketVersion = 13;
+static NSString *const iTermWebSocketConnectionPerMessageDeflate = @"permessage-deflate";
+// Smaller messages aren't worth the time to compress.
+static const NSUInteger iTermWebSocketConnectionMinimumCompressedMessageLength = 4096;
+// Refuse to inflate a message beyond this size so a malicious client can't exhaust memory.
+static const NSUInteger iTermWebSocketConnectionMaximumInflatedMessageLength = 256 * 1024 * 1024;
 NSString *const iTermWebSocketConnectionLibraryVersionTooOldString = @"Library version too old";
 
 // SEE ALSO iTermMinimumPythonEnvironmentVersion
@@ -45,6 +52,32 @@ typedef NS_ENUM(NSUInteger, iTermWebSocketConnectionState) {
     dispatch_queue_t _queue;
     iTermWebSocketFrameBuilder *_frameBuilder;
     dispatch_io_t _channel;
+    // Negotiated permessage-deflate (RFC 7692) without context takeover, so each message is
+    // compressed independently.
+    BOOL _perMessageDeflate;
+}
+
+// The client's Sec-WebSocket-Extensions header lists offers separated by commas. Only offers that
+// leave the server's window size at its default are accepted.
++ (BOOL)headerOffersPerMessageDeflate:(NSString *)header {
+    for (NSString *offer in [header componentsSeparatedByString:@","]) {
+        NSArray<NSString *> *parts = [offer componentsSeparatedByString:@";"];
+        NSString *name = [parts.firstObject stringByTrimmingCharactersInSet:[NSCharacterSet whitespaceCharacterSet]];
+        if ([name caseInsensitiveCompare:iTermWebSocketConnectionPerMessageDeflate] != NSOrderedSame) {
+            continue;
+        }
+        BOOL acceptable = YES;
+        for (NSString *param in [parts subarrayWithRange:NSMakeRange(1, parts.count - 1)]) {
+            if ([param rangeOfString:@"server_max_window_bits"].location != NSNotFound) {
+                acceptable = NO;
+                break;
+            }
+        }
+        if (acceptable) {
+            return YES;
+        }
+    }
+    return NO;
 }
 
 + (instancetype)newWebSocketConnectionForRequest:(NSURLRequest *)request
@@ -148,6 +181,8 @@ typedef NS_ENUM(NSUInteger, iTermWebSocketConnectionState) {
         NSString *key = headers[@"x-iterm2-key"] ?: [[NSUUID UUID] UUIDString];
         conn->_key = [[iTermAPIConnectionIdentifierController sharedInstance] identifierForKey:key];
         conn->_advisoryName = headers[@"x-iterm2-advisory-name"];
+        conn->_perMessageDeflate = ([iTermAdvancedSettingsModel compressLargeAPIMessages] &&
+                                    [self headerOffersPerMessageDeflate:headers[@"sec-websocket-extensions"]]);
     }
     return conn;
 }
@@ -259,6 +294,14 @@ typedef NS_ENUM(NSUInteger, iTermWebSocketConnectionState) {
 // queue
 - (void)reallySendBinary:(NSData *)binaryData {
     if (_state == iTermWebSocketConnectionStateOpen) {
+        if (_perMessageDeflate && binaryData.length >= iTermWebSocketConnectionMinimumCompressedMessageLength) {
+            NSData *compressed = [self deflatedData:binaryData];
+            if (compressed) {
+                DLog(@"Sending compressed binary frame (%@ bytes → %@)", @(binaryData.length), @(compressed.length));
+                [self sendFrame:[iTermWebSocketFrame binaryFrameWithCompressedData:compressed]];
+                return;
+            }
+        }
         DLog(@"Sending binary frame");
         [self sendFrame:[iTermWebSocketFrame binaryFrameWithData:binaryData]];
     } else {
@@ -291,15 +334,28 @@ typedef NS_ENUM(NSUInteger, iTermWebSocketConnectionState) {
 // queue
 - (void)sendFrame:(iTermWebSocketFrame *)frame {
     DLog(@"Send frame %@", frame);
-    [self sendData:frame.data];
+    NSData *header = frame.header;
+    if (!header) {
+        return;
+    }
+    // The payload is written from where it already is rather than being copied in after the header.
+    dispatch_data_t dispatchData = [self newDispatchDataForData:header];
+    if (frame.payload.length) {
+        dispatchData = dispatch_data_create_concat(dispatchData, [self newDispatchDataForData:frame.payload]);
+    }
+    [self sendDispatchData:dispatchData];
 }
 
 // queue
-- (void)sendData:(NSData *)data {
-    dispatch_data_t dispatchData = dispatch_data_create(data.bytes, data.length, _queue, ^{
+- (dispatch_data_t)newDispatchDataForData:(NSData *)data {
+    return dispatch_data_create(data.bytes, data.length, _queue, ^{
         DLog(@"Disposing of data %p", data);
         [data length];  // Keep a reference to data
     });
+}
+
+// queue
+- (void)sendDispatchData:(dispatch_data_t)dispatchData {
 
     __weak __typeof(self) weakSelf = self;
     dispatch_io_write(_channel, 0, dispatchData, _queue, ^(bool done, dispatch_data_t  _Nullable data, int error) {
@@ -341,15 +397,20 @@ typedef NS_ENUM(NSUInteger, iTermWebSocketConnectionState) {
 // queue
 - (void)handleFrame:(iTermWebSocketFrame *)frame {
     DLog(@"Handle frame %@", frame);
+    if (frame.compressed &&
+        (!_perMessageDeflate ||
+         (frame.opcode != iTermWebSocketOpcodeBinary && frame.opcode != iTermWebSocketOpcodeText))) {
+        DLog(@"Unexpected RSV1 bit");
+        [self reallyAbort];
+        return;
+    }
     switch (frame.opcode) {
         case iTermWebSocketOpcodeBinary:
         case iTermWebSocketOpcodeText:
             if (_state == iTermWebSocketConnectionStateOpen) {
                 if (frame.fin) {
                     DLog(@"Pass finished frame to delegate");
-                    dispatch_async(self.delegateQueue, ^{
-                        [self.delegate webSocketConnection:self didReadFrame:frame];
-                    });
+                    [self passFrameToDelegate:frame];
                 } else if (_fragment == nil) {
                     DLog(@"Begin fragmented frame");
                     _fragment = frame;
@@ -388,9 +449,7 @@ typedef NS_ENUM(NSUInteger, iTermWebSocketConnectionState) {
                     DLog(@"Fragmented frame finished. Sending to delegate");
                     iTermWebSocketFrame *fragment = _fragment;
                     _fragment = nil;
-                    dispatch_async(self.delegateQueue, ^{
-                        [self.delegate webSocketConnection:self didReadFrame:fragment];
-                    });
+                    [self passFrameToDelegate:fragment];
                 }
             } else {
                 [self reallyAbort];
@@ -420,6 +479,91 @@ typedef NS_ENUM(NSUInteger, iTermWebSocketConnectionState) {
     }
 }
 
+// queue
+- (void)passFrameToDelegate:(iTermWebSocketFrame *)frame {
+    if (frame.compressed) {
+        NSData *payload = [self inflatedData:frame.payload];
+        if (!payload) {
+            DLog(@"Failed to inflate compressed frame %@", frame);
+            [self reallyAbort];
+            return;
+        }
+        [frame replaceCompressedPayloadWithPayload:payload];
+    }
+    dispatch_async(self.delegateQueue, ^{
+        [self.delegate webSocketConnection:self didReadFrame:frame];
+    });
+}
+
+// Without context takeover each message is a raw deflate stream ending in a sync flush, whose
+// trailing 00 00 ff ff is left off on the wire.
+// queue
+- (NSData *)deflatedData:(NSData *)data {
+    z_stream stream = { 0 };
+    if (deflateInit2(&stream, Z_BEST_SPEED, Z_DEFLATED, -MAX_WBITS, 8, Z_DEFAULT_STRATEGY) != Z_OK) {
+        return nil;
+    }
+    // Leave room for the sync flush's empty block, which deflateBound doesn't count.
+    NSMutableData *result = [NSMutableData dataWithLength:deflateBound(&stream, data.length) + 16];
+    stream.next_in = (Bytef *)data.bytes;
+    stream.avail_in = (uInt)data.length;
+    stream.next_out = result.mutableBytes;
+    stream.avail_out = (uInt)result.length;
+    const int status = deflate(&stream, Z_SYNC_FLUSH);
+    const uLong length = stream.total_out;
+    const BOOL complete = (stream.avail_in == 0 && stream.avail_out > 0);
+    deflateEnd(&stream);
+    if (status != Z_OK || !complete || length < 4) {
+        DLog(@"deflate failed with %@", @(status));
+        return nil;
+    }
+    const unsigned char *bytes = result.bytes;
+    if (memcmp(bytes + length - 4, "\x00\x00\xff\xff", 4) == 0) {
+        result.length = length - 4;
+    } else {
+        result.length = length;
+    }
+    if (result.length >= data.length) {
+        return nil;
+    }
+    return result;
+}
+
+// queue
+- (NSData *)inflatedData:(NSData *)data {
+    z_stream stream = { 0 };
+    if (inflateInit2(&stream, -MAX_WBITS) != Z_OK) {
+        return nil;
+    }
+    NSMutableData *input = [data mutableCopy];
+    [input appendBytes:"\x00\x00\xff\xff" length:4];
+    NSMutableData *result = [NSMutableData dataWithLength:MAX(input.length * 4, 4096)];
+    stream.next_in = input.mutableBytes;
+    stream.avail_in = (uInt)input.length;
+    int status = Z_OK;
+    while (status == Z_OK && (stream.avail_in > 0 || stream.avail_out == 0)) {
+        if (stream.total_out == result.length) {
+            if (result.length >= iTermWebSocketConnectionMaximumInflatedMessageLength) {
+                DLog(@"Inflated message too large");
+                status = Z_MEM_ERROR;
+                break;
+            }
+            result.length = result.length * 2;
+        }
+        stream.next_out = result.mutableBytes + stream.total_out;
+        stream.avail_out = (uInt)(result.length - stream.total_out);
+        status = inflate(&stream, Z_SYNC_FLUSH);
+    }
+    const uLong length = stream.total_out;
+    inflateEnd(&stream);
+    if (status != Z_OK && status != Z_STREAM_END) {
+        DLog(@"inflate failed with %@", @(status));
+        return nil;
+    }
+    result.length = length;
+    return result;
+}
+
 // Any queue
 - (void)closeWithCompletion:(void (^)(void))completion {
     dispatch_async(_queue, ^{
@@ -462,6 +606,11 @@ typedef NS_ENUM(NSUInteger, iTermWebSocketConnectionState) {
                @"Sec-WebSocket-Protocol": kProtocolName,
                @"X-iTerm2-Protocol-Version": @"1.9"
              };
+        if (_perMessageDeflate) {
+            NSMutableDictionary *temp = [headers mutableCopy];
+            temp[@"Sec-WebSocket-Extensions"] = [iTermWebSocketConnectionPerMessageDeflate stringByAppendingString:@"; server_no_context_takeover; client_no_context_takeover"];
+            headers = temp;
+        }
         if (version > kWebSocketVersion) {
             NSMutableDictionary *temp = [headers mutableCopy];
             temp[@"Sec-Websocket-Version"] = [@(kWebSocketVersion) stringValue];
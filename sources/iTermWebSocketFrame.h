@@ -46,6 +46,8 @@ typedef NS_ENUM(int, iTermWebSocketOpcode) {
 @property (nonatomic, readonly) NSData *payload;
 @property (nonatomic, readonly) NSString *text;
 @property (nonatomic, readonly) NSData *data;
+// RSV1, which permessage-deflate uses to mark the first frame of a compressed message.
+@property (nonatomic, readonly) BOOL compressed;
 
 + (instancetype)closeFrame;
 + (instancetype)closeFrameWithCode:(uint16_t)code reason:(NSString *)reason;
@@ -53,6 +55,8 @@ typedef NS_ENUM(int, iTermWebSocketOpcode) {
 + (instancetype)pongFrameForPingFrame:(iTermWebSocketFrame *)ping;
 + (instancetype)textFrameWithString:(NSString *)string;
 + (instancetype)binaryFrameWithData:(NSData *)data;
+// |data| must already be compressed with permessage-deflate.
++ (instancetype)binaryFrameWithCompressedData:(NSData *)data;
 + (instancetype)frameWithDataSource:(unsigned char *(^)(int64_t))dataSource;
 
 // Valid if opcode is ConnectionClose
@@ -61,4 +65,10 @@ typedef NS_ENUM(int, iTermWebSocketOpcode) {
 
 - (BOOL)appendFragment:(iTermWebSocketFrame *)fragment;
 
+// Everything in -data that precedes the payload. Lets the payload be written without copying it.
+- (NSData *)header;
+
+// Replaces a compressed payload with its decompressed form and clears the compressed flag.
+- (void)replaceCompressedPayloadWithPayload:(NSData *)payload;
+
 @end
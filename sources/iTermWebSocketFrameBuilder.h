@@ -11,5 +11,7 @@
 @class iTermWebSocketFrame;
 
 @interface iTermWebSocketFrameBuilder : NSObject
+// If |data| is mutable the builder may take ownership of it, so the caller must not modify it
+// afterwards.
 - (void)addData:(NSData *)data frame:(void (^)(iTermWebSocketFrame *, BOOL *))frameBlock;
 @end
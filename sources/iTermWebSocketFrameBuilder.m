@@ -23,11 +23,20 @@
 }
 
 - (void)addData:(NSData *)data frame:(void (^)(iTermWebSocketFrame *, BOOL *))frameBlock {
-    [_data appendData:data];
+    if (_data.length == 0 && [data isKindOfClass:[NSMutableData class]]) {
+        // Usually a read ends on a frame boundary, so adopt the buffer instead of copying it.
+        _data = (NSMutableData *)data;
+    } else {
+        [_data appendData:data];
+    }
 
+    // Consumed bytes are removed once at the end rather than after each frame, which would move
+    // the rest of the buffer for every frame.
     __block int64_t offset = 0;
+    int64_t consumed = 0;
     __block BOOL eof = NO;
     while (!eof) {
+        offset = consumed;
         iTermWebSocketFrame *frame = [iTermWebSocketFrame frameWithDataSource:^unsigned char *(int64_t bytesWanted) {
             if (self->_data.length < offset + bytesWanted) {
                 eof = YES;
@@ -39,14 +48,14 @@
             }
         }];
         if (!eof) {
-            [_data replaceBytesInRange:NSMakeRange(0, offset) withBytes:"" length:0];
-            offset = 0;
+            consumed = offset;
         }
         if (frame) {
             if (_fragment) {
                 if (![_fragment appendFragment:frame]) {
                     BOOL stop = NO;
                     frameBlock(NULL, &stop);
+                    [self removeBytes:consumed];
                     return;
                 }
                 if (_fragment.fin) {
@@ -54,6 +63,7 @@
                     frameBlock(_fragment, &stop);
                     _fragment = nil;
                     if (stop) {
+                        [self removeBytes:consumed];
                         return;
                     }
                 }
@@ -62,6 +72,7 @@
                     BOOL stop = NO;
                     frameBlock(frame, &stop);
                     if (stop) {
+                        [self removeBytes:consumed];
                         return;
                     }
                 } else {
@@ -70,6 +81,15 @@
             }
         }
     }
+    [self removeBytes:consumed];
+}
+
+- (void)removeBytes:(int64_t)count {
+    if (count == _data.length) {
+        _data = [[NSMutableData alloc] init];
+    } else if (count > 0) {
+        [_data replaceBytesInRange:NSMakeRange(0, count) withBytes:"" length:0];
+    }
 }
 
 @end
@@ -17,6 +17,11 @@ NS_ASSUME_NONNULL_BEGIN
 - (BOOL)workingDirectoryPollerShouldPoll;
 - (void)workingDirectoryPollerDidFindWorkingDirectory:(nullable NSString *)path invalidated:(BOOL)invalidated;
 - (pid_t)workingDirectoryPollerProcessID;
+
+@optional
+// Shell integration has reported the directory, so it doesn't need to be polled after each
+// keystroke. It is still polled when the foreground job changes.
+- (BOOL)workingDirectoryPollerHasPushedDirectory;
 @end
 
 @interface iTermWorkingDirectoryPoller : NSObject
@@ -24,6 +29,9 @@ NS_ASSUME_NONNULL_BEGIN
 @property (nonatomic, weak) id<iTermWorkingDirectoryPollerDelegate> delegate;
 @property (nonatomic, nullable, strong) iTermTmuxOptionMonitor *tmuxOptionMonitor;
 
+// Set this whenever the foreground job is known. A change makes the cached directory stale.
+@property (nonatomic) pid_t foregroundJobProcessID;
+
 - (instancetype)init NS_DESIGNATED_INITIALIZER;
 
 - (instancetype)initWithTmuxGateway:(TmuxGateway *)gateway
@@ -8,12 +8,110 @@
 #import "iTermWorkingDirectoryPoller.h"
 
 #import "DebugLogging.h"
+#import "iTermAdvancedSettingsModel.h"
 #import "iTermLSOF.h"
 #import "iTermRateLimitedUpdate.h"
 #import "iTermTmuxOptionMonitor.h"
 
 typedef void (^iTermWorkingDirectoryPollerClosure)(NSString * _Nullable);
 
+@interface iTermWorkingDirectoryCacheEntry : NSObject
+@property (nonatomic) NSInteger generation;
+// Nil while the lookup is outstanding.
+@property (nonatomic, copy) NSString *directory;
+@end
+
+@implementation iTermWorkingDirectoryCacheEntry
+@end
+
+// Remembers the working directory of each process until something happens that could change it.
+// Pollers whose sessions have the same process share lookups. Main thread only.
+@interface iTermWorkingDirectoryCache : NSObject
++ (instancetype)sharedInstance;
+- (void)invalidateProcessID:(pid_t)pid;
+- (void)getWorkingDirectoryOfProcess:(pid_t)pid completion:(iTermWorkingDirectoryPollerClosure)completion;
+@end
+
+@implementation iTermWorkingDirectoryCache {
+    NSMutableDictionary<NSNumber *, iTermWorkingDirectoryCacheEntry *> *_entries;
+    // Generation -> callers waiting on that lookup. A lookup outlives its entry's invalidation.
+    NSMutableDictionary<NSNumber *, NSMutableArray<iTermWorkingDirectoryPollerClosure> *> *_lookups;
+    NSInteger _nextGeneration;
+}
+
++ (instancetype)sharedInstance {
+    static id instance;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        instance = [[self alloc] init];
+    });
+    return instance;
+}
+
+- (instancetype)init {
+    self = [super init];
+    if (self) {
+        _entries = [NSMutableDictionary dictionary];
+        _lookups = [NSMutableDictionary dictionary];
+    }
+    return self;
+}
+
+- (void)invalidateProcessID:(pid_t)pid {
+    DLog(@"Invalidate cached directory of %@", @(pid));
+    [_entries removeObjectForKey:@(pid)];
+}
+
+- (void)getWorkingDirectoryOfProcess:(pid_t)pid completion:(iTermWorkingDirectoryPollerClosure)completion {
+    iTermWorkingDirectoryCacheEntry *entry = _entries[@(pid)];
+    if (entry.directory) {
+        DLog(@"Use cached directory for %@: %@", @(pid), entry.directory);
+        NSString *directory = entry.directory;
+        dispatch_async(dispatch_get_main_queue(), ^{
+            completion(directory);
+        });
+        return;
+    }
+    if (entry) {
+        DLog(@"Join outstanding lookup for %@", @(pid));
+        [_lookups[@(entry.generation)] addObject:[completion copy]];
+        return;
+    }
+    if (_entries.count > 256) {
+        // Entries for processes that went away are never invalidated.
+        [_entries removeAllObjects];
+    }
+    entry = [[iTermWorkingDirectoryCacheEntry alloc] init];
+    entry.generation = _nextGeneration++;
+    _entries[@(pid)] = entry;
+    const NSInteger generation = entry.generation;
+    _lookups[@(generation)] = [NSMutableArray arrayWithObject:[completion copy]];
+    __weak __typeof(self) weakSelf = self;
+    [iTermLSOF asyncWorkingDirectoryOfProcess:pid queue:dispatch_get_main_queue() block:^(NSString *pwd) {
+        [weakSelf didFindWorkingDirectory:pwd ofProcess:pid generation:generation];
+    }];
+}
+
+- (void)didFindWorkingDirectory:(NSString *)pwd ofProcess:(pid_t)pid generation:(NSInteger)generation {
+    NSArray<iTermWorkingDirectoryPollerClosure> *completions = _lookups[@(generation)] ?: @[];
+    [_lookups removeObjectForKey:@(generation)];
+    iTermWorkingDirectoryCacheEntry *entry = _entries[@(pid)];
+    if (entry.generation == generation) {
+        if (pwd) {
+            entry.directory = pwd;
+        } else {
+            [_entries removeObjectForKey:@(pid)];
+        }
+    }
+    // Callers of an invalidated lookup still get its result. Their pollers decide whether it's
+    // stale.
+    for (iTermWorkingDirectoryPollerClosure completion in completions) {
+        completion(pwd);
+    }
+}
+
+@end
+
 @implementation iTermWorkingDirectoryPoller {
     iTermRateLimitedUpdate *_pwdPollRateLimit;
     BOOL _okToPollForWorkingDirectoryChange;
@@ -23,6 +121,15 @@ typedef void (^iTermWorkingDirectoryPollerClosure)(NSString * _Nullable);
     NSMutableArray<iTermWorkingDirectoryPollerClosure> *_completions;
 }
 
++ (BOOL)tracksForegroundJob {
+    static BOOL enabled;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        enabled = [iTermAdvancedSettingsModel trackWorkingDirectoryByForegroundJob];
+    });
+    return enabled;
+}
+
 - (instancetype)init {
     self = [super init];
     if (self) {
@@ -62,6 +169,28 @@ typedef void (^iTermWorkingDirectoryPollerClosure)(NSString * _Nullable);
 }
 
 - (void)userDidPressKey {
+    if ([iTermWorkingDirectoryPoller tracksForegroundJob]) {
+        if ([self delegateHasPushedDirectory]) {
+            DLog(@"Ignore keypress because shell integration reports the directory");
+            return;
+        }
+        // The shell might be about to cd.
+        [self invalidateCachedDirectory];
+    }
+    _okToPollForWorkingDirectoryChange = YES;
+    [self pollIfNeeded];
+}
+
+- (void)setForegroundJobProcessID:(pid_t)foregroundJobProcessID {
+    if (foregroundJobProcessID == _foregroundJobProcessID) {
+        return;
+    }
+    DLog(@"Foreground job changed from %@ to %@", @(_foregroundJobProcessID), @(foregroundJobProcessID));
+    _foregroundJobProcessID = foregroundJobProcessID;
+    if (![iTermWorkingDirectoryPoller tracksForegroundJob]) {
+        return;
+    }
+    [self invalidateCachedDirectory];
     _okToPollForWorkingDirectoryChange = YES;
     [self pollIfNeeded];
 }
@@ -77,6 +206,18 @@ typedef void (^iTermWorkingDirectoryPollerClosure)(NSString * _Nullable);
 
 #pragma mark - Private
 
+- (BOOL)delegateHasPushedDirectory {
+    return ([self.delegate respondsToSelector:@selector(workingDirectoryPollerHasPushedDirectory)] &&
+            [self.delegate workingDirectoryPollerHasPushedDirectory]);
+}
+
+- (void)invalidateCachedDirectory {
+    const pid_t pid = [self.delegate workingDirectoryPollerProcessID];
+    if (pid != -1) {
+        [[iTermWorkingDirectoryCache sharedInstance] invalidateProcessID:pid];
+    }
+}
+
 - (void)pollIfNeeded {
     DLog(@"pollIfNeeded. wantsPoll=%@", @(_wantsPoll));
     if (_wantsPoll) {
@@ -113,6 +254,13 @@ typedef void (^iTermWorkingDirectoryPollerClosure)(NSString * _Nullable);
     }
     __weak __typeof(self) weakSelf = self;
     NSInteger generation = _generation;
+    if ([iTermWorkingDirectoryPoller tracksForegroundJob]) {
+        [[iTermWorkingDirectoryCache sharedInstance] getWorkingDirectoryOfProcess:pid completion:^(NSString *pwd) {
+            DLog(@"Got: %@", pwd);
+            [weakSelf setDirectory:pwd generation:generation];
+        }];
+        return;
+    }
     [iTermLSOF asyncWorkingDirectoryOfProcess:pid queue:dispatch_get_main_queue() block:^(NSString *pwd) {
         DLog(@"Got: %@", pwd);
         [weakSelf setDirectory:pwd generation:generation];
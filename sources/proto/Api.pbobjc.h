@@ -30,8 +30,11 @@ CF_EXTERN_C_BEGIN
 @class ITMActivateRequest;
 @class ITMActivateRequest_App;
 @class ITMActivateResponse;
+@class ITMBatchRequest;
+@class ITMBatchResponse;
 @class ITMBroadcastDomain;
 @class ITMBroadcastDomainsChangedNotification;
+@class ITMClientOriginatedMessage;
 @class ITMCloseRequest;
 @class ITMCloseRequest_CloseSessions;
 @class ITMCloseRequest_CloseTabs;
@@ -59,12 +62,18 @@ CF_EXTERN_C_BEGIN
 @class ITMGetBroadcastDomainsResponse;
 @class ITMGetBufferRequest;
 @class ITMGetBufferResponse;
+@class ITMGetPerformanceCountersRequest;
+@class ITMGetPerformanceCountersResponse;
+@class ITMGetPerformanceCountersResponse_Counter;
 @class ITMGetProfilePropertyRequest;
 @class ITMGetProfilePropertyResponse;
 @class ITMGetPromptRequest;
 @class ITMGetPromptResponse;
 @class ITMGetPropertyRequest;
 @class ITMGetPropertyResponse;
+@class ITMGetSystemMetricsRequest;
+@class ITMGetSystemMetricsResponse;
+@class ITMGetSystemMetricsResponse_NetworkThroughput;
 @class ITMInjectRequest;
 @class ITMInjectResponse;
 @class ITMInvokeFunctionRequest;
@@ -139,6 +148,8 @@ CF_EXTERN_C_BEGIN
 @class ITMRestartSessionResponse;
 @class ITMSavedArrangementRequest;
 @class ITMSavedArrangementResponse;
+@class ITMScreenUpdateLine;
+@class ITMScreenUpdateMonitorRequest;
 @class ITMScreenUpdateNotification;
 @class ITMSelection;
 @class ITMSelectionRequest;
@@ -149,6 +160,7 @@ CF_EXTERN_C_BEGIN
 @class ITMSelectionResponse_SetSelectionResponse;
 @class ITMSendTextRequest;
 @class ITMSendTextResponse;
+@class ITMServerOriginatedMessage;
 @class ITMServerOriginatedRPC;
 @class ITMServerOriginatedRPCNotification;
 @class ITMServerOriginatedRPCResultRequest;
@@ -193,6 +205,7 @@ CF_EXTERN_C_BEGIN
 @class ITMVariableRequest;
 @class ITMVariableRequest_Set;
 @class ITMVariableResponse;
+@class ITMVariableValuePredicate;
 @class ITMWindowedCoordRange;
 
 NS_ASSUME_NONNULL_BEGIN
@@ -1063,6 +1076,9 @@ typedef GPB_ENUM(ITMClientOriginatedMessage_FieldNumber) {
   ITMClientOriginatedMessage_FieldNumber_CloseRequest = 131,
   ITMClientOriginatedMessage_FieldNumber_InvokeFunctionRequest = 132,
   ITMClientOriginatedMessage_FieldNumber_ListPromptsRequest = 133,
+  ITMClientOriginatedMessage_FieldNumber_BatchRequest = 134,
+  ITMClientOriginatedMessage_FieldNumber_GetSystemMetricsRequest = 135,
+  ITMClientOriginatedMessage_FieldNumber_GetPerformanceCountersRequest = 136,
 };
 
 typedef GPB_ENUM(ITMClientOriginatedMessage_Submessage_OneOfCase) {
@@ -1101,6 +1117,9 @@ typedef GPB_ENUM(ITMClientOriginatedMessage_Submessage_OneOfCase) {
   ITMClientOriginatedMessage_Submessage_OneOfCase_CloseRequest = 131,
   ITMClientOriginatedMessage_Submessage_OneOfCase_InvokeFunctionRequest = 132,
   ITMClientOriginatedMessage_Submessage_OneOfCase_ListPromptsRequest = 133,
+  ITMClientOriginatedMessage_Submessage_OneOfCase_BatchRequest = 134,
+  ITMClientOriginatedMessage_Submessage_OneOfCase_GetSystemMetricsRequest = 135,
+  ITMClientOriginatedMessage_Submessage_OneOfCase_GetPerformanceCountersRequest = 136,
 };
 
 /**
@@ -1182,6 +1201,12 @@ typedef GPB_ENUM(ITMClientOriginatedMessage_Submessage_OneOfCase) {
 
 @property(nonatomic, readwrite, strong, null_resettable) ITMListPromptsRequest *listPromptsRequest;
 
+@property(nonatomic, readwrite, strong, null_resettable) ITMBatchRequest *batchRequest;
+
+@property(nonatomic, readwrite, strong, null_resettable) ITMGetSystemMetricsRequest *getSystemMetricsRequest;
+
+@property(nonatomic, readwrite, strong, null_resettable) ITMGetPerformanceCountersRequest *getPerformanceCountersRequest;
+
 @end
 
 /**
@@ -1228,6 +1253,9 @@ typedef GPB_ENUM(ITMServerOriginatedMessage_FieldNumber) {
   ITMServerOriginatedMessage_FieldNumber_CloseResponse = 131,
   ITMServerOriginatedMessage_FieldNumber_InvokeFunctionResponse = 132,
   ITMServerOriginatedMessage_FieldNumber_ListPromptsResponse = 133,
+  ITMServerOriginatedMessage_FieldNumber_BatchResponse = 134,
+  ITMServerOriginatedMessage_FieldNumber_GetSystemMetricsResponse = 135,
+  ITMServerOriginatedMessage_FieldNumber_GetPerformanceCountersResponse = 136,
   ITMServerOriginatedMessage_FieldNumber_Notification = 1000,
 };
 
@@ -1268,6 +1296,9 @@ typedef GPB_ENUM(ITMServerOriginatedMessage_Submessage_OneOfCase) {
   ITMServerOriginatedMessage_Submessage_OneOfCase_CloseResponse = 131,
   ITMServerOriginatedMessage_Submessage_OneOfCase_InvokeFunctionResponse = 132,
   ITMServerOriginatedMessage_Submessage_OneOfCase_ListPromptsResponse = 133,
+  ITMServerOriginatedMessage_Submessage_OneOfCase_BatchResponse = 134,
+  ITMServerOriginatedMessage_Submessage_OneOfCase_GetSystemMetricsResponse = 135,
+  ITMServerOriginatedMessage_Submessage_OneOfCase_GetPerformanceCountersResponse = 136,
   ITMServerOriginatedMessage_Submessage_OneOfCase_Notification = 1000,
 };
 
@@ -1354,6 +1385,12 @@ typedef GPB_ENUM(ITMServerOriginatedMessage_Submessage_OneOfCase) {
 
 @property(nonatomic, readwrite, strong, null_resettable) ITMListPromptsResponse *listPromptsResponse;
 
+@property(nonatomic, readwrite, strong, null_resettable) ITMBatchResponse *batchResponse;
+
+@property(nonatomic, readwrite, strong, null_resettable) ITMGetSystemMetricsResponse *getSystemMetricsResponse;
+
+@property(nonatomic, readwrite, strong, null_resettable) ITMGetPerformanceCountersResponse *getPerformanceCountersResponse;
+
 /** This is the only response that is sent spontaneously. The 'id' field will not be set. */
 @property(nonatomic, readwrite, strong, null_resettable) ITMNotification *notification;
 
@@ -3591,6 +3628,8 @@ typedef GPB_ENUM(ITMVariableMonitorRequest_FieldNumber) {
   ITMVariableMonitorRequest_FieldNumber_Name = 1,
   ITMVariableMonitorRequest_FieldNumber_Scope = 2,
   ITMVariableMonitorRequest_FieldNumber_Identifier = 3,
+  ITMVariableMonitorRequest_FieldNumber_CoalescingInterval = 4,
+  ITMVariableMonitorRequest_FieldNumber_Predicate = 5,
 };
 
 @interface ITMVariableMonitorRequest : GPBMessage
@@ -3607,6 +3646,42 @@ typedef GPB_ENUM(ITMVariableMonitorRequest_FieldNumber) {
 /** Test to see if @c identifier has been set. */
 @property(nonatomic, readwrite) BOOL hasIdentifier;
 
+/**
+ * If set, changes are coalesced so that at most one notification is sent per this many
+ * seconds. It has the latest value and is not sent if the value is the same as the last one
+ * reported.
+ **/
+@property(nonatomic, readwrite) double coalescingInterval;
+
+@property(nonatomic, readwrite) BOOL hasCoalescingInterval;
+/** If set, only changes whose new value satisfies the predicate are reported. */
+@property(nonatomic, readwrite, strong, null_resettable) ITMVariableValuePredicate *predicate;
+/** Test to see if @c predicate has been set. */
+@property(nonatomic, readwrite) BOOL hasPredicate;
+
+@end
+
+#pragma mark - ITMVariableValuePredicate
+
+typedef GPB_ENUM(ITMVariableValuePredicate_FieldNumber) {
+  ITMVariableValuePredicate_FieldNumber_Regex = 1,
+  ITMVariableValuePredicate_FieldNumber_MinimumChange = 2,
+};
+
+@interface ITMVariableValuePredicate : GPBMessage
+
+/**
+ * The new value must match this regular expression. Strings are matched as-is and other values
+ * as JSON.
+ **/
+@property(nonatomic, readwrite, copy, null_resettable) NSString *regex;
+/** Test to see if @c regex has been set. */
+@property(nonatomic, readwrite) BOOL hasRegex;
+
+/** A numeric value must differ from the last value reported by at least this much. */
+@property(nonatomic, readwrite) double minimumChange;
+
+@property(nonatomic, readwrite) BOOL hasMinimumChange;
 @end
 
 #pragma mark - ITMProfileChangeRequest
@@ -3638,6 +3713,32 @@ typedef GPB_ENUM(ITMPromptMonitorRequest_FieldNumber) {
 
 @end
 
+#pragma mark - ITMScreenUpdateMonitorRequest
+
+typedef GPB_ENUM(ITMScreenUpdateMonitorRequest_FieldNumber) {
+  ITMScreenUpdateMonitorRequest_FieldNumber_IncludeChangedLines = 1,
+  ITMScreenUpdateMonitorRequest_FieldNumber_MaxUpdatesPerSecond = 2,
+};
+
+@interface ITMScreenUpdateMonitorRequest : GPBMessage
+
+/**
+ * If true, each ScreenUpdateNotification carries the lines that changed since the previous one,
+ * the cursor position, and how far the screen scrolled, so you don't need to fetch the buffer.
+ * The first notification contains every line of the screen.
+ **/
+@property(nonatomic, readwrite) BOOL includeChangedLines;
+
+@property(nonatomic, readwrite) BOOL hasIncludeChangedLines;
+/**
+ * If positive, updates are coalesced so that no more than this many notifications are sent per
+ * second.
+ **/
+@property(nonatomic, readwrite) double maxUpdatesPerSecond;
+
+@property(nonatomic, readwrite) BOOL hasMaxUpdatesPerSecond;
+@end
+
 #pragma mark - ITMNotificationRequest
 
 typedef GPB_ENUM(ITMNotificationRequest_FieldNumber) {
@@ -3650,6 +3751,7 @@ typedef GPB_ENUM(ITMNotificationRequest_FieldNumber) {
   ITMNotificationRequest_FieldNumber_ProfileChangeRequest = 7,
   ITMNotificationRequest_FieldNumber_KeystrokeFilterRequest = 8,
   ITMNotificationRequest_FieldNumber_PromptMonitorRequest = 9,
+  ITMNotificationRequest_FieldNumber_ScreenUpdateMonitorRequest = 10,
 };
 
 typedef GPB_ENUM(ITMNotificationRequest_Arguments_OneOfCase) {
@@ -3660,6 +3762,7 @@ typedef GPB_ENUM(ITMNotificationRequest_Arguments_OneOfCase) {
   ITMNotificationRequest_Arguments_OneOfCase_ProfileChangeRequest = 7,
   ITMNotificationRequest_Arguments_OneOfCase_KeystrokeFilterRequest = 8,
   ITMNotificationRequest_Arguments_OneOfCase_PromptMonitorRequest = 9,
+  ITMNotificationRequest_Arguments_OneOfCase_ScreenUpdateMonitorRequest = 10,
 };
 
 @interface ITMNotificationRequest : GPBMessage
@@ -3697,6 +3800,9 @@ typedef GPB_ENUM(ITMNotificationRequest_Arguments_OneOfCase) {
 
 @property(nonatomic, readwrite, strong, null_resettable) ITMPromptMonitorRequest *promptMonitorRequest;
 
+/** For NOTIFY_ON_SCREEN_UPDATE */
+@property(nonatomic, readwrite, strong, null_resettable) ITMScreenUpdateMonitorRequest *screenUpdateMonitorRequest;
+
 @end
 
 /**
@@ -3952,6 +4058,9 @@ typedef GPB_ENUM(ITMKeystrokeNotification_FieldNumber) {
 
 typedef GPB_ENUM(ITMScreenUpdateNotification_FieldNumber) {
   ITMScreenUpdateNotification_FieldNumber_Session = 1,
+  ITMScreenUpdateNotification_FieldNumber_ChangedLinesArray = 2,
+  ITMScreenUpdateNotification_FieldNumber_Cursor = 3,
+  ITMScreenUpdateNotification_FieldNumber_Overflow = 4,
 };
 
 @interface ITMScreenUpdateNotification : GPBMessage
@@ -3960,6 +4069,39 @@ typedef GPB_ENUM(ITMScreenUpdateNotification_FieldNumber) {
 /** Test to see if @c session has been set. */
 @property(nonatomic, readwrite) BOOL hasSession;
 
+/** Lines whose contents changed. Updates should be applied after moving lines up by `overflow`. */
+@property(nonatomic, readwrite, strong, null_resettable) NSMutableArray<ITMScreenUpdateLine*> *changedLinesArray;
+/** The number of items in @c changedLinesArray without causing the array to be created. */
+@property(nonatomic, readonly) NSUInteger changedLinesArray_Count;
+
+/** The cursor's position. Unlike elsewhere, y is relative to the top of the screen. */
+@property(nonatomic, readwrite, strong, null_resettable) ITMCoord *cursor;
+/** Test to see if @c cursor has been set. */
+@property(nonatomic, readwrite) BOOL hasCursor;
+
+/** The number of lines that scrolled off the top of the screen since the previous notification. */
+@property(nonatomic, readwrite) int64_t overflow;
+
+@property(nonatomic, readwrite) BOOL hasOverflow;
+@end
+
+#pragma mark - ITMScreenUpdateLine
+
+typedef GPB_ENUM(ITMScreenUpdateLine_FieldNumber) {
+  ITMScreenUpdateLine_FieldNumber_Line = 1,
+  ITMScreenUpdateLine_FieldNumber_Contents = 2,
+};
+
+@interface ITMScreenUpdateLine : GPBMessage
+
+/** 0 is the top line of the screen. */
+@property(nonatomic, readwrite) int32_t line;
+
+@property(nonatomic, readwrite) BOOL hasLine;
+@property(nonatomic, readwrite, strong, null_resettable) ITMLineContents *contents;
+/** Test to see if @c contents has been set. */
+@property(nonatomic, readwrite) BOOL hasContents;
+
 @end
 
 #pragma mark - ITMPromptNotificationPrompt
@@ -4221,6 +4363,8 @@ typedef GPB_ENUM(ITMLayoutChangedNotification_FieldNumber) {
 typedef GPB_ENUM(ITMGetBufferRequest_FieldNumber) {
   ITMGetBufferRequest_FieldNumber_Session = 1,
   ITMGetBufferRequest_FieldNumber_LineRange = 2,
+  ITMGetBufferRequest_FieldNumber_MaxLines = 3,
+  ITMGetBufferRequest_FieldNumber_ContinuationToken = 4,
 };
 
 /**
@@ -4238,6 +4382,21 @@ typedef GPB_ENUM(ITMGetBufferRequest_FieldNumber) {
 /** Test to see if @c lineRange has been set. */
 @property(nonatomic, readwrite) BOOL hasLineRange;
 
+/**
+ * If positive, return at most this many lines. When the range has more, the response includes
+ * a continuation_token for fetching the rest.
+ **/
+@property(nonatomic, readwrite) int32_t maxLines;
+
+@property(nonatomic, readwrite) BOOL hasMaxLines;
+/**
+ * From a previous response. Returns the next lines of that response's range, in which case
+ * line_range is ignored.
+ **/
+@property(nonatomic, readwrite, copy, null_resettable) NSString *continuationToken;
+/** Test to see if @c continuationToken has been set. */
+@property(nonatomic, readwrite) BOOL hasContinuationToken;
+
 @end
 
 #pragma mark - ITMGetBufferResponse
@@ -4249,6 +4408,7 @@ typedef GPB_ENUM(ITMGetBufferResponse_FieldNumber) {
   ITMGetBufferResponse_FieldNumber_Cursor = 4,
   ITMGetBufferResponse_FieldNumber_NumLinesAboveScreen = 5,
   ITMGetBufferResponse_FieldNumber_WindowedCoordRange = 6,
+  ITMGetBufferResponse_FieldNumber_ContinuationToken = 7,
 };
 
 /**
@@ -4286,6 +4446,14 @@ typedef GPB_ENUM(ITMGetBufferResponse_FieldNumber) {
 /** Test to see if @c windowedCoordRange has been set. */
 @property(nonatomic, readwrite) BOOL hasWindowedCoordRange;
 
+/**
+ * Set when max_lines was reached before the end of the requested range. Pass it back in a
+ * GetBufferRequest for the following lines.
+ **/
+@property(nonatomic, readwrite, copy, null_resettable) NSString *continuationToken;
+/** Test to see if @c continuationToken has been set. */
+@property(nonatomic, readwrite) BOOL hasContinuationToken;
+
 @end
 
 #pragma mark - ITMGetPromptRequest
@@ -4597,6 +4765,176 @@ typedef GPB_ENUM(ITMTransactionResponse_FieldNumber) {
 @property(nonatomic, readwrite) BOOL hasStatus;
 @end
 
+#pragma mark - ITMBatchRequest
+
+typedef GPB_ENUM(ITMBatchRequest_FieldNumber) {
+  ITMBatchRequest_FieldNumber_RequestsArray = 1,
+  ITMBatchRequest_FieldNumber_Atomic = 2,
+};
+
+/**
+ * Runs several requests in one pass of the app's main loop and answers them with a single
+ * BatchResponse. Transaction and batch requests may not be nested in a batch.
+ **/
+@interface ITMBatchRequest : GPBMessage
+
+@property(nonatomic, readwrite, strong, null_resettable) NSMutableArray<ITMClientOriginatedMessage*> *requestsArray;
+/** The number of items in @c requestsArray without causing the array to be created. */
+@property(nonatomic, readonly) NSUInteger requestsArray_Count;
+
+/**
+ * If true, requests from other connections are not handled until every request in the batch
+ * has been answered, as in a transaction.
+ **/
+@property(nonatomic, readwrite) BOOL atomic;
+
+@property(nonatomic, readwrite) BOOL hasAtomic;
+@end
+
+#pragma mark - ITMBatchResponse
+
+typedef GPB_ENUM(ITMBatchResponse_FieldNumber) {
+  ITMBatchResponse_FieldNumber_ResponsesArray = 1,
+};
+
+@interface ITMBatchResponse : GPBMessage
+
+/** One response per request, in the same order, each with the id of its request. */
+@property(nonatomic, readwrite, strong, null_resettable) NSMutableArray<ITMServerOriginatedMessage*> *responsesArray;
+/** The number of items in @c responsesArray without causing the array to be created. */
+@property(nonatomic, readonly) NSUInteger responsesArray_Count;
+
+@end
+
+#pragma mark - ITMGetSystemMetricsRequest
+
+/**
+ * Fetches the recent history of the system-wide measurements that status bar components show.
+ * Requesting them keeps the app sampling for a minute even if no status bar shows them, so a
+ * script that polls gets a continuous history without sampling on its own.
+ **/
+@interface ITMGetSystemMetricsRequest : GPBMessage
+
+@end
+
+#pragma mark - ITMGetSystemMetricsResponse
+
+typedef GPB_ENUM(ITMGetSystemMetricsResponse_FieldNumber) {
+  ITMGetSystemMetricsResponse_FieldNumber_SamplingInterval = 1,
+  ITMGetSystemMetricsResponse_FieldNumber_CpuUtilizationArray = 2,
+  ITMGetSystemMetricsResponse_FieldNumber_MemoryUtilizationArray = 3,
+  ITMGetSystemMetricsResponse_FieldNumber_PhysicalMemory = 4,
+  ITMGetSystemMetricsResponse_FieldNumber_NetworkThroughputArray = 5,
+};
+
+@interface ITMGetSystemMetricsResponse : GPBMessage
+
+/** Samples are oldest first and taken once per sampling_interval seconds. */
+@property(nonatomic, readwrite) double samplingInterval;
+
+@property(nonatomic, readwrite) BOOL hasSamplingInterval;
+/** Fraction of time the CPUs were busy, from 0 to 1. */
+@property(nonatomic, readwrite, strong, null_resettable) GPBDoubleArray *cpuUtilizationArray;
+/** The number of items in @c cpuUtilizationArray without causing the array to be created. */
+@property(nonatomic, readonly) NSUInteger cpuUtilizationArray_Count;
+
+/** Fraction of physical memory in use, from 0 to 1. */
+@property(nonatomic, readwrite, strong, null_resettable) GPBDoubleArray *memoryUtilizationArray;
+/** The number of items in @c memoryUtilizationArray without causing the array to be created. */
+@property(nonatomic, readonly) NSUInteger memoryUtilizationArray_Count;
+
+@property(nonatomic, readwrite) int64_t physicalMemory;
+
+@property(nonatomic, readwrite) BOOL hasPhysicalMemory;
+@property(nonatomic, readwrite, strong, null_resettable) NSMutableArray<ITMGetSystemMetricsResponse_NetworkThroughput*> *networkThroughputArray;
+/** The number of items in @c networkThroughputArray without causing the array to be created. */
+@property(nonatomic, readonly) NSUInteger networkThroughputArray_Count;
+
+@end
+
+#pragma mark - ITMGetSystemMetricsResponse_NetworkThroughput
+
+typedef GPB_ENUM(ITMGetSystemMetricsResponse_NetworkThroughput_FieldNumber) {
+  ITMGetSystemMetricsResponse_NetworkThroughput_FieldNumber_BytesPerSecondRead = 1,
+  ITMGetSystemMetricsResponse_NetworkThroughput_FieldNumber_BytesPerSecondWrite = 2,
+};
+
+@interface ITMGetSystemMetricsResponse_NetworkThroughput : GPBMessage
+
+@property(nonatomic, readwrite) double bytesPerSecondRead;
+
+@property(nonatomic, readwrite) BOOL hasBytesPerSecondRead;
+@property(nonatomic, readwrite) double bytesPerSecondWrite;
+
+@property(nonatomic, readwrite) BOOL hasBytesPerSecondWrite;
+@end
+
+#pragma mark - ITMGetPerformanceCountersRequest
+
+/**
+ * Fetches iTerm2's own hot-path counters: how often it reads from ptys, parses, executes tokens,
+ * runs triggers, prepares and draws frames, saves state, and rebuilds the process cache, and how
+ * long those take. Totals are since launch.
+ **/
+@interface ITMGetPerformanceCountersRequest : GPBMessage
+
+@end
+
+#pragma mark - ITMGetPerformanceCountersResponse
+
+typedef GPB_ENUM(ITMGetPerformanceCountersResponse_FieldNumber) {
+  ITMGetPerformanceCountersResponse_FieldNumber_CountersArray = 1,
+};
+
+@interface ITMGetPerformanceCountersResponse : GPBMessage
+
+@property(nonatomic, readwrite, strong, null_resettable) NSMutableArray<ITMGetPerformanceCountersResponse_Counter*> *countersArray;
+/** The number of items in @c countersArray without causing the array to be created. */
+@property(nonatomic, readonly) NSUInteger countersArray_Count;
+
+@end
+
+#pragma mark - ITMGetPerformanceCountersResponse_Counter
+
+typedef GPB_ENUM(ITMGetPerformanceCountersResponse_Counter_FieldNumber) {
+  ITMGetPerformanceCountersResponse_Counter_FieldNumber_Name = 1,
+  ITMGetPerformanceCountersResponse_Counter_FieldNumber_Count = 2,
+  ITMGetPerformanceCountersResponse_Counter_FieldNumber_TotalTime = 3,
+  ITMGetPerformanceCountersResponse_Counter_FieldNumber_P50 = 4,
+  ITMGetPerformanceCountersResponse_Counter_FieldNumber_P90 = 5,
+  ITMGetPerformanceCountersResponse_Counter_FieldNumber_P99 = 6,
+  ITMGetPerformanceCountersResponse_Counter_FieldNumber_Max = 7,
+};
+
+@interface ITMGetPerformanceCountersResponse_Counter : GPBMessage
+
+@property(nonatomic, readwrite, copy, null_resettable) NSString *name;
+/** Test to see if @c name has been set. */
+@property(nonatomic, readwrite) BOOL hasName;
+
+/** Number of events. */
+@property(nonatomic, readwrite) int64_t count;
+
+@property(nonatomic, readwrite) BOOL hasCount;
+/** Total time spent in seconds, extrapolated from the events that were timed. */
+@property(nonatomic, readwrite) double totalTime;
+
+@property(nonatomic, readwrite) BOOL hasTotalTime;
+/** Durations of timed events in milliseconds. */
+@property(nonatomic, readwrite) double p50;
+
+@property(nonatomic, readwrite) BOOL hasP50;
+@property(nonatomic, readwrite) double p90;
+
+@property(nonatomic, readwrite) BOOL hasP90;
+@property(nonatomic, readwrite) double p99;
+
+@property(nonatomic, readwrite) BOOL hasP99;
+@property(nonatomic, readwrite) double max;
+
+@property(nonatomic, readwrite) BOOL hasMax;
+@end
+
 #pragma mark - ITMLineRange
 
 typedef GPB_ENUM(ITMLineRange_FieldNumber) {
@@ -308,6 +308,9 @@ BOOL ITMPromptMonitorMode_IsValidValue(int32_t value__) {
 @dynamic closeRequest;
 @dynamic invokeFunctionRequest;
 @dynamic listPromptsRequest;
+@dynamic batchRequest;
+@dynamic getSystemMetricsRequest;
+@dynamic getPerformanceCountersRequest;
 
 typedef struct ITMClientOriginatedMessage__storage_ {
   uint32_t _has_storage_[2];
@@ -345,6 +348,9 @@ typedef struct ITMClientOriginatedMessage__storage_ {
   ITMCloseRequest *closeRequest;
   ITMInvokeFunctionRequest *invokeFunctionRequest;
   ITMListPromptsRequest *listPromptsRequest;
+  ITMBatchRequest *batchRequest;
+  ITMGetSystemMetricsRequest *getSystemMetricsRequest;
+  ITMGetPerformanceCountersRequest *getPerformanceCountersRequest;
   int64_t id_p;
 } ITMClientOriginatedMessage__storage_;
 
@@ -669,6 +675,33 @@ typedef struct ITMClientOriginatedMessage__storage_ {
         .flags = GPBFieldOptional,
         .dataType = GPBDataTypeMessage,
       },
+      {
+        .name = "batchRequest",
+        .dataTypeSpecific.className = GPBStringifySymbol(ITMBatchRequest),
+        .number = ITMClientOriginatedMessage_FieldNumber_BatchRequest,
+        .hasIndex = -1,
+        .offset = (uint32_t)offsetof(ITMClientOriginatedMessage__storage_, batchRequest),
+        .flags = GPBFieldOptional,
+        .dataType = GPBDataTypeMessage,
+      },
+      {
+        .name = "getSystemMetricsRequest",
+        .dataTypeSpecific.className = GPBStringifySymbol(ITMGetSystemMetricsRequest),
+        .number = ITMClientOriginatedMessage_FieldNumber_GetSystemMetricsRequest,
+        .hasIndex = -1,
+        .offset = (uint32_t)offsetof(ITMClientOriginatedMessage__storage_, getSystemMetricsRequest),
+        .flags = GPBFieldOptional,
+        .dataType = GPBDataTypeMessage,
+      },
+      {
+        .name = "getPerformanceCountersRequest",
+        .dataTypeSpecific.className = GPBStringifySymbol(ITMGetPerformanceCountersRequest),
+        .number = ITMClientOriginatedMessage_FieldNumber_GetPerformanceCountersRequest,
+        .hasIndex = -1,
+        .offset = (uint32_t)offsetof(ITMClientOriginatedMessage__storage_, getPerformanceCountersRequest),
+        .flags = GPBFieldOptional,
+        .dataType = GPBDataTypeMessage,
+      },
     };
     GPBDescriptor *localDescriptor =
         [GPBDescriptor allocDescriptorForClass:[ITMClientOriginatedMessage class]
@@ -738,6 +771,9 @@ void ITMClientOriginatedMessage_ClearSubmessageOneOfCase(ITMClientOriginatedMess
 @dynamic closeResponse;
 @dynamic invokeFunctionResponse;
 @dynamic listPromptsResponse;
+@dynamic batchResponse;
+@dynamic getSystemMetricsResponse;
+@dynamic getPerformanceCountersResponse;
 @dynamic notification;
 
 typedef struct ITMServerOriginatedMessage__storage_ {
@@ -777,6 +813,9 @@ typedef struct ITMServerOriginatedMessage__storage_ {
   ITMCloseResponse *closeResponse;
   ITMInvokeFunctionResponse *invokeFunctionResponse;
   ITMListPromptsResponse *listPromptsResponse;
+  ITMBatchResponse *batchResponse;
+  ITMGetSystemMetricsResponse *getSystemMetricsResponse;
+  ITMGetPerformanceCountersResponse *getPerformanceCountersResponse;
   ITMNotification *notification;
   int64_t id_p;
 } ITMServerOriginatedMessage__storage_;
@@ -1111,6 +1150,33 @@ typedef struct ITMServerOriginatedMessage__storage_ {
         .flags = GPBFieldOptional,
         .dataType = GPBDataTypeMessage,
       },
+      {
+        .name = "batchResponse",
+        .dataTypeSpecific.className = GPBStringifySymbol(ITMBatchResponse),
+        .number = ITMServerOriginatedMessage_FieldNumber_BatchResponse,
+        .hasIndex = -1,
+        .offset = (uint32_t)offsetof(ITMServerOriginatedMessage__storage_, batchResponse),
+        .flags = GPBFieldOptional,
+        .dataType = GPBDataTypeMessage,
+      },
+      {
+        .name = "getSystemMetricsResponse",
+        .dataTypeSpecific.className = GPBStringifySymbol(ITMGetSystemMetricsResponse),
+        .number = ITMServerOriginatedMessage_FieldNumber_GetSystemMetricsResponse,
+        .hasIndex = -1,
+        .offset = (uint32_t)offsetof(ITMServerOriginatedMessage__storage_, getSystemMetricsResponse),
+        .flags = GPBFieldOptional,
+        .dataType = GPBDataTypeMessage,
+      },
+      {
+        .name = "getPerformanceCountersResponse",
+        .dataTypeSpecific.className = GPBStringifySymbol(ITMGetPerformanceCountersResponse),
+        .number = ITMServerOriginatedMessage_FieldNumber_GetPerformanceCountersResponse,
+        .hasIndex = -1,
+        .offset = (uint32_t)offsetof(ITMServerOriginatedMessage__storage_, getPerformanceCountersResponse),
+        .flags = GPBFieldOptional,
+        .dataType = GPBDataTypeMessage,
+      },
       {
         .name = "notification",
         .dataTypeSpecific.className = GPBStringifySymbol(ITMNotification),
@@ -7975,12 +8041,16 @@ typedef struct ITMKeystrokeFilterRequest__storage_ {
 @dynamic hasName, name;
 @dynamic hasScope, scope;
 @dynamic hasIdentifier, identifier;
+@dynamic hasCoalescingInterval, coalescingInterval;
+@dynamic hasPredicate, predicate;
 
 typedef struct ITMVariableMonitorRequest__storage_ {
   uint32_t _has_storage_[1];
   ITMVariableScope scope;
   NSString *name;
   NSString *identifier;
+  ITMVariableValuePredicate *predicate;
+  double coalescingInterval;
 } ITMVariableMonitorRequest__storage_;
 
 // This method is threadsafe because it is initially called
@@ -8019,6 +8089,26 @@ typedef struct ITMVariableMonitorRequest__storage_ {
         .core.flags = GPBFieldOptional,
         .core.dataType = GPBDataTypeString,
       },
+      {
+        .defaultValue.valueDouble = 0,
+        .core.name = "coalescingInterval",
+        .core.dataTypeSpecific.className = NULL,
+        .core.number = ITMVariableMonitorRequest_FieldNumber_CoalescingInterval,
+        .core.hasIndex = 3,
+        .core.offset = (uint32_t)offsetof(ITMVariableMonitorRequest__storage_, coalescingInterval),
+        .core.flags = GPBFieldOptional,
+        .core.dataType = GPBDataTypeDouble,
+      },
+      {
+        .defaultValue.valueMessage = nil,
+        .core.name = "predicate",
+        .core.dataTypeSpecific.className = GPBStringifySymbol(ITMVariableValuePredicate),
+        .core.number = ITMVariableMonitorRequest_FieldNumber_Predicate,
+        .core.hasIndex = 4,
+        .core.offset = (uint32_t)offsetof(ITMVariableMonitorRequest__storage_, predicate),
+        .core.flags = GPBFieldOptional,
+        .core.dataType = GPBDataTypeMessage,
+      },
     };
     GPBDescriptor *localDescriptor =
         [GPBDescriptor allocDescriptorForClass:[ITMVariableMonitorRequest class]
@@ -8036,6 +8126,60 @@ typedef struct ITMVariableMonitorRequest__storage_ {
 
 @end
 
+#pragma mark - ITMVariableValuePredicate
+
+@implementation ITMVariableValuePredicate
+
+@dynamic hasRegex, regex;
+@dynamic hasMinimumChange, minimumChange;
+
+typedef struct ITMVariableValuePredicate__storage_ {
+  uint32_t _has_storage_[1];
+  NSString *regex;
+  double minimumChange;
+} ITMVariableValuePredicate__storage_;
+
+// This method is threadsafe because it is initially called
+// in +initialize for each subclass.
++ (GPBDescriptor *)descriptor {
+  static GPBDescriptor *descriptor = nil;
+  if (!descriptor) {
+    static GPBMessageFieldDescription fields[] = {
+      {
+        .name = "regex",
+        .dataTypeSpecific.className = NULL,
+        .number = ITMVariableValuePredicate_FieldNumber_Regex,
+        .hasIndex = 0,
+        .offset = (uint32_t)offsetof(ITMVariableValuePredicate__storage_, regex),
+        .flags = GPBFieldOptional,
+        .dataType = GPBDataTypeString,
+      },
+      {
+        .name = "minimumChange",
+        .dataTypeSpecific.className = NULL,
+        .number = ITMVariableValuePredicate_FieldNumber_MinimumChange,
+        .hasIndex = 1,
+        .offset = (uint32_t)offsetof(ITMVariableValuePredicate__storage_, minimumChange),
+        .flags = GPBFieldOptional,
+        .dataType = GPBDataTypeDouble,
+      },
+    };
+    GPBDescriptor *localDescriptor =
+        [GPBDescriptor allocDescriptorForClass:[ITMVariableValuePredicate class]
+                                     rootClass:[ITMApiRoot class]
+                                          file:ITMApiRoot_FileDescriptor()
+                                        fields:fields
+                                    fieldCount:(uint32_t)(sizeof(fields) / sizeof(GPBMessageFieldDescription))
+                                   storageSize:sizeof(ITMVariableValuePredicate__storage_)
+                                         flags:GPBDescriptorInitializationFlag_None];
+    NSAssert(descriptor == nil, @"Startup recursed!");
+    descriptor = localDescriptor;
+  }
+  return descriptor;
+}
+
+@end
+
 #pragma mark - ITMProfileChangeRequest
 
 @implementation ITMProfileChangeRequest
@@ -8122,6 +8266,59 @@ typedef struct ITMPromptMonitorRequest__storage_ {
 
 @end
 
+#pragma mark - ITMScreenUpdateMonitorRequest
+
+@implementation ITMScreenUpdateMonitorRequest
+
+@dynamic hasIncludeChangedLines, includeChangedLines;
+@dynamic hasMaxUpdatesPerSecond, maxUpdatesPerSecond;
+
+typedef struct ITMScreenUpdateMonitorRequest__storage_ {
+  uint32_t _has_storage_[1];
+  double maxUpdatesPerSecond;
+} ITMScreenUpdateMonitorRequest__storage_;
+
+// This method is threadsafe because it is initially called
+// in +initialize for each subclass.
++ (GPBDescriptor *)descriptor {
+  static GPBDescriptor *descriptor = nil;
+  if (!descriptor) {
+    static GPBMessageFieldDescription fields[] = {
+      {
+        .name = "includeChangedLines",
+        .dataTypeSpecific.className = NULL,
+        .number = ITMScreenUpdateMonitorRequest_FieldNumber_IncludeChangedLines,
+        .hasIndex = 0,
+        .offset = 1,  // Stored in _has_storage_ to save space.
+        .flags = GPBFieldOptional,
+        .dataType = GPBDataTypeBool,
+      },
+      {
+        .name = "maxUpdatesPerSecond",
+        .dataTypeSpecific.className = NULL,
+        .number = ITMScreenUpdateMonitorRequest_FieldNumber_MaxUpdatesPerSecond,
+        .hasIndex = 2,
+        .offset = (uint32_t)offsetof(ITMScreenUpdateMonitorRequest__storage_, maxUpdatesPerSecond),
+        .flags = GPBFieldOptional,
+        .dataType = GPBDataTypeDouble,
+      },
+    };
+    GPBDescriptor *localDescriptor =
+        [GPBDescriptor allocDescriptorForClass:[ITMScreenUpdateMonitorRequest class]
+                                     rootClass:[ITMApiRoot class]
+                                          file:ITMApiRoot_FileDescriptor()
+                                        fields:fields
+                                    fieldCount:(uint32_t)(sizeof(fields) / sizeof(GPBMessageFieldDescription))
+                                   storageSize:sizeof(ITMScreenUpdateMonitorRequest__storage_)
+                                         flags:GPBDescriptorInitializationFlag_None];
+    NSAssert(descriptor == nil, @"Startup recursed!");
+    descriptor = localDescriptor;
+  }
+  return descriptor;
+}
+
+@end
+
 #pragma mark - ITMNotificationRequest
 
 @implementation ITMNotificationRequest
@@ -8136,6 +8333,7 @@ typedef struct ITMPromptMonitorRequest__storage_ {
 @dynamic profileChangeRequest;
 @dynamic keystrokeFilterRequest;
 @dynamic promptMonitorRequest;
+@dynamic screenUpdateMonitorRequest;
 
 typedef struct ITMNotificationRequest__storage_ {
   uint32_t _has_storage_[2];
@@ -8147,6 +8345,7 @@ typedef struct ITMNotificationRequest__storage_ {
   ITMProfileChangeRequest *profileChangeRequest;
   ITMKeystrokeFilterRequest *keystrokeFilterRequest;
   ITMPromptMonitorRequest *promptMonitorRequest;
+  ITMScreenUpdateMonitorRequest *screenUpdateMonitorRequest;
 } ITMNotificationRequest__storage_;
 
 // This method is threadsafe because it is initially called
@@ -8245,6 +8444,16 @@ typedef struct ITMNotificationRequest__storage_ {
         .core.flags = GPBFieldOptional,
         .core.dataType = GPBDataTypeMessage,
       },
+      {
+        .defaultValue.valueMessage = nil,
+        .core.name = "screenUpdateMonitorRequest",
+        .core.dataTypeSpecific.className = GPBStringifySymbol(ITMScreenUpdateMonitorRequest),
+        .core.number = ITMNotificationRequest_FieldNumber_ScreenUpdateMonitorRequest,
+        .core.hasIndex = -1,
+        .core.offset = (uint32_t)offsetof(ITMNotificationRequest__storage_, screenUpdateMonitorRequest),
+        .core.flags = GPBFieldOptional,
+        .core.dataType = GPBDataTypeMessage,
+      },
     };
     GPBDescriptor *localDescriptor =
         [GPBDescriptor allocDescriptorForClass:[ITMNotificationRequest class]
@@ -9010,10 +9219,16 @@ BOOL ITMKeystrokeNotification_Action_IsValidValue(int32_t value__) {
 @implementation ITMScreenUpdateNotification
 
 @dynamic hasSession, session;
+@dynamic changedLinesArray, changedLinesArray_Count;
+@dynamic hasCursor, cursor;
+@dynamic hasOverflow, overflow;
 
 typedef struct ITMScreenUpdateNotification__storage_ {
   uint32_t _has_storage_[1];
   NSString *session;
+  NSMutableArray *changedLinesArray;
+  ITMCoord *cursor;
+  int64_t overflow;
 } ITMScreenUpdateNotification__storage_;
 
 // This method is threadsafe because it is initially called
@@ -9031,6 +9246,33 @@ typedef struct ITMScreenUpdateNotification__storage_ {
         .flags = GPBFieldOptional,
         .dataType = GPBDataTypeString,
       },
+      {
+        .name = "changedLinesArray",
+        .dataTypeSpecific.className = GPBStringifySymbol(ITMScreenUpdateLine),
+        .number = ITMScreenUpdateNotification_FieldNumber_ChangedLinesArray,
+        .hasIndex = GPBNoHasBit,
+        .offset = (uint32_t)offsetof(ITMScreenUpdateNotification__storage_, changedLinesArray),
+        .flags = GPBFieldRepeated,
+        .dataType = GPBDataTypeMessage,
+      },
+      {
+        .name = "cursor",
+        .dataTypeSpecific.className = GPBStringifySymbol(ITMCoord),
+        .number = ITMScreenUpdateNotification_FieldNumber_Cursor,
+        .hasIndex = 1,
+        .offset = (uint32_t)offsetof(ITMScreenUpdateNotification__storage_, cursor),
+        .flags = GPBFieldOptional,
+        .dataType = GPBDataTypeMessage,
+      },
+      {
+        .name = "overflow",
+        .dataTypeSpecific.className = NULL,
+        .number = ITMScreenUpdateNotification_FieldNumber_Overflow,
+        .hasIndex = 2,
+        .offset = (uint32_t)offsetof(ITMScreenUpdateNotification__storage_, overflow),
+        .flags = GPBFieldOptional,
+        .dataType = GPBDataTypeInt64,
+      },
     };
     GPBDescriptor *localDescriptor =
         [GPBDescriptor allocDescriptorForClass:[ITMScreenUpdateNotification class]
@@ -9048,6 +9290,60 @@ typedef struct ITMScreenUpdateNotification__storage_ {
 
 @end
 
+#pragma mark - ITMScreenUpdateLine
+
+@implementation ITMScreenUpdateLine
+
+@dynamic hasLine, line;
+@dynamic hasContents, contents;
+
+typedef struct ITMScreenUpdateLine__storage_ {
+  uint32_t _has_storage_[1];
+  int32_t line;
+  ITMLineContents *contents;
+} ITMScreenUpdateLine__storage_;
+
+// This method is threadsafe because it is initially called
+// in +initialize for each subclass.
++ (GPBDescriptor *)descriptor {
+  static GPBDescriptor *descriptor = nil;
+  if (!descriptor) {
+    static GPBMessageFieldDescription fields[] = {
+      {
+        .name = "line",
+        .dataTypeSpecific.className = NULL,
+        .number = ITMScreenUpdateLine_FieldNumber_Line,
+        .hasIndex = 0,
+        .offset = (uint32_t)offsetof(ITMScreenUpdateLine__storage_, line),
+        .flags = GPBFieldOptional,
+        .dataType = GPBDataTypeInt32,
+      },
+      {
+        .name = "contents",
+        .dataTypeSpecific.className = GPBStringifySymbol(ITMLineContents),
+        .number = ITMScreenUpdateLine_FieldNumber_Contents,
+        .hasIndex = 1,
+        .offset = (uint32_t)offsetof(ITMScreenUpdateLine__storage_, contents),
+        .flags = GPBFieldOptional,
+        .dataType = GPBDataTypeMessage,
+      },
+    };
+    GPBDescriptor *localDescriptor =
+        [GPBDescriptor allocDescriptorForClass:[ITMScreenUpdateLine class]
+                                     rootClass:[ITMApiRoot class]
+                                          file:ITMApiRoot_FileDescriptor()
+                                        fields:fields
+                                    fieldCount:(uint32_t)(sizeof(fields) / sizeof(GPBMessageFieldDescription))
+                                   storageSize:sizeof(ITMScreenUpdateLine__storage_)
+                                         flags:GPBDescriptorInitializationFlag_None];
+    NSAssert(descriptor == nil, @"Startup recursed!");
+    descriptor = localDescriptor;
+  }
+  return descriptor;
+}
+
+@end
+
 #pragma mark - ITMPromptNotificationPrompt
 
 @implementation ITMPromptNotificationPrompt
@@ -9742,11 +10038,15 @@ typedef struct ITMLayoutChangedNotification__storage_ {
 
 @dynamic hasSession, session;
 @dynamic hasLineRange, lineRange;
+@dynamic hasMaxLines, maxLines;
+@dynamic hasContinuationToken, continuationToken;
 
 typedef struct ITMGetBufferRequest__storage_ {
   uint32_t _has_storage_[1];
+  int32_t maxLines;
   NSString *session;
   ITMLineRange *lineRange;
+  NSString *continuationToken;
 } ITMGetBufferRequest__storage_;
 
 // This method is threadsafe because it is initially called
@@ -9773,6 +10073,24 @@ typedef struct ITMGetBufferRequest__storage_ {
         .flags = GPBFieldOptional,
         .dataType = GPBDataTypeMessage,
       },
+      {
+        .name = "maxLines",
+        .dataTypeSpecific.className = NULL,
+        .number = ITMGetBufferRequest_FieldNumber_MaxLines,
+        .hasIndex = 2,
+        .offset = (uint32_t)offsetof(ITMGetBufferRequest__storage_, maxLines),
+        .flags = GPBFieldOptional,
+        .dataType = GPBDataTypeInt32,
+      },
+      {
+        .name = "continuationToken",
+        .dataTypeSpecific.className = NULL,
+        .number = ITMGetBufferRequest_FieldNumber_ContinuationToken,
+        .hasIndex = 3,
+        .offset = (uint32_t)offsetof(ITMGetBufferRequest__storage_, continuationToken),
+        .flags = GPBFieldOptional,
+        .dataType = GPBDataTypeString,
+      },
     };
     GPBDescriptor *localDescriptor =
         [GPBDescriptor allocDescriptorForClass:[ITMGetBufferRequest class]
@@ -9800,6 +10118,7 @@ typedef struct ITMGetBufferRequest__storage_ {
 @dynamic hasCursor, cursor;
 @dynamic hasNumLinesAboveScreen, numLinesAboveScreen;
 @dynamic hasWindowedCoordRange, windowedCoordRange;
+@dynamic hasContinuationToken, continuationToken;
 
 typedef struct ITMGetBufferResponse__storage_ {
   uint32_t _has_storage_[1];
@@ -9808,6 +10127,7 @@ typedef struct ITMGetBufferResponse__storage_ {
   NSMutableArray *contentsArray;
   ITMCoord *cursor;
   ITMWindowedCoordRange *windowedCoordRange;
+  NSString *continuationToken;
   int64_t numLinesAboveScreen;
 } ITMGetBufferResponse__storage_;
 
@@ -9871,6 +10191,15 @@ typedef struct ITMGetBufferResponse__storage_ {
         .flags = GPBFieldOptional,
         .dataType = GPBDataTypeMessage,
       },
+      {
+        .name = "continuationToken",
+        .dataTypeSpecific.className = NULL,
+        .number = ITMGetBufferResponse_FieldNumber_ContinuationToken,
+        .hasIndex = 5,
+        .offset = (uint32_t)offsetof(ITMGetBufferResponse__storage_, continuationToken),
+        .flags = GPBFieldOptional,
+        .dataType = GPBDataTypeString,
+      },
     };
     GPBDescriptor *localDescriptor =
         [GPBDescriptor allocDescriptorForClass:[ITMGetBufferResponse class]
@@ -10942,6 +11271,457 @@ BOOL ITMTransactionResponse_Status_IsValidValue(int32_t value__) {
   }
 }
 
+#pragma mark - ITMBatchRequest
+
+@implementation ITMBatchRequest
+
+@dynamic requestsArray, requestsArray_Count;
+@dynamic hasAtomic, atomic;
+
+typedef struct ITMBatchRequest__storage_ {
+  uint32_t _has_storage_[1];
+  NSMutableArray *requestsArray;
+} ITMBatchRequest__storage_;
+
+// This method is threadsafe because it is initially called
+// in +initialize for each subclass.
++ (GPBDescriptor *)descriptor {
+  static GPBDescriptor *descriptor = nil;
+  if (!descriptor) {
+    static GPBMessageFieldDescription fields[] = {
+      {
+        .name = "requestsArray",
+        .dataTypeSpecific.className = GPBStringifySymbol(ITMClientOriginatedMessage),
+        .number = ITMBatchRequest_FieldNumber_RequestsArray,
+        .hasIndex = GPBNoHasBit,
+        .offset = (uint32_t)offsetof(ITMBatchRequest__storage_, requestsArray),
+        .flags = GPBFieldRepeated,
+        .dataType = GPBDataTypeMessage,
+      },
+      {
+        .name = "atomic",
+        .dataTypeSpecific.className = NULL,
+        .number = ITMBatchRequest_FieldNumber_Atomic,
+        .hasIndex = 0,
+        .offset = 1,  // Stored in _has_storage_ to save space.
+        .flags = GPBFieldOptional,
+        .dataType = GPBDataTypeBool,
+      },
+    };
+    GPBDescriptor *localDescriptor =
+        [GPBDescriptor allocDescriptorForClass:[ITMBatchRequest class]
+                                     rootClass:[ITMApiRoot class]
+                                          file:ITMApiRoot_FileDescriptor()
+                                        fields:fields
+                                    fieldCount:(uint32_t)(sizeof(fields) / sizeof(GPBMessageFieldDescription))
+                                   storageSize:sizeof(ITMBatchRequest__storage_)
+                                         flags:GPBDescriptorInitializationFlag_None];
+    NSAssert(descriptor == nil, @"Startup recursed!");
+    descriptor = localDescriptor;
+  }
+  return descriptor;
+}
+
+@end
+
+#pragma mark - ITMBatchResponse
+
+@implementation ITMBatchResponse
+
+@dynamic responsesArray, responsesArray_Count;
+
+typedef struct ITMBatchResponse__storage_ {
+  uint32_t _has_storage_[1];
+  NSMutableArray *responsesArray;
+} ITMBatchResponse__storage_;
+
+// This method is threadsafe because it is initially called
+// in +initialize for each subclass.
++ (GPBDescriptor *)descriptor {
+  static GPBDescriptor *descriptor = nil;
+  if (!descriptor) {
+    static GPBMessageFieldDescription fields[] = {
+      {
+        .name = "responsesArray",
+        .dataTypeSpecific.className = GPBStringifySymbol(ITMServerOriginatedMessage),
+        .number = ITMBatchResponse_FieldNumber_ResponsesArray,
+        .hasIndex = GPBNoHasBit,
+        .offset = (uint32_t)offsetof(ITMBatchResponse__storage_, responsesArray),
+        .flags = GPBFieldRepeated,
+        .dataType = GPBDataTypeMessage,
+      },
+    };
+    GPBDescriptor *localDescriptor =
+        [GPBDescriptor allocDescriptorForClass:[ITMBatchResponse class]
+                                     rootClass:[ITMApiRoot class]
+                                          file:ITMApiRoot_FileDescriptor()
+                                        fields:fields
+                                    fieldCount:(uint32_t)(sizeof(fields) / sizeof(GPBMessageFieldDescription))
+                                   storageSize:sizeof(ITMBatchResponse__storage_)
+                                         flags:GPBDescriptorInitializationFlag_None];
+    NSAssert(descriptor == nil, @"Startup recursed!");
+    descriptor = localDescriptor;
+  }
+  return descriptor;
+}
+
+@end
+
+#pragma mark - ITMGetSystemMetricsRequest
+
+@implementation ITMGetSystemMetricsRequest
+
+
+typedef struct ITMGetSystemMetricsRequest__storage_ {
+  uint32_t _has_storage_[1];
+} ITMGetSystemMetricsRequest__storage_;
+
+// This method is threadsafe because it is initially called
+// in +initialize for each subclass.
++ (GPBDescriptor *)descriptor {
+  static GPBDescriptor *descriptor = nil;
+  if (!descriptor) {
+    GPBDescriptor *localDescriptor =
+        [GPBDescriptor allocDescriptorForClass:[ITMGetSystemMetricsRequest class]
+                                     rootClass:[ITMApiRoot class]
+                                          file:ITMApiRoot_FileDescriptor()
+                                        fields:NULL
+                                    fieldCount:0
+                                   storageSize:sizeof(ITMGetSystemMetricsRequest__storage_)
+                                         flags:GPBDescriptorInitializationFlag_None];
+    NSAssert(descriptor == nil, @"Startup recursed!");
+    descriptor = localDescriptor;
+  }
+  return descriptor;
+}
+
+@end
+
+#pragma mark - ITMGetSystemMetricsResponse
+
+@implementation ITMGetSystemMetricsResponse
+
+@dynamic hasSamplingInterval, samplingInterval;
+@dynamic cpuUtilizationArray, cpuUtilizationArray_Count;
+@dynamic memoryUtilizationArray, memoryUtilizationArray_Count;
+@dynamic hasPhysicalMemory, physicalMemory;
+@dynamic networkThroughputArray, networkThroughputArray_Count;
+
+typedef struct ITMGetSystemMetricsResponse__storage_ {
+  uint32_t _has_storage_[1];
+  GPBDoubleArray *cpuUtilizationArray;
+  GPBDoubleArray *memoryUtilizationArray;
+  NSMutableArray *networkThroughputArray;
+  double samplingInterval;
+  int64_t physicalMemory;
+} ITMGetSystemMetricsResponse__storage_;
+
+// This method is threadsafe because it is initially called
+// in +initialize for each subclass.
++ (GPBDescriptor *)descriptor {
+  static GPBDescriptor *descriptor = nil;
+  if (!descriptor) {
+    static GPBMessageFieldDescription fields[] = {
+      {
+        .name = "samplingInterval",
+        .dataTypeSpecific.className = NULL,
+        .number = ITMGetSystemMetricsResponse_FieldNumber_SamplingInterval,
+        .hasIndex = 0,
+        .offset = (uint32_t)offsetof(ITMGetSystemMetricsResponse__storage_, samplingInterval),
+        .flags = GPBFieldOptional,
+        .dataType = GPBDataTypeDouble,
+      },
+      {
+        .name = "cpuUtilizationArray",
+        .dataTypeSpecific.className = NULL,
+        .number = ITMGetSystemMetricsResponse_FieldNumber_CpuUtilizationArray,
+        .hasIndex = GPBNoHasBit,
+        .offset = (uint32_t)offsetof(ITMGetSystemMetricsResponse__storage_, cpuUtilizationArray),
+        .flags = GPBFieldRepeated,
+        .dataType = GPBDataTypeDouble,
+      },
+      {
+        .name = "memoryUtilizationArray",
+        .dataTypeSpecific.className = NULL,
+        .number = ITMGetSystemMetricsResponse_FieldNumber_MemoryUtilizationArray,
+        .hasIndex = GPBNoHasBit,
+        .offset = (uint32_t)offsetof(ITMGetSystemMetricsResponse__storage_, memoryUtilizationArray),
+        .flags = GPBFieldRepeated,
+        .dataType = GPBDataTypeDouble,
+      },
+      {
+        .name = "physicalMemory",
+        .dataTypeSpecific.className = NULL,
+        .number = ITMGetSystemMetricsResponse_FieldNumber_PhysicalMemory,
+        .hasIndex = 1,
+        .offset = (uint32_t)offsetof(ITMGetSystemMetricsResponse__storage_, physicalMemory),
+        .flags = GPBFieldOptional,
+        .dataType = GPBDataTypeInt64,
+      },
+      {
+        .name = "networkThroughputArray",
+        .dataTypeSpecific.className = GPBStringifySymbol(ITMGetSystemMetricsResponse_NetworkThroughput),
+        .number = ITMGetSystemMetricsResponse_FieldNumber_NetworkThroughputArray,
+        .hasIndex = GPBNoHasBit,
+        .offset = (uint32_t)offsetof(ITMGetSystemMetricsResponse__storage_, networkThroughputArray),
+        .flags = GPBFieldRepeated,
+        .dataType = GPBDataTypeMessage,
+      },
+    };
+    GPBDescriptor *localDescriptor =
+        [GPBDescriptor allocDescriptorForClass:[ITMGetSystemMetricsResponse class]
+                                     rootClass:[ITMApiRoot class]
+                                          file:ITMApiRoot_FileDescriptor()
+                                        fields:fields
+                                    fieldCount:(uint32_t)(sizeof(fields) / sizeof(GPBMessageFieldDescription))
+                                   storageSize:sizeof(ITMGetSystemMetricsResponse__storage_)
+                                         flags:GPBDescriptorInitializationFlag_None];
+    NSAssert(descriptor == nil, @"Startup recursed!");
+    descriptor = localDescriptor;
+  }
+  return descriptor;
+}
+
+@end
+
+#pragma mark - ITMGetSystemMetricsResponse_NetworkThroughput
+
+@implementation ITMGetSystemMetricsResponse_NetworkThroughput
+
+@dynamic hasBytesPerSecondRead, bytesPerSecondRead;
+@dynamic hasBytesPerSecondWrite, bytesPerSecondWrite;
+
+typedef struct ITMGetSystemMetricsResponse_NetworkThroughput__storage_ {
+  uint32_t _has_storage_[1];
+  double bytesPerSecondRead;
+  double bytesPerSecondWrite;
+} ITMGetSystemMetricsResponse_NetworkThroughput__storage_;
+
+// This method is threadsafe because it is initially called
+// in +initialize for each subclass.
++ (GPBDescriptor *)descriptor {
+  static GPBDescriptor *descriptor = nil;
+  if (!descriptor) {
+    static GPBMessageFieldDescription fields[] = {
+      {
+        .name = "bytesPerSecondRead",
+        .dataTypeSpecific.className = NULL,
+        .number = ITMGetSystemMetricsResponse_NetworkThroughput_FieldNumber_BytesPerSecondRead,
+        .hasIndex = 0,
+        .offset = (uint32_t)offsetof(ITMGetSystemMetricsResponse_NetworkThroughput__storage_, bytesPerSecondRead),
+        .flags = GPBFieldOptional,
+        .dataType = GPBDataTypeDouble,
+      },
+      {
+        .name = "bytesPerSecondWrite",
+        .dataTypeSpecific.className = NULL,
+        .number = ITMGetSystemMetricsResponse_NetworkThroughput_FieldNumber_BytesPerSecondWrite,
+        .hasIndex = 1,
+        .offset = (uint32_t)offsetof(ITMGetSystemMetricsResponse_NetworkThroughput__storage_, bytesPerSecondWrite),
+        .flags = GPBFieldOptional,
+        .dataType = GPBDataTypeDouble,
+      },
+    };
+    GPBDescriptor *localDescriptor =
+        [GPBDescriptor allocDescriptorForClass:[ITMGetSystemMetricsResponse_NetworkThroughput class]
+                                     rootClass:[ITMApiRoot class]
+                                          file:ITMApiRoot_FileDescriptor()
+                                        fields:fields
+                                    fieldCount:(uint32_t)(sizeof(fields) / sizeof(GPBMessageFieldDescription))
+                                   storageSize:sizeof(ITMGetSystemMetricsResponse_NetworkThroughput__storage_)
+                                         flags:GPBDescriptorInitializationFlag_None];
+    [localDescriptor setupContainingMessageClassName:GPBStringifySymbol(ITMGetSystemMetricsResponse)];
+    NSAssert(descriptor == nil, @"Startup recursed!");
+    descriptor = localDescriptor;
+  }
+  return descriptor;
+}
+
+@end
+
+#pragma mark - ITMGetPerformanceCountersRequest
+
+@implementation ITMGetPerformanceCountersRequest
+
+
+typedef struct ITMGetPerformanceCountersRequest__storage_ {
+  uint32_t _has_storage_[1];
+} ITMGetPerformanceCountersRequest__storage_;
+
+// This method is threadsafe because it is initially called
+// in +initialize for each subclass.
++ (GPBDescriptor *)descriptor {
+  static GPBDescriptor *descriptor = nil;
+  if (!descriptor) {
+    GPBDescriptor *localDescriptor =
+        [GPBDescriptor allocDescriptorForClass:[ITMGetPerformanceCountersRequest class]
+                                     rootClass:[ITMApiRoot class]
+                                          file:ITMApiRoot_FileDescriptor()
+                                        fields:NULL
+                                    fieldCount:0
+                                   storageSize:sizeof(ITMGetPerformanceCountersRequest__storage_)
+                                         flags:GPBDescriptorInitializationFlag_None];
+    NSAssert(descriptor == nil, @"Startup recursed!");
+    descriptor = localDescriptor;
+  }
+  return descriptor;
+}
+
+@end
+
+#pragma mark - ITMGetPerformanceCountersResponse
+
+@implementation ITMGetPerformanceCountersResponse
+
+@dynamic countersArray, countersArray_Count;
+
+typedef struct ITMGetPerformanceCountersResponse__storage_ {
+  uint32_t _has_storage_[1];
+  NSMutableArray *countersArray;
+} ITMGetPerformanceCountersResponse__storage_;
+
+// This method is threadsafe because it is initially called
+// in +initialize for each subclass.
++ (GPBDescriptor *)descriptor {
+  static GPBDescriptor *descriptor = nil;
+  if (!descriptor) {
+    static GPBMessageFieldDescription fields[] = {
+      {
+        .name = "countersArray",
+        .dataTypeSpecific.className = GPBStringifySymbol(ITMGetPerformanceCountersResponse_Counter),
+        .number = ITMGetPerformanceCountersResponse_FieldNumber_CountersArray,
+        .hasIndex = GPBNoHasBit,
+        .offset = (uint32_t)offsetof(ITMGetPerformanceCountersResponse__storage_, countersArray),
+        .flags = GPBFieldRepeated,
+        .dataType = GPBDataTypeMessage,
+      },
+    };
+    GPBDescriptor *localDescriptor =
+        [GPBDescriptor allocDescriptorForClass:[ITMGetPerformanceCountersResponse class]
+                                     rootClass:[ITMApiRoot class]
+                                          file:ITMApiRoot_FileDescriptor()
+                                        fields:fields
+                                    fieldCount:(uint32_t)(sizeof(fields) / sizeof(GPBMessageFieldDescription))
+                                   storageSize:sizeof(ITMGetPerformanceCountersResponse__storage_)
+                                         flags:GPBDescriptorInitializationFlag_None];
+    NSAssert(descriptor == nil, @"Startup recursed!");
+    descriptor = localDescriptor;
+  }
+  return descriptor;
+}
+
+@end
+
+#pragma mark - ITMGetPerformanceCountersResponse_Counter
+
+@implementation ITMGetPerformanceCountersResponse_Counter
+
+@dynamic hasName, name;
+@dynamic hasCount, count;
+@dynamic hasTotalTime, totalTime;
+@dynamic hasP50, p50;
+@dynamic hasP90, p90;
+@dynamic hasP99, p99;
+@dynamic hasMax, max;
+
+typedef struct ITMGetPerformanceCountersResponse_Counter__storage_ {
+  uint32_t _has_storage_[1];
+  NSString *name;
+  int64_t count;
+  double totalTime;
+  double p50;
+  double p90;
+  double p99;
+  double max;
+} ITMGetPerformanceCountersResponse_Counter__storage_;
+
+// This method is threadsafe because it is initially called
+// in +initialize for each subclass.
++ (GPBDescriptor *)descriptor {
+  static GPBDescriptor *descriptor = nil;
+  if (!descriptor) {
+    static GPBMessageFieldDescription fields[] = {
+      {
+        .name = "name",
+        .dataTypeSpecific.className = NULL,
+        .number = ITMGetPerformanceCountersResponse_Counter_FieldNumber_Name,
+        .hasIndex = 0,
+        .offset = (uint32_t)offsetof(ITMGetPerformanceCountersResponse_Counter__storage_, name),
+        .flags = GPBFieldOptional,
+        .dataType = GPBDataTypeString,
+      },
+      {
+        .name = "count",
+        .dataTypeSpecific.className = NULL,
+        .number = ITMGetPerformanceCountersResponse_Counter_FieldNumber_Count,
+        .hasIndex = 1,
+        .offset = (uint32_t)offsetof(ITMGetPerformanceCountersResponse_Counter__storage_, count),
+        .flags = GPBFieldOptional,
+        .dataType = GPBDataTypeInt64,
+      },
+      {
+        .name = "totalTime",
+        .dataTypeSpecific.className = NULL,
+        .number = ITMGetPerformanceCountersResponse_Counter_FieldNumber_TotalTime,
+        .hasIndex = 2,
+        .offset = (uint32_t)offsetof(ITMGetPerformanceCountersResponse_Counter__storage_, totalTime),
+        .flags = GPBFieldOptional,
+        .dataType = GPBDataTypeDouble,
+      },
+      {
+        .name = "p50",
+        .dataTypeSpecific.className = NULL,
+        .number = ITMGetPerformanceCountersResponse_Counter_FieldNumber_P50,
+        .hasIndex = 3,
+        .offset = (uint32_t)offsetof(ITMGetPerformanceCountersResponse_Counter__storage_, p50),
+        .flags = GPBFieldOptional,
+        .dataType = GPBDataTypeDouble,
+      },
+      {
+        .name = "p90",
+        .dataTypeSpecific.className = NULL,
+        .number = ITMGetPerformanceCountersResponse_Counter_FieldNumber_P90,
+        .hasIndex = 4,
+        .offset = (uint32_t)offsetof(ITMGetPerformanceCountersResponse_Counter__storage_, p90),
+        .flags = GPBFieldOptional,
+        .dataType = GPBDataTypeDouble,
+      },
+      {
+        .name = "p99",
+        .dataTypeSpecific.className = NULL,
+        .number = ITMGetPerformanceCountersResponse_Counter_FieldNumber_P99,
+        .hasIndex = 5,
+        .offset = (uint32_t)offsetof(ITMGetPerformanceCountersResponse_Counter__storage_, p99),
+        .flags = GPBFieldOptional,
+        .dataType = GPBDataTypeDouble,
+      },
+      {
+        .name = "max",
+        .dataTypeSpecific.className = NULL,
+        .number = ITMGetPerformanceCountersResponse_Counter_FieldNumber_Max,
+        .hasIndex = 6,
+        .offset = (uint32_t)offsetof(ITMGetPerformanceCountersResponse_Counter__storage_, max),
+        .flags = GPBFieldOptional,
+        .dataType = GPBDataTypeDouble,
+      },
+    };
+    GPBDescriptor *localDescriptor =
+        [GPBDescriptor allocDescriptorForClass:[ITMGetPerformanceCountersResponse_Counter class]
+                                     rootClass:[ITMApiRoot class]
+                                          file:ITMApiRoot_FileDescriptor()
+                                        fields:fields
+                                    fieldCount:(uint32_t)(sizeof(fields) / sizeof(GPBMessageFieldDescription))
+                                   storageSize:sizeof(ITMGetPerformanceCountersResponse_Counter__storage_)
+                                         flags:GPBDescriptorInitializationFlag_None];
+    [localDescriptor setupContainingMessageClassName:GPBStringifySymbol(ITMGetPerformanceCountersResponse)];
+    NSAssert(descriptor == nil, @"Startup recursed!");
+    descriptor = localDescriptor;
+  }
+  return descriptor;
+}
+
+@end
+
 #pragma mark - ITMLineRange
 
 @implementation ITMLineRange